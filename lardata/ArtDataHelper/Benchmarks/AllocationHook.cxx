@@ -0,0 +1,78 @@
+/**
+ * @file   AllocationHook.cxx
+ * @brief  Replacement of the global `operator new` counting the allocations
+ * @date   October 14, 2026
+ * @see    BenchmarkSummary.h
+ *
+ * This source makes a library on its own, which is meant to be loaded in
+ * front of all the others:
+ *
+ *     LD_PRELOAD=liblardata_ArtDataHelper_Benchmarks_AllocationHook.so lar ...
+ *
+ * The replacement operators allocate with `std::malloc()` like the standard
+ * ones, and count the number and size of the allocations in all threads.
+ * The aligned versions of the operators are not replaced, and the
+ * allocations they perform are not counted.
+ * `lar::bench::currentAllocationCounts()` reads the counters.
+ */
+
+// C/C++ standard libraries
+#include <atomic>
+#include <new>
+#include <cstdlib> // std::malloc(), std::free()
+
+
+namespace {
+
+  std::atomic<unsigned long long> AllocationCount { 0U };
+  std::atomic<unsigned long long> AllocatedBytes { 0U };
+
+  void* countedAllocation(std::size_t size) noexcept {
+    AllocationCount.fetch_add(1U, std::memory_order_relaxed);
+    AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size? size: 1U);
+  } // countedAllocation()
+
+  void* countedAllocationOrThrow(std::size_t size) {
+    while (true) {
+      void* const ptr = countedAllocation(size);
+      if (ptr) return ptr;
+      std::new_handler const handler = std::get_new_handler();
+      if (!handler) throw std::bad_alloc();
+      handler();
+    } // while
+  } // countedAllocationOrThrow()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+extern "C" void lardata_bench_allocation_counts
+  (unsigned long long* count, unsigned long long* bytes)
+{
+  *count = AllocationCount.load(std::memory_order_relaxed);
+  *bytes = AllocatedBytes.load(std::memory_order_relaxed);
+} // lardata_bench_allocation_counts()
+
+
+//------------------------------------------------------------------------------
+void* operator new(std::size_t size)
+  { return countedAllocationOrThrow(size); }
+void* operator new[](std::size_t size)
+  { return countedAllocationOrThrow(size); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+  { return countedAllocation(size); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+  { return countedAllocation(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::nothrow_t const&) noexcept
+  { std::free(ptr); }
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept
+  { std::free(ptr); }
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,169 @@
+/**
+ * @file   BenchFindManyInChainP_module.cc
+ * @brief  Measures the cost of `lar::FindManyInChainP` on the event
+ * @date   October 14, 2026
+ * @see    lardata/Utilities/FindManyInChainP.h, BenchmarkSummary.h
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+#include "lardata/Utilities/FindManyInChainP.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/Cluster.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+// framework libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Utilities/InputTag.h"
+
+// utility libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// C/C++ standard libraries
+#include <vector>
+
+
+namespace lar {
+  namespace bench {
+
+    /**
+     * @brief Measures the hits of particles via `lar::FindManyInChainP`.
+     *
+     * On each event, the hits associated to each of the input particles
+     * through their clusters are found with the different algorithms of
+     * `lar::FindManyInChainP<recob::Hit, recob::Cluster>`, each one making a
+     * section of the benchmark: `find`, `findIndexed` and, optionally,
+     * `findIndexed (parallel)`. The processed items are the found hits.
+     *
+     * Configuration parameters
+     * =========================
+     *
+     * * *particles* (input tag, mandatory): the `recob::PFParticle`
+     *   collection, with its associations to clusters
+     * * *clusters* (input tag, mandatory): the data product with the
+     *   associations of clusters to hits
+     * * *parallel* (boolean, default: true): also measures the parallel
+     *   traversal
+     * * *logEvents* (boolean, default: false): also log each event
+     */
+    class BenchFindManyInChainP: public art::EDAnalyzer {
+        public:
+
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<art::InputTag> particles{
+          Name("particles"),
+          Comment("tag of the recob::PFParticle data product")
+          };
+
+        fhicl::Atom<art::InputTag> clusters{
+          Name("clusters"),
+          Comment("tag of the cluster-hit associations")
+          };
+
+        fhicl::Atom<bool> parallel{
+          Name("parallel"),
+          Comment("whether to measure also the parallel traversal"),
+          true
+          };
+
+        fhicl::Atom<bool> logEvents{
+          Name("logEvents"),
+          Comment("whether to log the measurements of each event"),
+          false
+          };
+
+      }; // struct Config
+
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+      explicit BenchFindManyInChainP(Parameters const& config);
+
+      virtual void analyze(art::Event const& event) override;
+
+      virtual void endJob() override;
+
+        private:
+      using Finder_t = lar::FindManyInChainP<recob::Hit, recob::Cluster>;
+
+      art::InputTag fParticlesTag; ///< input particles
+      art::InputTag fClustersTag; ///< input cluster-hit associations
+      bool fParallel; ///< whether to measure the parallel traversal
+      bool fLogEvents; ///< whether to log each event
+
+      BenchmarkSummary fSummary; ///< collected measurements
+
+    }; // class BenchFindManyInChainP
+
+  } // namespace bench
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+lar::bench::BenchFindManyInChainP::BenchFindManyInChainP
+  (Parameters const& config)
+  : art::EDAnalyzer(config)
+  , fParticlesTag(config().particles())
+  , fClustersTag(config().clusters())
+  , fParallel(config().parallel())
+  , fLogEvents(config().logEvents())
+  , fSummary("BenchFindManyInChainP", "hits")
+  {}
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchFindManyInChainP::analyze(art::Event const& event) {
+
+  auto const particles
+    = event.getValidHandle<std::vector<recob::PFParticle>>(fParticlesTag);
+
+  Measurement const find = fSummary.measure("find", [&](){
+    std::size_t nHits = 0U;
+    auto const hits
+      = Finder_t::find(particles, event, fParticlesTag, fClustersTag);
+    for (auto const& particleHits: hits) nHits += particleHits.size();
+    return nHits;
+  });
+
+  Measurement const indexed = fSummary.measure("findIndexed", [&](){
+    auto const hits
+      = Finder_t::findIndexed(particles, event, fParticlesTag, fClustersTag);
+    return hits.allPtrs().size();
+  });
+
+  Measurement parallel;
+  if (fParallel) {
+    parallel = fSummary.measure("findIndexed (parallel)", [&](){
+      auto const hits = Finder_t::findIndexed(lar::ParallelTraversal,
+        particles, event, fParticlesTag, fClustersTag);
+      return hits.allPtrs().size();
+    });
+  } // if parallel
+
+  if (fLogEvents) {
+    mf::LogInfo log("BenchFindManyInChainP");
+    log << event.id() << " (" << particles->size() << " particles)"
+      << "\n  [find] " << find
+      << "\n  [findIndexed] " << indexed;
+    if (fParallel) log << "\n  [findIndexed (parallel)] " << parallel;
+  } // if log
+
+} // lar::bench::BenchFindManyInChainP::analyze()
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchFindManyInChainP::endJob() {
+  mf::LogInfo("BenchFindManyInChainP") << fSummary;
+} // lar::bench::BenchFindManyInChainP::endJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(lar::bench::BenchFindManyInChainP)
@@ -0,0 +1,176 @@
+/**
+ * @file   BenchHitCreator_module.cc
+ * @brief  Measures the cost of `recob::HitCreator` on the hits of the event
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/HitCreator.h, BenchmarkSummary.h
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+#include "lardata/ArtDataHelper/HitCreator.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+// framework libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Utilities/InputTag.h"
+
+// utility libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/OptionalAtom.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// C/C++ standard libraries
+#include <vector>
+
+
+namespace lar {
+  namespace bench {
+
+    /**
+     * @brief Measures the creation of hits with `recob::HitCreator`.
+     *
+     * On each event, each of the hits of the input data product is created
+     * again with `recob::HitCreator`, in two ways:
+     * * `copy`: from the original hit, with its own wire ID;
+     * * `from wire`: from the hit parameters and the `recob::Wire` on the
+     *   same channel, which also integrates the wire signal (only if `wires`
+     *   is specified; hits with no wire are skipped).
+     *
+     * The processed items are the created hits.
+     *
+     * Configuration parameters
+     * =========================
+     *
+     * * *hits* (input tag, mandatory): the `recob::Hit` collection
+     * * *wires* (input tag, optional): the `recob::Wire` collection
+     * * *logEvents* (boolean, default: false): also log each event
+     */
+    class BenchHitCreator: public art::EDAnalyzer {
+        public:
+
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<art::InputTag> hits{
+          Name("hits"),
+          Comment("tag of the recob::Hit data product to re-create")
+          };
+
+        fhicl::OptionalAtom<art::InputTag> wires{
+          Name("wires"),
+          Comment("tag of the recob::Wire data product the hits come from")
+          };
+
+        fhicl::Atom<bool> logEvents{
+          Name("logEvents"),
+          Comment("whether to log the measurements of each event"),
+          false
+          };
+
+      }; // struct Config
+
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+      explicit BenchHitCreator(Parameters const& config);
+
+      virtual void analyze(art::Event const& event) override;
+
+      virtual void endJob() override;
+
+        private:
+      art::InputTag fHitsTag; ///< input hits
+      art::InputTag fWiresTag; ///< input wires (if any)
+      bool fUseWires; ///< whether wires were specified
+      bool fLogEvents; ///< whether to log each event
+
+      BenchmarkSummary fSummary; ///< collected measurements
+
+    }; // class BenchHitCreator
+
+  } // namespace bench
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+lar::bench::BenchHitCreator::BenchHitCreator(Parameters const& config)
+  : art::EDAnalyzer(config)
+  , fHitsTag(config().hits())
+  , fUseWires(config().wires(fWiresTag))
+  , fLogEvents(config().logEvents())
+  , fSummary("BenchHitCreator", "hits")
+  {}
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchHitCreator::analyze(art::Event const& event) {
+
+  auto const& hits
+    = *(event.getValidHandle<std::vector<recob::Hit>>(fHitsTag));
+
+  std::vector<recob::Hit> created;
+
+  Measurement const copy = fSummary.measure("copy", [&](){
+    created.clear();
+    created.reserve(hits.size());
+    for (recob::Hit const& hit: hits)
+      created.push_back(recob::HitCreator(hit, hit.WireID()).move());
+    return created.size();
+  });
+  if (fLogEvents) {
+    mf::LogInfo("BenchHitCreator")
+      << event.id() << " [copy] " << copy;
+  }
+
+  if (!fUseWires) return;
+
+  // channel lookup, not measured
+  auto const& wires
+    = *(event.getValidHandle<std::vector<recob::Wire>>(fWiresTag));
+  std::vector<recob::Wire const*> wireOnChannel;
+  for (recob::Wire const& wire: wires) {
+    if (wire.Channel() >= wireOnChannel.size())
+      wireOnChannel.resize(wire.Channel() + 1, nullptr);
+    wireOnChannel[wire.Channel()] = &wire;
+  } // for wires
+
+  Measurement const fromWire = fSummary.measure("from wire", [&](){
+    created.clear();
+    created.reserve(hits.size());
+    for (recob::Hit const& hit: hits) {
+      if (hit.Channel() >= wireOnChannel.size()) continue;
+      recob::Wire const* wire = wireOnChannel[hit.Channel()];
+      if (!wire) continue;
+      created.push_back(recob::HitCreator(
+        *wire, hit.WireID(), hit.StartTick(), hit.EndTick(), hit.RMS(),
+        hit.PeakTime(), hit.SigmaPeakTime(),
+        hit.PeakAmplitude(), hit.SigmaPeakAmplitude(),
+        hit.Integral(), hit.SigmaIntegral(),
+        hit.Multiplicity(), hit.LocalIndex(),
+        hit.GoodnessOfFit(), hit.DegreesOfFreedom()
+        ).move());
+    } // for hits
+    return created.size();
+  });
+  if (fLogEvents) {
+    mf::LogInfo("BenchHitCreator")
+      << event.id() << " [from wire] " << fromWire;
+  }
+
+} // lar::bench::BenchHitCreator::analyze()
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchHitCreator::endJob() {
+  mf::LogInfo("BenchHitCreator") << fSummary;
+} // lar::bench::BenchHitCreator::endJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(lar::bench::BenchHitCreator)
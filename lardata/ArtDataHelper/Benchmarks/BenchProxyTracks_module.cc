@@ -0,0 +1,146 @@
+/**
+ * @file   BenchProxyTracks_module.cc
+ * @brief  Measures the cost of the track proxies on the tracks of the event
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/Track.h, BenchmarkSummary.h
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+#include "lardata/RecoBaseProxy/Track.h" // proxy namespace
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+// framework libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+
+// utility libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// C/C++ standard libraries
+#include <optional>
+#include <utility> // std::declval()
+
+
+namespace lar {
+  namespace bench {
+
+    /**
+     * @brief Measures the creation and the use of `proxy::Tracks`.
+     *
+     * On each event, two sections are measured:
+     * * `getCollection`: the creation of the proxy to the input tracks, with
+     *   their hits (the items are the tracks);
+     * * `traversal`: a loop on all the points of all the tracks, reading
+     *   position and hit of each of them (the items are the points).
+     *
+     * Configuration parameters
+     * =========================
+     *
+     * * *tracks* (input tag, mandatory): the `recob::Track` collection, with
+     *   its associations to hits
+     * * *logEvents* (boolean, default: false): also log each event
+     */
+    class BenchProxyTracks: public art::EDAnalyzer {
+        public:
+
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<art::InputTag> tracks{
+          Name("tracks"),
+          Comment("tag of the recob::Track data product to read")
+          };
+
+        fhicl::Atom<bool> logEvents{
+          Name("logEvents"),
+          Comment("whether to log the measurements of each event"),
+          false
+          };
+
+      }; // struct Config
+
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+      explicit BenchProxyTracks(Parameters const& config);
+
+      virtual void analyze(art::Event const& event) override;
+
+      virtual void endJob() override;
+
+        private:
+      art::InputTag fTracksTag; ///< input tracks
+      bool fLogEvents; ///< whether to log each event
+
+      double fChecksum = 0.; ///< sum of the read values, keeps them alive
+
+      BenchmarkSummary fSummary; ///< collected measurements
+
+    }; // class BenchProxyTracks
+
+  } // namespace bench
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+lar::bench::BenchProxyTracks::BenchProxyTracks(Parameters const& config)
+  : art::EDAnalyzer(config)
+  , fTracksTag(config().tracks())
+  , fLogEvents(config().logEvents())
+  , fSummary("BenchProxyTracks", "items")
+  {}
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchProxyTracks::analyze(art::Event const& event) {
+
+  using TracksProxy_t = decltype(proxy::getCollection<proxy::Tracks>
+    (std::declval<art::Event const&>(), std::declval<art::InputTag>()));
+
+  std::optional<TracksProxy_t> tracks;
+
+  Measurement const creation = fSummary.measure("getCollection", [&](){
+    tracks.emplace(proxy::getCollection<proxy::Tracks>(event, fTracksTag));
+    return tracks->size();
+  });
+
+  Measurement const traversal = fSummary.measure("traversal", [&](){
+    std::size_t nPoints = 0U;
+    double sum = 0.;
+    for (auto const& track: *tracks) {
+      for (auto const& point: track.points()) {
+        ++nPoints;
+        sum += point.position().Z();
+        recob::Hit const* hit = point.hit();
+        if (hit) sum += hit->Integral();
+      } // for points
+    } // for tracks
+    fChecksum += sum;
+    return nPoints;
+  });
+
+  if (fLogEvents) {
+    mf::LogInfo("BenchProxyTracks") << event.id()
+      << "\n  [getCollection] " << creation
+      << "\n  [traversal] " << traversal;
+  }
+
+} // lar::bench::BenchProxyTracks::analyze()
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchProxyTracks::endJob() {
+  mf::LogInfo("BenchProxyTracks") << fSummary
+    << "\n(checksum: " << fChecksum << ")";
+} // lar::bench::BenchProxyTracks::endJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(lar::bench::BenchProxyTracks)
@@ -0,0 +1,243 @@
+/**
+ * @file   BenchSignalShaping_module.cc
+ * @brief  Measures the cost of `util::SignalShaping` on the wires of the event
+ * @date   October 14, 2026
+ * @see    lardata/Utilities/SignalShaping.h, BenchmarkSummary.h
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+#include "lardata/Utilities/SignalShaping.h"
+#include "lardata/Utilities/LArFFT.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+// framework libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "canvas/Utilities/InputTag.h"
+
+// utility libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// ROOT libraries
+#include "TComplex.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <memory> // std::unique_ptr<>
+#include <cmath> // std::exp()
+
+
+namespace lar {
+  namespace bench {
+
+    /**
+     * @brief Measures convolution and deconvolution of the wire signals.
+     *
+     * A `util::SignalShaping` object is configured with the response from the
+     * configuration (or a default unipolar one), a flat filter, and the size
+     * of the `LArFFT` service. On each event, the signal of each of the input
+     * wires is made dense and then:
+     * * `signal`: nothing else (cost of reading the signal only);
+     * * `convolution`: convoluted with the response;
+     * * `deconvolution`: deconvoluted (only if `deconvolute` is set).
+     *
+     * The cost of `signal` is included in the other two sections.
+     * The processed items are the wires. The `LArFFT` service is required.
+     *
+     * Configuration parameters
+     * =========================
+     *
+     * * *wires* (input tag, mandatory): the `recob::Wire` collection
+     * * *response* (list of real numbers, default: empty): the response
+     *   function, in ticks; if empty, a unipolar response with the peak at
+     *   `shapingTicks` is used
+     * * *shapingTicks* (real, default: 10): shaping time of the default
+     *   response
+     * * *deconvolute* (boolean, default: true): measures the deconvolution
+     * * *logEvents* (boolean, default: false): also log each event
+     */
+    class BenchSignalShaping: public art::EDAnalyzer {
+        public:
+
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<art::InputTag> wires{
+          Name("wires"),
+          Comment("tag of the recob::Wire data product to process")
+          };
+
+        fhicl::Sequence<double> response{
+          Name("response"),
+          Comment("response function, one value per tick"),
+          std::vector<double>{}
+          };
+
+        fhicl::Atom<double> shapingTicks{
+          Name("shapingTicks"),
+          Comment("shaping time of the default response [ticks]"),
+          10.0
+          };
+
+        fhicl::Atom<bool> deconvolute{
+          Name("deconvolute"),
+          Comment("whether to measure also the deconvolution"),
+          true
+          };
+
+        fhicl::Atom<bool> logEvents{
+          Name("logEvents"),
+          Comment("whether to log the measurements of each event"),
+          false
+          };
+
+      }; // struct Config
+
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+      explicit BenchSignalShaping(Parameters const& config);
+
+      virtual void analyze(art::Event const& event) override;
+
+      virtual void endJob() override;
+
+        private:
+      art::InputTag fWiresTag; ///< input wires
+      std::vector<double> fResponse; ///< response function
+      double fShapingTicks; ///< shaping time of the default response
+      bool fDeconvolute; ///< whether to measure the deconvolution
+      bool fLogEvents; ///< whether to log each event
+
+      std::unique_ptr<util::SignalShaping> fShaping; ///< shaping in use
+      int fShapingSize = 0; ///< FFT size `fShaping` was configured for
+
+      double fChecksum = 0.; ///< sum of the results, keeps them alive
+
+      BenchmarkSummary fSummary; ///< collected measurements
+
+      /// Configures the shaping for the current size of the FFT service
+      util::SignalShaping const& shaping();
+
+      /// Runs `process` on the dense signal of each wire
+      template <typename Process>
+      std::size_t processWires
+        (std::vector<recob::Wire> const& wires, Process process);
+
+    }; // class BenchSignalShaping
+
+  } // namespace bench
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+lar::bench::BenchSignalShaping::BenchSignalShaping(Parameters const& config)
+  : art::EDAnalyzer(config)
+  , fWiresTag(config().wires())
+  , fResponse(config().response())
+  , fShapingTicks(config().shapingTicks())
+  , fDeconvolute(config().deconvolute())
+  , fLogEvents(config().logEvents())
+  , fSummary("BenchSignalShaping", "wires")
+  {}
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchSignalShaping::analyze(art::Event const& event) {
+
+  auto const& wires
+    = *(event.getValidHandle<std::vector<recob::Wire>>(fWiresTag));
+  util::SignalShaping const& shaper = shaping();
+
+  Measurement const signal = fSummary.measure("signal",
+    [&](){ return processWires(wires, [](std::vector<float>&){}); }
+    );
+
+  Measurement const convolution = fSummary.measure("convolution", [&](){
+    return processWires
+      (wires, [&shaper](std::vector<float>& s){ shaper.Convolute(s); });
+  });
+
+  Measurement deconvolution;
+  if (fDeconvolute) {
+    deconvolution = fSummary.measure("deconvolution", [&](){
+      return processWires
+        (wires, [&shaper](std::vector<float>& s){ shaper.Deconvolute(s); });
+    });
+  } // if deconvolution
+
+  if (fLogEvents) {
+    mf::LogInfo log("BenchSignalShaping");
+    log << event.id()
+      << "\n  [signal] " << signal
+      << "\n  [convolution] " << convolution;
+    if (fDeconvolute) log << "\n  [deconvolution] " << deconvolution;
+  } // if log
+
+} // lar::bench::BenchSignalShaping::analyze()
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchSignalShaping::endJob() {
+  mf::LogInfo("BenchSignalShaping") << fSummary
+    << "\n(checksum: " << fChecksum << ")";
+} // lar::bench::BenchSignalShaping::endJob()
+
+
+//------------------------------------------------------------------------------
+util::SignalShaping const& lar::bench::BenchSignalShaping::shaping() {
+
+  art::ServiceHandle<util::LArFFT const> fft;
+  int const size = fft->FFTSize();
+  if (fShaping && (size == fShapingSize)) return *fShaping;
+
+  std::vector<double> response = fResponse;
+  if (response.empty()) {
+    // unipolar response (t/tau)^2 exp(-t/tau), peaking at 2 tau
+    double const tau = fShapingTicks / 2.0;
+    response.resize(size);
+    for (int t = 0; t < size; ++t) {
+      double const x = t / tau;
+      response[t] = x * x * std::exp(-x);
+    }
+  } // if default response
+
+  fShaping = std::make_unique<util::SignalShaping>();
+  fShaping->AddResponseFunction(response);
+  fShaping->AddFilterFunction
+    (std::vector<TComplex>(size / 2 + 1, TComplex(1.0, 0.0)));
+  fShaping->LockResponse();
+  if (fDeconvolute) fShaping->CalculateDeconvKernel();
+  fShapingSize = size;
+
+  return *fShaping;
+} // lar::bench::BenchSignalShaping::shaping()
+
+
+//------------------------------------------------------------------------------
+template <typename Process>
+std::size_t lar::bench::BenchSignalShaping::processWires
+  (std::vector<recob::Wire> const& wires, Process process)
+{
+  double sum = 0.;
+  for (recob::Wire const& wire: wires) {
+    std::vector<float> signal = wire.Signal();
+    signal.resize(fShapingSize, 0.0f);
+    process(signal);
+    sum += signal[signal.size() / 2];
+  } // for wires
+  fChecksum += sum;
+  return wires.size();
+} // lar::bench::BenchSignalShaping::processWires()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(lar::bench::BenchSignalShaping)
@@ -0,0 +1,129 @@
+/**
+ * @file   BenchmarkSummary.cxx
+ * @brief  Collection of per-event costs of the benchmark modules
+ * @date   October 14, 2026
+ * @see    BenchmarkSummary.h
+ */
+
+// library header
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::find_if()
+#include <ios> // std::fixed
+#include <iomanip> // std::setprecision()
+#include <utility> // std::move()
+
+
+// provided by the allocation hook library, if preloaded
+extern "C" void lardata_bench_allocation_counts
+  (unsigned long long* count, unsigned long long* bytes)
+  __attribute__((weak));
+
+
+//------------------------------------------------------------------------------
+bool lar::bench::allocationCountsAvailable()
+  { return lardata_bench_allocation_counts != nullptr; }
+
+
+lar::bench::AllocationCounts lar::bench::currentAllocationCounts() {
+  AllocationCounts counts;
+  if (allocationCountsAvailable())
+    lardata_bench_allocation_counts(&counts.count, &counts.bytes);
+  return counts;
+} // lar::bench::currentAllocationCounts()
+
+
+//------------------------------------------------------------------------------
+std::ostream& lar::bench::operator<<
+  (std::ostream& out, Measurement const& m)
+{
+  out << std::fixed << std::setprecision(3) << (m.seconds * 1e3) << " ms, "
+    << m.items << " items";
+  if (m.seconds > 0.)
+    out << " (" << std::setprecision(0) << (m.items / m.seconds) << "/s)";
+  if (allocationCountsAvailable()) {
+    out << ", " << m.allocations.count << " allocations ("
+      << m.allocations.bytes << " bytes)";
+  }
+  return out;
+} // lar::bench::operator<< (Measurement)
+
+
+//------------------------------------------------------------------------------
+lar::bench::BenchmarkSummary::BenchmarkSummary
+  (std::string name, std::string itemName /* = "items" */)
+  : fName(std::move(name)), fItemName(std::move(itemName))
+  {}
+
+
+//------------------------------------------------------------------------------
+lar::bench::Measurement const& lar::bench::BenchmarkSummary::record
+  (std::string const& section, Measurement const& measurement)
+{
+  SectionStats_t& stats = sectionStats(section);
+  stats.seconds.add(measurement.seconds);
+  stats.secondsRange.add(measurement.seconds);
+  stats.allocations.add(double(measurement.allocations.count));
+  stats.bytes.add(double(measurement.allocations.bytes));
+  stats.items += measurement.items;
+  fLast = measurement;
+  return fLast;
+} // lar::bench::BenchmarkSummary::record()
+
+
+//------------------------------------------------------------------------------
+auto lar::bench::BenchmarkSummary::section(std::string const& name) const
+  -> SectionStats_t const*
+{
+  auto const iSection = std::find_if(fSections.begin(), fSections.end(),
+    [&name](SectionStats_t const& stats){ return stats.name == name; });
+  return (iSection == fSections.end())? nullptr: &*iSection;
+} // lar::bench::BenchmarkSummary::section()
+
+
+//------------------------------------------------------------------------------
+void lar::bench::BenchmarkSummary::print(std::ostream& out) const {
+
+  out << "Benchmark '" << fName << "': " << fSections.size() << " sections";
+  if (!allocationCountsAvailable()) {
+    out << " (allocations not counted:"
+      " lardata_ArtDataHelper_Benchmarks_AllocationHook not preloaded)";
+  }
+
+  for (SectionStats_t const& stats: fSections) {
+    double const totalTime = stats.seconds.Sum();
+    out << "\n  '" << stats.name << "' on " << stats.seconds.N() << " events:"
+      << std::fixed << std::setprecision(3)
+      << "\n    time/event: " << (stats.seconds.Average() * 1e3)
+      << " +/- " << (stats.seconds.RMS() * 1e3) << " ms (range "
+      << (stats.secondsRange.min() * 1e3) << " -- "
+      << (stats.secondsRange.max() * 1e3) << " ms)"
+      << "\n    " << fItemName << "/event: "
+      << (double(stats.items) / stats.seconds.N())
+      << "; throughput: " << std::setprecision(0)
+      << ((totalTime > 0.)? (stats.items / totalTime): 0.)
+      << " " << fItemName << "/s";
+    if (allocationCountsAvailable()) {
+      out << "\n    allocations/event: " << std::setprecision(1)
+        << stats.allocations.Average()
+        << " (" << std::setprecision(0) << stats.bytes.Average() << " bytes)";
+    }
+  } // for sections
+
+} // lar::bench::BenchmarkSummary::print()
+
+
+//------------------------------------------------------------------------------
+auto lar::bench::BenchmarkSummary::sectionStats(std::string const& name)
+  -> SectionStats_t&
+{
+  for (SectionStats_t& stats: fSections)
+    if (stats.name == name) return stats;
+  fSections.emplace_back();
+  fSections.back().name = name;
+  return fSections.back();
+} // lar::bench::BenchmarkSummary::sectionStats()
+
+
+//------------------------------------------------------------------------------
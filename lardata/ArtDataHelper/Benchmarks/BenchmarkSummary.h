@@ -0,0 +1,180 @@
+/**
+ * @file   BenchmarkSummary.h
+ * @brief  Collection of per-event costs of the benchmark modules
+ * @date   October 14, 2026
+ * @see    BenchmarkSummary.cxx, AllocationHook.cxx
+ *
+ * The benchmark modules (`BenchHitCreator`, `BenchProxyTracks`,
+ * `BenchFindManyInChainP` and `BenchSignalShaping`) exercise a lardata helper
+ * on the data products of each event, and report their measurements through
+ * a `lar::bench::BenchmarkSummary` object.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_BENCHMARKS_BENCHMARKSUMMARY_H
+#define LARDATA_ARTDATAHELPER_BENCHMARKS_BENCHMARKSUMMARY_H 1
+
+// LArSoft libraries
+#include "lardataalg/Utilities/StatCollector.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef> // std::size_t
+
+
+namespace lar {
+
+  /// Utilities for the benchmark modules
+  namespace bench {
+
+    /// Number and total size of the memory allocations
+    struct AllocationCounts {
+      unsigned long long count = 0U; ///< number of allocations
+      unsigned long long bytes = 0U; ///< total allocated bytes
+    }; // struct AllocationCounts
+
+    /**
+     * @brief Returns whether the allocations are being counted.
+     *
+     * The allocations are counted only when the replacement of the global
+     * `operator new` from the library
+     * `lardata_ArtDataHelper_Benchmarks_AllocationHook` is in use, that is
+     * when the job is run with that library in `LD_PRELOAD`.
+     */
+    bool allocationCountsAvailable();
+
+    /// Returns the allocations since the start of the job (all threads)
+    /// @return the counts, all `0` if `allocationCountsAvailable()` is false
+    AllocationCounts currentAllocationCounts();
+
+
+    /// Cost of one run of a benchmarked helper
+    struct Measurement {
+      double seconds = 0.; ///< wall time [s]
+      AllocationCounts allocations; ///< allocations during the run
+      std::size_t items = 0U; ///< number of processed items
+    }; // struct Measurement
+
+    /// Prints a one-line summary of the measurement
+    std::ostream& operator<< (std::ostream& out, Measurement const& m);
+
+
+    /**
+     * @brief Collects the costs of the benchmarked helpers, event by event.
+     *
+     * A benchmark module measures one or more _sections_ (for example, two
+     * different ways to perform the same task) on each event.
+     * Each section is measured with `measure()`: the wall time and the
+     * allocations of the measured call are recorded, together with the
+     * number of items (hits, tracks...) it reports to have processed.
+     *
+     * Example:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * lar::bench::Measurement const& m = summary.measure("copy", [&](){
+     *     std::vector<recob::Hit> copy(hits.begin(), hits.end());
+     *     return copy.size();
+     *   });
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The end-of-job summary, printed to a stream with `operator<<`, reports
+     * for each section the average and RMS of the time per event, the
+     * allocations per event, and the throughput (items per second).
+     *
+     * The allocations are counted in all the threads, including the ones of
+     * other modules running concurrently; reliable counts require a job with
+     * a single thread.
+     */
+    class BenchmarkSummary {
+        public:
+
+      /// Collected information about one section
+      struct SectionStats_t {
+        std::string name; ///< name of the section
+        lar::util::StatCollector<double> seconds; ///< time per event [s]
+        lar::util::MinMaxCollector<double> secondsRange; ///< time extrema
+        lar::util::StatCollector<double> allocations; ///< allocations/event
+        lar::util::StatCollector<double> bytes; ///< allocated bytes/event
+        unsigned long long items = 0U; ///< total processed items
+      }; // struct SectionStats_t
+
+      /// Constructor: `itemName` is the unit of the throughput (plural)
+      explicit BenchmarkSummary
+        (std::string name, std::string itemName = "items");
+
+      /**
+       * @brief Runs and measures a section of the benchmark.
+       * @tparam Func type of callable returning the number of items
+       * @param section name of the section
+       * @param func the code to be measured
+       * @return the measurement of this run
+       */
+      template <typename Func>
+      Measurement const& measure(std::string const& section, Func&& func);
+
+      /// Records a measurement made elsewhere
+      Measurement const& record
+        (std::string const& section, Measurement const& measurement);
+
+      /// Returns the name of the benchmark
+      std::string const& name() const { return fName; }
+
+      /// Returns the number of sections measured so far
+      std::size_t nSections() const { return fSections.size(); }
+
+      /// Returns the statistics of the section with the specified name
+      /// @return a pointer to the statistics, `nullptr` if not present
+      SectionStats_t const* section(std::string const& name) const;
+
+      /// Prints the summary of all the sections, in order of first appearance
+      void print(std::ostream& out) const;
+
+
+        private:
+      using Clock_t = std::chrono::steady_clock;
+
+      std::string fName; ///< name of the benchmark
+      std::string fItemName; ///< name of the processed items
+      std::vector<SectionStats_t> fSections; ///< statistics of each section
+      Measurement fLast; ///< last recorded measurement
+
+      /// Returns the statistics of the section, creating them if needed
+      SectionStats_t& sectionStats(std::string const& name);
+
+    }; // class BenchmarkSummary
+
+
+    /// Prints the summary of all the benchmark sections
+    inline std::ostream& operator<<
+      (std::ostream& out, BenchmarkSummary const& summary)
+      { summary.print(out); return out; }
+
+  } // namespace bench
+
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+template <typename Func>
+lar::bench::Measurement const& lar::bench::BenchmarkSummary::measure
+  (std::string const& section, Func&& func)
+{
+  Measurement m;
+  AllocationCounts const startAllocs = currentAllocationCounts();
+  auto const start = Clock_t::now();
+
+  m.items = static_cast<std::size_t>(func());
+
+  auto const stop = Clock_t::now();
+  AllocationCounts const stopAllocs = currentAllocationCounts();
+
+  m.seconds = std::chrono::duration<double>(stop - start).count();
+  m.allocations.count = stopAllocs.count - startAllocs.count;
+  m.allocations.bytes = stopAllocs.bytes - startAllocs.bytes;
+  return record(section, m);
+} // lar::bench::BenchmarkSummary::measure()
+
+
+#endif // LARDATA_ARTDATAHELPER_BENCHMARKS_BENCHMARKSUMMARY_H
@@ -38,14 +38,24 @@ recob::ChargedSpacePointCollectionCreator::forPtrs
  std::string const& instanceName /* = {} */)
 {
   ChargedSpacePointCollectionCreator creator(event, instanceName);
-  creator.fSpacePointPtrMaker = std::make_unique<art::PtrMaker<recob::SpacePoint>>
-    (event, instanceName);
-  creator.fChargePtrMaker = std::make_unique<art::PtrMaker<recob::PointCharge>>
-    (event, instanceName);
+  creator.fMakePointers = true; // pointer makers are created on first use
   return creator;
 } // ChargedSpacePointCollectionCreator(ProducesCollector)
 
 
+//------------------------------------------------------------------------------
+recob::ChargedSpacePointCollectionCreator
+recob::ChargedSpacePointCollectionCreator::forPtrs
+(util::PtrMakerRegistry& ptrMakers,
+ std::string const& instanceName /* = {} */)
+{
+  ChargedSpacePointCollectionCreator creator
+    = forPtrs(ptrMakers.event(), instanceName);
+  creator.fPtrMakers = &ptrMakers;
+  return creator;
+} // ChargedSpacePointCollectionCreator::forPtrs(PtrMakerRegistry)
+
+
 //------------------------------------------------------------------------------
 void recob::ChargedSpacePointCollectionCreator::add
   (recob::SpacePoint const& spacePoint, recob::PointCharge const& charge)
@@ -100,13 +110,8 @@ void recob::ChargedSpacePointCollectionCreator::addAll(
     *fCharges = std::move(charges);
   }
   else {
-    fSpacePoints->reserve(fSpacePoints->size() + spacePoints.size());
-    for (auto&& obj: spacePoints) fSpacePoints->push_back(std::move(obj));
-    spacePoints.clear();
-
-    fCharges->reserve(fCharges->size() + charges.size());
-    for (auto&& obj: charges) fCharges->push_back(std::move(obj));
-    charges.clear();
+    moveAppend(*fSpacePoints, std::move(spacePoints));
+    moveAppend(*fCharges, std::move(charges));
   }
 
   assert(fSpacePoints->size() == fCharges->size());
@@ -144,6 +149,61 @@ void recob::ChargedSpacePointCollectionCreator::addAll(
 } // recob::ChargedSpacePointCollectionCreator::addAll()
 
 
+//------------------------------------------------------------------------------
+void recob::ChargedSpacePointCollectionCreator::addColumns(
+  std::vector<double> const& positions,
+  std::vector<double> const& errors,
+  std::vector<double> const& chi2,
+  std::vector<recob::PointCharge::Charge_t> const& charges,
+  int firstID
+  )
+{
+  // if these assertion fail, addColumns() is being called after put()
+  assert(fSpacePoints);
+  assert(fCharges);
+
+  std::size_t const n = charges.size();
+  if ((positions.size() != 3U * n)
+    || (!errors.empty() && (errors.size() != 6U * n))
+    || (!chi2.empty() && (chi2.size() != n))
+  ) {
+    throw cet::exception("ChargedSpacePointCollectionCreator")
+      << "Input columns of inconsistent size for " << n << " points:"
+      << " " << positions.size() << " positions (" << (3U * n) << " expected),"
+      << " " << errors.size() << " errors (0 or " << (6U * n) << " expected),"
+      << " " << chi2.size() << " chi2 (0 or " << n << " expected)"
+      << "\n";
+  }
+
+  reserve(size() + n);
+
+  Double32_t const noErrors[6U] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  for (std::size_t i = 0; i < n; ++i) {
+    fSpacePoints->emplace_back(
+      positions.data() + 3U * i,
+      errors.empty()? noErrors: errors.data() + 6U * i,
+      chi2.empty()? 0.0: chi2[i],
+      firstID + static_cast<int>(i)
+      );
+    fCharges->emplace_back(charges[i]);
+  } // for
+
+  assert(fSpacePoints->size() == fCharges->size());
+
+} // recob::ChargedSpacePointCollectionCreator::addColumns()
+
+
+//------------------------------------------------------------------------------
+void recob::ChargedSpacePointCollectionCreator::reserve(std::size_t n) {
+  // if these assertion fail, reserve() is being called after put()
+  assert(fSpacePoints);
+  assert(fCharges);
+
+  fSpacePoints->reserve(n);
+  fCharges->reserve(n);
+} // recob::ChargedSpacePointCollectionCreator::reserve()
+
+
 //------------------------------------------------------------------------------
     /// Puts all data products into the event, leaving the creator `empty()`.
 void recob::ChargedSpacePointCollectionCreator::put() {
@@ -172,8 +232,15 @@ art::Ptr<recob::SpacePoint>
 recob::ChargedSpacePointCollectionCreator::spacePointPtr
   (std::size_t i) const
 {
-  return fSpacePointPtrMaker
-    ? (*fSpacePointPtrMaker)(i): art::Ptr<recob::SpacePoint>{};
+  if (!fMakePointers) return {};
+  if (!fSpacePointPtrMaker) {
+    fSpacePointPtrMaker = fPtrMakers
+      ? std::make_unique<art::PtrMaker<recob::SpacePoint>>
+        (fPtrMakers->maker<recob::SpacePoint>(fInstanceName))
+      : std::make_unique<art::PtrMaker<recob::SpacePoint>>
+        (fEvent, fInstanceName);
+  }
+  return (*fSpacePointPtrMaker)(i);
 } // recob::ChargedSpacePointCollectionCreator::spacePointPtr()
 
 
@@ -182,7 +249,15 @@ art::Ptr<recob::PointCharge>
 recob::ChargedSpacePointCollectionCreator::chargePtr
   (std::size_t i) const
 {
-  return fChargePtrMaker? (*fChargePtrMaker)(i): art::Ptr<recob::PointCharge>{};
+  if (!fMakePointers) return {};
+  if (!fChargePtrMaker) {
+    fChargePtrMaker = fPtrMakers
+      ? std::make_unique<art::PtrMaker<recob::PointCharge>>
+        (fPtrMakers->maker<recob::PointCharge>(fInstanceName))
+      : std::make_unique<art::PtrMaker<recob::PointCharge>>
+        (fEvent, fInstanceName);
+  }
+  return (*fChargePtrMaker)(i);
 } // recob::ChargedSpacePointCollectionCreator::chargePtr()
 
 
@@ -14,6 +14,7 @@
 #define LARDATA_ARTDATAHELPER_CHARGEDSPACEPOINTCREATOR_H
 
 // LArSoft libraries
+#include "lardata/Utilities/PtrMakerRegistry.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lardataobj/RecoBase/PointCharge.h"
 
@@ -24,7 +25,10 @@
 // C/C++ standard libraries
 #include <vector>
 #include <memory> // std::unique_ptr<>
+#include <iterator> // std::make_move_iterator()
 #include <type_traits> // std::enable_if_t, ...
+#include <utility> // std::forward()
+#include <cassert>
 #include <cstdlib> // std::size_t
 
 namespace art { class Event; class ProducesCollector; }
@@ -174,6 +178,26 @@ namespace recob {
    * } // MyProducer::produce()
    * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
    *
+   * The objects can also be constructed directly in the collections, with
+   * `emplace()`: the charge comes first, followed by the arguments of the
+   * `recob::SpacePoint` constructor:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * spacePoints.emplace(charge, xyz, errXYZ, chi2, spacePoints.size());
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   *
+   * Algorithms producing many points may prefer to keep their results in
+   * columns (all positions, all charges...) rather than in `recob::SpacePoint`
+   * objects: `addColumns()` creates all the space points and charges from
+   * them in a single pass, allocating the collections only once:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::vector<double> positions; // x, y and z of each point
+   * std::vector<recob::PointCharge::Charge_t> charges; // one per point
+   *
+   * fSpacePointChargeAlgo->run(positions, charges);
+   *
+   * spacePoints.addColumns(positions, {}, {}, charges, spacePoints.size());
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   *
    *
    *
    * Operations on the collection
@@ -192,7 +216,8 @@ namespace recob {
    *             legal outcome)
    * * if art::Ptr-creation has been enabled (by calling the static 'forPtrs(...)' function), _art_
    *   pointers can be created with `lastSpacePointPtr()`, `lastChargePtr()`, `spacePointPtr()`
-   *   and `chargePtr()` to the elements of the future data products
+   *   and `chargePtr()` to the elements of the future data products;
+   *   the pointer makers are set up only on the first such request
    *
    *
    * Insertion of the data products into the event
@@ -221,6 +246,22 @@ namespace recob {
    * *After `put()` is called*, the object has served its purpose and *can't be
    * used any further*. In this state, `spent()` method will return `true`.
    *
+   *
+   * Memory usage
+   * -------------
+   *
+   * In events with many points, the memory of the data is better held only
+   * once. The collections of the creator are themselves the data products:
+   * `put()` hands them over to the event, and the creator keeps no copy.
+   * When filling with `addAll()` from vectors moved in, no point is copied:
+   * * into an `empty()` creator, the vectors are adopted as they are;
+   * * otherwise, the points are moved into the larger of the two buffers
+   *   when it can host them all (reserving memory in the input vectors for
+   *   the points already in the creator avoids a new allocation), and the
+   *   buffer left over is released immediately.
+   * `emplace()` and `addColumns()` construct the objects directly in the
+   * collections, without intermediate objects.
+   *
    */
   class ChargedSpacePointCollectionCreator {
 
@@ -255,6 +296,19 @@ namespace recob {
     static ChargedSpacePointCollectionCreator forPtrs(art::Event& event,
                                                       std::string const& instanceName = {});
 
+    /**
+     * @brief Static function binding a new object to the event of a registry.
+     * @param ptrMakers registry of pointer makers of the current event
+     * @param instanceName _(default: empty)_ instance name for all data
+     *                     products
+     *
+     * Like `forPtrs(art::Event&, std::string const&)`, but the pointer makers
+     * are taken from `ptrMakers`, and shared with its other users.
+     * The registry must be valid while this object creates pointers.
+     */
+    static ChargedSpacePointCollectionCreator forPtrs
+      (util::PtrMakerRegistry& ptrMakers, std::string const& instanceName = {});
+
     /// @}
     //--- END Constructors ---------------------------------------------------
 
@@ -280,6 +334,19 @@ namespace recob {
     void add(recob::SpacePoint&& spacePoint, recob::PointCharge&& charge);
     //@}
 
+    /**
+     * @brief Constructs a new space point and its charge in the collection.
+     * @tparam SpacePointArgs types of the arguments of the space point
+     * @param charge the charge of the new point
+     * @param spacePointArgs arguments of the `recob::SpacePoint` constructor
+     *
+     * The data is created as the new last element of the collection, with no
+     * temporary object.
+     */
+    template <typename... SpacePointArgs>
+    void emplace
+      (recob::PointCharge::Charge_t charge, SpacePointArgs&&... spacePointArgs);
+
     //@{
     /**
      * @brief Inserts all the space points and associated data from the vectors
@@ -292,7 +359,8 @@ namespace recob {
      * The data is pushed as the new last element of the collection.
      *
      * Data is copied or moved depending on which variant of this method is
-     * used.
+     * used. When moving, the input vectors are left empty, with their memory
+     * released or adopted (see "Memory usage" in the class documentation).
      *
      * No exception safety is offered here.
      */
@@ -306,6 +374,36 @@ namespace recob {
       );
     //@}
 
+    /**
+     * @brief Creates and inserts space points and charges from columns.
+     * @param positions the coordinates of all the points (_x_, _y_ and _z_ of
+     *                  the first point, then of the second, and so on)
+     * @param errors the 6 covariance matrix elements of each point, in the
+     *               same format as `recob::SpacePoint::ErrXYZ()`;
+     *               if empty, all errors are set to `0`
+     * @param chi2 the _chi^2_ of each point; if empty, all are set to `0`
+     * @param charges the charge of each point
+     * @param firstID ID of the first new point; the following points get
+     *                increasing IDs
+     * @throw cet::exception (category `ChargedSpacePointCollectionCreator`)
+     *                       if the input columns are inconsistent
+     *
+     * The number of points is the number of `charges`; `positions` must have
+     * three times as many entries, and `errors` and `chi2` must be either
+     * empty or have respectively six times and once as many.
+     * The data is pushed at the end of the collection.
+     */
+    void addColumns(
+      std::vector<double> const& positions,
+      std::vector<double> const& errors,
+      std::vector<double> const& chi2,
+      std::vector<recob::PointCharge::Charge_t> const& charges,
+      int firstID
+      );
+
+    /// Prepares the collections to host at least `n` space points.
+    void reserve(std::size_t n);
+
     /**
      * @brief Puts all data products into the event, leaving the creator
      *        `empty()`.
@@ -340,7 +438,7 @@ namespace recob {
     bool spent() const { return !fSpacePoints; }
 
     /// Returns whether _art_ pointer making is enabled.
-    bool canMakePointers() const { return bool(fSpacePointPtrMaker); }
+    bool canMakePointers() const { return fMakePointers; }
 
     ///@}
     //--- END Queries and operations -------------------------------------------
@@ -421,23 +519,78 @@ namespace recob {
 
     std::string fInstanceName; ///< Instance name of all the data products.
 
+    bool fMakePointers = false; ///< Whether _art_ pointers are enabled.
+
+    /// Registry to take pointer makers from (if any).
+    util::PtrMakerRegistry* fPtrMakers = nullptr;
+
     /// Space point data.
     std::unique_ptr<std::vector<recob::SpacePoint>> fSpacePoints;
-    /// Space point pointer maker.
-    std::unique_ptr<art::PtrMaker<recob::SpacePoint>> fSpacePointPtrMaker;
+    /// Space point pointer maker (created on first use).
+    mutable std::unique_ptr<art::PtrMaker<recob::SpacePoint>>
+      fSpacePointPtrMaker;
     /// Charge data.
     std::unique_ptr<std::vector<recob::PointCharge>> fCharges;
-    /// Charge pointer maker.
-    std::unique_ptr<art::PtrMaker<recob::PointCharge>> fChargePtrMaker;
+    /// Charge pointer maker (created on first use).
+    mutable std::unique_ptr<art::PtrMaker<recob::PointCharge>> fChargePtrMaker;
 
     /// Returns the index of the last element (undefined if empty).
     std::size_t lastIndex() const { return size() - 1U; }
 
+    /// Moves all the elements of `from` at the end of `to`, releasing the
+    /// memory left over (see `addAll()`).
+    template <typename T>
+    static void moveAppend(std::vector<T>& to, std::vector<T>&& from);
+
   }; // class ChargedSpacePointCollectionCreator
 
 } // namespace recob
 
 
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename... SpacePointArgs>
+void recob::ChargedSpacePointCollectionCreator::emplace
+  (recob::PointCharge::Charge_t charge, SpacePointArgs&&... spacePointArgs)
+{
+  // if these assertion fail, emplace() is being called after put()
+  assert(fSpacePoints);
+  assert(fCharges);
+
+  fSpacePoints->emplace_back(std::forward<SpacePointArgs>(spacePointArgs)...);
+  fCharges->emplace_back(charge);
+
+  assert(fSpacePoints->size() == fCharges->size());
+
+} // recob::ChargedSpacePointCollectionCreator::emplace()
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+void recob::ChargedSpacePointCollectionCreator::moveAppend
+  (std::vector<T>& to, std::vector<T>&& from)
+{
+  std::size_t const n = to.size() + from.size();
+  if ((to.capacity() < n) && (from.capacity() >= n)) {
+    // the input buffer can host everything: the data goes there
+    from.insert(
+      from.begin(),
+      std::make_move_iterator(to.begin()), std::make_move_iterator(to.end())
+      );
+    to.swap(from);
+  }
+  else {
+    to.reserve(n);
+    to.insert(
+      to.end(),
+      std::make_move_iterator(from.begin()), std::make_move_iterator(from.end())
+      );
+  }
+  std::vector<T>().swap(from); // release the memory left over
+} // recob::ChargedSpacePointCollectionCreator::moveAppend()
+
+
 //------------------------------------------------------------------------------
 
 #endif // LARDATA_ARTDATAHELPER_CHARGEDSPACEPOINTCREATOR_H
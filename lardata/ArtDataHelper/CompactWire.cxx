@@ -0,0 +1,162 @@
+/** ****************************************************************************
+ * @file   CompactWire.cxx
+ * @brief  Wire signal stored as 16-bit integers - implementation file
+ * @date   October 14, 2026
+ * @see    CompactWire.h
+ *
+ * ****************************************************************************/
+
+// declaration header
+#include "lardata/ArtDataHelper/CompactWire.h"
+
+// C/C++ standard library
+#include <algorithm> // std::max(), std::copy()
+#include <cmath> // std::abs(), std::lround(), std::isfinite()
+
+// art libraries
+#include "canvas/Utilities/Exception.h"
+
+
+namespace {
+
+  /// Throws if the precision is not allowed
+  void checkPrecision(float precision) {
+    if (precision > 0.0f) return;
+    throw art::Exception(art::errors::Configuration)
+      << "CompactWire: requested precision " << precision
+      << " is not positive\n";
+  } // checkPrecision()
+
+} // local namespace
+
+
+/// Reconstruction base classes
+namespace recob {
+
+  //----------------------------------------------------------------------
+  void CompactWire::ROIView::copyTo(float* dest) const {
+    if (isExact()) {
+      std::copy(exact, exact + size(), dest);
+      return;
+    }
+    float const scale = info->scale;
+    for (std::size_t i = 0; i < size(); ++i)
+      dest[i] = float(quantized[i]) * scale;
+  } // CompactWire::ROIView::copyTo()
+
+
+  //----------------------------------------------------------------------
+  CompactWire::CompactWire(
+    RegionsOfInterest_t const& signal,
+    raw::ChannelID_t channel,
+    geo::View_t view,
+    float precision
+    ):
+    fChannel(channel), fView(view), fNTicks(signal.size()),
+    fPrecision(precision)
+  {
+    checkPrecision(fPrecision);
+    fROIs.reserve(signal.n_ranges());
+    for (auto const& range: signal.get_ranges())
+      addROI(range.begin_index(), &*range.begin(), range.size());
+  } // CompactWire::CompactWire(RegionsOfInterest_t)
+
+
+  //----------------------------------------------------------------------
+  CompactWire::CompactWire(
+    float const* samples,
+    std::vector<WireCreator::FlatROI_t> const& rois,
+    std::size_t nTicks,
+    raw::ChannelID_t channel,
+    geo::View_t view,
+    float precision
+    ):
+    fChannel(channel), fView(view), fNTicks(nTicks), fPrecision(precision)
+  {
+    checkPrecision(fPrecision);
+    fROIs.reserve(rois.size());
+    for (WireCreator::FlatROI_t const& roi: rois)
+      addROI(roi.startTick, samples + roi.offset, roi.nSamples);
+  } // CompactWire::CompactWire(float const*)
+
+
+  //----------------------------------------------------------------------
+  CompactWire::ROIView CompactWire::ROI(std::size_t iROI) const {
+    ROIInfo_t const& info = fROIs[iROI];
+    if (info.scale == 0.0f)
+      return { info, nullptr, fExact.data() + info.offset };
+    else
+      return { info, fQuantized.data() + info.offset, nullptr };
+  } // CompactWire::ROI()
+
+
+  //----------------------------------------------------------------------
+  std::size_t CompactWire::NExactROIs() const {
+    std::size_t n = 0;
+    for (ROIInfo_t const& info: fROIs) if (info.scale == 0.0f) ++n;
+    return n;
+  } // CompactWire::NExactROIs()
+
+
+  //----------------------------------------------------------------------
+  std::size_t CompactWire::SampleMemory() const {
+    return fROIs.size() * sizeof(ROIInfo_t)
+      + fQuantized.size() * sizeof(Quantized_t)
+      + fExact.size() * sizeof(float);
+  } // CompactWire::SampleMemory()
+
+
+  //----------------------------------------------------------------------
+  CompactWire::RegionsOfInterest_t CompactWire::SignalROI() const {
+    RegionsOfInterest_t signal;
+    std::vector<float> buffer;
+    for (std::size_t iROI = 0; iROI < NROIs(); ++iROI) {
+      ROIView const roi = ROI(iROI);
+      buffer.resize(roi.size());
+      roi.copyTo(buffer.data());
+      signal.add_range(roi.startTick(), buffer.begin(), buffer.end());
+    } // for
+    signal.resize(fNTicks);
+    return signal;
+  } // CompactWire::SignalROI()
+
+
+  //----------------------------------------------------------------------
+  void CompactWire::addROI
+    (std::size_t startTick, float const* begin, std::size_t nSamples)
+  {
+    float const* const end = begin + nSamples;
+
+    // the largest sample takes the full range
+    float maxAbs = 0.0f;
+    bool finite = true;
+    for (float const* sample = begin; sample != end; ++sample) {
+      if (!std::isfinite(*sample)) finite = false;
+      maxAbs = std::max(maxAbs, std::abs(*sample));
+    }
+    float const scale = (maxAbs > 0.0f)? maxAbs / MaxQuantized: fPrecision;
+
+    // quantization, unless the error would exceed the precision
+    std::size_t const offset = fQuantized.size();
+    if (finite && (scale <= 2.0f * fPrecision)) {
+      fQuantized.reserve(offset + nSamples);
+      bool precise = true;
+      for (float const* sample = begin; sample != end; ++sample) {
+        auto const quantum = static_cast<Quantized_t>(std::lround(*sample / scale));
+        if (std::abs(float(quantum) * scale - *sample) > fPrecision)
+          precise = false;
+        fQuantized.push_back(quantum);
+      } // for
+      if (precise) {
+        fROIs.push_back({ startTick, nSamples, offset, scale });
+        return;
+      }
+      fQuantized.resize(offset);
+    } // if quantization
+
+    fROIs.push_back({ startTick, nSamples, fExact.size(), 0.0f });
+    fExact.insert(fExact.end(), begin, end);
+
+  } // CompactWire::addROI()
+
+} // namespace recob
@@ -0,0 +1,258 @@
+/** ****************************************************************************
+ * @file   CompactWire.h
+ * @brief  Wire signal stored as 16-bit integers, and its creator
+ * @date   October 14, 2026
+ * @see    CompactWire.cxx WireCreator.h
+ *
+ * ****************************************************************************/
+
+#ifndef LARDATA_ARTDATAHELPER_COMPACTWIRE_H
+#define LARDATA_ARTDATAHELPER_COMPACTWIRE_H
+
+// C/C++ standard library
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int16_t
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/WireCreator.h" // recob::WireCreator::FlatROI_t
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::View_t
+#include "lardataobj/RecoBase/Wire.h"
+
+/// Reconstruction base classes
+namespace recob {
+
+  /**
+   * @brief Signal of a wire, with the samples quantized to 16 bits
+   * @see CompactWireCreator
+   *
+   * This is a compact version of `recob::Wire`, for intermediate results
+   * which are consumed in the same job. Each sample of a region of interest
+   * is stored as a 16-bit integer, which multiplied by the scale of its
+   * region gives back the sample value. The scale of each region is chosen
+   * so that the largest sample is represented at full range, but no region
+   * is represented with an error larger than the precision the wire was
+   * created with: the regions which would be are stored as `float`, exactly.
+   * For a typical signal the bound is met by all the regions, and the
+   * storage of the samples is half of the one of `recob::Wire`.
+   *
+   * The samples are decoded on the fly by the `ROIView` of each region:
+   *
+   *     for (std::size_t iROI = 0; iROI < wire.NROIs(); ++iROI) {
+   *       recob::CompactWire::ROIView const roi = wire.ROI(iROI);
+   *       for (std::size_t i = 0; i < roi.size(); ++i)
+   *         charge += roi[i]; // sample at tick `roi.startTick() + i`
+   *     }
+   *
+   * and `toWire()` decodes the whole wire into a standard `recob::Wire`.
+   */
+  class CompactWire {
+    public:
+      /// Alias for the type of regions of interest of the standard wire
+      using RegionsOfInterest_t = Wire::RegionsOfInterest_t;
+
+      /// Type of a quantized sample
+      using Quantized_t = std::int16_t;
+
+      /// Largest magnitude of a quantized sample
+      static constexpr Quantized_t MaxQuantized = 32767;
+
+      /// Description of a region of interest
+      struct ROIInfo_t {
+        std::size_t startTick; ///< Tick of the first sample of the region.
+        std::size_t nSamples; ///< Number of samples in the region.
+        std::size_t offset; ///< Position of the first sample in its storage.
+        float scale; ///< Value of a quantum, `0` if stored exactly.
+      }; // struct ROIInfo_t
+
+      /// Read-only view of the decoded samples of a region of interest
+      class ROIView {
+        public:
+          /// Returns the tick of the first sample of the region
+          std::size_t startTick() const { return info->startTick; }
+
+          /// Returns the number of samples in the region
+          std::size_t size() const { return info->nSamples; }
+
+          /// Returns whether the region is stored as `float`, exactly
+          bool isExact() const { return info->scale == 0.0f; }
+
+          /// Returns the decoded value of the sample `i` of the region
+          float operator[] (std::size_t i) const
+            { return isExact()? exact[i]: float(quantized[i]) * info->scale; }
+
+          /// Decodes all the samples into the buffer starting at `dest`
+          void copyTo(float* dest) const;
+
+        private:
+          friend class CompactWire;
+
+          ROIInfo_t const* info; ///< Description of the region.
+          Quantized_t const* quantized; ///< First quantized sample, if any.
+          float const* exact; ///< First exact sample, if any.
+
+          ROIView(ROIInfo_t const& info, Quantized_t const* quantized, float const* exact)
+            : info(&info), quantized(quantized), exact(exact) {}
+
+      }; // class ROIView
+
+
+      /// Constructor: empty wire
+      CompactWire() = default;
+
+      /**
+       * @brief Constructor: quantizes the specified signal
+       * @param signal signal organized in regions of interest
+       * @param channel the ID of the channel
+       * @param view the view the channel belongs to
+       * @param precision largest error allowed on each sample
+       * @throw art::Exception (`art::errors::Configuration`) if `precision`
+       *        is not positive
+       */
+      CompactWire(
+        RegionsOfInterest_t const& signal,
+        raw::ChannelID_t channel,
+        geo::View_t view,
+        float precision
+        );
+
+      /**
+       * @brief Constructor: quantizes the signal from a flat buffer of samples
+       * @param samples pointer to the buffer with the samples of all regions
+       * @param rois position of each region in the buffer and in the waveform
+       * @param nTicks length of the full waveform (TDC ticks)
+       * @param channel the ID of the channel
+       * @param view the view the channel belongs to
+       * @param precision largest error allowed on each sample
+       * @throw art::Exception (`art::errors::Configuration`) if `precision`
+       *        is not positive
+       * @see WireCreator(float const*, std::vector<FlatROI_t> const&, ...)
+       */
+      CompactWire(
+        float const* samples,
+        std::vector<WireCreator::FlatROI_t> const& rois,
+        std::size_t nTicks,
+        raw::ChannelID_t channel,
+        geo::View_t view,
+        float precision
+        );
+
+      /// Returns the ID of the channel
+      raw::ChannelID_t Channel() const { return fChannel; }
+
+      /// Returns the view the channel belongs to
+      geo::View_t View() const { return fView; }
+
+      /// Returns the length of the full waveform (TDC ticks)
+      std::size_t NSignal() const { return fNTicks; }
+
+      /// Returns the largest error allowed on each sample
+      float Precision() const { return fPrecision; }
+
+      /// Returns the number of regions of interest
+      std::size_t NROIs() const { return fROIs.size(); }
+
+      /// Returns the description of all the regions of interest
+      std::vector<ROIInfo_t> const& ROIInfo() const { return fROIs; }
+
+      /// Returns a view of the decoded samples of the region `iROI`
+      ROIView ROI(std::size_t iROI) const;
+
+      /// Returns the number of regions stored exactly
+      std::size_t NExactROIs() const;
+
+      /// Returns the memory used by the samples and their description [bytes]
+      std::size_t SampleMemory() const;
+
+      /// Returns the decoded signal, organized in regions of interest
+      RegionsOfInterest_t SignalROI() const;
+
+      /// Returns a standard wire with the decoded signal
+      Wire toWire() const { return { SignalROI(), fChannel, fView }; }
+
+    private:
+      raw::ChannelID_t fChannel = raw::InvalidChannelID; ///< Channel ID.
+      geo::View_t fView = geo::kUnknown; ///< View of the channel.
+      std::size_t fNTicks = 0U; ///< Length of the full waveform.
+      float fPrecision = 0.0f; ///< Largest error allowed on each sample.
+
+      std::vector<ROIInfo_t> fROIs; ///< Description of each region.
+      std::vector<Quantized_t> fQuantized; ///< Quantized samples.
+      std::vector<float> fExact; ///< Samples of the regions stored exactly.
+
+      /// Adds a region with the `nSamples` samples starting at `begin`
+      void addROI(std::size_t startTick, float const* begin, std::size_t nSamples);
+
+  }; // class CompactWire
+
+
+  /**
+   * @brief Class managing the creation of a new recob::CompactWire object
+   * @see WireCreator
+   *
+   * This is the same as `WireCreator`, with the samples quantized with the
+   * specified precision (see `CompactWire`):
+   *
+   *     // precision: the largest error allowed, e.g. from configuration
+   *     recob::CompactWireCreator wire
+   *       (samples.data(), rois, nTicks, channel, view, precision);
+   *     wires.push_back(wire.move()); // wire content is not valid any more
+   *
+   */
+  class CompactWireCreator {
+    public:
+      /// Alias for the type of regions of interest of the standard wire
+      using RegionsOfInterest_t = CompactWire::RegionsOfInterest_t;
+
+      /// Alias for the position of a region of interest in a flat buffer
+      using FlatROI_t = WireCreator::FlatROI_t;
+
+      /// Constructor: quantizes the specified signal
+      /// @see CompactWire(RegionsOfInterest_t const&, ...)
+      CompactWireCreator(
+        RegionsOfInterest_t const& sigROIlist,
+        raw::ChannelID_t channel,
+        geo::View_t view,
+        float precision
+        )
+        : wire(sigROIlist, channel, view, precision)
+        {}
+
+      /// Constructor: quantizes the signal of a standard wire
+      CompactWireCreator(Wire const& wire, float precision)
+        : CompactWireCreator
+          (wire.SignalROI(), wire.Channel(), wire.View(), precision)
+        {}
+
+      /// Constructor: quantizes the signal from a flat buffer of samples
+      /// @see CompactWire(float const*, std::vector<FlatROI_t> const&, ...)
+      CompactWireCreator(
+        float const* samples,
+        std::vector<FlatROI_t> const& rois,
+        std::size_t nTicks,
+        raw::ChannelID_t channel,
+        geo::View_t view,
+        float precision
+        )
+        : wire(samples, rois, nTicks, channel, view, precision)
+        {}
+
+      /// Prepares the constructed wire to be moved away
+      /// @see WireCreator::move()
+      CompactWire&& move() { return std::move(wire); }
+
+      /// Returns the constructed wire
+      /// @see WireCreator::copy()
+      CompactWire const& copy() const { return wire; }
+
+    protected:
+
+      CompactWire wire; ///< local instance of the wire being constructed
+
+  }; // class CompactWireCreator
+
+} // namespace recob
+
+#endif // LARDATA_ARTDATAHELPER_COMPACTWIRE_H
@@ -0,0 +1,160 @@
+/**
+ * @file   AsyncDumpWriter.cc
+ * @brief  Buffered output of the dumper modules - implementation file
+ * @date   October 14, 2026
+ * @see    AsyncDumpWriter.h
+ */
+
+// library header
+#include "lardata/ArtDataHelper/Dumpers/AsyncDumpWriter.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <memory> // std::unique_ptr<>
+#include <vector>
+
+
+namespace {
+
+  /// Formatting buffers of the lines being written in the current thread
+  struct LineBuffers {
+    /// buffers (a new line may be started while another line is being written)
+    std::vector<std::unique_ptr<std::ostringstream>> buffers;
+    std::size_t nUsed = 0U; ///< number of buffers in use
+    std::ostringstream const pristine; ///< stream with default format flags
+  }; // struct LineBuffers
+
+  thread_local LineBuffers lineBuffers;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//---  recob::dumper::AsyncDumpWriter::Line
+//---
+recob::dumper::AsyncDumpWriter::Line::Line(AsyncDumpWriter& writer)
+  : fWriter(writer)
+{
+  LineBuffers& buffers = lineBuffers;
+  if (buffers.nUsed == buffers.buffers.size())
+    buffers.buffers.push_back(std::make_unique<std::ostringstream>());
+  fOut = buffers.buffers[buffers.nUsed++].get();
+  fOut->str({});
+  fOut->clear();
+  fOut->copyfmt(buffers.pristine);
+} // recob::dumper::AsyncDumpWriter::Line::Line()
+
+
+//------------------------------------------------------------------------------
+recob::dumper::AsyncDumpWriter::Line::~Line() {
+  fWriter.submit(fOut->str());
+  --lineBuffers.nUsed;
+} // recob::dumper::AsyncDumpWriter::Line::~Line()
+
+
+//------------------------------------------------------------------------------
+//---  recob::dumper::AsyncDumpWriter
+//---
+recob::dumper::AsyncDumpWriter::AsyncDumpWriter(
+  std::string const& fileName, std::string const& category,
+  std::size_t blockSize /* = DefaultBlockSize */
+)
+  : fCategory(category)
+  , fBlockSize(blockSize)
+{
+  if (!fileName.empty()) {
+    fFile.emplace(fileName);
+    if (!*fFile) {
+      throw cet::exception("AsyncDumpWriter")
+        << "Can't create the output file '" << fileName << "'\n";
+    }
+  } // if file
+
+  fBlock.reserve(fBlockSize);
+
+  // the thread is started last, when everything else is ready
+  fThread = std::thread(&AsyncDumpWriter::writeLoop, this);
+} // recob::dumper::AsyncDumpWriter::AsyncDumpWriter()
+
+
+//------------------------------------------------------------------------------
+recob::dumper::AsyncDumpWriter::~AsyncDumpWriter() {
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    queueBlock();
+    fStop = true;
+  }
+  fBlockReady.notify_one();
+  fThread.join();
+  if (fFile) fFile->flush();
+} // recob::dumper::AsyncDumpWriter::~AsyncDumpWriter()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::AsyncDumpWriter::submit(std::string const& text) {
+  std::lock_guard<std::mutex> lock(fMutex);
+  fBlock += text;
+  fBlock += '\n';
+  if (fBlock.size() >= fBlockSize) queueBlock();
+} // recob::dumper::AsyncDumpWriter::submit()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::AsyncDumpWriter::flush() {
+  std::unique_lock<std::mutex> lock(fMutex);
+  queueBlock();
+  fWritten.wait(lock, [this](){ return fQueue.empty() && !fWriting; });
+  if (fFile) fFile->flush();
+} // recob::dumper::AsyncDumpWriter::flush()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::AsyncDumpWriter::queueBlock() {
+  if (fBlock.empty()) return;
+  fQueue.push_back(std::move(fBlock));
+  fBlock = std::string();
+  fBlock.reserve(fBlockSize);
+  fBlockReady.notify_one();
+} // recob::dumper::AsyncDumpWriter::queueBlock()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::AsyncDumpWriter::writeLoop() {
+
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (true) {
+    fBlockReady.wait(lock, [this](){ return fStop || !fQueue.empty(); });
+    if (fQueue.empty()) break; // stop requested, and nothing left to write
+
+    std::string const block = std::move(fQueue.front());
+    fQueue.pop_front();
+    fWriting = true;
+
+    // the writing happens without holding the lock
+    lock.unlock();
+    writeBlock(block);
+    lock.lock();
+
+    fWriting = false;
+    fWritten.notify_all();
+  } // while
+
+} // recob::dumper::AsyncDumpWriter::writeLoop()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::AsyncDumpWriter::writeBlock(std::string const& block) {
+  if (fFile) {
+    fFile->write(block.data(), block.size());
+  }
+  else {
+    // message facility adds its own new line at the end of each message
+    mf::LogVerbatim(fCategory)
+      << block.substr(0, block.empty()? 0: block.size() - 1);
+  }
+} // recob::dumper::AsyncDumpWriter::writeBlock()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+/**
+ * @file   AsyncDumpWriter.h
+ * @brief  Buffered output of the dumper modules, written by a separate thread
+ * @date   October 14, 2026
+ * @see    AsyncDumpWriter.cc
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_DUMPERS_ASYNCDUMPWRITER_H
+#define LARDATA_ARTDATAHELPER_DUMPERS_ASYNCDUMPWRITER_H 1
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility> // std::forward()
+#include <cstddef> // std::size_t
+
+
+namespace recob {
+  namespace dumper {
+
+    /**
+     * @brief Collects dump output in large blocks written by a separate thread
+     *
+     * The dumper modules usually write each line into the message facility
+     * with a separate message, each composed by many small `<<` operations,
+     * and the event processing waits for all of them.
+     * This writer instead collects the lines in a block of text, and when the
+     * block is large enough it hands it to a background thread that writes it
+     * either into a file or into the message facility, as a single message.
+     * The dumper can in the meanwhile proceed.
+     *
+     * Lines are written in a way similar to `mf::LogVerbatim`:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * recob::dumper::AsyncDumpWriter writer("DumpTracks.log", "DumpTracks");
+     *
+     * writer.line() << "Track #" << iTrack << " has " << nHits << " hits";
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * Each line is formatted in a buffer private to the thread, and it is
+     * appended to the current block when complete (that is when the object
+     * returned by `line()` is destroyed).
+     * All the pending output is written on `flush()` and on destruction.
+     */
+    class AsyncDumpWriter {
+        public:
+
+      /// Default size of a block of output [bytes]
+      static constexpr std::size_t DefaultBlockSize = 1U << 20;
+
+      /// A single line of output, submitted to the writer on destruction
+      class Line {
+          public:
+        /// Constructor: starts a line which will go to the specified writer
+        Line(AsyncDumpWriter& writer);
+
+        /// Destructor: submits the line to the writer
+        ~Line();
+
+        Line(Line const&) = delete;
+        Line& operator= (Line const&) = delete;
+
+        /// Adds a value to the line
+        template <typename T>
+        Line& operator<< (T&& value)
+          { *fOut << std::forward<T>(value); return *this; }
+
+          private:
+        AsyncDumpWriter& fWriter; ///< writer to submit the line to
+        std::ostringstream* fOut; ///< buffer for formatting, owned by thread
+
+      }; // class Line
+
+
+      /**
+       * @brief Constructor: opens the output and starts the writing thread
+       * @param fileName name of the output file (empty: message facility)
+       * @param category message facility category, if writing there
+       * @param blockSize output is written in blocks of at least this size
+       * @throw cet::exception (category `"AsyncDumpWriter"`) if the output file
+       *        can't be created
+       */
+      AsyncDumpWriter(
+        std::string const& fileName, std::string const& category,
+        std::size_t blockSize = DefaultBlockSize
+        );
+
+      /// Destructor: writes all the pending output and stops the thread
+      ~AsyncDumpWriter();
+
+      AsyncDumpWriter(AsyncDumpWriter const&) = delete;
+      AsyncDumpWriter& operator= (AsyncDumpWriter const&) = delete;
+
+      /// Returns a new line of output
+      Line line() { return Line(*this); }
+
+      /// Appends a complete line of text to the output
+      void submit(std::string const& text);
+
+      /// Writes all the submitted output, and waits until it's written
+      void flush();
+
+        private:
+      std::string const fCategory; ///< message facility category
+      std::size_t const fBlockSize; ///< minimum size of a block to be written
+      std::optional<std::ofstream> fFile; ///< output file, if any
+
+      std::mutex fMutex; ///< lock for all the following data
+      std::condition_variable fBlockReady; ///< signals blocks to be written
+      std::condition_variable fWritten; ///< signals blocks have been written
+      std::string fBlock; ///< block being filled
+      std::deque<std::string> fQueue; ///< blocks to be written
+      bool fWriting = false; ///< whether the thread is writing a block now
+      bool fStop = false; ///< whether the writing thread should stop
+
+      std::thread fThread; ///< the writing thread
+
+      /// Moves the current block into the queue (mutex must be locked)
+      void queueBlock();
+
+      /// Body of the writing thread
+      void writeLoop();
+
+      /// Writes a block of text into the output
+      void writeBlock(std::string const& block);
+
+    }; // class AsyncDumpWriter
+
+
+    /**
+     * @brief A line of dump output, to a writer or to the message facility
+     *
+     * This object behaves like `mf::LogVerbatim` when no writer is provided,
+     * and like `AsyncDumpWriter::Line` otherwise. It allows dumpers to support
+     * both outputs with the same code:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * recob::dumper::DumpLine(fWriter.get(), fOutputCategory)
+     *   << "Event " << evt.id() << " contains " << n << " particles";
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    class DumpLine {
+        public:
+      /// Constructor: writes into `writer`, or into `category` if no writer
+      DumpLine(AsyncDumpWriter* writer, std::string const& category)
+        {
+          if (writer) fAsync.emplace(*writer);
+          else        fLog.emplace(category);
+        }
+
+      /// Adds a value to the line
+      template <typename T>
+      DumpLine& operator<< (T&& value)
+        {
+          if (fAsync) *fAsync << std::forward<T>(value);
+          else        *fLog << std::forward<T>(value);
+          return *this;
+        }
+
+        private:
+      std::optional<AsyncDumpWriter::Line> fAsync; ///< line to the writer
+      std::optional<mf::LogVerbatim> fLog; ///< line to message facility
+
+    }; // class DumpLine
+
+
+  } // namespace dumper
+} // namespace recob
+
+
+#endif // LARDATA_ARTDATAHELPER_DUMPERS_ASYNCDUMPWRITER_H
@@ -0,0 +1,408 @@
+/**
+ * @file   BinaryDump.cc
+ * @brief  Compact binary output for the dumper modules - implementation file
+ * @date   October 14, 2026
+ * @see    BinaryDump.h
+ */
+
+// library header
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RawData/raw.h" // raw::Uncompress()
+#include "lardataobj/RecoBase/Wire.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::equal()
+#include <cstdint> // std::int16_t, std::int32_t
+
+
+namespace {
+
+  /// Signature at the beginning of each binary dump file
+  constexpr char FileSignature[8] = { 'L', 'A', 'R', 'D', 'U', 'M', 'P', '1' };
+
+  /// Marker after the signature, to detect the byte order
+  constexpr std::uint32_t ByteOrderMarker = 0x01020304;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//---  recob::dumper::BinaryRecordBuffer
+//---
+recob::dumper::BinaryRecordBuffer& recob::dumper::BinaryRecordBuffer::putString
+  (std::string const& s)
+{
+  put<std::uint32_t>(s.size());
+  return putArray(s.data(), s.size());
+} // recob::dumper::BinaryRecordBuffer::putString()
+
+
+//------------------------------------------------------------------------------
+//---  recob::dumper::BinaryRecordReader
+//---
+std::string recob::dumper::BinaryRecordReader::getString() {
+  std::size_t const n = get<std::uint32_t>();
+  checkAvailable(n);
+  std::string s(fData + fPos, n);
+  fPos += n;
+  return s;
+} // recob::dumper::BinaryRecordReader::getString()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::BinaryRecordReader::checkAvailable(std::size_t n) const {
+  if (n <= remaining()) return;
+  throw cet::exception("BinaryDump")
+    << "Attempt to read " << n << " bytes from a record with only "
+    << remaining() << " left\n";
+} // recob::dumper::BinaryRecordReader::checkAvailable()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::BinaryRecordReader::checkCount
+  (std::uint64_t n, std::size_t size) const
+{
+  if (n <= remaining() / size) return;
+  throw cet::exception("BinaryDump")
+    << "Record declares " << n << " values of " << size
+    << " bytes, but it has only " << remaining() << " bytes left\n";
+} // recob::dumper::BinaryRecordReader::checkCount()
+
+
+//------------------------------------------------------------------------------
+//---  recob::dumper::BinaryDumpWriter
+//---
+recob::dumper::BinaryDumpWriter::BinaryDumpWriter(std::string const& fileName)
+  : fFileName(fileName)
+  , fOut(fileName, std::ios::binary | std::ios::trunc)
+{
+  if (!fOut) {
+    throw cet::exception("BinaryDump")
+      << "Can't create the binary dump file '" << fFileName << "'\n";
+  }
+  fOut.write(FileSignature, sizeof(FileSignature));
+  fOut.write
+    (reinterpret_cast<char const*>(&ByteOrderMarker), sizeof(ByteOrderMarker));
+} // recob::dumper::BinaryDumpWriter::BinaryDumpWriter()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::BinaryDumpWriter::writeEvent(
+  std::uint32_t run, std::uint32_t subRun, std::uint32_t event,
+  std::string const& productTag, std::uint64_t nElements
+) {
+  writeRecord(BinaryRecord::Event,
+    buffer().put(run).put(subRun).put(event)
+      .putString(productTag).put(nElements)
+    );
+} // recob::dumper::BinaryDumpWriter::writeEvent()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::BinaryDumpWriter::writeRecord
+  (BinaryRecord type, BinaryRecordBuffer const& buffer)
+{
+  std::uint32_t const recordType = static_cast<std::uint32_t>(type);
+  std::uint64_t const size = buffer.size();
+  fOut.write(reinterpret_cast<char const*>(&recordType), sizeof(recordType));
+  fOut.write(reinterpret_cast<char const*>(&size), sizeof(size));
+  fOut.write(buffer.data(), size);
+  if (!fOut) {
+    throw cet::exception("BinaryDump")
+      << "Error writing into the binary dump file '" << fFileName << "'\n";
+  }
+} // recob::dumper::BinaryDumpWriter::writeRecord()
+
+
+//------------------------------------------------------------------------------
+//---  recob::dumper::BinaryDumpReader
+//---
+recob::dumper::BinaryDumpReader::BinaryDumpReader(std::string const& fileName)
+  : fFileName(fileName)
+  , fIn(fileName, std::ios::binary)
+{
+  if (!fIn) {
+    throw cet::exception("BinaryDump")
+      << "Can't open the binary dump file '" << fFileName << "'\n";
+  }
+  fIn.seekg(0, std::ios::end);
+  fFileSize = fIn.tellg();
+  fIn.seekg(0, std::ios::beg);
+
+  char signature[sizeof(FileSignature)];
+  std::uint32_t marker = 0;
+  fIn.read(signature, sizeof(signature));
+  fIn.read(reinterpret_cast<char*>(&marker), sizeof(marker));
+  if (!fIn || !std::equal(signature, signature + sizeof(signature), FileSignature))
+  {
+    throw cet::exception("BinaryDump")
+      << "File '" << fFileName << "' is not a binary dump file\n";
+  }
+  if (marker != ByteOrderMarker) {
+    throw cet::exception("BinaryDump")
+      << "File '" << fFileName
+      << "' was written on a machine with a different byte order\n";
+  }
+} // recob::dumper::BinaryDumpReader::BinaryDumpReader()
+
+
+//------------------------------------------------------------------------------
+bool recob::dumper::BinaryDumpReader::next() {
+
+  std::uint32_t recordType = 0;
+  if (!fIn.read(reinterpret_cast<char*>(&recordType), sizeof(recordType)))
+    return false; // end of file
+
+  // the size is checked against the rest of the file before allocating
+  std::uint64_t size = 0;
+  if (fIn.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+    std::uint64_t const left
+      = fFileSize - static_cast<std::uint64_t>(fIn.tellg());
+    if (size > left) {
+      throw cet::exception("BinaryDump")
+        << "Truncated record found in binary dump file '" << fFileName
+        << "': " << size << " bytes declared, " << left << " left\n";
+    }
+    fPayload.resize(size);
+    fIn.read(fPayload.data(), fPayload.size());
+  }
+  if (!fIn) {
+    throw cet::exception("BinaryDump")
+      << "Truncated record found in binary dump file '" << fFileName << "'\n";
+  }
+  fType = static_cast<BinaryRecord>(recordType);
+  return true;
+
+} // recob::dumper::BinaryDumpReader::next()
+
+
+//------------------------------------------------------------------------------
+//---  record writers
+//---
+void recob::dumper::writeRawDigit
+  (BinaryDumpWriter& out, raw::RawDigit const& digits)
+{
+  raw::RawDigit::ADCvector_t ADCs(digits.Samples());
+  raw::Uncompress(digits.ADCs(), ADCs, digits.Compression());
+
+  out.writeRecord(BinaryRecord::RawDigit,
+    out.buffer()
+      .put<std::uint32_t>(digits.Channel())
+      .put<std::uint64_t>(digits.Samples())
+      .put<std::int32_t>(digits.Compression())
+      .put<std::uint64_t>(digits.NADC())
+      .put<std::uint64_t>(ADCs.size())
+      .putArray(ADCs.data(), ADCs.size())
+    );
+} // recob::dumper::writeRawDigit()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::writeWire(BinaryDumpWriter& out, recob::Wire const& wire) {
+
+  recob::Wire::RegionsOfInterest_t const& RoIs = wire.SignalROI();
+
+  BinaryRecordBuffer& buffer = out.buffer()
+    .put<std::uint32_t>(wire.Channel())
+    .put<std::int32_t>(wire.View())
+    .put<std::uint64_t>(wire.NSignal())
+    .put<std::uint64_t>(RoIs.n_ranges());
+  for (auto const& RoI: RoIs.get_ranges()) {
+    buffer.put<std::uint64_t>(RoI.offset).put<std::uint64_t>(RoI.size());
+    if (RoI.size() > 0) buffer.putArray(&*RoI.begin(), RoI.size());
+  } // for
+  out.writeRecord(BinaryRecord::Wire, buffer);
+
+} // recob::dumper::writeWire()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::writeHit(BinaryDumpWriter& out, recob::Hit const& hit) {
+
+  geo::WireID const& wireID = hit.WireID();
+  out.writeRecord(BinaryRecord::Hit,
+    out.buffer()
+      .put<std::uint32_t>(hit.Channel())
+      .put<std::int32_t>(hit.StartTick())
+      .put<std::int32_t>(hit.EndTick())
+      .put<float>(hit.PeakTime())
+      .put<float>(hit.SigmaPeakTime())
+      .put<float>(hit.RMS())
+      .put<float>(hit.PeakAmplitude())
+      .put<float>(hit.SigmaPeakAmplitude())
+      .put<float>(hit.SummedADC())
+      .put<float>(hit.Integral())
+      .put<float>(hit.SigmaIntegral())
+      .put<std::int16_t>(hit.Multiplicity())
+      .put<std::int16_t>(hit.LocalIndex())
+      .put<float>(hit.GoodnessOfFit())
+      .put<std::int32_t>(hit.DegreesOfFreedom())
+      .put<std::int32_t>(hit.View())
+      .put<std::int32_t>(hit.SignalType())
+      .put<std::uint32_t>(wireID.Cryostat)
+      .put<std::uint32_t>(wireID.TPC)
+      .put<std::uint32_t>(wireID.Plane)
+      .put<std::uint32_t>(wireID.Wire)
+    );
+
+} // recob::dumper::writeHit()
+
+
+//------------------------------------------------------------------------------
+void recob::dumper::writeAssociation(
+  BinaryDumpWriter& out, std::size_t left,
+  std::vector<std::pair<std::size_t, std::size_t>> const& ranges
+) {
+
+  BinaryRecordBuffer& buffer = out.buffer()
+    .put<std::uint64_t>(left)
+    .put<std::uint64_t>(ranges.size());
+  for (auto const& range: ranges)
+    buffer.put<std::uint64_t>(range.first).put<std::uint64_t>(range.second);
+  out.writeRecord(BinaryRecord::Association, buffer);
+
+} // recob::dumper::writeAssociation()
+
+
+//------------------------------------------------------------------------------
+//---  text conversion
+//---
+namespace {
+
+  void printEvent
+    (std::ostream& out, recob::dumper::BinaryRecordReader& payload)
+  {
+    auto const run = payload.get<std::uint32_t>();
+    auto const subRun = payload.get<std::uint32_t>();
+    auto const event = payload.get<std::uint32_t>();
+    std::string const tag = payload.getString();
+    auto const nElements = payload.get<std::uint64_t>();
+    out << "Event run: " << run << " subRun: " << subRun << " event: " << event
+      << " contains " << nElements << " '" << tag << "' elements";
+  } // printEvent()
+
+
+  void printRawDigit
+    (std::ostream& out, recob::dumper::BinaryRecordReader& payload)
+  {
+    auto const channel = payload.get<std::uint32_t>();
+    auto const samples = payload.get<std::uint64_t>();
+    auto const compression = payload.get<std::int32_t>();
+    auto const NADC = payload.get<std::uint64_t>();
+    std::vector<short> ADCs(payload.getCount<short>());
+    payload.getArray(ADCs.data(), ADCs.size());
+
+    out << "  #" << channel << ": " << ADCs.size() << " time ticks";
+    if (samples != ADCs.size()) out << " [!!! EXPECTED " << samples << "] ";
+    out << " (" << NADC << " after compression); compression type: #"
+      << compression;
+    for (std::size_t i = 0; i < ADCs.size(); ++i) {
+      if (i % 20 == 0) out << "\n   ";
+      out << " " << ADCs[i];
+    } // for
+  } // printRawDigit()
+
+
+  void printWire
+    (std::ostream& out, recob::dumper::BinaryRecordReader& payload)
+  {
+    auto const channel = payload.get<std::uint32_t>();
+    auto const view = payload.get<std::int32_t>();
+    auto const nSignal = payload.get<std::uint64_t>();
+    auto const nRoIs = payload.get<std::uint64_t>();
+    out << "  channel #" << channel << " on view #" << view << "; " << nSignal
+      << " time ticks with " << nRoIs << " regions of interest:";
+    std::vector<float> values;
+    for (std::uint64_t iRoI = 0; iRoI < nRoIs; ++iRoI) {
+      auto const offset = payload.get<std::uint64_t>();
+      values.resize(payload.getCount<float>());
+      payload.getArray(values.data(), values.size());
+      out << "\n    from " << offset << " for " << values.size() << " ticks:";
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i % 10 == 0) out << "\n     ";
+        out << " " << values[i];
+      } // for
+    } // for
+  } // printWire()
+
+
+  void printHit
+    (std::ostream& out, recob::dumper::BinaryRecordReader& payload)
+  {
+    auto const channel = payload.get<std::uint32_t>();
+    auto const startTick = payload.get<std::int32_t>();
+    auto const endTick = payload.get<std::int32_t>();
+    auto const peakTime = payload.get<float>();
+    auto const sigmaPeakTime = payload.get<float>();
+    auto const RMS = payload.get<float>();
+    auto const peakAmplitude = payload.get<float>();
+    auto const sigmaPeakAmplitude = payload.get<float>();
+    auto const summedADC = payload.get<float>();
+    auto const integral = payload.get<float>();
+    auto const sigmaIntegral = payload.get<float>();
+    auto const multiplicity = payload.get<std::int16_t>();
+    auto const localIndex = payload.get<std::int16_t>();
+    auto const goodnessOfFit = payload.get<float>();
+    auto const DOF = payload.get<std::int32_t>();
+    auto const view = payload.get<std::int32_t>();
+    auto const signalType = payload.get<std::int32_t>();
+    auto const cryostat = payload.get<std::uint32_t>();
+    auto const TPC = payload.get<std::uint32_t>();
+    auto const plane = payload.get<std::uint32_t>();
+    auto const wire = payload.get<std::uint32_t>();
+
+    out << "  hit on channel " << channel
+      << " (C:" << cryostat << " T:" << TPC << " P:" << plane << " W:" << wire
+      << ", view #" << view << ", signal type #" << signalType << ")"
+      << "\n    ticks [" << startTick << ";" << endTick << "]"
+      << " peak " << peakTime << " +/- " << sigmaPeakTime
+      << " RMS " << RMS
+      << "\n    amplitude " << peakAmplitude << " +/- " << sigmaPeakAmplitude
+      << " summed ADC " << summedADC
+      << " integral " << integral << " +/- " << sigmaIntegral
+      << "\n    multiplicity " << localIndex << " of " << multiplicity
+      << " GoF " << goodnessOfFit << " (DoF " << DOF << ")";
+  } // printHit()
+
+
+  void printAssociation
+    (std::ostream& out, recob::dumper::BinaryRecordReader& payload)
+  {
+    auto const left = payload.get<std::uint64_t>();
+    auto const nRanges = payload.get<std::uint64_t>();
+    out << "  #" << left << " associated with:";
+    for (std::uint64_t iRange = 0; iRange < nRanges; ++iRange) {
+      auto const first = payload.get<std::uint64_t>();
+      auto const last = payload.get<std::uint64_t>();
+      if (first == last) out << " " << first;
+      else out << " [" << first << "-" << last << "]";
+    } // for
+  } // printAssociation()
+
+} // local namespace
+
+
+void recob::dumper::printRecordAsText
+  (std::ostream& out, BinaryRecord type, BinaryRecordReader payload)
+{
+  switch (type) {
+    case BinaryRecord::Event:    printEvent(out, payload);    break;
+    case BinaryRecord::RawDigit: printRawDigit(out, payload); break;
+    case BinaryRecord::Wire:     printWire(out, payload);     break;
+    case BinaryRecord::Hit:      printHit(out, payload);      break;
+    case BinaryRecord::Association: printAssociation(out, payload); break;
+    default:
+      out << "<unknown record type #" << static_cast<std::uint32_t>(type)
+        << ", " << payload.remaining() << " bytes>";
+  } // switch
+} // recob::dumper::printRecordAsText()
+
+
+//------------------------------------------------------------------------------
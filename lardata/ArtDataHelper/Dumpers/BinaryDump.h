@@ -0,0 +1,300 @@
+/**
+ * @file   BinaryDump.h
+ * @brief  Compact binary output for the dumper modules
+ * @date   October 14, 2026
+ * @see    BinaryDump.cc DumpBinaryToText.cxx
+ *
+ * The dumper modules can write the content of the data products into a binary
+ * file instead of into the message facility. The file is a sequence of
+ * length-prefixed records, written in the native byte order of the machine:
+ *
+ *  * a file header: the 8-character signature `"LARDUMP1"`, followed by a
+ *    32-bit marker `0x01020304` used to detect the byte order on reading
+ *  * any number of records, each one made of:
+ *     * the record type (32-bit unsigned integer, `recob::dumper::BinaryRecord`)
+ *     * the size in bytes of the payload (64-bit unsigned integer)
+ *     * the payload
+ *
+ * Each dumped event starts with a `BinaryRecord::Event` record, followed by
+ * a record for each element of the dumped data product.
+ * The layout of the payload of each record type is defined by the `write...()`
+ * functions in this header, and the `DumpBinaryToText` program prints
+ * the content of a binary dump file as text.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_DUMPERS_BINARYDUMP_H
+#define LARDATA_ARTDATAHELPER_DUMPERS_BINARYDUMP_H 1
+
+// C/C++ standard libraries
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstring> // std::memcpy()
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstddef> // std::size_t
+#include <type_traits> // std::is_trivially_copyable<>
+
+
+namespace raw { class RawDigit; }
+namespace recob {
+  class Wire;
+  class Hit;
+}
+
+namespace recob {
+  namespace dumper {
+
+    /// Types of records in a binary dump file
+    enum class BinaryRecord: std::uint32_t {
+      Event    = 1, ///< start of an event: its ID, and the dumped product tag
+      RawDigit = 2, ///< a `raw::RawDigit`, with uncompressed waveform
+      Wire     = 3, ///< a `recob::Wire`, with its regions of interest
+      Hit      = 4, ///< a `recob::Hit`
+      Association = 5 ///< keys of the elements associated to one element
+    }; // enum class BinaryRecord
+
+
+    /// Payload of a record being written
+    class BinaryRecordBuffer {
+        public:
+
+      /// Appends a single value of a trivially copyable type
+      template <typename T>
+      BinaryRecordBuffer& put(T const& value)
+        { return putArray(&value, 1U); }
+
+      /// Appends `n` values of a trivially copyable type
+      template <typename T>
+      BinaryRecordBuffer& putArray(T const* values, std::size_t n);
+
+      /// Appends a string, prefixed by its length
+      BinaryRecordBuffer& putString(std::string const& s);
+
+      /// Returns a pointer to the payload
+      char const* data() const { return fData.data(); }
+
+      /// Returns the size of the payload, in bytes
+      std::size_t size() const { return fData.size(); }
+
+      /// Removes the current payload (and keeps the memory for the next one)
+      void clear() { fData.clear(); }
+
+        private:
+      std::vector<char> fData; ///< the payload
+
+    }; // class BinaryRecordBuffer
+
+
+    /// Access to the payload of a record being read
+    class BinaryRecordReader {
+        public:
+
+      /// Constructor: reads from the specified payload
+      BinaryRecordReader(char const* data, std::size_t size)
+        : fData(data), fSize(size)
+        {}
+
+      /// Reads a single value of a trivially copyable type
+      template <typename T>
+      T get() { T value; getArray(&value, 1U); return value; }
+
+      /// Reads `n` values of a trivially copyable type
+      /// @throw cet::exception (category `"BinaryDump"`) if data is too short
+      template <typename T>
+      void getArray(T* values, std::size_t n);
+
+      /// Reads a string, prefixed by its length
+      std::string getString();
+
+      /// Reads a 64-bit count of values of type `T` which follow it
+      /// @throw cet::exception (category `"BinaryDump"`) if data is too short
+      ///        for that many values
+      template <typename T>
+      std::size_t getCount()
+        { auto const n = get<std::uint64_t>(); checkCount(n, sizeof(T)); return n; }
+
+      /// Returns the number of bytes still to be read
+      std::size_t remaining() const { return fSize - fPos; }
+
+        private:
+      char const* fData; ///< the payload
+      std::size_t fSize; ///< size of the payload
+      std::size_t fPos = 0U; ///< current reading position
+
+      /// Throws an exception if there are less than `n` bytes to be read
+      void checkAvailable(std::size_t n) const;
+
+      /// Throws an exception if there are less than `n` values of `size` bytes
+      void checkCount(std::uint64_t n, std::size_t size) const;
+
+    }; // class BinaryRecordReader
+
+
+    /**
+     * @brief Writes records into a binary dump file
+     *
+     * The file is created (or overwritten) on construction, and it is closed
+     * on destruction.
+     * Each record is written with a single write operation from a buffer
+     * which is reused.
+     *
+     * The writer is not thread-safe. A module processing events concurrently
+     * holds `lock()` while writing the records of one event, which keeps them
+     * together in the file.
+     */
+    class BinaryDumpWriter {
+        public:
+
+      /// Constructor: creates the file and writes its header
+      /// @throw cet::exception (category `"BinaryDump"`) if can't create file
+      BinaryDumpWriter(std::string const& fileName);
+
+      /// Writes a `BinaryRecord::Event` record
+      void writeEvent(
+        std::uint32_t run, std::uint32_t subRun, std::uint32_t event,
+        std::string const& productTag, std::uint64_t nElements
+        );
+
+      /// Writes a record of the specified type with the payload from `buffer`
+      void writeRecord(BinaryRecord type, BinaryRecordBuffer const& buffer);
+
+      /// Returns the buffer used for the payload of records, after clearing it
+      BinaryRecordBuffer& buffer() { fBuffer.clear(); return fBuffer; }
+
+      /// Returns the name of the output file
+      std::string const& fileName() const { return fFileName; }
+
+      /// Returns a lock reserving the writer until it is released
+      std::unique_lock<std::mutex> lock()
+        { return std::unique_lock<std::mutex>(fMutex); }
+
+        private:
+      std::string fFileName; ///< name of the output file
+      std::mutex fMutex; ///< reserves the writer to a single event
+      std::ofstream fOut; ///< output file stream
+      BinaryRecordBuffer fBuffer; ///< buffer for the payload of records
+
+    }; // class BinaryDumpWriter
+
+
+    /**
+     * @brief Reads records from a binary dump file
+     *
+     * Example of usage:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * recob::dumper::BinaryDumpReader dump("DumpRawDigits.bin");
+     * while (dump.next()) {
+     *   recob::dumper::printRecordAsText
+     *     (std::cout, dump.type(), dump.payload());
+     * }
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    class BinaryDumpReader {
+        public:
+
+      /// Constructor: opens the file and checks its header
+      /// @throw cet::exception (category `"BinaryDump"`) if the file can't be
+      ///        read or it is not a binary dump in the byte order of this
+      ///        machine
+      BinaryDumpReader(std::string const& fileName);
+
+      /// Reads the next record; returns false if there are no more records
+      /// @throw cet::exception (category `"BinaryDump"`) if record is truncated
+      ///        (its declared size is checked against the rest of the file
+      ///        before any memory is allocated for it)
+      bool next();
+
+      /// Returns the type of the last record read
+      BinaryRecord type() const { return fType; }
+
+      /// Returns a reader of the payload of the last record read
+      BinaryRecordReader payload() const
+        { return { fPayload.data(), fPayload.size() }; }
+
+        private:
+      std::string fFileName; ///< name of the input file
+      std::ifstream fIn; ///< input file stream
+      std::uint64_t fFileSize = 0U; ///< size of the input file
+      BinaryRecord fType = BinaryRecord::Event; ///< type of the last record
+      std::vector<char> fPayload; ///< payload of the last record
+
+    }; // class BinaryDumpReader
+
+
+    //--------------------------------------------------------------------------
+    /// Writes a `BinaryRecord::RawDigit` record with the uncompressed digits
+    void writeRawDigit(BinaryDumpWriter& out, raw::RawDigit const& digits);
+
+    /// Writes a `BinaryRecord::Wire` record with all the regions of interest
+    void writeWire(BinaryDumpWriter& out, recob::Wire const& wire);
+
+    /// Writes a `BinaryRecord::Hit` record
+    void writeHit(BinaryDumpWriter& out, recob::Hit const& hit);
+
+    /**
+     * @brief Writes a `BinaryRecord::Association` record
+     * @param out the binary dump
+     * @param left key of the element the others are associated to
+     * @param ranges ranges of keys of the associated elements (both included)
+     *
+     * The payload is the left key and the number of ranges (64-bit unsigned
+     * integers), followed by first and last key of each range (64-bit).
+     * The records of the associations of a data product follow its
+     * `BinaryRecord::Event` record, so that the graphs of two dumps can be
+     * compared offline.
+     */
+    void writeAssociation(
+      BinaryDumpWriter& out, std::size_t left,
+      std::vector<std::pair<std::size_t, std::size_t>> const& ranges
+      );
+
+    /**
+     * @brief Prints the content of a record as text
+     * @param out the stream to print into
+     * @param type the type of record
+     * @param payload the payload of the record
+     *
+     * Records of unknown type are reported but their content is not printed.
+     */
+    void printRecordAsText
+      (std::ostream& out, BinaryRecord type, BinaryRecordReader payload);
+
+
+  } // namespace dumper
+} // namespace recob
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename T>
+recob::dumper::BinaryRecordBuffer& recob::dumper::BinaryRecordBuffer::putArray
+  (T const* values, std::size_t n)
+{
+  static_assert(std::is_trivially_copyable<T>(),
+    "Only trivially copyable types can be written in binary dumps");
+  std::size_t const pos = fData.size();
+  fData.resize(pos + n * sizeof(T));
+  if (n > 0) std::memcpy(fData.data() + pos, values, n * sizeof(T));
+  return *this;
+} // recob::dumper::BinaryRecordBuffer::putArray()
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+void recob::dumper::BinaryRecordReader::getArray(T* values, std::size_t n) {
+  static_assert(std::is_trivially_copyable<T>(),
+    "Only trivially copyable types can be read from binary dumps");
+  checkAvailable(n * sizeof(T));
+  if (n > 0) std::memcpy(values, fData + fPos, n * sizeof(T));
+  fPos += n * sizeof(T);
+} // recob::dumper::BinaryRecordReader::getArray()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_ARTDATAHELPER_DUMPERS_BINARYDUMP_H
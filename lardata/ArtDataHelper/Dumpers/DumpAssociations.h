@@ -11,10 +11,16 @@
 // C//C++ standard libraries
 #include <typeinfo>
 #include <type_traits> // std::is_same<>
+#include <algorithm> // std::sort()
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstddef> // std::size_t
 
 // framework and supporting libraries
 #include "cetlib_except/demangle.h"
 #include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
 
 
 namespace util {
@@ -34,7 +40,7 @@ namespace util {
   {
     out << "Association between '" << cet::demangle_symbol(typeid(Left).name())
       << "' and '" << cet::demangle_symbol(typeid(Right).name()) << "'";
-    if (std::is_same<Data, void>()) {
+    if (!std::is_same<Data, void>()) {
       out << " with '" << cet::demangle_symbol(typeid(Data).name())
         << "' metadata";
     }
@@ -47,6 +53,136 @@ namespace util {
   } // DumpAssociationsIntro<Data>()
 
 
+  /// A range of consecutive keys (`first` and `second` included)
+  using KeyRange_t = std::pair<std::size_t, std::size_t>;
+
+  /// The keys of the right elements associated to one left element
+  struct AssociationKeyGroup {
+    std::size_t left; ///< key of the left element
+    std::vector<KeyRange_t> right; ///< ranges of keys of the right elements
+  }; // struct AssociationKeyGroup
+
+
+  /**
+   * @brief Appends the keys in the specified range to a list of key ranges
+   * @tparam Iter type of iterator to keys (convertible to `std::size_t`)
+   * @param begin iterator to the first key
+   * @param end iterator past the last key
+   * @param ranges the list of ranges to extend
+   *
+   * The keys are scanned once, in their order: each run of keys increasing by
+   * one becomes a single range. If the last range in `ranges` ends just before
+   * the first key, it is extended with it.
+   */
+  template <typename Iter>
+  void AppendKeyRanges
+    (Iter begin, Iter end, std::vector<KeyRange_t>& ranges)
+  {
+    for (; begin != end; ++begin) {
+      std::size_t const key = *begin;
+      if (!ranges.empty() && (key == ranges.back().second + 1))
+        ranges.back().second = key;
+      else
+        ranges.emplace_back(key, key);
+    } // for
+  } // AppendKeyRanges()
+
+
+  /// Returns the ranges of consecutive keys in the specified range of keys
+  template <typename Iter>
+  std::vector<KeyRange_t> FindKeyRanges(Iter begin, Iter end)
+  {
+    std::vector<KeyRange_t> ranges;
+    AppendKeyRanges(begin, end, ranges);
+    return ranges;
+  } // FindKeyRanges()
+
+
+  /**
+   * @brief Returns the keys of the associated elements, grouped by left key
+   * @tparam Left first type in the association
+   * @tparam Right second type in the association
+   * @tparam Data metadata type in the association
+   * @param assns the associations
+   * @return a group for each sequence of associations with the same left key
+   *
+   * The associations are scanned once, in their order; the associations of
+   * one left element are expected to be contiguous (as when they are created
+   * one left element after the other), otherwise that element will appear in
+   * more than one group.
+   */
+  template <typename Left, typename Right, typename Data>
+  std::vector<AssociationKeyGroup> GroupAssociationKeys
+    (art::Assns<Left, Right, Data> const& assns)
+  {
+    std::vector<AssociationKeyGroup> groups;
+    for (auto const& assn: assns) {
+      std::size_t const left = assn.first.key();
+      if (groups.empty() || (groups.back().left != left))
+        groups.push_back({ left, {} });
+      std::size_t const right = assn.second.key();
+      AppendKeyRanges(&right, &right + 1, groups.back().right);
+    } // for
+    return groups;
+  } // GroupAssociationKeys()
+
+
+  /**
+   * @brief Prints a list of key ranges
+   * @tparam Stream type of output stream
+   * @param out output stream
+   * @param ranges the ranges to be printed
+   * @param rangesPerLine number of ranges on each line (`0`: all on one line)
+   * @param indent string printed at the beginning of each line
+   *
+   * Single keys are printed as they are, longer ranges as `[first-last]`.
+   * The output starts on a new line, and the last line is *not* broken.
+   */
+  template <typename Stream>
+  void DumpKeyRanges(
+    Stream&& out, std::vector<KeyRange_t> const& ranges,
+    unsigned int rangesPerLine, std::string const& indent = ""
+  ) {
+    std::size_t iRange = 0;
+    for (KeyRange_t const& range: ranges) {
+      if ((iRange == 0) || ((rangesPerLine > 0) && (iRange % rangesPerLine == 0)))
+        out << "\n" << indent;
+      else
+        out << " ";
+      ++iRange;
+      if (range.first == range.second) out << range.first;
+      else out << "[" << range.first << "-" << range.second << "]";
+    } // for
+  } // DumpKeyRanges()
+
+
+  /**
+   * @brief Prints the keys of the specified pointers, compacted in ranges
+   * @tparam Stream type of output stream
+   * @tparam T type of the pointed elements
+   * @param out output stream
+   * @param ptrs the pointers to the elements (e.g. from `art::FindManyP`)
+   * @param rangesPerLine number of ranges on each line (`0`: all on one line)
+   * @param indent string printed at the beginning of each line
+   * @param sorted whether to print the keys sorted, rather than in their order
+   *
+   * See `DumpKeyRanges()` for the format.
+   */
+  template <typename Stream, typename T>
+  void DumpAssociatedKeys(
+    Stream&& out, std::vector<art::Ptr<T>> const& ptrs,
+    unsigned int rangesPerLine, std::string const& indent = "",
+    bool sorted = true
+  ) {
+    std::vector<std::size_t> keys;
+    keys.reserve(ptrs.size());
+    for (art::Ptr<T> const& ptr: ptrs) keys.push_back(ptr.key());
+    if (sorted) std::sort(keys.begin(), keys.end());
+    DumpKeyRanges
+      (out, FindKeyRanges(keys.begin(), keys.end()), rangesPerLine, indent);
+  } // DumpAssociatedKeys()
+
+
 
 } // namespace util
 
@@ -0,0 +1,52 @@
+/**
+ * @file   DumpBinaryToText.cxx
+ * @brief  Prints the content of binary dump files as text
+ * @date   October 14, 2026
+ * @see    BinaryDump.h
+ *
+ * Usage:
+ *
+ *     DumpBinaryToText  DumpFile [DumpFile ...]
+ *
+ * The content of the binary dump files written by the dumper modules is
+ * printed on the standard output.
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <iostream>
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  DumpFile [DumpFile ...]"
+      << std::endl;
+    return 1;
+  }
+
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    try {
+      recob::dumper::BinaryDumpReader dump(argv[iArg]);
+      while (dump.next()) {
+        recob::dumper::printRecordAsText(std::cout, dump.type(), dump.payload());
+        std::cout << "\n";
+      } // while
+    }
+    catch (cet::exception const& e) {
+      std::cerr << argv[iArg] << ": " << e.what() << std::endl;
+      return 1;
+    }
+  } // for files
+
+  return 0;
+} // main()
+
+
+//------------------------------------------------------------------------------
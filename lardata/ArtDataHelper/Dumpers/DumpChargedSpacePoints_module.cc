@@ -6,18 +6,20 @@
  */
 
 // LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
 #include "lardata/RecoBaseProxy/ChargedSpacePoints.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
 
 // art libraries
 #include "canvas/Utilities/InputTag.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 
 // support libraries
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "fhiclcpp/types/Atom.h" // also pulls in fhicl::Name and fhicl::Comment
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
@@ -42,9 +44,14 @@ namespace recob {
    *   `recob::PointCharge` collections to be dumped
    * - *OutputCategory* (string, default: "DumpChargedSpacePoints"): the
    *   category used for the output (useful for filtering)
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the space points (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpChargedSpacePoints: public art::EDAnalyzer {
+  class DumpChargedSpacePoints: public art::SharedAnalyzer {
       public:
 
     /// Configuration parameters
@@ -65,21 +72,26 @@ namespace recob {
         "DumpChargedSpacePoints" /* default value */
         };
 
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
+
     }; // struct Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
 
     /// Constructor.
-    explicit DumpChargedSpacePoints(Parameters const& config);
+    DumpChargedSpacePoints
+      (Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing.
-    virtual void analyze (art::Event const& event) override;
+    virtual void analyze
+      (art::Event const& event, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fInputTag; ///< Input tag of the SpacePoint product.
     std::string fOutputCategory; ///< Category for LogInfo output.
+    recob::dumper::DumpSampler fSampler; ///< Selection of the dumped points.
 
   }; // class DumpChargedSpacePoints
 
@@ -92,15 +104,22 @@ namespace recob {
 
 //----------------------------------------------------------------------------
 recob::DumpChargedSpacePoints::DumpChargedSpacePoints
-  (art::EDAnalyzer::Table<Config> const& config)
-  : EDAnalyzer(config)
+  (Parameters const& config, art::ProcessingFrame const&)
+  : SharedAnalyzer(config)
   , fInputTag(config().SpacePointTag())
   , fOutputCategory(config().OutputCategory())
-  {}
+  , fSampler(config().Sampling())
+  {
+    async<art::InEvent>();
+  }
 
 
 //----------------------------------------------------------------------------
-void recob::DumpChargedSpacePoints::analyze(art::Event const& event) {
+void recob::DumpChargedSpacePoints::analyze
+  (art::Event const& event, art::ProcessingFrame const&)
+{
+
+  if (!fSampler.selectEvent()) return;
 
   //
   // collect all the available information
@@ -116,6 +135,7 @@ void recob::DumpChargedSpacePoints::analyze(art::Event const& event) {
     << " space points from '" << fInputTag.encode() << "'";
 
   for (auto const& point: points) {
+    if (!fSampler.selectElement(point.index())) continue;
 
     log << "\n [#" << point.index() << "] "
       << point.point() << " " << point.charge();
@@ -6,14 +6,19 @@
  */
 
 // LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpAssociations.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Cluster.h"
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/Assns.h"
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/FindManyP.h"
 #include "canvas/Utilities/InputTag.h"
@@ -23,13 +28,11 @@
 #include "fhiclcpp/types/Table.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
-#include <sstream>
-#include <iomanip> // std::setw()
-#include <algorithm> // std::min(), std::sort()
+#include <memory> // std::unique_ptr<>
 
 
 namespace recob {
@@ -48,10 +51,21 @@ namespace recob {
    * - *OutputCategory* (string, default: `"DumpClusters"`): the category
    *   used for the output (useful for filtering)
    * - *HitsPerLine* (integer, default: `20`): the dump of hits
-   *   will put this many of them for each line
+   *   will put this many of them (or ranges of consecutive ones, printed as
+   *   `[first-last]`) for each line
+   * - *AssociationFile* (string, default: empty): if specified, the keys of
+   *   the hits associated to each cluster (of all of them, regardless the
+   *   sampling) are written into this file in the binary format described
+   *   in `BinaryDump.h`, for offline comparisons; `DumpBinaryToText` can
+   *   print it as text
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the clusters (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpClusters : public art::EDAnalyzer {
+  class DumpClusters : public art::SharedAnalyzer {
       public:
 
     /// Configuration object
@@ -73,54 +87,66 @@ namespace recob {
         Comment("number of hits per line (0 suppresses hit dumping)"),
         20U
         };
+      fhicl::Atom<std::string> AssociationFile{
+        Name("AssociationFile"),
+        Comment("if not empty, the cluster-hit associations are written in"
+          " binary form into this file (convert it with DumpBinaryToText)"),
+        ""
+        };
+
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
 
     }; // Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
     /// Default constructor
-    explicit DumpClusters(Parameters const& config);
+    DumpClusters(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    void analyze (const art::Event& evt);
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fClusterModuleLabel; ///< tag of the cluster data product
     std::string fOutputCategory; ///< category for LogInfo output
     unsigned int fHitsPerLine; ///< hits per line in the output
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped clusters
+
+    /// Binary output of the associations (if any).
+    std::unique_ptr<recob::dumper::BinaryDumpWriter> fAssociationOut;
 
   }; // class DumpWires
 
 } // namespace recob
 
 
-//------------------------------------------------------------------------------
-namespace {
-
-  /// Returns the length of the string representation of the specified object
-  template <typename T>
-  size_t StringLength(const T& value) {
-    std::ostringstream sstr;
-    sstr << value;
-    return sstr.str().length();
-  } // StringLength()
-
-} // local namespace
-
 namespace recob {
 
   //-------------------------------------------------
-  DumpClusters::DumpClusters(Parameters const& config)
-    : EDAnalyzer         (config)
+  DumpClusters::DumpClusters
+    (Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer     (config)
     , fClusterModuleLabel(config().ClusterModuleLabel())
     , fOutputCategory    (config().OutputCategory())
     , fHitsPerLine       (config().HitsPerLine())
-    {}
+    , fSampler           (config().Sampling())
+    {
+      if (!config().AssociationFile().empty()) {
+        fAssociationOut = std::make_unique<recob::dumper::BinaryDumpWriter>
+          (config().AssociationFile());
+      }
+      async<art::InEvent>();
+    }
 
 
   //-------------------------------------------------
-  void DumpClusters::analyze(const art::Event& evt) {
+  void DumpClusters::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     // fetch the data to be dumped on screen
     art::InputTag ClusterInputTag(fClusterModuleLabel);
@@ -131,84 +157,42 @@ namespace recob {
     // get cluster-hit associations
     art::FindManyP<recob::Hit> HitAssn(Clusters, evt, ClusterInputTag);
 
-    mf::LogInfo(fOutputCategory)
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line()
       << "The event contains " << Clusters->size() << " '"
       << ClusterInputTag.encode() << "' clusters";
 
-    unsigned int iCluster = 0;
-    std::vector<size_t> HitBuffer(fHitsPerLine), LastBuffer;
-    for (const recob::Cluster& cluster: *Clusters) {
+    for (unsigned int iCluster = 0; iCluster < Clusters->size(); ++iCluster) {
+      if (!fSampler.selectElement(iCluster)) continue;
+      const recob::Cluster& cluster = (*Clusters)[iCluster];
       decltype(auto) ClusterHits = HitAssn.at(iCluster);
 
       // print a header for the cluster
-      mf::LogVerbatim(fOutputCategory)
-        << "Cluster #" << (iCluster++) << " from " << ClusterHits.size()
+      out.line()
+        << "Cluster #" << iCluster << " from " << ClusterHits.size()
         << " hits: " << cluster;
 
 
       // print the hits of the cluster
       if ((fHitsPerLine > 0) && !ClusterHits.empty()) {
-        std::vector<size_t> HitIndices;
-        for (art::Ptr<recob::Hit> pHit: ClusterHits)
-          HitIndices.push_back(pHit.key());
-        std::sort(HitIndices.begin(), HitIndices.end());
-
-        unsigned int Padding = ::StringLength(HitIndices.back());
-
-        mf::LogVerbatim(fOutputCategory) << "  hit indices:";
-
-        std::vector<size_t>::const_iterator iHit = HitIndices.begin(),
-          hend = HitIndices.end();
-        size_t RangeStart = *iHit, RangeStop = RangeStart;
-        std::ostringstream output_line;
-        size_t nItemsInLine = 0;
-        while (++iHit != hend) {
-
-          if (*iHit == RangeStop + 1) {
-            ++RangeStop;
-          }
-          else {
-            // the new item does not belong to the current range:
-            // - print the current range
-            if (RangeStart == RangeStop) {
-              output_line << "  " << std::setw(Padding) << RangeStart;
-              ++nItemsInLine;
-            }
-            else {
-              char fill = (RangeStart + 1 == RangeStop)? ' ': '-';
-              output_line << "  " << std::setw(Padding) << RangeStart
-                << fill << fill
-                << std::setw(Padding) << std::setfill(fill) << RangeStop
-                << std::setfill(' ');
-              nItemsInLine += 2;
-            }
-            // - start a new one
-            RangeStart = RangeStop = *iHit;
-          } // if ... else
-
-          // if we have enough stuff in the buffer, let's print it
-          if (nItemsInLine >= fHitsPerLine) {
-            nItemsInLine = 0;
-            mf::LogVerbatim(fOutputCategory) << " " << output_line.str();
-            output_line.str("");
-          }
-
-        } // while
-
-        mf::LogVerbatim line_out(fOutputCategory);
-        line_out << " " << output_line.str();
-        if (RangeStart == RangeStop)
-          line_out << "  " << std::setw(Padding) << RangeStart;
-        else {
-          char fill = (RangeStart + 1 == RangeStop)? ' ': '-';
-          line_out << "  " << std::setw(Padding) << RangeStart
-            << fill << fill
-            << std::setw(Padding) << std::setfill(fill) << RangeStop;
-        }
+        out.line() << "  hit indices:";
+        util::DumpAssociatedKeys(out, ClusterHits, fHitsPerLine, "   ");
       } // if dumping the hits
 
     } // for clusters
 
+    // write the whole association graph, in a single pass
+    if (fAssociationOut) {
+      auto const& Assns = *(evt.getValidHandle
+        <art::Assns<recob::Cluster, recob::Hit>>(ClusterInputTag));
+      auto const groups = util::GroupAssociationKeys(Assns);
+      auto const lock = fAssociationOut->lock(); // records of this event together
+      fAssociationOut->writeEvent(evt.run(), evt.subRun(), evt.event(),
+        ClusterInputTag.encode() + " cluster-hit", groups.size());
+      for (util::AssociationKeyGroup const& group: groups)
+        recob::dumper::writeAssociation(*fAssociationOut, group.left, group.right);
+    } // if association file
+
   } // DumpClusters::analyze()
 
   DEFINE_ART_MODULE(DumpClusters)
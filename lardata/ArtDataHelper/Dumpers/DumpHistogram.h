@@ -0,0 +1,183 @@
+/**
+ * @file   DumpHistogram.h
+ * @brief  Simple fixed-binning histogram for the aggregated dumps
+ * @date   October 14, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_DUMPERS_DUMPHISTOGRAM_H
+#define LARDATA_ARTDATAHELPER_DUMPERS_DUMPHISTOGRAM_H 1
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <algorithm> // std::fill()
+#include <utility> // std::pair<>
+#include <cstddef> // std::size_t
+
+
+namespace recob {
+  namespace dumper {
+
+    /**
+     * @brief Histogram with uniform binning, to summarize large collections
+     *
+     * Dumper modules can fill this histogram instead of printing each element
+     * of very large collections (like simulated energy deposits), and then
+     * print its content. Filling costs a multiplication and a conversion per
+     * entry, with no allocation; values outside the range are counted in the
+     * underflow and overflow bins, and are included in the mean.
+     *
+     * Example:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * recob::dumper::DumpHistogram energy { 20U, 0.0, 5.0 };
+     * for (auto const& dep: deps) energy.fill(dep.Energy());
+     *
+     * mf::LogVerbatim log("Dump");
+     * log << "energy (MeV): ";
+     * energy.dump(log, "  ");
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    class DumpHistogram {
+        public:
+
+      /// Constructor: `nBins` bins between `lower` and `upper`
+      /// @throw cet::exception (category `"DumpHistogram"`) on invalid binning
+      DumpHistogram(unsigned int nBins, double lower, double upper)
+        : fLower(lower), fUpper(upper)
+        , fScale((upper > lower)? nBins / (upper - lower): 0.0)
+        , fBins(nBins, 0.0)
+        {
+          if ((nBins == 0U) || !(upper > lower)) {
+            throw cet::exception("DumpHistogram")
+              << "Invalid binning: " << nBins << " bins in [ " << lower
+              << " ; " << upper << " ]\n";
+          }
+        }
+
+      /// Constructor: reads the range from a configuration sequence
+      /// @throw cet::exception (category `"DumpHistogram"`) on invalid range
+      DumpHistogram(
+        unsigned int nBins, std::vector<double> const& range,
+        char const* paramName
+        )
+        : DumpHistogram(nBins, checkRange(range, paramName))
+        {}
+
+
+      /// Adds an entry with the specified value and weight
+      void fill(double value, double weight = 1.0)
+        {
+          ++fEntries;
+          fSumW += weight;
+          fSumWX += weight * value;
+          double const x = (value - fLower) * fScale;
+          if (!(x >= 0.0)) fUnderflow += weight; // also NaN
+          else if (x >= fBins.size()) fOverflow += weight;
+          else fBins[static_cast<std::size_t>(x)] += weight;
+        }
+
+      /// Removes all the entries
+      void reset()
+        {
+          std::fill(fBins.begin(), fBins.end(), 0.0);
+          fUnderflow = fOverflow = fSumW = fSumWX = 0.0;
+          fEntries = 0U;
+        }
+
+
+      /// @{
+      /// @name Access
+
+      /// Number of bins (excluding underflow and overflow)
+      std::size_t nBins() const { return fBins.size(); }
+
+      /// Lower edge of the specified bin
+      double binLower(std::size_t iBin) const
+        { return fLower + iBin * (fUpper - fLower) / fBins.size(); }
+
+      /// Content of the specified bin
+      double binContent(std::size_t iBin) const { return fBins[iBin]; }
+
+      /// Sum of the weights of the entries below the range
+      double underflow() const { return fUnderflow; }
+
+      /// Sum of the weights of the entries above the range
+      double overflow() const { return fOverflow; }
+
+      /// Number of entries
+      std::size_t entries() const { return fEntries; }
+
+      /// Sum of the weights of all entries
+      double sumWeights() const { return fSumW; }
+
+      /// Weighted mean of all the entries (`0` if no weight)
+      double mean() const { return (fSumW != 0.0)? fSumWX / fSumW: 0.0; }
+
+      /// @}
+
+
+      /**
+       * @brief Prints the content of the histogram into a stream
+       * @tparam Stream type of output stream
+       * @param out the output stream
+       * @param indent string prepended to each line of the bins
+       *
+       * The output starts with a summary on the current line; then the empty
+       * bins are skipped, and the other ones are printed one per line, with
+       * their range. The last line is *not* broken.
+       */
+      template <typename Stream>
+      void dump(Stream&& out, std::string const& indent = "") const
+        {
+          out << fEntries << " entries, sum " << fSumW << ", mean " << mean()
+            << " (underflow: " << fUnderflow << ", overflow: " << fOverflow
+            << ")";
+          for (std::size_t iBin = 0; iBin < fBins.size(); ++iBin) {
+            if (fBins[iBin] == 0.0) continue;
+            out << "\n" << indent << "[ " << binLower(iBin) << " ; "
+              << binLower(iBin + 1) << " [  " << fBins[iBin];
+          } // for
+        } // dump()
+
+
+        private:
+      double fLower; ///< lower edge of the range
+      double fUpper; ///< upper edge of the range
+      double fScale; ///< number of bins per unit of value
+      std::vector<double> fBins; ///< content of the bins
+      double fUnderflow = 0.0; ///< weight below the range
+      double fOverflow = 0.0; ///< weight above the range
+      double fSumW = 0.0; ///< sum of the weights
+      double fSumWX = 0.0; ///< sum of the weighted values
+      std::size_t fEntries = 0U; ///< number of entries
+
+      /// Constructor: `nBins` bins in the range `{ lower, upper }`
+      DumpHistogram(unsigned int nBins, std::pair<double, double> range)
+        : DumpHistogram(nBins, range.first, range.second)
+        {}
+
+      /// Returns the range from a [ lower, upper ] configuration sequence
+      static std::pair<double, double> checkRange
+        (std::vector<double> const& range, char const* paramName)
+        {
+          if ((range.size() != 2) || !(range[0] < range[1])) {
+            throw cet::exception("DumpHistogram")
+              << "Parameter '" << paramName
+              << "' must be [ lower, upper ] with lower < upper\n";
+          }
+          return { range[0], range[1] };
+        } // checkRange()
+
+    }; // class DumpHistogram
+
+
+  } // namespace dumper
+} // namespace recob
+
+
+#endif // LARDATA_ARTDATAHELPER_DUMPERS_DUMPHISTOGRAM_H
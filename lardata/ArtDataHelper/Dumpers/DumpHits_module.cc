@@ -7,14 +7,21 @@
 
 // C//C++ standard libraries
 #include <string>
+#include <memory> // std::unique_ptr<>
+
+// LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 
 // support libraries
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "canvas/Persistency/Common/FindOne.h"
@@ -41,9 +48,20 @@ namespace hit {
    *   that the associated wire are on the same channel as the hit
    * - *CheckRawDigitAssociation* (string, default: false): if set, verifies
    *   that the associated raw digits are on the same channel as the hit
+   * - *BinaryFile* (string, default: empty): if specified, the content of the
+   *   hits is written into this file in the binary format described in
+   *   `BinaryDump.h` instead of into the message facility (association checks
+   *   are still performed); `DumpBinaryToText` can print it as text
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*, *ChannelRange*: dump
+   *   only a sample of the events and of the hits (see
+   *   `recob::dumper::ChannelSamplingConfig`); the association checks are
+   *   performed only on the dumped hits
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpHits: public art::EDAnalyzer {
+  class DumpHits: public art::SharedAnalyzer {
       public:
 
     struct Config {
@@ -73,16 +91,26 @@ namespace hit {
         false
         }; // CheckWireAssociation
 
+      fhicl::Atom<std::string> BinaryFile{
+        Name("BinaryFile"),
+        Comment("if not empty, the dump is written in binary form into this file"
+          " (convert it to text with DumpBinaryToText)"),
+        ""
+        };
+
+      fhicl::TableFragment<recob::dumper::ChannelSamplingConfig> Sampling;
+
     }; // Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
 
     /// Default constructor
-    explicit DumpHits(Parameters const& config);
+    DumpHits(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    void analyze (const art::Event& evt);
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
@@ -91,6 +119,11 @@ namespace hit {
     bool bCheckRawDigits;           ///< check associations with raw digits
     bool bCheckWires;               ///< check associations with wires
 
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped hits
+
+    /// binary output file (if any)
+    std::unique_ptr<recob::dumper::BinaryDumpWriter> fBinaryOut;
+
   }; // class DumpHits
 
 } // namespace hit
@@ -101,9 +134,7 @@ namespace hit {
 //---
 // C//C++ standard libraries
 #include <memory> // std::unique_ptr<>
-
-// support libraries
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include <mutex> // std::unique_lock<>
 
 // art libraries
 #include "art/Framework/Principal/Handle.h"
@@ -118,24 +149,45 @@ namespace hit {
 namespace hit {
 
   //-------------------------------------------------
-  DumpHits::DumpHits(Parameters const& config)
-    : EDAnalyzer         (config)
+  DumpHits::DumpHits(Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer     (config)
     , fHitsModuleLabel   (config().HitModuleLabel())
     , fOutputCategory    (config().OutputCategory())
     , bCheckRawDigits    (config().CheckRawDigitAssociation())
     , bCheckWires        (config().CheckWireAssociation())
-    {}
+    , fSampler           (config().Sampling())
+    {
+      if (!config().BinaryFile().empty()) {
+        fBinaryOut = std::make_unique<recob::dumper::BinaryDumpWriter>
+          (config().BinaryFile());
+      }
+      async<art::InEvent>();
+    }
 
 
   //-------------------------------------------------
-  void DumpHits::analyze(const art::Event& evt) {
+  void DumpHits::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     // fetch the data to be dumped on screen
     auto Hits = evt.getValidHandle<std::vector<recob::Hit>>(fHitsModuleLabel);
 
-    mf::LogInfo(fOutputCategory)
-      << "The event contains " << Hits->size() << " '"
-      << fHitsModuleLabel.encode() << "' hits";
+    // the binary records of this event are written together
+    std::unique_lock<std::mutex> binaryLock;
+    recob::dumper::EventDump out(fOutputCategory);
+    if (fBinaryOut) {
+      binaryLock = fBinaryOut->lock();
+      fBinaryOut->writeEvent(evt.run(), evt.subRun(), evt.event(),
+        fHitsModuleLabel.encode(), Hits->size());
+    }
+    else {
+      out.line()
+        << "The event contains " << Hits->size() << " '"
+        << fHitsModuleLabel.encode() << "' hits";
+    }
 
     std::unique_ptr<art::FindOne<raw::RawDigit>> HitToRawDigit;
     if (bCheckRawDigits) {
@@ -158,12 +210,13 @@ namespace hit {
       }
     } // if check wires
 
-    unsigned int iHit = 0;
-    for (const recob::Hit& hit: *Hits) {
+    for (unsigned int iHit = 0; iHit < Hits->size(); ++iHit) {
+      const recob::Hit& hit = (*Hits)[iHit];
+      if (!fSampler.selectElement(iHit, hit.Channel())) continue;
 
       // print a header for the cluster
-      mf::LogVerbatim(fOutputCategory)
-        << "Hit #" << iHit << ": " << hit;
+      if (fBinaryOut) recob::dumper::writeHit(*fBinaryOut, hit);
+      else out.line() << "Hit #" << iHit << ": " << hit;
 
       if (HitToRawDigit) {
         raw::ChannelID_t assChannelID = HitToRawDigit->at(iHit).ref().Channel();
@@ -185,7 +238,6 @@ namespace hit {
         } // mismatch
       } // wire check
 
-      ++iHit;
     } // for hits
 
   } // DumpHits::analyze()
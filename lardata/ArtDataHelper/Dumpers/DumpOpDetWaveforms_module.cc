@@ -6,28 +6,32 @@
  */
 
 // LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardataalg/DetectorInfo/DetectorClocks.h"
 #include "lardataalg/Dumpers/RawData/OpDetWaveform.h"
 #include "lardataobj/RawData/OpDetWaveform.h"
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Utilities/InputTag.h"
 
 // support libraries
-#include "messagefacility/MessageLogger/MessageLogger.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <vector>
 #include <string>
-#include <algorithm> // std::sort()
+#include <algorithm> // std::sort(), std::is_sorted()
+#include <cmath> // std::sqrt()
+#include <cstdint> // std::int64_t
 
 
 namespace detsim {
@@ -54,9 +58,26 @@ namespace detsim {
    *     - `"tick"`: the tick number of the waveform is printed (starts at `0`)
    *     - `"time"`: timestamp (&micro;s) of the first tick in the row
    *     - `"none"`: no preamble written at all
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*, *ChannelRange*: dump
+   *   only a sample of the events and of the waveforms (see
+   *   `recob::dumper::ChannelSamplingConfig`); keys are the positions of the
+   *   waveforms in the data product
+   * - *MaxSamples* (integer, default: `0`): dump at most this many ADC
+   *   readings of each waveform (`0`: all of them)
+   * - *DumpSamples* (boolean, default: `true`): if `false`, ADC readings are
+   *   not dumped, only a line for each waveform
+   * - *PrintSummary* (boolean, default: `false`): print for each waveform the
+   *   minimum, maximum, mean and RMS of the ADC readings (after pedestal
+   *   subtraction)
+   *
+   * The waveforms of each channel are dumped in order of timestamp; they
+   * are sorted only if they are not already in that order in the input.
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpOpDetWaveforms: public art::EDAnalyzer {
+  class DumpOpDetWaveforms: public art::SharedAnalyzer {
       public:
 
     struct Config {
@@ -99,16 +120,37 @@ namespace detsim {
         "tick"
         };
 
+      fhicl::TableFragment<recob::dumper::ChannelSamplingConfig> Sampling;
+
+      fhicl::Atom<unsigned int> MaxSamples {
+        Name("MaxSamples"),
+        Comment("dump at most this many ADC readings per waveform (0: all)"),
+        0U
+        };
+
+      fhicl::Atom<bool> DumpSamples {
+        Name("DumpSamples"),
+        Comment("dump the ADC readings (otherwise only one line per waveform)"),
+        true
+        };
+
+      fhicl::Atom<bool> PrintSummary {
+        Name("PrintSummary"),
+        Comment("print minimum, maximum, mean and RMS of each waveform"),
+        false
+        };
+
     }; // struct Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
 
-    explicit DumpOpDetWaveforms(Parameters const& config);
+    DumpOpDetWaveforms(Parameters const& config, art::ProcessingFrame const&);
 
 
     /// Does the printing.
-    void analyze (const art::Event& evt);
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
 
       private:
@@ -135,18 +177,39 @@ namespace detsim {
     std::string fOutputCategory; ///< Category for `mf::LogInfo` output.
     unsigned int fDigitsPerLine; ///< ADC readings per line in the output.
     raw::ADC_Count_t fPedestal; ///< ADC pedestal (subtracted from readings).
+    recob::dumper::DumpSampler fSampler; ///< Selection of dumped waveforms.
+    unsigned int fMaxSamples; ///< Maximum ADC readings dumped per waveform.
+    bool fDumpSamples; ///< Whether to dump the ADC readings.
+    bool fPrintSummary; ///< Whether to print waveform statistics.
     
     /// The object used to print tick labels.
     std::unique_ptr<dump::raw::OpDetWaveformDumper::TimeLabelMaker> fTimeLabel;
     
-    /// Returns pointers to all waveforms in a vector with channel as index.
-    static std::vector<std::vector<raw::OpDetWaveform const*>>
-    groupByChannel(std::vector<raw::OpDetWaveform> const& waveforms);
+    /// Returns pointers to all selected waveforms in a vector with channel
+    /// as index.
+    static std::vector<std::vector<raw::OpDetWaveform const*>> groupByChannel(
+      std::vector<raw::OpDetWaveform> const& waveforms,
+      recob::dumper::DumpSampler const& sampler
+      );
     
     /// Sorts all the waveforms in the vector by growing timestamp.
     static void sortByTimestamp
       (std::vector<raw::OpDetWaveform const*>& waveforms);
     
+    /// Statistics of the ADC readings of a waveform.
+    struct WaveformSummary {
+      std::size_t n = 0; ///< Number of readings.
+      raw::ADC_Count_t min = 0; ///< Minimum reading.
+      raw::ADC_Count_t max = 0; ///< Maximum reading.
+      double mean = 0.0; ///< Mean of the readings (pedestal subtracted).
+      double rms = 0.0; ///< RMS of the readings.
+    }; // struct WaveformSummary
+    
+    /// Computes the statistics of the readings of waveform, in a single pass
+    /// with integer accumulators (which the compiler can vectorize).
+    static WaveformSummary summarize
+      (raw::OpDetWaveform const& waveform, raw::ADC_Count_t pedestal);
+    
   }; // class DumpOpDetWaveforms
 
 } // namespace detsim
@@ -155,12 +218,17 @@ namespace detsim {
 namespace detsim {
 
   //-------------------------------------------------
-  DumpOpDetWaveforms::DumpOpDetWaveforms(Parameters const& config)
-    : EDAnalyzer         (config)
+  DumpOpDetWaveforms::DumpOpDetWaveforms
+    (Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer     (config)
     , fOpDetWaveformsTag (config().OpDetWaveformsTag())
     , fOutputCategory    (config().OutputCategory())
     , fDigitsPerLine     (config().DigitsPerLine())
     , fPedestal          (config().Pedestal())
+    , fSampler           (config().Sampling())
+    , fMaxSamples        (config().MaxSamples())
+    , fDumpSamples       (config().DumpSamples())
+    , fPrintSummary      (config().PrintSummary())
   {
     std::string const tickLabelStr = config().TickLabel();
     if (tickLabelStr == "none") {
@@ -181,11 +249,17 @@ namespace detsim {
         << "Invalid choice '" << tickLabelStr << "' for time label.\n";
     }
     
+    async<art::InEvent>();
+    
   } // DumpOpDetWaveforms::DumpOpDetWaveforms()
 
 
   //-------------------------------------------------
-  void DumpOpDetWaveforms::analyze(const art::Event& event) {
+  void DumpOpDetWaveforms::analyze
+    (art::Event const& event, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     // fetch the data to be dumped on screen
     auto Waveforms =
@@ -195,15 +269,16 @@ namespace detsim {
     dump.setIndent("    ");
     dump.setTimeLabelMaker(fTimeLabel.get());
 
-    mf::LogVerbatim(fOutputCategory)
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line()
       << "The event " << event.id() << " contains data for "
       << Waveforms->size() << " optical detector channels";
     if (fPedestal != 0) {
-      mf::LogVerbatim(fOutputCategory) << "A pedestal of " << fPedestal
+      out.line() << "A pedestal of " << fPedestal
         << " counts will be subtracted from all ADC readings.";
     } // if pedestal
     
-    auto groupedWaveforms = groupByChannel(*Waveforms);
+    auto groupedWaveforms = groupByChannel(*Waveforms, fSampler);
     
     for (auto& channelWaveforms: groupedWaveforms) {
       if (channelWaveforms.empty()) continue;
@@ -211,13 +286,36 @@ namespace detsim {
       sortByTimestamp(channelWaveforms);
       auto const channel = channelWaveforms.front()->ChannelNumber();
       
-      mf::LogVerbatim(fOutputCategory)
+      out.line()
         << "  optical detector channel #" << channel << " has "
         << channelWaveforms.size() << " waveforms:";
       
+      raw::OpDetWaveform truncated; // buffer for the capped dumps
       for (raw::OpDetWaveform const* pWaveform: channelWaveforms) {
-        mf::LogVerbatim log(fOutputCategory);
-        dump(log, *pWaveform);
+        recob::dumper::EventDump& log = out.line();
+        if (!fDumpSamples) {
+          log << "    waveform at " << pWaveform->TimeStamp() << " with "
+            << pWaveform->size() << " samples";
+        }
+        else if ((fMaxSamples > 0) && (pWaveform->size() > fMaxSamples)) {
+          truncated.SetTimeStamp(pWaveform->TimeStamp());
+          truncated.SetChannelNumber(pWaveform->ChannelNumber());
+          truncated.assign
+            (pWaveform->begin(), pWaveform->begin() + fMaxSamples);
+          dump(log, truncated);
+          log << "\n    (only the first " << fMaxSamples << " of "
+            << pWaveform->size() << " samples dumped)";
+        }
+        else dump(log, *pWaveform);
+        
+        if (fPrintSummary) {
+          WaveformSummary const summary = summarize(*pWaveform, fPedestal);
+          log << "\n    " << summary.n << " samples";
+          if (summary.n > 0) {
+            log << ", min " << summary.min << ", max " << summary.max
+              << ", mean " << summary.mean << ", RMS " << summary.rms;
+          }
+        } // if summary
       } // for waveforms on channel
       
     } // for all channels
@@ -227,12 +325,15 @@ namespace detsim {
 
   //----------------------------------------------------------------------------
   std::vector<std::vector<raw::OpDetWaveform const*>>
-  DumpOpDetWaveforms::groupByChannel
-    (std::vector<raw::OpDetWaveform> const& waveforms)
-  {
+  DumpOpDetWaveforms::groupByChannel(
+    std::vector<raw::OpDetWaveform> const& waveforms,
+    recob::dumper::DumpSampler const& sampler
+  ) {
     std::vector<std::vector<raw::OpDetWaveform const*>> groups;
-    for (auto const& waveform: waveforms) {
+    for (std::size_t iWaveform = 0; iWaveform < waveforms.size(); ++iWaveform) {
+      auto const& waveform = waveforms[iWaveform];
       auto const channel = waveform.ChannelNumber();
+      if (!sampler.selectElement(iWaveform, channel)) continue;
       if (groups.size() <= channel) groups.resize(channel + 1);
       groups[channel].push_back(&waveform);
     } // for
@@ -265,11 +366,42 @@ namespace detsim {
         { return sort(*a, *b); }
       
     }; // struct ChannelSorter
+    // waveforms are usually already in order: no need to sort them then
+    if (std::is_sorted(waveforms.begin(), waveforms.end(), ChannelSorter()))
+      return;
     std::sort(waveforms.begin(), waveforms.end(), ChannelSorter());
     
   } // DumpOpDetWaveforms::sortByTimestamp()
   
   
+  //----------------------------------------------------------------------------
+  DumpOpDetWaveforms::WaveformSummary DumpOpDetWaveforms::summarize
+    (raw::OpDetWaveform const& waveform, raw::ADC_Count_t pedestal)
+  {
+    WaveformSummary summary;
+    summary.n = waveform.size();
+    if (waveform.empty()) return summary;
+    
+    raw::ADC_Count_t const* data = waveform.data();
+    raw::ADC_Count_t min = data[0], max = data[0];
+    std::int64_t sum = 0, sum2 = 0;
+    for (std::size_t i = 0; i < summary.n; ++i) {
+      std::int64_t const value = data[i] - pedestal;
+      min = std::min(min, data[i]);
+      max = std::max(max, data[i]);
+      sum += value;
+      sum2 += value * value;
+    } // for
+    
+    summary.min = min - pedestal;
+    summary.max = max - pedestal;
+    summary.mean = double(sum) / summary.n;
+    double const variance = double(sum2) / summary.n - summary.mean * summary.mean;
+    summary.rms = (variance > 0.0)? std::sqrt(variance): 0.0;
+    return summary;
+  } // DumpOpDetWaveforms::summarize()
+  
+  
   //----------------------------------------------------------------------------
   DEFINE_ART_MODULE(DumpOpDetWaveforms)
 
@@ -6,10 +6,12 @@
  */
 
 // LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 
 // art libraries
 #include "canvas/Utilities/InputTag.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Principal/Event.h"
 
 // support libraries
@@ -17,6 +19,7 @@
 #include "fhiclcpp/types/Comment.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Table.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
@@ -40,9 +43,18 @@ namespace recob {
    *   for the output (useful for filtering)
    * - *PrintHexFloats* (boolean, default: `false`): print all the floating
    *   point numbers in base 16
+   * - *PrintExactFloats* (boolean, default: `false`): print all the floating
+   *   point numbers in base 10, with the shortest representation that reads
+   *   back into exactly the same number (useful to compare dumps bit by bit);
+   *   ignored if *PrintHexFloats* is set
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the axes (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpPCAxes: public art::EDAnalyzer {
+  class DumpPCAxes: public art::SharedAnalyzer {
       public:
 
     /// Configuration parameters
@@ -64,22 +76,32 @@ namespace recob {
         Comment("print floating point numbers in base 16 [false]"),
         false /* default value */
         };
+      fhicl::Atom<bool> PrintExactFloats {
+        Name   ("PrintExactFloats"),
+        Comment("print floating point numbers exactly, in base 10 [false]"),
+        false /* default value */
+        };
+
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
 
     }; // struct Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
     /// Default constructor
-    explicit DumpPCAxes(Parameters const& config);
+    DumpPCAxes(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    virtual void analyze (const art::Event& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fInputTag; ///< input tag of the PCAxis product
     std::string fOutputCategory; ///< category for LogInfo output
     bool fPrintHexFloats; ///< whether to print floats in base 16
+    bool fPrintExactFloats; ///< whether to print floats exactly
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped axes
 
   }; // class DumpPCAxes
 
@@ -100,7 +122,6 @@ namespace recob {
 #include "art/Framework/Principal/Handle.h"
 
 // support libraries
-#include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C//C++ standard libraries
 
@@ -114,6 +135,7 @@ namespace {
     /// Collection of available printing style options
     struct PrintOptions_t {
       bool hexFloats = false; ///< print all floating point numbers in base 16
+      bool exactFloats = false; ///< print all floating point numbers exactly
     }; // PrintOptions_t
 
 
@@ -129,6 +151,10 @@ namespace {
       , options(print_options)
       {}
 
+    /// Sets the selection of the axes to be dumped (`nullptr`: all axes)
+    void SetSampler(recob::dumper::DumpSampler const* pca_sampler)
+      { sampler = pca_sampler; }
+
 
     /// Dump a space point specified by its index in the input list
     template <typename Stream>
@@ -146,7 +172,9 @@ namespace {
 
         auto nl = recob::dumper::makeNewLine
           (out, indentstr + "  ", true /* follow */);
-        recob::dumper::DumpPCAxis(out, pca, nl);
+        recob::dumper::DumpPCAxis(out, pca, nl,
+          lar::FloatFormat::select(options.hexFloats, options.exactFloats)
+          );
 
         //
         // done
@@ -161,8 +189,10 @@ namespace {
       {
         indentstr += "  ";
         size_t const nPCAs = pcas.size();
-        for (size_t iPCA = 0; iPCA < nPCAs; ++iPCA)
+        for (size_t iPCA = 0; iPCA < nPCAs; ++iPCA) {
+          if (sampler && !sampler->selectElement(iPCA)) continue;
           DumpPCAxis(std::forward<Stream>(out), iPCA, indentstr);
+        } // for
       } // DumpAllPCAxes()
 
 
@@ -172,6 +202,9 @@ namespace {
 
     PrintOptions_t options; ///< printing and formatting options
 
+    /// Selection of the axes to be dumped (`nullptr`: all)
+    recob::dumper::DumpSampler const* sampler = nullptr;
+
   }; // PCAxisDumper
 
 
@@ -185,16 +218,24 @@ namespace {
 namespace recob {
 
   //----------------------------------------------------------------------------
-  DumpPCAxes::DumpPCAxes(Parameters const& config)
-    : EDAnalyzer(config)
+  DumpPCAxes::DumpPCAxes(Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer(config)
     , fInputTag(config().PCAxisModuleLabel())
     , fOutputCategory(config().OutputCategory())
     , fPrintHexFloats(config().PrintHexFloats())
-    {}
+    , fPrintExactFloats(config().PrintExactFloats())
+    , fSampler(config().Sampling())
+    {
+      async<art::InEvent>();
+    }
 
 
   //----------------------------------------------------------------------------
-  void DumpPCAxes::analyze(const art::Event& evt) {
+  void DumpPCAxes::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     //
     // collect all the available information
@@ -203,18 +244,21 @@ namespace recob {
     auto PCAxes = evt.getValidHandle<std::vector<recob::PCAxis>>(fInputTag);
 
     size_t const nPCAs = PCAxes->size();
-    mf::LogInfo(fOutputCategory)
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line()
       << "The event contains " << nPCAs << " PC axes from '"
       << fInputTag.encode() << "'";
 
     // prepare the dumper
     PCAxisDumper::PrintOptions_t options;
     options.hexFloats = fPrintHexFloats;
+    options.exactFloats = fPrintExactFloats;
     PCAxisDumper dumper(*PCAxes, options);
+    dumper.SetSampler(&fSampler);
 
-    dumper.DumpAllPCAxes(mf::LogVerbatim(fOutputCategory), "  ");
+    dumper.DumpAllPCAxes(out.line(), "  ");
 
-    mf::LogVerbatim(fOutputCategory) << "\n"; // two empty lines
+    out.line() << "\n"; // two empty lines
 
   } // DumpPCAxes::analyze()
 
@@ -7,21 +7,27 @@
 
 // LArSoft includes
 #include "lardataobj/RecoBase/PFParticle.h"
-#include "lardata/ArtDataHelper/Dumpers/hexfloat.h"
+#include "lardata/ArtDataHelper/Dumpers/FloatFormat.h"
+#include "lardata/ArtDataHelper/Dumpers/AsyncDumpWriter.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
+#include "lardata/ArtDataHelper/PFParticleHierarchy.h"
 
 // art libraries
 #include "canvas/Utilities/InputTag.h"
 #include "canvas/Persistency/Provenance/EventID.h"
 #include "art/Framework/Principal/Provenance.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Principal/Event.h"
 
 // support libraries
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/OptionalAtom.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
+#include <memory> // std::unique_ptr<>
 
 // ... and more in the implementation part
 
@@ -42,6 +48,10 @@ namespace recob {
    *   used for the output (useful for filtering)
    * - *PrintHexFloats* (boolean, default: `false`): print all the floating
    *   point numbers in base 16
+   * - *PrintExactFloats* (boolean, default: `false`): print all the floating
+   *   point numbers in base 10, with the shortest representation that reads
+   *   back into exactly the same number (useful to compare dumps bit by bit);
+   *   ignored if *PrintHexFloats* is set
    * - *MaxDepth* (unsigned int, optional): if specified, at most this number of
    *   particle generations will be printed; 1 means printing only primaries and
    *   their daughters, 0 only primaries. If not specified, no limit will be
@@ -51,6 +61,22 @@ namespace recob {
    *   `ProcessName_ModuleLabel_InstanceName_Run#_Subrun#_Event#_particles.dot`,
    *   where the the input label elements refer to the data product being
    *   plotted.
+   * - *BufferedOutput* (boolean, default: `false`): the output is collected in
+   *   large blocks which are written by a separate thread, so that the event
+   *   processing does not wait for the output to be written
+   * - *OutputFile* (string, default: empty): with _BufferedOutput_, the output
+   *   is written into this file instead of into the message facility
+   * - *ParallelFormatting* (boolean, default: `false`): the tree of each
+   *   primary particle is formatted concurrently with the others, and the
+   *   results are printed in the usual order; the output is the same as
+   *   without this option
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the primary particles, together with their
+   *   descendants (see `recob::dumper::SamplingConfig`); when sampling the
+   *   particles, the ones not descending from a primary are not reported
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message (or a single block, with _BufferedOutput_).
    *
    *
    * Particle connection graphs
@@ -128,7 +154,7 @@ namespace recob {
    *    as parent
    *
    */
-  class DumpPFParticles: public art::EDAnalyzer {
+  class DumpPFParticles: public art::SharedAnalyzer {
       public:
 
     struct Config {
@@ -152,6 +178,12 @@ namespace recob {
         false
       };
 
+      fhicl::Atom<bool> PrintExactFloats {
+        Name("PrintExactFloats"),
+        Comment("print all the floating point numbers exactly, in base 10"),
+        false
+      };
+
       fhicl::OptionalAtom<unsigned int> MaxDepth {
         Name("MaxDepth"),
         Comment("at most this number of particle generations will be printed")
@@ -163,23 +195,51 @@ namespace recob {
         false
       };
 
+      fhicl::Atom<bool> BufferedOutput {
+        Name("BufferedOutput"),
+        Comment("writes the output in large blocks from a separate thread"),
+        false
+      };
+
+      fhicl::Atom<std::string> OutputFile {
+        Name("OutputFile"),
+        Comment
+          ("with BufferedOutput, file to write into (empty: message facility)"),
+        ""
+      };
+
+      fhicl::Atom<bool> ParallelFormatting {
+        Name("ParallelFormatting"),
+        Comment("formats the tree of each primary particle concurrently"),
+        false
+      };
+
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
+
     }; // struct Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
     /// Default constructor
-    explicit DumpPFParticles(Parameters const& config);
+    DumpPFParticles(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    virtual void analyze (const art::Event& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fInputTag; ///< input tag of the PFParticle product
     std::string fOutputCategory; ///< category for LogInfo output
     bool fPrintHexFloats; ///< whether to print floats in base 16
+    bool fPrintExactFloats; ///< whether to print floats exactly
     unsigned int fMaxDepth; ///< maximum generation to print (0: only primaries)
     bool fMakeEventGraphs; ///< whether to create one DOT file per event
+    bool fParallelFormatting; ///< whether to format primaries concurrently
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped particles
+
+    /// buffered output writer (if any)
+    std::unique_ptr<recob::dumper::AsyncDumpWriter> fWriter;
 
 
     static std::string DotFileName
@@ -216,113 +276,18 @@ namespace recob {
 // support libraries
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 // C//C++ standard libraries
 #include <fstream>
-#include <utility> // std::swap()
+#include <sstream>
 #include <algorithm> // std::count(), std::find()
 #include <limits> // std::numeric_limits<>
 
 
 namespace {
-  /**
-   * @brief A container keyed by integer key (size_t).
-   * @tparam T type of contained element
-   */
-  template <typename T>
-  class int_map: private std::vector<T> {
-    using map_type = std::vector<T>;
-      public:
-    using this_type = int_map<T>;
-
-    using typename map_type::value_type;
-    using typename map_type::reference;
-    using typename map_type::const_reference;
-    using typename map_type::iterator;
-    using typename map_type::const_iterator;
-
-    using typename map_type::size_type;
-
-
-    /// Default constructor: "invalid data" is default-constructed
-    int_map() = default;
-
-    /// Constructor: sets the value of invalid data
-    int_map(value_type invalid_value): invalid(invalid_value) {}
-
-
-    /// Resizes the map to accomodate this many items
-    void resize(size_t new_size)
-      { get_map().resize(new_size, invalid_value()); }
-
-    /// Creates the item at specified position with invalid value and returns it
-    reference operator[] (size_t pos)
-      { if (pos >= size()) resize(pos + 1); return get_map()[pos]; }
-
-    /// Returns the item at specified position, or invalid value if not existing
-    const_reference operator[] (size_t pos) const
-      { return (pos >= size())? invalid: get_map()[pos]; }
-
-    using map_type::size;
-    using map_type::empty;
-
-    using map_type::begin;
-    using map_type::end;
-    using map_type::cbegin;
-    using map_type::cend;
-    using map_type::rbegin;
-    using map_type::rend;
-    using map_type::crbegin;
-    using map_type::crend;
-
-    /// Swaps the content of data and of this map
-    void swap(this_type& data)
-      { swap(data.get_map()); std::swap(data.invalid, invalid); }
-
-    /// Swaps the content of data and of this map
-    void swap(std::vector<T>& data) { map_type::swap(data); }
-
-    // non-standard calls follow
-    /// Returns the number of invalid elements
-    size_type n_invalid() const
-      { return std::count(begin(), end(), invalid); }
-
-    /// Returns the number of valid elements
-    size_type n_valid() const { return size() - n_invalid(); }
-
-    /// Returns whether the element at specified position is valid
-    bool is_valid(size_type pos) const
-      { return (pos < size())? is_valid_value(get_map()[pos]): false; }
-
-    /// Returns whether the specified value is valid
-    bool is_valid_value(value_type const& v) const { return v != invalid; }
-
-    /// Returns the invalid value
-    value_type const& invalid_value() const { return invalid; }
-
-
-      private:
-    value_type const invalid; ///< value of invalid data
-
-    map_type& get_map() { return static_cast<map_type&>(*this); }
-    map_type const& get_map() const
-      { return static_cast<map_type const&>(*this); }
-
-  }; // int_map<>
-
-
-  //----------------------------------------------------------------------------
-  int_map<size_t> CreateMap(std::vector<recob::PFParticle> const& particles) {
-
-    int_map<size_t> pmap(std::numeric_limits<size_t>::max());
-    pmap.resize(particles.size());
-
-    size_t const nParticles = particles.size();
-    for (size_t iPart = 0; iPart < nParticles; ++iPart)
-      pmap[particles[iPart].Self()] = iPart;
-
-    return pmap;
-  } // CreateMap()
-
 
   //----------------------------------------------------------------------------
   bool hasDaughter(recob::PFParticle const& particle, size_t partID) {
@@ -339,13 +304,28 @@ namespace {
     /// Collection of available printing style options
     struct PrintOptions_t {
       bool hexFloats = false; ///< print all floating point numbers in base 16
+      bool exactFloats = false; ///< print all floating point numbers exactly
       /// number of particle generations to descent into (0: only primaries)
       unsigned int maxDepth = std::numeric_limits<unsigned int>::max();
-      /// name of the output stream
-      std::string streamName;
+      /// collector of the output of the event (required for dumping)
+      recob::dumper::EventDump* output = nullptr;
+      /// whether to format the primary particles concurrently
+      bool parallel = false;
+      /// selection of the primary particles to be dumped (if null, all)
+      recob::dumper::DumpSampler const* sampler = nullptr;
     }; // PrintOptions_t
 
 
+    /// Number of times a particle has been visited, on entry and on exit
+    struct VisitRecord_t {
+      unsigned int atEntry = 0U; ///< visits including the current one
+      unsigned int atExit = 0U; ///< visits after the daughters were dumped
+    }; // VisitRecord_t
+
+    /// Position in the sequence of visits planned for a primary particle
+    using VisitCursor_t = std::vector<VisitRecord_t>::const_iterator;
+
+
     /// Constructor; will dump particles from the specified list
     ParticleDumper(std::vector<recob::PFParticle> const& particle_list)
       : ParticleDumper(particle_list, {})
@@ -359,7 +339,7 @@ namespace {
       : particles(particle_list)
       , options(print_options)
       , visited(particles.size(), 0U)
-      , particle_map (CreateMap(particles))
+      , hierarchy(particles)
       {}
 
 
@@ -390,22 +370,46 @@ namespace {
 
     /// Dump a particle specified by its index in the input particle list
     /// @param gen max generations to print
+    /// @param plan if specified, visit counts are read from there
     template <typename Stream>
     void DumpParticle(
       Stream&& out, size_t iPart, std::string indentstr = "",
-      unsigned int gen = 0
+      unsigned int gen = 0, VisitCursor_t* plan = nullptr
       ) const;
 
 
     /// Dump a particle specified by its ID
     /// @param gen max generations to print
+    /// @param plan if specified, visit counts are read from there
     template <typename Stream>
     void DumpParticleWithID(
       Stream&& out, size_t pID, std::string indentstr = "",
-      unsigned int gen = 0
+      unsigned int gen = 0, VisitCursor_t* plan = nullptr
       ) const;
 
 
+    /**
+     * @brief Counts the visits of a particle and its descendants
+     * @param iPart index of the particle in the input list
+     * @param gen max generations to visit
+     * @param plan sequence where visit counts are appended
+     *
+     * The visits are counted as `DumpParticle()` would, and the counts are
+     * recorded in the same order as `DumpParticle()` reads them.
+     * This allows the formatting of different particles, which depends on
+     * the number of previous visits, to happen concurrently.
+     */
+    void PlanVisits
+      (size_t iPart, unsigned int gen, std::vector<VisitRecord_t>& plan) const;
+
+
+    /// Returns whether the particle is a primary selected for dumping
+    bool isSelectedPrimary(size_t iPart) const
+      {
+        return particles[iPart].IsPrimary()
+          && (!options.sampler || options.sampler->selectElement(iPart));
+      }
+
     /// Dumps all primary particles
     void DumpAllPrimaries(std::string indentstr = "") const;
 
@@ -444,7 +448,12 @@ namespace {
     /// Number of dumps on each particle
     mutable std::vector<unsigned int> visited;
 
-    int_map<size_t> const particle_map; ///< fast lookup index by particle ID
+    /// Relations between the particles, by position in the list
+    recob::PFParticleHierarchy const hierarchy;
+
+    /// Returns a new line of output
+    recob::dumper::EventDump& OutputLine() const
+      { return options.output->line(); }
 
 
     template <typename Stream>
@@ -554,15 +563,15 @@ namespace {
   template <typename Stream>
   void ParticleDumper::DumpParticle(
     Stream&& out, size_t iPart, std::string indentstr /* = "" */,
-    unsigned int gen /* = 0 */
+    unsigned int gen /* = 0 */, VisitCursor_t* plan /* = nullptr */
     ) const
   {
-    lar::OptionalHexFloat hexfloat(options.hexFloats);
-
     recob::PFParticle const& part = particles.at(iPart);
-    ++visited[iPart];
+    VisitRecord_t const* visit = plan? &*((*plan)++): nullptr;
+    if (!visit) ++visited[iPart];
+    unsigned int const nVisits = visit? visit->atEntry: visited[iPart];
 
-    if (visited[iPart] > 1) {
+    if (nVisits > 1) {
       out << indentstr << "particle " << part.Self()
         << " already printed!!!";
       return;
@@ -636,7 +645,8 @@ namespace {
           }
           else {
             out << '\n';
-            DumpParticleWithID(out, DaughterID, indentstr + "  ", gen - 1);
+            DumpParticleWithID
+              (out, DaughterID, indentstr + "  ", gen - 1, plan);
           }
         }
       } // if descending
@@ -648,7 +658,7 @@ namespace {
     //
     // warnings
     //
-    if (visited[iPart] == 2) {
+    if ((visit? visit->atExit: visited[iPart]) == 2) {
       out << "\n" << indentstr << "  WARNING: particle ID=" << PartID
         << " connected more than once!";
     }
@@ -664,11 +674,11 @@ namespace {
   template <typename Stream>
   void ParticleDumper::DumpParticleWithID(
     Stream&& out, size_t pID, std::string indentstr /* = "" */,
-    unsigned int gen /* = 0 */
+    unsigned int gen /* = 0 */, VisitCursor_t* plan /* = nullptr */
   ) const {
-    size_t const pos = particle_map[pID];
-    if (particle_map.is_valid_value(pos)) {
-      DumpParticle(out, pos, indentstr, gen);
+    size_t const pos = hierarchy.index(pID);
+    if (pos != recob::PFParticleHierarchy::InvalidIndex) {
+      DumpParticle(out, pos, indentstr, gen, plan);
     }
     else {
       out /* << "\n" */ << indentstr << "<ID=" << pID << " not found>";
@@ -676,21 +686,69 @@ namespace {
   } // ParticleDumper::DumpParticleWithID()
 
 
+  //----------------------------------------------------------------------------
+  void ParticleDumper::PlanVisits
+    (size_t iPart, unsigned int gen, std::vector<VisitRecord_t>& plan) const
+  {
+    // this follows the same path as DumpParticle()
+    size_t const iVisit = plan.size();
+    plan.push_back({ ++visited[iPart], 0U });
+    if (plan[iVisit].atEntry == 1) {
+      recob::PFParticle const& part = particles.at(iPart);
+      auto const PartID = part.Self();
+      if ((part.NumDaughters() > 0) && (gen > 0)) {
+        for (size_t DaughterID: part.Daughters()) {
+          if (DaughterID == PartID) continue;
+          size_t const pos = hierarchy.index(DaughterID);
+          if (pos != recob::PFParticleHierarchy::InvalidIndex)
+            PlanVisits(pos, gen - 1, plan);
+        } // for daughters
+      } // if descending
+    } // if first visit
+    plan[iVisit].atExit = visited[iPart];
+  } // ParticleDumper::PlanVisits()
+
+
   //----------------------------------------------------------------------------
   void ParticleDumper::DumpAllPrimaries(std::string indentstr /* = "" */) const
   {
     indentstr += "  ";
-    size_t const nParticles = particles.size();
-    unsigned int nPrimaries = 0;
-    for (size_t iPart = 0; iPart < nParticles; ++iPart) {
-      if (!particles[iPart].IsPrimary()) continue;
-      DumpParticle(
-        mf::LogVerbatim(options.streamName),
-        iPart, indentstr, options.maxDepth
-        );
-    } // for
+    std::vector<size_t> primaries;
+    for (size_t iPart: hierarchy.primaries())
+      if (isSelectedPrimary(iPart)) primaries.push_back(iPart);
+    size_t const nPrimaries = primaries.size();
+    if (options.parallel) {
+      // the visits are counted serially, in the same order as DumpParticle()
+      // would do, then each primary is formatted into its own buffer
+      std::vector<std::vector<VisitRecord_t>> plans(primaries.size());
+      for (size_t i = 0; i < primaries.size(); ++i)
+        PlanVisits(primaries[i], options.maxDepth, plans[i]);
+
+      std::vector<std::string> buffers(primaries.size());
+      tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, primaries.size(), 1),
+        [&](tbb::blocked_range<size_t> const& range) {
+          for (size_t i = range.begin(); i != range.end(); ++i) {
+            std::ostringstream out;
+            VisitCursor_t plan = plans[i].cbegin();
+            DumpParticle
+              (out, primaries[i], indentstr, options.maxDepth, &plan);
+            buffers[i] = out.str();
+          } // for
+        });
+
+      for (std::string const& buffer: buffers) OutputLine() << buffer;
+    }
+    else {
+      for (size_t iPart: primaries) {
+        DumpParticle(
+          OutputLine(),
+          iPart, indentstr, options.maxDepth
+          );
+      } // for
+    }
     if (nPrimaries == 0) {
-      mf::LogVerbatim(options.streamName)
+      OutputLine()
         << indentstr << "No primary particle found";
     }
   } // ParticleDumper::DumpAllPrimaries()
@@ -701,21 +759,23 @@ namespace {
   {
     // first print all the primary particles
     DumpAllPrimaries(indentstr);
+    // with a sample of the primaries, the unvisited particles are not known
+    if (options.sampler && options.sampler->samplesElements()) return;
     // then find out if there are any that are "disconnected"
     unsigned int const nDisconnected
       = std::count(visited.begin(), visited.end(), 0U);
     if (nDisconnected) {
-      mf::LogVerbatim(options.streamName) << indentstr
+      OutputLine() << indentstr
         << nDisconnected << " particles not coming from primary ones:";
       size_t const nParticles = visited.size();
       for (size_t iPart = 0; iPart < nParticles; ++iPart) {
         if (visited[iPart] > 0) continue;
         DumpParticle(
-          mf::LogVerbatim(options.streamName), iPart, indentstr + "  ",
+          OutputLine(), iPart, indentstr + "  ",
           options.maxDepth
           );
       } // for unvisited particles
-      mf::LogVerbatim(options.streamName) << indentstr
+      OutputLine() << indentstr
         << "(end of " << nDisconnected << " particles not from primaries)";
     } // if there are disconnected particles
     // TODO finally, note if there are multiply-connected particles
@@ -770,10 +830,11 @@ namespace {
     recob::Vertex const& vertex = VertexRef.ref();
     std::array<double, 3> vtx_pos;
     vertex.XYZ(vtx_pos.data());
-    lar::OptionalHexFloat hexfloat(options.hexFloats);
+    lar::FloatFormat const fmt
+      = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
     out << " [decay at ("
-      << hexfloat(vtx_pos[0]) << "," << hexfloat(vtx_pos[1])
-      << "," << hexfloat(vtx_pos[2])
+      << fmt(vtx_pos[0]) << "," << fmt(vtx_pos[1])
+      << "," << fmt(vtx_pos[2])
       << "), ID=" << vertex.ID() << "]";
 
   } // ParticleDumper::DumpVertex()
@@ -787,11 +848,12 @@ namespace {
       out << "axis is invalid";
       return;
     }
-    lar::OptionalHexFloat hexfloat(options.hexFloats);
+    lar::FloatFormat const fmt
+      = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
     out << "axis ID=" << axis.getID() << ", principal: ("
-        << hexfloat(axis.getEigenVectors()[0][0])
-        << ", " << hexfloat(axis.getEigenVectors()[0][1])
-        << ", " << hexfloat(axis.getEigenVectors()[0][2]) << ")";
+        << fmt(axis.getEigenVectors()[0][0])
+        << ", " << fmt(axis.getEigenVectors()[0][1])
+        << ", " << fmt(axis.getEigenVectors()[0][2]) << ")";
   } // ParticleDumper::DumpPCAxisDirection()
 
   template <typename Stream>
@@ -830,13 +892,14 @@ namespace {
     std::array<double, 3> start, dir;
     seed.GetDirection(dir.data(), nullptr);
     seed.GetPoint(start.data(), nullptr);
-    lar::OptionalHexFloat hexfloat(options.hexFloats);
+    lar::FloatFormat const fmt
+      = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
     out << "\n" << indentstr
-      << "    (" << hexfloat(start[0]) << "," << hexfloat(start[1])
-      << "," << hexfloat(start[2])
-      << ")=>(" << hexfloat(dir[0]) << "," << hexfloat(dir[1])
-      << "," << hexfloat(dir[2])
-      << "), " << hexfloat(seed.GetLength()) << " cm"
+      << "    (" << fmt(start[0]) << "," << fmt(start[1])
+      << "," << fmt(start[2])
+      << ")=>(" << fmt(dir[0]) << "," << fmt(dir[1])
+      << "," << fmt(dir[2])
+      << "), " << fmt(seed.GetLength()) << " cm"
       ;
   } // ParticleDumper::DumpSeed()
 
@@ -860,10 +923,11 @@ namespace {
     (Stream&& out, recob::SpacePoint const& sp) const
   {
     const double* pos = sp.XYZ();
-    lar::OptionalHexFloat hexfloat(options.hexFloats);
+    lar::FloatFormat const fmt
+      = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
     out << "  ID=" << sp.ID()
-      << " at (" << hexfloat(pos[0]) << "," << hexfloat(pos[1])
-      << "," << hexfloat(pos[2]) << ") cm"
+      << " at (" << fmt(pos[0]) << "," << fmt(pos[1])
+      << "," << fmt(pos[2]) << ") cm"
       ;
   } // ParticleDumper::DumpSpacePoints()
 
@@ -893,14 +957,15 @@ namespace {
   template <typename Stream>
   void ParticleDumper::DumpTrack(Stream&& out, recob::Track const& track) const
   {
-    lar::OptionalHexFloat hexfloat(options.hexFloats);
-    out << " length " << hexfloat(track.Length())
-      << "cm from (" << hexfloat(track.Vertex().X())
-        << ";" << hexfloat(track.Vertex().Y())
-        << ";" << hexfloat(track.Vertex().Z())
-      << ") to (" << hexfloat(track.End().X())
-        << ";" << hexfloat(track.End().Y())
-        << ";" << hexfloat(track.End().Z())
+    lar::FloatFormat const fmt
+      = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
+    out << " length " << fmt(track.Length())
+      << "cm from (" << fmt(track.Vertex().X())
+        << ";" << fmt(track.Vertex().Y())
+        << ";" << fmt(track.Vertex().Z())
+      << ") to (" << fmt(track.End().X())
+        << ";" << fmt(track.End().Y())
+        << ";" << fmt(track.End().Z())
       << ") (ID=" << track.ID() << ")";
   } // ParticleDumper::DumpTrack()
 
@@ -998,7 +1063,7 @@ namespace {
   void PFParticleGraphMaker::WriteParticleEdges
     (Stream&& out, std::vector<recob::PFParticle> const& particles) const
   {
-    auto particle_map = CreateMap(particles);
+    recob::PFParticleHierarchy const hierarchy(particles);
 
     out
       << "\n  "
@@ -1017,8 +1082,8 @@ namespace {
       // draw parent line
       if (!particle.IsPrimary()) {
         auto const parentID = particle.Parent();
-        size_t const iParent = particle_map[parentID];
-        if (!particle_map.is_valid_value(iParent)) {
+        size_t const iParent = hierarchy.index(parentID);
+        if (iParent == recob::PFParticleHierarchy::InvalidIndex) {
           // parent is ghost
           out
             << "\nP" << parentID
@@ -1049,8 +1114,8 @@ namespace {
 
       // print daughter relationship only if daughters do not recognise us
       for (auto daughterID: particle.Daughters()) {
-        size_t const iDaughter = particle_map[daughterID];
-        if (!particle_map.is_valid_value(iDaughter)) {
+        size_t const iDaughter = hierarchy.index(daughterID);
+        if (iDaughter == recob::PFParticleHierarchy::InvalidIndex) {
           // daughter is ghost
           out
             << "\nP" << daughterID
@@ -1115,18 +1180,28 @@ namespace {
 namespace recob {
 
   //----------------------------------------------------------------------------
-  DumpPFParticles::DumpPFParticles(Parameters const& config)
-    : EDAnalyzer(config)
+  DumpPFParticles::DumpPFParticles
+    (Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer(config)
     , fInputTag(config().PFModuleLabel())
     , fOutputCategory(config().OutputCategory())
     , fPrintHexFloats(config().PrintHexFloats())
+    , fPrintExactFloats(config().PrintExactFloats())
     , fMaxDepth(std::numeric_limits<unsigned int>::max())
     , fMakeEventGraphs(config().MakeParticleGraphs())
+    , fParallelFormatting(config().ParallelFormatting())
+    , fSampler(config().Sampling())
     {
       // here we are handling the optional configuration key as it had just a
       // default value
       if (!config().MaxDepth(fMaxDepth))
         fMaxDepth = std::numeric_limits<unsigned int>::max();
+
+      if (config().BufferedOutput()) {
+        fWriter = std::make_unique<recob::dumper::AsyncDumpWriter>
+          (config().OutputFile(), fOutputCategory);
+      }
+      async<art::InEvent>();
     }
 
 
@@ -1171,7 +1246,11 @@ namespace recob {
 
 
   //----------------------------------------------------------------------------
-  void DumpPFParticles::analyze(const art::Event& evt) {
+  void DumpPFParticles::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     //
     // collect all the available information
@@ -1197,15 +1276,20 @@ namespace recob {
       (PFParticles, evt, fInputTag);
 
     size_t const nParticles = PFParticles->size();
-    mf::LogVerbatim(fOutputCategory) << "Event " << evt.id()
+    recob::dumper::EventDump out(fOutputCategory, fWriter.get());
+    out.line()
+      << "Event " << evt.id()
       << " contains " << nParticles << " particles from '"
       << fInputTag.encode() << "'";
 
     // prepare the dumper
     ParticleDumper::PrintOptions_t options;
     options.hexFloats = fPrintHexFloats;
+    options.exactFloats = fPrintExactFloats;
     options.maxDepth = fMaxDepth;
-    options.streamName = fOutputCategory;
+    options.output = &out;
+    options.parallel = fParallelFormatting;
+    options.sampler = &fSampler;
     ParticleDumper dumper(*PFParticles, options);
     if (ParticleVertices.isValid()) dumper.SetVertices(&ParticleVertices);
     else mf::LogPrint("DumpPFParticles") << "WARNING: vertex information not available";
@@ -1229,7 +1313,7 @@ namespace recob {
     }
     dumper.DumpAllParticles("  ");
 
-    mf::LogVerbatim(fOutputCategory) << "\n"; // two empty lines
+    out.line() << "\n"; // two empty lines
 
   } // DumpPFParticles::analyze()
 
@@ -6,28 +6,37 @@
  */
 
 // LArSoft includes
-#include "lardataalg/Utilities/StatCollector.h" // lar::util::MinMaxCollector<>
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/RawData/raw.h" // raw::Uncompress()
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Utilities/InputTag.h"
+#include "canvas/Utilities/Exception.h"
 
 // support libraries
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/TableFragment.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C//C++ standard libraries
 #include <string>
+#include <vector>
+#include <memory> // std::unique_ptr<>
 #include <algorithm> // std::min(), std::copy_n()
 #include <iomanip> // std::setprecision(), std::setw()
+#include <numeric> // std::adjacent_difference()
+#include <cmath> // std::sqrt()
+#include <cstddef> // std::size_t
 
 
 namespace detsim {
@@ -49,9 +58,36 @@ namespace detsim {
    *   will put this many of them for each line
    * - *Pedestal* (integer, default: `0`): digit values are written relative
    *   to this number
+   * - *Encoding* (string, default: `"plain"`): how the digits are printed:
+   *     * `"plain"`: all the digits, in fixed-width columns; lines identical to
+   *       the previous one are not repeated
+   *     * `"runlength"`: a sequence of consecutive identical digits is printed
+   *       as `value*count`
+   *     * `"delta"`: the first digit is printed, followed by the difference of
+   *       each digit from the previous one, with run-length encoding
+   *   _DigitsPerLine_ values (or runs) are printed per line
+   * - *ThresholdRMS* (real, default: `0`): channels whose pedestal-subtracted
+   *   digits have a RMS smaller than this are not printed
+   * - *ThresholdADC* (integer, default: `0`): channels whose pedestal-subtracted
+   *   digits never reach this absolute value are not printed
+   * - *BinaryFile* (string, default: empty): if specified, the content of the
+   *   raw digits is written into this file in the binary format described in
+   *   `BinaryDump.h` (uncompressed, and with no pedestal subtraction) instead
+   *   of into the message facility; `DumpBinaryToText` can print it as text
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*, *ChannelRange*: dump
+   *   only a sample of the events and of the channels (see
+   *   `recob::dumper::ChannelSamplingConfig`); the channels not sampled are not
+   *   even uncompressed
+   *
+   * The header of each printed channel includes the statistics of its
+   * pedestal-subtracted digits; the number of channels not printed because
+   * below threshold is reported at the end of each event.
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpRawDigits: public art::EDAnalyzer {
+  class DumpRawDigits: public art::SharedAnalyzer {
 
     /// Type to represent a digit.
     using Digit_t = raw::RawDigit::ADCvector_t::value_type;
@@ -59,6 +95,20 @@ namespace detsim {
     /// Type to represent a pedestal.
     using Pedestal_t = Digit_t;
 
+    /// How digits are printed.
+    enum class Encoding_t { Plain, RunLength, Delta };
+
+    /// Statistics of the digits of a channel.
+    struct ChannelStats_t {
+      Digit_t min = 0; ///< Minimum value.
+      Digit_t max = 0; ///< Maximum value.
+      double mean = 0.0; ///< Average value.
+      double RMS = 0.0; ///< Root mean square of the values around the mean.
+
+      /// Returns the largest absolute value.
+      Digit_t maxAbs() const { return std::max<Digit_t>(-min, max); }
+    }; // ChannelStats_t
+
       public:
 
     struct Config {
@@ -77,6 +127,13 @@ namespace detsim {
         "DumpDigits" /* default */
         };
 
+      fhicl::Atom<std::string> BinaryFile{
+        Name("BinaryFile"),
+        Comment("if not empty, the dump is written in binary form into this file"
+          " (convert it to text with DumpBinaryToText)"),
+        "" /* default */
+        };
+
       fhicl::Atom<unsigned int> DigitsPerLine{
         Name("DigitsPerLine"),
         Comment("number of digits printed per line (0: don't print digits)"),
@@ -89,19 +146,40 @@ namespace detsim {
         0 /* default */
         };
 
+      fhicl::Atom<std::string> Encoding{
+        Name("Encoding"),
+        Comment("how digits are printed: \"plain\", \"runlength\", \"delta\""),
+        "plain" /* default */
+        };
+
+      fhicl::Atom<double> ThresholdRMS{
+        Name("ThresholdRMS"),
+        Comment("channels with digit RMS below this are not printed"),
+        0.0 /* default */
+        };
+
+      fhicl::Atom<Digit_t> ThresholdADC{
+        Name("ThresholdADC"),
+        Comment("channels with no digit reaching this absolute value are not printed"),
+        0 /* default */
+        };
+
+      fhicl::TableFragment<recob::dumper::ChannelSamplingConfig> Sampling;
+
     }; // Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
 
     /// Constructor.
-    explicit DumpRawDigits(Parameters const& config);
+    DumpRawDigits(Parameters const& config, art::ProcessingFrame const&);
 
     /// Prints an introduction.
-    virtual void beginJob() override;
+    virtual void beginJob(art::ProcessingFrame const&) override;
 
     /// Does the printing.
-    virtual void analyze (art::Event const& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
@@ -109,14 +187,48 @@ namespace detsim {
     std::string fOutputCategory; ///< Category for `LogVerbatim` output.
     unsigned int fDigitsPerLine; ///< Ticks/digits per line in the output.
     Pedestal_t fPedestal; ///< ADC pedestal, will be subtracted from digits.
+    Encoding_t fEncoding; ///< How to print the digits.
+    double fThresholdRMS; ///< Minimum RMS of the channels to be printed.
+    Digit_t fThresholdADC; ///< Minimum digit of the channels to be printed.
+    recob::dumper::DumpSampler fSampler; ///< Selection of the dumped channels.
+
+    /// Binary output file (if any).
+    std::unique_ptr<recob::dumper::BinaryDumpWriter> fBinaryOut;
 
     /// Dumps a single `recob:Wire` to the specified output stream.
     template <typename Stream>
     void PrintRawDigit(
       Stream&& out, raw::RawDigit const& digits,
+      std::vector<Digit_t> const& samples, ChannelStats_t const& stats,
       std::string indent = "  ", std::string firstIndent = "  "
       ) const;
 
+    /// Prints the samples in fixed columns, skipping repeated lines.
+    template <typename Stream>
+    void PrintPlain
+      (Stream&& out, std::vector<Digit_t> const& samples, std::string indent)
+      const;
+
+    /// Prints the samples as `value*count` runs.
+    template <typename Stream>
+    void PrintRunLength(
+      Stream&& out, std::vector<Digit_t>::const_iterator begin,
+      std::vector<Digit_t>::const_iterator end, std::string indent
+      ) const;
+
+    /// Prints the first sample, then the run-length encoded differences.
+    template <typename Stream>
+    void PrintDelta
+      (Stream&& out, std::vector<Digit_t> const& samples, std::string indent)
+      const;
+
+    /// Uncompresses `digits`, subtracts the pedestal and returns statistics.
+    ChannelStats_t ExtractSamples
+      (raw::RawDigit const& digits, std::vector<Digit_t>& samples) const;
+
+    /// Parses the name of an encoding (throws on unknown names).
+    static Encoding_t ParseEncoding(std::string const& name);
+
   }; // class DumpRawDigits
 
 } // namespace detsim
@@ -125,17 +237,28 @@ namespace detsim {
 //------------------------------------------------------------------------------
 //---  Implementation
 //------------------------------------------------------------------------------
-detsim::DumpRawDigits::DumpRawDigits(Parameters const& config)
-  : EDAnalyzer         (config)
+detsim::DumpRawDigits::DumpRawDigits
+  (Parameters const& config, art::ProcessingFrame const&)
+  : SharedAnalyzer    (config)
   , fDetSimModuleLabel(config().DetSimModuleLabel())
   , fOutputCategory   (config().OutputCategory())
   , fDigitsPerLine    (config().DigitsPerLine())
   , fPedestal         (config().Pedestal())
-  {}
+  , fEncoding         (ParseEncoding(config().Encoding()))
+  , fThresholdRMS     (config().ThresholdRMS())
+  , fThresholdADC     (config().ThresholdADC())
+  , fSampler          (config().Sampling())
+  {
+    if (!config().BinaryFile().empty()) {
+      fBinaryOut = std::make_unique<recob::dumper::BinaryDumpWriter>
+        (config().BinaryFile());
+    }
+    async<art::InEvent>();
+  }
 
 
 //------------------------------------------------------------------------------
-void detsim::DumpRawDigits::beginJob() {
+void detsim::DumpRawDigits::beginJob(art::ProcessingFrame const&) {
 
   if (fPedestal != 0) {
     mf::LogVerbatim(fOutputCategory) << "A pedestal of " << fPedestal
@@ -146,20 +269,54 @@ void detsim::DumpRawDigits::beginJob() {
 
 
 //------------------------------------------------------------------------------
-void detsim::DumpRawDigits::analyze(art::Event const& evt) {
+void detsim::DumpRawDigits::analyze
+  (art::Event const& evt, art::ProcessingFrame const&)
+{
+
+  if (!fSampler.selectEvent()) return;
 
   auto const& RawDigits
     = *(evt.getValidHandle<std::vector<raw::RawDigit>>(fDetSimModuleLabel));
 
-  mf::LogVerbatim(fOutputCategory) << "Event " << evt.id()
+  if (fBinaryOut) {
+    auto const lock = fBinaryOut->lock(); // records of this event together
+    fBinaryOut->writeEvent(evt.run(), evt.subRun(), evt.event(),
+      fDetSimModuleLabel.encode(), RawDigits.size());
+    for (std::size_t iDigit = 0; iDigit < RawDigits.size(); ++iDigit) {
+      raw::RawDigit const& digits = RawDigits[iDigit];
+      if (!fSampler.selectElement(iDigit, digits.Channel())) continue;
+      recob::dumper::writeRawDigit(*fBinaryOut, digits);
+    } // for digits
+    return;
+  } // if binary output
+
+  recob::dumper::EventDump out(fOutputCategory);
+  out.line() << "Event " << evt.id()
     << " contains " << RawDigits.size() << " '" << fDetSimModuleLabel.encode()
     << "' waveforms";
-  for (raw::RawDigit const& digits: RawDigits) {
+  unsigned int nQuiet = 0; // channels below threshold
+  unsigned int nSampled = 0; // channels selected for dumping
+  std::vector<Digit_t> samples; // pedestal-subtracted digits of a channel
+  for (std::size_t iDigit = 0; iDigit < RawDigits.size(); ++iDigit) {
+    raw::RawDigit const& digits = RawDigits[iDigit];
+    if (!fSampler.selectElement(iDigit, digits.Channel())) continue;
+    ++nSampled;
+
+    ChannelStats_t const stats = ExtractSamples(digits, samples);
+    if ((stats.RMS < fThresholdRMS) || (stats.maxAbs() < fThresholdADC)) {
+      ++nQuiet;
+      continue;
+    }
 
-    PrintRawDigit(mf::LogVerbatim(fOutputCategory), digits);
+    PrintRawDigit(out.line(), digits, samples, stats);
 
   } // for digits
 
+  if (nQuiet > 0) {
+    out.line() << nQuiet << "/" << nSampled
+      << " channels below threshold were not printed";
+  }
+
 } // caldata::DumpWires::analyze()
 
 
@@ -167,21 +324,16 @@ void detsim::DumpRawDigits::analyze(art::Event const& evt) {
 template <typename Stream>
 void detsim::DumpRawDigits::PrintRawDigit(
   Stream&& out, raw::RawDigit const& digits,
+  std::vector<Digit_t> const& samples, ChannelStats_t const& stats,
   std::string indent /* = "  " */, std::string firstIndent /* = "  " */
 ) const {
 
-  //
-  // uncompress the digits
-  //
-  raw::RawDigit::ADCvector_t ADCs(digits.Samples());
-  raw::Uncompress(digits.ADCs(), ADCs, digits.Compression());
-
   //
   // print a header for the raw digits
   //
   out << firstIndent
-    << "  #" << digits.Channel() << ": " << ADCs.size() << " time ticks";
-  if (digits.Samples() != ADCs.size())
+    << "  #" << digits.Channel() << ": " << samples.size() << " time ticks";
+  if (digits.Samples() != samples.size())
     out << " [!!! EXPECTED " << digits.Samples() << "] ";
   out
     << " (" << digits.NADC() << " after compression); compression type: ";
@@ -195,67 +347,178 @@ void detsim::DumpRawDigits::PrintRawDigit(
     default:
       out << "unknown (#" << ((int) digits.Compression()) << ")"; break;
   } // switch
+  if (!samples.empty()) {
+    out << "\n" << indent
+      << "  range [" << stats.min << ";" << stats.max << "] mean "
+      << stats.mean << " RMS " << stats.RMS;
+  }
 
   // print the content of the channel
-  if (fDigitsPerLine > 0) {
-    std::vector<Digit_t> DigitBuffer(fDigitsPerLine), LastBuffer;
+  if (fDigitsPerLine == 0) return;
+
+  switch (fEncoding) {
+    case Encoding_t::Plain:
+      PrintPlain(out, samples, indent);
+      break;
+    case Encoding_t::RunLength:
+      out << "\n" << indent << "content of the channel (run-length encoded, "
+        << fDigitsPerLine << " runs per line):";
+      PrintRunLength(out, samples.cbegin(), samples.cend(), indent);
+      break;
+    case Encoding_t::Delta:
+      PrintDelta(out, samples, indent);
+      break;
+  } // switch
 
-    unsigned int repeat_count = 0; // additional lines like the last one
-    unsigned int index = 0;
-    lar::util::MinMaxCollector<Digit_t> Extrema;
-    out << "\n" << indent
-      << "content of the channel (" << fDigitsPerLine << " ticks per line):";
-    auto iTick = ADCs.cbegin(), tend = ADCs.cend(); // const iterators
-    while (iTick != tend) {
-      // the next line will show at most fDigitsPerLine ticks
-      unsigned int line_size
-        = std::min(fDigitsPerLine, (unsigned int) ADCs.size() - index);
-      if (line_size == 0) break; // no more ticks
-
-      // fill the new buffer (iTick will move forward)
-      DigitBuffer.resize(line_size);
-      auto iBuf = DigitBuffer.begin(), bend = DigitBuffer.end();
-      while ((iBuf != bend) && (iTick != tend))
-        Extrema.add(*(iBuf++) = (*(iTick++) - fPedestal));
-      index += line_size;
-
-      // if the new buffer is the same as the old one, just mark it
-      if (DigitBuffer == LastBuffer) {
-        repeat_count += 1;
-        continue;
-      }
-
-      // if there are previous repeats, write that on screen
-      // before the new, different line
-      if (repeat_count > 0) {
-        out << "\n" << indent
-          << "  [ ... repeated " << repeat_count << " more times, "
-          << (repeat_count * LastBuffer.size()) << " ticks ]";
-        repeat_count = 0;
-      }
-
-      // dump the new line of ticks
-      out << "\n" << indent << " ";
-      for (auto digit: DigitBuffer)
-        out << " " << std::setw(4) << digit;
-
-      // quick way to assign DigitBuffer to LastBuffer
-      // (we don't care we lose the former)
-      std::swap(LastBuffer, DigitBuffer);
-
-    } // while
-    if (repeat_count > 0) {
-      out << "\n" << indent
-        << "  [ ... repeated " << repeat_count << " more times to the end ]";
+} // detsim::DumpRawDigits::PrintRawDigit()
+
+
+//------------------------------------------------------------------------------
+template <typename Stream>
+void detsim::DumpRawDigits::PrintPlain
+  (Stream&& out, std::vector<Digit_t> const& samples, std::string indent) const
+{
+  std::vector<Digit_t> DigitBuffer(fDigitsPerLine), LastBuffer;
+
+  unsigned int repeat_count = 0; // additional lines like the last one
+  unsigned int index = 0;
+  out << "\n" << indent
+    << "content of the channel (" << fDigitsPerLine << " ticks per line):";
+  auto iTick = samples.cbegin(), tend = samples.cend(); // const iterators
+  while (iTick != tend) {
+    // the next line will show at most fDigitsPerLine ticks
+    unsigned int line_size
+      = std::min(fDigitsPerLine, (unsigned int) samples.size() - index);
+    if (line_size == 0) break; // no more ticks
+
+    // fill the new buffer (iTick will move forward)
+    DigitBuffer.assign(iTick, iTick + line_size);
+    iTick += line_size;
+    index += line_size;
+
+    // if the new buffer is the same as the old one, just mark it
+    if (DigitBuffer == LastBuffer) {
+      repeat_count += 1;
+      continue;
     }
-    if (Extrema.min() < Extrema.max()) {
+
+    // if there are previous repeats, write that on screen
+    // before the new, different line
+    if (repeat_count > 0) {
       out << "\n" << indent
-        << "  range of " << index
-        << " samples: [" << Extrema.min() << ";" << Extrema.max() << "]";
+        << "  [ ... repeated " << repeat_count << " more times, "
+        << (repeat_count * LastBuffer.size()) << " ticks ]";
+      repeat_count = 0;
     }
-  } // if dumping the ticks
 
-} // detsim::DumpRawDigits::analyze()
+    // dump the new line of ticks
+    out << "\n" << indent << " ";
+    for (auto digit: DigitBuffer)
+      out << " " << std::setw(4) << digit;
+
+    // quick way to assign DigitBuffer to LastBuffer
+    // (we don't care we lose the former)
+    std::swap(LastBuffer, DigitBuffer);
+
+  } // while
+  if (repeat_count > 0) {
+    out << "\n" << indent
+      << "  [ ... repeated " << repeat_count << " more times to the end ]";
+  }
+
+} // detsim::DumpRawDigits::PrintPlain()
+
+
+//------------------------------------------------------------------------------
+template <typename Stream>
+void detsim::DumpRawDigits::PrintRunLength(
+  Stream&& out, std::vector<Digit_t>::const_iterator begin,
+  std::vector<Digit_t>::const_iterator end, std::string indent
+) const {
+
+  unsigned int nRuns = 0;
+  auto iTick = begin;
+  while (iTick != end) {
+    Digit_t const value = *iTick;
+    auto const iRunEnd = std::find_if
+      (iTick, end, [value](Digit_t digit){ return digit != value; });
+    std::size_t const count = iRunEnd - iTick;
+    iTick = iRunEnd;
+
+    if (nRuns++ % fDigitsPerLine == 0) out << "\n" << indent << " ";
+    out << " " << value;
+    if (count > 1) out << "*" << count;
+  } // while
+
+} // detsim::DumpRawDigits::PrintRunLength()
+
+
+//------------------------------------------------------------------------------
+template <typename Stream>
+void detsim::DumpRawDigits::PrintDelta
+  (Stream&& out, std::vector<Digit_t> const& samples, std::string indent) const
+{
+  if (samples.empty()) return;
+
+  std::vector<Digit_t> deltas(samples.size());
+  std::adjacent_difference(samples.begin(), samples.end(), deltas.begin());
+
+  out << "\n" << indent << "content of the channel (starting from "
+    << samples.front() << ", differences from the previous tick, run-length"
+    " encoded, " << fDigitsPerLine << " runs per line):";
+  PrintRunLength(out, deltas.cbegin() + 1, deltas.cend(), indent);
+
+} // detsim::DumpRawDigits::PrintDelta()
+
+
+//------------------------------------------------------------------------------
+auto detsim::DumpRawDigits::ExtractSamples
+  (raw::RawDigit const& digits, std::vector<Digit_t>& samples) const
+  -> ChannelStats_t
+{
+  samples.resize(digits.Samples());
+  raw::Uncompress(digits.ADCs(), samples, digits.Compression());
+
+  ChannelStats_t stats;
+  std::size_t const n = samples.size();
+  if (n == 0) return stats;
+
+  // a single pass subtracting the pedestal and collecting the statistics;
+  // integer sums make this loop easy to vectorize
+  Digit_t* const data = samples.data();
+  Pedestal_t const pedestal = fPedestal;
+  long long int sum = 0, sum2 = 0;
+  Digit_t min = data[0] - pedestal, max = min;
+  for (std::size_t i = 0; i < n; ++i) {
+    Digit_t const value = data[i] - pedestal;
+    data[i] = value;
+    sum += value;
+    sum2 += value * value;
+    min = std::min(min, value);
+    max = std::max(max, value);
+  } // for
+
+  stats.min = min;
+  stats.max = max;
+  stats.mean = double(sum) / n;
+  double const variance = double(sum2) / n - stats.mean * stats.mean;
+  stats.RMS = (variance > 0.0)? std::sqrt(variance): 0.0;
+  return stats;
+
+} // detsim::DumpRawDigits::ExtractSamples()
+
+
+//------------------------------------------------------------------------------
+auto detsim::DumpRawDigits::ParseEncoding(std::string const& name)
+  -> Encoding_t
+{
+  if (name == "plain")     return Encoding_t::Plain;
+  if (name == "runlength") return Encoding_t::RunLength;
+  if (name == "delta")     return Encoding_t::Delta;
+  throw art::Exception(art::errors::Configuration)
+    << "DumpRawDigits: unknown encoding '" << name
+    << "' (supported: \"plain\", \"runlength\", \"delta\")\n";
+} // detsim::DumpRawDigits::ParseEncoding()
 
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,261 @@
+/**
+ * @file   DumpSampling.h
+ * @brief  Selection of the events and elements to be dumped
+ * @date   October 14, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_DUMPERS_DUMPSAMPLING_H
+#define LARDATA_ARTDATAHELPER_DUMPERS_DUMPSAMPLING_H 1
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// framework libraries
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/TableFragment.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <atomic>
+#include <vector>
+#include <algorithm> // std::max()
+#include <limits> // std::numeric_limits<>
+#include <utility> // std::pair<>
+#include <cstddef> // std::size_t
+
+
+namespace recob {
+  namespace dumper {
+
+    /**
+     * @brief Configuration of the sampling of the dumped data
+     *
+     * To be included in the configuration of a dumper module as
+     * `fhicl::TableFragment<recob::dumper::SamplingConfig>`, it adds the
+     * parameters:
+     *
+     * - *EventPrescale* (integer, default: `1`): only one event every this many
+     *   is dumped, starting with the first one (`0` and `1`: all events)
+     * - *ElementPrescale* (integer, default: `1`): within the dumped range, only
+     *   one element every this many is dumped, starting with the first one
+     *   (`0` and `1`: all elements)
+     * - *KeyRange* (list of two integers, default: empty): only the elements
+     *   with index in the collection between the first and the second number
+     *   (both included) are dumped; if empty, all indices are dumped
+     */
+    struct SamplingConfig {
+      using Name = fhicl::Name;
+      using Comment = fhicl::Comment;
+
+      fhicl::Atom<unsigned int> EventPrescale {
+        Name("EventPrescale"),
+        Comment("dump only one event every this many (0 or 1: all events)"),
+        1U
+      };
+
+      fhicl::Atom<unsigned int> ElementPrescale {
+        Name("ElementPrescale"),
+        Comment("dump only one element every this many (0 or 1: all elements)"),
+        1U
+      };
+
+      fhicl::Sequence<std::size_t> KeyRange {
+        Name("KeyRange"),
+        Comment
+          ("[ first, last ] index of the elements to dump (empty: all of them)"),
+        std::vector<std::size_t>()
+      };
+
+    }; // struct SamplingConfig
+
+
+    /**
+     * @brief Configuration of the sampling of data with a readout channel
+     *
+     * In addition to the parameters of `SamplingConfig`, this adds:
+     *
+     * - *ChannelRange* (list of two integers, default: empty): only the
+     *   elements on a channel between the first and the second number (both
+     *   included) are dumped; if empty, elements on all channels are dumped
+     */
+    struct ChannelSamplingConfig {
+      using Name = fhicl::Name;
+      using Comment = fhicl::Comment;
+
+      fhicl::TableFragment<SamplingConfig> Sampling;
+
+      fhicl::Sequence<raw::ChannelID_t> ChannelRange {
+        Name("ChannelRange"),
+        Comment("[ first, last ] channel of the elements to dump (empty: all)"),
+        std::vector<raw::ChannelID_t>()
+      };
+
+    }; // struct ChannelSamplingConfig
+
+
+    /**
+     * @brief Decides which events and elements a dumper module prints
+     *
+     * The decisions are cheap, and they are meant to be taken before any work
+     * is spent on the dumping:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * void DumpHits::analyze(art::Event const& evt, art::ProcessingFrame const&)
+     * {
+     *
+     *   if (!fSampler.selectEvent()) return;
+     *
+     *   auto const& Hits
+     *     = *(evt.getValidHandle<std::vector<recob::Hit>>(fHitsModuleLabel));
+     *   for (std::size_t iHit = 0; iHit < Hits.size(); ++iHit) {
+     *     recob::Hit const& hit = Hits[iHit];
+     *     if (!fSampler.selectElement(iHit, hit.Channel())) continue;
+     *
+     *     // ...
+     *   } // for
+     * } // DumpHits::analyze()
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The element prescale applies to the keys in the selected key range: with
+     * a range `[ 10, 50 ]` and a prescale of `20`, the elements with index
+     * 10, 30 and 50 are selected. The channel range is applied independently.
+     *
+     * The event selection keeps an atomic count of the events it was asked
+     * about, so the sampler can be used by modules processing events
+     * concurrently. In that case, which events are selected depends on the
+     * order in which they reach `selectEvent()`.
+     */
+    class DumpSampler {
+        public:
+
+      /// Type of a range of element keys (`first` and `second` included)
+      using KeyRange_t = std::pair<std::size_t, std::size_t>;
+
+      /// Type of a range of channels (`first` and `second` included)
+      using ChannelRange_t = std::pair<raw::ChannelID_t, raw::ChannelID_t>;
+
+      /// Range including all keys
+      static constexpr KeyRange_t AllKeys
+        { 0U, std::numeric_limits<std::size_t>::max() };
+
+      /// Range including all channels
+      static constexpr ChannelRange_t AllChannels
+        { 0U, std::numeric_limits<raw::ChannelID_t>::max() };
+
+
+      /// Constructor: selects everything, unless otherwise specified
+      DumpSampler(
+        unsigned int eventPrescale = 1U, unsigned int elementPrescale = 1U,
+        KeyRange_t keyRange = AllKeys, ChannelRange_t channelRange = AllChannels
+        )
+        : fEventPrescale(std::max(eventPrescale, 1U))
+        , fElementPrescale(std::max(elementPrescale, 1U))
+        , fKeyRange(keyRange)
+        , fChannelRange(channelRange)
+        {}
+
+      /// Constructor: reads the sampling from the configuration
+      /// @throw cet::exception (category `"DumpSampler"`) on invalid ranges
+      DumpSampler(SamplingConfig const& config)
+        : DumpSampler(
+          config.EventPrescale(), config.ElementPrescale(),
+          makeRange(config.KeyRange(), AllKeys, "KeyRange")
+          )
+        {}
+
+      /// Constructor: reads the sampling from the configuration
+      /// @throw cet::exception (category `"DumpSampler"`) on invalid ranges
+      DumpSampler(ChannelSamplingConfig const& config)
+        : DumpSampler(
+          config.Sampling().EventPrescale(), config.Sampling().ElementPrescale(),
+          makeRange(config.Sampling().KeyRange(), AllKeys, "KeyRange"),
+          makeRange(config.ChannelRange(), AllChannels, "ChannelRange")
+          )
+        {}
+
+      /// Constructor: reads the parameters of `SamplingConfig` from `pset`
+      /// (for modules without validated configuration)
+      /// @throw cet::exception (category `"DumpSampler"`) on invalid ranges
+      explicit DumpSampler(fhicl::ParameterSet const& pset)
+        : DumpSampler(
+          pset.get<unsigned int>("EventPrescale", 1U),
+          pset.get<unsigned int>("ElementPrescale", 1U),
+          makeRange(
+            pset.get<std::vector<std::size_t>>("KeyRange", {}),
+            AllKeys, "KeyRange"
+            )
+          )
+        {}
+
+
+      /// Returns whether the next event should be dumped
+      bool selectEvent()
+        { return (fNEvents.fetch_add(1U) % fEventPrescale) == 0; }
+
+      /// Returns whether the element with the specified key should be dumped
+      bool selectElement(std::size_t key) const
+        {
+          return (key >= fKeyRange.first) && (key <= fKeyRange.second)
+            && ((key - fKeyRange.first) % fElementPrescale == 0);
+        }
+
+      /// Returns whether the element with the specified key and channel should
+      /// be dumped
+      bool selectElement(std::size_t key, raw::ChannelID_t channel) const
+        { return selectChannel(channel) && selectElement(key); }
+
+      /// Returns whether elements on the specified channel should be dumped
+      bool selectChannel(raw::ChannelID_t channel) const
+        {
+          return (channel >= fChannelRange.first)
+            && (channel <= fChannelRange.second);
+        }
+
+      /// Returns whether there is any selection on the elements
+      bool samplesElements() const
+        {
+          return (fElementPrescale > 1U)
+            || (fKeyRange != AllKeys) || (fChannelRange != AllChannels);
+        }
+
+      /// Returns the number of events seen so far by `selectEvent()`
+      unsigned int nEvents() const { return fNEvents.load(); }
+
+
+        private:
+      unsigned int fEventPrescale; ///< dump one event every this many
+      unsigned int fElementPrescale; ///< dump one element every this many
+      KeyRange_t fKeyRange; ///< range of keys of the dumped elements
+      ChannelRange_t fChannelRange; ///< range of channels of dumped elements
+
+      std::atomic<unsigned int> fNEvents { 0U }; ///< events seen so far
+
+
+      /// Returns a range from a configuration sequence (empty: `all`)
+      template <typename T>
+      static std::pair<T, T> makeRange(
+        std::vector<T> const& values, std::pair<T, T> const& all,
+        char const* paramName
+        )
+        {
+          if (values.empty()) return all;
+          if ((values.size() != 2) || (values[0] > values[1])) {
+            throw cet::exception("DumpSampler")
+              << "Parameter '" << paramName
+              << "' must be empty or [ first, last ] with first <= last\n";
+          }
+          return { values[0], values[1] };
+        } // makeRange()
+
+    }; // class DumpSampler
+
+
+  } // namespace dumper
+} // namespace recob
+
+
+#endif // LARDATA_ARTDATAHELPER_DUMPERS_DUMPSAMPLING_H
@@ -7,11 +7,13 @@
 
 // LArSoft includes
 #include "lardataobj/RecoBase/Seed.h"
-#include "lardata/ArtDataHelper/Dumpers/hexfloat.h"
+#include "lardata/ArtDataHelper/Dumpers/FloatFormat.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 
 // art libraries
 #include "canvas/Utilities/InputTag.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Principal/Event.h"
 
 // support libraries
@@ -19,6 +21,7 @@
 #include "fhiclcpp/types/Table.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
@@ -42,9 +45,18 @@ namespace recob {
    *   for the output (useful for filtering)
    * - *PrintHexFloats* (boolean, default: `false`): print all the floating
    *   point numbers in base 16
+   * - *PrintExactFloats* (boolean, default: `false`): print all the floating
+   *   point numbers in base 10, with the shortest representation that reads
+   *   back into exactly the same number (useful to compare dumps bit by bit);
+   *   ignored if *PrintHexFloats* is set
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the seeds (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpSeeds: public art::EDAnalyzer {
+  class DumpSeeds: public art::SharedAnalyzer {
       public:
 
     struct Config {
@@ -69,21 +81,32 @@ namespace recob {
         false
         };
 
+      fhicl::Atom<bool> PrintExactFloats{
+        Name("PrintExactFloats"),
+        Comment("print all the floating point numbers exactly, in base 10"),
+        false
+        };
+
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
+
     }; // struct Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
     /// Default constructor
-    explicit DumpSeeds(Parameters const& config);
+    DumpSeeds(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    virtual void analyze (const art::Event& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fInputTag; ///< input tag of the Seed product
     std::string fOutputCategory; ///< category for LogInfo output
     bool fPrintHexFloats; ///< whether to print floats in base 16
+    bool fPrintExactFloats; ///< whether to print floats exactly
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped seeds
 
   }; // class DumpSeeds
 
@@ -119,6 +142,7 @@ namespace {
     /// Collection of available printing style options
     struct PrintOptions_t {
        bool hexFloats = false; ///< print all floating point numbers in base 16
+       bool exactFloats = false; ///< print all floating point numbers exactly
        std::string indent; ///< indentation string
     }; // PrintOptions_t
 
@@ -140,12 +164,17 @@ namespace {
     void SetHits(art::FindMany<recob::Hit> const* hit_query)
       { hits = hit_query; }
 
+    /// Sets the selection of the seeds to be dumped (`nullptr`: all seeds)
+    void SetSampler(recob::dumper::DumpSampler const* seed_sampler)
+      { sampler = seed_sampler; }
+
 
     /// Dump a seed specified by its index in the input particle list
     template <typename Stream>
     void DumpSeed(Stream&& out, size_t iSeed) const
       {
-        lar::OptionalHexFloat hexfloat(options.hexFloats);
+        lar::FloatFormat const fmt
+          = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
         std::string const& indentstr = options.indent;
 
         recob::Seed const& seed = seeds.at(iSeed);
@@ -160,11 +189,11 @@ namespace {
           seed.GetDirection(dir.data(), nullptr);
           seed.GetPoint(start.data(), nullptr);
           out
-            << " starts at (" << hexfloat(start[0])
-            << "," << hexfloat(start[1]) << "," << hexfloat(start[2])
-            << ") toward (" << hexfloat(dir[0]) << "," << hexfloat(dir[1])
-            << "," << hexfloat(dir[2])
-            << "); length: " << hexfloat(seed.GetLength()) << " cm"
+            << " starts at (" << fmt(start[0])
+            << "," << fmt(start[1]) << "," << fmt(start[2])
+            << ") toward (" << fmt(dir[0]) << "," << fmt(dir[1])
+            << "," << fmt(dir[2])
+            << "); length: " << fmt(seed.GetLength()) << " cm"
             ;
         }
 
@@ -203,8 +232,10 @@ namespace {
     void DumpAllSeeds(Stream&& out) const
       {
         size_t const nSeeds = seeds.size();
-        for (size_t iSeed = 0; iSeed < nSeeds; ++iSeed)
+        for (size_t iSeed = 0; iSeed < nSeeds; ++iSeed) {
+          if (sampler && !sampler->selectElement(iSeed)) continue;
           DumpSeed(out, iSeed);
+        } // for
       } // DumpAllSeeds()
 
 
@@ -217,6 +248,9 @@ namespace {
     /// Associated hits (expected same order as for seeds)
     art::FindMany<recob::Hit> const* hits = nullptr;
 
+    /// Selection of the seeds to be dumped (`nullptr`: all)
+    recob::dumper::DumpSampler const* sampler = nullptr;
+
   }; // SeedDumper
 
 
@@ -230,16 +264,24 @@ namespace {
 namespace recob {
 
   //----------------------------------------------------------------------------
-  DumpSeeds::DumpSeeds(Parameters const& config)
-    : EDAnalyzer(config)
+  DumpSeeds::DumpSeeds(Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer(config)
     , fInputTag(config().SeedModuleLabel())
     , fOutputCategory(config().OutputCategory())
     , fPrintHexFloats(config().PrintHexFloats())
-    {}
+    , fPrintExactFloats(config().PrintExactFloats())
+    , fSampler(config().Sampling())
+    {
+      async<art::InEvent>();
+    }
 
 
   //----------------------------------------------------------------------------
-  void DumpSeeds::analyze(const art::Event& evt) {
+  void DumpSeeds::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     //
     // collect all the available information
@@ -250,22 +292,25 @@ namespace recob {
     art::FindMany<recob::Hit> const SeedHits(Seeds, evt, fInputTag);
 
     size_t const nSeeds = Seeds->size();
-    mf::LogVerbatim(fOutputCategory) << "Event " << evt.id()
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line() << "Event " << evt.id()
       << " contains " << nSeeds << " seeds from '"
       << fInputTag.encode() << "'";
 
     // prepare the dumper
     SeedDumper::PrintOptions_t options;
     options.hexFloats = fPrintHexFloats;
+    options.exactFloats = fPrintExactFloats;
     options.indent = "  ";
     SeedDumper dumper(*Seeds, options);
+    dumper.SetSampler(&fSampler);
 
     if (SeedHits.isValid()) dumper.SetHits(&SeedHits);
     else mf::LogWarning("DumpSeeds") << "hit information not avaialble";
 
-    dumper.DumpAllSeeds(mf::LogVerbatim(fOutputCategory));
+    dumper.DumpAllSeeds(out.line());
 
-    mf::LogVerbatim(fOutputCategory) << "\n"; // two empty lines
+    out.line() << "\n"; // two empty lines
 
   } // DumpSeeds::analyze()
 
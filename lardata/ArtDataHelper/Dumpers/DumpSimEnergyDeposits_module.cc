@@ -6,6 +6,9 @@
  */
 
 // LArSoft libraries
+#include "lardata/ArtDataHelper/Dumpers/DumpHistogram.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataalg/MCDumpers/MCDumperUtils.h" // sim::ParticleName()
 #include "lardataalg/Utilities/quantities/energy.h" // MeV
 #include "lardataalg/Utilities/quantities/spacetime.h" // cm
@@ -14,20 +17,23 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Utilities/InputTag.h"
 
 // support libraries
-#include "messagefacility/MessageLogger/MessageLogger.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
+#include <map>
+#include <vector>
 #include <memory> // std::unique_ptr<>
 
 
@@ -47,9 +53,26 @@ namespace sim { class DumpSimEnergyDeposits; }
  *   `"moduleLabel:instanceName"`;
  * - *OutputCategory* (string, default: "DumpSimEnergyDeposits"): the category
  *   used for the output (useful for filtering)
+ * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of the
+ *   events and of the deposits (see `recob::dumper::SamplingConfig`); the
+ *   totals at the end of the event still include all the deposits
+ * - *DumpDeposits* (boolean, default: `true`): whether to dump the (sampled)
+ *   deposits one by one
+ * - *Aggregate* (boolean, default: `false`): at the end of the event, print
+ *   histograms of the energy and time of all the deposits, and their totals
+ *   for each particle type; together with `DumpDeposits` and the sampling
+ *   parameters, this allows to dump full-size simulation outputs
+ * - *HistogramBins* (integer, default: `20`): number of bins of the histograms
+ * - *EnergyRange* (list of two reals, default: `[ 0, 5 ]`): range of the
+ *   energy histogram, in MeV
+ * - *TimeRange* (list of two reals, default: `[ 0, 5000 ]`): range of the
+ *   time histogram, in nanoseconds
+ *
+ * Events can be processed concurrently: the dump of each event is emitted as a
+ * single message.
  *
  */
-class sim::DumpSimEnergyDeposits: public art::EDAnalyzer {
+class sim::DumpSimEnergyDeposits: public art::SharedAnalyzer {
     public:
 
   struct Config {
@@ -94,49 +117,123 @@ class sim::DumpSimEnergyDeposits: public art::EDAnalyzer {
       "DumpSimEnergyDeposits"
       };
 
+    fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
+
+    fhicl::Atom<bool> DumpDeposits {
+      Name("DumpDeposits"),
+      Comment("whether to dump the (sampled) deposits one by one"),
+      true
+      };
+
+    fhicl::Atom<bool> Aggregate {
+      Name("Aggregate"),
+      Comment
+        ("print histograms of energy and time, and totals per particle type"),
+      false
+      };
+
+    fhicl::Atom<unsigned int> HistogramBins {
+      Name("HistogramBins"),
+      Comment("number of bins of the histograms"),
+      20U
+      };
+
+    fhicl::Sequence<double> EnergyRange {
+      Name("EnergyRange"),
+      Comment("[ lower, upper ] range of the energy histogram [MeV]"),
+      std::vector<double>{ 0.0, 5.0 }
+      };
+
+    fhicl::Sequence<double> TimeRange {
+      Name("TimeRange"),
+      Comment("[ lower, upper ] range of the time histogram [ns]"),
+      std::vector<double>{ 0.0, 5000.0 }
+      };
+
   }; // struct Config
 
-  using Parameters = art::EDAnalyzer::Table<Config>;
+  using Parameters = art::SharedAnalyzer::Table<Config>;
 
 
   /// Constructor: reads the configuration.
-  explicit DumpSimEnergyDeposits(Parameters const& config);
+  DumpSimEnergyDeposits(Parameters const& config, art::ProcessingFrame const&);
 
   /// Does the printing.
-  void analyze(art::Event const& evt);
+  virtual void analyze
+    (art::Event const& evt, art::ProcessingFrame const&) override;
 
     private:
 
   art::InputTag fEnergyDepositTag; ///< Tag for input data product.
   std::string fOutputCategory;    ///< Category for LogInfo output.
+  recob::dumper::DumpSampler fSampler; ///< Selection of the dumped deposits.
   
   bool bShowLocation = true; ///< Print the center of the deposition.
   bool bShowStep     = true; ///< Print the step ends.
   bool bShowEmission = true; ///< Print the photons and electrons emitted.
   bool bSplitPhotons = true; ///< Print photons by emission speed.
+  bool bDumpDeposits = true; ///< Print the single deposits.
+  bool bAggregate    = false; ///< Print histograms and totals.
+  
+  unsigned int fHistogramBins; ///< Number of bins of the histograms.
+  std::vector<double> fEnergyRange; ///< Range of energy histogram [MeV].
+  std::vector<double> fTimeRange; ///< Range of time histogram [ns].
+  
+  /// Totals of the deposits of one particle type.
+  struct ParticleTotals {
+    unsigned int nDeposits = 0U;
+    double energy = 0.0; // MeV
+    double length = 0.0; // cm
+    unsigned int electrons = 0U;
+    unsigned int photons = 0U;
+  }; // struct ParticleTotals
   
   template <typename Stream>
   void dumpEnergyDeposit(Stream& out, sim::SimEnergyDeposit const& dep) const;
   
+  /// Prints histograms and per-particle totals of all the deposits.
+  void dumpAggregate(
+    recob::dumper::EventDump& out,
+    std::vector<sim::SimEnergyDeposit> const& deps
+    ) const;
+  
 }; // class sim::DumpSimEnergyDeposits
 
 
 //------------------------------------------------------------------------------
 //---  module implementation
 //------------------------------------------------------------------------------
-sim::DumpSimEnergyDeposits::DumpSimEnergyDeposits(Parameters const& config)
-  : EDAnalyzer       (config)
+sim::DumpSimEnergyDeposits::DumpSimEnergyDeposits
+  (Parameters const& config, art::ProcessingFrame const&)
+  : SharedAnalyzer   (config)
   , fEnergyDepositTag(config().EnergyDepositTag())
   , fOutputCategory  (config().OutputCategory())
   , bShowLocation(config().ShowLocation())
   , bShowStep    (config().ShowStep())
   , bShowEmission(config().ShowEmission())
   , bSplitPhotons(config().SplitPhotons())
-  {}
+  , bDumpDeposits(config().DumpDeposits())
+  , bAggregate   (config().Aggregate())
+  , fSampler     (config().Sampling())
+  , fHistogramBins(config().HistogramBins())
+  , fEnergyRange (config().EnergyRange())
+  , fTimeRange   (config().TimeRange())
+  {
+    if (bAggregate) { // check the configuration early
+      recob::dumper::DumpHistogram
+        (fHistogramBins, fEnergyRange, "EnergyRange");
+      recob::dumper::DumpHistogram(fHistogramBins, fTimeRange, "TimeRange");
+    }
+    async<art::InEvent>();
+  }
 
 
 //------------------------------------------------------------------------------
-void sim::DumpSimEnergyDeposits::analyze(art::Event const& event) {
+void sim::DumpSimEnergyDeposits::analyze
+  (art::Event const& event, art::ProcessingFrame const&)
+{
+
+  if (!fSampler.selectEvent()) return;
 
   using namespace util::quantities::energy_literals;
   using namespace util::quantities::space_literals;
@@ -148,7 +245,8 @@ void sim::DumpSimEnergyDeposits::analyze(art::Event const& event) {
     event.getValidHandle<std::vector<sim::SimEnergyDeposit>>(fEnergyDepositTag)
     );
 
-  mf::LogVerbatim(fOutputCategory)
+  recob::dumper::EventDump out(fOutputCategory);
+  out.line()
     << "Event " << event.id() << " contains " << Deps.size() << " '"
     << fEnergyDepositTag.encode() << "' energy deposits";
 
@@ -159,10 +257,11 @@ void sim::DumpSimEnergyDeposits::analyze(art::Event const& event) {
 
   for (auto const& [ iDep, dep ]: util::enumerate(Deps)) {
 
-    // print a header for the cluster
-    mf::LogVerbatim log(fOutputCategory);
-    log << "[#" << iDep << "]  ";
-    dumpEnergyDeposit(log, dep);
+    if (bDumpDeposits && fSampler.selectElement(iDep)) {
+      // print a header for the cluster
+      out.line() << "[#" << iDep << "]  ";
+      dumpEnergyDeposit(out, dep);
+    }
 
     // collect statistics
     TotalE += megaelectronvolt{ dep.Energy() };
@@ -174,7 +273,7 @@ void sim::DumpSimEnergyDeposits::analyze(art::Event const& event) {
 
   } // for depositions
 
-  mf::LogVerbatim(fOutputCategory)
+  out.line()
     << "Event " << event.id() << " energy deposits '"
     << fEnergyDepositTag.encode() << "' include "
     << TotalE << " worth of energy, " << TotalElectrons
@@ -183,9 +282,50 @@ void sim::DumpSimEnergyDeposits::analyze(art::Event const& event) {
     << " slow); tracked particles crossed " << TotalLength << " of space."
     ;
 
+  if (bAggregate) dumpAggregate(out, Deps);
+
 } // sim::DumpSimEnergyDeposits::analyze()
 
 
+// -----------------------------------------------------------------------------
+void sim::DumpSimEnergyDeposits::dumpAggregate(
+  recob::dumper::EventDump& out,
+  std::vector<sim::SimEnergyDeposit> const& deps
+) const {
+  recob::dumper::DumpHistogram energy
+    { fHistogramBins, fEnergyRange, "EnergyRange" };
+  recob::dumper::DumpHistogram time
+    { fHistogramBins, fTimeRange, "TimeRange" };
+  std::map<int, ParticleTotals> particles; // by PDG ID
+
+  // a single pass on all the deposits
+  for (sim::SimEnergyDeposit const& dep: deps) {
+    energy.fill(dep.Energy());
+    time.fill(dep.Time(), dep.Energy());
+    ParticleTotals& totals = particles[dep.PdgCode()];
+    ++totals.nDeposits;
+    totals.energy += dep.Energy();
+    totals.length += dep.StepLength();
+    totals.electrons += dep.NumElectrons();
+    totals.photons += dep.NumPhotons();
+  } // for
+
+  recob::dumper::EventDump& log = out.line();
+  log << "Energy of the deposits [MeV]: ";
+  energy.dump(log, "  ");
+  log << "\nTime of the deposits [ns], weighted by energy [MeV]: ";
+  time.dump(log, "  ");
+  log << "\nDeposits by particle type:";
+  for (auto const& [ pdg, totals ]: particles) {
+    log << "\n  " << sim::ParticleName(pdg) << ": " << totals.nDeposits
+      << " deposits, " << totals.energy << " MeV, " << totals.length
+      << " cm, " << totals.electrons << " electrons, " << totals.photons
+      << " photons";
+  } // for
+
+} // sim::DumpSimEnergyDeposits::dumpAggregate()
+
+
 // -----------------------------------------------------------------------------
 template <typename Stream>
 void sim::DumpSimEnergyDeposits::dumpEnergyDeposit
@@ -8,22 +8,28 @@
 
 
 // LArSoft libraries
+#include "lardata/ArtDataHelper/Dumpers/DumpHistogram.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataobj/Simulation/SimPhotons.h"
 
 // framework libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Utilities/InputTag.h"
 #include "fhiclcpp/types/Atom.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C/C++ standard libraries
 #include <string>
+#include <vector>
 #include <iomanip> // std::setw()
 #include <numeric> // std::accumulate()
 #include <utility> // std::forward()
+#include <cstddef> // std::size_t
 
 
 namespace sim {
@@ -50,19 +56,58 @@ namespace {
       "DumpSimPhotonsLite" /* default value */
       };
 
+    /// selection of the dumped events and channels
+    fhicl::TableFragment<recob::dumper::ChannelSamplingConfig> Sampling;
+
+    fhicl::Atom<bool> DumpPhotons {
+      Name("DumpPhotons"),
+      Comment(
+        "whether to dump all the photons of the (sampled) channels"
+        " (otherwise, just a summary line for each)"
+        ),
+      true
+      };
+
+    fhicl::Atom<bool> Aggregate {
+      Name("Aggregate"),
+      Comment(
+        "print histograms of photon time and of photons per channel,"
+        " including all the channels"
+        ),
+      false
+      };
+
+    fhicl::Atom<unsigned int> HistogramBins {
+      Name("HistogramBins"),
+      Comment("number of bins of the histograms"),
+      20U
+      };
+
+    fhicl::Sequence<double> TickRange {
+      Name("TickRange"),
+      Comment("[ lower, upper ] range of the photon time histogram [tick]"),
+      std::vector<double>{ 0.0, 10000.0 }
+      };
+
+    fhicl::Sequence<double> PhotonsRange {
+      Name("PhotonsRange"),
+      Comment("[ lower, upper ] range of the photons per channel histogram"),
+      std::vector<double>{ 0.0, 1000.0 }
+      };
+
   }; // struct Config
 
 
 } // local namespace
 
 
-class sim::DumpSimPhotonsLite: public art::EDAnalyzer {
+class sim::DumpSimPhotonsLite: public art::SharedAnalyzer {
     public:
   // type to enable module parameters description by art
-  using Parameters = art::EDAnalyzer::Table<Config>;
+  using Parameters = art::SharedAnalyzer::Table<Config>;
 
   /// Configuration-checking constructor
-  explicit DumpSimPhotonsLite(Parameters const& config);
+  DumpSimPhotonsLite(Parameters const& config, art::ProcessingFrame const&);
 
   // Plugins should not be copied or assigned.
   DumpSimPhotonsLite(DumpSimPhotonsLite const&) = delete;
@@ -71,8 +116,8 @@ class sim::DumpSimPhotonsLite: public art::EDAnalyzer {
   DumpSimPhotonsLite& operator = (DumpSimPhotonsLite &&) = delete;
 
 
-  // Operates on the event
-  void analyze(art::Event const& event) override;
+  // Operates on the event (concurrently, emitting a single message per event)
+  void analyze(art::Event const& event, art::ProcessingFrame const&) override;
 
 
   /**
@@ -100,11 +145,30 @@ class sim::DumpSimPhotonsLite: public art::EDAnalyzer {
     const
     { DumpPhoton(std::forward<Stream>(out), photons, indent, indent); }
 
+  /**
+   * @brief Dumps a one-line summary of the specified SimPhotonsLite.
+   * @tparam Stream the type of output stream
+   * @param out the output stream
+   * @param photons the SimPhotonsLite to be summarized
+   *
+   * The summary includes the number of photons, and their time range and
+   * mean. The output starts on the current line, and it is not broken.
+   */
+  template <typename Stream>
+  void DumpPhotonSummary
+    (Stream&& out, sim::SimPhotonsLite const& photons) const;
+
 
     private:
 
   art::InputTag fInputPhotons; ///< name of SimPhotons's data product
   std::string fOutputCategory; ///< name of the stream for output
+  recob::dumper::DumpSampler fSampler; ///< selection of the dumped channels
+  bool fDumpPhotons; ///< whether to dump all the photons of each channel
+  bool fAggregate; ///< whether to dump channel summaries and histograms
+  unsigned int fHistogramBins; ///< number of bins of the histograms
+  std::vector<double> fTickRange; ///< range of the photon time histogram
+  std::vector<double> fPhotonsRange; ///< range of photons/channel histogram
 
 }; // class sim::DumpSimPhotonsLite
 
@@ -113,11 +177,25 @@ class sim::DumpSimPhotonsLite: public art::EDAnalyzer {
 //---  module implementation
 //---
 //------------------------------------------------------------------------------
-sim::DumpSimPhotonsLite::DumpSimPhotonsLite(Parameters const& config)
-  : EDAnalyzer(config)
+sim::DumpSimPhotonsLite::DumpSimPhotonsLite
+  (Parameters const& config, art::ProcessingFrame const&)
+  : SharedAnalyzer(config)
   , fInputPhotons(config().InputPhotons())
   , fOutputCategory(config().OutputCategory())
-{}
+  , fSampler(config().Sampling())
+  , fDumpPhotons(config().DumpPhotons())
+  , fAggregate(config().Aggregate())
+  , fHistogramBins(config().HistogramBins())
+  , fTickRange(config().TickRange())
+  , fPhotonsRange(config().PhotonsRange())
+{
+  if (fAggregate) { // check the configuration early
+    recob::dumper::DumpHistogram(fHistogramBins, fTickRange, "TickRange");
+    recob::dumper::DumpHistogram
+      (fHistogramBins, fPhotonsRange, "PhotonsRange");
+  }
+  async<art::InEvent>();
+}
 
 //------------------------------------------------------------------------------
 template <typename Stream>
@@ -153,26 +231,84 @@ void sim::DumpSimPhotonsLite::DumpPhoton(
 
 
 //------------------------------------------------------------------------------
-void sim::DumpSimPhotonsLite::analyze(art::Event const& event) {
+template <typename Stream>
+void sim::DumpSimPhotonsLite::DumpPhotonSummary
+  (Stream&& out, sim::SimPhotonsLite const& photons) const
+{
+  unsigned long nPhotons = 0U;
+  double sumTicks = 0.0;
+  for (auto const& entry: photons.DetectedPhotons) {
+    nPhotons += entry.second;
+    sumTicks += double(entry.first) * entry.second;
+  } // for
+
+  out << "channel=" << photons.OpChannel << " has ";
+  if (nPhotons) {
+    // DetectedPhotons is a map: its keys are sorted
+    out << nPhotons << " photons in "
+      << photons.DetectedPhotons.size() << " ticks, from "
+      << photons.DetectedPhotons.begin()->first << " to "
+      << photons.DetectedPhotons.rbegin()->first
+      << " (mean: " << (sumTicks / nPhotons) << ")";
+  }
+  else {
+    out << "no photons";
+  }
+
+} // sim::DumpSimPhotonsLite::DumpPhotonSummary()
+
+
+//------------------------------------------------------------------------------
+void sim::DumpSimPhotonsLite::analyze
+  (art::Event const& event, art::ProcessingFrame const&)
+{
+
+  if (!fSampler.selectEvent()) return;
 
   // get the particles from the event
   auto const& Photons
     = *(event.getValidHandle<std::vector<sim::SimPhotonsLite>>(fInputPhotons));
 
-  mf::LogVerbatim(fOutputCategory) << "Event " << event.id()
+  recob::dumper::EventDump out(fOutputCategory);
+  out.line() << "Event " << event.id()
     << " : data product '" << fInputPhotons.encode() << "' contains "
     << Photons.size() << " SimPhotonsLite";
 
-  unsigned int iChannel = 0;
-  for (sim::SimPhotonsLite const& photons: Photons) {
+  for (std::size_t iChannel = 0; iChannel < Photons.size(); ++iChannel) {
+    sim::SimPhotonsLite const& photons = Photons[iChannel];
+    if (!fSampler.selectElement(iChannel, photons.OpChannel)) continue;
 
-    mf::LogVerbatim log(fOutputCategory);
+    recob::dumper::EventDump& log = out.line();
     // a bit of a header
-    log << "[#" << (iChannel++) << "] ";
-    DumpPhoton(log, photons, "  ");
+    log << "[#" << iChannel << "] ";
+    if (fDumpPhotons) DumpPhoton(log, photons, "  ");
+    else DumpPhotonSummary(log, photons);
 
   } // for
-  mf::LogVerbatim(fOutputCategory) << "\n"; // just an empty line
+
+  if (fAggregate) {
+    // a single pass on all the channels, sampled or not
+    recob::dumper::DumpHistogram ticks
+      { fHistogramBins, fTickRange, "TickRange" };
+    recob::dumper::DumpHistogram channelPhotons
+      { fHistogramBins, fPhotonsRange, "PhotonsRange" };
+    for (sim::SimPhotonsLite const& photons: Photons) {
+      unsigned long nPhotons = 0U;
+      for (auto const& entry: photons.DetectedPhotons) {
+        ticks.fill(entry.first, entry.second);
+        nPhotons += entry.second;
+      } // for
+      channelPhotons.fill(nPhotons);
+    } // for
+
+    recob::dumper::EventDump& log = out.line();
+    log << "Photon time [tick], weighted by photons: ";
+    ticks.dump(log, "  ");
+    log << "\nPhotons per channel: ";
+    channelPhotons.dump(log, "  ");
+  } // if aggregate
+
+  out.line() << "\n"; // just an empty line
 
 } // sim::DumpSimPhotonsLite::analyze()
 
@@ -8,15 +8,18 @@
 // LArSoft includes
 #include "lardata/ArtDataHelper/Dumpers/NewLine.h" // recob::dumper::makeNewLine()
 #include "lardata/ArtDataHelper/Dumpers/SpacePointDumpers.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
 
 // art libraries
 #include "canvas/Utilities/InputTag.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Principal/Event.h"
 
 // support libraries
 #include "fhiclcpp/types/Atom.h" // also pulls in fhicl::Name and fhicl::Comment
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
@@ -40,9 +43,18 @@ namespace recob {
    *   for the output (useful for filtering)
    * - *PrintHexFloats* (boolean, default: `false`): print all the floating
    *   point numbers in base 16
+   * - *PrintExactFloats* (boolean, default: `false`): print all the floating
+   *   point numbers in base 10, with the shortest representation that reads
+   *   back into exactly the same number (useful to compare dumps bit by bit);
+   *   ignored if *PrintHexFloats* is set
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the space points (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpSpacePoints: public art::EDAnalyzer {
+  class DumpSpacePoints: public art::SharedAnalyzer {
       public:
 
     /// Configuration parameters
@@ -64,22 +76,32 @@ namespace recob {
         Comment("print floating point numbers in base 16 [false]"),
         false /* default value */
         };
+      fhicl::Atom<bool> PrintExactFloats {
+        Name   ("PrintExactFloats"),
+        Comment("print floating point numbers exactly, in base 10 [false]"),
+        false /* default value */
+        };
+
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
 
     }; // struct Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
     /// Default constructor
-    explicit DumpSpacePoints(Parameters const& config);
+    DumpSpacePoints(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    virtual void analyze (const art::Event& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fInputTag; ///< input tag of the SpacePoint product
     std::string fOutputCategory; ///< category for LogInfo output
     bool fPrintHexFloats; ///< whether to print floats in base 16
+    bool fPrintExactFloats; ///< whether to print floats exactly
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped points
 
   }; // class DumpSpacePoints
 
@@ -127,6 +149,10 @@ namespace {
     void SetHits(art::FindMany<recob::Hit> const* hit_query)
       { hits = hit_query; }
 
+    /// Sets the selection of the points to be dumped (`nullptr`: all points)
+    void SetSampler(recob::dumper::DumpSampler const* point_sampler)
+      { sampler = point_sampler; }
+
 
     /// Dump a space point specified by its index in the input list
     template <typename Stream>
@@ -199,8 +225,10 @@ namespace {
         auto localOptions = options;
         localOptions.indent.appendIndentation(indentstr);
         size_t const nPoints = points.size();
-        for (size_t iPoint = 0; iPoint < nPoints; ++iPoint)
+        for (size_t iPoint = 0; iPoint < nPoints; ++iPoint) {
+          if (sampler && !sampler->selectElement(iPoint)) continue;
           DumpSpacePoint(std::forward<Stream>(out), iPoint, localOptions);
+        } // for
       } // DumpAllSpacePoints()
 
 
@@ -212,6 +240,9 @@ namespace {
     /// Associated hits (expected same order as for space points)
     art::FindMany<recob::Hit> const* hits = nullptr;
 
+    /// Selection of the points to be dumped (`nullptr`: all)
+    recob::dumper::DumpSampler const* sampler = nullptr;
+
   }; // SpacePointDumper
 
 
@@ -225,16 +256,25 @@ namespace {
 namespace recob {
 
   //----------------------------------------------------------------------------
-  DumpSpacePoints::DumpSpacePoints(Parameters const& config)
-    : EDAnalyzer(config)
+  DumpSpacePoints::DumpSpacePoints
+    (Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer(config)
     , fInputTag(config().SpacePointModuleLabel())
     , fOutputCategory(config().OutputCategory())
     , fPrintHexFloats(config().PrintHexFloats())
-    {}
+    , fPrintExactFloats(config().PrintExactFloats())
+    , fSampler(config().Sampling())
+    {
+      async<art::InEvent>();
+    }
 
 
   //----------------------------------------------------------------------------
-  void DumpSpacePoints::analyze(const art::Event& evt) {
+  void DumpSpacePoints::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     //
     // collect all the available information
@@ -246,18 +286,23 @@ namespace recob {
     art::FindMany<recob::Hit> const PointHits(SpacePoints, evt, fInputTag);
 
     size_t const nPoints = SpacePoints->size();
-    mf::LogInfo(fOutputCategory)
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line()
       << "The event contains " << nPoints << " space points from '"
       << fInputTag.encode() << "'";
 
     // prepare the dumper
-    SpacePointDumper dumper(*SpacePoints);
+    SpacePointDumper::PrintOptions_t options;
+    options.hexFloats = fPrintHexFloats;
+    options.exactFloats = fPrintExactFloats;
+    SpacePointDumper dumper(*SpacePoints, options);
     if (PointHits.isValid()) dumper.SetHits(&PointHits);
     else mf::LogWarning("DumpSpacePoints") << "hit information not avaialble";
+    dumper.SetSampler(&fSampler);
 
-    dumper.DumpAllSpacePoints(mf::LogVerbatim(fOutputCategory), "  ");
+    dumper.DumpAllSpacePoints(out.line(), "  ");
 
-    mf::LogVerbatim(fOutputCategory) << "\n"; // two empty lines
+    out.line() << "\n"; // two empty lines
 
   } // DumpSpacePoints::analyze()
 
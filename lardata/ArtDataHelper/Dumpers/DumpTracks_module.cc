@@ -6,6 +6,9 @@
  */
 
 // LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/DumpAssociations.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataobj/RecoBase/Track.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
@@ -16,184 +19,29 @@
 #include "fhiclcpp/types/Table.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Persistency/Common/FindManyP.h"
 #include "canvas/Utilities/InputTag.h"
 
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 // C//C++ standard libraries
 #include <string>
+#include <vector>
 #include <sstream>
-#include <iomanip> // std::setw()
-#include <algorithm> // std::max(), std::sort(), std::transform()
-#include <iterator> // std::back_inserter()
-#include <functional> // std::mem_fn()
+#include <algorithm> // std::max(), std::sort()
+#include <cstddef> // std::size_t
 #include <memory> // std::unique_ptr()
 
 
-namespace {
-
-  /// Returns the length of the string representation of the specified object
-  template <typename T>
-  size_t StringLength(const T& value) {
-    std::ostringstream sstr;
-    sstr << value;
-    return sstr.str().length();
-  } // StringLength()
-
-  /**
-   * @brief Prints a table with compact integers
-   * @param log stream to send the output to
-   * @param Indices sorted container of the indices to be printed
-   * @param IndicesPerLine number of indices printed in one line
-   * @param IndentStr string to be printed at the beginning of each new line
-   *
-   */
-  template <typename STREAM, typename CONT>
-  void PrintCompactIndexTable(
-    STREAM& log, const CONT& Indices, unsigned int IndicesPerLine,
-    std::string IndentStr = "")
-  {
-    unsigned int Padding = StringLength(Indices.back());
-
-    typename CONT::const_iterator iIndex = Indices.begin(),
-      iend = Indices.end();
-    size_t RangeStart = *iIndex, RangeStop = RangeStart;
-    std::ostringstream output_line;
-    size_t nItemsInLine = 0;
-    while (++iIndex != iend) {
-
-      if (*iIndex == RangeStop + 1) {
-        ++RangeStop;
-      }
-      else {
-        // the new item does not belong to the current range:
-        // - print the current range
-        if (nItemsInLine) output_line << "  ";
-        if (RangeStart == RangeStop) {
-          output_line << std::setw(Padding) << RangeStart;
-          ++nItemsInLine;
-        }
-        else {
-          char fill = (RangeStart + 1 == RangeStop)? ' ': '-';
-          output_line << std::setw(Padding) << RangeStart
-            << fill << fill
-            << std::setw(Padding) << std::setfill(fill) << RangeStop
-            << std::setfill(' ');
-          nItemsInLine += 2;
-        }
-        // - start a new one
-        RangeStart = RangeStop = *iIndex;
-      } // if ... else
-
-      // if we have enough stuff in the buffer, let's print it
-      if (nItemsInLine >= IndicesPerLine) {
-        nItemsInLine = 0;
-        log << IndentStr << output_line.str() << "\n";
-        output_line.str("");
-      }
-
-    } // while
-
-    // print what we have accumulated so far of the last line
-    log << IndentStr << output_line.str();
-    // print the last range (or single element)
-    if (nItemsInLine) log << "  ";
-    if (RangeStart == RangeStop)
-      log << std::setw(Padding) << RangeStart;
-    else {
-      char fill = (RangeStart + 1 == RangeStop)? ' ': '-';
-      log << std::setw(Padding) << RangeStart
-        << fill << fill
-        << std::setw(Padding) << std::setfill(fill) << RangeStop
-        << std::setfill(' ');
-    }
-    log << std::endl;
-  } // PrintCompactIndexTable()
-
-
-
-  /**
-   * @brief Prints a table with keys from a container of objects
-   * @param log stream to send the output to
-   * @param Indices sorted container of the indices to be printed
-   * @param IndicesPerLine number of indices printed in one line
-   * @param IndexExtractor functor extracting the index from a element
-   * @param IndentStr string to be printed at the beginning of each new line
-   *
-   * The key extractor must oterate on elements of Indices and returning
-   * something that can be converted to a size_t.
-   */
-  template <typename STREAM, typename CONT, typename GETINDEX>
-  void PrintCompactIndexTable(
-    STREAM& log, const CONT& Objects, unsigned int IndicesPerLine,
-    GETINDEX IndexExtractor, std::string IndentStr)
-  {
-    if ((IndicesPerLine == 0) || Objects.empty()) return;
-
-    std::vector<size_t> Indices;
-    Indices.reserve(Objects.size());
-    std::transform(Objects.begin(), Objects.end(), std::back_inserter(Indices),
-      IndexExtractor);
-    std::sort(Indices.begin(), Indices.end());
-    PrintCompactIndexTable(log, Indices, IndicesPerLine, IndentStr);
-
-  } // PrintCompactIndexTable()
-
-  /**
-   * @brief Prints a table with indices from a container of objects
-   * @param log stream to send the output to
-   * @param Objects container of art::Ptr to objects to be printed
-   * @param IndicesPerLine number of indices printed in one line
-   * @param IndentStr string to be printed at the beginning of each new line
-   *
-   * The class in the container must have a key() member returning something
-   * that can be converted to a size_t.
-   * This is designed for containers like std::vector<art::Ptr<T>>.
-   */
-  template <typename STREAM, typename T>
-  inline void PrintAssociatedIndexTable(
-    STREAM& log, const std::vector<art::Ptr<T>>& Objects,
-    unsigned int IndicesPerLine, std::string IndentStr = ""
-  ) {
-    PrintCompactIndexTable(
-      log, Objects, IndicesPerLine, std::mem_fn(&art::Ptr<T>::key),
-      IndentStr
-      );
-  } // PrintAssociatedIndexTable()
-
-
-  /**
-   * @brief Prints a table with indices from a container of objects
-   * @param log stream to send the output to
-   * @param Objects container of art::Ptr to objects to be printed
-   * @param IndicesPerLine number of indices printed in one line
-   * @param IndentStr string to be printed at the beginning of each new line
-   *
-   * The class in the container must have a key() member returning something
-   * that can be converted to a size_t.
-   * This is designed for containers like std::vector<art::Ptr<T>>.
-   */
-  template <typename STREAM, typename T>
-  inline void PrintAssociatedIDTable(
-    STREAM& log, const std::vector<art::Ptr<T>>& Objects,
-    unsigned int IndicesPerLine, std::string IndentStr = ""
-  ) {
-    PrintCompactIndexTable(
-      log, Objects, IndicesPerLine,
-      [](const art::Ptr<T>& ptr) { return ptr->ID(); },
-      IndentStr
-      );
-  } // PrintAssociatedIDTable()
-
-} // local namespace
-
-
 namespace recob {
 
   /**
@@ -223,9 +71,17 @@ namespace recob {
    *   associated with the tracks
    * - *ParticleAssociations* (boolean, default: `true`): prints the number
    *   of particle-flow particles associated with the tracks
+   * - *ParallelFormatting* (boolean, default: `false`): the tracks are
+   *   formatted concurrently, and the results are printed in the usual order;
+   *   the output is the same as without this option
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the tracks (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpTracks : public art::EDAnalyzer {
+  class DumpTracks : public art::SharedAnalyzer {
       public:
 
     /// Configuration object
@@ -272,16 +128,24 @@ namespace recob {
         Comment("prints the number of PF particles associated to the track"),
         true
         };
+      fhicl::Atom<bool> ParallelFormatting{
+        Name("ParallelFormatting"),
+        Comment("formats the tracks concurrently"),
+        false
+        };
+
+      fhicl::TableFragment<recob::dumper::SamplingConfig> Sampling;
 
     }; // Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
     /// Default constructor
-    explicit DumpTracks(Parameters const& config);
+    DumpTracks(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing
-    void analyze (const art::Event& evt);
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
@@ -295,9 +159,22 @@ namespace recob {
     bool fPrintHits; ///< prints the index of associated hits
     bool fPrintSpacePoints; ///< prints the index of associated space points
     bool fPrintParticles; ///< prints the index of associated PFParticles
+    bool fParallelFormatting; ///< formats the tracks concurrently
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped tracks
 
     /// Dumps information about the specified track
-    void DumpTrack(unsigned int iTrack, recob::Track const& track) const;
+    template <typename STREAM>
+    void DumpTrack
+      (STREAM& log, unsigned int iTrack, recob::Track const& track) const;
+
+    /// Dumps information about the objects associated to the specified track
+    template <typename STREAM>
+    void DumpAssociations(
+      STREAM& log, unsigned int iTrack,
+      art::FindManyP<recob::Hit> const* pHits,
+      art::FindManyP<recob::SpacePoint> const* pSpacePoints,
+      art::FindManyP<recob::PFParticle> const* pPFParticles
+      ) const;
 
   }; // class DumpTracks
 
@@ -309,8 +186,8 @@ namespace recob {
 namespace recob {
 
   //-------------------------------------------------
-  DumpTracks::DumpTracks(Parameters const& config)
-    : EDAnalyzer        (config)
+  DumpTracks::DumpTracks(Parameters const& config, art::ProcessingFrame const&)
+    : SharedAnalyzer    (config)
     , fTrackModuleLabel (config().TrackModuleLabel())
     , fOutputCategory   (config().OutputCategory())
     , fPrintWayPoints   (config().WayPoints())
@@ -320,16 +197,25 @@ namespace recob {
     , fPrintHits        (config().PrintHits())
     , fPrintSpacePoints (config().PrintSpacePoints())
     , fPrintParticles   (config().ParticleAssociations())
-    {}
+    , fParallelFormatting(config().ParallelFormatting())
+    , fSampler          (config().Sampling())
+    {
+      async<art::InEvent>();
+    }
 
   //-------------------------------------------------
-  void DumpTracks::analyze(const art::Event& evt) {
+  void DumpTracks::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     // fetch the data to be dumped on screen
     auto Tracks
       = evt.getValidHandle<std::vector<recob::Track>>(fTrackModuleLabel);
 
-    mf::LogInfo(fOutputCategory)
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line()
       << "The event contains " << Tracks->size() << " '"
       << fTrackModuleLabel.encode() << "'tracks";
 
@@ -366,54 +252,99 @@ namespace recob {
         << fTrackModuleLabel.encode() << "' tracks.\n";
     }
 
+    if (fParallelFormatting) {
+      // each track is formatted into its own buffers (one per line)
+      std::vector<std::string> TrackInfo(Tracks->size());
+      std::vector<std::string> AssnsInfo(Tracks->size());
+      tbb::parallel_for(
+        tbb::blocked_range<unsigned int>(0, Tracks->size()),
+        [&](tbb::blocked_range<unsigned int> const& range) {
+          for (unsigned int iTrack = range.begin(); iTrack != range.end();
+            ++iTrack
+          ) {
+            if (!fSampler.selectElement(iTrack)) continue;
+            std::ostringstream trackLog, assnsLog;
+            DumpTrack(trackLog, iTrack, Tracks->at(iTrack));
+            DumpAssociations(assnsLog, iTrack,
+              pHits.get(), pSpacePoints.get(), pPFParticles.get());
+            TrackInfo[iTrack] = trackLog.str();
+            AssnsInfo[iTrack] = assnsLog.str();
+          } // for
+        });
+
+      for (unsigned int iTrack = 0; iTrack < Tracks->size(); ++iTrack) {
+        if (!fSampler.selectElement(iTrack)) continue;
+        out.line() << TrackInfo[iTrack];
+        out.line() << AssnsInfo[iTrack];
+      } // for
+      return;
+    } // if parallel
+
     for (unsigned int iTrack = 0; iTrack < Tracks->size(); ++iTrack) {
+      if (!fSampler.selectElement(iTrack)) continue;
       const recob::Track& track = Tracks->at(iTrack);
 
       // print track information
-      DumpTrack(iTrack, track);
-
-      mf::LogVerbatim log(fOutputCategory);
-      if (pHits || pSpacePoints || pPFParticles) {
-        log << "\n  associated with:";
-        if (pHits)
-          log << " " << pHits->at(iTrack).size() << " hits;";
-        if (pSpacePoints)
-          log << " " << pSpacePoints->at(iTrack).size() << " space points;";
-        if (pPFParticles)
-          log << " " << pPFParticles->at(iTrack).size() << " PF particles;";
-      } // if we have any association
-
-      if (pHits && fPrintHits) {
-        const auto& Hits = pHits->at(iTrack);
-        log << "\n  hit indices (" << Hits.size() << "):\n";
-        PrintAssociatedIndexTable(log, Hits, 10 /* 10 hits per line */, "    ");
-      } // if print individual hits
-
-      if (pSpacePoints && fPrintSpacePoints) {
-        const auto& SpacePoints = pSpacePoints->at(iTrack);
-        log << "\n  space point IDs (" << SpacePoints.size() << "):\n";
-        PrintAssociatedIDTable
-          (log, SpacePoints, 10 /* 10 hits per line */, "    ");
-      } // if print individual space points
-
-      if (pPFParticles && fPrintParticles) {
-        const auto& PFParticles = pPFParticles->at(iTrack);
-        log << "\n  particle indices (" << PFParticles.size() << "):\n";
-        // currently a particle has no ID
-        PrintAssociatedIndexTable
-          (log, PFParticles, 10 /* 10 hits per line */, "    ");
-      } // if print individual particles
+      DumpTrack(out.line(), iTrack, track);
+
+      DumpAssociations
+        (out.line(), iTrack, pHits.get(), pSpacePoints.get(), pPFParticles.get());
     } // for tracks
   } // DumpTracks::analyze()
 
 
   //---------------------------------------------------------------------------
+  template <typename STREAM>
+  void DumpTracks::DumpAssociations(
+    STREAM& log, unsigned int iTrack,
+    art::FindManyP<recob::Hit> const* pHits,
+    art::FindManyP<recob::SpacePoint> const* pSpacePoints,
+    art::FindManyP<recob::PFParticle> const* pPFParticles
+  ) const {
+    if (pHits || pSpacePoints || pPFParticles) {
+      log << "\n  associated with:";
+      if (pHits)
+        log << " " << pHits->at(iTrack).size() << " hits;";
+      if (pSpacePoints)
+        log << " " << pSpacePoints->at(iTrack).size() << " space points;";
+      if (pPFParticles)
+        log << " " << pPFParticles->at(iTrack).size() << " PF particles;";
+    } // if we have any association
+
+    if (pHits && fPrintHits) {
+      const auto& Hits = pHits->at(iTrack);
+      log << "\n  hit indices (" << Hits.size() << "):";
+      util::DumpAssociatedKeys(log, Hits, 10 /* 10 hits per line */, "    ");
+    } // if print individual hits
+
+    if (pSpacePoints && fPrintSpacePoints) {
+      const auto& SpacePoints = pSpacePoints->at(iTrack);
+      log << "\n  space point IDs (" << SpacePoints.size() << "):";
+      std::vector<std::size_t> IDs;
+      IDs.reserve(SpacePoints.size());
+      for (auto const& ptr: SpacePoints) IDs.push_back(ptr->ID());
+      std::sort(IDs.begin(), IDs.end());
+      util::DumpKeyRanges(log, util::FindKeyRanges(IDs.begin(), IDs.end()),
+        10 /* 10 hits per line */, "    ");
+    } // if print individual space points
+
+    if (pPFParticles && fPrintParticles) {
+      const auto& PFParticles = pPFParticles->at(iTrack);
+      log << "\n  particle indices (" << PFParticles.size() << "):";
+      // currently a particle has no ID
+      util::DumpAssociatedKeys
+        (log, PFParticles, 10 /* 10 hits per line */, "    ");
+    } // if print individual particles
+  } // DumpTracks::DumpAssociations()
+
+
+  //---------------------------------------------------------------------------
+  template <typename STREAM>
   void DumpTracks::DumpTrack
-    (unsigned int iTrack, recob::Track const& track) const
+    (STREAM& log, unsigned int iTrack, recob::Track const& track) const
   {
     // print a header for the track
     const unsigned int nPoints = track.NumberTrajectoryPoints();
-    mf::LogVerbatim log(fOutputCategory);
     log
       << "Track #" << iTrack << " ID: " << track.ID()
         << std::fixed << std::setprecision(3)
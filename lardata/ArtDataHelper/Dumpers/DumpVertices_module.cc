@@ -7,10 +7,12 @@
 
 // LArSoft includes
 #include "lardataobj/RecoBase/Vertex.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 
 // art libraries
 #include "canvas/Utilities/InputTag.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Principal/Event.h"
 
 // support libraries
@@ -38,22 +40,34 @@ namespace recob {
    *   for the output (useful for filtering)
    * - *PrintHexFloats* (boolean, default: `false`): print all the floating
    *   point numbers in base 16
+   * - *PrintExactFloats* (boolean, default: `false`): print all the floating
+   *   point numbers in base 10, with the shortest representation that reads
+   *   back into exactly the same number (useful to compare dumps bit by bit);
+   *   ignored if *PrintHexFloats* is set
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*: dump only a sample of
+   *   the events and of the vertices (see `recob::dumper::SamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    *
    */
-  class DumpVertices: public art::EDAnalyzer {
+  class DumpVertices: public art::SharedAnalyzer {
       public:
 
     /// Default constructor
-    explicit DumpVertices(fhicl::ParameterSet const& pset);
+    DumpVertices(fhicl::ParameterSet const& pset, art::ProcessingFrame const&);
 
     /// Does the printing
-    virtual void analyze (const art::Event& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fInputTag; ///< input tag of the Vertex product
     std::string fOutputCategory; ///< category for LogInfo output
     bool fPrintHexFloats; ///< whether to print floats in base 16
+    bool fPrintExactFloats; ///< whether to print floats exactly
+    recob::dumper::DumpSampler fSampler; ///< selection of the dumped vertices
 
   }; // class DumpVertices
 
@@ -66,14 +80,13 @@ namespace recob {
 
 // LArSoft includes
 #include "lardataobj/RecoBase/Vertex.h"
-#include "lardata/ArtDataHelper/Dumpers/hexfloat.h"
+#include "lardata/ArtDataHelper/Dumpers/FloatFormat.h"
 
 // art libraries
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Handle.h"
 
 // support libraries
-#include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C//C++ standard libraries
 
@@ -87,6 +100,7 @@ namespace {
     /// Collection of available printing style options
     struct PrintOptions_t {
        bool hexFloats = false; ///< print all floating point numbers in base 16
+       bool exactFloats = false; ///< print all floating point numbers exactly
     }; // PrintOptions_t
 
 
@@ -105,12 +119,18 @@ namespace {
       {}
 
 
+    /// Sets the selection of the vertices to be dumped (`nullptr`: all)
+    void SetSampler(recob::dumper::DumpSampler const* vertex_sampler)
+      { sampler = vertex_sampler; }
+
+
     /// Dump a vertex specified by its index in the input list
     template <typename Stream>
     void DumpVertex
       (Stream&& out, size_t iVertex, std::string indentstr = "") const
       {
-        lar::OptionalHexFloat hexfloat(options.hexFloats);
+        lar::FloatFormat const fmt
+          = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
 
         recob::Vertex const& vertex = vertices.at(iVertex);
 
@@ -123,8 +143,8 @@ namespace {
         std::array<double, 3> vtx_pos;
         vertex.XYZ(vtx_pos.data());
         out << " ID=" << vertex.ID() << " at ("
-          << hexfloat(vtx_pos[0]) << "," << hexfloat(vtx_pos[1])
-          << "," << hexfloat(vtx_pos[2])
+          << fmt(vtx_pos[0]) << "," << fmt(vtx_pos[1])
+          << "," << fmt(vtx_pos[2])
           << ")";
 
         //
@@ -140,8 +160,10 @@ namespace {
       {
         indentstr += "  ";
         size_t const nVertices = vertices.size();
-        for (size_t iVertex = 0; iVertex < nVertices; ++iVertex)
+        for (size_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+          if (sampler && !sampler->selectElement(iVertex)) continue;
           DumpVertex(out, iVertex, indentstr);
+        } // for
       } // DumpAllVertices()
 
 
@@ -151,6 +173,9 @@ namespace {
 
     PrintOptions_t options; ///< printing and formatting options
 
+    /// Selection of the vertices to be dumped (`nullptr`: all)
+    recob::dumper::DumpSampler const* sampler = nullptr;
+
   }; // VertexDumper
 
 
@@ -164,16 +189,25 @@ namespace {
 namespace recob {
 
   //----------------------------------------------------------------------------
-  DumpVertices::DumpVertices(fhicl::ParameterSet const& pset)
-    : EDAnalyzer(pset)
+  DumpVertices::DumpVertices
+    (fhicl::ParameterSet const& pset, art::ProcessingFrame const&)
+    : SharedAnalyzer(pset)
     , fInputTag      (pset.get<art::InputTag>("VertexModuleLabel"))
     , fOutputCategory(pset.get<std::string>  ("OutputCategory", "DumpVertices"))
     , fPrintHexFloats(pset.get<bool>         ("PrintHexFloats", false))
-    {}
+    , fPrintExactFloats(pset.get<bool>       ("PrintExactFloats", false))
+    , fSampler       (pset)
+    {
+      async<art::InEvent>();
+    }
 
 
   //----------------------------------------------------------------------------
-  void DumpVertices::analyze(const art::Event& evt) {
+  void DumpVertices::analyze
+    (art::Event const& evt, art::ProcessingFrame const&)
+  {
+
+    if (!fSampler.selectEvent()) return;
 
     //
     // collect all the available information
@@ -182,18 +216,21 @@ namespace recob {
     auto Vertices = evt.getValidHandle<std::vector<recob::Vertex>>(fInputTag);
 
     size_t const nVertices = Vertices->size();
-    mf::LogVerbatim(fOutputCategory) << "Event " << evt.id()
+    recob::dumper::EventDump out(fOutputCategory);
+    out.line() << "Event " << evt.id()
       << " contains " << nVertices << " vertices from '"
       << fInputTag.encode() << "'";
 
     // prepare the dumper
     VertexDumper::PrintOptions_t options;
     options.hexFloats = fPrintHexFloats;
+    options.exactFloats = fPrintExactFloats;
     VertexDumper dumper(*Vertices, options);
+    dumper.SetSampler(&fSampler);
 
-    dumper.DumpAllVertices(mf::LogVerbatim(fOutputCategory), "  ");
+    dumper.DumpAllVertices(out.line(), "  ");
 
-    mf::LogVerbatim(fOutputCategory) << "\n"; // two empty lines
+    out.line() << "\n"; // two empty lines
 
   } // DumpVertices::analyze()
 
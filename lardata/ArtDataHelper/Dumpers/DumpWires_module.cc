@@ -6,12 +6,15 @@
  */
 
 // LArSoft includes
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+#include "lardata/ArtDataHelper/Dumpers/DumpSampling.h"
+#include "lardata/ArtDataHelper/Dumpers/EventDump.h"
 #include "lardataalg/Utilities/StatCollector.h" // lar::util::MinMaxCollector<>
 #include "lardataobj/RecoBase/Wire.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
 // art libraries
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
@@ -21,10 +24,11 @@
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/TableFragment.h"
 
 // C//C++ standard libraries
 #include <string>
+#include <memory> // std::unique_ptr<>
 #include <ios> // std::fixed
 #include <iomanip> // std::setprecision(), std::setw()
 
@@ -67,8 +71,18 @@ namespace caldata {
    *   for the output (useful for filtering)
    * - *DigitsPerLine* (integer, default: `20`): the dump of digits and ticks
    *   will put this many of them for each line; `0` suppresses digit printout
+   * - *BinaryFile* (string, default: empty): if specified, the content of the
+   *   wires is written into this file in the binary format described in
+   *   `BinaryDump.h` instead of into the message facility;
+   *   `DumpBinaryToText` can print it as text
+   * - *EventPrescale*, *ElementPrescale*, *KeyRange*, *ChannelRange*: dump
+   *   only a sample of the events and of the wires (see
+   *   `recob::dumper::ChannelSamplingConfig`)
+   *
+   * Events can be processed concurrently: the dump of each event is emitted
+   * as a single message.
    */
-  class DumpWires : public art::EDAnalyzer {
+  class DumpWires : public art::SharedAnalyzer {
       public:
 
     struct Config {
@@ -87,28 +101,42 @@ namespace caldata {
         "DumpWires" /* default */
         };
 
+      fhicl::Atom<std::string> BinaryFile{
+        Name("BinaryFile"),
+        Comment("if not empty, the dump is written in binary form into this file"
+          " (convert it to text with DumpBinaryToText)"),
+        "" /* default */
+        };
+
       fhicl::Atom<unsigned int> DigitsPerLine {
         Name("DigitsPerLine"),
         Comment("number of digits printed per line (0: don't print digits)"),
         20 /* default */
         };
 
+      fhicl::TableFragment<recob::dumper::ChannelSamplingConfig> Sampling;
+
     }; // Config
 
-    using Parameters = art::EDAnalyzer::Table<Config>;
+    using Parameters = art::SharedAnalyzer::Table<Config>;
 
 
     /// Constructor.
-    explicit DumpWires(Parameters const& config);
+    DumpWires(Parameters const& config, art::ProcessingFrame const&);
 
     /// Does the printing.
-    virtual void analyze (art::Event const& evt) override;
+    virtual void analyze
+      (art::Event const& evt, art::ProcessingFrame const&) override;
 
       private:
 
     art::InputTag fCalWireModuleLabel; ///< Input tag for wires.
     std::string fOutputCategory; ///< Category for `LogVerbatim` output.
     unsigned int fDigitsPerLine; ///< Ticks/digits per line in the output.
+    recob::dumper::DumpSampler fSampler; ///< Selection of the dumped wires.
+
+    /// Binary output file (if any).
+    std::unique_ptr<recob::dumper::BinaryDumpWriter> fBinaryOut;
 
     /// Dumps a single `recob:Wire` to the specified output stream.
     template <typename Stream>
@@ -125,27 +153,54 @@ namespace caldata {
 //------------------------------------------------------------------------------
 //---  Implementation
 //------------------------------------------------------------------------------
-caldata::DumpWires::DumpWires(Parameters const& config)
-  : EDAnalyzer         (config)
+caldata::DumpWires::DumpWires
+  (Parameters const& config, art::ProcessingFrame const&)
+  : SharedAnalyzer     (config)
   , fCalWireModuleLabel(config().CalWireModuleLabel())
   , fOutputCategory    (config().OutputCategory())
   , fDigitsPerLine     (config().DigitsPerLine())
-  {}
+  , fSampler           (config().Sampling())
+  {
+    if (!config().BinaryFile().empty()) {
+      fBinaryOut = std::make_unique<recob::dumper::BinaryDumpWriter>
+        (config().BinaryFile());
+    }
+    async<art::InEvent>();
+  }
 
 
 //------------------------------------------------------------------------------
-void caldata::DumpWires::analyze(art::Event const& evt) {
+void caldata::DumpWires::analyze
+  (art::Event const& evt, art::ProcessingFrame const&)
+{
+
+  if (!fSampler.selectEvent()) return;
 
   auto const& Wires
     = *(evt.getValidHandle<std::vector<recob::Wire>>(fCalWireModuleLabel));
 
-  mf::LogVerbatim(fOutputCategory) << "Event " << evt.id()
+  if (fBinaryOut) {
+    auto const lock = fBinaryOut->lock(); // records of this event together
+    fBinaryOut->writeEvent(evt.run(), evt.subRun(), evt.event(),
+      fCalWireModuleLabel.encode(), Wires.size());
+    for (std::size_t iWire = 0; iWire < Wires.size(); ++iWire) {
+      recob::Wire const& wire = Wires[iWire];
+      if (!fSampler.selectElement(iWire, wire.Channel())) continue;
+      recob::dumper::writeWire(*fBinaryOut, wire);
+    } // for wire
+    return;
+  } // if binary output
+
+  recob::dumper::EventDump out(fOutputCategory);
+  out.line() << "Event " << evt.id()
     << " contains " << Wires.size() << " '" << fCalWireModuleLabel.encode()
     << "' wires";
 
-  for (recob::Wire const& wire: Wires) {
+  for (std::size_t iWire = 0; iWire < Wires.size(); ++iWire) {
+    recob::Wire const& wire = Wires[iWire];
+    if (!fSampler.selectElement(iWire, wire.Channel())) continue;
 
-    PrintWire(mf::LogVerbatim(fOutputCategory), wire);
+    PrintWire(out.line(), wire);
 
   } // for wire
 
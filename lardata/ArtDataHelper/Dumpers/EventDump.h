@@ -0,0 +1,109 @@
+/**
+ * @file   EventDump.h
+ * @brief  Collects the text dump of one event, emitted as a single block
+ * @date   October 14, 2026
+ *
+ * This library is header-only, but `AsyncDumpWriter` output requires linking
+ * to `lardata_ArtDataHelper_Dumpers`.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_DUMPERS_EVENTDUMP_H
+#define LARDATA_ARTDATAHELPER_DUMPERS_EVENTDUMP_H 1
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Dumpers/AsyncDumpWriter.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <sstream>
+#include <string>
+#include <utility> // std::forward()
+
+
+namespace recob {
+  namespace dumper {
+
+    /**
+     * @brief Text output of a dumper module for a single event
+     *
+     * Dumper modules processing events concurrently can't write each line as
+     * a separate message, since lines from different events would be mixed.
+     * Each call of `analyze()` instead formats all its output into a local
+     * `EventDump`, which emits it as a single message on destruction:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * void DumpHits::analyze(art::Event const& evt, art::ProcessingFrame const&)
+     * {
+     *   recob::dumper::EventDump out(fOutputCategory);
+     *
+     *   out.line() << "The event contains " << Hits->size() << " hits";
+     *   for (std::size_t iHit = 0; iHit < Hits->size(); ++iHit)
+     *     out.line() << "Hit #" << iHit << ": " << (*Hits)[iHit];
+     *
+     * } // DumpHits::analyze()
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The message goes to the message facility as `mf::LogVerbatim` with the
+     * specified category, or, if an `AsyncDumpWriter` is specified, it is
+     * submitted to it as a single block.
+     * The output of each event is therefore contiguous, while the order of
+     * the events is the one they are completed in.
+     *
+     * The object can be used as a stream by the dumping functions.
+     */
+    class EventDump {
+        public:
+
+      /// Constructor: the dump will go to `writer`, or to `category` if none
+      EventDump(std::string const& category, AsyncDumpWriter* writer = nullptr)
+        : fCategory(category), fWriter(writer)
+        {}
+
+      /// Destructor: emits the dump
+      ~EventDump() { emit(); }
+
+      EventDump(EventDump const&) = delete;
+      EventDump& operator= (EventDump const&) = delete;
+
+      /// Adds a value to the current line
+      template <typename T>
+      EventDump& operator<< (T&& value)
+        { fText << std::forward<T>(value); return *this; }
+
+      /**
+       * @brief Starts a new line, and returns this object
+       *
+       * The format of the stream is reset, so that each line starts with the
+       * default format like a new message would.
+       */
+      EventDump& line()
+        {
+          if (fText.tellp() > 0) fText << '\n';
+          fText.copyfmt(fPristine);
+          return *this;
+        }
+
+      /// Emits the text collected so far, if any
+      void emit()
+        {
+          std::string text = fText.str();
+          if (text.empty()) return;
+          fText.str({});
+          if (fWriter) fWriter->submit(text);
+          else         mf::LogVerbatim(fCategory) << text;
+        } // emit()
+
+        private:
+      std::string const fCategory; ///< message facility category
+      AsyncDumpWriter* const fWriter; ///< writer to submit the dump to, if any
+      std::ostringstream fText; ///< text collected so far
+      std::ostringstream const fPristine; ///< stream with the default format
+
+    }; // class EventDump
+
+
+  } // namespace dumper
+} // namespace recob
+
+
+#endif // LARDATA_ARTDATAHELPER_DUMPERS_EVENTDUMP_H
@@ -0,0 +1,205 @@
+/**
+ * @file    FloatFormat.h
+ * @brief   Fast formatting of real numbers for the dumpers
+ * @date    October 14, 2026
+ * @see     hexfloat.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_DUMPERS_FLOATFORMAT_H
+#define LARDATA_ARTDATAHELPER_DUMPERS_FLOATFORMAT_H 1
+
+// C/C++ standard libraries
+#include <charconv> // std::to_chars()
+#include <cmath> // std::signbit(), std::isfinite()
+#include <cstddef> // std::size_t
+#include <ostream>
+#include <type_traits> // std::is_floating_point<>
+#include <system_error> // std::errc
+
+
+namespace lar {
+
+  namespace details {
+    template <typename T> struct FormattedFloat;
+  } // namespace details
+
+
+  /**
+   * @brief Formatter of real numbers based on `std::to_chars()`
+   *
+   * Example of use:
+   *
+   *     lar::FloatFormat const exact { lar::FloatFormat::Shortest };
+   *     lar::FloatFormat const money { lar::FloatFormat::Fixed, 2 };
+   *
+   *     std::cout << exact(0.1) << " " << money(0.125) << std::endl;
+   *
+   * prints `0.1 0.12`. The supported modes are:
+   *
+   * * `Stream`: the number is inserted in the stream as it is, honouring the
+   *   flags of the stream
+   * * `Shortest`: the shortest representation that reads back into the same
+   *   number, bit by bit (a `float` is printed with the digits needed to
+   *   read back a `float`)
+   * * `Fixed`: fixed point notation with the specified number of decimal
+   *   digits (numbers too large for the internal buffer are printed as in
+   *   `Shortest` mode)
+   * * `Hex`: exact representation in base 16, like `-0x1.8p-2` (unlike
+   *   `lar::OptionalHexFloat`, no padding is added, and `float` is supported)
+   *
+   * Except for `Stream` mode, the conversion does not go through the locale
+   * machinery of the stream, and the precision and notation flags of the
+   * stream are ignored (the field width is still respected). This is faster,
+   * and makes the output not affected by the stream state left by the
+   * previous output.
+   */
+  class FloatFormat {
+      public:
+
+    /// Available formats
+    enum Mode {
+      Stream,   ///< insertion in the stream, according to its flags
+      Shortest, ///< shortest representation that can be read back exactly
+      Fixed,    ///< fixed number of decimal digits
+      Hex       ///< exact representation in base 16
+    }; // Mode
+
+    /// Size of the buffer the numbers are formatted into
+    static constexpr std::size_t BufferSize = 64U;
+
+
+    /// Constructor: uses the specified mode (and precision for `Fixed` mode)
+    constexpr FloatFormat(Mode mode = Stream, int precision = 6)
+      : fMode(mode), fPrecision(precision)
+      {}
+
+    /// Returns the format for `hexFloats` or `exactFloats` dumper options
+    static constexpr FloatFormat select(bool hexFloats, bool exactFloats)
+      { return { hexFloats? Hex: (exactFloats? Shortest: Stream) }; }
+
+
+    /// Returns the formatting mode
+    constexpr Mode mode() const { return fMode; }
+
+    /// Returns the number of decimal digits in `Fixed` mode
+    constexpr int precision() const { return fPrecision; }
+
+
+    /// Returns an object printing `value` when inserted into a stream
+    template <typename T>
+    details::FormattedFloat<T> operator() (T value) const
+      {
+        static_assert(std::is_floating_point<T>::value,
+          "FloatFormat formats only floating point numbers");
+        return { *this, value };
+      }
+
+
+    /**
+     * @brief Writes `value` into the specified buffer
+     * @param first start of the buffer
+     * @param last end of the buffer
+     * @param value the value to be formatted
+     * @return pointer past the last character written
+     *
+     * The buffer is not null-terminated. The `Stream` mode is treated as
+     * `Shortest`. If the buffer is too small, nothing is written and `first`
+     * is returned; a buffer of `BufferSize` characters is large enough for all
+     * modes but (possibly) `Fixed`.
+     */
+    template <typename T>
+    char* write(char* first, char* last, T value) const;
+
+
+    /// Inserts `value` into the stream `out`
+    template <typename T>
+    std::ostream& print(std::ostream& out, T value) const;
+
+
+      private:
+    Mode fMode; ///< formatting mode
+    int fPrecision; ///< decimal digits in `Fixed` mode
+
+  }; // class FloatFormat
+
+
+  namespace details {
+
+    /// A real number bound to its format, for insertion into a stream
+    template <typename T>
+    struct FormattedFloat {
+      FloatFormat format; ///< the format to be used
+      T value; ///< the number to be printed
+    }; // FormattedFloat<>
+
+    template <typename T>
+    std::ostream& operator<< (std::ostream& out, FormattedFloat<T> const& f);
+
+  } // namespace details
+
+
+} // namespace lar
+
+
+//==============================================================================
+//=== template implementation
+//===
+//------------------------------------------------------------------------------
+template <typename T>
+char* lar::FloatFormat::write(char* first, char* last, T value) const {
+
+  std::to_chars_result res;
+  switch (fMode) {
+    case Fixed:
+      res = std::to_chars
+        (first, last, value, std::chars_format::fixed, fPrecision);
+      if (res.ec == std::errc()) return res.ptr;
+      break; // try again with the shortest representation
+    case Hex: {
+      if (!std::isfinite(value)) break; // "inf" or "nan", without prefix
+      if (last - first < 3) return first;
+      char* p = first;
+      if (std::signbit(value)) *p++ = '-';
+      *p++ = '0';
+      *p++ = 'x';
+      res = std::to_chars(p, last, std::abs(value), std::chars_format::hex);
+      return (res.ec == std::errc())? res.ptr: first;
+    }
+    case Stream:
+    case Shortest:
+    default:
+      break;
+  } // switch
+
+  res = std::to_chars(first, last, value);
+  return (res.ec == std::errc())? res.ptr: first;
+
+} // lar::FloatFormat::write()
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+std::ostream& lar::FloatFormat::print(std::ostream& out, T value) const {
+
+  if (fMode == Stream) return out << value;
+
+  char buffer[BufferSize];
+  char* const end = write(buffer, buffer + BufferSize - 1, value);
+  *end = '\0';
+  return out << buffer; // respects the field width
+
+} // lar::FloatFormat::print()
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+std::ostream& lar::details::operator<<
+  (std::ostream& out, FormattedFloat<T> const& f)
+  { return f.format.print(out, f.value); }
+
+
+//------------------------------------------------------------------------------
+
+#endif // LARDATA_ARTDATAHELPER_DUMPERS_FLOATFORMAT_H
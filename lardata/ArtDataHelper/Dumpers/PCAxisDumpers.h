@@ -12,6 +12,9 @@
 // LArSoft libraries
 #include "lardataobj/RecoBase/PCAxis.h"
 
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Dumpers/FloatFormat.h"
+
 // C/C++ standard libraries
 #include <string>
 #include <iomanip>
@@ -29,11 +32,17 @@ namespace recob {
     /// Dumps the content of the specified PCA axis (indentation info in nl)
     /// @tparam Stream the type of the output stream
     /// @tparam NewLineRef NewLine reference type (to get a universal reference)
+    ///
+    /// Positions and eigenvalues are printed with 2 decimal digits and
+    /// eigenvectors with 4, unless a format other than `Stream` is specified
+    /// in `fmt`, in which case that one is used for all the numbers.
     template <typename Stream, typename NewLineRef>
     std::enable_if_t
       <std::is_same<recob::dumper::NewLine<std::decay_t<Stream>>, std::decay_t<NewLineRef>>::value>
-    DumpPCAxis
-      (Stream&& out, recob::PCAxis const& pca, NewLineRef&& nl);
+    DumpPCAxis(
+      Stream&& out, recob::PCAxis const& pca, NewLineRef&& nl,
+      lar::FloatFormat fmt = {}
+      );
 
     /** ************************************************************************
      * @brief Dumps the content of the specified PCA axis into a stream
@@ -42,6 +51,7 @@ namespace recob {
      * @param pca the principal component axis to be dumped
      * @param indent indentation string (none by default)
      * @param indentFirst whether to indent the first line (yes by default)
+     * @param fmt format of the real numbers (default: fixed decimal digits)
      *
      * Insertion operators are required that insert into Stream basic types.
      *
@@ -50,11 +60,13 @@ namespace recob {
     template <typename Stream>
     void DumpPCAxis(Stream&& out, recob::PCAxis const& pca,
       std::string indent = "",
-      bool indentFirst = true
+      bool indentFirst = true,
+      lar::FloatFormat fmt = {}
       )
       {
         DumpPCAxis(
-          std::forward<Stream>(out), pca, makeNewLine(out, indent, !indentFirst)
+          std::forward<Stream>(out), pca, makeNewLine(out, indent, !indentFirst),
+          fmt
           );
       }
 
@@ -72,43 +84,55 @@ namespace recob {
 template <typename Stream, typename NewLineRef>
 std::enable_if_t
   <std::is_same<recob::dumper::NewLine<std::decay_t<Stream>>, std::decay_t<NewLineRef>>::value>
-recob::dumper::DumpPCAxis
-  (Stream&& out, recob::PCAxis const& pca, NewLineRef&& nl)
-{
+recob::dumper::DumpPCAxis(
+  Stream&& out, recob::PCAxis const& pca, NewLineRef&& nl,
+  lar::FloatFormat fmt /* = {} */
+) {
 
   if (!pca.getSvdOK()) {
     nl() << "<not valid>";
     return;
   }
 
-  nl() << std::setiosflags(std::ios::fixed) << std::setprecision(2)
+  // the fixed formats do not change the state of the stream
+  bool const useFixed = (fmt.mode() == lar::FloatFormat::Stream);
+  lar::FloatFormat const pos
+    = useFixed? lar::FloatFormat{ lar::FloatFormat::Fixed, 2 }: fmt;
+  lar::FloatFormat const dir
+    = useFixed? lar::FloatFormat{ lar::FloatFormat::Fixed, 4 }: fmt;
+
+  auto const& center = pca.getAvePosition();
+  auto const& values = pca.getEigenValues();
+  auto const& vectors = pca.getEigenVectors();
+
+  nl()
     << " ID " << pca.getID()
     << " run on " << pca.getNumHitsUsed() << " space points";
   nl()
-    << "  - center position: " << std::setw(6) << pca.getAvePosition()[0]
-    << ", " << pca.getAvePosition()[1]
-    << ", " << pca.getAvePosition()[2];
+    << "  - center position: " << std::setw(6) << pos(center[0])
+    << ", " << pos(center[1])
+    << ", " << pos(center[2]);
   nl()
     << "  - eigen values: " << std::setw(8) << std::right
-    << pca.getEigenValues()[0] << ", "
-    << pca.getEigenValues()[1] << ", " << pca.getEigenValues()[2];
+    << pos(values[0]) << ", "
+    << pos(values[1]) << ", " << pos(values[2]);
   nl()
-    << "  - average doca: " << pca.getAveHitDoca();
+    << "  - average doca: " << pos(pca.getAveHitDoca());
   nl()
     << "  - principle axis: "
-    << std::setw(7) << std::setprecision(4) << pca.getEigenVectors()[0][0]
-    << ", " << pca.getEigenVectors()[0][1]
-    << ", " << pca.getEigenVectors()[0][2];
+    << std::setw(7) << dir(vectors[0][0])
+    << ", " << dir(vectors[0][1])
+    << ", " << dir(vectors[0][2]);
   nl()
     << "  - second axis: "
-    << std::setw(7) << std::setprecision(4) << pca.getEigenVectors()[1][0]
-    << ", " << pca.getEigenVectors()[1][1]
-    << ", " << pca.getEigenVectors()[1][2];
+    << std::setw(7) << dir(vectors[1][0])
+    << ", " << dir(vectors[1][1])
+    << ", " << dir(vectors[1][2]);
   nl()
     << "  - third axis: "
-    << std::setw(7) << std::setprecision(4) << pca.getEigenVectors()[2][0]
-    << ", " << pca.getEigenVectors()[2][1]
-    << ", " << pca.getEigenVectors()[2][2];
+    << std::setw(7) << dir(vectors[2][0])
+    << ", " << dir(vectors[2][1])
+    << ", " << dir(vectors[2][2]);
 
 } // recob::dumper::DumpPCAxis()
 
@@ -20,7 +20,7 @@
 
 // --- for the implementation ---
 // LArSoft libraries
-#include "lardata/ArtDataHelper/Dumpers/hexfloat.h"
+#include "lardata/ArtDataHelper/Dumpers/FloatFormat.h"
 #include "lardata/ArtDataHelper/Dumpers/NewLine.h"
 
 
@@ -31,6 +31,8 @@ namespace recob {
     struct SpacePointPrintOptions_t {
       IndentOptions_t indent; ///< indentation string
       bool hexFloats = false; ///< print all floating point numbers in base 16
+      /// print all floating point numbers exactly, in their shortest form
+      bool exactFloats = false;
 
       /**
        * @brief Default constructor
@@ -39,14 +41,14 @@ namespace recob {
        *
        *  * no indentation
        *  * same indentation for the first and the following lines
-       *  * real numbers printed in base 10
+       *  * real numbers printed in base 10, with the stream precision
        *
        */
       SpacePointPrintOptions_t() = default;
 
       SpacePointPrintOptions_t
-        (IndentOptions_t indentOptions, bool bHexFloats)
-        : indent(indentOptions), hexFloats(bHexFloats)
+        (IndentOptions_t indentOptions, bool bHexFloats, bool bExactFloats = false)
+        : indent(indentOptions), hexFloats(bHexFloats), exactFloats(bExactFloats)
         {}
 
     }; // SpacePointPrintOptions_t
@@ -94,18 +96,19 @@ auto recob::dumper::DumpSpacePoint(
   double const* err = sp.ErrXYZ();
 
   NewLineRef nl(out, options.indent);
-  lar::OptionalHexFloat hexfloat(options.hexFloats);
+  lar::FloatFormat const fmt
+    = lar::FloatFormat::select(options.hexFloats, options.exactFloats);
 
   nl()
-    << "ID=" << sp.ID() << " at (" << hexfloat(pos[0])
-    << ", " << hexfloat(pos[1]) << ", " << hexfloat(pos[2])
-    << ") cm, chi^2/NDF=" << hexfloat(sp.Chisq());
+    << "ID=" << sp.ID() << " at (" << fmt(pos[0])
+    << ", " << fmt(pos[1]) << ", " << fmt(pos[2])
+    << ") cm, chi^2/NDF=" << fmt(sp.Chisq());
 
   nl()
-    << "variances { x^2=" << hexfloat(err[0]) << " y^2=" << hexfloat(err[2])
-    << " z^2=" << hexfloat(err[5])
-    << " xy=" << hexfloat(err[1]) << " xz=" << hexfloat(err[3])
-    << " yz=" << hexfloat(err[4]) << " }";
+    << "variances { x^2=" << fmt(err[0]) << " y^2=" << fmt(err[2])
+    << " z^2=" << fmt(err[5])
+    << " xy=" << fmt(err[1]) << " xz=" << fmt(err[3])
+    << " yz=" << fmt(err[4]) << " }";
 
 } // recob::dumper::DumpSpacePoint()
 
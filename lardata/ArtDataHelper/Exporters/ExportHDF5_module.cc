@@ -0,0 +1,463 @@
+/**
+ * @file   ExportHDF5_module.cc
+ * @brief  Writes hits, wires, space points and MVA outputs into HDF5 tables
+ * @date   October 14, 2026
+ * @see    HDF5ColumnWriter.h
+ */
+
+// LArSoft includes
+#include "lardata/ArtDataHelper/Exporters/HDF5ColumnWriter.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/Wire.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/AnalysisBase/MVAOutput.h"
+
+// art libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Utilities/InputTag.h"
+#include "canvas/Utilities/Exception.h"
+
+// support libraries
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+#include "fhiclcpp/types/Table.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// C//C++ standard libraries
+#include <memory> // std::unique_ptr<>
+#include <string>
+#include <utility> // std::index_sequence<>
+#include <vector>
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+
+namespace {
+
+  using recob::exporter::TableColumns;
+
+  /// Name of the table of `kind` for the data product with `tag`
+  std::string tableName(std::string const& kind, art::InputTag const& tag) {
+    std::string name = kind + "_" + tag.encode();
+    for (char& c: name) if ((c == ':') || (c == '/') || (c == '.')) c = '_';
+    return name;
+  } // tableName()
+
+
+  /// Fills the table with the feature vectors of size `N` with `tag`
+  template <std::size_t N>
+  void fillFeatureVectors(
+    art::Event const& event, art::InputTag const& tag,
+    std::vector<std::string> const& names, TableColumns& table
+  ) {
+    auto const& vectors
+      = *event.getValidHandle<std::vector<anab::FeatureVector<N>>>(tag);
+    std::vector<std::vector<float>*> columns;
+    for (std::size_t i = 0; i < N; ++i) {
+      columns.push_back(&table.column<float>
+        (names.empty()? ("f" + std::to_string(i)): names[i]));
+      columns.back()->reserve(vectors.size());
+    }
+    for (anab::FeatureVector<N> const& vector: vectors)
+      for (std::size_t i = 0; i < N; ++i) columns[i]->push_back(vector[i]);
+  } // fillFeatureVectors()
+
+
+  using FeatureVectorFiller_t = void(*)(
+    art::Event const&, art::InputTag const&,
+    std::vector<std::string> const&, TableColumns&
+    );
+
+  /// Largest size of feature vectors supported
+  constexpr std::size_t MaxFeatureVectorSize = 16U;
+
+  /// Returns the filler of feature vectors of the specified size (or nullptr)
+  template <std::size_t... I>
+  FeatureVectorFiller_t featureVectorFiller
+    (std::size_t size, std::index_sequence<I...>)
+  {
+    FeatureVectorFiller_t const fillers[] = { &fillFeatureVectors<I + 1U>... };
+    return ((size >= 1U) && (size <= sizeof...(I)))? fillers[size - 1U]: nullptr;
+  } // featureVectorFiller()
+
+} // local namespace
+
+
+namespace recob {
+  namespace exporter {
+
+    /**
+     * @brief Writes the content of data products into a HDF5 file, as columns
+     *
+     * This analyzer writes the hits, wires, space points and feature vectors
+     * (`anab::FeatureVector`, as written by `anab::MVAWriter`) from the
+     * configured data products into tables of a HDF5 file, in the layout
+     * described in `HDF5ColumnWriter.h`. The events are written by a separate
+     * thread while the next events are processed.
+     *
+     * Each data product is written into its own set of tables, named after
+     * the kind of data and its input tag (e.g. `hit_gaushit` for the hits
+     * from `gaushit`, `mva_emtrkmichelid_emtrkmichel` for the feature vectors
+     * from `emtrkmichelid:emtrkmichel`):
+     *
+     * - `hit_<tag>`: one row per hit, with its wire ID, channel, view and
+     *   signal type and all the fit quantities
+     * - `wire_<tag>`: one row per wire, with channel, view, number of ticks,
+     *   and the range of its regions of interest in `wireroi_<tag>`
+     *   (`roi_offset` is the index of the first region of interest of the
+     *   wire within the event); `wireroi_<tag>`: one row per region of
+     *   interest, with its first tick and the range of its samples in
+     *   `wiresample_<tag>` (`sample_offset`, again within the event);
+     *   `wiresample_<tag>`: the `adc` values of all the regions of interest
+     * - `spacepoint_<tag>`: one row per space point, with ID, position, the
+     *   lower triangle of the error matrix and the chi square
+     * - `mva_<tag>`: one row per feature vector, one column per feature
+     *
+     * Configuration parameters
+     * =========================
+     *
+     * - *OutputFile* (string, default: `"export.h5"`): name of the HDF5 file
+     *   to be written (an existing file is overwritten)
+     * - *HitTags*, *WireTags*, *SpacePointTags* (lists of input tags, default:
+     *   empty): the `recob::Hit`, `recob::Wire` and `recob::SpacePoint`
+     *   collections to be written
+     * - *FeatureVectors* (list of tables, default: empty): each one describes
+     *   a collection of `anab::FeatureVector<Size>` with *Tag* (input tag of
+     *   the collection, including the instance name), *Size* (size of the
+     *   vectors, at most 16) and *Columns* (optional names of the features;
+     *   by default, `f0`, `f1`...)
+     * - *ChunkRows* (integer, default: `65536`): number of rows in each chunk
+     *   of the HDF5 datasets
+     * - *CompressionLevel* (integer, default: `4`): `deflate` compression
+     *   level of the datasets, from `0` (no compression) to `9`
+     * - *MaxQueuedEvents* (integer, default: `8`): maximum number of events
+     *   waiting to be written; when the queue is full, the event loop waits
+     */
+    class ExportHDF5 : public art::EDAnalyzer {
+        public:
+
+      struct FeatureVectorConfig {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<art::InputTag> Tag{
+          Name("Tag"),
+          Comment("tag of the collection of anab::FeatureVector")
+          };
+
+        fhicl::Atom<unsigned int> Size{
+          Name("Size"),
+          Comment("number of features in each vector")
+          };
+
+        fhicl::Sequence<std::string> Columns{
+          Name("Columns"),
+          Comment("names of the features (default: f0, f1, ...)"),
+          std::vector<std::string>{}
+          };
+
+      }; // FeatureVectorConfig
+
+
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<std::string> OutputFile{
+          Name("OutputFile"),
+          Comment("name of the HDF5 output file"),
+          "export.h5"
+          };
+
+        fhicl::Sequence<art::InputTag> HitTags{
+          Name("HitTags"),
+          Comment("tags of the recob::Hit collections to be written"),
+          std::vector<art::InputTag>{}
+          };
+
+        fhicl::Sequence<art::InputTag> WireTags{
+          Name("WireTags"),
+          Comment("tags of the recob::Wire collections to be written"),
+          std::vector<art::InputTag>{}
+          };
+
+        fhicl::Sequence<art::InputTag> SpacePointTags{
+          Name("SpacePointTags"),
+          Comment("tags of the recob::SpacePoint collections to be written"),
+          std::vector<art::InputTag>{}
+          };
+
+        fhicl::Sequence<fhicl::Table<FeatureVectorConfig>> FeatureVectors{
+          Name("FeatureVectors"),
+          Comment("collections of feature vectors to be written"),
+          std::vector<FeatureVectorConfig>{}
+          };
+
+        fhicl::Atom<unsigned int> ChunkRows{
+          Name("ChunkRows"),
+          Comment("number of rows in each chunk of the datasets"),
+          65536U
+          };
+
+        fhicl::Atom<unsigned int> CompressionLevel{
+          Name("CompressionLevel"),
+          Comment("deflate compression level (0: no compression, up to 9)"),
+          4U
+          };
+
+        fhicl::Atom<unsigned int> MaxQueuedEvents{
+          Name("MaxQueuedEvents"),
+          Comment("maximum number of events waiting to be written"),
+          8U
+          };
+
+      }; // Config
+
+      using Parameters = art::EDAnalyzer::Table<Config>;
+
+
+      /// Constructor: creates the output file
+      explicit ExportHDF5(Parameters const& config);
+
+      /// Queues the content of the event for writing
+      virtual void analyze(art::Event const& event) override;
+
+      /// Writes all the pending events
+      virtual void endJob() override;
+
+        private:
+
+      /// A collection of feature vectors to be written
+      struct FeatureVectorSource {
+        art::InputTag tag;
+        std::string table;
+        std::vector<std::string> names;
+        FeatureVectorFiller_t fill;
+      }; // FeatureVectorSource
+
+      std::vector<art::InputTag> fHitTags;
+      std::vector<art::InputTag> fWireTags;
+      std::vector<art::InputTag> fSpacePointTags;
+      std::vector<FeatureVectorSource> fFeatureVectors;
+
+      std::unique_ptr<HDF5ColumnWriter> fWriter; ///< the output file
+
+      /// Fills the table of the hits with `tag`
+      void fillHits
+        (art::Event const& event, art::InputTag const& tag, EventColumns& data)
+        const;
+
+      /// Fills the tables of the wires with `tag`
+      void fillWires
+        (art::Event const& event, art::InputTag const& tag, EventColumns& data)
+        const;
+
+      /// Fills the table of the space points with `tag`
+      void fillSpacePoints
+        (art::Event const& event, art::InputTag const& tag, EventColumns& data)
+        const;
+
+    }; // class ExportHDF5
+
+  } // namespace exporter
+} // namespace recob
+
+
+//------------------------------------------------------------------------------
+//---  module implementation
+//---
+recob::exporter::ExportHDF5::ExportHDF5(Parameters const& config)
+  : EDAnalyzer(config)
+  , fHitTags(config().HitTags())
+  , fWireTags(config().WireTags())
+  , fSpacePointTags(config().SpacePointTags())
+{
+  for (FeatureVectorConfig const& fvConfig: config().FeatureVectors()) {
+    FeatureVectorSource source;
+    source.tag = fvConfig.Tag();
+    source.table = tableName("mva", source.tag);
+    source.names = fvConfig.Columns();
+    source.fill = featureVectorFiller
+      (fvConfig.Size(), std::make_index_sequence<MaxFeatureVectorSize>());
+    if (!source.fill) {
+      throw art::Exception(art::errors::Configuration)
+        << "Feature vectors '" << source.tag.encode() << "' have size "
+        << fvConfig.Size() << ", supported sizes are 1 to "
+        << MaxFeatureVectorSize << ".\n";
+    }
+    if (!source.names.empty() && (source.names.size() != fvConfig.Size())) {
+      throw art::Exception(art::errors::Configuration)
+        << source.names.size() << " column names for the " << fvConfig.Size()
+        << " features of '" << source.tag.encode() << "'.\n";
+    }
+    fFeatureVectors.push_back(std::move(source));
+  } // for
+
+  HDF5ColumnWriter::Options options;
+  options.chunkRows = config().ChunkRows();
+  options.compressionLevel = config().CompressionLevel();
+  options.maxQueuedEvents = config().MaxQueuedEvents();
+  fWriter = std::make_unique<HDF5ColumnWriter>(config().OutputFile(), options);
+
+} // recob::exporter::ExportHDF5::ExportHDF5()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::ExportHDF5::analyze(art::Event const& event) {
+
+  EventColumns data(event.run(), event.subRun(), event.event());
+
+  for (art::InputTag const& tag: fHitTags) fillHits(event, tag, data);
+  for (art::InputTag const& tag: fWireTags) fillWires(event, tag, data);
+  for (art::InputTag const& tag: fSpacePointTags)
+    fillSpacePoints(event, tag, data);
+  for (FeatureVectorSource const& source: fFeatureVectors)
+    source.fill(event, source.tag, source.names, data.table(source.table));
+
+  // the conversion is done here; compression and writing in the background
+  fWriter->write(std::move(data));
+
+} // recob::exporter::ExportHDF5::analyze()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::ExportHDF5::endJob() {
+  fWriter->flush();
+} // recob::exporter::ExportHDF5::endJob()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::ExportHDF5::fillHits
+  (art::Event const& event, art::InputTag const& tag, EventColumns& data) const
+{
+  auto const& hits = *event.getValidHandle<std::vector<recob::Hit>>(tag);
+  TableColumns& table = data.table(tableName("hit", tag));
+
+  auto& cryostat = table.column<std::uint32_t>("cryostat");
+  auto& tpc = table.column<std::uint32_t>("tpc");
+  auto& plane = table.column<std::uint32_t>("plane");
+  auto& wire = table.column<std::uint32_t>("wire");
+  auto& channel = table.column<std::uint32_t>("channel");
+  auto& view = table.column<std::int32_t>("view");
+  auto& signalType = table.column<std::int32_t>("signal_type");
+  auto& startTick = table.column<std::int32_t>("start_tick");
+  auto& endTick = table.column<std::int32_t>("end_tick");
+  auto& peakTime = table.column<float>("peak_time");
+  auto& sigmaPeakTime = table.column<float>("sigma_peak_time");
+  auto& rms = table.column<float>("rms");
+  auto& peakAmplitude = table.column<float>("peak_amplitude");
+  auto& sigmaPeakAmplitude = table.column<float>("sigma_peak_amplitude");
+  auto& summedADC = table.column<float>("summed_adc");
+  auto& integral = table.column<float>("integral");
+  auto& sigmaIntegral = table.column<float>("sigma_integral");
+  auto& multiplicity = table.column<std::int32_t>("multiplicity");
+  auto& localIndex = table.column<std::int32_t>("local_index");
+  auto& goodnessOfFit = table.column<float>("goodness_of_fit");
+  auto& dof = table.column<std::int32_t>("dof");
+
+  for (auto* column: { &cryostat, &tpc, &plane, &wire, &channel })
+    column->reserve(hits.size());
+
+  for (recob::Hit const& hit: hits) {
+    geo::WireID const& wireID = hit.WireID();
+    cryostat.push_back(wireID.Cryostat);
+    tpc.push_back(wireID.TPC);
+    plane.push_back(wireID.Plane);
+    wire.push_back(wireID.Wire);
+    channel.push_back(hit.Channel());
+    view.push_back(hit.View());
+    signalType.push_back(hit.SignalType());
+    startTick.push_back(hit.StartTick());
+    endTick.push_back(hit.EndTick());
+    peakTime.push_back(hit.PeakTime());
+    sigmaPeakTime.push_back(hit.SigmaPeakTime());
+    rms.push_back(hit.RMS());
+    peakAmplitude.push_back(hit.PeakAmplitude());
+    sigmaPeakAmplitude.push_back(hit.SigmaPeakAmplitude());
+    summedADC.push_back(hit.SummedADC());
+    integral.push_back(hit.Integral());
+    sigmaIntegral.push_back(hit.SigmaIntegral());
+    multiplicity.push_back(hit.Multiplicity());
+    localIndex.push_back(hit.LocalIndex());
+    goodnessOfFit.push_back(hit.GoodnessOfFit());
+    dof.push_back(hit.DegreesOfFreedom());
+  } // for hits
+
+} // recob::exporter::ExportHDF5::fillHits()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::ExportHDF5::fillWires
+  (art::Event const& event, art::InputTag const& tag, EventColumns& data) const
+{
+  auto const& wires = *event.getValidHandle<std::vector<recob::Wire>>(tag);
+
+  TableColumns& wireTable = data.table(tableName("wire", tag));
+  auto& channel = wireTable.column<std::uint32_t>("channel");
+  auto& view = wireTable.column<std::int32_t>("view");
+  auto& ticks = wireTable.column<std::uint32_t>("ticks");
+  auto& roiOffset = wireTable.column<std::uint64_t>("roi_offset");
+  auto& roiCount = wireTable.column<std::uint32_t>("roi_count");
+
+  TableColumns& roiTable = data.table(tableName("wireroi", tag));
+  auto& startTick = roiTable.column<std::uint32_t>("start_tick");
+  auto& sampleOffset = roiTable.column<std::uint64_t>("sample_offset");
+  auto& sampleCount = roiTable.column<std::uint32_t>("sample_count");
+
+  auto& adc = data.table(tableName("wiresample", tag)).column<float>("adc");
+
+  for (recob::Wire const& wire: wires) {
+    auto const& rois = wire.SignalROI();
+    channel.push_back(wire.Channel());
+    view.push_back(wire.View());
+    ticks.push_back(wire.NSignal());
+    roiOffset.push_back(startTick.size());
+    roiCount.push_back(rois.n_ranges());
+    for (auto const& roi: rois.get_ranges()) {
+      startTick.push_back(roi.begin_index());
+      sampleOffset.push_back(adc.size());
+      sampleCount.push_back(roi.size());
+      adc.insert(adc.end(), roi.begin(), roi.end());
+    } // for regions of interest
+  } // for wires
+
+} // recob::exporter::ExportHDF5::fillWires()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::ExportHDF5::fillSpacePoints
+  (art::Event const& event, art::InputTag const& tag, EventColumns& data) const
+{
+  auto const& points = *event.getValidHandle<std::vector<recob::SpacePoint>>(tag);
+  TableColumns& table = data.table(tableName("spacepoint", tag));
+
+  auto& id = table.column<std::int32_t>("id");
+  auto& x = table.column<double>("x");
+  auto& y = table.column<double>("y");
+  auto& z = table.column<double>("z");
+  static char const* ErrorNames[6]
+    = { "err_xx", "err_yx", "err_yy", "err_zx", "err_zy", "err_zz" };
+  std::vector<double>* errors[6];
+  for (unsigned int i = 0; i < 6; ++i)
+    errors[i] = &table.column<double>(ErrorNames[i]);
+  auto& chisq = table.column<double>("chisq");
+
+  for (recob::SpacePoint const& point: points) {
+    double const* pos = point.XYZ();
+    double const* err = point.ErrXYZ();
+    id.push_back(point.ID());
+    x.push_back(pos[0]);
+    y.push_back(pos[1]);
+    z.push_back(pos[2]);
+    for (unsigned int i = 0; i < 6; ++i) errors[i]->push_back(err[i]);
+    chisq.push_back(point.Chisq());
+  } // for points
+
+} // recob::exporter::ExportHDF5::fillSpacePoints()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(recob::exporter::ExportHDF5)
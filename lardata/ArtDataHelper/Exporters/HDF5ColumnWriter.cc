@@ -0,0 +1,479 @@
+/**
+ * @file   HDF5ColumnWriter.cc
+ * @brief  Columnar output of data products into HDF5 files - implementation
+ * @date   October 14, 2026
+ * @see    HDF5ColumnWriter.h
+ */
+
+// library header
+#include "lardata/ArtDataHelper/Exporters/HDF5ColumnWriter.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "cetlib_except/exception.h"
+
+// HDF5
+#include "hdf5.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max(), std::min()
+#include <type_traits> // std::decay_t<>
+#include <utility> // std::move(), std::exchange()
+
+
+namespace {
+
+  /// Owner of a HDF5 identifier, closing it on destruction
+  class Handle {
+      public:
+    using Closer_t = herr_t(*)(hid_t);
+
+    Handle() = default;
+    Handle(hid_t id, Closer_t closer): fId(id), fCloser(closer) {}
+    Handle(Handle&& from)
+      : fId(std::exchange(from.fId, H5I_INVALID_HID)), fCloser(from.fCloser)
+      {}
+    Handle& operator= (Handle&& from)
+      {
+        if (this != &from) {
+          close();
+          fId = std::exchange(from.fId, H5I_INVALID_HID);
+          fCloser = from.fCloser;
+        }
+        return *this;
+      }
+    ~Handle() { close(); }
+
+    hid_t id() const { return fId; }
+
+      private:
+    hid_t fId = H5I_INVALID_HID;
+    Closer_t fCloser = nullptr;
+
+    void close() { if (fId >= 0) fCloser(fId); fId = H5I_INVALID_HID; }
+
+  }; // class Handle
+
+
+  /// Returns `id` after checking it's valid
+  hid_t checked(hid_t id, char const* what, std::string const& name) {
+    if (id < 0) {
+      throw cet::exception("HDF5ColumnWriter")
+        << "HDF5 error: " << what << " '" << name << "'\n";
+    }
+    return id;
+  } // checked()
+
+  /// Checks the status returned by a HDF5 call
+  void checked(herr_t status, char const* what) {
+    if (status < 0) {
+      throw cet::exception("HDF5ColumnWriter") << "HDF5 error: " << what << "\n";
+    }
+  } // checked()
+
+
+  /// HDF5 types of memory and file for the values of columns
+  template <typename T> struct HDF5Types;
+  template <> struct HDF5Types<float> {
+    static hid_t memory() { return H5T_NATIVE_FLOAT; }
+    static hid_t file() { return H5T_IEEE_F32LE; }
+  };
+  template <> struct HDF5Types<double> {
+    static hid_t memory() { return H5T_NATIVE_DOUBLE; }
+    static hid_t file() { return H5T_IEEE_F64LE; }
+  };
+  template <> struct HDF5Types<std::int32_t> {
+    static hid_t memory() { return H5T_NATIVE_INT32; }
+    static hid_t file() { return H5T_STD_I32LE; }
+  };
+  template <> struct HDF5Types<std::uint32_t> {
+    static hid_t memory() { return H5T_NATIVE_UINT32; }
+    static hid_t file() { return H5T_STD_U32LE; }
+  };
+  template <> struct HDF5Types<std::uint64_t> {
+    static hid_t memory() { return H5T_NATIVE_UINT64; }
+    static hid_t file() { return H5T_STD_U64LE; }
+  };
+
+
+  /// An extensible one-dimensional dataset
+  struct Dataset {
+    Handle id; ///< the open dataset
+    hid_t memoryType; ///< HDF5 type of the values in memory
+    std::size_t typeIndex; ///< index of the values type in `ColumnData`
+    hsize_t size = 0U; ///< current number of entries
+
+    /// Appends `n` values at the end of the dataset
+    void append(void const* data, hsize_t n);
+
+    /// Appends the values of a column at the end of the dataset
+    void append(recob::exporter::ColumnData const& data)
+      {
+        std::visit
+          ([this](auto const& values){ append(values.data(), values.size()); }, data);
+      }
+
+  }; // struct Dataset
+
+
+  void Dataset::append(void const* data, hsize_t n) {
+    if (n == 0U) return;
+    hsize_t const newSize = size + n;
+    checked(H5Dset_extent(id.id(), &newSize), "extending a dataset");
+    Handle fileSpace
+      { checked(H5Dget_space(id.id()), "getting space of", "dataset"), H5Sclose };
+    checked(
+      H5Sselect_hyperslab
+        (fileSpace.id(), H5S_SELECT_SET, &size, nullptr, &n, nullptr),
+      "selecting the new entries of a dataset"
+      );
+    Handle memorySpace
+      { checked(H5Screate_simple(1, &n, nullptr), "creating", "memory space"), H5Sclose };
+    checked(
+      H5Dwrite(id.id(), memoryType, memorySpace.id(), fileSpace.id(), H5P_DEFAULT, data),
+      "writing into a dataset"
+      );
+    size = newSize;
+  } // Dataset::append()
+
+
+  /// A table: its group and the datasets of its columns and of its index
+  struct Table {
+    Handle group;
+    std::vector<std::pair<std::string, Dataset>> columns; ///< columns, in order
+    Dataset offset; ///< first row of each event
+    Dataset count; ///< number of rows of each event
+    std::uint64_t nRows = 0U; ///< total number of rows
+
+    /// Appends the index entries of an event with `n` rows
+    void appendEventIndex(std::uint64_t n)
+      {
+        offset.append(&nRows, 1U);
+        count.append(&n, 1U);
+        nRows += n;
+      }
+
+  }; // struct Table
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//---  recob::exporter::HDF5ColumnWriter::File
+//---
+struct recob::exporter::HDF5ColumnWriter::File {
+
+  Options const options;
+  Handle file;
+  Handle eventGroup;
+  Dataset run, subRun, event;
+  std::map<std::string, Table> tables;
+  std::uint64_t nEvents = 0U;
+
+  File(std::string const& fileName, Options const& options);
+
+  /// Writes all the content of an event
+  void write(EventColumns const& event);
+
+    private:
+
+  /// Creates an empty dataset of values of type `T`
+  template <typename T>
+  Dataset createDataset(hid_t parent, std::string const& name) const;
+
+  /// Creates an empty dataset for values of the same type as `data`
+  Dataset createDataset
+    (hid_t parent, std::string const& name, ColumnData const& data) const;
+
+  /// Creates a table with the columns in `rows`
+  Table& createTable(std::string const& name, TableColumns const& rows);
+
+  /// Checks that the columns of `rows` match the ones of `table`
+  static void checkColumns
+    (std::string const& name, Table const& table, TableColumns const& rows);
+
+}; // recob::exporter::HDF5ColumnWriter::File
+
+
+recob::exporter::HDF5ColumnWriter::File::File
+  (std::string const& fileName, Options const& options)
+  : options(options)
+  , file{
+      checked(H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT),
+        "can't create the output file", fileName),
+      H5Fclose
+    }
+  , eventGroup{
+      checked(H5Gcreate2(file.id(), "events", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
+        "creating group", "events"),
+      H5Gclose
+    }
+  , run(createDataset<std::uint32_t>(eventGroup.id(), "run"))
+  , subRun(createDataset<std::uint32_t>(eventGroup.id(), "subrun"))
+  , event(createDataset<std::uint32_t>(eventGroup.id(), "event"))
+{}
+
+
+template <typename T>
+Dataset recob::exporter::HDF5ColumnWriter::File::createDataset
+  (hid_t parent, std::string const& name) const
+{
+  hsize_t const initialSize = 0U;
+  hsize_t const maxSize = H5S_UNLIMITED;
+  hsize_t const chunkSize = std::max<hsize_t>(options.chunkRows, 1U);
+
+  Handle space{
+    checked(H5Screate_simple(1, &initialSize, &maxSize), "creating space of", name),
+    H5Sclose
+    };
+  Handle properties{
+    checked(H5Pcreate(H5P_DATASET_CREATE), "creating properties of", name),
+    H5Pclose
+    };
+  checked(H5Pset_chunk(properties.id(), 1, &chunkSize), "setting the chunk size");
+  if (options.compressionLevel > 0U) {
+    if (options.shuffle)
+      checked(H5Pset_shuffle(properties.id()), "setting the shuffle filter");
+    checked(H5Pset_deflate(properties.id(), std::min(options.compressionLevel, 9U)),
+      "setting the compression");
+  }
+
+  Dataset dataset;
+  dataset.id = Handle{
+    checked(H5Dcreate2(parent, name.c_str(), HDF5Types<T>::file(), space.id(),
+      H5P_DEFAULT, properties.id(), H5P_DEFAULT), "creating dataset", name),
+    H5Dclose
+    };
+  dataset.memoryType = HDF5Types<T>::memory();
+  dataset.typeIndex = ColumnData(std::vector<T>{}).index();
+  return dataset;
+} // recob::exporter::HDF5ColumnWriter::File::createDataset()
+
+
+Dataset recob::exporter::HDF5ColumnWriter::File::createDataset
+  (hid_t parent, std::string const& name, ColumnData const& data) const
+{
+  return std::visit([this, parent, &name](auto const& values){
+      using Value_t = typename std::decay_t<decltype(values)>::value_type;
+      return createDataset<Value_t>(parent, name);
+    }, data);
+} // recob::exporter::HDF5ColumnWriter::File::createDataset(ColumnData)
+
+
+Table& recob::exporter::HDF5ColumnWriter::File::createTable
+  (std::string const& name, TableColumns const& rows)
+{
+  Table table;
+  table.group = Handle{
+    checked(H5Gcreate2(file.id(), name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
+      "creating group", name),
+    H5Gclose
+    };
+  for (auto const& [ columnName, data ]: rows.columns()) {
+    if ((columnName == "event_offset") || (columnName == "event_count")) {
+      throw cet::exception("HDF5ColumnWriter")
+        << "Column name '" << columnName << "' of table '" << name
+        << "' is reserved for the event index.\n";
+    }
+    table.columns.emplace_back
+      (columnName, createDataset(table.group.id(), columnName, data));
+  } // for
+  table.offset = createDataset<std::uint64_t>(table.group.id(), "event_offset");
+  table.count = createDataset<std::uint64_t>(table.group.id(), "event_count");
+
+  // the events before this one had no rows in the table
+  std::vector<std::uint64_t> const none(nEvents, 0U);
+  table.offset.append(none.data(), none.size());
+  table.count.append(none.data(), none.size());
+
+  return tables.emplace(name, std::move(table)).first->second;
+} // recob::exporter::HDF5ColumnWriter::File::createTable()
+
+
+void recob::exporter::HDF5ColumnWriter::File::checkColumns
+  (std::string const& name, Table const& table, TableColumns const& rows)
+{
+  bool matching = (rows.nColumns() == table.columns.size());
+  for (auto const& [ columnName, data ]: rows.columns()) {
+    if (!matching) break;
+    matching = false;
+    for (auto const& [ tableColumnName, dataset ]: table.columns) {
+      if (tableColumnName != columnName) continue;
+      matching = (dataset.typeIndex == data.index());
+      break;
+    } // for table columns
+  } // for event columns
+  if (matching) return;
+
+  cet::exception e("HDF5ColumnWriter");
+  e << "The columns of table '" << name
+    << "' don't match the ones from its first event:";
+  for (auto const& column: table.columns) e << " '" << column.first << "'";
+  throw e << "\n";
+} // recob::exporter::HDF5ColumnWriter::File::checkColumns()
+
+
+void recob::exporter::HDF5ColumnWriter::File::write(EventColumns const& data) {
+
+  for (auto const& [ name, rows ]: data.tables()) {
+    std::size_t const nRows = rows.nRows();
+    auto iTable = tables.find(name);
+    Table& table = (iTable == tables.end())
+      ? createTable(name, rows): (checkColumns(name, iTable->second, rows), iTable->second);
+
+    // columns are written in the order of the table
+    for (auto& [ columnName, dataset ]: table.columns) {
+      for (auto const& [ rowsColumnName, values ]: rows.columns()) {
+        if (rowsColumnName != columnName) continue;
+        dataset.append(values);
+        break;
+      }
+    } // for columns
+    table.appendEventIndex(nRows);
+  } // for tables in the event
+
+  // tables not in this event get an empty entry
+  for (auto& [ name, table ]: tables) {
+    if (data.tables().count(name) == 0U) table.appendEventIndex(0U);
+  }
+
+  std::uint32_t const runNo = data.run();
+  std::uint32_t const subRunNo = data.subRun();
+  std::uint32_t const eventNo = data.event();
+  run.append(&runNo, 1U);
+  subRun.append(&subRunNo, 1U);
+  event.append(&eventNo, 1U);
+  ++nEvents;
+
+} // recob::exporter::HDF5ColumnWriter::File::write()
+
+
+//------------------------------------------------------------------------------
+//---  recob::exporter::TableColumns
+//---
+std::size_t recob::exporter::TableColumns::nRows() const {
+  if (fColumns.empty()) return 0U;
+  auto const size = [](ColumnData const& data)
+    { return std::visit([](auto const& values){ return values.size(); }, data); };
+  std::size_t const n = size(fColumns.front().second);
+  for (auto const& [ name, data ]: fColumns) {
+    if (size(data) == n) continue;
+    throw cet::exception("HDF5ColumnWriter")
+      << "Column '" << name << "' has " << size(data) << " rows, column '"
+      << fColumns.front().first << "' has " << n << ".\n";
+  }
+  return n;
+} // recob::exporter::TableColumns::nRows()
+
+
+void recob::exporter::details::throwColumnTypeMismatch(std::string const& name)
+{
+  throw cet::exception("HDF5ColumnWriter")
+    << "Column '" << name << "' already holds values of a different type.\n";
+} // recob::exporter::details::throwColumnTypeMismatch()
+
+
+//------------------------------------------------------------------------------
+//---  recob::exporter::HDF5ColumnWriter
+//---
+recob::exporter::HDF5ColumnWriter::HDF5ColumnWriter
+  (std::string const& fileName, Options const& options)
+  : fFileName(fileName)
+  , fOptions(options)
+  , fFile(std::make_unique<File>(fileName, options))
+{
+  // the thread is started last, when everything else is ready
+  fThread = std::thread(&HDF5ColumnWriter::writeLoop, this);
+} // recob::exporter::HDF5ColumnWriter::HDF5ColumnWriter()
+
+
+recob::exporter::HDF5ColumnWriter::HDF5ColumnWriter(std::string const& fileName)
+  : HDF5ColumnWriter(fileName, Options{})
+{}
+
+
+//------------------------------------------------------------------------------
+recob::exporter::HDF5ColumnWriter::~HDF5ColumnWriter() {
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fEventReady.notify_one();
+  fThread.join();
+  if (fError) {
+    try { std::rethrow_exception(fError); }
+    catch (std::exception const& e) {
+      mf::LogError("HDF5ColumnWriter")
+        << "Output file '" << fFileName << "' is incomplete: " << e.what();
+    }
+    catch (...) {
+      mf::LogError("HDF5ColumnWriter")
+        << "Output file '" << fFileName << "' is incomplete.";
+    }
+  }
+  fFile.reset(); // closes the file
+} // recob::exporter::HDF5ColumnWriter::~HDF5ColumnWriter()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::HDF5ColumnWriter::write(EventColumns&& event) {
+  std::unique_lock<std::mutex> lock(fMutex);
+  std::size_t const maxQueued = std::max<std::size_t>(fOptions.maxQueuedEvents, 1U);
+  fWritten.wait
+    (lock, [this, maxQueued](){ return fError || (fQueue.size() < maxQueued); });
+  rethrowError();
+  fQueue.push_back(std::move(event));
+  fEventReady.notify_one();
+} // recob::exporter::HDF5ColumnWriter::write()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::HDF5ColumnWriter::flush() {
+  std::unique_lock<std::mutex> lock(fMutex);
+  fWritten.wait(lock, [this](){ return fError || (fQueue.empty() && !fWriting); });
+  rethrowError();
+  // the writing thread is idle and can't resume while we hold the lock
+  checked(H5Fflush(fFile->file.id(), H5F_SCOPE_LOCAL), "flushing the output file");
+} // recob::exporter::HDF5ColumnWriter::flush()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::HDF5ColumnWriter::rethrowError() {
+  if (fError) std::rethrow_exception(fError);
+} // recob::exporter::HDF5ColumnWriter::rethrowError()
+
+
+//------------------------------------------------------------------------------
+void recob::exporter::HDF5ColumnWriter::writeLoop() {
+
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (true) {
+    fEventReady.wait(lock, [this](){ return fStop || !fQueue.empty(); });
+    if (fQueue.empty()) break; // stop requested, and nothing left to write
+
+    EventColumns const event = std::move(fQueue.front());
+    fQueue.pop_front();
+    fWriting = true;
+
+    // the writing happens without holding the lock
+    lock.unlock();
+    std::exception_ptr error;
+    try { fFile->write(event); }
+    catch (...) { error = std::current_exception(); }
+    lock.lock();
+
+    fWriting = false;
+    if (error) {
+      // after an error the file is not consistent any more: stop writing
+      fError = error;
+      fQueue.clear();
+      fWritten.notify_all();
+      break;
+    }
+    fWritten.notify_all();
+  } // while
+
+} // recob::exporter::HDF5ColumnWriter::writeLoop()
+
+
+//------------------------------------------------------------------------------
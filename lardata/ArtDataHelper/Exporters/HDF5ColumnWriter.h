@@ -0,0 +1,251 @@
+/**
+ * @file   HDF5ColumnWriter.h
+ * @brief  Columnar output of data products into HDF5 files
+ * @date   October 14, 2026
+ * @see    HDF5ColumnWriter.cc ExportHDF5_module.cc
+ *
+ * The content of the data products is written as tables of columns, one
+ * HDF5 group per table and one one-dimensional dataset per column, so that
+ * the training of machine learning models can read them in large blocks
+ * (`h5py`, `pandas`, ...) without the framework.
+ * The layout of the file is:
+ *
+ *  * `/events/run`, `/events/subrun`, `/events/event` (32-bit unsigned
+ *    integers): the ID of each of the events written, in order
+ *  * for each table, `/<table>/<column>`: the values of that column for all
+ *    the rows of all the events, one after the other
+ *  * for each table, `/<table>/event_offset` and `/<table>/event_count`
+ *    (64-bit unsigned integers): for each event in `/events`, the index of
+ *    the first row of that event in the columns of the table, and the number
+ *    of its rows (`0` for the events where the table was not filled)
+ *
+ * All the datasets are chunked, extensible and (optionally) compressed.
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_EXPORTERS_HDF5COLUMNWRITER_H
+#define LARDATA_ARTDATAHELPER_EXPORTERS_HDF5COLUMNWRITER_H 1
+
+// C/C++ standard libraries
+#include <condition_variable>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <map>
+#include <memory> // std::unique_ptr<>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility> // std::pair<>
+#include <variant>
+#include <vector>
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstddef> // std::size_t
+
+
+namespace recob {
+  namespace exporter {
+
+    /// Values of one column of a table; the supported types of the values
+    using ColumnData = std::variant<
+      std::vector<float>,
+      std::vector<double>,
+      std::vector<std::int32_t>,
+      std::vector<std::uint32_t>,
+      std::vector<std::uint64_t>
+      >;
+
+
+    /**
+     * @brief Rows of one table from a single event
+     *
+     * Columns are created on their first access, and they keep that order;
+     * the references to the columns stay valid when new columns are added.
+     * All the columns of a table must have the same number of rows when the
+     * table is written.
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * recob::exporter::TableColumns& hits = event.table("hits");
+     * auto& channel = hits.column<std::uint32_t>("channel");
+     * auto& peakTime = hits.column<float>("peak_time");
+     * for (recob::Hit const& hit: *hitHandle) {
+     *   channel.push_back(hit.Channel());
+     *   peakTime.push_back(hit.PeakTime());
+     * }
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    class TableColumns {
+        public:
+
+      /// Returns the values of the named column, creating it if needed
+      /// @throw cet::exception (category `"HDF5ColumnWriter"`) if the column
+      ///        already exists with values of a different type
+      template <typename T>
+      std::vector<T>& column(std::string const& name);
+
+      /// Returns the number of columns
+      std::size_t nColumns() const { return fColumns.size(); }
+
+      /// Returns the number of rows (`0` if no columns)
+      /// @throw cet::exception (category `"HDF5ColumnWriter"`) if the columns
+      ///        don't have all the same number of rows
+      std::size_t nRows() const;
+
+      /// Returns all the columns, with their names, in order of creation
+      std::deque<std::pair<std::string, ColumnData>> const& columns() const
+        { return fColumns; }
+
+        private:
+      std::deque<std::pair<std::string, ColumnData>> fColumns;
+
+    }; // class TableColumns
+
+
+    /// The content of all the tables from a single event
+    class EventColumns {
+        public:
+
+      /// Constructor: data of the specified event
+      EventColumns
+        (std::uint32_t run, std::uint32_t subRun, std::uint32_t event)
+        : fRun(run), fSubRun(subRun), fEvent(event)
+        {}
+
+      /// Returns the rows of the named table, creating it if needed
+      TableColumns& table(std::string const& name) { return fTables[name]; }
+
+      /// Returns all the tables, by name
+      std::map<std::string, TableColumns> const& tables() const
+        { return fTables; }
+
+      std::uint32_t run() const { return fRun; }
+      std::uint32_t subRun() const { return fSubRun; }
+      std::uint32_t event() const { return fEvent; }
+
+        private:
+      std::uint32_t fRun, fSubRun, fEvent; ///< event ID
+      std::map<std::string, TableColumns> fTables; ///< tables, by name
+
+    }; // class EventColumns
+
+
+    /**
+     * @brief Writes tables of columns into a HDF5 file, in a separate thread
+     *
+     * The events are queued by `write()` and written into the file by a
+     * background thread, so that the event loop does not wait for the
+     * compression and the writing to disk. At most `maxQueuedEvents` events
+     * wait in the queue: when it is full, `write()` waits until there is
+     * space, which limits the memory used when the disk is slower than the
+     * event processing.
+     *
+     * The columns of a table are defined by the first event containing the
+     * table: the following events must have the same columns, with the same
+     * types (in any order). New tables may appear in any event.
+     *
+     * Errors in the writing thread stop the writing, and they are thrown
+     * from the next call to `write()` or `flush()`.
+     * Only the writing thread uses the HDF5 library while the file is open:
+     * HDF5 builds without thread safety are fine, as long as no other code
+     * in the job uses the library at the same time.
+     */
+    class HDF5ColumnWriter {
+        public:
+
+      /// Parameters of the datasets and of the queue
+      struct Options {
+        /// number of rows in a chunk of each dataset
+        std::size_t chunkRows = 65536U;
+
+        /// `deflate` compression level (`0` to `9`; `0` disables compression)
+        unsigned int compressionLevel = 4U;
+
+        /// whether to apply the byte shuffle filter before the compression
+        bool shuffle = true;
+
+        /// maximum number of events waiting to be written
+        std::size_t maxQueuedEvents = 8U;
+      }; // struct Options
+
+
+      /**
+       * @brief Constructor: creates the file and starts the writing thread
+       * @param fileName name of the output file (overwritten if existing)
+       * @param options parameters of the datasets and of the queue
+       * @throw cet::exception (category `"HDF5ColumnWriter"`) if the file
+       *        can't be created
+       */
+      HDF5ColumnWriter(std::string const& fileName, Options const& options);
+
+      /// Constructor: creates the file with the default `Options`
+      HDF5ColumnWriter(std::string const& fileName);
+
+      /// Destructor: writes all the queued events, and closes the file
+      ~HDF5ColumnWriter();
+
+      HDF5ColumnWriter(HDF5ColumnWriter const&) = delete;
+      HDF5ColumnWriter& operator= (HDF5ColumnWriter const&) = delete;
+
+      /// Queues the content of an event for writing
+      /// @throw cet::exception (category `"HDF5ColumnWriter"`) on errors
+      ///        writing the previous events
+      void write(EventColumns&& event);
+
+      /// Writes all the queued events, and waits until they are written
+      /// @throw cet::exception (category `"HDF5ColumnWriter"`) on errors
+      void flush();
+
+      /// Returns the name of the output file
+      std::string const& fileName() const { return fFileName; }
+
+        private:
+      struct File; ///< the open file and its datasets (HDF5 details)
+
+      std::string const fFileName; ///< name of the output file
+      Options const fOptions; ///< parameters of output and queue
+      std::unique_ptr<File> fFile; ///< the output file
+
+      std::mutex fMutex; ///< lock for all the following data
+      std::condition_variable fEventReady; ///< signals events to be written
+      std::condition_variable fWritten; ///< signals events have been written
+      std::deque<EventColumns> fQueue; ///< events to be written
+      bool fWriting = false; ///< whether the thread is writing an event now
+      bool fStop = false; ///< whether the writing thread should stop
+      std::exception_ptr fError; ///< error from the writing thread, if any
+
+      std::thread fThread; ///< the writing thread
+
+      /// Body of the writing thread
+      void writeLoop();
+
+      /// Throws the error of the writing thread, if any (mutex must be locked)
+      void rethrowError();
+
+    }; // class HDF5ColumnWriter
+
+
+  } // namespace exporter
+} // namespace recob
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+namespace recob::exporter::details {
+
+  [[noreturn]] void throwColumnTypeMismatch(std::string const& name);
+
+} // namespace recob::exporter::details
+
+
+template <typename T>
+std::vector<T>& recob::exporter::TableColumns::column(std::string const& name)
+{
+  for (auto& [ columnName, data ]: fColumns) {
+    if (columnName != name) continue;
+    if (auto* values = std::get_if<std::vector<T>>(&data)) return *values;
+    details::throwColumnTypeMismatch(name);
+  } // for
+  fColumns.emplace_back(name, std::vector<T>{});
+  return std::get<std::vector<T>>(fColumns.back().second);
+} // recob::exporter::TableColumns::column()
+
+
+#endif // LARDATA_ARTDATAHELPER_EXPORTERS_HDF5COLUMNWRITER_H
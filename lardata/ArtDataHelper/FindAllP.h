@@ -13,9 +13,8 @@
 
 // C/C++ standard libraries
 #include <climits> // CHAR_BIT
-#include <stdexcept> // std::out_of_range
 #include <vector>
-#include <unordered_map>
+#include <utility> // std::move()
 #include <functional> // std::hash<>
 
 
@@ -28,6 +27,10 @@
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "art/Framework/Principal/Event.h"
 
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 /// LArSoft-specific namespace
 namespace lar {
 
@@ -60,6 +63,11 @@ namespace lar {
        * which Dest object is associated to this specific Src object?
        * The cache is structured so that only one Dest object is known for each
        * Src.
+       *
+       * The cache is a flat list of product IDs, each with a dense array of
+       * destination pointers indexed by the key of the source object.
+       * Events typically have only a handful of source products, and a linear
+       * search in the list is faster than hashing.
        */
       template <typename Source, typename Dest>
       class UniqueAssociationCache {
@@ -73,14 +81,16 @@ namespace lar {
         /// type for a cache of dest products for a given source product ID
         using InProductCache_t = std::vector<DestPtr_t>;
 
-        /// type of hash functor for the cache
-        using Hash_t = details::hash<art::ProductID>;
+        /// type for the cache of a single source product
+        struct ProductCache_t {
+          art::ProductID id; ///< ID of the source product
+          InProductCache_t dests; ///< dest pointers, by source key
+        }; // struct ProductCache_t
 
-        /// type for the complete cache, keyed by source product ID
-        using Cache_t
-          = std::unordered_map<art::ProductID, InProductCache_t, Hash_t>;
+        /// type for the complete cache, one entry per source product ID
+        using Cache_t = std::vector<ProductCache_t>;
 
-        Cache_t AssnCache; ///< association cache, keyed by product ID and index
+        Cache_t AssnCache; ///< association cache, by product ID and index
 
 
         /// Constructor: an empty cache
@@ -91,8 +101,22 @@ namespace lar {
          * @param src art pointer to the object we want the association of
          * @return the requested element, or a null pointer if not found
          */
-        DestPtr_t operator[] (SourcePtr_t const& src) const
-          { return AssnCache[src.id()][src.key()]; }
+        DestPtr_t operator[] (SourcePtr_t const& src) const;
+
+        /// Returns the cache of the specified product (nullptr if none)
+        InProductCache_t const* find(art::ProductID const& id) const;
+
+        /// Returns the cache of the specified product, creating it if needed
+        InProductCache_t& get(art::ProductID const& id);
+
+        /**
+         * @brief Moves all the content of another cache into this one
+         * @param other the cache to be merged
+         * @return the number of associations merged
+         * @throw art::Exception if the two caches associate the same source
+         *   object to different dest objects
+         */
+        unsigned int Merge(UniqueAssociationCache&& other);
 
         /// Empties the cache
         void clear() { AssnCache.clear(); }
@@ -135,7 +159,7 @@ namespace lar {
          * @param src a art pointer to the source object
          * @return a pointer to the associated object, or a null pointer if none
          */
-        art::Ptr<Dest_t> const& operator[] (art::Ptr<Dest_t> const& src) const;
+        art::Ptr<Dest_t> const& operator[] (art::Ptr<Source_t> const& src) const;
 
 
         /// Returns whether there are associations from objects in product id
@@ -148,8 +172,25 @@ namespace lar {
          * @brief Reads all the associations from the event
          * @throw art::Exception if multiple dest objects are found for one
          *   source object
+         * @see Prefetch()
+         */
+        unsigned int Read(art::Event& event) { return Prefetch(event); }
+
+        /**
+         * @brief Reads and indexes all the associations from the event
+         * @param event the event to read the associations from
+         * @return the number of associations read
+         * @throw art::Exception if multiple dest objects are found for one
+         *   source object
+         *
+         * All the association data products between the source and destination
+         * types are read, and each of them is indexed in a separate task
+         * (using TBB); the results are then merged into the cache.
+         * Calling this from the beginning of the event processing moves all
+         * the cost of filling the cache away from the first query.
+         * The existing associations already in cache are not removed.
          */
-        unsigned int Read(art::Event& event);
+        unsigned int Prefetch(art::Event& event);
 
         /**
          * @brief Reads the specified association from the event
@@ -190,7 +231,16 @@ namespace lar {
         Cache_t cache; ///< set of associations, keyed by product ID and key
 
         /// Adds all associations in the specified handle; returns their number
-        unsigned int Merge(art::Handle<Assns_t>& handle);
+        unsigned int Merge(art::Handle<Assns_t>& handle)
+          { return Index(handle, cache); }
+
+        /// Adds all associations in the handle to a cache; returns their number
+        static unsigned int Index
+          (art::Handle<Assns_t> const& handle, Cache_t& cache);
+
+          private:
+        static art::Ptr<Dest_t> const NoDest; ///< returned for missing matches
+
       }; // class FindAllP<>
 
 
@@ -222,27 +272,98 @@ namespace lar {
 namespace lar {
   namespace util {
     namespace details {
+      //------------------------------------------------------------------------
+      //---  UniqueAssociationCache
+
+      template <typename Source, typename Dest>
+      auto UniqueAssociationCache<Source, Dest>::operator[]
+        (SourcePtr_t const& src) const -> DestPtr_t
+      {
+        InProductCache_t const* dests = find(src.id());
+        if (!dests || (src.key() >= dests->size())) return {};
+        return (*dests)[src.key()];
+      } // UniqueAssociationCache<>::operator[]
+
+
+      template <typename Source, typename Dest>
+      auto UniqueAssociationCache<Source, Dest>::find
+        (art::ProductID const& id) const -> InProductCache_t const*
+      {
+        for (ProductCache_t const& product: AssnCache)
+          if (product.id == id) return &(product.dests);
+        return nullptr;
+      } // UniqueAssociationCache<>::find()
+
+
+      template <typename Source, typename Dest>
+      auto UniqueAssociationCache<Source, Dest>::get
+        (art::ProductID const& id) -> InProductCache_t&
+      {
+        for (ProductCache_t& product: AssnCache)
+          if (product.id == id) return product.dests;
+        AssnCache.push_back({ id, {} });
+        return AssnCache.back().dests;
+      } // UniqueAssociationCache<>::get()
+
+
+      template <typename Source, typename Dest>
+      unsigned int UniqueAssociationCache<Source, Dest>::Merge
+        (UniqueAssociationCache&& other)
+      {
+        unsigned int count = 0;
+        for (ProductCache_t& product: other.AssnCache) {
+          InProductCache_t& dests = get(product.id);
+
+          // if the list is empty, we have just created it: take the other
+          if (dests.empty()) {
+            for (DestPtr_t const& dest: product.dests)
+              if (dest.isNonnull()) ++count;
+            dests = std::move(product.dests);
+            continue;
+          }
+
+          if (dests.size() < product.dests.size())
+            ResizeToPower2(dests, product.dests.size());
+          for (size_t key = 0; key < product.dests.size(); ++key) {
+            DestPtr_t& dest = product.dests[key];
+            if (dest.isNull()) continue;
+            DestPtr_t& dest_cell = dests[key];
+            if (dest_cell.isNonnull() && (dest_cell != dest)) {
+              throw art::Exception(art::errors::InvalidNumber)
+                << "Object with key " << key << " in product " << product.id
+                << " is associated with at least two objects: "
+                << dest << " and " << dest_cell;
+            }
+            dest_cell = std::move(dest);
+            ++count;
+          } // for keys
+        } // for products
+        other.clear();
+        return count;
+      } // UniqueAssociationCache<>::Merge()
+
+
       //------------------------------------------------------------------------
       //---  FindAllP
 
+      template <typename Source, typename Dest>
+      art::Ptr<Dest> const FindAllP<Source, Dest>::NoDest;
+
+
       template <typename Source, typename Dest>
       auto FindAllP<Source, Dest>::operator[]
-        (art::Ptr<Dest_t> const& src) const -> art::Ptr<Dest_t> const&
+        (art::Ptr<Source_t> const& src) const -> art::Ptr<Dest_t> const&
       {
-        // we expect a missing match to be exceptional
-        try {
-          return cache.AssnCache.at(src.id()).at(src.key());
-        }
-        catch (std::out_of_range) {
-          return {};
-        }
+        auto const* dests = cache.find(src.id());
+        if (!dests || (src.key() >= dests->size())) return NoDest;
+        return (*dests)[src.key()];
       } // FindAllP<>::operator[]
 
 
       template <typename Source, typename Dest>
       inline bool FindAllP<Source, Dest>::hasProduct
         (art::ProductID const& id) const
-        { return cache.AssnCache.count(id) > 0; }
+        { return cache.find(id) != nullptr; }
 
 
       template <typename Source, typename Dest>
@@ -252,7 +373,7 @@ namespace lar {
 
 
       template <typename Source, typename Dest>
-      unsigned int FindAllP<Source, Dest>::Read
+      unsigned int FindAllP<Source, Dest>::Prefetch
         (art::Event& event)
       {
 
@@ -260,19 +381,28 @@ namespace lar {
         std::vector<art::Handle<Assns_t>> assns_list;
         event.getManyByType(assns_list);
 
-        MF_LOG_DEBUG("FindAllP") << "Read(): read " << assns_list.size()
+        MF_LOG_DEBUG("FindAllP") << "Prefetch(): read " << assns_list.size()
           << " association sets";
 
+        // index each association in its own cache, concurrently...
+        std::vector<Cache_t> partial(assns_list.size());
+        tbb::parallel_for(
+          tbb::blocked_range<size_t>(0, assns_list.size(), 1),
+          [&](tbb::blocked_range<size_t> const& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+              Index(assns_list[i], partial[i]);
+          });
+
+        // ... then merge them, in the order they were read
         unsigned int count = 0;
-        // parse all the associations, and translate them into a local cache
-        for (art::Handle<Assns_t> handle: assns_list)
-          count += Merge(handle);
+        for (Cache_t& assns_cache: partial)
+          count += cache.Merge(std::move(assns_cache));
 
         MF_LOG_DEBUG("FindAllP") << "Read " << count << " associations for "
           << cache.NProductIDs() << " product IDs";
 
         return count;
-      } // FindAllP::Read(Event)
+      } // FindAllP::Prefetch(Event)
 
 
 
@@ -303,16 +433,16 @@ namespace lar {
 
 
       template <typename Source, typename Dest>
-      unsigned int FindAllP<Source, Dest>::Merge
-        (art::Handle<Assns_t>& handle)
+      unsigned int FindAllP<Source, Dest>::Index
+        (art::Handle<Assns_t> const& handle, Cache_t& cache)
       {
         // product ID of the last source object; initialized invalid
         art::ProductID LastProductID = art::Ptr<Source_t>().id();
-        typename Cache_t::InProductCache_t const* AssnsList = nullptr;
+        typename Cache_t::InProductCache_t* AssnsList = nullptr;
 
         unsigned int count = 0;
 
-        MF_LOG_DEBUG("FindAllP") << "Merge(): importing " << handle->size()
+        MF_LOG_DEBUG("FindAllP") << "Index(): importing " << handle->size()
           << " associations from " << handle.provenance();
 
         for (auto const& assn: *handle) {
@@ -331,7 +461,7 @@ namespace lar {
           // update the running pointers
           if (src.id() != LastProductID) {
             LastProductID = src.id();
-            AssnsList = &(cache.AssnCache[LastProductID]);
+            AssnsList = &(cache.get(LastProductID));
 
             // if the list is empty, it means we have just created it!
             if (AssnsList->empty()) {
@@ -362,7 +492,7 @@ namespace lar {
         MF_LOG_DEBUG("FindAllP")
           << "Merged " << count << " associations from " << handle.provenance();
         return count;
-      } // FindAllP::Merge()
+      } // FindAllP::Index()
 
 
 
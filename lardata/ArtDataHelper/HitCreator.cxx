@@ -12,8 +12,10 @@
 
 // C/C++ standard library
 #include <utility> // std::move()
-#include <algorithm> // std::accumulate(), std::max()
-#include <limits> // std::numeric_limits<>
+#include <algorithm> // std::max(), std::find()
+#include <numeric> // std::accumulate()
+#include <functional> // std::mem_fn()
+#include <cmath> // std::ceil()
 #include <cassert>
 
 // art libraries
@@ -23,14 +25,27 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 
 // LArSoft libraries
+#include "lardata/Utilities/AllocationAccounting.h"
+#include "lardata/Utilities/Instrumentation.h"
 #include "larcore/Geometry/Geometry.h"
 #include "lardataobj/RecoBase/Wire.h"
 #include "lardataobj/RecoBase/Hit.h"
-#include "lardata/Utilities/MakeIndex.h"
 
 
 namespace {
 
+  /// Tag of the allocations of the hit collections
+  struct HitCollectionAllocationTag
+    { static constexpr char const* Name = "HitCollectionCreator"; };
+
+  /// Timer of the transfer of hits and associations into the event
+  struct HitCollectionPutTimer
+    { static constexpr char const* Name = "HitCollectionCreator::put_into"; };
+
+  /// Counter of the hits put into the event
+  struct HitCollectionHitsCounter
+    { static constexpr char const* Name = "HitCollectionCreator hits"; };
+
   /// Erases the content of an association
   template <typename Left, typename Right, typename Metadata>
   void ClearAssociations(art::Assns<Left, Right, Metadata>& assns) {
@@ -38,12 +53,57 @@ namespace {
     assns.swap(empty);
   } // ClearAssociations()
 
+
+  /// Pointers to the wire and to the raw digits of a channel.
+  struct ChannelDataPtrs {
+    art::Ptr<recob::Wire> wire; ///< Wire on the channel (null if none).
+    art::Ptr<raw::RawDigit> digits; ///< Digits on the channel (null if none).
+  }; // struct ChannelDataPtrs
+
+  /// Pointers to wire and raw digits, indexed by channel number.
+  using ChannelLookupTable_t = std::vector<ChannelDataPtrs>;
+
+
+  /// Makes `table` large enough for all the channels of the data in `coll`.
+  template <typename Coll, typename GetChannel>
+  void resizeToChannels
+    (ChannelLookupTable_t& table, Coll const& coll, GetChannel getChannel)
+  {
+    size_t nChannels = table.size();
+    for (auto const& data: coll)
+      nChannels = std::max(nChannels, size_t(getChannel(data)) + 1);
+    table.resize(nChannels);
+  } // resizeToChannels()
+
 } // local namespace
 
 
 /// Reconstruction base classes
 namespace recob {
 
+  //****************************************************************************
+  //***  ROISummedADC
+  //----------------------------------------------------------------------
+  ROISummedADC::ROISummedADC(RegionOfInterest_t const& roi)
+    : fBegin(roi.begin_index())
+  {
+    fSums.reserve(roi.size() + 1);
+    double sum = 0.0;
+    for (auto const adc: roi) fSums.push_back(sum += adc);
+  } // ROISummedADC::ROISummedADC()
+
+
+  //----------------------------------------------------------------------
+  double ROISummedADC::sum
+    (raw::TDCtick_t start_tick, raw::TDCtick_t end_tick) const
+  {
+    raw::TDCtick_t const first = std::max(start_tick, begin_tick());
+    raw::TDCtick_t const last = std::min(end_tick, this->end_tick());
+    if (first >= last) return 0.0;
+    return fSums[last - fBegin] - fSums[first - fBegin];
+  } // ROISummedADC::sum()
+
+
   //****************************************************************************
   //***  HitCreator
   //----------------------------------------------------------------------
@@ -163,6 +223,36 @@ namespace recob {
   {} // HitCreator::HitCreator(Wire; no summed ADC)
 
 
+  //----------------------------------------------------------------------
+  HitCreator::HitCreator(
+    recob::Wire const&   wire,
+    geo::WireID const&   wireID,
+    raw::TDCtick_t       start_tick,
+    raw::TDCtick_t       end_tick,
+    float                rms,
+    float                peak_time,
+    float                sigma_peak_time,
+    float                peak_amplitude,
+    float                sigma_peak_amplitude,
+    float                hit_integral,
+    float                hit_sigma_integral,
+    ROISummedADC const&  roiSums,
+    short int            multiplicity,
+    short int            local_index,
+    float                goodness_of_fit,
+    int                  dof
+    ):
+    HitCreator(
+      wire, wireID, start_tick, end_tick,
+      rms, peak_time, sigma_peak_time, peak_amplitude, sigma_peak_amplitude,
+      hit_integral, hit_sigma_integral,
+      roiSums.sum(start_tick, end_tick),
+      multiplicity, local_index,
+      goodness_of_fit, dof
+      )
+  {} // HitCreator::HitCreator(Wire; ROI sums)
+
+
   //----------------------------------------------------------------------
   HitCreator::HitCreator(
     recob::Wire const&        wire,
@@ -227,6 +317,31 @@ namespace recob {
 
 
 
+  //****************************************************************************
+  //***  HitCollectionSizeEstimator
+  //----------------------------------------------------------------------
+  void HitCollectionSizeEstimator::record(size_t nHits) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fAverage = (fNEvents == 0)
+      ? double(nHits): (fAverage + fWeight * (double(nHits) - fAverage));
+    ++fNEvents;
+  } // HitCollectionSizeEstimator::record()
+
+
+  //----------------------------------------------------------------------
+  size_t HitCollectionSizeEstimator::expected() const {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return static_cast<size_t>(std::ceil(fAverage * fMargin));
+  } // HitCollectionSizeEstimator::expected()
+
+
+  //----------------------------------------------------------------------
+  size_t HitCollectionSizeEstimator::nEvents() const {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fNEvents;
+  } // HitCollectionSizeEstimator::nEvents()
+
+
   //****************************************************************************
   //***  HitAndAssociationsWriterBase
   //----------------------------------------------------------------------
@@ -244,6 +359,21 @@ namespace recob {
     , hitPtrMaker(*(this->event), prod_instance)
   {} // HitAndAssociationsWriterBase::HitAndAssociationsWriterBase()
 
+  //----------------------------------------------------------------------
+  HitAndAssociationsWriterBase::HitAndAssociationsWriterBase(
+    util::PtrMakerRegistry& ptrMakers,
+    std::string instance_name, bool doWireAssns, bool doRawDigitAssns
+    )
+    : prod_instance(instance_name)
+    , hits()
+    , WireAssns
+      (doWireAssns? new art::Assns<recob::Wire, recob::Hit>: nullptr)
+    , RawDigitAssns
+      (doRawDigitAssns? new art::Assns<raw::RawDigit, recob::Hit>: nullptr)
+    , event(&ptrMakers.event())
+    , hitPtrMaker(ptrMakers.maker<recob::Hit>(prod_instance))
+  {} // HitAndAssociationsWriterBase::HitAndAssociationsWriterBase(registry)
+
   //------------------------------------------------------------------------------
   void HitAndAssociationsWriterBase::declare_products(
     art::ProducesCollector& collector,
@@ -263,10 +393,44 @@ namespace recob {
     }
   } // HitAndAssociationsWriterBase::declare_products()
 
+  //------------------------------------------------------------------------------
+  void HitAndAssociationsWriterBase::useSizeEstimator
+    (std::shared_ptr<HitCollectionSizeEstimator> estimator)
+  {
+    sizeEstimator = std::move(estimator);
+    if (sizeEstimator && hits) {
+      std::size_t const oldCapacity = hits->capacity();
+      hits->reserve(sizeEstimator->expected());
+      recordHitCapacity(oldCapacity);
+    }
+  } // HitAndAssociationsWriterBase::useSizeEstimator()
+
+  //------------------------------------------------------------------------------
+  void HitAndAssociationsWriterBase::recordHitCapacity
+    (std::size_t oldCapacity) const
+  {
+    std::size_t const newCapacity = hits? hits->capacity(): 0U;
+    hitMemory.set(newCapacity * sizeof(recob::Hit));
+    if constexpr (lar::AllocationAccounting::Enabled) {
+      if (newCapacity == oldCapacity) return;
+      using Accounting_t = lar::AllocationAccounting;
+      if (oldCapacity > 0U) {
+        Accounting_t::recordDeallocation<HitCollectionAllocationTag>
+          (oldCapacity * sizeof(recob::Hit));
+      }
+      Accounting_t::recordAllocation<HitCollectionAllocationTag>
+        (newCapacity * sizeof(recob::Hit));
+    }
+  } // HitAndAssociationsWriterBase::recordHitCapacity()
+
   //------------------------------------------------------------------------------
   void HitAndAssociationsWriterBase::put_into() {
     assert(event);
+    lar::ScopedTimer<HitCollectionPutTimer> const timer;
+    if (hits) lar::Instrumentation::count<HitCollectionHitsCounter>(hits->size());
+    if (sizeEstimator && hits) sizeEstimator->record(hits->size());
     if (hits) event->put(std::move(hits), prod_instance);
+    hitMemory.release(); // the hits belong to the event now
     if (WireAssns) event->put(std::move(WireAssns), prod_instance);
     if (RawDigitAssns) event->put(std::move(RawDigitAssns), prod_instance);
   } // HitAndAssociationsWriterBase::put_into()
@@ -286,6 +450,18 @@ namespace recob {
     hits.reset(new std::vector<recob::Hit>);
   } // HitCollectionCreator::HitCollectionCreator()
 
+  //----------------------------------------------------------------------
+  HitCollectionCreator::HitCollectionCreator(
+    util::PtrMakerRegistry& ptrMakers,
+    std::string instance_name /* = "" */,
+    bool doWireAssns /* = true */, bool doRawDigitAssns /* = true */
+    )
+    : HitAndAssociationsWriterBase
+      (ptrMakers, instance_name, doWireAssns, doRawDigitAssns)
+  {
+    hits.reset(new std::vector<recob::Hit>);
+  } // HitCollectionCreator::HitCollectionCreator(registry)
+
   //----------------------------------------------------------------------
   void HitCollectionCreator::emplace_back(
     recob::Hit&& hit,
@@ -293,7 +469,9 @@ namespace recob {
   ) {
 
     // add the hit to the collection
+    std::size_t const oldCapacity = hits->capacity();
     hits->emplace_back(std::move(hit));
+    recordHitCapacity(oldCapacity);
 
     CreateAssociationsToLastHit(wire, digits);
   } // HitCollectionCreator::emplace_back(Hit&&)
@@ -306,7 +484,9 @@ namespace recob {
   ) {
 
     // add the hit to the collection
+    std::size_t const oldCapacity = hits->capacity();
     hits->push_back(hit);
+    recordHitCapacity(oldCapacity);
 
     CreateAssociationsToLastHit(wire, digits);
   } // HitCollectionCreator::emplace_back(Hit)
@@ -344,6 +524,242 @@ namespace recob {
   } // HitCollectionCreator::CreateAssociationsToLastHit()
 
 
+  //****************************************************************************
+  //***  ShardedHitCollectionCreator
+  //----------------------------------------------------------------------
+  void ShardedHitCollectionCreator::Shard::emplace_back(
+    recob::Hit&& hit,
+    art::Ptr<recob::Wire> const& wire, art::Ptr<raw::RawDigit> const& digits
+  ) {
+    hits.emplace_back(std::move(hit));
+    if (doWireAssns) wires.push_back(wire);
+    if (doRawDigitAssns) this->digits.push_back(digits);
+  } // ShardedHitCollectionCreator::Shard::emplace_back()
+
+
+  //----------------------------------------------------------------------
+  void ShardedHitCollectionCreator::Shard::reserve(size_t new_size) {
+    hits.reserve(new_size);
+    if (doWireAssns) wires.reserve(new_size);
+    if (doRawDigitAssns) digits.reserve(new_size);
+  } // ShardedHitCollectionCreator::Shard::reserve()
+
+
+  //----------------------------------------------------------------------
+  ShardedHitCollectionCreator::ShardedHitCollectionCreator(
+    art::Event& event,
+    std::string instance_name /* = "" */,
+    bool doWireAssns /* = true */, bool doRawDigitAssns /* = true */,
+    size_t nShards /* = 1 */
+    )
+    : HitAndAssociationsWriterBase
+      (event, instance_name, doWireAssns, doRawDigitAssns)
+  {
+    hits.reset(new std::vector<recob::Hit>);
+    setNShards(nShards);
+  } // ShardedHitCollectionCreator::ShardedHitCollectionCreator()
+
+
+  //----------------------------------------------------------------------
+  void ShardedHitCollectionCreator::setNShards(size_t nShards) {
+    shards.resize(nShards, Shard(bool(WireAssns), bool(RawDigitAssns)));
+  } // ShardedHitCollectionCreator::setNShards()
+
+
+  //----------------------------------------------------------------------
+  size_t ShardedHitCollectionCreator::size() const {
+    size_t n = 0;
+    for (Shard const& shard: shards) n += shard.size();
+    return n;
+  } // ShardedHitCollectionCreator::size()
+
+
+  //----------------------------------------------------------------------
+  void ShardedHitCollectionCreator::put_into() {
+    if (!hits) {
+      throw art::Exception(art::errors::LogicError)
+        << "ShardedHitCollectionCreator is trying to put into the event"
+        " a hit collection that was never created!\n";
+    }
+    merge_shards();
+    HitAndAssociationsWriterBase::put_into();
+  } // ShardedHitCollectionCreator::put_into()
+
+
+  //----------------------------------------------------------------------
+  void ShardedHitCollectionCreator::merge_shards() {
+
+    // position of each hit: (shard, index in shard); sorted by channel, with
+    // a stable sort so that the shard order breaks the ties
+    std::vector<std::pair<size_t, size_t>> order;
+    order.reserve(size());
+    for (size_t iShard = 0; iShard < shards.size(); ++iShard) {
+      for (size_t iHit = 0; iHit < shards[iShard].size(); ++iHit)
+        order.emplace_back(iShard, iHit);
+    } // for shards
+
+    auto channelOf = [this](std::pair<size_t, size_t> const& pos)
+      { return shards[pos.first].hits[pos.second].Channel(); };
+    std::stable_sort(order.begin(), order.end(),
+      [&channelOf](auto const& a, auto const& b)
+        { return channelOf(a) < channelOf(b); }
+      );
+
+    std::size_t const oldCapacity = hits->capacity();
+    hits->reserve(hits->size() + order.size());
+    recordHitCapacity(oldCapacity);
+    for (auto const& pos: order) {
+      Shard& shard = shards[pos.first];
+      hits->emplace_back(std::move(shard.hits[pos.second]));
+
+      if (!WireAssns && !RawDigitAssns) continue;
+
+      HitPtr_t const hit_ptr = CreatePtr(hits->size() - 1);
+
+      art::Ptr<recob::Wire> const& wire
+        = WireAssns? shard.wires[pos.second]: art::Ptr<recob::Wire>();
+      if (wire.isNonnull()) WireAssns->addSingle(wire, hit_ptr);
+
+      art::Ptr<raw::RawDigit> const& digits
+        = RawDigitAssns? shard.digits[pos.second]: art::Ptr<raw::RawDigit>();
+      if (digits.isNonnull()) RawDigitAssns->addSingle(digits, hit_ptr);
+
+    } // for
+
+    for (Shard& shard: shards) {
+      shard.hits.clear();
+      shard.wires.clear();
+      shard.digits.clear();
+    } // for
+
+  } // ShardedHitCollectionCreator::merge_shards()
+
+
+  //****************************************************************************
+  //***  MultiInstanceHitCollectionCreator
+  //----------------------------------------------------------------------
+  MultiInstanceHitCollectionCreator::MultiInstanceHitCollectionCreator(
+    art::Event& event,
+    std::vector<std::string> instance_names,
+    bool doWireAssns /* = true */, bool doRawDigitAssns /* = true */
+    )
+    : prod_instances(std::move(instance_names))
+    , doWireAssns(doWireAssns)
+    , doRawDigitAssns(doRawDigitAssns)
+    , event(&event)
+  {
+    hits.reserve(prod_instances.size());
+    hitPtrMakers.reserve(prod_instances.size());
+    for (std::string const& instance_name: prod_instances) {
+      hits.push_back(std::make_unique<std::vector<recob::Hit>>());
+      hitPtrMakers.emplace_back(event, instance_name);
+    } // for
+  } // MultiInstanceHitCollectionCreator::MultiInstanceHitCollectionCreator()
+
+
+  //----------------------------------------------------------------------
+  void MultiInstanceHitCollectionCreator::declare_products(
+    art::ProducesCollector& collector,
+    std::vector<std::string> const& instance_names,
+    bool doWireAssns /* = true */, bool doRawDigitAssns /* = true */
+  ) {
+    for (std::string const& instance_name: instance_names) {
+      HitAndAssociationsWriterBase::declare_products
+        (collector, instance_name, doWireAssns, doRawDigitAssns);
+    }
+  } // MultiInstanceHitCollectionCreator::declare_products()
+
+
+  //----------------------------------------------------------------------
+  size_t MultiInstanceHitCollectionCreator::instanceIndex
+    (std::string const& instance_name) const
+  {
+    auto const iName = std::find
+      (prod_instances.begin(), prod_instances.end(), instance_name);
+    if (iName == prod_instances.end()) {
+      throw art::Exception(art::errors::LogicError)
+        << "MultiInstanceHitCollectionCreator has no product instance '"
+        << instance_name << "'\n";
+    }
+    return iName - prod_instances.begin();
+  } // MultiInstanceHitCollectionCreator::instanceIndex()
+
+
+  //----------------------------------------------------------------------
+  size_t MultiInstanceHitCollectionCreator::size() const {
+    size_t n = 0;
+    for (auto const& instanceHits: hits) if (instanceHits) n += instanceHits->size();
+    return n;
+  } // MultiInstanceHitCollectionCreator::size()
+
+
+  //----------------------------------------------------------------------
+  void MultiInstanceHitCollectionCreator::emplace_back(
+    size_t iInstance, recob::Hit&& hit,
+    art::Ptr<recob::Wire> const& wire, art::Ptr<raw::RawDigit> const& digits
+  ) {
+    std::vector<recob::Hit>& instanceHits = *(hits[iInstance]);
+    instanceHits.emplace_back(std::move(hit));
+
+    // associations are created all together in put_into()
+    bool const hasWire = doWireAssns && wire.isNonnull();
+    bool const hasDigits = doRawDigitAssns && digits.isNonnull();
+    if (!hasWire && !hasDigits) return;
+    pending.push_back({
+      iInstance, instanceHits.size() - 1,
+      hasWire? wire: art::Ptr<recob::Wire>(),
+      hasDigits? digits: art::Ptr<raw::RawDigit>()
+      });
+  } // MultiInstanceHitCollectionCreator::emplace_back()
+
+
+  //----------------------------------------------------------------------
+  void MultiInstanceHitCollectionCreator::put_into() {
+    assert(event);
+    size_t const nInstances = prod_instances.size();
+
+    // all the associations, in a single pass on the buffer
+    std::vector<std::unique_ptr<art::Assns<recob::Wire, recob::Hit>>>
+      WireAssns(nInstances);
+    std::vector<std::unique_ptr<art::Assns<raw::RawDigit, recob::Hit>>>
+      RawDigitAssns(nInstances);
+    for (size_t iInstance = 0; iInstance < nInstances; ++iInstance) {
+      if (doWireAssns) {
+        WireAssns[iInstance]
+          = std::make_unique<art::Assns<recob::Wire, recob::Hit>>();
+      }
+      if (doRawDigitAssns) {
+        RawDigitAssns[iInstance]
+          = std::make_unique<art::Assns<raw::RawDigit, recob::Hit>>();
+      }
+    } // for
+
+    for (PendingAssociation const& assn: pending) {
+      art::Ptr<recob::Hit> const hit_ptr
+        = hitPtrMakers[assn.instance](assn.hit);
+      if (assn.wire.isNonnull())
+        WireAssns[assn.instance]->addSingle(assn.wire, hit_ptr);
+      if (assn.digits.isNonnull())
+        RawDigitAssns[assn.instance]->addSingle(assn.digits, hit_ptr);
+    } // for
+    pending.clear();
+
+    for (size_t iInstance = 0; iInstance < nInstances; ++iInstance) {
+      std::string const& instance_name = prod_instances[iInstance];
+      if (!hits[iInstance]) {
+        throw art::Exception(art::errors::LogicError)
+          << "MultiInstanceHitCollectionCreator is trying to put into the event"
+          " the hit collection '" << instance_name << "' twice!\n";
+      }
+      event->put(std::move(hits[iInstance]), instance_name);
+      if (WireAssns[iInstance])
+        event->put(std::move(WireAssns[iInstance]), instance_name);
+      if (RawDigitAssns[iInstance])
+        event->put(std::move(RawDigitAssns[iInstance]), instance_name);
+    } // for
+  } // MultiInstanceHitCollectionCreator::put_into()
+
+
   //****************************************************************************
   //***  HitCollectionAssociator
   //----------------------------------------------------------------------
@@ -415,6 +831,9 @@ namespace recob {
     // but we don't know where digits are; in that case, we try to use wires
     const bool bUseWiresForDigits = RawDigitAssns && (digits_label == "");
 
+    // pointers to wire and digits of each channel (null if none)
+    ChannelLookupTable_t ChannelMap;
+
     if (WireAssns || bUseWiresForDigits) {
       // do we use wires for digit associations too?
 
@@ -422,10 +841,6 @@ namespace recob {
       art::ValidHandle<std::vector<recob::Wire>> hWires
         = event->getValidHandle<std::vector<recob::Wire>>(wires_label);
 
-      // fill a map of wire index vs. channel number
-      std::vector<size_t> WireMap
-        = util::MakeIndex(*hWires, std::mem_fn(&recob::Wire::Channel));
-
       // use raw rigit - wire association, assuming they have been produced
       // by the same producer as the wire and with the same instance name;
       // we don't check whether the data product is found, but the following
@@ -437,6 +852,14 @@ namespace recob {
           (new art::FindOneP<raw::RawDigit>(hWires, *event, wires_label));
       }
 
+      // fill the table of wire (and digits) vs. channel number
+      resizeToChannels(ChannelMap, *hWires, std::mem_fn(&recob::Wire::Channel));
+      for (size_t iWire = 0; iWire < hWires->size(); ++iWire) {
+        ChannelDataPtrs& ptrs = ChannelMap[(*hWires)[iWire].Channel()];
+        ptrs.wire = art::Ptr<recob::Wire>(hWires, iWire);
+        if (bUseWiresForDigits) ptrs.digits = WireToDigit->at(iWire);
+      } // for wires
+
       // add associations, hit by hit:
       for (size_t iHit = 0; iHit < srchits.size(); ++iHit) {
 
@@ -444,31 +867,27 @@ namespace recob {
         size_t iChannel = size_t(srchits[iHit].Channel()); // forcibly converted
 
         // find the wire associated to that channel
-        size_t iWire = std::numeric_limits<size_t>::max();
-        if (iChannel < WireMap.size()) iWire = WireMap[iChannel];
-        if (iWire == std::numeric_limits<size_t>::max()) {
+        if ((iChannel >= ChannelMap.size()) || ChannelMap[iChannel].wire.isNull())
+        {
           throw art::Exception(art::errors::LogicError)
             << "No wire associated to channel #" << iChannel << " whence hit #"
             << iHit << " comes!\n";
         } // if no channel
+        ChannelDataPtrs const& ptrs = ChannelMap[iChannel];
 
         // make the association with wires
-        if (WireAssns) {
-          art::Ptr<recob::Wire> wire(hWires, iWire);
-          WireAssns->addSingle(wire, CreatePtr(iHit));
-        }
+        if (WireAssns) WireAssns->addSingle(ptrs.wire, CreatePtr(iHit));
 
         if (bUseWiresForDigits) {
           // find the digit associated to that channel
-          art::Ptr<raw::RawDigit> const& digit = WireToDigit->at(iWire);
-          if (digit.isNull()) {
+          if (ptrs.digits.isNull()) {
             throw art::Exception(art::errors::LogicError)
               << "No raw digit associated to channel #" << iChannel
               << " whence hit #" << iHit << " comes!\n";
           } // if no channel
 
           // make the association
-          RawDigitAssns->addSingle(digit, CreatePtr(iHit));
+          RawDigitAssns->addSingle(ptrs.digits, CreatePtr(iHit));
         } // if create digit associations through wires
       } // for hit
 
@@ -479,9 +898,13 @@ namespace recob {
       art::ValidHandle<std::vector<raw::RawDigit>> hDigits
         = event->getValidHandle<std::vector<raw::RawDigit>>(digits_label);
 
-      // fill a map of wire index vs. channel number
-      std::vector<size_t> DigitMap
-        = util::MakeIndex(*hDigits, std::mem_fn(&raw::RawDigit::Channel));
+      // fill the table of digits vs. channel number
+      resizeToChannels
+        (ChannelMap, *hDigits, std::mem_fn(&raw::RawDigit::Channel));
+      for (size_t iDigit = 0; iDigit < hDigits->size(); ++iDigit) {
+        ChannelMap[(*hDigits)[iDigit].Channel()].digits
+          = art::Ptr<raw::RawDigit>(hDigits, iDigit);
+      } // for digits
 
       // add associations, hit by hit:
       for (size_t iHit = 0; iHit < srchits.size(); ++iHit) {
@@ -490,17 +913,16 @@ namespace recob {
         size_t iChannel = size_t(srchits[iHit].Channel()); // forcibly converted
 
         // find the digit associated to that channel
-        size_t iDigit = std::numeric_limits<size_t>::max();
-        if (iChannel < DigitMap.size()) iDigit = DigitMap[iChannel];
-        if (iDigit == std::numeric_limits<size_t>::max()) {
+        if ((iChannel >= ChannelMap.size())
+          || ChannelMap[iChannel].digits.isNull())
+        {
           throw art::Exception(art::errors::LogicError)
             << "No raw digit associated to channel #" << iChannel
             << " whence hit #" << iHit << " comes!\n";
         } // if no channel
 
         // make the association
-        art::Ptr<raw::RawDigit> digit(hDigits, iDigit);
-        RawDigitAssns->addSingle(digit, CreatePtr(iHit));
+        RawDigitAssns->addSingle(ChannelMap[iChannel].digits, CreatePtr(iHit));
 
       } // for hit
     } // if we have rawdigit label
@@ -547,86 +969,69 @@ namespace recob {
 
     // we make the associations anew
     if (RawDigitAssns) ClearAssociations(*RawDigitAssns);
+    if (WireAssns)     ClearAssociations(*WireAssns);
 
     // read the hits; this is going to hurt performances...
     // no solution to that until there is a way to have a lazy read
     art::ValidHandle<std::vector<recob::Hit>> hHits
       = event->getValidHandle<std::vector<recob::Hit>>(hits_label);
 
-    // now get the associations
+    // find the associations between the hits and the wires
+    std::unique_ptr<art::FindOneP<recob::Wire>> HitToWire;
     if (WireAssns) {
-      // we make the associations anew
-      ClearAssociations(*WireAssns);
-
-      // find the associations between the hits and the wires
-      art::FindOneP<recob::Wire> HitToWire(hHits, *event, hits_label);
-      if (!HitToWire.isValid()) {
+      HitToWire.reset
+        (new art::FindOneP<recob::Wire>(hHits, *event, hits_label));
+      if (!HitToWire->isValid()) {
         throw art::Exception(art::errors::ProductNotFound)
           << "Can't find the associations between hits and wires produced by '"
           << hits_label << "'!\n";
       } // if no association
-
-      // fill a map of wire vs. channel number
-      std::vector<art::Ptr<recob::Wire>> WireMap;
-      for (size_t iAssn = 0; iAssn < HitToWire.size(); ++iAssn) {
-        art::Ptr<recob::Wire> wire = HitToWire.at(iAssn);
-        if (wire.isNull()) continue;
-        size_t channelID = (size_t) wire->Channel();
-        if (WireMap.size() <= channelID) // expand the map of necessary
-          WireMap.resize(std::max(channelID + 1, 2 * WireMap.size()), {});
-        WireMap[channelID] = std::move(wire);
-      } // for
-
-      // now go through all the hits...
-      for (size_t iHit = 0; iHit < srchits.size(); ++iHit) {
-        recob::Hit const& hit = srchits[iHit];
-        size_t channelID = (size_t) hit.Channel();
-
-        // no association if there is no wire to associate with
-        if ((channelID >= WireMap.size()) || !WireMap[channelID]) continue;
-
-        // create an association using the same wire pointer
-        WireAssns->addSingle(WireMap[channelID], CreatePtr(iHit));
-      } // for hits
     } // if wire associations
 
-    // now get the associations
+    // find the associations between the hits and the raw digits
+    std::unique_ptr<art::FindOneP<raw::RawDigit>> HitToDigits;
     if (RawDigitAssns) {
-      // we make the associations anew
-      ClearAssociations(*RawDigitAssns);
-
-      // find the associations between the hits and the raw digits
-      art::FindOneP<raw::RawDigit> HitToDigits(hHits, *event, hits_label);
-      if (!HitToDigits.isValid()) {
+      HitToDigits.reset
+        (new art::FindOneP<raw::RawDigit>(hHits, *event, hits_label));
+      if (!HitToDigits->isValid()) {
         throw art::Exception(art::errors::ProductNotFound)
           << "Can't find the associations between hits and raw digits"
           << " produced by '" << hits_label << "'!\n";
       } // if no association
-
-      // fill a map of digits vs. channel number
-      std::vector<art::Ptr<raw::RawDigit>> DigitMap;
-      for (size_t iAssn = 0; iAssn < HitToDigits.size(); ++iAssn) {
-        art::Ptr<raw::RawDigit> digits = HitToDigits.at(iAssn);
-        if (digits.isNull()) continue;
-        size_t channelID = (size_t) digits->Channel();
-        if (DigitMap.size() <= channelID) // expand the map of necessary
-          DigitMap.resize(std::max(channelID + 1, 2 * DigitMap.size()), {});
-        DigitMap[channelID] = std::move(digits);
-      } // for
-
-      // now go through all the hits...
-      for (size_t iHit = 0; iHit < srchits.size(); ++iHit) {
-        recob::Hit const& hit = srchits[iHit];
-        size_t channelID = (size_t) hit.Channel();
-
-        // no association if there is no digits to associate with
-        if ((channelID >= DigitMap.size()) || !DigitMap[channelID]) continue;
-
-        // create an association using the same digits pointer
-        RawDigitAssns->addSingle(DigitMap[channelID], CreatePtr(iHit));
-      } // for hits
     } // if digit associations
 
+    // fill a table of wire and digits vs. channel number, in a single pass;
+    // the channel is taken from the original hit rather than from the
+    // associated objects, which therefore do not need to be read
+    ChannelLookupTable_t ChannelMap;
+    resizeToChannels(ChannelMap, *hHits, std::mem_fn(&recob::Hit::Channel));
+    for (size_t iAssn = 0; iAssn < hHits->size(); ++iAssn) {
+      ChannelDataPtrs& ptrs = ChannelMap[(*hHits)[iAssn].Channel()];
+      if (HitToWire) {
+        art::Ptr<recob::Wire> const& wire = HitToWire->at(iAssn);
+        if (wire.isNonnull()) ptrs.wire = wire;
+      }
+      if (HitToDigits) {
+        art::Ptr<raw::RawDigit> const& digits = HitToDigits->at(iAssn);
+        if (digits.isNonnull()) ptrs.digits = digits;
+      }
+    } // for
+
+    // now go through all the hits...
+    for (size_t iHit = 0; iHit < srchits.size(); ++iHit) {
+      size_t channelID = (size_t) srchits[iHit].Channel();
+
+      // no association if there is nothing to associate with
+      if (channelID >= ChannelMap.size()) continue;
+      ChannelDataPtrs const& ptrs = ChannelMap[channelID];
+
+      // create the associations using the same pointers
+      if (WireAssns && ptrs.wire)
+        WireAssns->addSingle(ptrs.wire, CreatePtr(iHit));
+      if (RawDigitAssns && ptrs.digits)
+        RawDigitAssns->addSingle(ptrs.digits, CreatePtr(iHit));
+    } // for hits
+
   } // HitRefinerAssociator::put_into()
 
 
@@ -11,6 +11,8 @@
 #define LARDATA_ARTDATAHELPERS_HITCREATOR_H
 
 // LArSoft libraries
+#include "lardata/Utilities/MemoryAccounting.h"
+#include "lardata/Utilities/PtrMakerRegistry.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Wire.h"
 #include "lardataobj/RawData/RawDigit.h"
@@ -25,6 +27,8 @@
 
 // C/C++ standard library
 #include <utility> // std::move()
+#include <memory> // std::shared_ptr<>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -38,6 +42,68 @@ namespace art {
 /// Reconstruction base classes
 namespace recob {
 
+  /** **************************************************************************
+   * @brief Cumulative sums of the signal in a region of interest.
+   *
+   * Hit finders often extract several hits from the same region of interest,
+   * and each hit needs the sum of the signal in its own tick range.
+   * This object is built once per region of interest, with a single pass on
+   * its signal, and then it returns the sum of any tick range in constant
+   * time. It can be passed to the `HitCreator` constructor that would
+   * otherwise sum the signal of the wire for each hit:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * for (auto const& roi: wire.SignalROI().get_ranges()) {
+   *   recob::ROISummedADC const roiSums(roi);
+   *   for (auto const& found: findHits(roi)) {
+   *     recob::HitCreator hit(
+   *       wire, wireID, found.start_tick, found.end_tick, ...,
+   *       hit_integral, hit_sigma_integral, roiSums,
+   *       multiplicity, local_index, goodness_of_fit, dof
+   *       );
+   *     hits.push_back(hit.move());
+   *   }
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class ROISummedADC {
+    public:
+      /// Type of one region of interest.
+      using RegionOfInterest_t = recob::Wire::RegionsOfInterest_t::datarange_t;
+
+      /// Constructor: an empty region.
+      ROISummedADC() = default;
+
+      /// Constructor: computes the cumulative sums of the region.
+      explicit ROISummedADC(RegionOfInterest_t const& roi);
+
+      /// First tick of the region.
+      raw::TDCtick_t begin_tick() const { return fBegin; }
+
+      /// First tick after the region.
+      raw::TDCtick_t end_tick() const
+        { return fBegin + raw::TDCtick_t(fSums.size()) - 1; }
+
+      /**
+       * @brief Returns the sum of the signal from `start_tick` to `end_tick`.
+       * @param start_tick first tick of the sum
+       * @param end_tick first tick after the last one in the sum
+       * @return the sum of the signal in the ticks within the region
+       *
+       * Ticks outside the region contribute nothing, as the (void) signal
+       * around a region of interest would.
+       */
+      double sum(raw::TDCtick_t start_tick, raw::TDCtick_t end_tick) const;
+
+      /// Returns the sum of the signal of the whole region.
+      double sum() const { return fSums.back(); }
+
+    private:
+      raw::TDCtick_t fBegin = 0; ///< First tick of the region.
+      std::vector<double> fSums { 0.0 }; ///< Sum of the first `i` ticks.
+
+  }; // class ROISummedADC
+
+
   /** **************************************************************************
    * @brief Class managing the creation of a new `recob::Hit` object.
    *
@@ -79,6 +145,8 @@ namespace recob {
    * 4. from `recob::Wire`, [CVS], start and stop time from a region of interest
    * 5. from `recob::Wire`, [CVS], start and stop time from index of region of
    *      interest
+   * 6. from `recob::Wire`, [CVS], `summedADC` is computed from the cumulative
+   *      sums of the region of interest the hit comes from (`ROISummedADC`)
    */
   class HitCreator {
     public:
@@ -220,6 +288,51 @@ namespace recob {
         );
 
 
+      /**
+       * @brief Constructor: sum of ADC from the sums of a region of interest.
+       * @param wire a pointer to a `recob::Wire` (for channel, view, signal
+       *        type)
+       * @param wireID ID of the wire the hit is on
+       * @param start_tick first tick in the region the hit was extracted from
+       * @param end_tick first tick after the region the hit was extracted from
+       * @param rms RMS of the signal hit, in TDC time units
+       * @param peak_time time at peak of the signal, in TDC time units
+       * @param sigma_peak_time uncertainty on time at peak, in TDC time units
+       * @param peak_amplitude amplitude of the signal at peak, in ADC units
+       * @param sigma_peak_amplitude uncertainty on amplitude at peak
+       * @param hit_integral total charge integrated under the hit signal
+       * @param hit_sigma_integral uncertainty on the total hit charge
+       * @param roiSums cumulative sums of the region of interest of the hit
+       * @param multiplicity number of hits in the region it was extracted from
+       * @param local_index index of this hit in the region it was extracted from
+       * @param goodness_of_fit quality parameter for the hit
+       * @param dof degrees of freedom in the definition of the hit shape
+       *
+       * This is the same as the constructor computing the sum of ADC counts
+       * from the wire, but the sum between `start_tick` and `end_tick`
+       * (the latter excluded) comes from `roiSums` in constant time; the
+       * same `roiSums` can be used for all the hits of its region.
+       */
+      HitCreator(
+        recob::Wire const&   wire,
+        geo::WireID const&   wireID,
+        raw::TDCtick_t       start_tick,
+        raw::TDCtick_t       end_tick,
+        float                rms,
+        float                peak_time,
+        float                sigma_peak_time,
+        float                peak_amplitude,
+        float                sigma_peak_amplitude,
+        float                hit_integral,
+        float                hit_sigma_integral,
+        ROISummedADC const&  roiSums,
+        short int            multiplicity,
+        short int            local_index,
+        float                goodness_of_fit,
+        int                  dof
+        );
+
+
       /**
        * @brief Constructor: uses region of interest specified by index.
        * @param wire a pointer to a `recob::Wire` (for channel, view, signal
@@ -368,6 +481,56 @@ namespace recob {
 
 
 
+  /** **************************************************************************
+   * @brief Learns the typical number of hits per event.
+   *
+   * This object keeps a running average of the number of hits in the last
+   * events, where each new event has a weight `weight()` and the older ones
+   * weigh less and less. The expected number of hits is that average,
+   * increased by a safety margin factor `margin()`.
+   * Hit writers use it to reserve their collection ahead of time: see
+   * `HitAndAssociationsWriterManager`.
+   *
+   * The object can be updated and queried concurrently from different threads.
+   */
+  class HitCollectionSizeEstimator {
+  public:
+    /**
+     * @brief Constructor: sets the parameters of the estimation.
+     * @param margin factor applied to the average to obtain the expectation
+     * @param weight weight of each new event in the running average
+     */
+    HitCollectionSizeEstimator(double margin = 1.1, double weight = 0.25)
+      : fMargin(margin), fWeight(weight)
+      {}
+
+    /// Adds the number of hits of a new event to the average.
+    void record(size_t nHits);
+
+    /// Returns the number of hits expected in the next event.
+    size_t expected() const;
+
+    /// Returns the number of events recorded so far.
+    size_t nEvents() const;
+
+    /// Returns the safety margin factor.
+    double margin() const { return fMargin; }
+
+    /// Returns the weight of each new event.
+    double weight() const { return fWeight; }
+
+  private:
+    double const fMargin; ///< Safety factor on the expected number of hits.
+    double const fWeight; ///< Weight of the latest event in the average.
+
+    mutable std::mutex fMutex; ///< Lock for the estimation.
+
+    double fAverage = 0.0; ///< Current average number of hits.
+    size_t fNEvents = 0U; ///< Number of events recorded.
+
+  }; // class HitCollectionSizeEstimator
+
+
   /** **************************************************************************
    * @brief Base class handling a collection of hits and its associations.
    *
@@ -375,6 +538,7 @@ namespace recob {
    * wires and one for its association with raw digits, one can use a class
    * derived from this one:
         * - `HitCollectionCreator`: push new hits one by one
+        *     (see `MultiInstanceHitCollectionCreator` for many instances)
         * - `HitCollectionAssociator`: push a complete collection of hits
         * - `HitRefinerAssociator`: push a complete collection of hits deriving their
         *     associations from other hits
@@ -432,6 +596,18 @@ namespace recob {
     std::vector<recob::Hit> const& peek() const { return *hits; }
 
 
+    /**
+     * @brief Uses a size estimator for the hit collection.
+     * @param estimator the estimator to use (null to use none)
+     *
+     * The hit collection (if any) is reserved for the number of hits expected
+     * by `estimator`, and the actual number of hits is recorded into the
+     * estimator when the hits are put into the event.
+     */
+    void useSizeEstimator
+      (std::shared_ptr<HitCollectionSizeEstimator> estimator);
+
+
     /**
      * @brief Declares the hit products we are going to fill.
      * @tparam ModuleType type of producing module (`EDProducer` or `EDFilter`)
@@ -472,6 +648,28 @@ namespace recob {
 
     art::PtrMaker<recob::Hit> hitPtrMaker; ///< Tool to create hit pointers,
 
+    /// Estimator of the number of hits (may be null).
+    std::shared_ptr<HitCollectionSizeEstimator> sizeEstimator;
+
+    /// Tag of the memory of the hit collection (see `lar::MemoryAccounting`).
+    struct HitMemoryTag
+      { static constexpr char const* Name = "HitCollectionCreator"; };
+
+    /// Size of the hit collection, until it is put into the event.
+    mutable lar::MemoryAccount<HitMemoryTag> hitMemory;
+
+    /**
+     * @brief Accounts a change of capacity of the hit collection.
+     * @param oldCapacity capacity of the collection before the change
+     *
+     * The type of the hit data product can't use a tagged allocator, so its
+     * reallocations are recorded explicitly under the tag
+     * `"HitCollectionCreator"` (only when `LARDATA_ALLOCATION_ACCOUNTING` is
+     * enabled; see `lar::AllocationAccounting`). The new capacity is also
+     * registered in `hitMemory`.
+     */
+    void recordHitCapacity(std::size_t oldCapacity) const;
+
 
     /**
      * @brief Constructor: sets instance name and whether to build associations.
@@ -489,6 +687,19 @@ namespace recob {
       bool doWireAssns, bool doRawDigitAssns
       );
 
+    /**
+     * @brief Constructor: takes the hit pointer maker from a registry.
+     * @param ptrMakers registry of pointer makers of the current event
+     * @param instance_name name of the instance for all data products
+     * @param doWireAssns whether to enable associations to wires
+     * @param doRawDigitAssns whether to enable associations to raw digits
+     */
+    HitAndAssociationsWriterBase(
+      util::PtrMakerRegistry& ptrMakers,
+      std::string instance_name,
+      bool doWireAssns, bool doRawDigitAssns
+      );
+
 
     /// Creates an art pointer to the hit with the specified index.
     HitPtr_t CreatePtr(size_t index) const { return hitPtrMaker(index); }
@@ -540,6 +751,23 @@ namespace recob {
       HitCollectionCreator(event, "", doWireAssns, doRawDigitAssns)
       {}
 
+    /**
+     * @brief Constructor: uses the event and hit pointer maker of a registry.
+     * @param ptrMakers registry of pointer makers of the current event
+     * @param instance_name name of the instance for all data products
+     * @param doWireAssns whether to enable associations to wires
+     * @param doRawDigitAssns whether to enable associations to raw digits
+     *
+     * The pointer maker for the hits is shared with the other users of
+     * `ptrMakers` (e.g. `util::AssnsBuilder` associating clusters to these
+     * hits), and its product ID is looked up only once per event.
+     */
+    HitCollectionCreator(
+      util::PtrMakerRegistry& ptrMakers,
+      std::string instance_name = "",
+      bool doWireAssns = true, bool doRawDigitAssns = true
+      );
+
     /// @}
 
     // destructor, copy and move constructors and assignment are default
@@ -637,7 +865,21 @@ namespace recob {
 
 
     /// Prepares the collection to host at least `new_size` hits.
-    void reserve(size_t new_size) { if (hits) hits->reserve(new_size); }
+    void reserve(size_t new_size)
+      {
+        if (!hits) return;
+        std::size_t const oldCapacity = hits->capacity();
+        hits->reserve(new_size);
+        recordHitCapacity(oldCapacity);
+      }
+
+    /**
+     * @brief Prepares the collection for hits from the specified wires.
+     * @param nWires number of wires the hits are going to be found on
+     * @param hitsPerWire average number of hits expected on each wire
+     */
+    void reserveForWires(size_t nWires, double hitsPerWire)
+      { reserve(static_cast<size_t>(nWires * hitsPerWire + 0.5)); }
 
 
     /**
@@ -682,6 +924,330 @@ namespace recob {
 
 
 
+  /** **************************************************************************
+   * @brief A class collecting hits and their associations from many threads.
+   *
+   * This object works like `HitCollectionCreator`, but hits are not added
+   * directly to it: they are added to one of its "shards".
+   * Each shard is an independent buffer of hits and of the wire and raw digit
+   * they are associated with, and different shards can be filled concurrently
+   * from different threads, with no locking. A single shard must not be used
+   * by more than one thread at a time.
+   *
+   * When the data is put into the event, the hits of all the shards are merged
+   * sorted by channel; hits on the same channel are kept in the order they were
+   * added, with the ones from lower shard numbers first. The _art_ pointers
+   * and the associations are then created in a single pass on the merged
+   * collection.
+   *
+   * An example of usage in a module with a parallel loop on wires:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * recob::ShardedHitCollectionCreator hitCol(event, "", true, true, nThreads);
+   *
+   * // in each thread, with its own index `iThread`:
+   * recob::ShardedHitCollectionCreator::Shard& hits = hitCol.shard(iThread);
+   * for (...) { // loop on the wires assigned to this thread
+   *   hits.emplace_back(std::move(hit), wirePtr, digitPtr);
+   * }
+   *
+   * // after all the threads are done:
+   * hitCol.put_into();
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class ShardedHitCollectionCreator: public HitAndAssociationsWriterBase {
+  public:
+
+    /// Buffer of hits and associations filled by a single thread.
+    class Shard {
+    public:
+      /**
+       * @brief Adds the specified hit to this shard.
+       * @param hit the hit that will be moved into the collection
+       * @param wire art pointer to the wire to be associated to this hit
+       * @param digits art pointer to the raw digits to be associated to this
+       *        hit
+       *
+       * After this call, hit will be invalid.
+       * If a art pointer is not valid, that association will not be stored.
+       */
+      void emplace_back(
+        recob::Hit&& hit,
+        art::Ptr<recob::Wire> const& wire = art::Ptr<recob::Wire>(),
+        art::Ptr<raw::RawDigit> const& digits = art::Ptr<raw::RawDigit>()
+        );
+
+      /// Adds a copy of the specified hit to this shard.
+      void emplace_back(
+        recob::Hit const& hit,
+        art::Ptr<recob::Wire> const& wire = art::Ptr<recob::Wire>(),
+        art::Ptr<raw::RawDigit> const& digits = art::Ptr<raw::RawDigit>()
+        )
+        { emplace_back(recob::Hit(hit), wire, digits); }
+
+      /// Adds the hit from the specified creator, which will be left empty.
+      void emplace_back(
+        HitCreator&& hit,
+        art::Ptr<recob::Wire> const& wire = art::Ptr<recob::Wire>(),
+        art::Ptr<raw::RawDigit> const& digits = art::Ptr<raw::RawDigit>()
+        )
+        { emplace_back(hit.move(), wire, digits); }
+
+      /// Adds the specified hit, associated only to the specified raw digits.
+      void emplace_back(recob::Hit&& hit, art::Ptr<raw::RawDigit> const& digits)
+        { emplace_back(std::move(hit), art::Ptr<recob::Wire>(), digits); }
+
+      /// Adds the hit from the creator, associated only to the raw digits.
+      void emplace_back(HitCreator&& hit, art::Ptr<raw::RawDigit> const& digits)
+        { emplace_back(hit.move(), art::Ptr<recob::Wire>(), digits); }
+
+      /// Returns the number of hits currently in this shard.
+      size_t size() const { return hits.size(); }
+
+      /// Prepares this shard to host at least `new_size` hits.
+      void reserve(size_t new_size);
+
+      /// Returns a read-only reference to the current list of hits.
+      std::vector<recob::Hit> const& peek() const { return hits; }
+
+    private:
+      friend class ShardedHitCollectionCreator;
+
+      bool doWireAssns = false; ///< Whether to keep the wire pointers.
+      bool doRawDigitAssns = false; ///< Whether to keep the digit pointers.
+
+      std::vector<recob::Hit> hits; ///< Hits in this shard.
+      std::vector<art::Ptr<recob::Wire>> wires; ///< Wire of each hit.
+      std::vector<art::Ptr<raw::RawDigit>> digits; ///< Digits of each hit.
+
+      Shard(bool doWireAssns, bool doRawDigitAssns)
+        : doWireAssns(doWireAssns), doRawDigitAssns(doRawDigitAssns) {}
+
+    }; // class Shard
+
+
+    /**
+     * @brief Constructor: sets instance name and whether to build associations.
+     * @param event the event the products are going to be put into
+     * @param instance_name name of the instance for all data products
+     * @param doWireAssns whether to enable associations to wires
+     * @param doRawDigitAssns whether to enable associations to raw digits
+     * @param nShards number of shards to create
+     *
+     * All the data products (hit collection and associations) will have the
+     * specified product instance name.
+     */
+    ShardedHitCollectionCreator(
+      art::Event& event,
+      std::string instance_name = "",
+      bool doWireAssns = true, bool doRawDigitAssns = true,
+      size_t nShards = 1U
+      );
+
+    // destructor, copy and move constructors and assignment are default
+
+
+    /**
+     * @brief Sets the number of shards.
+     * @param nShards the new number of shards
+     *
+     * The content of existing shards is preserved, unless they are removed.
+     * This method invalidates all references to shards and must not be called
+     * while any shard is being filled.
+     */
+    void setNShards(size_t nShards);
+
+    /// Returns the number of shards.
+    size_t nShards() const { return shards.size(); }
+
+    /// Returns the shard with the specified index (no range check).
+    Shard& shard(size_t iShard) { return shards[iShard]; }
+
+    /// Returns the total number of hits currently in all the shards.
+    size_t size() const;
+
+
+    /**
+     * @brief Merges the shards and moves the data into the event.
+     *
+     * The calling module must have already declared the production of these
+     * products with the proper instance name.
+     * After the move, the collections in this object and all the shards are
+     * empty.
+     * This method must not be called while any shard is being filled.
+     */
+    void put_into();
+
+
+  protected:
+    std::vector<Shard> shards; ///< All the shards.
+
+    /// Moves the hits from all the shards into `hits`, sorted by channel.
+    void merge_shards();
+
+  }; // class ShardedHitCollectionCreator
+
+
+
+
+  /** **************************************************************************
+   * @brief A class handling many hit collections and their associations.
+   *
+   * Hit finders writing their hits in separate data product instances (e.g.
+   * one per TPC or per plane) would need a `HitCollectionCreator` for each
+   * of them. This object manages all of them together: hits are added to the
+   * instance with a given index, the wire and raw digit pointers of all the
+   * instances are kept in a single buffer, and all the collections and
+   * associations are created and put into the event with one `put_into()`
+   * call, in a single pass on that buffer.
+   *
+   * The products must be declared with the static `declare_products()`:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * // in the module constructor
+   * recob::MultiInstanceHitCollectionCreator::declare_products
+   *   (producesCollector(), fInstanceNames);
+   *
+   * // in produce()
+   * recob::MultiInstanceHitCollectionCreator hitCols(event, fInstanceNames);
+   * for (...) {
+   *   hitCols.emplace_back(iPlane, std::move(hit), wirePtr, digitPtr);
+   * }
+   * hitCols.put_into();
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class MultiInstanceHitCollectionCreator {
+  public:
+
+    /**
+     * @brief Constructor: sets instance names and which associations to build.
+     * @param event the event the products are going to be put into
+     * @param instance_names names of the instances of the data products
+     * @param doWireAssns whether to enable associations to wires
+     * @param doRawDigitAssns whether to enable associations to raw digits
+     *
+     * Each instance has its hit collection and its associations, all with the
+     * same product instance name. Instances are then referred to by their
+     * index in `instance_names`.
+     */
+    MultiInstanceHitCollectionCreator(
+      art::Event& event,
+      std::vector<std::string> instance_names,
+      bool doWireAssns = true, bool doRawDigitAssns = true
+      );
+
+    // destructor, copy and move constructors and assignment are default
+
+
+    /// Returns the number of product instances.
+    size_t nInstances() const { return prod_instances.size(); }
+
+    /// Returns the name of the specified product instance.
+    std::string const& instanceName(size_t iInstance) const
+      { return prod_instances[iInstance]; }
+
+    /// Returns the index of the instance with the specified name.
+    /// @throw art::Exception (`art::errors::LogicError`) if not present
+    size_t instanceIndex(std::string const& instance_name) const;
+
+
+    /**
+     * @brief Adds the specified hit to the collection of an instance.
+     * @param iInstance index of the product instance
+     * @param hit the hit that will be moved into the collection
+     * @param wire art pointer to the wire to be associated to this hit
+     * @param digits art pointer to the raw digits to be associated to this hit
+     *
+     * After this call, hit will be invalid.
+     * If a art pointer is not valid, that association will not be stored.
+     */
+    void emplace_back(
+      size_t iInstance,
+      recob::Hit&& hit,
+      art::Ptr<recob::Wire> const& wire = art::Ptr<recob::Wire>(),
+      art::Ptr<raw::RawDigit> const& digits = art::Ptr<raw::RawDigit>()
+      );
+
+    /// Adds the hit from the specified creator, which will be left empty.
+    void emplace_back(
+      size_t iInstance,
+      HitCreator&& hit,
+      art::Ptr<recob::Wire> const& wire = art::Ptr<recob::Wire>(),
+      art::Ptr<raw::RawDigit> const& digits = art::Ptr<raw::RawDigit>()
+      )
+      { emplace_back(iInstance, hit.move(), wire, digits); }
+
+
+    /// Returns the total number of hits currently in all the collections.
+    size_t size() const;
+
+    /// Returns the number of hits currently in the specified instance.
+    size_t size(size_t iInstance) const { return hits[iInstance]->size(); }
+
+    /// Prepares the specified instance to host at least `new_size` hits.
+    void reserve(size_t iInstance, size_t new_size)
+      { hits[iInstance]->reserve(new_size); }
+
+    /// Returns a read-only reference to the hits of the specified instance.
+    std::vector<recob::Hit> const& peek(size_t iInstance) const
+      { return *(hits[iInstance]); }
+
+
+    /**
+     * @brief Moves the data of all the instances into the event.
+     *
+     * The calling module must have already declared the production of these
+     * products (see `declare_products()`).
+     * After the move, the collections in this object are empty.
+     */
+    void put_into();
+
+
+    /**
+     * @brief Declares the hit products of all the instances.
+     * @param collector the module producing the data products
+     * @param instance_names names of the instances of the data products
+     * @param doWireAssns whether to enable associations to wires
+     * @param doRawDigitAssns whether to enable associations to raw digits
+     *
+     * This is `HitAndAssociationsWriterBase::declare_products()` for each of
+     * the instances, and it must be called in the constructor of producer.
+     */
+    static void declare_products(
+      art::ProducesCollector& collector,
+      std::vector<std::string> const& instance_names,
+      bool doWireAssns = true, bool doRawDigitAssns = true
+      );
+
+  private:
+
+    /// Associations of a hit, to be created when putting into the event.
+    struct PendingAssociation {
+      size_t instance; ///< Index of the instance the hit belongs to.
+      size_t hit; ///< Index of the hit in its collection.
+      art::Ptr<recob::Wire> wire; ///< Wire to associate (may be null).
+      art::Ptr<raw::RawDigit> digits; ///< Digits to associate (may be null).
+    }; // PendingAssociation
+
+    std::vector<std::string> prod_instances; ///< Names of the instances.
+
+    bool doWireAssns; ///< Whether to create associations with wires.
+    bool doRawDigitAssns; ///< Whether to create associations with digits.
+
+    art::Event* event = nullptr; ///< Pointer to the event we are using.
+
+    /// Collection of hits of each instance.
+    std::vector<std::unique_ptr<std::vector<recob::Hit>>> hits;
+
+    /// Tool to create hit pointers, for each instance.
+    std::vector<art::PtrMaker<recob::Hit>> hitPtrMakers;
+
+    /// Associations of all the instances, in order of addition of the hits.
+    std::vector<PendingAssociation> pending;
+
+  }; // class MultiInstanceHitCollectionCreator
+
+
+
+
   /** **************************************************************************
    * @brief A class handling a collection of hits and its associations.
    *
@@ -944,6 +1510,10 @@ namespace recob {
    * performing the first step directly, and delivering an already configured
    * object for the second step.
    *
+   * The manager also keeps track of the number of hits written in the past
+   * events (`sizeEstimator()`), and each new writer reserves its hit
+   * collection accordingly, avoiding repeated reallocations in busy events.
+   *
    * An example of usage in a module:
    * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
    * class MyHitProducer: public art::EDProducer {
@@ -1035,6 +1605,10 @@ namespace recob {
     /// Returns whether the class is fully configured.
     bool ready() const noexcept { return collector_p != nullptr; }
 
+    /// Returns the estimator of the number of hits shared by all writers.
+    HitCollectionSizeEstimator const& sizeEstimator() const
+      { return *hitCountEstimator; }
+
   protected:
     art::ProducesCollector* collector_p = nullptr; ///< Collector this manager is bound to.
 
@@ -1046,6 +1620,10 @@ namespace recob {
     /// Whether we produce hit-wire associations.
     bool hasWireAssns = true;
 
+    /// Running estimation of the number of hits, learned from past events.
+    std::shared_ptr<HitCollectionSizeEstimator> hitCountEstimator
+      = std::make_shared<HitCollectionSizeEstimator>();
+
 
   }; // class HitAndAssociationsWriterManager
 
@@ -1112,8 +1690,9 @@ recob::HitAndAssociationsWriterManager<Writer>::collectionWriter
       << "HitAndAssociationsWriter<>::collectionWriter() called"
       " before products are declared.";
   }
-  return
-    { event, prodInstance, hasWireAssns, hasRawDigitAssns };
+  Writer_t writer { event, prodInstance, hasWireAssns, hasRawDigitAssns };
+  writer.useSizeEstimator(hitCountEstimator);
+  return writer;
 } // recob::HitAndAssociationsWriterManager::collectionWriter()
 
 
@@ -9,6 +9,80 @@
 // this header
 #include "HitUtils.h"
 
+// framework libraries
+#include "canvas/Utilities/Exception.h"
+#include "art/Framework/Principal/Handle.h"
 
+// C/C++ standard libraries
+#include <algorithm> // std::max()
 
 
+//------------------------------------------------------------------------------
+//---  lar::util::HitToWireTable
+//---
+lar::util::HitToWireTable::HitToWireTable
+  (Assns_t const& assns, art::ProductID const& hitID, std::size_t nHits)
+  : fHitID(hitID)
+  , fWires(nHits)
+{
+  for (auto const& assn: assns) {
+    // assn is a std::pair<art::Ptr<recob::Wire>, art::Ptr<recob::Hit>>
+    HitPtr_t const& hit = assn.second;
+    if (hit.id() != fHitID) continue;
+
+    std::size_t const key = hit.key();
+    if (key >= fWires.size()) fWires.resize(key + 1);
+
+    WirePtr_t& wire = fWires[key];
+    if (wire.isNonnull() && (wire != assn.first)) {
+      throw art::Exception(art::errors::InvalidNumber)
+        << "Object Ptr" << hit
+        << " is associated with at least two objects: "
+        << assn.first << " and " << wire;
+    }
+    wire = assn.first;
+  } // for all associations
+} // lar::util::HitToWireTable::HitToWireTable(Assns)
+
+
+//------------------------------------------------------------------------------
+lar::util::HitToWireTable::HitToWireTable(
+  art::Event const& event,
+  art::InputTag const& hitTag, art::InputTag const& assnTag
+  )
+{
+  auto const& hHits = event.getValidHandle<std::vector<recob::Hit>>(hitTag);
+  auto const& hAssns = event.getValidHandle<Assns_t>(assnTag);
+  *this = HitToWireTable(*hAssns, hHits.id(), hHits->size());
+} // lar::util::HitToWireTable::HitToWireTable(Event)
+
+
+//------------------------------------------------------------------------------
+//---  lar::util::WireChannelTable
+//---
+lar::util::WireChannelTable::WireChannelTable
+  (std::vector<recob::Wire> const& wires)
+{
+  // wires on invalid channels are left out of the table
+  std::size_t nChannels = 0;
+  for (recob::Wire const& wire: wires) {
+    if (wire.Channel() == raw::InvalidChannelID) continue;
+    nChannels
+      = std::max(nChannels, static_cast<std::size_t>(wire.Channel()) + 1);
+  } // for
+  fIndices.assign(nChannels, NoWire);
+
+  for (std::size_t iWire = 0; iWire < wires.size(); ++iWire) {
+    if (wires[iWire].Channel() == raw::InvalidChannelID) continue;
+    std::size_t& index = fIndices[wires[iWire].Channel()];
+    if (index != NoWire) {
+      throw art::Exception(art::errors::InvalidNumber)
+        << "Wires #" << index << " and #" << iWire
+        << " are both on channel " << wires[iWire].Channel();
+    }
+    index = iWire;
+  } // for
+} // lar::util::WireChannelTable::WireChannelTable()
+
+
+//------------------------------------------------------------------------------
@@ -17,6 +17,19 @@
 #include "lardataobj/RecoBase/Wire.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardata/ArtDataHelper/FindAllP.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/InputTag.h"
+#include "art/Framework/Principal/Event.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits> // std::numeric_limits<>
+#include <cstddef> // std::size_t
 
 
 /// LArSoft-specific namespace
@@ -56,6 +69,143 @@ namespace lar {
     using HitToWire = details::FindAllP<recob::Hit, recob::Wire>;
 
 
+    /** ************************************************************************
+     * @brief Table of the wire of each hit, indexed by hit key
+     *
+     * This is a compact alternative to HitToWire and art::FindOneP for a
+     * single hit data product: the association is read once, and the wire
+     * of each hit is stored in a vector at the position of the hit key, so
+     * that each query is a plain vector access.
+     *
+     * Example of usage: let hitTag be the input tag of the hit data product,
+     * with its hit-wire association. Then
+     *
+     *     lar::util::HitToWireTable const HtoW(evt, hitTag);
+     *     art::Ptr<recob::Wire> const& wire_ptr = HtoW[hit_ptr];
+     *
+     * The table can be copied, and it is not bound to the event it was read
+     * from, so the same table can be handed to all the algorithms working on
+     * the same hits in an event.
+     * If a hit is associated to no wire, or it belongs to a different data
+     * product, a null pointer is returned.
+     */
+    class HitToWireTable {
+        public:
+      using WirePtr_t = art::Ptr<recob::Wire>;
+      using HitPtr_t = art::Ptr<recob::Hit>;
+
+      /// Type of the association between wires and hits
+      using Assns_t = art::Assns<recob::Wire, recob::Hit>;
+
+      /// Default constructor: an empty table
+      HitToWireTable() = default;
+
+      /**
+       * @brief Constructor: fills the table from an association
+       * @param assns the association between wires and hits
+       * @param hitID the product ID of the hits in the table
+       * @param nHits number of hits in the hit data product
+       * @throw art::Exception if a hit is associated with two different wires
+       *
+       * Associated hits from other data products are ignored.
+       */
+      HitToWireTable
+        (Assns_t const& assns, art::ProductID const& hitID, std::size_t nHits);
+
+      /**
+       * @brief Constructor: reads the hits and the association from the event
+       * @param event the event to read the data from
+       * @param hitTag the input tag of the hit collection
+       * @param assnTag the input tag of the wire-hit association
+       * @throw art::Exception if the data products are not found
+       * @throw art::Exception if a hit is associated with two different wires
+       */
+      HitToWireTable(
+        art::Event const& event,
+        art::InputTag const& hitTag, art::InputTag const& assnTag
+        );
+
+      /// Constructor: reads the association with the same tag as the hits
+      HitToWireTable(art::Event const& event, art::InputTag const& hitTag)
+        : HitToWireTable(event, hitTag, hitTag)
+        {}
+
+      /// Returns the wire of the specified hit (null pointer if none)
+      WirePtr_t const& operator[] (HitPtr_t const& hit) const
+        { return (hit.id() == fHitID)? wireOf(hit.key()): fNoWire; }
+
+      /// Returns the wire of the hit with the specified key (null if none)
+      WirePtr_t const& wireOf(std::size_t hitKey) const
+        { return (hitKey < fWires.size())? fWires[hitKey]: fNoWire; }
+
+      /// Returns the number of hits in the table
+      std::size_t size() const { return fWires.size(); }
+
+      /// Returns the product ID of the hits in the table
+      art::ProductID const& hitProductID() const { return fHitID; }
+
+      /// Returns the wire of each hit, indexed by hit key
+      std::vector<WirePtr_t> const& wires() const { return fWires; }
+
+        private:
+      art::ProductID fHitID; ///< ID of the hit data product
+      std::vector<WirePtr_t> fWires; ///< wire of each hit, by hit key
+      WirePtr_t fNoWire; ///< null pointer returned for hits without wire
+
+    }; // class HitToWireTable
+
+
+    /** ************************************************************************
+     * @brief Table of the position of the wire on each channel
+     *
+     * Wire collections hold typically one wire per channel. This table maps
+     * each channel to the position of its wire in the collection, so that
+     * the wire of a hit can be found from the channel of the hit alone:
+     *
+     *     lar::util::WireChannelTable const channelToWire(wires);
+     *     std::size_t const iWire = channelToWire[hit.Channel()];
+     *     if (iWire != lar::util::WireChannelTable::NoWire) {
+     *       recob::Wire const& wire = wires[iWire];
+     *       // ...
+     *     }
+     *
+     */
+    class WireChannelTable {
+        public:
+      /// Value returned for the channels with no wire
+      static constexpr std::size_t NoWire
+        = std::numeric_limits<std::size_t>::max();
+
+      /// Default constructor: an empty table
+      WireChannelTable() = default;
+
+      /**
+       * @brief Constructor: fills the table from a wire collection
+       * @param wires the wire collection
+       * @throw art::Exception if two wires are on the same channel
+       */
+      WireChannelTable(std::vector<recob::Wire> const& wires);
+
+      /// Returns the position of the wire on the channel (NoWire if none)
+      std::size_t operator[] (raw::ChannelID_t channel) const
+        {
+          return (static_cast<std::size_t>(channel) < fIndices.size())
+            ? fIndices[channel]: NoWire;
+        }
+
+      /// Returns whether there is a wire on the specified channel
+      bool hasWire(raw::ChannelID_t channel) const
+        { return (*this)[channel] != NoWire; }
+
+      /// Returns the number of channels in the table (one past the highest)
+      std::size_t size() const { return fIndices.size(); }
+
+        private:
+      std::vector<std::size_t> fIndices; ///< wire position, by channel
+
+    }; // class WireChannelTable
+
+
   } // namespace util
 
 } // namespace lar
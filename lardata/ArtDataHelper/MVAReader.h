@@ -151,6 +151,60 @@ public:
         std::function<float (T const &)> fweight) const
     { return pAccumulate(items, fweight, FVectorReader<T, N>::vectors()); }
 
+    /// Get MVA results accumulated with any callable weighting function (taking T const &
+    /// or art::Ptr<T> const &), which is inlined in the accumulation loop.
+    template <class F, typename = std::enable_if_t< MVAWrapperBase::isWeightFunction<T, F>() > >
+    std::array<float, N> getOutput(std::vector< art::Ptr<T> > const & items, F && fweight) const
+    { return pAccumulate(items, std::forward<F>(fweight), FVectorReader<T, N>::vectors()); }
+
+    /// Get MVA results accumulated over the nKeys items at indices keys (no art::Ptr needed),
+    /// optionally weighted with an array of nKeys weights or with a function of the key.
+    std::array<float, N> getOutput(size_t const * keys, size_t nKeys) const
+    { return pAccumulate(keys, nKeys, FVectorReader<T, N>::vectors()); }
+
+    std::array<float, N> getOutput(size_t const * keys, size_t nKeys, float const * weights) const
+    { return pAccumulate(keys, nKeys, weights, FVectorReader<T, N>::vectors()); }
+
+    template <class F, typename = std::enable_if_t< MVAWrapperBase::isKeyWeightFunction<F>() > >
+    std::array<float, N> getOutput(size_t const * keys, size_t nKeys, F && fweight) const
+    { return pAccumulate(keys, nKeys, std::forward<F>(fweight), FVectorReader<T, N>::vectors()); }
+
+    /// Get MVA results accumulated over the vector of items, with outputs normalized in
+    /// groups: members of a group have the same non-negative label in the mask, outputs
+    /// with negative label are ignored.
+    std::array<float, N> getOutput(std::vector< art::Ptr<T> > const & items,
+        std::array<char, N> const & mask) const
+    { return pAccumulate(items, FVectorReader<T, N>::vectors(), mask); }
+
+    /// Get MVA results accumulated with the mask for each of the objects (eg. for the hits of
+    /// each cluster); result is resized to the number of objects.
+    void getOutputs(std::vector< std::vector< art::Ptr<T> > > const & objects,
+        std::array<char, N> const & mask, std::vector< std::array<float, N> > & result) const
+    { pAccumulate(objects, FVectorReader<T, N>::vectors(), mask, result); }
+
+    /// Get the index of the highest MVA output of each item in the collection (eg. the most
+    /// likely class of each hit); result is resized to the number of items.
+    void getArgMax(std::vector<size_t> & result) const
+    { pArgMax(FVectorReader<T, N>::vectors(), result); }
+
+    /// Get the index of the highest MVA output of each of the items, in the same order.
+    void getArgMax(std::vector< art::Ptr<T> > const & items, std::vector<size_t> & result) const
+    { pArgMax(items, FVectorReader<T, N>::vectors(), result); }
+
+    /// Get the mask of the items in the collection whose MVA output at the index "column"
+    /// is above threshold; mask is resized to the number of items.
+    void getMask(size_t column, float threshold, std::vector<char> & mask) const
+    { pMask(FVectorReader<T, N>::vectors(), column, threshold, mask); }
+
+    /// Get the arithmetic mean of the MVA outputs of the items (eg. of the hits of a cluster).
+    std::array<float, N> getAverage(std::vector< art::Ptr<T> > const & items) const
+    { return pAverage(items, FVectorReader<T, N>::vectors()); }
+
+    /// Get the weighted arithmetic mean of the MVA outputs of the items.
+    std::array<float, N> getAverage(std::vector< art::Ptr<T> > const & items,
+        std::vector<float> const & weights) const
+    { return pAverage(items, weights, FVectorReader<T, N>::vectors()); }
+
     /// Meaning/name of the index'th column in the collection of MVA output vectors.
     const std::string & outputName(size_t index) const { return FVectorReader<T, N>::columnName(index); }
 
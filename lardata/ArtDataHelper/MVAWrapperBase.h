@@ -10,6 +10,7 @@
 #define ANAB_MVAWRAPPERBASE_H
 
 #include "canvas/Persistency/Common/Ptr.h"
+#include "cetlib_except/exception.h"
 
 #include "lardataobj/AnalysisBase/MVAOutput.h"
 
@@ -17,7 +18,13 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 namespace anab {
 
@@ -30,6 +37,27 @@ protected:
     std::string getProductName(std::type_info const & ti) const;
     size_t getProductHash(std::type_info const & ti) const { return ti.hash_code(); }
 
+    /// Convert the bit pattern of an IEEE 754 half precision number into float.
+    static float halfToFloat(std::uint16_t h)
+    {
+        std::uint32_t const sign = std::uint32_t(h & 0x8000u) << 16;
+        std::uint32_t const exponent = (h >> 10) & 0x1Fu;
+        std::uint32_t const mantissa = h & 0x3FFu;
+
+        if (exponent == 0) // zero or subnormal
+        {
+            float const value = std::ldexp(float(mantissa), -24);
+            return sign? -value: value;
+        }
+
+        std::uint32_t const bits = (exponent == 0x1Fu)
+            ? (sign | 0x7F800000u | (mantissa << 13))                // inf or NaN
+            : (sign | ((exponent + 112u) << 23) | (mantissa << 13)); // normal
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
 };
 
 /// Helper functions for MVAReader and MVAWriter wrappers.
@@ -38,6 +66,19 @@ public:
 
 protected:
 
+    /// True if F can be used as the weighting function of items of type T.
+    template <class T, class F>
+    static constexpr bool isWeightFunction()
+    {
+        return std::is_invocable_r<float, F &, T const &>::value
+            || std::is_invocable_r<float, F &, art::Ptr<T> const &>::value;
+    }
+
+    /// True if F can be used as the weighting function of items given by keys.
+    template <class F>
+    static constexpr bool isKeyWeightFunction()
+    { return std::is_invocable_r<float, F &, size_t>::value; }
+
     // all mva outputs in the feature vecor sum up to p=1
 
     template <class T, size_t N>
@@ -60,6 +101,31 @@ protected:
         std::vector< art::Ptr<T> > const & items, std::function<float (art::Ptr<T> const &)> fweight,
         std::vector< FeatureVector<N> > const & outs) const;
 
+    /// Weighting with any callable taking T const & or art::Ptr<T> const &; the call is
+    /// resolved at compile time and can be inlined (no std::function in the loop).
+    template <class T, size_t N, class F, typename = std::enable_if_t< isWeightFunction<T, F>() > >
+    std::array<float, N> pAccumulate(
+        std::vector< art::Ptr<T> > const & items, F && fweight,
+        std::vector< FeatureVector<N> > const & outs) const;
+
+    // the same, for items given by nKeys indices (keys) into outs,
+    // with optional weights (array of nKeys values, or callable taking the key)
+
+    template <size_t N>
+    std::array<float, N> pAccumulate(
+        size_t const * keys, size_t nKeys,
+        std::vector< FeatureVector<N> > const & outs) const;
+
+    template <size_t N>
+    std::array<float, N> pAccumulate(
+        size_t const * keys, size_t nKeys, float const * weights,
+        std::vector< FeatureVector<N> > const & outs) const;
+
+    template <size_t N, class F, typename = std::enable_if_t< isKeyWeightFunction<F>() > >
+    std::array<float, N> pAccumulate(
+        size_t const * keys, size_t nKeys, F && fweight,
+        std::vector< FeatureVector<N> > const & outs) const;
+
     // outputs in the feature vecor sum up to p=1 in groups:
     // - members of a group are tagged in the mask with the same non-negative number
     // - entries with negative tag in the mask are ignored
@@ -69,63 +135,98 @@ protected:
         std::vector< art::Ptr<T> > const & items,
         std::vector< FeatureVector<N> > const & outs,
         std::array<char, N> const & mask) const;
-};
 
-} // namespace anab
+    /// Masked accumulation for many objects in one call (eg. over the hits of each
+    /// cluster): the groups are set up once, result is resized to the number of objects.
+    template <class T, size_t N>
+    void pAccumulate(
+        std::vector< std::vector< art::Ptr<T> > > const & objects,
+        std::vector< FeatureVector<N> > const & outs,
+        std::array<char, N> const & mask,
+        std::vector< std::array<float, N> > & result) const;
+
+    /// Number of distinct non-negative mask labels (the bounded label range).
+    static constexpr size_t MaxMaskLabels = size_t(std::numeric_limits<char>::max()) + 1;
+
+    /// Set the group index of each output (negative if ignored) and the number of
+    /// outputs in each group, for the mask; returns the number of groups. Labels
+    /// index a dense array, so there are no allocations.
+    template <size_t N>
+    static size_t maskGroups(std::array<char, N> const & mask,
+        std::array<int, N> & groupidx, std::array<size_t, N> & nb_entries);
+
+    // batch queries: they work in a single pass on the feature vectors, with
+    // the loops over the N outputs known at compile time (vectorizable), and
+    // write into the provided result containers, which can be reused
+
+    /// Index of the highest output of each vector in outs.
+    template <size_t N>
+    void pArgMax(
+        std::vector< FeatureVector<N> > const & outs,
+        std::vector<size_t> & result) const;
 
-//----------------------------------------------------------------------------
-// MVAReader functions.
-//
-template <class T, size_t N>
-std::array<float, N> anab::MVAWrapperBase::pAccumulate(
-    std::vector< art::Ptr<T> > const & items,
-    std::vector< anab::FeatureVector<N> > const & outs) const
-{
-    std::array<double, N> acc;
-    acc.fill(0);
+    /// Index of the highest output of the vector of each of the items.
+    template <class T, size_t N>
+    void pArgMax(
+        std::vector< art::Ptr<T> > const & items,
+        std::vector< FeatureVector<N> > const & outs,
+        std::vector<size_t> & result) const;
 
-	float pmin = 1.0e-6, pmax = 1.0 - pmin;
-	float log_pmin = std::log(pmin), log_pmax = std::log(pmax);
+    /// For each vector in outs, whether the output at index column is above threshold.
+    template <size_t N>
+    void pMask(
+        std::vector< FeatureVector<N> > const & outs,
+        size_t column, float threshold,
+        std::vector<char> & result) const;
 
-	for (auto const & ptr : items)
-	{
-		auto const & vout = outs[ptr.key()];
-		for (size_t i = 0; i < vout.size(); ++i)
-		{
-		    float v;
-			if (vout[i] < pmin) v = log_pmin;
-			else if (vout[i] > pmax) v = log_pmax;
-			else v = std::log(vout[i]);
+    /// Arithmetic mean of the outputs of the items (zero if no items).
+    template <class T, size_t N>
+    std::array<float, N> pAverage(
+        std::vector< art::Ptr<T> > const & items,
+        std::vector< FeatureVector<N> > const & outs) const;
 
-			acc[i] += v;
-		}
-	}
+    /// Weighted arithmetic mean of the outputs of the items (zero if no weight).
+    template <class T, size_t N>
+    std::array<float, N> pAverage(
+        std::vector< art::Ptr<T> > const & items, std::vector<float> const & weights,
+        std::vector< FeatureVector<N> > const & outs) const;
 
-	if (!items.empty())
-	{
-		double totp = 0.0;
-		for (size_t i = 0; i < N; ++i)
-		{
-			acc[i] = exp(acc[i] / items.size());
-			totp += acc[i];
-		}
-		for (size_t i = 0; i < N; ++i)
-		{
-			acc[i] /= totp;
-		}
-	}
-	else std::fill(acc.begin(), acc.end(), 1.0 / N);
+    /// Index of the highest of the N outputs in vout.
+    template <size_t N>
+    static size_t argMax(FeatureVector<N> const & vout)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < N; ++i) { if (vout[i] > vout[best]) best = i; }
+        return best;
+    }
 
+private:
 
-    std::array<float, N> result;
-    for (size_t i = 0; i < N; ++i) result[i] = acc[i];
-    return result;
-}
-//----------------------------------------------------------------------------
+    /// Log-probability accumulation of the outputs outs[key(k)] with the weights weight(k),
+    /// for k = 0...n-1; key and weight are plain callables, so they are inlined in the loop.
+    template <size_t N, class Key, class Weight>
+    std::array<float, N> pAccumulateCore(
+        size_t n, Key && key, Weight && weight,
+        std::vector< FeatureVector<N> > const & outs) const;
 
-template <class T, size_t N>
-std::array<float, N> anab::MVAWrapperBase::pAccumulate(
-    std::vector< art::Ptr<T> > const & items, std::vector<float> const & weights,
+    /// Log-probability accumulation of the outputs outs[key(k)], k = 0...n-1,
+    /// normalized in the groups prepared with maskGroups().
+    template <size_t N, class Key>
+    std::array<float, N> pAccumulateMasked(
+        size_t n, Key && key,
+        std::vector< FeatureVector<N> > const & outs,
+        std::array<int, N> const & groupidx, size_t n_groups,
+        std::array<size_t, N> const & nb_entries) const;
+};
+
+} // namespace anab
+
+//----------------------------------------------------------------------------
+// MVAReader functions.
+//
+template <size_t N, class Key, class Weight>
+std::array<float, N> anab::MVAWrapperBase::pAccumulateCore(
+    size_t n, Key && key, Weight && weight,
     std::vector< anab::FeatureVector<N> > const & outs) const
 {
     std::array<double, N> acc;
@@ -135,15 +236,14 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 	float log_pmin = std::log(pmin), log_pmax = std::log(pmax);
 	double totw = 0.0;
 
-	for (size_t k = 0; k < items.size(); ++k)
+	for (size_t k = 0; k < n; ++k)
 	{
-	    auto const & ptr = items[k];
-		float w = weights[k];
+		float w = weight(k);
 
 		if (w == 0) continue;
 
-		auto const & vout = outs[ptr.key()];
-		for (size_t i = 0; i < vout.size(); ++i)
+		auto const & vout = outs[key(k)];
+		for (size_t i = 0; i < N; ++i)
 		{
 		    float v;
 			if (vout[i] < pmin) v = log_pmin;
@@ -155,7 +255,7 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 		totw += w;
 	}
 
-	if (!items.empty())
+	if (n)
 	{
 		double totp = 0.0;
 		for (size_t i = 0; i < N; ++i)
@@ -179,55 +279,34 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 
 template <class T, size_t N>
 std::array<float, N> anab::MVAWrapperBase::pAccumulate(
-    std::vector< art::Ptr<T> > const & items, std::function<float (T const &)> fweight,
+    std::vector< art::Ptr<T> > const & items,
     std::vector< anab::FeatureVector<N> > const & outs) const
 {
-    std::array<double, N> acc;
-    acc.fill(0);
-
-	float pmin = 1.0e-6, pmax = 1.0 - pmin;
-	float log_pmin = std::log(pmin), log_pmax = std::log(pmax);
-	double totw = 0.0;
-
-	for (size_t k = 0; k < items.size(); ++k)
-	{
-	    auto const & ptr = items[k];
-		float w = fweight(*ptr);
-
-		if (w == 0) continue;
-
-		auto const & vout = outs[ptr.key()];
-		for (size_t i = 0; i < vout.size(); ++i)
-		{
-		    float v;
-			if (vout[i] < pmin) v = log_pmin;
-			else if (vout[i] > pmax) v = log_pmax;
-			else v = std::log(vout[i]);
-
-			acc[i] += w * v;
-		}
-		totw += w;
-	}
-
-	if (!items.empty())
-	{
-		double totp = 0.0;
-		for (size_t i = 0; i < N; ++i)
-		{
-			acc[i] = exp(acc[i] / totw);
-			totp += acc[i];
-		}
-		for (size_t i = 0; i < N; ++i)
-		{
-			acc[i] /= totp;
-		}
-	}
-	else std::fill(acc.begin(), acc.end(), 1.0 / N);
+    return pAccumulateCore(items.size(),
+        [&items](size_t k) { return items[k].key(); },
+        [](size_t) { return 1.0F; }, outs);
+}
+//----------------------------------------------------------------------------
 
+template <class T, size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    std::vector< art::Ptr<T> > const & items, std::vector<float> const & weights,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    return pAccumulateCore(items.size(),
+        [&items](size_t k) { return items[k].key(); },
+        [&weights](size_t k) { return weights[k]; }, outs);
+}
+//----------------------------------------------------------------------------
 
-    std::array<float, N> result;
-    for (size_t i = 0; i < N; ++i) result[i] = acc[i];
-    return result;
+template <class T, size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    std::vector< art::Ptr<T> > const & items, std::function<float (T const &)> fweight,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    return pAccumulateCore(items.size(),
+        [&items](size_t k) { return items[k].key(); },
+        [&items, &fweight](size_t k) { return fweight(*items[k]); }, outs);
 }
 //----------------------------------------------------------------------------
 
@@ -236,52 +315,61 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
     std::vector< art::Ptr<T> > const & items, std::function<float (art::Ptr<T> const &)> fweight,
     std::vector< anab::FeatureVector<N> > const & outs) const
 {
-    std::array<double, N> acc;
-    acc.fill(0);
-
-	float pmin = 1.0e-6, pmax = 1.0 - pmin;
-	float log_pmin = std::log(pmin), log_pmax = std::log(pmax);
-	double totw = 0.0;
-
-	for (size_t k = 0; k < items.size(); ++k)
-	{
-	    auto const & ptr = items[k];
-		float w = fweight(ptr);
-
-		if (w == 0) continue;
-
-		auto const & vout = outs[ptr.key()];
-		for (size_t i = 0; i < vout.size(); ++i)
-		{
-		    float v;
-			if (vout[i] < pmin) v = log_pmin;
-			else if (vout[i] > pmax) v = log_pmax;
-			else v = std::log(vout[i]);
+    return pAccumulateCore(items.size(),
+        [&items](size_t k) { return items[k].key(); },
+        [&items, &fweight](size_t k) { return fweight(items[k]); }, outs);
+}
+//----------------------------------------------------------------------------
 
-			acc[i] += w * v;
-		}
-		totw += w;
-	}
+template <class T, size_t N, class F, typename>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    std::vector< art::Ptr<T> > const & items, F && fweight,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    auto key = [&items](size_t k) { return items[k].key(); };
+    if constexpr (std::is_invocable_r<float, F &, T const &>::value)
+    {
+        return pAccumulateCore(items.size(), key,
+            [&items, &fweight](size_t k) -> float { return fweight(*items[k]); }, outs);
+    }
+    else
+    {
+        return pAccumulateCore(items.size(), key,
+            [&items, &fweight](size_t k) -> float { return fweight(items[k]); }, outs);
+    }
+}
+//----------------------------------------------------------------------------
 
-	if (!items.empty())
-	{
-		double totp = 0.0;
-		for (size_t i = 0; i < N; ++i)
-		{
-			acc[i] = exp(acc[i] / totw);
-			totp += acc[i];
-		}
-		for (size_t i = 0; i < N; ++i)
-		{
-			acc[i] /= totp;
-		}
-	}
-	else std::fill(acc.begin(), acc.end(), 1.0 / N);
+template <size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    size_t const * keys, size_t nKeys,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    return pAccumulateCore(nKeys,
+        [keys](size_t k) { return keys[k]; },
+        [](size_t) { return 1.0F; }, outs);
+}
+//----------------------------------------------------------------------------
 
+template <size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    size_t const * keys, size_t nKeys, float const * weights,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    return pAccumulateCore(nKeys,
+        [keys](size_t k) { return keys[k]; },
+        [weights](size_t k) { return weights[k]; }, outs);
+}
+//----------------------------------------------------------------------------
 
-    std::array<float, N> result;
-    for (size_t i = 0; i < N; ++i) result[i] = acc[i];
-    return result;
+template <size_t N, class F, typename>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    size_t const * keys, size_t nKeys, F && fweight,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    return pAccumulateCore(nKeys,
+        [keys](size_t k) { return keys[k]; },
+        [keys, &fweight](size_t k) -> float { return fweight(keys[k]); }, outs);
 }
 //----------------------------------------------------------------------------
 
@@ -289,48 +377,48 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 // functions with the mask tagging groups og labels
 //----------------------------------------------------------------------------
 
-template <class T, size_t N>
-std::array<float, N> anab::MVAWrapperBase::pAccumulate(
-    std::vector< art::Ptr<T> > const & items,
-    std::vector< anab::FeatureVector<N> > const & outs,
-    std::array<char, N> const & mask) const
+template <size_t N>
+size_t anab::MVAWrapperBase::maskGroups(std::array<char, N> const & mask,
+    std::array<int, N> & groupidx, std::array<size_t, N> & nb_entries)
 {
+    std::array<int, MaxMaskLabels> label2group;
+    label2group.fill(-1);
+    nb_entries.fill(0);
+
     size_t n_groups = 0;
-    std::unordered_map<char, size_t> label2group;
-    std::vector<size_t> nb_entries;
-    std::array<int, N> groupidx;
     for (size_t i = 0; i < N; ++i)
     {
         int idx = -1;
         if (mask[i] >= 0)
         {
-            auto search = label2group.find(mask[i]);
-            if (search == label2group.end())
-            {
-                idx = n_groups;
-                label2group[mask[i]] = idx;
-                nb_entries.push_back(0);
-                ++n_groups;
-            }
-            else
-            {
-                idx = search->second;
-                nb_entries[idx]++;
-            }
+            int & group = label2group[size_t(mask[i])];
+            if (group < 0) { group = n_groups++; }
+            idx = group;
+            nb_entries[idx]++;
         }
         groupidx[i] = idx;
     }
+    return n_groups;
+}
+//----------------------------------------------------------------------------
 
+template <size_t N, class Key>
+std::array<float, N> anab::MVAWrapperBase::pAccumulateMasked(
+    size_t n, Key && key,
+    std::vector< anab::FeatureVector<N> > const & outs,
+    std::array<int, N> const & groupidx, size_t n_groups,
+    std::array<size_t, N> const & nb_entries) const
+{
     std::array<double, N> acc;
     acc.fill(0);
 
 	float pmin = 1.0e-6, pmax = 1.0 - pmin;
 	float log_pmin = std::log(pmin), log_pmax = std::log(pmax);
 
-	for (auto const & ptr : items)
+	for (size_t k = 0; k < n; ++k)
 	{
-		auto const & vout = outs[ptr.key()];
-		for (size_t i = 0; i < vout.size(); ++i)
+		auto const & vout = outs[key(k)];
+		for (size_t i = 0; i < N; ++i)
 		{
 		    if (groupidx[i] < 0) continue;
 
@@ -343,14 +431,15 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 		}
 	}
 
-	if (!items.empty())
+	if (n)
 	{
-		std::vector<double> totp(n_groups, 0.0);
+		std::array<double, N> totp;
+		std::fill(totp.begin(), totp.begin() + n_groups, 0.0);
 		for (size_t i = 0; i < N; ++i)
 		{
 		    if (groupidx[i] >= 0)
             {
-    			acc[i] = exp(acc[i] / items.size());
+    			acc[i] = exp(acc[i] / n);
 	    		totp[groupidx[i]] += acc[i];
 	        }
 		}
@@ -363,7 +452,7 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 	{
 	    for (size_t i = 0; i < N; ++i)
 	    {
-	         if (groupidx[i] >= 0) { acc[i] = 1 / nb_entries[groupidx[i]]; }
+	         if (groupidx[i] >= 0) { acc[i] = 1.0 / nb_entries[groupidx[i]]; }
 	    }
     }
 
@@ -373,4 +462,133 @@ std::array<float, N> anab::MVAWrapperBase::pAccumulate(
 }
 //----------------------------------------------------------------------------
 
+template <class T, size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAccumulate(
+    std::vector< art::Ptr<T> > const & items,
+    std::vector< anab::FeatureVector<N> > const & outs,
+    std::array<char, N> const & mask) const
+{
+    std::array<int, N> groupidx;
+    std::array<size_t, N> nb_entries;
+    size_t n_groups = maskGroups(mask, groupidx, nb_entries);
+
+    return pAccumulateMasked(items.size(),
+        [&items](size_t k) { return items[k].key(); },
+        outs, groupidx, n_groups, nb_entries);
+}
+//----------------------------------------------------------------------------
+
+template <class T, size_t N>
+void anab::MVAWrapperBase::pAccumulate(
+    std::vector< std::vector< art::Ptr<T> > > const & objects,
+    std::vector< anab::FeatureVector<N> > const & outs,
+    std::array<char, N> const & mask,
+    std::vector< std::array<float, N> > & result) const
+{
+    std::array<int, N> groupidx;
+    std::array<size_t, N> nb_entries;
+    size_t n_groups = maskGroups(mask, groupidx, nb_entries);
+
+    result.resize(objects.size());
+    for (size_t j = 0; j < objects.size(); ++j)
+    {
+        auto const & items = objects[j];
+        result[j] = pAccumulateMasked(items.size(),
+            [&items](size_t k) { return items[k].key(); },
+            outs, groupidx, n_groups, nb_entries);
+    }
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// batch queries
+//----------------------------------------------------------------------------
+
+template <size_t N>
+void anab::MVAWrapperBase::pArgMax(
+    std::vector< anab::FeatureVector<N> > const & outs,
+    std::vector<size_t> & result) const
+{
+    result.resize(outs.size());
+    for (size_t k = 0; k < outs.size(); ++k) { result[k] = argMax(outs[k]); }
+}
+//----------------------------------------------------------------------------
+
+template <class T, size_t N>
+void anab::MVAWrapperBase::pArgMax(
+    std::vector< art::Ptr<T> > const & items,
+    std::vector< anab::FeatureVector<N> > const & outs,
+    std::vector<size_t> & result) const
+{
+    result.resize(items.size());
+    for (size_t k = 0; k < items.size(); ++k) { result[k] = argMax(outs[items[k].key()]); }
+}
+//----------------------------------------------------------------------------
+
+template <size_t N>
+void anab::MVAWrapperBase::pMask(
+    std::vector< anab::FeatureVector<N> > const & outs,
+    size_t column, float threshold,
+    std::vector<char> & result) const
+{
+    if (column >= N)
+    {
+        throw cet::exception("MVAWrapperBase") << "Output index " << column << " out of range, only " << N << " outputs." << std::endl;
+    }
+    result.resize(outs.size());
+    for (size_t k = 0; k < outs.size(); ++k) { result[k] = (outs[k][column] > threshold); }
+}
+//----------------------------------------------------------------------------
+
+template <class T, size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAverage(
+    std::vector< art::Ptr<T> > const & items,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    std::array<float, N> acc;
+    acc.fill(0);
+
+    for (auto const & ptr : items)
+    {
+        auto const & vout = outs[ptr.key()];
+        for (size_t i = 0; i < N; ++i) { acc[i] += vout[i]; }
+    }
+
+    if (!items.empty())
+    {
+        float const norm = 1.0F / items.size();
+        for (size_t i = 0; i < N; ++i) { acc[i] *= norm; }
+    }
+    return acc;
+}
+//----------------------------------------------------------------------------
+
+template <class T, size_t N>
+std::array<float, N> anab::MVAWrapperBase::pAverage(
+    std::vector< art::Ptr<T> > const & items, std::vector<float> const & weights,
+    std::vector< anab::FeatureVector<N> > const & outs) const
+{
+    std::array<float, N> acc;
+    acc.fill(0);
+    double totw = 0.0;
+
+    for (size_t k = 0; k < items.size(); ++k)
+    {
+        float const w = weights[k];
+        if (w == 0) continue;
+
+        auto const & vout = outs[items[k].key()];
+        for (size_t i = 0; i < N; ++i) { acc[i] += w * vout[i]; }
+        totw += w;
+    }
+
+    if (totw != 0.0)
+    {
+        float const norm = 1.0 / totw;
+        for (size_t i = 0; i < N; ++i) { acc[i] *= norm; }
+    }
+    return acc;
+}
+//----------------------------------------------------------------------------
+
 #endif //ANAB_MVAWRAPPERBASE
@@ -15,6 +15,12 @@
 
 #include "lardata/ArtDataHelper/MVAWrapperBase.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
 namespace anab {
 
 /// Index to the MVA output / FeatureVector collection, used when result vectors are added or set.
@@ -63,7 +69,8 @@ public:
 
     /// Initialize container for FeatureVectors and, if not yet done, the container for
     /// metadata, then creates metadata for data products of type T. FeatureVector container
-    /// is initialized as EMPTY and vectors should be added with addOutput() function.
+    /// is initialized as EMPTY and vectors should be added with addOutput() function; its
+    /// capacity is reserved for as many vectors as were saved for T in the previous event.
     /// Returns index of collection which should be used when adding actual output values.
     template <class T>
     FVector_ID initOutputs(art::InputTag const & dataTag,
@@ -75,11 +82,32 @@ public:
         std::vector< std::string > const & names = std::vector< std::string >(N, ""))
     { return initOutputs<T>(std::string(""), 0, names); }
 
+    /// Reserve capacity for nVectors feature vectors in the container (eg. the size of the
+    /// input collection, when it is known better than from the previous event).
+    void reserve(FVector_ID id, size_t nVectors) { fVectors[id]->reserve(nVectors); }
+
     void addVector(FVector_ID id, std::array<float, N> const & values) { fVectors[id]->emplace_back(values); }
     void addVector(FVector_ID id, std::array<double, N> const & values) { fVectors[id]->emplace_back(values); }
     void addVector(FVector_ID id, std::vector<float> const & values) { fVectors[id]->emplace_back(values); }
     void addVector(FVector_ID id, std::vector<double> const & values) { fVectors[id]->emplace_back(values); }
 
+    /// Set nVectors consecutive feature vectors, starting at index "key", from a contiguous
+    /// buffer of nVectors x N values, one vector after the other (e.g. the output batch of
+    /// an inference engine). The container has to be initialized to hold these vectors.
+    void setVectors(FVector_ID id, size_t key, float const * values, size_t nVectors);
+
+    /// Same as above, for a buffer of IEEE 754 half precision (float16) values, given as
+    /// their bit patterns; values are stored in the feature vectors as float.
+    void setVectors(FVector_ID id, size_t key, std::uint16_t const * values, size_t nVectors);
+
+    /// Add nVectors feature vectors from a contiguous buffer of nVectors x N values.
+    void addVectors(FVector_ID id, float const * values, size_t nVectors)
+    { setVectors(id, growBy(id, nVectors), values, nVectors); }
+
+    /// Add nVectors feature vectors from a contiguous buffer of nVectors x N float16 values.
+    void addVectors(FVector_ID id, std::uint16_t const * values, size_t nVectors)
+    { setVectors(id, growBy(id, nVectors), values, nVectors); }
+
     /// Set tag of associated data products in case it was not ready at the initialization time.
     void setDataTag(FVector_ID id, art::InputTag const & dataTag) { (*fDescriptions)[id].setDataTag(dataTag.encode()); }
 
@@ -140,6 +168,11 @@ private:
 
     std::unordered_map< size_t, FVector_ID > fTypeHashToID;
 
+    /// Number of vectors saved for each data type (by type hash) in the previous event;
+    /// art takes the ownership of the saved containers, so their memory can not be reused,
+    /// but their size is the best prediction of the capacity needed in the next event.
+    std::unordered_map< size_t, size_t > fSizeHints;
+
     std::unique_ptr< std::vector< anab::FVecDescription<N> > > fDescriptions;
     void clearEventData()
     {
@@ -147,6 +180,17 @@ private:
         fDescriptions.reset(nullptr);
     }
 
+    /// Add nVectors zero-initialized vectors to the container; return index of the first one.
+    size_t growBy(FVector_ID id, size_t nVectors)
+    {
+        size_t const key = fVectors[id]->size();
+        fVectors[id]->resize(key + nVectors, anab::FeatureVector<N>(0.0F));
+        return key;
+    }
+
+    /// Check that the vectors from key to key + nVectors are in the container.
+    void checkRange(FVector_ID id, size_t key, size_t nVectors) const;
+
     /// Check if the the writer is configured to write results for data product type name.
     bool dataTypeRegistered(const std::string & dname) const;
     /// Check if the containers for results prepared for "tname" data type are ready.
@@ -182,6 +226,14 @@ public:
     void addOutput(FVector_ID id, std::vector<float> const & values) { FVectorWriter<N>::addVector(id, values); }
     void addOutput(FVector_ID id, std::vector<double> const & values) { FVectorWriter<N>::addVector(id, values); }
 
+    /// Set or add the outputs of nVectors objects from a contiguous buffer of nVectors x N values
+    /// (float, or float16 bit patterns), e.g. the output of a whole batch of the MVA model.
+    void setOutputs(FVector_ID id, size_t key, float const * values, size_t nVectors) { FVectorWriter<N>::setVectors(id, key, values, nVectors); }
+    void setOutputs(FVector_ID id, size_t key, std::uint16_t const * values, size_t nVectors) { FVectorWriter<N>::setVectors(id, key, values, nVectors); }
+
+    void addOutputs(FVector_ID id, float const * values, size_t nVectors) { FVectorWriter<N>::addVectors(id, values, nVectors); }
+    void addOutputs(FVector_ID id, std::uint16_t const * values, size_t nVectors) { FVectorWriter<N>::addVectors(id, values, nVectors); }
+
 
     /// Get MVA results accumulated over the vector of items (eg. over hits associated to a cluster).
     /// NOTE: MVA outputs for these items has to be added to the MVAWriter first!
@@ -212,6 +264,23 @@ public:
         std::function<float (art::Ptr<T> const &)> fweight) const
     { return pAccumulate<T, N>(items, fweight, *(FVectorWriter<N>::fVectors[FVectorWriter<N>::template getProductID<T>()])); }
 
+    /// Get MVA results accumulated with any callable weighting function (taking T const &
+    /// or art::Ptr<T> const &), which is inlined in the accumulation loop.
+    /// NOTE: MVA outputs for these items has to be added to the MVAWriter first!
+    template <class T, class F, typename = std::enable_if_t< MVAWrapperBase::isWeightFunction<T, F>() > >
+    std::array<float, N> getOutput(std::vector< art::Ptr<T> > const & items, F && fweight) const
+    { return pAccumulate<T, N>(items, std::forward<F>(fweight), *(FVectorWriter<N>::fVectors[FVectorWriter<N>::template getProductID<T>()])); }
+
+    /// Get MVA results for the type T accumulated over the nKeys items at indices keys,
+    /// optionally weighted with an array of nKeys weights.
+    /// NOTE: MVA outputs for these items has to be added to the MVAWriter first!
+    template <class T>
+    std::array<float, N> getOutput(size_t const * keys, size_t nKeys, float const * weights = nullptr) const
+    {
+        auto const & outs = *(FVectorWriter<N>::fVectors[FVectorWriter<N>::template getProductID<T>()]);
+        return weights? pAccumulate<N>(keys, nKeys, weights, outs): pAccumulate<N>(keys, nKeys, outs);
+    }
+
     /// Get copy of the MVA output vector for the type T, at index "key".
     template <class T>
     std::array<float, N> getOutput(size_t key) const { return FVectorWriter<N>::template getVector<T>(key); }
@@ -304,6 +373,8 @@ anab::FVector_ID anab::FVectorWriter<N>::initOutputs(
     if (!fDescriptions)
     {
         fDescriptions = std::make_unique< std::vector< anab::FVecDescription<N> > >();
+        fDescriptions->reserve(fRegisteredDataTypes.size());
+        fVectors.reserve(fRegisteredDataTypes.size());
     }
     else if (descriptionExists(dataName))
     {
@@ -316,11 +387,67 @@ anab::FVector_ID anab::FVectorWriter<N>::initOutputs(
     fTypeHashToID[dataHash] = id;
 
     if (dataSize) { fVectors[id]->resize(dataSize, anab::FeatureVector<N>(0.0F)); }
+    else
+    {
+        auto hint = fSizeHints.find(dataHash);
+        if (hint != fSizeHints.end()) { fVectors[id]->reserve(hint->second); }
+    }
 
     return id;
 }
 //----------------------------------------------------------------------------
 
+template <size_t N>
+void anab::FVectorWriter<N>::checkRange(FVector_ID id, size_t key, size_t nVectors) const
+{
+    if (key + nVectors > fVectors[id]->size())
+    {
+        throw cet::exception("FVectorWriter") << "Cannot set " << nVectors << " vectors from index " << key
+            << ", only " << fVectors[id]->size() << " vectors initialized." << std::endl;
+    }
+}
+//----------------------------------------------------------------------------
+
+template <size_t N>
+void anab::FVectorWriter<N>::setVectors(FVector_ID id, size_t key, float const * values, size_t nVectors)
+{
+    checkRange(id, key, nVectors);
+
+    anab::FeatureVector<N>* dest = fVectors[id]->data() + key;
+
+    // FeatureVector<N> is a plain array of N floats: copy the whole block at once
+    if constexpr (std::is_trivially_copyable< anab::FeatureVector<N> >::value
+        && (sizeof(anab::FeatureVector<N>) == N * sizeof(float)))
+    {
+        std::memcpy(static_cast<void*>(dest), values, nVectors * N * sizeof(float));
+    }
+    else
+    {
+        std::array<float, N> vec;
+        for (size_t i = 0; i < nVectors; ++i, values += N)
+        {
+            std::copy(values, values + N, vec.begin());
+            dest[i] = vec;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+
+template <size_t N>
+void anab::FVectorWriter<N>::setVectors(FVector_ID id, size_t key, std::uint16_t const * values, size_t nVectors)
+{
+    checkRange(id, key, nVectors);
+
+    anab::FeatureVector<N>* dest = fVectors[id]->data() + key;
+    std::array<float, N> vec;
+    for (size_t i = 0; i < nVectors; ++i, values += N)
+    {
+        for (size_t j = 0; j < N; ++j) { vec[j] = halfToFloat(values[j]); }
+        dest[i] = vec;
+    }
+}
+//----------------------------------------------------------------------------
+
 template <size_t N>
 void anab::FVectorWriter<N>::saveOutputs(art::Event & evt)
 {
@@ -337,6 +464,8 @@ void anab::FVectorWriter<N>::saveOutputs(art::Event & evt)
         throw cet::exception("FVectorWriter") << "FVecDescription<N> vector length not equal to the number of FeatureVector<N> vectors" << std::endl;
     }
 
+    for (auto const & entry : fTypeHashToID) { fSizeHints[entry.first] = fVectors[entry.second]->size(); }
+
     for (size_t i = 0; i < fVectors.size(); ++i)
     {
         auto const & outInstName = (*fDescriptions)[i].outputInstance();
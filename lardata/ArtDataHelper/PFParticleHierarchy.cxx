@@ -0,0 +1,187 @@
+/**
+ * @file   lardata/ArtDataHelper/PFParticleHierarchy.cxx
+ * @brief  Index of the parent/daughter relations of a PFParticle collection
+ * @date   October 14, 2026
+ * @see    PFParticleHierarchy.h
+ */
+
+// this header
+#include "lardata/ArtDataHelper/PFParticleHierarchy.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max_element(), std::lower_bound(), ...
+#include <tuple>
+
+
+namespace {
+
+  /// IDs up to this many times the number of particles use a dense lookup.
+  constexpr std::size_t DenseIDFactor = 4U;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+recob::PFParticleHierarchy::PFParticleHierarchy
+  (std::vector<recob::PFParticle> const& particles)
+{
+  std::size_t const nParticles = particles.size();
+
+  buildIndex(particles);
+  buildRelations(particles);
+
+  //
+  // subtrees, from the primaries first
+  //
+  fDepths.assign(nParticles, InvalidDepth);
+  fOrderPositions.assign(nParticles, InvalidIndex);
+  fSubtreeSizes.assign(nParticles, 0U);
+  fOrder.reserve(nParticles);
+  std::vector<std::size_t> treeParents(nParticles, InvalidIndex);
+
+  for (std::size_t iPrimary: fPrimaries)
+    placeSubtree(iPrimary, 0U, treeParents);
+
+  fNDisconnected = nParticles - fOrder.size();
+  if (fNDisconnected > 0U) {
+    fConsistent = false;
+    // the orphans are the natural roots of the disconnected groups
+    for (std::size_t iPart = 0; iPart < nParticles; ++iPart) {
+      if ((fOrderPositions[iPart] == InvalidIndex) && (fParents[iPart] == InvalidIndex))
+        placeSubtree(iPart, InvalidDepth, treeParents);
+    }
+    // the rest are in cycles
+    for (std::size_t iPart = 0; iPart < nParticles; ++iPart) {
+      if (fOrderPositions[iPart] == InvalidIndex)
+        placeSubtree(iPart, InvalidDepth, treeParents);
+    }
+  } // if disconnected
+
+  // in depth-first order, all the descendants of a particle come after it
+  for (auto iPart = fOrder.crbegin(); iPart != fOrder.crend(); ++iPart) {
+    ++fSubtreeSizes[*iPart];
+    std::size_t const treeParent = treeParents[*iPart];
+    if (treeParent != InvalidIndex)
+      fSubtreeSizes[treeParent] += fSubtreeSizes[*iPart];
+  } // for
+
+} // recob::PFParticleHierarchy::PFParticleHierarchy()
+
+
+//------------------------------------------------------------------------------
+std::size_t recob::PFParticleHierarchy::index(std::size_t particleID) const {
+
+  if (fSparseIndex.empty()) {
+    return (particleID < fDenseIndex.size())
+      ? fDenseIndex[particleID]: InvalidIndex;
+  }
+
+  auto const iEntry = std::lower_bound(fSparseIndex.cbegin(), fSparseIndex.cend(),
+    particleID, [](auto const& entry, std::size_t ID){ return entry.first < ID; });
+  return ((iEntry != fSparseIndex.cend()) && (iEntry->first == particleID))
+    ? iEntry->second: InvalidIndex;
+
+} // recob::PFParticleHierarchy::index()
+
+
+//------------------------------------------------------------------------------
+void recob::PFParticleHierarchy::buildIndex
+  (std::vector<recob::PFParticle> const& particles)
+{
+  std::size_t const nParticles = particles.size();
+  if (nParticles == 0U) return;
+
+  std::size_t const maxID = std::max_element(particles.cbegin(), particles.cend(),
+    [](auto const& a, auto const& b){ return a.Self() < b.Self(); }
+    )->Self();
+
+  if (maxID < DenseIDFactor * nParticles) {
+    fDenseIndex.assign(maxID + 1, InvalidIndex);
+    for (std::size_t iPart = 0; iPart < nParticles; ++iPart) {
+      std::size_t& pos = fDenseIndex[particles[iPart].Self()];
+      if (pos == InvalidIndex) pos = iPart;
+      else fConsistent = false; // duplicate ID: the first particle wins
+    } // for
+  }
+  else {
+    fSparseIndex.reserve(nParticles);
+    for (std::size_t iPart = 0; iPart < nParticles; ++iPart)
+      fSparseIndex.emplace_back(particles[iPart].Self(), iPart);
+    std::sort(fSparseIndex.begin(), fSparseIndex.end());
+    auto const newEnd = std::unique(fSparseIndex.begin(), fSparseIndex.end(),
+      [](auto const& a, auto const& b){ return a.first == b.first; });
+    if (newEnd != fSparseIndex.end()) fConsistent = false;
+    fSparseIndex.erase(newEnd, fSparseIndex.end());
+  }
+
+} // recob::PFParticleHierarchy::buildIndex()
+
+
+//------------------------------------------------------------------------------
+void recob::PFParticleHierarchy::buildRelations
+  (std::vector<recob::PFParticle> const& particles)
+{
+  std::size_t const nParticles = particles.size();
+  fParents.assign(nParticles, InvalidIndex);
+  fDaughterOffsets.reserve(nParticles + 1);
+
+  std::size_t nWithParent = 0U; // particles with a parent in the collection
+  std::size_t nClaimed = 0U; // ... and listed among the parent daughters
+  for (std::size_t iPart = 0; iPart < nParticles; ++iPart) {
+    recob::PFParticle const& particle = particles[iPart];
+
+    if (particle.IsPrimary()) fPrimaries.push_back(iPart);
+    else {
+      fParents[iPart] = index(particle.Parent());
+      if (fParents[iPart] == InvalidIndex) fConsistent = false;
+      else ++nWithParent;
+    }
+
+    for (std::size_t daughterID: particle.Daughters()) {
+      std::size_t const iDaughter = index(daughterID);
+      if ((iDaughter == InvalidIndex) || (iDaughter == iPart)) {
+        fConsistent = false;
+        continue;
+      }
+      fDaughters.push_back(iDaughter);
+      if (particles[iDaughter].Parent() == particle.Self()) ++nClaimed;
+      else fConsistent = false;
+    } // for daughters
+    fDaughterOffsets.push_back(fDaughters.size());
+  } // for particles
+
+  if (nClaimed != nWithParent) fConsistent = false;
+
+} // recob::PFParticleHierarchy::buildRelations()
+
+
+//------------------------------------------------------------------------------
+void recob::PFParticleHierarchy::placeSubtree(
+  std::size_t root, unsigned int rootDepth,
+  std::vector<std::size_t>& treeParents
+) {
+  // particle, its depth and the particle it is reached from
+  std::vector<std::tuple<std::size_t, unsigned int, std::size_t>> stack;
+  stack.emplace_back(root, rootDepth, InvalidIndex);
+  while (!stack.empty()) {
+    auto const [ iPart, depth, treeParent ] = stack.back();
+    stack.pop_back();
+    if (fOrderPositions[iPart] != InvalidIndex) {
+      fConsistent = false; // reached again: more parents, or a cycle
+      continue;
+    }
+    fOrderPositions[iPart] = fOrder.size();
+    fOrder.push_back(iPart);
+    fDepths[iPart] = depth;
+    treeParents[iPart] = treeParent;
+
+    // daughters are pushed in reverse, to be visited in their order
+    unsigned int const daughterDepth
+      = (depth == InvalidDepth)? InvalidDepth: depth + 1;
+    for (std::size_t i = fDaughterOffsets[iPart + 1]; i-- > fDaughterOffsets[iPart];)
+      stack.emplace_back(fDaughters[i], daughterDepth, iPart);
+  } // while
+} // recob::PFParticleHierarchy::placeSubtree()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+/**
+ * @file   lardata/ArtDataHelper/PFParticleHierarchy.h
+ * @brief  Index of the parent/daughter relations of a PFParticle collection
+ * @date   October 14, 2026
+ * @see    PFParticleHierarchy.cxx
+ *         lardata/RecoBaseProxy/PFParticleHierarchyCache.h
+ */
+
+#ifndef LARDATA_ARTDATAHELPER_PFPARTICLEHIERARCHY_H
+#define LARDATA_ARTDATAHELPER_PFPARTICLEHIERARCHY_H
+
+// LArSoft libraries
+#include "lardata/Utilities/CollectionView.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+
+// C/C++ standard libraries
+#include <limits>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace recob {
+
+  /**
+   * @brief Parent/daughter relations of a collection of `recob::PFParticle`.
+   *
+   * The particles refer to each other by their ID (`recob::PFParticle::Self()`),
+   * and every user of the hierarchy needs a lookup from ID to position in the
+   * collection. This object resolves all the relations once, in terms of
+   * positions (_indices_) in the collection:
+   *
+   * * `index(ID)`: the position of the particle with the specified ID
+   * * `parent(i)`: the position of the parent of particle `i`
+   * * `daughters(i)`: the positions of the daughters of particle `i`, in the
+   *   order of `recob::PFParticle::Daughters()`, stored contiguously for all
+   *   particles
+   * * `primaries()`: the positions of all the primary particles, in order
+   * * `depth(i)`: the generation of particle `i` (`0` for primaries)
+   * * `subtree(i)`: particle `i` followed by all its descendants, depth first
+   *
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const& particles
+   *   = *event.getValidHandle<std::vector<recob::PFParticle>>(tag);
+   * recob::PFParticleHierarchy const hierarchy(particles);
+   * for (std::size_t iPrimary: hierarchy.primaries()) {
+   *   for (std::size_t iPart: hierarchy.subtree(iPrimary)) {
+   *     std::cout << std::string(2*hierarchy.depth(iPart), ' ')
+   *       << "particle ID=" << particles[iPart].Self() << std::endl;
+   *   }
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * `proxy::getPFParticleHierarchy()` shares the same object among all the
+   * modules of the event.
+   *
+   * Inconsistent relations
+   * -----------------------
+   *
+   * The relations are taken as declared, and they are not required to be
+   * consistent: a daughter is listed if its parent lists it in
+   * `Daughters()`, a parent is reported if the daughter declares it in
+   * `Parent()`. Daughter and parent IDs of particles not in the collection
+   * are ignored, and so are particles declaring themselves as their own
+   * daughters.
+   *
+   * Depth and subtrees follow the daughter lists from the primary particles:
+   * a particle reached from more than one parent belongs to the subtree of
+   * the first one reaching it (in the order of the primaries, depth first),
+   * and cycles are broken. Particles which can't be reached from any primary
+   * have depth `InvalidDepth`; each group of them is still a subtree rooted in
+   * one of them (preferably one without a parent in the collection).
+   * `isConsistent()` tells whether none of this happened.
+   */
+  class PFParticleHierarchy {
+
+      public:
+
+    /// Value of indices for particles not in the collection.
+    static constexpr std::size_t InvalidIndex
+      = std::numeric_limits<std::size_t>::max();
+
+    /// Depth of particles not descending from any primary particle.
+    static constexpr unsigned int InvalidDepth
+      = std::numeric_limits<unsigned int>::max();
+
+    /// Constructor: empty hierarchy.
+    PFParticleHierarchy() = default;
+
+    /// Constructor: indexes the relations of the specified particles.
+    explicit PFParticleHierarchy
+      (std::vector<recob::PFParticle> const& particles);
+
+    /// Returns the number of particles in the hierarchy.
+    std::size_t size() const { return fParents.size(); }
+
+    /// Returns whether there are no particles in the hierarchy.
+    bool empty() const { return fParents.empty(); }
+
+    /// Returns the position of the particle with ID `particleID`
+    /// (`InvalidIndex` if not present).
+    std::size_t index(std::size_t particleID) const;
+
+    /// Returns whether the particle with `particleID` is in the collection.
+    bool hasParticle(std::size_t particleID) const
+      { return index(particleID) != InvalidIndex; }
+
+    /// Returns the position of the parent of particle `iPart`
+    /// (`InvalidIndex` for primaries and parents not in the collection).
+    std::size_t parent(std::size_t iPart) const { return fParents[iPart]; }
+
+    /// Returns the number of daughters of particle `iPart` in the collection.
+    std::size_t nDaughters(std::size_t iPart) const
+      { return fDaughterOffsets[iPart + 1] - fDaughterOffsets[iPart]; }
+
+    /// Returns the positions of the daughters of particle `iPart`.
+    auto daughters(std::size_t iPart) const
+      {
+        return lar::makeCollectionView(
+          fDaughters.cbegin() + fDaughterOffsets[iPart],
+          fDaughters.cbegin() + fDaughterOffsets[iPart + 1]
+          );
+      }
+
+    /// Returns the positions of all the primary particles.
+    std::vector<std::size_t> const& primaries() const { return fPrimaries; }
+
+    /// Returns the generation of particle `iPart`
+    /// (`0` for primaries, `InvalidDepth` if not descending from one).
+    unsigned int depth(std::size_t iPart) const { return fDepths[iPart]; }
+
+    /// Returns whether particle `iPart` descends from a primary particle.
+    bool isFromPrimary(std::size_t iPart) const
+      { return depth(iPart) != InvalidDepth; }
+
+    /// Returns the number of particles not descending from any primary.
+    std::size_t nDisconnected() const { return fNDisconnected; }
+
+    /// Returns the number of particles in the subtree of `iPart` (including it).
+    std::size_t subtreeSize(std::size_t iPart) const
+      { return fSubtreeSizes[iPart]; }
+
+    /// Returns `iPart` followed by the positions of all its descendants,
+    /// depth first (each daughter right before its own descendants).
+    auto subtree(std::size_t iPart) const
+      {
+        auto const begin = fOrder.cbegin() + fOrderPositions[iPart];
+        return lar::makeCollectionView(begin, begin + fSubtreeSizes[iPart]);
+      }
+
+    /// Returns whether all the relations are consistent: parents and
+    /// daughters agree and are in the collection, and each particle
+    /// descends from exactly one primary through a single path.
+    bool isConsistent() const { return fConsistent; }
+
+
+      private:
+
+    /// Particle IDs with their positions, for sparse IDs (sorted by ID).
+    std::vector<std::pair<std::size_t, std::size_t>> fSparseIndex;
+
+    /// Position of each particle ID, for dense IDs.
+    std::vector<std::size_t> fDenseIndex;
+
+    std::vector<std::size_t> fParents; ///< Position of each parent.
+
+    /// Start of the daughters of each particle in `fDaughters`, plus the end.
+    std::vector<std::size_t> fDaughterOffsets { 0U };
+    std::vector<std::size_t> fDaughters; ///< Daughters of all particles.
+
+    std::vector<std::size_t> fPrimaries; ///< Positions of primary particles.
+    std::vector<unsigned int> fDepths; ///< Generation of each particle.
+
+    std::vector<std::size_t> fOrder; ///< All particles, subtree by subtree.
+    std::vector<std::size_t> fOrderPositions; ///< Position in `fOrder`.
+    std::vector<std::size_t> fSubtreeSizes; ///< Size of each subtree.
+
+    std::size_t fNDisconnected = 0U; ///< Particles not from primaries.
+    bool fConsistent = true; ///< Whether all relations are consistent.
+
+    /// Fills the lookup from particle ID to position.
+    void buildIndex(std::vector<recob::PFParticle> const& particles);
+
+    /// Fills parents and daughters of all particles.
+    void buildRelations(std::vector<recob::PFParticle> const& particles);
+
+    /// Appends the subtree of `root`, made of particles not yet placed;
+    /// records in `treeParents` the particle each one was reached from.
+    void placeSubtree(
+      std::size_t root, unsigned int rootDepth,
+      std::vector<std::size_t>& treeParents
+      );
+
+  }; // class PFParticleHierarchy
+
+} // namespace recob
+
+
+#endif // LARDATA_ARTDATAHELPER_PFPARTICLEHIERARCHY_H
@@ -0,0 +1,410 @@
+/** ****************************************************************************
+ * @file   SignalProcessingPipeline.cxx
+ * @brief  Parallel processing of raw digits into wires - implementation file
+ * @date   October 14, 2026
+ * @see    SignalProcessingPipeline.h
+ *
+ * ****************************************************************************/
+
+// declaration header
+#include "lardata/ArtDataHelper/SignalProcessingPipeline.h"
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/SignalShaping.h"
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RawData/raw.h" // raw::Uncompress()
+
+// framework libraries
+#include "canvas/Utilities/Exception.h"
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+// C/C++ standard library
+#include <algorithm> // std::transform(), std::fill(), std::nth_element()
+#include <chrono>
+#include <iomanip> // std::setw(), std::setprecision()
+#include <ostream>
+
+
+namespace {
+
+  using Clock_t = std::chrono::steady_clock;
+
+  /// Returns the nanoseconds from `start` to `stop`
+  std::uint64_t nanoseconds(Clock_t::time_point start, Clock_t::time_point stop)
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>
+        (stop - start).count();
+    }
+
+  /// Adds an entry of `ns` nanoseconds to the statistics
+  void addEntry(lar::InstrumentationStats_t& stats, std::uint64_t ns) {
+    ++stats.entries;
+    stats.sum += ns;
+    if (ns > stats.max) stats.max = ns;
+  } // addEntry()
+
+  /// Returns the transform size of the kernels, throwing if not consistent
+  std::size_t kernelTransformSize
+    (std::vector<recob::SignalProcessingPipeline::ComplexVector> const& kernels)
+  {
+    if (kernels.empty()) {
+      throw art::Exception(art::errors::Configuration)
+        << "SignalProcessingPipeline: no deconvolution kernel specified\n";
+    }
+    std::size_t const freqSize = kernels.front().size();
+    if (freqSize < 2U) {
+      throw art::Exception(art::errors::Configuration)
+        << "SignalProcessingPipeline: deconvolution kernel of " << freqSize
+        << " elements (not calculated yet?)\n";
+    }
+    for (std::size_t iKernel = 1U; iKernel < kernels.size(); ++iKernel) {
+      if (kernels[iKernel].size() == freqSize) continue;
+      throw art::Exception(art::errors::Configuration)
+        << "SignalProcessingPipeline: deconvolution kernel #" << iKernel
+        << " has " << kernels[iKernel].size() << " elements, kernel #0 "
+        << freqSize << "\n";
+    } // for
+    return 2U * (freqSize - 1U);
+  } // kernelTransformSize()
+
+  /// Returns the deconvolution kernels of the shapers
+  std::vector<recob::SignalProcessingPipeline::ComplexVector> shaperKernels
+    (std::vector<util::SignalShaping const*> const& shapers)
+  {
+    std::vector<recob::SignalProcessingPipeline::ComplexVector> kernels;
+    kernels.reserve(shapers.size());
+    for (util::SignalShaping const* shaper: shapers) {
+      if (!shaper) {
+        throw art::Exception(art::errors::Configuration)
+          << "SignalProcessingPipeline: null signal shaper #" << kernels.size()
+          << "\n";
+      }
+      kernels.push_back(shaper->DeconvKernelD());
+    } // for
+    return kernels;
+  } // shaperKernels()
+
+} // local namespace
+
+
+/// Reconstruction base classes
+namespace recob {
+
+  //----------------------------------------------------------------------
+  struct SignalProcessingPipeline::Workspace_t {
+    util::LArFFTW fft; ///< FFT engine with its own buffers.
+    std::vector<short> adcs; ///< Uncompressed ADC counts.
+    std::vector<short> scratch; ///< Copy of the counts for the median.
+    std::vector<float> waveform; ///< Waveform, then deconvolved signal.
+    std::vector<FlatROI_t> rois; ///< Regions of interest of the channel.
+    std::array<lar::InstrumentationStats_t, NStages> stages; ///< Timing.
+
+    Workspace_t
+      (std::shared_ptr<util::LArFFTWPlan const> plan, std::size_t size)
+      : fft(std::move(plan), 1), waveform(size, 0.0f)
+      {}
+
+  }; // SignalProcessingPipeline::Workspace_t
+
+
+  //----------------------------------------------------------------------
+  std::uint64_t SignalProcessingPipeline::Timing_t::totalTime() const {
+    std::uint64_t total = 0U;
+    for (lar::InstrumentationStats_t const& stats: stages) total += stats.sum;
+    return total;
+  } // SignalProcessingPipeline::Timing_t::totalTime()
+
+
+  //----------------------------------------------------------------------
+  char const* SignalProcessingPipeline::Timing_t::stageName(Stage_t stage) {
+    switch (stage) {
+      case Pedestal:      return "pedestal";
+      case Deconvolution: return "deconvolution";
+      case ROIBuilding:   return "ROI building";
+      case WireOutput:    return "wire output";
+      default:            return "unknown";
+    } // switch
+  } // SignalProcessingPipeline::Timing_t::stageName()
+
+
+  //----------------------------------------------------------------------
+  SignalProcessingPipeline::SignalProcessingPipeline
+    (std::vector<ComplexVector> deconvKernels, Config_t config)
+    : fConfig(std::move(config))
+    , fSize(kernelTransformSize(deconvKernels))
+    , fKernels(std::move(deconvKernels))
+  {
+    if (fConfig.batchSize == 0U) {
+      throw art::Exception(art::errors::Configuration)
+        << "SignalProcessingPipeline: batch size can't be 0\n";
+    }
+
+    if (fConfig.singlePrecision) {
+      fKernelsF.reserve(fKernels.size());
+      for (ComplexVector const& kernel: fKernels)
+        fKernelsF.emplace_back(kernel.begin(), kernel.end());
+    }
+
+    fPlan = util::LArFFTWPlan::Shared(
+      int(fSize), fConfig.fftwOption, 1, "",
+      fConfig.singlePrecision
+        ? util::LArFFTWPlan::kDoubleAndSingle: util::LArFFTWPlan::kDouble
+      );
+  } // SignalProcessingPipeline::SignalProcessingPipeline()
+
+
+  //----------------------------------------------------------------------
+  SignalProcessingPipeline::SignalProcessingPipeline(
+    std::vector<util::SignalShaping const*> const& shapers,
+    Config_t config
+    )
+    : SignalProcessingPipeline(shaperKernels(shapers), std::move(config))
+    {}
+
+
+  //----------------------------------------------------------------------
+  SignalProcessingPipeline::~SignalProcessingPipeline() = default;
+
+
+  //----------------------------------------------------------------------
+  std::unique_ptr<std::vector<recob::Wire>> SignalProcessingPipeline::process(
+    std::vector<raw::RawDigit> const& digits,
+    ChannelSetupFunc_t const& setup
+    )
+  {
+    using Range_t = tbb::blocked_range<std::size_t>;
+
+    Clock_t::time_point const start = Clock_t::now();
+
+    auto wires = std::make_unique<std::vector<recob::Wire>>(digits.size());
+
+    // the simple partitioner splits the channels down to the batch size
+    tbb::parallel_for(
+      Range_t(0U, digits.size(), fConfig.batchSize),
+      [this, &digits, &setup, &wires](Range_t const& batch)
+        {
+          auto const release
+            = [this](Workspace_t* workspace){ releaseWorkspace(workspace); };
+          std::unique_ptr<Workspace_t, decltype(release)> const workspace
+            (acquireWorkspace(), release);
+
+          for (std::size_t i = batch.begin(); i != batch.end(); ++i) {
+            raw::RawDigit const& digit = digits[i];
+            processChannel
+              (*workspace, digit, setup(digit.Channel()), (*wires)[i]);
+          } // for
+        },
+      tbb::simple_partitioner()
+      );
+
+    fWallTime += nanoseconds(start, Clock_t::now());
+    ++fNCalls;
+    return wires;
+  } // SignalProcessingPipeline::process()
+
+
+  //----------------------------------------------------------------------
+  auto SignalProcessingPipeline::timing() const -> Timing_t {
+    Timing_t timing;
+    {
+      std::lock_guard<std::mutex> const lock(fMutex);
+      for (auto const& workspace: fWorkspaces) {
+        for (std::size_t iStage = 0U; iStage < NStages; ++iStage)
+          timing.stages[iStage] += workspace->stages[iStage];
+      } // for
+    }
+    timing.wallTime = fWallTime;
+    timing.nCalls = fNCalls;
+    return timing;
+  } // SignalProcessingPipeline::timing()
+
+
+  //----------------------------------------------------------------------
+  void SignalProcessingPipeline::resetTiming() {
+    {
+      std::lock_guard<std::mutex> const lock(fMutex);
+      for (auto const& workspace: fWorkspaces) workspace->stages = {};
+    }
+    fWallTime = 0U;
+    fNCalls = 0U;
+  } // SignalProcessingPipeline::resetTiming()
+
+
+  //----------------------------------------------------------------------
+  std::size_t SignalProcessingPipeline::nWorkspaces() const {
+    std::lock_guard<std::mutex> const lock(fMutex);
+    return fWorkspaces.size();
+  } // SignalProcessingPipeline::nWorkspaces()
+
+
+  //----------------------------------------------------------------------
+  void SignalProcessingPipeline::findROIs(
+    float const* signal, std::size_t nTicks, float threshold,
+    std::size_t preSamples, std::size_t postSamples,
+    std::vector<FlatROI_t>& rois
+    )
+  {
+    rois.clear();
+
+    std::size_t tick = 0U;
+    while (tick < nTicks) {
+      if (!(signal[tick] > threshold)) { ++tick; continue; }
+
+      std::size_t end = tick + 1U;
+      while ((end < nTicks) && (signal[end] > threshold)) ++end;
+
+      std::size_t const begin = (tick > preSamples)? tick - preSamples: 0U;
+      std::size_t const stop = std::min(end + postSamples, nTicks);
+
+      if (!rois.empty() && (begin <= rois.back().startTick + rois.back().nSamples))
+        rois.back().nSamples = stop - rois.back().startTick;
+      else
+        rois.push_back({ begin, begin, stop - begin });
+
+      tick = end;
+    } // while
+  } // SignalProcessingPipeline::findROIs()
+
+
+  //----------------------------------------------------------------------
+  float SignalProcessingPipeline::medianPedestal
+    (std::vector<short> const& adcs, std::vector<short>& scratch)
+  {
+    if (adcs.empty()) return 0.0f;
+    scratch.assign(adcs.begin(), adcs.end());
+    auto const middle = scratch.begin() + scratch.size() / 2U;
+    std::nth_element(scratch.begin(), middle, scratch.end());
+    return float(*middle);
+  } // SignalProcessingPipeline::medianPedestal()
+
+
+  //----------------------------------------------------------------------
+  auto SignalProcessingPipeline::acquireWorkspace() -> Workspace_t* {
+    {
+      std::lock_guard<std::mutex> const lock(fMutex);
+      if (!fAvailable.empty()) {
+        Workspace_t* const workspace = fAvailable.back();
+        fAvailable.pop_back();
+        return workspace;
+      }
+    }
+
+    // the new workspace allocates its buffers outside the lock
+    auto workspace = std::make_unique<Workspace_t>(fPlan, fSize);
+    std::lock_guard<std::mutex> const lock(fMutex);
+    fWorkspaces.push_back(std::move(workspace));
+    return fWorkspaces.back().get();
+  } // SignalProcessingPipeline::acquireWorkspace()
+
+
+  //----------------------------------------------------------------------
+  void SignalProcessingPipeline::releaseWorkspace(Workspace_t* workspace) {
+    std::lock_guard<std::mutex> const lock(fMutex);
+    fAvailable.push_back(workspace);
+  } // SignalProcessingPipeline::releaseWorkspace()
+
+
+  //----------------------------------------------------------------------
+  void SignalProcessingPipeline::processChannel(
+    Workspace_t& workspace, raw::RawDigit const& digit,
+    ChannelSetup_t const& setup, recob::Wire& wire
+    ) const
+  {
+    std::size_t const nTicks = digit.Samples();
+    if (nTicks > fSize) {
+      throw art::Exception(art::errors::LogicError)
+        << "SignalProcessingPipeline: channel " << digit.Channel() << " has "
+        << nTicks << " samples, more than the transform size " << fSize
+        << "\n";
+    }
+    if (setup.kernel >= fKernels.size()) {
+      throw art::Exception(art::errors::LogicError)
+        << "SignalProcessingPipeline: channel " << digit.Channel()
+        << " requires deconvolution kernel #" << setup.kernel << ", but only "
+        << fKernels.size() << " are available\n";
+    }
+
+    Clock_t::time_point start = Clock_t::now();
+    auto const record = [&workspace, &start](Stage_t stage)
+      {
+        Clock_t::time_point const now = Clock_t::now();
+        addEntry(workspace.stages[stage], nanoseconds(start, now));
+        start = now;
+      };
+
+    //
+    // pedestal subtraction
+    //
+    std::vector<float>& waveform = workspace.waveform;
+    workspace.adcs.resize(nTicks);
+    raw::Uncompress(digit.ADCs(), workspace.adcs, digit.Compression());
+    float const pedestal = fConfig.estimatePedestal
+      ? medianPedestal(workspace.adcs, workspace.scratch)
+      : digit.GetPedestal();
+    std::transform(
+      workspace.adcs.begin(), workspace.adcs.end(), waveform.begin(),
+      [pedestal](short adc){ return float(adc) - pedestal; }
+      );
+    std::fill(waveform.begin() + nTicks, waveform.end(), 0.0f);
+    record(Pedestal);
+
+    //
+    // deconvolution (the kernel already includes the filter)
+    //
+    if (fConfig.singlePrecision)
+      workspace.fft.Convolute(waveform, fKernelsF[setup.kernel]);
+    else
+      workspace.fft.Convolute(waveform, fKernels[setup.kernel]);
+    record(Deconvolution);
+
+    //
+    // regions of interest
+    //
+    findROIs(waveform.data(), nTicks, fConfig.threshold,
+      fConfig.preSamples, fConfig.postSamples, workspace.rois);
+    record(ROIBuilding);
+
+    //
+    // wire
+    //
+    wire = WireCreator(waveform.data(), workspace.rois, nTicks,
+      digit.Channel(), setup.view).move();
+    record(WireOutput);
+
+  } // SignalProcessingPipeline::processChannel()
+
+
+  //----------------------------------------------------------------------
+  std::ostream& operator<<
+    (std::ostream& out, SignalProcessingPipeline::Timing_t const& timing)
+  {
+    using Timing_t = SignalProcessingPipeline::Timing_t;
+
+    std::uint64_t const total = timing.totalTime();
+    out << "Signal processing: " << timing.nCalls << " calls, "
+      << std::fixed << std::setprecision(3) << (timing.wallTime * 1e-6)
+      << " ms elapsed, " << (total * 1e-6) << " ms in the stages";
+    for (std::size_t iStage = 0U; iStage < SignalProcessingPipeline::NStages;
+      ++iStage
+    ) {
+      auto const stage = static_cast<SignalProcessingPipeline::Stage_t>(iStage);
+      lar::InstrumentationStats_t const& stats = timing[stage];
+      out << "\n  " << std::setw(14) << std::left << Timing_t::stageName(stage)
+        << std::right << ": " << std::setprecision(3) << (stats.sum * 1e-6)
+        << " ms";
+      if (total > 0U)
+        out << " (" << std::setprecision(1) << (100.0 * stats.sum / total) << "%)";
+      out << ", " << std::setprecision(3) << (stats.mean() * 1e-3)
+        << " us/channel (max " << (stats.max * 1e-3) << " us) over "
+        << stats.entries << " channels";
+    } // for
+    return out;
+  } // operator<< (SignalProcessingPipeline::Timing_t)
+
+
+} // namespace recob
@@ -0,0 +1,280 @@
+/** ****************************************************************************
+ * @file   SignalProcessingPipeline.h
+ * @brief  Parallel processing of raw digits into wires
+ * @date   October 14, 2026
+ * @see    SignalProcessingPipeline.cxx WireCreator.h
+ *
+ * ****************************************************************************/
+
+#ifndef LARDATA_ARTDATAHELPER_SIGNALPROCESSINGPIPELINE_H
+#define LARDATA_ARTDATAHELPER_SIGNALPROCESSINGPIPELINE_H
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/WireCreator.h" // recob::WireCreator::FlatROI_t
+#include "lardata/Utilities/Instrumentation.h" // lar::InstrumentationStats_t
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::View_t
+#include "lardataobj/RecoBase/Wire.h"
+
+// C/C++ standard library
+#include <array>
+#include <atomic>
+#include <complex>
+#include <functional> // std::function<>
+#include <iosfwd> // std::ostream
+#include <memory> // std::unique_ptr<>
+#include <mutex>
+#include <string>
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+namespace raw { class RawDigit; }
+namespace util { class SignalShaping; class LArFFTWPlan; }
+
+/// Reconstruction base classes
+namespace recob {
+
+  /**
+   * @brief Turns raw digits into wires, processing channels in parallel
+   *
+   * Each channel goes through four stages:
+   * 1. _pedestal subtraction_: the ADC counts are uncompressed and the
+   *    pedestal (the one of the digit, or the median of the counts) is
+   *    subtracted; the waveform is padded with zeroes to the transform size;
+   * 2. _deconvolution_: the waveform is multiplied in frequency domain by the
+   *    deconvolution kernel of the channel;
+   * 3. _region of interest building_: the ticks above threshold, extended by
+   *    a fixed number of ticks on each side, form the regions of interest;
+   * 4. _wire output_: the regions are copied from the deconvolved waveform
+   *    straight into a new `recob::Wire` (`recob::WireCreator` with a flat
+   *    buffer).
+   *
+   * The channels are split in batches of `Config_t::batchSize`, processed in
+   * parallel by `tbb::parallel_for()` (in the current task arena). A batch
+   * leases a workspace from the pipeline, with its own `util::LArFFTW` engine
+   * (the FFTW plans are the job-wide ones of `util::LArFFTWPlan::Shared()`)
+   * and all the buffers of the stages, which are reused for all the channels
+   * and, since the workspaces are kept, for all the following calls. The
+   * pipeline ends up with one workspace per thread, and the processing of a
+   * channel allocates only the storage of its wire.
+   *
+   *     recob::SignalProcessingPipeline pipeline({ &shaperU, &shaperV, &shaperY });
+   *     // ...
+   *     geo::GeometryCore const& geom = *lar::providerFrom<geo::Geometry>();
+   *     auto wires = pipeline.process(digits, [&geom](raw::ChannelID_t channel)
+   *       {
+   *         geo::View_t const view = geom.View(channel);
+   *         return recob::SignalProcessingPipeline::ChannelSetup_t
+   *           { view, std::size_t(view) };
+   *       });
+   *     event.put(std::move(wires));
+   *
+   * The time spent in each stage is recorded per channel, and `timing()`
+   * collects it from all the workspaces at the end of the job.
+   * `process()` may be called by several threads at the same time, while
+   * `timing()` and `resetTiming()` should be called when no processing is
+   * ongoing.
+   */
+  class SignalProcessingPipeline {
+    public:
+      /// Type of a deconvolution kernel (as `SignalShaping::DeconvKernelD()`)
+      using ComplexVector = std::vector<std::complex<double>>;
+
+      /// Alias for the position of a region of interest in the waveform
+      using FlatROI_t = WireCreator::FlatROI_t;
+
+      /// Configuration of the pipeline
+      struct Config_t {
+        std::size_t batchSize = 64U; ///< Channels processed by one task.
+        float threshold = 3.0f; ///< Deconvolved signal starting a region.
+        std::size_t preSamples = 10U; ///< Ticks added before each region.
+        std::size_t postSamples = 10U; ///< Ticks added after each region.
+        bool estimatePedestal = false; ///< Use the median ADC as pedestal.
+        bool singlePrecision = false; ///< Deconvolve with `fftwf` plans.
+        std::string fftwOption = "ES"; ///< FFTW planning option.
+      }; // struct Config_t
+
+      /// What the pipeline needs to know of a channel
+      struct ChannelSetup_t {
+        geo::View_t view; ///< View of the channel.
+        std::size_t kernel = 0U; ///< Index of its deconvolution kernel.
+      }; // struct ChannelSetup_t
+
+      /// Function returning the setup of a channel (called concurrently)
+      using ChannelSetupFunc_t
+        = std::function<ChannelSetup_t(raw::ChannelID_t)>;
+
+      /// Processing stages
+      enum Stage_t {
+        Pedestal, ///< Uncompression and pedestal subtraction.
+        Deconvolution, ///< Deconvolution.
+        ROIBuilding, ///< Search of the regions of interest.
+        WireOutput, ///< Creation of the wire.
+        NStages ///< Number of stages.
+      }; // Stage_t
+
+      /// Time spent in each stage (nanoseconds, one entry per channel)
+      struct Timing_t {
+        /// Statistics of each stage, summed over all the threads
+        std::array<lar::InstrumentationStats_t, NStages> stages;
+
+        std::uint64_t wallTime = 0U; ///< Total duration of `process()` [ns].
+        std::uint64_t nCalls = 0U; ///< Number of `process()` calls.
+
+        /// Returns the statistics of the specified stage
+        lar::InstrumentationStats_t const& operator[] (Stage_t stage) const
+          { return stages[stage]; }
+
+        /// Returns the time spent in all the stages by all the threads [ns]
+        std::uint64_t totalTime() const;
+
+        /// Returns the name of the specified stage
+        static char const* stageName(Stage_t stage);
+
+      }; // struct Timing_t
+
+
+      /**
+       * @brief Constructor: uses the specified deconvolution kernels
+       * @param deconvKernels frequency domain kernels, `N/2+1` elements each
+       * @param config configuration of the pipeline
+       * @throw art::Exception (`art::errors::Configuration`) on bad settings
+       *
+       * The kernels are indexed by `ChannelSetup_t::kernel`, and the
+       * transform size `N` is determined by their size, which must be the
+       * same for all of them.
+       */
+      SignalProcessingPipeline
+        (std::vector<ComplexVector> deconvKernels, Config_t config);
+
+      /// Constructor: uses the specified kernels and the default configuration
+      explicit SignalProcessingPipeline
+        (std::vector<ComplexVector> deconvKernels)
+        : SignalProcessingPipeline(std::move(deconvKernels), Config_t{})
+        {}
+
+      /**
+       * @brief Constructor: uses the deconvolution kernels of the shapers
+       * @param shapers the signal shapers, in the order of their kernel index
+       * @param config configuration of the pipeline
+       * @throw art::Exception (`art::errors::Configuration`) on bad settings
+       *
+       * The kernels are copied, and they must have been calculated already
+       * (`util::SignalShaping::CalculateDeconvKernel()`).
+       */
+      SignalProcessingPipeline(
+        std::vector<util::SignalShaping const*> const& shapers,
+        Config_t config
+        );
+
+      /// Constructor: uses the shapers and the default configuration
+      explicit SignalProcessingPipeline
+        (std::vector<util::SignalShaping const*> const& shapers)
+        : SignalProcessingPipeline(shapers, Config_t{})
+        {}
+
+      ~SignalProcessingPipeline();
+
+      SignalProcessingPipeline(SignalProcessingPipeline const&) = delete;
+      SignalProcessingPipeline& operator=
+        (SignalProcessingPipeline const&) = delete;
+
+      /// Returns the configuration of the pipeline
+      Config_t const& config() const { return fConfig; }
+
+      /// Returns the number of ticks of the transforms
+      std::size_t transformSize() const { return fSize; }
+
+      /// Returns the number of deconvolution kernels
+      std::size_t nKernels() const { return fKernels.size(); }
+
+      /**
+       * @brief Processes all the specified digits
+       * @param digits the raw digits to be processed
+       * @param setup function returning the setup of each channel
+       * @return one wire per digit, in the same order
+       * @throw art::Exception (`art::errors::LogicError`) if a digit is longer
+       *        than the transform size, or a kernel index is not available
+       *
+       * The `setup` function is called once per digit, by the threads of the
+       * processing.
+       */
+      std::unique_ptr<std::vector<recob::Wire>> process(
+        std::vector<raw::RawDigit> const& digits,
+        ChannelSetupFunc_t const& setup
+        );
+
+      /// Returns the time spent so far in each stage
+      Timing_t timing() const;
+
+      /// Forgets all the recorded times
+      void resetTiming();
+
+      /// Returns the number of workspaces created so far
+      std::size_t nWorkspaces() const;
+
+      /**
+       * @brief Finds the regions of interest of a deconvolved waveform
+       * @param signal the deconvolved waveform
+       * @param nTicks number of ticks of the waveform
+       * @param threshold signal above which a tick is in a region
+       * @param preSamples ticks added before each region
+       * @param postSamples ticks added after each region
+       * @param rois (output) the regions found, sorted and not overlapping
+       *
+       * The regions extended by the padding are merged when they overlap or
+       * touch, and are clamped to the waveform ticks. Their `offset` is the
+       * same as their `startTick`, so that `signal` itself is the flat buffer
+       * of `recob::WireCreator`.
+       */
+      static void findROIs(
+        float const* signal, std::size_t nTicks, float threshold,
+        std::size_t preSamples, std::size_t postSamples,
+        std::vector<FlatROI_t>& rois
+        );
+
+      /// Returns the median of the ADC counts (`0` if none)
+      static float medianPedestal
+        (std::vector<short> const& adcs, std::vector<short>& scratch);
+
+    private:
+      struct Workspace_t; ///< FFT engine, buffers and timing of one thread
+
+      Config_t fConfig; ///< Configuration.
+      std::size_t fSize; ///< Transform size.
+      std::vector<ComplexVector> fKernels; ///< Deconvolution kernels.
+      /// Single precision kernels (only with `Config_t::singlePrecision`).
+      std::vector<std::vector<std::complex<float>>> fKernelsF;
+      std::shared_ptr<util::LArFFTWPlan const> fPlan; ///< Shared FFTW plans.
+
+      mutable std::mutex fMutex; ///< Protects the workspace lists.
+      std::vector<std::unique_ptr<Workspace_t>> fWorkspaces; ///< All of them.
+      std::vector<Workspace_t*> fAvailable; ///< Workspaces not leased.
+
+      std::atomic<std::uint64_t> fWallTime { 0U }; ///< Time in `process()`.
+      std::atomic<std::uint64_t> fNCalls { 0U }; ///< Calls of `process()`.
+
+      /// Returns a workspace for exclusive use, creating it if needed
+      Workspace_t* acquireWorkspace();
+
+      /// Makes the workspace available again
+      void releaseWorkspace(Workspace_t* workspace);
+
+      /// Runs all the stages on a digit
+      void processChannel(
+        Workspace_t& workspace, raw::RawDigit const& digit,
+        ChannelSetup_t const& setup, recob::Wire& wire
+        ) const;
+
+  }; // class SignalProcessingPipeline
+
+
+  /// Prints the time of each stage, per channel and in total
+  std::ostream& operator<<
+    (std::ostream& out, SignalProcessingPipeline::Timing_t const& timing);
+
+} // namespace recob
+
+#endif // LARDATA_ARTDATAHELPER_SIGNALPROCESSINGPIPELINE_H
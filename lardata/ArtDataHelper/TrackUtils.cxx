@@ -26,6 +26,8 @@
 // ROOT libraries
 
 // C/C++ standard libraries
+#include <algorithm> // std::fill()
+#include <utility> // std::move()
 #include <cmath>
 
 
@@ -33,23 +35,51 @@
 //------------------------------------------------------------------------------
 double lar::util::TrackProjectedLength(recob::Track const& track, geo::View_t view) {
 
-   if(view == geo::kUnknown) {
-      throw cet::exception("TrackProjectedLength") << "cannot provide projected length for "
-        << "unknown view\n";
-   }
    double length = 0.;
+   TrackViewProjector({ view }).projectedLengths(track, &length);
+   return length;
+
+} // lar::util::TrackProjectedLength()
+
+
 
+//------------------------------------------------------------------------------
+lar::util::TrackViewProjector::TrackViewProjector(std::vector<geo::View_t> views)
+   : fViews(std::move(views))
+   , fSinAngle(fViews.size(), 0.)
+   , fCosAngle(fViews.size(), 1.)
+{
    auto const* geom = lar::providerFrom<geo::Geometry>();
-   double angleToVert = 0.;
-   for(unsigned int i = 0; i < geom->Nplanes(); ++i){
-      if(geom->Plane(i).View() == view){
-         angleToVert = geom->Plane(i).Wire(0).ThetaZ(false) - 0.5*::util::pi<>();
-         break;
+   for(std::size_t iView = 0; iView < fViews.size(); ++iView){
+      geo::View_t const view = fViews[iView];
+      if(view == geo::kUnknown) {
+         throw cet::exception("TrackProjectedLength") << "cannot provide projected length for "
+           << "unknown view\n";
       }
-   }
+
+      double angleToVert = 0.;
+      for(unsigned int i = 0; i < geom->Nplanes(); ++i){
+         if(geom->Plane(i).View() == view){
+            angleToVert = geom->Plane(i).Wire(0).ThetaZ(false) - 0.5*::util::pi<>();
+            break;
+         }
+      }
+      fSinAngle[iView] = std::sin(angleToVert);
+      fCosAngle[iView] = std::cos(angleToVert);
+   } // for views
+} // lar::util::TrackViewProjector::TrackViewProjector()
+
+
+
+//------------------------------------------------------------------------------
+void lar::util::TrackViewProjector::projectedLengths
+  (recob::Track const& track, double* lengths) const
+{
+   std::size_t const nViews = fViews.size();
+   std::fill(lengths, lengths + nViews, 0.);
 
    // now loop over all points in the trajectory and add the contribution to the
-   // to the desired view
+   // to each view
 
    for(size_t p = 1; p < track.NumberTrajectoryPoints(); ++p){
       const auto& pos_cur = track.LocationAtPoint(p);
@@ -61,15 +91,26 @@ double lar::util::TrackProjectedLength(recob::Track const& track, geo::View_t vi
       // (sin(angleToVert),cos(angleToVert)) is the direction perpendicular to wire
       // fDir[p-1] is the direction between the two relevant points
       const auto& dir_prev = track.DirectionAtPoint(p - 1);
-      double cosgamma = std::abs(std::sin(angleToVert)*dir_prev.Y() +
-         std::cos(angleToVert)*dir_prev.Z() );
+      for(std::size_t iView = 0; iView < nViews; ++iView){
+         double cosgamma = std::abs(fSinAngle[iView]*dir_prev.Y() +
+            fCosAngle[iView]*dir_prev.Z() );
 
-      /// @todo is this right, or should it be dist*cosgamma???
-      length += dist/cosgamma;
+         /// @todo is this right, or should it be dist*cosgamma???
+         lengths[iView] += dist/cosgamma;
+      }
    } // end loop over distances between trajectory points
 
-   return length;
-} // lar::util::TrackProjectedLength()
+} // lar::util::TrackViewProjector::projectedLengths()
+
+
+
+//------------------------------------------------------------------------------
+std::vector<double> lar::util::TrackProjectedLengths(
+   std::vector<recob::Track> const& tracks,
+   std::vector<geo::View_t> const& views
+) {
+   return TrackViewProjector(views).projectedLengths(tracks);
+} // lar::util::TrackProjectedLengths()
 
 
 
@@ -17,6 +17,10 @@
 // LArSoft libraries
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::View_t
 
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
 namespace recob { class Track; }
 
 namespace lar::util {
@@ -35,6 +39,94 @@ namespace lar::util {
   double TrackProjectedLength(recob::Track const& track, geo::View_t view);
 
 
+  /**
+   * @brief Computes the projected length of tracks on many views at once
+   *
+   * The projection constants of each view are read from the geometry service
+   * only once, on construction, and then used for all the tracks.
+   * The loop on the trajectory of each track is also shared by all the views.
+   * The results are the same as `lar::util::TrackProjectedLength()`.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * lar::util::TrackViewProjector const projector({ geo::kU, geo::kV, geo::kZ });
+   * std::vector<double> const lengths = projector.projectedLengths(tracks);
+   * // length of track iTrack in view geo::kV:
+   * double const length = lengths[iTrack * projector.nViews() + 1];
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * Here `tracks` may be a `std::vector<recob::Track>`, a collection of
+   * `art::Ptr<recob::Track>` or a track collection proxy (`proxy::Tracks`).
+   */
+  class TrackViewProjector {
+
+      public:
+    /**
+     * @brief Constructor: caches the projection constants of the views
+     * @param views the views to project the tracks on
+     * @throw cet::exception (category `"TrackProjectedLength"`) if any of the
+     *                       views is `geo::kUnknown`
+     */
+    TrackViewProjector(std::vector<geo::View_t> views);
+
+    /// Returns the number of views tracks are projected on.
+    std::size_t nViews() const { return fViews.size(); }
+
+    /// Returns the views tracks are projected on.
+    std::vector<geo::View_t> const& views() const { return fViews; }
+
+    /**
+     * @brief Computes the projected length of a track on all views
+     * @param track the track to be projected
+     * @param lengths array to store the result of each view into
+     *
+     * The array `lengths` must have room for `nViews()` values, which are
+     * stored in the order of `views()`.
+     */
+    void projectedLengths(recob::Track const& track, double* lengths) const;
+
+    /**
+     * @brief Computes the projected length of tracks on all views
+     * @tparam Tracks type of collection of tracks
+     * @param tracks the tracks to be projected
+     * @return the lengths, `nViews()` for each track, in the order of `tracks`
+     */
+    template <typename Tracks>
+    std::vector<double> projectedLengths(Tracks const& tracks) const;
+
+      private:
+    std::vector<geo::View_t> fViews; ///< Views to project on.
+
+    /// Components of the direction orthogonal to the wires, for each view.
+    std::vector<double> fSinAngle, fCosAngle;
+
+    /// Returns the track in the argument.
+    static recob::Track const& asTrack(recob::Track const& track)
+      { return track; }
+
+    /// Returns the track pointed by the argument (`art::Ptr`, proxy...).
+    template <typename TrackRef>
+    static auto asTrack(TrackRef const& track) -> decltype(*track)
+      { return *track; }
+
+  }; // class TrackViewProjector
+
+
+  /**
+   * @brief Returns the projected length of the tracks on all the views
+   * @param tracks the tracks to be projected
+   * @param views the views to project the tracks on
+   * @return the lengths, `views.size()` for each track, in the order of `tracks`
+   * @see `lar::util::TrackViewProjector`
+   *
+   * The length of track `i` on `views[j]` is at position
+   * `i * views.size() + j` of the result.
+   */
+  std::vector<double> TrackProjectedLengths(
+    std::vector<recob::Track> const& tracks,
+    std::vector<geo::View_t> const& views
+    );
+
+
   /**
    * @brief Returns the projected length of track on a wire pitch step [cm]
    * @param track the track to be projected on a view
@@ -68,4 +160,24 @@ namespace lar::util {
 } // namespace lar::util
 
 
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Tracks>
+std::vector<double> lar::util::TrackViewProjector::projectedLengths
+  (Tracks const& tracks) const
+{
+  std::vector<double> lengths;
+  lengths.reserve(tracks.size() * nViews());
+  for (auto const& track: tracks) {
+    lengths.resize(lengths.size() + nViews());
+    projectedLengths(asTrack(track), lengths.data() + lengths.size() - nViews());
+  } // for
+  return lengths;
+} // lar::util::TrackViewProjector::projectedLengths()
+
+
+//------------------------------------------------------------------------------
+
+
 #endif // LARDATA_ARTDATAHELPER_TRACKUTILS_H
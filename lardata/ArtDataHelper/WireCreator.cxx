@@ -12,6 +12,7 @@
 
 // C/C++ standard library
 #include <utility> // std::move()
+#include <memory> // std::make_unique()
 
 // art libraries
 #include "art/Framework/Services/Registry/ServiceHandle.h"
@@ -71,4 +72,57 @@ namespace recob {
     wire(std::move(sigROIlist), channel, view)
     {}
 
+  //----------------------------------------------------------------------
+  WireCreator::WireCreator(
+    float const* samples,
+    std::vector<FlatROI_t> const& rois,
+    std::size_t nTicks,
+    raw::ChannelID_t channel,
+    geo::View_t view
+    ):
+    wire(makeRegionsOfInterest(samples, rois, nTicks), channel, view)
+    {}
+
+  //----------------------------------------------------------------------
+  WireCreator::RegionsOfInterest_t WireCreator::makeRegionsOfInterest(
+    float const* samples,
+    std::vector<FlatROI_t> const& rois,
+    std::size_t nTicks
+  ) {
+    RegionsOfInterest_t sigROIlist;
+    for (FlatROI_t const& roi: rois) {
+      float const* begin = samples + roi.offset;
+      sigROIlist.add_range(roi.startTick, begin, begin + roi.nSamples);
+    } // for
+    sigROIlist.resize(nTicks);
+    return sigROIlist;
+  } // WireCreator::makeRegionsOfInterest()
+
+
+  //----------------------------------------------------------------------
+  WireCollectionCreator::WireCollectionCreator(std::size_t nWires /* = 0 */)
+    : wires(std::make_unique<std::vector<Wire>>())
+    { wires->reserve(nWires); }
+
+  //----------------------------------------------------------------------
+  void WireCollectionCreator::emplace_back(
+    float const* samples,
+    std::vector<FlatROI_t> const& rois,
+    std::size_t nTicks,
+    raw::ChannelID_t channel,
+    geo::View_t view
+  ) {
+    wires->emplace_back
+      (WireCreator::makeRegionsOfInterest(samples, rois, nTicks), channel, view);
+  } // WireCollectionCreator::emplace_back()
+
+  //----------------------------------------------------------------------
+  std::unique_ptr<std::vector<Wire>> WireCollectionCreator::release() {
+    std::size_t const nWires = wires->size();
+    auto released = std::move(wires);
+    wires = std::make_unique<std::vector<Wire>>();
+    wires->reserve(nWires); // the next collection is likely similar
+    return released;
+  } // WireCollectionCreator::release()
+
 } // namespace recob
@@ -12,6 +12,9 @@
 
 // C/C++ standard library
 #include <utility> // std::move()
+#include <memory> // std::unique_ptr<>
+#include <vector>
+#include <cstddef> // std::size_t
 
 // LArSoft libraries
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
@@ -49,12 +52,30 @@ namespace recob {
    * This is a one-step creation object: the wire is constructed at the same
    * time the WireCreator is, and no facility is offered to modify the
    * constructed wire, or to create another one.
+   *
+   * The signal can also be provided as a single buffer with the samples of
+   * all the regions of interest one after the other, and the description of
+   * where each region starts in the buffer and in the waveform (`FlatROI_t`).
+   * The buffer can then be reused for all the channels, and only the storage
+   * of the wire itself is allocated:
+   *
+   *     // samples: all the signal samples of the channel, one ROI after the
+   *     // other; rois: position of each ROI in samples and in the waveform
+   *     recob::WireCreator wire
+   *       (samples.data(), rois, nTicks, channel, view);
    */
   class WireCreator {
     public:
       /// Alias for the type of regions of interest
       using RegionsOfInterest_t = Wire::RegionsOfInterest_t;
 
+      /// Position of a region of interest in a flat buffer of samples.
+      struct FlatROI_t {
+        std::size_t startTick; ///< Tick of the first sample of the region.
+        std::size_t offset; ///< Position of the first sample in the buffer.
+        std::size_t nSamples; ///< Number of samples in the region.
+      }; // struct FlatROI_t
+
       // destructor, copy and move constructor and assignment as default
 
       /**
@@ -116,6 +137,42 @@ namespace recob {
         geo::View_t view
         );
 
+
+      /**
+       * @brief Constructor: uses signal from a flat buffer of samples
+       * @param samples pointer to the buffer with the samples of all regions
+       * @param rois position of each region in the buffer and in the waveform
+       * @param nTicks length of the full waveform (TDC ticks)
+       * @param channel the ID of the channel
+       * @param view the view the channel belongs to
+       *
+       * The regions must be sorted by `startTick` and must not overlap.
+       * The samples are copied directly into the storage of the wire, with
+       * no intermediate copy.
+       */
+      WireCreator(
+        float const* samples,
+        std::vector<FlatROI_t> const& rois,
+        std::size_t nTicks,
+        raw::ChannelID_t channel,
+        geo::View_t view
+        );
+
+
+      /**
+       * @brief Creates regions of interest from a flat buffer of samples
+       * @param samples pointer to the buffer with the samples of all regions
+       * @param rois position of each region in the buffer and in the waveform
+       * @param nTicks length of the full waveform (TDC ticks)
+       * @return the regions of interest, with size `nTicks`
+       * @see WireCreator(float const*, std::vector<FlatROI_t> const&, ...)
+       */
+      static RegionsOfInterest_t makeRegionsOfInterest(
+        float const* samples,
+        std::vector<FlatROI_t> const& rois,
+        std::size_t nTicks
+        );
+
       /**
        * @brief Prepares the constructed wire to be moved away
        * @return a right-value reference to the constructed wire
@@ -155,6 +212,76 @@ namespace recob {
 
   }; // class WireCreator
 
+
+  /**
+   * @brief Class managing the creation of a collection of recob::Wire
+   *
+   * The collection is reserved up front for the expected number of channels,
+   * and wires are moved into it as they are created:
+   *
+   *     recob::WireCollectionCreator wires(nChannels);
+   *     for (...) { // loop on channels
+   *       // fill samples and rois for this channel, reusing their memory
+   *       wires.emplace_back(samples.data(), rois, nTicks, channel, view);
+   *     }
+   *     event.put(wires.release());
+   *
+   */
+  class WireCollectionCreator {
+    public:
+      /// Alias for the type of regions of interest
+      using RegionsOfInterest_t = WireCreator::RegionsOfInterest_t;
+
+      /// Alias for the position of a region of interest in a flat buffer
+      using FlatROI_t = WireCreator::FlatROI_t;
+
+      /// Constructor: reserves space for `nWires` wires
+      explicit WireCollectionCreator(std::size_t nWires = 0);
+
+      /// Prepares the collection to host at least `nWires` wires
+      void reserve(std::size_t nWires) { wires->reserve(nWires); }
+
+      /// Returns the number of wires currently in the collection
+      std::size_t size() const { return wires->size(); }
+
+      /// Moves the wire from the specified creator into the collection
+      void emplace_back(WireCreator&& wire) { wires->push_back(wire.move()); }
+
+      /// Adds a wire with the specified signal, which becomes empty
+      void emplace_back(
+        RegionsOfInterest_t&& sigROIlist,
+        raw::ChannelID_t channel,
+        geo::View_t view
+        )
+        { wires->emplace_back(std::move(sigROIlist), channel, view); }
+
+      /// Adds a wire with signal from a flat buffer of samples
+      /// @see WireCreator(float const*, std::vector<FlatROI_t> const&, ...)
+      void emplace_back(
+        float const* samples,
+        std::vector<FlatROI_t> const& rois,
+        std::size_t nTicks,
+        raw::ChannelID_t channel,
+        geo::View_t view
+        );
+
+      /// Returns a read-only reference to the current list of wires
+      std::vector<Wire> const& peek() const { return *wires; }
+
+      /**
+       * @brief Yields the collection of wires
+       * @return the collection, ready to be put into the event
+       *
+       * After this call, this object hosts a new, empty collection.
+       */
+      std::unique_ptr<std::vector<Wire>> release();
+
+    protected:
+
+      std::unique_ptr<std::vector<Wire>> wires; ///< the collection of wires
+
+  }; // class WireCollectionCreator
+
 } // namespace recob
 
 #endif // WIRECREATOR_H
@@ -13,11 +13,19 @@
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "lardataalg/DetectorInfo/DetectorClocks.h"
 #include "larcore/CoreUtils/ServiceUtil.h"
-#include "larcore/CoreUtils/EnsureOnlyOneSchedule.h"
+#include "canvas/Persistency/Provenance/ScheduleID.h"
+
+#include <memory> // std::shared_ptr<>
 
 ///General LArSoft Utilities
 namespace detinfo{
-  class DetectorClocksService: private lar::EnsureOnlyOneSchedule<DetectorClocksService> {
+  /**
+   * @brief Interface of the services providing `detinfo::DetectorClocks`
+   *
+   * Implementations which do not support more than one schedule must ensure
+   * it themselves (e.g. by deriving from `lar::EnsureOnlyOneSchedule`).
+   */
+  class DetectorClocksService {
 
     public:
     typedef detinfo::DetectorClocks provider_type;
@@ -28,6 +36,30 @@ namespace detinfo{
       virtual void   reconfigure(fhicl::ParameterSet const& pset) = 0;
       virtual const  detinfo::DetectorClocks* provider() const = 0;
 
+      /**
+       * @brief Returns the provider as seen by the event in a schedule
+       * @param schedule the schedule processing the event
+       * @return the provider for the event currently in that schedule
+       *
+       * Implementations supporting more than one schedule may give each event
+       * its own immutable snapshot of the provider; the snapshot stays valid
+       * as long as the returned pointer is held.
+       * By default, this is just `provider()`.
+       */
+      virtual std::shared_ptr<provider_type const> providerFor
+        (art::ScheduleID /* schedule */) const
+        { return { std::shared_ptr<provider_type const>(), provider() }; }
+
+      /**
+       * @brief Returns a number which changes whenever `provider()` timing does
+       * @return the current timing version, or `0` if not tracked
+       *
+       * Users deriving quantities from the clocks may recompute them only
+       * when this number changes. Implementations not tracking the changes
+       * return `0`, which means that the timing may have changed at any time.
+       */
+      virtual unsigned long long timingVersion() const { return 0ULL; }
+
     }; // class DetectorClocksService
 } //namespace detinfo
 DECLARE_ART_SERVICE_INTERFACE(detinfo::DetectorClocksService, SHARED)
@@ -19,6 +19,13 @@
 
 #include "lardataalg/DetectorInfo/DetectorClocksStandard.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/ProviderCallCounter.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 ///General LArSoft Utilities
 namespace detinfo{
@@ -78,10 +85,53 @@ namespace detinfo{
    *     of the service provider is updated using the default values of trigger
    *     and beam times specified in the service configuration
    *
+   * Whether the trigger data product is present is decided on the first
+   * event of each input file (or of the job, without input files). If it is
+   * absent there, it is assumed absent in all the events of that file: the
+   * lookup is skipped and the default times are used directly. The number of
+   * skipped lookups is printed at the end of the job.
+   *
    * The first set up happens on opening the first run in the first input file.
    * Accessing this service before (e.g. during `beginJob()` phase) yields
    * undefined behaviour.
    *
+   *
+   * Multithreading
+   * ===============
+   *
+   * By default, the trigger times are set into the shared provider before
+   * each event, and the service supports only one schedule.
+   * With the service parameter *PerScheduleSnapshots* set to `true`, the
+   * shared provider is never changed during the event loop: before each
+   * event, a copy of it is updated with the trigger of that event, and it
+   * is made available to the modules processing that event through
+   * `providerFor(scheduleID)`. Consecutive events with the same trigger and
+   * beam gate times share the same (immutable) snapshot, so the provider is
+   * copied only when the timing actually changes. In this mode, `provider()`
+   * returns the configuration from the service parameters and the input
+   * file, without the event trigger information, and more than one schedule
+   * is allowed.
+   *
+   *
+   * Change detection
+   * =================
+   *
+   * Before each event, the timing of the provider (trigger, beam gate and
+   * G4 reference times, and the configuration of the clocks) is compared
+   * with the one of the previous event. `timingVersion()` changes only when
+   * they differ, so that the users of the clocks (like
+   * `DetectorPropertiesServiceStandard`) can skip recomputing their derived
+   * quantities. The number of events and of actual changes are printed at
+   * the end of the job.
+   *
+   *
+   * Instrumentation
+   * ================
+   *
+   * With the service parameter *CountProviderCalls* set to `true`, the
+   * requests of the provider are counted by module, and a summary is printed
+   * at the end of the job (see `detinfo::ProviderCallCounter`).
+   *
    */
   class DetectorClocksServiceStandard : public DetectorClocksService {
   public:
@@ -91,13 +141,72 @@ namespace detinfo{
     void   preBeginRun(const art::Run& run);
     void   preProcessEvent(const art::Event& evt, art::ScheduleContext);
     void   postOpenFile(const std::string& filename);
+    void   postEndJob();
+
+    virtual const provider_type* provider() const override
+      { fCallCounter.count(); return fClocks.get(); }
+
+    /// Returns the snapshot of the provider for the event in the schedule
+    /// (only different from `provider()` with *PerScheduleSnapshots*)
+    virtual std::shared_ptr<provider_type const> providerFor
+      (art::ScheduleID schedule) const override;
+
+    /// Returns the current version of the timing of `provider()`
+    virtual unsigned long long timingVersion() const override
+      { return fTimingVersion; }
 
-    virtual const provider_type* provider() const override { return fClocks.get();}
+    /// Returns the number of events whose timing was checked
+    unsigned long long nTimingChecks() const { return fNTimingChecks; }
+
+    /// Returns the number of events which changed the timing
+    unsigned long long nTimingChanges() const { return fNTimingChanges; }
+
+    /// Returns the number of events whose trigger lookup was skipped
+    unsigned long long nTriggerLookupsSkipped() const { return fNTriggerSkips; }
 
   private:
 
+    /// Whether the trigger data product is in the current input file
+    enum class TriggerPresence_t { Unknown, Present, Absent };
+
+    using Snapshot_t = std::shared_ptr<detinfo::DetectorClocksStandard const>;
+
     std::unique_ptr<detinfo::DetectorClocksStandard> fClocks;
 
+    bool fPerScheduleSnapshots; ///< whether to give each event a snapshot
+
+    detinfo::ProviderCallCounter fCallCounter; ///< counts provider requests
+
+    mutable std::mutex fSnapshotMutex; ///< protects the snapshot data below
+    std::map<art::ScheduleID, Snapshot_t> fSnapshots; ///< snapshot per schedule
+    Snapshot_t fLastSnapshot; ///< the most recently created snapshot
+
+    std::vector<double> fTimingKey; ///< timing values of the last check
+    unsigned long long fTimingVersion = 1ULL; ///< current timing version
+    std::atomic<unsigned long long> fNTimingChecks { 0ULL }; ///< events checked
+    std::atomic<unsigned long long> fNTimingChanges { 0ULL }; ///< events changing the timing
+
+    /// presence of the trigger product, decided on the first event of the file
+    std::atomic<TriggerPresence_t> fTriggerPresence { TriggerPresence_t::Unknown };
+    std::atomic<unsigned long long> fNTriggerSkips { 0ULL }; ///< events not looked up
+
+    /// Returns the values the timing of `clocks` depends on
+    static std::vector<double> timingKey(detinfo::DetectorClocksStandard const& clocks);
+
+    /// Updates the timing version if the provider timing changed (or `force`)
+    /// @return whether the timing version was changed
+    bool updateTimingVersion(bool force = false);
+
+    /// Sets the trigger of the event into `clocks`, skipping the lookup of a
+    /// trigger product known to be absent
+    void setTrigger(detinfo::DetectorClocksStandard& clocks, art::Event const& evt);
+
+    /// Creates or reuses the snapshot for the event in the schedule
+    void updateSnapshot(art::Event const& evt, art::ScheduleID schedule);
+
+    /// Drops all the snapshots (after the base configuration changes)
+    void clearSnapshots();
+
   };
 } //namespace detinfo
 DECLARE_ART_SERVICE_INTERFACE_IMPL(detinfo::DetectorClocksServiceStandard, detinfo::DetectorClocksService, SHARED)
@@ -7,14 +7,15 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
-#include "art_root_io/RootDB/SQLite3Wrapper.h"
 #include "canvas/Persistency/Provenance/FileFormatVersion.h"
 #include "canvas/Persistency/Provenance/ParameterSetMap.h"
 #include "canvas/Persistency/Provenance/rootNames.h"
 #include "cetlib_except/exception.h"
 #include "fhiclcpp/ParameterSet.h"
-#include "fhiclcpp/make_ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/HistoricalParameterSets.h"
+#include "lardata/DetectorInfoServices/ServicePack.h" // lar::noteProviderChange()
 #include "lardataalg/DetectorInfo/DetectorClocksStandard.h"
 #include "lardataalg/DetectorInfo/DetectorClocksStandardTriggerLoader.h"
 
@@ -24,6 +25,8 @@
 #include "art_root_io/Inputfwd.h"
 #include "art_root_io/detail/readMetadata.h"
 
+#include "larcore/CoreUtils/EnsureOnlyOneSchedule.h"
+
 #include <string>
 #include <vector>
 
@@ -33,33 +36,141 @@ namespace detinfo {
 
 DetectorClocksServiceStandard::DetectorClocksServiceStandard(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
   : fClocks(make_unique<DetectorClocksStandard>(pset))
+  , fPerScheduleSnapshots(pset.get<bool>("PerScheduleSnapshots", false))
+  , fCallCounter("DetectorClocksServiceStandard", pset.get<bool>("CountProviderCalls", false), reg)
 {
+  // without snapshots, the provider is changed by each event
+  if (!fPerScheduleSnapshots) {
+    lar::EnsureOnlyOneSchedule<DetectorClocksServiceStandard> const oneSchedule;
+  }
 
   reg.sPreProcessEvent.watch(this, &DetectorClocksServiceStandard::preProcessEvent);
   reg.sPostOpenFile.watch(this, &DetectorClocksServiceStandard::postOpenFile);
   reg.sPreBeginRun.watch(this, &DetectorClocksServiceStandard::preBeginRun);
+  reg.sPostEndJob.watch(this, &DetectorClocksServiceStandard::postEndJob);
+
+  fTimingKey = timingKey(*fClocks);
 
 }
 
 void DetectorClocksServiceStandard::reconfigure(fhicl::ParameterSet const& pset)
 {
   fClocks->Configure(pset);
-
+  clearSnapshots();
+  updateTimingVersion(true);
 }
 
-void DetectorClocksServiceStandard::preProcessEvent(const art::Event& evt, art::ScheduleContext)
+void DetectorClocksServiceStandard::preProcessEvent(const art::Event& evt, art::ScheduleContext sc)
 {
-  setDetectorClocksStandardTrigger(*fClocks, evt);
+  if (fPerScheduleSnapshots) {
+    updateSnapshot(evt, sc.id());
+    return;
+  }
+  setTrigger(*fClocks, evt);
   setDetectorClocksStandardG4RefTimeCorrection(*fClocks, evt);
+  ++fNTimingChecks;
+  if (updateTimingVersion()) {
+    ++fNTimingChanges;
+  }
 }
 
 void DetectorClocksServiceStandard::preBeginRun(art::Run const& run)
 {
   fClocks->ApplyParams();
+  clearSnapshots();
+  updateTimingVersion();
+}
+
+void DetectorClocksServiceStandard::postEndJob()
+{
+  mf::LogInfo("DetectorClocksServiceStandard")
+    << "Clock timing changed in " << fNTimingChanges << " of "
+    << fNTimingChecks << " events; trigger lookup skipped in "
+    << fNTriggerSkips << " events";
+}
+
+void DetectorClocksServiceStandard::setTrigger(DetectorClocksStandard& clocks, art::Event const& evt)
+{
+  if (fTriggerPresence == TriggerPresence_t::Absent) {
+    clocks.SetTriggerTime(clocks.DefaultTrigTime(), clocks.DefaultBeamTime());
+    ++fNTriggerSkips;
+    return;
+  }
+  bool const found = setDetectorClocksStandardTrigger(clocks, evt);
+  // the first event of the file decides for all the others
+  TriggerPresence_t unknown = TriggerPresence_t::Unknown;
+  fTriggerPresence.compare_exchange_strong
+    (unknown, found? TriggerPresence_t::Present: TriggerPresence_t::Absent);
+}
+
+vector<double> DetectorClocksServiceStandard::timingKey(DetectorClocksStandard const& clocks)
+{
+  vector<double> key = clocks.ConfigValues();
+  key.push_back(clocks.TriggerTime());
+  key.push_back(clocks.BeamGateTime());
+  key.push_back(clocks.G4ToElecTime());
+  return key;
+}
+
+bool DetectorClocksServiceStandard::updateTimingVersion(bool force)
+{
+  // an exact comparison: a change of timing can never be missed
+  vector<double> key = timingKey(*fClocks);
+  if (!force && (key == fTimingKey)) {
+    return false;
+  }
+  fTimingKey = move(key);
+  ++fTimingVersion;
+  lar::noteProviderChange();
+  return true;
+}
+
+shared_ptr<DetectorClocksServiceStandard::provider_type const>
+DetectorClocksServiceStandard::providerFor(art::ScheduleID schedule) const
+{
+  fCallCounter.count();
+  lock_guard<mutex> lock(fSnapshotMutex);
+  auto const iSnapshot = fSnapshots.find(schedule);
+  if (iSnapshot != fSnapshots.end()) {
+    return iSnapshot->second;
+  }
+  return DetectorClocksService::providerFor(schedule);
+}
+
+void DetectorClocksServiceStandard::updateSnapshot(art::Event const& evt, art::ScheduleID schedule)
+{
+  // the trigger is applied to a private copy, which only this thread sees
+  auto snapshot = make_shared<DetectorClocksStandard>(*fClocks);
+  setTrigger(*snapshot, evt);
+  setDetectorClocksStandardG4RefTimeCorrection(*snapshot, evt);
+
+  lock_guard<mutex> lock(fSnapshotMutex);
+  ++fNTimingChecks;
+  // share the previous snapshot if the timing of this event is the same
+  if (fLastSnapshot
+      && (fLastSnapshot->TriggerTime() == snapshot->TriggerTime())
+      && (fLastSnapshot->BeamGateTime() == snapshot->BeamGateTime())
+      && (fLastSnapshot->G4ToElecTime() == snapshot->G4ToElecTime())) {
+    fSnapshots[schedule] = fLastSnapshot;
+  }
+  else {
+    ++fNTimingChanges;
+    fLastSnapshot = snapshot;
+    fSnapshots[schedule] = move(snapshot);
+  }
+}
+
+void DetectorClocksServiceStandard::clearSnapshots()
+{
+  lock_guard<mutex> lock(fSnapshotMutex);
+  fSnapshots.clear();
+  fLastSnapshot.reset();
 }
 
 void DetectorClocksServiceStandard::postOpenFile(const string& filename)
 {
+  // the trigger product may be present in this file even if not in the last
+  fTriggerPresence = TriggerPresence_t::Unknown;
   if (!fClocks->InheritClockConfig()) {
     return;
   }
@@ -84,9 +195,10 @@ void DetectorClocksServiceStandard::postOpenFile(const string& filename)
     if (!art::detail::readMetadata(metaDataTree, psetMap)) {
       throw cet::exception("DetectorClocksServiceStandard", "Could not read ParameterSetMap from metadata tree!");
     }
+    auto& history = HistoricalParameterSets::instance();
     for (auto const& psEntry : psetMap) {
-      fhicl::ParameterSet ps;
-      fhicl::make_ParameterSet(psEntry.second.pset_, ps);
+      fhicl::ParameterSet const& ps
+        = *history.get(psEntry.first.to_string(), psEntry.second.pset_);
       if (!fClocks->IsRightConfig(ps)) {
         continue;
       }
@@ -109,12 +221,12 @@ void DetectorClocksServiceStandard::postOpenFile(const string& filename)
     }
   }
   else {
-    art::SQLite3Wrapper sqliteDB(file, "RootFileDB");
-    sqlite3_stmt* stmt{nullptr};
-    sqlite3_prepare_v2(sqliteDB, "SELECT PSetBlob from ParameterSets;", -1, &stmt, NULL);
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      fhicl::ParameterSet ps;
-      fhicl::make_ParameterSet(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)), ps);
+    // only the configurations mentioning all the inherited parameters are
+    // read; each is parsed only once in the job, and shared with other services
+    auto const psets
+      = HistoricalParameterSets::instance().fromRootFileDB(*file, cfgName);
+    for (auto const& pps : psets) {
+      fhicl::ParameterSet const& ps = *pps;
       if (!fClocks->IsRightConfig(ps)) {
         continue;
       }
@@ -156,6 +268,8 @@ void DetectorClocksServiceStandard::postOpenFile(const string& filename)
     delete file;
   }
   fClocks->ApplyParams();
+  clearSnapshots();
+  updateTimingVersion();
 }
 
 } // namespace detinfo
@@ -18,6 +18,15 @@
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include "lardataalg/DetectorInfo/DetectorPropertiesStandard.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/ProviderCallCounter.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility> // std::pair<>
 
 ///General LArSoft Utilities
 namespace detinfo{
@@ -50,6 +59,27 @@ namespace detinfo{
    *   configuration database in the ROOT input file is queried and if a
    *   configuration for this service is found, it's used instead of the
    *   one from the current FHiCL configuration
+   * - *PerScheduleSnapshots* (boolean; default: false): if true, the provider
+   *   is not updated with the clocks of each event; instead, each event gets
+   *   through `providerFor(scheduleID)` an immutable provider using the
+   *   clock snapshot of that event from `DetectorClocksService` (which
+   *   should have its *PerScheduleSnapshots* enabled too); snapshots are
+   *   shared by the events with the same clock snapshot, and more than one
+   *   schedule is allowed
+   * - *LazyInitialization* (boolean; default: false): if true, the provider
+   *   (and with it, the geometry and the other services it depends on) is
+   *   created only on the first call to `provider()`, and so is the
+   *   inheritance of *NumberTimeSamples* from the input file; jobs where no
+   *   module uses this service skip this work entirely. This is not supported
+   *   together with *PerScheduleSnapshots*, which takes precedence
+   * - *CountProviderCalls* (boolean; default: false): if true, the requests
+   *   of the provider are counted by module, and a summary is printed at the
+   *   end of the job (see `detinfo::ProviderCallCounter`)
+   *
+   * Without snapshots, the provider is updated before each event only if the
+   * timing of `DetectorClocksService` has changed since the last update
+   * (see `DetectorClocksService::timingVersion()`). The number of updates
+   * and of skipped updates are printed at the end of the job.
    *
    */
 
@@ -68,6 +98,24 @@ namespace detinfo{
           false /* default value */
         };
 
+        fhicl::Atom<bool> PerScheduleSnapshots {
+          fhicl::Name("PerScheduleSnapshots"),
+          fhicl::Comment("give each event its own immutable provider"),
+          false /* default value */
+        };
+
+        fhicl::Atom<bool> LazyInitialization {
+          fhicl::Name("LazyInitialization"),
+          fhicl::Comment("create the provider only when it is first used"),
+          false /* default value */
+        };
+
+        fhicl::Atom<bool> CountProviderCalls {
+          fhicl::Name("CountProviderCalls"),
+          fhicl::Comment("count the provider requests of each module"),
+          false /* default value */
+        };
+
         // provider configuration
         detinfo::DetectorPropertiesStandard::Configuration_t ProviderConfiguration;
 
@@ -83,15 +131,72 @@ namespace detinfo{
       virtual void   reconfigure(fhicl::ParameterSet const& pset) override;
       void   preProcessEvent(const art::Event& evt, art::ScheduleContext);
       void   postOpenFile(const std::string& filename);
+      void   postEndJob();
+
+      virtual const provider_type* provider() const override
+        { fCallCounter.count(); initialize(); return fProp.get(); }
+
+      /// Returns the provider for the event in the schedule
+      /// (only different from `provider()` with *PerScheduleSnapshots*)
+      virtual std::shared_ptr<provider_type const> providerFor
+        (art::ScheduleID schedule) const override;
 
-      virtual const provider_type* provider() const override { return fProp.get();}
+      /// Returns the number of times the provider was updated with the clocks
+      unsigned long long nClockUpdates() const { return fNClockUpdates; }
+
+      /// Returns the number of events which did not need a clock update
+      unsigned long long nClockUpdatesSkipped() const
+        { return fNClockUpdatesSkipped; }
 
     private:
 
+      using Snapshot_t = std::shared_ptr<detinfo::DetectorPropertiesStandard const>;
+      using ClocksSnapshot_t
+        = std::shared_ptr<detinfo::DetectorClocksService::provider_type const>;
+
       std::unique_ptr<detinfo::DetectorPropertiesStandard> fProp;
       fhicl::ParameterSet   fPS;       ///< Original parameter set.
 
       bool fInheritNumberTimeSamples; ///< Flag saying whether to inherit NumberTimeSamples
+      bool fPerScheduleSnapshots; ///< Whether to give each event a snapshot
+      bool fLazyInitialization; ///< Whether to create the provider on first use
+
+      detinfo::ProviderCallCounter fCallCounter; ///< Counts provider requests
+
+      mutable std::once_flag fInitialized; ///< Guards the provider creation
+      std::string fPendingInputFile; ///< File opened before the provider existed
+
+      mutable std::mutex fSnapshotMutex; ///< Protects the snapshot data below
+      std::map<art::ScheduleID, Snapshot_t> fSnapshots; ///< Snapshot per schedule
+      ClocksSnapshot_t fLastClocks; ///< Clocks used by the last snapshot
+      Snapshot_t fLastSnapshot; ///< The most recently created snapshot
+
+      /// Clocks provider the provider was last updated with
+      detinfo::DetectorClocksService::provider_type const* fLastClocksProvider = nullptr;
+      unsigned long long fLastClocksVersion = 0ULL; ///< Its timing version then
+      unsigned long long fNClockUpdates = 0ULL; ///< Number of clock updates
+      unsigned long long fNClockUpdatesSkipped = 0ULL; ///< Number of skipped ones
+
+      /// Updates the provider with the clocks, unless their timing is unchanged
+      void updateClocks();
+
+      /// Parameters not passed to the provider
+      static std::set<std::string> const ServiceParameters;
+
+      /// Creates the provider, unless already done
+      void initialize() const;
+
+      /// Creates the provider and inherits from the last input file
+      void createProvider();
+
+      /// Creates a new provider from the current configuration
+      std::unique_ptr<detinfo::DetectorPropertiesStandard> makeProvider() const;
+
+      /// Creates or reuses the snapshot for the event in the schedule
+      void updateSnapshot(art::ScheduleID schedule);
+
+      /// Drops all the snapshots (after the base configuration changes)
+      void clearSnapshots();
 
       bool isDetectorPropertiesServiceStandard(const fhicl::ParameterSet& ps) const;
 
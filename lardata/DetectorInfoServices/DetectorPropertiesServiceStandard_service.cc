@@ -12,23 +12,72 @@
 #include "lardata/DetectorInfoServices/ServicePack.h" // lar::extractProviders()
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/HistoricalParameterSets.h"
+#include "larcore/CoreUtils/EnsureOnlyOneSchedule.h"
 
-// Art includes
-#include "art_root_io/RootDB/SQLite3Wrapper.h"
-#include "fhiclcpp/make_ParameterSet.h"
+// ROOT includes
+#include "TFile.h"
 
 namespace detinfo{
 
+  //--------------------------------------------------------------------
+  std::set<std::string> const
+  DetectorPropertiesServiceStandard::ServiceParameters
+    { "InheritNumberTimeSamples", "PerScheduleSnapshots", "LazyInitialization",
+      "CountProviderCalls" };
+
   //--------------------------------------------------------------------
   DetectorPropertiesServiceStandard::DetectorPropertiesServiceStandard
     (fhicl::ParameterSet const& pset, art::ActivityRegistry &reg)
     : fInheritNumberTimeSamples(pset.get<bool>("InheritNumberTimeSamples", false))
+    , fPerScheduleSnapshots(pset.get<bool>("PerScheduleSnapshots", false))
+    , fLazyInitialization(pset.get<bool>("LazyInitialization", false))
+    , fCallCounter("DetectorPropertiesServiceStandard",
+        pset.get<bool>("CountProviderCalls", false), reg)
   {
+    // without snapshots, the provider is changed by each event
+    if (!fPerScheduleSnapshots) {
+      lar::EnsureOnlyOneSchedule<DetectorPropertiesServiceStandard> const oneSchedule;
+    }
+
+    // Save the parameter set.
+    fPS = pset;
+
+    if (fLazyInitialization && fPerScheduleSnapshots) {
+      mf::LogWarning("DetectorPropertiesServiceStandard")
+        << "LazyInitialization is not supported with PerScheduleSnapshots:"
+        " the provider is created now.";
+      fLazyInitialization = false;
+    }
+
+    // the provider and its dependencies are created on first use if lazy
+    if (!fLazyInitialization) initialize();
+
     // Register for callbacks.
+    // The clocks service must be constructed first, so that it registers its
+    // own callbacks before ours: we always follow the clocks of the event.
+    art::ServiceHandle<detinfo::DetectorClocksService const>();
 
     reg.sPostOpenFile.watch    (this, &DetectorPropertiesServiceStandard::postOpenFile);
     reg.sPreProcessEvent.watch (this, &DetectorPropertiesServiceStandard::preProcessEvent);
-/*
+    reg.sPostEndJob.watch      (this, &DetectorPropertiesServiceStandard::postEndJob);
+
+  }
+
+  //--------------------------------------------------------------------
+  void DetectorPropertiesServiceStandard::initialize() const
+  {
+    // creating the provider on demand does not change the service content
+    // as seen from the outside, hence the cast
+    std::call_once(fInitialized, [this]()
+      { const_cast<DetectorPropertiesServiceStandard*>(this)->createProvider(); }
+      );
+  }
+
+  //--------------------------------------------------------------------
+  void DetectorPropertiesServiceStandard::createProvider()
+  {
+    /*
     // obtain the required dependency service providers and create our own
     const geo::GeometryCore* geo = lar::providerFrom<geo::Geometry>();
 
@@ -38,39 +87,154 @@ namespace detinfo{
 
     fProp = std::make_unique<detinfo::DetectorPropertiesStandard>(pset,geo,lp,clks);
     */
-    fProp = std::make_unique<detinfo::DetectorPropertiesStandard>(pset,
+    fProp = std::make_unique<detinfo::DetectorPropertiesStandard>(fPS,
       lar::extractProviders<
         geo::Geometry,
         detinfo::LArPropertiesService,
         detinfo::DetectorClocksService
         >(),
-        std::set<std::string>({ "InheritNumberTimeSamples" })
+        ServiceParameters
       );
 
     // at this point we need and expect the provider to be fully configured
     fProp->CheckIfConfigured();
 
-    // Save the parameter set.
-    fPS = pset;
-
+    // catch up with the input file opened before the provider existed
+    if (!fPendingInputFile.empty()) {
+      std::string const filename = std::move(fPendingInputFile);
+      fPendingInputFile.clear();
+      postOpenFile(filename);
+    }
   }
 
   //--------------------------------------------------------------------
   void DetectorPropertiesServiceStandard::reconfigure(fhicl::ParameterSet const& p)
   {
-    fProp->ValidateAndConfigure(p, { "InheritNumberTimeSamples" });
+    initialize();
+    fProp->ValidateAndConfigure(p, ServiceParameters);
 
     // Save the parameter set.
     fPS = p;
 
+    clearSnapshots();
+    fLastClocksVersion = 0ULL; // the next event updates the clocks
+    lar::noteProviderChange();
+
     return;
   }
 
   //-------------------------------------------------------------
-  void DetectorPropertiesServiceStandard::preProcessEvent(const art::Event& evt, art::ScheduleContext)
+  void DetectorPropertiesServiceStandard::preProcessEvent(const art::Event& evt, art::ScheduleContext sc)
   {
+    if (fPerScheduleSnapshots) {
+      updateSnapshot(sc.id());
+      return;
+    }
+    // a provider created later will use the clocks of that time
+    if (!fProp) return;
+
     // Make sure TPC Clock is updated with TimeService (though in principle it shouldn't change
-    fProp->UpdateClocks(lar::providerFrom<detinfo::DetectorClocksService>());
+    updateClocks();
+  }
+
+  //-------------------------------------------------------------
+  void DetectorPropertiesServiceStandard::updateClocks()
+  {
+    auto const& clocksService
+      = *art::ServiceHandle<detinfo::DetectorClocksService const>();
+    auto const* clocks = clocksService.provider();
+    auto const version = clocksService.timingVersion();
+
+    // version 0 means that the clocks service does not track its changes
+    if ((version != 0ULL) && (version == fLastClocksVersion)
+      && (clocks == fLastClocksProvider))
+    {
+      ++fNClockUpdatesSkipped;
+      return;
+    }
+
+    fProp->UpdateClocks(clocks);
+    fLastClocksProvider = clocks;
+    fLastClocksVersion = version;
+    ++fNClockUpdates;
+    lar::noteProviderChange();
+  }
+
+  //-------------------------------------------------------------
+  void DetectorPropertiesServiceStandard::postEndJob()
+  {
+    if (fPerScheduleSnapshots) return;
+    mf::LogInfo("DetectorPropertiesServiceStandard")
+      << "Provider updated with the clocks in " << fNClockUpdates << " of "
+      << (fNClockUpdates + fNClockUpdatesSkipped) << " events";
+  }
+
+  //-------------------------------------------------------------
+  std::shared_ptr<DetectorPropertiesServiceStandard::provider_type const>
+  DetectorPropertiesServiceStandard::providerFor(art::ScheduleID schedule) const
+  {
+    fCallCounter.count();
+    std::lock_guard<std::mutex> lock(fSnapshotMutex);
+    auto const iSnapshot = fSnapshots.find(schedule);
+    if (iSnapshot != fSnapshots.end()) return iSnapshot->second;
+    return DetectorPropertiesService::providerFor(schedule);
+  }
+
+  //-------------------------------------------------------------
+  std::unique_ptr<detinfo::DetectorPropertiesStandard>
+  DetectorPropertiesServiceStandard::makeProvider() const
+  {
+    auto prop = std::make_unique<detinfo::DetectorPropertiesStandard>(fPS,
+      lar::extractProviders<
+        geo::Geometry,
+        detinfo::LArPropertiesService,
+        detinfo::DetectorClocksService
+        >(),
+        ServiceParameters
+      );
+    // the number of samples may have been inherited from the input file
+    prop->SetNumberTimeSamples(fProp->NumberTimeSamples());
+    return prop;
+  }
+
+  //-------------------------------------------------------------
+  void DetectorPropertiesServiceStandard::updateSnapshot(art::ScheduleID schedule)
+  {
+    ClocksSnapshot_t clocks
+      = art::ServiceHandle<detinfo::DetectorClocksService const>()
+      ->providerFor(schedule);
+
+    {
+      std::lock_guard<std::mutex> lock(fSnapshotMutex);
+      // events with the same clock snapshot share the same provider
+      if (fLastSnapshot && (clocks == fLastClocks)) {
+        fSnapshots[schedule] = fLastSnapshot;
+        return;
+      }
+    }
+
+    // the new provider is created without holding the lock
+    auto prop = makeProvider();
+    prop->UpdateClocks(clocks.get());
+
+    // the snapshot also keeps alive the clock snapshot it uses
+    auto holder = std::make_shared<std::pair<ClocksSnapshot_t, Snapshot_t>>
+      (clocks, Snapshot_t(std::move(prop)));
+    Snapshot_t const snapshot(holder, holder->second.get());
+
+    std::lock_guard<std::mutex> lock(fSnapshotMutex);
+    fLastClocks = std::move(clocks);
+    fLastSnapshot = snapshot;
+    fSnapshots[schedule] = snapshot;
+  }
+
+  //-------------------------------------------------------------
+  void DetectorPropertiesServiceStandard::clearSnapshots()
+  {
+    std::lock_guard<std::mutex> lock(fSnapshotMutex);
+    fSnapshots.clear();
+    fLastClocks.reset();
+    fLastSnapshot.reset();
   }
 
   //--------------------------------------------------------------------
@@ -104,6 +268,14 @@ namespace detinfo{
 
     if(!fInheritNumberTimeSamples) return;
 
+    // Without a provider yet, the file is inspected when the provider is
+    // created (only the last file opened matters).
+
+    if(!fProp) {
+      fPendingInputFile = filename;
+      return;
+    }
+
     // The only way to access art service metadata from the input file
     // is to open it as a separate TFile object.  Do that now.
 
@@ -112,20 +284,17 @@ namespace detinfo{
       TFile* file = TFile::Open(filename.c_str(), "READ");
       if(file != 0 && !file->IsZombie() && file->IsOpen()) {
 
-	// Open the sqlite datatabase.
-
-	art::SQLite3Wrapper sqliteDB(file, "RootFileDB");
-
-	// Loop over all stored ParameterSets.
+	// Loop over the ParameterSets stored in the sqlite database which
+	// may be a configuration of this service; each parameter set is
+	// parsed only once in the whole job, and shared with other services.
 
 	unsigned int iNumberTimeSamples = 0;  // Combined value of NumberTimeSamples.
 	unsigned int nNumberTimeSamples = 0;  // Number of NumberTimeSamples parameters seen.
 
-	sqlite3_stmt * stmt = 0;
-	sqlite3_prepare_v2(sqliteDB, "SELECT PSetBlob from ParameterSets;", -1, &stmt, NULL);
-	while (sqlite3_step(stmt) == SQLITE_ROW) {
-	  fhicl::ParameterSet ps;
-	  fhicl::make_ParameterSet(reinterpret_cast<char const *>(sqlite3_column_text(stmt, 0)), ps);
+	auto const psets = HistoricalParameterSets::instance().fromRootFileDB
+	  (*file, { "DetectorPropertiesServiceStandard" });
+	for (auto const& pps: psets) {
+	  fhicl::ParameterSet const& ps = *pps;
 	  // Is this a DetectorPropertiesService parameter set?
 
 	  bool psok = isDetectorPropertiesServiceStandard(ps);
@@ -163,6 +332,8 @@ namespace detinfo{
 	    << "  Configured value:        " << fProp->NumberTimeSamples() << "\n"
 	    << "  Historical (used) value: " << iNumberTimeSamples << "\n";
 	  fProp->SetNumberTimeSamples(iNumberTimeSamples);
+	  clearSnapshots();
+	  lar::noteProviderChange();
 	}
       }
 
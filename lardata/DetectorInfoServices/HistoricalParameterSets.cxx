@@ -0,0 +1,112 @@
+/**
+ * @file   HistoricalParameterSets.cxx
+ * @brief  Process-wide cache of the configurations stored in input files
+ * @date   October 14, 2026
+ * @see    HistoricalParameterSets.h
+ */
+
+// our header
+#include "lardata/DetectorInfoServices/HistoricalParameterSets.h"
+
+// framework libraries
+#include "art_root_io/RootDB/SQLite3Wrapper.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// ROOT and SQLite
+#include "TFile.h"
+#include "sqlite3.h"
+
+// C/C++ standard libraries
+#include <utility> // std::move()
+
+
+//------------------------------------------------------------------------------
+detinfo::HistoricalParameterSets& detinfo::HistoricalParameterSets::instance()
+{
+  static HistoricalParameterSets history;
+  return history;
+} // detinfo::HistoricalParameterSets::instance()
+
+
+//------------------------------------------------------------------------------
+auto detinfo::HistoricalParameterSets::get
+  (std::string const& id, std::string const& blob) -> PSetPtr_t
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto const iPSet = fCache.find(id);
+    if (iPSet != fCache.end()) {
+      ++fNReused;
+      return iPSet->second;
+    }
+  }
+
+  // parsing is the expensive part, and it's done without holding the lock
+  auto pset = std::make_shared<fhicl::ParameterSet>();
+  fhicl::make_ParameterSet(blob, *pset);
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  ++fNParsed;
+  // if another thread has cached the same set meanwhile, that one is kept
+  return fCache.emplace(id, std::move(pset)).first->second;
+} // detinfo::HistoricalParameterSets::get()
+
+
+//------------------------------------------------------------------------------
+auto detinfo::HistoricalParameterSets::fromRootFileDB
+  (TFile& file, std::vector<std::string> const& mustContain)
+  -> std::vector<PSetPtr_t>
+{
+  std::string query = "SELECT ID, PSetBlob FROM ParameterSets";
+  for (std::size_t i = 0; i < mustContain.size(); ++i) {
+    query += (i == 0)? " WHERE ": " AND ";
+    query += "instr(PSetBlob, ?" + std::to_string(i + 1) + ") > 0";
+  }
+  query += ";";
+
+  art::SQLite3Wrapper sqliteDB(&file, "RootFileDB");
+
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(sqliteDB, query.c_str(), -1, &stmt, nullptr)
+    != SQLITE_OK)
+  {
+    throw cet::exception("HistoricalParameterSets")
+      << "Failed to query the configuration database of '" << file.GetName()
+      << "': " << sqlite3_errmsg(sqliteDB) << "\n";
+  }
+  for (std::size_t i = 0; i < mustContain.size(); ++i) {
+    sqlite3_bind_text(stmt, i + 1, mustContain[i].c_str(),
+      mustContain[i].length(), SQLITE_STATIC);
+  }
+
+  std::vector<PSetPtr_t> psets;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    auto const* id
+      = reinterpret_cast<char const*>(sqlite3_column_text(stmt, 0));
+    auto const* blob
+      = reinterpret_cast<char const*>(sqlite3_column_text(stmt, 1));
+    if (!id || !blob) continue;
+    psets.push_back(get(id, blob));
+  } // while
+  sqlite3_finalize(stmt);
+
+  return psets;
+} // detinfo::HistoricalParameterSets::fromRootFileDB()
+
+
+//------------------------------------------------------------------------------
+std::size_t detinfo::HistoricalParameterSets::nParsed() const {
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNParsed;
+} // detinfo::HistoricalParameterSets::nParsed()
+
+
+//------------------------------------------------------------------------------
+std::size_t detinfo::HistoricalParameterSets::nReused() const {
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNReused;
+} // detinfo::HistoricalParameterSets::nReused()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,110 @@
+/**
+ * @file   HistoricalParameterSets.h
+ * @brief  Process-wide cache of the configurations stored in input files
+ * @date   October 14, 2026
+ * @see    HistoricalParameterSets.cxx
+ *
+ * This library is shared by the services which inherit their configuration
+ * from the jobs that produced the input file.
+ */
+
+#ifndef LARDATA_DETECTORINFOSERVICES_HISTORICALPARAMETERSETS_H
+#define LARDATA_DETECTORINFOSERVICES_HISTORICALPARAMETERSETS_H 1
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <memory> // std::shared_ptr<>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstddef> // std::size_t
+
+// ROOT
+class TFile;
+
+
+namespace detinfo {
+
+  /**
+   * @brief Parses each historical parameter set only once per process
+   *
+   * The services inheriting configuration from the input file
+   * (`DetectorClocksServiceStandard`, `DetectorPropertiesServiceStandard`)
+   * scan all the parameter sets stored in each input file. Most of them are
+   * the same from file to file, and they are the same for all the services.
+   * This object parses each of them once, and then returns the parsed
+   * parameter set whenever the same ID is met again, by any service, in any
+   * file:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto& history = detinfo::HistoricalParameterSets::instance();
+   * for (auto const& ps: history.fromRootFileDB
+   *   (*file, { "DetectorPropertiesServiceStandard" })
+   *   )
+   * {
+   *   if (!isDetectorPropertiesServiceStandard(*ps)) continue;
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The selection strings are a first, cheap filter applied by the database
+   * query on the unparsed configuration: only the parameter sets containing
+   * all of them are parsed. They should be necessary conditions (like the
+   * name of a parameter that must be present), since the caller still needs
+   * to check the parsed parameter sets.
+   *
+   * The object is thread-safe.
+   */
+  class HistoricalParameterSets {
+      public:
+
+    /// Type of a parsed parameter set (shared with the cache)
+    using PSetPtr_t = std::shared_ptr<fhicl::ParameterSet const>;
+
+    /// Returns the process-wide instance
+    static HistoricalParameterSets& instance();
+
+    /**
+     * @brief Returns the parameter set with the specified ID
+     * @param id the ID of the parameter set
+     * @param blob the text of the parameter set, to be parsed if not cached
+     * @return the parsed parameter set
+     */
+    PSetPtr_t get(std::string const& id, std::string const& blob);
+
+    /**
+     * @brief Returns the parameter sets from the database in the file
+     * @param file the input file
+     * @param mustContain strings that the selected configurations must contain
+     * @return the selected parameter sets
+     * @throw cet::exception (category `"HistoricalParameterSets"`) if the
+     *        database can't be queried
+     *
+     * This function reads the `RootFileDB` database of files with format
+     * version 5 and later.
+     */
+    std::vector<PSetPtr_t> fromRootFileDB
+      (TFile& file, std::vector<std::string> const& mustContain = {});
+
+    /// Returns how many parameter sets were parsed
+    std::size_t nParsed() const;
+
+    /// Returns how many parameter sets were served from the cache
+    std::size_t nReused() const;
+
+      private:
+
+    mutable std::mutex fMutex; ///< protects all the following data
+    std::unordered_map<std::string, PSetPtr_t> fCache; ///< parsed, by ID
+    std::size_t fNParsed = 0U; ///< number of parameter sets parsed
+    std::size_t fNReused = 0U; ///< number of parameter sets served from cache
+
+    HistoricalParameterSets() = default;
+
+  }; // class HistoricalParameterSets
+
+} // namespace detinfo
+
+
+#endif // LARDATA_DETECTORINFOSERVICES_HISTORICALPARAMETERSETS_H
@@ -0,0 +1,95 @@
+/**
+ * @file   LArOpticalTables.h
+ * @brief  Optical properties of liquid argon as interpolation tables
+ * @date   October 14, 2026
+ *
+ * This is a pure header library.
+ */
+
+#ifndef LARDATA_DETECTORINFOSERVICES_LAROPTICALTABLES_H
+#define LARDATA_DETECTORINFOSERVICES_LAROPTICALTABLES_H 1
+
+// LArSoft libraries
+#include "lardata/Utilities/InterpolationTable.h"
+#include "lardataalg/DetectorInfo/LArProperties.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <string>
+
+
+namespace detinfo {
+
+  /**
+   * @brief The spectra from `detinfo::LArProperties`, as sorted flat tables
+   *
+   * The `detinfo::LArProperties` interface returns each spectrum as a new
+   * `std::map` on each call. This object collects all of them once, as
+   * `lar::util::InterpolationTable` objects which can be evaluated directly:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const& tables
+   *   = art::ServiceHandle<detinfo::LArPropertiesServiceStandard const>()
+   *   ->opticalTables();
+   * double const absLength = tables.absLength(photonEnergy);
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The points and units are the ones of the respective `LArProperties`
+   * methods (energies in eV).
+   */
+  struct LArOpticalTables {
+
+    /// Type of each table
+    using Table_t = lar::util::InterpolationTable<double>;
+
+    /// Type of the tables for each reflective surface, by surface name
+    using SurfaceTables_t = std::map<std::string, Table_t>;
+
+    Table_t fastScint;  ///< `LArProperties::FastScintSpectrum()`
+    Table_t slowScint;  ///< `LArProperties::SlowScintSpectrum()`
+    Table_t rIndex;     ///< `LArProperties::RIndexSpectrum()`
+    Table_t absLength;  ///< `LArProperties::AbsLengthSpectrum()`
+    Table_t rayleigh;   ///< `LArProperties::RayleighSpectrum()`
+    Table_t tpbAbs;     ///< `LArProperties::TpbAbs()`
+    Table_t tpbEm;      ///< `LArProperties::TpbEm()`
+
+    /// `LArProperties::SurfaceReflectances()`
+    SurfaceTables_t surfaceReflectances;
+
+    /// `LArProperties::SurfaceReflectanceDiffuseFractions()`
+    SurfaceTables_t surfaceReflectanceDiffuseFractions;
+
+
+    /// Fills all the tables from the provider
+    static LArOpticalTables build(detinfo::LArProperties const& larp)
+      {
+        LArOpticalTables tables;
+        tables.fastScint = Table_t(larp.FastScintSpectrum());
+        tables.slowScint = Table_t(larp.SlowScintSpectrum());
+        tables.rIndex    = Table_t(larp.RIndexSpectrum());
+        tables.absLength = Table_t(larp.AbsLengthSpectrum());
+        tables.rayleigh  = Table_t(larp.RayleighSpectrum());
+        tables.tpbAbs    = Table_t(larp.TpbAbs());
+        tables.tpbEm     = Table_t(larp.TpbEm());
+        tables.surfaceReflectances
+          = buildSurfaceTables(larp.SurfaceReflectances());
+        tables.surfaceReflectanceDiffuseFractions
+          = buildSurfaceTables(larp.SurfaceReflectanceDiffuseFractions());
+        return tables;
+      }
+
+      private:
+
+    static SurfaceTables_t buildSurfaceTables
+      (std::map<std::string, std::map<double, double>> const& surfaces)
+      {
+        SurfaceTables_t tables;
+        for (auto const& surface: surfaces)
+          tables.emplace(surface.first, Table_t(surface.second));
+        return tables;
+      }
+
+  }; // struct LArOpticalTables
+
+} // namespace detinfo
+
+
+#endif // LARDATA_DETECTORINFOSERVICES_LAROPTICALTABLES_H
@@ -10,32 +10,97 @@
 #define LARPROPERTIESSERVICESTANDARD_H
 
 #include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/types/Atom.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "art/Framework/Principal/Run.h"
 #include "lardataalg/DetectorInfo/LArPropertiesStandard.h"
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
+#include "lardata/DetectorInfoServices/LArOpticalTables.h"
+#include "lardata/DetectorInfoServices/ProviderCallCounter.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 ///General LArSoft Utilities
 namespace detinfo{
+
+  /**
+   * @brief _art_ service managing `detinfo::LArPropertiesStandard`
+   *
+   * In addition to the provider, the service offers the optical spectra of
+   * the provider as interpolation tables (`opticalTables()`). They are built
+   * at the beginning of each run, after the provider is updated, and stay
+   * unchanged until the next run.
+   *
+   * Besides the provider configuration, the service reacts to:
+   * - *LazyInitialization* (boolean; default: false): if true, the provider
+   *   is configured and updated only on the first call to `provider()` (or
+   *   `opticalTables()`), so that jobs where no module uses this service skip
+   *   that work
+   * - *CountProviderCalls* (boolean; default: false): if true, the requests
+   *   of the provider are counted by module, and a summary is printed at the
+   *   end of the job (see `detinfo::ProviderCallCounter`)
+   */
   class LArPropertiesServiceStandard : public LArPropertiesService {
     public:
 
+      struct ServiceConfiguration_t {
+
+        // service-specific configuration
+        fhicl::Atom<bool> LazyInitialization {
+          fhicl::Name("LazyInitialization"),
+          fhicl::Comment("configure the provider only when it is first used"),
+          false /* default value */
+        };
+
+        fhicl::Atom<bool> CountProviderCalls {
+          fhicl::Name("CountProviderCalls"),
+          fhicl::Comment("count the provider requests of each module"),
+          false /* default value */
+        };
+
+        // provider configuration
+        detinfo::LArPropertiesStandard::ConfigurationParameters_t ProviderConfiguration;
+
+      }; // ServiceConfiguration_t
+
       // this enables art to print the configuration help:
-      using Parameters = art::ServiceTable<detinfo::LArPropertiesStandard::ConfigurationParameters_t>;
+      using Parameters = art::ServiceTable<ServiceConfiguration_t>;
 
       LArPropertiesServiceStandard(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
 
       virtual void   reconfigure(fhicl::ParameterSet const& pset) override;
       void   preBeginRun(const art::Run& run);
 
-      virtual const  provider_type* provider() const override { return fProp.get();}
+      virtual const  provider_type* provider() const override
+        { fCallCounter.count(); initialize(); return fProp.get(); }
+
+      /// Returns the optical spectra of the current run, as tables
+      detinfo::LArOpticalTables const& opticalTables() const
+        { initialize(); return fOpticalTables; }
 
     private:
 
       std::unique_ptr<detinfo::LArPropertiesStandard> fProp;
 
+      fhicl::ParameterSet fPS; ///< Configuration of the provider
+      bool fLazyInitialization; ///< Whether to configure on first use
+      detinfo::ProviderCallCounter fCallCounter; ///< Counts provider requests
+      int fRun = -1; ///< Current run (negative if none yet)
+      mutable std::atomic<bool> fConfigured { false }; ///< Whether fProp is up to date
+      mutable std::mutex fInitMutex; ///< Guards the provider configuration
+
+      /// Configures and updates the provider, unless already done
+      void initialize() const;
+
+      /// Configures the provider and updates it to the current run
+      void configureProvider();
+
+      detinfo::LArOpticalTables fOpticalTables; ///< Spectra of the current run
+
     }; // class LArPropertiesServiceStandard
 } //namespace detinfo
 DECLARE_ART_SERVICE_INTERFACE_IMPL(detinfo::LArPropertiesServiceStandard, detinfo::LArPropertiesService, SHARED)
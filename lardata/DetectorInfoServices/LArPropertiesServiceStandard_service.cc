@@ -9,9 +9,13 @@
 
 // LArSoft includes
 #include "lardata/DetectorInfoServices/LArPropertiesServiceStandard.h"
+#include "lardata/DetectorInfoServices/ServicePack.h" // lar::noteProviderChange()
 
 //-----------------------------------------------
 detinfo::LArPropertiesServiceStandard::LArPropertiesServiceStandard(fhicl::ParameterSet const& pset, art::ActivityRegistry &reg)
+  : fLazyInitialization(pset.get<bool>("LazyInitialization", false))
+  , fCallCounter("LArPropertiesServiceStandard",
+      pset.get<bool>("CountProviderCalls", false), reg)
 {
   fProp.reset(new detinfo::LArPropertiesStandard());
 
@@ -22,7 +26,36 @@ detinfo::LArPropertiesServiceStandard::LArPropertiesServiceStandard(fhicl::Param
 //----------------------------------------------
 void detinfo::LArPropertiesServiceStandard::preBeginRun(const art::Run& run)
 {
-  fProp->Update(run.id().run());
+  fRun = run.id().run();
+  if (!fConfigured) return; // updated on first use
+
+  fProp->Update(fRun);
+  fOpticalTables = detinfo::LArOpticalTables::build(*fProp);
+  lar::noteProviderChange();
+}
+
+//----------------------------------------------
+void detinfo::LArPropertiesServiceStandard::initialize() const
+{
+  if (fConfigured) return;
+
+  std::lock_guard<std::mutex> lock(fInitMutex);
+  if (fConfigured) return;
+  // configuring on demand does not change the service content as seen from
+  // the outside, hence the cast
+  const_cast<LArPropertiesServiceStandard*>(this)->configureProvider();
+  fConfigured = true;
+}
+
+//----------------------------------------------
+void detinfo::LArPropertiesServiceStandard::configureProvider()
+{
+  fProp->Configure(fPS, { "LazyInitialization", "CountProviderCalls" });
+  if (fRun >= 0) {
+    fProp->Update(fRun);
+    fOpticalTables = detinfo::LArOpticalTables::build(*fProp);
+  }
+  lar::noteProviderChange();
 }
 
 
@@ -31,7 +64,9 @@ void detinfo::LArPropertiesServiceStandard::preBeginRun(const art::Run& run)
 /// \todo these values should eventually come from a database
 void detinfo::LArPropertiesServiceStandard::reconfigure(fhicl::ParameterSet const& pset)
 {
-  fProp->Configure(pset);
+  fPS = pset;
+  fConfigured = false;
+  if (!fLazyInitialization) initialize();
   return;
 }
 
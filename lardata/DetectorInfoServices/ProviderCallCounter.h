@@ -0,0 +1,143 @@
+/**
+ * @file   ProviderCallCounter.h
+ * @brief  Counts the requests of a service provider, by module
+ * @date   October 14, 2026
+ *
+ * This is a pure header library.
+ */
+
+#ifndef LARDATA_DETECTORINFOSERVICES_PROVIDERCALLCOUNTER_H
+#define LARDATA_DETECTORINFOSERVICES_PROVIDERCALLCOUNTER_H 1
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility> // std::move()
+
+
+namespace art { class Event; }
+
+namespace detinfo {
+
+  /**
+   * @brief Counts how many times each module requests a service provider
+   *
+   * A service owning this object calls `count()` each time its provider is
+   * requested (`provider()`, `providerFor()`). When enabled, the request is
+   * assigned to the module currently running on the calling thread (or to
+   * `"(no module)"`, e.g. for the requests from other services or from tasks
+   * spawned by a module on other threads). At the end of the job, a summary
+   * is printed on the `mf::LogInfo` stream with the name of the service:
+   * for each module, the number of requests, in how many module calls, their
+   * average and their maximum in a single module call, and the number of
+   * events processed.
+   *
+   * When disabled, `count()` is a single test of a constant flag.
+   *
+   * The services enable this by the service parameter *CountProviderCalls*.
+   */
+  class ProviderCallCounter {
+      public:
+
+    /// Label assigned to the requests not made from within a module
+    static constexpr char const* NoModuleLabel = "(no module)";
+
+    /// Constructor: registers the callbacks if `enabled`
+    ProviderCallCounter
+      (std::string serviceName, bool enabled, art::ActivityRegistry& reg)
+      : fServiceName(std::move(serviceName)), fEnabled(enabled)
+      {
+        if (!fEnabled) return;
+        reg.sPreModule.watch(this, &ProviderCallCounter::preModule);
+        reg.sPostModule.watch(this, &ProviderCallCounter::postModule);
+        reg.sPreProcessEvent.watch(this, &ProviderCallCounter::preProcessEvent);
+        reg.sPostEndJob.watch(this, &ProviderCallCounter::postEndJob);
+      }
+
+    /// Returns whether the requests are counted
+    bool enabled() const { return fEnabled; }
+
+    /// Records a request of the provider
+    void count() const { if (fEnabled) record(); }
+
+      private:
+
+    /// Counters of one module
+    struct ModuleCounts_t {
+      unsigned long long requests = 0ULL; ///< total requests
+      unsigned long long calls = 0ULL; ///< module calls with requests
+      unsigned long long current = 0ULL; ///< requests in the running call
+      unsigned long long maxPerCall = 0ULL; ///< most requests in one call
+    }; // ModuleCounts_t
+
+    std::string const fServiceName; ///< name of the service, for the summary
+    bool const fEnabled; ///< whether to count at all
+
+    mutable std::mutex fMutex; ///< protects the counters
+    mutable std::map<std::string, ModuleCounts_t> fCounts; ///< by module label
+    std::atomic<unsigned long long> fNEvents { 0ULL }; ///< events processed
+
+    /// Returns the label of the module running in this thread (or empty)
+    static std::string& currentModule()
+      { static thread_local std::string label; return label; }
+
+    void record() const
+      {
+        std::string const& label = currentModule();
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto& counts = fCounts[label.empty()? std::string(NoModuleLabel): label];
+        ++counts.requests;
+        ++counts.current;
+      }
+
+    void preModule(art::ModuleContext const& mc)
+      { currentModule() = mc.moduleLabel(); }
+
+    void postModule(art::ModuleContext const& mc)
+      {
+        currentModule().clear();
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto const iCounts = fCounts.find(mc.moduleLabel());
+        if (iCounts == fCounts.end()) return;
+        ModuleCounts_t& counts = iCounts->second;
+        if (counts.current == 0ULL) return;
+        ++counts.calls;
+        counts.maxPerCall = std::max(counts.maxPerCall, counts.current);
+        counts.current = 0ULL;
+      }
+
+    void preProcessEvent(art::Event const&, art::ScheduleContext)
+      { ++fNEvents; }
+
+    void postEndJob()
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        mf::LogInfo log(fServiceName);
+        log << "Provider requests in " << fNEvents << " events:";
+        if (fCounts.empty()) log << " none";
+        for (auto const& moduleCounts: fCounts) {
+          ModuleCounts_t const& counts = moduleCounts.second;
+          log << "\n  " << moduleCounts.first << ": " << counts.requests;
+          if (counts.calls > 0ULL) {
+            log << " in " << counts.calls << " module calls ("
+              << (double(counts.requests) / counts.calls) << " per call, at most "
+              << counts.maxPerCall << ")";
+          }
+        } // for
+      }
+
+  }; // class ProviderCallCounter
+
+} // namespace detinfo
+
+
+#endif // LARDATA_DETECTORINFOSERVICES_PROVIDERCALLCOUNTER_H
@@ -13,6 +13,9 @@
 #include "larcorealg/CoreUtils/ProviderPack.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
 
+// C/C++ standard libraries
+#include <atomic>
+
 
 namespace lar {
   /*
@@ -54,6 +57,100 @@ namespace lar {
   ProviderPackFromServices<Services...> extractProviders()
     { return { lar::providerFrom<Services>()... }; }
 
+
+  /// Type of the stamp of the state of the service providers
+  using ProviderStamp_t = unsigned long long;
+
+  namespace details {
+    /// Returns the process-wide counter of the provider changes
+    inline std::atomic<ProviderStamp_t>& providerStampCounter()
+      { static std::atomic<ProviderStamp_t> counter { 1ULL }; return counter; }
+  } // namespace details
+
+  /// Returns the current stamp of the state of all the service providers
+  inline ProviderStamp_t currentProviderStamp()
+    { return details::providerStampCounter().load(std::memory_order_acquire); }
+
+  /**
+   * @brief Declares that the content of a service provider has changed
+   *
+   * Services call this after they have changed their provider (e.g. after a
+   * new configuration, a new run or new trigger times), so that the
+   * `ProviderSnapshot` objects created before can tell they are stale.
+   */
+  inline void noteProviderChange()
+    { details::providerStampCounter().fetch_add(1ULL, std::memory_order_acq_rel); }
+
+
+  /**
+   * @brief Providers from specified services, with the stamp of their state
+   * @tparam Services the services to extract the providers from
+   *
+   * A snapshot is extracted once from the services (which requires the
+   * service registry), and then it can be copied for free, e.g. into each of
+   * the tasks of a parallel algorithm:
+   *
+   *     auto const providers = lar::makeProviderSnapshot
+   *       <detinfo::DetectorClocksService, detinfo::DetectorPropertiesService>();
+   *
+   *     tbb::parallel_for(range, [providers](auto const& r){
+   *       auto const* detProp = providers.get<detinfo::DetectorProperties>();
+   *       // ...
+   *     });
+   *
+   * The snapshot does not own the providers: as with `extractProviders()`,
+   * the pointers are valid as long as the services are. The content of the
+   * providers may change between events; `isStale()` tells whether any of
+   * the services has declared a change (`noteProviderChange()`) since the
+   * snapshot was taken, in which case a new one should be extracted.
+   * The check is a single atomic read.
+   */
+  template <typename... Services>
+  class ProviderSnapshot {
+      public:
+    /// Type of the pack of providers
+    using Pack_t = ProviderPackFromServices<Services...>;
+
+    /// Constructor: stores the providers with the specified stamp
+    ProviderSnapshot(Pack_t providers, ProviderStamp_t stamp)
+      : fProviders(providers), fStamp(stamp) {}
+
+    /// Returns the providers
+    Pack_t const& providers() const { return fProviders; }
+
+    /// Converts the snapshot into its provider pack, e.g. for `Setup()` calls
+    operator Pack_t const&() const { return providers(); }
+
+    /// Returns the provider of the specified type
+    template <typename Provider>
+    Provider const* get() const { return fProviders.template get<Provider>(); }
+
+    /// Returns the stamp of the providers state when the snapshot was taken
+    ProviderStamp_t stamp() const { return fStamp; }
+
+    /// Returns whether a provider has changed since the snapshot was taken
+    bool isStale() const { return fStamp != currentProviderStamp(); }
+
+    /// Extracts a new snapshot from the services
+    static ProviderSnapshot extract()
+      {
+        // the stamp is read first: a change meanwhile makes the snapshot stale
+        ProviderStamp_t const stamp = currentProviderStamp();
+        return { extractProviders<Services...>(), stamp };
+      }
+
+      private:
+    Pack_t fProviders; ///< the providers
+    ProviderStamp_t fStamp; ///< stamp of the providers state
+
+  }; // class ProviderSnapshot<>
+
+
+  /// Returns a new snapshot of the providers from the specified services
+  template <typename... Services>
+  ProviderSnapshot<Services...> makeProviderSnapshot()
+    { return ProviderSnapshot<Services...>::extract(); }
+
 } // namespace lar
 
 //==============================================================================
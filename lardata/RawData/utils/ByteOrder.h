@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  ByteOrder.h
+/// \brief Reversal of the byte order of the words of raw binary data
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#ifndef LARDATA_RAWDATA_UTILS_BYTEORDER_H
+#define LARDATA_RAWDATA_UTILS_BYTEORDER_H
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <type_traits>
+
+namespace lris {
+
+  /// Returns `value` with its bytes in the reverse order
+  template <typename T>
+  T byteSwapped(T value);
+
+  /// Reverses the byte order of `value` in place
+  template <typename T>
+  void swapByteOrder(T& value) { value = byteSwapped(value); }
+
+  /**
+   * @brief Reverses the byte order of `n` integral values in place
+   *
+   * The loop has no branches and is written with shifts on the unsigned
+   * values, so that the compiler turns it into byte shuffles on whole
+   * vector registers.
+   */
+  template <typename T>
+  void swapByteOrder(T* values, std::size_t n);
+
+} // namespace lris
+
+
+//----------------------------------------------------------------------
+//--- template implementation
+//----------------------------------------------------------------------
+namespace lris {
+  namespace details {
+
+    template <std::size_t Size> struct ByteSwapper;
+
+    template <> struct ByteSwapper<1U> {
+      static std::uint8_t swap(std::uint8_t v) { return v; }
+    };
+
+    template <> struct ByteSwapper<2U> {
+      static std::uint16_t swap(std::uint16_t v)
+        { return std::uint16_t((v << 8) | (v >> 8)); }
+    };
+
+    template <> struct ByteSwapper<4U> {
+      static std::uint32_t swap(std::uint32_t v)
+        {
+          return (v << 24) | ((v << 8) & 0x00FF0000U)
+            | ((v >> 8) & 0x0000FF00U) | (v >> 24);
+        }
+    };
+
+    template <> struct ByteSwapper<8U> {
+      static std::uint64_t swap(std::uint64_t v)
+        {
+          return (std::uint64_t(ByteSwapper<4U>::swap(std::uint32_t(v))) << 32)
+            | ByteSwapper<4U>::swap(std::uint32_t(v >> 32));
+        }
+    };
+
+  } // namespace details
+} // namespace lris
+
+
+//----------------------------------------------------------------------
+template <typename T>
+T lris::byteSwapped(T value)
+{
+  static_assert(std::is_integral<T>(),
+    "Only the byte order of integral values can be reversed");
+  using Unsigned_t = std::make_unsigned_t<T>;
+  return T(details::ByteSwapper<sizeof(T)>::swap(Unsigned_t(value)));
+}
+
+
+//----------------------------------------------------------------------
+template <typename T>
+void lris::swapByteOrder(T* values, std::size_t n)
+{
+  static_assert(std::is_integral<T>(),
+    "Only the byte order of integral values can be reversed");
+  // signed and unsigned variants of a type may alias each other
+  using Unsigned_t = std::make_unsigned_t<T>;
+  Unsigned_t* words = reinterpret_cast<Unsigned_t*>(values);
+  for (std::size_t i = 0; i < n; ++i)
+    words[i] = details::ByteSwapper<sizeof(T)>::swap(words[i]);
+}
+
+
+#endif // LARDATA_RAWDATA_UTILS_BYTEORDER_H
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  DecodingStats.h
+/// \brief Time and throughput accounting for the raw input drivers
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#ifndef LARDATA_RAWDATA_UTILS_DECODINGSTATS_H
+#define LARDATA_RAWDATA_UTILS_DECODINGSTATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef> // std::size_t
+
+namespace lris {
+  struct DecodingStats;
+}
+
+/**
+ * @brief Time spent in each stage of the reading of event files, and counts
+ *
+ * The stages are:
+ * - `kOpen`: opening and mapping the file
+ * - `kRead`: copying headers and ADC counts from the file (this is where the
+ *   data is actually read from storage, as the mapped pages are accessed)
+ * - `kDecode`: interpretation of the headers and fixes to the ADC counts
+ * - `kDigits`: construction of the `raw::RawDigit` objects
+ * - `kCompress`: compression of the digits
+ * - `kWait`: time the event loop waited for the prefetching thread
+ *
+ * With prefetching, all stages but `kWait` happen on the prefetching thread,
+ * and `kWait` is the only time spent by the event loop.
+ *
+ * The time of consecutive stages is measured with a `Stopwatch`:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * lris::DecodingStats::Stopwatch watch(stats);
+ * lris::MappedEventFile infile(path);
+ * watch.lap(lris::DecodingStats::kOpen);
+ * infile.read(h1);
+ * watch.lap(lris::DecodingStats::kRead);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+struct lris::DecodingStats {
+
+  /// Stages of the reading of an event file
+  enum Stage_t {
+    kOpen,     ///< opening and mapping the file
+    kRead,     ///< copying data from the file
+    kDecode,   ///< interpreting the data
+    kDigits,   ///< creating the raw digits
+    kCompress, ///< compressing the raw digits
+    kWait,     ///< waiting for a prefetched file
+    NStages    ///< number of stages
+  };
+
+  /// Measures the time of consecutive stages
+  class Stopwatch {
+   public:
+    /// Starts measuring time for `stats`
+    explicit Stopwatch(DecodingStats& stats)
+      : fStats(stats), fLast(clock_t::now()) {}
+
+    /// Assigns the time since the last lap (or the start) to `stage`
+    void lap(Stage_t stage)
+      {
+        auto const now = clock_t::now();
+        fStats.seconds[stage]
+          += std::chrono::duration<double>(now - fLast).count();
+        fLast = now;
+      }
+
+   private:
+    using clock_t = std::chrono::steady_clock;
+
+    DecodingStats& fStats; ///< where the time is accounted
+    clock_t::time_point fLast; ///< time of the last lap
+  }; // class Stopwatch
+
+
+  std::array<double, NStages> seconds {}; ///< time per stage [s]
+  std::size_t files = 0;    ///< number of event files
+  std::size_t bytes = 0;    ///< size of the event files [bytes]
+  std::size_t channels = 0; ///< number of channels read
+  std::size_t samples = 0;  ///< number of ADC samples read
+
+
+  /// Adds the counts and times from `other`
+  DecodingStats& operator+= (DecodingStats const& other)
+    {
+      for (std::size_t i = 0; i < NStages; ++i) seconds[i] += other.seconds[i];
+      files += other.files;
+      bytes += other.bytes;
+      channels += other.channels;
+      samples += other.samples;
+      return *this;
+    }
+
+  /// Returns the time spent in all the stages of decoding (but waiting) [s]
+  double decodingTime() const
+    {
+      double total = 0.0;
+      for (std::size_t i = 0; i < kWait; ++i) total += seconds[i];
+      return total;
+    }
+
+  /// Returns the name of the stage
+  static char const* stageName(Stage_t stage)
+    {
+      switch (stage) {
+        case kOpen:     return "open";
+        case kRead:     return "read";
+        case kDecode:   return "decode";
+        case kDigits:   return "digits";
+        case kCompress: return "compress";
+        case kWait:     return "wait";
+        default:        return "unknown";
+      } // switch
+    }
+
+  /**
+   * @brief Writes the statistics into a stream, on a single line
+   * @tparam Stream type of stream (`std::ostream` or message facility)
+   *
+   * The throughput of the input is computed from the time spent in opening
+   * and reading the files, and the one of the whole decoding from the time
+   * of all the stages except the waiting.
+   */
+  template <typename Stream>
+  void dump(Stream&& out) const
+    {
+      out << files << " files, " << (bytes / 1048576.0) << " MiB, "
+        << channels << " channels, " << samples << " samples;";
+      for (std::size_t i = 0; i < NStages; ++i) {
+        out << " " << stageName(static_cast<Stage_t>(i))
+          << " " << (seconds[i] * 1000.0) << " ms";
+      }
+      double const ioTime = seconds[kOpen] + seconds[kRead];
+      if (ioTime > 0.0)
+        out << "; input " << (bytes / 1048576.0 / ioTime) << " MiB/s";
+      double const total = decodingTime();
+      if (total > 0.0)
+        out << "; decoding " << (channels / total) << " channels/s";
+    }
+
+}; // struct lris::DecodingStats
+
+
+#endif // LARDATA_RAWDATA_UTILS_DECODINGSTATS_H
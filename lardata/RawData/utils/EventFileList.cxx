@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  EventFileList.cxx
+/// \brief Discovery and sorting of the DAQ480 event files of a directory
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#include "lardata/RawData/utils/EventFileList.h"
+
+#include "canvas/Utilities/Exception.h"
+
+#include <algorithm>
+#include <fstream>
+#include <tuple>
+#include <utility>
+#include <cerrno>
+#include <cstdio> // std::rename(), std::remove()
+#include <cstdlib> // atoi()
+#include <cstring> // std::strerror()
+
+extern "C" {
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+namespace {
+
+  // ======================================================================
+  int run( std::string const& s1 )
+  {
+    size_t p1 = s1.find("R");
+    size_t p2 = s1.find("_E");
+
+    int run = atoi((s1.substr(p1+1,p2-p1-1)).c_str());
+    return run;
+  }
+
+
+  // ======================================================================
+  int event( std::string const& s1 )
+  {
+    size_t p1 = s1.find("E");
+    size_t p2 = s1.find("_T");
+
+    int event = atoi((s1.substr(p1+1,p2-p1-1)).c_str());
+    return event;
+  }
+
+
+  // ======================================================================
+  bool isEventFile( std::string const& filename )
+  {
+    return filename.find("bin") != std::string::npos;
+  }
+
+
+  // ======================================================================
+  // first line of the index files, identifying their format
+  std::string const IndexSignature = "LArRawInput event file index v1";
+
+  // modification time of a directory: seconds and nanoseconds
+  typedef std::pair<long long, long long> mtime_t;
+
+  mtime_t directoryTime( std::string const& dir )
+  {
+    struct stat info;
+    if (::stat(dir.c_str(), &info) != 0) {
+      throw art::Exception( art::errors::FileOpenError )
+        << "Error reading directory " << dir
+        << ": " << std::strerror(errno) << std::endl;
+    }
+    return { info.st_mtim.tv_sec, info.st_mtim.tv_nsec };
+  }
+
+
+  // ======================================================================
+  // the index of /a/b/c is <indexDir>/_a_b_c.index
+  std::string indexPath( std::string const& dir, std::string const& indexDir )
+  {
+    std::string name = dir;
+    while (name.size() > 1 && name.back() == '/') name.pop_back();
+    std::replace(name.begin(), name.end(), '/', '_');
+    return indexDir + "/" + name + ".index";
+  }
+
+
+  // ======================================================================
+  // reads the list from the index; returns false if the index is not valid
+  bool readIndex( std::string const& path,
+                  std::string const& dir,
+                  mtime_t const& dirTime,
+                  std::vector<std::string>& files )
+  {
+    std::ifstream index(path);
+    if (!index) return false;
+
+    std::string line;
+    if (!std::getline(index, line) || line != IndexSignature) return false;
+    if (!std::getline(index, line) || line != dir) return false;
+
+    mtime_t indexTime;
+    std::size_t nFiles = 0;
+    if (!(index >> indexTime.first >> indexTime.second >> nFiles))
+      return false;
+    if (indexTime != dirTime) return false;
+    std::getline(index, line); // end of the time line
+
+    files.clear();
+    files.reserve(nFiles);
+    while (std::getline(index, line)) files.push_back(line);
+    return files.size() == nFiles;
+  }
+
+
+  // ======================================================================
+  // writes the index; the new index replaces the old one only when complete
+  void writeIndex( std::string const& path,
+                   std::string const& dir,
+                   mtime_t const& dirTime,
+                   std::vector<std::string> const& files )
+  {
+    std::string const tmpPath = path + ".tmp" + std::to_string(::getpid());
+    {
+      std::ofstream index(tmpPath);
+      index << IndexSignature << '\n' << dir << '\n'
+            << dirTime.first << ' ' << dirTime.second << ' ' << files.size()
+            << '\n';
+      for (std::string const& file: files) index << file << '\n';
+      if (index.flush()) {
+        index.close();
+        if (std::rename(tmpPath.c_str(), path.c_str()) == 0) return;
+      }
+    }
+    // the index is only a cache: failing to write it is not an error
+    std::remove(tmpPath.c_str());
+  }
+
+
+  // ======================================================================
+  std::vector<std::string> scandirectory( std::string const& dir )
+  {
+    std::vector<std::string> files;
+
+    DIR * dp = NULL;
+    if( (dp = opendir(dir.c_str())) == NULL ) {
+      throw art::Exception( art::errors::FileOpenError )
+        << "Error opening directory " << dir << std::endl;
+    }
+
+    dirent * dirp = NULL;
+    while( (dirp = readdir(dp)) != NULL ) {
+      std::string filename( dirp->d_name );
+      if( isEventFile(filename) ) {
+        files.push_back(filename);
+      }
+    }
+    closedir(dp);
+
+    lris::sortEventFiles(files);
+
+    return files;
+  }  // scandirectory()
+
+} // namespace
+
+
+namespace lris {
+
+  // ======================================================================
+  void sortEventFiles( std::vector<std::string>& files )
+  {
+    // extract the run and event numbers only once per file
+    typedef std::tuple<int, int, std::string> key_t;
+    std::vector<key_t> keys;
+    keys.reserve(files.size());
+    for (std::string& file: files)
+      keys.emplace_back(run(file), event(file), std::move(file));
+
+    std::sort(keys.begin(), keys.end());
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      files[i] = std::move(std::get<2>(keys[i]));
+  }  // sortEventFiles()
+
+
+  // ======================================================================
+  std::vector<std::string> getsortedfiles( std::string const& dir,
+                                           std::string const& indexDir )
+  {
+    if( dir == "" )
+      throw art::Exception( art::errors::Configuration )
+        << "Vacuous directory name" << std::endl;
+
+    if (indexDir.empty()) return scandirectory(dir);
+
+    // the time is taken before the scan, so that changes during the scan
+    // invalidate the index
+    mtime_t const dirTime = directoryTime(dir);
+    std::string const path = indexPath(dir, indexDir);
+
+    std::vector<std::string> files;
+    if (readIndex(path, dir, dirTime, files)) return files;
+
+    files = scandirectory(dir);
+    writeIndex(path, dir, dirTime, files);
+    return files;
+  }  // getsortedfiles()
+
+
+  // ======================================================================
+  EventFileWatcher::EventFileWatcher(std::string const& dir)
+    : fDir(dir)
+  {
+    fFD = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fFD < 0) {
+      throw art::Exception( art::errors::FileOpenError )
+        << "Error starting to watch directory " << fDir
+        << ": " << std::strerror(errno) << std::endl;
+    }
+    // files are reported when completely written, or when moved in
+    if (::inotify_add_watch(fFD, fDir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+      int const error = errno;
+      ::close(fFD);
+      throw art::Exception( art::errors::FileOpenError )
+        << "Error starting to watch directory " << fDir
+        << ": " << std::strerror(error) << std::endl;
+    }
+  }
+
+  // ======================================================================
+  EventFileWatcher::~EventFileWatcher()
+  {
+    ::close(fFD);
+  }
+
+  // ======================================================================
+  void EventFileWatcher::markKnown(std::vector<std::string> const& files)
+  {
+    fKnown.insert(files.begin(), files.end());
+  }
+
+  // ======================================================================
+  std::vector<std::string> EventFileWatcher::waitForFiles
+    (std::chrono::milliseconds timeout)
+  {
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::vector<std::string> files = readEvents();
+    while (files.empty()) {
+      auto const left = std::chrono::duration_cast<std::chrono::milliseconds>
+        (deadline - std::chrono::steady_clock::now());
+      if (left.count() <= 0) break;
+
+      pollfd pfd { fFD, POLLIN, 0 };
+      int const res = ::poll(&pfd, 1, static_cast<int>(left.count()));
+      if (res < 0 && errno != EINTR) {
+        throw art::Exception( art::errors::FileReadError )
+          << "Error watching directory " << fDir
+          << ": " << std::strerror(errno) << std::endl;
+      }
+      files = readEvents();
+    }
+
+    sortEventFiles(files);
+    return files;
+  }
+
+  // ======================================================================
+  std::vector<std::string> EventFileWatcher::readEvents()
+  {
+    std::vector<std::string> files;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+      ssize_t const n = ::read(fFD, buffer, sizeof(buffer));
+      if (n <= 0) break; // no more pending notifications (EAGAIN)
+
+      char const* ptr = buffer;
+      while (ptr < buffer + n) {
+        inotify_event const* event
+          = reinterpret_cast<inotify_event const*>(ptr);
+        ptr += sizeof(inotify_event) + event->len;
+        if (event->len == 0) continue;
+
+        std::string filename(event->name);
+        if (!isEventFile(filename)) continue;
+        if (!fKnown.insert(filename).second) continue; // already reported
+        files.push_back(std::move(filename));
+      }
+    }
+    return files;
+  }
+
+} // namespace lris
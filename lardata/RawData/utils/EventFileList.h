@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  EventFileList.h
+/// \brief Discovery and sorting of the DAQ480 event files of a directory
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#ifndef LARDATA_RAWDATA_UTILS_EVENTFILELIST_H
+#define LARDATA_RAWDATA_UTILS_EVENTFILELIST_H
+
+#include <chrono>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace lris {
+
+  /**
+   * @brief Returns the event files in a directory, sorted by run and event
+   * @param dir the directory with the event files
+   * @param indexDir directory where to keep the index file (empty: no index)
+   * @return the names of the files (without the directory)
+   * @throw art::Exception (`Configuration`) if `dir` is empty
+   * @throw art::Exception (`FileOpenError`) if `dir` can't be read
+   *
+   * The event files are the ones with "bin" in their name, and they are
+   * sorted by the run and event numbers in the name (`R<run>_E<event>_T...`).
+   *
+   * If `indexDir` is specified, the sorted list is also saved into an index
+   * file in there (named after `dir`), together with the modification time
+   * of `dir`. As long as `dir` is not modified (no file is added, removed or
+   * renamed), the list is then read back from the index instead of scanning
+   * and sorting the whole directory again. The index must not be kept in
+   * `dir` itself, since writing it would modify `dir`. If the index can't be
+   * written, it is just not used.
+   */
+  std::vector<std::string> getsortedfiles
+    (std::string const& dir, std::string const& indexDir = "");
+
+  /// Sorts event file names by run and event number (see `getsortedfiles()`)
+  void sortEventFiles(std::vector<std::string>& files);
+
+  class EventFileWatcher;
+
+} // namespace lris
+
+
+/**
+ * @brief Reports the event files which appear in a directory
+ *
+ * This object uses `inotify` to learn about the files completely written in
+ * (or moved into) the directory while the job is running, for nearline
+ * processing. To avoid missing files, it should be created before the
+ * directory is scanned, and the files from the scan should be marked as
+ * known:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * lris::EventFileWatcher watcher(dir);
+ * std::vector<std::string> files = lris::getsortedfiles(dir);
+ * watcher.markKnown(files);
+ *
+ * // ... after all files have been processed:
+ * std::vector<std::string> newFiles
+ *   = watcher.waitForFiles(std::chrono::seconds(30));
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Each file is reported only once.
+ */
+class lris::EventFileWatcher {
+ public:
+  /// Starts watching `dir`; throws `art::Exception` (`FileOpenError`) on
+  /// failure
+  explicit EventFileWatcher(std::string const& dir);
+
+  /// Stops watching
+  ~EventFileWatcher();
+
+  EventFileWatcher(EventFileWatcher const&) = delete;
+  EventFileWatcher& operator= (EventFileWatcher const&) = delete;
+
+  /// Marks the specified files as already known (they won't be reported)
+  void markKnown(std::vector<std::string> const& files);
+
+  /**
+   * @brief Returns the new event files, waiting for them if needed
+   * @param timeout maximum time to wait for the first new file
+   * @return the names of the new files, sorted (empty if none in time)
+   */
+  std::vector<std::string> waitForFiles(std::chrono::milliseconds timeout);
+
+ private:
+  std::string fDir; ///< the watched directory
+  int fFD = -1; ///< inotify file descriptor
+  std::unordered_set<std::string> fKnown; ///< files already reported
+
+  /// Collects the reported files from all the pending notifications
+  std::vector<std::string> readEvents();
+
+};  // EventFileWatcher
+
+
+#endif // LARDATA_RAWDATA_UTILS_EVENTFILELIST_H
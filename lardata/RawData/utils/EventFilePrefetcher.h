@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  EventFilePrefetcher.h
+/// \brief Decoding of raw event files ahead of time, on a separate thread
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#ifndef LARDATA_RAWDATA_UTILS_EVENTFILEPREFETCHER_H
+#define LARDATA_RAWDATA_UTILS_EVENTFILEPREFETCHER_H
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm> // std::max()
+#include <condition_variable>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+
+namespace lris {
+  template <typename Event>
+  class EventFilePrefetcher;
+}
+
+/**
+ * @brief Decodes the next event files on a background thread
+ * @tparam Event type of the content of a decoded file
+ *
+ * The input drivers read an event file only when the framework asks for the
+ * next event, and the event loop waits for the file to be read and decoded.
+ * This object instead decodes the files of a list, in the order of the list,
+ * on its own thread, keeping up to a fixed number of decoded events ready:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * lris::EventFilePrefetcher<EventData> prefetcher
+ *   (files, 4U, [dir](std::string const& file){ return decode(dir, file); });
+ *
+ * EventData const data = prefetcher.next(); // the first file
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * The decoding function is called on the background thread only, one file
+ * at a time. If it throws, the exception is delivered by `next()` in place
+ * of the event of that file, and no further file is decoded.
+ *
+ * Destroying the prefetcher stops the thread after the file being decoded,
+ * if any, and discards all the ready events.
+ */
+template <typename Event>
+class lris::EventFilePrefetcher {
+ public:
+  /// Type of function decoding an event file (from the name in the list)
+  using Decoder_t = std::function<Event(std::string const&)>;
+
+  /**
+   * @brief Constructor: starts decoding the files of the list
+   * @param files names of the files to decode, in order
+   * @param depth maximum number of decoded events kept ready (at least 1)
+   * @param decode function decoding a file into an event
+   */
+  EventFilePrefetcher
+    (std::vector<std::string> files, std::size_t depth, Decoder_t decode);
+
+  /// Stops the decoding thread
+  ~EventFilePrefetcher();
+
+  EventFilePrefetcher(EventFilePrefetcher const&) = delete;
+  EventFilePrefetcher& operator= (EventFilePrefetcher const&) = delete;
+
+  /**
+   * @brief Returns the event from the next file, waiting for it if needed
+   * @throw cet::exception (category `"EventFilePrefetcher"`) if there are no
+   *        more events
+   *
+   * Exceptions thrown by the decoding of the file are rethrown here.
+   */
+  Event next();
+
+  /// Returns the number of files whose event has not been delivered yet
+  std::size_t nLeft() const { return fFiles.size() - fNDelivered; }
+
+ private:
+  /// A decoded file: either the event, or what went wrong with it
+  struct Slot_t {
+    Event event;
+    std::exception_ptr error;
+  };
+
+  std::vector<std::string> const fFiles; ///< files to decode, in order
+  std::size_t const fDepth; ///< maximum number of events kept ready
+  Decoder_t const fDecode; ///< function decoding a file
+  std::size_t fNDelivered = 0; ///< number of events returned by `next()`
+
+  std::mutex fMutex; ///< lock for all the following data
+  std::condition_variable fSpaceAvailable; ///< signals a slot is free
+  std::condition_variable fEventReady; ///< signals a new ready event
+  std::deque<Slot_t> fReady; ///< events decoded and not delivered yet
+  bool fFinished = false; ///< whether the thread has decoded all it will
+  bool fStop = false; ///< whether the thread should stop
+
+  std::thread fThread; ///< the decoding thread
+
+  /// Body of the decoding thread
+  void decodeLoop();
+
+};  // EventFilePrefetcher
+
+
+//----------------------------------------------------------------------
+//--- template implementation
+//----------------------------------------------------------------------
+template <typename Event>
+lris::EventFilePrefetcher<Event>::EventFilePrefetcher
+  (std::vector<std::string> files, std::size_t depth, Decoder_t decode)
+  : fFiles(std::move(files))
+  , fDepth(std::max(depth, std::size_t(1)))
+  , fDecode(std::move(decode))
+  , fThread(&EventFilePrefetcher::decodeLoop, this)
+{}
+
+
+//----------------------------------------------------------------------
+template <typename Event>
+lris::EventFilePrefetcher<Event>::~EventFilePrefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fSpaceAvailable.notify_all();
+  fThread.join();
+} // lris::EventFilePrefetcher<>::~EventFilePrefetcher()
+
+
+//----------------------------------------------------------------------
+template <typename Event>
+Event lris::EventFilePrefetcher<Event>::next()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fEventReady.wait(lock, [this](){ return !fReady.empty() || fFinished; });
+  if (fReady.empty()) {
+    throw cet::exception("EventFilePrefetcher")
+      << "No more events to be read (" << fNDelivered << " out of "
+      << fFiles.size() << " files delivered)\n";
+  }
+  Slot_t slot = std::move(fReady.front());
+  fReady.pop_front();
+  ++fNDelivered;
+  lock.unlock();
+  fSpaceAvailable.notify_one();
+
+  if (slot.error) std::rethrow_exception(slot.error);
+  return std::move(slot.event);
+} // lris::EventFilePrefetcher<>::next()
+
+
+//----------------------------------------------------------------------
+template <typename Event>
+void lris::EventFilePrefetcher<Event>::decodeLoop()
+{
+  for (std::string const& file: fFiles) {
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fSpaceAvailable.wait
+        (lock, [this](){ return fStop || (fReady.size() < fDepth); });
+      if (fStop) break;
+    }
+
+    // the decoding itself happens without holding the lock
+    Slot_t slot;
+    try {
+      slot.event = fDecode(file);
+    }
+    catch (...) {
+      slot.error = std::current_exception();
+    }
+
+    bool const failed = bool(slot.error);
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fReady.push_back(std::move(slot));
+    }
+    fEventReady.notify_one();
+    if (failed) break;
+  } // for
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fFinished = true;
+  }
+  fEventReady.notify_all();
+} // lris::EventFilePrefetcher<>::decodeLoop()
+
+
+#endif // LARDATA_RAWDATA_UTILS_EVENTFILEPREFETCHER_H
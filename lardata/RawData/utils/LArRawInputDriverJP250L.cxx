@@ -18,12 +18,18 @@
 #include "art/Framework/Principal/RunPrincipal.h"
 #include "canvas/Persistency/Provenance/FileFormatVersion.h"
 #include "canvas/Persistency/Provenance/Timestamp.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 #include "TFile.h"
 #include "TObject.h"
 #include "TTree.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 // ======================================================================
@@ -32,10 +38,13 @@
 namespace lris {
   // ======================================================================
   // class c'tor/d'tor:
-  LArRawInputDriverJP250L::LArRawInputDriverJP250L(fhicl::ParameterSet const &, // Not used
+  LArRawInputDriverJP250L::LArRawInputDriverJP250L(fhicl::ParameterSet const &pset,
 						   art::ProductRegistryHelper &helper,
 						   art::SourceHelper const &pm)
     : principalMaker_(pm)
+    , m_treeCacheSize(pset.get<long>("treeCacheSize", -1))
+    , m_clusterPrefetch(pset.get<bool>("clusterPrefetch", false))
+    , m_eventTree(0)
     , m_current(0)
     , m_data(0)
   {
@@ -44,22 +53,38 @@ namespace lris {
     helper.reconstitutes<sumdata::RunData,            art::InRun>  ("daq");
   }
 
+  LArRawInputDriverJP250L::~LArRawInputDriverJP250L()
+  {
+    closeCurrentFile();
+  }
+
   // ======================================================================
   void LArRawInputDriverJP250L::closeCurrentFile()
   {
+    // the tree belongs to the file
+    m_eventTree = 0;
+    m_file.reset();
     delete [] m_data;
+    m_data = 0;
   }
 
   // ======================================================================
   void LArRawInputDriverJP250L::readFile(std::string const &name,
 					 art::FileBlock* &fb)
   {
-    TFile m_f(name.c_str());
-    TTree* runTree = dynamic_cast<TTree*>(m_f.Get("runTree"));
-
-    m_eventTree    = dynamic_cast<TTree*>(m_f.Get("eventTree"));
-    m_eventTree->SetDirectory(0);
+    // the file stays open while the events are read from it: the tree cache
+    // and the prefetching of the baskets work on it
+    m_file.reset(TFile::Open(name.c_str()));
+    if(!m_file || m_file->IsZombie())
+      throw cet::exception("LArRawInputDriverJP250L") << "Can't open file '" << name << "'\n";
+
+    TTree* runTree = dynamic_cast<TTree*>(m_file->Get("runTree"));
+    m_eventTree    = dynamic_cast<TTree*>(m_file->Get("eventTree"));
+    if(!runTree || !m_eventTree)
+      throw cet::exception("LArRawInputDriverJP250L")
+        << "File '" << name << "' has no runTree or eventTree\n";
     m_nEvent = m_eventTree->GetEntries();
+    m_current = 0;
 
     // run information
     runTree->SetBranchAddress("runID",&m_runID);
@@ -76,6 +101,21 @@ namespace lris {
     m_data = new unsigned short[nLength];
     m_eventTree->SetBranchAddress("data",m_data);
 
+    // only the ADC samples are converted: the other branches are not read,
+    // and the cache holds the baskets of that branch only, without learning
+    m_eventTree->SetBranchStatus("*",0);
+    m_eventTree->SetBranchStatus("data",1);
+    if(m_treeCacheSize != 0){
+      if(m_treeCacheSize > 0) m_eventTree->SetCacheSize(m_treeCacheSize);
+      m_eventTree->AddBranchToCache("data",true);
+      m_eventTree->StopCacheLearningPhase();
+    }
+    else m_eventTree->SetCacheSize(0);
+
+    // the baskets of the next cluster of entries are read on a separate thread
+    // while the current one is converted
+    m_eventTree->SetClusterPrefetch(m_clusterPrefetch);
+
     // Fill and return a new Fileblock.
     // The string tells you what the version of the LArRawInputDriver is
     fb = new art::FileBlock(art::FileFormatVersion(1, "LArRawInputJP250L 2013_01"),
@@ -93,7 +133,7 @@ namespace lris {
 					 art::EventPrincipal* &outE)
   {
 
-    if(m_current > m_nEvent) return false;
+    if(m_current >= m_nEvent) return false;
 
     m_eventTree->GetEntry(m_current);
 
@@ -117,15 +157,20 @@ namespace lris {
     std::unique_ptr<std::vector<raw::RawDigit> >  rdcol( new std::vector<raw::RawDigit> );
 
     // loop over the signals and break them into
-    // one RawDigit for each channel
-    std::vector<short> adcVec(m_nSamples,0);
-    for(unsigned int n = 0; n < m_nChannels; ++n){
-      adcVec.clear();
-      for(unsigned int i = 0; i < m_nSamples; ++i){
-	adcVec.push_back(m_data[(m_nSamples+4)*n+(4+i)]);
-      }
-      rdcol->push_back(raw::RawDigit(n,m_nSamples,adcVec));
-    }
+    // one RawDigit for each channel; each ADC vector is created directly
+    // from the samples of its channel, and then moved into the digit.
+    // The channels are at fixed positions in the buffer: they are converted
+    // in parallel, each one into its own slot of the collection
+    rdcol->resize(m_nChannels);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_nChannels),
+      [this, &rdcol](tbb::blocked_range<unsigned int> const& range)
+      {
+        for(unsigned int n = range.begin(); n != range.end(); ++n){
+          unsigned short const* samples = m_data + (m_nSamples+4)*n + 4;
+          std::vector<short> adcVec(samples, samples + m_nSamples);
+          (*rdcol)[n] = raw::RawDigit(n,m_nSamples,std::move(adcVec));
+        }
+      });
 
     art::RunNumber_t    rn     = daqHeader.GetRun();
     art::SubRunNumber_t sn     = 1;
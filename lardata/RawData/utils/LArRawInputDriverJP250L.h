@@ -5,6 +5,7 @@
 /// \author  eito@post.kek.jp, brebel@fnal.gov
 ////////////////////////////////////////////////////////////////////////
 
+#include <memory>
 #include <string>
 
 namespace art {
@@ -17,6 +18,7 @@ namespace art {
 }
 namespace fhicl { class ParameterSet; }
 
+class TFile;
 class TTree;
 
 ///Conversion of binary data to root files
@@ -33,6 +35,8 @@ class lris::LArRawInputDriverJP250L {
 			  art::ProductRegistryHelper &helper,
 			  art::SourceHelper const &pm);
 
+  ~LArRawInputDriverJP250L();
+
   // Required by FileReaderSource:
   void closeCurrentFile();
   void readFile(std::string const &name,
@@ -48,7 +52,12 @@ class lris::LArRawInputDriverJP250L {
   // --- data members:
   art::SourceHelper const& principalMaker_;
 
+  // --- reading of the event tree:
+  long            m_treeCacheSize;   ///< TTreeCache bytes (<0: ROOT default, 0: none)
+  bool            m_clusterPrefetch; ///< whether to read the next cluster ahead
+
   // added by E.Iwai
+  std::unique_ptr<TFile> m_file; ///< the input file, open until closeCurrentFile()
   TTree*          m_eventTree;   ///< TTree containing information from each trigger
   unsigned int    m_nEvent;      ///< number of triggers in the TTree
   unsigned int    m_current;     ///< current entry in the TTree
@@ -6,7 +6,12 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "canvas/Persistency/Provenance/SubRunID.h"
+#include "lardata/RawData/utils/DecodingStats.h"
+#include "lardata/RawData/utils/EventFileList.h"
+#include "lardata/RawData/utils/EventFilePrefetcher.h"
+#include "lardata/RawData/utils/RawDigitCompression.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -34,6 +39,8 @@ class lris::LArRawInputDriverLongBo {
                     art::ProductRegistryHelper &helper,
                     art::SourceHelper const &pm);
 
+  ~LArRawInputDriverLongBo();
+
   // Required by FileReaderSource:
   void closeCurrentFile();
   void readFile(std::string const &name,
@@ -54,4 +61,35 @@ class lris::LArRawInputDriverLongBo {
   stringvec_t::const_iterator    nextfile_;
   stringvec_t::const_iterator    filesdone_;
   art::SubRunID                  currentSubRunID_;
+
+  // --- compression of the produced digits:
+  lris::DigitCompression         compression_;   ///< applied to all digits
+
+  // --- decoding statistics:
+  unsigned int                   statsLevel_;    ///< 0: none, 1: summary, 2: per file
+  lris::DecodingStats            dirStats_;      ///< statistics of this directory
+  lris::DecodingStats            jobStats_;      ///< statistics of closed directories
+
+  // --- discovery of new event files:
+  std::string                    fileIndexDir_;  ///< where the file lists are cached
+  unsigned int                   watchTimeout_;  ///< seconds to wait for new files
+  std::unique_ptr<lris::EventFileWatcher> watcher_; ///< reports new files
+
+  // --- prefetching of the event files:
+  struct EventData_t; ///< content of one decoded event file
+  typedef  lris::EventFilePrefetcher<EventData_t>  prefetcher_t;
+
+  std::size_t                    prefetchFiles_; ///< files decoded ahead
+  std::unique_ptr<prefetcher_t>  prefetcher_;    ///< decodes files ahead
+
+  /// Starts decoding ahead the files after nextfile_ (if requested)
+  void startPrefetching();
+
+  /// Adds the statistics of a file (and reports them if requested)
+  void recordStats(std::string const& filename,
+                   lris::DecodingStats const& stats);
+
+  /// Waits for new files in the directory and adds them to the list;
+  /// returns whether any was found
+  bool waitForNewFiles();
 };  // LArRawInputDriverLongBo
@@ -6,8 +6,14 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "lardata/RawData/utils/LArRawInputDriverShortBo.h"
+#include "lardata/RawData/utils/ByteOrder.h"
+#include "lardata/RawData/utils/DecodingStats.h"
+#include "lardata/RawData/utils/EventFileList.h"
+#include "lardata/RawData/utils/MappedEventFile.h"
 
 #include "art/Framework/Core/FileBlock.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 #include "art/Framework/Core/ProductRegistryHelper.h"
 #include "art/Framework/IO/Sources/SourceHelper.h"
 #include "art/Framework/Principal/EventPrincipal.h"
@@ -15,7 +21,9 @@
 #include "canvas/Persistency/Provenance/Timestamp.h"
 
 #include <algorithm>
-#include <fstream>
+#include <chrono>
+#include <iterator>
+#include <utility>
 #include <stdlib.h>
 #include <time.h>
 
@@ -26,10 +34,6 @@
 #include "art/Framework/IO/Sources/put_product_in_principal.h"
 #include "canvas/Utilities/Exception.h"
 
-extern "C" {
-#include <dirent.h>
-}
-
 // ======================================================================
 // ShortBo DAQ480 interface, adapted from code by Rebel/Soderberg:
 
@@ -65,96 +69,44 @@ namespace {
   };
 
   // ======================================================================
-  int run( std::string s1 )
-  {
-    size_t p1 = s1.find("R");
-    size_t p2 = s1.find("_E");
+  // value of header::fixed; a file written with the other byte order
+  // has it reversed, 0x80D40000
+  constexpr int FixedWord = 0x0000D480;
 
-    int run = atoi((s1.substr(p1+1,p2-p1-1)).c_str());
-    return run;
-  }
-
-
-  // ======================================================================
-  int event( std::string s1 )
+  void swapByteOrder(header& h)
   {
-    size_t p1 = s1.find("E");
-    size_t p2 = s1.find("_T");
-
-    int event = atoi((s1.substr(p1+1,p2-p1-1)).c_str());
-    return event;
+    lris::swapByteOrder(h.fixed);
+    lris::swapByteOrder(h.format);
+    lris::swapByteOrder(h.software);
+    lris::swapByteOrder(h.run);
+    lris::swapByteOrder(h.event);
+    lris::swapByteOrder(h.time);
+    lris::swapByteOrder(h.spare);
+    lris::swapByteOrder(h.nchan);
   }
 
-
-  // ======================================================================
-  bool compare( std::string s1, std::string s2 )
+  void swapByteOrder(channel& c)
   {
-    int r1 = run(s1);
-    int r2 = run(s2);
-    int e1 = event(s1);
-    int e2 = event(s2);
-
-    return r1 == r2 ?  e1 < e2
-      :  r1 < r2;
+    lris::swapByteOrder(c.ch);
+    lris::swapByteOrder(c.samples);
   }
 
-
-  // ======================================================================
-  std::vector<std::string> getsortedfiles( std::string dir )
-  {
-    if( dir == "" )
-      throw art::Exception( art::errors::Configuration )
-        << "Vacuous directory name" << std::endl;
-
-    std::vector<std::string> files;
-
-    DIR * dp = NULL;
-    if( (dp = opendir(dir.c_str())) == NULL ) {
-      throw art::Exception( art::errors::FileOpenError )
-        << "Error opening directory " << dir << std::endl;
-    }
-
-    dirent * dirp = NULL;
-    while( (dirp = readdir(dp)) != NULL ) {
-      std::string filename( dirp->d_name );
-      if( filename.find("bin") != std::string::npos ) {
-        files.push_back(filename);
-      }
-    }
-    closedir(dp);
-
-    sort( files.begin(), files.end(), compare );
-
-    return files;
-  }  // getsortedfiles()
-
-  struct EventFileSentry {
-    // Use RAII (Resource Acquisition Is Initialization)
-    explicit EventFileSentry(std::string const &filepath)
-      : infile(filepath.c_str(), std::ios_base::in | std::ios_base::binary)
-    { }
-    ~EventFileSentry() { infile.close(); }
-
-    std::ifstream infile;
-  };
-
   // ======================================================================
   void process_LAr_file(std::string dir,
                         std::string  const &  filename,
                         std::vector<raw::RawDigit>& digitList,
-                        raw::DAQHeader& daqHeader)
+                        raw::DAQHeader& daqHeader,
+                        lris::DecodingStats& stats)
   {
-    // Prepare the input file. The sentry is responsible for making the
-    // file stream object, and will *automatically* close it when it
-    // goes out of scope *for any reason*, including normal function
-    // exit or exception throw.
-    EventFileSentry efs(dir+"/"+filename);
-    std::ifstream &infile = efs.infile;
-
-    if( !infile.is_open() ) {
-      throw art::Exception( art::errors::FileReadError )
-        << "failed to open input file " << filename << std::endl;
-    }
+    // Map the input file in memory. The mapping is released automatically
+    // when it goes out of scope *for any reason*, including normal function
+    // exit or exception throw; all reads are checked against the file size.
+    // The time spent in each stage is accounted into stats.
+    lris::DecodingStats::Stopwatch watch(stats);
+    lris::MappedEventFile infile(dir+"/"+filename);
+    watch.lap(lris::DecodingStats::kOpen);
+    ++stats.files;
+    stats.bytes += infile.size();
 
     unsigned int wiresPerPlane = 48;
     unsigned int planes = 3;
@@ -163,8 +115,14 @@ namespace {
     channel c1;
     footer f1;
 
-    //read in header section of file
-    infile.read((char *) &h1, sizeof h1);
+    //read in header section of file; the fixed word tells the byte order,
+    //and the ADC samples of byte-swapped files are swapped in bulk as they are read
+    infile.read(h1);
+    if (h1.fixed == lris::byteSwapped(FixedWord)) {
+      swapByteOrder(h1);
+      infile.setByteSwapped(true);
+    }
+    watch.lap(lris::DecodingStats::kRead);
 
     time_t mytime = h1.time;
     mytime = mytime << 32;//Nov. 2, 2010 - "time_t" is a 64-bit word on many 64-bit machines
@@ -190,15 +148,21 @@ namespace {
     daqHeader.SetSpareWord(h1.spare);
     daqHeader.SetNChannels(h1.nchan);
 
-    //one digit for every wire on each plane
+    //one digit for every wire on each plane, and room for all the channels
+    //in the header
     digitList.clear();
-    digitList.resize(wiresPerPlane*planes);
+    digitList.resize(std::max<std::size_t>(wiresPerPlane*planes, h1.nchan));
+    watch.lap(lris::DecodingStats::kDecode);
 
     for( int i = 0; i != h1.nchan; ++i ) {
-      infile.read((char *) &c1, sizeof c1);
-      //Create vector for ADC data, with correct number of samples for this event
-      std::vector<short> adclist(c1.samples);
-      infile.read((char*)&adclist[0],sizeof(short)*c1.samples);
+      infile.read(c1);
+      if (infile.byteSwapped()) swapByteOrder(c1);
+      //Create vector for ADC data, with correct number of samples for this event,
+      //directly from the mapped file
+      std::vector<short> adclist = infile.readVector<short>(c1.samples);
+      watch.lap(lris::DecodingStats::kRead);
+      ++stats.channels;
+      stats.samples += c1.samples;
       // std::cout << "Channel = " << c1.ch ;
       // std::cout << " #Samples = " << c1.samples ;
       // std::cout << " ADC[0] = " << adclist[0] << " ADC[2047] = " << adclist[2047] << std::endl;
@@ -211,24 +175,36 @@ namespace {
 	if (i==95) iw=92;
       }
 
-      digitList[i] = raw::RawDigit(iw, c1.samples, adclist);//subtract one from ch. number...
+      digitList[i] = raw::RawDigit(iw, c1.samples, std::move(adclist));//subtract one from ch. number...
       //      digitList[i] = raw::RawDigit((c1.ch-1), c1.samples, adclist);//subtract one from ch. number...
                                                                    //hence offline channels will always be one lower
                                                                    //than the DAQ480 definition. - mitch 7/8/2009
       digitList[i].SetPedestal(400.); //carl b assures me this will never change. bjr 4/15/2009
+
+      watch.lap(lris::DecodingStats::kDigits);
     }
-    //read in footer section of file...though it's currently empty.
-    infile.read((char *) &f1, sizeof f1);
+    //read in footer section of file...though it's currently empty
+    //(and not required to be there).
+    if (infile.remaining() >= sizeof f1) infile.read(f1);
+    watch.lap(lris::DecodingStats::kRead);
 
-    // infile will be closed automatically as EventFileSentry goes out of scope.
+    // infile will be unmapped automatically as it goes out of scope.
   }  // process_LAr_file
 
 } // namespace
 
 namespace lris {
+  // ======================================================================
+  // content of one event file, as decoded by process_LAr_file()
+  struct LArRawInputDriverShortBo::EventData_t {
+    std::vector<raw::RawDigit>  digits;
+    raw::DAQHeader              daqHeader;
+    lris::DecodingStats         stats;
+  };
+
   // ======================================================================
   // class c'tor/d'tor:
-  LArRawInputDriverShortBo::LArRawInputDriverShortBo(fhicl::ParameterSet const &, // Not used
+  LArRawInputDriverShortBo::LArRawInputDriverShortBo(fhicl::ParameterSet const &pset,
                                        art::ProductRegistryHelper &helper,
                                        art::SourceHelper const &pm)
     :
@@ -238,39 +214,128 @@ namespace lris {
     , nextfile_          ( inputfiles_.begin() )
     , filesdone_         ( inputfiles_.end() )
     , currentSubRunID_   ( )
+    , compression_       ( lris::DigitCompression::fromParameters(pset) )
+    , statsLevel_        ( pset.get<unsigned int>("decodingStats", 0) )
+    , dirStats_          ( )
+    , jobStats_          ( )
+    , fileIndexDir_      ( pset.get<std::string>("fileIndexDir", "") )
+    , watchTimeout_      ( pset.get<unsigned int>("watchTimeout", 0) )
+    , watcher_           ( )
+    , prefetchFiles_     ( pset.get<unsigned int>("prefetchFiles", 0) )
+    , prefetcher_        ( )
   {
     helper.reconstitutes<raw::DAQHeader,              art::InEvent>("daq");
     helper.reconstitutes<std::vector<raw::RawDigit>,  art::InEvent>("daq");
     helper.reconstitutes<sumdata::RunData,            art::InRun>  ("daq");
   }
 
+  LArRawInputDriverShortBo::~LArRawInputDriverShortBo()
+  {
+    if (statsLevel_ > 0 && jobStats_.files > 0) {
+      mf::LogInfo log("LArRawInputDriverShortBo");
+      log << "Decoding of all the input: ";
+      jobStats_.dump(log);
+    }
+  }
+
   void LArRawInputDriverShortBo::closeCurrentFile()
   {
-    // Nothing to do (See EventFileSentry).
+    // Stop decoding and watching the files of this directory (each event
+    // file is mapped only while being read).
+    prefetcher_.reset();
+    watcher_.reset();
+
+    if (statsLevel_ > 0 && dirStats_.files > 0) {
+      mf::LogInfo log("LArRawInputDriverShortBo");
+      log << "Decoding of " << currentDir_ << ": ";
+      dirStats_.dump(log);
+    }
+    jobStats_ += dirStats_;
+    dirStats_ = lris::DecodingStats();
+  }
+
+  void LArRawInputDriverShortBo::recordStats(std::string const &filename,
+                                                lris::DecodingStats const &stats)
+  {
+    if (statsLevel_ > 1) {
+      mf::LogInfo log("LArRawInputDriverShortBo");
+      log << "Decoding of " << filename << ": ";
+      stats.dump(log);
+    }
+    dirStats_ += stats;
   }
 
   void LArRawInputDriverShortBo::readFile(std::string const &name,
                                    art::FileBlock* &fb)
   {
-    // Get the list of event files for this directory.
+    // Get the list of event files for this directory; if new files are
+    // going to be waited for, start watching before listing the directory.
     currentDir_ = name;
-    inputfiles_ = getsortedfiles(currentDir_);
+    watcher_.reset();
+    if (watchTimeout_ > 0)
+      watcher_ = std::make_unique<lris::EventFileWatcher>(currentDir_);
+    inputfiles_ = lris::getsortedfiles(currentDir_, fileIndexDir_);
+    if (watcher_) watcher_->markKnown(inputfiles_);
     nextfile_ = inputfiles_.begin();
     filesdone_ = inputfiles_.end();
     currentSubRunID_ = art::SubRunID();
 
+    startPrefetching();
+
     // Fill and return a new Fileblock.
     fb = new art::FileBlock(art::FileFormatVersion(1, "LArRawInput 2011a"),
                             currentDir_);
   }
 
+  void LArRawInputDriverShortBo::startPrefetching()
+  {
+    // If requested, start decoding the event files not read yet ahead,
+    // in their order.
+    prefetcher_.reset();
+    if (prefetchFiles_ == 0 || nextfile_ == filesdone_) return;
+
+    std::string const dir = currentDir_;
+    lris::DigitCompression const compression = compression_;
+    prefetcher_ = std::make_unique<prefetcher_t>
+      (stringvec_t(nextfile_, filesdone_), prefetchFiles_,
+        [dir, compression](std::string const& filename)
+        {
+          EventData_t data;
+          process_LAr_file(dir, filename, data.digits, data.daqHeader, data.stats);
+          lris::DecodingStats::Stopwatch watch(data.stats);
+          lris::compressDigits(data.digits, compression);
+          watch.lap(lris::DecodingStats::kCompress);
+          return data;
+        }
+      );
+  }
+
+  bool LArRawInputDriverShortBo::waitForNewFiles()
+  {
+    if (!watcher_) return false;
+
+    stringvec_t const newFiles
+      = watcher_->waitForFiles(std::chrono::seconds(watchTimeout_));
+    if (newFiles.empty()) return false;
+
+    // appending invalidates the iterators: restore them from the position
+    std::size_t const nDone = nextfile_ - inputfiles_.cbegin();
+    inputfiles_.insert(inputfiles_.end(), newFiles.begin(), newFiles.end());
+    nextfile_ = inputfiles_.begin() + nDone;
+    filesdone_ = inputfiles_.end();
+
+    startPrefetching();
+    return true;
+  }
+
   bool LArRawInputDriverShortBo::readNext(art::RunPrincipal* const & /* inR */,
                                    art::SubRunPrincipal* const & /* inSR */,
                                    art::RunPrincipal* &outR,
                                    art::SubRunPrincipal* &outSR,
                                    art::EventPrincipal* &outE)
   {
-    if (inputfiles_.empty() || nextfile_ == filesdone_ ) return false;
+    if ((inputfiles_.empty() || nextfile_ == filesdone_) && !waitForNewFiles())
+      return false;
 
     // Create empty result, then fill it from current filename:
     std::unique_ptr<std::vector<raw::RawDigit> >  rdcolsb ( new std::vector<raw::RawDigit>  );
@@ -278,7 +343,23 @@ namespace lris {
     raw::DAQHeader daqHeader;
     bool firstEventInRun = (nextfile_ == inputfiles_.begin());
 
-    process_LAr_file( currentDir_, *nextfile_++, *rdcolsb, daqHeader );
+    lris::DecodingStats stats;
+    if (prefetcher_) {
+      lris::DecodingStats::Stopwatch watch(stats);
+      EventData_t data = prefetcher_->next();
+      watch.lap(lris::DecodingStats::kWait);
+      stats += data.stats;
+      ++nextfile_;
+      *rdcolsb = std::move(data.digits);
+      daqHeader = data.daqHeader;
+    }
+    else {
+      process_LAr_file( currentDir_, *nextfile_++, *rdcolsb, daqHeader, stats );
+      lris::DecodingStats::Stopwatch watch(stats);
+      lris::compressDigits(*rdcolsb, compression_);
+      watch.lap(lris::DecodingStats::kCompress);
+    }
+    recordStats(*std::prev(nextfile_), stats);
     std::unique_ptr<raw::DAQHeader>              daqcolsb( new raw::DAQHeader(daqHeader) );
 
     art::RunNumber_t rn = daqHeader.GetRun();
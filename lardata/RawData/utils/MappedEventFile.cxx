@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  MappedEventFile.cxx
+/// \brief Sequential reading of raw binary event files mapped in memory
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#include "lardata/RawData/utils/MappedEventFile.h"
+
+#include "canvas/Utilities/Exception.h"
+
+#include <cerrno>
+#include <cstring> // std::strerror()
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+namespace lris {
+
+  // ======================================================================
+  MappedEventFile::MappedEventFile(std::string const& path)
+    : fPath(path)
+  {
+    int const fd = ::open(fPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw art::Exception( art::errors::FileOpenError )
+        << "failed to open input file " << fPath
+        << ": " << std::strerror(errno) << std::endl;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      int const error = errno;
+      ::close(fd);
+      throw art::Exception( art::errors::FileReadError )
+        << "failed to get the size of input file " << fPath
+        << ": " << std::strerror(error) << std::endl;
+    }
+    fSize = static_cast<std::size_t>(info.st_size);
+
+    // an empty file can't be mapped; there is nothing to read anyway
+    if (fSize > 0) {
+      void* const map = ::mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {
+        int const error = errno;
+        ::close(fd);
+        throw art::Exception( art::errors::FileReadError )
+          << "failed to map input file " << fPath
+          << ": " << std::strerror(error) << std::endl;
+      }
+      // the file is read once from start to end: let the kernel read ahead
+      // (advice values are not flags, and can't be combined in one call)
+      ::madvise(map, fSize, MADV_SEQUENTIAL);
+      ::madvise(map, fSize, MADV_WILLNEED);
+      fData = static_cast<char const*>(map);
+    }
+
+    // the mapping stays valid after the file is closed
+    ::close(fd);
+  }
+
+  // ======================================================================
+  MappedEventFile::~MappedEventFile()
+  {
+    if (fData) ::munmap(const_cast<char*>(fData), fSize);
+  }
+
+  // ======================================================================
+  void MappedEventFile::checkAvailableAt
+    (std::size_t offset, std::size_t n) const
+  {
+    std::size_t const available = (offset < fSize)? fSize - offset: 0;
+    if (n <= available) return;
+    throw art::Exception( art::errors::FileReadError )
+      << "input file " << fPath << " is truncated: "
+      << n << " bytes requested at position " << offset
+      << ", but only " << available << " are available" << std::endl;
+  }
+
+}
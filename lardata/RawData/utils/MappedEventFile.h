@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  MappedEventFile.h
+/// \brief Sequential reading of raw binary event files mapped in memory
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#ifndef LARDATA_RAWDATA_UTILS_MAPPEDEVENTFILE_H
+#define LARDATA_RAWDATA_UTILS_MAPPEDEVENTFILE_H
+
+#include "lardata/RawData/utils/ByteOrder.h"
+
+#include <string>
+#include <vector>
+#include <cstring> // std::memcpy()
+#include <cstddef> // std::size_t
+#include <type_traits> // std::is_trivially_copyable<>
+
+namespace lris {
+  class MappedEventFile;
+}
+
+/**
+ * @brief A raw binary event file, mapped in memory and read sequentially
+ *
+ * The whole file is mapped in memory on construction, and the kernel is
+ * advised that it will be read sequentially, so that it can prefetch it.
+ * The content is then read from the mapped region without any further system
+ * call: the header structures are copied directly from it, and the ADC
+ * vectors are created with their final size and filled from it in one go.
+ *
+ * The data of a known position can also be read with `readArrayAt()` and
+ * `readVectorAt()`, which do not change the reading position and can be
+ * called from many threads at once: a decoder can scan the file once for the
+ * position of each block with `skip()`, and then decode the blocks in
+ * parallel.
+ *
+ * Files written with the other byte order can be read after
+ * `setByteSwapped(true)`: the byte order of arrays of integral values is then
+ * reversed in bulk as they are read, while the fields of the structures read
+ * with `read()` are left to the caller.
+ *
+ * All the reading functions throw `art::Exception` (`FileReadError`) if the
+ * file is shorter than the requested data.
+ * The mapping is released on destruction.
+ */
+class lris::MappedEventFile {
+ public:
+  /// Maps the specified file; throws `art::Exception` (`FileOpenError`) on
+  /// failure
+  explicit MappedEventFile(std::string const& path);
+
+  /// Releases the mapping
+  ~MappedEventFile();
+
+  MappedEventFile(MappedEventFile const&) = delete;
+  MappedEventFile& operator= (MappedEventFile const&) = delete;
+
+  /// Copies the next `sizeof(T)` bytes into `obj`
+  template <typename T>
+  void read(T& obj) { readArray(&obj, 1U); }
+
+  /// Sets whether the file has the byte order opposite to this machine's
+  void setByteSwapped(bool swapped) { fSwapped = swapped; }
+
+  /// Returns whether the file has the byte order opposite to this machine's
+  bool byteSwapped() const { return fSwapped; }
+
+  /// Copies the next `n` objects of type `T` into `dest` (swapping the bytes
+  /// of integral values if the file is byte-swapped)
+  template <typename T>
+  void readArray(T* dest, std::size_t n);
+
+  /// Returns a vector with the next `n` objects of type `T`
+  template <typename T>
+  std::vector<T> readVector(std::size_t n);
+
+  /// Moves the reading position `nBytes` forward
+  void skip(std::size_t nBytes) { checkAvailable(nBytes); fPos += nBytes; }
+
+  /// Returns the current reading position, in bytes from the start
+  std::size_t position() const { return fPos; }
+
+  /// Copies `n` objects of type `T` from the byte `offset` into `dest`
+  /// (the reading position is not changed)
+  template <typename T>
+  void readArrayAt(std::size_t offset, T* dest, std::size_t n) const;
+
+  /// Returns a vector with `n` objects of type `T` from the byte `offset`
+  /// (the reading position is not changed)
+  template <typename T>
+  std::vector<T> readVectorAt(std::size_t offset, std::size_t n) const;
+
+  /// Returns the name of the mapped file
+  std::string const& path() const { return fPath; }
+
+  /// Returns the size of the file, in bytes
+  std::size_t size() const { return fSize; }
+
+  /// Returns the number of bytes not read yet
+  std::size_t remaining() const { return fSize - fPos; }
+
+ private:
+  std::string fPath;           ///< path of the mapped file
+  char const* fData = nullptr; ///< start of the mapped region
+  std::size_t fSize = 0;       ///< size of the mapped region
+  std::size_t fPos = 0;        ///< current reading position
+  bool fSwapped = false;       ///< whether the byte order is reversed
+
+  /// Throws if fewer than `n` bytes are left to be read
+  void checkAvailable(std::size_t n) const { checkAvailableAt(fPos, n); }
+
+  /// Throws if fewer than `n` bytes are available after `offset`
+  void checkAvailableAt(std::size_t offset, std::size_t n) const;
+
+};  // MappedEventFile
+
+
+//----------------------------------------------------------------------
+//--- template implementation
+//----------------------------------------------------------------------
+template <typename T>
+void lris::MappedEventFile::readArray(T* dest, std::size_t n)
+{
+  readArrayAt(fPos, dest, n);
+  fPos += n * sizeof(T);
+}
+
+
+//----------------------------------------------------------------------
+template <typename T>
+void lris::MappedEventFile::readArrayAt
+  (std::size_t offset, T* dest, std::size_t n) const
+{
+  static_assert(std::is_trivially_copyable<T>(),
+    "Only trivially copyable types can be read from a mapped file");
+  std::size_t const nBytes = n * sizeof(T);
+  checkAvailableAt(offset, nBytes);
+  if (nBytes > 0) std::memcpy(dest, fData + offset, nBytes);
+  if constexpr (std::is_integral<T>()) {
+    if (fSwapped) lris::swapByteOrder(dest, n);
+  }
+}
+
+
+//----------------------------------------------------------------------
+template <typename T>
+std::vector<T> lris::MappedEventFile::readVector(std::size_t n)
+{
+  std::vector<T> values(n);
+  readArray(values.data(), n);
+  return values;
+}
+
+
+//----------------------------------------------------------------------
+template <typename T>
+std::vector<T> lris::MappedEventFile::readVectorAt
+  (std::size_t offset, std::size_t n) const
+{
+  std::vector<T> values(n);
+  readArrayAt(offset, values.data(), n);
+  return values;
+}
+
+
+#endif // LARDATA_RAWDATA_UTILS_MAPPEDEVENTFILE_H
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  RawDigitCompression.cxx
+/// \brief Compression of the raw digits produced by the input drivers
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#include "lardata/RawData/utils/RawDigitCompression.h"
+
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RawData/raw.h" // raw::Compress()
+
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <cmath> // std::lround()
+#include <utility>
+
+namespace lris {
+
+  // ======================================================================
+  raw::Compress_t DigitCompression::parseType(std::string const& name)
+  {
+    if (name == "none")            return raw::kNone;
+    if (name == "Huffman")         return raw::kHuffman;
+    if (name == "ZeroSuppression") return raw::kZeroSuppression;
+    if (name == "ZeroHuffman")     return raw::kZeroHuffman;
+    throw art::Exception( art::errors::Configuration )
+      << "Unsupported raw digit compression '" << name
+      << "' (use 'none', 'Huffman', 'ZeroSuppression' or 'ZeroHuffman')"
+      << std::endl;
+  }
+
+  // ======================================================================
+  DigitCompression DigitCompression::fromParameters
+    (fhicl::ParameterSet const& pset)
+  {
+    DigitCompression config;
+    config.type = parseType(pset.get<std::string>("compression", "none"));
+    config.zeroThreshold
+      = pset.get<unsigned int>("zeroThreshold", config.zeroThreshold);
+    config.zeroNearestNeighbor
+      = pset.get<int>("zeroNearestNeighbor", config.zeroNearestNeighbor);
+    return config;
+  }
+
+  // ======================================================================
+  void compressDigits
+    (std::vector<raw::RawDigit>& digits, DigitCompression const& config)
+  {
+    if (!config.enabled()) return;
+
+    // each task replaces its own digits: no synchronization is needed
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, digits.size()),
+      [&](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t i = range.begin(); i != range.end(); ++i) {
+          raw::RawDigit& digit = digits[i];
+          if (digit.Compression() != raw::kNone) continue;
+
+          // raw::Compress() may change its arguments
+          std::vector<short> adc = digit.ADCs();
+          unsigned int zeroThreshold = config.zeroThreshold;
+          int nearestNeighbor = config.zeroNearestNeighbor;
+          raw::Compress(adc, config.type, zeroThreshold,
+            static_cast<int>(std::lround(digit.GetPedestal())),
+            nearestNeighbor);
+
+          float const pedestal = digit.GetPedestal();
+          float const sigma = digit.GetSigma();
+          digit = raw::RawDigit
+            (digit.Channel(), digit.Samples(), std::move(adc), config.type);
+          digit.SetPedestal(pedestal, sigma);
+        } // for
+      });
+  } // compressDigits()
+
+} // namespace lris
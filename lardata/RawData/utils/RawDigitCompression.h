@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  RawDigitCompression.h
+/// \brief Compression of the raw digits produced by the input drivers
+///
+/// \date  October 14, 2026
+////////////////////////////////////////////////////////////////////////
+
+#ifndef LARDATA_RAWDATA_UTILS_RAWDIGITCOMPRESSION_H
+#define LARDATA_RAWDATA_UTILS_RAWDIGITCOMPRESSION_H
+
+#include "lardataobj/RawData/RawTypes.h" // raw::Compress_t
+
+#include <string>
+#include <vector>
+
+namespace fhicl { class ParameterSet; }
+namespace raw { class RawDigit; }
+
+namespace lris {
+
+  /**
+   * @brief Compression applied to the raw digits before they are stored
+   *
+   * The configuration is read from the parameters of the input source:
+   *
+   * - *compression* (string, default: `"none"`): one of `"none"`,
+   *   `"Huffman"`, `"ZeroSuppression"` and `"ZeroHuffman"` (zero suppression
+   *   followed by Huffman encoding), as supported by `raw::Compress()`
+   * - *zeroThreshold* (integer, default: `5`): with zero suppression, samples
+   *   within this many ADC counts from the pedestal are suppressed
+   * - *zeroNearestNeighbor* (integer, default: `4`): with zero suppression,
+   *   this many samples around the ones above threshold are kept as well
+   */
+  struct DigitCompression {
+    raw::Compress_t type = raw::kNone; ///< type of compression
+    unsigned int zeroThreshold = 5;    ///< zero suppression threshold [ADC]
+    int zeroNearestNeighbor = 4;       ///< samples kept around the signal
+
+    /// Returns whether any compression is applied
+    bool enabled() const { return type != raw::kNone; }
+
+    /// Reads the configuration from the source parameters
+    /// @throw art::Exception (`Configuration`) on unsupported compression
+    static DigitCompression fromParameters(fhicl::ParameterSet const& pset);
+
+    /// Returns the compression type with the specified name
+    /// @throw art::Exception (`Configuration`) on unsupported compression
+    static raw::Compress_t parseType(std::string const& name);
+  };
+
+  /**
+   * @brief Compresses all the uncompressed digits of a collection
+   * @param digits the digits to be compressed (replaced in place)
+   * @param config the compression to apply
+   *
+   * The channels are compressed in parallel. Channel, number of samples,
+   * pedestal and its sigma are kept. Digits already compressed are left
+   * untouched.
+   */
+  void compressDigits
+    (std::vector<raw::RawDigit>& digits, DigitCompression const& config);
+
+} // namespace lris
+
+
+#endif // LARDATA_RAWDATA_UTILS_RAWDIGITCOMPRESSION_H
@@ -21,6 +21,11 @@
  *     standard one)
  * * `proxy::ChargedSpacePointsCollectionProxy`: the interface of the collection
  *     proxy (derived and extended from the standard one)
+ * * `proxy::ChargedSpacePointColumns`: positions and charges of all the space
+ *     points as separate arrays, from the collection proxy `columns()`
+ * * `proxy::SpacePointGrid` (in `SpacePointGrid.h`): spatial index of the
+ *     points for radius and nearest neighbour queries, from the collection
+ *     proxy `spatialIndex()`
  * * a specialization of `proxy::CollectionProxyMakerTraits` for this collection
  *     proxy, which informs the infrastructure about the two customized classes
  *     above (in fact, only about the latter, which in turn contains the
@@ -107,12 +112,20 @@
 
 // LArSoft libraries
 #include "lardata/RecoBaseProxy/ProxyBase.h" // proxy namespace
+#include "lardata/RecoBaseProxy/SpacePointGrid.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lardataobj/RecoBase/PointCharge.h"
 #include "larcorealg/Geometry/geo_vectors_utils.h" // geo::vect namespace
 
 // framework libraries
 
+// C/C++ standard libraries
+#include <map>
+#include <memory> // std::shared_ptr<>, std::make_shared()
+#include <mutex> // std::call_once(), std::once_flag, std::mutex
+#include <vector>
+#include <cstdlib> // std::size_t
+
 
 namespace proxy {
 
@@ -298,6 +311,61 @@ namespace proxy {
   }; // SpacePointWithCharge<>
 
 
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Positions and charges of all space points, in separate arrays.
+   * @ingroup LArSoftProxyChargedSpacePoint
+   * @see `proxy::ChargedSpacePointsCollectionProxy::columns()`
+   *
+   * Each coordinate of the position and the charge are stored in a contiguous
+   * array of single precision numbers, with one entry per space point, in the
+   * same order as in the proxy. The arrays can be passed directly to
+   * algorithms expecting plain arrays (`positionsX().data()`).
+   *
+   * Points with no valid charge keep the value from `recob::PointCharge`
+   * (`recob::PointCharge::InvalidCharge`).
+   */
+  class ChargedSpacePointColumns {
+
+      public:
+    /// Type of a single value in the arrays.
+    using value_t = float;
+
+    /// Type of the arrays.
+    using column_t = std::vector<value_t>;
+
+    /// Fills all the columns with a single pass on the specified data.
+    template <typename SpacePoints, typename Charges>
+    void fill(SpacePoints const& points, Charges const& charges);
+
+    /// Returns the number of space points.
+    std::size_t size() const { return fX.size(); }
+
+    /// Returns whether there are no space points.
+    bool empty() const { return fX.empty(); }
+
+    /// Returns the _x_ coordinates of all the space points [cm]
+    column_t const& positionsX() const { return fX; }
+
+    /// Returns the _y_ coordinates of all the space points [cm]
+    column_t const& positionsY() const { return fY; }
+
+    /// Returns the _z_ coordinates of all the space points [cm]
+    column_t const& positionsZ() const { return fZ; }
+
+    /// Returns the charges of all the space points.
+    /// @see `recob::PointCharge::charge()`
+    column_t const& charges() const { return fCharge; }
+
+      private:
+    column_t fX; ///< _x_ coordinates of all points.
+    column_t fY; ///< _y_ coordinates of all points.
+    column_t fZ; ///< _z_ coordinates of all points.
+    column_t fCharge; ///< Charges of all points.
+
+  }; // class ChargedSpacePointColumns
+
+
   //----------------------------------------------------------------------------
   /**
    * @brief Proxy collection class for space points associated to charge.
@@ -339,6 +407,79 @@ namespace proxy {
         return base_t::template get<ChargedSpacePoints::ChargeTag>().dataRef();
       }
 
+    /**
+     * @brief Returns positions and charges of all points as separate arrays.
+     * @return a `proxy::ChargedSpacePointColumns` object
+     *
+     * The arrays are filled on the first call, and the same object is
+     * returned by all the following calls on this proxy (also from different
+     * threads):
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto points = proxy::getChargedSpacePoints(event, pointsTag);
+     * auto const& columns = points.columns();
+     * float const* x = columns.positionsX().data();
+     * float const* q = columns.charges().data();
+     * float totalCharge = 0.0;
+     * for (std::size_t i = 0; i < columns.size(); ++i) totalCharge += q[i];
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    ChargedSpacePointColumns const& columns() const;
+
+    /**
+     * @brief Returns the spatial index of the points.
+     * @param cellSize side of the cells of the index [cm]
+     * @return a `proxy::SpacePointGrid` object
+     *
+     * The index is built on the first call with each cell size, and the same
+     * object is returned by all the following calls on this proxy and its
+     * copies (also from different threads). Building an index holds a lock
+     * on the indices of this proxy.
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto points = proxy::getChargedSpacePoints(event, pointsTag);
+     * auto const& grid = points.spatialIndex(2.0); // 2 cm cells
+     * for (auto point: points) {
+     *   for (std::size_t iNear: grid.pointsWithin(point.position(), 3.0)) {
+     *     auto const near = points[iNear];
+     *     // ...
+     *   }
+     * }
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    SpacePointGrid const& spatialIndex
+      (double cellSize = SpacePointGrid::DefaultCellSize) const;
+
+    /// Returns the positions of the points within `radius` of `center`
+    /// (see `proxy::SpacePointGrid::pointsWithin()`).
+    std::vector<std::size_t> pointsWithin
+      (geo::Point_t const& center, double radius) const
+      { return spatialIndex().pointsWithin(center, radius); }
+
+    /// Returns the positions of the `k` points closest to `center`
+    /// (see `proxy::SpacePointGrid::nearestPoints()`).
+    std::vector<std::size_t> nearestPoints
+      (geo::Point_t const& center, std::size_t k) const
+      { return spatialIndex().nearestPoints(center, k); }
+
+      private:
+    /// Columns, filled on demand, and flag for their filling.
+    struct ColumnCache {
+      std::once_flag filled;
+      ChargedSpacePointColumns columns;
+    }; // struct ColumnCache
+
+    /// Spatial indices, built on demand, by cell size.
+    struct SpatialIndexCache {
+      std::mutex lock;
+      std::map<double, std::unique_ptr<SpacePointGrid const>> grids;
+    }; // struct SpatialIndexCache
+
+    /// Cache of the columns (shared by copies of this proxy).
+    std::shared_ptr<ColumnCache> fColumns = std::make_shared<ColumnCache>();
+
+    /// Cache of the spatial indices (shared by copies of this proxy).
+    std::shared_ptr<SpatialIndexCache> fSpatialIndices
+      = std::make_shared<SpatialIndexCache>();
+
   }; // ChargedSpacePointsCollectionProxy
 
 
@@ -434,4 +575,54 @@ namespace proxy {
 } // namespace proxy
 
 
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename SpacePoints, typename Charges>
+void proxy::ChargedSpacePointColumns::fill
+  (SpacePoints const& points, Charges const& charges)
+{
+  std::size_t const n = points.size();
+  fX.resize(n);
+  fY.resize(n);
+  fZ.resize(n);
+  fCharge.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const* xyz = points[i].XYZ();
+    fX[i] = static_cast<value_t>(xyz[0]);
+    fY[i] = static_cast<value_t>(xyz[1]);
+    fZ[i] = static_cast<value_t>(xyz[2]);
+    fCharge[i] = static_cast<value_t>(charges[i].charge());
+  } // for
+} // proxy::ChargedSpacePointColumns::fill()
+
+
+//------------------------------------------------------------------------------
+template <typename MainColl, typename... AuxColl>
+auto proxy::ChargedSpacePointsCollectionProxy<MainColl, AuxColl...>::columns
+  () const -> ChargedSpacePointColumns const&
+{
+  std::call_once(fColumns->filled,
+    [this](){ fColumns->columns.fill(spacePoints(), charges()); }
+    );
+  return fColumns->columns;
+} // proxy::ChargedSpacePointsCollectionProxy<>::columns()
+
+
+//------------------------------------------------------------------------------
+template <typename MainColl, typename... AuxColl>
+auto proxy::ChargedSpacePointsCollectionProxy<MainColl, AuxColl...>::spatialIndex
+  (double cellSize /* = SpacePointGrid::DefaultCellSize */) const
+  -> SpacePointGrid const&
+{
+  std::lock_guard<std::mutex> guard(fSpatialIndices->lock);
+  auto& grid = fSpatialIndices->grids[cellSize];
+  if (!grid) grid = std::make_unique<SpacePointGrid>(spacePoints(), cellSize);
+  return *grid;
+} // proxy::ChargedSpacePointsCollectionProxy<>::spatialIndex()
+
+
+//------------------------------------------------------------------------------
+
+
 #endif // LARDATA_RECOBASEPROXY_CHARGEDSPACEPOINTS_H
@@ -0,0 +1,165 @@
+/**
+ * @file   lardata/RecoBaseProxy/Hits.cxx
+ * @brief  Implementation file for `proxy::HitGroupIndex`.
+ * @date   October 14, 2026
+ * @see    Hits.h
+ *
+ */
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/Hits.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::lower_bound(), std::max()
+#include <map>
+
+
+//------------------------------------------------------------------------------
+//---  proxy::HitGroupIndex implementation
+//------------------------------------------------------------------------------
+proxy::HitGroupIndex::HitGroupIndex(std::vector<recob::Hit> const& hits)
+  : fNHits(hits.size())
+{
+  //
+  // first pass: channel keys and the planes, with their largest wire number
+  //
+  std::vector<std::size_t> channelKeys(fNHits, InvalidKey);
+  std::size_t nChannelKeys = 0U;
+
+  std::map<geo::PlaneID, geo::WireID::WireID_t> maxWires;
+  for (std::size_t iHit = 0; iHit < fNHits; ++iHit) {
+    recob::Hit const& hit = hits[iHit];
+
+    raw::ChannelID_t const channel = hit.Channel();
+    if (raw::isValidChannelID(channel)) {
+      channelKeys[iHit] = channel;
+      nChannelKeys = std::max(nChannelKeys, std::size_t(channel) + 1U);
+    }
+
+    geo::WireID const& wireID = hit.WireID();
+    if (!wireID.isValid) continue;
+    auto const [ iPlane, added ]
+      = maxWires.try_emplace(wireID.asPlaneID(), wireID.Wire);
+    if (!added) iPlane->second = std::max(iPlane->second, wireID.Wire);
+  } // for
+
+  fByChannel.fill(channelKeys, nChannelKeys);
+  fChannels.reserve(fByChannel.size());
+  for (std::size_t channel = 0; channel < fByChannel.size(); ++channel) {
+    if (fByChannel.offsets[channel + 1] > fByChannel.offsets[channel])
+      fChannels.push_back(raw::ChannelID_t(channel));
+  } // for
+
+  fPlanes.reserve(maxWires.size());
+  fWireOffsets.reserve(maxWires.size() + 1U);
+  for (auto const& [ planeID, maxWire ]: maxWires) {
+    fPlanes.push_back(planeID);
+    fWireOffsets.push_back(fWireOffsets.back() + maxWire + 1U);
+  } // for
+
+  //
+  // second pass: plane and wire keys
+  //
+  std::vector<std::size_t> planeKeys(fNHits, InvalidKey);
+  std::vector<std::size_t> wireKeys(fNHits, InvalidKey);
+  std::size_t lastPlane = InvalidKey; // hits are often sorted by plane
+  for (std::size_t iHit = 0; iHit < fNHits; ++iHit) {
+    geo::WireID const& wireID = hits[iHit].WireID();
+    if (!wireID.isValid) continue;
+    if ((lastPlane == InvalidKey) || (fPlanes[lastPlane] != wireID.asPlaneID()))
+      lastPlane = planeKey(wireID);
+    planeKeys[iHit] = lastPlane;
+    wireKeys[iHit] = fWireOffsets[lastPlane] + wireID.Wire;
+  } // for
+
+  fByPlane.fill(planeKeys, fPlanes.size());
+  fByWire.fill(wireKeys, fWireOffsets.back());
+
+  fMemory.set(memoryUsage());
+
+} // proxy::HitGroupIndex::HitGroupIndex()
+
+
+//------------------------------------------------------------------------------
+std::size_t proxy::HitGroupIndex::memoryUsage() const {
+  auto const bytes = [](auto const& v){ return v.capacity() * sizeof(v[0]); };
+  std::size_t size = 0U;
+  for (Groups_t const* groups: { &fByChannel, &fByPlane, &fByWire })
+    size += bytes(groups->offsets) + bytes(groups->positions);
+  return size + bytes(fChannels) + bytes(fPlanes) + bytes(fWireOffsets);
+} // proxy::HitGroupIndex::memoryUsage()
+
+
+//------------------------------------------------------------------------------
+auto proxy::HitGroupIndex::hitsOnChannel(raw::ChannelID_t channel) const
+  -> group_t
+{
+  return fByChannel.group
+    (raw::isValidChannelID(channel)? std::size_t(channel): InvalidKey);
+} // proxy::HitGroupIndex::hitsOnChannel()
+
+
+//------------------------------------------------------------------------------
+auto proxy::HitGroupIndex::hitsOnPlane(geo::PlaneID const& planeID) const
+  -> group_t
+  { return fByPlane.group(planeKey(planeID)); }
+
+
+//------------------------------------------------------------------------------
+auto proxy::HitGroupIndex::hitsOnWire(geo::WireID const& wireID) const
+  -> group_t
+{
+  std::size_t const iPlane = planeKey(wireID);
+  if (iPlane == InvalidKey) return fByWire.group(InvalidKey);
+  std::size_t const wireKey = fWireOffsets[iPlane] + wireID.Wire;
+  return fByWire.group
+    ((wireKey < fWireOffsets[iPlane + 1])? wireKey: InvalidKey);
+} // proxy::HitGroupIndex::hitsOnWire()
+
+
+//------------------------------------------------------------------------------
+std::size_t proxy::HitGroupIndex::planeKey(geo::PlaneID const& planeID) const
+{
+  if (!planeID.isValid) return InvalidKey;
+  // `planeID` may be a wire ID: compare it as a plane ID
+  auto const iPlane
+    = std::lower_bound(fPlanes.cbegin(), fPlanes.cend(), planeID);
+  return ((iPlane != fPlanes.cend()) && (*iPlane == planeID))
+    ? std::size_t(iPlane - fPlanes.cbegin()): InvalidKey;
+} // proxy::HitGroupIndex::planeKey()
+
+
+//------------------------------------------------------------------------------
+auto proxy::HitGroupIndex::Groups_t::group(std::size_t key) const -> group_t
+{
+  if (key >= size()) {
+    std::size_t const* const none = positions.data();
+    return lar::makeCollectionView(none, none);
+  }
+  return lar::makeCollectionView
+    (positions.data() + offsets[key], positions.data() + offsets[key + 1]);
+} // proxy::HitGroupIndex::Groups_t::group()
+
+
+//------------------------------------------------------------------------------
+void proxy::HitGroupIndex::Groups_t::fill
+  (std::vector<std::size_t> const& keys, std::size_t nKeys)
+{
+  std::size_t const n = keys.size();
+
+  // count the elements of each group, then place them
+  offsets.assign(nKeys + 1U, 0U);
+  for (std::size_t key: keys) if (key != InvalidKey) ++offsets[key + 1];
+  for (std::size_t key = 0; key < nKeys; ++key)
+    offsets[key + 1] += offsets[key];
+
+  positions.resize(offsets.back());
+  std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (keys[i] != InvalidKey) positions[next[keys[i]]++] = i;
+  } // for
+
+} // proxy::HitGroupIndex::Groups_t::fill()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,332 @@
+/**
+ * @file   lardata/RecoBaseProxy/Hits.h
+ * @brief  Offers `proxy::Hits`, a hit collection proxy grouped by channel,
+ *         wire and plane.
+ * @date   October 14, 2026
+ * @see    Hits.cxx
+ *
+ * This file defines the proxy of a `recob::Hit` collection, which in addition
+ * to the standard proxy interface offers the hits on a given channel, wire or
+ * plane. It contains:
+ *
+ * * `proxy::Hits`: the formal name of the proxy
+ * * `proxy::getHits()`: a function to create a collection proxy of that type
+ * * `proxy::HitGroupIndex`: the positions of the hits grouped by channel, wire
+ *   and plane, built once per collection proxy
+ * * `proxy::HitGroup`: the hit proxies of one group
+ * * `proxy::HitsCollectionProxy`: the interface of the collection proxy
+ *   (derived and extended from the standard one)
+ * * a specialization of `proxy::CollectionProxyMakerTraits` for this collection
+ *   proxy
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_HITS_H
+#define LARDATA_RECOBASEPROXY_HITS_H
+
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase.h" // proxy namespace
+#include "lardata/Utilities/CollectionView.h"
+#include "lardata/Utilities/MemoryAccounting.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::PlaneID, ...
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <memory> // std::shared_ptr<>, std::make_shared()
+#include <mutex> // std::call_once(), std::once_flag
+#include <vector>
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Proxy tag for a `recob::Hit` collection grouped by readout element.
+   * @see `proxy::getHits()`, `proxy::HitsCollectionProxy`
+   *
+   * Many algorithms need the hits on a specific channel, wire or plane, and
+   * end up sorting the hit collection or filling a map of hit indices in
+   * each event. This proxy computes that grouping once and shares it:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto hits = proxy::getHits
+   *   (event, hitTag, proxy::withAssociated<recob::Wire>(hitTag));
+   *
+   * for (geo::PlaneID const& planeID: hits.groupIndex().planes()) {
+   *   for (auto hit: hits.onPlane(planeID)) {
+   *     recob::Hit const& hitData = *hit;
+   *     auto const& wires = hit.get<recob::Wire>();
+   *     // ...
+   *   }
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The elements of the groups are the regular hit proxies, which carry all
+   * the auxiliary data merged into the collection proxy (in the example, the
+   * associated wire, and raw digits could be added the same way).
+   *
+   * @note `proxy::Hits` is *not* the type of the collection proxy returned by
+   *       `proxy::getHits()`.
+   */
+  struct Hits {
+
+    /// Type of the main collection.
+    using HitDataProduct_t = std::vector<recob::Hit>;
+
+  }; // struct Hits
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Positions of hits grouped by channel, wire and plane.
+   * @see `proxy::HitsCollectionProxy::groupIndex()`
+   *
+   * The groups are stored as contiguous lists of positions in the hit
+   * collection (compressed sparse rows), filled with a counting sort: within
+   * each group, the hits keep the order of the original collection.
+   * Channels are indexed directly, while planes and wires are numbered in
+   * the increasing order of their ID.
+   *
+   * Hits with an invalid channel are not in any channel group, and hits with
+   * an invalid wire ID are not in any plane or wire group.
+   *
+   * The memory of the index is registered under the tag `"proxy::HitGroupIndex"`
+   * (see `lar::MemoryAccounting`).
+   */
+  class HitGroupIndex {
+
+      public:
+
+    /// Type of a group: the positions of its hits in the collection.
+    using group_t = lar::RangeAsCollection_t<std::size_t const*>;
+
+    /// Constructor: empty index.
+    HitGroupIndex() = default;
+
+    /// Constructor: groups the specified hits.
+    explicit HitGroupIndex(std::vector<recob::Hit> const& hits);
+
+    /// Returns the number of hits in the indexed collection.
+    std::size_t nHits() const { return fNHits; }
+
+    // --- BEGIN channel groups ------------------------------------------------
+    /// @name Channel groups
+    /// @{
+
+    /// Returns all the channels with at least one hit, in increasing order.
+    std::vector<raw::ChannelID_t> const& channels() const { return fChannels; }
+
+    /// Returns the positions of the hits on the specified channel.
+    group_t hitsOnChannel(raw::ChannelID_t channel) const;
+
+    /// @}
+    // --- END channel groups --------------------------------------------------
+
+
+    // --- BEGIN plane and wire groups -----------------------------------------
+    /// @name Plane and wire groups
+    /// @{
+
+    /// Returns all the planes with at least one hit, in increasing order.
+    std::vector<geo::PlaneID> const& planes() const { return fPlanes; }
+
+    /// Returns the positions of the hits on the specified plane.
+    group_t hitsOnPlane(geo::PlaneID const& planeID) const;
+
+    /// Returns the positions of the hits on the specified wire.
+    group_t hitsOnWire(geo::WireID const& wireID) const;
+
+    /// @}
+    // --- END plane and wire groups -------------------------------------------
+
+
+      private:
+
+    /// Groups of positions in compressed sparse row format.
+    struct Groups_t {
+
+      /// Start of each group in `positions`, plus the end.
+      std::vector<std::size_t> offsets { 0U };
+
+      std::vector<std::size_t> positions; ///< Positions of all the hits.
+
+      /// Returns the number of groups.
+      std::size_t size() const { return offsets.size() - 1U; }
+
+      /// Returns the positions in the group `key` (empty if not present).
+      group_t group(std::size_t key) const;
+
+      /// Fills all groups with a counting sort of the keys
+      /// (`InvalidKey` ones are skipped).
+      void fill(std::vector<std::size_t> const& keys, std::size_t nKeys);
+
+    }; // struct Groups_t
+
+    /// Key of hits not belonging to any group.
+    static constexpr std::size_t InvalidKey = ~std::size_t(0);
+
+    std::size_t fNHits = 0U; ///< Number of hits in the collection.
+
+    Groups_t fByChannel; ///< Hits by channel number.
+    Groups_t fByPlane; ///< Hits by plane, in the order of `fPlanes`.
+    Groups_t fByWire; ///< Hits by wire, plane after plane.
+
+    std::vector<raw::ChannelID_t> fChannels; ///< Channels with hits.
+    std::vector<geo::PlaneID> fPlanes; ///< Planes with hits.
+
+    /// Key of the first wire of each plane in `fByWire`, plus the end.
+    std::vector<std::size_t> fWireOffsets { 0U };
+
+    /// Tag of the memory of the index.
+    struct MemoryTag
+      { static constexpr char const* Name = "proxy::HitGroupIndex"; };
+
+    lar::MemoryAccount<MemoryTag> fMemory; ///< Registered memory of the index.
+
+    /// Returns the memory allocated by the index [bytes].
+    std::size_t memoryUsage() const;
+
+    /// Returns the position of `planeID` in `fPlanes` (`InvalidKey` if none).
+    std::size_t planeKey(geo::PlaneID const& planeID) const;
+
+  }; // class HitGroupIndex
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Hit proxies of one channel, wire or plane.
+   * @tparam CollProxy type of the hit collection proxy
+   *
+   * This is a random access range of element proxies of `CollProxy`, in the
+   * order of the original collection. The group refers to the collection
+   * proxy it comes from, and must not outlive it.
+   */
+  template <typename CollProxy>
+  using HitGroup = CollectionProxySubset<CollProxy>;
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Proxy collection class for hits grouped by channel, wire and plane.
+   * @tparam MainColl type of hit collection
+   * @tparam AuxColl types of auxiliary data collections
+   * @see `proxy::Hits`, `proxy::HitGroupIndex`, `proxy::CollectionProxyBase`
+   *
+   * In addition to the standard proxy interface, the hits on one channel,
+   * wire or plane can be accessed directly:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto hits = proxy::getHits(event, hitTag);
+   * for (raw::ChannelID_t channel: hits.groupIndex().channels()) {
+   *   for (auto hit: hits.onChannel(channel)) {
+   *     // ...
+   *   }
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The grouping is computed on the first request, and shared by all the
+   * following ones on this proxy (also from different threads) and by its
+   * copies.
+   */
+  template <typename MainColl, typename... AuxColl>
+  class HitsCollectionProxy
+    : public CollectionProxyBase<CollectionProxyElement, MainColl, AuxColl...>
+  {
+    using base_t
+      = CollectionProxyBase<CollectionProxyElement, MainColl, AuxColl...>;
+    using base_t::base_t;
+
+      public:
+
+    /// Type of a group of hit proxies.
+    using group_t = HitGroup<HitsCollectionProxy>;
+
+    /// Returns the original collection of hits.
+    auto const& hits() const { return base_t::main(); }
+
+    /// Returns the index of the hits by channel, wire and plane.
+    HitGroupIndex const& groupIndex() const;
+
+    /// Returns the proxies of the hits on the specified channel.
+    group_t onChannel(raw::ChannelID_t channel) const
+      { return { *this, groupIndex().hitsOnChannel(channel) }; }
+
+    /// Returns the proxies of the hits on the specified wire.
+    group_t onWire(geo::WireID const& wireID) const
+      { return { *this, groupIndex().hitsOnWire(wireID) }; }
+
+    /// Returns the proxies of the hits on the specified plane.
+    group_t onPlane(geo::PlaneID const& planeID) const
+      { return { *this, groupIndex().hitsOnPlane(planeID) }; }
+
+      private:
+    /// Index, built on demand, and flag for its building.
+    struct IndexCache {
+      std::once_flag built;
+      HitGroupIndex index;
+    }; // struct IndexCache
+
+    /// Cache of the index (shared by copies of this proxy).
+    std::shared_ptr<IndexCache> fIndex = std::make_shared<IndexCache>();
+
+  }; // HitsCollectionProxy
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Creates and returns a proxy to hits grouped by readout element.
+   * @tparam Event type of the event to read data from
+   * @tparam Args additional arguments
+   * @param event event to read the data from
+   * @param inputTag tag of the hit collection
+   * @param withArgs additional elements to be merged into the proxy
+   * @return a proxy to the hits
+   * @see `proxy::Hits`, `proxy::HitsCollectionProxy`, `proxy::getCollection()`
+   *
+   * This is equivalent to `proxy::getCollection<proxy::Hits>()`.
+   */
+  template <typename Event, typename... Args>
+  auto getHits(Event const& event, art::InputTag inputTag, Args&&... withArgs)
+    {
+      return proxy::getCollection<Hits>
+        (event, inputTag, std::forward<Args>(withArgs)...);
+    } // getHits()
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Traits of `proxy::Hits` proxy.
+   *
+   * The proxy uses a custom collection proxy, `HitsCollectionProxy`, with the
+   * standard element proxy.
+   */
+  template <>
+  struct CollectionProxyMakerTraits<Hits>
+    : public CollectionProxyMakerTraits<Hits::HitDataProduct_t>
+  {
+    template <typename... Args>
+    using collection_proxy_impl_t = HitsCollectionProxy<Args...>;
+  };
+
+  //----------------------------------------------------------------------------
+
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename MainColl, typename... AuxColl>
+auto proxy::HitsCollectionProxy<MainColl, AuxColl...>::groupIndex
+  () const -> HitGroupIndex const&
+{
+  std::call_once(fIndex->built,
+    [this](){ fIndex->index = HitGroupIndex(hits()); }
+    );
+  return fIndex->index;
+} // proxy::HitsCollectionProxy<>::groupIndex()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_RECOBASEPROXY_HITS_H
@@ -0,0 +1,61 @@
+/**
+ * @file   lardata/RecoBaseProxy/PFParticleHierarchyCache.h
+ * @brief  Shares the hierarchy index of a PFParticle collection in an event.
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/PFParticleHierarchy.h
+ *         lardata/RecoBaseProxy/ProxyBase/ProxyCache.h
+ *
+ * This library is header-only, but users need to link to
+ * `lardata_ArtDataHelper`.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PFPARTICLEHIERARCHYCACHE_H
+#define LARDATA_RECOBASEPROXY_PFPARTICLEHIERARCHYCACHE_H
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/ProxyCache.h"
+#include "lardata/ArtDataHelper/PFParticleHierarchy.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+
+// framework libraries
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard
+#include <memory> // std::shared_ptr<>
+#include <vector>
+
+
+namespace proxy {
+
+  /**
+   * @brief Returns the hierarchy of the PFParticles with the specified tag.
+   * @tparam Event type of event to read data from
+   * @param cache the cache to share the hierarchy through
+   * @param event event to read data from
+   * @param tag input tag of the `recob::PFParticle` collection
+   * @return a shared pointer to the constant hierarchy
+   *
+   * The hierarchy is built the first time it is requested for the event,
+   * and shared by all the following requests with the same `tag`:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const hierarchy = proxy::getPFParticleHierarchy(
+   *   art::ServiceHandle<proxy::ProxyCacheService>()->cache(),
+   *   event, pfpTag
+   *   );
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The positions in the hierarchy refer to the collection in the event.
+   */
+  template <typename Event>
+  std::shared_ptr<recob::PFParticleHierarchy const> getPFParticleHierarchy
+    (ProxyCache& cache, Event const& event, art::InputTag const& tag)
+  {
+    return cache.getObject<recob::PFParticleHierarchy>(event, tag, [&](){
+      return recob::PFParticleHierarchy
+        (*event.template getValidHandle<std::vector<recob::PFParticle>>(tag));
+    });
+  } // getPFParticleHierarchy()
+
+} // namespace proxy
+
+
+#endif // LARDATA_RECOBASEPROXY_PFPARTICLEHIERARCHYCACHE_H
@@ -18,6 +18,10 @@
 #include "lardata/RecoBaseProxy/ProxyBase/withAssociated.h"
 #include "lardata/RecoBaseProxy/ProxyBase/withParallelData.h"
 #include "lardata/RecoBaseProxy/ProxyBase/withZeroOrOne.h"
+#include "lardata/RecoBaseProxy/ProxyBase/withLazy.h"
 #include "lardata/RecoBaseProxy/ProxyBase/getCollection.h"
+#include "lardata/RecoBaseProxy/ProxyBase/CollectionProxyPartition.h"
+#include "lardata/RecoBaseProxy/ProxyBase/ProxyCache.h"
+#include "lardata/RecoBaseProxy/ProxyBase/IndexBufferPool.h"
 
 #endif // LARDATA_RECOBASEPROXY_PROXYBASE_H
@@ -14,6 +14,7 @@
 // LArSoft libraries
 #include "lardata/RecoBaseProxy/ProxyBase/AssnsNodeAsTuple.h"
 #include "lardata/RecoBaseProxy/ProxyBase/AssnsTraits.h"
+#include "lardata/RecoBaseProxy/ProxyBase/IndexBufferPool.h"
 #include "lardata/Utilities/CollectionView.h"
 #include "lardata/Utilities/TupleLookupByTag.h" // util::add_tag_t, ...
 #include "larcorealg/CoreUtils/MetaUtils.h" // util::is_not_same<>
@@ -31,6 +32,7 @@
 #include <utility> // std::forward(), std::declval(), ...
 #include <type_traits> // std::is_same<>, std::enable_if_t<>, ...
 #include <cstdlib> // std::size_t
+#include <cstddef> // std::ptrdiff_t
 #include <cassert>
 
 
@@ -751,6 +753,260 @@ namespace proxy {
     }; // class BoundaryList
 
 
+    /**
+     * @brief Iterator to association nodes through a list of node iterators.
+     * @tparam NodeIter type of iterator to association nodes
+     *
+     * This iterator walks a random access sequence of `NodeIter` iterators
+     * (`assns_node_iterator` in `AssociatedData`), which may be in an order
+     * different from the one of the original association, and exposes the
+     * nodes they point to, with the same interface as `NodeIter` itself.
+     * The referenced nodes live in the `NodeIter` objects of the list, which
+     * must therefore persist as long as this iterator is used.
+     */
+    template <typename NodeIter>
+    class assns_node_indirect_iterator {
+      using node_iterator_t = NodeIter; ///< Type of wrapped node iterator.
+      using list_iterator_t
+        = typename std::vector<node_iterator_t>::const_iterator;
+
+      list_iterator_t fIter; ///< Iterator to the current node iterator.
+
+      /// Returns the node iterator currently pointed.
+      node_iterator_t const& nodeIter() const { return *fIter; }
+
+        public:
+      /// Type of node for this association iterator.
+      using AssnsNode_t = std::decay_t<decltype(std::declval<node_iterator_t>().info())>;
+
+      /// @{
+      /// @name Iterator traits
+      using difference_type = std::ptrdiff_t;
+      using value_type = AssnsNode_t;
+      using pointer = value_type const*;
+      using reference = value_type const&;
+      using iterator_category = std::random_access_iterator_tag;
+      /// @}
+
+      /// Default constructor: the iterator is invalid.
+      assns_node_indirect_iterator() = default;
+
+      /// Constructor: points to the node of the specified node iterator.
+      explicit assns_node_indirect_iterator(list_iterator_t const& it)
+        : fIter(it) {}
+
+      /// Returns the full information the iterator points to.
+      AssnsNode_t const& info() const { return nodeIter().info(); }
+
+      /// Returns the full information the iterator points to.
+      AssnsNode_t const& operator() () const { return info(); }
+
+      /// @{
+      /// @name Iterator interface
+
+      reference operator*() const { return info(); }
+      pointer operator->() const { return std::addressof(info()); }
+      reference operator[](difference_type n) const
+        { return fIter[n].info(); }
+
+      assns_node_indirect_iterator& operator++() { ++fIter; return *this; }
+      assns_node_indirect_iterator& operator--() { --fIter; return *this; }
+      assns_node_indirect_iterator operator++(int)
+        { auto old = *this; ++fIter; return old; }
+      assns_node_indirect_iterator operator--(int)
+        { auto old = *this; --fIter; return old; }
+      assns_node_indirect_iterator& operator+=(difference_type n)
+        { fIter += n; return *this; }
+      assns_node_indirect_iterator& operator-=(difference_type n)
+        { fIter -= n; return *this; }
+      assns_node_indirect_iterator operator+(difference_type n) const
+        { return assns_node_indirect_iterator(fIter + n); }
+      assns_node_indirect_iterator operator-(difference_type n) const
+        { return assns_node_indirect_iterator(fIter - n); }
+      difference_type operator-(assns_node_indirect_iterator const& other) const
+        { return fIter - other.fIter; }
+
+      bool operator==(assns_node_indirect_iterator const& other) const
+        { return fIter == other.fIter; }
+      bool operator!=(assns_node_indirect_iterator const& other) const
+        { return fIter != other.fIter; }
+      bool operator<(assns_node_indirect_iterator const& other) const
+        { return fIter < other.fIter; }
+
+      /// @}
+
+      //--- BEGIN Access to the full association information -------------------
+      /// @name Access to the full association information
+      /// This interface is a replica of the one of `AssnsNode_t`.
+      /// @{
+
+      using main_t     = typename AssnsNode_t::main_t;
+      using value_t    = typename AssnsNode_t::value_t;
+      using data_t     = typename AssnsNode_t::data_t;
+      using mainptr_t  = typename AssnsNode_t::mainptr_t;
+      using valueptr_t = typename AssnsNode_t::valueptr_t;
+      using dataptr_t  = typename AssnsNode_t::dataptr_t;
+
+      /// Returns the _art_ pointer to the associated value.
+      valueptr_t valuePtr() const { return info().valuePtr(); }
+
+      /// Returns the _art_ pointer to the associated value.
+      value_t const& value() const { return info().value(); }
+
+      /// Returns the _art_ pointer to the main value, key of the association.
+      mainptr_t mainPtr() const { return info().mainPtr(); }
+
+      /// Returns the main value, key of the association.
+      main_t const& main() const { return info().main(); }
+
+      /// Returns whether this node type supports metadata.
+      template <typename Node = AssnsNode_t>
+      static constexpr bool hasMetadata()
+        { return lar::util::assns_has_metadata_v<Node>; }
+
+      /// Returns the pointer to the metadata on this association node.
+      template <typename Iter = node_iterator_t>
+      auto dataPtr() const -> decltype(std::declval<Iter>().dataPtr())
+        { return nodeIter().dataPtr(); }
+
+      /// Returns a reference to the metadata on this association node.
+      template <typename Iter = node_iterator_t>
+      auto data() const -> decltype(std::declval<Iter>().data())
+        { return nodeIter().data(); }
+
+      /// @}
+      //--- END Access to the full association information ---------------------
+
+    }; // class assns_node_indirect_iterator<>
+
+
+    /**
+     * @brief Index of association nodes grouped by main key.
+     * @tparam NodeIter type of iterator to the association nodes
+     *
+     * This is a "compressed sparse row" representation of an association:
+     * a contiguous list of iterators to the association nodes, ordered by key
+     * of the main (left) object, and a list of offsets, where the nodes of the
+     * main object with key `i` are the ones from `offsets[i]` (included) to
+     * `offsets[i + 1]` (excluded).
+     * The index is built in linear time by `makeAssnsGroupIndex()`, and the
+     * input association is not required to be sorted; within each group,
+     * nodes keep their relative order from the association.
+     *
+     * The interface is the same as the one of `BoundaryList`: the index is a
+     * random access collection of ranges (`range_t`), each one a random access
+     * collection of association nodes.
+     *
+     * The list of node iterators and the offsets are shared among copies of
+     * the index, so that copying is cheap and ranges stay valid as long as any
+     * copy exists. Their memory may come from a `proxy::IndexBufferPool`.
+     */
+    template <typename NodeIter>
+    class AssnsGroupIndex {
+        public:
+      /// Type of iterator to the original association nodes.
+      using node_iterator_t = NodeIter;
+
+      /// Type of the list of node iterators, in group order.
+      using nodes_t = std::vector<node_iterator_t>;
+
+      /// Type of the list of group offsets.
+      using offsets_t = std::vector<std::size_t>;
+
+      /// Type of iterator to nodes within a range.
+      using data_iterator_t = assns_node_indirect_iterator<node_iterator_t>;
+
+      /// Range object directly containing the boundary iterators.
+      using range_t = lar::RangeAsCollection_t<data_iterator_t>;
+
+      /// Iterator on the ranges contained in the collection.
+      class range_iterator_t {
+        AssnsGroupIndex const* fIndex = nullptr; ///< Index being iterated.
+        std::size_t fGroup = 0; ///< Current group.
+
+          public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = range_t;
+        using pointer = value_type const*;
+        using reference = value_type;
+        using iterator_category = std::forward_iterator_tag;
+
+        range_iterator_t() = default;
+        range_iterator_t(AssnsGroupIndex const& index, std::size_t group)
+          : fIndex(&index), fGroup(group) {}
+
+        range_t operator*() const { return fIndex->range(fGroup); }
+        range_iterator_t& operator++() { ++fGroup; return *this; }
+        range_iterator_t operator++(int)
+          { auto old = *this; ++fGroup; return old; }
+        bool operator==(range_iterator_t const& other) const
+          { return (fIndex == other.fIndex) && (fGroup == other.fGroup); }
+        bool operator!=(range_iterator_t const& other) const
+          { return !operator==(other); }
+      }; // class range_iterator_t
+
+
+      /// Constructor: acquires node list and offsets (must be consistent).
+      AssnsGroupIndex
+        (std::shared_ptr<nodes_t const> nodes, offsets_t&& offsets)
+        : AssnsGroupIndex(
+          std::move(nodes), std::make_shared<offsets_t const>(std::move(offsets))
+          )
+        {}
+
+      /// Constructor: shares node list and offsets (must be consistent).
+      AssnsGroupIndex(
+        std::shared_ptr<nodes_t const> nodes,
+        std::shared_ptr<offsets_t const> offsets
+        )
+        : fNodes(std::move(nodes)), fOffsets(std::move(offsets))
+        {
+          assert(fNodes);
+          assert(fOffsets);
+          assert(fOffsets->size() >= 1);
+          assert(fOffsets->back() == fNodes->size());
+        }
+
+      /// Returns the number of ranges contained in the list.
+      std::size_t nRanges() const { return fOffsets->size() - 1; }
+
+      /// Returns the begin iterator of the `i`-th range (end if overflow).
+      data_iterator_t rangeBegin(std::size_t i) const
+        { return dataIter((*fOffsets)[std::min(i, nRanges())]); }
+      /// Returns the end iterator of the `i`-th range (end if overflow).
+      data_iterator_t rangeEnd(std::size_t i) const
+        { return rangeBegin(i + 1); }
+
+      /// Returns the number of ranges contained in the list.
+      std::size_t size() const { return nRanges(); }
+      /// Returns the begin iterator of the first range.
+      range_iterator_t begin() const { return { *this, 0U }; }
+      /// Returns the end iterator of the last range.
+      range_iterator_t end() const { return { *this, nRanges() }; }
+
+      /// Returns the specified range (valid while this index or a copy exists).
+      range_t range(std::size_t i) const
+        { return lar::makeCollectionView(rangeBegin(i), rangeEnd(i)); }
+
+      /// Returns the specified range.
+      range_t operator[](std::size_t i) const { return range(i); }
+
+      /// Returns the list of offsets (one more than the number of ranges).
+      offsets_t const& offsets() const { return *fOffsets; }
+
+        private:
+      std::shared_ptr<nodes_t const> fNodes; ///< Node iterators, in group order.
+
+      /// Start of each group in `fNodes`, plus its end.
+      std::shared_ptr<offsets_t const> fOffsets;
+
+      /// Returns an iterator to the node at the specified position.
+      data_iterator_t dataIter(std::size_t pos) const
+        { return data_iterator_t(std::next(fNodes->begin(), pos)); }
+
+    }; // class AssnsGroupIndex<>
+
+
     /**
      * @brief Object to draft associated data interface.
      * @tparam Main type of the main associated object (one)
@@ -764,9 +1020,10 @@ namespace proxy {
      *
      * Construction is not part of the interface.
      *
-     * The `AssociatedData` object, on creation, finds the borders surrounding
-     * the associated `Aux` objects for each `Main` one, and keep a record of
-     * them (this is actually delegated to `BoundaryList` class).
+     * The `AssociatedData` object, on creation, groups the associated `Aux`
+     * objects by `Main` one, and keep a record of them (this is actually
+     * delegated to `AssnsGroupIndex` class).
+     * The association is not required to be sorted by `Main` key.
      * The `AssociatedData` object also provides a container-like view of this
      * information, where each element in the container is associated to a
      * single `Main` and it is a container (actually, another view) of `Right`.
@@ -793,7 +1050,7 @@ namespace proxy {
         public:
       using tag = Tag; ///< Tag of this association proxy.
 
-      using group_ranges_t = BoundaryList<associated_data_iterator_t>;
+      using group_ranges_t = AssnsGroupIndex<associated_data_iterator_t>;
 
       /// Type of collection of auxiliary data associated with a main item.
       using auxiliary_data_t
@@ -851,8 +1108,12 @@ namespace proxy {
    * @param minSize minimum number of entries in the produced association data
    * @return a new `AssociatedData` filled with associations from `tag`
    *
-   * The content of the association object must fulfill the requirements of
-   * @ref LArSoftProxyDefinitionOneToManySeqAssn "one-to-many sequential association".
+   * The association object is typically a
+   * @ref LArSoftProxyDefinitionOneToManySeqAssn "one-to-many sequential association",
+   * but sorting by main key is not required: the associations are grouped by
+   * key into a "compressed sparse row" index (`details::AssnsGroupIndex`) in
+   * linear time, and the associated objects of each main object are then
+   * accessed in constant time.
    * The `Assns` type is expected to be a `art::Assns` instance. At least,
    * the `Assns` type is required to have `left_t` and `right_t` definitions
    * representing respectively the main data type and the associated one, and
@@ -1030,6 +1291,70 @@ namespace proxy {
       }
 
 
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Groups associations by key, in a compressed sparse row index.
+     * @tparam GroupKey index of the key in the tuple pointed by the iterator
+     * @tparam NodeIter type of iterator to be stored in the index
+     * @tparam Iter type of iterators delimiting the data (same type required)
+     * @param begin iterator to the first association in the list
+     * @param end iterator past the last association in the list
+     * @param n minimum number of ranges to be produced
+     * @return an index of the associations grouped by key
+     *
+     * The input iterators are expected to point to a tuple-like structure whose
+     * key element can be accessed as `std::get<GroupKey>()` and is an _art_
+     * pointer of some sort.
+     * Each input iterator is converted into a `NodeIter` to be stored.
+     *
+     * Keys do not need to be sorted: the index is built with a stable counting
+     * sort (two passes on the input), so that the associations with the same
+     * key keep their relative order.
+     * There are as many ranges as the largest key plus one, or `n` if larger;
+     * keys with no association have an empty range.
+     */
+    template <std::size_t GroupKey, typename NodeIter, typename Iter>
+    AssnsGroupIndex<NodeIter> makeAssnsGroupIndex
+      (Iter begin, Iter end, std::size_t n = 0)
+    {
+      constexpr auto KeyIndex = GroupKey;
+
+      auto extractKey
+        = [](auto const& assn){ return std::get<KeyIndex>(assn).key(); };
+
+      using index_t = AssnsGroupIndex<NodeIter>;
+
+      // buffers are recycled from the pool in use, if any
+      auto offsetsBuffer = acquireIndexBuffer<std::size_t>();
+      auto nodes = acquireIndexBuffer<NodeIter>();
+      auto nextBuffer = acquireIndexBuffer<std::size_t>();
+
+      // first pass: count the associations of each key
+      typename index_t::offsets_t& offsets = *offsetsBuffer;
+      offsets.assign(n + 1, 0U);
+      std::size_t nAssns = 0;
+      for (auto it = begin; it != end; ++it, ++nAssns) {
+        std::size_t const key = extractKey(*it);
+        if (key >= offsets.size() - 1) offsets.resize(key + 2, 0U);
+        ++offsets[key + 1];
+      } // for
+
+      // turn counts into offsets
+      for (std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+      assert(offsets.back() == nAssns);
+
+      // second pass: place each association in its slot
+      nodes->assign(nAssns, NodeIter(begin));
+      auto& next = *nextBuffer;
+      next.assign(offsets.begin(), std::prev(offsets.end()));
+      for (auto it = begin; it != end; ++it)
+        (*nodes)[next[extractKey(*it)]++] = NodeIter(it);
+
+      return index_t(std::move(nodes), std::move(offsetsBuffer));
+    } // makeAssnsGroupIndex()
+
+
     //--------------------------------------------------------------------------
 
   } // namespace details
@@ -1045,18 +1370,15 @@ namespace proxy {
     using AssociatedData_t
       = details::AssociatedData<Main_t, Aux_t, Metadata_t, Tag>;
 
-    // associationRangeBoundaries() produces iterators to association elements,
-    // (i.e. tuples)
+    // makeAssnsGroupIndex() groups iterators to association elements
+    // (i.e. tuples), converted into iterators to the associated node
     using std::begin;
     using std::end;
-    auto ranges = details::associationRangeBoundaries<0U>
-      (begin(assns), end(assns), minSize);
-    // we convert those iterators into iterators to the right associated item
-    // (it takes a few steps)
     using group_ranges_t = typename AssociatedData_t::group_ranges_t;
     return AssociatedData_t(
-      group_ranges_t
-        (typename group_ranges_t::boundaries_t(ranges.begin(), ranges.end()))
+      details::makeAssnsGroupIndex
+        <0U, typename group_ranges_t::node_iterator_t>
+        (begin(assns), end(assns), minSize)
       );
   } // makeAssociatedDataFrom(assns)
 
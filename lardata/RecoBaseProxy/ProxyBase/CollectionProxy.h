@@ -21,8 +21,10 @@
 #include <vector>
 #include <tuple>
 #include <utility> // std::move()
+#include <iterator> // std::random_access_iterator_tag
 #include <limits> // std::numeric_limits<>
 #include <cstdlib> // std::size_t
+#include <cstddef> // std::ptrdiff_t
 
 
 namespace proxy {
@@ -37,6 +39,9 @@ namespace proxy {
 
   } // namespace details
 
+  template <typename CollProxy>
+  class CollectionProxyRange;
+
 
   // --- BEGIN Collection proxy infrastructure ---------------------------------
   /**
@@ -146,6 +151,9 @@ namespace proxy {
     /// Type of iterator to this collection (still constant).
     using iterator = const_iterator;
 
+    /// Type of splittable range of elements of this collection.
+    using range_t = CollectionProxyRange<collection_proxy_t>;
+
     /**
      * @brief Constructor: uses the specified data.
      * @param main the original main data product collection
@@ -187,6 +195,36 @@ namespace proxy {
     /// Returns the size of this collection.
     std::size_t size() const { return main().size(); }
 
+    /**
+     * @brief Returns a splittable range covering the whole collection.
+     * @param grainSize number of elements below which the range is not split
+     * @return a range object, `proxy::CollectionProxyRange`
+     * @see proxy::CollectionProxyRange
+     *
+     * The returned range can be handed to parallel algorithms like
+     * `tbb::parallel_for()`:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto const tracks = proxy::getCollection<proxy::Tracks>(event, tag);
+     *
+     * tbb::parallel_for(tracks.range(100U), [&](auto const& subrange){
+     *     for (auto const& track: subrange) {
+     *       // ... per-track analysis, e.g. track.nHits()
+     *     }
+     *   });
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * Since the collection iterators are random access, the standard parallel
+     * algorithms can be used too, directly on the collection:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * std::for_each(std::execution::par, tracks.begin(), tracks.end(),
+     *   [&](auto const& track){ ... });
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * In both cases, the elements are element proxies created on the spot
+     * from the collection proxy, which must outlive the algorithm.
+     * Access to the proxy is read-only, and no data is copied.
+     */
+    range_t range(std::size_t grainSize = 1U) const
+      { return { begin(), end(), grainSize }; }
+
 
     /// Returns the associated data proxy specified by `AuxTag`.
     template <typename AuxTag>
@@ -287,6 +325,94 @@ namespace proxy {
   }; // struct CollectionProxyBase
 
 
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Range of elements of a collection proxy, which can be split.
+   * @tparam CollProxy type of the collection proxy
+   * @see CollectionProxyBase::range()
+   *
+   * This object describes a contiguous range of elements in a collection
+   * proxy, and it fulfils the requirements of the _Range_ concept of Intel
+   * Threading Building Blocks: it can be used with `tbb::parallel_for()`,
+   * `tbb::parallel_reduce()` and the like. It does not depend on TBB though.
+   *
+   * The range is split in halves until it has no more than `grainsize()`
+   * elements. It is also a regular iterable range, with `begin()` and `end()`.
+   *
+   * The range does not own the elements, and the collection proxy it refers to
+   * must stay valid for as long as the range is used.
+   */
+  template <typename CollProxy>
+  class CollectionProxyRange {
+
+      public:
+    /// Type of collection proxy this range belongs to.
+    using collection_proxy_t = CollProxy;
+
+    /// Type of iterator to the elements of the range (constant).
+    using const_iterator = typename collection_proxy_t::const_iterator;
+
+    /// Type of iterator to the elements of the range (still constant).
+    using iterator = const_iterator;
+
+    /// Type of element in the range.
+    using value_type = typename collection_proxy_t::value_type;
+
+    /**
+     * @brief Constructor: range between two iterators.
+     * @param b iterator to the first element of the range
+     * @param e iterator past the last element of the range
+     * @param grainSize number of elements below which the range is not split
+     *
+     * A grain size of `0` is interpreted as `1`.
+     */
+    CollectionProxyRange
+      (const_iterator b, const_iterator e, std::size_t grainSize = 1U)
+      : fBegin(b), fEnd(e), fGrainSize(grainSize? grainSize: 1U)
+      {}
+
+    /**
+     * @brief Splitting constructor: steals the second half of `other`.
+     * @tparam Split type of the splitting tag (e.g. `tbb::split`), unused
+     * @param other the range to be split
+     *
+     * After the construction, `other` is left with the first half of its
+     * original elements, and this range covers the rest.
+     */
+    template <typename Split>
+    CollectionProxyRange(CollectionProxyRange& other, Split)
+      : fBegin(other.middle()), fEnd(other.fEnd), fGrainSize(other.fGrainSize)
+      { other.fEnd = fBegin; }
+
+    /// Returns an iterator to the first element of the range.
+    const_iterator begin() const { return fBegin; }
+
+    /// Returns an iterator past the last element of the range.
+    const_iterator end() const { return fEnd; }
+
+    /// Returns the number of elements in the range.
+    std::size_t size() const { return fEnd - fBegin; }
+
+    /// Returns whether the range has no elements.
+    bool empty() const { return !(fBegin != fEnd); }
+
+    /// Returns whether the range is large enough to be split.
+    bool is_divisible() const { return size() > fGrainSize; }
+
+    /// Returns the number of elements below which the range is not split.
+    std::size_t grainsize() const { return fGrainSize; }
+
+      private:
+    const_iterator fBegin; ///< Iterator to the first element.
+    const_iterator fEnd; ///< Iterator past the last element.
+    std::size_t fGrainSize; ///< Size of a range that is not divisible.
+
+    /// Returns an iterator to the middle element of the range.
+    const_iterator middle() const { return fBegin + (size() / 2); }
+
+  }; // class CollectionProxyRange<>
+
+
   //----------------------------------------------------------------------------
   /**
    * @brief Base representation of a collection of proxied objects.
@@ -342,6 +468,15 @@ namespace proxy {
      * @tparam Cont type of random-access container to iterate
      *
      * `Cont` is a type providing a public `operator[](std::size_t)` method.
+     *
+     * This is a random access iterator, that can be used by parallel
+     * algorithms (e.g. `std::for_each(std::execution::par, ...)`).
+     * Dereferencing it returns the element of the container _by value_, as
+     * returned by `Cont::operator[]`: for collection proxies, that is an
+     * element proxy object created on the spot. Therefore `reference` is not a
+     * true reference, and `operator->` is not provided. Strictly speaking,
+     * this makes the iterator only an input iterator in the C++ standard
+     * classification, even if all random access operations are supported.
      */
     template <typename Cont>
     class IndexBasedIterator {
@@ -352,6 +487,13 @@ namespace proxy {
       using value_type = util::collection_value_t<container_t>;
       using const_iterator = IndexBasedIterator;
 
+      // --- BEGIN iterator traits ---------------------------------------------
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type;
+      using pointer = void;
+      using iterator_category = std::random_access_iterator_tag;
+      // --- END iterator traits -----------------------------------------------
+
       /// Default constructor (required by iterator protocol): an unusable iterator.
       IndexBasedIterator() = default;
 
@@ -363,13 +505,79 @@ namespace proxy {
       auto operator* () const -> decltype(auto)
         { return fCont->operator[](fIndex); }
 
-      /// Returns the value pointed by this iterator.
+      /// Returns the value `n` positions after the one pointed by this iterator.
+      auto operator[] (difference_type n) const -> decltype(auto)
+        { return fCont->operator[](fIndex + n); }
+
+      // --- BEGIN increment and decrement -------------------------------------
+      /// Points to the next element.
       const_iterator& operator++ () { ++fIndex; return *this; }
 
+      /// Points to the next element, returns an iterator to the current one.
+      const_iterator operator++ (int)
+        { const_iterator old(*this); ++fIndex; return old; }
+
+      /// Points to the previous element.
+      const_iterator& operator-- () { --fIndex; return *this; }
+
+      /// Points to the previous element, returns an iterator to the current one.
+      const_iterator operator-- (int)
+        { const_iterator old(*this); --fIndex; return old; }
+
+      /// Moves this iterator forward by `n` elements.
+      const_iterator& operator+= (difference_type n)
+        { fIndex += n; return *this; }
+
+      /// Moves this iterator backward by `n` elements.
+      const_iterator& operator-= (difference_type n)
+        { fIndex -= n; return *this; }
+
+      /// Returns an iterator `n` elements after this one.
+      const_iterator operator+ (difference_type n) const
+        { return { *fCont, fIndex + n }; }
+
+      /// Returns an iterator `n` elements before this one.
+      const_iterator operator- (difference_type n) const
+        { return { *fCont, fIndex - n }; }
+
+      /// Returns the distance of this iterator from `other`.
+      difference_type operator- (const_iterator const& other) const
+        {
+          return static_cast<difference_type>(fIndex)
+            - static_cast<difference_type>(other.fIndex);
+        }
+      // --- END increment and decrement ---------------------------------------
+
+      // --- BEGIN comparisons -------------------------------------------------
+      /**
+       * @name Comparisons
+       *
+       * The relational operators compare only the index, and are meaningful
+       * only for iterators on the same container.
+       */
+      /// @{
       /// Returns whether the iterators point to the same element.
+      bool operator== (const_iterator const& other) const
+        { return (other.fIndex == fIndex) && (other.fCont == fCont); }
+
+      /// Returns whether the iterators point to different elements.
       bool operator!= (const_iterator const& other) const
         { return (other.fIndex != fIndex) || (other.fCont != fCont); }
 
+      bool operator< (const_iterator const& other) const
+        { return fIndex < other.fIndex; }
+      bool operator<= (const_iterator const& other) const
+        { return fIndex <= other.fIndex; }
+      bool operator> (const_iterator const& other) const
+        { return fIndex > other.fIndex; }
+      bool operator>= (const_iterator const& other) const
+        { return fIndex >= other.fIndex; }
+      /// @}
+      // --- END comparisons ---------------------------------------------------
+
+      /// Returns the index of the element pointed by this iterator.
+      std::size_t index() const { return fIndex; }
+
         protected:
       container_t const* fCont = nullptr; ///< Pointer to the original container.
 
@@ -378,6 +586,16 @@ namespace proxy {
 
     }; // IndexBasedIterator<>
 
+
+    /// Returns an iterator `n` elements after `it`.
+    template <typename Cont>
+    IndexBasedIterator<Cont> operator+ (
+      typename IndexBasedIterator<Cont>::difference_type n,
+      IndexBasedIterator<Cont> const& it
+      )
+      { return it + n; }
+
+
   } // namespace details
 
 } // namespace proxy
@@ -33,6 +33,10 @@ namespace proxy {
     template <typename AuxCollTuple>
     struct SubstituteWithAuxList;
 
+    /// Returns the auxiliary data element as it is (overloaded for lazy data).
+    template <typename AuxElement>
+    AuxElement const& resolveAuxElement(AuxElement const& elem) { return elem; }
+
   } // namespace details
 
 
@@ -188,7 +192,11 @@ namespace proxy {
     /// Returns the auxiliary data specified by type (`Tag`).
     template <typename Tag>
     auto get() const -> decltype(auto)
-      { return std::get<util::index_of_tag_v<Tag, aux_elements_t>>(fAuxData); }
+      {
+        using details::resolveAuxElement; // the rest is found by ADL
+        return resolveAuxElement
+          (std::get<util::index_of_tag_v<Tag, aux_elements_t>>(fAuxData));
+      }
 
 
     /**
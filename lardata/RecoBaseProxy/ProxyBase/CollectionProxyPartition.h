@@ -0,0 +1,345 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyBase/CollectionProxyPartition.h
+ * @brief  Subsets of a collection proxy, grouped by a key.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyBase.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PROXYBASE_COLLECTIONPROXYPARTITION_H
+#define LARDATA_RECOBASEPROXY_PROXYBASE_COLLECTIONPROXYPARTITION_H
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/CollectionProxy.h"
+#include "lardata/RecoBaseProxy/ProxyBase/getCollection.h"
+#include "lardata/Utilities/CollectionView.h"
+
+// framework libraries
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard
+#include <vector>
+#include <algorithm> // std::sort(), std::unique(), std::lower_bound()
+#include <type_traits> // std::decay_t<>
+#include <utility> // std::move(), std::forward(), std::declval()
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  // --- BEGIN Collection proxy partitions -------------------------------------
+  /**
+   * @defgroup LArSoftProxyPartition Partitions of collection proxies
+   * @ingroup LArSoftProxyCollections
+   * @brief Subsets of a collection proxy sharing its auxiliary data.
+   *
+   * A collection proxy can be split in subsets (partitions) by a key computed
+   * from each of its elements, for example the TPC of a hit:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const hitsByTPC = proxy::getPartitionedCollection<proxy::Hits>
+   *   (event, hitTag, proxy::byTPC, proxy::withAssociated<recob::Wire>());
+   *
+   * tbb::parallel_for(std::size_t(0), hitsByTPC.size(), [&](std::size_t i){
+   *   geo::TPCID const& tpcid = hitsByTPC.key(i);
+   *   for (auto hit: hitsByTPC[i]) {
+   *     auto const& wire = hit.get<recob::Wire>();
+   *     // ...
+   *   }
+   * });
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The subsets are views into the partitioned collection proxy: their
+   * elements are the regular element proxies, and the main collection and
+   * all the auxiliary data (including the association indices) are shared
+   * rather than copied. The subsets are read-only and can be used
+   * concurrently.
+   *
+   * @{
+   */
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Elements of a collection proxy at the specified positions.
+   * @tparam CollProxy type of the collection proxy
+   *
+   * This is a random access range of element proxies of `CollProxy`, in the
+   * order of the positions. The subset refers to the collection proxy it
+   * comes from, and must not outlive it.
+   */
+  template <typename CollProxy>
+  class CollectionProxySubset {
+
+      public:
+
+    /// Type of the collection proxy the elements come from.
+    using collection_proxy_t = CollProxy;
+
+    /// Type of the elements of the subset.
+    using value_type = typename collection_proxy_t::element_proxy_t;
+
+    /// Type of sequence of the positions of the elements.
+    using positions_t = lar::RangeAsCollection_t<std::size_t const*>;
+
+    /// Type of iterator to the element proxies.
+    using const_iterator = details::IndexBasedIterator<CollectionProxySubset>;
+
+    /// Type of iterator to the element proxies.
+    using iterator = const_iterator;
+
+    /// Constructor: the elements in `positions` from the collection `coll`.
+    CollectionProxySubset
+      (collection_proxy_t const& coll, positions_t positions)
+      : fColl(&coll), fPositions(positions)
+      {}
+
+    /// Returns the number of elements in the subset.
+    std::size_t size() const { return fPositions.size(); }
+
+    /// Returns whether the subset has no elements.
+    bool empty() const { return fPositions.empty(); }
+
+    /// Returns the proxy of the `i`-th element of the subset.
+    value_type operator[] (std::size_t i) const
+      { return fColl->operator[](fPositions[i]); }
+
+    /// Returns the positions of the elements in the collection.
+    positions_t const& positions() const { return fPositions; }
+
+    /// Returns the collection proxy the elements come from.
+    collection_proxy_t const& collection() const { return *fColl; }
+
+    /// Returns an iterator to the first element proxy of the subset.
+    const_iterator begin() const { return { *this, 0U }; }
+
+    /// Returns an iterator past the last element proxy of the subset.
+    const_iterator end() const { return { *this, size() }; }
+
+      private:
+    collection_proxy_t const* fColl; ///< The collection of the elements.
+    positions_t fPositions; ///< Positions of the elements.
+
+  }; // class CollectionProxySubset<>
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief A collection proxy split into subsets by a key.
+   * @tparam CollProxy type of the collection proxy
+   * @tparam Key type of the key of the subsets
+   * @see `proxy::partitionCollection()`, `proxy::getPartitionedCollection()`
+   *
+   * The partition owns the collection proxy, and each subset is made of all
+   * the elements with the same key, in their original order. The subsets are
+   * sorted by key, which needs to support `operator<` and `operator==`.
+   *
+   * The subsets refer to the collection proxy in this object: they must not
+   * be used after this object is destroyed or moved.
+   */
+  template <typename CollProxy, typename Key>
+  class CollectionProxyPartition {
+
+      public:
+
+    /// Type of the partitioned collection proxy.
+    using collection_proxy_t = CollProxy;
+
+    using key_t = Key; ///< Type of the key of the subsets.
+
+    /// Type of a subset.
+    using subset_t = CollectionProxySubset<collection_proxy_t>;
+
+    /// Type of the elements of this object: the subsets.
+    using value_type = subset_t;
+
+    /// Type of iterator to the subsets.
+    using const_iterator
+      = details::IndexBasedIterator<CollectionProxyPartition>;
+
+    /// Type of iterator to the subsets.
+    using iterator = const_iterator;
+
+    /// Constructor: splits `coll` by the key `keyOf(element)`.
+    template <typename KeyOf>
+    CollectionProxyPartition(collection_proxy_t coll, KeyOf&& keyOf);
+
+    /// Returns the number of subsets.
+    std::size_t size() const { return fKeys.size(); }
+
+    /// Returns whether there are no subsets (the collection is empty).
+    bool empty() const { return fKeys.empty(); }
+
+    /// Returns the keys of all the subsets, in increasing order.
+    std::vector<key_t> const& keys() const { return fKeys; }
+
+    /// Returns the key of the `i`-th subset.
+    key_t const& key(std::size_t i) const { return fKeys[i]; }
+
+    /// Returns the `i`-th subset.
+    subset_t operator[] (std::size_t i) const
+      { return { fColl, makePositions(fOffsets[i], fOffsets[i + 1]) }; }
+
+    /// Returns the subset with the specified key (empty if none).
+    subset_t subset(key_t const& key) const;
+
+    /// Returns the partitioned collection proxy.
+    collection_proxy_t const& collection() const { return fColl; }
+
+    /// Returns an iterator to the first subset.
+    const_iterator begin() const { return { *this, 0U }; }
+
+    /// Returns an iterator past the last subset.
+    const_iterator end() const { return { *this, size() }; }
+
+      private:
+    collection_proxy_t fColl; ///< The partitioned collection proxy.
+
+    std::vector<key_t> fKeys; ///< Keys of all the subsets.
+
+    /// Start of each subset in `fPositions`, plus the end.
+    std::vector<std::size_t> fOffsets { 0U };
+
+    std::vector<std::size_t> fPositions; ///< Positions, subset by subset.
+
+    /// Returns the view of `fPositions` between the specified offsets.
+    typename subset_t::positions_t makePositions
+      (std::size_t begin, std::size_t end) const
+      {
+        return lar::makeCollectionView
+          (fPositions.data() + begin, fPositions.data() + end);
+      }
+
+  }; // class CollectionProxyPartition<>
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Splits a collection proxy into subsets by a key.
+   * @tparam CollProxy type of the collection proxy
+   * @tparam KeyOf type of functor extracting the key
+   * @param coll the collection proxy to be split (moved into the result)
+   * @param keyOf functor returning the key of an element proxy
+   * @return a `proxy::CollectionProxyPartition` object
+   */
+  template <typename CollProxy, typename KeyOf>
+  auto partitionCollection(CollProxy coll, KeyOf&& keyOf)
+    {
+      using key_t = std::decay_t<decltype
+        (keyOf(std::declval<typename CollProxy::element_proxy_t>()))>;
+      return CollectionProxyPartition<CollProxy, key_t>
+        (std::move(coll), std::forward<KeyOf>(keyOf));
+    }
+
+
+  /**
+   * @brief Creates a collection proxy and splits it into subsets by a key.
+   * @tparam CollProxy type of target main collection proxy
+   * @tparam Event type of event to read data from
+   * @tparam KeyOf type of functor extracting the key
+   * @tparam WithArgs type of arguments for the auxiliary data
+   * @param event event to read data from
+   * @param tag input tag of the main data product
+   * @param keyOf functor returning the key of an element proxy
+   * @param withArgs optional arguments for the auxiliary data
+   * @return a `proxy::CollectionProxyPartition` object
+   * @see `proxy::getCollection()`, `proxy::partitionCollection()`
+   *
+   * The auxiliary data is read and indexed once for the whole collection,
+   * as in `proxy::getCollection()`, and it is shared by all the subsets.
+   */
+  template <
+    typename CollProxy, typename Event, typename KeyOf, typename... WithArgs
+    >
+  auto getPartitionedCollection(
+    Event const& event, art::InputTag const& tag, KeyOf&& keyOf,
+    WithArgs&&... withArgs
+    )
+    {
+      return partitionCollection(
+        getCollection<CollProxy>(event, tag, std::forward<WithArgs>(withArgs)...),
+        std::forward<KeyOf>(keyOf)
+        );
+    }
+
+
+  //----------------------------------------------------------------------------
+  /// Partition key: the TPC of elements with a wire ID (like `recob::Hit`).
+  struct ByTPC {
+    template <typename Elem>
+    auto operator() (Elem const& elem) const
+      { return (*elem).WireID().asTPCID(); }
+  }; // struct ByTPC
+
+  /// Partition key: the cryostat of elements with a wire ID.
+  struct ByCryostat {
+    template <typename Elem>
+    auto operator() (Elem const& elem) const
+      { return (*elem).WireID().asCryostatID(); }
+  }; // struct ByCryostat
+
+  /// Splits elements with a wire ID by TPC (see `getPartitionedCollection()`).
+  inline constexpr ByTPC byTPC {};
+
+  /// Splits elements with a wire ID by cryostat.
+  inline constexpr ByCryostat byCryostat {};
+
+  /// @}
+  // --- END Collection proxy partitions ---------------------------------------
+
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename CollProxy, typename Key>
+template <typename KeyOf>
+proxy::CollectionProxyPartition<CollProxy, Key>::CollectionProxyPartition
+  (collection_proxy_t coll, KeyOf&& keyOf)
+  : fColl(std::move(coll))
+{
+  std::size_t const n = fColl.size();
+
+  // the key of each element, and the sorted list of the distinct ones
+  std::vector<key_t> elementKeys;
+  elementKeys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) elementKeys.push_back(keyOf(fColl[i]));
+
+  fKeys = elementKeys;
+  std::sort(fKeys.begin(), fKeys.end());
+  fKeys.erase(std::unique(fKeys.begin(), fKeys.end()), fKeys.end());
+
+  // counting sort of the positions by subset
+  std::vector<std::size_t> subsets(n);
+  fOffsets.assign(fKeys.size() + 1U, 0U);
+  for (std::size_t i = 0; i < n; ++i) {
+    subsets[i] = std::lower_bound(fKeys.cbegin(), fKeys.cend(), elementKeys[i])
+      - fKeys.cbegin();
+    ++fOffsets[subsets[i] + 1];
+  } // for
+  for (std::size_t iSubset = 0; iSubset < fKeys.size(); ++iSubset)
+    fOffsets[iSubset + 1] += fOffsets[iSubset];
+
+  fPositions.resize(n);
+  std::vector<std::size_t> next(fOffsets.begin(), fOffsets.end() - 1);
+  for (std::size_t i = 0; i < n; ++i) fPositions[next[subsets[i]]++] = i;
+
+} // proxy::CollectionProxyPartition<>::CollectionProxyPartition()
+
+
+//------------------------------------------------------------------------------
+template <typename CollProxy, typename Key>
+auto proxy::CollectionProxyPartition<CollProxy, Key>::subset
+  (key_t const& key) const -> subset_t
+{
+  auto const iKey = std::lower_bound(fKeys.cbegin(), fKeys.cend(), key);
+  if ((iKey == fKeys.cend()) || !(*iKey == key))
+    return { fColl, makePositions(0U, 0U) };
+  return operator[](iKey - fKeys.cbegin());
+} // proxy::CollectionProxyPartition<>::subset()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_RECOBASEPROXY_PROXYBASE_COLLECTIONPROXYPARTITION_H
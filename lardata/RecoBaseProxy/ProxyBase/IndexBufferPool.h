@@ -0,0 +1,256 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyBase/IndexBufferPool.h
+ * @brief  Recycling of the index buffers of collection proxies across events.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyBase.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PROXYBASE_INDEXBUFFERPOOL_H
+#define LARDATA_RECOBASEPROXY_PROXYBASE_INDEXBUFFERPOOL_H
+
+// C/C++ standard
+#include <map>
+#include <memory> // std::shared_ptr<>, std::weak_ptr<>, std::unique_ptr<>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+#include <utility> // std::move()
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Pool of buffers recycled by the indices of collection proxies.
+   * @ingroup LArSoftProxyBase
+   *
+   * Each collection proxy merging associated data (`proxy::withAssociated()`)
+   * builds an index of the association, which takes memory allocations
+   * proportional to the size of the association. In a loop over many events,
+   * the same allocations are repeated in every event.
+   * When a pool is in use, the indices take their buffers from the pool, and
+   * the buffers are returned to it (with their capacity) when the last copy of
+   * the proxy using them is destroyed, ready for the proxies of the next event:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * proxy::IndexBufferPool pool;
+   *
+   * for (gallery::Event event(fileNames); !event.atEnd(); event.next()) {
+   *
+   *   proxy::IndexBufferPool::Use const usePool(pool);
+   *
+   *   auto tracks = proxy::getCollection<proxy::Tracks>
+   *     (event, tracksTag, proxy::withAssociated<recob::SpacePoint>());
+   *
+   *   // ...
+   *
+   * } // for
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * After the first few events the pool holds enough buffers, large enough for
+   * the typical event, and the creation of the proxies stops allocating memory
+   * for the indices.
+   *
+   * The pool is used by the proxies created in the same thread while a
+   * `IndexBufferPool::Use` object is alive; without it, each index allocates
+   * its own memory as usual.
+   * Buffers can be returned to the pool from any thread, and proxies may
+   * outlive the pool (their buffers are then simply freed).
+   *
+   * @note The proxies refer to the data of the event they were created from:
+   *       with _gallery_ only the current event is available, and proxies
+   *       must not be used after moving to another event. For that reason the
+   *       pool does not keep proxies of different events together, but it
+   *       makes their creation in consecutive events cheaper.
+   */
+  class IndexBufferPool {
+
+    struct Storage; // forward declaration
+
+      public:
+
+    /// Object enabling the use of a pool in the current thread while alive.
+    class Use {
+        public:
+      /// Enables `pool` for the proxies created in this thread.
+      explicit Use(IndexBufferPool& pool)
+        : fPrevious(current()) { current() = &pool; }
+
+      /// Restores the pool in use before this object was created (if any).
+      ~Use() { current() = fPrevious; }
+
+      Use(Use const&) = delete;
+      Use& operator= (Use const&) = delete;
+
+        private:
+      IndexBufferPool* fPrevious; ///< Pool in use before this one.
+    }; // class Use
+
+
+    /// Constructor: starts with an empty pool.
+    IndexBufferPool(): fStorage(std::make_shared<Storage>()) {}
+
+    IndexBufferPool(IndexBufferPool const&) = delete;
+    IndexBufferPool& operator= (IndexBufferPool const&) = delete;
+
+    /**
+     * @brief Returns an empty buffer, which goes back to the pool when released.
+     * @tparam T type of the elements in the buffer
+     * @return a shared pointer to an empty vector
+     *
+     * The returned vector may have capacity from a previous use.
+     */
+    template <typename T>
+    std::shared_ptr<std::vector<T>> acquire();
+
+    /// Returns the number of buffers available in the pool.
+    std::size_t nAvailable() const;
+
+    /// Returns how many buffers were served by recycling.
+    std::size_t nRecycled() const;
+
+    /// Returns how many buffers were newly allocated.
+    std::size_t nAllocated() const;
+
+    /// Frees all the buffers available in the pool.
+    void clear();
+
+
+    /// Returns the pool in use in this thread (`nullptr` if none).
+    static IndexBufferPool* inUse() { return current(); }
+
+
+      private:
+
+    /// Buffers of a single element type.
+    struct BuffersBase { virtual ~BuffersBase() = default; };
+
+    template <typename T>
+    struct Buffers: BuffersBase {
+      std::vector<std::unique_ptr<std::vector<T>>> free; ///< Available buffers.
+    }; // struct Buffers<>
+
+    /// Data of the pool, shared with the buffers that are in use.
+    struct Storage {
+      mutable std::mutex mutex; ///< Lock for all the data of the pool.
+
+      /// Buffers available, by element type.
+      std::map<std::type_index, std::unique_ptr<BuffersBase>> buffers;
+
+      std::size_t nAvailable = 0U; ///< Number of buffers available.
+      std::size_t nRecycled = 0U; ///< Number of buffers served from the pool.
+      std::size_t nAllocated = 0U; ///< Number of buffers created.
+
+      /// Returns the buffers with elements of type `T`, creating them if needed.
+      template <typename T>
+      Buffers<T>& buffersOf();
+    }; // struct Storage
+
+    std::shared_ptr<Storage> fStorage; ///< Data of the pool.
+
+    /// Pool in use in this thread.
+    static IndexBufferPool*& current()
+      { thread_local IndexBufferPool* pool = nullptr; return pool; }
+
+  }; // class IndexBufferPool
+
+
+  namespace details {
+
+    /**
+     * @brief Returns an empty buffer, from the pool in use if any.
+     * @tparam T type of the elements in the buffer
+     * @see `proxy::IndexBufferPool`
+     */
+    template <typename T>
+    std::shared_ptr<std::vector<T>> acquireIndexBuffer() {
+      IndexBufferPool* pool = IndexBufferPool::inUse();
+      return pool? pool->acquire<T>(): std::make_shared<std::vector<T>>();
+    } // acquireIndexBuffer()
+
+  } // namespace details
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename T>
+auto proxy::IndexBufferPool::Storage::buffersOf() -> Buffers<T>& {
+  std::unique_ptr<BuffersBase>& buffers = this->buffers[typeid(T)];
+  if (!buffers) buffers = std::make_unique<Buffers<T>>();
+  return static_cast<Buffers<T>&>(*buffers);
+} // proxy::IndexBufferPool::Storage::buffersOf()
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+std::shared_ptr<std::vector<T>> proxy::IndexBufferPool::acquire() {
+
+  std::unique_ptr<std::vector<T>> buffer;
+  {
+    std::lock_guard<std::mutex> lock(fStorage->mutex);
+    auto& available = fStorage->buffersOf<T>().free;
+    if (available.empty()) {
+      ++(fStorage->nAllocated);
+    }
+    else {
+      buffer = std::move(available.back());
+      available.pop_back();
+      --(fStorage->nAvailable);
+      ++(fStorage->nRecycled);
+    }
+  }
+  if (!buffer) buffer = std::make_unique<std::vector<T>>();
+
+  // the buffer is returned to the pool only if the pool still exists
+  std::weak_ptr<Storage> pool = fStorage;
+  auto release = [pool](std::vector<T>* buffer) {
+    std::unique_ptr<std::vector<T>> owned(buffer);
+    std::shared_ptr<Storage> storage = pool.lock();
+    if (!storage) return;
+    owned->clear();
+    std::lock_guard<std::mutex> lock(storage->mutex);
+    storage->buffersOf<T>().free.push_back(std::move(owned));
+    ++(storage->nAvailable);
+  };
+  return std::shared_ptr<std::vector<T>>(buffer.release(), std::move(release));
+
+} // proxy::IndexBufferPool::acquire()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t proxy::IndexBufferPool::nAvailable() const {
+  std::lock_guard<std::mutex> lock(fStorage->mutex);
+  return fStorage->nAvailable;
+} // proxy::IndexBufferPool::nAvailable()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t proxy::IndexBufferPool::nRecycled() const {
+  std::lock_guard<std::mutex> lock(fStorage->mutex);
+  return fStorage->nRecycled;
+} // proxy::IndexBufferPool::nRecycled()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t proxy::IndexBufferPool::nAllocated() const {
+  std::lock_guard<std::mutex> lock(fStorage->mutex);
+  return fStorage->nAllocated;
+} // proxy::IndexBufferPool::nAllocated()
+
+
+//------------------------------------------------------------------------------
+inline void proxy::IndexBufferPool::clear() {
+  std::lock_guard<std::mutex> lock(fStorage->mutex);
+  fStorage->buffers.clear();
+  fStorage->nAvailable = 0U;
+} // proxy::IndexBufferPool::clear()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_RECOBASEPROXY_PROXYBASE_INDEXBUFFERPOOL_H
@@ -0,0 +1,335 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyBase/LazyAuxData.h
+ * @brief  Auxiliary data of a collection proxy, created on first access.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyBase.h
+ *         lardata/RecoBaseProxy/ProxyBase/withLazy.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PROXYBASE_LAZYAUXDATA_H
+#define LARDATA_RECOBASEPROXY_PROXYBASE_LAZYAUXDATA_H
+
+// LArSoft libraries
+#include "lardata/Utilities/TupleLookupByTag.h" // util::type_with_tag_t, ...
+#include "larcorealg/CoreUtils/DebugUtils.h" // lar::debug::demangle()
+
+// C/C++ standard
+#include <functional> // std::function<>
+#include <memory> // std::shared_ptr<>
+#include <optional>
+#include <mutex> // std::call_once(), std::once_flag
+#include <atomic>
+#include <string>
+#include <vector>
+#include <tuple> // std::tuple_size_v, std::tuple_element_t<>
+#include <utility> // std::move(), std::index_sequence<>
+#include <type_traits> // std::is_same<>
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  // --- BEGIN LArSoftProxiesLazyData ------------------------------------------
+  /**
+   * @defgroup LArSoftProxiesLazyData Lazy auxiliary data infrastructure
+   * @ingroup  LArSoftProxyCustom
+   * @brief Infrastructure for auxiliary data created on first access.
+   *
+   * Auxiliary data requested via `withLazy()` is not read nor indexed when
+   * the collection proxy is created, but only the first time any of its
+   * elements is used. The data is then created only once, and shared by all
+   * the elements of the proxy (also when they are used from different
+   * threads).
+   *
+   * Whether the data was eventually used can be queried with
+   * `proxy::isAuxDataLoaded()`, and the list of the tags of all the auxiliary
+   * data that has been created so far with `proxy::loadedAuxDataTags()`.
+   *
+   * @{
+   */
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Returns whether the auxiliary data with the specified tag is loaded.
+   * @tparam Tag tag of the auxiliary data to be checked
+   * @tparam CollProxy type of collection proxy
+   * @param proxy the collection proxy
+   * @return whether the auxiliary data labelled `Tag` has been created
+   *
+   * Auxiliary data not requested as lazy is always created with the proxy,
+   * and it is reported as loaded.
+   */
+  template <typename Tag, typename CollProxy>
+  bool isAuxDataLoaded(CollProxy const& proxy);
+
+
+  /**
+   * @brief Returns the tags of all auxiliary data that has been loaded.
+   * @tparam CollProxy type of collection proxy
+   * @param proxy the collection proxy
+   * @return the names of the tags of all the loaded auxiliary data
+   * @see isAuxDataLoaded()
+   *
+   * The tags are returned in the same order as they were requested in
+   * `getCollection()`. Auxiliary data not requested as lazy is always
+   * included.
+   * This is meant for reporting which of the requested data products were
+   * actually used, e.g.:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto tracks = proxy::getCollection<proxy::Tracks>(event, trackTag,
+   *   proxy::withLazy(proxy::withAssociated<recob::Cluster>(clusterTag))
+   *   );
+   * // ...
+   * for (std::string const& tagName: proxy::loadedAuxDataTags(tracks))
+   *   mf::LogVerbatim("MyAnalysis") << "Used: " << tagName;
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename CollProxy>
+  std::vector<std::string> loadedAuxDataTags(CollProxy const& proxy);
+
+
+  //----------------------------------------------------------------------------
+  namespace details {
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Auxiliary data created on first request, and the way to create it.
+     * @tparam AuxColl type of the auxiliary data being wrapped
+     *
+     * The creation is thread-safe, and happens only once.
+     * This object is shared by a `LazyAuxData` and all its elements.
+     */
+    template <typename AuxColl>
+    class LazyAuxDataState {
+
+        public:
+      /// Type of function creating the auxiliary data.
+      using maker_t = std::function<AuxColl()>;
+
+      /// Constructor: data will be created by the specified function.
+      LazyAuxDataState(maker_t&& maker): fMaker(std::move(maker)) {}
+
+      /// Returns the auxiliary data, creating it if needed.
+      AuxColl const& load() const;
+
+      /// Returns whether the auxiliary data has already been created.
+      bool isLoaded() const { return fLoaded.load(); }
+
+        private:
+      mutable maker_t fMaker; ///< Function creating the data.
+      mutable std::once_flag fCreated; ///< Flag for the creation of the data.
+      mutable std::optional<AuxColl> fData; ///< The data, once created.
+      mutable std::atomic<bool> fLoaded { false }; ///< Whether data exists.
+
+    }; // class LazyAuxDataState<>
+
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Element of lazy auxiliary data, as stored in proxy elements.
+     * @tparam AuxColl type of the auxiliary data being wrapped
+     *
+     * This object refers to the element of a `LazyAuxData` with a given index.
+     * The auxiliary data is created only when `get()` is called.
+     * Like the other proxy elements, this one stays valid after the collection
+     * proxy it comes from is destroyed.
+     *
+     * `proxy::CollectionProxyElement::get()` takes care of calling `get()`,
+     * so that the lazy auxiliary data of an element looks the same as
+     * auxiliary data created together with the proxy.
+     */
+    template <typename AuxColl>
+    class LazyAuxElement {
+
+        public:
+      /// Type of the wrapped auxiliary data.
+      using aux_collection_t = AuxColl;
+
+      using tag = typename aux_collection_t::tag; ///< Tag of this element.
+
+      /// Type of the shared data.
+      using state_t = LazyAuxDataState<aux_collection_t>;
+
+      /// Constructor: element `index` of the specified lazy data.
+      LazyAuxElement(std::shared_ptr<state_t const> state, std::size_t index)
+        : fState(std::move(state)), fIndex(index) {}
+
+      /// Returns the auxiliary data element, creating all data if needed.
+      auto get() const -> decltype(auto) { return fState->load()[fIndex]; }
+
+      /// Returns whether the auxiliary data has already been created.
+      bool isLoaded() const { return fState->isLoaded(); }
+
+        private:
+      std::shared_ptr<state_t const> fState; ///< The whole lazy data.
+      std::size_t fIndex; ///< Index of the element in the data.
+
+    }; // class LazyAuxElement<>
+
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Wrapper around auxiliary data which is created on first access.
+     * @tparam AuxColl type of the auxiliary data being wrapped
+     *
+     * This object holds a function creating auxiliary data of type `AuxColl`
+     * (e.g. `proxy::details::AssociatedData`), and calls it only the first
+     * time the data is needed, i.e. when `load()` is called either directly
+     * or via any of the other data access methods.
+     * The creation is thread-safe, and happens only once.
+     *
+     * The state of the data is shared among copies of this object and its
+     * elements, and it is kept when this object is moved.
+     *
+     * This object is an auxiliary data collection with the same tag as
+     * `AuxColl`. Its elements are `LazyAuxElement` objects, which create the
+     * data only when their content is accessed.
+     */
+    template <typename AuxColl>
+    class LazyAuxData {
+
+        public:
+      /// Type of the wrapped auxiliary data.
+      using aux_collection_t = AuxColl;
+
+      using tag = typename aux_collection_t::tag; ///< Tag of this data.
+
+      /// Type of the element of this data ("lazy" too).
+      using auxiliary_data_t = LazyAuxElement<aux_collection_t>;
+
+      /// Type of the shared data.
+      using state_t = LazyAuxDataState<aux_collection_t>;
+
+      /// Type of function creating the auxiliary data.
+      using maker_t = typename state_t::maker_t;
+
+      /// Constructor: data will be created by the specified function.
+      LazyAuxData(maker_t maker)
+        : fState(std::make_shared<state_t>(std::move(maker)))
+        {}
+
+      /// Returns the wrapped auxiliary data, creating it if needed.
+      aux_collection_t const& load() const { return fState->load(); }
+
+      /// Returns whether the auxiliary data has already been created.
+      bool isLoaded() const { return fState->isLoaded(); }
+
+      /// Returns a lazy element of the data (data is not created yet).
+      auxiliary_data_t operator[] (std::size_t index) const
+        { return { fState, index }; }
+
+      /// Returns an iterator to the first data element (data is created).
+      auto begin() const -> decltype(auto) { return load().begin(); }
+
+      /// Returns an iterator past the last data element (data is created).
+      auto end() const -> decltype(auto) { return load().end(); }
+
+      /// Returns the number of elements of the data (data is created).
+      auto size() const -> decltype(auto) { return load().size(); }
+
+      /// Returns whether this data is labeled with the specified tag.
+      template <typename TestTag>
+      static constexpr bool hasTag() { return std::is_same<TestTag, tag>(); }
+
+        private:
+      std::shared_ptr<state_t const> fState; ///< Shared state of the data.
+
+    }; // class LazyAuxData<>
+
+
+    //--------------------------------------------------------------------------
+    /// Returns the content of a lazy element (its data is created if needed).
+    template <typename AuxColl>
+    auto resolveAuxElement(LazyAuxElement<AuxColl> const& elem)
+      -> decltype(auto)
+      { return elem.get(); }
+
+
+    //--------------------------------------------------------------------------
+    /// Whether the auxiliary data is loaded (always true for non-lazy data).
+    template <typename AuxColl>
+    bool isAuxCollLoaded(AuxColl const&) { return true; }
+
+    template <typename AuxColl>
+    bool isAuxCollLoaded(LazyAuxData<AuxColl> const& data)
+      { return data.isLoaded(); }
+
+
+    //--------------------------------------------------------------------------
+
+  } // namespace details
+
+
+  /// @}
+  // --- END LArSoftProxiesLazyData --------------------------------------------
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+namespace proxy {
+
+  namespace details {
+
+    //--------------------------------------------------------------------------
+    template <typename AuxColl>
+    AuxColl const& LazyAuxDataState<AuxColl>::load() const {
+      std::call_once(fCreated, [this](){
+        fData.emplace(fMaker());
+        fMaker = nullptr; // release whatever the maker was holding
+        fLoaded = true;
+      });
+      return *fData;
+    } // LazyAuxDataState<>::load()
+
+
+    //--------------------------------------------------------------------------
+    template <typename CollProxy, std::size_t... I>
+    std::vector<std::string> loadedAuxDataTagsImpl
+      (CollProxy const& proxy, std::index_sequence<I...>)
+    {
+      using aux_collections_t = typename CollProxy::aux_collections_t;
+      std::vector<std::string> tags;
+      (
+        (isAuxDataLoaded
+          <typename std::tuple_element_t<I, aux_collections_t>::tag>(proxy)
+          ? tags.push_back(lar::debug::demangle
+            <typename std::tuple_element_t<I, aux_collections_t>::tag>())
+          : void()
+        ), ...
+      );
+      return tags;
+    } // loadedAuxDataTagsImpl()
+
+
+    //--------------------------------------------------------------------------
+
+  } // namespace details
+
+
+  //----------------------------------------------------------------------------
+  template <typename Tag, typename CollProxy>
+  bool isAuxDataLoaded(CollProxy const& proxy)
+    { return details::isAuxCollLoaded(proxy.template get<Tag>()); }
+
+
+  //----------------------------------------------------------------------------
+  template <typename CollProxy>
+  std::vector<std::string> loadedAuxDataTags(CollProxy const& proxy) {
+    using aux_collections_t = typename CollProxy::aux_collections_t;
+    return details::loadedAuxDataTagsImpl(proxy,
+      std::make_index_sequence<std::tuple_size_v<aux_collections_t>>()
+      );
+  } // loadedAuxDataTags()
+
+
+  //----------------------------------------------------------------------------
+
+} // namespace proxy
+
+
+#endif // LARDATA_RECOBASEPROXY_PROXYBASE_LAZYAUXDATA_H
@@ -21,6 +21,8 @@
 
 // C/C++ standard
 #include <vector>
+#include <algorithm> // std::lower_bound(), std::stable_sort(), std::max()
+#include <numeric> // std::iota()
 #include <tuple> // std::tuple_element_t<>, std::get()
 #include <iterator> // std::cbegin(), std::cend()
 #include <utility> // std::move()
@@ -60,6 +62,13 @@ namespace proxy {
      * information, where each element in the container is associated to a
      * single `Main` and it is an _art_ pointer to the `Right` element.
      *
+     * When only a small fraction of the main elements is associated (see
+     * `preferSparse()`), `makeOneTo01data()` creates this object with a
+     * sparse storage instead: only the pointers of the associated elements
+     * are stored, together with the sorted list of the keys of their main
+     * elements. Access is then logarithmic in the number of associated
+     * elements, and the interface is unchanged.
+     *
      * Association metadata is not accessible from this object.
      *
      * @todo Metadata for `proxy::details::OneTo01Data` is not supported yet.
@@ -96,16 +105,54 @@ namespace proxy {
       /// Type of the source association.
       using assns_t = art::Assns<main_t, aux_t>;
 
+      /// Type of the list of keys of the associated main elements.
+      using keys_t = std::vector<std::size_t>;
+
+      /// Maximum fraction of associated main elements for sparse storage.
+      static constexpr double SparseMaxFillRatio = 0.25;
+
+
+      /// Constructor: dense storage, with one pointer per main element.
+      OneTo01Data(aux_coll_t&& data)
+        : auxData(std::move(data)), nMain(auxData.size()), sparse(false)
+        {}
+
+      /**
+       * @brief Constructor: sparse storage.
+       * @param size number of main elements
+       * @param keys sorted keys of the main elements with associated data
+       * @param data pointers to the associated data, in the order of `keys`
+       */
+      OneTo01Data(std::size_t size, keys_t&& keys, aux_coll_t&& data)
+        : auxData(std::move(data)), auxKeys(std::move(keys))
+        , nMain(size), sparse(true)
+        {}
 
-      OneTo01Data(aux_coll_t&& data): auxData(std::move(data)) {}
+      /// Returns the number of main elements covered by this data.
+      std::size_t size() const { return nMain; }
+
+      /// Returns whether the storage is sparse.
+      bool isSparse() const { return sparse; }
 
       /// Returns whether the element `i` is associated with auxiliary datum.
       bool has(std::size_t i) const
-        { return get(i) == aux_ptr_t(); }
+        { return get(i) != aux_ptr_t(); }
 
       /// Returns a copy of the pointer to data associated with element `i`.
       auxiliary_data_t get(std::size_t i) const
-        { return auxiliary_data_t(auxData[i]); }
+        {
+          if (!sparse) return auxiliary_data_t(auxData[i]);
+          auto const it = std::lower_bound(auxKeys.begin(), auxKeys.end(), i);
+          return ((it == auxKeys.end()) || (*it != i))
+            ? auxiliary_data_t(aux_ptr_t())
+            : auxiliary_data_t(auxData[it - auxKeys.begin()]);
+        }
+
+      /// Returns whether sparse storage is preferable for `nAssociated`
+      /// associated elements out of `size`.
+      static constexpr bool preferSparse
+        (std::size_t nAssociated, std::size_t size)
+        { return nAssociated < SparseMaxFillRatio * size; }
 
 
       /// Returns the range with the specified index (no check performed).
@@ -120,6 +167,9 @@ namespace proxy {
 
         private:
       aux_coll_t auxData; ///< Data associated to the main collection.
+      keys_t auxKeys; ///< Keys of the main elements in `auxData` (if sparse).
+      std::size_t nMain; ///< Number of main elements.
+      bool sparse; ///< Whether only associated elements are stored.
 
     }; // class OneTo01Data<>
 
@@ -260,6 +310,64 @@ namespace proxy {
       return data;
     } // associationOneToOneFullSequence(Iter, Iter, std::size_t)
 
+
+    //--------------------------------------------------------------------------
+    // Creates a OneTo01Data, with sparse storage if few elements are associated
+    template <typename Data, std::size_t Key, std::size_t Aux, typename Iter>
+    Data makeOneTo01storage(Iter begin, Iter end, std::size_t n) {
+
+      // first pass: how many associations, and how many main elements
+      std::size_t nAssns = 0U;
+      std::size_t size = n;
+      for (auto it = begin; it != end; ++it) {
+        ++nAssns;
+        size = std::max(size, std::get<Key>(*it).key() + 1);
+      }
+
+      if (!Data::preferSparse(nAssns, size)) {
+        return Data
+          (associationOneToOneFullSequence<Key, Aux>(begin, end, n));
+      }
+
+      typename Data::keys_t keys;
+      typename Data::aux_coll_t data;
+      keys.reserve(nAssns);
+      data.reserve(nAssns);
+      bool sorted = true;
+      for (auto it = begin; it != end; ++it) {
+        std::size_t const key = std::get<Key>(*it).key();
+        if (!keys.empty() && (key <= keys.back())) sorted = false;
+        keys.push_back(key);
+        data.push_back(std::get<Aux>(*it));
+      } // for
+
+      if (!sorted) {
+        // sort by key; like in the dense storage, the last association of
+        // a main element wins
+        std::vector<std::size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0U);
+        std::stable_sort(order.begin(), order.end(),
+          [&keys](std::size_t a, std::size_t b){ return keys[a] < keys[b]; }
+          );
+        typename Data::keys_t sortedKeys;
+        typename Data::aux_coll_t sortedData;
+        sortedKeys.reserve(keys.size());
+        sortedData.reserve(keys.size());
+        for (std::size_t i: order) {
+          if (!sortedKeys.empty() && (sortedKeys.back() == keys[i]))
+            sortedData.back() = data[i];
+          else {
+            sortedKeys.push_back(keys[i]);
+            sortedData.push_back(data[i]);
+          }
+        } // for
+        keys = std::move(sortedKeys);
+        data = std::move(sortedData);
+      } // if not sorted
+
+      return Data(size, std::move(keys), std::move(data));
+    } // makeOneTo01storage()
+
   } // namespace details
 
 
@@ -277,10 +385,8 @@ namespace proxy {
 
     using std::cbegin;
     using std::cend;
-    return AssociatedData_t(
-      details::associationOneToOneFullSequence<0U, 1U>
-        (cbegin(assns), cend(assns), minSize)
-      );
+    return details::makeOneTo01storage<AssociatedData_t, 0U, 1U>
+      (cbegin(assns), cend(assns), minSize);
   } // makeOneTo01data(assns)
 
   //----------------------------------------------------------------------------
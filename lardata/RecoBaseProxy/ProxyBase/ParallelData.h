@@ -16,8 +16,12 @@
 #include "larcorealg/CoreUtils/ContainerMeta.h" // util::collection_value_t, ...
 
 // C/C++ standard
+#include <tuple>
+#include <iterator> // std::random_access_iterator_tag
 #include <utility> // std::declval()
 #include <type_traits> // std::is_convertible<>, ...
+#include <cassert>
+#include <cstddef> // std::ptrdiff_t
 #include <cstdlib> // std::size_t
 
 
@@ -59,9 +63,49 @@ namespace proxy {
   auto makeParallelData(AuxColl const& data);
 
 
+  /**
+   * @brief Joins parallel data into a single view of their elements.
+   * @tparam ParallelDatas types of the parallel data objects
+   * @param data the parallel data objects to be joined
+   * @return a `details::ParallelDataZip` of all the `data`
+   *
+   * Parallel data products share the index of the main collection: this
+   * function presents them as a structure of arrays, whose element `i` is a
+   * tuple with the references to the element `i` of each of the data.
+   * The elements are accessed with `ParallelData::element()`, i.e. without any
+   * tag wrapping and with only debug-mode checks, and are meant for tight
+   * loops on all the data at once:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const fits = proxy::zipParallelData(
+   *   proxy::makeParallelData(momenta),
+   *   proxy::makeParallelData(fitInfo)
+   *   );
+   * for (auto const& [ momentum, info ]: fits) {
+   *   // ...
+   * }
+   * double const p0 = fits.get<recob::TrackMomentum>(0).p;
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * All the data must have the same size (checked only in debug mode), and
+   * the zip refers to the data collections, not to the `data` objects.
+   */
+  template <typename... ParallelDatas>
+  auto zipParallelData(ParallelDatas const&... data);
+
+
   //----------------------------------------------------------------------------
   namespace details {
 
+    /// Trait: whether `Coll` stores its elements contiguously (has `data()`).
+    template <typename Coll, typename = void>
+    struct has_contiguous_data: std::false_type {};
+
+    template <typename Coll>
+    struct has_contiguous_data
+      <Coll, std::void_t<decltype(std::declval<Coll const&>().data())>>
+      : std::is_pointer<decltype(std::declval<Coll const&>().data())>
+    {};
+
+
     /**
      * @brief Object to draft parallel data interface.
      * @tparam AuxColl type of the parallel data collection
@@ -72,6 +116,12 @@ namespace proxy {
      *  * random access (no index check guarantee)
      *  * forward iteration
      *
+     * Random access is offered both with tagged elements (`operator[]`) and
+     * with plain ones (`element()`); the latter goes straight through the
+     * contiguous storage of the collection when it has one (`data()`), and
+     * it is the one to be used in tight loops. None of them checks the index
+     * unless `NDEBUG` is undefined.
+     *
      * Construction is not part of the interface.
      */
     template <
@@ -93,6 +143,9 @@ namespace proxy {
 
       using parallel_data_iterator_t = typename parallel_data_t::const_iterator;
 
+      /// Whether the elements of the collection are stored contiguously.
+      static constexpr bool isContiguous = has_contiguous_data<AuxColl>();
+
         public:
       using tag = Tag; ///< Tag of this association proxy.
 
@@ -123,6 +176,51 @@ namespace proxy {
           return getElement(index);
         }
 
+      /// Returns the number of data elements.
+      std::size_t size() const { return fData->size(); }
+
+      /**
+       * @brief Returns the element with the specified index, not tagged.
+       * @param index the index of the element
+       * @return a constant reference to the element
+       *
+       * The index is checked only in debug mode (`NDEBUG` undefined).
+       */
+      auto element(std::size_t index) const -> decltype(auto)
+        {
+          assert(index < size());
+          if constexpr (isContiguous) return *(fData->data() + index);
+          else return fData->operator[](index);
+        }
+
+      /**
+       * @brief Returns a pointer to the contiguous elements of the data.
+       *
+       * This is available only if the data collection has a `data()` method
+       * returning a pointer to its storage (like `std::vector`).
+       */
+      auto elements() const
+        {
+          static_assert(isContiguous, "Parallel data is not contiguous.");
+          return fData->data();
+        }
+
+      /**
+       * @brief Hints the processor to load the element with `index` in cache.
+       *
+       * This is meant to be called a few elements ahead in loops where the
+       * access pattern is not regular (e.g. via an index list). It does
+       * nothing if the data is not contiguous, or if the compiler does not
+       * support prefetching. The index is not checked, even in debug mode.
+       */
+      void prefetch([[maybe_unused]] std::size_t index) const
+        {
+#if defined(__GNUC__)
+          if constexpr (isContiguous)
+            __builtin_prefetch(fData->data() + index, 0 /* read */);
+#endif // __GNUC__
+        }
+
       /// Returns whether this data is labeled with the specified tag.
       template <typename TestTag>
       static constexpr bool hasTag() { return std::is_same<TestTag, tag>(); }
@@ -138,11 +236,134 @@ namespace proxy {
       parallel_data_t const* fData; ///< Reference to the original data product.
 
       auto getElement(std::size_t index) const -> decltype(auto)
-        { return util::makeTagged<tag>(fData->operator[](index)); }
+        { return util::makeTagged<tag>(element(index)); }
 
     }; // class ParallelData<>
 
 
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Structure-of-arrays view of several parallel data.
+     * @tparam ParallelDatas types of the joined parallel data
+     * @see `proxy::zipParallelData()`
+     *
+     * Element `i` of the view is a `std::tuple` of constant references to the
+     * element `i` of each of the parallel data, in the order they were joined.
+     * An element of a specific data can also be accessed by its tag.
+     * The view supports random access and random access iteration; indices are
+     * checked only in debug mode.
+     *
+     * Construction is not part of the interface.
+     */
+    template <typename... ParallelDatas>
+    class ParallelDataZip {
+      static_assert(sizeof...(ParallelDatas) > 0U,
+        "At least one parallel data is required.");
+
+      /// Type of the tags of all the data.
+      using tags_t = std::tuple<typename ParallelDatas::tag...>;
+
+        public:
+      /// Type of the element of the view.
+      using value_type
+        = std::tuple<decltype(std::declval<ParallelDatas const&>().element(0U))...>;
+
+      /// Random access iterator through the view.
+      class const_iterator {
+          public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ParallelDataZip::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        const_iterator() = default;
+        const_iterator(ParallelDataZip const& zip, std::size_t index)
+          : fZip(&zip), fIndex(index) {}
+
+        reference operator*() const { return (*fZip)[fIndex]; }
+        reference operator[] (difference_type n) const
+          { return (*fZip)[fIndex + n]; }
+
+        const_iterator& operator++() { ++fIndex; return *this; }
+        const_iterator operator++(int) { auto old = *this; ++fIndex; return old; }
+        const_iterator& operator--() { --fIndex; return *this; }
+        const_iterator operator--(int) { auto old = *this; --fIndex; return old; }
+        const_iterator& operator+= (difference_type n)
+          { fIndex += n; return *this; }
+        const_iterator& operator-= (difference_type n)
+          { fIndex -= n; return *this; }
+        const_iterator operator+ (difference_type n) const
+          { return { *fZip, fIndex + n }; }
+        const_iterator operator- (difference_type n) const
+          { return { *fZip, fIndex - n }; }
+        difference_type operator- (const_iterator const& other) const
+          { return difference_type(fIndex) - difference_type(other.fIndex); }
+
+        bool operator== (const_iterator const& other) const
+          { return fIndex == other.fIndex; }
+        bool operator!= (const_iterator const& other) const
+          { return fIndex != other.fIndex; }
+        bool operator< (const_iterator const& other) const
+          { return fIndex < other.fIndex; }
+        bool operator> (const_iterator const& other) const
+          { return fIndex > other.fIndex; }
+        bool operator<= (const_iterator const& other) const
+          { return fIndex <= other.fIndex; }
+        bool operator>= (const_iterator const& other) const
+          { return fIndex >= other.fIndex; }
+
+          private:
+        ParallelDataZip const* fZip = nullptr; ///< The view being iterated.
+        std::size_t fIndex = 0U; ///< Index of the current element.
+
+      }; // class const_iterator
+
+      /// Constructor: joins the specified data (which must have the same size).
+      ParallelDataZip(ParallelDatas const&... data)
+        : fData(data...)
+        , fSize(std::get<0U>(fData).size())
+        { assert(((data.size() == fSize) && ...)); }
+
+      /// Returns the number of elements in the view.
+      std::size_t size() const { return fSize; }
+
+      /// Returns whether the view has no element.
+      bool empty() const { return fSize == 0U; }
+
+      /// Returns the element with the specified index (no check performed).
+      value_type operator[] (std::size_t index) const
+        {
+          assert(index < fSize);
+          return std::apply(
+            [index](auto const&... data){ return value_type(data.element(index)...); },
+            fData
+            );
+        }
+
+      /// Returns the element of the data with the specified tag.
+      template <typename Tag>
+      auto get(std::size_t index) const -> decltype(auto)
+        { return data<Tag>().element(index); }
+
+      /// Returns the parallel data with the specified tag.
+      template <typename Tag>
+      auto data() const -> decltype(auto)
+        { return std::get<util::index_of_type_v<Tag, tags_t>>(fData); }
+
+      /// Returns an iterator to the first element of the view.
+      const_iterator begin() const { return { *this, 0U }; }
+
+      /// Returns an iterator past the last element of the view.
+      const_iterator end() const { return { *this, fSize }; }
+
+        private:
+      std::tuple<ParallelDatas...> fData; ///< The joined parallel data.
+      std::size_t fSize; ///< Number of elements (common to all data).
+
+    }; // class ParallelDataZip<>
+
+
     //--------------------------------------------------------------------------
 
   } // namespace details
@@ -175,6 +396,12 @@ namespace proxy {
   } // makeParallelData(AuxColl)
 
 
+  //----------------------------------------------------------------------------
+  template <typename... ParallelDatas>
+  auto zipParallelData(ParallelDatas const&... data)
+    { return details::ParallelDataZip<ParallelDatas...>(data...); }
+
+
   //----------------------------------------------------------------------------
 
 } // namespace proxy
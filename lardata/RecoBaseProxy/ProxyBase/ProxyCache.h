@@ -0,0 +1,249 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyBase/ProxyCache.h
+ * @brief  Cache of collection proxies shared within an event.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyBase.h
+ *         lardata/RecoBaseProxy/ProxyCacheService.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PROXYBASE_PROXYCACHE_H
+#define LARDATA_RECOBASEPROXY_PROXYBASE_PROXYCACHE_H
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/getCollection.h"
+
+// framework libraries
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard
+#include <map>
+#include <memory> // std::shared_ptr<>, std::make_shared()
+#include <mutex> // std::mutex, std::call_once(), ...
+#include <atomic>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <utility> // std::forward(), std::move()
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Cache of collection proxies, shared by all their users in an event.
+   * @ingroup LArSoftProxyBase
+   *
+   * Creating a collection proxy may be expensive, mostly because of the
+   * indexing of the associations. When the same proxy is requested by
+   * different algorithms or modules for the same event, this cache allows the
+   * work to be done only once:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * proxy::ProxyCache& cache
+   *   = art::ServiceHandle<proxy::ProxyCacheService>()->cache();
+   *
+   * auto tracks = cache.getCollection<proxy::Tracks>
+   *   (event, tracksTag, proxy::withParallelData<recob::TrackMomentum>());
+   *
+   * for (auto const& track: *tracks) {
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The arguments are the same as for `proxy::getCollection()`, but the
+   * returned object is a shared pointer to a constant collection proxy.
+   * A second call with the same proxy type and the same input tags in the
+   * same event returns the proxy created by the first call.
+   *
+   * Cached proxies are identified by the event ID, the type of the collection
+   * proxy (which includes the type and tag of all the auxiliary data) and by
+   * the arguments of `getCollection()`: input tags are compared by their
+   * value, while other arguments (e.g. associations passed to
+   * `proxy::wrapAssociated()`) are compared by address.
+   *
+   * The proxies refer to data owned by the event, and they must not be used
+   * after the event is over. The cache should be cleared at the end of each
+   * event with `clearEvent()`: `proxy::ProxyCacheService` takes care of that.
+   * The shared pointers handed out keep the proxy alive after the cache is
+   * cleared, but not the event data they point to.
+   *
+   * This object can be used concurrently from different threads. A proxy is
+   * created only once even if requested concurrently, but the creation of
+   * different proxies can proceed concurrently.
+   */
+  class ProxyCache {
+
+      public:
+
+    /**
+     * @brief Returns a collection proxy, creating it if not in the cache.
+     * @tparam CollProxy type of target main collection proxy
+     * @tparam Event type of event to read data from
+     * @tparam WithArgs type of arguments for the auxiliary data
+     * @param event event to read data from
+     * @param tag input tag of the main data product
+     * @param withArgs optional arguments for the auxiliary data
+     * @return a shared pointer to the constant collection proxy
+     * @see `proxy::getCollection()`
+     */
+    template <typename CollProxy, typename Event, typename... WithArgs>
+    auto getCollection(
+      Event const& event, art::InputTag const& tag, WithArgs&&... withArgs
+      );
+
+    /**
+     * @brief Returns an object derived from event data, creating it if needed.
+     * @tparam T type of the object
+     * @tparam Event type of event to read data from
+     * @tparam Make type of callable creating the object
+     * @param event event the object is derived from
+     * @param tag input tag of the data product the object is derived from
+     * @param make callable returning a new `T`, called at most once per event
+     * @return a shared pointer to the constant object
+     *
+     * This allows auxiliary indices (like `recob::PFParticleHierarchy`) to be
+     * shared the same way as collection proxies. Objects are identified by
+     * their type and by `tag`.
+     */
+    template <typename T, typename Event, typename Make>
+    std::shared_ptr<T const> getObject
+      (Event const& event, art::InputTag const& tag, Make&& make);
+
+    /// Removes from the cache all proxies of the specified event.
+    void clearEvent(art::EventID const& eventID);
+
+    /// Removes all proxies from the cache.
+    void clear();
+
+    /// Returns the number of proxies in the cache.
+    std::size_t size() const;
+
+    /// Returns how many times a proxy was found in the cache.
+    std::size_t nHits() const { return fHits.load(); }
+
+    /// Returns how many proxies were created.
+    std::size_t nMisses() const { return fMisses.load(); }
+
+
+      private:
+
+    /// A cached proxy, shared by all requests with the same key.
+    struct Entry {
+      std::once_flag created; ///< Flag for the creation of the proxy.
+      std::shared_ptr<void const> proxy; ///< The cached proxy.
+    }; // struct Entry
+
+    /// Identifier of a proxy: proxy type and encoded arguments.
+    using ProxyKey_t = std::tuple<std::type_index, std::string>;
+
+    /// All proxies from the same event.
+    using EventEntries_t = std::map<ProxyKey_t, std::shared_ptr<Entry>>;
+
+    mutable std::mutex fMutex; ///< Lock for the cache structure.
+
+    std::map<art::EventID, EventEntries_t> fEntries; ///< All cached proxies.
+
+    std::atomic<std::size_t> fHits { 0U }; ///< Number of proxies reused.
+    std::atomic<std::size_t> fMisses { 0U }; ///< Number of proxies created.
+
+    /// Returns the entry for the specified key, adding an empty one if needed.
+    std::shared_ptr<Entry> getEntry
+      (art::EventID const& eventID, ProxyKey_t&& key);
+
+  }; // class ProxyCache
+
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename CollProxy, typename Event, typename... WithArgs>
+auto proxy::ProxyCache::getCollection
+  (Event const& event, art::InputTag const& tag, WithArgs&&... withArgs)
+{
+  using proxy_t = decltype(proxy::getCollection<CollProxy>
+    (event, tag, std::forward<WithArgs>(withArgs)...));
+
+  std::string argKey = tag.encode();
+  ((argKey += '|', argKey += withArgs.cacheKey()), ...);
+
+  std::shared_ptr<Entry> entry = getEntry
+    (event.id(), ProxyKey_t{ std::type_index(typeid(proxy_t)), std::move(argKey) });
+
+  // the entry is created outside the cache lock: other proxies can be created
+  // in the meanwhile, while requests for this same proxy will wait
+  bool created = false;
+  std::call_once(entry->created, [&](){
+    entry->proxy = std::make_shared<proxy_t const>(proxy::getCollection<CollProxy>
+      (event, tag, std::forward<WithArgs>(withArgs)...));
+    created = true;
+  });
+  ++(created? fMisses: fHits);
+
+  return std::static_pointer_cast<proxy_t const>(entry->proxy);
+
+} // proxy::ProxyCache::getCollection()
+
+
+//------------------------------------------------------------------------------
+template <typename T, typename Event, typename Make>
+std::shared_ptr<T const> proxy::ProxyCache::getObject
+  (Event const& event, art::InputTag const& tag, Make&& make)
+{
+  std::shared_ptr<Entry> entry = getEntry
+    (event.id(), ProxyKey_t{ std::type_index(typeid(T)), tag.encode() });
+
+  bool created = false;
+  std::call_once(entry->created, [&](){
+    entry->proxy = std::make_shared<T const>(std::forward<Make>(make)());
+    created = true;
+  });
+  ++(created? fMisses: fHits);
+
+  return std::static_pointer_cast<T const>(entry->proxy);
+
+} // proxy::ProxyCache::getObject()
+
+
+//------------------------------------------------------------------------------
+inline void proxy::ProxyCache::clearEvent(art::EventID const& eventID) {
+  std::lock_guard<std::mutex> lock(fMutex);
+  fEntries.erase(eventID);
+} // proxy::ProxyCache::clearEvent()
+
+
+//------------------------------------------------------------------------------
+inline void proxy::ProxyCache::clear() {
+  std::lock_guard<std::mutex> lock(fMutex);
+  fEntries.clear();
+} // proxy::ProxyCache::clear()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t proxy::ProxyCache::size() const {
+  std::lock_guard<std::mutex> lock(fMutex);
+  std::size_t n = 0U;
+  for (auto const& eventEntries: fEntries) n += eventEntries.second.size();
+  return n;
+} // proxy::ProxyCache::size()
+
+
+//------------------------------------------------------------------------------
+inline auto proxy::ProxyCache::getEntry
+  (art::EventID const& eventID, ProxyKey_t&& key) -> std::shared_ptr<Entry>
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  std::shared_ptr<Entry>& entry = fEntries[eventID][std::move(key)];
+  if (!entry) entry = std::make_shared<Entry>();
+  return entry;
+} // proxy::ProxyCache::getEntry()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_RECOBASEPROXY_PROXYBASE_PROXYCACHE_H
@@ -11,10 +11,16 @@
 #ifndef LARDATA_RECOBASEPROXY_PROXYBASE_WITHASSOCIATEDSTRUCTBASE_H
 #define LARDATA_RECOBASEPROXY_PROXYBASE_WITHASSOCIATEDSTRUCTBASE_H
 
+// framework libraries
+#include "canvas/Utilities/InputTag.h"
 
 // C/C++ standard
 #include <tuple> // std::tuple_size(), std::get()
 #include <utility> // std::forward(), std::move(), std::index_sequence<>...
+#include <memory> // std::addressof()
+#include <sstream>
+#include <string>
+#include <type_traits> // std::is_convertible<>
 #include <cstdlib> // std::size_t
 
 
@@ -41,6 +47,64 @@ namespace proxy {
   //----------------------------------------------------------------------------
   namespace details {
 
+    //--------------------------------------------------------------------------
+    /// Type of `Arg` with rvalue references replaced by the referred type.
+    template <typename Arg>
+    struct OwningArg { using type = Arg; };
+
+    template <typename Arg>
+    struct OwningArg<Arg&&> { using type = Arg; };
+
+    /**
+     * @brief Type of argument tuple owning the temporary arguments.
+     * @tparam ArgTuple tuple of references, e.g. `std::tuple<Args&&...>`
+     *
+     * Rvalue references of `ArgTuple` are replaced by the referred type,
+     * while lvalue references are kept.
+     */
+    template <typename ArgTuple>
+    struct OwningArgTuple;
+
+    template <typename... Args>
+    struct OwningArgTuple<std::tuple<Args...>>
+      { using type = std::tuple<typename OwningArg<Args>::type...>; };
+
+    /// Direct access to `OwningArgTuple::type`.
+    template <typename ArgTuple>
+    using OwningArgTuple_t = typename OwningArgTuple<ArgTuple>::type;
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Returns a string identifying an argument of a request.
+     * @param arg the argument
+     * @return a string identifying `arg`
+     *
+     * Arguments convertible to `art::InputTag` are identified by their encoded
+     * tag, all others (e.g. associations) by their address.
+     */
+    template <typename Arg>
+    std::string argCacheKey(Arg const& arg)
+      {
+        if constexpr (std::is_convertible<Arg const&, art::InputTag>()) {
+          return art::InputTag(arg).encode();
+        }
+        else {
+          std::ostringstream sstr;
+          sstr << '@' << static_cast<void const*>(std::addressof(arg));
+          return sstr.str();
+        }
+      } // argCacheKey()
+
+    /// Returns a string identifying all the arguments in the tuple `args`.
+    template <typename ArgTuple, std::size_t... I>
+    std::string argsCacheKey(ArgTuple const& args, std::index_sequence<I...>)
+      {
+        std::string key;
+        ((key += '[', key += argCacheKey(std::get<I>(args)), key += ']'), ...);
+        return key;
+      } // argsCacheKey()
+
+
     //--------------------------------------------------------------------------
     /**
      * @brief Helper to create associated data proxy.
@@ -110,6 +174,24 @@ namespace proxy {
             );
         } // construct()
 
+      /**
+       * @brief Returns an equivalent object owning its temporary arguments.
+       *
+       * The arguments stored in this object are references to the ones passed
+       * by the user, which usually do not outlive the `getCollection()` call.
+       * The returned object holds a copy (moved) of the arguments which were
+       * temporary, and still references the other ones.
+       * It is used when the creation of the auxiliary data is deferred until
+       * after `getCollection()` returns (see `proxy::withLazy()`).
+       */
+      auto makeOwning() &&
+        { return makeOwningImpl(std::make_index_sequence<NArgs>()); }
+
+      /// Returns a string identifying the arguments of this request.
+      /// @see `proxy::ProxyCache`
+      std::string cacheKey() const
+        { return argsCacheKey(args, std::make_index_sequence<NArgs>()); }
+
 
         protected:
 
@@ -134,6 +216,14 @@ namespace proxy {
             );
         }
 
+      template <std::size_t... I>
+      auto makeOwningImpl(std::index_sequence<I...>)
+        {
+          using owning_args_t = OwningArgTuple_t<ArgTuple>;
+          return WithAssociatedStructBase<Aux, Metadata, OwningArgTuple_t<ArgTuple>, ProxyMaker, AuxTag>
+            (owning_args_t(std::get<I>(std::move(args))...));
+        }
+
     }; // struct WithAssociatedStructBase<>
 
 
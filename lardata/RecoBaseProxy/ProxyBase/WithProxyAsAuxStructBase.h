@@ -13,6 +13,7 @@
 
 // LArSoft libraries
 #include "lardata/RecoBaseProxy/ProxyBase/ProxyAsAuxProxyMaker.h"
+#include "lardata/RecoBaseProxy/ProxyBase/WithAssociatedStructBase.h" // OwningArgTuple_t, ...
 
 // framework libraries
 #include "canvas/Utilities/InputTag.h"
@@ -20,6 +21,7 @@
 // C/C++ standard
 #include <tuple> // std::tuple_element_t<>, std::get(), ...
 #include <utility> // std::forward(), std::move(), std::make_index_sequence()...
+#include <string>
 #include <type_traits> // std::is_convertible<>, std::decay_t<>, ...
 #include <cstdlib> // std::size_t
 
@@ -96,6 +98,24 @@ namespace proxy {
             );
         } // construct()
 
+      /**
+       * @brief Returns an equivalent object owning its temporary arguments.
+       *
+       * The arguments stored in this object are references to the ones passed
+       * by the user, which usually do not outlive the `getCollection()` call.
+       * The returned object holds a copy (moved) of the arguments which were
+       * temporary, and still references the other ones.
+       * It is used when the creation of the auxiliary data is deferred until
+       * after `getCollection()` returns (see `proxy::withLazy()`).
+       */
+      auto makeOwning() &&
+        { return makeOwningImpl(std::make_index_sequence<NArgs>()); }
+
+      /// Returns a string identifying the arguments of this request.
+      /// @see `proxy::ProxyCache`
+      std::string cacheKey() const
+        { return argsCacheKey(args, std::make_index_sequence<NArgs>()); }
+
 
         protected:
 
@@ -120,6 +140,14 @@ namespace proxy {
             );
         }
 
+      template <std::size_t... I>
+      auto makeOwningImpl(std::index_sequence<I...>)
+        {
+          using owning_args_t = OwningArgTuple_t<ArgTuple>;
+          return WithProxyAsAuxStructBase<AuxProxy, OwningArgTuple_t<ArgTuple>, AuxTag>
+            (owning_args_t(std::get<I>(std::move(args))...));
+        }
+
     }; // struct WithProxyAsAuxStructBase
 
 
@@ -13,6 +13,7 @@
 
 // LArSoft libraries
 #include "lardata/RecoBaseProxy/ProxyBase/CollectionProxyMaker.h"
+#include "lardata/Utilities/Instrumentation.h"
 
 // C/C++ standard
 #include <utility> // std::forward()
@@ -20,6 +21,15 @@
 
 namespace proxy {
 
+  namespace details {
+
+    /// Timer of the creation of collection proxies (see `lar::Instrumentation`)
+    struct GetCollectionTimer
+      { static constexpr char const* Name = "proxy::getCollection"; };
+
+  } // namespace details
+
+
   // ---------------------------------------------------------------------------
   /**
    * @brief Creates a proxy to a data product collection.
@@ -81,6 +91,7 @@ namespace proxy {
   template <typename CollProxy, typename Event, typename... OptionalArgs>
   auto getCollection(Event const& event, OptionalArgs&&... optionalArgs)
     {
+      lar::ScopedTimer<details::GetCollectionTimer> const timer;
       return CollectionProxyMaker<CollProxy>::make
         (event, std::forward<OptionalArgs>(optionalArgs)...);
     }
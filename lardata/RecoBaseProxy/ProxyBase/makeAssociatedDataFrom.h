@@ -51,8 +51,9 @@ namespace proxy {
    * @param minSize minimum number of entries in the produced association data
    * @return a new `AssociatedData` filled with associations from `tag`
    *
-   * The association being retrieved must fulfill the requirements of
-   * @ref LArSoftProxyDefinitionOneToManySeqAssn "one-to-many sequential association".
+   * The association being retrieved is typically a
+   * @ref LArSoftProxyDefinitionOneToManySeqAssn "one-to-many sequential association",
+   * but it is not required to be sorted by main key.
    *
    * Elements in the main collection not associated with any object will be
    * recorded as such. If there is information for less than `minSize` main
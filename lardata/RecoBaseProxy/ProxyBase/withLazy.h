@@ -0,0 +1,147 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyBase/withLazy.h
+ * @brief  Interface to add auxiliary data created on first access to a proxy.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyBase.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PROXYBASE_WITHLAZY_H
+#define LARDATA_RECOBASEPROXY_PROXYBASE_WITHLAZY_H
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/LazyAuxData.h"
+
+// C/C++ standard libraries
+#include <string>
+#include <utility> // std::forward(), std::move(), std::declval()
+#include <type_traits> // std::decay_t<>
+
+
+namespace proxy {
+
+  namespace details {
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Helper to create auxiliary data on first access.
+     * @tparam WithArg type of the request of the auxiliary data
+     *
+     * This class wraps a request of auxiliary data like the one returned by
+     * `withAssociated()`, and when `getCollection()` asks for the auxiliary
+     * data it returns a `LazyAuxData` object, which will forward the request
+     * only when the data is needed.
+     *
+     * The main data product handle and the main product arguments are copied,
+     * while the event is referenced: the collection proxy must not be used
+     * after the event is gone.
+     */
+    template <typename WithArg>
+    class WithLazyStruct {
+
+        public:
+      /// Constructor: steals the wrapped request.
+      WithLazyStruct(WithArg&& withArg): fWithArg(std::move(withArg)) {}
+
+      /// Creates a `LazyAuxData` which will create the requested data.
+      template
+        <typename CollProxy, typename Event, typename Handle, typename MainArgs>
+      auto createAuxProxyMaker
+        (Event const& event, Handle&& mainHandle, MainArgs const& mainArgs)
+        {
+          using handle_t = std::decay_t<Handle>;
+          using aux_collection_t
+            = decltype(std::declval<WithArg&>().template createAuxProxyMaker
+              <CollProxy>(event, std::declval<handle_t&>(), mainArgs)
+            );
+          return LazyAuxData<aux_collection_t>(
+            [
+              withArg = std::move(fWithArg), &event,
+              handle = handle_t(std::forward<Handle>(mainHandle)),
+              mainArgs = MainArgs(mainArgs)
+            ]() mutable
+            {
+              return withArg.template createAuxProxyMaker<CollProxy>
+                (event, handle, mainArgs);
+            }
+            );
+        } // createAuxProxyMaker()
+
+      /// Returns a string identifying the wrapped request.
+      /// @see `proxy::ProxyCache`
+      std::string cacheKey() const { return "lazy" + fWithArg.cacheKey(); }
+
+        private:
+      WithArg fWithArg; ///< The wrapped request.
+
+    }; // class WithLazyStruct<>
+
+
+    //--------------------------------------------------------------------------
+    // use a copy owning the arguments if the request supports it
+    template <typename WithArg>
+    auto makeOwningWithArg(WithArg&& withArg, int)
+      -> decltype(std::move(withArg).makeOwning())
+      { return std::move(withArg).makeOwning(); }
+
+    template <typename WithArg>
+    std::decay_t<WithArg> makeOwningWithArg(WithArg&& withArg, long)
+      { return std::move(withArg); }
+
+    //--------------------------------------------------------------------------
+
+  } // namespace details
+
+
+  // --- BEGIN Lazy auxiliary data ---------------------------------------------
+  /**
+   * @brief Helper function to create auxiliary data only when needed.
+   * @tparam WithArg type of the wrapped request of auxiliary data
+   * @param withArg request of auxiliary data (e.g. from `withAssociated()`)
+   * @return a temporary object that `getCollection()` knows to handle
+   * @ingroup LArSoftProxyBase
+   * @see @ref LArSoftProxiesLazyData "lazy auxiliary data"
+   *
+   * This function is meant to convey to `getCollection()` function the request
+   * to merge into the proxy the auxiliary data described by `withArg`, but to
+   * read the data product and build the auxiliary structures only when the
+   * data is first accessed by any of the elements of the proxy:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto tracks = proxy::getCollection<proxy::Tracks>(event, trackTag,
+   *   proxy::withLazy(proxy::withAssociated<recob::Cluster>(clusterTag))
+   *   );
+   *
+   * for (auto const& track: tracks) {
+   *   if (track->Length() < 100.0) continue;
+   *   auto const& clusters = track.get<recob::Cluster>(); // read here
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * In this example, the association between tracks and clusters is read
+   * only if there is at least one track 100 cm long or longer, and it is read
+   * only once. After the loop, `proxy::isAuxDataLoaded<recob::Cluster>(tracks)`
+   * tells whether that happened.
+   *
+   * The elements of the auxiliary data are accessed via the proxy elements as
+   * usual (`track.get<recob::Cluster>()`). The auxiliary data as a whole
+   * (`tracks.get<recob::Cluster>()`) is a `proxy::details::LazyAuxData`
+   * object, whose `load()` method returns the actual data.
+   *
+   * Temporary arguments of `withArg` (like `art::InputTag("cluster")`) are
+   * copied, while arguments passed as lvalues are referenced, and must persist
+   * as long as the proxy is used. The same holds for the event.
+   */
+  template <typename WithArg>
+  auto withLazy(WithArg&& withArg)
+    {
+      auto owning = details::makeOwningWithArg(std::forward<WithArg>(withArg), 0);
+      return details::WithLazyStruct<decltype(owning)>(std::move(owning));
+    }
+
+  // --- END Lazy auxiliary data -----------------------------------------------
+
+} // namespace proxy
+
+
+#endif // LARDATA_RECOBASEPROXY_PROXYBASE_WITHLAZY_H
@@ -0,0 +1,75 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyCacheService.h
+ * @brief  _art_ service sharing collection proxies among modules.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyBase/ProxyCache.h
+ *
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_PROXYCACHESERVICE_H
+#define LARDATA_RECOBASEPROXY_PROXYCACHESERVICE_H
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/ProxyCache.h"
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "fhiclcpp/ParameterSet.h"
+
+
+namespace proxy {
+
+  /**
+   * @brief _art_ service owning a `proxy::ProxyCache` for all modules.
+   * @see proxy::ProxyCache
+   *
+   * Modules asking for collection proxies via the cache of this service,
+   * instead of via `proxy::getCollection()`, share the proxies with each other
+   * within the same event, so that the association indexing happens only once
+   * per event:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto tracks = art::ServiceHandle<proxy::ProxyCacheService>()->cache()
+   *   .getCollection<proxy::Tracks>(event, tracksTag);
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * All the proxies of an event are removed from the cache after the event
+   * has been processed.
+   *
+   * Configuration
+   * ==============
+   *
+   * * `Verbose` (boolean, default: `false`): at the end of the job, prints
+   *     how many collection proxies were created and how many were reused
+   */
+  class ProxyCacheService {
+
+      public:
+
+    ProxyCacheService(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+    /// Returns the shared cache of collection proxies.
+    ProxyCache& cache() { return fCache; }
+
+      private:
+
+    ProxyCache fCache; ///< The cache of collection proxies.
+
+    bool fVerbose; ///< Whether to print statistics at the end of the job.
+
+    /// Removes the proxies of the event just processed.
+    void postProcessEvent(art::Event const& evt, art::ScheduleContext);
+
+    /// Prints the statistics of the cache, if requested.
+    void postEndJob();
+
+  }; // class ProxyCacheService
+
+} // namespace proxy
+
+
+DECLARE_ART_SERVICE(proxy::ProxyCacheService, SHARED)
+
+
+#endif // LARDATA_RECOBASEPROXY_PROXYCACHESERVICE_H
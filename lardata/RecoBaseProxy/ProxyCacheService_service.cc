@@ -0,0 +1,44 @@
+/**
+ * @file   lardata/RecoBaseProxy/ProxyCacheService_service.cc
+ * @brief  _art_ service sharing collection proxies among modules.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/ProxyCacheService.h
+ *
+ */
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyCacheService.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+
+//------------------------------------------------------------------------------
+proxy::ProxyCacheService::ProxyCacheService
+  (fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
+  : fVerbose(pset.get<bool>("Verbose", false))
+{
+  reg.sPostProcessEvent.watch(this, &ProxyCacheService::postProcessEvent);
+  reg.sPostEndJob.watch(this, &ProxyCacheService::postEndJob);
+} // proxy::ProxyCacheService::ProxyCacheService()
+
+
+//------------------------------------------------------------------------------
+void proxy::ProxyCacheService::postProcessEvent
+  (art::Event const& evt, art::ScheduleContext)
+{
+  fCache.clearEvent(evt.id());
+} // proxy::ProxyCacheService::postProcessEvent()
+
+
+//------------------------------------------------------------------------------
+void proxy::ProxyCacheService::postEndJob() {
+  if (!fVerbose) return;
+  mf::LogInfo("ProxyCacheService")
+    << "Collection proxies created: " << fCache.nMisses()
+    << ", reused: " << fCache.nHits();
+} // proxy::ProxyCacheService::postEndJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_SERVICE(proxy::ProxyCacheService)
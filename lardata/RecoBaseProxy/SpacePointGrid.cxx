@@ -0,0 +1,165 @@
+/**
+ * @file   lardata/RecoBaseProxy/SpacePointGrid.cxx
+ * @brief  Implementation file for `proxy::SpacePointGrid`.
+ * @date   October 14, 2026
+ * @see    SpacePointGrid.h
+ *
+ */
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/SpacePointGrid.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::nth_element(), std::clamp(), ...
+#include <utility> // std::pair<>
+#include <limits> // std::numeric_limits<>
+#include <cmath> // std::isfinite(), std::floor(), std::cbrt()
+
+
+//------------------------------------------------------------------------------
+//---  proxy::SpacePointGrid implementation
+//------------------------------------------------------------------------------
+proxy::SpacePointGrid::SpacePointGrid
+  (std::vector<recob::SpacePoint> const& points, double cellSize)
+  : fCellSize((cellSize > 0.0)? cellSize: DefaultCellSize)
+{
+  //
+  // bounding box of the points
+  //
+  std::vector<GridPoint_t> gridPoints;
+  gridPoints.reserve(points.size());
+  std::array<double, 3U> lower;
+  lower.fill(std::numeric_limits<double>::max());
+  std::array<double, 3U> upper;
+  upper.fill(std::numeric_limits<double>::lowest());
+  for (std::size_t iPoint = 0; iPoint < points.size(); ++iPoint) {
+    Double32_t const* xyz = points[iPoint].XYZ();
+    if (!std::isfinite(xyz[0]) || !std::isfinite(xyz[1]) || !std::isfinite(xyz[2]))
+      continue;
+    gridPoints.push_back({ xyz[0], xyz[1], xyz[2], iPoint });
+    for (std::size_t d = 0; d < 3U; ++d) {
+      lower[d] = std::min<double>(lower[d], xyz[d]);
+      upper[d] = std::max<double>(upper[d], xyz[d]);
+    }
+  } // for
+  fNPoints = gridPoints.size();
+
+  //
+  // grid size, enlarging the cells if too many
+  //
+  std::array<std::size_t, 3U> sides {{ 1U, 1U, 1U }};
+  if (fNPoints > 0U) {
+    fOrigin = lower;
+    double const maxCells = double(MaxCellsPerPoint * fNPoints);
+    auto const nCells = [&lower, &upper](double cellSize){
+      double n = 1.0;
+      for (std::size_t d = 0; d < 3U; ++d)
+        n *= std::floor((upper[d] - lower[d]) / cellSize) + 1.0;
+      return n;
+    };
+    // start from the cubic estimate, which is short for flat distributions
+    double const volume = std::max(upper[0] - lower[0], fCellSize)
+      * std::max(upper[1] - lower[1], fCellSize)
+      * std::max(upper[2] - lower[2], fCellSize);
+    if (volume / (fCellSize * fCellSize * fCellSize) > maxCells)
+      fCellSize = std::cbrt(volume / maxCells);
+    while (nCells(fCellSize) > maxCells) fCellSize *= 1.25;
+    for (std::size_t d = 0; d < 3U; ++d) {
+      sides[d]
+        = static_cast<std::size_t>((upper[d] - lower[d]) / fCellSize) + 1U;
+    }
+  } // if points
+
+  fGrid.emplace(sides);
+  fGrid->fill(gridPoints.cbegin(), gridPoints.cend(),
+    [this](GridPoint_t const& point){ return cellOf(point.x, point.y, point.z); }
+    );
+
+} // proxy::SpacePointGrid::SpacePointGrid()
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> proxy::SpacePointGrid::pointsWithin
+  (geo::Point_t const& center, double radius) const
+{
+  std::vector<std::size_t> found;
+  forEachWithin
+    (center, radius, [&found](std::size_t index, double){ found.push_back(index); });
+  std::sort(found.begin(), found.end());
+  return found;
+} // proxy::SpacePointGrid::pointsWithin()
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> proxy::SpacePointGrid::nearestPoints
+  (geo::Point_t const& center, std::size_t k) const
+{
+  std::vector<std::size_t> nearest;
+  if (empty() || (k == 0U)) return nearest;
+  if (!std::isfinite(center.X()) || !std::isfinite(center.Y())
+    || !std::isfinite(center.Z()))
+    return nearest;
+
+  //
+  // the cells within `shell` of the center cover a sphere of radius
+  // `shell * fCellSize`: the search grows until that includes `k` points,
+  // or the whole grid
+  //
+  CellID_t const centerCell = cellOf(center.X(), center.Y(), center.Z());
+  std::size_t const nCells[3]
+    = { fGrid->sizeX(), fGrid->sizeY(), fGrid->sizeZ() };
+  Grid_t::CellDimIndex_t firstShell = 0; // the grid is reached from here
+  Grid_t::CellDimIndex_t lastShell = 0; // the whole grid is covered from here
+  for (std::size_t d = 0; d < 3U; ++d) {
+    auto const side = static_cast<Grid_t::CellDimIndex_t>(nCells[d]);
+    firstShell = std::max(firstShell, -centerCell[d]);
+    firstShell = std::max(firstShell, centerCell[d] - side + 1);
+    lastShell = std::max(lastShell, centerCell[d]);
+    lastShell = std::max(lastShell, side - 1 - centerCell[d]);
+  } // for
+
+  std::vector<std::pair<double, std::size_t>> candidates;
+  for (auto shell = firstShell; ; ++shell) {
+    candidates.clear();
+    fGrid->forEachNeighbour(centerCell, shell,
+      [&](GridPoint_t const& point){
+        double const dx = point.x - center.X();
+        double const dy = point.y - center.Y();
+        double const dz = point.z - center.Z();
+        candidates.emplace_back(dx*dx + dy*dy + dz*dz, point.index);
+      });
+    if (shell >= lastShell) break;
+    if (candidates.size() < k) continue;
+    std::nth_element
+      (candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+    double const covered = shell * fCellSize;
+    if (candidates[k - 1].first <= covered * covered) break;
+  } // for
+
+  std::size_t const n = std::min(k, candidates.size());
+  std::partial_sort
+    (candidates.begin(), candidates.begin() + n, candidates.end());
+  nearest.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) nearest.push_back(candidates[i].second);
+  return nearest;
+
+} // proxy::SpacePointGrid::nearestPoints()
+
+
+//------------------------------------------------------------------------------
+auto proxy::SpacePointGrid::cellOf(double x, double y, double z) const
+  -> CellID_t
+{
+  // cells far off the grid are clamped, still off the grid
+  double const coords[3] = { x, y, z };
+  CellID_t cellID;
+  for (std::size_t d = 0; d < 3U; ++d) {
+    double const c = std::floor((coords[d] - fOrigin[d]) / fCellSize);
+    cellID[d] = static_cast<Grid_t::CellDimIndex_t>
+      (std::clamp(c, -FarCells, FarCells));
+  }
+  return cellID;
+} // proxy::SpacePointGrid::cellOf()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+/**
+ * @file   lardata/RecoBaseProxy/SpacePointGrid.h
+ * @brief  Spatial index of a collection of space points.
+ * @date   October 14, 2026
+ * @see    SpacePointGrid.cxx
+ *         lardata/RecoBaseProxy/ChargedSpacePoints.h
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_SPACEPOINTGRID_H
+#define LARDATA_RECOBASEPROXY_SPACEPOINTGRID_H
+
+// LArSoft libraries
+#include "lardata/Utilities/GridContainers.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "larcorealg/Geometry/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <array>
+#include <optional>
+#include <vector>
+#include <cmath> // std::isfinite()
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Space points arranged in cubic cells, for neighbour searches.
+   * @see `proxy::ChargedSpacePointsCollectionProxy::spatialIndex()`
+   *
+   * The grid covers the bounding box of the points, with cells of the
+   * requested side. The points are frozen into a `util::GridContainer3D`, so
+   * that the points of each cell are contiguous in memory, and a query visits
+   * only the cells around its center.
+   *
+   * Points are reported by their position in the original collection.
+   *
+   * To keep the memory bounded for sparse collections, the cells are enlarged
+   * when the grid would have more than `MaxCellsPerPoint` cells per point;
+   * `cellSize()` reports the side actually used. Points with non-finite
+   * coordinates are not in the grid.
+   */
+  class SpacePointGrid {
+
+      public:
+
+    /// Default side of the cells [cm]
+    static constexpr double DefaultCellSize = 1.0;
+
+    /// Largest number of cells per point, before the cells are enlarged.
+    static constexpr std::size_t MaxCellsPerPoint = 8U;
+
+    /// Constructor: indexes `points` with cubic cells of side `cellSize` [cm].
+    SpacePointGrid
+      (std::vector<recob::SpacePoint> const& points, double cellSize);
+
+    /// Returns the number of points in the grid.
+    std::size_t size() const { return fNPoints; }
+
+    /// Returns whether there are no points in the grid.
+    bool empty() const { return fNPoints == 0U; }
+
+    /// Returns the side of the cells [cm]
+    double cellSize() const { return fCellSize; }
+
+    /**
+     * @brief Returns the points within `radius` of `center`.
+     * @param center center of the search
+     * @param radius largest distance of the points [cm]
+     * @return the positions of the points, in increasing order
+     */
+    std::vector<std::size_t> pointsWithin
+      (geo::Point_t const& center, double radius) const;
+
+    /**
+     * @brief Calls `op` on all the points within `radius` of `center`.
+     * @tparam Op type of operation
+     * @param center center of the search
+     * @param radius largest distance of the points [cm]
+     * @param op operation called as `op(std::size_t index, double distance2)`
+     *
+     * The operation receives the position of each point in the collection
+     * and its square distance from `center`, in no particular order.
+     */
+    template <typename Op>
+    void forEachWithin
+      (geo::Point_t const& center, double radius, Op op) const;
+
+    /**
+     * @brief Returns the `k` points closest to `center`.
+     * @param center center of the search
+     * @param k number of points requested
+     * @return the positions of the points, from the closest
+     *
+     * Points at the same distance are sorted by position. If the grid has
+     * fewer than `k` points, all of them are returned.
+     */
+    std::vector<std::size_t> nearestPoints
+      (geo::Point_t const& center, std::size_t k) const;
+
+
+      private:
+
+    /// Position and index of a point, as stored in the grid.
+    struct GridPoint_t {
+      double x = 0.0;
+      double y = 0.0;
+      double z = 0.0;
+      std::size_t index = 0U; ///< Position in the original collection.
+    }; // struct GridPoint_t
+
+    using Grid_t = util::GridContainer3D<GridPoint_t>; ///< Grid type.
+    using CellID_t = Grid_t::CellID_t; ///< Cell coordinates type.
+
+    /// Cell coordinates are clamped to this distance from the grid.
+    static constexpr double FarCells = 1e9;
+
+    std::size_t fNPoints = 0U; ///< Number of points in the grid.
+    double fCellSize = DefaultCellSize; ///< Side of the cells [cm]
+    std::array<double, 3U> fOrigin {{ 0.0, 0.0, 0.0 }}; ///< Grid corner.
+    std::optional<Grid_t> fGrid; ///< The grid.
+
+    /// Returns the cell containing the specified point (may be off grid).
+    CellID_t cellOf(double x, double y, double z) const;
+
+  }; // class SpacePointGrid
+
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Op>
+void proxy::SpacePointGrid::forEachWithin
+  (geo::Point_t const& center, double radius, Op op) const
+{
+  if (empty() || !(radius >= 0.0)) return;
+  if (!std::isfinite(center.X()) || !std::isfinite(center.Y())
+    || !std::isfinite(center.Z()))
+    return;
+
+  double const radius2 = radius * radius;
+  auto const k = static_cast<Grid_t::CellDimIndex_t>
+    (std::min(radius / fCellSize, 3.0 * FarCells)) + 1;
+  fGrid->forEachNeighbour(cellOf(center.X(), center.Y(), center.Z()), k,
+    [&](GridPoint_t const& point){
+      double const dx = point.x - center.X();
+      double const dy = point.y - center.Y();
+      double const dz = point.z - center.Z();
+      double const d2 = dx*dx + dy*dy + dz*dz;
+      if (d2 <= radius2) op(point.index, d2);
+    });
+} // proxy::SpacePointGrid::forEachWithin()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_RECOBASEPROXY_SPACEPOINTGRID_H
@@ -29,6 +29,11 @@
  *   information is provided with `recob::TrackFitHitInfo` tag, with the
  *   dedicated accessor `fitInfoAtPoint()` of the track proxy and with
  *   `fitInfoPtr()` when accessing a single point
+ * * the hit metadata (`recob::TrackHitMeta`): include it with
+ *   `withHitMetadata()`; the information is provided with
+ *   `recob::TrackHitMeta` tag and with the dedicated accessor
+ *   `hitsWithMetadata()` of the track proxy, and it also speeds up the access
+ *   to the hits of single points
  *
  * LArSoft prescribes conventions to be followed, which include:
  * * a track has at least two trajectory points
@@ -232,7 +237,9 @@
 
 // LArSoft libraries
 #include "lardata/RecoBaseProxy/ProxyBase.h" // proxy namespace
+#include "lardata/RecoBaseProxy/TrackHitMetaIndex.h"
 #include "lardata/Utilities/filterRangeFor.h"
+#include "lardata/Utilities/CollectionView.h"
 #include "lardataobj/RecoBase/Track.h"
 #include "lardataobj/RecoBase/TrackTrajectory.h"
 #include "lardataobj/RecoBase/Hit.h"
@@ -241,8 +248,11 @@
 // framework libraries
 #include "canvas/Persistency/Common/Ptr.h"
 
+#include <cstddef> // std::ptrdiff_t
+#include <iterator> // std::forward_iterator_tag
 #include <limits>
 #include <tuple>
+#include <type_traits> // std::is_same_v<>
 #include <vector>
 
 namespace proxy {
@@ -255,12 +265,18 @@ namespace proxy {
   template <typename Data>
   class TrackPointWrapper;
 
+  template <typename TrackProxy, typename... Fields>
+  class TrackPointFields;
+
   //----------------------------------------------------------------------------
   namespace details {
 
     template <typename CollProxy>
     struct TrackPointIteratorBox;
 
+    template <typename TrackProxy, typename... Fields>
+    class TrackPointFieldRange;
+
     template <typename T>
     struct isTrackProxy;
 
@@ -509,6 +525,9 @@ namespace proxy {
     /// Tag used for the associated hits.
     using HitTag = recob::Hit;
 
+    /// Tag used for the associated hits with their metadata.
+    using HitMetaTag = recob::TrackHitMeta;
+
     /// Types of tracks and trajectories.
     typedef enum {
       Unfitted, ///< Represents a track trajectory before the final fit.
@@ -695,6 +714,108 @@ namespace proxy {
   }; // class TrackPoint
 
 
+  // --- BEGIN Track point fields ----------------------------------------------
+  /**
+   * @name Track point fields
+   * @ingroup LArSoftProxyTracks
+   * @see `proxy::TrackPointFields`, `proxy::Track::points()`
+   *
+   * Tags selecting the information of the trajectory points which is read
+   * by a field-selective iteration, `track.points<Fields...>()`.
+   */
+  /// @{
+  struct TrackPointPosition {}; ///< Position of the trajectory point.
+  struct TrackPointMomentum {}; ///< Momentum at the trajectory point.
+  struct TrackPointFlags {};    ///< Flags of the trajectory point.
+  struct TrackPointHit {};      ///< Hit associated to the trajectory point.
+  /// @}
+  // --- END Track point fields ------------------------------------------------
+
+
+  /**
+   * @brief Selected information of a trajectory point.
+   * @tparam TrackProxy type of the track proxy the point belongs to
+   * @tparam Fields tags of the information available for the point
+   * @ingroup LArSoftProxyTracks
+   * @see `proxy::Track::points()`
+   *
+   * This object offers the same interface as `proxy::TrackPointWrapper`, but
+   * only for the information selected by `Fields` (`TrackPointPosition`,
+   * `TrackPointMomentum`, `TrackPointFlags` and `TrackPointHit`); the index
+   * of the point is always available. Asking for information which was not
+   * selected is a compilation error.
+   *
+   * The object refers to the range which created it, and it is valid only as
+   * long as that range is.
+   */
+  template <typename TrackProxy, typename... Fields>
+  class TrackPointFields {
+    using range_t = details::TrackPointFieldRange<TrackProxy, Fields...>;
+
+    friend range_t;
+
+    range_t const* fRange = nullptr; ///< Range the point belongs to.
+    std::size_t fIndex = 0U; ///< Index of the point within the track.
+
+    TrackPointFields(range_t const& range, std::size_t index)
+      : fRange(&range), fIndex(index) {}
+
+      public:
+
+    /// Returns whether the information tagged `Field` is available.
+    template <typename Field>
+    static constexpr bool has()
+      { return (std::is_same_v<Field, Fields> || ...); }
+
+    /// Returns the index of the point within the track.
+    std::size_t index() const { return fIndex; }
+
+    /// Returns the position of the trajectory point.
+    recob::Track::Point_t const& position() const
+      {
+        static_assert(has<TrackPointPosition>(),
+          "position() requires proxy::TrackPointPosition among the fields");
+        return fRange->positionsData()[fIndex];
+      }
+
+    /// Returns the momentum vector of the trajectory point.
+    recob::Track::Vector_t const& momentum() const
+      {
+        static_assert(has<TrackPointMomentum>(),
+          "momentum() requires proxy::TrackPointMomentum among the fields");
+        return fRange->momentaData()[fIndex];
+      }
+
+    /// Returns the flags associated with the trajectory point.
+    recob::TrackTrajectory::PointFlags_t const& flags() const
+      {
+        static_assert(has<TrackPointFlags>(),
+          "flags() requires proxy::TrackPointFlags among the fields");
+        return fRange->flagsData()[fIndex];
+      }
+
+    /// Returns whether the trajectory point is valid.
+    bool isPointValid() const { return flags().isPointValid(); }
+
+    /// Returns the art pointer to the hit on the trajectory point, if any.
+    auto hitPtr() const -> decltype(auto)
+      {
+        static_assert(has<TrackPointHit>(),
+          "hitPtr() requires proxy::TrackPointHit among the fields");
+        return fRange->track().hitAtPoint(fIndex);
+      }
+
+    /// Returns a pointer to the hit on the trajectory point, if any.
+    recob::Hit const* hit() const
+      {
+        static_assert(has<TrackPointHit>(),
+          "hit() requires proxy::TrackPointHit among the fields");
+        return fRange->hitAt(fIndex);
+      }
+
+  }; // TrackPointFields<>
+
+
   /**
    * @brief Returns an object with information about the specified track point.
    * @tparam TrackProxy an instance of proxy::Track template
@@ -792,13 +913,50 @@ namespace proxy {
     auto hits() const -> decltype(auto)
       { return base_t::template get<Tracks::HitTag>(); }
 
-    /// Returns an art pointer to the hit associated with the specified point.
+    /**
+     * @brief Returns an art pointer to the hit associated with the specified
+     *        point.
+     *
+     * If the hit metadata was merged into the proxy (`withHitMetadata()`),
+     * the pointer is read from its pre-resolved index.
+     */
     auto hitAtPoint(std::size_t index) const -> decltype(auto)
-      { return hits()[index]; }
+      {
+        if constexpr (hasHitMetadata())
+          return hitsWithMetadata().hitPtrs()[index];
+        else return hits()[index];
+      }
 
     /// Returns the number of hits associated with this track.
     std::size_t nHits() const { return hits().size(); }
 
+    /// Returns whether the hit metadata was merged into the proxy.
+    /// @see `proxy::withHitMetadata()`
+    static constexpr bool hasHitMetadata()
+      { return base_t::template has<Tracks::HitMetaTag>(); }
+
+    /**
+     * @brief Returns the hits of this track with their association metadata.
+     * @return a `proxy::TrackHitsWithMetadata` object
+     * @see `proxy::withHitMetadata()`
+     *
+     * This interface is available only if the hit metadata was merged into
+     * the proxy (`withHitMetadata()`):
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto const& hitInfo = track.hitsWithMetadata();
+     * auto const& hits = hitInfo.hits();
+     * auto const& metadata = hitInfo.metadata();
+     * double charge = 0.0, length = 0.0;
+     * for (std::size_t i = 0; i < hitInfo.size(); ++i) {
+     *   if (!hits[i]) continue;
+     *   charge += hits[i]->Integral();
+     *   length += metadata[i]->Dx();
+     * }
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    auto hitsWithMetadata() const -> decltype(auto)
+      { return base_t::template get<Tracks::HitMetaTag>(); }
+
     /// @}
     // --- END Direct hit interface --------------------------------------------
 
@@ -909,6 +1067,36 @@ namespace proxy {
     auto points() const
       { return details::TrackPointIteratorBox<CollProxy>(*this); }
 
+    /**
+     * @brief Returns an iterable range with only some of the point information.
+     * @tparam Field tag of the first information to be read
+     * @tparam Fields tags of the other information to be read
+     * @return an object that can be iterated and indexed
+     * @see `proxy::TrackPointFields`, `points()`
+     *
+     * The elements of the range offer only the selected information of the
+     * points (`TrackPointPosition`, `TrackPointMomentum`, `TrackPointFlags`
+     * and `TrackPointHit`) and their index. Only the selected data of the
+     * trajectory is accessed, and the associated hits are looked up only if
+     * `TrackPointHit` is requested: in that case, the hits of all the points
+     * are resolved once, when the range is created.
+     * Example:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * double sumZ = 0.0;
+     * for (auto const& pointInfo: track.points<proxy::TrackPointPosition>())
+     *   sumZ += pointInfo.position().Z();
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The elements refer to the range, which must be kept alive as long as
+     * they are used. In a template context, the call must be written as
+     * `track.template points<...>()`.
+     */
+    template <typename Field, typename... Fields>
+    auto points() const
+      {
+        return details::TrackPointFieldRange
+          <TrackCollectionProxyElement, Field, Fields...>(*this);
+      }
+
     /**
      * @brief Returns an iterable range with only points matching the `mask`.
      * @tparam Pred type of predicate to test on points
@@ -1002,6 +1190,69 @@ namespace proxy {
     // --- END Point-by-point iteration interface ------------------------------
 
 
+    // --- BEGIN Bulk trajectory point interface -------------------------------
+    /**
+     * @name Bulk trajectory point interface
+     * @see `proxy::TrackPoint`
+     *
+     * Information of all the trajectory points can be accessed as a whole,
+     * as contiguous sequences with one entry per point. This avoids the
+     * creation of the point-by-point information (`point()`) and is better
+     * suited to loops over many points, which the compiler may vectorize:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto const& positions = track.positions();
+     * auto const& flags = track.flags();
+     * double length = 0.0;
+     * for (std::size_t i = 1; i < positions.size(); ++i) {
+     *   if (!flags[i].isPointValid() || !flags[i - 1].isPointValid()) continue;
+     *   length += (positions[i] - positions[i - 1]).R();
+     * }
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * Positions, momenta and flags are views on the data of the track
+     * trajectory, and no data is copied. They are valid as long as the track
+     * itself is. The keys of the hits are instead collected into a new
+     * vector.
+     */
+    /// @{
+
+    /// Type of sequence of all the positions of the trajectory points.
+    using positions_t = lar::RangeAsCollection_t<recob::Track::Point_t const*>;
+
+    /// Type of sequence of all the momenta of the trajectory points.
+    using momenta_t = lar::RangeAsCollection_t<recob::Track::Vector_t const*>;
+
+    /// Type of sequence of all the flags of the trajectory points.
+    using flags_t
+      = lar::RangeAsCollection_t<recob::TrackTrajectory::PointFlags_t const*>;
+
+    /// Key returned by `hitKeys()` for points with no associated hit.
+    static constexpr std::size_t InvalidHitKey
+      = std::numeric_limits<std::size_t>::max();
+
+    /// Returns the positions of all the trajectory points.
+    positions_t positions() const
+      { return makeContiguousView(track().Trajectory().Positions()); }
+
+    /// Returns the momenta of all the trajectory points.
+    momenta_t momenta() const
+      { return makeContiguousView(track().Trajectory().Momenta()); }
+
+    /// Returns the flags of all the trajectory points.
+    flags_t flags() const
+      { return makeContiguousView(track().Trajectory().Flags()); }
+
+    /**
+     * @brief Returns the keys of all the hits of this track, at point order.
+     * @return a vector with the key of the hit of each point
+     *
+     * Points with no associated hit have `InvalidHitKey` as key.
+     */
+    std::vector<std::size_t> hitKeys() const;
+
+    /// @}
+    // --- END Bulk trajectory point interface ---------------------------------
+
+
     // --- BEGIN Additional utilities ------------------------------------------
     /// @name Additional utilities
     /// @{
@@ -1014,6 +1265,12 @@ namespace proxy {
     recob::TrackTrajectory const* originalTrajectoryCPtr() const noexcept
       { return hasOriginalTrajectory()? &originalTrajectory(): nullptr; }
 
+    /// Returns a view of the whole content of a contiguous collection.
+    template <typename Coll>
+    static auto makeContiguousView(Coll const& coll)
+      -> lar::RangeAsCollection_t<typename Coll::value_type const*>
+      { return lar::makeCollectionView(coll.data(), coll.data() + coll.size()); }
+
   }; // TrackCollectionProxyElement<>
 
 
@@ -1194,6 +1451,57 @@ namespace proxy {
         <std::vector<recob::TrackFitHitInfo>, Tracks::TrackFitHitInfoTag>();
     }
 
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Adds hits with `recob::TrackHitMeta` information to the proxy.
+   * @param inputTag the data product label to read the association from
+   * @return an object driving `getCollection()` to index the hit metadata
+   * @ingroup LArSoftProxyTracks
+   * @see `proxy::Tracks`, `proxy::getCollection()`, `proxy::withHitMetadata()`
+   *
+   * This function behaves like `withHitMetadata()`, but allows to use
+   * `inputTag` as input tag, instead of the same label as for the track
+   * collection.
+   */
+  inline auto withHitMetadata(art::InputTag const& inputTag)
+    { return details::WithTrackHitMetaStruct<Tracks::HitMetaTag>(inputTag); }
+
+  /**
+   * @brief Adds hits with `recob::TrackHitMeta` information to the proxy.
+   * @return an object driving `getCollection()` to index the hit metadata
+   * @ingroup LArSoftProxyTracks
+   * @see `proxy::withHitMetadata(art::InputTag const&)`,
+   *      `proxy::TrackCollectionProxyElement::hitsWithMetadata()`
+   *
+   * The association `art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta>`
+   * with the same input tag as the tracks is read, and the hits and metadata
+   * of each track are stored in contiguous arrays, with all the pointers
+   * already resolved.
+   * Compared to `proxy::withAssociatedMeta<recob::Hit, recob::TrackHitMeta>()`
+   * this costs some memory and time when the proxy is created, but then
+   * `track.hitsWithMetadata()` and the hits of the trajectory points
+   * (`point.hitPtr()`, `point.hit()`) are plain array reads:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto tracks = proxy::getCollection<proxy::Tracks>
+   *   (event, tracksTag, proxy::withHitMetadata());
+   *
+   * for (auto const& track: tracks) {
+   *   auto const& metadata = track.hitsWithMetadata().metadata();
+   *   for (auto const& point: track.points()) {
+   *     recob::Hit const* hit = point.hit();
+   *     double const dx = metadata[point.index()]->Dx();
+   *     // ...
+   *   } // for point
+   * } // for tracks
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The association is expected to hold the same hits, in the same order,
+   * as the one between tracks and hits that the proxy always reads.
+   * The data is available through the regular interface via tag
+   * `recob::TrackHitMeta`.
+   */
+  inline auto withHitMetadata()
+    { return details::WithTrackHitMetaStruct<Tracks::HitMetaTag>(); }
+
   /// @}
   // --- END Auxiliary data ----------------------------------------------------
 
@@ -1382,10 +1690,110 @@ namespace proxy {
     }; // TrackPointIteratorBox<>
 
 
+    //--------------------------------------------------------------------------
+    /// Range of points of a track, with only the selected information.
+    template <typename TrackProxy, typename... Fields>
+    class TrackPointFieldRange {
+        public:
+      /// Type of the elements of the range.
+      using point_t = TrackPointFields<TrackProxy, Fields...>;
+
+      /// Iterator through the points of the range.
+      class const_iterator {
+        TrackPointFieldRange const* fRange = nullptr; ///< Iterated range.
+        std::size_t fIndex = 0U; ///< Index of the current point.
+
+          public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = point_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = point_t;
+
+        const_iterator() = default;
+        const_iterator(TrackPointFieldRange const& range, std::size_t index)
+          : fRange(&range), fIndex(index) {}
+
+        point_t operator*() const { return (*fRange)[fIndex]; }
+
+        const_iterator& operator++() { ++fIndex; return *this; }
+        const_iterator operator++(int)
+          { const_iterator old(*this); ++fIndex; return old; }
+
+        bool operator==(const_iterator const& other) const
+          { return (fRange == other.fRange) && (fIndex == other.fIndex); }
+        bool operator!=(const_iterator const& other) const
+          { return !(*this == other); }
+
+      }; // const_iterator
+
+      TrackPointFieldRange(TrackProxy const& track);
+
+      /// Returns the proxy of the track the points belong to.
+      TrackProxy const& track() const { return *fTrack; }
+
+      /// Returns the number of points in the range.
+      std::size_t size() const { return fTrack->nPoints(); }
+
+      const_iterator begin() const { return { *this, 0U }; }
+      const_iterator end() const { return { *this, size() }; }
+
+      /// Returns the information of the point with the specified `index`.
+      point_t operator[](std::size_t index) const { return { *this, index }; }
+
+      /// @{
+      /// @name Selected data (`nullptr` if not selected)
+      recob::Track::Point_t const* positionsData() const { return fPositions; }
+      recob::Track::Vector_t const* momentaData() const { return fMomenta; }
+      recob::TrackTrajectory::PointFlags_t const* flagsData() const
+        { return fFlags; }
+      /// @}
+
+      /// Returns the prefetched hit of the point `index` (`nullptr` if none).
+      recob::Hit const* hitAt(std::size_t index) const
+        { return (index < fHits.size())? fHits[index]: nullptr; }
+
+        private:
+      TrackProxy const* fTrack = nullptr; ///< Track the points belong to.
+
+      recob::Track::Point_t const* fPositions = nullptr;
+      recob::Track::Vector_t const* fMomenta = nullptr;
+      recob::TrackTrajectory::PointFlags_t const* fFlags = nullptr;
+
+      /// Hits of all the points (only with `TrackPointHit`).
+      std::vector<recob::Hit const*> fHits;
+
+    }; // TrackPointFieldRange<>
+
+
     //--------------------------------------------------------------------------
 
   } // namespace details
 
+  //----------------------------------------------------------------------------
+  template <typename TrackProxy, typename... Fields>
+  details::TrackPointFieldRange<TrackProxy, Fields...>::TrackPointFieldRange
+    (TrackProxy const& track)
+    : fTrack(&track)
+  {
+    auto const& trajectory = track.track().Trajectory();
+    if constexpr (point_t::template has<TrackPointPosition>())
+      fPositions = trajectory.Positions().data();
+    if constexpr (point_t::template has<TrackPointMomentum>())
+      fMomenta = trajectory.Momenta().data();
+    if constexpr (point_t::template has<TrackPointFlags>())
+      fFlags = trajectory.Flags().data();
+    if constexpr (point_t::template has<TrackPointHit>()) {
+      std::size_t const nHits = track.nHits();
+      fHits.reserve(nHits);
+      for (std::size_t i = 0; i < nHits; ++i) {
+        decltype(auto) ptr = track.hitAtPoint(i);
+        fHits.push_back(ptr? ptr.get(): nullptr);
+      } // for
+    } // if hits
+  } // details::TrackPointFieldRange<>::TrackPointFieldRange()
+
+
   //----------------------------------------------------------------------------
   template <typename CollProxy>
   recob::TrackTrajectory const*
@@ -1434,6 +1842,20 @@ namespace proxy {
   } // TrackCollectionProxyElement<>::pointsWithFlags()
 
 
+  //----------------------------------------------------------------------------
+  template <typename CollProxy>
+  std::vector<std::size_t> TrackCollectionProxyElement<CollProxy>::hitKeys()
+    const
+  {
+    auto const& hits = this->hits();
+    std::vector<std::size_t> keys;
+    keys.reserve(hits.size());
+    for (art::Ptr<recob::Hit> const& hit: hits)
+      keys.push_back(hit.isNull()? InvalidHitKey: hit.key());
+    return keys;
+  } // TrackCollectionProxyElement<>::hitKeys()
+
+
   //----------------------------------------------------------------------------
 
 } // namespace proxy
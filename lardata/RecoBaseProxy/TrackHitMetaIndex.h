@@ -0,0 +1,284 @@
+/**
+ * @file   lardata/RecoBaseProxy/TrackHitMetaIndex.h
+ * @brief  Pre-resolved index of hits and `recob::TrackHitMeta` of tracks.
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/Track.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_RECOBASEPROXY_TRACKHITMETAINDEX_H
+#define LARDATA_RECOBASEPROXY_TRACKHITMETAINDEX_H
+
+// LArSoft libraries
+#include "lardata/Utilities/AllocationAccounting.h"
+#include "lardata/Utilities/CollectionView.h"
+#include "lardata/Utilities/TupleLookupByTag.h" // util::add_tag_t<>
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/TrackHitMeta.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard
+#include <memory> // std::shared_ptr<>, std::make_shared()
+#include <optional>
+#include <string>
+#include <vector>
+#include <utility> // std::move()
+#include <type_traits> // std::is_same<>
+#include <cstdlib> // std::size_t
+
+
+namespace proxy {
+
+  namespace details {
+
+    /// Tag of the allocations of the track hit metadata index.
+    struct TrackHitMetaAllocationTag
+      { static constexpr char const* Name = "TrackHitMetaIndex"; };
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Hits and their metadata of all tracks, in contiguous arrays.
+     *
+     * The hits of track `i` are at positions from `offsets[i]` to
+     * `offsets[i + 1]` (excluded) of all the other arrays, in the same order
+     * as they appear in the association.
+     */
+    struct TrackHitMetaStorage {
+
+      template <typename T>
+      using Vector_t = lar::TaggedVector<T, TrackHitMetaAllocationTag>;
+
+      /// Position of the first hit of each track, plus the total hit count.
+      Vector_t<std::size_t> offsets;
+
+      Vector_t<art::Ptr<recob::Hit>> hitPtrs; ///< _art_ pointers to hits.
+
+      Vector_t<recob::Hit const*> hits; ///< Hits (`nullptr` if missing).
+
+      /// Metadata of the hits in the association.
+      Vector_t<recob::TrackHitMeta const*> metadata;
+
+    }; // struct TrackHitMetaStorage
+
+  } // namespace details
+
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Hits of a track with their association metadata.
+   * @ingroup LArSoftProxyTracks
+   * @see `proxy::withHitMetadata()`
+   *
+   * This object presents the hits associated with a single track and the
+   * `recob::TrackHitMeta` of each association, as contiguous sequences
+   * with the same order: `hits()[i]` has metadata `metadata()[i]`.
+   * All pointers have been resolved when the track collection proxy was
+   * created, and accessing them is a plain array read.
+   *
+   * The object shares the data with the collection proxy it comes from, and it
+   * stays valid after that proxy is destroyed.
+   */
+  class TrackHitsWithMetadata {
+
+      public:
+    /// Type of sequence of _art_ pointers to the hits.
+    using hit_ptrs_t
+      = lar::RangeAsCollection_t<art::Ptr<recob::Hit> const*>;
+
+    /// Type of sequence of pointers to the hits.
+    using hits_t = lar::RangeAsCollection_t<recob::Hit const* const*>;
+
+    /// Type of sequence of pointers to the association metadata.
+    using metadata_t
+      = lar::RangeAsCollection_t<recob::TrackHitMeta const* const*>;
+
+    /// Type of the shared data of all tracks.
+    using storage_t = details::TrackHitMetaStorage;
+
+    /// Constructor: hits of track with the specified `index` in `storage`.
+    TrackHitsWithMetadata
+      (std::shared_ptr<storage_t const> storage, std::size_t index)
+      : fStorage(std::move(storage))
+      , fBegin(fStorage->offsets[index])
+      , fEnd(fStorage->offsets[index + 1])
+      {}
+
+    /// Returns the number of hits of this track.
+    std::size_t size() const { return fEnd - fBegin; }
+
+    /// Returns whether this track has no hits.
+    bool empty() const { return fBegin == fEnd; }
+
+    /// Returns the _art_ pointers to the hits of this track.
+    hit_ptrs_t hitPtrs() const { return makeView(fStorage->hitPtrs); }
+
+    /// Returns the pointers to the hits of this track (`nullptr` if missing).
+    hits_t hits() const { return makeView(fStorage->hits); }
+
+    /// Returns the pointers to the metadata of the hits of this track.
+    metadata_t metadata() const { return makeView(fStorage->metadata); }
+
+      private:
+    std::shared_ptr<storage_t const> fStorage; ///< Data of all tracks.
+    std::size_t fBegin; ///< Position of the first hit of this track.
+    std::size_t fEnd; ///< Position after the last hit of this track.
+
+    /// Returns a view of the part of `coll` pertaining this track.
+    template <typename Coll>
+    auto makeView(Coll const& coll) const
+      -> lar::RangeAsCollection_t<typename Coll::value_type const*>
+      {
+        return lar::makeCollectionView
+          (coll.data() + fBegin, coll.data() + fEnd);
+      }
+
+  }; // class TrackHitsWithMetadata
+
+
+  namespace details {
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Auxiliary data with the hits and metadata of all the tracks.
+     * @tparam Tag the tag labelling this auxiliary data
+     *
+     * The data is read from a `art::Assns<recob::Track, recob::Hit,
+     * recob::TrackHitMeta>` association and indexed once; the association
+     * does not need to be sorted by track. The elements of this collection
+     * are `proxy::TrackHitsWithMetadata` objects.
+     */
+    template <typename Tag>
+    class TrackHitMetaIndex {
+
+        public:
+      using tag = Tag; ///< Tag of this data.
+
+      /// Type of the data of a single track.
+      using auxiliary_data_t = util::add_tag_t<TrackHitsWithMetadata, tag>;
+
+      /// Type of the source association.
+      using assns_t
+        = art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta>;
+
+      /// Constructor: indexes the association for `nTracks` tracks.
+      TrackHitMetaIndex(assns_t const& assns, std::size_t nTracks);
+
+      /// Returns the hits with metadata of the track with the specified index.
+      auxiliary_data_t operator[] (std::size_t index) const
+        { return auxiliary_data_t(fStorage, index); }
+
+      /// Returns the number of tracks in the index.
+      std::size_t size() const { return fStorage->offsets.size() - 1U; }
+
+      /// Returns whether this data is labeled with the specified tag.
+      template <typename TestTag>
+      static constexpr bool hasTag() { return std::is_same<TestTag, tag>(); }
+
+        private:
+      /// The index, shared with all the elements.
+      std::shared_ptr<TrackHitMetaStorage const> fStorage;
+
+    }; // class TrackHitMetaIndex<>
+
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Helper to merge a `TrackHitMetaIndex` into a track proxy.
+     * @tparam Tag the tag labelling the auxiliary data
+     *
+     * The association is read with the specified input tag, or with the one
+     * of the main data product if none is specified.
+     */
+    template <typename Tag>
+    class WithTrackHitMetaStruct {
+
+        public:
+      /// Constructor: the association will have the same tag as the tracks.
+      WithTrackHitMetaStruct() = default;
+
+      /// Constructor: the association will be read with the specified tag.
+      WithTrackHitMetaStruct(art::InputTag const& inputTag)
+        : fInputTag(inputTag) {}
+
+      /// Reads the association and creates the index.
+      template
+        <typename CollProxy, typename Event, typename Handle, typename MainArgs>
+      auto createAuxProxyMaker
+        (Event const& event, Handle&& mainHandle, MainArgs const& mainArgs)
+        {
+          using index_t = TrackHitMetaIndex<Tag>;
+          auto const& assns
+            = *(event.template getValidHandle<typename index_t::assns_t>
+              (fInputTag.value_or(art::InputTag(mainArgs))));
+          return index_t(assns, mainHandle->size());
+        } // createAuxProxyMaker()
+
+      /// Returns a string identifying this request.
+      /// @see `proxy::ProxyCache`
+      std::string cacheKey() const
+        { return "[hitmeta:" + (fInputTag? fInputTag->encode(): "") + "]"; }
+
+        private:
+      std::optional<art::InputTag> fInputTag; ///< Tag of the association.
+
+    }; // class WithTrackHitMetaStruct<>
+
+
+    //--------------------------------------------------------------------------
+
+  } // namespace details
+
+} // namespace proxy
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Tag>
+proxy::details::TrackHitMetaIndex<Tag>::TrackHitMetaIndex
+  (assns_t const& assns, std::size_t nTracks)
+{
+  auto storage = std::make_shared<TrackHitMetaStorage>();
+
+  // count the hits of each track first, then fill all the arrays at once
+  std::size_t const nHits = assns.size();
+  auto& offsets = storage->offsets;
+  offsets.assign(nTracks + 1, 0U);
+  for (std::size_t i = 0; i < nHits; ++i) {
+    std::size_t const trackKey = assns[i].first.key();
+    if (trackKey >= nTracks) continue; // not one of our tracks
+    ++offsets[trackKey + 1];
+  } // for
+  for (std::size_t iTrack = 0; iTrack < nTracks; ++iTrack)
+    offsets[iTrack + 1] += offsets[iTrack];
+
+  storage->hitPtrs.resize(offsets.back());
+  storage->hits.resize(offsets.back(), nullptr);
+  storage->metadata.resize(offsets.back(), nullptr);
+
+  std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+  for (std::size_t i = 0; i < nHits; ++i) {
+    auto const& assn = assns[i];
+    std::size_t const trackKey = assn.first.key();
+    if (trackKey >= nTracks) continue;
+    std::size_t const pos = next[trackKey]++;
+    art::Ptr<recob::Hit> const& hitPtr = storage->hitPtrs[pos] = assn.second;
+    storage->hits[pos] = hitPtr? hitPtr.get(): nullptr;
+    storage->metadata[pos] = &(assns.data(i));
+  } // for
+
+  fStorage = std::move(storage);
+
+} // proxy::details::TrackHitMetaIndex<>::TrackHitMetaIndex()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_RECOBASEPROXY_TRACKHITMETAINDEX_H
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   DedxStepper.h
+///
+/// \brief  Error-controlled integration of the energy loss.
+///
+/// \date   October 14, 2026
+///
+/// The energy loss along a step of length s is the solution of
+///
+/// dE/dx = -f(E)
+///
+/// where f is the stopping power.  The propagators solve it with one
+/// midpoint step, and limit the step length so that a fixed fraction
+/// of the kinetic energy is lost.  This is more than needed where f
+/// is nearly constant (minimum ionizing particles), and not always
+/// enough where f changes quickly (stopping protons).
+///
+/// The functions below control the step length with the difference
+/// between the Euler and the midpoint steps (embedded first and second
+/// order Runge-Kutta pair), which estimates the error of the energy
+/// after the step.  The tolerance is relative to the kinetic energy at
+/// the start of each step.
+///
+/// The stopping power is passed as a callable of the momentum (GeV/c)
+/// returning GeV/cm, e.g. wrapping DedxTable::Eloss.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef DEDXSTEPPER_H
+#define DEDXSTEPPER_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace trkf {
+
+  /// Estimate of the longest step (cm) meeting the tolerance.
+  ///
+  /// Arguments:
+  ///
+  /// dedx      - Stopping power (GeV/cm) as a function of momentum.
+  /// e         - Energy at the start of the step (GeV).
+  /// mass      - Mass (GeV).
+  /// tolerance - Relative tolerance on the kinetic energy.
+  /// strial    - Trial step length (cm, positive), e.g. the fixed rule.
+  ///
+  /// The error of the trial step is scaled to the tolerance assuming
+  /// that it is quadratic in the step length.
+  ///
+  template <class F>
+  double dedxStepLength(F&& dedx, double e, double mass, double tolerance, double strial)
+  {
+    const double f1 = dedx(std::sqrt(e*e - mass*mass));
+    const double emid = e - 0.5 * strial * f1;
+    if(emid <= mass)
+      return 0.5 * strial;
+    const double err = strial * std::abs(dedx(std::sqrt(emid*emid - mass*mass)) - f1);
+    const double scale = tolerance * (e - mass);
+    if(err <= 0.)
+      return HUGE_VAL;
+    return strial * std::sqrt(scale / err);
+  }
+
+  /// Integrate the energy loss over a step, with step length control.
+  ///
+  /// Arguments:
+  ///
+  /// dedx      - Stopping power (GeV/cm) as a function of momentum.
+  /// e1        - Initial energy (GeV).
+  /// mass      - Mass (GeV).
+  /// s         - Distance (cm, negative for backward propagation).
+  /// tolerance - Relative tolerance on the kinetic energy (positive).
+  /// e2        - Returned final energy (GeV).
+  /// nsteps    - Incremented by the number of accepted steps.
+  ///
+  /// Returned value: false if the particle stops, or if the number of
+  /// steps exceeds a large maximum.
+  ///
+  template <class F>
+  bool integrateDedx(F&& dedx, double e1, double mass, double s, double tolerance,
+		     double& e2, unsigned long& nsteps)
+  {
+    const int nitmax = 1000;
+    double e = e1;
+    double remaining = s;
+    double h = s;   // First try the full step.
+    for(int nit = 0; remaining != 0.; ++nit) {
+      if(nit > nitmax)
+	return false;
+      if(std::abs(h) > std::abs(remaining))
+	h = remaining;
+      const double f1 = dedx(std::sqrt(e*e - mass*mass));
+      const double emid = e - 0.5 * h * f1;
+      if(emid <= mass) {
+	h *= 0.5;
+	continue;
+      }
+      const double fmid = dedx(std::sqrt(emid*emid - mass*mass));
+      const double err = std::abs(h * (fmid - f1));
+      const double scale = tolerance * (e - mass);
+      const double factor = (err > 0. ? 0.9 * std::sqrt(scale / err) : 4.);
+      if(err <= scale) {
+	e -= h * fmid;
+	if(e <= mass)
+	  return false;
+	remaining -= h;
+	++nsteps;
+	h *= std::min(4., factor);
+      }
+      else
+	h *= std::max(0.1, factor);
+    }
+    e2 = e;
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   DedxTable.cxx
+///
+/// \brief  Tabulated energy loss for one particle mass.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include "lardata/RecoObjects/DedxTable.h"
+#include "lardataalg/DetectorInfo/DetectorProperties.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  /// Shared tables, and the mutex protecting them.
+  std::mutex gTablesMutex;
+  std::vector<std::shared_ptr<const trkf::DedxTable> > gTables;
+
+  /// Generation of the shared tables (incremented by clear).
+  std::atomic<unsigned long> gGeneration(0);
+
+}
+
+namespace trkf {
+
+  /// Constructor.
+  ///
+  /// Arguments:
+  ///
+  /// detprop    - Detector properties provider.
+  /// mass       - Particle mass (GeV/c^2).
+  /// tcut       - Maximum delta ray energy (MeV).
+  /// pmin       - Minimum tabulated momentum (GeV/c).
+  /// pmax       - Maximum tabulated momentum (GeV/c).
+  /// nperdecade - Number of grid points per decade of momentum.
+  ///
+  DedxTable::DedxTable(const detinfo::DetectorProperties* detprop, double mass, double tcut,
+		       double pmin, double pmax, int nperdecade) :
+    fDetProp(detprop),
+    fDensity(0.),
+    fMass(mass),
+    fTcut(tcut),
+    fPmin(pmin),
+    fPmax(pmax),
+    fLogPmin(0.),
+    fInvStep(0.)
+  {
+    if(fDetProp == 0)
+      throw cet::exception("DedxTable") << "No detector properties provider.\n";
+    if(pmin <= 0. || pmax <= pmin || nperdecade <= 0)
+      throw cet::exception("DedxTable") << "Bad table range " << pmin << " - " << pmax
+					<< " GeV/c, " << nperdecade << " points per decade.\n";
+
+    fDensity = fDetProp->Density();
+    fLogPmin = std::log(fPmin);
+    fInvStep = nperdecade / std::log(10.);
+    unsigned int nbins = std::ceil((std::log(fPmax) - fLogPmin) * fInvStep);
+    fPmax = fPmin * std::exp(nbins / fInvStep);
+
+    fEloss.reserve(nbins + 1);
+    fElossVar.reserve(nbins + 1);
+    for(unsigned int i = 0; i <= nbins; ++i) {
+      double p = fPmin * std::exp(i / fInvStep);
+      fEloss.push_back(fDetProp->Eloss(p, fMass, fTcut));
+      fElossVar.push_back(fDetProp->ElossVar(p, fMass));
+    }
+  }
+
+  /// Destructor.
+  DedxTable::~DedxTable()
+  {}
+
+  /// Is this table valid for the specified provider, mass and tcut?
+  ///
+  /// The table is valid if it was built from the same provider, with
+  /// the current density of that provider.
+  ///
+  bool DedxTable::isValid(const detinfo::DetectorProperties* detprop,
+			  double mass, double tcut) const
+  {
+    return detprop == fDetProp && mass == fMass && tcut == fTcut &&
+      detprop->Density() == fDensity;
+  }
+
+  /// Find interpolation bin and fraction.
+  ///
+  /// Arguments:
+  ///
+  /// p - Momentum (GeV/c).
+  /// i - Lower grid point (returned).
+  /// f - Fraction of the step from grid point i (returned).
+  ///
+  /// Returned value: true if p is in the table range.
+  ///
+  bool DedxTable::locate(double p, unsigned int& i, double& f) const
+  {
+    if(!(p >= fPmin && p < fPmax))
+      return false;
+    double x = (std::log(p) - fLogPmin) * fInvStep;
+    i = x;
+    if(i + 1 >= fEloss.size())
+      return false;
+    f = x - i;
+    return true;
+  }
+
+  /// Interpolated stopping power (MeV/cm).
+  double DedxTable::Eloss(double p) const
+  {
+    unsigned int i;
+    double f;
+    if(!locate(p, i, f))
+      return fDetProp->Eloss(p, fMass, fTcut);
+    return fEloss[i] + f * (fEloss[i+1] - fEloss[i]);
+  }
+
+  /// Interpolated energy loss variance (MeV^2/cm).
+  double DedxTable::ElossVar(double p) const
+  {
+    unsigned int i;
+    double f;
+    if(!locate(p, i, f))
+      return fDetProp->ElossVar(p, fMass);
+    return fElossVar[i] + f * (fElossVar[i+1] - fElossVar[i]);
+  }
+
+  /// Get the shared table for a provider, mass and tcut.
+  ///
+  /// Arguments:
+  ///
+  /// detprop - Detector properties provider.
+  /// mass    - Particle mass (GeV/c^2).
+  /// tcut    - Maximum delta ray energy (MeV).
+  ///
+  /// The table is built the first time it is asked for, and again
+  /// whenever the provider or its density changes.  Each thread
+  /// remembers the last table it used, so that repeated calls for the
+  /// same particle do not need to take the lock.
+  ///
+  std::shared_ptr<const DedxTable> DedxTable::get(const detinfo::DetectorProperties* detprop,
+						  double mass, double tcut)
+  {
+    thread_local std::shared_ptr<const DedxTable> last;
+    thread_local unsigned long last_generation = 0;
+
+    if(last.get() != 0 && last_generation == gGeneration &&
+       last->isValid(detprop, mass, tcut))
+      return last;
+
+    std::lock_guard<std::mutex> lock(gTablesMutex);
+    last_generation = gGeneration;
+    for(auto& ptable : gTables) {
+      if(ptable->getMass() == mass && ptable->getTcut() == tcut) {
+	if(!ptable->isValid(detprop, mass, tcut))
+	  ptable = std::make_shared<const DedxTable>(detprop, mass, tcut);
+	last = ptable;
+	return last;
+      }
+    }
+    gTables.push_back(std::make_shared<const DedxTable>(detprop, mass, tcut));
+    last = gTables.back();
+    return last;
+  }
+
+  /// Forget all shared tables.
+  ///
+  /// Tables still in use stay valid, but they will not be handed out
+  /// again by get.
+  ///
+  void DedxTable::clear()
+  {
+    std::lock_guard<std::mutex> lock(gTablesMutex);
+    gTables.clear();
+    ++gGeneration;
+  }
+}
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   DedxTable.h
+///
+/// \brief  Tabulated energy loss for one particle mass.
+///
+/// This class holds the stopping power (DetectorProperties::Eloss) and
+/// the energy loss variance (DetectorProperties::ElossVar) of one
+/// particle mass and delta ray energy cut, tabulated on a grid uniform
+/// in log(p), and returns values interpolated linearly in log(p).
+/// With the default grid (100 points per decade), the interpolated
+/// values agree with the exact formulas to a few 1e-4 (relative),
+/// except within one grid step of a kink of the formula.
+/// Outside of the table range, the exact formulas are used.
+///
+/// Tables are normally obtained from method get, which builds each
+/// table once and shares it.  A table remembers the detector
+/// properties provider and the density it was built with, and get
+/// makes a new table when either of them changes (e.g. at a new run).
+/// Method get is safe to use from several threads.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef DEDXTABLE_H
+#define DEDXTABLE_H
+
+#include <memory>
+#include <vector>
+
+namespace detinfo {
+  class DetectorProperties;
+}
+
+namespace trkf {
+
+  class DedxTable
+  {
+  public:
+
+    /// Constructor (builds the table).
+    DedxTable(const detinfo::DetectorProperties* detprop, double mass, double tcut,
+	      double pmin = 1.e-3, double pmax = 1.e3, int nperdecade = 100);
+
+    /// Destructor.
+    ~DedxTable();
+
+    // Accessors.
+
+    double getMass() const {return fMass;}
+    double getTcut() const {return fTcut;}
+    double getPmin() const {return fPmin;}
+    double getPmax() const {return fPmax;}
+    unsigned int size() const {return fEloss.size();}
+
+    /// Is this table valid for the specified provider, mass and tcut?
+    bool isValid(const detinfo::DetectorProperties* detprop, double mass, double tcut) const;
+
+    // Interpolated values.
+
+    /// Stopping power (MeV/cm), same as DetectorProperties::Eloss.
+    double Eloss(double p) const;
+
+    /// Energy loss variance (MeV^2/cm), same as DetectorProperties::ElossVar.
+    double ElossVar(double p) const;
+
+    // Shared tables.
+
+    /// Get the shared table for a provider, mass and tcut (built if needed).
+    static std::shared_ptr<const DedxTable> get(const detinfo::DetectorProperties* detprop,
+						double mass, double tcut);
+
+    /// Forget all shared tables.
+    static void clear();
+
+  private:
+
+    /// Find interpolation bin and fraction (false if out of range).
+    bool locate(double p, unsigned int& i, double& f) const;
+
+    // Attributes.
+
+    const detinfo::DetectorProperties* fDetProp;  ///< Detector properties provider.
+    double fDensity;                              ///< Density at construction (g/cm^3).
+    double fMass;                                 ///< Particle mass (GeV/c^2).
+    double fTcut;                                 ///< Maximum delta ray energy (MeV).
+    double fPmin;                                 ///< Minimum tabulated momentum (GeV/c).
+    double fPmax;                                 ///< Maximum tabulated momentum (GeV/c).
+    double fLogPmin;                              ///< log(fPmin).
+    double fInvStep;                              ///< Inverse of log(p) step.
+    std::vector<double> fEloss;                   ///< Stopping power at grid points.
+    std::vector<double> fElossVar;                ///< Energy loss variance at grid points.
+  };
+}
+
+#endif
@@ -8,6 +8,7 @@
 ///
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cmath>
 #include "lardata/RecoObjects/InteractGeneral.h"
 #include "lardata/RecoObjects/SurfXYZPlane.h"
@@ -92,4 +93,66 @@ namespace trkf {
 
     return true;
   }
+
+  /// Calculate noise matrices for several path distances.
+  ///
+  /// Arguments:
+  ///
+  /// trk            - Original track.
+  /// s              - Path distances.
+  /// noise_matrices - Resultant noise matrices (one per distance).
+  ///
+  /// Returns: True if success.
+  ///
+  /// The zero distance propagation and the transformation are done
+  /// once, on the noise terms of the plane interactor.
+  ///
+  bool InteractGeneral::noise(const KTrack& trk, const std::vector<double>& s,
+			      std::vector<TrackError>& noise_matrices) const
+  {
+    // Get track position and direction.
+
+    double xyz[3];
+    double mom[3];
+    trk.getPosition(xyz);
+    trk.getMomentum(mom);
+
+    // Propagate track to a plane normal to the track direction.
+
+    std::shared_ptr<Surface> psurf(new SurfXYZPlane(xyz[0], xyz[1], xyz[2],
+						    mom[0], mom[1], mom[2]));
+    TrackMatrix prop_matrix;
+    KTrack temp_trk = trk;
+    boost::optional<double> result = fProp.short_vec_prop(temp_trk, psurf, Propagator::UNKNOWN,
+							  false, &prop_matrix);
+    if(!result)
+      return false;
+
+    // Calculate noise terms on plane surface, and transform each of
+    // them to original surface.
+
+    InteractPlane::NoiseTerms terms;
+    fInteract.noise_terms(temp_trk, terms);
+
+    invert(prop_matrix);
+    double* const term_arrays[3] = {terms.lin, terms.quad, terms.cubic};
+    for(double* term : term_arrays) {
+      TrackError plane_term(5);
+      std::copy(term, term + InteractPlane::NoiseTerms::size, &plane_term.data()[0]);
+      TrackMatrix temp = prod(plane_term, trans(prop_matrix));
+      TrackMatrix temp2 = prod(prop_matrix, temp);
+      TrackError general_term = ublas::symmetric_adaptor<TrackMatrix>(temp2);
+      std::copy(&general_term.data()[0], &general_term.data()[0] + InteractPlane::NoiseTerms::size, term);
+    }
+
+    // Combine the terms for each distance.
+
+    noise_matrices.resize(s.size());
+    for(unsigned int i = 0; i < s.size(); ++i)
+      InteractPlane::combine_terms(terms, s[i], noise_matrices[i]);
+
+    // Done (success).
+
+    return true;
+  }
 } // end namespace trkf
@@ -39,6 +39,10 @@ namespace trkf {
     /// Calculate noise matrix.
     virtual bool noise(const KTrack& trk, double s, TrackError& noise_matrix) const;
 
+    /// Calculate noise matrices for several path distances.
+    virtual bool noise(const KTrack& trk, const std::vector<double>& s,
+		       std::vector<TrackError>& noise_matrices) const;
+
   private:
 
     // Data members.
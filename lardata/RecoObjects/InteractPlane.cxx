@@ -8,6 +8,7 @@
 ///
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cmath>
 #include "lardata/RecoObjects/InteractPlane.h"
 #include "lardata/RecoObjects/SurfPlane.h"
@@ -69,11 +70,55 @@ namespace trkf {
   ///
   bool InteractPlane::noise(const KTrack& trk, double s, TrackError& noise_matrix) const
   {
-    // Get LAr service.
+    // If distance is zero, return zero noise.
 
-    auto const * larprop = lar::providerFrom<detinfo::LArPropertiesService>();
-    auto const * detprop = lar::providerFrom<detinfo::DetectorPropertiesService>();
+    if(s == 0.) {
+      noise_matrix.resize(5, false);
+      noise_matrix.clear();
+      return true;
+    }
+
+    NoiseTerms terms;
+    noise_terms(trk, terms);
+    combine_terms(terms, s, noise_matrix);
+
+    // Done (success).
+
+    return true;
+  }
+
+  /// Calculate noise matrices for several path distances.
+  ///
+  /// Arguments:
+  ///
+  /// trk            - Original track.
+  /// s              - Path distances.
+  /// noise_matrices - Resultant noise matrices (one per distance).
+  ///
+  /// Returns: True if success.
+  ///
+  /// The noise terms of the track are calculated once.
+  ///
+  bool InteractPlane::noise(const KTrack& trk, const std::vector<double>& s,
+			    std::vector<TrackError>& noise_matrices) const
+  {
+    NoiseTerms terms;
+    noise_terms(trk, terms);
+    noise_matrices.resize(s.size());
+    for(unsigned int i = 0; i < s.size(); ++i)
+      combine_terms(terms, s[i], noise_matrices[i]);
+    return true;
+  }
 
+  /// Calculate the noise terms of a track (see method noise).
+  ///
+  /// Arguments:
+  ///
+  /// trk   - Original track.
+  /// terms - Resultant noise terms.
+  ///
+  void InteractPlane::noise_terms(const KTrack& trk, NoiseTerms& terms) const
+  {
     // Make sure we are on a plane surface (throw exception if not).
 
     const SurfPlane* psurf = dynamic_cast<const SurfPlane*>(&*trk.getSurface());
@@ -81,9 +126,11 @@ namespace trkf {
       throw cet::exception("InteractPlane")
 	<< "InteractPlane called for non-planar surface.\n";
 
-    // Clear noise matrix.
+    // Clear noise terms.
 
-    noise_matrix.clear();
+    std::fill(terms.lin, terms.lin + NoiseTerms::size, 0.);
+    std::fill(terms.quad, terms.quad + NoiseTerms::size, 0.);
+    std::fill(terms.cubic, terms.cubic + NoiseTerms::size, 0.);
 
     // Unpack track parameters.
 
@@ -93,10 +140,15 @@ namespace trkf {
     double pinv = vec[4];
     double mass = trk.Mass();
 
-    // If distance is zero, or momentum is infinite, return zero noise.
+    // If momentum is infinite, return zero noise.
 
-    if(pinv == 0. || s == 0.)
-      return true;
+    if(pinv == 0.)
+      return;
+
+    // Get LAr service.
+
+    auto const * larprop = lar::providerFrom<detinfo::LArPropertiesService>();
+    auto const * detprop = lar::providerFrom<detinfo::DetectorPropertiesService>();
 
     // Make a crude estimate of the range of the track.
 
@@ -114,69 +166,81 @@ namespace trkf {
 
     double x0 = larprop->RadiationLength() / detprop->Density();
 
-    // Calculate projected rms scattering angle.
+    // Calculate projected rms scattering angle per unit path distance
+    // (theta0^2 = theta02 * |s|).
     // Use the estimted range in the logarithm factor.
     // Use the incremental propagation distance in the square root factor.
 
     double betainv = std::sqrt(1. + pinv*pinv * mass*mass);
     double theta_fact = (0.0136 * pinv * betainv) * (1. + 0.038 * std::log(range/x0));
-    double theta02 = theta_fact*theta_fact * std::abs(s/x0);
+    double theta02 = theta_fact*theta_fact / x0;
 
-    // Calculate some sommon factors needed for multiple scattering.
+    // Calculate some sommon factors needed for multiple scattering
+    // (dist2_3 = s^2/3 and dist_2 = |s|/2 per unit path distance).
 
     double ufact2 = 1. + dudw*dudw;
     double vfact2 = 1. + dvdw*dvdw;
     double uvfact2 = 1. + dudw*dudw + dvdw*dvdw;
     double uvfact = std::sqrt(uvfact2);
     double uv = dudw * dvdw;
-    double dist2_3 = s*s / 3.;
-    double dist_2 = std::abs(s) / 2.;
+    double dist2_3 = 1. / 3.;
+    double dist_2 = 1. / 2.;
     if(trk.getDirection() == Surface::BACKWARD)
       dist_2 = -dist_2;
 
-    // Calculate energy loss fluctuations.
+    // Calculate energy loss fluctuations per unit path distance.
 
-    double evar = 1.e-6 * detprop->ElossVar(p, mass) * std::abs(s); // E variance (GeV^2).
-    double pinvvar = evar * e2 / (p2*p2*p2);                        // Inv. p variance (1/GeV^2)
+    double evar = 1.e-6 * detprop->ElossVar(p, mass);   // E variance (GeV^2).
+    double pinvvar = evar * e2 / (p2*p2*p2);            // Inv. p variance (1/GeV^2)
 
-    // Fill elements of noise matrix.
+    // Fill elements of noise terms (index i*(i+1)/2 + j of element (i,j)).
 
     // Position submatrix.
 
-    noise_matrix(0,0) = dist2_3 * theta02 * ufact2;           // sigma^2(u,u)
-    noise_matrix(1,0) = dist2_3 * theta02 * uv;               // sigma^2(u,v)
-    noise_matrix(1,1) = dist2_3 * theta02 * vfact2;           // sigma^2(v,v)
+    terms.cubic[0] = dist2_3 * theta02 * ufact2;          // sigma^2(u,u)
+    terms.cubic[1] = dist2_3 * theta02 * uv;              // sigma^2(u,v)
+    terms.cubic[2] = dist2_3 * theta02 * vfact2;          // sigma^2(v,v)
 
     // Slope submatrix.
 
-    noise_matrix(2,2) = theta02 * uvfact2 * ufact2;           // sigma^2(u', u')
-    noise_matrix(3,2) = theta02 * uvfact2 * uv;               // sigma^2(v', u')
-    noise_matrix(3,3) = theta02 * uvfact2 * vfact2;           // sigma^2(v', v')
+    terms.lin[5] = theta02 * uvfact2 * ufact2;            // sigma^2(u', u')
+    terms.lin[8] = theta02 * uvfact2 * uv;                // sigma^2(v', u')
+    terms.lin[9] = theta02 * uvfact2 * vfact2;            // sigma^2(v', v')
 
     // Same-view position-slope correlations.
 
-    noise_matrix(2,0) = dist_2 * theta02 * uvfact * ufact2;   // sigma^2(u', u)
-    noise_matrix(3,1) = dist_2 * theta02 * uvfact * vfact2;   // sigma^2(v', v)
+    terms.quad[3] = dist_2 * theta02 * uvfact * ufact2;   // sigma^2(u', u)
+    terms.quad[7] = dist_2 * theta02 * uvfact * vfact2;   // sigma^2(v', v)
 
     // Opposite-view position-slope correlations.
 
-    noise_matrix(2,1) = dist_2 * theta02 * uvfact * uv;       // sigma^2(u', v)
-    noise_matrix(3,0) = dist_2 * theta02 * uvfact * uv;       // sigma^2(v', u)
+    terms.quad[4] = dist_2 * theta02 * uvfact * uv;       // sigma^2(u', v)
+    terms.quad[6] = dist_2 * theta02 * uvfact * uv;       // sigma^2(v', u)
 
     // Momentum correlations (zero).
 
-    noise_matrix(4,0) = 0.;                                   // sigma^2(pinv, u)
-    noise_matrix(4,1) = 0.;                                   // sigma^2(pinv, v)
-    noise_matrix(4,2) = 0.;                                   // sigma^2(pinv, u')
-    noise_matrix(4,3) = 0.;                                   // sigma^2(pinv, v')
-
     // Energy loss fluctuations.
 
-    noise_matrix(4,4) = pinvvar;                              // sigma^2(pinv, pinv)
-
-    // Done (success).
+    terms.lin[14] = pinvvar;                              // sigma^2(pinv, pinv)
+  }
 
-    return true;
+  /// Noise matrix for path distance s from the noise terms.
+  ///
+  /// Arguments:
+  ///
+  /// terms        - Noise terms of the track.
+  /// s            - Path distance.
+  /// noise_matrix - Resultant noise matrix.
+  ///
+  void InteractPlane::combine_terms(const NoiseTerms& terms, double s, TrackError& noise_matrix)
+  {
+    double const a = std::abs(s);
+    double const b = s*s;
+    double const c = a*b;
+    noise_matrix.resize(5, false);
+    double* const out = &noise_matrix.data()[0];
+    for(unsigned int i = 0; i < NoiseTerms::size; ++i)
+      out[i] = a*terms.lin[i] + b*terms.quad[i] + c*terms.cubic[i];
   }
 
 } // end namespace trkf
@@ -11,6 +11,12 @@
 /// has a local Cartesian coordinate system in which the track
 /// parameters are (u, v, u'=du/dw, v'=dv/dw, q/p).
 ///
+/// For a given track, the noise matrix is a sum of three fixed
+/// matrices weighted by |s|, s^2 and |s|^3 (NoiseTerms).  The terms
+/// require the service lookups and transcendental functions, and are
+/// calculated once per track.  The noise matrices for any number of
+/// path distances are then simple weighted sums (batch noise method).
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef INTERACTPLANE_H
@@ -24,6 +30,16 @@ namespace trkf {
   {
   public:
 
+    /// Noise matrix of path distance s is lin*|s| + quad*s^2 + cubic*|s|^3.
+    /// The elements are in the packed storage order of TrackError.
+    struct NoiseTerms
+    {
+      static constexpr unsigned int size = 15;  ///< Elements of a 5x5 symmetric matrix.
+      double lin[size];     ///< Slope and momentum terms.
+      double quad[size];    ///< Position-slope correlation terms.
+      double cubic[size];   ///< Position terms.
+    };
+
     /// Constructor.
     InteractPlane(double tcut);
 
@@ -37,6 +53,18 @@ namespace trkf {
 
     /// Calculate noise matrix.
     virtual bool noise(const KTrack& trk, double s, TrackError& noise_matrix) const;
+
+    /// Calculate noise matrices for several path distances.
+    virtual bool noise(const KTrack& trk, const std::vector<double>& s,
+		       std::vector<TrackError>& noise_matrices) const;
+
+    // Methods.
+
+    /// Calculate the noise terms of a track.
+    void noise_terms(const KTrack& trk, NoiseTerms& terms) const;
+
+    /// Noise matrix for path distance s from the noise terms.
+    static void combine_terms(const NoiseTerms& terms, double s, TrackError& noise_matrix);
   };
 }
 
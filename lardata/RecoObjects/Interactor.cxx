@@ -26,4 +26,26 @@ namespace trkf {
   Interactor::~Interactor()
   {}
 
+  /// Calculate noise matrices for several path distances.
+  ///
+  /// Arguments:
+  ///
+  /// trk            - Original track.
+  /// s              - Path distances.
+  /// noise_matrices - Resultant noise matrices (one per distance).
+  ///
+  /// Returns: True if success for all distances.
+  ///
+  bool Interactor::noise(const KTrack& trk, const std::vector<double>& s,
+			 std::vector<TrackError>& noise_matrices) const
+  {
+    noise_matrices.resize(s.size());
+    bool ok = true;
+    for(unsigned int i = 0; i < s.size(); ++i) {
+      noise_matrices[i].resize(trk.getVector().size(), false);
+      ok = noise(trk, s[i], noise_matrices[i]) && ok;
+    }
+    return ok;
+  }
+
 } // end namespace trkf
@@ -14,11 +14,17 @@
 /// associated with the propagation of a track over a specified
 /// distance.
 ///
+/// Virtual method "noise" with a vector of distances calculates the
+/// noise matrices of several propagations of the same track, e.g. to
+/// several destination surfaces.  The default implementation calls
+/// the single distance method for each distance.
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef INTERACTOR_H
 #define INTERACTOR_H
 
+#include <vector>
 #include "lardata/RecoObjects/KalmanLinearAlgebra.h"
 #include "lardata/RecoObjects/KTrack.h"
 
@@ -46,6 +52,10 @@ namespace trkf {
     /// Calculate noise matrix.
     virtual bool noise(const KTrack& trk, double s, TrackError& noise_matrix) const = 0;
 
+    /// Calculate noise matrices for several path distances.
+    virtual bool noise(const KTrack& trk, const std::vector<double>& s,
+		       std::vector<TrackError>& noise_matrices) const;
+
   private:
 
     // Attributes.
@@ -9,6 +9,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <cstddef>
 #include "lardata/RecoObjects/KETrack.h"
 #include "cetlib_except/exception.h"
 
@@ -92,6 +93,9 @@ namespace trkf {
   /// because the sum of the two error matrices is singular, in which
   /// case the success flag embedded in the return value is false.
   ///
+  /// The track parameters and error matrices may have at most MaxDim
+  /// dimensions (throw exception if not, or if they are not consistent).
+  ///
   boost::optional<double> KETrack::combineTrack(const KETrack& tre)
   {
     // Make sure that the two track surfaces are the same.
@@ -138,39 +142,83 @@ namespace trkf {
       err2 = terr;
     }
 
+    // The combination is calculated directly on the packed storage of
+    // the symmetric matrices (lower triangle, row major), without
+    // ublas temporaries.  Only one (symmetric, in situ) inversion is
+    // needed.
+
+    const std::size_t n = vec1->size();
+    if(n > MaxDim || err1->size1() != n || err2->size1() != n || vec2->size() != n)
+      throw cet::exception("KETrack") << "Track combination dimensions are not consistent.\n";
+    const double* e1 = &err1->data()[0];
+    const double* e2 = &err2->data()[0];
+    const std::size_t npacked = n*(n+1)/2;
+
     // Calculate the difference vector and difference error matrix.
 
-    TrackVector dvec = *vec1 - *vec2;
-    TrackError derr = *err1 + *err2;
+    double dvec[MaxDim];
+    for(std::size_t i = 0; i < n; ++i)
+      dvec[i] = (*vec1)(i) - (*vec2)(i);
+    double derr[MaxDim*(MaxDim+1)/2];
+    for(std::size_t k = 0; k < npacked; ++k)
+      derr[k] = e1[k] + e2[k];
 
     // Invert the difference error matrix.
     // This is the only place where a detectable failure can occur.
 
-    bool ok = syminvert(derr);
+    bool ok = detail::packed_syminvert(derr, n);
     if(ok) {
 
-      // Calculate updated state vector.
-      // vec1 = vec1 - err1 * derr * dvec
+      // Element (i,j) of a packed symmetric matrix.
 
-      TrackVector tvec1 = prod(derr, dvec);
-      TrackVector tvec2 = prod(*err1, tvec1);
-      TrackVector tvec3 = *vec1 - tvec2;
-      setVector(tvec3);
+      auto at = [](const double* m, std::size_t i, std::size_t j)
+	{ return (i >= j)? m[i*(i+1)/2+j]: m[j*(j+1)/2+i]; };
 
-      // Calculate updated error matrix.
-      // err1 = err1 - err1 * derr * err1
+      // Gain matrix: gain = err1 * derr
 
-      TrackMatrix terr1 = prod(derr, *err1);
-      TrackMatrix terr2 = prod(*err1, terr1);
-      TrackError terr2s = ublas::symmetric_adaptor<TrackMatrix>(terr2);
-      TrackError terr3 = *err1 - terr2s;
-      setError(terr3);
+      double gain[MaxDim][MaxDim];
+      for(std::size_t i = 0; i < n; ++i) {
+	for(std::size_t j = 0; j < n; ++j) {
+	  double sum = 0.;
+	  for(std::size_t k = 0; k < n; ++k)
+	    sum += at(e1, i, k) * at(derr, k, j);
+	  gain[i][j] = sum;
+	}
+      }
 
-      // Calculate chisquare.
+      // Calculate updated state vector and chisquare.
+      // vec1 = vec1 - err1 * derr * dvec
       // chisq = dvec^T * derr * dvec
 
-      TrackVector dvec1 = prod(derr, dvec);
-      double chisq = inner_prod(dvec, dvec1);
+      TrackVector tvec(n);
+      double chisq = 0.;
+      for(std::size_t i = 0; i < n; ++i) {
+	double gd = 0.;
+	double dd = 0.;
+	for(std::size_t k = 0; k < n; ++k) {
+	  gd += gain[i][k] * dvec[k];
+	  dd += at(derr, i, k) * dvec[k];
+	}
+	tvec(i) = (*vec1)(i) - gd;
+	chisq += dvec[i] * dd;
+      }
+
+      // Calculate updated error matrix (lower triangle).
+      // err1 = err1 - err1 * derr * err1
+
+      TrackError terr(n);
+      double* te = &terr.data()[0];
+      for(std::size_t i = 0; i < n; ++i) {
+	for(std::size_t j = 0; j <= i; ++j) {
+	  double sum = 0.;
+	  for(std::size_t k = 0; k < n; ++k)
+	    sum += gain[i][k] * at(e1, k, j);
+	  te[i*(i+1)/2+j] = at(e1, i, j) - sum;
+	}
+      }
+
+      setVector(tvec);
+      setError(terr);
       result = boost::optional<double>(true, chisq);
     }
 
@@ -21,6 +21,7 @@
 #ifndef KETRACK_H
 #define KETRACK_H
 
+#include <cstddef>
 #include "lardata/RecoObjects/KTrack.h"
 #include "boost/optional.hpp"
 
@@ -30,6 +31,9 @@ namespace trkf {
   {
   public:
 
+    /// Maximum dimension of the track parameters (see combineTrack).
+    static constexpr std::size_t MaxDim = 5;
+
     /// Default constructor.
     KETrack();
 
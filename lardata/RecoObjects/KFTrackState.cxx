@@ -7,10 +7,17 @@ bool KFTrackState::updateWithHitState(const HitState& hitstate) {
   if ( (hitstate.plane().position()-fTrackState.plane().position()).Mag2()>10e-6   ) return false;
   if ( (hitstate.plane().direction()-fTrackState.plane().direction()).Mag2()>10e-6 ) return false;
   // Kalman Filter update (simplified case: 1D measurement along the same coordinate as element 0 of the track parameters)
-  SMatrixSym55 tmp;
-  tmp(0,0) = 1./(hitstate.hitMeasErr2()+fTrackState.covariance()(0,0));
-  fTrackState.setParameters( fTrackState.parameters() + fTrackState.covariance()*tmp.Col(0)*(hitstate.hitMeas() - fTrackState.parameters()(0)) );
-  fTrackState.setCovariance( (fTrackState.covariance()-ROOT::Math::Similarity(fTrackState.covariance(),tmp)) );
+  // The gain is the first column of the covariance over the combined error, and the covariance update is the rank-1
+  // product of that column with itself (equivalent to the similarity product with a matrix whose only element is (0,0)).
+  const SMatrixSym55& cov = fTrackState.covariance();
+  const SVector5 col = cov.Col(0);
+  const double weight = 1./(hitstate.hitMeasErr2()+cov(0,0));
+  SMatrixSym55 newcov = cov;
+  for (unsigned int i = 0; i < 5; ++i) {
+    for (unsigned int j = 0; j <= i; ++j) newcov(i,j) -= weight*col(i)*col(j);
+  }
+  fTrackState.setParameters( fTrackState.parameters() + col*(weight*(hitstate.hitMeas() - fTrackState.parameters()(0))) );
+  fTrackState.setCovariance( newcov );
   return true;
 }
 
@@ -29,6 +29,19 @@ namespace trkf {
     /// Update the TrackState given a HitState (they need to be on the same plane)
     bool updateWithHitState(const HitState& hitstate);
 
+    /// Compute the chi2 of each of the candidate HitStates in [begin, end) with respect to this state, which is not modified.
+    /// The chi2 values are written in sequence to out; the iterator past the last written value is returned.
+    /// The hits must be on the same plane as this state; it is responsibility of the user to enforce this.
+    template <typename HitIter, typename OutIter>
+    OutIter chi2(HitIter begin, HitIter end, OutIter out) const;
+
+    /// Return the candidate HitState in [begin, end) with the smallest chi2 with respect to this state, which is not modified.
+    /// The chi2 of the returned hit is stored in bestChi2; end is returned if there are no candidates.
+    /// The hits must be on the same plane as this state; it is responsibility of the user to enforce this.
+    /// The selected hit is then meant to be used in updateWithHitState.
+    template <typename HitIter>
+    HitIter bestHitState(HitIter begin, HitIter end, double& bestChi2) const;
+
     /// Combine the TrackState given another TrackState (they need to be on the same plane)
     bool combineWithTrackState(const TrackState& trackstate);
 
@@ -71,5 +84,35 @@ namespace trkf {
     TrackState fTrackState;
   };
 
+  template <typename HitIter, typename OutIter>
+  OutIter KFTrackState::chi2(HitIter begin, HitIter end, OutIter out) const {
+    // the state parameter and error along the measurement are the same for all the candidates
+    const double par0 = parameters()(0);
+    const double err2 = covariance()(0,0);
+    for (; begin != end; ++begin, ++out) {
+      const HitState& hitstate = *begin;
+      const double res = hitstate.hitMeas() - par0;
+      *out = res*res/(hitstate.hitMeasErr2() + err2);
+    }
+    return out;
+  }
+
+  template <typename HitIter>
+  HitIter KFTrackState::bestHitState(HitIter begin, HitIter end, double& bestChi2) const {
+    const double par0 = parameters()(0);
+    const double err2 = covariance()(0,0);
+    HitIter best = end;
+    for (; begin != end; ++begin) {
+      const HitState& hitstate = *begin;
+      const double res = hitstate.hitMeas() - par0;
+      const double chi2 = res*res/(hitstate.hitMeasErr2() + err2);
+      if (best == end || chi2 < bestChi2) {
+	best = begin;
+	bestChi2 = chi2;
+      }
+    }
+    return best;
+  }
+
 }
 #endif
@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   KFitRecord.cxx
+///
+/// \brief  Recorded inputs of a Kalman fit, for replay outside art.
+///
+/// \date   October 14, 2026
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include "lardata/RecoObjects/KFitRecord.h"
+#include "lardata/RecoObjects/KHitWireX.h"
+#include "lardata/RecoObjects/KHitWireLine.h"
+#include "lardata/RecoObjects/PropYZPlane.h"
+#include "lardata/RecoObjects/PropXYZPlane.h"
+#include "lardata/RecoObjects/PropYZLine.h"
+#include "lardata/RecoObjects/PropAny.h"
+#include "lardata/RecoObjects/SurfaceVariant.h"
+#include "larcore/Geometry/Geometry.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // Format identifier, at the start of each record.
+  const char Magic[4] = {'K', 'F', 'R', '1'};
+
+  // Surface type codes.
+  enum SurfaceCode {YZPLANE = 0, XYZPLANE = 1, YZLINE = 2};
+
+  template <typename T>
+  void put(std::ostream& out, T value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  T get(std::istream& in)
+  {
+    T value;
+    if(!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+      throw cet::exception("KFitRecord") << "Truncated record.\n";
+    return value;
+  }
+
+  // Writes the geometry of a surface (derived surfaces as their base).
+  struct SurfaceWriter
+  {
+    std::ostream& out;
+    void operator()(const trkf::SurfYZPlane& surf) const
+    {
+      put<std::int32_t>(out, YZPLANE);
+      put(out, surf.x0());
+      put(out, surf.y0());
+      put(out, surf.z0());
+      put(out, surf.phi());
+    }
+    void operator()(const trkf::SurfXYZPlane& surf) const
+    {
+      put<std::int32_t>(out, XYZPLANE);
+      put(out, surf.x0());
+      put(out, surf.y0());
+      put(out, surf.z0());
+      put(out, surf.phi());
+      put(out, surf.theta());
+    }
+    void operator()(const trkf::SurfYZLine& surf) const
+    {
+      put<std::int32_t>(out, YZLINE);
+      put(out, surf.x0());
+      put(out, surf.y0());
+      put(out, surf.z0());
+      put(out, surf.phi());
+    }
+    void operator()(const trkf::Surface&) const
+    {
+      throw cet::exception("KFitRecord") << "Surface type can not be recorded.\n";
+    }
+  };
+
+  void writeSurface(std::ostream& out, const trkf::Surface& surf)
+  {
+    trkf::visitSurface(surf, SurfaceWriter{out});
+  }
+
+  std::shared_ptr<const trkf::Surface> readSurface(std::istream& in)
+  {
+    std::int32_t code = get<std::int32_t>(in);
+    double x0 = get<double>(in);
+    double y0 = get<double>(in);
+    double z0 = get<double>(in);
+    double phi = get<double>(in);
+    switch(code) {
+    case YZPLANE:
+      return std::make_shared<trkf::SurfYZPlane>(x0, y0, z0, phi);
+    case XYZPLANE:
+      return std::make_shared<trkf::SurfXYZPlane>(x0, y0, z0, phi, get<double>(in));
+    case YZLINE:
+      return std::make_shared<trkf::SurfYZLine>(x0, y0, z0, phi);
+    }
+    throw cet::exception("KFitRecord") << "Unknown surface code " << code << ".\n";
+  }
+}
+
+namespace trkf {
+
+  /// Default constructor.
+  KFitRecord::KFitRecord() :
+    fPropType(PROPANY),
+    fTcut(0.),
+    fDoDedx(false)
+  {}
+
+  /// Constructor.
+  ///
+  /// Arguments:
+  ///
+  /// seed     - Seed track.
+  /// cont     - Measurement container (all lists are recorded).
+  /// proptype - Propagator type.
+  /// tcut     - Delta ray energy cut of the propagator.
+  /// doDedx   - dE/dx flag of the propagator.
+  ///
+  KFitRecord::KFitRecord(const KETrack& seed, const KHitContainer& cont,
+			 PropType proptype, double tcut, bool doDedx) :
+    fSeed(seed),
+    fPropType(proptype),
+    fTcut(tcut),
+    fDoDedx(doDedx)
+  {
+    addMeasurements(cont);
+  }
+
+  /// Set propagator configuration.
+  void KFitRecord::setPropagator(PropType proptype, double tcut, bool doDedx)
+  {
+    fPropType = proptype;
+    fTcut = tcut;
+    fDoDedx = doDedx;
+  }
+
+  /// Record the measurements of a container.
+  ///
+  /// Arguments:
+  ///
+  /// cont - Measurement container.
+  ///
+  /// The groups of the sorted, unsorted and unused lists are recorded,
+  /// in this order.  The supported measurements are KHitWireX,
+  /// KHitWireLine and KHitRecorded (throw an exception otherwise).
+  /// The wire pitch is taken from the geometry service.
+  ///
+  void KFitRecord::addMeasurements(const KHitContainer& cont)
+  {
+    double pitch = -1.;
+    for(const KHitContainer::HitGroupList_t* plist :
+	  {&cont.getSorted(), &cont.getUnsorted(), &cont.getUnused()}) {
+      for(const KHitGroup& gr : *plist) {
+	Group group{gr.getSurface(), gr.getPlane(), {}};
+	for(const std::shared_ptr<const KHitBase>& phit : gr.getHits()) {
+	  const KHit<1>* phit1 = dynamic_cast<const KHit<1>*>(phit.get());
+	  const KHitRecorded* prec = dynamic_cast<const KHitRecorded*>(phit.get());
+	  KHitRecorded::Kind kind = KHitRecorded::WIREX;
+	  double hitpitch = 0.;
+	  if(prec) {
+	    kind = prec->getKind();
+	    hitpitch = prec->getPitch();
+	  }
+	  else if(dynamic_cast<const KHitWireX*>(phit.get()) ||
+		  dynamic_cast<const KHitWireLine*>(phit.get())) {
+	    if(dynamic_cast<const KHitWireLine*>(phit.get()))
+	      kind = KHitRecorded::WIRELINE;
+	    if(pitch < 0.) {
+	      art::ServiceHandle<geo::Geometry const> geom;
+	      pitch = geom->WirePitch();
+	    }
+	    hitpitch = pitch;
+	  }
+	  else
+	    throw cet::exception("KFitRecord") << __func__ << ": measurement type can not be recorded.\n";
+	  group.hits.push_back(std::make_shared<const KHitRecorded>
+			       (group.surf, phit->getMeasPlane(), kind, hitpitch,
+				phit1->getMeasVector()(0), phit1->getMeasError()(0,0)));
+	}
+	addGroup(group);
+      }
+    }
+  }
+
+  /// Add a measurement group.
+  ///
+  /// All the measurements must be on the surface of the group.
+  ///
+  void KFitRecord::addGroup(const Group& group)
+  {
+    if(group.surf.get() == 0)
+      throw cet::exception("KFitRecord") << __func__ << ": group without surface.\n";
+    for(const std::shared_ptr<const KHitRecorded>& phit : group.hits) {
+      if(phit.get() == 0 || phit->getMeasSurface().get() != group.surf.get())
+	throw cet::exception("KFitRecord") << __func__ << ": measurement not on group surface.\n";
+    }
+    fGroups.push_back(group);
+  }
+
+  /// Make the propagator.
+  ///
+  /// Arguments:
+  ///
+  /// useDedx - If false, disable dE/dx even if recorded.
+  ///
+  std::unique_ptr<Propagator> KFitRecord::makePropagator(bool useDedx) const
+  {
+    bool doDedx = fDoDedx && useDedx;
+    switch(fPropType) {
+    case PROPYZPLANE:
+      return std::make_unique<PropYZPlane>(fTcut, doDedx);
+    case PROPXYZPLANE:
+      return std::make_unique<PropXYZPlane>(fTcut, doDedx);
+    case PROPYZLINE:
+      return std::make_unique<PropYZLine>(fTcut, doDedx);
+    case PROPANY:
+      return std::make_unique<PropAny>(fTcut, doDedx);
+    }
+    throw cet::exception("KFitRecord") << __func__ << ": unknown propagator type " << fPropType << ".\n";
+  }
+
+  /// Add the recorded measurements to the unsorted list of a container.
+  ///
+  /// The measurements are copied, so that records can be replayed
+  /// concurrently (the measurements keep their last prediction).
+  ///
+  void KFitRecord::fillContainer(KHitContainer& cont) const
+  {
+    for(const Group& group : fGroups) {
+      KHitGroup gr;
+      for(const std::shared_ptr<const KHitRecorded>& phit : group.hits)
+	gr.addHit(std::make_shared<const KHitRecorded>(*phit));
+      cont.getUnsorted().push_back(gr);
+    }
+  }
+
+  /// Write record.
+  void KFitRecord::write(std::ostream& out) const
+  {
+    out.write(Magic, sizeof(Magic));
+    put<std::int32_t>(out, fPropType);
+    put(out, fTcut);
+    put<std::uint8_t>(out, fDoDedx);
+    writeTrack(out, fSeed);
+    put<std::uint32_t>(out, fGroups.size());
+    for(const Group& group : fGroups) {
+      writeSurface(out, *group.surf);
+      put<std::int32_t>(out, group.plane);
+      put<std::uint32_t>(out, group.hits.size());
+      for(const std::shared_ptr<const KHitRecorded>& phit : group.hits) {
+	put<std::int32_t>(out, phit->getKind());
+	put(out, phit->getPitch());
+	put(out, phit->getMeasVector()(0));
+	put(out, phit->getMeasError()(0,0));
+      }
+    }
+  }
+
+  /// Read record.
+  ///
+  /// Returns false if the stream is at its end.  Throws an exception
+  /// if the record is truncated or not a record.
+  ///
+  bool KFitRecord::read(std::istream& in)
+  {
+    if(in.peek() == std::istream::traits_type::eof())
+      return false;
+    char magic[sizeof(Magic)];
+    if(!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), Magic))
+      throw cet::exception("KFitRecord") << "Not a fit record.\n";
+
+    KFitRecord rec;
+    rec.fPropType = static_cast<PropType>(get<std::int32_t>(in));
+    rec.fTcut = get<double>(in);
+    rec.fDoDedx = get<std::uint8_t>(in);
+    rec.fSeed = readTrack(in);
+    // The counts are not trusted for allocations: a corrupted record
+    // throws when it runs out of data.
+    std::uint32_t ngroups = get<std::uint32_t>(in);
+    for(std::uint32_t igr = 0; igr < ngroups; ++igr) {
+      Group group{readSurface(in), get<std::int32_t>(in), {}};
+      std::uint32_t nhits = get<std::uint32_t>(in);
+      for(std::uint32_t ihit = 0; ihit < nhits; ++ihit) {
+	KHitRecorded::Kind kind = static_cast<KHitRecorded::Kind>(get<std::int32_t>(in));
+	double pitch = get<double>(in);
+	double meas = get<double>(in);
+	double measerr = get<double>(in);
+	group.hits.push_back(std::make_shared<const KHitRecorded>
+			     (group.surf, group.plane, kind, pitch, meas, measerr));
+      }
+      rec.fGroups.push_back(group);
+    }
+    *this = rec;
+    return true;
+  }
+
+  /// Write track.
+  void KFitRecord::writeTrack(std::ostream& out, const KETrack& tre)
+  {
+    if(tre.getSurface().get() == 0)
+      throw cet::exception("KFitRecord") << __func__ << ": track without surface.\n";
+    writeSurface(out, *tre.getSurface());
+    const TrackVector& vec = tre.getVector();
+    const TrackError& err = tre.getError();
+    put<std::uint32_t>(out, vec.size());
+    for(unsigned int i = 0; i < vec.size(); ++i)
+      put(out, vec(i));
+    for(unsigned int i = 0; i < vec.size(); ++i) {
+      for(unsigned int j = 0; j <= i; ++j)
+	put(out, err(i, j));
+    }
+    put<std::int32_t>(out, tre.getDirection());
+    put<std::int32_t>(out, tre.PdgCode());
+  }
+
+  /// Read track.
+  KETrack KFitRecord::readTrack(std::istream& in)
+  {
+    std::shared_ptr<const Surface> psurf = readSurface(in);
+    std::uint32_t size = get<std::uint32_t>(in);
+    if(size != 5)
+      throw cet::exception("KFitRecord") << __func__ << ": bad track size " << size << ".\n";
+    TrackVector vec(size);
+    for(unsigned int i = 0; i < size; ++i)
+      vec(i) = get<double>(in);
+    TrackError err(size);
+    for(unsigned int i = 0; i < size; ++i) {
+      for(unsigned int j = 0; j <= i; ++j)
+	err(i, j) = get<double>(in);
+    }
+    Surface::TrackDirection dir = static_cast<Surface::TrackDirection>(get<std::int32_t>(in));
+    int pdg = get<std::int32_t>(in);
+    return KETrack(psurf, vec, err, dir, pdg);
+  }
+
+} // end namespace trkf
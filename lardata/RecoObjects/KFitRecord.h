@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   KFitRecord.h
+///
+/// \brief  Recorded inputs of a Kalman fit, for replay outside art.
+///
+/// \date   October 14, 2026
+///
+/// This class holds the inputs of one Kalman fit: the seed track, the
+/// candidate measurements of a KHitContainer, and the configuration of
+/// the propagator.  A record is made in the art job from the objects
+/// passed to the fit, and can be written to and read from a compact
+/// binary stream, so that the same fits can be replayed, profiled and
+/// compared outside art (see test/RecoObjects/KFitReplay.cc).
+///
+/// The measurements are recorded as KHitRecorded objects, which
+/// reproduce the prediction of KHitWireX and KHitWireLine without the
+/// original hits and the geometry service.  The surfaces are recorded
+/// by their geometry (SurfWireX as SurfYZPlane, SurfWireLine as
+/// SurfYZLine); all the measurements of one KHitGroup share the same
+/// surface object, as in the original container.
+///
+/// Propagation with dE/dx (and material noise) uses the detector
+/// properties service.  Records of fits with dE/dx can only be
+/// replayed as they were made where that service is available; the
+/// propagator can be made without dE/dx otherwise (makePropagator).
+///
+/// Binary format (native byte order): the characters "KFR1", the
+/// propagator type, cut and dE/dx flag, the seed track (surface,
+/// vector, lower triangle of the error matrix, direction and pdg
+/// code), then the number of groups and, for each group, its surface,
+/// plane, and measurements (kind, pitch, measurement and error).
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef KFITRECORD_H
+#define KFITRECORD_H
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+#include "lardata/RecoObjects/KETrack.h"
+#include "lardata/RecoObjects/KHitContainer.h"
+#include "lardata/RecoObjects/KHitRecorded.h"
+#include "lardata/RecoObjects/Propagator.h"
+
+namespace trkf {
+
+  class KFitRecord
+  {
+  public:
+
+    /// Propagator types.
+    enum PropType {PROPYZPLANE = 0, PROPXYZPLANE = 1, PROPYZLINE = 2, PROPANY = 3};
+
+    /// Recorded measurement group (measurements on the same surface).
+    struct Group
+    {
+      std::shared_ptr<const Surface> surf;                       ///< Measurement surface.
+      int plane;                                                 ///< Measurement plane.
+      std::vector<std::shared_ptr<const KHitRecorded> > hits;    ///< Measurements.
+    };
+
+    /// Default constructor.
+    KFitRecord();
+
+    /// Constructor - record seed track, container contents and propagator configuration.
+    KFitRecord(const KETrack& seed, const KHitContainer& cont,
+	       PropType proptype, double tcut, bool doDedx);
+
+    // Accessors.
+
+    const KETrack& getSeed() const {return fSeed;}                ///< Seed track.
+    const std::vector<Group>& getGroups() const {return fGroups;} ///< Measurement groups.
+    PropType getPropType() const {return fPropType;}              ///< Propagator type.
+    double getTcut() const {return fTcut;}                        ///< Delta ray energy cut.
+    bool getDoDedx() const {return fDoDedx;}                      ///< dE/dx flag.
+
+    // Modifiers.
+
+    /// Set seed track.
+    void setSeed(const KETrack& seed) {fSeed = seed;}
+
+    /// Set propagator configuration.
+    void setPropagator(PropType proptype, double tcut, bool doDedx);
+
+    /// Record the measurements of a container (all lists).
+    void addMeasurements(const KHitContainer& cont);
+
+    /// Add a measurement group.
+    void addGroup(const Group& group);
+
+    // Replay.
+
+    /// Make the propagator (maybe disabling dE/dx).
+    std::unique_ptr<Propagator> makePropagator(bool useDedx = true) const;
+
+    /// Add the recorded measurements to the unsorted list of a container.
+    void fillContainer(KHitContainer& cont) const;
+
+    // Serialization.
+
+    /// Write record.
+    void write(std::ostream& out) const;
+
+    /// Read record (return false, leaving record unchanged, at end of stream).
+    bool read(std::istream& in);
+
+    /// Write track (surface, vector, error, direction and pdg code).
+    static void writeTrack(std::ostream& out, const KETrack& tre);
+
+    /// Read track.
+    static KETrack readTrack(std::istream& in);
+
+  private:
+
+    // Attributes.
+
+    KETrack fSeed;                ///< Seed track.
+    std::vector<Group> fGroups;   ///< Measurement groups.
+    PropType fPropType;           ///< Propagator type.
+    double fTcut;                 ///< Delta ray energy cut.
+    bool fDoDedx;                 ///< dE/dx flag.
+  };
+}
+
+#endif
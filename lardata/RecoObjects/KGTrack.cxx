@@ -8,6 +8,7 @@
 ///
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 
@@ -16,12 +17,123 @@
 #include "lardata/RecoObjects/KHitWireLine.h"
 #include "lardata/RecoObjects/SurfXYZPlane.h"
 #include "lardata/RecoObjects/PropXYZPlane.h"
+#include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/TrackHitMeta.h"
 #include "lardataobj/RecoBase/TrackingTypes.h"
 #include "lardataobj/RecoBase/TrajectoryPointFlags.h"
 
 #include "cetlib_except/exception.h"
 
+namespace {
+
+  /// Content of a recob::Track, as extracted from a KGTrack.
+  struct TrackContent {
+    std::vector<recob::tracking::Point_t> xyz;
+    std::vector<recob::tracking::Vector_t> pxpypz;
+    std::vector<recob::TrajectoryPointFlags> flags;
+    recob::tracking::SMatrixSym55 startCov;
+    recob::tracking::SMatrixSym55 endCov;
+    float chi2 = 0.;
+    int ndof = 0;
+  };
+
+  /// Orders track collection entries by path distance.
+  bool byPath(const trkf::KGTrack::TrackMapEntry_t& a,
+	      const trkf::KGTrack::TrackMapEntry_t& b)
+  {
+    return a.first < b.first;
+  }
+
+  /// Error matrix of a track on the surface perpendicular to its momentum.
+  recob::tracking::SMatrixSym55 perpendicularError(const trkf::KHitTrack& trh,
+						    const double pos[3],
+						    const double mom[3])
+  {
+    using namespace trkf;
+
+    // Make propagator for propating to standard track surface.
+
+    PropXYZPlane prop(0., false);
+
+    // Construct surface perpendicular to track momentun, and
+    // propagate track to that surface (zero distance).
+
+    const std::shared_ptr<const Surface> psurf(new SurfXYZPlane(pos[0], pos[1], pos[2],
+								mom[0], mom[1], mom[2]));
+    KETrack tre(trh);
+    boost::optional<double> dist = prop.err_prop(tre, psurf, Propagator::UNKNOWN, false);
+    if (!dist.is_initialized())
+      throw cet::exception("KGTrack") << "fillTrack: error propagation failed\n";
+    recob::tracking::SMatrixSym55 covar;
+    for(int i=0; i<5; ++i) {
+      for(int j=0; j<5; ++j)
+	covar(i,j) = tre.getError()(i,j);
+    }
+    return covar;
+  }
+
+  /// Extracts the content of a recob::Track from a track collection.
+  /// Returns false if there are less than two trajectory points.
+  bool extractTrack(const trkf::KGTrack::TrackMap_t& trackMap, TrackContent& content)
+  {
+    size_t const npoints = trackMap.size();
+    content.xyz.reserve(npoints);
+    content.pxpypz.reserve(npoints);
+    content.flags.reserve(npoints);
+
+    // Loop over KHitTracks.
+
+    unsigned int n = 0;
+    for(const auto& entry : trackMap) {
+      const trkf::KHitTrack& trh = entry.second;
+
+      // Get position.
+
+      double pos[3];
+      trh.getPosition(pos);
+      content.xyz.push_back({pos[0], pos[1], pos[2]});
+
+      // Get momentum vector.
+      // Fill direction unit vector and momentum.
+
+      double mom[3];
+      trh.getMomentum(mom);
+      double p = std::sqrt(mom[0]*mom[0] + mom[1]*mom[1] + mom[2]*mom[2]);
+      if (p == 0.)
+        throw cet::exception("KGTrack") << "fillTrack: null momentum\n";
+      content.pxpypz.push_back({mom[0], mom[1], mom[2]});
+
+      content.ndof += 1;
+      content.chi2 += trh.getChisq();
+      content.flags.emplace_back(n, recob::TrajectoryPointFlags::makeMask());
+
+      // Only the first and last error matrices are saved,
+      // so only those are computed.
+
+      if(n == 0)
+	content.startCov = perpendicularError(trh, pos, mom);
+      if(n + 1 == npoints && n > 0)
+	content.endCov = perpendicularError(trh, pos, mom);
+      ++n;
+    }
+
+    content.ndof = content.ndof - 4; //fit measures 4 parameters: position and direction on plane
+    return content.xyz.size() >= 2;
+  }
+
+  /// Returns the recob::Hit of a measurement (null if there is none).
+  art::Ptr<recob::Hit> recobHit(const trkf::KHitBase& hit)
+  {
+    if(const trkf::KHitWireX* phit = dynamic_cast<const trkf::KHitWireX*>(&hit))
+      return phit->getHit();
+    if(const trkf::KHitWireLine* phit = dynamic_cast<const trkf::KHitWireLine*>(&hit))
+      return phit->getHit();
+    return art::Ptr<recob::Hit>();
+  }
+
+} // local namespace
+
 namespace trkf {
 
   /// Default constructor.
@@ -43,7 +155,7 @@ namespace trkf {
 
     // Return track.
 
-    return (*fTrackMap.begin()).second;
+    return fTrackMap.front().second;
   }
 
   /// Track at end point.
@@ -56,7 +168,7 @@ namespace trkf {
 
     // Return track.
 
-    return (*fTrackMap.rbegin()).second;
+    return fTrackMap.back().second;
   }
 
   /// Modifiable track at start point.
@@ -69,7 +181,7 @@ namespace trkf {
 
     // Return track.
 
-    return (*fTrackMap.begin()).second;
+    return fTrackMap.front().second;
   }
 
   /// Modifiable track at end point.
@@ -82,45 +194,77 @@ namespace trkf {
 
     // Return track.
 
-    return (*fTrackMap.rbegin()).second;
+    return fTrackMap.back().second;
   }
 
   /// Add track.
+  ///
+  /// The track is appended if its path distance is not smaller than the
+  /// last one (the common case), and inserted after all the tracks with
+  /// the same or smaller distance otherwise.
+  ///
   void KGTrack::addTrack(const KHitTrack& trh) {
     if(!trh.isValid())
       throw cet::exception("KGTrack") << "Adding invalid track to KGTrack.\n";
-    fTrackMap.insert(std::make_pair(trh.getPath() + trh.getHit()->getPredDistance(), trh));
+    double const s = trh.getPath() + trh.getHit()->getPredDistance();
+    if(fTrackMap.empty() || !(s < fTrackMap.back().first))
+      fTrackMap.emplace_back(s, trh);
+    else {
+      TrackMapEntry_t const entry(s, trh);
+      fTrackMap.insert(std::upper_bound(fTrackMap.begin(), fTrackMap.end(), entry, byPath),
+		       entry);
+    }
+  }
+
+  /// Add tracks.
+  ///
+  /// All tracks are appended, then sorted by path distance and merged
+  /// with the existing ones.  The result is the same as adding the tracks
+  /// one by one in the same order.
+  ///
+  void KGTrack::addTracks(const std::vector<KHitTrack>& trhs) {
+    for(const KHitTrack& trh : trhs) {
+      if(!trh.isValid())
+	throw cet::exception("KGTrack") << "Adding invalid track to KGTrack.\n";
+    }
+    size_t const nold = fTrackMap.size();
+    fTrackMap.reserve(nold + trhs.size());
+    for(const KHitTrack& trh : trhs)
+      fTrackMap.emplace_back(trh.getPath() + trh.getHit()->getPredDistance(), trh);
+    auto const middle = fTrackMap.begin() + nold;
+    if(!std::is_sorted(middle, fTrackMap.end(), byPath))
+      std::stable_sort(middle, fTrackMap.end(), byPath);
+    std::inplace_merge(fTrackMap.begin(), middle, fTrackMap.end(), byPath);
   }
 
   /// Recalibrate track map.
   ///
-  /// Loop over contents of track map.  Copy each KHitTrack into a new multimap track map.
+  /// Loop over contents of track map.
   /// Offset the distance stored in the KHitTracks such that the minimum distance is zero.
-  /// Also update multimap keys to agree with distance stored in track.
+  /// Also update the sorting distances to agree with distance stored in track,
+  /// and sort the track map again.
   ///
   void KGTrack::recalibrate()
   {
-    std::multimap<double, KHitTrack> newmap;
-
-    // Loop over old track map.
+    // Loop over track map.
 
     bool first = true;
     double s0 = 0.;
-    for(std::multimap<double, KHitTrack>::iterator i = fTrackMap.begin();
-	i != fTrackMap.end(); ++i) {
-      KHitTrack& trh = (*i).second;
+    for(auto& entry : fTrackMap) {
+      KHitTrack& trh = entry.second;
       if(first) {
 	first = false;
 	s0 = trh.getPath();
       }
       double s = trh.getPath()  - s0;
       trh.setPath(s);
-      newmap.insert(std::make_pair(s, trh));
+      entry.first = s;
     }
 
-    // Update data member track map.
+    // Sort again with the new distances.
 
-    fTrackMap.swap(newmap);
+    if(!std::is_sorted(fTrackMap.begin(), fTrackMap.end(), byPath))
+      std::stable_sort(fTrackMap.begin(), fTrackMap.end(), byPath);
   }
 
   /// Fill a recob::Track.
@@ -129,89 +273,44 @@ namespace trkf {
   ///
   /// track - Track to fill.
   ///
+  /// The track is left unchanged if there are less than two trajectory points.
+  ///
   void KGTrack::fillTrack(recob::Track& track,
 			  int id) const
   {
-
-    // Make propagator for propating to standard track surface.
-
-    PropXYZPlane prop(0., false);
-
-    // Fill collections of trajectory points and direction vectors.
-
-    std::vector<recob::tracking::Point_t> xyz;
-    std::vector<recob::tracking::Vector_t> pxpypz;
-    std::vector<recob::tracking::SMatrixSym55> cov;
-    std::vector<recob::TrajectoryPointFlags> outFlags;
-
-    xyz.reserve(fTrackMap.size());
-    pxpypz.reserve(fTrackMap.size());
-    outFlags.reserve(fTrackMap.size());
-
-    // Loop over KHitTracks.
-
-    int ndof = 0;
-    float totChi2 = 0.;
-    unsigned int n = 0;
-    for(std::multimap<double, KHitTrack>::const_iterator itr = fTrackMap.begin();
-	itr != fTrackMap.end(); ++itr, ++n) {
-      const KHitTrack& trh = (*itr).second;
-
-      // Get position.
-
-      double pos[3];
-      trh.getPosition(pos);
-      xyz.push_back({pos[0], pos[1], pos[2]});
-
-      // Get momentum vector.
-      // Fill direction unit vector and momentum.
-
-      double mom[3];
-      trh.getMomentum(mom);
-      double p = std::sqrt(mom[0]*mom[0] + mom[1]*mom[1] + mom[2]*mom[2]);
-      if (p == 0.)
-        throw cet::exception("KGTrack") << __func__ << ": null momentum\n";
-      pxpypz.push_back({mom[0], mom[1], mom[2]});
-
-      ndof += 1;
-      totChi2 += trh.getChisq();
-      outFlags.emplace_back(n, recob::TrajectoryPointFlags::makeMask());
-
-      // Fill error matrix.
-
-      recob::tracking::SMatrixSym55 covar;
-
-      // Construct surface perpendicular to track momentun, and
-      // propagate track to that surface (zero distance).
-
-      const std::shared_ptr<const Surface> psurf(new SurfXYZPlane(pos[0], pos[1], pos[2],
-								  mom[0], mom[1], mom[2]));
-      KETrack tre(trh);
-      boost::optional<double> dist = prop.err_prop(tre, psurf, Propagator::UNKNOWN, false);
-      if (!dist.is_initialized())
-	throw cet::exception("KGTrack") << __func__ << ": error propagation failed\n";
-      for(int i=0; i<5; ++i) {
-	for(int j=0; j<5; ++j)
-	  covar(i,j) = tre.getError()(i,j);
-      }
-
-      // Only save first and last error matrix.
-
-      if(cov.size() < 2)
-	cov.push_back(covar);
-      else
-	cov.back() = covar;
-
-    }
+    TrackContent content;
+    if(!extractTrack(fTrackMap, content))
+      return;
 
     // Fill track.
 
-    ndof = ndof - 4; //fit measures 4 parameters: position and direction on plane
-    if(xyz.size() >= 2) {
-      track = recob::Track(std::move(xyz), std::move(pxpypz), std::move(outFlags),
-			   true, this->startTrack().PdgCode(), totChi2, ndof,
-			   std::move(cov.front()), std::move(cov.back()), id);
+    track = recob::Track(std::move(content.xyz), std::move(content.pxpypz),
+			 std::move(content.flags), true, this->startTrack().PdgCode(),
+			 content.chi2, content.ndof,
+			 std::move(content.startCov), std::move(content.endCov), id);
+  }
+
+  /// Fill a recob::Track at the end of a collection.
+  ///
+  /// Arguments:
+  ///
+  /// tracks - Collection to add the track to (should be reserved by the caller).
+  ///
+  /// The new track is constructed directly in the collection.  It is
+  /// default-constructed if there are less than two trajectory points.
+  ///
+  void KGTrack::fillTrack(std::vector<recob::Track>& tracks,
+			  int id) const
+  {
+    TrackContent content;
+    if(!extractTrack(fTrackMap, content)) {
+      tracks.emplace_back();
+      return;
     }
+    tracks.emplace_back(std::move(content.xyz), std::move(content.pxpypz),
+			std::move(content.flags), true, this->startTrack().PdgCode(),
+			content.chi2, content.ndof,
+			std::move(content.startCov), std::move(content.endCov), id);
   }
 
   /// Fill a PtrVector of Hits.
@@ -224,33 +323,50 @@ namespace trkf {
                          std::vector<unsigned int>& hittpindex) const
   {
     hits.reserve(hits.size() + fTrackMap.size());
+    hittpindex.reserve(hittpindex.size() + fTrackMap.size());
 
     // Loop over KHitTracks and fill hits belonging to this track.
 
     unsigned int counter = 0; //Index of corresponding trajectory point
-    for(std::multimap<double, KHitTrack>::const_iterator it = fTrackMap.begin();
-	it != fTrackMap.end(); ++it) {
-      const KHitTrack& track = (*it).second;
+    for(const auto& entry : fTrackMap) {
+      const KHitTrack& track = entry.second;
       ++counter;
       // Extrack Hit from track.
-      const std::shared_ptr<const KHitBase>& hit = track.getHit();
-      if(const KHitWireX* phit = dynamic_cast<const KHitWireX*>(&*hit)) {
-	const art::Ptr<recob::Hit> prhit = phit->getHit();
-	if(!prhit.isNull()){
-	  hits.push_back(prhit);
-          hittpindex.push_back(counter-1);
-        }
-      }
-      else if(const KHitWireLine* phit = dynamic_cast<const KHitWireLine*>(&*hit)) {
-	const art::Ptr<recob::Hit> prhit = phit->getHit();
-	if(!prhit.isNull()){
-	  hits.push_back(prhit);
-          hittpindex.push_back(counter-1);
-        }
+      const art::Ptr<recob::Hit> prhit = recobHit(*track.getHit());
+      if(!prhit.isNull()){
+	hits.push_back(prhit);
+	hittpindex.push_back(counter-1);
       }
     }
   }
 
+  /// Add the hits of this track to a track-hit association.
+  ///
+  /// Arguments:
+  ///
+  /// track - Pointer to the recob::Track filled from this track.
+  /// assns - Association to add the hits to.
+  ///
+  /// This is the same as fillHits, followed by the association of each
+  /// hit to the track, but done in the same pass over the KHitTracks.
+  /// The metadata of each hit holds the index of its trajectory point
+  /// and, as dx, the path length assigned to the point (half the path
+  /// distance between the neighbouring points).
+  ///
+  void KGTrack::fillHitAssns(const art::Ptr<recob::Track>& track,
+			     TrackHitAssns_t& assns) const
+  {
+    const size_t npoints = fTrackMap.size();
+    for(size_t i = 0; i < npoints; ++i) {
+      const art::Ptr<recob::Hit> prhit = recobHit(*fTrackMap[i].second.getHit());
+      if(prhit.isNull())
+	continue;
+      const double sbefore = fTrackMap[i > 0 ? i-1 : i].first;
+      const double safter = fTrackMap[i+1 < npoints ? i+1 : i].first;
+      assns.addSingle(track, prhit, recob::TrackHitMeta(i, 0.5 * (safter - sbefore)));
+    }
+  }
+
   ///
   /// Printout
   ///
@@ -11,9 +11,14 @@
 /// measurement surface.  This is the maximum amount of information
 /// that it is possible to have.
 ///
-/// KHitTrack collection is stored as a map, indexed by path distance.
+/// KHitTrack collection is stored as a vector of (path distance,
+/// KHitTrack) pairs, sorted by path distance (tracks with the same
+/// distance stay in the order they were added, as in a multimap).
 /// This organization makes it easy to find the one or two nearest
-/// KHitTrack objects to any path distance.
+/// KHitTrack objects to any path distance, and keeps all the tracks
+/// in a single allocation.  Tracks are usually added in order of
+/// increasing distance, which just appends them.  addTracks()
+/// appends many tracks and sorts them once.
 ///
 /// Note that by combining information from forward and backward fit
 /// tracks (Kalman smoothing), it is possible to obtain optimal fit
@@ -26,16 +31,20 @@
 #define KGTRACK_H
 
 #include <iosfwd>
-#include <map>
+#include <utility>
 #include <vector>
 
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/PtrVector.h"
 
 #include "lardata/RecoObjects/KHitTrack.h"
+#include "lardata/Utilities/CollectionView.h"
 
 namespace recob {
   class Hit;
   class Track;
+  class TrackHitMeta;
 }
 
 namespace trkf {
@@ -44,6 +53,15 @@ namespace trkf {
   {
   public:
 
+    /// KHitTrack collection entry: path distance and track.
+    typedef std::pair<double, KHitTrack> TrackMapEntry_t;
+
+    /// KHitTrack collection, sorted by path distance.
+    typedef std::vector<TrackMapEntry_t> TrackMap_t;
+
+    /// Track-hit association, with trajectory point metadata.
+    typedef art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> TrackHitAssns_t;
+
     /// Constructor.
     KGTrack(int prefplane);
 
@@ -54,8 +72,12 @@ namespace trkf {
 
     int getPrefPlane() const {return fPrefPlane;}
 
-    /// KHitTrack collection, indexed by path distance.
-    const std::multimap<double, KHitTrack>& getTrackMap() const {return fTrackMap;}
+    /// KHitTrack collection, sorted by path distance.
+    const TrackMap_t& getTrackMap() const {return fTrackMap;}
+
+    /// View of the KHitTrack collection entries (contiguous, sorted).
+    lar::RangeAsCollection_t<const TrackMapEntry_t*> tracks() const
+      {return lar::makeCollectionView(fTrackMap.data(), fTrackMap.data() + fTrackMap.size());}
 
     /// Number of measurements in track.
     size_t numHits() const {return fTrackMap.size();}
@@ -71,8 +93,9 @@ namespace trkf {
 
     // Modifiers.
 
-    /// Modifiable KHitTrack collection, indexed by path distance.
-    std::multimap<double, KHitTrack>& getTrackMap() {return fTrackMap;}
+    /// Modifiable KHitTrack collection, sorted by path distance.
+    /// Path distances must not be changed (see recalibrate()).
+    TrackMap_t& getTrackMap() {return fTrackMap;}
 
     /// Modifiable track at start point.
     KHitTrack& startTrack();
@@ -83,6 +106,12 @@ namespace trkf {
     /// Add track.
     void addTrack(const KHitTrack& trh);
 
+    /// Add tracks (appended, then sorted once).
+    void addTracks(const std::vector<KHitTrack>& trhs);
+
+    /// Reserve space for the specified total number of tracks.
+    void reserve(size_t n) {fTrackMap.reserve(n);}
+
     /// Recalibrate track map.
     void recalibrate();
 
@@ -95,11 +124,26 @@ namespace trkf {
     void fillTrack(recob::Track& track,
 		   int id) const;
 
+    /// Fill a recob::Track at the end of a collection.
+    void fillTrack(std::vector<recob::Track>& tracks,
+		   int id) const;
+
     /// Fill a PtrVector of Hits.
     void fillHits(art::PtrVector<recob::Hit>& hits,
                   std::vector<unsigned int>& hittpindex) const;
 
-    const std::multimap<double, KHitTrack> TrackMap() const { return fTrackMap; }
+    /// Add the hits of this track to a track-hit association.
+    void fillHitAssns(const art::Ptr<recob::Track>& track,
+		      TrackHitAssns_t& assns) const;
+
+    /// Fill recob::Tracks and their track-hit association from KGTracks.
+    template <typename MakeTrackPtr>
+    static void fillTracks(const std::vector<KGTrack>& kgtracks,
+			   std::vector<recob::Track>& tracks,
+			   TrackHitAssns_t& assns,
+			   const MakeTrackPtr& makeTrackPtr);
+
+    const TrackMap_t& TrackMap() const { return fTrackMap; }
 
     /// Printout
     std::ostream& Print(std::ostream& out) const;
@@ -111,13 +155,44 @@ namespace trkf {
     /// Preferred plane.
     int fPrefPlane;
 
-    /// KHitTrack collection, indexed by path distance.
-    std::multimap<double, KHitTrack> fTrackMap;
+    /// KHitTrack collection, sorted by path distance.
+    TrackMap_t fTrackMap;
   };
 
   /// Output operator.
   std::ostream& operator<<(std::ostream& out, const KGTrack& trg);
 
+  /// Fill recob::Tracks and their track-hit association from KGTracks.
+  ///
+  /// Arguments:
+  ///
+  /// kgtracks     - Tracks to convert.
+  /// tracks       - Collection to add the recob::Tracks to.
+  /// assns        - Association to add the hits of each track to.
+  /// makeTrackPtr - Callable returning the art::Ptr<recob::Track> to
+  ///                the element of tracks with the given index
+  ///                (e.g. an art::PtrMaker<recob::Track>).
+  ///
+  /// The track collection is reserved once for all the tracks, and each
+  /// track is constructed in place from trajectory arrays reserved to
+  /// its number of points.  The id of each track is its index in the
+  /// collection.  Each track gets an element in the collection even when
+  /// it is not converted (see fillTrack), so that indices stay aligned.
+  ///
+  template <typename MakeTrackPtr>
+  void KGTrack::fillTracks(const std::vector<KGTrack>& kgtracks,
+			   std::vector<recob::Track>& tracks,
+			   TrackHitAssns_t& assns,
+			   const MakeTrackPtr& makeTrackPtr)
+  {
+    tracks.reserve(tracks.size() + kgtracks.size());
+    for(const KGTrack& kgtrack : kgtracks) {
+      const size_t index = tracks.size();
+      kgtrack.fillTrack(tracks, index);
+      kgtrack.fillHitAssns(makeTrackPtr(index), assns);
+    }
+  }
+
 }
 
 #endif
@@ -59,6 +59,13 @@
 /// 4.  If the chisquare cut passes, update track by calling method
 ///     KHit::update.
 ///
+/// Measurements whose prediction depends only on the track and on the
+/// measurement surface (isPredictionShared returns true) can copy the
+/// prediction of another measurement of the same type on the same
+/// surface with method predictAs, which only calculates the residual
+/// and the chisquare.  KHitGroup::predictHits uses this to predict
+/// all the measurements of a group from a single propagation.
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef KHIT_H
@@ -132,6 +139,12 @@ namespace trkf {
     /// Prediction method (return false if fail).
     bool predict(const KETrack& tre, const Propagator* prop = 0, const KTrack* ref = 0) const;
 
+    /// Prediction method copying the prediction of other (return false if fail).
+    bool predictAs(const KHit<N>& other) const;
+
+    /// Whether the prediction depends only on the track and measurement surface.
+    virtual bool isPredictionShared() const {return false;}
+
     /// Update track method.
     void update(KETrack& tre) const;
 
@@ -159,6 +172,9 @@ namespace trkf {
     mutable typename KSymMatrix<N>::type fRinv;  ///< Residual inverse error matrix.
     mutable typename KHMatrix<N>::type fH;       ///< Kalman H-matrix.
     mutable double fChisq;                       ///< Incremental chisquare.
+
+    /// Update residual and chisquare from the prediction.
+    bool updateResidual() const;
   };
 
   // Method implementations.
@@ -293,18 +309,7 @@ namespace trkf {
 
       // Update residual
 
-      fRvec = fMvec - fPvec;
-      fRerr = fMerr + fPerr;
-      fRinv = fRerr;
-      ok = syminvert(fRinv);
-      if(ok) {
-
-	// Calculate incremental chisquare.
-
-	// (workaround: if we use the copy constructor, gcc emits a spurious warning)
-//	typename KVector<N>::type rtemp = prod(fRinv, fRvec);
-	fChisq = inner_prod(fRvec, prod(fRinv, fRvec));
-      }
+      ok = updateResidual();
     }
 
     // If a problem occured at any step, clear the prediction surface pointer.
@@ -319,6 +324,60 @@ namespace trkf {
     return ok;
   }
 
+  /// Prediction method copying the prediction of another measurement.
+  ///
+  /// Arguments:
+  ///
+  /// other - Measurement, already predicted, of the same type and on the
+  ///         same measurement surface as this one.
+  ///
+  /// The prediction surface, distance, vector, error matrix and H-matrix
+  /// are copied from other, and only the residual and the incremental
+  /// chisquare are calculated, which is equivalent to calling predict
+  /// with the same track if the prediction is shared (isPredictionShared).
+  /// The prediction fails if the one of other failed.
+  ///
+  template <int N>
+  bool KHit<N>::predictAs(const KHit<N>& other) const
+  {
+    bool ok = other.getPredSurface().get() != 0;
+    if(ok) {
+      fPredSurf = other.fPredSurf;
+      fPredDist = other.fPredDist;
+      fPvec = other.fPvec;
+      fPerr = other.fPerr;
+      fH = other.fH;
+      ok = updateResidual();
+    }
+    if(!ok) {
+      fPredSurf.reset();
+      fPredDist = 0.;
+    }
+    return ok;
+  }
+
+  /// Update residual and chisquare from the prediction.
+  ///
+  /// Returned value: false if the residual error matrix is singular.
+  ///
+  template <int N>
+  bool KHit<N>::updateResidual() const
+  {
+    fRvec = fMvec - fPvec;
+    fRerr = fMerr + fPerr;
+    fRinv = fRerr;
+    bool ok = syminvert(fRinv);
+    if(ok) {
+
+      // Calculate incremental chisquare.
+
+      // (workaround: if we use the copy constructor, gcc emits a spurious warning)
+//    typename KVector<N>::type rtemp = prod(fRinv, fRvec);
+      fChisq = inner_prod(fRvec, prod(fRinv, fRvec));
+    }
+    return ok;
+  }
+
   /// Update track method.
   ///
   /// Arguments:
@@ -30,6 +30,11 @@
 /// 3.  Update method, in which the track object is passed in and is
 ///     updated according to the Kalman updating formula.
 ///
+/// Virtual method checkResidual is an optional, cheap compatibility
+/// test of a measurement with a track, to be used before the full
+/// prediction.  It returns false only if the measurement is clearly
+/// incompatible.  The default implementation always returns true.
+///
 /// This class does not include in its interface anything having to do
 /// with concrete measurements, predictions, or residuals, or anything
 /// with a variable dimension.
@@ -112,6 +117,11 @@ namespace trkf {
     /// Printout
     virtual std::ostream& Print(std::ostream& out, bool doTitle = true) const;
 
+    // Virtual methods.
+
+    /// Cheap compatibility test within nsigma (false if clearly incompatible).
+    virtual bool checkResidual(const KETrack& /* tre */, double /* nsigma */) const {return true;}
+
     // Attributes.
 
   protected:
@@ -9,13 +9,18 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "lardata/RecoObjects/KHitContainer.h"
+#include <algorithm>
+#include <vector>
 
 #include "cetlib_except/exception.h"
 
 namespace trkf {
 
   /// Default Constructor.
-  KHitContainer::KHitContainer()
+  KHitContainer::KHitContainer() :
+    fRefillPlane(-1),
+    fRefillGroups(0),
+    fRefilled(false)
   {}
 
   /// Destructor.
@@ -31,6 +36,9 @@ namespace trkf {
     fSorted.clear();
     fUnsorted.clear();
     fUnused.clear();
+    fRefillHits.clear();
+    fRefillGroups = 0;
+    fRefilled = false;
   }
 
   /// Move all objects to unsorted list (from sorted and unused lists).
@@ -40,6 +48,41 @@ namespace trkf {
     fUnsorted.splice(fUnsorted.end(), fUnused);
   }
 
+  /// Fill container, or reuse the objects of the last refill.
+  ///
+  /// Arguments:
+  ///
+  /// hits       - RecoBase/Hit collection.
+  /// only_plane - Choose hits from this plane if >= 0.
+  ///
+  /// If the last refill was made with the same hits (in the same order)
+  /// and plane, and all the KHitGroup objects it made are still in the
+  /// lists, those objects are moved to the unsorted list and their path
+  /// is reset, without making any new measurement.  Otherwise, the
+  /// container is cleared and filled again using fill.
+  ///
+  void KHitContainer::refill(const art::PtrVector<recob::Hit>& hits,
+			     int only_plane)
+  {
+    if(fRefilled && only_plane == fRefillPlane &&
+       fSorted.size() + fUnsorted.size() + fUnused.size() == fRefillGroups &&
+       std::equal(hits.begin(), hits.end(), fRefillHits.begin(), fRefillHits.end())) {
+      reset();
+      for(KHitGroup& gr : fUnsorted)
+	gr.setPath(false, 0.);
+      return;
+    }
+
+    // Make new objects.
+
+    clear();
+    fill(hits, only_plane);
+    fRefillHits = hits;
+    fRefillPlane = only_plane;
+    fRefillGroups = fUnsorted.size();
+    fRefilled = true;
+  }
+
   /// (Re)sort objects in unsorted and sorted lists.
   ///
   /// Arguments:
@@ -63,7 +106,7 @@ namespace trkf {
 
     // Loop over objects in sorted list.
 
-    for(std::list<KHitGroup>::iterator igr = fSorted.begin();
+    for(HitGroupList_t::iterator igr = fSorted.begin();
 	igr != fSorted.end();) {
 
       KHitGroup& gr = *igr;
@@ -84,7 +127,7 @@ namespace trkf {
 	// keep the list iterator valid.
 
 	gr.setPath(false, 0.);
-	std::list<KHitGroup>::iterator it = igr;
+	HitGroupList_t::iterator it = igr;
 	++igr;
 	fUnsorted.splice(fUnsorted.end(), fSorted, it);
       }
@@ -103,6 +146,76 @@ namespace trkf {
     fSorted.sort();
   }
 
+  /// Resort the first window objects of the sorted list.
+  ///
+  /// Arguments:
+  ///
+  /// trk    - Track to be propagated.
+  /// window - Number of objects to propagate.
+  /// prop   - Propagator.
+  /// dir    - Propagation direction.
+  ///
+  /// Objects of the window which can't be reached are moved to the
+  /// unsorted list.  The path distance of the objects after the window
+  /// is shifted by the change of the path distance of the first
+  /// reachable object of the window, and their order is kept.  The
+  /// objects of the window go before the following objects with the
+  /// same path distance.
+  ///
+  void KHitContainer::sortWindow(const KTrack& trk, unsigned int window,
+				 const Propagator* prop,
+				 Propagator::PropDirection dir)
+  {
+    if(!prop)
+      throw cet::exception("KHitContainer") << __func__ << ": no propagator" << "\n";
+
+    // Propagate the track to the objects in the window.
+
+    std::vector<HitGroupList_t::iterator> reached;
+    reached.reserve(window);
+    bool has_shift = false;
+    double shift = 0.;
+    HitGroupList_t::iterator igr = fSorted.begin();
+    for(unsigned int n = 0; n < window && igr != fSorted.end(); ++n) {
+      KHitGroup& gr = *igr;
+      KTrack trkp = trk;
+      boost::optional<double> dist = prop->vec_prop(trkp, gr.getSurface(), dir, false, 0, 0);
+      if(!dist) {
+	gr.setPath(false, 0.);
+	HitGroupList_t::iterator it = igr;
+	++igr;
+	fUnsorted.splice(fUnsorted.end(), fSorted, it);
+      }
+      else {
+	if(!has_shift) {
+	  shift = *dist - gr.getPath();
+	  has_shift = true;
+	}
+	gr.setPath(true, *dist);
+	reached.push_back(igr);
+	++igr;
+      }
+    }
+
+    // Shift the cached path distance of the objects after the window.
+
+    const HitGroupList_t::iterator iend = igr;
+    for(; igr != fSorted.end(); ++igr)
+      igr->setPath(true, igr->getPath() + shift);
+
+    // Sort the window, and merge it with the following objects
+    // (usually, all of the window stays in front of them).
+
+    std::sort(reached.begin(), reached.end(),
+	      [](HitGroupList_t::iterator a, HitGroupList_t::iterator b) {return *a < *b;});
+    HitGroupList_t::iterator pos = iend;
+    for(HitGroupList_t::iterator it : reached) {
+      while(pos != fSorted.end() && *pos < *it)
+	++pos;
+      fSorted.splice(pos, fSorted, it);
+    }
+  }
+
   /// Return the plane with the most KHitGroups in the unsorted list.
   unsigned int KHitContainer::getPreferredPlane() const
   {
@@ -112,7 +225,7 @@ namespace trkf {
 
     // Loop over KHitGroups in the unsorted list.
 
-    for(std::list<KHitGroup>::const_iterator igr = fUnsorted.begin();
+    for(HitGroupList_t::const_iterator igr = fUnsorted.begin();
 	igr != fUnsorted.end(); ++igr) {
 
       const KHitGroup& gr = *igr;
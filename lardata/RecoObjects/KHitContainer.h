@@ -22,6 +22,16 @@
 /// length updated, are moved to the sorted list, and are eventually
 /// sorted.  Unreachable objects are moved to the unsorted list.
 ///
+/// 2.  Window sort
+///
+/// Cheaper resort of the sorted list during the filter.  Only the
+/// first few objects of the sorted list (the window) are propagated
+/// and put in order.  The other objects keep their order, and their
+/// path length is shifted by the same amount as the first object of
+/// the window, which assumes that the track has moved along the
+/// path without changing much its direction.  The cost does not
+/// depend on the number of objects beyond the window.
+///
 /// Here are the envisioned use cases of this class.
 ///
 /// 1.  At the beginning of the event, a set of candidate measurements
@@ -40,25 +50,55 @@
 /// lists.  These kinds of operations can be accomplished using STL
 /// list splice method without copying the objects.
 ///
+/// When the same hits are used for several seeds, the container can
+/// be filled with refill instead of fill.  The first call fills it
+/// as usual.  The following calls with the same hits and plane reuse
+/// the measurements and KHitGroup objects already made: they are just
+/// moved back to the unsorted list, as with reset.  Only the sorting
+/// and the filter then need to be repeated for each seed.  Objects
+/// must not be removed from the lists between refill calls (if they
+/// are, the container is filled again).
+///
+/// The measurement objects made by the fill methods of derived classes
+/// can be allocated in an arena (see setArena), for example one per
+/// event, instead of one heap allocation each.  The arena memory is
+/// released in one shot when the last measurement is destroyed.
+/// Without an arena, measurements are allocated with make_shared.
+///
+/// The nodes of the lists are accounted under the tag "KHitContainer"
+/// when lardata is built with LARDATA_ALLOCATION_ACCOUNTING (see
+/// lar::AllocationAccounting).
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef KHITCONTAINER_H
 #define KHITCONTAINER_H
 
 #include <list>
+#include <memory>
 #include "lardata/RecoObjects/KHitGroup.h"
 #include "lardata/RecoObjects/KTrack.h"
 #include "lardata/RecoObjects/Propagator.h"
 #include "canvas/Persistency/Common/PtrVector.h"
 #include "lardataobj/RecoBase/Hit.h"
+#include "lardata/Utilities/SharedArenaAllocator.h"
+#include "lardata/Utilities/AllocationAccounting.h"
 
 
 namespace trkf {
 
+  /// Tag of the allocations of the KHitContainer lists.
+  struct KHitContainerAllocationTag
+    { static constexpr char const* Name = "KHitContainer"; };
+
   class KHitContainer
   {
   public:
 
+    /// Type of the lists of KHitGroup objects.
+    using HitGroupList_t = std::list
+      <KHitGroup, lar::TaggedAllocator<KHitGroup, KHitContainerAllocationTag>>;
+
     /// Default constructor.
     KHitContainer();
 
@@ -68,15 +108,21 @@ namespace trkf {
     virtual void fill(const art::PtrVector<recob::Hit>& hits, int only_plane) = 0;
     // Const Accessors.
 
-    const std::list<KHitGroup>& getSorted() const {return fSorted;}       ///< Sorted list.
-    const std::list<KHitGroup>& getUnsorted() const {return fUnsorted;}   ///< Unsorted list.
-    const std::list<KHitGroup>& getUnused() const {return fUnused;}       ///< Unused list.
+    const HitGroupList_t& getSorted() const {return fSorted;}       ///< Sorted list.
+    const HitGroupList_t& getUnsorted() const {return fUnsorted;}   ///< Unsorted list.
+    const HitGroupList_t& getUnused() const {return fUnused;}       ///< Unused list.
 
     // Non-const Accessors.
 
-    std::list<KHitGroup>& getSorted() {return fSorted;}       ///< Sorted list.
-    std::list<KHitGroup>& getUnsorted() {return fUnsorted;}   ///< Unsorted list.
-    std::list<KHitGroup>& getUnused() {return fUnused;}       ///< Unused list.
+    HitGroupList_t& getSorted() {return fSorted;}       ///< Sorted list.
+    HitGroupList_t& getUnsorted() {return fUnsorted;}   ///< Unsorted list.
+    HitGroupList_t& getUnused() {return fUnused;}       ///< Unused list.
+
+    /// Arena for the measurements made by fill (null if none).
+    const std::shared_ptr<lar::SharedArena_t>& getArena() const {return fArena;}
+
+    /// Set the arena for the measurements made by fill (null for none).
+    void setArena(const std::shared_ptr<lar::SharedArena_t>& arena) {fArena = arena;}
 
     /// Clear all lists.
     void clear();
@@ -84,10 +130,17 @@ namespace trkf {
     /// Move all objects to unsorted list (from sorted and unused lists).
     void reset();
 
+    /// Fill container, or reuse the objects of the last refill (see class comment).
+    void refill(const art::PtrVector<recob::Hit>& hits, int only_plane);
+
     /// (Re)sort objects in unsorted and sorted lists.
     void sort(const KTrack& trk, bool addUnsorted, const Propagator* prop,
 	      Propagator::PropDirection dir = Propagator::UNKNOWN);
 
+    /// Resort the first window objects of the sorted list (see class comment).
+    void sortWindow(const KTrack& trk, unsigned int window, const Propagator* prop,
+		    Propagator::PropDirection dir = Propagator::UNKNOWN);
+
     /// Return the plane with the most KHitGroups in the unsorted list.
     unsigned int getPreferredPlane() const;
 
@@ -95,9 +148,14 @@ namespace trkf {
 
     // Attributes.
 
-    std::list<KHitGroup> fSorted;     ///< Sorted KHitGroup objects.
-    std::list<KHitGroup> fUnsorted;   ///< Unsorted KHitGroup objects.
-    std::list<KHitGroup> fUnused;     ///< Unused KHitGroup objects.
+    HitGroupList_t fSorted;     ///< Sorted KHitGroup objects.
+    HitGroupList_t fUnsorted;   ///< Unsorted KHitGroup objects.
+    HitGroupList_t fUnused;     ///< Unused KHitGroup objects.
+    std::shared_ptr<lar::SharedArena_t> fArena;  ///< Measurement arena (may be null).
+    art::PtrVector<recob::Hit> fRefillHits;      ///< Hits of the last refill.
+    int fRefillPlane;                            ///< Plane of the last refill.
+    size_t fRefillGroups;                        ///< KHitGroup objects made by the last refill.
+    bool fRefilled;                              ///< Whether the objects were made by refill.
   };
 }
 
@@ -14,7 +14,6 @@
 #include "cetlib_except/exception.h"
 
 #include "lardata/RecoObjects/KHitWireLine.h"
-#include "larcore/Geometry/Geometry.h"
 
 namespace trkf {
 
@@ -39,10 +38,6 @@ namespace trkf {
   void KHitContainerWireLine::fill(const art::PtrVector<recob::Hit>& hits,
 				   int only_plane)
   {
-    // Get services.
-
-    art::ServiceHandle<geo::Geometry const> geom;
-
     // Loop over hits.
 
     for(art::PtrVector<recob::Hit>::const_iterator ihit = hits.begin();
@@ -71,9 +66,10 @@ namespace trkf {
 
       const std::shared_ptr<const Surface>& psurf = pgr->getSurface();
 
-      // Construct KHitWireLine object.
+      // Construct KHitWireLine object (in the arena, if any).
 
-      std::shared_ptr<const KHitBase> phit(new KHitWireLine(*ihit, psurf));
+      std::shared_ptr<const KHitBase> phit =
+	lar::makeArenaShared<KHitWireLine>(getArena(), *ihit, psurf);
 
       // Insert hit into KHitGroup.
 
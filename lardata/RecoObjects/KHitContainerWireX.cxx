@@ -15,7 +15,6 @@
 #include "cetlib_except/exception.h"
 
 #include "lardata/RecoObjects/KHitWireX.h"
-#include "larcore/Geometry/Geometry.h"
 
 namespace trkf {
 
@@ -37,15 +36,12 @@ namespace trkf {
   /// This method converts the hits in the input collection into
   /// KHitWireX objects and inserts them into the base class.  Hits
   /// corresponding to the same readout wire are grouped together as
-  /// KHitGroup objects.
+  /// KHitGroup objects, which share the cached surface of their wire
+  /// (see SurfWireCache), so there is no geometry lookup per hit.
   ///
   void KHitContainerWireX::fill(const art::PtrVector<recob::Hit>& hits,
 				int only_plane)
   {
-    // Get services.
-
-    art::ServiceHandle<geo::Geometry const> geom;
-
     // Make a temporary map from channel number to KHitGroup objects.
     // The KHitGroup pointers are borrowed references to KHitGroup
     // objects stored by value in the base class.
@@ -86,9 +82,10 @@ namespace trkf {
 
       const std::shared_ptr<const Surface>& psurf = pgr->getSurface();
 
-      // Construct KHitWireX object.
+      // Construct KHitWireX object (in the arena, if any).
 
-      std::shared_ptr<const KHitBase> phit(new KHitWireX(*ihit, psurf));
+      std::shared_ptr<const KHitBase> phit =
+	lar::makeArenaShared<KHitWireX>(getArena(), *ihit, psurf);
 
       // Insert hit into KHitGroup.
 
@@ -8,7 +8,9 @@
 ///
 ////////////////////////////////////////////////////////////////////////
 
+#include <typeinfo>
 #include "lardata/RecoObjects/KHitGroup.h"
+#include "lardata/RecoObjects/KHit.h"
 #include "cetlib_except/exception.h"
 
 namespace trkf {
@@ -72,6 +74,93 @@ namespace trkf {
     fHits.push_back(hit);
   }
 
+  /// Cheap pre-filter of measurements.
+  ///
+  /// Arguments:
+  ///
+  /// tre    - Track, normally propagated to the common surface.
+  /// nsigma - Maximum residual in units of its standard deviation.
+  /// hits   - Measurements passing the test (returned, in collection order).
+  ///
+  /// Returned value: number of measurements passing the test.
+  ///
+  /// Each measurement is tested with KHitBase::checkResidual, which
+  /// uses diagonal errors only.  Measurements that fail are pruned
+  /// without the matrix work of KHitBase::predict.  The accepted
+  /// measurements should still be predicted and cut on chisquare as
+  /// usual.  The accepted and pruned counters of the group are
+  /// incremented (atomically).
+  ///
+  std::size_t KHitGroup::preselectHits(const KETrack& tre, double nsigma,
+				       std::vector<std::shared_ptr<const KHitBase> >& hits) const
+  {
+    hits.clear();
+    hits.reserve(fHits.size());
+    for(const auto& phit : fHits) {
+      if(phit->checkResidual(tre, nsigma))
+	hits.push_back(phit);
+    }
+    fNumAccepted.add(hits.size());
+    fNumPruned.add(fHits.size() - hits.size());
+    return hits.size();
+  }
+
+  /// Predict measurements from one track state.
+  ///
+  /// Arguments:
+  ///
+  /// hits  - Measurements to predict, on the same surface (e.g. from preselectHits).
+  /// tre   - Track.
+  /// prop  - Propagator (only needed if the track is not on the measurement surface).
+  /// ref   - Reference track (optional).
+  /// chisq - Incremental chisquare of each measurement (returned, in collection
+  ///         order, negative if the prediction failed).
+  ///
+  /// Returned value: number of measurements predicted successfully.
+  ///
+  /// The result is the same as calling KHitBase::predict for each
+  /// measurement, which can then be used to update the track.  The
+  /// first one-dimensional measurement whose prediction only depends on
+  /// the track (KHit::isPredictionShared) is predicted normally,
+  /// including the propagation to the measurement surface.  The
+  /// following measurements of the same type copy its prediction and
+  /// H-matrix (KHit::predictAs), and only calculate their residual and
+  /// chisquare.  Other measurements are predicted normally.
+  ///
+  std::size_t KHitGroup::predictHits(const std::vector<std::shared_ptr<const KHitBase> >& hits,
+				     const KETrack& tre, const Propagator* prop, const KTrack* ref,
+				     std::vector<double>& chisq)
+  {
+    chisq.assign(hits.size(), -1.);
+    std::size_t nok = 0;
+
+    // Measurement holding the shared prediction.
+
+    const KHit<1>* pshared = 0;
+
+    for(std::size_t i=0; i<hits.size(); ++i) {
+      const KHitBase& hit = *hits[i];
+      const KHit<1>* phit1 = dynamic_cast<const KHit<1>*>(&hit);
+      bool ok = false;
+      if(phit1 == 0 || !phit1->isPredictionShared())
+	ok = hit.predict(tre, prop, ref);
+      else if(pshared == 0) {
+	pshared = phit1;
+	ok = hit.predict(tre, prop, ref);
+      }
+      else if(typeid(*phit1) == typeid(*pshared) &&
+	      phit1->getMeasSurface().get() == pshared->getMeasSurface().get())
+	ok = phit1->predictAs(*pshared);
+      else
+	ok = hit.predict(tre, prop, ref);
+      if(ok) {
+	chisq[i] = hit.getChisq();
+	++nok;
+      }
+    }
+    return nok;
+  }
+
   /// Equivalance operator.
   ///
   /// Objects with path flag false compare equal.
@@ -24,11 +24,26 @@
 /// The last two attributes is included as an aid in sorting
 /// measurements for inclusion in tracks.
 ///
+/// Method preselectHits is a cheap pre-filter of the measurements
+/// against a track on the common surface (KHitBase::checkResidual),
+/// meant to be applied before the full prediction and chisquare
+/// calculation of each measurement.  The group counts how many
+/// measurements were accepted and how many were pruned by the
+/// pre-filter.  The counters are atomic, so that preselectHits can be
+/// called concurrently on the same group.
+///
+/// Method predictHits predicts the measurements from one track state,
+/// sharing the propagation to the common surface and the H-matrix
+/// between the measurements whose prediction depends only on the
+/// track (KHit::isPredictionShared, e.g. KHitWireX and KHitWireLine).
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef KHITGROUP_H
 #define KHITGROUP_H
 
+#include <atomic>
+#include <cstddef>
 #include <vector>
 #include "lardata/RecoObjects/KHitBase.h"
 
@@ -61,6 +76,12 @@ namespace trkf {
     /// Estimated path distance.
     double getPath() const {return fPath;}
 
+    /// Number of measurements accepted by preselectHits.
+    std::size_t getNumAccepted() const {return fNumAccepted.get();}
+
+    /// Number of measurements pruned by preselectHits.
+    std::size_t getNumPruned() const {return fNumPruned.get();}
+
     // Modifiers.
 
     /// Clear the collection.
@@ -72,6 +93,27 @@ namespace trkf {
     /// Set path flag and estimated path distance.
     void setPath(bool has_path, double path) {fHasPath = has_path; fPath = path;}
 
+    /// Reset pre-filter counters.
+    void resetCounters() const {fNumAccepted.reset(); fNumPruned.reset();}
+
+    // Pre-filter.
+
+    /// Measurements compatible with a track within nsigma (cheap test).
+    std::size_t preselectHits(const KETrack& tre, double nsigma,
+			      std::vector<std::shared_ptr<const KHitBase> >& hits) const;
+
+    // Prediction.
+
+    /// Predict all measurements from one track state (return number predicted).
+    std::size_t predictHits(const KETrack& tre, const Propagator* prop, const KTrack* ref,
+			    std::vector<double>& chisq) const
+      {return predictHits(fHits, tre, prop, ref, chisq);}
+
+    /// Predict the specified measurements from one track state (return number predicted).
+    static std::size_t predictHits(const std::vector<std::shared_ptr<const KHitBase> >& hits,
+				   const KETrack& tre, const Propagator* prop, const KTrack* ref,
+				   std::vector<double>& chisq);
+
     // Relational operators, sort by estimated path distance.
 
     bool operator==(const KHitGroup& obj) const;  ///< Equivalance operator.
@@ -79,6 +121,20 @@ namespace trkf {
 
   private:
 
+    /// Copyable atomic counter.
+    class Counter
+    {
+    public:
+      Counter() : fN(0) {}
+      Counter(const Counter& obj) : fN(obj.get()) {}
+      Counter& operator=(const Counter& obj) {fN.store(obj.get(), std::memory_order_relaxed); return *this;}
+      std::size_t get() const {return fN.load(std::memory_order_relaxed);}
+      void add(std::size_t n) {fN.fetch_add(n, std::memory_order_relaxed);}
+      void reset() {fN.store(0, std::memory_order_relaxed);}
+    private:
+      std::atomic<std::size_t> fN;
+    };
+
     // Attributes.
 
     std::shared_ptr<const Surface> fSurf;                  ///< Common surface.
@@ -86,6 +142,8 @@ namespace trkf {
     std::vector<std::shared_ptr<const KHitBase> > fHits;   ///< Measuement collection.
     bool fHasPath;                                         ///< Path flag.
     double fPath;                                          ///< Estimated path distance.
+    mutable Counter fNumAccepted;                          ///< Measurements accepted by pre-filter.
+    mutable Counter fNumPruned;                            ///< Measurements pruned by pre-filter.
   };
 }
 
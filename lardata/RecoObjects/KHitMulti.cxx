@@ -10,13 +10,38 @@
 
 #include "lardata/RecoObjects/KHitMulti.h"
 #include "cetlib_except/exception.h"
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+  // Scratch array of doubles, on the stack up to N elements, on the
+  // heap beyond.
+  template <std::size_t N>
+  class SmallBuffer
+  {
+  public:
+    explicit SmallBuffer(std::size_t n) :
+      fHeap(n > N ? n : 0),
+      fData(n > N ? fHeap.data() : fStack)
+    {}
+    SmallBuffer(const SmallBuffer&) = delete;
+    SmallBuffer& operator=(const SmallBuffer&) = delete;
+    double& operator[](std::size_t i) {return fData[i];}
+  private:
+    double fStack[N];
+    std::vector<double> fHeap;
+    double* fData;
+  };
+}
 
 namespace trkf {
 
   /// Default Constructor.
   KHitMulti::KHitMulti() :
     fMeasDim(0),
-    fChisq(0.)
+    fChisq(0.),
+    fSequential(false)
   {}
 
   /// Initializing Constructor.
@@ -28,7 +53,8 @@ namespace trkf {
   KHitMulti::KHitMulti(const std::shared_ptr<const Surface>& psurf) :
     KHitBase(psurf),
     fMeasDim(0),
-    fChisq(0.)
+    fChisq(0.),
+    fSequential(false)
   {}
 
   /// Destructor.
@@ -97,7 +123,8 @@ namespace trkf {
   ///
   bool KHitMulti::predict(const KETrack& tre, const Propagator* prop, const KTrack* ref) const
   {
-    // Resize and clear all linear algebra objects.
+    // Resize (without reallocation if the dimension did not change)
+    // and clear all linear algebra objects.
 
     fMvec.resize(fMeasDim, false);
     fMvec.clear();
@@ -120,7 +147,7 @@ namespace trkf {
     fRinv.resize(fMeasDim, false);
     fRinv.clear();
 
-    fH.resize(fMeasDim, tre.getVector().size());
+    fH.resize(fMeasDim, tre.getVector().size(), false);
     fH.clear();
 
     // Update the prediction surface to be the track surface.
@@ -161,24 +188,42 @@ namespace trkf {
       // Calculate prediction error matrix.
       // T = H C H^T.
 
-      ublas::matrix<double> temp(fH.size2(), fMeasDim);
-      ublas::matrix<double> temp2(fMeasDim, fMeasDim);
-      temp = prod(tre.getError(), trans(fH));
-      temp2 = prod(fH, temp);
-      fPerr = ublas::symmetric_adaptor<ublas::matrix<double> >(temp2);
+      const TrackError& terr = tre.getError();
+      const unsigned int size = terr.size1();
+      SmallBuffer<5*MaxStackMeas> cht(size * fMeasDim);   // C H^T
+      for(unsigned int i = 0; i < size; ++i) {
+	for(int k = 0; k < fMeasDim; ++k) {
+	  double sum = 0.;
+	  for(unsigned int j = 0; j < size; ++j)
+	    sum += terr(i, j) * fH(k, j);
+	  cht[i*fMeasDim + k] = sum;
+	}
+      }
+      for(int k = 0; k < fMeasDim; ++k) {
+	for(int l = 0; l <= k; ++l) {
+	  double sum = 0.;
+	  for(unsigned int i = 0; i < size; ++i)
+	    sum += fH(k, i) * cht[i*fMeasDim + l];
+	  fPerr(k, l) = sum;
+	}
+      }
 
       // Update residual
 
-      fRvec = fMvec - fPvec;
-      fRerr = fMerr + fPerr;
+      noalias(fRvec) = fMvec - fPvec;
+      noalias(fRerr) = fMerr + fPerr;
       fRinv = fRerr;
       ok = syminvert(fRinv);
       if(ok) {
 
         // Calculate incremental chisquare.
 
-	ublas::vector<double> rtemp = prod(fRinv, fRvec);
-        fChisq = inner_prod(fRvec, rtemp);
+	fChisq = 0.;
+	for(int k = 0; k < fMeasDim; ++k) {
+	  fChisq += fRinv(k, k) * fRvec(k) * fRvec(k);
+	  for(int l = 0; l < k; ++l)
+	    fChisq += 2. * fRinv(k, l) * fRvec(k) * fRvec(l);
+	}
       }
     }
 
@@ -200,7 +245,10 @@ namespace trkf {
   ///
   /// tre - Track to be updated.
   ///
-  /// This method is almost an exact copy of the update method in KHit<N>.
+  /// The combined update is almost an exact copy of the update method
+  /// in KHit<N>.  The sequential update adds the measurements one at a
+  /// time, with the residual of each measurement taken with respect to
+  /// the track updated with the previous ones.
   ///
   void KHitMulti::update(KETrack& tre) const
   {
@@ -214,28 +262,89 @@ namespace trkf {
     const TrackError& terr = tre.getError();
     TrackVector::size_type size = tvec.size();
 
-    // Calculate gain matrix.
+    TrackVector newvec = tvec;
+    TrackError newerr = terr;
+
+    if(fSequential) {
+
+      // Loop over one-dimensional measurements.
+
+      TrackVector u(size);   // C h^T
+      for(int im = 0; im < fMeasDim; ++im) {
+
+	// Residual and residual error with respect to the updated track.
 
-    ublas::matrix<double> temp(size, fMeasDim);
-    ublas::matrix<double> gain(size, fMeasDim);
-    temp = prod(trans(fH), fRinv);
-    gain = prod(terr, temp);
+	double res = fRvec(im);
+	for(unsigned int j = 0; j < size; ++j)
+	  res -= fH(im, j) * (newvec(j) - tvec(j));
+	double reserr = fMerr(im, im);
+	for(unsigned int i = 0; i < size; ++i) {
+	  double sum = 0.;
+	  for(unsigned int j = 0; j < size; ++j)
+	    sum += newerr(i, j) * fH(im, j);
+	  u(i) = sum;
+	  reserr += fH(im, i) * sum;
+	}
+	if(reserr <= 0.)
+	  throw cet::exception("KHitMulti") << "Non-positive residual error in sequential update.\n";
 
-    // Calculate updated track state.
+	// Update track state and error matrix (C - C h^T h C / (h C h^T + V)).
 
-    TrackVector newvec = tre.getVector() + prod(gain, fRvec);
+	for(unsigned int i = 0; i < size; ++i) {
+	  newvec(i) += u(i) * res / reserr;
+	  for(unsigned int j = 0; j <= i; ++j)
+	    newerr(i, j) -= u(i) * u(j) / reserr;
+	}
+      }
+    }
+    else {
+
+      // Calculate gain matrix.
+
+      SmallBuffer<5*MaxStackMeas> cht(size * fMeasDim);    // C H^T
+      SmallBuffer<5*MaxStackMeas> gain(size * fMeasDim);
+      for(unsigned int i = 0; i < size; ++i) {
+	for(int k = 0; k < fMeasDim; ++k) {
+	  double sum = 0.;
+	  for(unsigned int j = 0; j < size; ++j)
+	    sum += terr(i, j) * fH(k, j);
+	  cht[i*fMeasDim + k] = sum;
+	}
+	for(int k = 0; k < fMeasDim; ++k) {
+	  double sum = 0.;
+	  for(int l = 0; l < fMeasDim; ++l)
+	    sum += cht[i*fMeasDim + l] * fRinv(l, k);
+	  gain[i*fMeasDim + k] = sum;
+	}
+      }
 
-    // Calculate updated error matrix.
+      // Calculate updated track state.
+
+      for(unsigned int i = 0; i < size; ++i) {
+	for(int k = 0; k < fMeasDim; ++k)
+	  newvec(i) += gain[i*fMeasDim + k] * fRvec(k);
+      }
 
-    TrackMatrix fact = ublas::identity_matrix<TrackVector::value_type>(size);
-    fact -= prod(gain, fH);
-    TrackMatrix errtemp1 = prod(terr, trans(fact));
-    TrackMatrix errtemp2 = prod(fact, errtemp1);
-    TrackError errtemp2s = ublas::symmetric_adaptor<TrackMatrix>(errtemp2);
-    ublas::matrix<double> errtemp3 = prod(fMerr, trans(gain));
-    TrackMatrix errtemp4 = prod(gain, errtemp3);
-    TrackError errtemp4s = ublas::symmetric_adaptor<TrackMatrix>(errtemp4);
-    TrackError newerr = errtemp2s + errtemp4s;
+      // Calculate updated error matrix.
+
+      TrackMatrix fact = ublas::identity_matrix<TrackVector::value_type>(size);
+      for(unsigned int i = 0; i < size; ++i) {
+	for(unsigned int j = 0; j < size; ++j) {
+	  for(int k = 0; k < fMeasDim; ++k)
+	    fact(i, j) -= gain[i*fMeasDim + k] * fH(k, j);
+	}
+      }
+      TrackMatrix errtemp1 = prod(terr, trans(fact));
+      TrackMatrix errtemp2 = prod(fact, errtemp1);
+      for(unsigned int i = 0; i < size; ++i) {
+	for(unsigned int j = 0; j <= i; ++j) {
+	  double sum = errtemp2(i, j);
+	  for(int k = 0; k < fMeasDim; ++k)
+	    sum += gain[i*fMeasDim + k] * fMerr(k, k) * gain[j*fMeasDim + k];
+	  newerr(i, j) = sum;
+	}
+      }
+    }
 
     // Update track.
 
@@ -41,6 +41,17 @@
 /// measurements).  Residuals and chisquare are calculated in the
 /// usual way.
 ///
+/// The combined attributes are resized only when the number of
+/// measurements changes, and the intermediate products of predict and
+/// update are kept on the stack for up to MaxStackMeas measurements,
+/// so that repeated predictions and updates do not allocate memory.
+///
+/// Optionally (setSequential), the update method adds the underlying
+/// measurements to the track one at a time, which needs neither the
+/// gain matrix nor the inverse residual error matrix of the combined
+/// measurement.  Since the underlying measurements are uncorrelated,
+/// the result is the same as the combined update, up to rounding.
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef KHITMULTI_H
@@ -54,6 +65,9 @@ namespace trkf {
   {
   public:
 
+    /// Number of measurements with intermediate products on the stack.
+    static constexpr unsigned int MaxStackMeas = 8;
+
     /// Default constructor.
     KHitMulti();
 
@@ -98,6 +112,9 @@ namespace trkf {
     /// Incremental chisquare.
     double getChisq() const {return fChisq;}
 
+    /// Sequential update flag.
+    bool getSequential() const {return fSequential;}
+
     // Modifiers.
 
     /// Add a measurement of unknown type.
@@ -106,6 +123,9 @@ namespace trkf {
     /// Add a one-dimensional measurement.
     void addMeas(const std::shared_ptr<const KHit<1> >& pmeas);
 
+    /// Update with one measurement at a time (or with the combined measurement).
+    void setSequential(bool sequential) {fSequential = sequential;}
+
     // Overrides.
 
     /// Prediction method (return false if fail).
@@ -133,6 +153,7 @@ namespace trkf {
     mutable ublas::symmetric_matrix<double> fRinv;  ///< Residual inverse error matrix.
     mutable ublas::matrix<double> fH;               ///< Kalman H-matrix.
     mutable double fChisq;                          ///< Incremental chisquare.
+    bool fSequential;                               ///< Sequential update flag.
   };
 }
 
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   KHitRecorded.cxx
+///
+/// \brief  Kalman filter wire measurement replayed from a KFitRecord.
+///
+/// \date   October 14, 2026
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include "lardata/RecoObjects/KHitRecorded.h"
+#include "cetlib_except/exception.h"
+
+namespace trkf {
+
+  /// Constructor.
+  ///
+  /// Arguments:
+  ///
+  /// psurf   - Measurement surface.
+  /// plane   - Measurement plane index.
+  /// kind    - Kind of the original measurement.
+  /// pitch   - Wire pitch.
+  /// meas    - Measurement.
+  /// measerr - Measurement error (variance).
+  ///
+  KHitRecorded::KHitRecorded(const std::shared_ptr<const Surface>& psurf, int plane,
+			     Kind kind, double pitch, double meas, double measerr) :
+    KHit(psurf),
+    fKind(kind),
+    fPitch(pitch)
+  {
+    setMeasPlane(plane);
+
+    KVector<1>::type mvec(1);
+    mvec(0) = meas;
+    setMeasVector(mvec);
+
+    KSymMatrix<1>::type merr(1);
+    merr(0,0) = measerr;
+    setMeasError(merr);
+  }
+
+  /// Destructor.
+  KHitRecorded::~KHitRecorded()
+  {}
+
+  bool KHitRecorded::subpredict(const KETrack& tre,
+				KVector<1>::type& pvec,
+				KSymMatrix<1>::type& perr,
+				KHMatrix<1>::type& hmatrix) const
+  {
+    // Make sure that the track surface and the measurement surface are the same.
+    // Throw an exception if they are not.
+
+    if(!getMeasSurface()->isEqual(*tre.getSurface()))
+      throw cet::exception("KHitRecorded") << "Track surface not the same as measurement surface.\n";
+
+    // Prediction is just track parameter 0 and error.
+
+    int size = tre.getVector().size();
+    pvec.resize(1, /* preserve */ false);
+    pvec.clear();
+    pvec(0) = tre.getVector()(0);
+
+    perr.resize(1, /* preserve */ false);
+    perr.clear();
+    perr(0,0) = tre.getError()(0,0);
+
+    // Update prediction error to include contribution from track slope
+    // (as in KHitWireX and KHitWireLine).
+
+    double slope = tre.getVector()(2);
+    if(fKind == WIRELINE)
+      slope = std::cos(slope);
+    double slopevar = fPitch*fPitch * slope*slope / 12.;
+    perr(0,0) += slopevar;
+
+    // Hmatrix - derivative with respect to parameter 0 is 1., all others are zero.
+
+    hmatrix.resize(1, size, /* preserve */ false);
+    hmatrix.clear();
+    hmatrix(0,0) = 1.;
+
+    return true;
+  }
+
+  /// Cheap compatibility test (as in KHitWireX).
+  bool KHitRecorded::checkResidual(const KETrack& tre, double nsigma) const
+  {
+    const std::shared_ptr<const Surface>& psurf = tre.getSurface();
+    if(psurf.get() != getMeasSurface().get() &&
+       (psurf.get() == 0 || !getMeasSurface()->isEqual(*psurf)))
+      return true;
+
+    double slope = tre.getVector()(2);
+    if(fKind == WIRELINE)
+      slope = std::cos(slope);
+    double slopevar = fPitch*fPitch * slope*slope / 12.;
+
+    double res = getMeasVector()(0) - tre.getVector()(0);
+    double var = getMeasError()(0,0) + tre.getError()(0,0) + slopevar;
+    return res*res <= nsigma*nsigma * var;
+  }
+
+} // end namespace trkf
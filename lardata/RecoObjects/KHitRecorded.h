@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   KHitRecorded.h
+///
+/// \brief  Kalman filter wire measurement replayed from a KFitRecord.
+///
+/// \date   October 14, 2026
+///
+/// This class is a type of one-dimensional Kalman filter measurement
+/// which reproduces a KHitWireX or KHitWireLine measurement without
+/// the original hit and without the geometry service, so that
+/// recorded fits (see KFitRecord) can be replayed outside art.
+///
+/// The prediction is the same as the one of the original measurement
+/// (track parameter 0 and its error), including the contribution of
+/// the track slope to the prediction error, using the wire pitch
+/// recorded with the measurement.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef KHITRECORDED_H
+#define KHITRECORDED_H
+
+#include "lardata/RecoObjects/KHit.h"
+
+namespace trkf {
+
+  class KHitRecorded : public KHit<1>
+  {
+  public:
+
+    /// Kind of the original measurement (defines the slope error).
+    enum Kind {WIREX = 0, WIRELINE = 1};
+
+    /// Constructor.
+    KHitRecorded(const std::shared_ptr<const Surface>& psurf, int plane,
+		 Kind kind, double pitch, double meas, double measerr);
+
+    /// Destructor.
+    virtual ~KHitRecorded();
+
+    // Accessors.
+
+    Kind getKind() const {return fKind;}        ///< Kind of original measurement.
+    double getPitch() const {return fPitch;}    ///< Wire pitch.
+
+    // Overrides.
+
+    // Prediction method.
+    virtual bool subpredict(const KETrack& tre,
+			    KVector<1>::type& pvec,
+			    KSymMatrix<1>::type& perr,
+			    KHMatrix<1>::type& hmatrix) const;
+
+    /// Cheap compatibility test.
+    virtual bool checkResidual(const KETrack& tre, double nsigma) const;
+
+  private:
+
+    // Attributes.
+
+    Kind fKind;      ///< Kind of original measurement.
+    double fPitch;   ///< Wire pitch.
+  };
+}
+
+#endif
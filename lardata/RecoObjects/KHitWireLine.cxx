@@ -10,6 +10,7 @@
 
 #include "lardata/RecoObjects/KHitWireLine.h"
 #include "lardata/RecoObjects/SurfWireLine.h"
+#include "lardata/RecoObjects/SurfWireCache.h"
 #include "larcore/Geometry/Geometry.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "cetlib_except/exception.h"
@@ -58,13 +59,12 @@ namespace trkf {
     // surface pointer is null, make a new SurfWireLine surface and
     // update the base class appropriately.  Otherwise, just check
     // that the specified surface agrees with the wire id + drift time.
+    // The wire geometry comes from the per-job cache (SurfWireCache).
 
-    if(psurf.get() == 0) {
-      std::shared_ptr<const Surface> new_psurf(new SurfWireLine(wireid, x));
-      setMeasSurface(new_psurf);
-    }
+    if(psurf.get() == 0)
+      setMeasSurface(SurfWireCache::instance().makeWireLine(wireid, x));
     else {
-      SurfWireLine check_surf(wireid, x);
+      SurfWireLine check_surf(*SurfWireCache::instance().getWireX(wireid), x);
       if(!check_surf.isEqual(*psurf))
 	throw cet::exception("KHitWireLine") << "Measurement surface doesn't match hit.\n";
     }
@@ -158,4 +158,36 @@ namespace trkf {
 
     return true;
   }
+
+  /// Cheap compatibility test.
+  ///
+  /// Arguments:
+  ///
+  /// tre    - Track (on any surface).
+  /// nsigma - Maximum residual in units of its standard deviation.
+  ///
+  /// Returned value: false if the measurement is incompatible with the track.
+  ///
+  /// The residual is calculated as in subpredict (the prediction is
+  /// the signed impact parameter), using only the diagonal
+  /// measurement and track errors, plus the same slope contribution.
+  /// The test can only be made if the track is on the measurement
+  /// surface, otherwise it returns true.
+  ///
+  bool KHitWireLine::checkResidual(const KETrack& tre, double nsigma) const
+  {
+    const std::shared_ptr<const Surface>& psurf = tre.getSurface();
+    if(psurf.get() != getMeasSurface().get() &&
+       (psurf.get() == 0 || !getMeasSurface()->isEqual(*psurf)))
+      return true;
+
+    art::ServiceHandle<geo::Geometry const> geom;
+    double pitch = geom->WirePitch();
+    double cosphi = std::cos(tre.getVector()(2));
+    double slopevar = pitch*pitch * cosphi*cosphi / 12.;
+
+    double res = getMeasVector()(0) - tre.getVector()(0);
+    double var = getMeasError()(0,0) + tre.getError()(0,0) + slopevar;
+    return res*res <= nsigma*nsigma * var;
+  }
 } // end namespace trkf
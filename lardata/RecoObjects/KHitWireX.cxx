@@ -10,6 +10,7 @@
 
 #include "lardata/RecoObjects/KHitWireX.h"
 #include "lardata/RecoObjects/SurfWireX.h"
+#include "lardata/RecoObjects/SurfWireCache.h"
 #include "larcore/Geometry/Geometry.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "cetlib_except/exception.h"
@@ -39,17 +40,15 @@ namespace trkf {
     geo::WireID wireid = hit->WireID();
 
     // Check the surface (determined by wire id).  If the
-    // surface pointer is null, make a new SurfWireX surface and
-    // update the base class appropriately.  Otherwise, just check
-    // that the specified surface agrees with the wire id.
-
-    if(psurf.get() == 0) {
-      std::shared_ptr<const Surface> new_psurf(new SurfWireX(wireid));
-      setMeasSurface(new_psurf);
-    }
-    else {
-      SurfWireX check_surf(wireid);
-      if(!check_surf.isEqual(*psurf))
+    // surface pointer is null, use the shared SurfWireX surface of
+    // this wire and update the base class appropriately.  Otherwise,
+    // just check that the specified surface agrees with the wire id.
+
+    std::shared_ptr<const SurfWireX> wire_psurf = SurfWireCache::instance().getWireX(wireid);
+    if(psurf.get() == 0)
+      setMeasSurface(wire_psurf);
+    else if(psurf.get() != wire_psurf.get()) {
+      if(!wire_psurf->isEqual(*psurf))
 	throw cet::exception("KHitWireX") << "Measurement surface doesn't match wire id.\n";
     }
 
@@ -156,4 +155,36 @@ namespace trkf {
 
     return true;
   }
+
+  /// Cheap compatibility test.
+  ///
+  /// Arguments:
+  ///
+  /// tre    - Track (on any surface).
+  /// nsigma - Maximum residual in units of its standard deviation.
+  ///
+  /// Returned value: false if the measurement is incompatible with the track.
+  ///
+  /// The residual is calculated as in subpredict (the prediction is
+  /// the u track parameter), using only the diagonal measurement and
+  /// track errors, plus the same slope contribution.  The test can
+  /// only be made if the track is on the measurement surface,
+  /// otherwise it returns true.
+  ///
+  bool KHitWireX::checkResidual(const KETrack& tre, double nsigma) const
+  {
+    const std::shared_ptr<const Surface>& psurf = tre.getSurface();
+    if(psurf.get() != getMeasSurface().get() &&
+       (psurf.get() == 0 || !getMeasSurface()->isEqual(*psurf)))
+      return true;
+
+    art::ServiceHandle<geo::Geometry const> geom;
+    double pitch = geom->WirePitch();
+    double slope = tre.getVector()(2);
+    double slopevar = pitch*pitch * slope*slope / 12.;
+
+    double res = getMeasVector()(0) - tre.getVector()(0);
+    double var = getMeasError()(0,0) + tre.getError()(0,0) + slopevar;
+    return res*res <= nsigma*nsigma * var;
+  }
 } // end namespace trkf
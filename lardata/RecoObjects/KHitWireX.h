@@ -54,6 +54,12 @@ namespace trkf {
 			    KSymMatrix<1>::type& perr,
 			    KHMatrix<1>::type& hmatrix) const;
 
+    /// Cheap compatibility test.
+    virtual bool checkResidual(const KETrack& tre, double nsigma) const;
+
+    /// Prediction depends only on the track (shared by all hits on a surface).
+    virtual bool isPredictionShared() const {return true;}
+
   private:
 
     // Attributes.
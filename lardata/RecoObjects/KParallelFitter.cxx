@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   KParallelFitter.cxx
+///
+/// \brief  Fit many independent track candidates concurrently.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "lardata/RecoObjects/KParallelFitter.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "cetlib_except/exception.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+namespace trkf {
+
+  /// Constructor.
+  ///
+  /// Arguments:
+  ///
+  /// prop     - Prototype propagator (cloned).
+  /// nthreads - Maximum number of concurrent fits (<= 0 for automatic).
+  ///
+  KParallelFitter::KParallelFitter(const Propagator& prop, int nthreads) :
+    fProp(prop.clone()),
+    fNumThreads(nthreads)
+  {}
+
+  /// Destructor.
+  KParallelFitter::~KParallelFitter()
+  {}
+
+  /// Fit candidates.
+  ///
+  /// Arguments:
+  ///
+  /// ncand  - Number of candidates (the fit function gets 0 to ncand-1).
+  /// fitter - Fit function.
+  ///
+  /// Returned value: fitted tracks of all candidates, in candidate order.
+  ///
+  /// Exceptions thrown by the fit function are passed on to the caller.
+  ///
+  std::vector<KGTrack> KParallelFitter::fit(std::size_t ncand,
+					    const FitFunction& fitter) const
+  {
+    if(!fitter)
+      throw cet::exception("KParallelFitter") << __func__ << ": no fit function\n";
+
+    // Fitted tracks of each candidate, filled concurrently.
+
+    std::vector<std::vector<KGTrack> > results(ncand);
+
+    tbb::task_arena arena(fNumThreads > 0 ? fNumThreads : tbb::task_arena::automatic);
+    arena.execute([&]() {
+	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, ncand, 1),
+			  [&](const tbb::blocked_range<std::size_t>& range) {
+			    for(std::size_t i = range.begin(); i != range.end(); ++i) {
+
+			      // Propagator private to this task.
+
+			      std::unique_ptr<const Propagator> prop(fProp->clone());
+			      fitter(i, *prop, results[i]);
+			    }
+			  });
+      });
+
+    // Merge in candidate order.
+
+    std::size_t ntracks = 0;
+    for(const auto& r : results)
+      ntracks += r.size();
+
+    std::vector<KGTrack> tracks;
+    tracks.reserve(ntracks);
+    for(auto& r : results) {
+      for(auto& trg : r)
+	tracks.push_back(std::move(trg));
+    }
+    return tracks;
+  }
+
+  /// Fit candidates and fill a recob::Track collection.
+  ///
+  /// Arguments:
+  ///
+  /// ncand    - Number of candidates.
+  /// fitter   - Fit function.
+  /// tracks   - recob::Track collection (fitted tracks are appended).
+  /// firstId  - Id of the first new recob::Track (the next get consecutive ids).
+  /// kgtracks - Optional collection to receive the fitted KGTracks (appended,
+  ///            in the same order as the new recob::Tracks).
+  ///
+  void KParallelFitter::fitTracks(std::size_t ncand, const FitFunction& fitter,
+				  std::vector<recob::Track>& tracks, int firstId,
+				  std::vector<KGTrack>* kgtracks) const
+  {
+    std::vector<KGTrack> fitted = fit(ncand, fitter);
+
+    // Conversion to recob::Track is done sequentially, in order.
+
+    tracks.reserve(tracks.size() + fitted.size());
+    int id = firstId;
+    for(const KGTrack& trg : fitted)
+      trg.fillTrack(tracks, id++);
+
+    if(kgtracks != 0) {
+      kgtracks->reserve(kgtracks->size() + fitted.size());
+      for(auto& trg : fitted)
+	kgtracks->push_back(std::move(trg));
+    }
+  }
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   KParallelFitter.h
+///
+/// \brief  Fit many independent track candidates concurrently.
+///
+/// This class runs a Kalman fit function on a set of independent
+/// track candidates in parallel, using a TBB task arena.  The fit of
+/// one candidate is sequential, as usual.
+///
+/// Propagators may keep mutable state (e.g. PropCache), so each task
+/// gets its own clone of the prototype propagator passed to the
+/// constructor.  The propagator clones share the (stateless, const)
+/// interactor of the prototype.  Anything else the fit function uses
+/// must either be local to the call, or safe to share between threads.
+///
+/// The fitted tracks (KGTrack) of all candidates are merged in
+/// candidate order, and within a candidate in the order the fit
+/// function produced them, independent of the number of threads and
+/// of the order in which the tasks ran.  Method fitTracks also fills
+/// the corresponding recob::Track collection, with track ids assigned
+/// in the same order.
+///
+/// Example:
+///
+///   trkf::KParallelFitter fitter(prop);
+///   std::vector<recob::Track> tracks;
+///   fitter.fitTracks(candidates.size(),
+///     [&](std::size_t i, const trkf::Propagator& p, std::vector<trkf::KGTrack>& out)
+///       { ... fit candidates[i] with propagator p, append to out ... },
+///     tracks);
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef KPARALLELFITTER_H
+#define KPARALLELFITTER_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "lardata/RecoObjects/Propagator.h"
+#include "lardata/RecoObjects/KGTrack.h"
+
+namespace recob {
+  class Track;
+}
+
+namespace trkf {
+
+  class KParallelFitter
+  {
+  public:
+
+    /// Fit function: fit candidate icand using propagator prop (private
+    /// to the call), and append the fitted tracks (maybe none) to tracks.
+    using FitFunction = std::function<void(std::size_t icand,
+					   const Propagator& prop,
+					   std::vector<KGTrack>& tracks)>;
+
+    /// Constructor (nthreads <= 0 means as many as TBB chooses).
+    KParallelFitter(const Propagator& prop, int nthreads = 0);
+
+    /// Destructor.
+    ~KParallelFitter();
+
+    // Accessors.
+
+    const Propagator& getPropagator() const {return *fProp;}
+    int getNumThreads() const {return fNumThreads;}
+
+    // Methods.
+
+    /// Fit ncand candidates, return the fitted tracks in candidate order.
+    std::vector<KGTrack> fit(std::size_t ncand, const FitFunction& fitter) const;
+
+    /// Fit ncand candidates, and append the fitted tracks to a
+    /// recob::Track collection, with ids starting from firstId.
+    void fitTracks(std::size_t ncand, const FitFunction& fitter,
+		   std::vector<recob::Track>& tracks, int firstId = 0,
+		   std::vector<KGTrack>* kgtracks = 0) const;
+
+  private:
+
+    // Attributes.
+
+    std::shared_ptr<const Propagator> fProp;  ///< Prototype propagator.
+    int fNumThreads;                          ///< Maximum concurrency (<=0: automatic).
+  };
+}
+
+#endif
@@ -34,12 +34,20 @@
 /// built-in symmetric matrix inverse function.  We provide one here
 /// as free function syminvert.
 ///
+/// The inversions of the matrices defined here (lower triangular and
+/// row major storage) work directly on the underlying storage, with
+/// closed forms for sizes 1 and 2 (the usual measurement dimensions),
+/// instead of going through the ublas element accessors and (for
+/// general matrices) a heap allocated LU decomposition.
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef KALMANLINEARALGEBRA_H
 #define KALMANLINEARALGEBRA_H
 
 #include <cmath>
+#include <cstddef>
+#include <algorithm>
 #include "boost/serialization/array_wrapper.hpp"  // workaround for deficiency in boost 1.64
 #include "boost/numeric/ublas/vector.hpp"
 #include "boost/numeric/ublas/matrix.hpp"
@@ -186,6 +194,182 @@ namespace trkf {
     return true;
   }
 
+  namespace detail {
+
+    /// Invert symmetric matrix in packed lower triangular row major
+    /// storage (element (i,j), j <= i, at i*(i+1)/2+j) in situ.
+    ///
+    /// Same algorithm as the generic syminvert, working on the storage.
+    ///
+    template <class T>
+    bool packed_syminvert(T* m, std::size_t n)
+    {
+      // Closed forms for the smallest matrices.
+
+      if(n == 1) {
+	if(m[0] == 0.)
+	  return false;
+	m[0] = 1./m[0];
+	return true;
+      }
+      if(n == 2) {
+	T const det = m[0]*m[2] - m[1]*m[1];
+	if(det == 0. || m[0] == 0.)
+	  return false;
+	T const a = m[0];
+	m[0] = m[2]/det;
+	m[1] = -m[1]/det;
+	m[2] = a/det;
+	return true;
+      }
+
+      // Start of each row in the packed storage.
+
+      auto row = [m](std::size_t i) { return m + i*(i+1)/2; };
+
+      // In situ Cholesky decomposition m = LDL^T.
+
+      for(std::size_t i = 0; i < n; ++i) {
+	T* ri = row(i);
+	for(std::size_t j = 0; j <= i; ++j) {
+	  T const* rj = row(j);
+	  T ele = ri[j];
+	  for(std::size_t k = 0; k < j; ++k)
+	    ele -= row(k)[k] * ri[k] * rj[k];
+	  if(i == j) {
+	    if(ele == 0.)
+	      return false;
+	  }
+	  else
+	    ele = ele / rj[j];
+	  ri[j] = ele;
+	}
+      }
+
+      // In situ inversion of D and L.
+
+      for(std::size_t i = 0; i < n; ++i) {
+	T* ri = row(i);
+	for(std::size_t j = 0; j <= i; ++j) {
+	  if(i == j)
+	    ri[i] = 1./ri[i];
+	  else {
+	    T sum = -ri[j];
+	    for(std::size_t k = j+1; k < i; ++k)
+	      sum -= ri[k] * row(k)[j];
+	    ri[j] = sum;
+	  }
+	}
+      }
+
+      // Recompose the inverse matrix m = L^T DL.
+
+      for(std::size_t i = 0; i < n; ++i) {
+	T* ri = row(i);
+	for(std::size_t j = 0; j <= i; ++j) {
+	  T sum = ri[i];
+	  if(i != j)
+	    sum *= ri[j];
+	  for(std::size_t k = i+1; k < n; ++k) {
+	    T const* rk = row(k);
+	    sum += rk[k] * rk[i] * rk[j];
+	  }
+	  ri[j] = sum;
+	}
+      }
+      return true;
+    }
+
+    /// Invert square matrix in row major storage in situ, by Gauss-Jordan
+    /// elimination with partial pivoting, for sizes up to MaxN.
+    ///
+    template <std::size_t MaxN, class T>
+    bool dense_invert(T* m, std::size_t n)
+    {
+      if(n == 1) {
+	if(m[0] == 0.)
+	  return false;
+	m[0] = 1./m[0];
+	return true;
+      }
+      if(n == 2) {
+	T const det = m[0]*m[3] - m[1]*m[2];
+	if(det == 0.)
+	  return false;
+	T const a = m[0];
+	m[0] = m[3]/det;
+	m[1] = -m[1]/det;
+	m[2] = -m[2]/det;
+	m[3] = a/det;
+	return true;
+      }
+
+      // Column permutation from the row pivoting.
+
+      std::size_t perm[MaxN];
+      for(std::size_t i = 0; i < n; ++i)
+	perm[i] = i;
+
+      for(std::size_t c = 0; c < n; ++c) {
+
+	// Pivot.
+
+	std::size_t p = c;
+	for(std::size_t r = c+1; r < n; ++r) {
+	  if(std::abs(m[r*n+c]) > std::abs(m[p*n+c]))
+	    p = r;
+	}
+	if(m[p*n+c] == 0.)
+	  return false;
+	if(p != c) {
+	  for(std::size_t k = 0; k < n; ++k)
+	    std::swap(m[p*n+k], m[c*n+k]);
+	  std::swap(perm[p], perm[c]);
+	}
+
+	// Eliminate, building the inverse in place.
+
+	T* rc = m + c*n;
+	T const inv = 1./rc[c];
+	rc[c] = 1.;
+	for(std::size_t k = 0; k < n; ++k)
+	  rc[k] *= inv;
+	for(std::size_t r = 0; r < n; ++r) {
+	  if(r == c)
+	    continue;
+	  T* rr = m + r*n;
+	  T const f = rr[c];
+	  rr[c] = 0.;
+	  for(std::size_t k = 0; k < n; ++k)
+	    rr[k] -= f * rc[k];
+	}
+      }
+
+      // Undo the row permutation on the columns of the inverse.
+
+      T tmp[MaxN];
+      for(std::size_t r = 0; r < n; ++r) {
+	T* rr = m + r*n;
+	for(std::size_t k = 0; k < n; ++k)
+	  tmp[perm[k]] = rr[k];
+	std::copy(tmp, tmp + n, rr);
+      }
+      return true;
+    }
+
+  } // namespace detail
+
+  /// Invert symmetric matrix (return false if singular), for the storage
+  /// used by KSymMatrix and TrackError.
+  ///
+  template <class T, class A>
+  bool syminvert(ublas::symmetric_matrix<T, ublas::lower, ublas::row_major, A>& m)
+  {
+    if(m.size1() == 0)
+      return true;
+    return detail::packed_syminvert(&m.data()[0], m.size1());
+  }
+
   /// Invert general square matrix by LU decomposition with partial pivoting.
   /// Return false if singular or not square.
   ///
@@ -225,6 +409,31 @@ namespace trkf {
     return true;
   }
 
+  /// Invert general square matrix (return false if singular or not
+  /// square), for the storage used by KMatrix and TrackMatrix.
+  ///
+  /// Matrices up to 5x5 are inverted in situ by Gauss-Jordan elimination
+  /// with partial pivoting, larger ones by LU decomposition.
+  ///
+  template <class T, class A>
+  bool invert(ublas::matrix<T, ublas::row_major, A>& m)
+  {
+    if(m.size1() != m.size2())
+      return false;
+    if(m.size1() == 0)
+      return true;
+    if(m.size1() <= 5)
+      return detail::dense_invert<5>(&m.data()[0], m.size1());
+
+    ublas::permutation_matrix<std::size_t> pm(m.size1());
+    ublas::matrix<T, ublas::row_major, A> mcopy(m);
+    if(lu_factorize(mcopy, pm) != 0)
+      return false;
+    m.assign(ublas::identity_matrix<T>(m.size1()));
+    lu_substitute(mcopy, pm, m);
+    return true;
+  }
+
   /// Trace of matrix.
   ///
   template <class M>
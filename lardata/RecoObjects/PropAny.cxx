@@ -9,9 +9,6 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "lardata/RecoObjects/PropAny.h"
-#include "lardata/RecoObjects/SurfYZLine.h"
-#include "lardata/RecoObjects/SurfYZPlane.h"
-#include "lardata/RecoObjects/SurfXYZPlane.h"
 #include "lardata/RecoObjects/InteractPlane.h"
 #include "cetlib_except/exception.h"
 
@@ -40,7 +37,8 @@ namespace trkf {
   /// Propagate without error.
   /// Optionally return propagation matrix and noise matrix.
   /// This method tests the type of the destination surface, and calls
-  /// the corresponding typed propagator.
+  /// the corresponding typed propagator.  The test is a single typeid
+  /// comparison for the known surface types (see visitSurface()).
   ///
   /// Arguments:
   ///
@@ -61,24 +59,11 @@ namespace trkf {
 			  TrackMatrix* prop_matrix,
 			  TrackError* noise_matrix) const
   {
-    // Default result.
+    // Call the propagator of the type of the destination surface.
 
-    boost::optional<double> result(false, 0.);
-
-    // Test the type of the destination surface.
-
-    if(dynamic_cast<const SurfYZLine*>(&*psurf))
-      result = fPropYZLine.short_vec_prop(trk, psurf, dir, doDedx, prop_matrix, noise_matrix);
-    else if(dynamic_cast<const SurfYZPlane*>(&*psurf))
-      result = fPropYZPlane.short_vec_prop(trk, psurf, dir, doDedx, prop_matrix, noise_matrix);
-    else if(dynamic_cast<const SurfXYZPlane*>(&*psurf))
-      result = fPropXYZPlane.short_vec_prop(trk, psurf, dir, doDedx, prop_matrix, noise_matrix);
-    else
-      throw cet::exception("PropAny") << "Destination surface has unknown type.\n";
-
-    // Done.
-
-    return result;
+    return visitSurface(*psurf, [&](const auto& to)
+      { return propagator(to).short_vec_prop(trk, psurf, dir, doDedx,
+					     prop_matrix, noise_matrix); });
   }
 
   /// Propagate without error to dynamically generated origin surface.
@@ -99,24 +84,16 @@ namespace trkf {
 			   const std::shared_ptr<const Surface>& porient,
 			   TrackMatrix* prop_matrix) const
   {
-    // Default result.
-
-    boost::optional<double> result(false, 0.);
+    // Call the propagator of the type of the destination surface.
 
-    // Test the type of the destination surface.
-
-    if(dynamic_cast<const SurfYZLine*>(&*porient))
-      result = fPropYZLine.origin_vec_prop(trk, porient, prop_matrix);
-    else if(dynamic_cast<const SurfYZPlane*>(&*porient))
-      result = fPropYZPlane.origin_vec_prop(trk, porient, prop_matrix);
-    else if(dynamic_cast<const SurfXYZPlane*>(&*porient))
-      result = fPropXYZPlane.origin_vec_prop(trk, porient, prop_matrix);
-    else
-      throw cet::exception("PropAny") << "Destination surface has unknown type.\n";
-
-    // Done.
+    return visitSurface(*porient, [&](const auto& to)
+      { return propagator(to).origin_vec_prop(trk, porient, prop_matrix); });
+  }
 
-    return result;
+  /// Underlying propagator for surfaces of unknown type: throws.
+  const Propagator& PropAny::propagator(const Surface&) const
+  {
+    throw cet::exception("PropAny") << "Destination surface has unknown type.\n";
   }
 
 } // end namespace trkf
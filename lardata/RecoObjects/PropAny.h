@@ -8,7 +8,8 @@
 ///
 /// Class for propagating between any two surfaces.  This propagator
 /// tests the type of the destination surface, and calls the
-/// propagator.
+/// propagator.  The dispatch goes through visitSurface() (see
+/// SurfaceVariant.h) rather than a chain of dynamic_cast.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -19,6 +20,7 @@
 #include "lardata/RecoObjects/PropYZLine.h"
 #include "lardata/RecoObjects/PropYZPlane.h"
 #include "lardata/RecoObjects/PropXYZPlane.h"
+#include "lardata/RecoObjects/SurfaceVariant.h"
 
 namespace trkf {
 
@@ -50,10 +52,26 @@ namespace trkf {
                                                    const std::shared_ptr<const Surface>& porient,
                                                    TrackMatrix* prop_matrix = 0) const;
 
-    // Data members.
-
   private:
 
+    /// Underlying propagator for surfaces of type S.
+    template <typename S>
+    const Propagator& propagator(const S&) const
+    {
+      using Geometry_t = SurfaceGeometry_t<S>;
+      if constexpr (std::is_same<Geometry_t, SurfYZLine>::value)
+	return fPropYZLine;
+      else if constexpr (std::is_same<Geometry_t, SurfYZPlane>::value)
+	return fPropYZPlane;
+      else
+	return fPropXYZPlane;
+    }
+
+    /// Underlying propagator for surfaces of unknown type: throws.
+    const Propagator& propagator(const Surface& surf) const;
+
+    // Data members.
+
     /// Underlying propagators.
 
     PropYZLine fPropYZLine;
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   PropCache.cxx
+///
+/// \brief  Memoizing wrapper around another propagator.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include "lardata/RecoObjects/PropCache.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  /// Combine a hash value into a seed (same as boost::hash_combine).
+  void hash_combine(std::size_t& seed, std::size_t value)
+  {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+}
+
+namespace trkf {
+
+  /// Constructor.
+  ///
+  /// Arguments.
+  ///
+  /// prop        - Underlying propagator.
+  /// max_entries - Cache size at which the cache is flushed.
+  ///
+  /// The energy loss settings and the interactor are those of the
+  /// underlying propagator.
+  ///
+  PropCache::PropCache(const std::shared_ptr<const Propagator>& prop, std::size_t max_entries) :
+    Propagator((prop.get() != 0 ? prop->getTcut() : 0.),
+	       (prop.get() != 0 ? prop->getDoDedx() : false),
+	       (prop.get() != 0 ? prop->getInteractor() : std::shared_ptr<const Interactor>())),
+    fProp(prop),
+    fMaxEntries(max_entries),
+    fHits(0),
+    fMisses(0)
+  {
+    if(fProp.get() == 0)
+      throw cet::exception("PropCache") << "No underlying propagator.\n";
+  }
+
+  /// Destructor.
+  PropCache::~PropCache()
+  {}
+
+  /// Key equality.  State vectors must agree exactly.
+  bool PropCache::Key::operator==(const Key& other) const
+  {
+    if(from != other.from || to != other.to || trkdir != other.trkdir ||
+       pdg != other.pdg || dir != other.dir || doDedx != other.doDedx ||
+       longdist != other.longdist ||
+       vec.size() != other.vec.size())
+      return false;
+    for(unsigned int i = 0; i < vec.size(); ++i) {
+      if(vec(i) != other.vec(i))
+	return false;
+    }
+    return true;
+  }
+
+  /// Key hash.
+  std::size_t PropCache::KeyHash::operator()(const Key& key) const
+  {
+    std::size_t seed = std::hash<const Surface*>()(key.from.get());
+    hash_combine(seed, std::hash<const Surface*>()(key.to.get()));
+    hash_combine(seed, std::hash<int>()(key.trkdir + 4*key.dir + 16*key.doDedx + 32*key.longdist));
+    hash_combine(seed, std::hash<int>()(key.pdg));
+    for(unsigned int i = 0; i < key.vec.size(); ++i)
+      hash_combine(seed, std::hash<double>()(key.vec(i)));
+    return seed;
+  }
+
+  /// Propagate without error (short distance), using the cache.
+  boost::optional<double>
+  PropCache::short_vec_prop(KTrack& trk,
+			    const std::shared_ptr<const Surface>& psurf,
+			    Propagator::PropDirection dir,
+			    bool doDedx,
+			    TrackMatrix* prop_matrix,
+			    TrackError* noise_matrix) const
+  {
+    return cached_prop(trk, psurf, dir, doDedx, prop_matrix, noise_matrix, false);
+  }
+
+  /// Propagate without error (long distance), using the cache.
+  boost::optional<double>
+  PropCache::vec_prop(KTrack& trk,
+		      const std::shared_ptr<const Surface>& psurf,
+		      Propagator::PropDirection dir,
+		      bool doDedx,
+		      TrackMatrix* prop_matrix,
+		      TrackError* noise_matrix) const
+  {
+    return cached_prop(trk, psurf, dir, doDedx, prop_matrix, noise_matrix, true);
+  }
+
+  /// Propagate without error using the cache.
+  /// Optionally return propagation matrix and noise matrix.
+  ///
+  /// Arguments:
+  ///
+  /// trk   - Track to propagate.
+  /// psurf - Destination surface.
+  /// dir   - Propagation direction (FORWARD, BACKWARD, or UNKNOWN).
+  /// doDedx - dE/dx enable/disable flag.
+  /// prop_matrix - Pointer to optional propagation matrix.
+  /// noise_matrix - Pointer to optional noise matrix.
+  /// longdist - Long distance (vec_prop) or short distance (short_vec_prop).
+  ///
+  /// Returned value: propagation distance + success flag.
+  ///
+  /// A cache entry is used only if it holds all of the requested
+  /// matrices.  Otherwise the propagation is recomputed and the entry
+  /// is replaced.
+  ///
+  boost::optional<double>
+  PropCache::cached_prop(KTrack& trk,
+			 const std::shared_ptr<const Surface>& psurf,
+			 Propagator::PropDirection dir,
+			 bool doDedx,
+			 TrackMatrix* prop_matrix,
+			 TrackError* noise_matrix,
+			 bool longdist) const
+  {
+    Key key;
+    key.from = trk.getSurface();
+    key.to = psurf;
+    key.vec = trk.getVector();
+    key.trkdir = trk.getDirection();
+    key.pdg = trk.PdgCode();
+    key.dir = dir;
+    key.doDedx = doDedx;
+    key.longdist = longdist;
+
+    // Look for a usable cache entry.
+
+    auto it = fCache.find(key);
+    if(it != fCache.end() &&
+       (prop_matrix == 0 || it->second.hasPropMatrix) &&
+       (noise_matrix == 0 || it->second.hasNoiseMatrix)) {
+      ++fHits;
+      const Entry& entry = it->second;
+      if(entry.dist) {
+	trk.KTrack::operator=(entry.trk);   // Not the error matrix of a KETrack.
+	if(prop_matrix != 0)
+	  *prop_matrix = entry.prop_matrix;
+	if(noise_matrix != 0)
+	  *noise_matrix = entry.noise_matrix;
+      }
+      return entry.dist;
+    }
+
+    // Not found.  Propagate and remember the result.
+
+    ++fMisses;
+    Entry entry;
+    entry.hasPropMatrix = (prop_matrix != 0);
+    entry.hasNoiseMatrix = (noise_matrix != 0);
+    TrackMatrix* pm = (entry.hasPropMatrix ? &entry.prop_matrix : 0);
+    TrackError* nm = (entry.hasNoiseMatrix ? &entry.noise_matrix : 0);
+    entry.dist = (longdist ?
+		  fProp->vec_prop(trk, psurf, dir, doDedx, pm, nm) :
+		  fProp->short_vec_prop(trk, psurf, dir, doDedx, pm, nm));
+    if(entry.dist) {
+      entry.trk = trk;
+      if(prop_matrix != 0)
+	*prop_matrix = entry.prop_matrix;
+      if(noise_matrix != 0)
+	*noise_matrix = entry.noise_matrix;
+    }
+
+    if(it != fCache.end())
+      it->second = entry;
+    else {
+      if(fCache.size() >= fMaxEntries)
+	fCache.clear();
+      fCache.emplace(key, entry);
+    }
+
+    return entry.dist;
+  }
+
+  /// Propagate without error to dynamically generated origin surface.
+  /// Not cached (origin propagation is cheap).
+  ///
+  /// Arguments:
+  ///
+  /// trk - Track to propagate.
+  /// porient - Orientation surface.
+  /// prop_matrix - Pointer to optional propagation matrix.
+  ///
+  /// Returned value: propagation distance + success flag.
+  ///
+  boost::optional<double>
+  PropCache::origin_vec_prop(KTrack& trk,
+			     const std::shared_ptr<const Surface>& porient,
+			     TrackMatrix* prop_matrix) const
+  {
+    return fProp->origin_vec_prop(trk, porient, prop_matrix);
+  }
+
+  /// Propagate without error to many surfaces.
+  /// Uses the batch propagation of the underlying propagator (not cached).
+  void PropCache::batch_vec_prop(const KTrack& trk,
+				 const std::vector<std::shared_ptr<const Surface> >& psurfs,
+				 Propagator::PropDirection dir,
+				 bool doDedx,
+				 BatchResult& result,
+				 bool doPropMatrix,
+				 bool doNoiseMatrix) const
+  {
+    fProp->batch_vec_prop(trk, psurfs, dir, doDedx, result, doPropMatrix, doNoiseMatrix);
+  }
+}
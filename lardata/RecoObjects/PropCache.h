@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   PropCache.h
+///
+/// \brief  Memoizing wrapper around another propagator.
+///
+/// Class PropCache wraps a propagator and remembers the results of
+/// its propagations without error, short distance (short_vec_prop)
+/// and long distance (vec_prop).  Since the other propagation methods
+/// (lin_prop, err_prop, noise_prop) are implemented in terms of
+/// vec_prop, they all benefit from the cache.  A long distance
+/// propagation is cached as a whole (its intermediate steps go to
+/// surfaces made on the fly, which would never be found again).
+///
+/// A cache entry is keyed on the identity (pointer) of the starting
+/// and destination surfaces, and on the starting track state (state
+/// vector, direction and pdg code), propagation direction and dE/dx
+/// flag.  A repeated propagation of an unchanged track to the same
+/// surface, as happens when the Kalman filter revisits a surface during
+/// smoothing and refits, or tries several hits of one KHitGroup, then
+/// returns the stored track, propagation matrix and noise matrix
+/// instead of recomputing them.  The state vector must match exactly.
+///
+/// Entries hold shared pointers to their surfaces, so surface identity
+/// remains meaningful for as long as an entry exists.  The cache is
+/// flushed when it reaches the configured number of entries.
+///
+/// Caching is opt-in: wrap the propagator used by the fitter, e.g.
+///
+///   PropCache prop(std::shared_ptr<const Propagator>(new PropAny(tcut, doDedx)));
+///
+/// The cache is not protected against concurrent use.  Use one
+/// PropCache (e.g. one clone) per thread.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef PROPCACHE_H
+#define PROPCACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include "lardata/RecoObjects/Propagator.h"
+
+namespace trkf {
+
+  class PropCache : public trkf::Propagator
+  {
+  public:
+
+    /// Constructor.
+    PropCache(const std::shared_ptr<const Propagator>& prop, std::size_t max_entries = 10000);
+
+    /// Destructor.
+    virtual ~PropCache();
+
+    // Accessors.
+
+    const std::shared_ptr<const Propagator>& getPropagator() const {return fProp;}
+    std::size_t size() const {return fCache.size();}    ///< Number of cache entries.
+    std::size_t hits() const {return fHits;}            ///< Propagations found in cache.
+    std::size_t misses() const {return fMisses;}        ///< Propagations computed.
+
+    // Modifiers.
+
+    /// Remove all cache entries (counters are kept).
+    void clear() const {fCache.clear();}
+
+    // Overrides.
+
+    /// Clone method.
+    Propagator* clone() const {return new PropCache(*this);}
+
+    /// Propagate without error (cached).
+    boost::optional<double> short_vec_prop(KTrack& trk,
+					   const std::shared_ptr<const Surface>& surf,
+					   Propagator::PropDirection dir,
+					   bool doDedx,
+					   TrackMatrix* prop_matrix = 0,
+					   TrackError* noise_matrix = 0) const;
+
+    /// Propagate without error, long distance (cached).
+    boost::optional<double> vec_prop(KTrack& trk,
+				     const std::shared_ptr<const Surface>& psurf,
+				     Propagator::PropDirection dir,
+				     bool doDedx,
+				     TrackMatrix* prop_matrix = 0,
+				     TrackError* noise_matrix = 0) const;
+
+    /// Propagate without error to surface whose origin parameters coincide with track position.
+    virtual boost::optional<double> origin_vec_prop(KTrack& trk,
+						    const std::shared_ptr<const Surface>& porient,
+						    TrackMatrix* prop_matrix = 0) const;
+
+    /// Propagate without error to many surfaces (not cached).
+    virtual void batch_vec_prop(const KTrack& trk,
+				const std::vector<std::shared_ptr<const Surface> >& psurfs,
+				Propagator::PropDirection dir,
+				bool doDedx,
+				BatchResult& result,
+				bool doPropMatrix = false,
+				bool doNoiseMatrix = false) const;
+
+  private:
+
+    /// Cache key.
+    struct Key
+    {
+      std::shared_ptr<const Surface> from;     ///< Starting surface.
+      std::shared_ptr<const Surface> to;       ///< Destination surface.
+      TrackVector vec;                         ///< Starting state vector.
+      Surface::TrackDirection trkdir;          ///< Starting track direction.
+      int pdg;                                 ///< Pdg code.
+      Propagator::PropDirection dir;           ///< Propagation direction.
+      bool doDedx;                             ///< dE/dx flag.
+      bool longdist;                           ///< Long distance propagation (vec_prop).
+
+      bool operator==(const Key& other) const;
+    };
+
+    /// Hash of cache key.
+    struct KeyHash
+    {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    /// Cached propagation result.
+    struct Entry
+    {
+      boost::optional<double> dist;            ///< Propagation distance + success flag.
+      KTrack trk;                              ///< Propagated track.
+      bool hasPropMatrix;                      ///< Propagation matrix is stored.
+      bool hasNoiseMatrix;                     ///< Noise matrix is stored.
+      TrackMatrix prop_matrix;                 ///< Propagation matrix.
+      TrackError noise_matrix;                 ///< Noise matrix.
+    };
+
+    /// Look up or compute a propagation.
+    boost::optional<double> cached_prop(KTrack& trk,
+					const std::shared_ptr<const Surface>& psurf,
+					Propagator::PropDirection dir,
+					bool doDedx,
+					TrackMatrix* prop_matrix,
+					TrackError* noise_matrix,
+					bool longdist) const;
+
+    // Attributes.
+
+    std::shared_ptr<const Propagator> fProp;   ///< Underlying propagator.
+    std::size_t fMaxEntries;                   ///< Maximum number of cache entries.
+
+    // Cache and counters.
+
+    mutable std::unordered_map<Key, Entry, KeyHash> fCache;
+    mutable std::size_t fHits;
+    mutable std::size_t fMisses;
+  };
+}
+
+#endif
@@ -9,6 +9,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <map>
 #include "lardata/RecoObjects/PropYZPlane.h"
 #include "lardata/RecoObjects/SurfYZLine.h"
 #include "lardata/RecoObjects/SurfYZPlane.h"
@@ -248,6 +249,74 @@ namespace trkf {
     return result;
   }
 
+  /// Propagate without error to many surfaces.
+  ///
+  /// Arguments:
+  ///
+  /// trk           - Track to propagate (not modified).
+  /// psurfs        - Destination surfaces.
+  /// dir           - Propagation direction (FORWARD, BACKWARD, or UNKNOWN).
+  /// doDedx        - dE/dx enable/disable flag.
+  /// result        - Propagated tracks, distances and matrices, one per surface.
+  /// doPropMatrix  - Return propagation matrices.
+  /// doNoiseMatrix - Return noise matrices.
+  ///
+  /// Destination surfaces of type SurfYZPlane are grouped by orientation
+  /// (phi).  The transformation to the origin surface is done
+  /// once per group, and the straight line propagation to all the
+  /// planes of the group is done together.  Other surface types are
+  /// propagated one at a time.
+  ///
+  void PropYZPlane::batch_vec_prop(const KTrack& trk,
+				   const std::vector<std::shared_ptr<const Surface> >& psurfs,
+				   Propagator::PropDirection dir,
+				   bool doDedx,
+				   BatchResult& result,
+				   bool doPropMatrix,
+				   bool doNoiseMatrix) const
+  {
+    init_batch_result(trk, psurfs.size(), result, doPropMatrix, doNoiseMatrix);
+
+    // Group the destination planes by orientation.
+
+    std::map<double, std::vector<std::size_t> > groups;
+    for(std::size_t i = 0; i < psurfs.size(); ++i) {
+      const SurfYZPlane* to = dynamic_cast<const SurfYZPlane*>(&*psurfs[i]);
+      if(to != 0)
+	groups[to->phi()].push_back(i);
+      else
+	result.dists[i] =
+	  short_vec_prop(result.tracks[i], psurfs[i], dir, doDedx,
+			 (doPropMatrix ? &result.prop_matrices[i] : 0),
+			 (doNoiseMatrix ? &result.noise_matrices[i] : 0));
+    }
+
+    std::vector<double> x0, y0, z0;
+    for(const auto& igroup : groups) {
+      const std::vector<std::size_t>& index = igroup.second;
+
+      // Propagate to origin surface (once for the whole group).
+
+      KTrack otrk(trk);
+      TrackMatrix origin_matrix;
+      if(!origin_vec_prop(otrk, psurfs[index.front()], (doPropMatrix ? &origin_matrix : 0)))
+	continue;
+
+      x0.clear();
+      y0.clear();
+      z0.clear();
+      for(std::size_t i : index) {
+	const SurfYZPlane* to = static_cast<const SurfYZPlane*>(&*psurfs[i]);
+	x0.push_back(to->x0());
+	y0.push_back(to->y0());
+	z0.push_back(to->z0());
+      }
+      parallel_planes_prop(trk, otrk, (doPropMatrix ? &origin_matrix : 0),
+			   0., igroup.first, index, x0, y0, z0,
+			   psurfs, dir, doDedx, result, doPropMatrix, doNoiseMatrix);
+    }
+  }
+
   /// Propagate without error to dynamically generated origin surface.
   /// Optionally return propagation matrix.
   ///
@@ -45,6 +45,15 @@ namespace trkf {
 						    const std::shared_ptr<const Surface>& porient,
 						    TrackMatrix* prop_matrix = 0) const;
 
+    /// Propagate without error to many surfaces.
+    virtual void batch_vec_prop(const KTrack& trk,
+				const std::vector<std::shared_ptr<const Surface> >& psurfs,
+				Propagator::PropDirection dir,
+				bool doDedx,
+				BatchResult& result,
+				bool doPropMatrix = false,
+				bool doNoiseMatrix = false) const;
+
   private:
 
     /// The following methods transform the track parameters from
@@ -8,11 +8,26 @@
 ///
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
 #include "lardata/RecoObjects/Propagator.h"
 #include "lardata/RecoObjects/SurfXYZPlane.h"
+#include "lardata/RecoObjects/DedxTable.h"
+#include "lardata/RecoObjects/DedxStepper.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lardata/Utilities/Instrumentation.h"
 #include "cetlib_except/exception.h"
 
+namespace {
+
+  // Timers of the propagations (see lar::Instrumentation)
+  struct VecPropTimer
+    { static constexpr char const* Name = "Propagator::vec_prop"; };
+  struct ErrPropTimer
+    { static constexpr char const* Name = "Propagator::err_prop"; };
+
+} // local namespace
+
 namespace trkf {
 
   /// Constructor.
@@ -26,7 +41,9 @@ namespace trkf {
 			 const std::shared_ptr<const Interactor>& interactor) :
     fTcut(tcut),
     fDoDedx(doDedx),
-    fInteractor(interactor)
+    fInteractor(interactor),
+    fUseDedxTable(true),
+    fDedxTolerance(0.)
   {}
 
   /// Destructor.
@@ -56,6 +73,8 @@ namespace trkf {
 					       TrackMatrix* prop_matrix,
 					       TrackError* noise_matrix) const
   {
+    lar::ScopedTimer<VecPropTimer> const timer;
+
     // Default result.
 
     auto result = boost::make_optional<double>(false, 0.);
@@ -124,6 +143,7 @@ namespace trkf {
 	// If the iteration count exceeds the maximum, return failure.
 
 	++nit;
+	++fCounters.steps;
 	if(nit > nitmax) {
 	  trk = trk0;
 	  result = boost::optional<double>(false, 0.);
@@ -138,11 +158,23 @@ namespace trkf {
 	double p = 1./std::abs(pinv);
 	double e = std::hypot(p, mass);
 	double t = p*p / (e + mass);
-	double dedx = 0.001 * detprop->Eloss(p, mass, fTcut);
+	std::shared_ptr<const DedxTable> table;
+	if(fUseDedxTable)
+	  table = DedxTable::get(detprop, mass, fTcut);
+	auto stopping = [&](double pp)
+	  { return 0.001 * (table ? table->Eloss(pp) : detprop->Eloss(pp, mass, fTcut)); };
+	double dedx = stopping(p);
 	double smax = 0.1 * t / dedx;
 	if (smax <= 0.)
 	  throw cet::exception("Propagator") << __func__ << ": maximum step " << smax << "\n";
 
+	// With a tolerance, take the step meeting it instead (the energy
+	// loss is then integrated with error control by dedx_prop), but
+	// do not lose more than half of the kinetic energy in one step.
+
+	if(fDedxTolerance > 0.)
+	  smax = std::min(0.5 * t / dedx, dedxStepLength(stopping, e, mass, fDedxTolerance, smax));
+
 	// Always allow a step of at least 0.3 cm (about one wire spacing).
 
 	if(smax < 0.3)
@@ -239,6 +271,207 @@ namespace trkf {
     return result;
   }
 
+  /// Propagate without error (short distance) to each of several surfaces.
+  ///
+  /// Arguments:
+  ///
+  /// trk           - Track to propagate (not modified).
+  /// psurfs        - Destination surfaces.
+  /// dir           - Propagation direction (FORWARD, BACKWARD, or UNKNOWN).
+  /// doDedx        - dE/dx enable/disable flag.
+  /// result        - Propagated tracks, distances and matrices, one per surface.
+  /// doPropMatrix  - Return propagation matrices.
+  /// doNoiseMatrix - Return noise matrices.
+  ///
+  /// Each entry of the result is the same as from short_vec_prop to
+  /// that surface.
+  ///
+  void Propagator::batch_vec_prop(const KTrack& trk,
+				  const std::vector<std::shared_ptr<const Surface> >& psurfs,
+				  PropDirection dir,
+				  bool doDedx,
+				  BatchResult& result,
+				  bool doPropMatrix,
+				  bool doNoiseMatrix) const
+  {
+    init_batch_result(trk, psurfs.size(), result, doPropMatrix, doNoiseMatrix);
+    for(std::size_t i = 0; i < psurfs.size(); ++i) {
+      result.dists[i] =
+	short_vec_prop(result.tracks[i], psurfs[i], dir, doDedx,
+		       (doPropMatrix ? &result.prop_matrices[i] : 0),
+		       (doNoiseMatrix ? &result.noise_matrices[i] : 0));
+    }
+  }
+
+  /// Prepare the result of batch propagation for n surfaces.
+  void Propagator::init_batch_result(const KTrack& trk, std::size_t n, BatchResult& result,
+				     bool doPropMatrix, bool doNoiseMatrix) const
+  {
+    result.tracks.assign(n, trk);
+    result.dists.assign(n, boost::optional<double>(false, 0.));
+    result.prop_matrices.resize(doPropMatrix ? n : 0);
+    result.noise_matrices.resize(doNoiseMatrix ? n : 0);
+  }
+
+  /// Batch propagation along straight lines to parallel planes.
+  ///
+  /// Arguments:
+  ///
+  /// trk           - Track to propagate.
+  /// otrk          - Track propagated to the origin surface with orientation
+  ///                 (theta, phi) at the position of trk (by origin_vec_prop).
+  /// origin_matrix - Propagation matrix of trk to otrk (if propagation
+  ///                 matrices are requested).
+  /// theta, phi    - Orientation of the destination planes (theta is zero
+  ///                 for SurfYZPlane).
+  /// index         - Where the destination planes are in psurfs and result.
+  /// x0, y0, z0    - Origins of the destination planes (same order as index).
+  /// psurfs        - All destination surfaces.
+  /// dir           - Propagation direction (FORWARD, BACKWARD, or UNKNOWN).
+  /// doDedx        - dE/dx enable/disable flag.
+  /// result        - Results, filled for the entries in index.
+  ///
+  /// This is the second half of short_vec_prop of PropYZPlane and
+  /// PropXYZPlane.  The positions on all the destination planes are
+  /// computed first, in one loop over the coordinate arrays; the per
+  /// surface work left (direction check, dE/dx, matrices) follows.
+  ///
+  void Propagator::parallel_planes_prop(const KTrack& trk,
+					const KTrack& otrk,
+					const TrackMatrix* origin_matrix,
+					double theta, double phi,
+					const std::vector<std::size_t>& index,
+					const std::vector<double>& x0,
+					const std::vector<double>& y0,
+					const std::vector<double>& z0,
+					const std::vector<std::shared_ptr<const Surface> >& psurfs,
+					PropDirection dir,
+					bool doDedx,
+					BatchResult& result,
+					bool doPropMatrix,
+					bool doNoiseMatrix) const
+  {
+    std::size_t const n = index.size();
+
+    // Get the track position and the intermediate track parameters.
+
+    double xyz[3];
+    trk.getPosition(xyz);
+
+    const TrackVector& vec = otrk.getVector();
+    if(vec.size() != 5)
+      throw cet::exception("Propagator")
+	<< "Track state vector has wrong size" << vec.size() << "\n";
+    double const u1 = vec(0);
+    double const v1 = vec(1);
+    double const dudw1 = vec(2);
+    double const dvdw1 = vec(3);
+    double const pinv = vec(4);
+    Surface::TrackDirection const dir1 = otrk.getDirection();
+    if(dir1 == Surface::UNKNOWN)
+      return;
+
+    // Rotation matrix from global coordinate system to destination
+    // coordinate system.
+
+    double const sinth = std::sin(theta);
+    double const costh = std::cos(theta);
+    double const sinphi = std::sin(phi);
+    double const cosphi = std::cos(phi);
+
+    double const rux = costh;
+    double const ruy = sinth*sinphi;
+    double const ruz = -sinth*cosphi;
+
+    double const rvy = cosphi;
+    double const rvz = sinphi;
+
+    double const rwx = sinth;
+    double const rwy = -costh*sinphi;
+    double const rwz = costh*cosphi;
+
+    double const ds = std::sqrt(1. + dudw1*dudw1 + dvdw1*dvdw1) * (dir1 == Surface::BACKWARD ? -1. : 1.);
+
+    // Positions on all the destination planes and propagation distances.
+
+    std::vector<double> u2p(n), v2p(n), w2(n), s(n);
+    for(std::size_t i = 0; i < n; ++i) {
+      double const dx = xyz[0] - x0[i];
+      double const dy = xyz[1] - y0[i];
+      double const dz = xyz[2] - z0[i];
+      double const w = dx*rwx + dy*rwy + dz*rwz;
+      u2p[i] = dx*rux + dy*ruy + dz*ruz + u1 - w * dudw1;
+      v2p[i] =          dy*rvy + dz*rvz + v1 - w * dvdw1;
+      w2[i] = w;
+      s[i] = -w * ds;
+    }
+
+    // Noise matrices for all the distances in one go.  If that fails,
+    // they are calculated for each destination.
+
+    std::vector<TrackError> noise;
+    bool batch_noise = doNoiseMatrix && getInteractor().get() != 0 &&
+      getInteractor()->noise(otrk, s, noise);
+
+    // Finish each propagation.
+
+    for(std::size_t i = 0; i < n; ++i) {
+      std::size_t const k = index[i];
+
+      bool sok = (dir == Propagator::UNKNOWN ||
+		  (dir == Propagator::FORWARD && s[i] >= 0.) ||
+		  (dir == Propagator::BACKWARD && s[i] <= 0.));
+      if(!sok)
+	continue;
+
+      double deriv = 1.;
+      boost::optional<double> pinv2(true, pinv);
+      if(getDoDedx() && doDedx && s[i] != 0.)
+	pinv2 = dedx_prop(pinv, otrk.Mass(), s[i], (doPropMatrix ? &deriv : 0));
+      if(!pinv2)
+	continue;
+
+      if(doPropMatrix) {
+	TrackMatrix pm(vec.size(), vec.size());
+	pm.clear();
+	pm(0,0) = 1.;
+	pm(1,1) = 1.;
+	pm(0,2) = -w2[i];
+	pm(2,2) = 1.;
+	pm(1,3) = -w2[i];
+	pm(3,3) = 1.;
+	pm(4,4) = deriv;
+	result.prop_matrices[k] = prod(pm, *origin_matrix);
+      }
+
+      if(doNoiseMatrix) {
+	TrackError& noise_matrix = result.noise_matrices[k];
+	noise_matrix.resize(vec.size(), false);
+	if(batch_noise)
+	  noise_matrix = noise[i];
+	else if(getInteractor().get() != 0) {
+	  if(!getInteractor()->noise(otrk, s[i], noise_matrix))
+	    continue;
+	}
+	else
+	  noise_matrix.clear();
+      }
+
+      TrackVector vec2(vec.size());
+      vec2(0) = u2p[i];
+      vec2(1) = v2p[i];
+      vec2(2) = dudw1;
+      vec2(3) = dvdw1;
+      vec2(4) = *pinv2;
+
+      KTrack& trk2 = result.tracks[k];
+      trk2 = otrk;
+      trk2.setSurface(psurfs[k]);
+      trk2.setVector(vec2);
+      result.dists[k] = boost::optional<double>(true, s[i]);
+    }
+  }
+
   /// Linearized propagate without error.
   ///
   /// Arguments:
@@ -358,6 +591,8 @@ namespace trkf {
 					       KTrack* ref,
 					       TrackMatrix* prop_matrix) const
   {
+    lar::ScopedTimer<ErrPropTimer> const timer;
+
     // Propagate without error, get propagation matrix.
 
     TrackMatrix prop_temp;
@@ -441,7 +676,7 @@ namespace trkf {
   /// dE/dx = -f(E)
   ///
   /// where f(E) is the stopping power returned by method
-  /// LArProperties::Eloss.
+  /// LArProperties::Eloss (or interpolated from DedxTable).
   ///
   /// We expect that this method will be called exclusively for short
   /// distance propagation.  The differential equation is solved using
@@ -451,6 +686,10 @@ namespace trkf {
   /// dE = -s*f(E1)
   /// E2 = E1 - s*f(E1 + 0.5*dE)
   ///
+  /// If a tolerance is set (setDedxTolerance), the step is divided if
+  /// needed so that the estimated error of each midpoint step is within
+  /// the tolerance (see integrateDedx).
+  ///
   /// The derivative is calculated assuming E2 = E1 + constant, giving
   ///
   /// d(pinv2)/d(pinv1) = pinv2^3 E2 / (pinv1^3 E1).
@@ -473,15 +712,36 @@ namespace trkf {
 
     auto const * detprop = lar::providerFrom<detinfo::DetectorPropertiesService>();
 
+    // Get energy loss table (if used).
+
+    std::shared_ptr<const DedxTable> table;
+    if(fUseDedxTable)
+      table = DedxTable::get(detprop, mass, fTcut);
+
     // Calculate final energy.
 
     double p1 = 1./std::abs(pinv);
     double e1 = std::hypot(p1, mass);
-    double de = -0.001 * s * detprop->Eloss(p1, mass, fTcut);
+    if(fDedxTolerance > 0.) {
+      auto stopping = [&](double p)
+	{ return 0.001 * (table ? table->Eloss(p) : detprop->Eloss(p, mass, fTcut)); };
+      double e2 = 0.;
+      if(integrateDedx(stopping, e1, mass, s, fDedxTolerance, e2, fCounters.dedxSteps)) {
+	double pinv2 = 1./std::sqrt(e2*e2 - mass*mass);
+	if(pinv < 0.)
+	  pinv2 = -pinv2;
+	result = boost::optional<double>(true, pinv2);
+	if(deriv != 0)
+	  *deriv = pinv2*pinv2*pinv2 * e2 / (pinv*pinv*pinv * e1);
+      }
+      return result;
+    }
+    ++fCounters.dedxSteps;
+    double de = -0.001 * s * (table ? table->Eloss(p1) : detprop->Eloss(p1, mass, fTcut));
     double emid = e1 + 0.5 * de;
     if(emid > mass) {
       double pmid = std::sqrt(emid*emid - mass*mass);
-      double e2 = e1 - 0.001 * s * detprop->Eloss(pmid, mass, fTcut);
+      double e2 = e1 - 0.001 * s * (table ? table->Eloss(pmid) : detprop->Eloss(pmid, mass, fTcut));
       if(e2 > mass) {
 	double p2 = std::sqrt(e2*e2 - mass*mass);
 	double pinv2 = 1./p2;
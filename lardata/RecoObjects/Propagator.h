@@ -20,6 +20,8 @@
 /// 6.  Coordinate transformations without motion (method origin_vec_prop).
 ///
 /// Methods short_vec_prop and origin_vec_prop are pure virtual.
+/// Method vec_prop is virtual, so that a wrapping propagator (e.g.
+/// PropCache) can intercept whole long distance propagations.
 ///
 /// Other methods are implemented by calling short_vec_prop internally.
 ///
@@ -66,6 +68,30 @@
 /// propagation methods.  Nonzero energy loss will take place only if
 /// both flags are true.
 ///
+/// By default, the stopping power is interpolated from a table (class
+/// DedxTable) built once per particle mass, rather than calculated
+/// from the Bethe-Bloch formula at every step.  Method setUseDedxTable
+/// selects the exact formula instead.
+///
+/// By default, long propagations with dE/dx are divided in steps
+/// losing at most 10% of the kinetic energy, and the energy loss of
+/// each step is computed with one midpoint step.  With a positive
+/// tolerance (method setDedxTolerance), the step lengths are instead
+/// chosen from an estimate of the error on the energy after the step
+/// (see DedxStepper.h), relative to the kinetic energy: fewer steps
+/// are made where the stopping power hardly changes, and more where it
+/// changes quickly.  The numbers of steps are counted (stepCounters),
+/// to trade accuracy for speed.
+///
+/// Method batch_vec_prop propagates one track (without error, short
+/// distance) to each of a list of destination surfaces, e.g. the
+/// candidate wire surfaces of a hit search.  The default implementation
+/// calls short_vec_prop for each of them.  Propagators to planes
+/// override it: the transformation to each distinct orientation is done
+/// once, and the straight line steps to all the planes with that
+/// orientation are then computed together on arrays of surface
+/// coordinates.
+///
 /// Method origin_vec_prop always returns a propgation distance of
 /// zero (if successful).  Origin propagation does not calculate noise
 /// (noise is zero by definition).  Origin propagation does not accept
@@ -77,6 +103,7 @@
 #define PROPAGATOR_H
 
 #include <memory>
+#include <vector>
 #include "lardata/RecoObjects/KalmanLinearAlgebra.h"
 #include "lardata/RecoObjects/KETrack.h"
 #include "lardata/RecoObjects/Interactor.h"
@@ -91,6 +118,22 @@ namespace trkf {
     /// Propagation direction enum.
     enum PropDirection {FORWARD, BACKWARD, UNKNOWN};
 
+    /// Results of batch propagation, one entry per destination surface.
+    struct BatchResult
+    {
+      std::vector<KTrack> tracks;                   ///< Propagated tracks (original track if failed).
+      std::vector<boost::optional<double> > dists;  ///< Propagation distances (uninitialized if failed).
+      std::vector<TrackMatrix> prop_matrices;       ///< Propagation matrices (if requested).
+      std::vector<TrackError> noise_matrices;       ///< Noise matrices (if requested).
+    };
+
+    /// Numbers of steps of the propagations with dE/dx.
+    struct StepCounters
+    {
+      unsigned long steps = 0;      ///< Steps of long distance propagation (vec_prop).
+      unsigned long dedxSteps = 0;  ///< Energy loss integration steps (dedx_prop).
+    };
+
     /// Constructor.
     Propagator(double tcut, bool doDedx, const std::shared_ptr<const Interactor>& interactor);
 
@@ -102,6 +145,23 @@ namespace trkf {
     double getTcut() const {return fTcut;}
     bool getDoDedx() const {return fDoDedx;}
     const std::shared_ptr<const Interactor>& getInteractor() const {return fInteractor;}
+    bool getUseDedxTable() const {return fUseDedxTable;}
+    double getDedxTolerance() const {return fDedxTolerance;}
+
+    /// Step counters (not thread safe; each clone has its own).
+    const StepCounters& stepCounters() const {return fCounters;}
+
+    // Modifiers.
+
+    /// Use tabulated (true, default) or exact (false) stopping power.
+    void setUseDedxTable(bool use) {fUseDedxTable = use;}
+
+    /// Relative tolerance on the kinetic energy for the step length
+    /// control (0, default, for the fixed step rules).
+    void setDedxTolerance(double tolerance) {fDedxTolerance = tolerance;}
+
+    /// Reset step counters.
+    void resetStepCounters() const {fCounters = StepCounters();}
 
     // Virtual methods.
 
@@ -121,13 +181,22 @@ namespace trkf {
 						    const std::shared_ptr<const Surface>& porient,
 						    TrackMatrix* prop_matrix = 0) const = 0;
 
+    /// Propagate without error (short distance) to each of several surfaces.
+    virtual void batch_vec_prop(const KTrack& trk,
+				const std::vector<std::shared_ptr<const Surface> >& psurfs,
+				PropDirection dir,
+				bool doDedx,
+				BatchResult& result,
+				bool doPropMatrix = false,
+				bool doNoiseMatrix = false) const;
+
     /// Propagate without error (long distance).
-    boost::optional<double> vec_prop(KTrack& trk,
-				     const std::shared_ptr<const Surface>& psurf,
-				     PropDirection dir,
-				     bool doDedx,
-				     TrackMatrix* prop_matrix = 0,
-				     TrackError* noise_matrix = 0) const;
+    virtual boost::optional<double> vec_prop(KTrack& trk,
+					     const std::shared_ptr<const Surface>& psurf,
+					     PropDirection dir,
+					     bool doDedx,
+					     TrackMatrix* prop_matrix = 0,
+					     TrackError* noise_matrix = 0) const;
 
     /// Linearized propagate without error.
     boost::optional<double> lin_prop(KTrack& trk,
@@ -156,6 +225,29 @@ namespace trkf {
     boost::optional<double> dedx_prop(double pinv, double mass,
 				      double s, double* deriv=0) const;
 
+  protected:
+
+    /// Batch propagation along straight lines to planes sharing the
+    /// orientation (theta, phi) of the origin surface of otrk.
+    void parallel_planes_prop(const KTrack& trk,
+			      const KTrack& otrk,
+			      const TrackMatrix* origin_matrix,
+			      double theta, double phi,
+			      const std::vector<std::size_t>& index,
+			      const std::vector<double>& x0,
+			      const std::vector<double>& y0,
+			      const std::vector<double>& z0,
+			      const std::vector<std::shared_ptr<const Surface> >& psurfs,
+			      PropDirection dir,
+			      bool doDedx,
+			      BatchResult& result,
+			      bool doPropMatrix,
+			      bool doNoiseMatrix) const;
+
+    /// Prepare the result of batch propagation for n surfaces.
+    void init_batch_result(const KTrack& trk, std::size_t n, BatchResult& result,
+			   bool doPropMatrix, bool doNoiseMatrix) const;
+
   private:
 
     // Attributes.
@@ -163,6 +255,9 @@ namespace trkf {
     double fTcut;                                   ///< Maximum delta ray energy for dE/dx.
     bool fDoDedx;                                   ///< Energy loss enable flag.
     std::shared_ptr<const Interactor> fInteractor;  ///< Interactor (for calculating noise).
+    bool fUseDedxTable;                             ///< Use tabulated stopping power.
+    double fDedxTolerance;                          ///< Energy loss tolerance (0 = fixed steps).
+    mutable StepCounters fCounters;                 ///< Numbers of steps.
   };
 }
 
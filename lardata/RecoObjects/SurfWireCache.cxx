@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   SurfWireCache.cxx
+///
+/// \brief  Cache of measurement surfaces indexed by wire id.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "lardata/RecoObjects/SurfWireCache.h"
+#include "lardata/RecoObjects/SurfWireLine.h"
+
+namespace trkf {
+
+  /// Default constructor.
+  SurfWireCache::SurfWireCache()
+  {}
+
+  /// Destructor.
+  SurfWireCache::~SurfWireCache()
+  {}
+
+  /// Per-job instance.
+  SurfWireCache& SurfWireCache::instance()
+  {
+    static SurfWireCache cache;
+    return cache;
+  }
+
+  /// Shared SurfWireX surface of a wire.
+  ///
+  /// Arguments:
+  ///
+  /// wireid - Wire id.
+  ///
+  /// The surface is made (using the geometry service) the first time
+  /// a wire is asked for.
+  ///
+  std::shared_ptr<const SurfWireX> SurfWireCache::getWireX(const geo::WireID& wireid) const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::shared_ptr<const SurfWireX>& psurf = fWireX[wireid];
+    if(psurf.get() == 0)
+      psurf.reset(new SurfWireX(wireid));
+    return psurf;
+  }
+
+  /// New SurfWireLine surface for a wire and x coordinate.
+  ///
+  /// Arguments:
+  ///
+  /// wireid - Wire id.
+  /// x      - X coordinate.
+  ///
+  std::shared_ptr<const Surface> SurfWireCache::makeWireLine(const geo::WireID& wireid,
+							     double x) const
+  {
+    return std::shared_ptr<const Surface>(new SurfWireLine(*getWireX(wireid), x));
+  }
+
+  /// Number of cached wires.
+  std::size_t SurfWireCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fWireX.size();
+  }
+
+  /// Remove all cached surfaces.
+  void SurfWireCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fWireX.clear();
+  }
+
+} // end namespace trkf
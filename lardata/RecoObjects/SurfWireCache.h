@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   SurfWireCache.h
+///
+/// \brief  Cache of measurement surfaces indexed by wire id.
+///
+/// This class keeps one immutable SurfWireX surface per wire, made
+/// from the geometry service the first time the wire is asked for.
+/// Measurements on the same wire (KHitWireX) then share one surface
+/// object, and no geometry calls are needed after the first one.
+///
+/// SurfWireLine surfaces also depend on the drift coordinate of the
+/// measurement, so they are not shared, but they are made from the
+/// cached wire geometry as well.
+///
+/// A single instance is meant to be used for the whole job (method
+/// instance).  It is safe to use from several threads.  Call clear if
+/// the geometry changes.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef SURFWIRECACHE_H
+#define SURFWIRECACHE_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardata/RecoObjects/SurfWireX.h"
+
+namespace trkf {
+
+  class SurfWireCache
+  {
+  public:
+
+    /// Default constructor.
+    SurfWireCache();
+
+    /// Destructor.
+    ~SurfWireCache();
+
+    /// Per-job instance.
+    static SurfWireCache& instance();
+
+    /// Shared SurfWireX surface of a wire.
+    std::shared_ptr<const SurfWireX> getWireX(const geo::WireID& wireid) const;
+
+    /// New SurfWireLine surface for a wire and x coordinate.
+    std::shared_ptr<const Surface> makeWireLine(const geo::WireID& wireid, double x) const;
+
+    /// Number of cached wires.
+    std::size_t size() const;
+
+    /// Remove all cached surfaces (e.g. after a geometry change).
+    void clear();
+
+  private:
+
+    // Attributes.
+
+    mutable std::mutex fMutex;    ///< Protects the cache.
+    mutable std::map<geo::WireID, std::shared_ptr<const SurfWireX> > fWireX;  ///< Cached surfaces.
+  };
+}
+
+#endif
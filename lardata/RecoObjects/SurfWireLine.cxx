@@ -9,6 +9,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "lardata/RecoObjects/SurfWireLine.h"
+#include "lardata/RecoObjects/SurfWireX.h"
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/WireGeo.h"
 #include "TMath.h"
@@ -44,6 +45,17 @@ namespace trkf {
     *static_cast<SurfYZLine*>(this) = SurfYZLine(x, xyz[1], xyz[2], phi);
   }
 
+  /// Constructor.
+  ///
+  /// Arguments:
+  ///
+  /// wire - Plane surface of the wire (has the same wire center and angle).
+  /// x    - X coordinate.
+  ///
+  SurfWireLine::SurfWireLine(const SurfWireX& wire, double x) :
+    SurfYZLine(x, wire.y0(), wire.z0(), wire.phi())
+  {}
+
   /// Destructor.
   SurfWireLine::~SurfWireLine()
   {}
@@ -21,6 +21,8 @@ namespace geo { struct WireID; }
 
 namespace trkf {
 
+  class SurfWireX;
+
   class SurfWireLine : public SurfYZLine
   {
   public:
@@ -28,6 +30,9 @@ namespace trkf {
     /// Constructor.
     SurfWireLine(const geo::WireID& wireid, double x);
 
+    /// Constructor from the wire plane surface of the same wire (no geometry lookup).
+    SurfWireLine(const SurfWireX& wire, double x);
+
     /// Destructor.
     virtual ~SurfWireLine();
   };
@@ -28,7 +28,9 @@ namespace trkf {
     fZ0(0.),
     fPhi(0.),
     fTheta(0.)
-  {}
+  {
+    initRotation();
+  }
 
   /// Initializing constructor.
   ///
@@ -44,7 +46,9 @@ namespace trkf {
     fZ0(z0),
     fPhi(phi),
     fTheta(theta)
-  {}
+  {
+    initRotation();
+  }
 
   /// Initializing constructor (normal vector).
   ///
@@ -68,12 +72,42 @@ namespace trkf {
     fPhi = 0.;
     if(nyz != 0.)
       fPhi = atan2(-ny, nz);
+
+    initRotation();
   }
 
   /// Destructor.
   SurfXYZPlane::~SurfXYZPlane()
   {}
 
+  /// Calculate the cached rotation from the angles.
+  ///
+  /// The rows of the rotation are the local axes in global coordinates:
+  ///
+  /// u = ( cos(theta),  sin(theta)*sin(phi), -sin(theta)*cos(phi))
+  /// v = (          0,             cos(phi),             sin(phi))
+  /// w = ( sin(theta), -cos(theta)*sin(phi),  cos(theta)*cos(phi))
+  ///
+  void SurfXYZPlane::initRotation()
+  {
+    double sinth = std::sin(fTheta);
+    double costh = std::cos(fTheta);
+    double sinphi = std::sin(fPhi);
+    double cosphi = std::cos(fPhi);
+
+    fRot[0][0] = costh;
+    fRot[0][1] = sinth*sinphi;
+    fRot[0][2] = -sinth*cosphi;
+
+    fRot[1][0] = 0.;
+    fRot[1][1] = cosphi;
+    fRot[1][2] = sinphi;
+
+    fRot[2][0] = sinth;
+    fRot[2][1] = -costh*sinphi;
+    fRot[2][2] = costh*cosphi;
+  }
+
   /// Clone method.
   Surface* SurfXYZPlane::clone() const
   {
@@ -95,19 +129,18 @@ namespace trkf {
   ///
   void SurfXYZPlane::toLocal(const double xyz[3], double uvw[3]) const
   {
-    double sinth = std::sin(fTheta);
-    double costh = std::cos(fTheta);
-    double sinphi = std::sin(fPhi);
-    double cosphi = std::cos(fPhi);
+    double dx = xyz[0] - fX0;
+    double dy = xyz[1] - fY0;
+    double dz = xyz[2] - fZ0;
 
     // u = (x-x0)*cos(theta) + (y-y0)*sin(theta)*sin(phi) - (z-z0)*sin(theta)*cos(phi)
-    uvw[0] = (xyz[0]-fX0)*costh + (xyz[1]-fY0)*sinth*sinphi - (xyz[2]-fZ0)*sinth*cosphi;
+    uvw[0] = dx*fRot[0][0] + dy*fRot[0][1] + dz*fRot[0][2];
 
     // v =                     (y-y0)*cos(phi)            + (z-z0)*sin(phi)
-    uvw[1] = (xyz[1]-fY0)*cosphi + (xyz[2]-fZ0)*sinphi;
+    uvw[1] = dy*fRot[1][1] + dz*fRot[1][2];
 
     // w = (x-x0)*sin(theta) - (y-y0)*cos(theta)*sin(phi) + (z-z0)*cos(theta)*cos(phi)
-    uvw[2] = (xyz[0]-fX0)*sinth - (xyz[1]-fY0)*costh*sinphi + (xyz[2]-fZ0)*costh*cosphi;
+    uvw[2] = dx*fRot[2][0] + dy*fRot[2][1] + dz*fRot[2][2];
   }
 
   /// Transform local to global coordinates.
@@ -119,19 +152,74 @@ namespace trkf {
   ///
   void SurfXYZPlane::toGlobal(const double uvw[3], double xyz[3]) const
   {
-    double sinth = std::sin(fTheta);
-    double costh = std::cos(fTheta);
-    double sinphi = std::sin(fPhi);
-    double cosphi = std::cos(fPhi);
+    double u = uvw[0];
+    double v = uvw[1];
+    double w = uvw[2];
 
     // x = x0 + u*cos(theta)                       + w*sin(theta)
-    xyz[0] = fX0 + uvw[0]*costh + uvw[2]*sinth;
+    xyz[0] = fX0 + u*fRot[0][0] + w*fRot[2][0];
 
     // y = y0 + u*sin(theta)*sin(phi) + v*cos(phi) - w*cos(theta)*sin(phi)
-    xyz[1] = fY0 + uvw[0]*sinth*sinphi + uvw[1]*cosphi - uvw[2]*costh*sinphi;
+    xyz[1] = fY0 + u*fRot[0][1] + v*fRot[1][1] + w*fRot[2][1];
 
     // z = z0 - u*sin(theta)*cos(phi) + v*sin(phi) + w*cos(theta)*cos(phi)
-    xyz[2] = fZ0 - uvw[0]*sinth*cosphi + uvw[1]*sinphi + uvw[2]*costh*cosphi;
+    xyz[2] = fZ0 + u*fRot[0][2] + v*fRot[1][2] + w*fRot[2][2];
+  }
+
+  /// Transform global to local coordinates, for n points.
+  ///
+  /// Arguments:
+  ///
+  /// n   - Number of points.
+  /// xyz - Cartesian coordinates in global coordinate system, for each point.
+  /// uvw - Cartesian coordinates in local coordinate system, for each point.
+  ///
+  /// The two arrays may be the same (transformation in place).
+  ///
+  void SurfXYZPlane::toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const
+  {
+    const double x0 = fX0;
+    const double y0 = fY0;
+    const double z0 = fZ0;
+    const double uu[3] = { fRot[0][0], fRot[0][1], fRot[0][2] };
+    const double vv[3] = { fRot[1][0], fRot[1][1], fRot[1][2] };
+    const double ww[3] = { fRot[2][0], fRot[2][1], fRot[2][2] };
+    for(std::size_t i=0; i<n; ++i) {
+      const double dx = xyz[i][0] - x0;
+      const double dy = xyz[i][1] - y0;
+      const double dz = xyz[i][2] - z0;
+      uvw[i][0] = dx*uu[0] + dy*uu[1] + dz*uu[2];
+      uvw[i][1] = dx*vv[0] + dy*vv[1] + dz*vv[2];
+      uvw[i][2] = dx*ww[0] + dy*ww[1] + dz*ww[2];
+    }
+  }
+
+  /// Transform local to global coordinates, for n points.
+  ///
+  /// Arguments:
+  ///
+  /// n   - Number of points.
+  /// uvw - Cartesian coordinates in local coordinate system, for each point.
+  /// xyz - Cartesian coordinates in global coordinate system, for each point.
+  ///
+  /// The two arrays may be the same (transformation in place).
+  ///
+  void SurfXYZPlane::toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const
+  {
+    const double x0 = fX0;
+    const double y0 = fY0;
+    const double z0 = fZ0;
+    const double uu[3] = { fRot[0][0], fRot[0][1], fRot[0][2] };
+    const double vv[3] = { fRot[1][0], fRot[1][1], fRot[1][2] };
+    const double ww[3] = { fRot[2][0], fRot[2][1], fRot[2][2] };
+    for(std::size_t i=0; i<n; ++i) {
+      const double u = uvw[i][0];
+      const double v = uvw[i][1];
+      const double w = uvw[i][2];
+      xyz[i][0] = x0 + u*uu[0] + v*vv[0] + w*ww[0];
+      xyz[i][1] = y0 + u*uu[1] + v*vv[1] + w*ww[1];
+      xyz[i][2] = z0 + u*uu[2] + v*vv[2] + w*ww[2];
+    }
   }
 
   /// Get position of track.
@@ -195,14 +283,9 @@ namespace trkf {
 
     // Rotate momentum to global coordinte system.
 
-    double sinth = std::sin(fTheta);
-    double costh = std::cos(fTheta);
-    double sinphi = std::sin(fPhi);
-    double cosphi = std::cos(fPhi);
-
-    mom[0] = pu*costh + pw*sinth;
-    mom[1] = pu*sinth*sinphi + pv*cosphi - pw*costh*sinphi;
-    mom[2] = -pu*sinth*cosphi + pv*sinphi + pw*costh*cosphi;
+    mom[0] = pu*fRot[0][0] + pw*fRot[2][0];
+    mom[1] = pu*fRot[0][1] + pv*fRot[1][1] + pw*fRot[2][1];
+    mom[2] = pu*fRot[0][2] + pv*fRot[1][2] + pw*fRot[2][2];
 
     return;
   }
@@ -116,6 +116,12 @@ namespace trkf {
     /// Transform local to global coordinates.
     virtual void toGlobal(const double uvw[3], double xyz[3]) const;
 
+    /// Transform global to local coordinates, for n points.
+    virtual void toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const;
+
+    /// Transform local to global coordinates, for n points.
+    virtual void toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const;
+
     /// Get position of track.
     virtual void getPosition(const TrackVector& vec, double xyz[3]) const;
 
@@ -150,6 +156,13 @@ namespace trkf {
     double fZ0;     ///< Z origin.
     double fPhi;    ///< Rotation angle about x-axis (wire angle).
     double fTheta;  ///< Rotation angle about y'-axis (projected Lorentz angle).
+
+    /// Rotation from global to local coordinates, cached.
+    /// Rows are the unit vectors of the local u, v, w axes in global coordinates.
+    double fRot[3][3];
+
+    /// Calculate the cached rotation from the angles.
+    void initRotation();
   };
 }
 
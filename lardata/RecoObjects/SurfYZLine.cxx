@@ -26,7 +26,9 @@ namespace trkf {
     fX0(0.),
     fY0(0.),
     fZ0(0.),
-    fPhi(0.)
+    fPhi(0.),
+    fSinPhi(0.),
+    fCosPhi(1.)
   {}
 
   /// Initializing constructor.
@@ -40,7 +42,9 @@ namespace trkf {
     fX0(x0),
     fY0(y0),
     fZ0(z0),
-    fPhi(phi)
+    fPhi(phi),
+    fSinPhi(std::sin(phi)),
+    fCosPhi(std::cos(phi))
   {}
 
   /// Destructor.
@@ -70,8 +74,8 @@ namespace trkf {
   ///
   void SurfYZLine::toLocal(const double xyz[3], double uvw[3]) const
   {
-    double sinphi = std::sin(fPhi);
-    double cosphi = std::cos(fPhi);
+    double sinphi = fSinPhi;
+    double cosphi = fCosPhi;
 
     // u = x-x0
     uvw[0] = xyz[0] - fX0;
@@ -92,8 +96,8 @@ namespace trkf {
   ///
   void SurfYZLine::toGlobal(const double uvw[3], double xyz[3]) const
   {
-    double sinphi = std::sin(fPhi);
-    double cosphi = std::cos(fPhi);
+    double sinphi = fSinPhi;
+    double cosphi = fCosPhi;
 
     // x = x0 + u
     xyz[0] = fX0 + uvw[0];
@@ -105,6 +109,60 @@ namespace trkf {
     xyz[2] = fZ0 + uvw[1] * sinphi + uvw[2] * cosphi;
   }
 
+  /// Transform global to local coordinates, for n points.
+  ///
+  /// Arguments:
+  ///
+  /// n   - Number of points.
+  /// xyz - Cartesian coordinates in global coordinate system, for each point.
+  /// uvw - Cartesian coordinates in local coordinate system, for each point.
+  ///
+  /// The two arrays may be the same (transformation in place).
+  ///
+  void SurfYZLine::toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const
+  {
+    const double x0 = fX0;
+    const double y0 = fY0;
+    const double z0 = fZ0;
+    const double sinphi = fSinPhi;
+    const double cosphi = fCosPhi;
+    for(std::size_t i=0; i<n; ++i) {
+      const double dx = xyz[i][0] - x0;
+      const double dy = xyz[i][1] - y0;
+      const double dz = xyz[i][2] - z0;
+      uvw[i][0] = dx;
+      uvw[i][1] = dy * cosphi + dz * sinphi;
+      uvw[i][2] = -dy * sinphi + dz * cosphi;
+    }
+  }
+
+  /// Transform local to global coordinates, for n points.
+  ///
+  /// Arguments:
+  ///
+  /// n   - Number of points.
+  /// uvw - Cartesian coordinates in local coordinate system, for each point.
+  /// xyz - Cartesian coordinates in global coordinate system, for each point.
+  ///
+  /// The two arrays may be the same (transformation in place).
+  ///
+  void SurfYZLine::toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const
+  {
+    const double x0 = fX0;
+    const double y0 = fY0;
+    const double z0 = fZ0;
+    const double sinphi = fSinPhi;
+    const double cosphi = fCosPhi;
+    for(std::size_t i=0; i<n; ++i) {
+      const double u = uvw[i][0];
+      const double v = uvw[i][1];
+      const double w = uvw[i][2];
+      xyz[i][0] = x0 + u;
+      xyz[i][1] = y0 + v * cosphi - w * sinphi;
+      xyz[i][2] = z0 + v * sinphi + w * cosphi;
+    }
+  }
+
   /// Calculate difference of two track parameter vectors, taking into account phi wrap.
   ///
   /// Arguments:
@@ -185,8 +243,8 @@ namespace trkf {
 
     // Rotate momentum to global coordinte system.
 
-    double sinfphi = std::sin(fPhi);
-    double cosfphi = std::cos(fPhi);
+    double sinfphi = fSinPhi;
+    double cosfphi = fCosPhi;
 
     mom[0] = pu;
     mom[1] = pv * cosfphi - pw * sinfphi;
@@ -106,6 +106,12 @@ namespace trkf {
     /// Transform local to global coordinates.
     virtual void toGlobal(const double uvw[3], double xyz[3]) const;
 
+    /// Transform global to local coordinates, for n points.
+    virtual void toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const;
+
+    /// Transform local to global coordinates, for n points.
+    virtual void toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const;
+
     /// Calculate difference of two track parameter vectors.
     virtual TrackVector getDiff(const TrackVector& vec1, const TrackVector& vec2) const;
 
@@ -141,6 +147,8 @@ namespace trkf {
     double fY0;     ///< Y origin.
     double fZ0;     ///< Z origin.
     double fPhi;    ///< Rotation angle about x-axis.
+    double fSinPhi; ///< sin(phi), cached.
+    double fCosPhi; ///< cos(phi), cached.
   };
 }
 
@@ -74,6 +74,12 @@ namespace trkf {
     /// Transform local to global coordinates.
     virtual void toGlobal(const double uvw[3], double xyz[3]) const;
 
+    /// Transform global to local coordinates, for n points.
+    virtual void toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const;
+
+    /// Transform local to global coordinates, for n points.
+    virtual void toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const;
+
     /// Get position of track.
     virtual void getPosition(const TrackVector& vec, double xyz[3]) const;
 
@@ -106,6 +112,8 @@ namespace trkf {
     double fY0;     ///< Y origin.
     double fZ0;     ///< Z origin.
     double fPhi;    ///< Rotation angle about x-axis.
+    double fSinPhi; ///< sin(phi), cached.
+    double fCosPhi; ///< cos(phi), cached.
   };
 }
 
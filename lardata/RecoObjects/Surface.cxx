@@ -35,4 +35,36 @@ namespace trkf {
     return vec1 - vec2;
   }
 
+  /// Transform global to local coordinates, for n points.
+  /// This method has a default implementation which transforms one point at a time.
+  /// Surfaces with a cheaper transformation of many points should override this method.
+  ///
+  /// Arguments:
+  ///
+  /// n   - Number of points.
+  /// xyz - Cartesian coordinates in global coordinate system, for each point.
+  /// uvw - Cartesian coordinates in local coordinate system, for each point.
+  ///
+  void Surface::toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const
+  {
+    for(std::size_t i=0; i<n; ++i)
+      toLocal(xyz[i], uvw[i]);
+  }
+
+  /// Transform local to global coordinates, for n points.
+  /// This method has a default implementation which transforms one point at a time.
+  /// Surfaces with a cheaper transformation of many points should override this method.
+  ///
+  /// Arguments:
+  ///
+  /// n   - Number of points.
+  /// uvw - Cartesian coordinates in local coordinate system, for each point.
+  /// xyz - Cartesian coordinates in global coordinate system, for each point.
+  ///
+  void Surface::toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const
+  {
+    for(std::size_t i=0; i<n; ++i)
+      toGlobal(uvw[i], xyz[i]);
+  }
+
 } // end namespace trkf
@@ -44,6 +44,7 @@
 #define SURFACE_H
 
 #include <iosfwd>
+#include <cstddef>
 #include "lardata/RecoObjects/KalmanLinearAlgebra.h"
 
 namespace trkf {
@@ -75,6 +76,12 @@ namespace trkf {
     /// Transform local to global coordinates.
     virtual void toGlobal(const double uvw[3], double xyz[3]) const = 0;
 
+    /// Transform global to local coordinates, for n points.
+    virtual void toLocalBatch(std::size_t n, const double xyz[][3], double uvw[][3]) const;
+
+    /// Transform local to global coordinates, for n points.
+    virtual void toGlobalBatch(std::size_t n, const double uvw[][3], double xyz[][3]) const;
+
     /// Calculate difference of two track parameter vectors.
     virtual TrackVector getDiff(const TrackVector& vec1, const TrackVector& vec2) const;
 
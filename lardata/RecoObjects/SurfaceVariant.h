@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   SurfaceVariant.h
+///
+/// \brief  Closed, value-type representation of the Kalman filter surfaces.
+///
+/// \date   October 14, 2026
+///
+/// The concrete Kalman filter surfaces are a closed set (SurfYZPlane,
+/// SurfXYZPlane, SurfYZLine and their wire-constructed variants
+/// SurfWireX and SurfWireLine).  This header offers two ways to
+/// dispatch on the concrete type without going through the virtual
+/// interface of Surface on each call:
+///
+/// 1.  SurfaceVariant, a std::variant holding a copy of the surface.
+///     The free functions below (toLocal(), toGlobal(), getPosition(),
+///     getMomentum(), ...) visit the variant and call the method of the
+///     concrete class with a qualified (non-virtual) call, which the
+///     compiler may inline.  Parallel and equality tests between
+///     surfaces of unrelated types are resolved at compile time.
+///
+/// 2.  visitSurface(), which calls a visitor with the concrete type of
+///     a polymorphic Surface.  The type is found with a single typeid
+///     comparison for the known types; other types derived from them
+///     are found with dynamic_cast, and are passed as their known base.
+///     This is what PropAny uses to pick the propagator.
+///
+/// The variant coexists with the polymorphic interface: makeSurfaceVariant()
+/// copies a Surface into a variant, and asSurface() and makeSurface()
+/// go back to the polymorphic interface (e.g. to be stored in a KTrack).
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef SURFACEVARIANT_H
+#define SURFACEVARIANT_H
+
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include "lardata/RecoObjects/SurfYZPlane.h"
+#include "lardata/RecoObjects/SurfXYZPlane.h"
+#include "lardata/RecoObjects/SurfYZLine.h"
+#include "lardata/RecoObjects/SurfWireX.h"
+#include "lardata/RecoObjects/SurfWireLine.h"
+#include "cetlib_except/exception.h"
+
+namespace trkf {
+
+  /// Value type holding any of the concrete surfaces.
+  using SurfaceVariant = std::variant
+    <SurfYZPlane, SurfXYZPlane, SurfYZLine, SurfWireX, SurfWireLine>;
+
+  /// The class defining the geometry (and the comparisons) of surface type S.
+  template <typename S>
+  using SurfaceGeometry_t = std::conditional_t<
+    std::is_base_of<SurfYZLine, S>::value, SurfYZLine,
+    std::conditional_t<std::is_base_of<SurfYZPlane, S>::value, SurfYZPlane,
+    SurfXYZPlane>>;
+
+  /// Calls f with the concrete type of surf.
+  ///
+  /// Arguments:
+  ///
+  /// surf - Surface.
+  /// f    - Visitor, callable with a constant reference to any of the
+  ///        types in SurfaceVariant and to Surface; all calls must
+  ///        return the same type.
+  ///
+  /// Returned value: the value returned by f.
+  ///
+  /// Surfaces of other types derived from SurfYZLine, SurfYZPlane or
+  /// SurfXYZPlane are passed to f as that base type.  Other surfaces
+  /// are passed as Surface, and it is up to f to handle them.
+  ///
+  template <typename F>
+  decltype(auto) visitSurface(const Surface& surf, F&& f)
+  {
+    // Fast path: exact type match.
+
+    const std::type_info& type = typeid(surf);
+    if(type == typeid(SurfWireX))
+      return f(static_cast<const SurfWireX&>(surf));
+    if(type == typeid(SurfWireLine))
+      return f(static_cast<const SurfWireLine&>(surf));
+    if(type == typeid(SurfYZPlane))
+      return f(static_cast<const SurfYZPlane&>(surf));
+    if(type == typeid(SurfXYZPlane))
+      return f(static_cast<const SurfXYZPlane&>(surf));
+    if(type == typeid(SurfYZLine))
+      return f(static_cast<const SurfYZLine&>(surf));
+
+    // Other derived types.
+
+    if(const SurfYZLine* psurf = dynamic_cast<const SurfYZLine*>(&surf))
+      return f(*psurf);
+    if(const SurfYZPlane* psurf = dynamic_cast<const SurfYZPlane*>(&surf))
+      return f(*psurf);
+    if(const SurfXYZPlane* psurf = dynamic_cast<const SurfXYZPlane*>(&surf))
+      return f(*psurf);
+    return f(surf);
+  }
+
+  /// Copies a polymorphic surface into a variant.
+  inline SurfaceVariant makeSurfaceVariant(const Surface& surf)
+  {
+    return visitSurface(surf, [](const auto& s) -> SurfaceVariant {
+	if constexpr (std::is_same<std::decay_t<decltype(s)>, Surface>::value)
+	  throw cet::exception("SurfaceVariant") << "Surface has unknown type.\n";
+	else
+	  return s;
+      });
+  }
+
+  /// Returns the polymorphic interface of the surface in the variant.
+  inline const Surface& asSurface(const SurfaceVariant& surf)
+  {
+    return std::visit([](const auto& s) -> const Surface& { return s; }, surf);
+  }
+
+  /// Returns a new polymorphic copy of the surface in the variant.
+  inline std::shared_ptr<const Surface> makeSurface(const SurfaceVariant& surf)
+  {
+    return std::visit([](const auto& s) -> std::shared_ptr<const Surface>
+      { return std::make_shared<std::decay_t<decltype(s)>>(s); }, surf);
+  }
+
+  // Non-virtual versions of the Surface interface.
+
+  /// Surface-specific tests of validity of track parameters.
+  inline bool isTrackValid(const SurfaceVariant& surf, const TrackVector& vec)
+  {
+    return std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; return s.S::isTrackValid(vec); },
+      surf);
+  }
+
+  /// Transform global to local coordinates.
+  inline void toLocal(const SurfaceVariant& surf, const double xyz[3], double uvw[3])
+  {
+    std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; s.S::toLocal(xyz, uvw); }, surf);
+  }
+
+  /// Transform local to global coordinates.
+  inline void toGlobal(const SurfaceVariant& surf, const double uvw[3], double xyz[3])
+  {
+    std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; s.S::toGlobal(uvw, xyz); }, surf);
+  }
+
+  /// Transform global to local coordinates, for n points.
+  inline void toLocalBatch(const SurfaceVariant& surf, std::size_t n,
+			   const double xyz[][3], double uvw[][3])
+  {
+    std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; s.S::toLocalBatch(n, xyz, uvw); },
+      surf);
+  }
+
+  /// Transform local to global coordinates, for n points.
+  inline void toGlobalBatch(const SurfaceVariant& surf, std::size_t n,
+			    const double uvw[][3], double xyz[][3])
+  {
+    std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; s.S::toGlobalBatch(n, uvw, xyz); },
+      surf);
+  }
+
+  /// Calculate difference of two track parameter vectors.
+  inline TrackVector getDiff(const SurfaceVariant& surf,
+			     const TrackVector& vec1, const TrackVector& vec2)
+  {
+    return std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; return s.S::getDiff(vec1, vec2); },
+      surf);
+  }
+
+  /// Get position of track.
+  inline void getPosition(const SurfaceVariant& surf,
+			  const TrackVector& vec, double xyz[3])
+  {
+    std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; s.S::getPosition(vec, xyz); },
+      surf);
+  }
+
+  /// Get direction of track.
+  inline Surface::TrackDirection getDirection(const SurfaceVariant& surf,
+    const TrackVector& vec, Surface::TrackDirection dir = Surface::UNKNOWN)
+  {
+    return std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; return s.S::getDirection(vec, dir); },
+      surf);
+  }
+
+  /// Get momentum vector of track.
+  inline void getMomentum(const SurfaceVariant& surf, const TrackVector& vec,
+    double mom[3], Surface::TrackDirection dir = Surface::UNKNOWN)
+  {
+    std::visit([&](const auto& s)
+      { using S = std::decay_t<decltype(s)>; s.S::getMomentum(vec, mom, dir); },
+      surf);
+  }
+
+  /// Test whether two surfaces are parallel, within tolerance.
+  inline bool isParallel(const SurfaceVariant& surf1, const SurfaceVariant& surf2)
+  {
+    return std::visit([](const auto& s1, const auto& s2){
+	using S1 = std::decay_t<decltype(s1)>;
+	using S2 = std::decay_t<decltype(s2)>;
+	if constexpr (std::is_base_of<SurfaceGeometry_t<S1>, S2>::value)
+	  return s1.S1::isParallel(s2);
+	else
+	  return false;
+      }, surf1, surf2);
+  }
+
+  /// Find perpendicular forward distance to a parallel surface.
+  inline double distanceTo(const SurfaceVariant& surf1, const SurfaceVariant& surf2)
+  {
+    return std::visit([](const auto& s1, const auto& s2){
+	using S1 = std::decay_t<decltype(s1)>;
+	return s1.S1::distanceTo(s2);
+      }, surf1, surf2);
+  }
+
+  /// Test two surfaces for equality, within tolerance.
+  inline bool isEqual(const SurfaceVariant& surf1, const SurfaceVariant& surf2)
+  {
+    return std::visit([](const auto& s1, const auto& s2){
+	using S1 = std::decay_t<decltype(s1)>;
+	using S2 = std::decay_t<decltype(s2)>;
+	if constexpr (std::is_base_of<SurfaceGeometry_t<S1>, S2>::value)
+	  return s1.S1::isEqual(s2);
+	else
+	  return false;
+      }, surf1, surf2);
+  }
+}
+
+#endif
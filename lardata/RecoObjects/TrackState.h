@@ -45,6 +45,9 @@ namespace trkf {
     : fHitMeas(hitMeas),fHitMeasErr2(hitMeasErr2), fWireId(wireId),fPlane(recob::tracking::makePlane(wgeom)) {}
   HitState(double hitMeas, double hitMeasErr2, geo::WireID&& wireId, const geo::WireGeo& wgeom)
     : fHitMeas(hitMeas),fHitMeasErr2(hitMeasErr2), fWireId(std::move(wireId)),fPlane(recob::tracking::makePlane(wgeom)) {}
+  /// Constructor from the measurement plane, when it is already known
+  HitState(double hitMeas, double hitMeasErr2, const geo::WireID& wireId, const Plane& plane)
+    : fHitMeas(hitMeas),fHitMeasErr2(hitMeasErr2), fWireId(wireId),fPlane(plane) {}
     double             hitMeas()     const { return fHitMeas; }
     double             hitMeasErr2() const { return fHitMeasErr2; }
     const Plane&       plane()       const { return fPlane; }
@@ -0,0 +1,206 @@
+#include "lardata/RecoObjects/TrackStateBatch.h"
+#include "cetlib_except/exception.h"
+
+namespace trkf {
+
+  void PlaneBatch::push_back(const Plane& plane) {
+    fX.push_back(plane.position().X());
+    fY.push_back(plane.position().Y());
+    fZ.push_back(plane.position().Z());
+    fDirX.push_back(plane.direction().X());
+    fDirY.push_back(plane.direction().Y());
+    fDirZ.push_back(plane.direction().Z());
+    fSinA.push_back(plane.sinAlpha());
+    fCosA.push_back(plane.cosAlpha());
+    fSinB.push_back(plane.sinBeta());
+    fCosB.push_back(plane.cosBeta());
+  }
+
+  void PlaneBatch::set(std::size_t i, const Plane& plane) {
+    fX[i] = plane.position().X();
+    fY[i] = plane.position().Y();
+    fZ[i] = plane.position().Z();
+    fDirX[i] = plane.direction().X();
+    fDirY[i] = plane.direction().Y();
+    fDirZ[i] = plane.direction().Z();
+    fSinA[i] = plane.sinAlpha();
+    fCosA[i] = plane.cosAlpha();
+    fSinB[i] = plane.sinBeta();
+    fCosB[i] = plane.cosBeta();
+  }
+
+  void PlaneBatch::clear() {
+    for (auto* v : { &fX, &fY, &fZ, &fDirX, &fDirY, &fDirZ, &fSinA, &fCosA, &fSinB, &fCosB }) v->clear();
+  }
+
+  void PlaneBatch::reserve(std::size_t n) {
+    for (auto* v : { &fX, &fY, &fZ, &fDirX, &fDirY, &fDirZ, &fSinA, &fCosA, &fSinB, &fCosB }) v->reserve(n);
+  }
+
+  batch::PlaneArrays<double> PlaneBatch::arrays() {
+    return batch::PlaneArrays<double>{ fX.data(), fY.data(), fZ.data(), fDirX.data(), fDirY.data(), fDirZ.data(),
+				       fSinA.data(), fCosA.data(), fSinB.data(), fCosB.data() };
+  }
+
+  batch::PlaneArrays<const double> PlaneBatch::arrays() const {
+    return batch::PlaneArrays<const double>{ fX.data(), fY.data(), fZ.data(), fDirX.data(), fDirY.data(), fDirZ.data(),
+					     fSinA.data(), fCosA.data(), fSinB.data(), fCosB.data() };
+  }
+
+  void TrackStateBatch::push_back(const TrackState& state) {
+    const SVector5& par = state.parameters();
+    const SMatrixSym55& cov = state.covariance();
+    for (unsigned int i = 0; i < 5; ++i) fPar[i].push_back(par(i));
+    for (unsigned int i = 0; i < 5; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) fCov[batch::symIndex(i,j)].push_back(cov(i,j));
+    }
+    fPos[0].push_back(state.position().X());
+    fPos[1].push_back(state.position().Y());
+    fPos[2].push_back(state.position().Z());
+    fMom[0].push_back(state.momentum().X());
+    fMom[1].push_back(state.momentum().Y());
+    fMom[2].push_back(state.momentum().Z());
+    fPlanes.push_back(state.plane());
+    fPid.push_back(state.pID());
+  }
+
+  TrackState TrackStateBatch::state(std::size_t i) const {
+    SVector5 par;
+    SMatrixSym55 cov;
+    for (unsigned int a = 0; a < 5; ++a) par(a) = fPar[a][i];
+    for (unsigned int a = 0; a < 5; ++a) {
+      for (unsigned int b = 0; b <= a; ++b) cov(a,b) = fCov[batch::symIndex(a,b)][i];
+    }
+    const Plane plane = fPlanes.plane(i);
+    const Vector_t mom(fMom[0][i], fMom[1][i], fMom[2][i]);
+    return TrackState(par, cov, plane, mom.Dot(plane.direction())>0, fPid[i]);
+  }
+
+  void TrackStateBatch::set(std::size_t i, const TrackState& state) {
+    const SVector5& par = state.parameters();
+    const SMatrixSym55& cov = state.covariance();
+    for (unsigned int a = 0; a < 5; ++a) fPar[a][i] = par(a);
+    for (unsigned int a = 0; a < 5; ++a) {
+      for (unsigned int b = 0; b <= a; ++b) fCov[batch::symIndex(a,b)][i] = cov(a,b);
+    }
+    fPos[0][i] = state.position().X();
+    fPos[1][i] = state.position().Y();
+    fPos[2][i] = state.position().Z();
+    fMom[0][i] = state.momentum().X();
+    fMom[1][i] = state.momentum().Y();
+    fMom[2][i] = state.momentum().Z();
+    fPlanes.set(i, state.plane());
+    fPid[i] = state.pID();
+  }
+
+  void TrackStateBatch::clear() {
+    for (auto& v : fPar) v.clear();
+    for (auto& v : fCov) v.clear();
+    for (auto& v : fPos) v.clear();
+    for (auto& v : fMom) v.clear();
+    fPlanes.clear();
+    fPid.clear();
+  }
+
+  void TrackStateBatch::reserve(std::size_t n) {
+    for (auto& v : fPar) v.reserve(n);
+    for (auto& v : fCov) v.reserve(n);
+    for (auto& v : fPos) v.reserve(n);
+    for (auto& v : fMom) v.reserve(n);
+    fPlanes.reserve(n);
+    fPid.reserve(n);
+  }
+
+  batch::StateArrays TrackStateBatch::arrays() {
+    batch::StateArrays s;
+    for (unsigned int a = 0; a < 5; ++a)  s.par[a] = fPar[a].data();
+    for (unsigned int a = 0; a < 15; ++a) s.cov[a] = fCov[a].data();
+    for (unsigned int a = 0; a < 3; ++a)  s.pos[a] = fPos[a].data();
+    for (unsigned int a = 0; a < 3; ++a)  s.mom[a] = fMom[a].data();
+    s.plane = fPlanes.arrays();
+    return s;
+  }
+
+  void HitStateBatch::push_back(const HitState& hit) {
+    fMeas.push_back(hit.hitMeas());
+    fErr2.push_back(hit.hitMeasErr2());
+    fPlanes.push_back(hit.plane());
+  }
+
+  void HitStateBatch::clear() {
+    fMeas.clear();
+    fErr2.clear();
+    fPlanes.clear();
+  }
+
+  void HitStateBatch::reserve(std::size_t n) {
+    fMeas.reserve(n);
+    fErr2.reserve(n);
+    fPlanes.reserve(n);
+  }
+
+  batch::HitArrays HitStateBatch::arrays() const {
+    return batch::HitArrays{ fMeas.data(), fErr2.data(), fPlanes.arrays() };
+  }
+
+  namespace {
+    // success has one entry per state; without selection, all of them are reset
+    void prepareSuccess(std::vector<char>& success, const std::vector<char>& select, std::size_t n, const char* caller) {
+      if (!select.empty() && select.size() != n)
+	throw cet::exception(caller) << "Selection of " << select.size() << " entries for " << n << " states.\n";
+      if (select.empty()) success.assign(n, false);
+      else success.resize(n, false);
+    }
+  }
+
+  bool propagateStraightToPlanes(std::vector<char>& success, TrackStateBatch& states, const PlaneBatch& targets,
+				 double wrongDirDistTolerance, TrackStatePropagator::PropDirection dir,
+				 const std::vector<char>& select, bool useDevice) {
+    const std::size_t n = states.size();
+    if (targets.size() != 1 && targets.size() != n)
+      throw cet::exception("propagateStraightToPlanes") << targets.size() << " target planes for " << n << " states.\n";
+    prepareSuccess(success, select, n, "propagateStraightToPlanes");
+    if (n == 0) return false;
+    const batch::StateArrays s = states.arrays();
+    const batch::TargetArrays t{ targets.arrays(), std::size_t(targets.size() == 1 ? 0 : 1) };
+    const char* sel = select.empty() ? nullptr : select.data();
+#ifdef LARDATA_CUDA
+    if (useDevice && batch::details::propagateStraightOnDevice(s, t, targets.size(), n, dir, wrongDirDistTolerance, sel, success.data()))
+      return true;
+#else
+    (void) useDevice;
+#endif
+    char* ok = success.data();
+    for (std::size_t i = 0; i < n; ++i) {
+      const bool active = !sel || sel[i];
+      const bool done = batch::propagateStraight(s, t, i, dir, wrongDirDistTolerance, active);
+      ok[i] = active ? done : ok[i];
+    }
+    return false;
+  }
+
+  bool updateWithHitStates(std::vector<char>& success, TrackStateBatch& states, const HitStateBatch& hits,
+			   const std::vector<char>& select, bool useDevice) {
+    const std::size_t n = states.size();
+    if (hits.size() != n)
+      throw cet::exception("updateWithHitStates") << hits.size() << " hits for " << n << " states.\n";
+    prepareSuccess(success, select, n, "updateWithHitStates");
+    if (n == 0) return false;
+    const batch::StateArrays s = states.arrays();
+    const batch::HitArrays h = hits.arrays();
+    const char* sel = select.empty() ? nullptr : select.data();
+#ifdef LARDATA_CUDA
+    if (useDevice && batch::details::updateWithHitsOnDevice(s, h, n, sel, success.data())) return true;
+#else
+    (void) useDevice;
+#endif
+    char* ok = success.data();
+    for (std::size_t i = 0; i < n; ++i) {
+      const bool active = !sel || sel[i];
+      const bool done = batch::updateWithHit(s, h, i, active);
+      ok[i] = active ? done : ok[i];
+    }
+    return false;
+  }
+
+}
@@ -0,0 +1,139 @@
+#ifndef TRACKSTATEBATCH_H
+#define TRACKSTATEBATCH_H
+
+#include "lardata/RecoObjects/TrackState.h"
+#include "lardata/RecoObjects/TrackStatePropagator.h"
+#include "lardata/RecoObjects/TrackStateBatchKernels.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace trkf {
+
+  /// \file  lardata/RecoObjects/TrackStateBatch.h
+  /// \class PlaneBatch
+  ///
+  /// \brief Collection of recob::tracking::Plane in structure-of-arrays layout.
+  ///
+  /// \date    October 14, 2026
+  ///
+  /// Each plane is stored as its position and direction, plus the sines and cosines of its angles.
+  ///
+
+  class PlaneBatch {
+  public:
+    /// Add a plane at the end of the collection
+    void push_back(const Plane& plane);
+    /// Plane i
+    Plane plane(std::size_t i) const { return Plane(Point_t(fX[i],fY[i],fZ[i]), Vector_t(fDirX[i],fDirY[i],fDirZ[i])); }
+    /// Replace plane i
+    void set(std::size_t i, const Plane& plane);
+    //
+    std::size_t size()  const { return fX.size(); }
+    bool        empty() const { return fX.empty(); }
+    void        clear();
+    void        reserve(std::size_t n);
+    //
+    //@{
+    /// Pointers to the arrays, for the kernels
+    batch::PlaneArrays<double>       arrays();
+    batch::PlaneArrays<const double> arrays() const;
+    //@}
+  private:
+    std::vector<double> fX, fY, fZ;
+    std::vector<double> fDirX, fDirY, fDirZ;
+    std::vector<double> fSinA, fCosA, fSinB, fCosB;
+  };
+
+  /// \class TrackStateBatch
+  ///
+  /// \brief Collection of TrackState in structure-of-arrays layout, for the batch propagation and update.
+  ///
+  /// \date    October 14, 2026
+  ///
+  /// The parameters, the covariance (lower triangle), the global position and momentum and the plane of all the states
+  /// are each stored in contiguous arrays, one per component, so that a kernel (see TrackStateBatchKernels.h) applied
+  /// to all the states runs as a loop over the states with contiguous memory access, or on a GPU.
+  ///
+  /// Typical usage, for many tracks crossing the same sequence of wire planes:
+  ///
+  ///   trkf::TrackStateBatch states; // push_back the starting states
+  ///   prop.propagateToPlane(success, states, targets, dodedx, domcs);   // see TrackStatePropagator
+  ///   trkf::updateWithHitStates(success, states, hits);
+  ///   trkf::TrackState s = states.state(i);
+  ///
+
+  class TrackStateBatch {
+  public:
+    /// Add a state at the end of the collection
+    void push_back(const TrackState& state);
+    /// State i
+    TrackState state(std::size_t i) const;
+    /// Replace state i
+    void set(std::size_t i, const TrackState& state);
+    /// Parameter k of state i
+    double parameter(std::size_t i, unsigned int k) const { return fPar[k][i]; }
+    //
+    std::size_t size()  const { return fPid.size(); }
+    bool        empty() const { return fPid.empty(); }
+    void        clear();
+    void        reserve(std::size_t n);
+    //
+    /// Planes of the states
+    const PlaneBatch& planes() const { return fPlanes; }
+    //
+    /// Pointers to the arrays, for the kernels
+    batch::StateArrays arrays();
+  private:
+    std::vector<double> fPar[5];
+    std::vector<double> fCov[15];
+    std::vector<double> fPos[3];
+    std::vector<double> fMom[3];
+    PlaneBatch          fPlanes;
+    std::vector<int>    fPid;
+  };
+
+  /// \class HitStateBatch
+  ///
+  /// \brief Collection of HitState (measurement, error and plane) in structure-of-arrays layout.
+  ///
+  /// \date    October 14, 2026
+  ///
+
+  class HitStateBatch {
+  public:
+    /// Add a hit at the end of the collection
+    void push_back(const HitState& hit);
+    //
+    std::size_t size()  const { return fMeas.size(); }
+    bool        empty() const { return fMeas.empty(); }
+    void        clear();
+    void        reserve(std::size_t n);
+    //
+    /// Pointers to the arrays, for the kernels
+    batch::HitArrays arrays() const;
+  private:
+    std::vector<double> fMeas;
+    std::vector<double> fErr2;
+    PlaneBatch          fPlanes;
+  };
+
+  /// Straight line propagation of each of the states to the corresponding target plane, or to the only target plane,
+  /// as TrackStatePropagator::propagateToPlane without material effects.
+  /// On failure, the corresponding entry of success is false and the state is not modified.
+  /// With a nonempty select, only the states with a nonzero entry are propagated, and the other entries of success
+  /// are not modified. With useDevice, the kernel runs on a GPU if lardata is built with CUDA (otherwise or after an
+  /// error, on the CPU); the return value tells where it ran (true for the GPU).
+  bool propagateStraightToPlanes(std::vector<char>& success, TrackStateBatch& states, const PlaneBatch& targets,
+				 double wrongDirDistTolerance, TrackStatePropagator::PropDirection dir,
+				 const std::vector<char>& select = {}, bool useDevice = false);
+
+  /// Kalman update of each of the states with the corresponding hit, as KFTrackState::updateWithHitState.
+  /// The hit and the state need to be on the same plane, otherwise the entry of success is false and the state is not modified.
+  /// The select and useDevice arguments are as for propagateStraightToPlanes.
+  bool updateWithHitStates(std::vector<char>& success, TrackStateBatch& states, const HitStateBatch& hits,
+			   const std::vector<char>& select = {}, bool useDevice = false);
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "lardata/RecoObjects/TrackStateBatchKernels.h"
+
+#include <cuda_runtime.h>
+
+#include <vector>
+
+namespace {
+
+  using namespace trkf::batch;
+
+  // ... one allocation for all the arrays of a call, released at the end of it
+  class DeviceArrays {
+  public:
+    DeviceArrays(std::size_t nArrays, std::size_t n) : fN(n)
+      { fOk = (cudaMalloc(&fData, sizeof(double)*nArrays*n) == cudaSuccess); }
+    ~DeviceArrays() { if (fData) cudaFree(fData); }
+    bool ok() const { return fOk; }
+
+    // ... device copy of the host array of m values (n, by default)
+    double* upload(const double* host, std::size_t m = 0) {
+      if (m == 0) m = fN;
+      double* dev = fData + fUsed;
+      fUsed += m;
+      if (fOk) fOk = (cudaMemcpy(dev, host, sizeof(double)*m, cudaMemcpyHostToDevice) == cudaSuccess);
+      fCopies.push_back(Copy{ const_cast<double*>(host), dev, m });
+      return dev;
+    }
+
+    // ... copies back the first nCopies arrays uploaded
+    bool download(std::size_t nCopies) {
+      for (std::size_t c = 0; fOk && c < nCopies; ++c)
+	fOk = (cudaMemcpy(fCopies[c].host, fCopies[c].dev, sizeof(double)*fCopies[c].size, cudaMemcpyDeviceToHost) == cudaSuccess);
+      return fOk;
+    }
+
+  private:
+    struct Copy { double* host; double* dev; std::size_t size; };
+    std::size_t fN;
+    double* fData = nullptr;
+    std::size_t fUsed = 0;
+    bool fOk = false;
+    std::vector<Copy> fCopies;
+  };
+
+  // ... flags are copied as bytes
+  class DeviceFlags {
+  public:
+    explicit DeviceFlags(std::size_t n) : fN(n)
+      { fOk = (cudaMalloc(&fData, 2*n) == cudaSuccess); }
+    ~DeviceFlags() { if (fData) cudaFree(fData); }
+    bool ok() const { return fOk; }
+    char* select() { return fData; }
+    char* success() { return fData + fN; }
+    bool upload(const char* select, const char* success) {
+      if (fOk && select) fOk = (cudaMemcpy(fData, select, fN, cudaMemcpyHostToDevice) == cudaSuccess);
+      if (fOk) fOk = (cudaMemcpy(fData + fN, success, fN, cudaMemcpyHostToDevice) == cudaSuccess);
+      return fOk;
+    }
+    bool download(char* success) {
+      if (fOk) fOk = (cudaMemcpy(success, fData + fN, fN, cudaMemcpyDeviceToHost) == cudaSuccess);
+      return fOk;
+    }
+  private:
+    std::size_t fN;
+    char* fData = nullptr;
+    bool fOk = false;
+  };
+
+  // ... the state arrays are uploaded first, so that they are the ones copied back
+  constexpr std::size_t NStateArrays = 5 + 15 + 3 + 3 + 10;
+
+  StateArrays uploadStates(DeviceArrays& dev, StateArrays const& s) {
+    StateArrays d;
+    for (unsigned int a = 0; a < 5; ++a)  d.par[a] = dev.upload(s.par[a]);
+    for (unsigned int a = 0; a < 15; ++a) d.cov[a] = dev.upload(s.cov[a]);
+    for (unsigned int a = 0; a < 3; ++a)  d.pos[a] = dev.upload(s.pos[a]);
+    for (unsigned int a = 0; a < 3; ++a)  d.mom[a] = dev.upload(s.mom[a]);
+    d.plane.x    = dev.upload(s.plane.x);
+    d.plane.y    = dev.upload(s.plane.y);
+    d.plane.z    = dev.upload(s.plane.z);
+    d.plane.dirX = dev.upload(s.plane.dirX);
+    d.plane.dirY = dev.upload(s.plane.dirY);
+    d.plane.dirZ = dev.upload(s.plane.dirZ);
+    d.plane.sinA = dev.upload(s.plane.sinA);
+    d.plane.cosA = dev.upload(s.plane.cosA);
+    d.plane.sinB = dev.upload(s.plane.sinB);
+    d.plane.cosB = dev.upload(s.plane.cosB);
+    return d;
+  }
+
+  PlaneArrays<const double> uploadPlanes(DeviceArrays& dev, PlaneArrays<const double> const& p, std::size_t m) {
+    PlaneArrays<const double> d;
+    d.x    = dev.upload(p.x, m);
+    d.y    = dev.upload(p.y, m);
+    d.z    = dev.upload(p.z, m);
+    d.dirX = dev.upload(p.dirX, m);
+    d.dirY = dev.upload(p.dirY, m);
+    d.dirZ = dev.upload(p.dirZ, m);
+    d.sinA = dev.upload(p.sinA, m);
+    d.cosA = dev.upload(p.cosA, m);
+    d.sinB = dev.upload(p.sinB, m);
+    d.cosB = dev.upload(p.cosB, m);
+    return d;
+  }
+
+  // ... one thread per state
+  __global__ void PropagateStraight(StateArrays s, TargetArrays t, std::size_t n, int dir, double tolerance,
+				    const char* select, char* success) {
+    std::size_t const i = std::size_t(blockIdx.x)*blockDim.x + threadIdx.x;
+    if (i >= n || (select && !select[i])) return;
+    success[i] = propagateStraight(s, t, i, dir, tolerance);
+  }
+
+  __global__ void UpdateWithHits(StateArrays s, HitArrays h, std::size_t n, const char* select, char* success) {
+    std::size_t const i = std::size_t(blockIdx.x)*blockDim.x + threadIdx.x;
+    if (i >= n || (select && !select[i])) return;
+    success[i] = updateWithHit(s, h, i);
+  }
+
+  constexpr unsigned int Threads = 128;
+  unsigned int blocks(std::size_t n) { return (n + Threads - 1)/Threads; }
+
+}
+
+bool trkf::batch::details::propagateStraightOnDevice(StateArrays const& s, TargetArrays const& t, std::size_t nTargets, std::size_t n,
+						     int dir, double tolerance, const char* select, char* success) {
+  if (n == 0) return true;
+  DeviceArrays dev(NStateArrays + 10, n);
+  DeviceFlags flags(n);
+  if (!dev.ok() || !flags.ok()) return false;
+  const StateArrays ds = uploadStates(dev, s);
+  const TargetArrays dt{ uploadPlanes(dev, t.plane, nTargets), t.stride };
+  if (!dev.ok() || !flags.upload(select, success)) return false;
+  PropagateStraight<<<blocks(n), Threads>>>(ds, dt, n, dir, tolerance, select ? flags.select() : nullptr, flags.success());
+  if (cudaGetLastError() != cudaSuccess || cudaDeviceSynchronize() != cudaSuccess) return false;
+  return dev.download(NStateArrays) && flags.download(success);
+}
+
+bool trkf::batch::details::updateWithHitsOnDevice(StateArrays const& s, HitArrays const& h, std::size_t n, const char* select, char* success) {
+  if (n == 0) return true;
+  DeviceArrays dev(NStateArrays + 12, n);
+  DeviceFlags flags(n);
+  if (!dev.ok() || !flags.ok()) return false;
+  const StateArrays ds = uploadStates(dev, s);
+  HitArrays dh;
+  dh.meas = dev.upload(h.meas);
+  dh.err2 = dev.upload(h.err2);
+  dh.plane = uploadPlanes(dev, h.plane, n);
+  if (!dev.ok() || !flags.upload(select, success)) return false;
+  UpdateWithHits<<<blocks(n), Threads>>>(ds, dh, n, select ? flags.select() : nullptr, flags.success());
+  if (cudaGetLastError() != cudaSuccess || cudaDeviceSynchronize() != cudaSuccess) return false;
+  return dev.download(NStateArrays) && flags.download(success);
+}
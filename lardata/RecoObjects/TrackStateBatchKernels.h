@@ -0,0 +1,261 @@
+#ifndef TRACKSTATEBATCHKERNELS_H
+#define TRACKSTATEBATCHKERNELS_H
+
+#include <cmath>
+#include <cstddef>
+
+#ifdef __CUDACC__
+#define TRKF_HOST_DEVICE __host__ __device__
+#else
+#define TRKF_HOST_DEVICE
+#endif
+
+namespace trkf {
+
+  /// \file  lardata/RecoObjects/TrackStateBatchKernels.h
+  ///
+  /// \brief Kernels of the batch propagation and update of track states (see TrackStateBatch.h).
+  ///
+  /// \date    October 14, 2026
+  ///
+  /// The kernels process one element of arrays in structure-of-arrays layout, given as plain pointers,
+  /// so that they can be called in a loop over the tracks on the CPU (with contiguous memory access)
+  /// or by one thread per track on a GPU (TrackStateBatchKernels.cu). They only use basic arithmetic,
+  /// and they repeat step by step the computations of TrackStatePropagator::propagateToPlane (straight
+  /// line path) and KFTrackState::updateWithHitState, in order to take the same decisions.
+  ///
+  /// The covariance matrices are stored as their lower triangle, row by row (element (i,j), with j<=i,
+  /// at index i*(i+1)/2+j), like SMatrixSym55.
+  ///
+
+  namespace batch {
+
+    /// Pointers to the arrays describing planes (recob::tracking::Plane).
+    template <typename T>
+    struct PlaneArrays {
+      T* x;    T* y;    T* z;    ///< point on the plane
+      T* dirX; T* dirY; T* dirZ; ///< direction orthogonal to the plane
+      T* sinA; T* cosA;          ///< sine and cosine of alpha
+      T* sinB; T* cosB;          ///< sine and cosine of beta
+    };
+
+    /// Pointers to the arrays of track states.
+    struct StateArrays {
+      double* par[5];  ///< local parameters on the plane
+      double* cov[15]; ///< lower triangle of the covariance matrix
+      double* pos[3];  ///< global position (cached)
+      double* mom[3];  ///< global momentum (cached)
+      PlaneArrays<double> plane; ///< plane of the states
+    };
+
+    /// Pointers to the arrays of target planes: one plane per state, or one plane for all (stride 0).
+    struct TargetArrays {
+      PlaneArrays<const double> plane;
+      std::size_t stride;
+    };
+
+    /// Pointers to the arrays of hit states, one per track state.
+    struct HitArrays {
+      const double* meas;
+      const double* err2;
+      PlaneArrays<const double> plane;
+    };
+
+    /// Index of element (i,j), j<=i, of the packed covariance matrices.
+    TRKF_HOST_DEVICE inline constexpr unsigned int symIndex(unsigned int i, unsigned int j) { return i*(i+1)/2+j; }
+
+    /// Global position and momentum from the local parameters (as recob::tracking::Plane::Local5DToGlobal6DParameters).
+    TRKF_HOST_DEVICE inline void localToGlobal(const double par[5], double sinA, double cosA, double sinB, double cosB,
+					       double x0, double y0, double z0, bool trackAlongPlaneDir, double pos[3], double mom[3]) {
+      const double u = par[0];
+      const double v = par[1];
+      const double dudw = par[2];
+      const double dvdw = par[3];
+      const double pinv = par[4];
+      pos[0] = x0 + u*cosA;
+      pos[1] = y0 + u*sinA*sinB + v*cosB;
+      pos[2] = z0 - u*sinA*cosB + v*sinB;
+      const double dwds = (trackAlongPlaneDir ? 1. : -1.)/std::sqrt(1. + dudw*dudw + dvdw*dvdw);
+      const double p = (pinv != 0. ? 1./pinv : 1.);
+      mom[0] = p * dwds * (dudw*cosA + sinA);
+      mom[1] = p * dwds * (dudw*sinA*sinB + dvdw*cosB - cosA*sinB);
+      mom[2] = p * dwds * (-dudw*sinA*cosB + dvdw*sinB + cosA*cosB);
+    }
+
+    /// Packed covariance out = jac * in * jac^T.
+    TRKF_HOST_DEVICE inline void similarity(const double jac[5][5], const double in[15], double out[15]) {
+      double jc[5][5];
+      for (unsigned int a = 0; a < 5; ++a) {
+	for (unsigned int b = 0; b < 5; ++b) {
+	  double sum = 0.;
+	  for (unsigned int c = 0; c < 5; ++c) sum += jac[a][c]*in[c >= b ? symIndex(c,b) : symIndex(b,c)];
+	  jc[a][b] = sum;
+	}
+      }
+      for (unsigned int a = 0; a < 5; ++a) {
+	for (unsigned int b = 0; b <= a; ++b) {
+	  double sum = 0.;
+	  for (unsigned int c = 0; c < 5; ++c) sum += jc[a][c]*jac[b][c];
+	  out[symIndex(a,b)] = sum;
+	}
+      }
+    }
+
+    /// Straight line propagation of state i to its target plane (TrackStatePropagator::propagateToPlane without material effects).
+    /// dir is the TrackStatePropagator::PropDirection. Returns false if the track is parallel to the plane or the distance is
+    /// beyond tolerance in the wrong direction, or if active is false; then the state is not modified.
+    /// All the values are computed in any case, and the result is stored or not at the end with no branch, so that the
+    /// threads of a GPU warp do not diverge.
+    TRKF_HOST_DEVICE inline bool propagateStraight(StateArrays const& s, TargetArrays const& t, std::size_t i, int dir, double tolerance,
+						   bool active = true) {
+      const std::size_t k = i*t.stride;
+      const double tx = t.plane.x[k];
+      const double ty = t.plane.y[k];
+      const double tz = t.plane.z[k];
+      const double tdx = t.plane.dirX[k];
+      const double tdy = t.plane.dirY[k];
+      const double tdz = t.plane.dirZ[k];
+      const double px = s.mom[0][i];
+      const double py = s.mom[1][i];
+      const double pz = s.mom[2][i];
+      const double pmag = std::sqrt(px*px + py*py + pz*pz);
+      //
+      // 1- distance to the target plane, along the track and orthogonal to the plane
+      const double cosTheta = tdx*(px/pmag) + tdy*(py/pmag) + tdz*(pz/pmag);
+      const double sperp = tdx*(tx - s.pos[0][i]) + tdy*(ty - s.pos[1][i]) + tdz*(tz - s.pos[2][i]);
+      const double distance = sperp/cosTheta;
+      bool ok = active && cosTheta != 0. && !((distance < -tolerance && dir == 0) || (distance > tolerance && dir == 1));
+      //
+      // 2- propagated position, on the plane parallel to the origin plane
+      const double pinv = s.par[4][i];
+      const double x1 = s.pos[0][i] + distance*(px*pinv);
+      const double y1 = s.pos[1][i] + distance*(py*pinv);
+      const double z1 = s.pos[2][i] + distance*(pz*pinv);
+      //
+      // 3- rotation to the target plane (recob::tracking::makePlaneRotation)
+      const double sinA1 = s.plane.sinA[i];
+      const double cosA1 = s.plane.cosA[i];
+      const double sinB1 = s.plane.sinB[i];
+      const double cosB1 = s.plane.cosB[i];
+      const double sinA2 = t.plane.sinA[k];
+      const double cosA2 = t.plane.cosA[k];
+      const double sinB2 = t.plane.sinB[k];
+      const double cosB2 = t.plane.cosB[k];
+      const double sindB = -sinB1*cosB2 + cosB1*sinB2;
+      const double cosdB = cosB1*cosB2 + sinB1*sinB2;
+      const double ruu = cosA1*cosA2 + sinA1*sinA2*cosdB;
+      const double ruv = sinA2*sindB;
+      const double ruw = sinA1*cosA2 - cosA1*sinA2*cosdB;
+      const double rvu = -sinA1*sindB;
+      const double rvv = cosdB;
+      const double rvw = cosA1*sindB;
+      const double rwu = cosA1*sinA2 - sinA1*cosA2*cosdB;
+      const double rwv = -cosA2*sindB;
+      const double rww = sinA1*sinA2 + cosA1*cosA2*cosdB;
+      const double dudw1 = s.par[2][i];
+      const double dvdw1 = s.par[3][i];
+      const double dw2dw1 = dudw1*rwu + dvdw1*rwv + rww;
+      ok = ok && dw2dw1 != 0.;
+      const double dudw2 = (dudw1*ruu + dvdw1*ruv + ruw) / dw2dw1;
+      const double dvdw2 = (dudw1*rvu + dvdw1*rvv + rvw) / dw2dw1;
+      //
+      // 4- covariance: rotation, then straight line (du2/d(dudw1) = dv2/d(dvdw1) = sperp), in the same order as the scalar code
+      const double r00 = ruu - dudw2*rwu;
+      const double r10 = rvu - dvdw2*rwu;
+      const double r01 = ruv - dudw2*rwv;
+      const double r11 = rvv - dvdw2*rwv;
+      const double rot[5][5] = {
+	{ r00, r01, 0.,         0.,         0. },
+	{ r10, r11, 0.,         0.,         0. },
+	{ 0.,  0.,  r00/dw2dw1, r01/dw2dw1, 0. },
+	{ 0.,  0.,  r10/dw2dw1, r11/dw2dw1, 0. },
+	{ 0.,  0.,  0.,         0.,         1. }
+      };
+      const double line[5][5] = {
+	{ 1., 0., sperp, 0.,    0. },
+	{ 0., 1., 0.,    sperp, 0. },
+	{ 0., 0., 1.,    0.,    0. },
+	{ 0., 0., 0.,    1.,    0. },
+	{ 0., 0., 0.,    0.,    1. }
+      };
+      double cov0[15], cov1[15], cov[15];
+      for (unsigned int a = 0; a < 15; ++a) cov0[a] = s.cov[a][i];
+      similarity(rot, cov0, cov1);
+      similarity(line, cov1, cov);
+      //
+      // 5- parameters on the target plane, which becomes the plane of the state
+      const double dx = x1 - tx;
+      const double dy = y1 - ty;
+      const double dz = z1 - tz;
+      const double par[5] = { dx*cosA2 + dy*sinA2*sinB2 - dz*sinA2*cosB2, dy*cosB2 + dz*sinB2, dudw2, dvdw2, pinv };
+      double pos[3], mom[3];
+      localToGlobal(par, sinA2, cosA2, sinB2, cosB2, tx, ty, tz, px*tdx + py*tdy + pz*tdz > 0., pos, mom);
+      //
+      for (unsigned int a = 0; a < 4; ++a)  s.par[a][i] = ok ? par[a] : s.par[a][i];
+      for (unsigned int a = 0; a < 15; ++a) s.cov[a][i] = ok ? cov[a] : s.cov[a][i];
+      for (unsigned int a = 0; a < 3; ++a)  s.pos[a][i] = ok ? pos[a] : s.pos[a][i];
+      for (unsigned int a = 0; a < 3; ++a)  s.mom[a][i] = ok ? mom[a] : s.mom[a][i];
+      s.plane.x[i]    = ok ? tx    : s.plane.x[i];
+      s.plane.y[i]    = ok ? ty    : s.plane.y[i];
+      s.plane.z[i]    = ok ? tz    : s.plane.z[i];
+      s.plane.dirX[i] = ok ? tdx   : s.plane.dirX[i];
+      s.plane.dirY[i] = ok ? tdy   : s.plane.dirY[i];
+      s.plane.dirZ[i] = ok ? tdz   : s.plane.dirZ[i];
+      s.plane.sinA[i] = ok ? sinA2 : s.plane.sinA[i];
+      s.plane.cosA[i] = ok ? cosA2 : s.plane.cosA[i];
+      s.plane.sinB[i] = ok ? sinB2 : s.plane.sinB[i];
+      s.plane.cosB[i] = ok ? cosB2 : s.plane.cosB[i];
+      return ok;
+    }
+
+    /// Kalman update of state i with hit i (KFTrackState::updateWithHitState).
+    /// Returns false if the hit is not on the plane of the state, or if active is false; then the state is not modified.
+    /// As for propagateStraight, the result is stored or not with no branch.
+    TRKF_HOST_DEVICE inline bool updateWithHit(StateArrays const& s, HitArrays const& h, std::size_t i, bool active = true) {
+      const double ddx = h.plane.x[i] - s.plane.x[i];
+      const double ddy = h.plane.y[i] - s.plane.y[i];
+      const double ddz = h.plane.z[i] - s.plane.z[i];
+      const double ddirx = h.plane.dirX[i] - s.plane.dirX[i];
+      const double ddiry = h.plane.dirY[i] - s.plane.dirY[i];
+      const double ddirz = h.plane.dirZ[i] - s.plane.dirZ[i];
+      const bool ok = active && !(ddx*ddx + ddy*ddy + ddz*ddz > 10e-6) && !(ddirx*ddirx + ddiry*ddiry + ddirz*ddirz > 10e-6);
+      //
+      const bool along = s.mom[0][i]*s.plane.dirX[i] + s.mom[1][i]*s.plane.dirY[i] + s.mom[2][i]*s.plane.dirZ[i] > 0.;
+      double col[5];
+      for (unsigned int a = 0; a < 5; ++a) col[a] = s.cov[symIndex(a,0)][i];
+      const double weight = 1./(h.err2[i] + col[0]);
+      const double gain = weight*(h.meas[i] - s.par[0][i]);
+      for (unsigned int a = 0; a < 5; ++a) {
+	for (unsigned int b = 0; b <= a; ++b) {
+	  const double c = s.cov[symIndex(a,b)][i];
+	  s.cov[symIndex(a,b)][i] = ok ? c - weight*col[a]*col[b] : c;
+	}
+      }
+      double par[5];
+      for (unsigned int a = 0; a < 5; ++a) par[a] = s.par[a][i] + col[a]*gain;
+      double pos[3], mom[3];
+      localToGlobal(par, s.plane.sinA[i], s.plane.cosA[i], s.plane.sinB[i], s.plane.cosB[i],
+		    s.plane.x[i], s.plane.y[i], s.plane.z[i], along, pos, mom);
+      for (unsigned int a = 0; a < 5; ++a) s.par[a][i] = ok ? par[a] : s.par[a][i];
+      for (unsigned int a = 0; a < 3; ++a) s.pos[a][i] = ok ? pos[a] : s.pos[a][i];
+      for (unsigned int a = 0; a < 3; ++a) s.mom[a][i] = ok ? mom[a] : s.mom[a][i];
+      return ok;
+    }
+
+#ifdef LARDATA_CUDA
+    namespace details {
+      //@{
+      /// Run the kernels on the n states on the GPU (TrackStateBatchKernels.cu); false, with the states untouched, on any device error.
+      /// Only the states with nonzero select (all, if null) are processed, and their success flag set.
+      bool propagateStraightOnDevice(StateArrays const& s, TargetArrays const& t, std::size_t nTargets, std::size_t n,
+				     int dir, double tolerance, const char* select, char* success);
+      bool updateWithHitsOnDevice(StateArrays const& s, HitArrays const& h, std::size_t n, const char* select, char* success);
+      //@}
+    }
+#endif
+
+  }
+
+}
+
+#endif
@@ -1,4 +1,8 @@
 #include "lardata/RecoObjects/TrackStatePropagator.h"
+#include "lardata/RecoObjects/TrackStateBatch.h"
+#include "lardata/RecoObjects/DedxTable.h"
+#include "lardata/RecoObjects/DedxStepper.h"
+#include "lardata/RecoObjects/TrackingPlaneHelper.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
 
@@ -6,20 +10,49 @@ using namespace recob::tracking;
 
 namespace trkf {
 
-  TrackStatePropagator::TrackStatePropagator(double minStep, double maxElossFrac, int maxNit, double tcut, double wrongDirDistTolerance, bool propPinvErr) :
+  TrackStatePropagator::TrackStatePropagator(double minStep, double maxElossFrac, int maxNit, double tcut, double wrongDirDistTolerance, bool propPinvErr, double fastPathMinP, bool useDedxTable, double dedxTolerance) :
     fMinStep(minStep),
     fMaxElossFrac(maxElossFrac),
     fMaxNit(maxNit),
     fTcut(tcut),
     fWrongDirDistTolerance(wrongDirDistTolerance),
-    fPropPinvErr(propPinvErr)
+    fPropPinvErr(propPinvErr),
+    fFastPathMinP(fastPathMinP),
+    fUseDedxTable(useDedxTable),
+    fDedxTolerance(dedxTolerance)
   {
     detprop = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->provider();
     larprop = lar::providerFrom<detinfo::LArPropertiesService>();
   }
 
+  TrackStatePropagator::TrackStatePropagator(const detinfo::DetectorProperties* detprop, const detinfo::LArProperties* larprop,
+					     double minStep, double maxElossFrac, int maxNit, double tcut, double wrongDirDistTolerance, bool propPinvErr,
+					     double fastPathMinP, bool useDedxTable, double dedxTolerance) :
+    fMinStep(minStep),
+    fMaxElossFrac(maxElossFrac),
+    fMaxNit(maxNit),
+    fTcut(tcut),
+    fWrongDirDistTolerance(wrongDirDistTolerance),
+    fPropPinvErr(propPinvErr),
+    fFastPathMinP(fastPathMinP),
+    fUseDedxTable(useDedxTable),
+    fDedxTolerance(dedxTolerance),
+    detprop(detprop),
+    larprop(larprop)
+  {}
+
   TrackStatePropagator::~TrackStatePropagator() {}
 
+  double TrackStatePropagator::eloss(double p, double mass) const {
+    if (fUseDedxTable) return DedxTable::get(detprop, mass, fTcut)->Eloss(p);
+    return detprop->Eloss(p, mass, fTcut);
+  }
+
+  double TrackStatePropagator::elossVar(double p, double mass) const {
+    if (fUseDedxTable) return DedxTable::get(detprop, mass, fTcut)->ElossVar(p);
+    return detprop->ElossVar(p, mass);
+  }
+
   using PropDirection = TrackStatePropagator::PropDirection;
 
   TrackState TrackStatePropagator::propagateToPlane(bool& success, const TrackState& origin, const Plane& target, bool dodedx, bool domcs, PropDirection dir) const {
@@ -50,31 +83,54 @@ namespace trkf {
     pm(0,2) = sperp;   // du2/d(dudw1);
     pm(1,3) = sperp;   // dv2/d(dvdw1);
     //
-    // 5- apply material effects, performing more iterations if the distance is long
-    bool arrived = false;
-    int nit = 0;         // Iteration count.
+    // 5a- straight line fast path: no material effects requested, infinite momentum,
+    // or momentum above threshold; the result is the line-plane intersection above
+    if ((!dodedx && !domcs) || par5d[4]==0. ||
+	(fFastPathMinP>=0. && std::abs(1./par5d[4])>fFastPathMinP)) {
+      ++fCounters.fast;
+      cov5d = ROOT::Math::Similarity(pm,cov5d);
+      return TrackState(par5d, cov5d, target, origin.momentum().Dot(target.direction())>0, origin.pID());
+    }
+    ++fCounters.iterative;
+    //
+    // 5b- apply material effects, performing more iterations if the distance is long
     double deriv = 1.;
     SMatrixSym55 noise_matrix;
+    if (!applyMaterialEffects(origin, distance, dw2dw1, dodedx, domcs, par5d, deriv, noise_matrix)) {
+      success = false;
+      return origin;
+    }
+    if (fPropPinvErr) pm(4,4)*=deriv;
+    //
+    // 6- create final track state
+    cov5d = ROOT::Math::Similarity(pm,cov5d);//*rj
+    cov5d = cov5d+noise_matrix;
+    TrackState trackState(par5d, cov5d, target, origin.momentum().Dot(target.direction())>0, origin.pID());
+    return trackState;
+  }
+
+  bool TrackStatePropagator::applyMaterialEffects(const TrackState& origin, double distance, double dw2dw1, bool dodedx, bool domcs,
+						  SVector5& par5d, double& deriv, SMatrixSym55& noise_matrix) const {
+    bool arrived = false;
+    int nit = 0;         // Iteration count.
     while (!arrived) {
       ++nit;
-      if(nit > fMaxNit) {
-	success = false;
-	return origin;
-      }
+      ++fCounters.steps;
+      if(nit > fMaxNit) return false;
       // Estimate maximum step distance, such that fMaxElossFrac of initial energy is lost by dedx
       const double mass = origin.mass();
       const double p = 1./par5d[4];
       const double e = std::hypot(p, mass);
       const double t = e - mass;
-      const double dedx = 0.001 * detprop->Eloss(std::abs(p), mass, fTcut);
+      const double dedx = 0.001 * eloss(std::abs(p), mass);
       const double range = t / dedx;
-      const double smax = std::max(fMinStep,fMaxElossFrac*range);
+      const double smax = std::max(fMinStep, fDedxTolerance > 0. ?
+				   std::min(0.5*range, dedxStepLength([&](double pp){ return 0.001 * eloss(pp, mass); },
+								      e, mass, fDedxTolerance, fMaxElossFrac*range)) :
+				   fMaxElossFrac*range);
       double s = distance;
       if (domcs && smax>0 && std::abs(s)>smax) {
-	if (fMaxNit==1) {
-	  success = false;
-	  return origin;
-	}
+	if (fMaxNit==1) return false;
 	s = (s>0 ? smax : -smax);
 	distance-=s;
       } else arrived = true;
@@ -84,55 +140,135 @@ namespace trkf {
 	if (origin.isTrackAlongPlaneDir()==true && dw2dw1<0.) flip = true;
 	if (origin.isTrackAlongPlaneDir()==false && dw2dw1>0.) flip = true;
 	bool ok = apply_mcs(par5d[2], par5d[3], par5d[4], origin.mass(), s, range, p, e*e, flip, noise_matrix);
-	if(!ok) {
-	  success = false;
-	  return origin;
-	}
+	if(!ok) return false;
       }
       if(dodedx) {
 	apply_dedx(par5d(4), dedx, e, origin.mass(), s, deriv);
       }
     }
-    if (fPropPinvErr) pm(4,4)*=deriv;
+    return true;
+  }
+
+  std::vector<TrackState> TrackStatePropagator::propagateToPlane(std::vector<bool>& success, const std::vector<TrackState>& origins, const Plane& target, bool dodedx, bool domcs, PropDirection dir) const {
+    success.assign(origins.size(), false);
+    std::vector<TrackState> result(origins);
+    if (origins.empty()) return result;
     //
-    // 6- create final track state
-    cov5d = ROOT::Math::Similarity(pm,cov5d);//*rj
-    cov5d = cov5d+noise_matrix;
-    TrackState trackState(par5d, cov5d, target, origin.momentum().Dot(target.direction())>0, origin.pID());
-    return trackState;
+    // 1- find distance to target plane, for the reference hypothesis
+    const TrackState& ref = origins.front();
+    bool ok = false;
+    std::pair<double, double> distpair = distancePairToPlane(ok, ref, target);
+    const double distance = distpair.first;
+    const double sperp    = distpair.second;
+    if (!ok) return result;
+    if ((distance<-fWrongDirDistTolerance && dir==FORWARD) || (distance>fWrongDirDistTolerance && dir==BACKWARD)) return result;
+    //
+    // 2- propagate 3d position by distance, form propagated state on plane parallel to origin plane
+    Point_t p = propagatedPosByDistance(ref.position(), ref.momentum()*ref.parameters()[4], distance);
+    TrackState tmpState(SVector5(0.,0.,ref.parameters()[2],ref.parameters()[3],ref.parameters()[4]), ref.covariance(),
+			Plane(p,ref.plane().direction()), ref.isTrackAlongPlaneDir(), ref.pID());
+    //
+    // 3- rotate reference state to target plane, and combine the rotation and straight line jacobians
+    double dw2dw1 = 0;
+    SVector5 refPar5d;
+    SMatrix55 rot;
+    if (!rotationToPlane(tmpState, target, refPar5d, rot, dw2dw1)) return result;
+    SMatrix55 pm = ROOT::Math::SMatrixIdentity();
+    pm(0,2) = sperp;   // du2/d(dudw1);
+    pm(1,3) = sperp;   // dv2/d(dvdw1);
+    const SMatrix55 jacobian = pm*rot;
+    //
+    // 4- each hypothesis: parameters to first order in the difference from the reference, then mass dependent terms
+    for (size_t i = 0; i < origins.size(); ++i) {
+      const TrackState& origin = origins[i];
+      if ( i != 0 &&
+	   ( (origin.plane().position()-ref.plane().position()).Mag2()>10e-6 ||
+	     (origin.plane().direction()-ref.plane().direction()).Mag2()>10e-6 ) ) {
+	// not on the plane of the reference: full propagation
+	bool oneSuccess = false;
+	result[i] = propagateToPlane(oneSuccess, origin, target, dodedx, domcs, dir);
+	success[i] = oneSuccess;
+	continue;
+      }
+      SVector5 par5d = refPar5d + jacobian*(origin.parameters()-ref.parameters());
+      SMatrix55 hypJacobian = jacobian;
+      SMatrixSym55 noise_matrix;
+      if ((!dodedx && !domcs) || par5d[4]==0. ||
+	  (fFastPathMinP>=0. && std::abs(1./par5d[4])>fFastPathMinP)) {
+	++fCounters.fast;
+      }
+      else {
+	++fCounters.iterative;
+	double deriv = 1.;
+	if (!applyMaterialEffects(origin, distance, dw2dw1, dodedx, domcs, par5d, deriv, noise_matrix)) continue;
+	if (fPropPinvErr) hypJacobian(4,4)*=deriv;
+      }
+      SMatrixSym55 cov5d = ROOT::Math::Similarity(hypJacobian,origin.covariance())+noise_matrix;
+      result[i] = TrackState(par5d, cov5d, target, origin.momentum().Dot(target.direction())>0, origin.pID());
+      success[i] = true;
+    }
+    return result;
+  }
+
+  void TrackStatePropagator::propagateToPlane(std::vector<char>& success, TrackStateBatch& states, const PlaneBatch& targets, bool dodedx, bool domcs, PropDirection dir, bool useDevice) const {
+    //
+    // 1- select the states taking the fast path; the rotation leaves 1/p unchanged, so the decision can be taken at the origin
+    const std::size_t n = states.size();
+    std::vector<char> fast(n, false);
+    for (size_t i = 0; i < n; ++i) {
+      const double pinv = states.parameter(i, 4);
+      fast[i] = ((!dodedx && !domcs) || pinv==0. || (fFastPathMinP>=0. && std::abs(1./pinv)>fFastPathMinP));
+    }
+    //
+    // 2- propagate them together
+    propagateStraightToPlanes(success, states, targets, fWrongDirDistTolerance, dir, fast, useDevice);
+    //
+    // 3- the others one by one, with material effects
+    for (size_t i = 0; i < n; ++i) {
+      if (fast[i]) {
+	if (success[i]) ++fCounters.fast;
+	continue;
+      }
+      bool ok = false;
+      const Plane target = targets.plane(targets.size()==1 ? 0 : i);
+      const TrackState result = propagateToPlane(ok, states.state(i), target, dodedx, domcs, dir);
+      if (ok) states.set(i, result);
+      success[i] = ok;
+    }
   }
 
   TrackState TrackStatePropagator::rotateToPlane(bool& success, const TrackState& origin, const Plane& target, double& dw2dw1) const {
     const bool isTrackAlongPlaneDir = origin.momentum().Dot(target.direction())>0;
     //
-    SVector5 par5 = origin.parameters();
-    const double sinA1 = origin.plane().sinAlpha();
-    const double cosA1 = origin.plane().cosAlpha();
+    SVector5 par5;
+    SMatrix55 pm;
+    success = rotationToPlane(origin, target, par5, pm, dw2dw1);
+    if (!success) return origin;
+    return TrackState(par5,ROOT::Math::Similarity(pm,origin.covariance()),Plane(origin.position(),target.direction()),isTrackAlongPlaneDir,origin.pID());
+  }
+
+  bool TrackStatePropagator::rotationToPlane(const TrackState& origin, const Plane& target, SVector5& par5, SMatrix55& pm, double& dw2dw1) const {
+    par5 = origin.parameters();
+    // the rotation between two plane directions is the same for all the propagations between them
+    thread_local PlaneRotationCache rotations;
+    const PlaneRotation& rot = rotations.rotation(origin.plane(), target);
+    const double ruu = rot.ruu;
+    const double ruv = rot.ruv;
+    const double ruw = rot.ruw;
+    const double rvu = rot.rvu;
+    const double rvv = rot.rvv;
+    const double rvw = rot.rvw;
+    const double rwu = rot.rwu;
+    const double rwv = rot.rwv;
+    const double rww = rot.rww;
     const double sinA2 = target.sinAlpha();
     const double cosA2 = target.cosAlpha();
-    const double sinB1 = origin.plane().sinBeta();
-    const double cosB1 = origin.plane().cosBeta();
     const double sinB2 = target.sinBeta();
     const double cosB2 = target.cosBeta();
-    const double sindB = -sinB1*cosB2 + cosB1*sinB2;
-    const double cosdB = cosB1*cosB2 + sinB1*sinB2;
-    const double ruu = cosA1*cosA2 + sinA1*sinA2*cosdB;
-    const double ruv = sinA2*sindB;
-    const double ruw = sinA1*cosA2 - cosA1*sinA2*cosdB;
-    const double rvu = -sinA1*sindB;
-    const double rvv = cosdB;
-    const double rvw = cosA1*sindB;
-    const double rwu = cosA1*sinA2 - sinA1*cosA2*cosdB;
-    const double rwv = -cosA2*sindB;
-    const double rww = sinA1*sinA2 + cosA1*cosA2*cosdB;
     dw2dw1 = par5[2]*rwu + par5[3]*rwv + rww;
-    if(dw2dw1 == 0.) {
-      success = false;
-      return origin;
-    }
+    if(dw2dw1 == 0.) return false;
     const double dudw2 = (par5[2]*ruu + par5[3]*ruv + ruw) / dw2dw1;
     const double dvdw2 = (par5[2]*rvu + par5[3]*rvv + rvw) / dw2dw1;
-    SMatrix55 pm;
     //
     pm(0,0) = ruu - dudw2*rwu;    // du2/du1
     pm(1,0) = rvu - dvdw2*rwu;    // dv2/du1
@@ -169,8 +305,7 @@ namespace trkf {
     par5[2] = dudw2;
     par5[3] = dvdw2;
     //
-    success = true;
-    return TrackState(par5,ROOT::Math::Similarity(pm,origin.covariance()),Plane(origin.position(),target.direction()),isTrackAlongPlaneDir,origin.pID());
+    return true;
   }
 
   double TrackStatePropagator::distanceToPlane(bool& success, const Point_t& origpos, const Vector_t& origmom, const Plane& target) const {
@@ -217,10 +352,21 @@ namespace trkf {
     // For infinite initial momentum, return with infinite momentum.
     if (pinv == 0.) return;
     //
+    if (fDedxTolerance > 0.) {
+      double e2 = 0.;
+      if (integrateDedx([&](double p){ return 0.001 * eloss(p, mass); }, e1, mass, s, fDedxTolerance, e2, fCounters.dedxSteps)) {
+	double pinv2 = 1./std::sqrt(e2*e2 - mass*mass);
+	if(pinv < 0.) pinv2 = -pinv2;
+	deriv = pinv2*pinv2*pinv2 * e2 / (pinv*pinv*pinv * e1);
+	pinv = pinv2;
+      }
+      return;
+    }
+    ++fCounters.dedxSteps;
     const double emid = e1 - 0.5 * s * dedx;
     if(emid > mass) {
       const double pmid = std::sqrt(emid*emid - mass*mass);
-      const double e2 = e1 - 0.001 * s * detprop->Eloss(pmid, mass, fTcut);
+      const double e2 = e1 - 0.001 * s * eloss(pmid, mass);
       if(e2 > mass) {
 	const double p2 = std::sqrt(e2*e2 - mass*mass);
 	double pinv2 = 1./p2;
@@ -266,8 +412,8 @@ namespace trkf {
 
     // Calculate energy loss fluctuations.
 
-    const double evar = 1.e-6 * detprop->ElossVar(p, mass) * std::abs(s); // E variance (GeV^2).
-    const double pinvvar = evar * e2 / (p2*p2*p2);                        // Inv. p variance (1/GeV^2)
+    const double evar = 1.e-6 * elossVar(p, mass) * std::abs(s); // E variance (GeV^2).
+    const double pinvvar = evar * e2 / (p2*p2*p2);                // Inv. p variance (1/GeV^2)
 
     // Update elements of noise matrix.
 
@@ -8,6 +8,7 @@
 #include "fhiclcpp/types/Table.h"
 
 #include <utility>
+#include <vector>
 
 namespace detinfo {
   class DetectorProperties;
@@ -16,6 +17,9 @@ namespace detinfo {
 
 namespace trkf {
 
+  class TrackStateBatch;
+  class PlaneBatch;
+
   /// \class TrackStatePropagator
   ///
   /// \brief Class for propagation of a trkf::TrackState to a recob::tracking::Plane
@@ -32,6 +36,31 @@ namespace trkf {
   /// While the propagated position can be directly computed, accounting for the material effects
   /// in the covariance matrix requires an iterative procedure in case of long propagations distances.
   ///
+  /// When no material effects are requested (dodedx and domcs both false), or the momentum is infinite
+  /// or above the fastPathMinP threshold, the propagation is a line-plane intersection and its
+  /// Jacobian only, with no iteration (fast path). The number of propagations taken by each path is
+  /// counted (see pathCounters()), to help tuning the threshold.
+  ///
+  /// The rotations between the local frames of pairs of plane directions are computed once per thread and reused
+  /// (see recob::tracking::PlaneRotationCache), since the fits only go through a few plane orientations.
+  ///
+  /// Several mass hypotheses of the same track can be propagated together (see the overload of propagateToPlane
+  /// taking a vector of states): the distance, the propagated position and the rotation are computed once, from
+  /// the first state, and the parameters of the other hypotheses are propagated to first order in their difference
+  /// from it; only the material effects, which depend on the mass, are computed for each hypothesis.
+  ///
+  /// The stopping power and energy loss variance are interpolated from tables (trkf::DedxTable) built once
+  /// per particle mass, unless useDedxTable is false, in which case the exact formulas are evaluated at each step.
+  ///
+  /// With a positive dedxTolerance, the energy loss is integrated with step length control instead of one midpoint
+  /// step per propagation step (see DedxStepper.h), and the maximum step length with multiple scattering is the one
+  /// meeting the tolerance instead of the maxElossFrac rule. The integration steps are counted in pathCounters().
+  ///
+  /// Many tracks can be propagated at once, each to its own plane, with the states in structure-of-arrays layout
+  /// (see TrackStateBatch.h and the overload of propagateToPlane taking a TrackStateBatch): the tracks taking the
+  /// fast path are processed in bulk by a kernel that runs as a loop over the arrays on the CPU, or on a GPU, and the
+  /// others are propagated one by one, as usual.
+  ///
   /// For configuration options see TrackStatePropagator#Config
   ///
 
@@ -77,17 +106,45 @@ namespace trkf {
 	Comment("Propagate error on 1/p or not (in order to avoid infs, it should be set to false when 1/p not updated)."),
 	false
        };
+      fhicl::Atom<double> fastPathMinP {
+	Name("fastPathMinP"),
+	Comment("Momentum (GeV) above which material effects are neglected and the straight-line propagation is used (negative: never)."),
+	-1.
+       };
+      fhicl::Atom<bool> useDedxTable {
+	Name("useDedxTable"),
+	Comment("Interpolate energy loss and its variance from tables (false: evaluate the exact formulas)."),
+	true
+       };
+      fhicl::Atom<double> dedxTolerance {
+	Name("dedxTolerance"),
+	Comment("Relative tolerance on the kinetic energy for the error-controlled integration of the energy loss (0: fixed step rules)."),
+	0.
+       };
     };
     using Parameters = fhicl::Table<Config>;
 
     /// Propagation direction enum.
     enum PropDirection {FORWARD=0, BACKWARD=1, UNKNOWN=2};
 
+    /// Number of calls to propagateToPlane by path taken.
+    struct PathCounters {
+      unsigned long fast = 0;       ///< Straight line, no material effects.
+      unsigned long iterative = 0;  ///< Stepping with material effects.
+      unsigned long steps = 0;      ///< Total number of steps of the iterative path.
+      unsigned long dedxSteps = 0;  ///< Total number of energy loss integration steps.
+    };
+
     /// Constructor from parameter values.
-    TrackStatePropagator(double minStep, double maxElossFrac, int maxNit, double tcut, double wrongDirDistTolerance, bool propPinvErr);
+    TrackStatePropagator(double minStep, double maxElossFrac, int maxNit, double tcut, double wrongDirDistTolerance, bool propPinvErr, double fastPathMinP = -1., bool useDedxTable = true, double dedxTolerance = 0.);
+
+    /// Constructor from parameter values and detector property providers, which are used only for the material effects.
+    TrackStatePropagator(const detinfo::DetectorProperties* detprop, const detinfo::LArProperties* larprop,
+			 double minStep, double maxElossFrac, int maxNit, double tcut, double wrongDirDistTolerance, bool propPinvErr,
+			 double fastPathMinP = -1., bool useDedxTable = true, double dedxTolerance = 0.);
 
     /// Constructor from Parameters (fhicl::Table<Config>).
-    explicit TrackStatePropagator(Parameters const & p) : TrackStatePropagator(p().minStep(),p().maxElossFrac(),p().maxNit(),p().tcut(),p().wrongDirDistTolerance(),p().propPinvErr()) {}
+    explicit TrackStatePropagator(Parameters const & p) : TrackStatePropagator(p().minStep(),p().maxElossFrac(),p().maxNit(),p().tcut(),p().wrongDirDistTolerance(),p().propPinvErr(),p().fastPathMinP(),p().useDedxTable(),p().dedxTolerance()) {}
 
     /// Destructor.
     virtual ~TrackStatePropagator();
@@ -95,6 +152,17 @@ namespace trkf {
     /// Main function for propagation of a TrackState to a Plane
     TrackState propagateToPlane(bool& success, const TrackState& origin, const Plane& target, bool dodedx, bool domcs, PropDirection dir = FORWARD) const;
 
+    /// Propagation of several mass hypotheses of the same track to a Plane, sharing the geometry of the first one.
+    /// States which are not on the plane of the first one are propagated independently.
+    /// On failure, the corresponding entry of success is false and the origin state is returned.
+    std::vector<TrackState> propagateToPlane(std::vector<bool>& success, const std::vector<TrackState>& origins, const Plane& target, bool dodedx, bool domcs, PropDirection dir = FORWARD) const;
+
+    /// Propagation in place of a batch of states, each to the corresponding target plane (or all to the only one).
+    /// The states taking the fast path are propagated together by a kernel (on a GPU if useDevice is set and lardata
+    /// is built with CUDA), with the same results as the main function; the others are propagated one by one.
+    /// On failure, the corresponding entry of success is false and the state is not modified.
+    void propagateToPlane(std::vector<char>& success, TrackStateBatch& states, const PlaneBatch& targets, bool dodedx, bool domcs, PropDirection dir = FORWARD, bool useDevice = false) const;
+
     /// Rotation of a TrackState to a Plane (zero distance propagation)
     inline TrackState rotateToPlane(bool& success, const TrackState& origin, const Plane& target) const { double dw2dw1 = 0.; return rotateToPlane(success, origin, target, dw2dw1);}
 
@@ -134,17 +202,49 @@ namespace trkf {
     /// get Tcut parameter used in DetectorPropertiesService Eloss method
     double getTcut() const {return fTcut;}
 
+    /// get momentum threshold of the straight-line fast path (negative if disabled)
+    double getFastPathMinP() const {return fFastPathMinP;}
+
+    /// get whether energy loss is interpolated from tables
+    bool getUseDedxTable() const {return fUseDedxTable;}
+
+    /// get relative tolerance of the energy loss integration (0 if fixed step rules)
+    double getDedxTolerance() const {return fDedxTolerance;}
+
+    //@{
+    /// Counters of the propagation paths taken (not thread safe)
+    const PathCounters& pathCounters() const {return fCounters;}
+    void resetPathCounters() const {fCounters = PathCounters();}
+    //@}
+
   private:
 
     /// Rotation of a TrackState to a Plane (zero distance propagation), keeping track of dw2dw1 (needed by mcs)
     TrackState rotateToPlane(bool& success, const TrackState& origin, const Plane& target, double& dw2dw1) const;
 
+    /// Parameters rotated to the target Plane and jacobian of the rotation; false if the track is parallel to the plane
+    bool rotationToPlane(const TrackState& origin, const Plane& target, SVector5& par5, SMatrix55& pm, double& dw2dw1) const;
+
+    /// Energy loss and multiple scattering along distance, in steps; false if the maximum number of iterations is exceeded
+    bool applyMaterialEffects(const TrackState& origin, double distance, double dw2dw1, bool dodedx, bool domcs,
+			      SVector5& par5d, double& deriv, SMatrixSym55& noise_matrix) const;
+
+    //@{
+    /// Stopping power (MeV/cm) and energy loss variance (MeV^2/cm), from table or exact formula
+    double eloss(double p, double mass) const;
+    double elossVar(double p, double mass) const;
+    //@}
+
     double fMinStep;               ///< Minimum propagation step length guaranteed.
     double fMaxElossFrac;          ///< Maximum propagation step length based on fraction of energy loss.
     int    fMaxNit;                ///< Maximum number of iterations.
     double fTcut;                  ///< Maximum delta ray energy for dE/dx.
     double fWrongDirDistTolerance; ///< Allowed propagation distance in the wrong direction.
     bool   fPropPinvErr;           ///< Propagate error on 1/p or not (in order to avoid infs, it should be set to false when 1/p not updated)
+    double fFastPathMinP;          ///< Momentum above which the straight-line fast path is used (negative: never).
+    bool   fUseDedxTable;          ///< Interpolate energy loss from tables.
+    double fDedxTolerance;         ///< Energy loss tolerance (0: fixed step rules).
+    mutable PathCounters fCounters; ///< Number of propagations by path.
     const detinfo::DetectorProperties* detprop;
     const detinfo::LArProperties* larprop;
   };
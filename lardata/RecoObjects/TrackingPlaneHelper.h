@@ -6,6 +6,7 @@
 #include "lardata/RecoObjects/SurfWireX.h"
 #include "larcorealg/Geometry/WireGeo.h"
 #include "TMath.h"
+#include <algorithm>
 
 namespace recob {
   namespace tracking {
@@ -33,6 +34,77 @@ namespace recob {
       return Plane(Point_t(0.,xyz[1], xyz[2]), Vector_t(0,-std::sin(phi),std::cos(phi)));
     }
 
+    /// Rotation from the local (u,v,w) frame of a plane to the one of another plane: (u2,v2,w2) = R (u1,v1,w1).
+    /// It only depends on the directions of the two planes.
+    struct PlaneRotation {
+      double ruu, ruv, ruw; ///< first row (u2)
+      double rvu, rvv, rvw; ///< second row (v2)
+      double rwu, rwv, rww; ///< third row (w2)
+    };
+
+    /// helper function to compute the rotation from the local frame of plane "from" to the one of plane "to".
+    inline PlaneRotation makePlaneRotation(Plane const& from, Plane const& to) {
+      const double sinA1 = from.sinAlpha();
+      const double cosA1 = from.cosAlpha();
+      const double sinA2 = to.sinAlpha();
+      const double cosA2 = to.cosAlpha();
+      const double sinB1 = from.sinBeta();
+      const double cosB1 = from.cosBeta();
+      const double sinB2 = to.sinBeta();
+      const double cosB2 = to.cosBeta();
+      const double sindB = -sinB1*cosB2 + cosB1*sinB2;
+      const double cosdB = cosB1*cosB2 + sinB1*sinB2;
+      return PlaneRotation{
+	cosA1*cosA2 + sinA1*sinA2*cosdB, sinA2*sindB, sinA1*cosA2 - cosA1*sinA2*cosdB,
+	-sinA1*sindB, cosdB, cosA1*sindB,
+	cosA1*sinA2 - sinA1*cosA2*cosdB, -cosA2*sindB, sinA1*sinA2 + cosA1*cosA2*cosdB
+      };
+    }
+
+    /// \class PlaneRotationCache
+    ///
+    /// \brief Small cache of the rotations between pairs of plane directions.
+    ///
+    /// The wire planes are fixed for the job, so a fit only propagates between a handful of plane orientations.
+    /// This cache remembers the rotations of the most recently used pairs of directions (compared exactly),
+    /// most recent first, and computes the others with makePlaneRotation.
+    /// It is not protected against concurrent use: use one per thread.
+    ///
+    class PlaneRotationCache {
+    public:
+      /// Maximum number of pairs of directions remembered.
+      static constexpr unsigned int MaxEntries = 16;
+
+      /// Rotation from the local frame of plane "from" to the one of plane "to".
+      const PlaneRotation& rotation(Plane const& from, Plane const& to) {
+	const Vector_t& dir1 = from.direction();
+	const Vector_t& dir2 = to.direction();
+	for (unsigned int i = 0; i < fN; ++i) {
+	  if (fEntries[i].dir1 == dir1 && fEntries[i].dir2 == dir2) {
+	    if (i != 0) std::rotate(fEntries, fEntries + i, fEntries + i + 1);
+	    return fEntries[0].rotation;
+	  }
+	}
+	// not found: the new entry goes first, dropping the least recently used one if full
+	if (fN < MaxEntries) ++fN;
+	std::move_backward(fEntries, fEntries + fN - 1, fEntries + fN);
+	fEntries[0] = Entry{dir1, dir2, makePlaneRotation(from, to)};
+	return fEntries[0].rotation;
+      }
+
+      /// Number of pairs of directions remembered.
+      unsigned int size() const { return fN; }
+
+    private:
+      struct Entry {
+	Vector_t dir1;
+	Vector_t dir2;
+	PlaneRotation rotation;
+      };
+      Entry fEntries[MaxEntries];
+      unsigned int fN = 0;
+    };
+
   }
 }
 
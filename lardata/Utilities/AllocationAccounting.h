@@ -0,0 +1,306 @@
+/**
+ * @file   AllocationAccounting.h
+ * @brief  Optional accounting of the memory allocated by lardata containers
+ * @date   October 14, 2026
+ * @see    AllocationReport.h
+ *
+ * This is a pure header library.
+ *
+ * The accounting is enabled at compile time by defining the preprocessor
+ * macro `LARDATA_ALLOCATION_ACCOUNTING` to a non-zero value (e.g.
+ * `-DLARDATA_ALLOCATION_ACCOUNTING=1`) for the whole build. When it is not
+ * enabled, `lar::TaggedAllocator` is `std::allocator` and the recording
+ * functions do nothing, so that the instrumented containers have no cost.
+ */
+
+#ifndef LARDATA_UTILITIES_ALLOCATIONACCOUNTING_H
+#define LARDATA_UTILITIES_ALLOCATIONACCOUNTING_H 1
+
+// C/C++ standard libraries
+#include <array>
+#include <atomic>
+#include <memory> // std::allocator<>
+#include <mutex>
+#include <string>
+#include <type_traits> // std::conditional_t<>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+#ifndef LARDATA_ALLOCATION_ACCOUNTING
+#  define LARDATA_ALLOCATION_ACCOUNTING 0
+#endif // !LARDATA_ALLOCATION_ACCOUNTING
+
+
+namespace lar {
+
+  /// Memory allocated and freed under one tag
+  struct AllocationCounts_t {
+    std::size_t allocations = 0U; ///< number of allocations
+    std::size_t deallocations = 0U; ///< number of deallocations
+    std::size_t allocatedBytes = 0U; ///< total allocated bytes
+    std::size_t freedBytes = 0U; ///< total freed bytes
+
+    /// Returns the bytes allocated and not freed yet (may be negative)
+    long long bytesInUse() const
+      { return (long long) allocatedBytes - (long long) freedBytes; }
+
+    /// Returns whether there was no allocation nor deallocation
+    bool empty() const { return (allocations == 0U) && (deallocations == 0U); }
+
+    /// Adds the specified counts to these ones
+    AllocationCounts_t& operator+= (AllocationCounts_t const& other)
+      {
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        allocatedBytes += other.allocatedBytes;
+        freedBytes += other.freedBytes;
+        return *this;
+      }
+
+  }; // struct AllocationCounts_t
+
+
+  /**
+   * @brief Registry of the allocations of the instrumented containers
+   *
+   * Each instrumented container is labelled by a _tag_, a type with a static
+   * member `Name` with the name to be reported:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * struct KHitContainerAllocationTag
+   *   { static constexpr char const* Name = "KHitContainer"; };
+   *
+   * std::list<KHitGroup, lar::TaggedAllocator<KHitGroup, KHitContainerAllocationTag>>
+   *   groups;
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The allocations are added to the counters of the tag for the job
+   * (`GetCounts()`) and, if one is set on the allocating thread, to the
+   * current _scope_ (`setScope()`): this is how `lar::AllocationReport`
+   * assigns them to each module and event. Allocations from threads with no
+   * scope (e.g. TBB tasks spawned by a module) are counted only for the job.
+   *
+   * Memory not allocated via an allocator (e.g. the buffers of a data product
+   * whose type can't change) may be accounted explicitly with
+   * `recordAllocation()` and `recordDeallocation()`.
+   *
+   * At most `MaxTags` tags are supported; further tags share the last one.
+   */
+  class AllocationAccounting {
+      public:
+
+    /// Whether the accounting is enabled in this build
+    static constexpr bool Enabled = (LARDATA_ALLOCATION_ACCOUNTING != 0);
+
+    /// Maximum number of distinct tags
+    static constexpr std::size_t MaxTags = 32U;
+
+    /// Counts of all the tags, by tag ID, in a scope
+    struct Scope_t {
+      std::array<AllocationCounts_t, MaxTags> counts; ///< counts by tag ID
+
+      /// Resets all the counts
+      void clear() { counts.fill(AllocationCounts_t{}); }
+    }; // struct Scope_t
+
+    /// Records an allocation of `bytes` under `Tag` (if enabled)
+    template <typename Tag>
+    static void recordAllocation(std::size_t bytes)
+      { if constexpr (Enabled) count(tagID<Tag>(), bytes, true); }
+
+    /// Records a deallocation of `bytes` under `Tag` (if enabled)
+    template <typename Tag>
+    static void recordDeallocation(std::size_t bytes)
+      { if constexpr (Enabled) count(tagID<Tag>(), bytes, false); }
+
+    /// Returns the counts of the job under `Tag`
+    template <typename Tag>
+    static AllocationCounts_t GetCounts() { return GetCounts(tagID<Tag>()); }
+
+    /// Returns the counts of the job under the tag with the specified ID
+    static AllocationCounts_t GetCounts(std::size_t id);
+
+    /// Returns the counts of the job of all the tags seen so far, with names
+    static std::vector<std::pair<std::string, AllocationCounts_t>> GetCounts();
+
+    /// Returns the number of tags seen so far
+    static std::size_t nTags() { return registry().nTags.load(); }
+
+    /// Returns the name of the tag with the specified ID
+    static char const* tagName(std::size_t id) { return registry().names[id]; }
+
+    /// Sets the scope of the allocations of this thread; returns the old one
+    static Scope_t* setScope(Scope_t* scope)
+      {
+        Scope_t* const old = currentScope();
+        currentScope() = scope;
+        return old;
+      }
+
+    /// Records an allocation (`allocation` true) or a deallocation
+    static void count(std::size_t id, std::size_t bytes, bool allocation);
+
+    /// Returns the ID of the specified tag, registering it if needed
+    template <typename Tag>
+    static std::size_t tagID()
+      { static std::size_t const id = registerTag(Tag::Name); return id; }
+
+
+      private:
+
+    /// Job-wide counters of one tag
+    struct AtomicCounts_t {
+      std::atomic<std::size_t> allocations { 0U };
+      std::atomic<std::size_t> deallocations { 0U };
+      std::atomic<std::size_t> allocatedBytes { 0U };
+      std::atomic<std::size_t> freedBytes { 0U };
+    }; // struct AtomicCounts_t
+
+    struct Registry_t {
+      std::atomic<std::size_t> nTags { 0U }; ///< number of registered tags
+      std::array<char const*, MaxTags> names {}; ///< name of each tag
+      std::array<AtomicCounts_t, MaxTags> counts; ///< counters of each tag
+      std::mutex mutex; ///< protects the registration of tags
+    }; // struct Registry_t
+
+    /// Returns the registry of the job
+    static Registry_t& registry() { static Registry_t reg; return reg; }
+
+    /// Returns the scope of this thread
+    static Scope_t*& currentScope()
+      { static thread_local Scope_t* scope = nullptr; return scope; }
+
+    /// Registers a tag with the specified name, and returns its ID
+    static std::size_t registerTag(char const* name);
+
+  }; // class AllocationAccounting
+
+
+  /**
+   * @brief Allocator counting its allocations under a tag
+   * @tparam T type of the allocated objects
+   * @tparam Tag tag of the allocations (see `lar::AllocationAccounting`)
+   *
+   * This allocator uses `std::allocator` and counts all its allocations,
+   * regardless of `LARDATA_ALLOCATION_ACCOUNTING`.
+   * Use `lar::TaggedAllocator` to count only when accounting is enabled.
+   */
+  template <typename T, typename Tag>
+  struct CountingAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = CountingAllocator<U, Tag>; };
+
+    CountingAllocator() noexcept = default;
+    template <typename U>
+    CountingAllocator(CountingAllocator<U, Tag> const&) noexcept {}
+
+    T* allocate(std::size_t n)
+      {
+        T* const p = std::allocator<T>().allocate(n);
+        AllocationAccounting::count
+          (AllocationAccounting::tagID<Tag>(), n * sizeof(T), true);
+        return p;
+      }
+
+    void deallocate(T* p, std::size_t n) noexcept
+      {
+        AllocationAccounting::count
+          (AllocationAccounting::tagID<Tag>(), n * sizeof(T), false);
+        std::allocator<T>().deallocate(p, n);
+      }
+
+    template <typename U>
+    bool operator== (CountingAllocator<U, Tag> const&) const noexcept
+      { return true; }
+    template <typename U>
+    bool operator!= (CountingAllocator<U, Tag> const&) const noexcept
+      { return false; }
+
+  }; // struct CountingAllocator
+
+
+  /// Allocator counting under `Tag` if the accounting is enabled
+  template <typename T, typename Tag>
+  using TaggedAllocator = std::conditional_t<
+    AllocationAccounting::Enabled, CountingAllocator<T, Tag>, std::allocator<T>
+    >;
+
+  /// A `std::vector` with allocations counted under `Tag` when enabled
+  template <typename T, typename Tag>
+  using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline lar::AllocationCounts_t lar::AllocationAccounting::GetCounts
+  (std::size_t id)
+{
+  AtomicCounts_t const& counts = registry().counts[id];
+  AllocationCounts_t result;
+  result.allocations = counts.allocations.load(std::memory_order_relaxed);
+  result.deallocations = counts.deallocations.load(std::memory_order_relaxed);
+  result.allocatedBytes = counts.allocatedBytes.load(std::memory_order_relaxed);
+  result.freedBytes = counts.freedBytes.load(std::memory_order_relaxed);
+  return result;
+} // lar::AllocationAccounting::GetCounts(std::size_t)
+
+
+//------------------------------------------------------------------------------
+inline auto lar::AllocationAccounting::GetCounts()
+  -> std::vector<std::pair<std::string, AllocationCounts_t>>
+{
+  std::vector<std::pair<std::string, AllocationCounts_t>> result;
+  std::size_t const n = nTags();
+  result.reserve(n);
+  for (std::size_t id = 0; id < n; ++id)
+    result.emplace_back(tagName(id), GetCounts(id));
+  return result;
+} // lar::AllocationAccounting::GetCounts()
+
+
+//------------------------------------------------------------------------------
+inline void lar::AllocationAccounting::count
+  (std::size_t id, std::size_t bytes, bool allocation)
+{
+  AtomicCounts_t& counts = registry().counts[id];
+  Scope_t* const scope = currentScope();
+  if (allocation) {
+    counts.allocations.fetch_add(1U, std::memory_order_relaxed);
+    counts.allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (scope) {
+      ++(scope->counts[id].allocations);
+      scope->counts[id].allocatedBytes += bytes;
+    }
+  }
+  else {
+    counts.deallocations.fetch_add(1U, std::memory_order_relaxed);
+    counts.freedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (scope) {
+      ++(scope->counts[id].deallocations);
+      scope->counts[id].freedBytes += bytes;
+    }
+  }
+} // lar::AllocationAccounting::count()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t lar::AllocationAccounting::registerTag(char const* name) {
+  Registry_t& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::size_t const n = reg.nTags.load();
+  if (n == MaxTags) return MaxTags - 1U; // shares the last tag
+  reg.names[n] = (n == MaxTags - 1U)? "(other)": name;
+  reg.nTags.store(n + 1U);
+  return n;
+} // lar::AllocationAccounting::registerTag()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_UTILITIES_ALLOCATIONACCOUNTING_H
@@ -0,0 +1,95 @@
+/**
+ * @file   AllocationReport.h
+ * @brief  _art_ service reporting the allocations of lardata containers
+ * @date   October 14, 2026
+ * @see    AllocationReport_service.cc, AllocationAccounting.h
+ */
+
+#ifndef LARDATA_UTILITIES_ALLOCATIONREPORT_H
+#define LARDATA_UTILITIES_ALLOCATIONREPORT_H 1
+
+// LArSoft libraries
+#include "lardata/Utilities/AllocationAccounting.h"
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <mutex>
+#include <string>
+
+
+namespace art { class Event; }
+
+namespace lar {
+
+  /**
+   * @brief Reports the allocations of the instrumented containers, by module.
+   *
+   * The allocations of the containers using `lar::TaggedAllocator` (see
+   * `lar::AllocationAccounting`) made by each module while processing an
+   * event are assigned to that module. At the end of the job, a summary is
+   * printed on the `mf::LogInfo` stream `AllocationReport`: for each module
+   * and tag, the allocated bytes and the number of allocations, and their
+   * average and maximum in a single event. Counts like the ones of
+   * `BulkAllocator::GetCounts()` (memory in use at the end of the job, by
+   * tag) follow.
+   *
+   * Only the allocations made on the thread running the module are assigned
+   * to it; the others are reported in the job totals.
+   *
+   * The accounting must be enabled at compile time (see
+   * `LARDATA_ALLOCATION_ACCOUNTING`); otherwise this service only prints
+   * a warning that there is nothing to report.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *LogEvents* (boolean, default: false): reports the allocations of each
+   *   module on each event, as they happen
+   */
+  class AllocationReport {
+      public:
+
+    AllocationReport(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+      private:
+
+    /// Counters of one module and tag
+    struct ModuleTagCounts_t {
+      AllocationCounts_t total; ///< counts of all the calls
+      std::size_t calls = 0U; ///< module calls with allocations
+      std::size_t maxBytesPerCall = 0U; ///< most bytes in one call
+      std::size_t maxAllocationsPerCall = 0U; ///< most allocations in a call
+    }; // ModuleTagCounts_t
+
+    /// Counters of one module, by tag name
+    using ModuleCounts_t = std::map<std::string, ModuleTagCounts_t>;
+
+    bool const fLogEvents; ///< whether to report each event
+
+    std::mutex fMutex; ///< protects the following members
+    std::map<std::string, ModuleCounts_t> fCounts; ///< by module label
+    std::map<art::ScheduleID, art::EventID> fCurrentEvent; ///< by schedule
+    std::size_t fNEvents = 0U; ///< events processed
+
+    void preProcessEvent(art::Event const& event, art::ScheduleContext sc);
+    void preModule(art::ModuleContext const& mc);
+    void postModule(art::ModuleContext const& mc);
+    void postEndJob();
+
+  }; // class AllocationReport
+
+} // namespace lar
+
+
+DECLARE_ART_SERVICE(lar::AllocationReport, SHARED)
+
+
+#endif // LARDATA_UTILITIES_ALLOCATIONREPORT_H
@@ -0,0 +1,134 @@
+/**
+ * @file   AllocationReport_service.cc
+ * @brief  _art_ service reporting the allocations of lardata containers
+ * @date   October 14, 2026
+ * @see    AllocationReport.h
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/AllocationReport.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+
+
+namespace {
+
+  /// Returns the scope of the module running in this thread
+  lar::AllocationAccounting::Scope_t& moduleScope() {
+    static thread_local lar::AllocationAccounting::Scope_t scope;
+    return scope;
+  } // moduleScope()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+lar::AllocationReport::AllocationReport
+  (fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
+  : fLogEvents(pset.get<bool>("LogEvents", false))
+{
+  if (!AllocationAccounting::Enabled) {
+    mf::LogWarning("AllocationReport") << "lardata was built without"
+      " LARDATA_ALLOCATION_ACCOUNTING: no allocation will be reported.";
+    return;
+  }
+  reg.sPreProcessEvent.watch(this, &AllocationReport::preProcessEvent);
+  reg.sPreModule.watch(this, &AllocationReport::preModule);
+  reg.sPostModule.watch(this, &AllocationReport::postModule);
+  reg.sPostEndJob.watch(this, &AllocationReport::postEndJob);
+} // lar::AllocationReport::AllocationReport()
+
+
+//------------------------------------------------------------------------------
+void lar::AllocationReport::preProcessEvent
+  (art::Event const& event, art::ScheduleContext sc)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fCurrentEvent[sc.id()] = event.id();
+  ++fNEvents;
+} // lar::AllocationReport::preProcessEvent()
+
+
+//------------------------------------------------------------------------------
+void lar::AllocationReport::preModule(art::ModuleContext const&) {
+  AllocationAccounting::Scope_t& scope = moduleScope();
+  scope.clear();
+  AllocationAccounting::setScope(&scope);
+} // lar::AllocationReport::preModule()
+
+
+//------------------------------------------------------------------------------
+void lar::AllocationReport::postModule(art::ModuleContext const& mc) {
+
+  AllocationAccounting::setScope(nullptr);
+  AllocationAccounting::Scope_t const& scope = moduleScope();
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  ModuleCounts_t& moduleCounts = fCounts[mc.moduleLabel()];
+  std::size_t const nTags = AllocationAccounting::nTags();
+  for (std::size_t id = 0; id < nTags; ++id) {
+    AllocationCounts_t const& counts = scope.counts[id];
+    if (counts.empty()) continue;
+    ModuleTagCounts_t& tagCounts
+      = moduleCounts[AllocationAccounting::tagName(id)];
+    tagCounts.total += counts;
+    ++tagCounts.calls;
+    tagCounts.maxBytesPerCall
+      = std::max(tagCounts.maxBytesPerCall, counts.allocatedBytes);
+    tagCounts.maxAllocationsPerCall
+      = std::max(tagCounts.maxAllocationsPerCall, counts.allocations);
+  } // for tags
+
+  if (!fLogEvents) return;
+  mf::LogInfo log("AllocationReport");
+  log << mc.moduleLabel() << " on " << fCurrentEvent[mc.scheduleID()] << ":";
+  bool any = false;
+  for (std::size_t id = 0; id < nTags; ++id) {
+    AllocationCounts_t const& counts = scope.counts[id];
+    if (counts.empty()) continue;
+    any = true;
+    log << "\n  " << AllocationAccounting::tagName(id) << ": "
+      << counts.allocatedBytes << " bytes in " << counts.allocations
+      << " allocations, " << counts.freedBytes << " bytes freed";
+  } // for tags
+  if (!any) log << " no allocation";
+
+} // lar::AllocationReport::postModule()
+
+
+//------------------------------------------------------------------------------
+void lar::AllocationReport::postEndJob() {
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  mf::LogInfo log("AllocationReport");
+  log << "Allocations of lardata containers in " << fNEvents << " events:";
+  for (auto const& [ label, moduleCounts ]: fCounts) {
+    if (moduleCounts.empty()) continue;
+    log << "\n  " << label << ":";
+    for (auto const& [ tag, counts ]: moduleCounts) {
+      log << "\n    " << tag << ": " << counts.total.allocatedBytes
+        << " bytes in " << counts.total.allocations << " allocations ("
+        << (double(counts.total.allocatedBytes) / counts.calls)
+        << " bytes per event with allocations; at most " << counts.maxBytesPerCall
+        << " bytes and " << counts.maxAllocationsPerCall
+        << " allocations in one event)";
+    } // for tags
+  } // for modules
+
+  log << "\nJob totals by tag:";
+  for (auto const& [ tag, counts ]: AllocationAccounting::GetCounts()) {
+    log << "\n  " << tag << ": " << counts.allocatedBytes << " bytes in "
+      << counts.allocations << " allocations, " << counts.bytesInUse()
+      << " bytes still in use";
+  } // for tags
+
+} // lar::AllocationReport::postEndJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_SERVICE(lar::AllocationReport)
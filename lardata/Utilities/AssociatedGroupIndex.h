@@ -0,0 +1,361 @@
+/**
+ * @file   lardata/Utilities/AssociatedGroupIndex.h
+ * @brief  Random access index of the groups of an association.
+ * @date   October 14, 2026
+ * @see    `lardata/Utilities/ForEachAssociatedGroup.h`
+ *
+ * This library is header-only.
+ *
+ * Provided:
+ *
+ * * `util::AssociatedGroupIndex`: index of the groups of associated objects
+ * * `util::associated_groups_index()`: creates such an index
+ *
+ */
+
+#ifndef LARDATA_UTILITIES_ASSOCIATEDGROUPINDEX_H
+#define LARDATA_UTILITIES_ASSOCIATEDGROUPINDEX_H
+
+// framework libraries
+#include "canvas/Persistency/Common/Ptr.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::is_sorted(), std::lower_bound(), std::sort()
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <limits> // std::numeric_limits<>
+#include <numeric> // std::iota()
+#include <stdexcept> // std::out_of_range
+#include <string> // std::to_string()
+#include <vector>
+
+
+namespace util {
+
+  /**
+   * @brief Index of the groups of objects associated to the same object.
+   * @tparam Assns type of the association (e.g. `art::Assns<Track, Hit>`)
+   * @see `util::associated_groups()`
+   *
+   * A group is a sequence of consecutive pairs in the association sharing the
+   * same left object, like for `util::associated_groups()`.
+   * The association is read once at construction: for each group the index
+   * stores the left pointer and the range of its pairs in the association.
+   * Then:
+   *
+   * * `size()` is the number of groups, and `operator[]` the group with the
+   *   specified index, with no scan of the association;
+   * * `find()` returns the group of a given left object, by binary search;
+   * * the group iterators are random access, so the index can be split by
+   *   parallel algorithms.
+   *
+   * Each group (`Group`) provides `left()` and a range of the right
+   * pointers. The index refers to the association, which must not change
+   * or be destroyed while the index is in use.
+   *
+   * Example: the total charge of each track, with the tracks processed in
+   * parallel by TBB:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const& assns
+   *   = *(event.getValidHandle<art::Assns<recob::Track, recob::Hit>>(tag));
+   * auto const groups = util::associated_groups_index(assns);
+   *
+   * std::vector<double> totalCharge(groups.size(), 0.0);
+   * tbb::parallel_for(tbb::blocked_range<std::size_t>(0, groups.size()),
+   *   [&](tbb::blocked_range<std::size_t> const& range){
+   *     for (std::size_t i = range.begin(); i != range.end(); ++i)
+   *       for (art::Ptr<recob::Hit> const& hit: groups[i])
+   *         totalCharge[i] += hit->Integral();
+   *   });
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename Assns>
+  class AssociatedGroupIndex {
+
+      public:
+    using Assns_t = Assns; ///< Type of the indexed association.
+    using LeftPtr_t = art::Ptr<typename Assns_t::left_t>; ///< Left pointer.
+    using RightPtr_t = art::Ptr<typename Assns_t::right_t>; ///< Right pointer.
+
+    /// Value returned by `find()` and `index()` for a missing group.
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+
+    /// Random access iterator to the right pointers of a group.
+    class RightIterator {
+      using PairIter_t = typename Assns_t::const_iterator;
+
+        public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = RightPtr_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = RightPtr_t; // pointers are returned by value
+
+      RightIterator() = default;
+      explicit RightIterator(PairIter_t it): fIter(it) {}
+
+      reference operator*() const { return (*fIter).second; }
+      reference operator[] (difference_type n) const { return *(*this + n); }
+
+      RightIterator& operator++() { ++fIter; return *this; }
+      RightIterator& operator--() { --fIter; return *this; }
+      RightIterator operator++(int) { auto old = *this; ++fIter; return old; }
+      RightIterator operator--(int) { auto old = *this; --fIter; return old; }
+      RightIterator& operator+= (difference_type n) { fIter += n; return *this; }
+      RightIterator& operator-= (difference_type n) { fIter -= n; return *this; }
+      RightIterator operator+ (difference_type n) const
+        { return RightIterator(fIter + n); }
+      RightIterator operator- (difference_type n) const
+        { return RightIterator(fIter - n); }
+      difference_type operator- (RightIterator const& other) const
+        { return fIter - other.fIter; }
+
+      bool operator== (RightIterator const& other) const
+        { return fIter == other.fIter; }
+      bool operator!= (RightIterator const& other) const
+        { return fIter != other.fIter; }
+      bool operator< (RightIterator const& other) const
+        { return (fIter - other.fIter) < 0; }
+
+        private:
+      PairIter_t fIter; ///< Iterator to the association pair.
+
+    }; // class RightIterator
+
+
+    /// A group: the left object and the range of its right pointers.
+    class Group {
+        public:
+      Group(LeftPtr_t const& left, RightIterator begin, RightIterator end)
+        : fLeft(left), fBegin(begin), fEnd(end)
+        {}
+
+      /// Returns the pointer to the left object of the group.
+      LeftPtr_t const& left() const { return fLeft; }
+
+      /// Returns an iterator to the first of the right pointers.
+      RightIterator begin() const { return fBegin; }
+
+      /// Returns an iterator past the last of the right pointers.
+      RightIterator end() const { return fEnd; }
+
+      /// Returns the number of right pointers in the group.
+      std::size_t size() const { return fEnd - fBegin; }
+
+      /// Returns whether the group has no right pointers (never in an index).
+      bool empty() const { return fBegin == fEnd; }
+
+      /// Returns the `i`-th right pointer of the group (no check).
+      RightPtr_t operator[] (std::size_t i) const { return fBegin[i]; }
+
+        private:
+      LeftPtr_t fLeft; ///< Pointer to the left object.
+      RightIterator fBegin; ///< First of the right pointers.
+      RightIterator fEnd; ///< Past the last of the right pointers.
+
+    }; // class Group
+
+
+    /// Random access iterator to the groups.
+    class const_iterator {
+        public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = Group;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Group; // groups are created on the fly
+
+      const_iterator() = default;
+      const_iterator(AssociatedGroupIndex const* index, std::size_t pos)
+        : fIndex(index), fPos(pos)
+        {}
+
+      reference operator*() const { return (*fIndex)[fPos]; }
+      reference operator[] (difference_type n) const
+        { return (*fIndex)[fPos + n]; }
+
+      /// Returns the index of the pointed group.
+      std::size_t position() const { return fPos; }
+
+      const_iterator& operator++() { ++fPos; return *this; }
+      const_iterator& operator--() { --fPos; return *this; }
+      const_iterator operator++(int) { auto old = *this; ++fPos; return old; }
+      const_iterator operator--(int) { auto old = *this; --fPos; return old; }
+      const_iterator& operator+= (difference_type n)
+        { fPos += n; return *this; }
+      const_iterator& operator-= (difference_type n)
+        { fPos -= n; return *this; }
+      const_iterator operator+ (difference_type n) const
+        { return { fIndex, fPos + n }; }
+      const_iterator operator- (difference_type n) const
+        { return { fIndex, fPos - n }; }
+      difference_type operator- (const_iterator const& other) const
+        { return difference_type(fPos) - difference_type(other.fPos); }
+
+      bool operator== (const_iterator const& other) const
+        { return fPos == other.fPos; }
+      bool operator!= (const_iterator const& other) const
+        { return fPos != other.fPos; }
+      bool operator< (const_iterator const& other) const
+        { return fPos < other.fPos; }
+      bool operator> (const_iterator const& other) const
+        { return fPos > other.fPos; }
+      bool operator<= (const_iterator const& other) const
+        { return fPos <= other.fPos; }
+      bool operator>= (const_iterator const& other) const
+        { return fPos >= other.fPos; }
+
+        private:
+      AssociatedGroupIndex const* fIndex = nullptr; ///< The index.
+      std::size_t fPos = 0; ///< Index of the pointed group.
+
+    }; // class const_iterator
+
+
+    /// Constructor: indexes all the groups of `assns`, in one pass.
+    explicit AssociatedGroupIndex(Assns_t const& assns);
+
+    /// Returns the number of groups.
+    std::size_t size() const { return fGroups.size(); }
+
+    /// Returns whether the association has no group.
+    bool empty() const { return fGroups.empty(); }
+
+    /// Returns the group `i` (no check).
+    Group operator[] (std::size_t i) const;
+
+    /// Returns the group `i`.
+    /// @throw std::out_of_range if there is no group with that index
+    Group at(std::size_t i) const;
+
+    /// Returns an iterator to the first group.
+    const_iterator begin() const { return { this, 0U }; }
+
+    /// Returns an iterator past the last group.
+    const_iterator end() const { return { this, size() }; }
+
+    /// Returns the index of the group of `left`, `npos` if not present.
+    /// If `left` has more than one group, the first one is returned.
+    std::size_t index(LeftPtr_t const& left) const;
+
+    /// Returns an iterator to the group of `left`, `end()` if not present.
+    const_iterator find(LeftPtr_t const& left) const
+      {
+        std::size_t const i = index(left);
+        return (i == npos)? end(): const_iterator(this, i);
+      }
+
+    /// Returns whether the groups are sorted by their left object.
+    bool sorted() const { return fSortedGroups.empty(); }
+
+
+      private:
+
+    /// Location of a group in the association.
+    struct GroupInfo_t {
+      LeftPtr_t left; ///< Left object of the group.
+      std::size_t begin; ///< Position of the first pair in the association.
+      std::size_t end; ///< Position after the last pair in the association.
+    }; // GroupInfo_t
+
+    Assns_t const* fAssns; ///< The indexed association.
+    std::vector<GroupInfo_t> fGroups; ///< All the groups, in order.
+
+    /// Groups sorted by left object, if they are not already (else empty).
+    std::vector<std::size_t> fSortedGroups;
+
+  }; // class AssociatedGroupIndex<>
+
+
+  /// Returns an index of all the groups of `assns`.
+  /// @see `util::AssociatedGroupIndex`
+  template <typename Assns>
+  AssociatedGroupIndex<Assns> associated_groups_index(Assns const& assns)
+    { return AssociatedGroupIndex<Assns>(assns); }
+
+} // namespace util
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+template <typename Assns>
+util::AssociatedGroupIndex<Assns>::AssociatedGroupIndex(Assns_t const& assns)
+  : fAssns(&assns)
+{
+  std::size_t pos = 0;
+  for (auto const& pair: assns) {
+    if (fGroups.empty() || (fGroups.back().left != pair.first))
+      fGroups.push_back({ pair.first, pos, pos });
+    fGroups.back().end = ++pos;
+  } // for
+
+  auto const byLeft = [](GroupInfo_t const& a, GroupInfo_t const& b)
+    { return a.left < b.left; };
+  if (std::is_sorted(fGroups.begin(), fGroups.end(), byLeft)) return;
+
+  fSortedGroups.resize(fGroups.size());
+  std::iota(fSortedGroups.begin(), fSortedGroups.end(), 0U);
+  std::stable_sort(fSortedGroups.begin(), fSortedGroups.end(),
+    [this](std::size_t a, std::size_t b)
+      { return fGroups[a].left < fGroups[b].left; }
+    );
+
+} // util::AssociatedGroupIndex<>::AssociatedGroupIndex()
+
+
+//------------------------------------------------------------------------------
+template <typename Assns>
+auto util::AssociatedGroupIndex<Assns>::operator[] (std::size_t i) const
+  -> Group
+{
+  GroupInfo_t const& info = fGroups[i];
+  auto const first = fAssns->begin();
+  return {
+    info.left,
+    RightIterator(first + info.begin), RightIterator(first + info.end)
+    };
+} // util::AssociatedGroupIndex<>::operator[]()
+
+
+//------------------------------------------------------------------------------
+template <typename Assns>
+auto util::AssociatedGroupIndex<Assns>::at(std::size_t i) const -> Group {
+  if (i >= size()) {
+    throw std::out_of_range("AssociatedGroupIndex: group #"
+      + std::to_string(i) + " requested, only " + std::to_string(size())
+      + " present");
+  }
+  return operator[](i);
+} // util::AssociatedGroupIndex<>::at()
+
+
+//------------------------------------------------------------------------------
+template <typename Assns>
+std::size_t util::AssociatedGroupIndex<Assns>::index
+  (LeftPtr_t const& left) const
+{
+  if (sorted()) {
+    auto const it = std::lower_bound(fGroups.begin(), fGroups.end(), left,
+      [](GroupInfo_t const& info, LeftPtr_t const& ptr)
+        { return info.left < ptr; }
+      );
+    return ((it == fGroups.end()) || (it->left != left))
+      ? npos: std::size_t(it - fGroups.begin());
+  }
+  else {
+    auto const it
+      = std::lower_bound(fSortedGroups.begin(), fSortedGroups.end(), left,
+      [this](std::size_t i, LeftPtr_t const& ptr)
+        { return fGroups[i].left < ptr; }
+      );
+    return ((it == fSortedGroups.end()) || (fGroups[*it].left != left))
+      ? npos: *it;
+  }
+} // util::AssociatedGroupIndex<>::index()
+
+
+//------------------------------------------------------------------------------
+
+#endif // LARDATA_UTILITIES_ASSOCIATEDGROUPINDEX_H
@@ -34,6 +34,10 @@
  *   one-to-many association, between an element of a collection and the
  *   elements of another collection, whose indices are specified by the values
  *   in a subrange of a third collection (of indices)
+ * -# `CreateAssn(art::Event&, art::Assns<T,U>&, Offsets const&, Indices const&)`
+ *   many one-to-many associations, between all the elements of a collection
+ *   and elements of another collection, with the indices of the latter for
+ *   all the former in compressed sparse row format
  * -# @code CreateAssnD(art::Event&, art::Assns<T,U>&, size_t, size_t, typename art::Assns<T,U,D>::data_t const&) @endcode,
  *   @code CreateAssnD(art::Event&, art::Assns<T,U>&, size_t, size_t, typename art::Assns<T,U,D>::data_t&&) @endcode
  *   one-to-one association, between an element of a collection and the element
@@ -66,6 +70,11 @@
  * element of std::vector | std::vector<art::Ptr<U>> |                            | CreateAssn(art::Event&, std::vector<T> const&, std::vector<art::Ptr<U>>&, art::Assns<T,U>&, size_t)
  * element of std::vector | std::vector<U>           |                            | CreateAssn(art::Event&, std::vector<T> const&, std::vector<U> const&, art::Assns<T,U>&, size_t, size_t, size_t)
  * element by index       | range of indices         | does not need object lists | CreateAssn(art::Event&, art::Assns<T,U>&, size_t, Iter, Iter)
+ * all elements by index  | indices, in CSR format   | all in one pass            | CreateAssn(art::Event&, art::Assns<T,U>&, Offsets const&, Indices const&)
+ *
+ * Producers filling many associations between the same two collections one
+ * call at a time can use instead a util::AssnsBuilder, which looks up the
+ * product IDs of the collections only once.
  *
  */
 
@@ -73,7 +82,11 @@
 #define ASSOCIATIONUTIL_H
 
 // C/C++ standard libraries
+#include <iterator> // std::begin(), std::distance(), ...
+#include <numeric> // std::partial_sum()
+#include <stdexcept> // std::out_of_range
 #include <string>
+#include <type_traits> // std::enable_if_t, std::is_convertible_v
 #include <utility> // std::move()
 #include <vector>
 
@@ -87,8 +100,12 @@
 #include "canvas/Persistency/Common/FindOneP.h"
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Utilities/Exception.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+// LArSoft libraries
+#include "lardata/Utilities/PtrMakerRegistry.h"
+
 namespace util {
 
   // see https://cdcvs.fnal.gov/redmine/projects/art/wiki/Inter-Product_References
@@ -514,6 +531,170 @@ namespace util {
   //@}
 
 
+  /**
+   * @brief Helper adding associations between two collections, by index
+   * @tparam T type of the objects on the left of the association
+   * @tparam U type of the objects on the right of the association
+   *
+   * The builder creates the `art::PtrMaker` of both the collections once,
+   * so that the product IDs are looked up only at construction, and then
+   * adds associations between elements specified by their index.
+   * As with the other `util::CreateAssn()` functions, the collections are
+   * the data products of type `std::vector<T>` and `std::vector<U>` which are
+   * (or will be) put into the event by the current producer.
+   *
+   * Example: associating each cluster to its hits
+   *
+   *     util::AssnsBuilder<recob::Cluster, recob::Hit> assnsBuilder
+   *       (evt, *clusterHitAssns);
+   *     for (std::size_t iCluster = 0; iCluster < clusters.size(); ++iCluster)
+   *       assnsBuilder.add(iCluster, hitIndices[iCluster]);
+   *
+   */
+  template <typename T, typename U>
+  class AssnsBuilder {
+      public:
+    using Assns_t = art::Assns<T,U>; ///< type of the filled association
+
+    /**
+     * @brief Constructor: fills `assn`, with the specified instance names
+     * @param evt reference to the current event
+     * @param assn reference to association object where to add new ones
+     * @param a_instance instance name of the data product of T objects
+     * @param b_instance instance name of the data product of U objects
+     */
+    AssnsBuilder(
+      art::Event        & evt,
+      Assns_t           & assn,
+      std::string const & a_instance = {},
+      std::string const & b_instance = {}
+      )
+      : fAssns(assn)
+      , fMakeAPtr(evt, a_instance)
+      , fMakeBPtr(evt, b_instance)
+      {}
+
+    /**
+     * @brief Constructor: uses the pointer makers from a registry
+     * @param ptrMakers registry of the pointer makers of the current event
+     * @param assn reference to association object where to add new ones
+     * @param a_instance instance name of the data product of T objects
+     * @param b_instance instance name of the data product of U objects
+     *
+     * The pointer makers are taken from `ptrMakers` (and created there if not
+     * present yet), so that they are shared with the other users of the
+     * registry.
+     */
+    AssnsBuilder(
+      util::PtrMakerRegistry & ptrMakers,
+      Assns_t                & assn,
+      std::string const      & a_instance = {},
+      std::string const      & b_instance = {}
+      )
+      : fAssns(assn)
+      , fMakeAPtr(ptrMakers.maker<T>(a_instance))
+      , fMakeBPtr(ptrMakers.maker<U>(b_instance))
+      {}
+
+    /// Associates `a[first_index]` and `b[second_index]`.
+    void add(size_t first_index, size_t second_index)
+      { fAssns.addSingle(fMakeAPtr(first_index), fMakeBPtr(second_index)); }
+
+    /// Associates `a[first_index]` with each `b[i]`, `i` in the range.
+    template <typename Iter>
+    void add(size_t first_index, Iter from_second_index, Iter to_second_index);
+
+    /// Associates `a[first_index]` with each `b[i]`, `i` in the collection.
+    template <typename Indices>
+    std::enable_if_t<!std::is_convertible_v<Indices, size_t>>
+    add(size_t first_index, Indices const& second_indices)
+      {
+        using std::begin;
+        using std::end;
+        add(first_index, begin(second_indices), end(second_indices));
+      }
+
+    /**
+     * @brief Associates all the elements of `a` at once
+     * @param offsets start of the indices of each `a` element, plus the end
+     * @param second_indices indices of `b` elements, for all `a` in order
+     * @throw art::Exception (`art::errors::LogicError`) on invalid offsets
+     *
+     * The association is specified in compressed sparse row format:
+     * `a[i]` is associated with `b[second_indices[k]]` for all `k` from
+     * `offsets[i]` to `offsets[i + 1]` excluded. The number of elements of
+     * `a` is `offsets.size() - 1`.
+     */
+    template <typename Offsets, typename Indices>
+    void addCSR(Offsets const& offsets, Indices const& second_indices);
+
+      private:
+    Assns_t& fAssns; ///< the association being filled
+    art::PtrMaker<T> const fMakeAPtr; ///< creates pointers to `a` elements
+    art::PtrMaker<U> const fMakeBPtr; ///< creates pointers to `b` elements
+
+  }; // class AssnsBuilder<>
+
+
+  /**
+   * @brief Creates all the one-to-many associations between two collections
+   * @tparam T type of the objects on the left of the association
+   * @tparam U type of the objects on the right of the association
+   * @tparam Offsets type of collection of the offsets (`size_t`-compatible)
+   * @tparam Indices type of collection of the indices (`size_t`-compatible)
+   * @param evt reference to the current event
+   * @param assn reference to association object where the new ones will be put
+   * @param offsets start of the indices of each `a` element, plus the end
+   * @param second_indices indices of `b` elements, for all `a` in order
+   *        (random access sequence)
+   * @return whether the operation was successful
+   * @see AssnsBuilder::addCSR()
+   *
+   * This is the same as calling `CreateAssn()` [08] for each element of the
+   * data product "a" of type `std::vector<T>`, with the indices of the
+   * elements of the data product "b" of type `std::vector<U>` taken from
+   * `second_indices`, from `offsets[i]` to `offsets[i + 1]`. The product IDs
+   * are looked up only once, and the associations are added in a single pass.
+   *
+   *     std::vector<size_t> offsets { 0 }, hitIndices;
+   *     for (auto const& hits: hitIndicesOfCluster) {
+   *       hitIndices.insert(hitIndices.end(), hits.begin(), hits.end());
+   *       offsets.push_back(hitIndices.size());
+   *     }
+   *     util::CreateAssn(evt, *clusterHitAssns, offsets, hitIndices);
+   *
+   */
+  // MARK CreateAssn_09
+  template <typename T, typename U, typename Offsets, typename Indices>
+  bool CreateAssn(
+    art::Event           & evt,
+    art::Assns<T,U>      & assn,
+    Offsets         const& offsets,
+    Indices         const& second_indices
+    );
+
+  /**
+   * @brief Creates all the one-to-many associations between two collections
+   * @param ptrMakers registry of the pointer makers of the current event
+   * @param assn reference to association object where the new ones will be put
+   * @param offsets start of the indices of each `a` element, plus the end
+   * @param second_indices indices of `b` elements, for all `a` in order
+   * @return whether the operation was successful
+   * @see PtrMakerRegistry
+   *
+   * This is the same as `CreateAssn()` [09], but the pointer makers are taken
+   * from (and shared via) the registry `ptrMakers`.
+   */
+  // MARK CreateAssn_10
+  template <typename T, typename U, typename Offsets, typename Indices>
+  bool CreateAssn(
+    util::PtrMakerRegistry & ptrMakers,
+    art::Assns<T,U>        & assn,
+    Offsets           const& offsets,
+    Indices           const& second_indices
+    );
+
+
   // method to return all objects of type U that are not associated to
   // objects of type T. Label is the module label that would have produced
   // the associations and likely the objects of type T
@@ -573,6 +754,57 @@ namespace util {
                            art::Handle< std::vector<T> > index_p);
 
 
+  /**
+   * @brief Values associated to each element of a collection (CSR format)
+   * @tparam V type of the associated values (index or pointer)
+   *
+   * The values associated to the element `i` of the collection are
+   * `values[offsets[i]]` to `values[offsets[i + 1]]` (excluded), in the order
+   * of the association. There are `size() + 1` offsets.
+   */
+  template <typename V>
+  struct AssociatedCSR {
+    std::vector<size_t> offsets; ///< start of values of each element, plus end
+    std::vector<V>      values;  ///< all the associated values, by element
+
+    /// number of elements of the collection
+    size_t size() const { return offsets.empty()? 0: offsets.size() - 1; }
+
+    /// number of values associated to the element `i`
+    size_t count(size_t i) const { return offsets[i + 1] - offsets[i]; }
+
+    /// pointer to the first of the values associated to the element `i`
+    V const* begin(size_t i) const { return values.data() + offsets[i]; }
+
+    /// pointer after the last of the values associated to the element `i`
+    V const* end(size_t i) const { return values.data() + offsets[i + 1]; }
+  }; // struct AssociatedCSR<>
+
+  // --- GetAssociatedCSRManyI and GetAssociatedCSRManyP return the same
+  //     information as GetAssociatedVectorManyI and GetAssociatedVectorManyP,
+  //     in compressed sparse row format.
+  //     They take a single pass on the association if it is sorted by the
+  //     key of the left objects, and two otherwise.
+
+  template<class T,class U>
+  AssociatedCSR<size_t>
+  GetAssociatedCSRManyI(art::Handle< art::Assns<T,U> > h,
+                        art::Handle< std::vector<T> > index_p);
+  template<class T,class U>
+  AssociatedCSR<const U*>
+  GetAssociatedCSRManyP(art::Handle< art::Assns<T,U> > h,
+                        art::Handle< std::vector<T> > index_p);
+
+  namespace details {
+
+    /// Fills `result` with `valueOf(pair.second)` for all the pairs
+    template <typename Assns, typename V, typename ValueOf>
+    void FillAssociatedCSR
+      (Assns const& assns, size_t n, AssociatedCSR<V>& result, ValueOf valueOf);
+
+  } // namespace details
+
+
 }// end namespace
 
 //----------------------------------------------------------------------
@@ -853,6 +1085,93 @@ bool util::CreateAssnD(
   return true;
 } // util::CreateAssnD() [01b]
 
+//----------------------------------------------------------------------
+// MARK CreateAssn_09
+template <typename T, typename U, typename Offsets, typename Indices>
+bool util::CreateAssn(
+  art::Event           & evt,
+  art::Assns<T,U>      & assn,
+  Offsets         const& offsets,
+  Indices         const& second_indices
+) {
+
+  try{
+    AssnsBuilder<T, U>(evt, assn).addCSR(offsets, second_indices);
+  }
+  catch(cet::exception &e){
+    mf::LogWarning("AssociationUtil")
+      << "unable to create requested art:Assns, exception thrown: " << e;
+    return false;
+  }
+
+  return true;
+} // util::CreateAssn() [09]
+
+//----------------------------------------------------------------------
+// MARK CreateAssn_10
+template <typename T, typename U, typename Offsets, typename Indices>
+bool util::CreateAssn(
+  util::PtrMakerRegistry & ptrMakers,
+  art::Assns<T,U>        & assn,
+  Offsets           const& offsets,
+  Indices           const& second_indices
+) {
+
+  try{
+    AssnsBuilder<T, U>(ptrMakers, assn).addCSR(offsets, second_indices);
+  }
+  catch(cet::exception &e){
+    mf::LogWarning("AssociationUtil")
+      << "unable to create requested art:Assns, exception thrown: " << e;
+    return false;
+  }
+
+  return true;
+} // util::CreateAssn() [10]
+
+//----------------------------------------------------------------------
+template <typename T, typename U>
+template <typename Iter>
+void util::AssnsBuilder<T,U>::add
+  (size_t first_index, Iter from_second_index, Iter to_second_index)
+{
+  auto const first_ptr = fMakeAPtr(first_index);
+  for (; from_second_index != to_second_index; ++from_second_index)
+    fAssns.addSingle(first_ptr, fMakeBPtr(*from_second_index));
+} // util::AssnsBuilder<>::add()
+
+//----------------------------------------------------------------------
+template <typename T, typename U>
+template <typename Offsets, typename Indices>
+void util::AssnsBuilder<T,U>::addCSR
+  (Offsets const& offsets, Indices const& second_indices)
+{
+  using std::begin;
+  using std::cbegin;
+  using std::cend;
+
+  size_t const nIndices
+    = std::distance(cbegin(second_indices), cend(second_indices));
+  auto iOffset = cbegin(offsets);
+  auto const oend = cend(offsets);
+  if (iOffset == oend) return; // no elements at all
+
+  auto const indices = begin(second_indices);
+  size_t start = *iOffset;
+  size_t first_index = 0;
+  while (++iOffset != oend) {
+    size_t const stop = *iOffset;
+    if ((stop < start) || (stop > nIndices)) {
+      throw art::Exception(art::errors::LogicError)
+        << "AssnsBuilder::addCSR(): invalid offsets [" << start << "; "
+        << stop << "[ for element #" << first_index << " (" << nIndices
+        << " indices)\n";
+    }
+    add(first_index++, indices + start, indices + stop);
+    start = stop;
+  } // while
+} // util::AssnsBuilder<>::addCSR()
+
 //----------------------------------------------------------------------
 template<class T, class U>
 inline std::vector<const U*>
@@ -934,8 +1253,13 @@ util::GetAssociatedVectorManyI(art::Handle< art::Assns<T,U> > h,
                                art::Handle< std::vector<T> > index_p)
 {
   std::vector< std::vector<size_t> > associated_indices(index_p->size());
+  // count first, so that each list is allocated only once
+  std::vector<size_t> counts(index_p->size(), 0);
+  for(auto const& pair : *h) ++counts.at(pair.first.key());
+  for(size_t i = 0; i < counts.size(); ++i)
+    associated_indices[i].reserve(counts[i]);
   for(auto const& pair : *h)
-    associated_indices.at(pair.first.key()).push_back(pair.second.key());
+    associated_indices[pair.first.key()].push_back(pair.second.key());
   return associated_indices;
 }
 
@@ -945,11 +1269,73 @@ util::GetAssociatedVectorManyP(art::Handle< art::Assns<T,U> > h,
                                art::Handle< std::vector<T> > index_p)
 {
   std::vector< std::vector<const U*> > associated_pointers(index_p->size());
+  // count first, so that each list is allocated only once
+  std::vector<size_t> counts(index_p->size(), 0);
+  for(auto const& pair : *h) ++counts.at(pair.first.key());
+  for(size_t i = 0; i < counts.size(); ++i)
+    associated_pointers[i].reserve(counts[i]);
   for(auto const& pair : *h)
-    associated_pointers.at(pair.first.key()).push_back( &(*(pair.second)) );
+    associated_pointers[pair.first.key()].push_back( &(*(pair.second)) );
+  return associated_pointers;
+}
+
+template<class T,class U>
+inline util::AssociatedCSR<size_t>
+util::GetAssociatedCSRManyI(art::Handle< art::Assns<T,U> > h,
+                            art::Handle< std::vector<T> > index_p)
+{
+  AssociatedCSR<size_t> associated_indices;
+  details::FillAssociatedCSR(*h, index_p->size(), associated_indices,
+    [](art::Ptr<U> const& ptr){ return ptr.key(); });
+  return associated_indices;
+}
+
+template<class T,class U>
+inline util::AssociatedCSR<const U*>
+util::GetAssociatedCSRManyP(art::Handle< art::Assns<T,U> > h,
+                            art::Handle< std::vector<T> > index_p)
+{
+  AssociatedCSR<const U*> associated_pointers;
+  details::FillAssociatedCSR(*h, index_p->size(), associated_pointers,
+    [](art::Ptr<U> const& ptr){ return &(*ptr); });
   return associated_pointers;
 }
 
+template <typename Assns, typename V, typename ValueOf>
+void util::details::FillAssociatedCSR
+  (Assns const& assns, size_t n, AssociatedCSR<V>& result, ValueOf valueOf)
+{
+  // first pass: count the associations of each element, and collect the
+  // values in the association order, which is also the final one if the
+  // association is sorted by left key
+  std::vector<size_t>& offsets = result.offsets;
+  std::vector<V>& values = result.values;
+  offsets.assign(n + 1, 0);
+  values.clear();
+  values.reserve(assns.size());
+  bool sorted = true;
+  size_t lastKey = 0;
+  for(auto const& pair : assns) {
+    size_t const key = pair.first.key();
+    if (key >= n) {
+      throw std::out_of_range("FillAssociatedCSR(): left key "
+        + std::to_string(key) + " of a collection of " + std::to_string(n));
+    }
+    if (key < lastKey) sorted = false;
+    lastKey = key;
+    ++offsets[key + 1];
+    values.push_back(valueOf(pair.second));
+  } // for
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  if (sorted) return;
+
+  // second pass, only if not sorted: counting sort
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  for(auto const& pair : assns)
+    values[next[pair.first.key()]++] = valueOf(pair.second);
+
+} // util::details::FillAssociatedCSR()
+
 //--------------------------------------------------------------------
 // Functions to support unnecessary leading producer argument
 //
@@ -6,19 +6,15 @@
  */
 
 
-//--- BEGIN issue #19494 -------------------------------------------------------
-/// @bug BulkAllocator.h is currently broken; see issue #19494.
-// We are leaving it here because, being a header, it will not bother unless
-// explicitly invoked. Note that there is a unit test for it too.
-#error ("BulkAllocator.h is currently broken; see issue #19494.")
-//--- END issue #19494 ---------------------------------------------------------
-
-
 #ifndef BULKALLOCATOR_H
 #define BULKALLOCATOR_H
 
 // interface include
 #include <memory> // std::allocator<>, std::unique_ptr<>
+#include <array>
+#include <atomic>
+#include <utility> // std::move()
+#include <cstddef> // std::size_t, std::ptrdiff_t
 #include <stdexcept> // std::logic_error
 #include <cstdlib> // std::free
 
@@ -62,11 +58,16 @@ namespace lar {
    *
    * <h3>Deletion policy</h3>
    *
-   * This allocator does not release not reuse deallocated memory. This design
-   * choice is meant to reflect a specific use case where a large amount of
+   * This allocator is meant for a specific use case where a large amount of
    * elements is created and then used, and the created object is fairly static.
-   * Tracking freed memory fragments takes time and more memory, and reusing
-   * them too.
+   * Deallocated memory is tracked by chunk with little overhead: single
+   * elements are reused by later allocations (if the type is at least as
+   * large as a pointer), and a chunk is returned to the system as soon as all
+   * its elements are deallocated and it is not the one a thread is currently
+   * allocating from. Containers repeatedly filled and destroyed (e.g. one per
+   * event) therefore keep the memory usage bounded.
+   * The statistics of the memory can be followed with GetCounts() or with a
+   * reporter function called periodically (SetReporter()).
    * Nevertheless, the allocator has a user count; when no user is present,
    * all the memory is deallocated. This can be convenient, or disastrous:
    * remember that the elements of a container can (or just might) not survive
@@ -87,29 +88,59 @@ namespace lar {
    * member). Each allocator type has its own singleton, i.e., a
    * BulkAllocator<int> does not share memory with a BulkAllocator<double>,
    * but all BulkAllocator<int> share.
+   * Each allocator object, including copies and allocators converted from
+   * other `BulkAllocator` types, counts as a user of the singleton.
+   *
+   * <h3>Multithreading</h3>
+   *
+   * The allocator can be used concurrently from different threads.
+   * Each thread draws memory from its own chunk (cached in the thread), so
+   * that allocation does not lock nor touch shared data; a thread which has
+   * exhausted its chunk creates a new one and publishes it in the pool with
+   * a single atomic operation.
+   * Free() and the deletion of the last user must not happen while other
+   * threads use the allocator.
+   *
+   * <h3>NUMA nodes</h3>
+   *
+   * Each chunk records the NUMA node of the thread which created it. With
+   * SetNodeLocal(true), the chunks of each node make a separate pool: a
+   * thread whose chunk is exhausted takes over only chunks of its own node,
+   * and preallocated chunks are touched by the preallocating thread, so that
+   * the system places their memory on its node. GetNodeCounts() reports the
+   * element counts of each node. The node is read from the system (Linux
+   * only: elsewhere, all the chunks are on node 0).
    */
   template <typename T>
   class BulkAllocator: public std::allocator<T> {
       public:
     using BaseAllocator_t = std::allocator<T>;
 
-    // import types from the STL allocator
-    typedef typename BaseAllocator_t::size_type size_type;
-    typedef typename BaseAllocator_t::difference_type difference_type;
+    // the STL allocator does not define the pointer types any more (C++20)
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
 
-    typedef typename BaseAllocator_t::value_type value_type;
+    typedef T value_type;
 
-    typedef typename BaseAllocator_t::pointer pointer;
-    typedef typename BaseAllocator_t::const_pointer const_pointer;
+    typedef T* pointer;
+    typedef T const* const_pointer;
 
-    typedef typename BaseAllocator_t::reference reference;
-    typedef typename BaseAllocator_t::const_reference const_reference;
+    typedef T& reference;
+    typedef T const& const_reference;
 
     template<typename U>
     struct rebind {
       typedef BulkAllocator<U> other;
     };
 
+    /// Type of function receiving the element counts (@see SetReporter())
+    using Reporter_t = typename
+      details::bulk_allocator::BulkAllocatorBase<T>::Reporter_t;
+
+    /// Type of the element counts of each NUMA node (@see GetNodeCounts())
+    using NodeCounts_t = typename
+      details::bulk_allocator::BulkAllocatorBase<T>::NodeCounts_t;
+
     /// Default constructor: uses the default chunk size
     BulkAllocator() noexcept: BulkAllocator(GetChunkSize(), false) {}
 
@@ -117,16 +148,19 @@ namespace lar {
     BulkAllocator(size_type ChunkSize, bool bPreallocate = false) noexcept
       { CreateGlobalAllocator(ChunkSize, bPreallocate); }
 
-    /// Copy constructor: default
-    BulkAllocator(const BulkAllocator &a) noexcept = default;
+    /// Copy constructor: the copy is a new user
+    BulkAllocator(const BulkAllocator &a) noexcept:
+      BaseAllocator_t(a) { GlobalAllocator.AddUser(); }
 
-    /// Move  constructor: default
-    BulkAllocator(BulkAllocator &&a) noexcept = default;
+    /// Move constructor: the new allocator is a new user
+    BulkAllocator(BulkAllocator &&a) noexcept:
+      BaseAllocator_t(a) { GlobalAllocator.AddUser(); }
 
     /// General copy constructor; currently, it does not preallocate
     template <class U>
     BulkAllocator(const BulkAllocator<U> &a) noexcept:
-      BaseAllocator_t(a) { SetChunkSize(a.GetChunkSize()); }
+      BaseAllocator_t()
+      { CreateGlobalAllocator(a.GetChunkSize()); }
 
     /// Copy assignment: default
     BulkAllocator& operator = (const BulkAllocator &a) = default;
@@ -153,6 +187,45 @@ namespace lar {
     static void SetChunkSize(size_type ChunkSize)
       { GlobalAllocator.SetChunkSize(ChunkSize); }
 
+    /// Returns the number of used and unused elements in the global allocator
+    static std::array<size_type, 2> GetCounts()
+      { return GlobalAllocator.GetCounts(); }
+
+    /// Returns the number of used and unused elements of each NUMA node
+    static NodeCounts_t GetNodeCounts()
+      { return GlobalAllocator.GetNodeCounts(); }
+
+    /// Returns the number of memory chunks in the global allocator
+    static size_type NChunks() { return GlobalAllocator.NChunks(); }
+
+    /// Returns the number of chunk headers in the global allocator
+    static size_type NChunkHeaders() { return GlobalAllocator.NChunkHeaders(); }
+
+    /// Sets whether threads allocate only from chunks of their NUMA node
+    static void SetNodeLocal(bool local)
+      { GlobalAllocator.SetNodeLocal(local); }
+
+    /// Returns whether threads allocate only from chunks of their NUMA node
+    static bool IsNodeLocal() { return GlobalAllocator.IsNodeLocal(); }
+
+    /**
+     * @brief Sets a function to receive GetCounts() periodically
+     * @param reporter the function (an empty one disables the reports)
+     * @param period number of chunks allocated or returned between reports
+     *
+     * For example:
+     * @code
+     * lar::BulkAllocator<Node_t>::SetReporter(
+     *   [](std::array<std::size_t, 2> const& counts)
+     *     { mf::LogInfo("Memory") << counts[0] << " used, " << counts[1] << " free"; },
+     *   100
+     *   );
+     * @endcode
+     * The reporter must be set while no other thread uses the allocator.
+     */
+    static void SetReporter(Reporter_t reporter, size_type period = 1)
+      { GlobalAllocator.SetReporter(std::move(reporter), period); }
+
       private:
     typedef details::bulk_allocator::BulkAllocatorBase<T>
       SharedAllocator_t; ///< shared allocator type
@@ -171,6 +244,7 @@ namespace lar {
 
 //------------------------------------------------------------------------------
 #include <algorithm> // std::max()
+#include <functional> // std::function<>
 #include <vector>
 #include <iostream>
 #include <array>
@@ -179,6 +253,10 @@ namespace lar {
 #ifdef __GNUG__
 # include <cxxabi.h>
 #endif // __GNUG__
+#ifdef __linux__
+# include <unistd.h> // syscall()
+# include <sys/syscall.h> // SYS_getcpu
+#endif // __linux__
 
 namespace lar {
   namespace details {
@@ -221,7 +299,18 @@ namespace lar {
     namespace bulk_allocator {
       constexpr bool bDebug = false;
 
+      /// Returns the NUMA node of the CPU running the calling thread
+      /// (0 if the system does not tell)
+      inline unsigned int CurrentNUMANode() {
+        #if defined(__linux__) && defined(SYS_getcpu)
+          unsigned int cpu = 0, node = 0;
+          if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return node;
+        #endif // __linux__
+        return 0U;
+      } // CurrentNUMANode()
+
       /// A simple reference counter, keep track of a number of users.
+      /// The counter is thread-safe.
       class ReferenceCounter {
           public:
         typedef unsigned int Counter_t; ///< type of user counter
@@ -237,10 +326,16 @@ namespace lar {
 
         /// Removed a user to the users count; returns false if no user yet
         bool RemoveUser()
-          { if (!counter) return false; --counter; return true; }
+          {
+            Counter_t current = counter.load();
+            do {
+              if (!current) return false;
+            } while (!counter.compare_exchange_weak(current, current - 1));
+            return true;
+          }
 
           private:
-        Counter_t counter = 0;
+        std::atomic<Counter_t> counter { 0 };
       }; // class ReferenceCounter
 
 
@@ -248,10 +343,39 @@ namespace lar {
        * @brief A class managing a memory pool
        *
        * The management policy is to allocate *big* chunks of memory.
-       * Memory is never freed, until the last user is removed (which is
+       * Each chunk keeps track of how many of its elements have been released;
+       * a chunk which no thread allocates from any more and which has all its
+       * elements released is returned to the system.
+       * All the memory is also freed when the last user is removed (which is
        * responsibility of the caller), this object is destroyed of Free() is
        * explicitly called.
-       * The amount of memory on
+       *
+       * Each thread draws memory from its own current chunk, whose free
+       * pointer is written only by that thread. When that chunk is exhausted,
+       * the thread first tries to take over a chunk left by another thread (or
+       * earlier by itself) which has released elements to be reused; if there
+       * is none, it allocates a new chunk and pushes it in front of the list of
+       * all chunks with an atomic compare-and-swap; no lock is ever taken.
+       *
+       * The header of a returned chunk is unlinked from the list by the next
+       * thread returning a chunk (unless another thread is already sweeping
+       * the list); the unlinked headers are deleted as soon as no thread is
+       * walking the list, so that the list does not grow event after event.
+       * Walks only count themselves in and out, and never wait.
+       *
+       * Single released elements are kept in a list in their chunk, and given
+       * out again by the thread which owns the chunk, if the type is large
+       * enough to hold a pointer. Released sequences of elements are not
+       * reused, but they still allow their chunk to be returned.
+       *
+       * The element counts (UsedCount() etc.) collect the chunks of all the
+       * threads, and they are approximate while other threads allocate.
+       * A reporter function can be set to receive the counts periodically
+       * (SetReporter()).
+       *
+       * Chunks are tagged with the NUMA node of the thread creating them;
+       * with SetNodeLocal(true), a thread takes over only chunks of its node,
+       * and preallocated chunks are first touched by the preallocating thread.
        *
        * This class has a users counter. The count must be explicitly handled by
        * the caller.
@@ -263,6 +387,12 @@ namespace lar {
         typedef T value_type;
         typedef T* pointer;
 
+        /// Type of function receiving the element counts (see GetCounts())
+        using Reporter_t = std::function<void(std::array<size_type, 2> const&)>;
+
+        /// Type of the element counts of each NUMA node (see GetNodeCounts())
+        using NodeCounts_t = std::vector<std::array<size_type, 2>>;
+
         /// Constructor; preallocates memory if explicitly requested
         BulkAllocatorBase(
           size_type NewChunkSize = DefaultChunkSize, bool bPreallocate = false
@@ -277,8 +407,8 @@ namespace lar {
         /// Returns a pointer to memory for n new values of type T
         pointer Get(size_type n);
 
-        /// Releases memory pointed by the specified pointer (but it does not).
-        void Release(pointer) {}
+        /// Releases the memory of n elements at the specified pointer
+        void Release(pointer p, size_type n = 1);
 
         /// Add a new pool user with the current parameters
         void AddUser() { ReferenceCounter::AddUser(); }
@@ -299,25 +429,64 @@ namespace lar {
         size_type FreeCount() const;
 
         /// Returns the number of memory pool chunks allocated
-        size_type NChunks() const { return MemoryPool.size(); }
+        size_type NChunks() const { return nChunks.load(); }
+
+        /// Returns the number of chunk headers, including the ones whose
+        /// memory was returned and which are not deleted yet
+        size_type NChunkHeaders() const { return nHeaders.load(); }
 
         /// Returns an array equivalent to { UsedCount(), FreeCount() }
         std::array<size_type, 2> GetCounts() const;
 
+        /// Returns { used, free } elements of the chunks of each NUMA node
+        /// (one entry per node, up to the highest node with chunks)
+        NodeCounts_t GetNodeCounts() const;
+
+        /// Sets whether threads allocate only from chunks of their NUMA node
+        void SetNodeLocal(bool local) { bNodeLocal.store(local); }
+
+        /// Returns whether threads allocate only from chunks of their node
+        bool IsNodeLocal() const { return bNodeLocal.load(); }
+
         /// Sets the chunk size for the future allocations
         void SetChunkSize(size_type NewChunkSize, bool force = false);
 
         /// Returns the current chunk size
-        size_type GetChunkSize() const { return ChunkSize; }
+        size_type GetChunkSize() const { return ChunkSize.load(); }
 
-        /// Preallocates a chunk of the current ChunkSize;
+        /// Preallocates a chunk of the current ChunkSize for this thread;
         /// @see Preallocate(size_type)
-        void Preallocate() { Preallocate(ChunkSize); }
+        void Preallocate() { Preallocate(GetChunkSize()); }
+
+        /**
+         * @brief Sets a function to be called with the counts periodically
+         * @param reporter function receiving the result of GetCounts()
+         * @param period number of chunks allocated or returned between calls
+         *
+         * The reporter is called by the thread allocating or returning the
+         * chunk. It must be set (or removed, with an empty function) while no
+         * other thread uses the pool.
+         */
+        void SetReporter(Reporter_t reporter, size_type period = 1);
 
           private:
         typedef std::allocator<T> Allocator_t;
         typedef typename Allocator_t::difference_type difference_type;
 
+        /// A released element, in the list of elements to be reused
+        struct FreeSlot_t { FreeSlot_t* next; };
+
+        /// Whether single released elements can be kept for reuse
+        static constexpr bool bReuseSlots = (sizeof(T) >= sizeof(FreeSlot_t))
+          && (alignof(T) % alignof(FreeSlot_t) == 0);
+
+        /// Who may allocate from a chunk
+        enum ChunkState_t: unsigned long {
+          Owned    = 0, ///< a thread allocates from the chunk
+          Retired  = 1, ///< no thread allocates from the chunk
+          Returned = 2  ///< the memory of the chunk was returned to the system
+        }; // ChunkState_t
+
         Allocator_t allocator; ///< the actual allocator we use
 
         /// Internal memory chunk; like a std::vector, but does not construct
@@ -327,58 +496,222 @@ namespace lar {
 
           pointer begin = nullptr; ///< start of the pool
           pointer end = nullptr; ///< end of the pool
-          pointer free = nullptr; ///< first unused element of the pool
+
+          /// first unused element of the pool (written only by its thread)
+          std::atomic<pointer> free { nullptr };
+
+          /// number of given out elements released (and not reused)
+          std::atomic<size_type> released { 0 };
+
+          /// single released elements which can be reused
+          std::atomic<FreeSlot_t*> freeSlots { nullptr };
+
+          /// the allocation status of the chunk (lowest bits), and the
+          /// number of its changes (to tell a chunk retired again)
+          std::atomic<unsigned long> stateWord { Owned };
+
+          /// next chunk in the pool list (kept when unlinked, so that walks
+          /// on this chunk can go on)
+          std::atomic<MemoryChunk_t*> next { nullptr };
+
+          /// next chunk unlinked from the pool list and waiting for deletion
+          MemoryChunk_t* nextUnlinked = nullptr;
+
+          unsigned int node = 0U; ///< NUMA node of the thread creating it
 
           ///< Constructor: allocates memory
           MemoryChunk_t(Allocator_t& alloc, size_type n): allocator(&alloc)
             {
               begin = n? allocator->allocate(n): nullptr;
               end = begin + n;
-              free = begin;
+              free.store(begin, std::memory_order_relaxed);
             } // MemoryChunk_t()
           MemoryChunk_t(const MemoryChunk_t&) = delete; ///< Can't copy
-          MemoryChunk_t(MemoryChunk_t&&); ///< Move constructor
+          MemoryChunk_t(MemoryChunk_t&&) = delete; ///< Can't move
 
-          ~MemoryChunk_t() { allocator->deallocate(begin, size()); }
+          ~MemoryChunk_t() { if (hasMemory()) ReturnMemory(); }
 
           MemoryChunk_t& operator=(const MemoryChunk_t&) = delete;
             ///< Can't assign
-          MemoryChunk_t& operator=(MemoryChunk_t&&); ///< Move assignment
+          MemoryChunk_t& operator=(MemoryChunk_t&&) = delete;
+            ///< Can't assign
+
+          /// Returns whether the chunk still has its memory
+          bool hasMemory() const { return stateOf(stateWord.load()) != Returned; }
+
+          /// Returns whether the pointer is in the memory of this chunk
+          bool contains(pointer p) const
+            { return (p >= begin) && (p < end) && hasMemory(); }
 
           /// Returns the number of elements in this pool
           size_type size() const { return end - begin; }
 
           /// Returns the number of free elements in this pool
-          size_type available() const { return end - free; }
+          size_type available() const
+            { return end - firstFree() + released.load(); }
 
           /// Returns the number of used elements in this pool
-          size_type used() const { return free - begin; }
+          size_type used() const { return firstFree() - begin - released.load(); }
 
           /// Returns whether the chunk is full
           bool full() const { return !available(); }
 
-          /// Returns a pointer to a free item, or nullptr if none is available
-          pointer get() { return (free != end)? free++: nullptr; }
-
-          /// Returns a pointer to n free items, or nullptr if not available
+          /// Returns a pointer to n free items, or nullptr if not available;
+          /// only the thread owning the chunk may call this
           pointer get(size_t n)
             {
-              pointer ptr = free;
-              if ((free += n) <= end) return ptr;
-              free = ptr;
-              return nullptr;
+              if (bReuseSlots && (n == 1)) {
+                pointer ptr = reuse();
+                if (ptr) return ptr;
+              }
+              pointer const ptr = firstFree();
+              if (size_type(end - ptr) < n) return nullptr;
+              free.store(ptr + n, std::memory_order_relaxed);
+              return ptr;
+            }
+
+          /// Writes a byte in each memory page, so that the system places the
+          /// pages on the NUMA node of the calling thread (first touch)
+          void touch()
+            {
+              constexpr size_type PageSize = 4096U;
+              auto* const bytes = reinterpret_cast<volatile char*>(begin);
+              size_type const nBytes = size() * sizeof(T);
+              for (size_type offset = 0; offset < nBytes; offset += PageSize)
+                bytes[offset] = 0;
+            }
+
+          /// Returns whether there are released elements ready for reuse
+          bool hasFreeSlots() const { return freeSlots.load() != nullptr; }
+
+          /// Records the release of n elements from p;
+          /// returns whether the chunk has become empty and was returned
+          bool release(pointer p, size_type n)
+            {
+              if (bReuseSlots && (n == 1)) {
+                // lock-free push; any thread can release
+                auto* slot = reinterpret_cast<FreeSlot_t*>(p);
+                slot->next = freeSlots.load(std::memory_order_relaxed);
+                while (!freeSlots.compare_exchange_weak(slot->next, slot));
+              }
+              released += n;
+              return ReturnIfEmpty();
+            }
+
+          /// Stops allocating from the chunk (only the owner thread may call);
+          /// returns whether the chunk was returned
+          bool retire()
+            {
+              // no other thread changes the state of an owned chunk
+              stateWord.store(nextState(stateWord.load(), Retired));
+              return ReturnIfEmpty();
+            }
+
+          /// Takes over the allocation from a retired chunk
+          bool adopt()
+            {
+              unsigned long word = stateWord.load();
+              if (stateOf(word) != Retired) return false;
+              return stateWord.compare_exchange_strong
+                (word, nextState(word, Owned));
             }
 
             private:
-          ///< Default constructor (does nothing)
-          MemoryChunk_t(): allocator(nullptr) {}
+          pointer firstFree() const
+            { return free.load(std::memory_order_relaxed); }
+
+          /// Returns a released element (only the owner thread may pop)
+          pointer reuse()
+            {
+              FreeSlot_t* slot = freeSlots.load();
+              while (slot && !freeSlots.compare_exchange_weak(slot, slot->next));
+              if (!slot) return nullptr;
+              --released;
+              return reinterpret_cast<pointer>(slot);
+            }
+
+          /// Returns the memory if retired and with no element in use
+          bool ReturnIfEmpty()
+            {
+              // if the chunk is adopted and retired again meanwhile,
+              // the change count in the state word makes the exchange fail
+              unsigned long word = stateWord.load();
+              if (stateOf(word) != Retired) return false;
+              if (released.load() != size_type(firstFree() - begin))
+                return false;
+              if (!stateWord.compare_exchange_strong
+                (word, nextState(word, Returned)))
+                return false;
+              ReturnMemory();
+              return true;
+            }
+
+          /// Deallocates the memory; the range is kept to be safely compared
+          void ReturnMemory() { allocator->deallocate(begin, size()); }
+
+          static ChunkState_t stateOf(unsigned long word)
+            { return ChunkState_t(word & 3UL); }
+
+          static unsigned long nextState(unsigned long word, ChunkState_t state)
+            { return ((word | 3UL) + 1UL) | state; }
 
         }; // class MemoryChunk_t
 
-        typedef std::vector<MemoryChunk_t> MemoryPool_t;
+        /// The chunks a thread is using
+        struct ThreadCache_t {
+          BulkAllocatorBase const* owner = nullptr; ///< pool of the chunk
+          unsigned long generation = 0; ///< generation of the pool
+          MemoryChunk_t* chunk = nullptr; ///< the chunk allocating from
+          MemoryChunk_t* lastReleased = nullptr; ///< chunk of last release
+          /// value of the reclamation epoch when `lastReleased` was found
+          unsigned long lastReleasedEpoch = 0;
+        }; // ThreadCache_t
+
+        /// Counts a walk of the chunk list in for its lifetime: while any walk
+        /// is counted, no unlinked chunk header is deleted
+        class ListWalk_t {
+            public:
+          ListWalk_t(BulkAllocatorBase const& pool): nWalks(pool.nWalks)
+            { ++nWalks; }
+          ~ListWalk_t() { --nWalks; }
+          ListWalk_t(ListWalk_t const&) = delete;
+          ListWalk_t& operator=(ListWalk_t const&) = delete;
+            private:
+          std::atomic<unsigned int>& nWalks;
+        }; // ListWalk_t
+
+        std::atomic<size_type> ChunkSize; ///< size of the chunks to add
+
+        /// list of all memory chunks, the latest first
+        std::atomic<MemoryChunk_t*> MemoryPool { nullptr };
+
+        std::atomic<size_type> nChunks { 0 }; ///< number of chunks with memory
+
+        std::atomic<size_type> nHeaders { 0 }; ///< number of chunk headers
+
+        /// number of walks of the chunk list in progress (see ListWalk_t)
+        mutable std::atomic<unsigned int> nWalks { 0 };
+
+        /// changed before each deletion of unlinked headers, so that threads
+        /// can tell their cached chunks may be gone
+        std::atomic<unsigned long> reclaimEpoch { 0 };
+
+        /// set while a thread unlinks and deletes chunk headers
+        std::atomic_flag sweeping = ATOMIC_FLAG_INIT;
 
-        size_type ChunkSize; ///< size of the chunks to add
-        MemoryPool_t MemoryPool; ///< list of all memory chunks; first is free
+        /// chunks unlinked from the list, not deleted yet (only the sweeping
+        /// thread uses this list)
+        MemoryChunk_t* unlinked = nullptr;
+
+        /// whether threads take over only chunks of their NUMA node
+        std::atomic<bool> bNodeLocal { false };
+
+        /// identifier of the content of the pool, changed at each Free()
+        std::atomic<unsigned long> generation;
+
+        Reporter_t reporter; ///< function receiving the counts
+        size_type reportPeriod = 0; ///< chunk operations between reports
+        std::atomic<size_type> nChunkOperations { 0 }; ///< for the reports
 
         /// Default chunk size (default: 10000)
         static size_type DefaultChunkSize;
@@ -386,27 +719,53 @@ namespace lar {
         /// Preallocates a chunk of the given size; allocates if free space < n
         void Preallocate(size_type n);
 
-      }; // class BulkAllocatorBase<>
+        /// Returns the cache of this thread if it refers to this pool
+        ThreadCache_t* ValidThreadCache() const;
 
+        /// Returns the chunk the current thread allocates from, if any
+        MemoryChunk_t* ThreadChunk() const;
 
-      template <typename T>
-      BulkAllocatorBase<T>::MemoryChunk_t::MemoryChunk_t(MemoryChunk_t&& from) {
-        std::swap(allocator, from.allocator);
-        std::swap(begin, from.begin);
-        std::swap(end, from.end);
-        std::swap(free, from.free);
-      } // BulkAllocatorBase<T>::MemoryChunk_t::MemoryChunk_t(MemoryChunk_t&&)
+        /// Makes the chunk the one this thread allocates from
+        void SetThreadChunk(MemoryChunk_t* chunk);
 
-      template <typename T>
-      typename BulkAllocatorBase<T>::MemoryChunk_t&
-        BulkAllocatorBase<T>::MemoryChunk_t::operator= (MemoryChunk_t&& from)
-      {
-        std::swap(allocator, from.allocator);
-        std::swap(begin, from.begin);
-        std::swap(end, from.end);
-        std::swap(free, from.free);
-        return *this;
-      } // BulkAllocatorBase<T>::MemoryChunk_t::operator= (MemoryChunk_t&&)
+        /// Adds a new chunk to the pool, optionally to be used by this thread
+        MemoryChunk_t* NewChunk(size_type n, bool bMakeCurrent = true);
+
+        /// Takes over a retired chunk with reusable elements, if any
+        MemoryChunk_t* AdoptChunk();
+
+        /// Returns the chunk in the pool containing p, nullptr if none;
+        /// the caller must be walking the list (ListWalk_t)
+        MemoryChunk_t* FindChunk(pointer p) const;
+
+        /// Records a chunk allocated or returned, and reports if it's time
+        void ChunkOperation(int delta);
+
+        /// Records a chunk returned, and reclaims the headers of returned chunks
+        void ChunkReturned() { ChunkOperation(-1); ReclaimHeaders(); }
+
+        /// Unlinks the returned chunks and deletes them if no walk is going on;
+        /// must not be called during a walk of the list of this thread
+        void ReclaimHeaders();
+
+        /// Calls op(chunk) for each chunk in the pool
+        template <typename Op>
+        void ForEachChunk(Op op) const
+          {
+            ListWalk_t walk(*this);
+            for (auto chunk = MemoryPool.load(std::memory_order_acquire);
+              chunk; chunk = chunk->next.load()) op(*chunk);
+          }
+
+        /// Returns the cache of the calling thread
+        static ThreadCache_t& ThreadCache()
+          { static thread_local ThreadCache_t cache; return cache; }
+
+        /// Returns a generation value never used before
+        static unsigned long NewGeneration()
+          { static std::atomic<unsigned long> next { 1 }; return next++; }
+
+      }; // class BulkAllocatorBase<>
 
 
       template <typename T>
@@ -416,9 +775,9 @@ namespace lar {
       template <typename T>
       BulkAllocatorBase<T>::BulkAllocatorBase
         (size_type NewChunkSize, bool bPreallocate /* = false */):
-        ChunkSize(NewChunkSize), MemoryPool()
+        ChunkSize(NewChunkSize), generation(NewGeneration())
       {
-        Preallocate(bPreallocate? ChunkSize: 0);
+        Preallocate(bPreallocate? GetChunkSize(): 0);
         if (bDebug) {
           std::cout << "BulkAllocatorBase[" << ((void*) this)
             << "] created for type " << demangle<value_type>()
@@ -437,7 +796,21 @@ namespace lar {
             << NChunks() << " memory chunks with " << AllocatedCount()
             << " elements" << std::endl;
         } // if debug
-        MemoryPool.clear();
+        // the chunks cached by the threads are now all invalid
+        generation.store(NewGeneration(), std::memory_order_release);
+        MemoryChunk_t* chunk = MemoryPool.exchange(nullptr);
+        while (chunk) {
+          MemoryChunk_t* next = chunk->next.load();
+          delete chunk;
+          chunk = next;
+        } // while
+        while (unlinked) {
+          MemoryChunk_t* next = unlinked->nextUnlinked;
+          delete unlinked;
+          unlinked = next;
+        } // while
+        nChunks.store(0);
+        nHeaders.store(0);
       } // BulkAllocatorBase<T>::Free()
 
 
@@ -456,15 +829,181 @@ namespace lar {
       {
         AddUser();
         SetChunkSize(NewChunkSize);
-        Preallocate(bPreallocate? ChunkSize: 0);
+        Preallocate(bPreallocate? GetChunkSize(): 0);
       } // BulkAllocatorBase<T>::AddUser(size_type, bool )
 
 
       template <typename T>
       void BulkAllocatorBase<T>::Preallocate(size_type n) {
-        if (MemoryPool.empty() || (MemoryPool.front().available() < n))
-          MemoryPool.emplace_back(allocator, n);
-      } // BulkAllocatorBase<T>::RemoveUser()
+        if (n == 0) return;
+        MemoryChunk_t const* chunk = ThreadChunk();
+        if (chunk && (chunk->available() >= n)) return;
+        MemoryChunk_t* const newChunk = NewChunk(n);
+        if (IsNodeLocal()) newChunk->touch();
+      } // BulkAllocatorBase<T>::Preallocate()
+
+
+      template <typename T>
+      void BulkAllocatorBase<T>::SetReporter
+        (Reporter_t newReporter, size_type period /* = 1 */)
+      {
+        reporter = std::move(newReporter);
+        reportPeriod = std::max(period, size_type(1));
+        nChunkOperations.store(0);
+      } // BulkAllocatorBase<T>::SetReporter()
+
+
+      template <typename T>
+      typename BulkAllocatorBase<T>::ThreadCache_t*
+        BulkAllocatorBase<T>::ValidThreadCache() const
+      {
+        ThreadCache_t& cache = ThreadCache();
+        if (cache.owner != this) return nullptr;
+        if (cache.generation != generation.load(std::memory_order_acquire))
+          return nullptr;
+        return &cache;
+      } // BulkAllocatorBase<T>::ValidThreadCache()
+
+
+      template <typename T>
+      typename BulkAllocatorBase<T>::MemoryChunk_t*
+        BulkAllocatorBase<T>::ThreadChunk() const
+      {
+        ThreadCache_t const* cache = ValidThreadCache();
+        return cache? cache->chunk: nullptr;
+      } // BulkAllocatorBase<T>::ThreadChunk()
+
+
+      template <typename T>
+      void BulkAllocatorBase<T>::SetThreadChunk(MemoryChunk_t* chunk) {
+        ThreadCache_t* cache = ValidThreadCache();
+        if (!cache) {
+          ThreadCache() = ThreadCache_t
+            { this, generation.load(std::memory_order_acquire), nullptr, nullptr };
+          cache = &ThreadCache();
+        }
+        cache->chunk = chunk;
+      } // BulkAllocatorBase<T>::SetThreadChunk()
+
+
+      template <typename T>
+      typename BulkAllocatorBase<T>::MemoryChunk_t*
+        BulkAllocatorBase<T>::NewChunk
+        (size_type n, bool bMakeCurrent /* = true */)
+      {
+        auto* chunk = new MemoryChunk_t(allocator, n);
+        chunk->node = CurrentNUMANode();
+        // lock-free push in front of the list
+        MemoryChunk_t* head = MemoryPool.load(std::memory_order_relaxed);
+        do {
+          chunk->next.store(head, std::memory_order_relaxed);
+        } while (!MemoryPool.compare_exchange_weak(head, chunk,
+          std::memory_order_release, std::memory_order_relaxed)
+          );
+        ++nHeaders;
+        if (bMakeCurrent) SetThreadChunk(chunk);
+        ChunkOperation(+1);
+        return chunk;
+      } // BulkAllocatorBase<T>::NewChunk()
+
+
+      template <typename T>
+      typename BulkAllocatorBase<T>::MemoryChunk_t*
+        BulkAllocatorBase<T>::AdoptChunk()
+      {
+        if (!bReuseSlots) return nullptr;
+        bool const bLocal = IsNodeLocal();
+        unsigned int const node = bLocal? CurrentNUMANode(): 0U;
+        // an adopted chunk is owned, and can't be returned after the walk
+        ListWalk_t walk(*this);
+        for (auto chunk = MemoryPool.load(std::memory_order_acquire);
+          chunk; chunk = chunk->next.load())
+        {
+          if (bLocal && (chunk->node != node)) continue;
+          if (!chunk->hasFreeSlots() || !chunk->adopt()) continue;
+          SetThreadChunk(chunk);
+          return chunk;
+        } // for
+        return nullptr;
+      } // BulkAllocatorBase<T>::AdoptChunk()
+
+
+      template <typename T>
+      typename BulkAllocatorBase<T>::MemoryChunk_t*
+        BulkAllocatorBase<T>::FindChunk(pointer p) const
+      {
+        // the caller is walking the list: read after being counted in, the
+        // epoch tells whether the chunk of the last release may be deleted
+        unsigned long const epoch = reclaimEpoch.load();
+        ThreadCache_t* cache = ValidThreadCache();
+        if (cache) {
+          // elements are most often released by the thread allocating them,
+          // and many at a time
+          if (cache->chunk && cache->chunk->contains(p)) return cache->chunk;
+          if (cache->lastReleased && (cache->lastReleasedEpoch == epoch)
+            && cache->lastReleased->contains(p))
+            return cache->lastReleased;
+        }
+        for (auto chunk = MemoryPool.load(std::memory_order_acquire);
+          chunk; chunk = chunk->next.load())
+        {
+          if (!chunk->contains(p)) continue;
+          if (cache) {
+            cache->lastReleased = chunk;
+            cache->lastReleasedEpoch = epoch;
+          }
+          return chunk;
+        } // for
+        return nullptr;
+      } // BulkAllocatorBase<T>::FindChunk()
+
+
+      template <typename T>
+      void BulkAllocatorBase<T>::ChunkOperation(int delta) {
+        nChunks += delta;
+        if (!reporter) return;
+        if ((++nChunkOperations % reportPeriod) != 0) return;
+        reporter(GetCounts());
+      } // BulkAllocatorBase<T>::ChunkOperation()
+
+
+      template <typename T>
+      void BulkAllocatorBase<T>::ReclaimHeaders() {
+        // a thread already sweeping will be followed by the next return
+        if (sweeping.test_and_set(std::memory_order_acquire)) return;
+
+        // the first chunk is never unlinked, so that pushes in front of the
+        // list need not to be coordinated with the sweep; unlinked chunks
+        // keep their next pointer, for the walks which are on them
+        MemoryChunk_t* prev = MemoryPool.load(std::memory_order_acquire);
+        if (prev) {
+          MemoryChunk_t* chunk;
+          while ((chunk = prev->next.load())) {
+            if (chunk->hasMemory()) {
+              prev = chunk;
+              continue;
+            }
+            prev->next.store(chunk->next.load());
+            chunk->nextUnlinked = unlinked;
+            unlinked = chunk;
+          } // while
+        } // if
+
+        // the walks starting after this point can't reach the unlinked chunks
+        // (not even from the thread caches, because of the new epoch); the
+        // others have to be over
+        ++reclaimEpoch;
+        if (nWalks.load() == 0) {
+          while (unlinked) {
+            MemoryChunk_t* next = unlinked->nextUnlinked;
+            delete unlinked;
+            --nHeaders;
+            unlinked = next;
+          } // while
+        } // if
+
+        sweeping.clear(std::memory_order_release);
+      } // BulkAllocatorBase<T>::ReclaimHeaders()
 
 
       template <typename T>
@@ -472,7 +1011,8 @@ namespace lar {
         BulkAllocatorBase<T>::AllocatedCount() const
       {
         size_type n = 0;
-        for (const auto& chunk: MemoryPool) n += chunk.size();
+        ForEachChunk([&n](MemoryChunk_t const& chunk)
+          { if (chunk.hasMemory()) n += chunk.size(); });
         return n;
       } // AllocatedCount()
 
@@ -482,11 +1022,23 @@ namespace lar {
         BulkAllocatorBase<T>::UsedCount() const
       {
         size_type n = 0;
-        for (const auto& chunk: MemoryPool) n += chunk.used();
+        ForEachChunk([&n](MemoryChunk_t const& chunk)
+          { if (chunk.hasMemory()) n += chunk.used(); });
         return n;
       } // BulkAllocatorBase<T>::UsedCount()
 
 
+      template <typename T>
+      typename BulkAllocatorBase<T>::size_type
+        BulkAllocatorBase<T>::FreeCount() const
+      {
+        size_type n = 0;
+        ForEachChunk([&n](MemoryChunk_t const& chunk)
+          { if (chunk.hasMemory()) n += chunk.available(); });
+        return n;
+      } // BulkAllocatorBase<T>::FreeCount()
+
+
       template <typename T>
       std::array<typename BulkAllocatorBase<T>::size_type, 2>
         BulkAllocatorBase<T>::GetCounts() const
@@ -494,14 +1046,30 @@ namespace lar {
         // BUG the double brace syntax is required to work around clang bug 21629
         // (https://bugs.llvm.org/show_bug.cgi?id=21629)
         std::array<BulkAllocatorBase<T>::size_type, 2> stats = {{ 0U, 0U }};
-        for (const auto& chunk: MemoryPool) {
+        ForEachChunk([&stats](MemoryChunk_t const& chunk){
+          if (!chunk.hasMemory()) return;
           stats[0] += chunk.used();
           stats[1] += chunk.available();
-        } // for
+        });
         return stats;
       } // BulkAllocatorBase<T>::GetCounts()
 
 
+      template <typename T>
+      typename BulkAllocatorBase<T>::NodeCounts_t
+        BulkAllocatorBase<T>::GetNodeCounts() const
+      {
+        NodeCounts_t stats;
+        ForEachChunk([&stats](MemoryChunk_t const& chunk){
+          if (!chunk.hasMemory()) return;
+          if (chunk.node >= stats.size()) stats.resize(chunk.node + 1, {{ 0U, 0U }});
+          stats[chunk.node][0] += chunk.used();
+          stats[chunk.node][1] += chunk.available();
+        });
+        return stats;
+      } // BulkAllocatorBase<T>::GetNodeCounts()
+
+
       template <typename T>
       void BulkAllocatorBase<T>::SetChunkSize
         (size_type NewChunkSize, bool force /* = false */)
@@ -514,7 +1082,7 @@ namespace lar {
             << (NewChunkSize*sizeof(value_type)) << " bytes/chunk"
             << std::endl;
         }
-        ChunkSize = NewChunkSize;
+        ChunkSize.store(NewChunkSize);
       } // BulkAllocatorBase<T>::SetChunkSize()
 
 
@@ -523,25 +1091,69 @@ namespace lar {
         (size_type n)
       {
         if (n == 0) return nullptr;
-        // get the free pointer from the latest chunk (#0)
-        pointer ptr = MemoryPool.front().get(n);
-        if (ptr) return ptr;
+        // get the free pointer from the chunk of this thread
+        MemoryChunk_t* chunk = ThreadChunk();
+        if (chunk) {
+          pointer ptr = chunk->get(n);
+          if (ptr) return ptr;
+        }
+        size_type const chunkSize = GetChunkSize();
+        // a request larger than a chunk gets a chunk of its own, and the
+        // thread keeps allocating from its current one
+        if ((n > chunkSize) && chunk) {
+          MemoryChunk_t* own = NewChunk(n, false);
+          pointer ptr = own->get(n);
+          if (own->retire()) ChunkReturned();
+          return ptr;
+        }
         // no free element left in that chunk:
-        // - create a new one in the first position of the pool (move the rest)
-        // - return the pointer from the new pool
-        //   (if it fails, it fails... but how could that happen?)
+        // - leave it to be returned when all its elements are released
+        // - take over a chunk with released elements, if any
+        // - or create a new one in the first position of the pool
+        if (chunk && chunk->retire()) ChunkReturned();
+        if (n == 1) {
+          MemoryChunk_t* adopted = AdoptChunk();
+          if (adopted) {
+            pointer ptr = adopted->get(n);
+            if (ptr) return ptr;
+            // all the released elements have been taken by someone else
+            if (adopted->retire()) ChunkReturned();
+          }
+        }
         if (bDebug) {
           std::array<size_type, 2> stats = GetCounts();
           std::cout << "BulkAllocatorBase[" << ((void*) this)
-            << "] allocating " << std::max(ChunkSize, n)
+            << "] allocating " << std::max(chunkSize, n)
             << " more elements (on top of the current " << (stats[0] + stats[1])
             << " elements, " << stats[1] << " unused)" << std::endl;
         } // if debug
-        return MemoryPool.emplace
-          (MemoryPool.begin(), allocator, std::max(ChunkSize, n))->get(n);
+        return NewChunk(std::max(chunkSize, n))->get(n);
       } // BulkAllocatorBase<T>::Get()
 
 
+      template <typename T>
+      void BulkAllocatorBase<T>::Release(pointer p, size_type n /* = 1 */) {
+        if (!p || (n == 0)) return;
+        bool bReturned = false;
+        {
+          // the chunk can be returned by another thread as soon as the
+          // elements are released: the walk lasts until we are done with it
+          ListWalk_t walk(*this);
+          MemoryChunk_t* chunk = FindChunk(p);
+          if (!chunk) {
+            if (bDebug) {
+              std::cout << "BulkAllocatorBase[" << ((void*) this) << "]"
+                << " releasing memory not from this pool: " << ((void*) p)
+                << std::endl;
+            }
+            return;
+          }
+          bReturned = chunk->release(p, n);
+        }
+        if (bReturned) ChunkReturned();
+      } // BulkAllocatorBase<T>::Release()
+
+
     } // namespace bulk_allocator
   } // namespace details
 
@@ -564,7 +1176,7 @@ namespace lar {
 
   template <typename T>
   inline void BulkAllocator<T>::deallocate(pointer p, size_type n) {
-    return GlobalAllocator.Release(p);
+    return GlobalAllocator.Release(p, n);
   } // BulkAllocator<T>::deallocate()
 } // namespace lar
 
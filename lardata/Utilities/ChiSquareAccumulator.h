@@ -12,12 +12,38 @@
 
 
 // C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <cmath> // std::abs()
+#include <cstddef> // std::size_t
+#include <iterator> // std::data(), std::size()
+#include <stdexcept> // std::length_error
+#include <type_traits> // std::enable_if_t, std::void_t, ...
 #include <utility> // std::move(), std::forward()
 
 
 namespace lar {
   namespace util {
 
+    namespace details {
+
+      template <typename Coll, typename = void>
+      struct IsSequence: std::false_type {};
+
+      template <typename Coll>
+      struct IsSequence<Coll, std::void_t<
+        decltype(std::data(std::declval<Coll const&>())),
+        decltype(std::size(std::declval<Coll const&>()))
+        >>
+        : std::true_type
+      {};
+
+      /// Whether `Coll` supports `std::data()` and `std::size()`.
+      template <typename Coll>
+      constexpr bool isSequence() { return IsSequence<Coll>::value; }
+
+    } // namespace details
+
+
     /**
      * @brief Computes a &chi;&sup2; from expectation function and data points.
      * @tparam F type of the function
@@ -50,6 +76,19 @@ namespace lar {
      * will check three observations against the prediction of `2 - x`,
      * returning a `chi2value` of `8.0` and a `degreesOfFreedom` of `0`
      * (note that the `3` degrees are manually subtracted).
+     *
+     * Many points can be added at once from contiguous sequences (like
+     * `std::vector`) of parameters, observations and uncertainties:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * chiSquare.add(xs, ys, sigmas);
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The points are processed in blocks: the normal variables of a block are
+     * computed first in a loop the compiler can vectorize, then summed
+     * pairwise, and the sum of each block is added to the total with
+     * compensation (Kahan-Babuska-Neumaier), which keeps the rounding error
+     * independent of the number of points.
+     * Accumulators filled with parts of the data (e.g. by different threads)
+     * can be combined with `merge()`.
      */
     template <typename F, typename T = double>
     class ChiSquareAccumulator {
@@ -76,7 +115,7 @@ namespace lar {
 
       // @{
       /// Returns the value of &chi;&sup2; currently accumulated.
-      Data_t chiSquare() const { return fChiSq; }
+      Data_t chiSquare() const { return fChiSq + fChiSqCorr; }
       Data_t operator() () const { return chiSquare(); }
       operator Data_t() const { return chiSquare(); }
       //@}
@@ -120,18 +159,145 @@ namespace lar {
       void add(Data_t x, Data_t y, Data_t s)
         { fChiSq += sqr(z(y, expected(x), s)); ++fN; }
 
+      /**
+       * @brief Adds all the data points from the specified sequences.
+       * @tparam XColl type of contiguous sequence of parameters
+       * @tparam YColl type of contiguous sequence of observed values
+       * @param x parameters
+       * @param y observed data, one per parameter in `x`
+       * @throw std::length_error if `x` and `y` have different sizes
+       *
+       * The result is the same as calling `add(x[i], y[i])` for each point,
+       * with a smaller rounding error.
+       * The sequences must support `std::data()` and `std::size()`, like
+       * `std::vector` and C arrays do.
+       */
+      template <typename XColl, typename YColl>
+      auto add(XColl const& x, YColl const& y)
+        -> std::enable_if_t
+          <details::isSequence<XColl>() && details::isSequence<YColl>()>
+        {
+          checkSizes(std::size(x), std::size(y));
+          addPoints(std::data(x), std::data(y),
+            static_cast<Data_t const*>(nullptr), std::size(x));
+        }
+
+      /**
+       * @brief Adds all the data points from the specified sequences.
+       * @tparam XColl type of contiguous sequence of parameters
+       * @tparam YColl type of contiguous sequence of observed values
+       * @tparam SColl type of contiguous sequence of uncertainties
+       * @param x parameters
+       * @param y observed data, one per parameter in `x`
+       * @param s uncertainty on the observed data, one per parameter in `x`
+       * @throw std::length_error if the sequences have different sizes
+       *
+       * The result is the same as calling `add(x[i], y[i], s[i])` for each
+       * point, with a smaller rounding error.
+       * The sequences must support `std::data()` and `std::size()`, like
+       * `std::vector` and C arrays do.
+       */
+      template <typename XColl, typename YColl, typename SColl>
+      auto add(XColl const& x, YColl const& y, SColl const& s)
+        -> std::enable_if_t<
+          details::isSequence<XColl>() && details::isSequence<YColl>()
+          && details::isSequence<SColl>()
+          >
+        {
+          checkSizes(std::size(x), std::size(y));
+          checkSizes(std::size(x), std::size(s));
+          addPoints(std::data(x), std::data(y), std::data(s), std::size(x));
+        }
+
+      /**
+       * @brief Adds all the points of another accumulator to this one.
+       * @param other the accumulator to be merged into this one
+       * @return this accumulator
+       *
+       * The expectation function of `other` is not used: the two accumulators
+       * are assumed to share the same expectation.
+       * For a result independent of the number of threads filling the parts,
+       * see `lar::util::deterministicReduce()`.
+       */
+      ChiSquareAccumulator& merge(ChiSquareAccumulator const& other)
+        {
+          addCompensated(other.fChiSq);
+          addCompensated(other.fChiSqCorr);
+          fN += other.fN;
+          return *this;
+        }
+
       /// Resets all the counts, starting from no data.
-      void clear() { fChiSq = Data_t{0}; fN = 0U; }
+      void clear() { fChiSq = Data_t{0}; fChiSqCorr = Data_t{0}; fN = 0U; }
 
       /// @}
       // --- END -- Data manipulation ------------------------------------------
 
         private:
+      /// Number of points processed together by the sequence `add()`.
+      static constexpr std::size_t BlockSize = 64U;
+
+      /// Number of partial sums of a block, combined pairwise at the end.
+      static constexpr std::size_t NPartialSums = 8U;
+
       unsigned int fN = 0U; ///< Number of data entries.
       Data_t fChiSq = 0.0;  ///< Accumulated &chi;&sup2; value.
+      Data_t fChiSqCorr = 0.0; ///< Compensation of rounding of `fChiSq`.
 
       Function_t fExpected; ///< Function for the expectation.
 
+      /// Throws `std::length_error` if the two sizes are different.
+      static void checkSizes(std::size_t a, std::size_t b)
+        {
+          if (a == b) return;
+          throw std::length_error
+            ("ChiSquareAccumulator::add(): sequences of different sizes");
+        }
+
+      /// Adds `n` points; unit uncertainties if `s` is `nullptr`.
+      template <typename XT, typename YT, typename ST>
+      void addPoints(XT const* x, YT const* y, ST const* s, std::size_t n)
+        {
+          Data_t buffer[BlockSize];
+          for (std::size_t start = 0; start < n; start += BlockSize) {
+            std::size_t const nBlock = std::min(BlockSize, n - start);
+            // the expectation is not vectorized, unless it can be inlined
+            for (std::size_t i = 0; i < nBlock; ++i)
+              buffer[i] = Data_t(y[start + i]) - expected(x[start + i]);
+            if (s) {
+              for (std::size_t i = 0; i < nBlock; ++i)
+                buffer[i] /= Data_t(s[start + i]);
+            }
+            addCompensated(sumOfSquares(buffer, nBlock));
+          } // for blocks
+          fN += n;
+        }
+
+      /// Returns the sum of squares of the `n` values, summed pairwise.
+      static Data_t sumOfSquares(Data_t const* values, std::size_t n)
+        {
+          Data_t partial[NPartialSums] = {};
+          std::size_t i = 0;
+          for (; i + NPartialSums <= n; i += NPartialSums) {
+            for (std::size_t j = 0; j < NPartialSums; ++j)
+              partial[j] += sqr(values[i + j]);
+          }
+          for (; i < n; ++i) partial[i % NPartialSums] += sqr(values[i]);
+          for (std::size_t w = NPartialSums / 2; w > 0; w /= 2) {
+            for (std::size_t j = 0; j < w; ++j) partial[j] += partial[j + w];
+          }
+          return partial[0];
+        }
+
+      /// Adds `v` to the &chi;&sup2; with Neumaier compensated summation.
+      void addCompensated(Data_t v)
+        {
+          Data_t const sum = fChiSq + v;
+          fChiSqCorr += (std::abs(fChiSq) >= std::abs(v))
+            ? ((fChiSq - sum) + v): ((v - sum) + fChiSq);
+          fChiSq = sum;
+        }
+
       /// Normal variable.
       static Data_t z(Data_t x, Data_t mu, Data_t sigma)
         { return (x - mu) / sigma; }
@@ -86,6 +86,7 @@
 // C/C++ standard libraries
 #include <stdexcept> // std::out_of_range
 #include <iterator> // std::iterator_traits, std::reverse_iterator
+#include <memory> // std::addressof()
 #include <string> // std::to_string()
 #include <type_traits> // std::declval(), ...
 #include <cstddef> // std::size_t
@@ -116,6 +117,45 @@ namespace lar {
     }; // RangeTraits<>
 
 
+    //--------------------------------------------------------------------------
+    /// Trait: whether the end iterator can be turned into a begin iterator
+    /// (random access begin iterator, and `end - begin` defined).
+    template <typename BeginIter, typename EndIter, typename = void>
+    struct is_end_convertible_to_begin: public std::false_type {};
+
+    template <typename BeginIter, typename EndIter>
+    struct is_end_convertible_to_begin<BeginIter, EndIter, std::enable_if_t<
+      std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<BeginIter>::iterator_category
+        >::value
+      && std::is_convertible<
+        decltype(std::declval<EndIter const&>() - std::declval<BeginIter const&>()),
+        typename std::iterator_traits<BeginIter>::difference_type
+        >::value
+      && std::is_same<
+        decltype(std::declval<BeginIter&>() += std::declval<
+          typename std::iterator_traits<BeginIter>::difference_type>()
+          ),
+        BeginIter&
+        >::value
+      >>
+      : public std::true_type
+    {};
+
+
+    //--------------------------------------------------------------------------
+    /// Trait: whether `Range` has a `data()` member function.
+    template <typename Range, typename = void>
+    struct has_data: public std::false_type {};
+
+    template <typename Range>
+    struct has_data
+      <Range, std::void_t<decltype(std::declval<Range const&>().data())>>
+      : public std::true_type
+    {};
+
+
     //--------------------------------------------------------------------------
     /// Class storing a begin and a end iterator.
     template <typename BeginIter, typename EndIter = BeginIter>
@@ -281,6 +321,23 @@ namespace lar {
    * be directly instantiated: using directly `IntViewBase_t` will _not_ be
    * allowed.
    *
+   *
+   * Random access and parallel algorithms
+   * --------------------------------------
+   *
+   * The iterators of the view are the ones of the wrapped range, and they keep
+   * their category. If the begin iterator is random access and its distance
+   * from the end iterator can be computed, the end iterator is returned as
+   * a begin iterator (`const_iterator`) even when the range has a different
+   * type for it (a "sentinel"). Then `begin()` and `end()` have the same type
+   * and can be passed to the standard algorithms, including the parallel ones
+   * (e.g. with `std::execution::par`), or used in vectorizable loops, without
+   * copying the elements.
+   * `data()` is available for contiguous ranges.
+   *
+   * The view does not change the wrapped range, and any number of threads can
+   * iterate it at the same time as long as that is safe on the range.
+   *
    */
   template <typename Range>
   class CollectionView: private Range {
@@ -290,8 +347,17 @@ namespace lar {
 
     /// Type of the begin iterator.
     using begin_iter_t = typename traits_t::begin_iterator_t;
+    /// Type of the end iterator of the wrapped range.
+    using range_end_iter_t = typename traits_t::end_iterator_t;
+
+    /// Whether the end iterator is exposed as a begin iterator.
+    static constexpr bool commonIterators
+      = std::is_same<begin_iter_t, range_end_iter_t>()
+      || details::is_end_convertible_to_begin<begin_iter_t, range_end_iter_t>();
+
     /// Type of the end iterator.
-    using end_iter_t = typename traits_t::end_iterator_t;
+    using end_iter_t = std::conditional_t
+      <commonIterators, begin_iter_t, range_end_iter_t>;
 
     /// Type of traits of iterator.
     using iter_traits_t = std::iterator_traits<begin_iter_t>;
@@ -310,6 +376,8 @@ namespace lar {
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     using difference_type = typename iter_traits_t::difference_type;
     using size_type = std::size_t;
+    /// Category of the iterators of the view.
+    using iterator_category = typename iter_traits_t::iterator_category;
 
     /// @{
     /// @name Forward access.
@@ -318,7 +386,15 @@ namespace lar {
     bool empty() const noexcept { return cbegin() == cend(); }
 
     /// Returns the size of the collection.
-    size_type size() const noexcept { return std::distance(cbegin(), cend()); }
+    size_type size() const noexcept
+      {
+        if constexpr (commonIterators) return std::distance(cbegin(), cend());
+        else {
+          size_type n = 0U;
+          for (auto it = cbegin(); it != cend(); ++it) ++n;
+          return n;
+        }
+      }
 
     /// Returns an iterator to the begin of the collection.
     const_iterator cbegin() const noexcept
@@ -326,7 +402,17 @@ namespace lar {
 
     /// Returns an iterator past the end of the collection.
     end_iter_t cend() const noexcept
-      { using std::cend; return cend(asRange()); }
+      {
+        using std::cend;
+        if constexpr
+          (commonIterators && !std::is_same<end_iter_t, range_end_iter_t>())
+        {
+          const_iterator iEnd = cbegin();
+          iEnd += (cend(asRange()) - iEnd);
+          return iEnd;
+        }
+        else return cend(asRange());
+      }
 
     /// Returns an iterator to the begin of the collection.
     const_iterator begin() const noexcept { return cbegin(); }
@@ -385,7 +471,19 @@ namespace lar {
     /// @{
     /// @name Contiguous access.
 
-    const_pointer data() const { return &front(); }
+    /**
+     * @brief Returns a pointer to the first element of a contiguous range.
+     * @return pointer to the first element, `nullptr` if the view is empty
+     *
+     * If the wrapped range provides a `data()` method, its result is returned.
+     * Otherwise the view is assumed to be contiguous, and the address of the
+     * first element is returned.
+     */
+    const_pointer data() const
+      {
+        if constexpr (details::has_data<range_t>()) return asRange().data();
+        else return empty()? nullptr: std::addressof(front());
+      }
 
     /// @}
 
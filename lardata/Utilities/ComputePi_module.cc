@@ -9,11 +9,17 @@
 #include <random> // std::default_random_engine, std::uniform_real_distribution
 #include <ios> // std::fixed
 #include <iomanip> // std::setprecision
+#include <chrono>
+#include <cstdint> // std::uint32_t
+#include <thread>
+#include <vector>
 
 // art libraries
 #include "fhiclcpp/ParameterSet.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 
 
 namespace lar {
@@ -47,8 +53,35 @@ namespace lar {
    *   number sequence will be used for all events; otherwise, each event will
    *   get its own specific sequence
    * - <b>Verbose</b> (boolean, default: false) writes the result into the log
+   * - <b>Threads</b> (unsigned integer, default: 0) if not 0, runs the
+   *   parallel mode (see below) with this number of threads
+   * - <b>Vectorized</b> (boolean, default: false) in parallel mode, uses the
+   *   kernel written for the compiler to vectorize
+   *
+   * Parallel mode
+   * --------------
+   *
+   * The serial mode measures the scalar throughput of a single core.
+   * In parallel mode, each of the threads runs on each event the same
+   * workload as the serial mode (`Ksamples` thousand samples), so that the
+   * time per thread measures a single core while the other ones are busy too.
+   *
+   * The random numbers come from a counter-based generator: sample `i` of a
+   * thread is a hash of `i` and of a key made of the seed, the thread number
+   * and (unless `Fixed`) the event number. Key and counter are the high and
+   * low halves of the 64-bit input of a bijective hash, so that streams with
+   * different keys never share numbers. The result is the same regardless
+   * of the number of threads running at the same time and of the kernel
+   * (the vectorized kernel processes many samples at once without branches,
+   * and it counts the same hits as the scalar one). The counter has 32 bits,
+   * so that up to about 2 billion samples per thread are unique.
+   *
+   * The speed of each thread (samples per second) and the aggregate speed
+   * (all the samples over the wall time of the event) are written in the log
+   * on each event if `Verbose` is set, and their average at the end of the
+   * job.
    */
-  class ComputePi: public art::EDAnalyzer {
+  class ComputePi: public art::SharedAnalyzer {
       public:
     using Counter_t = unsigned long long; ///< type used for integral counters
     using Seed_t = std::default_random_engine::result_type;
@@ -60,6 +93,8 @@ namespace lar {
 
     virtual void analyze(const art::Event&) override;
 
+    virtual void endJob() override;
+
     /// Returns the current best estimation of pi
     double best_pi() const
       { return tries? 4. * double(hits) / double(tries): 3.0; }
@@ -76,10 +111,23 @@ namespace lar {
     bool bFixed; ///< whether the random sequence is always the same
     bool bVerbose; ///< whether to put stuff on screen
 
+    unsigned int nThreads; ///< number of threads (0: serial mode)
+    bool bVectorized; ///< whether to use the vectorized kernel
+
     std::default_random_engine generator; ///< random generator
     Counter_t hits = 0; ///< total number of hits
     Counter_t tries = 0; ///< total number of tries (samples)
 
+    unsigned int nEvents = 0; ///< events processed in parallel mode
+    double threadSeconds = 0.; ///< time spent by all threads, all events
+    double wallSeconds = 0.; ///< wall time of the parallel mode, all events
+
+    /// Serial mode, with the standard random engine
+    void analyzeSerial();
+
+    /// Parallel mode, with the counter-based generator
+    void analyzeParallel(const art::Event& event);
+
 
   }; // class ComputePi
 
@@ -90,11 +138,77 @@ namespace lar {
 
 DEFINE_ART_MODULE(lar::ComputePi)
 
-const char* lar::ComputePi::VersionString = "1.0";
+const char* lar::ComputePi::VersionString = "1.1";
 
 template <typename T>
 inline constexpr T sqr(T v) { return v*v; }
 
+namespace {
+
+  using Counter_t = lar::ComputePi::Counter_t;
+
+  /// 32-bit integer hash ("lowbias32"), mixing the keys of the streams
+  inline std::uint32_t hash32(std::uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+  } // hash32()
+
+  /// 64-bit integer hash (the finalizer of "splitmix64"), a bijection
+  inline std::uint64_t hash64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  } // hash64()
+
+  /// Random number `c` of the stream `key`, from key and counter together
+  inline std::uint32_t random32(std::uint32_t key, std::uint32_t c)
+    { return std::uint32_t(hash64((std::uint64_t(key) << 32) | c) >> 32); }
+
+  /// Returns a number in [ 0, 1 [ from the highest 24 bits of `h`
+  inline float toUnit(std::uint32_t h)
+    { return float(h >> 8) * (1.0f / 16777216.0f); }
+
+  /// Returns whether the sample `i` of the stream `key` is in the circle
+  inline bool inCircle(std::uint32_t key, std::uint32_t i) {
+    float const x = toUnit(random32(key, 2U * i));
+    float const y = toUnit(random32(key, 2U * i + 1U));
+    return sqr(x) + sqr(y) < 1.0f;
+  } // inCircle()
+
+  /// Counts the samples in the circle, one after the other
+  Counter_t countHitsScalar(std::uint32_t key, Counter_t samples) {
+    Counter_t hits = 0;
+    for (Counter_t i = 0; i < samples; ++i)
+      if (inCircle(key, std::uint32_t(i))) ++hits;
+    return hits;
+  } // countHitsScalar()
+
+  /// Counts the samples in the circle, in blocks with no branch
+  Counter_t countHitsVectorized(std::uint32_t key, Counter_t samples) {
+    constexpr std::uint32_t Lanes = 16;
+    std::uint32_t laneHits[Lanes] = {};
+    Counter_t const nBlocks = samples / Lanes;
+    for (Counter_t block = 0; block < nBlocks; ++block) {
+      std::uint32_t const first = std::uint32_t(block * Lanes);
+      for (std::uint32_t lane = 0; lane < Lanes; ++lane)
+        laneHits[lane] += inCircle(key, first + lane);
+    } // for blocks
+    Counter_t hits = 0;
+    for (std::uint32_t lane = 0; lane < Lanes; ++lane) hits += laneHits[lane];
+    for (Counter_t i = nBlocks * Lanes; i < samples; ++i)
+      hits += inCircle(key, std::uint32_t(i));
+    return hits;
+  } // countHitsVectorized()
+
+} // local namespace
+
 
 lar::ComputePi::ComputePi(const fhicl::ParameterSet& p):
   EDAnalyzer(p),
@@ -102,15 +216,28 @@ lar::ComputePi::ComputePi(const fhicl::ParameterSet& p):
   seed(p.get<Seed_t>("Seed", 314159)),
   bFixed(p.get<bool>("Fixed", false)),
   bVerbose(p.get<bool>("Verbose", false)),
+  nThreads(p.get<unsigned int>("Threads", 0U)),
+  bVectorized(p.get<bool>("Vectorized", false)),
   generator(seed)
 {
-  mf::LogInfo("ComputePi")
+  mf::LogInfo log("ComputePi");
+  log
     << "version " << VersionString
     << " using " << samples << " samples per event, random seed " << seed;
+  if (nThreads > 0) {
+    log << "; parallel mode with " << nThreads << " threads, "
+      << (bVectorized? "vectorized": "scalar") << " kernel";
+  }
 } // lar::ComputePi::ComputePi()
 
 
-void lar::ComputePi::analyze(const art::Event&) {
+void lar::ComputePi::analyze(const art::Event& event) {
+  if (nThreads > 0) analyzeParallel(event);
+  else              analyzeSerial();
+} // lar::ComputePi::analyze()
+
+
+void lar::ComputePi::analyzeSerial() {
 
   // prepare our personal pseudo-random engine;
   // we'll use always the same sequence!
@@ -138,5 +265,81 @@ void lar::ComputePi::analyze(const art::Event&) {
       << " after " << best_pi_tries() << " samples)";
   } // if verbose
 
-} // lar::ComputePi::analyze()
+} // lar::ComputePi::analyzeSerial()
+
+
+void lar::ComputePi::analyzeParallel(const art::Event& event) {
+
+  using Clock_t = std::chrono::steady_clock;
+  using Seconds_t = std::chrono::duration<double>;
+
+  std::uint32_t const eventKey
+    = bFixed? 0U: hash32(std::uint32_t(event.event()));
+
+  std::vector<Counter_t> threadHits(nThreads, 0);
+  std::vector<double> threadTime(nThreads, 0.);
+
+  auto const start = Clock_t::now();
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads);
+  for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+    std::uint32_t const key
+      = hash32(std::uint32_t(seed) ^ hash32(iThread + 1U)) ^ eventKey;
+    threads.emplace_back([this, key, iThread, &threadHits, &threadTime](){
+      auto const threadStart = Clock_t::now();
+      threadHits[iThread] = bVectorized
+        ? countHitsVectorized(key, samples)
+        : countHitsScalar(key, samples);
+      threadTime[iThread] = Seconds_t(Clock_t::now() - threadStart).count();
+    });
+  } // for threads
+  for (std::thread& thread: threads) thread.join();
+  double const wallTime = Seconds_t(Clock_t::now() - start).count();
+
+  Counter_t local_hits = 0;
+  double eventThreadTime = 0.;
+  for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+    local_hits += threadHits[iThread];
+    eventThreadTime += threadTime[iThread];
+  }
+  Counter_t const local_tries = samples * nThreads;
+  hits += local_hits;
+  tries += local_tries;
+  ++nEvents;
+  threadSeconds += eventThreadTime;
+  wallSeconds += wallTime;
+
+  if (bVerbose) {
+    mf::LogInfo log("ComputePi");
+    log << "today's pi = "
+      << std::fixed << std::setprecision(9)
+      << (double(local_hits) / double(local_tries) * 4.0)
+      << " (pi = "
+      << std::fixed << std::setprecision(12) << best_pi()
+      << " after " << best_pi_tries() << " samples)";
+    log << "\n  per thread [Msamples/s]:" << std::setprecision(3);
+    for (unsigned int iThread = 0; iThread < nThreads; ++iThread)
+      log << " " << (samples / threadTime[iThread] / 1e6);
+    log << "\n  aggregate: " << (local_tries / wallTime / 1e6)
+      << " Msamples/s";
+  } // if verbose
+
+} // lar::ComputePi::analyzeParallel()
+
+
+void lar::ComputePi::endJob() {
+
+  if ((nThreads == 0) || (nEvents == 0)) return;
+
+  double const threadSamples = double(samples) * nEvents * nThreads;
+  mf::LogInfo("ComputePi")
+    << nEvents << " events with " << nThreads << " threads ("
+    << (bVectorized? "vectorized": "scalar") << " kernel):"
+    << std::fixed << std::setprecision(3)
+    << "\n  per-core score: " << (threadSamples / threadSeconds / 1e6)
+    << " Msamples/s"
+    << "\n  aggregate score: " << (threadSamples / wallSeconds / 1e6)
+    << " Msamples/s";
+
+} // lar::ComputePi::endJob()
 
@@ -0,0 +1,384 @@
+/**
+ * @file   ConcurrentCountersMap.h
+ * @brief  Map of counters which can be filled from many threads
+ * @date   October 14, 2026
+ * @see    CountersMap.h
+ *
+ * This is a pure header library.
+ */
+
+#ifndef CONCURRENTCOUNTERSMAP_H
+#define CONCURRENTCOUNTERSMAP_H
+
+// LArSoft libraries
+#include "lardata/Utilities/CountersMap.h" // lar::IsPowerOf2()
+
+// C/C++ standard libraries
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <array>
+#include <atomic>
+#include <algorithm> // std::sort()
+#include <functional> // std::hash<>, std::less<>
+#include <iterator> // std::forward_iterator_tag
+#include <map>
+#include <memory> // std::unique_ptr<>, std::shared_ptr<>
+#include <mutex> // std::unique_lock<>
+#include <shared_mutex>
+#include <type_traits> // std::make_unsigned_t<>
+#include <unordered_map>
+#include <utility> // std::pair<>
+#include <vector>
+
+
+namespace lar {
+
+  namespace details {
+
+    /// Block of counters which can be changed concurrently
+    template <typename COUNTER, std::size_t NCounters>
+    struct AtomicCounterBlock {
+      using Counter_t = COUNTER;
+
+      /// The counters, initialized to 0
+      std::array<std::atomic<Counter_t>, NCounters> counters;
+
+      AtomicCounterBlock()
+        { for (auto& counter: counters) counter.store(0, std::memory_order_relaxed); }
+
+      /// Returns the current value of the counter with the specified index
+      Counter_t load(std::size_t index) const
+        { return counters[index].load(std::memory_order_relaxed); }
+
+    }; // AtomicCounterBlock
+
+  } // namespace details
+
+
+  /**
+   * @brief Map of counters which can be changed from many threads
+   * @param KEY the type of the key of the counters map
+   * @param COUNTER the type of a basic counter (must be suitable for atomics)
+   * @param BLOCKSIZE the number of counters in a cluster
+   * @param NSTRIPES number of independently locked parts of the block index
+   *
+   * This is the concurrent version of `lar::CountersMap`: as the latter, the
+   * counters are allocated in blocks of contiguous keys, created on demand.
+   * All the methods changing or reading counters (`increment()`,
+   * `decrement()`, `add()`, `set()`, `operator[]`) can be called at the same
+   * time from different threads:
+   *  * the counters are atomic, and changing a counter never takes a lock;
+   *  * the blocks are indexed in a hash map split in NSTRIPES stripes, each
+   *    with its own lock; finding an existing block takes a shared lock on
+   *    its stripe only, and creating a block an exclusive one;
+   *  * the blocks are never moved nor deleted until `clear()` or destruction.
+   *
+   * Only `clear()` (and assignment or destruction) must not run concurrently
+   * with anything else.
+   *
+   * Iteration is in key order, on a snapshot of the blocks taken at
+   * `begin()`: it stays valid while counts are being added; the counters are
+   * read live when dereferencing the iterator, and blocks created after the
+   * snapshot are not visited.
+   *
+   * Counting is relaxed: the counts are exact, but updates on different
+   * counters are not ordered with respect to each other. The final values are
+   * guaranteed to be visible after the filling threads are joined.
+   *
+   * Example with parallel hit finding:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * lar::ConcurrentCountersMap<int, unsigned int, 32> occupancy;
+   * // in each task:
+   * occupancy.increment(hit.Channel());
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <
+    typename KEY,
+    typename COUNTER,
+    std::size_t SIZE,
+    std::size_t NSTRIPES = 64
+    >
+  class ConcurrentCountersMap {
+    static_assert(IsPowerOf2(SIZE),
+      "the size of the cluster of counters must be a power of 2");
+    static_assert(NSTRIPES > 0, "at least one stripe is needed");
+
+      public:
+    using Key_t = KEY; ///< type of counter key in the map
+    using Counter_t = COUNTER; ///< type of the single counter
+
+    /// Number of counters in one counter block
+    static constexpr std::size_t NCounters = SIZE;
+
+    /// Number of independently locked parts of the block index
+    static constexpr std::size_t NStripes = NSTRIPES;
+
+    /// Type of block of counters
+    using CounterBlock_t = details::AtomicCounterBlock<Counter_t, NCounters>;
+
+    using mapped_type = Counter_t;
+    using value_type = std::pair<const Key_t, Counter_t>;
+
+    /// Forward iterator through the counters (shown as value_type)
+    class const_iterator;
+
+
+    /// Default constructor (empty map)
+    ConcurrentCountersMap() = default;
+
+    ConcurrentCountersMap(ConcurrentCountersMap const&) = delete;
+    ConcurrentCountersMap& operator= (ConcurrentCountersMap const&) = delete;
+
+
+    /// Read-only access to an element; returns 0 if no counter is present
+    Counter_t operator[] (Key_t key) const
+      {
+        CounterBlock_t const* block = findBlock(blockKey(key));
+        return block? block->load(counterIndex(key)): 0;
+      }
+
+    /// Adds delta to the specified counter; returns its new value
+    Counter_t add(Key_t key, Counter_t delta)
+      {
+        auto& counter = getOrCreateBlock(blockKey(key))
+          .counters[counterIndex(key)];
+        return counter.fetch_add(delta, std::memory_order_relaxed) + delta;
+      }
+
+    /// Increments by 1 the specified counter; returns its new value
+    Counter_t increment(Key_t key) { return add(key, Counter_t(1)); }
+
+    /// Decrements by 1 the specified counter; returns its new value
+    Counter_t decrement(Key_t key)
+      {
+        auto& counter = getOrCreateBlock(blockKey(key))
+          .counters[counterIndex(key)];
+        return counter.fetch_sub(1, std::memory_order_relaxed) - 1;
+      }
+
+    /// Sets the specified counter to a count; returns the value
+    Counter_t set(Key_t key, Counter_t value)
+      {
+        getOrCreateBlock(blockKey(key)).counters[counterIndex(key)]
+          .store(value, std::memory_order_relaxed);
+        return value;
+      }
+
+
+    /// Returns an iterator to the begin of the counters (takes a snapshot)
+    const_iterator begin() const;
+
+    /// Returns an iterator past-the-end of the counters
+    const_iterator end() const { return {}; }
+
+
+    /// Returns whether the map has no counters
+    bool empty() const { return n_blocks() == 0; }
+
+    /// Returns the number of allocated counters
+    std::size_t n_counters() const { return n_blocks() * NCounters; }
+
+    /// Removes all the counters (not thread-safe)
+    void clear()
+      {
+        for (Stripe_t& stripe: stripes) stripe.blocks.clear();
+        nBlocks.store(0, std::memory_order_relaxed);
+      }
+
+
+    /**
+     * @brief Returns whether the counters in this map are equivalent to another
+     * @param to a STL map
+     * @return whether the counters are equivalent
+     * @see `lar::CountersMap::is_equal()`
+     *
+     * The counters in this map which are not in the other must be 0.
+     * The comparison is meaningful only when no counter is changing.
+     */
+    template <typename OALLOC>
+    bool is_equal
+      (std::map<Key_t, Counter_t, std::less<Key_t>, OALLOC> const& to) const;
+
+
+      private:
+    using UKey_t = std::make_unsigned_t<Key_t>; ///< type for key arithmetic
+
+    /// Bit mask for the index of the counter in the block
+    static constexpr UKey_t IndexMask = UKey_t(NCounters - 1);
+
+    /// One part of the block index, with its own lock
+    struct Stripe_t {
+      mutable std::shared_mutex mutex; ///< protects the index
+      std::unordered_map<Key_t, std::unique_ptr<CounterBlock_t>> blocks;
+    }; // Stripe_t
+
+    std::array<Stripe_t, NStripes> stripes; ///< the block index
+    std::atomic<std::size_t> nBlocks { 0 }; ///< number of blocks
+
+    /// Type of the list of blocks iterators run through
+    using Snapshot_t = std::vector<std::pair<Key_t, CounterBlock_t const*>>;
+
+
+    std::size_t n_blocks() const
+      { return nBlocks.load(std::memory_order_relaxed); }
+
+    /// Returns the key of the block including the counter with `key`
+    static Key_t blockKey(Key_t key) { return Key_t(UKey_t(key) & ~IndexMask); }
+
+    /// Returns the index of the counter with `key` in its block
+    static std::size_t counterIndex(Key_t key)
+      { return std::size_t(UKey_t(key) & IndexMask); }
+
+    /// Returns the stripe in charge of the block with the specified key
+    Stripe_t& stripeOf(Key_t block)
+      { return stripes[stripeIndex(block)]; }
+    Stripe_t const& stripeOf(Key_t block) const
+      { return stripes[stripeIndex(block)]; }
+    static std::size_t stripeIndex(Key_t block)
+      {
+        // contiguous blocks go to different stripes
+        return std::hash<UKey_t>()(UKey_t(block) / NCounters) % NStripes;
+      }
+
+    /// Returns the block with the specified key, nullptr if not present
+    CounterBlock_t const* findBlock(Key_t block) const
+      {
+        Stripe_t const& stripe = stripeOf(block);
+        std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+        auto const iBlock = stripe.blocks.find(block);
+        return (iBlock == stripe.blocks.end())? nullptr: iBlock->second.get();
+      }
+
+    /// Returns the block with the specified key, created if not present
+    CounterBlock_t& getOrCreateBlock(Key_t block)
+      {
+        Stripe_t& stripe = stripeOf(block);
+        {
+          std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+          auto const iBlock = stripe.blocks.find(block);
+          if (iBlock != stripe.blocks.end()) return *(iBlock->second);
+        }
+        std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+        auto& pBlock = stripe.blocks[block]; // another thread may have made it
+        if (!pBlock) {
+          pBlock = std::make_unique<CounterBlock_t>();
+          nBlocks.fetch_add(1, std::memory_order_relaxed);
+        }
+        return *pBlock;
+      }
+
+    /// Returns the list of the current blocks, sorted by key
+    std::shared_ptr<Snapshot_t const> snapshot() const;
+
+  }; // class ConcurrentCountersMap
+
+
+  //----------------------------------------------------------------------------
+  template <typename K, typename C, std::size_t S, std::size_t NS>
+  class ConcurrentCountersMap<K, C, S, NS>::const_iterator {
+    friend ConcurrentCountersMap<K, C, S, NS>;
+
+      public:
+    using value_type = typename ConcurrentCountersMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type const*;
+    using reference = value_type; // values do not exist in memory
+    using iterator_category = std::forward_iterator_tag;
+
+    /// Default constructor: past-the-end iterator
+    const_iterator() = default;
+
+    /// Returns the pointed pair (the counter is read at this time)
+    value_type operator*() const
+      {
+        auto const& block = (*blocks)[iBlock];
+        return { Key_t(block.first + Key_t(index)), block.second->load(index) };
+      }
+
+    const_iterator& operator++()
+      {
+        if (++index == NCounters) { ++iBlock; index = 0; }
+        return *this;
+      }
+    const_iterator operator++(int)
+      { const_iterator old(*this); operator++(); return old; }
+
+    /// Iterators are equal if both are at the end, or at the same counter
+    bool operator== (const_iterator const& as) const
+      {
+        if (atEnd() || as.atEnd()) return atEnd() && as.atEnd();
+        return (blocks == as.blocks)
+          && (iBlock == as.iBlock) && (index == as.index);
+      }
+    bool operator!= (const_iterator const& as) const
+      { return !operator==(as); }
+
+      private:
+    std::shared_ptr<Snapshot_t const> blocks; ///< the blocks to go through
+    std::size_t iBlock = 0; ///< index of the current block
+    std::size_t index = 0; ///< index of the counter in the block
+
+    explicit const_iterator(std::shared_ptr<Snapshot_t const> blocks)
+      : blocks(std::move(blocks)) {}
+
+    bool atEnd() const { return !blocks || (iBlock >= blocks->size()); }
+
+  }; // ConcurrentCountersMap<>::const_iterator
+
+
+  //----------------------------------------------------------------------------
+  template <typename K, typename C, std::size_t S, std::size_t NS>
+  constexpr std::size_t ConcurrentCountersMap<K, C, S, NS>::NCounters;
+
+  template <typename K, typename C, std::size_t S, std::size_t NS>
+  constexpr std::size_t ConcurrentCountersMap<K, C, S, NS>::NStripes;
+
+
+  template <typename K, typename C, std::size_t S, std::size_t NS>
+  typename ConcurrentCountersMap<K, C, S, NS>::const_iterator
+    ConcurrentCountersMap<K, C, S, NS>::begin() const
+    { return const_iterator(snapshot()); }
+
+
+  template <typename K, typename C, std::size_t S, std::size_t NS>
+  auto ConcurrentCountersMap<K, C, S, NS>::snapshot() const
+    -> std::shared_ptr<Snapshot_t const>
+  {
+    auto blocks = std::make_shared<Snapshot_t>();
+    blocks->reserve(n_blocks());
+    for (Stripe_t const& stripe: stripes) {
+      std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+      for (auto const& block: stripe.blocks)
+        blocks->emplace_back(block.first, block.second.get());
+    } // for
+    std::sort(blocks->begin(), blocks->end(),
+      [](auto const& a, auto const& b){ return a.first < b.first; });
+    return blocks;
+  } // ConcurrentCountersMap<>::snapshot()
+
+
+  template <typename K, typename C, std::size_t S, std::size_t NS>
+  template <typename OALLOC>
+  bool ConcurrentCountersMap<K, C, S, NS>::is_equal
+    (std::map<Key_t, Counter_t, std::less<Key_t>, OALLOC> const& to) const
+  {
+    auto iTo = to.begin(), toEnd = to.end();
+    for (value_type const p: *this) {
+      if (iTo != toEnd) {
+        if (p.first > iTo->first) return false; // missing in this map
+        if (p.first == iTo->first) {
+          if (p.second != iTo->second) return false;
+          ++iTo;
+          continue;
+        }
+      }
+      if (p.second != 0) return false; // extra in this map
+    } // for
+    // all the remaining counters in the other map must be missing here
+    return iTo == toEnd;
+  } // ConcurrentCountersMap<>::is_equal()
+
+
+} // namespace lar
+
+
+#endif // CONCURRENTCOUNTERSMAP_H
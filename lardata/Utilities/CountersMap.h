@@ -11,8 +11,11 @@
 // interface include
 #include <cstddef> // std::ptrdiff_t
 #include <map>
+#include <vector>
 #include <array>
+#include <algorithm> // std::min(), std::max(), std::fill()
 #include <functional> // std::less<>
+#include <limits> // std::numeric_limits<>
 #include <memory> // std::allocator<>
 #include <utility> // std::pair<>
 #include <iterator> // std::bidirectional_iterator_tag
@@ -31,7 +34,7 @@ namespace lar {
 
   namespace details {
 
-    /// Type of block of counters (just a STL array until SUBCOUNTERS are in)
+    /// Type of block of counters (subcounters are packed in the counters)
     template <typename COUNTER, std::size_t NCounters>
     class CounterBlock: public std::array<COUNTER, NCounters> {
         public:
@@ -88,17 +91,237 @@ namespace lar {
 
     }; // struct CountersMapTraits
 
+
+    /**
+     * @brief Block storage based on a STL map
+     * @tparam KEY type of the key of the blocks
+     * @tparam BLOCK type of block of counters
+     * @tparam ALLOC allocator (rebound to the map value)
+     * @tparam STEP difference between the keys of two contiguous blocks
+     *
+     * Block lookup has logarithmic complexity, and the blocks can be anywhere
+     * in the range of keys.
+     */
+    template <typename KEY, typename BLOCK, typename ALLOC, std::size_t STEP>
+    class MapBlockStorage {
+        public:
+      using Key_t = KEY; ///< type of block key
+      using Block_t = BLOCK; ///< type of block of counters
+
+      /// Type of the map used in the implementation
+      using Map_t = std::map<Key_t, Block_t, std::less<Key_t>,
+        typename std::allocator_traits<ALLOC>::template rebind_alloc
+          <std::pair<const Key_t, Block_t>>
+        >;
+      using allocator_type = typename Map_t::allocator_type;
+
+      /// Iterator through the blocks, in key order
+      class const_iterator {
+          public:
+        const_iterator() = default;
+        explicit const_iterator(typename Map_t::const_iterator it): iter(it) {}
+
+        Key_t key() const { return iter->first; } ///< key of the block
+        Block_t const& block() const { return iter->second; } ///< the block
+
+        const_iterator& operator++() { ++iter; return *this; }
+        const_iterator& operator--() { --iter; return *this; }
+        bool operator== (const_iterator const& as) const
+          { return iter == as.iter; }
+        bool operator!= (const_iterator const& as) const
+          { return iter != as.iter; }
+
+          private:
+        typename Map_t::const_iterator iter;
+      }; // const_iterator
+
+
+      MapBlockStorage() = default;
+      explicit MapBlockStorage(allocator_type const& alloc): blocks(alloc) {}
+
+      /// Returns whether there is no block
+      bool empty() const { return blocks.empty(); }
+
+      /// Returns the number of blocks
+      std::size_t size() const { return blocks.size(); }
+
+      /// Returns the block with the specified key, nullptr if not present
+      Block_t const* find(Key_t key) const
+        {
+          auto const iBlock = blocks.find(key);
+          return (iBlock == blocks.end())? nullptr: &(iBlock->second);
+        }
+
+      /// Returns the block with the specified key, created if not present
+      Block_t& get_or_create(Key_t key)
+        {
+          auto iBlock = blocks.lower_bound(key);
+          if ((iBlock != blocks.end()) && (iBlock->first == key))
+            return iBlock->second;
+          // hint to insert before the block in the position we have already
+          // found (this is optimal in STL map for C++11)
+          return blocks.emplace_hint(iBlock, key, Block_t())->second;
+        }
+
+      const_iterator begin() const { return const_iterator(blocks.begin()); }
+      const_iterator end() const { return const_iterator(blocks.end()); }
+
+        private:
+      Map_t blocks; ///< the blocks
+    }; // MapBlockStorage<>
+
+
+    /**
+     * @brief Block storage based on a vector covering all the key range
+     * @tparam KEY type of the key of the blocks
+     * @tparam BLOCK type of block of counters
+     * @tparam ALLOC allocator (rebound to the block)
+     * @tparam STEP difference between the keys of two contiguous blocks
+     *
+     * The blocks are stored contiguously, from the one with the lowest key to
+     * the one with the highest, including the blocks in between which have
+     * never been used. Block lookup is a subtraction and a division, and
+     * iteration is a walk through contiguous memory.
+     * The memory is proportional to the range of the keys rather than to the
+     * number of used blocks: this storage is good for dense keys, like
+     * channel or wire numbers.
+     */
+    template <typename KEY, typename BLOCK, typename ALLOC, std::size_t STEP>
+    class DenseBlockStorage {
+        public:
+      using Key_t = KEY; ///< type of block key
+      using Block_t = BLOCK; ///< type of block of counters
+
+      using allocator_type
+        = typename std::allocator_traits<ALLOC>::template rebind_alloc<Block_t>;
+
+      /// Iterator through the used blocks, in key order
+      class const_iterator {
+          public:
+        const_iterator() = default;
+        const_iterator(DenseBlockStorage const* storage, std::size_t index):
+          storage(storage), index(index) {}
+
+        Key_t key() const { return storage->keyAt(index); } ///< key of block
+        Block_t const& block() const { return storage->blocks[index]; }
+
+        const_iterator& operator++()
+          {
+            while ((++index < storage->used.size()) && !storage->used[index]);
+            return *this;
+          }
+        const_iterator& operator--()
+          { while (!storage->used[--index]); return *this; }
+        bool operator== (const_iterator const& as) const
+          { return index == as.index; }
+        bool operator!= (const_iterator const& as) const
+          { return index != as.index; }
+
+          private:
+        DenseBlockStorage const* storage = nullptr;
+        std::size_t index = 0;
+      }; // const_iterator
+
+
+      DenseBlockStorage() = default;
+      explicit DenseBlockStorage(allocator_type const& alloc): blocks(alloc) {}
+
+      /// Returns whether there is no block
+      bool empty() const { return nUsed == 0; }
+
+      /// Returns the number of used blocks
+      std::size_t size() const { return nUsed; }
+
+      /// Returns the block with the specified key, nullptr if not present
+      Block_t const* find(Key_t key) const
+        {
+          if (blocks.empty() || (key < firstKey)) return nullptr;
+          std::size_t const index = indexOf(key);
+          return ((index < blocks.size()) && used[index])
+            ? &(blocks[index]): nullptr;
+        }
+
+      /// Returns the block with the specified key, created if not present
+      Block_t& get_or_create(Key_t key)
+        {
+          if (blocks.empty()) firstKey = key;
+          else if (key < firstKey) {
+            // room to grow downward too, so repeated extensions are amortized
+            std::size_t const nMissing = (UKey_t(firstKey) - UKey_t(key)) / STEP;
+            std::size_t const room = (UKey_t(firstKey)
+              - UKey_t(std::numeric_limits<Key_t>::min())) / STEP;
+            std::size_t const nAdded
+              = std::min(std::max(nMissing, blocks.size()), room);
+            blocks.insert(blocks.begin(), nAdded, Block_t());
+            used.insert(used.begin(), nAdded, false);
+            firstKey = Key_t(UKey_t(firstKey) - UKey_t(nAdded * STEP));
+          }
+          std::size_t const index = indexOf(key);
+          if (index >= blocks.size()) {
+            blocks.resize(index + 1);
+            used.resize(index + 1, false);
+          }
+          if (!used[index]) {
+            used[index] = true;
+            ++nUsed;
+          }
+          return blocks[index];
+        }
+
+      const_iterator begin() const
+        {
+          const_iterator it(this, 0U);
+          return (used.empty() || used.front())? it: ++it;
+        }
+      const_iterator end() const { return { this, used.size() }; }
+
+        private:
+      std::vector<Block_t, allocator_type> blocks; ///< all the blocks in range
+      std::vector<bool> used; ///< whether each block has ever been used
+      std::size_t nUsed = 0; ///< number of used blocks
+      Key_t firstKey = 0; ///< key of the first block
+
+      using UKey_t = std::make_unsigned_t<Key_t>; ///< for offset arithmetic
+
+      std::size_t indexOf(Key_t key) const
+        { return (UKey_t(key) - UKey_t(firstKey)) / STEP; }
+      Key_t keyAt(std::size_t index) const
+        { return Key_t(UKey_t(firstKey) + UKey_t(index * STEP)); }
+
+    }; // DenseBlockStorage<>
+
+
   } // namespace details
 
 
+  /// Storage policies for the blocks of `lar::CountersMap`
+  namespace counters_map {
+
+    /// Blocks in a STL map (default): any key distribution
+    struct MapStorage {
+      template <typename Key, typename Block, typename Alloc, std::size_t Step>
+      using Storage_t = details::MapBlockStorage<Key, Block, Alloc, Step>;
+    }; // MapStorage
+
+    /// Blocks in a vector covering the key range: dense keys (e.g. channels)
+    struct DenseStorage {
+      template <typename Key, typename Block, typename Alloc, std::size_t Step>
+      using Storage_t = details::DenseBlockStorage<Key, Block, Alloc, Step>;
+    }; // DenseStorage
+
+  } // namespace counters_map
+
+
 
   /**
    * @brief Map storing counters in a compact way
    * @param KEY the type of the key of the counters map
    * @param COUNTER the type of a basic counter (can be signed or unsigned)
    * @param BLOCKSIZE the number of counters in a cluster
-   * @param ALLOC allocator for the underlying STL map
-   * @param SUBCOUNTERS split each counter in subcounters (not implemented yet)
+   * @param ALLOC allocator for the underlying storage
+   * @param SUBCOUNTERS split each counter in subcounters
+   * @param STORAGE how to store the blocks (`lar::counters_map::MapStorage`
+   *                or `lar::counters_map::DenseStorage`)
    *
    * This class is designed for the need of a vast number of counters with
    * a integral numerical key, when the counter keys are usually clustered.
@@ -117,15 +340,25 @@ namespace lar {
    * "next counter" is well defined and we can store contiguous counters
    * in a fixed structure.
    *
+   * <h3>Storage</h3>
+   * By default the blocks are stored in a STL map, and finding a block takes
+   * a tree traversal. With `lar::counters_map::DenseStorage` the blocks are
+   * stored in a vector spanning from the lowest to the highest key, and
+   * finding a block is a direct index computation; this is faster, but it
+   * takes memory for the whole key range, and it is meant for dense keys
+   * like channel or wire numbers (see `lar::DenseCountersMap`).
+   *
    * <h3>Subcounters</h3>
    * The idea behind subcounters is that you migt want to split a counter into
    * subcounters to save memory if the maximum counter value is smaller than
    * the range of the counter type.
-   * <strong>The implementation is delayed</strong> since in the end the same
-   * effect can be achieved by using a small counter type (e.g. signed char),
-   * unless the range is smaller that 16 (or 4, or 2), in which case the
-   * character can be split into bits. That will cause some overhead for
-   * increment and decrement instructions.
+   * With SUBCOUNTERS larger than 1, each counter (which must be of unsigned
+   * type) is split into SUBCOUNTERS fields of equal bit width, each one
+   * working as an independent counter; for example, 4 subcounters of an
+   * `unsigned char` count from 0 to 3. Increments and decrements wrap within
+   * the subcounter range; values set are truncated to that range.
+   * Each block holds BLOCKSIZE counters, that is BLOCKSIZE * SUBCOUNTERS
+   * subcounters.
    */
   template <
     typename KEY,
@@ -133,12 +366,18 @@ namespace lar {
     size_t SIZE,
     typename ALLOC
       = typename details::CountersMapTraits<KEY, COUNTER, SIZE>::DefaultAllocator_t,
-    unsigned int SUBCOUNTERS=1
+    unsigned int SUBCOUNTERS=1,
+    typename STORAGE = counters_map::MapStorage
     >
   class CountersMap {
-    static_assert(SUBCOUNTERS == 1, "subcounters not implemented yet");
     static_assert(IsPowerOf2(SIZE),
       "the size of the cluster of counters must be a power of 2");
+    static_assert(IsPowerOf2(SUBCOUNTERS),
+      "the number of subcounters must be a power of 2");
+    static_assert((SUBCOUNTERS == 1) || std::is_unsigned<COUNTER>::value,
+      "subcounters require an unsigned counter type");
+    static_assert(SUBCOUNTERS <= sizeof(COUNTER) * 8,
+      "subcounters must be at least one bit wide");
 
     /// Set of data types pertaining this counter.
     using Traits_t = details::CountersMapTraits<KEY, COUNTER, SIZE>;
@@ -149,7 +388,8 @@ namespace lar {
     using Allocator_t = ALLOC; ///< type of the single counter
 
     /// This class
-    using CounterMap_t = CountersMap<KEY, COUNTER, SIZE, ALLOC, SUBCOUNTERS>;
+    using CounterMap_t
+      = CountersMap<KEY, COUNTER, SIZE, ALLOC, SUBCOUNTERS, STORAGE>;
 
 
     /// Number of counters in one counter block
@@ -164,11 +404,9 @@ namespace lar {
 
     using CounterBlock_t = typename Traits_t::CounterBlock_t;
 
-    /// Type of the map used in the implementation
-    using BaseMap_t = typename Traits_t::template BaseMap_t<
-      typename std::allocator_traits<Allocator_t>::template rebind_alloc
-        <typename Traits_t::MapValue_t>
-      >;
+    /// Type of the block storage used in the implementation
+    using BaseMap_t = typename STORAGE::template Storage_t
+      <Key_t, CounterBlock_t, Allocator_t, NSubcounters>;
 
     /*
     /// Iterator through the allocated elements
@@ -195,7 +433,8 @@ namespace lar {
     CountersMap() {}
 
     /// Constructor, specifies an allocator
-    CountersMap(Allocator_t alloc): BaseMap_t(alloc) {}
+    CountersMap(Allocator_t alloc)
+      : counter_map(typename BaseMap_t::allocator_type(alloc)) {}
 
 
     /// Read-only access to an element; returns 0 if no counter is present
@@ -228,6 +467,18 @@ namespace lar {
      */
     SubCounter_t decrement(Key_t key);
 
+    /**
+     * @brief Adds all the counts of another map to this one
+     * @param other the map with the counts to be added
+     * @return this map
+     *
+     * Counters present only in `other` are created. The sums are exact, so
+     * maps filled with parts of the data (e.g. by different threads, see
+     * `lar::util::deterministicReduce()`) can be merged in any order.
+     * No check is performed on overflow.
+     */
+    CounterMap_t& merge(CounterMap_t const& other);
+
 
     ///@{
     /// @name Iterators (experimental)
@@ -363,9 +614,7 @@ namespace lar {
     Counter_t GetCounter(CounterKey_t key) const;
 
     /// Returns the value of the subcounter at the specified split key
-    // Since subcounters are not implemented yet, this is a no-op
-    SubCounter_t GetSubCounter(CounterKey_t key) const
-      { return GetCounter(key); }
+    SubCounter_t GetSubCounter(CounterKey_t key) const;
 
     /// Returns the counter at the specified split key
     Counter_t& GetOrCreateCounter(CounterKey_t key);
@@ -379,6 +628,19 @@ namespace lar {
       (typename BaseMap_t::const_iterator it, size_t ix)
       { return { it, ix }; }
 
+
+    /// Number of bits of each subcounter
+    static constexpr unsigned int SubCounterBits
+      = sizeof(Counter_t) * 8 / SUBCOUNTERS;
+
+    /// Returns the value of the subcounter with the index in the block
+    static SubCounter_t ReadSubCounter
+      (CounterBlock_t const& block, CounterIndex_t index);
+
+    /// Sets the subcounter with the index in the block; returns the new value
+    static SubCounter_t WriteSubCounter
+      (CounterBlock_t& block, CounterIndex_t index, SubCounter_t value);
+
       private:
 
     /// Sets the specified counter to a value (no check on value range)
@@ -390,6 +652,20 @@ namespace lar {
   }; // class CountersMap
 
 
+  /// A `lar::CountersMap` with the blocks stored densely in a vector
+  template <
+    typename KEY,
+    typename COUNTER,
+    size_t SIZE,
+    unsigned int SUBCOUNTERS = 1
+    >
+  using DenseCountersMap = CountersMap<
+    KEY, COUNTER, SIZE,
+    typename details::CountersMapTraits<KEY, COUNTER, SIZE>::DefaultAllocator_t,
+    SUBCOUNTERS, counters_map::DenseStorage
+    >;
+
+
 } // namespace lar
 
 
@@ -420,22 +696,22 @@ namespace lar {
   // (or else the reference would not be needed).
   // I am not providing the same for the protected and private members
   // (just because of laziness).
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  constexpr size_t CountersMap<K, C, S, A, SUB>::NCounters;
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  constexpr size_t CountersMap<K, C, S, A, SUB, ST>::NCounters;
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  constexpr size_t CountersMap<K, C, S, A, SUB>::NSubcounters;
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  constexpr size_t CountersMap<K, C, S, A, SUB, ST>::NSubcounters;
 
 
   // CountersMap<>::const_iterator does not fully implement the STL iterator
   // interface, since it does not implement operator-> () (for technical reason:
   // the value does not actually exist and it does not have an address),
   // in addition to std::swap().
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  class CountersMap<K, C, S, A, SUB>::const_iterator:
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  class CountersMap<K, C, S, A, SUB, ST>::const_iterator:
     public std::bidirectional_iterator_tag
   {
-    friend CountersMap<K, C, S, A, SUB>;
+    friend CountersMap<K, C, S, A, SUB, ST>;
 
       public:
     using value_type = typename CounterMap_t::value_type; ///< value type: pair
@@ -450,7 +726,8 @@ namespace lar {
     const_iterator() = default;
 
     /// Access to the pointed pair
-    value_type operator*() const { return { key(), iter->second[index] }; }
+    value_type operator*() const
+      { return { key(), ReadSubCounter(iter.block(), index) }; }
 
     iterator_type& operator++()
       {
@@ -476,7 +753,7 @@ namespace lar {
 
 
     /// Returns the key of the pointed item as a CounterKey_t
-    CounterKey_t key() const { return { iter->first, index }; }
+    CounterKey_t key() const { return { iter.key(), index }; }
 
       protected:
     typename BaseMap_t::const_iterator iter;
@@ -490,36 +767,47 @@ namespace lar {
   }; // CountersMap<>::const_iterator
 
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::SubCounter_t
-    CountersMap<K, C, S, A, SUB>::set(Key_t key, SubCounter_t value)
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::set(Key_t key, SubCounter_t value)
     { return unchecked_set(CounterKey_t(key), value); }
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::SubCounter_t
-    CountersMap<K, C, S, A, SUB>::increment(Key_t key)
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::increment(Key_t key)
     { return unchecked_add(CounterKey_t(key), +1); }
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::SubCounter_t
-    CountersMap<K, C, S, A, SUB>::decrement(Key_t key)
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::decrement(Key_t key)
     { return unchecked_add(CounterKey_t(key), -1); }
 
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::const_iterator
-    CountersMap<K, C, S, A, SUB>::begin() const
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  auto CountersMap<K, C, S, A, SUB, ST>::merge(CounterMap_t const& other)
+    -> CounterMap_t&
+  {
+    for (const typename const_iterator::value_type& p: other) {
+      if (p.second != 0) unchecked_add(CounterKey_t(p.first), p.second);
+    }
+    return *this;
+  } // CountersMap<>::merge()
+
+
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::const_iterator
+    CountersMap<K, C, S, A, SUB, ST>::begin() const
     { return const_iterator{ counter_map.begin(), 0 }; }
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::const_iterator
-    CountersMap<K, C, S, A, SUB>::end() const
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::const_iterator
+    CountersMap<K, C, S, A, SUB, ST>::end() const
     { return const_iterator{ counter_map.end(), 0 }; }
 
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
   template <typename OALLOC>
-  bool CountersMap<K, C, S, A, SUB>::is_equal(
+  bool CountersMap<K, C, S, A, SUB, ST>::is_equal(
     const std::map<Key_t, SubCounter_t, std::less<Key_t>, OALLOC>& to,
     Key_t& first_difference
   ) const {
@@ -587,68 +875,82 @@ namespace lar {
   } // CountersMap<>::is_equal()
 
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::Counter_t
-    CountersMap<K, C, S, A, SUB>::GetCounter(CounterKey_t key) const
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::Counter_t
+    CountersMap<K, C, S, A, SUB, ST>::GetCounter(CounterKey_t key) const
   {
-    typename BaseMap_t::const_iterator iBlock = counter_map.find(key.block);
-    return (iBlock == counter_map.end())? 0: iBlock->second[key.counter];
+    CounterBlock_t const* block = counter_map.find(key.block);
+    return block? (*block)[key.counter / SUB]: 0;
   } // CountersMap<>::GetCounter() const
 
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  inline typename CountersMap<K, C, S, A, SUB>::Counter_t&
-    CountersMap<K, C, S, A, SUB>::GetOrCreateCounter(CounterKey_t key)
-    { return counter_map[key.block][key.counter]; }
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::GetSubCounter(CounterKey_t key) const
+  {
+    CounterBlock_t const* block = counter_map.find(key.block);
+    return block? ReadSubCounter(*block, key.counter): 0;
+  } // CountersMap<>::GetSubCounter() const
 
 
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  typename CountersMap<K, C, S, A, SUB>::SubCounter_t
-    CountersMap<K, C, S, A, SUB>::unchecked_set
-    (CounterKey_t key, SubCounter_t value)
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::Counter_t&
+    CountersMap<K, C, S, A, SUB, ST>::GetOrCreateCounter(CounterKey_t key)
+    { return counter_map.get_or_create(key.block)[key.counter / SUB]; }
+
+
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::ReadSubCounter
+    (CounterBlock_t const& block, CounterIndex_t index)
   {
-    // take it low level here
-    // first get the iterator to the block
-    typename BaseMap_t::iterator iBlock = counter_map.lower_bound(key.block);
-    if (iBlock != counter_map.end()) {
-      if (iBlock->first == key.block) { // sweet, we have that counter already
-        return iBlock->second[key.counter] = value;
-      }
+    if constexpr (SUB == 1) return block[index];
+    else {
+      constexpr Counter_t Mask = (Counter_t(1) << SubCounterBits) - 1;
+      return (block[index / SUB] >> ((index % SUB) * SubCounterBits)) & Mask;
     }
-    // no counter there yet: create one;
-    // hint to insert before the block in the position we jave already found
-    // (this is optimal in STL map for C++11);
-    // create a block using the special constructor;
-    // the temporary value created here is moved to the map
-    counter_map.insert(iBlock, { key.block, { key.counter, value } } );
-    return value;
-  } // CountersMap<>::unchecked_add() const
-
-
-  template <typename K, typename C, size_t S, typename A, unsigned int SUB>
-  typename CountersMap<K, C, S, A, SUB>::SubCounter_t
-    CountersMap<K, C, S, A, SUB>::unchecked_add
-    (CounterKey_t key, SubCounter_t delta)
+  } // CountersMap<>::ReadSubCounter()
+
+
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  inline typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::WriteSubCounter
+    (CounterBlock_t& block, CounterIndex_t index, SubCounter_t value)
   {
-    // take it low level here
-    // first get the iterator to the block
-    typename BaseMap_t::iterator iBlock = counter_map.lower_bound(key.block);
-    if (iBlock != counter_map.end()) {
-      if (iBlock->first == key.block) { // sweet, we have that counter already
-        return iBlock->second[key.counter] += delta;
-      }
+    if constexpr (SUB == 1) return block[index] = value;
+    else {
+      constexpr Counter_t Mask = (Counter_t(1) << SubCounterBits) - 1;
+      unsigned int const shift = (index % SUB) * SubCounterBits;
+      Counter_t& counter = block[index / SUB];
+      value &= Mask;
+      counter = (counter & ~Counter_t(Mask << shift)) | Counter_t(value << shift);
+      return value;
     }
-    // no counter there yet: create one;
-    // hint to insert before the block in the position we jave already found
-    // (this is optimal in STL map for C++11);
-    // create a block using the special constructor;
-    // the temporary value created here is moved to the map
-    counter_map.insert(iBlock, { key.block, { key.counter, delta } } );
-    return delta;
-  } // CountersMap<>::unchecked_add() const
+  } // CountersMap<>::WriteSubCounter()
+
+
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::unchecked_set
+    (CounterKey_t key, SubCounter_t value)
+  {
+    return WriteSubCounter
+      (counter_map.get_or_create(key.block), key.counter, value);
+  } // CountersMap<>::unchecked_set()
+
+
+  template <typename K, typename C, size_t S, typename A, unsigned int SUB, typename ST>
+  typename CountersMap<K, C, S, A, SUB, ST>::SubCounter_t
+    CountersMap<K, C, S, A, SUB, ST>::unchecked_add
+    (CounterKey_t key, SubCounter_t delta)
+  {
+    CounterBlock_t& block = counter_map.get_or_create(key.block);
+    return WriteSubCounter
+      (block, key.counter, ReadSubCounter(block, key.counter) + delta);
+  } // CountersMap<>::unchecked_add()
 
 
 } // namespace lar
 
 
-#endif // BULKALLOCATOR_H
+#endif // COUNTERSMAP_H
@@ -13,8 +13,17 @@
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "lardata/Utilities/RunValueCache.h"
 #include <libpq-fe.h>
 
+#include <deque>
+#include <future> // std::shared_future
+#include <map>
+#include <set>
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
 ///General LArSoft Utilities
 namespace util{
 
@@ -49,9 +58,65 @@ namespace util{
   typedef std::map< UBLArSoftCh_t, UBDaqID > UBChannelReverseMap_t;
 
 
+  /**
+   * @brief Access to the run database
+   *
+   * Run cache
+   * ----------
+   *
+   * The run-dependent values (`GetLifetimeFromDB()`, `GetTemperatureFromDB()`,
+   * `GetEfieldValuesFromDB()`, `GetTriggerOffsetFromDB()` and
+   * `GetPOTFromDB()`) are first looked up in a cache (`util::RunValueCache`),
+   * and the database is queried only for the values not found there.
+   * The cache is configured by:
+   * - *RunCacheFile* (string, default: empty): file with the values of the
+   *   runs, read at the beginning of the job if it exists; the values in the
+   *   file are used even if *ShouldConnect* is `false`
+   * - *PrefetchRuns* (list of integers, default: empty): runs (typically,
+   *   the ones in the input files of the job) whose values are all read from
+   *   the database with one query per field at the beginning of the job,
+   *   unless already cached
+   * - *UpdateRunCacheFile* (boolean, default: `false`): at the end of the
+   *   job, writes all the cached values (from the file and from the database)
+   *   into *RunCacheFile*
+   *
+   * A cache file can be prepared by a job with *ShouldConnect*, the list of
+   * runs in *PrefetchRuns* and *UpdateRunCacheFile* enabled, and then
+   * distributed with the jobs, which will not need to connect.
+   * The runs and fields which the database has no value for are also
+   * remembered (for the job only), and not queried again.
+   *
+   * Connection
+   * -----------
+   *
+   * The connection to the database is opened at the first query and kept
+   * for the following ones, unless *KeepConnection* (boolean, default: `true`)
+   * is set to `false`, in which case each query opens its own connection as
+   * in the past. A lost connection is opened again at the next query.
+   * The queries of the run values are sent as prepared statements, which the
+   * server parses only once per connection.
+   *
+   * Background queries
+   * -------------------
+   *
+   * `PrefetchRunAsync()` sends the queries of all the values of a run not
+   * cached yet, on a second connection, and returns immediately: the server
+   * processes them while the job goes on. The returned future yields `0` on
+   * success and `-1` on failure; waiting for it (or calling `AwaitRun()`, or
+   * any getter of the values of that run) collects the results into the
+   * cache. The future is deferred: its `wait_for()` does not tell whether
+   * the results have arrived. The values which could not be read in
+   * background are queried again by the getters, as usual.
+   * - *AsyncPrefetchRuns* (list of integers, default: empty): runs whose
+   *   values are read in background, one at a time: the first one at the
+   *   beginning of the job, and each of the others when the previous run
+   *   begins, so that its values are read while the previous run is being
+   *   processed; the values of each run are awaited when that run begins
+   */
   class DatabaseUtil {
   public:
-    DatabaseUtil(fhicl::ParameterSet const& pset);
+    DatabaseUtil(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+    ~DatabaseUtil();
 
     void   reconfigure(fhicl::ParameterSet const& pset);
 
@@ -69,11 +134,69 @@ namespace util{
     bool ToughErrorTreatment() const { return fToughErrorTreatment; }
     bool ShouldConnect() const { return fShouldConnect; }
 
+    /// Reads from the database all the run values of the runs not cached yet
+    void PrefetchRuns(std::vector<int> const& runs);
+
+    /// Starts reading in background the values of the run not cached yet
+    std::shared_future<int> PrefetchRunAsync(int run);
+
+    /// Waits for the values of the run being read in background, if any;
+    /// returns -1 if their reading failed
+    int AwaitRun(int run);
+
+    /// Returns the cache of the run values
+    RunValueCache const& RunCache() const { return fRunCache; }
+
   private:
 
     int SelectSingleFieldByQuery(std::vector<std::string> &value,const char * query);
+    int SelectRowsByQuery(std::vector<std::vector<std::string>> &rows,const char * query);
+
+    /// Runs the prepared statement `name` (prepared from `query` if needed)
+    /// with the run as parameter; returns -2 if there are no results
+    int SelectSingleFieldByStatement(std::vector<std::string> &value,const char * name,const char * query,int run);
+
+    /// Extracts the first field from the result and frees it;
+    /// returns -2 if there are no results
+    int ExtractSingleField(std::vector<std::string> &value,PGresult *result);
+
+    /// Returns the values of the field for the run, from cache or database
+    int GetRunValues(int run,const char * field,const char * query,std::vector<std::string> &values);
+
+    /// Query of the values of a run sent in background
+    struct AsyncQuery_t {
+      int run; ///< the run being queried
+      std::vector<std::string> fields; ///< fields queried, in order
+      std::size_t nReceived = 0; ///< number of results already received
+      int status = 0; ///< -1 if any of the results is an error
+    };
+
+    /// Returns the query of all the values of the field for the run
+    std::string RunFieldQuery(std::string const& field,int run) const;
+
+    /// Sends the first of the queued background queries which can be sent
+    void SendNextAsyncQuery();
+
+    /// Reads the results of the first background query; returns `false`
+    /// if they are not complete and `wait` is `false`
+    bool ReceiveAsyncResults(bool wait);
+
+    /// Caches the values in the result of a background query, and frees it
+    void StoreAsyncResult(AsyncQuery_t &query,PGresult *result);
+
+    /// Waits for the results of the background query of the run
+    int CollectAsyncRun(int run);
+
+    /// Awaits the values of the run, and starts reading the next ones
+    void preBeginRun(art::Run const& run);
+
+    /// Writes the cache file, if requested
+    void postEndJob();
     int Connect(int conn_wait=0);
     int DisConnect();
+    void CloseConnection(); ///< closes the connection, even if to be kept
+    int ConnectAsync(); ///< opens the connection for background queries
+    void CloseAsyncConnection(); ///< closes it, failing the pending queries
     char connection_str[200];
 
     PGconn *conn;       // database connection handle
@@ -86,6 +209,20 @@ namespace util{
     bool fToughErrorTreatment;
     bool fShouldConnect;
 
+    RunValueCache fRunCache; ///< run values already known
+    std::string fRunCacheFile; ///< file to read (and write) the cache from
+    bool fUpdateRunCacheFile; ///< whether to write the cache at end of job
+    std::set<std::pair<int, std::string>> fMissingRunValues; ///< no value in DB
+
+    bool fKeepConnection; ///< whether to reuse the connection across queries
+    std::set<std::string> fPreparedStatements; ///< prepared in the connection
+
+    PGconn *fAsyncConn; ///< connection for the background queries
+    std::deque<AsyncQuery_t> fAsyncQueries; ///< sent (first) and queued
+    std::map<int, int> fAsyncStatus; ///< status of the completed queries
+    std::map<int, std::shared_future<int>> fPendingRuns; ///< not awaited yet
+    std::deque<int> fAsyncPrefetchRuns; ///< runs to be read in background
+
     UBChannelMap_t        fChannelMap;
     UBChannelReverseMap_t fChannelReverseMap;
     void LoadUBChannelMap(int data_taking_timestamp = -1 , int  swizzling_timestamp = -1 );
@@ -8,20 +8,97 @@
 // C++ language includes
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <sstream>
+#include <algorithm> // std::remove()
+#include <poll.h> // poll()
 //#include <libpq-fe.h>
 
 // LArSoft includes
 #include "lardata/Utilities/DatabaseUtil.h"
+#include "art/Framework/Principal/Run.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "cetlib_except/exception.h"
+#include "cetlib/filesystem.h" // cet::file_exists()
+
+namespace {
+
+  /// Fields of the run values, which `PrefetchRunAsync()` reads
+  std::vector<std::string> const RunFields { "tau", "temp", "T0", "pot", "efield" };
+
+} // local namespace
 
 //-----------------------------------------------
-util::DatabaseUtil::DatabaseUtil(fhicl::ParameterSet const& pset)
+util::DatabaseUtil::DatabaseUtil(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
 {
   conn = NULL;
+  fAsyncConn = NULL;
   this->reconfigure(pset);
   fChannelMap.clear();
   fChannelReverseMap.clear();
+
+  // values known from a previous job are never queried again
+  if(!fRunCacheFile.empty() && cet::file_exists(fRunCacheFile)) {
+    std::size_t const nEntries = fRunCache.load(fRunCacheFile);
+    mf::LogInfo("DatabaseUtil") << "Read " << nEntries
+      << " run values from '" << fRunCacheFile << "'";
+  }
+  PrefetchRuns(pset.get< std::vector<int> >("PrefetchRuns", {}));
+
+  // the first run is read now, each of the others when the previous begins
+  for(int run: pset.get< std::vector<int> >("AsyncPrefetchRuns", {}))
+    fAsyncPrefetchRuns.push_back(run);
+  if(!fAsyncPrefetchRuns.empty()) {
+    PrefetchRunAsync(fAsyncPrefetchRuns.front());
+    fAsyncPrefetchRuns.pop_front();
+  }
+
+  reg.sPreBeginRun.watch(this, &DatabaseUtil::preBeginRun);
+  reg.sPostEndJob.watch(this, &DatabaseUtil::postEndJob);
+}
+
+//----------------------------------------------
+util::DatabaseUtil::~DatabaseUtil()
+{
+  CloseAsyncConnection();
+  CloseConnection();
+}
+
+//----------------------------------------------
+void util::DatabaseUtil::preBeginRun(art::Run const& run)
+{
+  // the values of this run were (hopefully) read during the previous run...
+  AwaitRun(run.run());
+
+  // ... and the ones of the next run are read during this one
+  fAsyncPrefetchRuns.erase(
+    std::remove(fAsyncPrefetchRuns.begin(), fAsyncPrefetchRuns.end(), int(run.run())),
+    fAsyncPrefetchRuns.end());
+  if(!fAsyncPrefetchRuns.empty()) {
+    PrefetchRunAsync(fAsyncPrefetchRuns.front());
+    fAsyncPrefetchRuns.pop_front();
+  }
+}
+
+//----------------------------------------------
+void util::DatabaseUtil::postEndJob()
+{
+  CloseAsyncConnection();
+  fPendingRuns.clear();
+  CloseConnection();
+
+  if(!fUpdateRunCacheFile || fRunCacheFile.empty() || !fRunCache.modified())
+    return;
+  try {
+    fRunCache.save(fRunCacheFile);
+  }
+  catch(cet::exception const& e) {
+    // the job is over: its results are not lost for a missing cache file
+    mf::LogError("DatabaseUtil") << "Run cache file not updated:\n" << e.what();
+    return;
+  }
+  mf::LogInfo("DatabaseUtil") << "Wrote " << fRunCache.size()
+    << " run values into '" << fRunCacheFile << "'";
 }
 
 //----------------------------------------------
@@ -30,14 +107,24 @@ int util::DatabaseUtil::Connect(int conn_wait)
   if(!fShouldConnect)
     return -1;
 
+  // the connection of the previous queries is reused while it's good
+  if(conn && PQstatus(conn) == CONNECTION_OK)
+    return 1;
+  if(conn) {
+    mf::LogInfo("DatabaseUtil") << "Connection to database lost, reconnecting\n";
+    CloseConnection();
+  }
+
   if(conn_wait)
     sleep(conn_wait);
 
   conn = PQconnectdb(connection_str);
   if (PQstatus(conn) == CONNECTION_BAD) {
-    mf::LogWarning("DatabaseUtil") << "Connection to database failed, "<<PQerrorMessage(conn)<<"\n";
-    if( ( strstr(PQerrorMessage(conn),"remaining connection slots are reserved")!=NULL ||
-	  strstr(PQerrorMessage(conn),"sorry, too many clients already")!=NULL )
+    std::string const errorMessage = PQerrorMessage(conn);
+    CloseConnection();
+    mf::LogWarning("DatabaseUtil") << "Connection to database failed, "<<errorMessage<<"\n";
+    if( ( errorMessage.find("remaining connection slots are reserved")!=std::string::npos ||
+	  errorMessage.find("sorry, too many clients already")!=std::string::npos )
 	&& conn_wait<20 ) {
       conn_wait+=2;
       mf::LogWarning("DatabaseUtil") << "retrying connection after " << conn_wait << " seconds \n";
@@ -58,13 +145,62 @@ int util::DatabaseUtil::DisConnect()
 {
   if(!fShouldConnect)
     return -1;
-  //close connection
+  // the connection is kept for the next query
+  if(fKeepConnection)
+    return 1;
+  CloseConnection();
+  return 1;
+}
+
+
+void util::DatabaseUtil::CloseConnection()
+{
+  if(!conn) return;
   MF_LOG_DEBUG("DatabaseUtil")<<"Closing Connection \n";
   PQfinish(conn);
+  conn = NULL;
+  // prepared statements live in the connection
+  fPreparedStatements.clear();
+}
+
+
+int util::DatabaseUtil::ConnectAsync()
+{
+  if(!fShouldConnect)
+    return -1;
+  if(fAsyncConn && PQstatus(fAsyncConn) == CONNECTION_OK)
+    return 1;
+  CloseAsyncConnection();
+
+  // the queries are sent and read without blocking, the connection is not
+  fAsyncConn = PQconnectdb(connection_str);
+  if (PQstatus(fAsyncConn) == CONNECTION_BAD) {
+    mf::LogWarning("DatabaseUtil") << "Connection to database for background queries failed, "
+                                   << PQerrorMessage(fAsyncConn) << "\n";
+    CloseAsyncConnection();
+    if(fToughErrorTreatment)
+      throw cet::exception("DataBaseUtil") << " DB connection failed\n";
+    return -1;
+  }
+  MF_LOG_DEBUG("DatabaseUtil")<<"Connected OK for background queries\n";
   return 1;
 }
 
 
+void util::DatabaseUtil::CloseAsyncConnection()
+{
+  // the queries which were not completed will not be
+  for(AsyncQuery_t const& query: fAsyncQueries)
+    fAsyncStatus[query.run] = -1;
+  fAsyncQueries.clear();
+
+  if(!fAsyncConn) return;
+  MF_LOG_DEBUG("DatabaseUtil")<<"Closing connection for background queries \n";
+  PQfinish(fAsyncConn);
+  fAsyncConn = NULL;
+}
+
+
 
 //------------------------------------------------
 void util::DatabaseUtil::reconfigure(fhicl::ParameterSet const& pset)
@@ -77,6 +213,14 @@ void util::DatabaseUtil::reconfigure(fhicl::ParameterSet const& pset)
   fPassword 		 = "";
   fToughErrorTreatment   = pset.get< bool >("ToughErrorTreatment");
   fShouldConnect   	 = pset.get< bool >("ShouldConnect");
+  fRunCacheFile          = pset.get< std::string >("RunCacheFile", "");
+  fUpdateRunCacheFile    = pset.get< bool >("UpdateRunCacheFile", false);
+  fKeepConnection        = pset.get< bool >("KeepConnection", true);
+
+  // connection parameters and statements may change
+  CloseAsyncConnection();
+  CloseConnection();
+  fMissingRunValues.clear();
 
   // constructor decides if initialized value is a path or an environment variable
   std::string passfname;
@@ -109,9 +253,22 @@ void util::DatabaseUtil::reconfigure(fhicl::ParameterSet const& pset)
 
 int util::DatabaseUtil::SelectSingleFieldByQuery(std::vector<std::string> &value,const char * query)
 {
-  PGresult *result;
-  char * string_val;
+  if(this->Connect()==-1)  {
+    if(fShouldConnect)
+      mf::LogWarning("DatabaseUtil")<< "DB Connection error \n";
+    else
+      mf::LogInfo("DatabaseUtil")<< "Not connecting to DB by choice. \n";
+    return -1;
+  }
+
+  // no distinction between failure and no result here
+  return (ExtractSingleField(value, PQexec(conn, query))==0)? 0: -1;
+}
+
 
+
+int util::DatabaseUtil::SelectSingleFieldByStatement(std::vector<std::string> &value,const char * name,const char * query,int run)
+{
   if(this->Connect()==-1)  {
     if(fShouldConnect)
       mf::LogWarning("DatabaseUtil")<< "DB Connection error \n";
@@ -120,10 +277,34 @@ int util::DatabaseUtil::SelectSingleFieldByQuery(std::vector<std::string> &value
     return -1;
   }
 
-  result = PQexec(conn, query);
+  // the statement is parsed and planned by the server only once per connection
+  if(fPreparedStatements.count(name)==0) {
+    PGresult *prepared = PQprepare(conn, name, query, 1, NULL);
+    if(!prepared || PQresultStatus(prepared)!=PGRES_COMMAND_OK) {
+      mf::LogWarning("DatabaseUtil")<<"Preparation of statement '"<<name<<"' failed, error message "
+				    <<(prepared? PQresultErrorMessage(prepared): "(none)")<<"\n";
+      if(prepared) PQclear(prepared);
+      this->DisConnect();
+      return -1;
+    }
+    PQclear(prepared);
+    fPreparedStatements.insert(name);
+  }
+
+  std::string const runStr = std::to_string(run);
+  char const* params[1] = { runStr.c_str() };
+  return ExtractSingleField(value, PQexecPrepared(conn, name, 1, params, NULL, NULL, 0));
+}
+
+
+
+int util::DatabaseUtil::ExtractSingleField(std::vector<std::string> &value,PGresult *result)
+{
+  char * string_val;
 
   if (!result) {
     mf::LogInfo("DatabaseUtil")<< "PQexec command failed, no error code\n";
+    this->DisConnect();
     return -1;
   }
   else if(PQresultStatus(result)!=PGRES_TUPLES_OK) {
@@ -158,11 +339,304 @@ int util::DatabaseUtil::SelectSingleFieldByQuery(std::vector<std::string> &value
       mf::LogWarning("DatabaseUtil")<<"wrong number of rows returned:"<<PQntuples(result)<<"\n";
       PQclear(result);
       this->DisConnect();
-      return -1;
+      return -2;
+    }
+  }
+
+
+}
+
+
+
+int util::DatabaseUtil::SelectRowsByQuery(std::vector<std::vector<std::string>> &rows,const char * query)
+{
+  if(this->Connect()==-1)  {
+    if(fShouldConnect)
+      mf::LogWarning("DatabaseUtil")<< "DB Connection error \n";
+    else
+      mf::LogInfo("DatabaseUtil")<< "Not connecting to DB by choice. \n";
+    return -1;
+  }
+
+  PGresult *result = PQexec(conn, query);
+
+  if (!result) {
+    mf::LogInfo("DatabaseUtil")<< "PQexec command failed, no error code\n";
+    this->DisConnect();
+    return -1;
+  }
+  if(PQresultStatus(result)!=PGRES_TUPLES_OK) {
+    mf::LogWarning("DatabaseUtil")<<"Command failed with code "
+				  <<PQresStatus(PQresultStatus(result)) <<", error message "
+				  <<PQresultErrorMessage(result)<<"\n";
+    PQclear(result);
+    this->DisConnect();
+    return -1;
+  }
+
+  int const nFields = PQnfields(result);
+  for(int i=0;i<PQntuples(result);i++) {
+    std::vector<std::string> row;
+    for(int j=0;j<nFields;j++) row.push_back(PQgetvalue(result,i,j));
+    rows.push_back(std::move(row));
+  }
+  PQclear(result);
+  this->DisConnect();
+  return 0;
+}
+
+
+
+int util::DatabaseUtil::GetRunValues(int run,const char * field,const char * query,std::vector<std::string> &values)
+{
+  // the values may already be on their way
+  AwaitRun(run);
+
+  RunValueCache::Values_t const* cached = fRunCache.find(run, field);
+  if(cached) {
+    values = *cached;
+    return 0;
+  }
+
+  // the database has already answered that there is no value
+  if(fMissingRunValues.count({ run, field })>0)
+    return -1;
+
+  int err=SelectSingleFieldByStatement(values,field,query,run);
+  if(err==-2) {
+    fMissingRunValues.emplace(run, field);
+    return -1;
+  }
+  if(err==-1) return err;
+
+  // only values which can be written into the cache file are kept
+  for(std::string const& value: values) {
+    if(value.empty() || value.find_first_of(" \t\n") != std::string::npos)
+      return err;
+  }
+  fRunCache.set(run, field, values);
+  return err;
+}
+
+
+
+void util::DatabaseUtil::PrefetchRuns(std::vector<int> const& runs)
+{
+  if(!fShouldConnect || runs.empty()) return;
+
+  // fields of the main table, with one value per run, and their queries
+  static std::vector<std::string> const SingleFields { "tau", "temp", "T0", "pot" };
+  for(std::string const& field: SingleFields) {
+    std::ostringstream runList;
+    for(int run: runs) {
+      if(fRunCache.has(run, field)) continue;
+      if(!runList.str().empty()) runList << ",";
+      runList << run;
     }
+    if(runList.str().empty()) continue;
+
+    std::string const query = "SELECT run, " + field + " FROM " + fTableName
+      + " WHERE run IN (" + runList.str() + ")";
+    std::vector<std::vector<std::string>> rows;
+    if(SelectRowsByQuery(rows, query.c_str())==-1) continue;
+
+    std::map<int, RunValueCache::Values_t> values;
+    for(auto const& row: rows)
+      values[std::atoi(row[0].c_str())].push_back(row[1]);
+    for(int run: runs)
+      if(values.count(run)==0) fMissingRunValues.emplace(run, field);
+    for(auto& runValues: values) {
+      // the single value lookups accept exactly one value
+      if(runValues.second.size() != 1 || runValues.second[0].empty()) continue;
+      fRunCache.set(runValues.first, field, std::move(runValues.second));
+    }
+  } // for fields
+
+  // electric field: one value per plane gap
+  std::ostringstream runList;
+  for(int run: runs) {
+    if(fRunCache.has(run, "efield")) continue;
+    if(!runList.str().empty()) runList << ",";
+    runList << run;
   }
+  if(runList.str().empty()) return;
+
+  std::string const query = "SELECT run, EFbet FROM EField," + fTableName
+    + " WHERE Efield.FID = " + fTableName + ".FID AND run IN ("
+    + runList.str() + ") ORDER BY run, planegap";
+  std::vector<std::vector<std::string>> rows;
+  if(SelectRowsByQuery(rows, query.c_str())==-1) return;
+
+  std::map<int, RunValueCache::Values_t> values;
+  for(auto const& row: rows)
+    values[std::atoi(row[0].c_str())].push_back(row[1]);
+  for(int run: runs)
+    if(values.count(run)==0) fMissingRunValues.emplace(run, "efield");
+  for(auto& runValues: values)
+    fRunCache.set(runValues.first, "efield", std::move(runValues.second));
+}
+
 
 
+std::shared_future<int> util::DatabaseUtil::PrefetchRunAsync(int run)
+{
+  auto const iPending = fPendingRuns.find(run);
+  if(iPending != fPendingRuns.end()) return iPending->second;
+
+  AsyncQuery_t query;
+  query.run = run;
+  for(std::string const& field: RunFields) {
+    if(fRunCache.has(run, field) || fMissingRunValues.count({ run, field })>0)
+      continue;
+    query.fields.push_back(field);
+  }
+
+  // nothing to read, or no way to read it
+  if(query.fields.empty() || this->ConnectAsync()==-1) {
+    std::promise<int> done;
+    done.set_value(query.fields.empty()? 0: -1);
+    return done.get_future().share();
+  }
+
+  // the connection takes one query at a time: the others wait in the queue
+  fAsyncStatus.erase(run);
+  fAsyncQueries.push_back(std::move(query));
+  if(fAsyncQueries.size()==1U) SendNextAsyncQuery();
+
+  std::shared_future<int> pending = std::async(std::launch::deferred,
+    [this, run](){ return this->CollectAsyncRun(run); }
+    ).share();
+  fPendingRuns.emplace(run, pending);
+  return pending;
+}
+
+
+
+int util::DatabaseUtil::AwaitRun(int run)
+{
+  auto const iPending = fPendingRuns.find(run);
+  if(iPending == fPendingRuns.end()) return 0;
+  std::shared_future<int> const pending = iPending->second;
+  int const status = pending.get();
+  fPendingRuns.erase(run);
+  return status;
+}
+
+
+
+std::string util::DatabaseUtil::RunFieldQuery(std::string const& field,int run) const
+{
+  // the run is a number: it can be written in the query as it is
+  std::string const runStr = std::to_string(run);
+  if(field=="efield") {
+    return "SELECT EFbet FROM EField," + fTableName + " WHERE Efield.FID = "
+      + fTableName + ".FID AND run = " + runStr + " ORDER BY planegap";
+  }
+  return "SELECT " + field + " FROM " + fTableName + " WHERE run = " + runStr;
+}
+
+
+
+void util::DatabaseUtil::SendNextAsyncQuery()
+{
+  while(!fAsyncQueries.empty()) {
+    AsyncQuery_t const& query = fAsyncQueries.front();
+
+    // all the fields in a single command: the results come back in order
+    std::string command;
+    for(std::string const& field: query.fields) {
+      if(!command.empty()) command += "; ";
+      command += RunFieldQuery(field, query.run);
+    }
+    if(PQsendQuery(fAsyncConn, command.c_str())) return;
+
+    mf::LogWarning("DatabaseUtil")<<"Background query of run "<<query.run
+				  <<" failed, error message "<<PQerrorMessage(fAsyncConn)<<"\n";
+    fAsyncStatus[query.run] = -1;
+    fAsyncQueries.pop_front();
+  } // while
+}
+
+
+
+bool util::DatabaseUtil::ReceiveAsyncResults(bool wait)
+{
+  while(!fAsyncQueries.empty()) {
+    if(!PQconsumeInput(fAsyncConn)) {
+      mf::LogWarning("DatabaseUtil")<<"Connection for background queries lost, "
+				    <<PQerrorMessage(fAsyncConn)<<"\n";
+      CloseAsyncConnection();
+      return true;
+    }
+    if(PQisBusy(fAsyncConn)) {
+      if(!wait) return false;
+      pollfd fd { PQsocket(fAsyncConn), POLLIN, 0 };
+      poll(&fd, 1, -1);
+      continue;
+    }
+
+    AsyncQuery_t& query = fAsyncQueries.front();
+    PGresult *result = PQgetResult(fAsyncConn);
+    if(result) {
+      StoreAsyncResult(query, result);
+      continue;
+    }
+
+    // no more results: the query of this run is complete
+    if(query.nReceived < query.fields.size()) query.status = -1;
+    fAsyncStatus[query.run] = query.status;
+    fAsyncQueries.pop_front();
+    SendNextAsyncQuery();
+    return true;
+  } // while
+  return true;
+}
+
+
+
+void util::DatabaseUtil::StoreAsyncResult(AsyncQuery_t &query,PGresult *result)
+{
+  if(query.nReceived >= query.fields.size()) {
+    PQclear(result);
+    return;
+  }
+  std::string const& field = query.fields[query.nReceived++];
+
+  if(PQresultStatus(result)!=PGRES_TUPLES_OK) {
+    mf::LogWarning("DatabaseUtil")<<"Background query of '"<<field<<"' for run "<<query.run
+				  <<" failed with code "<<PQresStatus(PQresultStatus(result))
+				  <<", error message "<<PQresultErrorMessage(result)<<"\n";
+    query.status = -1;
+    PQclear(result);
+    return;
+  }
+
+  if(PQntuples(result)<1) {
+    fMissingRunValues.emplace(query.run, field);
+    PQclear(result);
+    return;
+  }
+
+  // as in GetRunValues(), only values which can be written into the cache file
+  RunValueCache::Values_t values;
+  for(int i=0;i<PQntuples(result);i++) values.push_back(PQgetvalue(result,i,0));
+  PQclear(result);
+  for(std::string const& value: values) {
+    if(value.empty() || value.find_first_of(" \t\n") != std::string::npos)
+      return;
+  }
+  fRunCache.set(query.run, field, std::move(values));
+}
+
+
+
+int util::DatabaseUtil::CollectAsyncRun(int run)
+{
+  // results come in the order of the queries: the earlier ones are read first
+  while(fAsyncStatus.count(run)==0 && !fAsyncQueries.empty())
+    ReceiveAsyncResults(true);
+  auto const iStatus = fAsyncStatus.find(run);
+  return (iStatus == fAsyncStatus.end())? -1: iStatus->second;
 }
 
 
@@ -170,9 +644,9 @@ int util::DatabaseUtil::SelectSingleFieldByQuery(std::vector<std::string> &value
 int util::DatabaseUtil::GetTemperatureFromDB(int run,double &temp_real)
 {
   std::vector<std::string> retvalue;
-  char cond[30];
-  sprintf(cond,"run = %d",run);
-  int err=SelectFieldByName(retvalue,"temp",cond,fTableName.c_str());
+  char query[200];
+  sprintf(query,"SELECT temp FROM %s WHERE run = $1",fTableName.c_str());
+  int err=GetRunValues(run,"temp",query,retvalue);
 
   if(err!=-1 && retvalue.size()==1){
     char * endstr;
@@ -194,8 +668,8 @@ int util::DatabaseUtil::GetEfieldValuesFromDB(int run,std::vector<double> &efiel
   std::vector<std::string> retvalue;
 
   char query[200];
-  sprintf(query,"SELECT EFbet FROM EField,%s WHERE Efield.FID = %s.FID AND run = %d ORDER BY planegap",fTableName.c_str(),fTableName.c_str(),run);
-  int err=SelectSingleFieldByQuery(retvalue,query);
+  sprintf(query,"SELECT EFbet FROM EField,%s WHERE Efield.FID = %s.FID AND run = $1 ORDER BY planegap",fTableName.c_str(),fTableName.c_str());
+  int err=GetRunValues(run,"efield",query,retvalue);
 
   if(err!=-1 && retvalue.size()>=1){
     efield.clear();    //clear value before setting new values
@@ -237,9 +711,9 @@ int util::DatabaseUtil::GetLifetimeFromDB(int run,double &lftime_real) {
   //  sprintf(query,"SELECT tau FROM argoneut_test WHERE run = %d",run);
 
   std::vector<std::string> retvalue;
-  char cond[30];
-  sprintf(cond,"run = %d",run);
-  int err=SelectFieldByName(retvalue,"tau",cond,fTableName.c_str());
+  char query[200];
+  sprintf(query,"SELECT tau FROM %s WHERE run = $1",fTableName.c_str());
+  int err=GetRunValues(run,"tau",query,retvalue);
 
   if(err!=-1 && retvalue.size()==1){
     char * endstr;
@@ -258,9 +732,9 @@ int util::DatabaseUtil::GetTriggerOffsetFromDB(int run,double &T0_real) {
   //  sprintf(query,"SELECT tau FROM argoneut_test WHERE run = %d",run);
 
   std::vector<std::string> retvalue;
-  char cond[30];
-  sprintf(cond,"run = %d",run);
-  int err=SelectFieldByName(retvalue,"T0",cond,fTableName.c_str());
+  char query[200];
+  sprintf(query,"SELECT T0 FROM %s WHERE run = $1",fTableName.c_str());
+  int err=GetRunValues(run,"T0",query,retvalue);
 
   if(err!=-1 && retvalue.size()==1){
     char * endstr;
@@ -280,9 +754,9 @@ int util::DatabaseUtil::GetPOTFromDB(int run,long double &POT) {
   //  sprintf(query,"SELECT tau FROM argoneut_test WHERE run = %d",run);
 
   std::vector<std::string> retvalue;
-  char cond[30];
-  sprintf(cond,"run = %d",run);
-  int err=SelectFieldByName(retvalue,"pot",cond,fTableName.c_str());
+  char query[200];
+  sprintf(query,"SELECT pot FROM %s WHERE run = $1",fTableName.c_str());
+  int err=GetRunValues(run,"pot",query,retvalue);
 
   if(err!=-1 && retvalue.size()==1){
     char * endstr;
@@ -304,12 +778,11 @@ namespace util {
       // Also this avoids inglorious segfault.
       return;
     }
-    if ( conn==NULL )
-      Connect( 0 );
+    Connect( 0 );
 
     if(PQstatus(conn)!=CONNECTION_OK) {
-      mf::LogError("") << __PRETTY_FUNCTION__ << ": Couldn't open connection to postgresql interface"  << PQdb(conn) <<":"<<PQhost(conn);
-      PQfinish(conn);
+      mf::LogError("") << __PRETTY_FUNCTION__ << ": Couldn't open connection to postgresql interface "  << fDBName <<":"<<fDBHostName;
+      CloseConnection();
       throw art::Exception( art::errors::FileReadError )
         << "Failed to get channel map from DB."<< std::endl;
     }
@@ -321,7 +794,7 @@ namespace util {
     if (PQresultStatus(res) != PGRES_COMMAND_OK) {
       mf::LogError("")<< "postgresql BEGIN failed";
       PQclear(res);
-      PQfinish(conn);
+      CloseConnection();
       throw art::Exception( art::errors::FileReadError )
         << "postgresql BEGIN failed." << std::endl;
     }
@@ -342,7 +815,7 @@ namespace util {
       {
 	mf::LogError("")<< "SELECT command did not return tuples properly. \n" << PQresultErrorMessage(res) << "Number rows: "<< PQntuples(res);
         PQclear(res);
-        PQfinish(conn);
+        CloseConnection();
         throw art::Exception( art::errors::FileReadError )
           << "postgresql SELECT failed." << std::endl;
       }
@@ -375,6 +848,9 @@ namespace util {
       fChannelMap.insert( p );
       fChannelReverseMap.insert( std::pair< UBLArSoftCh_t, UBDaqID >( larsoft_chan, daq_id ) );
     }
+    PQclear(res);
+    // the connection may be reused: the transaction must not stay open
+    PQclear(PQexec(conn, "END"));
     this->DisConnect();
   }// end of LoadUBChannelMap
 
@@ -9,7 +9,11 @@
 #define LARDATA_UTILITIES_DEREFERENCE_H 1
 
 // C/C++ standard libraries
+#include <vector>
+#include <iterator> // std::begin(), std::end()
+#include <utility> // std::declval()
 #include <type_traits>
+#include <cstddef> // std::size_t
 
 /// LArSoft namespace
 namespace lar {
@@ -296,6 +300,105 @@ namespace lar {
           <T, details::has_dereference_class<T>::value>()(v);
       }
 
+
+    /** ************************************************************************
+     * @brief Type of the table of pointers from `make_pointer_table()`.
+     * @tparam Coll type of the collection of (pointers to) objects
+     */
+    template <typename Coll>
+    using pointer_table_t = std::vector<decltype(make_pointer
+      (std::declval<typename Coll::value_type const&>()))>;
+
+
+    /** ************************************************************************
+     * @brief Returns the C pointers to all the values in the collection
+     * @tparam Coll type of the collection of (pointers to) objects
+     * @param coll the collection
+     * @return a vector of C pointers, one per element of `coll`, in order
+     *
+     * Each element of the collection is resolved with `make_pointer()` only
+     * once. This is convenient when the same collection of smart pointers
+     * (e.g. `std::vector<art::Ptr<recob::Hit>>`) is looped through several
+     * times, as the subsequent loops touch only plain pointers:
+     *
+     *     auto const hitPtrs = lar::util::make_pointer_table(hits);
+     *     for (recob::Hit const* hit: hitPtrs) { ... }
+     *
+     * The pointed objects must stay valid while the table is used.
+     */
+    template <typename Coll>
+    pointer_table_t<Coll> make_pointer_table(Coll const& coll)
+      {
+        pointer_table_t<Coll> table;
+        table.reserve(coll.size());
+        for (auto const& elem: coll) table.push_back(make_pointer(elem));
+        return table;
+      }
+
+
+    /** ************************************************************************
+     * @brief Returns the C pointers to all the values of product pointers
+     * @tparam PtrColl type of the collection of product pointers
+     * @param ptrs the collection of product pointers
+     * @return a vector of C pointers, one per element of `ptrs`, in order
+     * @see make_pointer_table()
+     *
+     * This is a version of `make_pointer_table()` for pointers to elements of
+     * data products (like `art::Ptr`), which passes through the product
+     * lookup only once per data product, rather than once per pointer.
+     * The pointers are grouped by their product ID (`id()`): the first pointer
+     * of each product is dereferenced, and all the following ones in the same
+     * product are found by their distance in `key()` from it.
+     * Null pointers (`isNull()`) are resolved into `nullptr`.
+     *
+     * This requires the data products to be contiguous collections, indexed
+     * by the key of the pointer, which is the case of `art::Ptr` pointing
+     * into a `std::vector` data product (the usual form of LArSoft data
+     * products). Use `make_pointer_table()` for the other cases.
+     */
+    template <typename PtrColl>
+    pointer_table_t<PtrColl> make_product_pointer_table(PtrColl const& ptrs)
+      {
+        using pointer_t = typename pointer_table_t<PtrColl>::value_type;
+        using id_t
+          = std::decay_t<decltype(std::declval<typename PtrColl::value_type const&>().id())>;
+
+        // one anchor for each product; usually there are very few of them
+        struct Anchor_t {
+          id_t id; ///< ID of the product
+          std::size_t key; ///< key of the anchor pointer
+          pointer_t ptr; ///< resolved anchor pointer
+        };
+        std::vector<Anchor_t> anchors;
+
+        pointer_table_t<PtrColl> table;
+        table.reserve(ptrs.size());
+        Anchor_t const* last = nullptr; // the product of the previous pointer
+        for (auto const& ptr: ptrs) {
+          if (ptr.isNull()) {
+            table.push_back(nullptr);
+            continue;
+          }
+          if (!last || !(last->id == ptr.id())) {
+            last = nullptr;
+            for (Anchor_t const& anchor: anchors) {
+              if (!(anchor.id == ptr.id())) continue;
+              last = &anchor;
+              break;
+            } // for anchors
+            if (!last) {
+              anchors.push_back({ ptr.id(), ptr.key(), make_pointer(ptr) });
+              last = &anchors.back();
+            }
+          }
+          table.push_back(last->ptr
+            + (static_cast<std::ptrdiff_t>(ptr.key())
+              - static_cast<std::ptrdiff_t>(last->key))
+            );
+        } // for
+        return table;
+      }
+
   } // namespace util
 
 } // namespace lar
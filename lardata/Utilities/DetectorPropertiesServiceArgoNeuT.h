@@ -27,12 +27,14 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcore/CoreUtils/EnsureOnlyOneSchedule.h"
 
 ///General LArSoft Utilities
 namespace util{
     class DetectorPropertiesServiceArgoNeuT
       : public detinfo::DetectorProperties // implements provider interface
       , public detinfo::DetectorPropertiesService // implements service interface
+      , private lar::EnsureOnlyOneSchedule<DetectorPropertiesServiceArgoNeuT>
     {
     public:
 
@@ -0,0 +1,148 @@
+/**
+ * @file   DeterministicReduce.h
+ * @brief  Parallel reduction with a result independent of the threads
+ * @date   October 14, 2026
+ * @see    SimpleFits.h, ChiSquareAccumulator.h, CountersMap.h
+ *
+ * This is a pure header library.
+ */
+
+#ifndef LARDATA_UTILITIES_DETERMINISTICREDUCE_H
+#define LARDATA_UTILITIES_DETERMINISTICREDUCE_H 1
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <stdexcept> // std::logic_error
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace lar {
+  namespace util {
+
+    /**
+     * @brief Fills accumulators in parallel, with a reproducible result
+     * @tparam Acc type of the accumulator
+     * @tparam Fill type of the functor filling an accumulator with items
+     * @tparam Merge type of the functor merging two accumulators
+     * @param n number of items
+     * @param chunkSize number of items in each chunk
+     * @param empty accumulator with no data (copied for each chunk)
+     * @param fill functor `fill(Acc&, begin, end)` adding items [begin, end[
+     * @param merge functor `merge(Acc& into, Acc const& from)`
+     * @return an accumulator with all the `n` items
+     * @throw std::logic_error if `chunkSize` is `0`
+     *
+     * Parallel reductions like `tbb::parallel_reduce()` split the data and
+     * combine the partial results in an order which depends on the number of
+     * threads and on the scheduling. With floating point accumulators (the
+     * fitters in `SimpleFits.h`, `lar::util::ChiSquareAccumulator`) the result
+     * then changes in its last bits from one run to the other.
+     *
+     * Here the items are split in chunks of `chunkSize` items, each filled
+     * into its own copy of `empty` (in parallel), and the partial results are
+     * merged in a fixed tree: chunk `i + 1` into `i` for all even `i`, then
+     * `i + 2` into `i` for all `i` multiple of 4, and so on, each level in
+     * parallel. Neither the chunks nor the order of the merges depend on the
+     * threads, so the result is the same bit by bit with any number of them.
+     * It may differ from filling a single accumulator with all the items, and
+     * it changes with `chunkSize`, which must therefore be a fixed number
+     * (not derived from the number of threads).
+     *
+     * Example:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * lar::util::LinearFit<double> const fit = lar::util::deterministicReduce(
+     *   hits.size(), 1024U, lar::util::LinearFit<double>(),
+     *   [&hits](lar::util::LinearFit<double>& fit, std::size_t b, std::size_t e)
+     *     {
+     *       for (std::size_t i = b; i < e; ++i)
+     *         fit.add(hits[i].WireID().Wire, hits[i].PeakTime());
+     *     }
+     *   );
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * Up to `n / chunkSize` accumulators (rounded up) are kept at the same
+     * time. The threads are the ones of the current TBB task arena.
+     */
+    template <typename Acc, typename Fill, typename Merge>
+    Acc deterministicReduce(
+      std::size_t n, std::size_t chunkSize, Acc const& empty,
+      Fill fill, Merge merge
+      );
+
+    /**
+     * @brief Fills accumulators in parallel, with a reproducible result
+     * @tparam Acc type of the accumulator
+     * @tparam Fill type of the functor filling an accumulator with items
+     * @param n number of items
+     * @param chunkSize number of items in each chunk
+     * @param empty accumulator with no data (copied for each chunk)
+     * @param fill functor `fill(Acc&, begin, end)` adding items [begin, end[
+     * @return an accumulator with all the `n` items
+     * @throw std::logic_error if `chunkSize` is `0`
+     *
+     * The partial results are combined with their `merge()` method, which
+     * the fitters in `SimpleFits.h`, `lar::util::ChiSquareAccumulator` and
+     * `lar::CountersMap` provide.
+     * @see deterministicReduce(std::size_t, std::size_t, Acc const&, Fill, Merge)
+     */
+    template <typename Acc, typename Fill>
+    Acc deterministicReduce
+      (std::size_t n, std::size_t chunkSize, Acc const& empty, Fill fill)
+      {
+        return deterministicReduce(n, chunkSize, empty, fill,
+          [](Acc& into, Acc const& from){ into.merge(from); });
+      }
+
+  } // namespace util
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+template <typename Acc, typename Fill, typename Merge>
+Acc lar::util::deterministicReduce(
+  std::size_t n, std::size_t chunkSize, Acc const& empty,
+  Fill fill, Merge merge
+) {
+  using Range_t = tbb::blocked_range<std::size_t>;
+
+  if (chunkSize == 0U)
+    throw std::logic_error("deterministicReduce(): chunk size can't be 0");
+  if (n == 0U) return empty;
+
+  std::size_t const nChunks = (n + chunkSize - 1) / chunkSize;
+  std::vector<Acc> partials(nChunks, empty);
+
+  // filling of the chunks (parallel)
+  tbb::parallel_for(Range_t(0, nChunks), [&](Range_t const& range){
+    for (std::size_t iChunk = range.begin(); iChunk != range.end(); ++iChunk) {
+      std::size_t const begin = iChunk * chunkSize;
+      fill(partials[iChunk], begin, std::min(n, begin + chunkSize));
+    }
+  });
+
+  // merging in a fixed tree (each level in parallel)
+  for (std::size_t step = 1; step < nChunks; step *= 2) {
+    std::size_t const nPairs = (nChunks - step + 2 * step - 1) / (2 * step);
+    tbb::parallel_for(Range_t(0, nPairs), [&](Range_t const& range){
+      for (std::size_t iPair = range.begin(); iPair != range.end(); ++iPair) {
+        std::size_t const i = iPair * 2 * step;
+        merge(partials[i], partials[i + step]);
+      }
+    });
+  } // for levels
+
+  return std::move(partials.front());
+} // lar::util::deterministicReduce()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_UTILITIES_DETERMINISTICREDUCE_H
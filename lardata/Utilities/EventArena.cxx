@@ -0,0 +1,90 @@
+/**
+ * @file   EventArena.cxx
+ * @brief  Monotonic memory arena for the allocations of a single event
+ * @date   October 14, 2026
+ * @see    EventArena.h
+ */
+
+// our header
+#include "lardata/Utilities/EventArena.h"
+
+// C/C++ standard libraries
+#include <atomic>
+
+
+namespace {
+
+  /// Source of unique arena identifiers (never reused, unlike addresses)
+  std::atomic<std::uint64_t> NextArenaID { 1U };
+
+  /// The last arena used by this thread, and the sub-arena of the thread in it
+  struct ThreadCache_t {
+    std::uint64_t arenaID = 0U;
+    std::pmr::memory_resource* subArena = nullptr;
+  };
+
+  thread_local ThreadCache_t ThreadCache;
+
+  /// Identifier of the threads owning the sub-arenas
+  thread_local std::thread::id const ThisThread = std::this_thread::get_id();
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+lar::EventArena::EventArena(std::size_t blockSize)
+  : fID(NextArenaID++)
+  , fBlockSize(blockSize)
+  {}
+
+
+//------------------------------------------------------------------------------
+lar::EventArena::~EventArena() = default;
+
+
+//------------------------------------------------------------------------------
+void lar::EventArena::release() {
+  std::lock_guard<std::mutex> lock(fSubArenaLock);
+  // the sub-arenas are kept, since the threads have cached them
+  for (auto& subArena: fSubArenas) subArena->release();
+} // lar::EventArena::release()
+
+
+//------------------------------------------------------------------------------
+std::pmr::memory_resource* lar::EventArena::threadResource() {
+  if (ThreadCache.arenaID != fID) {
+    ThreadCache.subArena = findSubArena();
+    ThreadCache.arenaID = fID;
+  }
+  return ThreadCache.subArena;
+} // lar::EventArena::threadResource()
+
+
+//------------------------------------------------------------------------------
+std::size_t lar::EventArena::nSubArenas() const {
+  std::lock_guard<std::mutex> lock(fSubArenaLock);
+  return fSubArenas.size();
+} // lar::EventArena::nSubArenas()
+
+
+//------------------------------------------------------------------------------
+void* lar::EventArena::do_allocate(std::size_t bytes, std::size_t alignment)
+  { return threadResource()->allocate(bytes, alignment); }
+
+
+//------------------------------------------------------------------------------
+auto lar::EventArena::findSubArena() -> SubArena_t* {
+  std::lock_guard<std::mutex> lock(fSubArenaLock);
+  // a thread which alternated with another arena already has its sub-arena
+  for (std::size_t i = 0; i < fSubArenas.size(); ++i)
+    if (fOwners[i] == ThisThread) return fSubArenas[i].get();
+  fSubArenas.push_back((fBlockSize > 0)
+    ? std::make_unique<SubArena_t>(fBlockSize)
+    : std::make_unique<SubArena_t>()
+    );
+  fOwners.push_back(ThisThread);
+  return fSubArenas.back().get();
+} // lar::EventArena::findSubArena()
+
+
+//------------------------------------------------------------------------------
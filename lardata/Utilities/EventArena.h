@@ -0,0 +1,123 @@
+/**
+ * @file   EventArena.h
+ * @brief  Monotonic memory arena for the allocations of a single event
+ * @date   October 14, 2026
+ * @see    EventArena.cxx, SharedArenaAllocator.h
+ */
+
+#ifndef LARDATA_UTILITIES_EVENTARENA_H
+#define LARDATA_UTILITIES_EVENTARENA_H 1
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <memory> // std::unique_ptr<>, std::shared_ptr<>
+#include <memory_resource> // std::pmr::memory_resource, ...
+#include <mutex>
+#include <thread> // std::thread::id
+#include <vector>
+
+
+namespace lar {
+
+  /**
+   * @brief Memory arena holding the working memory of one event
+   *
+   * The arena is a `std::pmr::memory_resource` which hands out memory by
+   * bumping a pointer, and returns all of it at once with `release()`, to be
+   * called at the end of the event. Deallocation of single blocks does
+   * nothing.
+   *
+   * Each thread allocating from the arena gets its own monotonic sub-arena,
+   * so that allocations from different threads (e.g. from TBB tasks) neither
+   * lock nor share cache lines. A thread finds its sub-arena with a look-up
+   * in a thread-local cache; a mutex is taken only the first time a thread
+   * allocates from the arena.
+   *
+   * The arena can be used:
+   * * by any standard container via `std::pmr` allocators, e.g.
+   *   `std::pmr::vector<int> v(arena.allocator<int>())`;
+   * * by the lardata helpers accepting a `std::pmr::memory_resource`, like
+   *   `util::GridContainer3D`;
+   * * by the helpers accepting a shared `lar::SharedArena_t`, like
+   *   `trkf::KHitContainer::setArena()`, when the arena is created with
+   *   `makeEventArena()`.
+   *
+   * All the objects allocated in the arena must be destroyed (or just
+   * forgotten, if trivially destructible) before `release()` is called, and
+   * `release()` must not run while other threads allocate.
+   *
+   * Example:
+   * @code
+   * lar::EventArena arena;
+   * for (art::Event const& event: events) {
+   *   std::pmr::vector<float> charges(arena.allocator<float>());
+   *   // ...
+   *   charges = {}; // or let go out of scope
+   *   arena.release();
+   * }
+   * @endcode
+   */
+  class EventArena: public std::pmr::memory_resource {
+      public:
+
+    /// Constructor: each sub-arena starts with a block of `blockSize` bytes
+    /// (default size if `0`)
+    explicit EventArena(std::size_t blockSize = 0);
+
+    /// Destructor: releases all the memory
+    ~EventArena() override;
+
+    // the arena is identified by its address (see `do_is_equal()`)
+    EventArena(EventArena const&) = delete;
+    EventArena& operator= (EventArena const&) = delete;
+
+    /// Returns all the memory of all sub-arenas to the upstream resource
+    void release();
+
+    /// Returns the sub-arena of the calling thread
+    std::pmr::memory_resource* threadResource();
+
+    /// Returns a polymorphic allocator of `T` using this arena
+    template <typename T>
+    std::pmr::polymorphic_allocator<T> allocator()
+      { return std::pmr::polymorphic_allocator<T>(this); }
+
+    /// Returns the number of threads which allocated from this arena
+    std::size_t nSubArenas() const;
+
+      protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    /// Does nothing: memory is reclaimed by `release()`
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(std::pmr::memory_resource const& other)
+      const noexcept override
+      { return this == &other; }
+
+      private:
+    using SubArena_t = std::pmr::monotonic_buffer_resource;
+
+    std::uint64_t const fID; ///< unique identifier of this arena
+    std::size_t const fBlockSize; ///< size of the first block of sub-arenas
+
+    mutable std::mutex fSubArenaLock; ///< protects the sub-arena lists
+    std::vector<std::unique_ptr<SubArena_t>> fSubArenas; ///< one per thread
+    std::vector<std::thread::id> fOwners; ///< thread of each sub-arena
+
+    /// Returns the sub-arena of the calling thread, creating it if needed
+    SubArena_t* findSubArena();
+
+  }; // class EventArena
+
+
+  /// Creates an event arena which can be shared (see `lar::SharedArena_t`)
+  inline std::shared_ptr<EventArena> makeEventArena(std::size_t blockSize = 0)
+    { return std::make_shared<EventArena>(blockSize); }
+
+} // namespace lar
+
+
+#endif // LARDATA_UTILITIES_EVENTARENA_H
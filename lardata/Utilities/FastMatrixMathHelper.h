@@ -5,8 +5,9 @@
  * @date    March 31st, 2015
  *
  * Currently includes:
- *  - determinant (2x2, 3x3, 4x4)
- *  - inversion (2x2, 3x3, 4x4)
+ *  - determinant (2x2, 3x3, 4x4, 5x5, 6x6)
+ *  - inversion (2x2, 3x3, 4x4, 5x5, 6x6)
+ *  - batch inversion of symmetric matrices (5x5, 6x6)
  *
  */
 
@@ -20,6 +21,8 @@
 #include <iterator> // std::begin(), std::end()
 #include <algorithm> // std::for_each()
 #include <stdexcept> // std::range_error
+#include <cstddef> // std::size_t
+#include <utility> // std::swap()
 
 
 #include "lardataalg/Utilities/StatCollector.h" // lar::util::identity
@@ -351,6 +354,92 @@ namespace lar {
       }; // struct FastMatrixOperations<T, 3>
 
 
+      /**
+       * @brief Matrix operations by decomposition, for larger matrices.
+       * @tparam T data type for the elements of the matrix
+       * @tparam DIM the dimension of the (square) matrix
+       *
+       * For dimensions above 4 the cofactor expansion used for the smaller
+       * matrices grows too fast; these operations use instead:
+       *  - Gaussian elimination with partial pivoting for the determinant;
+       *  - Gauss-Jordan elimination with partial pivoting for the inversion;
+       *  - LDL^T decomposition for the inversion of symmetric matrices, which
+       *    needs no pivoting for positive definite ones (like covariances);
+       *    when a pivot of the decomposition is not positive (the matrix is
+       *    indefinite, or singular) the inversion falls back to Gauss-Jordan
+       *    elimination.
+       *
+       * All loops have a size known at compile time, so that the compiler can
+       * unroll them.
+       *
+       * `InvertSymmetricMatrices()` inverts many symmetric matrices stored in
+       * "structure of arrays" layout, processing a few of them together
+       * element by element, which the compiler can vectorize.
+       */
+      template <typename T, unsigned int DIM>
+      struct FastMatrixOperationsByDecomposition:
+        public FastMatrixOperationsBase<T, DIM>
+      {
+        using Base_t = FastMatrixOperationsBase<T, DIM>;
+        static constexpr unsigned int Dim = Base_t::Dim;
+        using Data_t = typename Base_t::Data_t;
+        using Matrix_t = typename Base_t::Matrix_t;
+
+        /// Number of matrices processed together by `InvertSymmetricMatrices()`
+        static constexpr std::size_t BatchSize = 8;
+
+        /// Computes the determinant of a matrix
+        static Data_t Determinant(Matrix_t const& mat);
+
+        /// Computes the inverse of a matrix (the determinant is not used)
+        static Matrix_t InvertMatrix(Matrix_t const& mat, Data_t /* det */)
+          { return InvertMatrix(mat); }
+
+        /// Computes the inverse of a symmetric matrix
+        /// (the determinant is not used)
+        static Matrix_t InvertSymmetricMatrix
+          (Matrix_t const& mat, Data_t /* det */)
+          { return InvertSymmetricMatrix(mat); }
+
+        /// Computes the inverse of a matrix
+        static Matrix_t InvertMatrix(Matrix_t const& mat);
+
+        /// Computes the inverse of a symmetric matrix
+        static Matrix_t InvertSymmetricMatrix(Matrix_t const& mat);
+
+        /// Inverts a symmetric matrix by Gauss-Jordan elimination
+        /// (only its lower triangle is used, like in `InvertSymmetricMatrix()`)
+        static Matrix_t InvertSymmetricMatrixByElimination(Matrix_t const& mat);
+
+        /**
+         * @brief Inverts many symmetric matrices in "structure of arrays" layout
+         * @param n number of matrices
+         * @param mats the matrices to be inverted
+         * @param inverses where to store the inverse matrices
+         *
+         * Element `[r, c]` of the matrix `k` is stored in
+         * `mats[(r * Dim + c) * n + k]`, and the same layout is used for the
+         * result. Each matrix is inverted as by `InvertSymmetricMatrix()`.
+         * `mats` and `inverses` may be the same array.
+         */
+        static void InvertSymmetricMatrices
+          (std::size_t n, Data_t const* mats, Data_t* inverses);
+
+      }; // struct FastMatrixOperationsByDecomposition<>
+
+
+      /// Routines for 5x5 matrices
+      template <typename T>
+      struct FastMatrixOperations<T, 5>:
+        public FastMatrixOperationsByDecomposition<T, 5>
+        {};
+
+      /// Routines for 6x6 matrices
+      template <typename T>
+      struct FastMatrixOperations<T, 6>:
+        public FastMatrixOperationsByDecomposition<T, 6>
+        {};
+
 
     } // namespace details
   } // namespace util
@@ -514,4 +603,228 @@ auto lar::util::details::FastMatrixOperations<T, 4>::InvertSymmetricMatrix
 } // FastMatrixOperations<T, 4>::InvertSymmetricMatrix()
 
 
+template <typename T, unsigned int DIM>
+auto lar::util::details::FastMatrixOperationsByDecomposition<T, DIM>::Determinant
+  (Matrix_t const& mat) -> Data_t
+{
+  Matrix_t m = mat;
+  Data_t det = Data_t(1);
+  for (unsigned int k = 0; k < Dim; ++k) {
+    // partial pivoting
+    unsigned int pivot = k;
+    for (unsigned int r = k + 1; r < Dim; ++r)
+      if (std::abs(m[r * Dim + k]) > std::abs(m[pivot * Dim + k])) pivot = r;
+    if (m[pivot * Dim + k] == Data_t(0)) return Data_t(0);
+    if (pivot != k) {
+      for (unsigned int c = k; c < Dim; ++c)
+        std::swap(m[k * Dim + c], m[pivot * Dim + c]);
+      det = -det;
+    }
+    Data_t const diag = m[k * Dim + k];
+    det *= diag;
+    for (unsigned int r = k + 1; r < Dim; ++r) {
+      Data_t const f = m[r * Dim + k] / diag;
+      for (unsigned int c = k + 1; c < Dim; ++c)
+        m[r * Dim + c] -= f * m[k * Dim + c];
+    } // for rows
+  } // for k
+  return det;
+} // FastMatrixOperationsByDecomposition<>::Determinant()
+
+
+template <typename T, unsigned int DIM>
+auto lar::util::details::FastMatrixOperationsByDecomposition<T, DIM>::InvertMatrix
+  (Matrix_t const& mat) -> Matrix_t
+{
+  //
+  // Gauss-Jordan elimination on [ mat | 1 ], with partial pivoting
+  //
+  Matrix_t m = mat;
+  Matrix_t Inverse;
+  Inverse.fill(Data_t(0));
+  for (unsigned int i = 0; i < Dim; ++i) Inverse[i * Dim + i] = Data_t(1);
+
+  for (unsigned int k = 0; k < Dim; ++k) {
+    unsigned int pivot = k;
+    for (unsigned int r = k + 1; r < Dim; ++r)
+      if (std::abs(m[r * Dim + k]) > std::abs(m[pivot * Dim + k])) pivot = r;
+    if (pivot != k) {
+      for (unsigned int c = 0; c < Dim; ++c) {
+        std::swap(m[k * Dim + c], m[pivot * Dim + c]);
+        std::swap(Inverse[k * Dim + c], Inverse[pivot * Dim + c]);
+      }
+    }
+    Data_t const factor = Data_t(1) / m[k * Dim + k];
+    for (unsigned int c = 0; c < Dim; ++c) {
+      m[k * Dim + c] *= factor;
+      Inverse[k * Dim + c] *= factor;
+    }
+    for (unsigned int r = 0; r < Dim; ++r) {
+      if (r == k) continue;
+      Data_t const f = m[r * Dim + k];
+      for (unsigned int c = 0; c < Dim; ++c) {
+        m[r * Dim + c] -= f * m[k * Dim + c];
+        Inverse[r * Dim + c] -= f * Inverse[k * Dim + c];
+      }
+    } // for rows
+  } // for k
+  return Inverse;
+} // FastMatrixOperationsByDecomposition<>::InvertMatrix()
+
+
+template <typename T, unsigned int DIM>
+auto lar::util::details::FastMatrixOperationsByDecomposition<T, DIM>::InvertSymmetricMatrix
+  (Matrix_t const& mat) -> Matrix_t
+{
+  //
+  // mat = L D L^T, with L unit lower triangular and D diagonal;
+  // then mat^-1 = L^-T D^-1 L^-1; only the lower triangle of mat is used
+  //
+  Matrix_t L; // strictly lower triangle: L; diagonal: 1/D
+  std::array<Data_t, Dim> D;
+  for (unsigned int j = 0; j < Dim; ++j) {
+    Data_t d = mat[j * Dim + j];
+    for (unsigned int k = 0; k < j; ++k)
+      d -= L[j * Dim + k] * L[j * Dim + k] * D[k];
+    // no LDL^T decomposition without pivoting
+    if (!(d > Data_t(0))) return InvertSymmetricMatrixByElimination(mat);
+    D[j] = d;
+    Data_t const invD = L[j * Dim + j] = Data_t(1) / d;
+    for (unsigned int i = j + 1; i < Dim; ++i) {
+      Data_t v = mat[i * Dim + j];
+      for (unsigned int k = 0; k < j; ++k)
+        v -= L[i * Dim + k] * L[j * Dim + k] * D[k];
+      L[i * Dim + j] = v * invD;
+    } // for i
+  } // for j
+
+  // inverse of L (unit lower triangular), in the upper triangle of L;
+  // element [i, j] (i > j) of L^-1 is stored as L[j, i]
+  for (unsigned int j = 0; j < Dim; ++j) {
+    for (unsigned int i = j + 1; i < Dim; ++i) {
+      Data_t v = -L[i * Dim + j];
+      for (unsigned int k = j + 1; k < i; ++k)
+        v -= L[i * Dim + k] * L[j * Dim + k];
+      L[j * Dim + i] = v;
+    } // for i
+  } // for j
+
+  Matrix_t Inverse;
+  for (unsigned int i = 0; i < Dim; ++i) {
+    for (unsigned int j = 0; j <= i; ++j) {
+      // sum over k >= i of Linv[k, i] Linv[k, j] / D[k]
+      Data_t v = ((i == j)? Data_t(1): L[j * Dim + i]) * L[i * Dim + i];
+      for (unsigned int k = i + 1; k < Dim; ++k)
+        v += L[i * Dim + k] * L[j * Dim + k] * L[k * Dim + k];
+      Inverse[i * Dim + j] = Inverse[j * Dim + i] = v;
+    } // for j
+  } // for i
+  return Inverse;
+} // FastMatrixOperationsByDecomposition<>::InvertSymmetricMatrix()
+
+
+template <typename T, unsigned int DIM>
+auto lar::util::details::FastMatrixOperationsByDecomposition<T, DIM>::InvertSymmetricMatrixByElimination
+  (Matrix_t const& mat) -> Matrix_t
+{
+  Matrix_t m;
+  for (unsigned int i = 0; i < Dim; ++i) {
+    for (unsigned int j = 0; j <= i; ++j)
+      m[i * Dim + j] = m[j * Dim + i] = mat[i * Dim + j];
+  } // for i
+  Matrix_t Inverse = InvertMatrix(m);
+  // the elimination does not preserve the symmetry exactly
+  for (unsigned int i = 0; i < Dim; ++i) {
+    for (unsigned int j = 0; j < i; ++j) {
+      Inverse[i * Dim + j] = Inverse[j * Dim + i]
+        = (Inverse[i * Dim + j] + Inverse[j * Dim + i]) / Data_t(2);
+    } // for j
+  } // for i
+  return Inverse;
+} // FastMatrixOperationsByDecomposition<>::InvertSymmetricMatrixByElimination()
+
+
+template <typename T, unsigned int DIM>
+void lar::util::details::FastMatrixOperationsByDecomposition<T, DIM>::InvertSymmetricMatrices
+  (std::size_t n, Data_t const* mats, Data_t* inverses)
+{
+  //
+  // same algorithm as InvertSymmetricMatrix(), with each operation repeated
+  // for BatchSize matrices at a time; the matrices with a non-positive pivot
+  // are inverted one by one after their batch
+  //
+  constexpr std::size_t B = BatchSize;
+  for (std::size_t first = 0; first < n; first += B) {
+    std::size_t const nBatch = std::min(B, n - first);
+
+    Data_t L[Dim * Dim][B];
+    Data_t D[Dim][B];
+    bool indefinite[B] = {};
+    for (unsigned int j = 0; j < Dim; ++j) {
+      Data_t* d = D[j];
+      for (std::size_t b = 0; b < B; ++b)
+        d[b] = (b < nBatch)? mats[(j * Dim + j) * n + first + b]: Data_t(1);
+      for (unsigned int k = 0; k < j; ++k) {
+        for (std::size_t b = 0; b < B; ++b)
+          d[b] -= L[j * Dim + k][b] * L[j * Dim + k][b] * D[k][b];
+      }
+      for (std::size_t b = 0; b < B; ++b)
+        indefinite[b] = indefinite[b] || !(d[b] > Data_t(0));
+      for (std::size_t b = 0; b < B; ++b) L[j * Dim + j][b] = Data_t(1) / d[b];
+      for (unsigned int i = j + 1; i < Dim; ++i) {
+        Data_t v[B];
+        for (std::size_t b = 0; b < B; ++b)
+          v[b] = (b < nBatch)? mats[(i * Dim + j) * n + first + b]: Data_t(0);
+        for (unsigned int k = 0; k < j; ++k) {
+          for (std::size_t b = 0; b < B; ++b)
+            v[b] -= L[i * Dim + k][b] * L[j * Dim + k][b] * D[k][b];
+        }
+        for (std::size_t b = 0; b < B; ++b)
+          L[i * Dim + j][b] = v[b] * L[j * Dim + j][b];
+      } // for i
+    } // for j
+
+    for (unsigned int j = 0; j < Dim; ++j) {
+      for (unsigned int i = j + 1; i < Dim; ++i) {
+        Data_t v[B];
+        for (std::size_t b = 0; b < B; ++b) v[b] = -L[i * Dim + j][b];
+        for (unsigned int k = j + 1; k < i; ++k) {
+          for (std::size_t b = 0; b < B; ++b)
+            v[b] -= L[i * Dim + k][b] * L[j * Dim + k][b];
+        }
+        for (std::size_t b = 0; b < B; ++b) L[j * Dim + i][b] = v[b];
+      } // for i
+    } // for j
+
+    for (unsigned int i = 0; i < Dim; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+        Data_t v[B];
+        for (std::size_t b = 0; b < B; ++b) {
+          v[b] = ((i == j)? Data_t(1): L[j * Dim + i][b]) * L[i * Dim + i][b];
+        }
+        for (unsigned int k = i + 1; k < Dim; ++k) {
+          for (std::size_t b = 0; b < B; ++b)
+            v[b] += L[i * Dim + k][b] * L[j * Dim + k][b] * L[k * Dim + k][b];
+        }
+        for (std::size_t b = 0; b < nBatch; ++b) {
+          if (indefinite[b]) continue; // its matrix may still be needed
+          inverses[(i * Dim + j) * n + first + b]
+            = inverses[(j * Dim + i) * n + first + b] = v[b];
+        }
+      } // for j
+    } // for i
+
+    for (std::size_t b = 0; b < nBatch; ++b) {
+      if (!indefinite[b]) continue;
+      Matrix_t mat;
+      for (unsigned int e = 0; e < Dim * Dim; ++e)
+        mat[e] = mats[e * n + first + b];
+      Matrix_t const Inverse = InvertSymmetricMatrixByElimination(mat);
+      for (unsigned int e = 0; e < Dim * Dim; ++e)
+        inverses[e * n + first + b] = Inverse[e];
+    } // for
+  } // for batches
+} // FastMatrixOperationsByDecomposition<>::InvertSymmetricMatrices()
+
+
 #endif // FASTMATRIXMATHHELPER_H
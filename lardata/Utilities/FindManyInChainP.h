@@ -11,6 +11,9 @@
 #ifndef LARDATA_UTILITIES_FINDMANYINCHAINP_H
 #define LARDATA_UTILITIES_FINDMANYINCHAINP_H
 
+// LArSoft libraries
+#include "lardata/Utilities/CollectionView.h" // lar::RangeAsCollection_t
+
 // framework
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Utilities/InputTag.h"
@@ -19,6 +22,8 @@
 #include <vector>
 #include <utility> // std::forward()
 #include <initializer_list>
+#include <stdexcept> // std::out_of_range
+#include <string> // std::to_string()
 #include <cstdlib> // std::size_t
 
 
@@ -46,6 +51,74 @@ namespace lar {
   /// Value for default tag in `FindManyInChainP` constructors.
   constexpr SameAsDataTag SameAsData;
 
+  /// Type for the parallel option of `FindManyInChainP::findIndexed()`.
+  struct ParallelTraversalTag {};
+
+  /// Value for the parallel option of `FindManyInChainP::findIndexed()`.
+  constexpr ParallelTraversalTag ParallelTraversal;
+
+
+  /**
+   * @brief Lists of _art_ pointers, one per source, stored contiguously.
+   * @tparam T type of the pointed objects
+   *
+   * All the pointers are stored in a single vector, the ones of each source
+   * after the ones of the previous source; `at(i)` returns a view of the
+   * pointers of the `i`-th source.
+   */
+  template <typename T>
+  class FlatPtrLists {
+      public:
+    using Ptr_t = art::Ptr<T>; ///< Type of the stored pointers.
+
+    /// Type of view of the pointers of one source.
+    using List_t = lar::RangeAsCollection_t<Ptr_t const*>;
+
+    /// Constructor: empty lists.
+    FlatPtrLists() = default;
+
+    /// Constructor: `ptrs` of the `i`-th list start at `ptrs[offsets[i]]`.
+    FlatPtrLists
+      (std::vector<Ptr_t>&& allPtrs, std::vector<std::size_t>&& listStarts)
+      : ptrs(std::move(allPtrs)), offsets(std::move(listStarts))
+      {}
+
+    /// Returns the number of lists.
+    std::size_t size() const noexcept
+      { return offsets.empty()? 0U: offsets.size() - 1U; }
+
+    /// Returns whether there are no lists.
+    bool empty() const noexcept { return size() == 0U; }
+
+    /// Returns the pointers in the list `i` (no check on `i`).
+    List_t operator[] (std::size_t i) const
+      {
+        Ptr_t const* const first = ptrs.data();
+        return lar::makeCollectionView
+          (first + offsets[i], first + offsets[i + 1]);
+      }
+
+    /// Returns the pointers in the list `i`.
+    /// @throw std::out_of_range if the specified index is not valid
+    List_t at(std::size_t i) const
+      {
+        if (i >= size()) {
+          throw std::out_of_range("FlatPtrLists: list #" + std::to_string(i)
+            + " requested, only " + std::to_string(size()) + " present");
+        }
+        return operator[](i);
+      }
+
+    /// Returns all the pointers, in list order.
+    std::vector<Ptr_t> const& allPtrs() const noexcept { return ptrs; }
+
+      private:
+    std::vector<Ptr_t> ptrs; ///< All the pointers.
+    std::vector<std::size_t> offsets; ///< Start of each list, plus the end.
+
+  }; // class FlatPtrLists<>
+
+
   /**
    * @brief  Query object collecting a list of associated objects.
    * @tparam Target type of objects to be fetched
@@ -116,6 +189,9 @@ namespace lar {
     /// Type returned by `at()` method.
     using TargetPtrCollection_t = std::vector<TargetPtr_t>;
 
+    /// Type returned by `findIndexed()`.
+    using IndexedResult_t = FlatPtrLists<Target_t>;
+
     /**
      * @brief Constructor: extracts target objects associated to all objects
      *        under the specified handle.
@@ -221,6 +297,58 @@ namespace lar {
     static std::vector<TargetPtrCollection_t> find
       (Source&& source, Event const& event, InputTags... tags);
 
+
+    /**
+     * @brief Returns target objects associated to all objects contained in the
+     *        specified source, using prebuilt indices.
+     * @tparam Source type of source: art Handle or collection of art pointers
+     * @tparam Event type of event to be used (either _art_ or gallery `Event`)
+     * @tparam InputTags a variable number of `art::InputTag` objects
+     * @param source art Handle or collection of art pointers to source objects
+     * @param event the event to read associations and objects from
+     * @param tags input tags for each one of the required associations
+     * @return lists of pointers to associated objects, one for each source
+     *         element, in the same order
+     * @see find()
+     *
+     * The arguments and the result are the same as in `find()`, but the
+     * lists are all stored in a single `lar::FlatPtrLists` object.
+     *
+     * Each association data product of the chain is read in full once, and
+     * turned into an index with, for each key of the left object, the range
+     * of its associated right objects. The associated objects of each source
+     * are then collected by walking down the indices, with no sorting and no
+     * search. This is faster than `find()` when a sizeable fraction of the
+     * associations is reached by the sources (e.g. all the particles of an
+     * event), while `find()` may be cheaper for a handful of sources.
+     *
+     * The targets of each source are in the order of the associations, level
+     * by level. A target reached from a source via different intermediate
+     * objects appears once per path.
+     */
+    template <typename Source, typename Event, typename... InputTags>
+    static IndexedResult_t findIndexed
+      (Source&& source, Event const& event, InputTags... tags);
+
+    /**
+     * @brief Like `findIndexed()`, with the sources processed in parallel.
+     * @see findIndexed()
+     *
+     * The indices are built sequentially; the traversal of the sources is
+     * then split among TBB tasks. The result is the same as `findIndexed()`.
+     * Example:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto const particleHits
+     *   = lar::FindManyInChainP<recob::Hit, recob::Cluster>::findIndexed
+     *   (lar::ParallelTraversal, particles, event, particleTag);
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    template <typename Source, typename Event, typename... InputTags>
+    static IndexedResult_t findIndexed(
+      ParallelTraversalTag, Source&& source, Event const& event,
+      InputTags... tags
+      );
+
       private:
     std::vector<TargetPtrCollection_t> results; ///< Stored results.
 
@@ -13,6 +13,13 @@
 #error "FindManyInChainP.tcc must not be included directly. Include FindManyInChainP.h instead."
 #endif // LARDATA_UTILITIES_FINDMANYINCHAINP_H
 
+// LArSoft libraries
+#include "lardata/Utilities/AllocationAccounting.h"
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 // framework
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Persistency/Common/FindManyP.h"
@@ -25,6 +32,8 @@
 #include <iterator> // std::begin(), std::cbegin(), std::distance()...
 #include <tuple> // std::tuple_cat(), ...
 #include <algorithm> // std::lower_bound(), std::sort(), std::transform()...
+#include <numeric> // std::partial_sum()
+#include <cstddef> // std::nullptr_t
 #include <utility> // std::pair<>, std::move(), std::declval()...
 #include <type_traits> // std::decay_t<>, std::enable_if_t<>, ...
 
@@ -35,6 +44,10 @@
 namespace lar {
   
   namespace details {
+
+    /// Tag of the allocations of the association indices.
+    struct FindManyInChainPAllocationTag
+      { static constexpr char const* Name = "FindManyInChainP"; };
     
     //--------------------------------------------------------------------------
     // this is a copy of things in cetlib; should be replaced by the original
@@ -1028,6 +1041,358 @@ namespace lar {
     }; // FindManyInChainPimpl
     
     
+    //--------------------------------------------------------------------------
+    //---  indexed finder implementation
+    //---
+    
+    namespace IndexedChain {
+      
+      /// Identifier of an object: its product ID and its key within it.
+      using ObjectKey_t = std::pair<art::ProductID, std::size_t>;
+      
+      
+      /// Returns the identifiers of all the objects under the handle.
+      template <typename Handle>
+      std::enable_if_t<is_handle_v<Handle>, std::vector<ObjectKey_t>>
+      sourceKeys(Handle const& handle)
+      {
+        // FIXME: this implementation is NOT canvas-compatible (Handle::id())
+        art::ProductID const id = handle.id();
+        std::vector<ObjectKey_t> keys;
+        keys.reserve(handle->size());
+        for (std::size_t i = 0; i < handle->size(); ++i) keys.emplace_back(id, i);
+        return keys;
+      } // sourceKeys(Handle)
+      
+      /// Returns the identifiers of all the objects in the pointer collection.
+      template <typename PtrColl>
+      std::enable_if_t<!is_handle_v<PtrColl>, std::vector<ObjectKey_t>>
+      sourceKeys(PtrColl const& coll)
+      {
+        std::vector<ObjectKey_t> keys;
+        for (auto const& ptr: coll) keys.emplace_back(ptr.id(), ptr.key());
+        return keys;
+      } // sourceKeys(PtrColl)
+      
+      
+      /// Type of the objects in the source (art Handle or pointer collection).
+      template <typename Source, typename = void>
+      struct SourceType {
+        using type = typename std::decay_t
+          <decltype(*std::cbegin(std::declval<Source const&>()))>::value_type;
+      };
+      
+      template <typename Source>
+      struct SourceType<Source, enable_if_is_handle_t<Source>> {
+        using type = typename std::decay_t<Source>::element_type::value_type;
+      };
+      
+      template <typename Source>
+      using SourceType_t = typename SourceType<std::decay_t<Source>>::type;
+      
+      
+      /**
+       * @brief Index of the right objects associated to each left object.
+       * @tparam Right type of the right (associated) objects
+       *
+       * For each product ID of the left objects, the right pointers are
+       * stored sorted by the key of their left object, with an offset table
+       * of their start by key (compressed sparse row format).
+       * The right pointers of each left object keep the association order.
+       */
+      template <typename Right>
+      class AssnsIndex {
+          public:
+        using RightPtr_t = art::Ptr<Right>;
+        
+        /// Range of right pointers associated to a single left object.
+        using Range_t = std::pair<RightPtr_t const*, RightPtr_t const*>;
+        
+        /// Indexes all the associations in `assns`.
+        template <typename Assns>
+        void addAll(Assns const& assns)
+          { fill(assns, [](art::ProductID const&){ return true; }); }
+        
+        /// Indexes the associations of `assns` with left objects from `id`.
+        template <typename Assns>
+        void add(Assns const& assns, art::ProductID const& id)
+          { fill(assns, [id](art::ProductID const& left){ return left == id; }); }
+        
+        /// Returns the right pointers associated to the specified left one.
+        Range_t children(art::ProductID const& id, std::size_t key) const
+          {
+            for (ProductIndex_t const& product: products) {
+              if (product.id != id) continue;
+              if (key + 1 >= product.offsets.size()) break;
+              RightPtr_t const* const first = product.children.data();
+              return
+                { first + product.offsets[key], first + product.offsets[key + 1] };
+            } // for
+            return { nullptr, nullptr };
+          } // children()
+        
+        /// Returns the product IDs of all the indexed right pointers.
+        std::vector<art::ProductID> const& rightProducts() const
+          { return rightIDs; }
+        
+          private:
+        
+        /// The index of the associations with left objects from one product.
+        struct ProductIndex_t {
+          template <typename T>
+          using Vector_t = lar::TaggedVector<T, FindManyInChainPAllocationTag>;
+          
+          art::ProductID id; ///< ID of the left objects.
+          Vector_t<std::size_t> offsets; ///< Start of `children` by key.
+          Vector_t<RightPtr_t> children; ///< Right pointers, by left key.
+        }; // ProductIndex_t
+        
+        std::vector<ProductIndex_t> products; ///< Index of each left product.
+        std::vector<art::ProductID> rightIDs; ///< Product IDs of right objects.
+        
+        /// Indexes the associations with left objects accepted by `accept`,
+        /// whose product must not have been indexed yet.
+        template <typename Assns, typename Pred>
+        void fill(Assns const& assns, Pred accept)
+          {
+            std::size_t const firstNew = products.size();
+            
+            // finds the index of the left product, creating it if needed;
+            // the last one found is tried first
+            std::size_t last = firstNew;
+            auto productFor = [this, firstNew, &last](art::ProductID const& id)
+              -> ProductIndex_t&
+              {
+                if ((last < products.size()) && (products[last].id == id))
+                  return products[last];
+                for (last = firstNew; last < products.size(); ++last)
+                  if (products[last].id == id) return products[last];
+                products.push_back({ id, {}, {} });
+                return products.back();
+              };
+            
+            // first pass: count the associations of each left key
+            for (decltype(auto) assn: assns) {
+              art::ProductID const& id = assn.first.id();
+              if (!accept(id)) continue;
+              std::size_t const key = assn.first.key();
+              auto& offsets = productFor(id).offsets;
+              if (offsets.size() < key + 2) offsets.resize(key + 2, 0U);
+              ++offsets[key + 1];
+            } // for
+            
+            for (std::size_t i = firstNew; i < products.size(); ++i) {
+              auto& offsets = products[i].offsets;
+              std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+              products[i].children.resize(offsets.back());
+            } // for
+            
+            // second pass: fill, using `offsets[key]` as cursor for `key`
+            for (decltype(auto) assn: assns) {
+              art::ProductID const& id = assn.first.id();
+              if (!accept(id)) continue;
+              ProductIndex_t& product = productFor(id);
+              RightPtr_t const& right = assn.second;
+              product.children[product.offsets[assn.first.key()]++] = right;
+              if (rightIDs.empty() || (rightIDs.back() != right.id())) {
+                if (std::find(rightIDs.begin(), rightIDs.end(), right.id())
+                  == rightIDs.end()
+                  )
+                  rightIDs.push_back(right.id());
+              }
+            } // for
+            
+            // each cursor is now at the start of the next key: shift them back
+            for (std::size_t i = firstNew; i < products.size(); ++i) {
+              auto& offsets = products[i].offsets;
+              std::copy_backward
+                (offsets.begin(), offsets.end() - 1, offsets.end());
+              offsets.front() = 0U;
+            } // for
+            
+          } // fill()
+        
+      }; // class AssnsIndex<>
+      
+      
+      /**
+       * @brief One level of the association chain, and all the following.
+       * @tparam Level level of the chain (`0` is the one from the source)
+       * @tparam Left type of objects on the left of the association
+       * @tparam Target type of objects at the end of the chain
+       * @tparam Intermediate intermediate types, leftmost is closest to `Target`
+       */
+      template <
+        unsigned int Level, typename Left,
+        typename Target, typename... Intermediate
+        >
+      class ChainLevel {
+        
+        /// Total number of levels (original source + all intermediates).
+        static constexpr unsigned int Tiers = sizeof...(Intermediate) + 1;
+        
+        /// Whether this level associates to `Target`.
+        static constexpr bool IsLast = (Level + 1 == Tiers);
+        
+        /// Type of objects on the right of the association.
+        using Right_t = get_type_t<(Tiers - 1 - Level), Target, Intermediate...>;
+        
+        /// Type of the next level (unused for the last one).
+        using NextLevel_t = std::conditional_t<IsLast,
+          std::nullptr_t,
+          ChainLevel<(Level + 1), Right_t, Target, Intermediate...>
+          >;
+        
+          public:
+        
+        /**
+         * @brief Indexes the associations of this and the following levels.
+         * @param event the event to read associations from
+         * @param tags all the tags of the chain
+         * @param leftIDs product IDs of the possible left objects
+         *
+         * The product IDs are used only with `lar::SameAsData` tags, to find
+         * the tags of the association data products.
+         */
+        template <typename Event, typename InputTags>
+        void build(
+          Event const& event, InputTags const& tags,
+          std::vector<art::ProductID> const& leftIDs
+          )
+          {
+            buildIndex(event, std::get<Level>(tags), leftIDs);
+            if constexpr (!IsLast)
+              next.build(event, tags, index.rightProducts());
+          } // build()
+        
+        /// Returns the number of targets associated to the specified object.
+        std::size_t count(art::ProductID const& id, std::size_t key) const
+          {
+            auto const children = index.children(id, key);
+            if constexpr (IsLast) {
+              return std::distance(children.first, children.second);
+            }
+            else {
+              std::size_t n = 0U;
+              for (auto it = children.first; it != children.second; ++it)
+                n += next.count(it->id(), it->key());
+              return n;
+            }
+          } // count()
+        
+        /// Copies into `out` the targets associated to the specified object.
+        template <typename OutIter>
+        OutIter copy(art::ProductID const& id, std::size_t key, OutIter out) const
+          {
+            auto const children = index.children(id, key);
+            if constexpr (IsLast) {
+              return std::copy(children.first, children.second, out);
+            }
+            else {
+              for (auto it = children.first; it != children.second; ++it)
+                out = next.copy(it->id(), it->key(), out);
+              return out;
+            }
+          } // copy()
+        
+          private:
+        AssnsIndex<Right_t> index; ///< Index of the associations of this level.
+        NextLevel_t next; ///< The next levels.
+        
+        /// Indexes the associations from the specified data product.
+        template <typename Event>
+        void buildIndex(
+          Event const& event, art::InputTag const& tag,
+          std::vector<art::ProductID> const&
+          )
+          {
+            index.addAll(*(event.template getValidHandle
+              <art::Assns<Left, Right_t>>(tag)));
+          } // buildIndex(InputTag)
+        
+        /// Indexes the associations from the producer of each left product.
+        template <typename Event>
+        void buildIndex(
+          Event const& event, lar::SameAsDataTag,
+          std::vector<art::ProductID> const& leftIDs
+          )
+          {
+            for (art::ProductID const& id: leftIDs) {
+              art::InputTag const tag
+                = tagFromProductID<std::vector<Left>>(id, event);
+              index.add(*(event.template getValidHandle
+                <art::Assns<Left, Right_t>>(tag)), id);
+            } // for
+          } // buildIndex(SameAsData)
+        
+      }; // class ChainLevel<>
+      
+      
+      /// Collects the targets of all sources, using indices of the chain.
+      template <typename Target, typename... Intermediate>
+      struct IndexedFinder {
+        
+        using TargetPtr_t = art::Ptr<Target>;
+        
+        template <typename Source, typename Event, typename InputTags>
+        static FlatPtrLists<Target> find(
+          bool parallel, Source const& source, Event const& event,
+          InputTags const& tags
+          )
+          {
+            using Chain_t
+              = ChainLevel<0U, SourceType_t<Source>, Target, Intermediate...>;
+            
+            std::vector<ObjectKey_t> const keys = sourceKeys(source);
+            std::size_t const nSources = keys.size();
+            
+            std::vector<art::ProductID> sourceIDs;
+            for (ObjectKey_t const& key: keys) {
+              if (std::find(sourceIDs.begin(), sourceIDs.end(), key.first)
+                == sourceIDs.end()
+                )
+                sourceIDs.push_back(key.first);
+            } // for
+            
+            Chain_t chain;
+            chain.build(event, tags, sourceIDs);
+            
+            std::vector<std::size_t> offsets;
+            std::vector<TargetPtr_t> targets;
+            
+            if (!parallel) {
+              offsets.reserve(nSources + 1);
+              offsets.push_back(0U);
+              for (ObjectKey_t const& key: keys) {
+                chain.copy(key.first, key.second, std::back_inserter(targets));
+                offsets.push_back(targets.size());
+              }
+              return { std::move(targets), std::move(offsets) };
+            }
+            
+            // parallel: count the targets of each source, then fill
+            using Range_t = tbb::blocked_range<std::size_t>;
+            offsets.assign(nSources + 1, 0U);
+            tbb::parallel_for(Range_t(0U, nSources), [&](Range_t const& r){
+              for (std::size_t i = r.begin(); i != r.end(); ++i)
+                offsets[i + 1] = chain.count(keys[i].first, keys[i].second);
+            });
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            
+            targets.resize(offsets.back());
+            tbb::parallel_for(Range_t(0U, nSources), [&](Range_t const& r){
+              for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                chain.copy
+                  (keys[i].first, keys[i].second, targets.begin() + offsets[i]);
+              }
+            });
+            return { std::move(targets), std::move(offsets) };
+          } // find()
+        
+      }; // struct IndexedFinder<>
+      
+    } // namespace IndexedChain
+    
     
     //--------------------------------------------------------------------------
     
@@ -1067,6 +1432,46 @@ auto lar::FindManyInChainP<Target, Intermediate...>::find
 } // lar::FindManyInChainP<Target, Intermediate...>::FindManyInChainP()
 
 
+//------------------------------------------------------------------------------
+template <typename Target, typename... Intermediate>
+template <typename Source, typename Event, typename... InputTags>
+auto lar::FindManyInChainP<Target, Intermediate...>::findIndexed
+  (Source&& source, Event const& event, InputTags... tags)
+  -> IndexedResult_t
+{
+  constexpr auto Tiers = sizeof...(Intermediate) + 1U;
+  
+  auto const allTags
+    = details::AssociationFinderBase::makeTagsTuple<Tiers>
+    (SameAsData, std::forward<InputTags>(tags)...);
+  
+  return details::IndexedChain::IndexedFinder<Target, Intermediate...>::find
+    (false, source, event, allTags);
+  
+} // lar::FindManyInChainP<Target, Intermediate...>::findIndexed()
+
+
+//------------------------------------------------------------------------------
+template <typename Target, typename... Intermediate>
+template <typename Source, typename Event, typename... InputTags>
+auto lar::FindManyInChainP<Target, Intermediate...>::findIndexed(
+  ParallelTraversalTag, Source&& source, Event const& event,
+  InputTags... tags
+  )
+  -> IndexedResult_t
+{
+  constexpr auto Tiers = sizeof...(Intermediate) + 1U;
+  
+  auto const allTags
+    = details::AssociationFinderBase::makeTagsTuple<Tiers>
+    (SameAsData, std::forward<InputTags>(tags)...);
+  
+  return details::IndexedChain::IndexedFinder<Target, Intermediate...>::find
+    (true, source, event, allTags);
+  
+} // lar::FindManyInChainP<Target, Intermediate...>::findIndexed(parallel)
+
+
 //------------------------------------------------------------------------------
 template <typename Target, typename... Intermediate>
 std::size_t
@@ -0,0 +1,236 @@
+/**
+ * @file   FixedTensorIndices.h
+ * @brief  Flattening of multi-dimension indices with sizes fixed at compile time
+ * @date   October 14, 2026
+ * @see    TensorIndices.h
+ *
+ * This header provides:
+ *
+ * * util::FixedTensorIndices: row-major indices with the dimension sizes as
+ *   template arguments, with the interface of util::TensorIndices
+ *
+ * This is a pure header that contains only template classes.
+ */
+
+#ifndef LARDATA_UTILITIES_FIXEDTENSORINDICES_H
+#define LARDATA_UTILITIES_FIXEDTENSORINDICES_H
+
+// LArSoft libraries
+#include "lardata/Utilities/TensorIndices.h" // util::TensorIndicesBasicTypes
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <array>
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <string> // std::to_string()
+#include <type_traits> // std::enable_if_t
+#include <utility> // std::index_sequence
+
+
+namespace util {
+
+  /**
+   * @brief Converts tensor indices into a linear index, with fixed sizes
+   * @tparam DIMS the size of each dimension of the tensor
+   *
+   * This class has the same interface and the same (row-major) linear index
+   * as `util::TensorIndices<sizeof...(DIMS)>`, but the sizes of the
+   * dimensions are compile-time constants. The strides are then constants
+   * too, and the compiler reduces the index computation to shifts and adds
+   * (just shifts for powers of 2), and can fully unroll the loops on the
+   * dimensions and on the cells of a grid (`util::GridContainer3DFixedIndices`).
+   *
+   * The object holds no data, and all instances of the same type are
+   * equivalent.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * util::FixedTensorIndices<100, 100, 50> indices;
+   * std::vector<double> v(indices.size(), 0.);
+   * v[indices(12, 34, 5)] = 1.0;
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <TensorIndicesBasicTypes::DimSize_t... DIMS>
+  class FixedTensorIndices {
+    static constexpr unsigned int RANK = sizeof...(DIMS); ///< rank
+    static_assert(RANK > 0, "FixedTensorIndices must have rank 1 or higher");
+
+      public:
+
+    /// Type of a single index in the tensor
+    using Index_t    = TensorIndicesBasicTypes::Index_t   ;
+
+    /// Type for the specification of a dimension size
+    using DimSize_t  = TensorIndicesBasicTypes::DimSize_t ;
+
+    /// Type of the linear index
+    using LinIndex_t = TensorIndicesBasicTypes::LinIndex_t;
+
+
+    /// Rank of this tensor
+    static constexpr unsigned int rank() { return RANK; }
+
+    /// Returns the sizes of all the dimensions
+    static constexpr std::array<DimSize_t, RANK> dimensions()
+      { return {{ DIMS... }}; }
+
+
+    /// Constructor: the dimensions are the ones of the type
+    constexpr FixedTensorIndices() = default;
+
+    /// Constructor: checks that `rank()` values match the dimensions
+    /// @throw std::invalid_argument if any size is different
+    template <
+      typename ITER,
+      typename = std::enable_if_t
+        <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, void>
+      >
+    FixedTensorIndices(ITER dimIter)
+      {
+        for (unsigned int d = 0; d < RANK; ++d, ++dimIter) {
+          if (DimSize_t(*dimIter) == Dims[d]) continue;
+          throw std::invalid_argument("FixedTensorIndices: size "
+            + std::to_string(*dimIter) + " requested for dimension #"
+            + std::to_string(d) + " of size " + std::to_string(Dims[d]));
+        } // for
+      }
+
+
+    /// Returns the linear index of the indices pointed by `indexIter`
+    /// (no check on the validity of the indices)
+    template <typename ITER>
+    constexpr std::enable_if_t
+      <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, LinIndex_t>
+    operator() (ITER indexIter) const
+      {
+        LinIndex_t linIndex = 0;
+        for (unsigned int d = 0; d < RANK; ++d, ++indexIter)
+          linIndex += LinIndex_t(*indexIter) * Strides[d];
+        return linIndex;
+      }
+
+    /// Returns the linear index of the specified indices (no check)
+    template <typename... INDICES>
+    constexpr LinIndex_t operator() (Index_t first, INDICES... others) const
+      {
+        static_assert(sizeof...(INDICES) + 1 == RANK,
+          "Wrong number of indices for FixedTensorIndices");
+        return linIndex(std::make_index_sequence<RANK>(),
+          LinIndex_t(first), LinIndex_t(others)...);
+      }
+
+    /// Returns the linear index of the specified indices
+    /// @throw std::out_of_range if any index is not valid
+    template <typename ITER>
+    std::enable_if_t
+      <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, LinIndex_t>
+    at(ITER indexIter) const
+      {
+        ITER iter = indexIter;
+        for (unsigned int d = 0; d < RANK; ++d, ++iter) {
+          if (hasIndex(d, *iter)) continue;
+          throw std::out_of_range("Requested index " + std::to_string(*iter)
+            + " for dimension #" + std::to_string(d) + " of size "
+            + std::to_string(Dims[d]));
+        }
+        return operator()(indexIter);
+      }
+
+    /// Returns the indices of the element with the specified linear index
+    constexpr std::array<Index_t, RANK> indices(LinIndex_t linIndex) const
+      {
+        std::array<Index_t, RANK> indices {};
+        for (unsigned int d = 0; d < RANK; ++d) {
+          indices[d] = Index_t(linIndex / Strides[d]);
+          linIndex %= Strides[d];
+        }
+        return indices;
+      }
+
+
+    /// Returns whether all the indices pointed by `indexIter` are valid
+    template <typename ITER>
+    constexpr std::enable_if_t
+      <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, bool>
+    has(ITER indexIter) const
+      {
+        for (unsigned int d = 0; d < RANK; ++d, ++indexIter)
+          if (!hasIndex(d, *indexIter)) return false;
+        return true;
+      }
+
+    /// Returns whether the specified index is valid for dimension `DIM`
+    template <unsigned int DIM>
+    constexpr bool hasIndex(Index_t index) const
+      {
+        static_assert(DIM < RANK, "Invalid dimension requested");
+        return hasIndex(DIM, index);
+      }
+
+    /// Returns whether the specified linear index is valid in this tensor
+    constexpr bool hasLinIndex(LinIndex_t linIndex) const
+      { return linIndex < size(); }
+
+
+    /// Returns the size of the linear index range
+    static constexpr DimSize_t size() { return Strides[0] * Dims[0]; }
+
+    /// Returns the size of the minor tensor starting at dimension `DIM`
+    template <unsigned int DIM>
+    static constexpr DimSize_t size()
+      {
+        static_assert(DIM < RANK, "Invalid dimension requested");
+        return Strides[DIM] * Dims[DIM];
+      }
+
+    /// Returns the size of the specified dimension
+    template <unsigned int DIM>
+    static constexpr DimSize_t dim()
+      {
+        static_assert(DIM < RANK, "Invalid dimension requested");
+        return Dims[DIM];
+      }
+
+    /// Returns the step of the linear index for the dimension `d`
+    static constexpr LinIndex_t stride(unsigned int d) { return Strides[d]; }
+
+
+    /// Returns true: all objects of this type have the same sizes
+    constexpr bool operator== (FixedTensorIndices const&) const { return true; }
+
+    /// Returns false: all objects of this type have the same sizes
+    constexpr bool operator!= (FixedTensorIndices const&) const
+      { return false; }
+
+
+      private:
+    /// Size of each dimension
+    static constexpr std::array<DimSize_t, RANK> Dims {{ DIMS... }};
+
+    /// Step of the linear index in each dimension
+    static constexpr std::array<LinIndex_t, RANK> Strides = []()
+      {
+        std::array<LinIndex_t, RANK> strides {};
+        LinIndex_t stride = 1;
+        for (unsigned int d = RANK; d-- > 0; ) {
+          strides[d] = stride;
+          stride *= Dims[d];
+        }
+        return strides;
+      }();
+
+    static constexpr bool hasIndex(unsigned int d, Index_t index)
+      { return (index >= 0) && ((DimSize_t) index < Dims[d]); }
+
+    template <std::size_t... D, typename... INDICES>
+    static constexpr LinIndex_t linIndex
+      (std::index_sequence<D...>, INDICES... indices)
+      { return ((indices * Strides[D]) + ...); }
+
+  }; // class FixedTensorIndices<>
+
+
+} // namespace util
+
+
+#endif // LARDATA_UTILITIES_FIXEDTENSORINDICES_H
@@ -9,6 +9,11 @@
  * * `util::associated_groups()` providing a sequence of objects associated to
  *   the same object, for each object
  *
+ * The groups are visited in order; for random access to them (e.g. to split
+ * them among parallel tasks, or to look up the group of a given object) see
+ * `util::associated_groups_index()` in `AssociatedGroupIndex.h`, also included
+ * here.
+ *
  */
 
 
@@ -17,6 +22,7 @@
 
 // LArSoft libraries
 #include "lardata/Utilities/RangeForWrapper.h"
+#include "lardata/Utilities/AssociatedGroupIndex.h"
 
 // framework libraries
 #include "canvas/Persistency/Common/AssnsAlgorithms.h" // art::for_each_group()
@@ -85,18 +91,22 @@ namespace util {
    *  * again, there is one outer loop iteration for every track;
    *  * the value of `hits` is an object representing a range of _art_ pointers
    *    (`art::Ptr<recob::Hit>`) which can be navigated with the
-   *    `begin()`/`end()` free functions, or in a range-for loop;
+   *    `begin()`/`end()` free functions, or in a range-for loop; the end
+   *    iterator may be of a different type than the begin one (see
+   *    `util::range_for_sentinel`), and they should be compared with `!=`;
    *  * on each iteration, the information of which track the hits are
    *    associated to is not available; if that is also needed, use
-   *    `util::associated_groups_with_left()` instead.
+   *    `util::associated_groups_with_left()` instead;
+   *  * the groups can only be visited in sequence; `util::associated_groups_index()`
+   *    indexes them once for random access.
    */
   template <class A>
   auto associated_groups(A const & assns) {
      return assns |
             ranges::view::all |
             ranges::view::group_by([](auto a1, auto a2) { return a1.first == a2.first;}) |
-            ranges::view::transform([] (auto pairs) {return pairs | ranges::view::values | util::range_for;}) |
-            util::range_for
+            ranges::view::transform([] (auto pairs) {return pairs | ranges::view::values | util::range_for_sentinel;}) |
+            util::range_for_sentinel
             ;
   } // associated_groups()
 
@@ -146,7 +156,8 @@ namespace util {
    *  * again, there is one outer loop iteration for every track;
    *  * the value of `hits` is an object representing a range of _art_ pointers
    *    (`art::Ptr<recob::Hit>`) which can be navigated with the
-   *    `begin()`/`end()` free functions, or in a range-for loop.
+   *    `begin()`/`end()` free functions, or in a range-for loop; the end
+   *    iterator may be of a different type than the begin one.
    */
   template <class A>
   auto associated_groups_with_left(A const & assns) {
@@ -157,10 +168,10 @@ namespace util {
            {
              return std::make_pair(
                pairs.front().first, // assuming they're all the same, pick first
-               pairs | ranges::view::values | util::range_for
+               pairs | ranges::view::values | util::range_for_sentinel
                );
            })
-        | util::range_for
+        | util::range_for_sentinel
         ;
   } // associated_groups_with_left()
 
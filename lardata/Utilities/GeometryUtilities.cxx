@@ -11,6 +11,7 @@
 #include "larcore/CoreUtils/ServiceUtil.h"
 #include "larcore/Geometry/Geometry.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lardata/DetectorInfoServices/ServicePack.h" // lar::currentProviderStamp()
 #include "lardata/Utilities/GeometryUtilities.h"
 #include "lardata/Utilities/UtilException.h"
 #include "larcorealg/Geometry/GeometryCore.h"
@@ -20,6 +21,10 @@
 
 #include "TLorentzVector.h"
 
+#include <algorithm> // std::stable_sort(), std::unique(), std::find()
+#include <array>
+#include <atomic> // std::atomic_load(), std::atomic_store()
+
 namespace {
   template <typename T>
   inline T sqr(T v) { return v*v; }
@@ -27,23 +32,53 @@ namespace {
   template <typename T>
   inline T sum_sqr(T a, T b) { return sqr(a) + sqr(b); }
 
+  /// The object returned by `GeometryUtilities::Current()`, with its stamp
+  struct CurrentUtilities_t {
+    std::shared_ptr<const util::GeometryUtilities> utils;
+    lar::ProviderStamp_t stamp;
+  };
+
+  /// Accessed only via `std::atomic_load()` and `std::atomic_store()`
+  std::shared_ptr<const CurrentUtilities_t> CurrentUtilities;
+
 } // local namespace
 
 
 namespace util{
 
-  ::util::GeometryUtilities* ::util::GeometryUtilities::_me = 0;
-
   //--------------------------------------------------------------------
   GeometryUtilities::GeometryUtilities()
+    : GeometryUtilities(*lar::providerFrom<geo::Geometry>(),
+			*lar::providerFrom<detinfo::DetectorPropertiesService>())
   {
     //_name = "GeometryUtilities";
-    geom = lar::providerFrom<geo::Geometry>();
-    detp = lar::providerFrom<detinfo::DetectorPropertiesService>();
+  }
 
+  //--------------------------------------------------------------------
+  GeometryUtilities::GeometryUtilities(const geo::GeometryCore& geometry,
+				       const detinfo::DetectorProperties& detProp)
+    : geom(&geometry)
+    , detp(&detProp)
+  {
     Reconfigure();
   }
 
+  //--------------------------------------------------------------------
+  std::shared_ptr<const GeometryUtilities> GeometryUtilities::Current()
+  {
+    // the stamp is read first: a change meanwhile triggers a new update later
+    const lar::ProviderStamp_t stamp = lar::currentProviderStamp();
+    std::shared_ptr<const CurrentUtilities_t> current
+      = std::atomic_load(&CurrentUtilities);
+    if(current && (current->stamp == stamp)) return current->utils;
+
+    // concurrent updates may build more than one object; all are correct
+    current = std::make_shared<const CurrentUtilities_t>
+      (CurrentUtilities_t{ std::make_shared<const GeometryUtilities>(), stamp });
+    std::atomic_store(&CurrentUtilities, current);
+    return current->utils;
+  }
+
   void GeometryUtilities::Reconfigure()
   {
     /*
@@ -64,6 +99,27 @@ namespace util{
     fWiretoCm=fWirePitch;
     fTimetoCm=fTimeTick*fDriftVelocity;
     fWireTimetoCmCm=fTimetoCm/fWirePitch;
+    fTicksPerCm=(1./fDriftVelocity)*(1./fTimeTick);
+
+    // per-plane constants, so that the projections need no service look-up
+    const double origin[3] = {0.};
+    const Double_t triggerOffset = detp->TriggerOffset();
+    fPlaneInfo.resize(fNPlanes);
+    for(UInt_t ip=0;ip<fNPlanes;ip++){
+      geo::PlaneGeo const& plane = geom->Plane(ip);
+      PlaneInfo_t& info = fPlaneInfo[ip];
+      Double_t pos[3];
+      plane.LocalToWorld(origin, pos);
+      info.wirePitch = geom->WirePitch(ip);
+      info.alpha = 0.5*TMath::Pi()-geom->WireAngleToVertical(plane.View());
+      info.cosAlpha = cos(info.alpha);
+      info.sinAlpha = sin(info.alpha);
+      info.wireOffset = geom->DetHalfHeight()*sin(fabs(info.alpha));
+      info.tickOffset = triggerOffset-(pos[0]/fDriftVelocity)*(1./fTimeTick);
+    }
+    fAngleStart[0] = geom->DetHalfWidth();
+    fAngleStart[1] = 0.;
+    fAngleStart[2] = geom->DetLength()/2.;
   }
 
 
@@ -537,20 +593,20 @@ namespace util{
 
    double  GeometryUtilities::Get2DangleFrom3D(unsigned int plane,TVector3 dir_vector) const
   {
-   double alpha= 0.5*TMath::Pi()-geom->WireAngleToVertical(geom->Plane(plane).View());
+   PlaneInfo_t const& info = fPlaneInfo[plane];
    // create dummy  xyz point in middle of detector and another one in unit length.
    // calculate correspoding points in wire-time space and use the differnces between those to return 2D a
    // angle
 
 
-   TVector3 start(geom->DetHalfWidth(),0.,geom->DetLength()/2.);
+   TVector3 start(fAngleStart[0],fAngleStart[1],fAngleStart[2]);
    TVector3 end=start+dir_vector;
 
 
     //the wire coordinate is already in cm. The time needs to be converted.
-   util::PxPoint startp(plane,(geom->DetHalfHeight()*sin(fabs(alpha))+start[2]*cos(alpha)-start[1]*sin(alpha)),start[0]);
+   util::PxPoint startp(plane,(info.wireOffset+start[2]*info.cosAlpha-start[1]*info.sinAlpha),start[0]);
 
-   util::PxPoint endp(plane,(geom->DetHalfHeight()*sin(fabs(alpha))+end[2]*cos(alpha)-end[1]*sin(alpha)),end[0]);
+   util::PxPoint endp(plane,(info.wireOffset+end[2]*info.cosAlpha-end[1]*info.sinAlpha),end[0]);
 
    double angle=Get2Dangle(&endp,&startp);
 
@@ -915,19 +971,12 @@ namespace util{
   PxPoint GeometryUtilities::Get2DPointProjection(Double_t *xyz, Int_t plane) const{
 
     PxPoint pN(0,0,0);
-    const double origin[3] = {0.};
-    Double_t pos[3];
-    //geom->PlaneOriginVtx(plane,pos);
-    geom->Plane(plane).LocalToWorld(origin, pos);
-    Double_t drifttick=(xyz[0]/fDriftVelocity)*(1./fTimeTick);
-
-    pos[1]=xyz[1];
-    pos[2]=xyz[2];
+    Double_t pos[3]{0., xyz[1], xyz[2]};
 
     ///\todo: this should use the cryostat and tpc as well in the NearestWire method
 
     pN.w = geom->NearestWire(pos, plane);
-    pN.t=drifttick-(pos[0]/fDriftVelocity)*(1./fTimeTick)+detp->TriggerOffset();
+    pN.t=xyz[0]*fTicksPerCm+fPlaneInfo[plane].tickOffset;
     pN.plane=plane;
 
     return pN;
@@ -935,6 +984,43 @@ namespace util{
    }
 
 
+  void GeometryUtilities::Get2DPointProjections(const Double_t* xyz,
+						std::size_t nPoints,
+						std::vector<PxPoint>& projections) const{
+
+    projections.resize(nPoints*fNPlanes);
+    auto iProj = projections.begin();
+    for(std::size_t i=0;i<nPoints;i++, xyz+=3){
+      Double_t pos[3]{0., xyz[1], xyz[2]};
+      const Double_t drifttick=xyz[0]*fTicksPerCm;
+      for(UInt_t plane=0;plane<fNPlanes;plane++, ++iProj){
+        iProj->w = geom->NearestWire(pos, plane);
+        iProj->t = drifttick+fPlaneInfo[plane].tickOffset;
+        iProj->plane = plane;
+      }
+    }
+
+   }
+
+
+  void GeometryUtilities::Get2DPointProjectionsCM(const Double_t* xyz,
+						  std::size_t nPoints,
+						  std::vector<PxPoint>& projections) const{
+
+    projections.resize(nPoints*fNPlanes);
+    auto iProj = projections.begin();
+    for(std::size_t i=0;i<nPoints;i++, xyz+=3){
+      Double_t pos[3]{0., xyz[1], xyz[2]};
+      for(UInt_t plane=0;plane<fNPlanes;plane++, ++iProj){
+        iProj->w = geom->NearestWire(pos, plane)*fWiretoCm;
+        iProj->t = xyz[0];
+        iProj->plane = plane;
+      }
+    }
+
+   }
+
+
     //////////////////////////////////////////////////////////////
     // for now this returns the vlause in CM/CM space.
     // this will become the default, but don't want to break the code that depends on the
@@ -986,15 +1072,19 @@ namespace util{
 
   Double_t GeometryUtilities::GetTimeTicks(Double_t x, Int_t plane) const{
 
+    return x*fTicksPerCm+fPlaneInfo[plane].tickOffset;
+
+   }
 
-    const double origin[3] = {0.};
-    Double_t pos[3];
-    //geom->PlaneOriginVtx(plane,pos);
-    geom->Plane(plane).LocalToWorld(origin, pos);
-    Double_t drifttick=(x/fDriftVelocity)*(1./fTimeTick);
 
-    return drifttick-(pos[0]/fDriftVelocity)*(1./fTimeTick)+detp->TriggerOffset();
+  void GeometryUtilities::GetTimeTicks(const Double_t* x,
+				       std::size_t nPoints,
+				       Int_t plane,
+				       Double_t* ticks) const{
 
+    const Double_t tickOffset = fPlaneInfo[plane].tickOffset;
+    for(std::size_t i=0;i<nPoints;i++)
+      ticks[i]=x[i]*fTicksPerCm+tickOffset;
 
    }
 
@@ -1015,8 +1105,8 @@ namespace util{
     Double_t wirePitch   = 0.;
     Double_t angleToVert = 0.;
 
-    wirePitch = geom->WirePitch(plane);
-    angleToVert = geom->WireAngleToVertical(geom->Plane(plane).View()) - 0.5*TMath::Pi();
+    wirePitch = fPlaneInfo[plane].wirePitch;
+    angleToVert = -fPlaneInfo[plane].alpha;
 
     //(sin(angleToVert),std::cos(angleToVert)) is the direction perpendicular to wire
     //fDir.front() is the direction of the track at the beginning of its trajectory
@@ -1121,24 +1211,93 @@ namespace util{
 
     for(size_t i=0; i<hitlist.size(); ++i) {
 
-      util::PxPoint hitonline;
+      if(IsLocalHit(hitlist.at(i),startHit,locintercept,linearlimit,ortlimit,lineslopetest)){
+        hitlistlocal_index.push_back(i);
+      }
 
-      GetPointOnLine( lineslopetest, locintercept, (const util::PxHit*)(&hitlist.at(i)), hitonline );
 
+    }
 
-      //calculate linear distance from start point and orthogonal distance from axis
-      Double_t lindist=Get2DDistance((const util::PxPoint*)(&hitonline),(const util::PxPoint*)(&startHit));
-      Double_t ortdist=Get2DDistance((const util::PxPoint*)(&hitlist.at(i)),(const util::PxPoint*)(&hitonline));
 
+  }
 
-      if(lindist<linearlimit && ortdist<ortlimit){
-        hitlistlocal_index.push_back(i);
-      }
 
+  void GeometryUtilities::SelectLocalHitlist(const std::vector<util::PxHit> &hitlist,
+					     const util::PxHitIndex& index,
+					     std::vector <const util::PxHit*> &hitlistlocal,
+					     util::PxPoint &startHit,
+					     Double_t& linearlimit,
+					     Double_t& ortlimit,
+					     Double_t& lineslopetest,
+					     util::PxHit &averageHit) const
+  {
+
+    hitlistlocal.clear();
+    std::vector< unsigned int > hitlistlocal_index;
+
+    SelectLocalHitlistIndex(index,hitlistlocal_index,startHit,linearlimit,ortlimit,lineslopetest);
 
+    double timesum = 0;
+    double wiresum = 0;
+    for(unsigned int i: hitlistlocal_index) {
+      util::PxHit const& hit = hitlist.at(i);
+      hitlistlocal.push_back(&hit);
+      timesum += hit.t;
+      wiresum += hit.w;
     }
 
+    averageHit.plane = startHit.plane;
+    if(hitlistlocal.size())
+    {
+      averageHit.w = wiresum/(double)hitlistlocal.size();
+      averageHit.t = timesum/((double) hitlistlocal.size());
+    }
+  }
 
+
+  void GeometryUtilities::SelectLocalHitlistIndex(const util::PxHitIndex& index,
+						  std::vector <unsigned int> &hitlistlocal_index,
+						  util::PxPoint &startHit,
+						  Double_t& linearlimit,
+						  Double_t& ortlimit,
+						  Double_t& lineslopetest) const
+  {
+
+    hitlistlocal_index.clear();
+    if((linearlimit <= 0.) || (ortlimit <= 0.)) return;
+    double locintercept=startHit.t - startHit.w * lineslopetest;
+
+    // a selected hit is closer to the start than sqrt(linearlimit^2 + ortlimit^2)
+    double const radius=std::sqrt(sum_sqr(linearlimit, ortlimit));
+    index.forEachInBox(startHit.w - radius, startHit.w + radius,
+		       startHit.t - radius, startHit.t + radius,
+		       [&](util::PxHitIndex::Entry_t const& entry)
+      {
+	util::PxPoint const hit(startHit.plane, entry.w, entry.t);
+	if(IsLocalHit(hit,startHit,locintercept,linearlimit,ortlimit,lineslopetest))
+	  hitlistlocal_index.push_back(entry.index);
+      });
+    std::sort(hitlistlocal_index.begin(), hitlistlocal_index.end());
+
+  }
+
+
+  bool GeometryUtilities::IsLocalHit(const util::PxPoint& hit,
+				     const util::PxPoint& startHit,
+				     Double_t locintercept,
+				     Double_t linearlimit,
+				     Double_t ortlimit,
+				     Double_t lineslopetest) const
+  {
+    util::PxPoint hitonline;
+
+    GetPointOnLine( lineslopetest, locintercept, &hit, hitonline );
+
+    //calculate linear distance from start point and orthogonal distance from axis
+    Double_t lindist=Get2DDistance(&hitonline,&startHit);
+    Double_t ortdist=Get2DDistance(&hit,&hitonline);
+
+    return lindist<linearlimit && ortdist<ortlimit;
   }
 
 
@@ -1152,6 +1311,15 @@ namespace util{
 
   void GeometryUtilities::SelectPolygonHitList(const std::vector<util::PxHit>   &hitlist,
 					       std::vector <const util::PxHit*> &hitlistlocal)
+  {
+    PolygonWorkspace_t work;
+    SelectPolygonHitList(hitlist, hitlistlocal, work);
+  }
+
+
+  void GeometryUtilities::SelectPolygonHitList(const std::vector<util::PxHit>   &hitlist,
+					       std::vector <const util::PxHit*> &hitlistlocal,
+					       PolygonWorkspace_t &work) const
   {
     if(!(hitlist.size())) {
       throw UtilException("Provided empty hit list!");
@@ -1161,47 +1329,56 @@ namespace util{
     hitlistlocal.clear();
     unsigned char plane = (*hitlist.begin()).plane;
 
-    // Define subset of hits to define polygon
-    std::map<double,const util::PxHit*> hitmap;
+    // Define subset of hits to define polygon:
+    // hits by decreasing charge, only the first one of the hits with the same
+    // charge, until 95% of the total charge is collected
+    std::vector<const util::PxHit*>& ordered_hits = work.ordered_hits;
+    ordered_hits.clear();
+    ordered_hits.reserve(hitlist.size());
     double qtotal=0;
     for(auto const &h : hitlist){
-
-      hitmap.insert(std::pair<double,const util::PxHit*>(h.charge,&h));
+      ordered_hits.push_back(&h);
       qtotal += h.charge;
-
     }
+    std::stable_sort(ordered_hits.begin(), ordered_hits.end(),
+      [](const util::PxHit* a, const util::PxHit* b){ return a->charge > b->charge; });
+    ordered_hits.erase(
+      std::unique(ordered_hits.begin(), ordered_hits.end(),
+	[](const util::PxHit* a, const util::PxHit* b){ return a->charge == b->charge; }),
+      ordered_hits.end());
     double qintegral=0;
-    std::vector<const util::PxHit*> ordered_hits;
-    ordered_hits.reserve(hitlist.size());
-    for(auto hiter = hitmap.rbegin();
-	qintegral < qtotal*0.95 && hiter != hitmap.rend();
-	++hiter) {
-
-      qintegral += (*hiter).first;
-      ordered_hits.push_back((*hiter).second);
-
+    size_t nSelected=0;
+    while(qintegral < qtotal*0.95 && nSelected < ordered_hits.size()) {
+      qintegral += ordered_hits[nSelected]->charge;
+      ++nSelected;
     }
+    ordered_hits.resize(nSelected);
 
     // Define container to hold found polygon corner PxHit index & distance
-    std::vector<size_t> hit_index(8,0);
-    std::vector<double> hit_distance(8,1e9);
+    std::array<size_t, 8> hit_index;
+    std::array<double, 8> hit_distance;
+    hit_index.fill(0);
+    hit_distance.fill(1e9);
 
     // Loop over hits and find corner points in the plane view
     // Also fill corner edge points
-    std::vector<util::PxPoint> edges(4,PxPoint(plane,0,0));
+    std::array<util::PxPoint, 4> edges
+      {{ PxPoint(plane,0,0), PxPoint(plane,0,0), PxPoint(plane,0,0), PxPoint(plane,0,0) }};
     double wire_max = geom->Nwires(plane) * fWiretoCm;
     double time_max = detp->NumberTimeSamples() * fTimetoCm;
 
     for(size_t index = 0; index<ordered_hits.size(); ++index) {
 
-      if(ordered_hits.at(index)->t < 0 ||
-	 ordered_hits.at(index)->w < 0 ||
-	 ordered_hits.at(index)->t > time_max ||
-	 ordered_hits.at(index)->w > wire_max ) {
+      const util::PxHit& hit = *(ordered_hits[index]);
+
+      if(hit.t < 0 ||
+	 hit.w < 0 ||
+	 hit.t > time_max ||
+	 hit.w > wire_max ) {
 
 	throw UtilException(Form("Invalid wire/time (%g,%g) ... range is (0=>%g,0=>%g)",
-				    ordered_hits.at(index)->w,
-				    ordered_hits.at(index)->t,
+				    hit.w,
+				    hit.t,
 				    wire_max,
 				    time_max)
 			       );
@@ -1211,155 +1388,124 @@ namespace util{
       double dist = 0;
 
       // Comparison w/ (Wire,0)
-      dist = ordered_hits.at(index)->t;
-      if(dist < hit_distance.at(1)) {
-	hit_distance.at(1) = dist;
-	hit_index.at(1) = index;
-	edges.at(0).t = ordered_hits.at(index)->t;
-	edges.at(1).t = ordered_hits.at(index)->t;
+      dist = hit.t;
+      if(dist < hit_distance[1]) {
+	hit_distance[1] = dist;
+	hit_index[1] = index;
+	edges[0].t = hit.t;
+	edges[1].t = hit.t;
       }
 
       // Comparison w/ (WireMax,Time)
-      dist = wire_max - ordered_hits.at(index)->w;
-      if(dist < hit_distance.at(3)) {
-	hit_distance.at(3) = dist;
-	hit_index.at(3) = index;
-	edges.at(1).w = ordered_hits.at(index)->w;
-	edges.at(2).w = ordered_hits.at(index)->w;
+      dist = wire_max - hit.w;
+      if(dist < hit_distance[3]) {
+	hit_distance[3] = dist;
+	hit_index[3] = index;
+	edges[1].w = hit.w;
+	edges[2].w = hit.w;
       }
 
       // Comparison w/ (Wire,TimeMax)
-      dist = time_max - ordered_hits.at(index)->t;
-      if(dist < hit_distance.at(5)) {
-	hit_distance.at(5) = dist;
-	hit_index.at(5) = index;
-	edges.at(2).t = ordered_hits.at(index)->t;
-	edges.at(3).t = ordered_hits.at(index)->t;
+      dist = time_max - hit.t;
+      if(dist < hit_distance[5]) {
+	hit_distance[5] = dist;
+	hit_index[5] = index;
+	edges[2].t = hit.t;
+	edges[3].t = hit.t;
       }
 
       // Comparison w/ (0,Time)
-      dist = ordered_hits.at(index)->w;
-      if(dist < hit_distance.at(7)) {
-	hit_distance.at(7) = dist;
-	hit_index.at(7) = index;
-	edges.at(0).w = ordered_hits.at(index)->w;
-	edges.at(3).w = ordered_hits.at(index)->w;
+      dist = hit.w;
+      if(dist < hit_distance[7]) {
+	hit_distance[7] = dist;
+	hit_index[7] = index;
+	edges[0].w = hit.w;
+	edges[3].w = hit.w;
       }
     }
-    /*
-    std::cout
-      << Form("Corner points: (%g,%g) (%g,%g) (%g,%g) (%g,%g)",
-	      edges.at(0).w, edges.at(0).t,
-	      edges.at(1).w, edges.at(1).t,
-	      edges.at(2).w, edges.at(2).t,
-	      edges.at(3).w, edges.at(3).t)
-      <<std::endl;
-    */
-    for(size_t index = 0; index<ordered_hits.size(); ++index) {
 
-      double dist = 0;
-      // Comparison w/ (0,0)
-      dist = pow((ordered_hits.at(index)->t - edges.at(0).t),2) + pow((ordered_hits.at(index)->w - edges.at(0).w),2);
-      if(dist < hit_distance.at(0)) {
-	hit_distance.at(0) = dist;
-	hit_index.at(0) = index;
-      }
-
-      // Comparison w/ (WireMax,0)
-      dist = pow((ordered_hits.at(index)->t - edges.at(1).t),2) + pow((ordered_hits.at(index)->w - edges.at(1).w),2);
-      if(dist < hit_distance.at(2)) {
-	hit_distance.at(2) = dist;
-	hit_index.at(2) = index;
-      }
+    for(size_t index = 0; index<ordered_hits.size(); ++index) {
 
-      // Comparison w/ (WireMax,TimeMax)
-      dist = pow((ordered_hits.at(index)->t - edges.at(2).t),2) + pow((ordered_hits.at(index)->w - edges.at(2).w),2);
-      if(dist < hit_distance.at(4)) {
-	hit_distance.at(4) = dist;
-	hit_index.at(4) = index;
-      }
+      const util::PxHit& hit = *(ordered_hits[index]);
 
-      // Comparison w/ (0,TimeMax)
-      dist = pow((ordered_hits.at(index)->t - edges.at(3).t),2) + pow((ordered_hits.at(index)->w - edges.at(3).w),2);
-      if(dist < hit_distance.at(6)) {
-	hit_distance.at(6) = dist;
-	hit_index.at(6) = index;
+      // Comparison w/ (0,0), (WireMax,0), (WireMax,TimeMax), (0,TimeMax)
+      for(size_t corner = 0; corner < 4; ++corner) {
+	double dist = sum_sqr(hit.t - edges[corner].t, hit.w - edges[corner].w);
+	if(dist < hit_distance[2*corner]) {
+	  hit_distance[2*corner] = dist;
+	  hit_index[2*corner] = index;
+	}
       }
 
     }
 
     // Loop over the resulting hit indexes and append unique hits to define the polygon to the return hit list
-    std::set<size_t> unique_index;
-    std::vector<size_t> candidate_polygon;
+    std::vector<size_t>& candidate_polygon = work.candidate_polygon;
+    candidate_polygon.clear();
     candidate_polygon.reserve(9);
-    //    std::cout << "Original polygon: " << std::endl;
     for(auto &index : hit_index) {
-
-      if(unique_index.find(index) == unique_index.end()) {
-	//	hitlistlocal.push_back((const util::PxHit*)(ordered_hits.at(index)));
-	//std::cout << "(" << ordered_hits.at(index)->w << ", " << ordered_hits.at(index)->t << ")" << std::endl;
-	unique_index.insert(index);
+      if(std::find(candidate_polygon.begin(), candidate_polygon.end(), index)
+	 == candidate_polygon.end())
 	candidate_polygon.push_back(index);
-      }
-    }
-    for (auto &index: hit_index){
-      candidate_polygon.push_back(index);
-      break;
     }
-
-    if(unique_index.size()>8) throw UtilException("Size of the polygon > 8!");
+    candidate_polygon.push_back(hit_index.front());
 
     //Untangle Polygon
-    candidate_polygon = PolyOverlap( ordered_hits, candidate_polygon);
+    PolyOverlap( ordered_hits, candidate_polygon);
 
     hitlistlocal.clear();
     for( unsigned int i=0; i<(candidate_polygon.size()-1); i++){
-      hitlistlocal.push_back((const util::PxHit*)(ordered_hits.at(candidate_polygon.at(i))));
+      hitlistlocal.push_back(ordered_hits[candidate_polygon[i]]);
     }
-    //check that polygon does not have more than 8 sides
-    if(unique_index.size()>8) throw UtilException("Size of the polygon > 8!");
   }
 
 
   std::vector<size_t>  GeometryUtilities::PolyOverlap( std::vector<const util::PxHit*> ordered_hits ,
 						    std::vector<size_t> candidate_polygon) {
 
-    //loop over edges
-    for ( unsigned int i=0; i<(candidate_polygon.size()-1); i++){
-      double Ax = ordered_hits.at(candidate_polygon.at(i))->w;
-      double Ay = ordered_hits.at(candidate_polygon.at(i))->t;
-      double Bx = ordered_hits.at(candidate_polygon.at(i+1))->w;
-      double By = ordered_hits.at(candidate_polygon.at(i+1))->t;
-      //loop over edges that have not been checked yet...
-      //only ones furhter down in polygon
-      for ( unsigned int j=i+2; j<(candidate_polygon.size()-1); j++){
-	//avoid consecutive segments:
-	if ( candidate_polygon.at(i) == candidate_polygon.at(j+1) )
-	  continue;
-	else{
-	  double Cx = ordered_hits.at(candidate_polygon.at(j))->w;
-	  double Cy = ordered_hits.at(candidate_polygon.at(j))->t;
-	  double Dx = ordered_hits.at(candidate_polygon.at(j+1))->w;
-	  double Dy = ordered_hits.at(candidate_polygon.at(j+1))->t;
+    PolyOverlap(ordered_hits, candidate_polygon);
+    return candidate_polygon;
+  }
+
+
+  void GeometryUtilities::PolyOverlap(const std::vector<const util::PxHit*> &ordered_hits,
+				      std::vector<size_t> &candidate_polygon) const
+  {
+    // after each swap the check restarts from the first edge
+    bool swapped = true;
+    while (swapped) {
+      swapped = false;
+      //loop over edges
+      for ( unsigned int i=0; !swapped && i<(candidate_polygon.size()-1); i++){
+	double Ax = ordered_hits[candidate_polygon[i]]->w;
+	double Ay = ordered_hits[candidate_polygon[i]]->t;
+	double Bx = ordered_hits[candidate_polygon[i+1]]->w;
+	double By = ordered_hits[candidate_polygon[i+1]]->t;
+	//loop over edges that have not been checked yet...
+	//only ones furhter down in polygon
+	for ( unsigned int j=i+2; j<(candidate_polygon.size()-1); j++){
+	  //avoid consecutive segments:
+	  if ( candidate_polygon[i] == candidate_polygon[j+1] )
+	    continue;
+	  double Cx = ordered_hits[candidate_polygon[j]]->w;
+	  double Cy = ordered_hits[candidate_polygon[j]]->t;
+	  double Dx = ordered_hits[candidate_polygon[j+1]]->w;
+	  double Dy = ordered_hits[candidate_polygon[j+1]]->t;
 
 	  if ( (Clockwise(Ax,Ay,Cx,Cy,Dx,Dy) != Clockwise(Bx,By,Cx,Cy,Dx,Dy))
 	       and (Clockwise(Ax,Ay,Bx,By,Cx,Cy) != Clockwise(Ax,Ay,Bx,By,Dx,Dy)) ){
-	    size_t tmp = candidate_polygon.at(i+1);
-	    candidate_polygon.at(i+1) = candidate_polygon.at(j);
-	    candidate_polygon.at(j) = tmp;
+	    std::swap(candidate_polygon[i+1], candidate_polygon[j]);
 	    //check that last element is still first (to close circle...)
-	    candidate_polygon.at(candidate_polygon.size()-1) = candidate_polygon.at(0);
-	    //swapped polygon...now do recursion to make sure
-	    return PolyOverlap( ordered_hits, candidate_polygon);
+	    candidate_polygon.back() = candidate_polygon.front();
+	    swapped = true;
+	    break;
 	  }//if crossing
-	}
-      }//second loop
-    }//first loop
-    //std::cout << std::endl;
-    return candidate_polygon;
+	}//second loop
+      }//first loop
+    }
   }
 
-  bool GeometryUtilities::Clockwise(double Ax,double Ay,double Bx,double By,double Cx,double Cy){
+  bool GeometryUtilities::Clockwise(double Ax,double Ay,double Bx,double By,double Cx,double Cy) const{
     return (Cy-Ay)*(Bx-Ax) > (By-Ay)*(Cx-Ax);
   }
 
@@ -1401,7 +1547,7 @@ namespace util{
 //   }
 
 
-   util::PxHit GeometryUtilities::FindClosestHit(std::vector<util::PxHit >  hitlist,
+   util::PxHit GeometryUtilities::FindClosestHit(const std::vector<util::PxHit > & hitlist,
                                                  unsigned int wirein,
                                                  double timein) const
      {
@@ -1412,7 +1558,7 @@ namespace util{
 
 
 
-   unsigned int GeometryUtilities::FindClosestHitIndex(std::vector<util::PxHit >  hitlist,
+   unsigned int GeometryUtilities::FindClosestHitIndex(const std::vector<util::PxHit > & hitlist,
                                                  unsigned int wirein,
                                                  double timein) const
      {
@@ -1425,7 +1571,7 @@ namespace util{
 
      for(unsigned int ii=0; ii<hitlist.size();ii++){
 
-      util::PxHit * theHit = &(hitlist[ii]);
+      const util::PxHit * theHit = &(hitlist[ii]);
       time = theHit->t ;
       wire=theHit->w;
      // plane=theHit->WireID().Plane;
@@ -1445,6 +1591,27 @@ namespace util{
   }
 
 
+   util::PxHit GeometryUtilities::FindClosestHit(const std::vector<util::PxHit > & hitlist,
+						 const util::PxHitIndex& index,
+						 unsigned int wirein,
+						 double timein) const
+     {
+
+   return hitlist[FindClosestHitIndex(index, wirein,timein)];
+
+  }
+
+
+   unsigned int GeometryUtilities::FindClosestHitIndex(const util::PxHitIndex& index,
+						       unsigned int wirein,
+						       double timein) const
+     {
+     // same metric as Get2DDistance(Double_t, Double_t, Double_t, Double_t)
+     unsigned int const ret_ind=index.closest(wirein,timein,fWiretoCm,fTimetoCm);
+     return (ret_ind == util::PxHitIndex::npos)? 0: ret_ind;
+  }
+
+
 
 
 
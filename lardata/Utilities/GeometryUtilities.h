@@ -13,8 +13,11 @@
 #include "TVector3.h"
 
 #include "PxUtils.h"
+#include "lardata/Utilities/PxHitIndex.h"
 
+#include <cstddef> // std::size_t
 #include <limits>
+#include <memory> // std::shared_ptr<>
 #include <vector>
 
 class TLorentzVector;
@@ -27,26 +30,58 @@ namespace util{
 
   const double kINVALID_DOUBLE = std::numeric_limits<Double_t>::max();
 
+  /**
+   * @brief Distances, angles and projections on the wire planes
+   *
+   * The constants of the geometry and of the detector properties are cached
+   * on construction (and by `Reconfigure()`). All the `const` methods can be
+   * called concurrently on the same object.
+   *
+   * There are several ways to get an object:
+   * * `GeometryUtilities::Current()` returns the shared object for the
+   *   current state of the services, built again after any of them declares
+   *   a change (see `lar::noteProviderChange()`); it is thread-safe;
+   * * `makeGeometryUtilities()` builds a new shared, immutable object from
+   *   the specified providers, e.g. the ones of a schedule or of a
+   *   `lar::ProviderSnapshot`;
+   * * `GetME()` returns an object built the first time it is called, which
+   *   is not updated when the services change: use `Current()` instead.
+   */
   //class GeometryUtilities : public larlight::larlight_base {
   class GeometryUtilities {
 
   public:
 
+    /// Returns the object built on the first call (thread-safe); it is not
+    /// updated when the services change (see `Current()`)
     static const GeometryUtilities* GetME() {
-      if(!_me) _me = new GeometryUtilities;
-      return _me;
+      static GeometryUtilities const me;
+      return &me;
     }
 
-    /// Default constructor = private for singleton
+    /// Returns the shared object for the current state of the services
+    static std::shared_ptr<const GeometryUtilities> Current();
+
+    /// Default constructor: uses the providers from the services
     GeometryUtilities();
 
+    /// Constructor: uses the specified providers, which must outlive it
+    GeometryUtilities(const geo::GeometryCore& geometry,
+		      const detinfo::DetectorProperties& detProp);
+
+    /// Constructor: uses the providers from a pack, e.g. a
+    /// `lar::ProviderPack` or a `lar::ProviderSnapshot`
+    template <typename Providers>
+    explicit GeometryUtilities(const Providers& providers)
+      : GeometryUtilities(*(providers.template get<geo::GeometryCore>()),
+			  *(providers.template get<detinfo::DetectorProperties>()))
+      {}
+
     /// Default destructor
     ~GeometryUtilities();
 
   private:
 
-    static GeometryUtilities* _me;
-
     /*
     /// Default constructor = private for singleton
     GeometryUtilities();
@@ -173,6 +208,26 @@ namespace util{
 
     Double_t GetTimeTicks(Double_t x, Int_t plane) const;
 
+    /// Converts the drift coordinates `x` of `nPoints` points into ticks on
+    /// the specified plane, writing them into `ticks`
+    void GetTimeTicks(const Double_t* x,
+		      std::size_t nPoints,
+		      Int_t plane,
+		      Double_t* ticks) const;
+
+    /// Projects `nPoints` points on all the planes at once (wire and ticks);
+    /// `xyz` holds the x, y, z coordinates of each point in sequence, and the
+    /// projection of point `i` on plane `p` is `projections[i*Nplanes() + p]`
+    void Get2DPointProjections(const Double_t* xyz,
+			       std::size_t nPoints,
+			       std::vector<PxPoint>& projections) const;
+
+    /// Like `Get2DPointProjections()`, but in cm/cm space
+    /// (as `Get2DPointProjectionCM()`)
+    void Get2DPointProjectionsCM(const Double_t* xyz,
+				 std::size_t nPoints,
+				 std::vector<PxPoint>& projections) const;
+
     Int_t GetProjectedPoint(const PxPoint *p0,
 			    const PxPoint *p1,
 			    PxPoint &pN) const;
@@ -186,14 +241,27 @@ namespace util{
                                                  unsigned int wirein,
                                                  double timein) const;             */
 
-    util::PxHit  FindClosestHit(std::vector<util::PxHit >  hitlist,
+    util::PxHit  FindClosestHit(const std::vector<util::PxHit > & hitlist,
                                                  unsigned int wirein,
                                                  double timein) const;
 
-    unsigned int FindClosestHitIndex(std::vector<util::PxHit >  hitlist,
+    unsigned int FindClosestHitIndex(const std::vector<util::PxHit > & hitlist,
                                                  unsigned int wirein,
                                                  double timein) const;
 
+    /// Same as `FindClosestHit()`, looking up the hit in `index` (built from
+    /// `hitlist`); the wire coordinate of the hits is not truncated
+    util::PxHit  FindClosestHit(const std::vector<util::PxHit > & hitlist,
+				const util::PxHitIndex& index,
+				unsigned int wirein,
+				double timein) const;
+
+    /// Same as `FindClosestHitIndex()`, looking up the hit in `index`;
+    /// the wire coordinate of the hits is not truncated
+    unsigned int FindClosestHitIndex(const util::PxHitIndex& index,
+				     unsigned int wirein,
+				     double timein) const;
+
 
 //     void SelectLocalHitlist(std::vector< art::Ptr < recob::Hit> > hitlist,
 //                                              std::vector < art::Ptr<recob::Hit> > &hitlistlocal,
@@ -252,15 +320,51 @@ namespace util{
 			    Double_t& ortlimit,
 			    Double_t& lineslopetest);
 
+   /// Same as `SelectLocalHitlist()`, testing only the hits of `index` (built
+   /// from `hitlist`) which are close enough to `startHit`
+    void SelectLocalHitlist(const std::vector<util::PxHit> &hitlist,
+			    const util::PxHitIndex& index,
+			    std::vector <const util::PxHit*> &hitlistlocal,
+			    util::PxPoint &startHit,
+			    Double_t& linearlimit,
+			    Double_t& ortlimit,
+			    Double_t& lineslopetest,
+			    util::PxHit &averageHit) const;
+
+   /// Same as `SelectLocalHitlistIndex()`, testing only the hits of `index`
+   /// which are close enough to `startHit`; the indices are sorted
+   void SelectLocalHitlistIndex(const util::PxHitIndex& index,
+			    std::vector <unsigned int> &hitlistlocal_index,
+			    util::PxPoint &startHit,
+			    Double_t& linearlimit,
+			    Double_t& ortlimit,
+			    Double_t& lineslopetest) const;
+
+
+    /// Working memory of `SelectPolygonHitList()`, to be reused between calls
+    struct PolygonWorkspace_t {
+      std::vector<const util::PxHit*> ordered_hits; ///< hits by charge
+      std::vector<size_t> candidate_polygon; ///< polygon (indices of hits)
+    };
 
     void SelectPolygonHitList(const std::vector<util::PxHit> &hitlist,
 			      std::vector <const util::PxHit*> &hitlistlocal);
 
+    /// Same as `SelectPolygonHitList()`, using the memory in `work`
+    /// (`util::PxPolygon` can test which hits are inside the result)
+    void SelectPolygonHitList(const std::vector<util::PxHit> &hitlist,
+			      std::vector <const util::PxHit*> &hitlistlocal,
+			      PolygonWorkspace_t &work) const;
+
     std::vector<size_t> PolyOverlap( std::vector<const util::PxHit*> ordered_hits,
 				  std::vector<size_t> candidate_polygon);
 
+    /// Untangles `candidate_polygon` in place (see `PolyOverlap()`)
+    void PolyOverlap(const std::vector<const util::PxHit*> &ordered_hits,
+		     std::vector<size_t> &candidate_polygon) const;
+
     bool Clockwise(double Ax, double Ay, double Bx, double By,
-		   double Cx, double Cy);
+		   double Cx, double Cy) const;
 
     Double_t TimeToCm() const {return fTimetoCm;}
     Double_t WireToCm() const {return fWiretoCm;}
@@ -269,6 +373,14 @@ namespace util{
 
   private:
 
+    /// Returns whether `hit` is within the limits of `SelectLocalHitlist()`
+    bool IsLocalHit(const util::PxPoint& hit,
+		    const util::PxPoint& startHit,
+		    Double_t locintercept,
+		    Double_t linearlimit,
+		    Double_t ortlimit,
+		    Double_t lineslopetest) const;
+
     /*
      larutil::Geometry* geom;
      larutil::DetectorProperties* detp;
@@ -281,7 +393,20 @@ namespace util{
     art::ServiceHandle<detinfo::LArPropertiesService const> larp;
     */
 
+    /// Constants of one plane, cached by `Reconfigure()`
+    struct PlaneInfo_t {
+      Double_t wirePitch;  ///< wire pitch [cm]
+      Double_t alpha;      ///< pi/2 minus the wire angle to vertical [rad]
+      Double_t cosAlpha;   ///< cos(alpha)
+      Double_t sinAlpha;   ///< sin(alpha)
+      Double_t wireOffset; ///< half detector height times sin(|alpha|) [cm]
+      Double_t tickOffset; ///< ticks of the plane position, plus trigger offset
+    };
+
     std::vector< Double_t > vertangle;  //angle wrt to vertical
+    std::vector<PlaneInfo_t> fPlaneInfo; ///< per-plane constants
+    Double_t fAngleStart[3]; ///< reference point for `Get2DangleFrom3D()`
+    Double_t fTicksPerCm;    ///< drift ticks per cm
     Double_t fWirePitch;
     Double_t fTimeTick;
     Double_t fDriftVelocity;
@@ -292,5 +417,16 @@ namespace util{
 
     }; // class GeometryUtilities
 
+  /// Returns a new shared, immutable object using the specified providers
+  inline std::shared_ptr<const GeometryUtilities> makeGeometryUtilities
+    (const geo::GeometryCore& geometry, const detinfo::DetectorProperties& detProp)
+    { return std::make_shared<const GeometryUtilities>(geometry, detProp); }
+
+  /// Returns a new shared, immutable object using the providers from a pack
+  template <typename Providers>
+  std::shared_ptr<const GeometryUtilities> makeGeometryUtilities
+    (const Providers& providers)
+    { return std::make_shared<const GeometryUtilities>(providers); }
+
 } //namespace util
 #endif // UTIL_GEOMETRYUTILITIES_H
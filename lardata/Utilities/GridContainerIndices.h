@@ -8,9 +8,15 @@
  *
  * * GridContainer2DIndices: index manager for object in a 2D space
  * * GridContainer3DIndices: index manager for object in a 3D space
+ * * GridContainer2DFixedIndices, GridContainer3DFixedIndices: the same, with
+ *   the grid sizes fixed at compile time
+ * * GridNeighbourhood: range of the indices of the cells around a cell
  *
  * These classes have methods whose names reflect the idea of a physical space
- * ("x", "y", "z"). The functionality is provided by TensorIndices class.
+ * ("x", "y", "z"). The functionality is provided by TensorIndices class, or by
+ * MortonTensorIndices for the `Morton` variants, which place cells close in
+ * any direction close in memory, or by FixedTensorIndices for the `Fixed`
+ * variants, whose index arithmetic is made of compile-time constants.
  *
  * This is a pure header that contains only template classes.
  */
@@ -21,22 +27,297 @@
 
 // LArSoft libraries
 #include "lardata/Utilities/TensorIndices.h"
+#include "lardata/Utilities/MortonTensorIndices.h"
+#include "lardata/Utilities/FixedTensorIndices.h"
 
 // C/C++ standard libraries
 #include <cstddef> // std::ptrdiff_t
+#include <algorithm> // std::min(), std::max()
 #include <array>
+#include <iterator> // std::forward_iterator_tag
+#include <utility> // std::index_sequence
 
 
 namespace util {
 
   namespace details {
 
-    /// Index manager for a container of data arranged on a DIMS-dimension grid
-    template <unsigned int DIMS>
+    /**
+     * @brief Index arithmetic for moving between neighbouring cells
+     * @tparam INDICES type of tensor index manager
+     *
+     * The specialisations provide:
+     * * `index(cellID)`: the index of the cell with the specified coordinates
+     * * `next(index, d)`: the index of the cell following in dimension `d`
+     * * `rewind(index, d, from, to)`: the index of the cell with the same
+     *   coordinates except `to` instead of `from` in dimension `d`
+     */
+    template <typename INDICES>
+    class GridIndexSteps;
+
+    /// Row-major order: steps are precomputed strides
+    template <unsigned int RANK>
+    class GridIndexSteps<util::TensorIndices<RANK>> {
+        public:
+      using CellIndex_t = TensorIndicesBasicTypes::LinIndex_t;
+      using CellDimIndex_t = TensorIndicesBasicTypes::Index_t;
+
+      explicit GridIndexSteps(util::TensorIndices<RANK> const& indices)
+        : strides(extractStrides(indices, std::make_index_sequence<RANK>()))
+        {}
+
+      template <typename CellID>
+      CellIndex_t index(CellID const& id) const
+        {
+          CellIndex_t index = 0;
+          for (unsigned int d = 0; d < RANK; ++d) index += id[d] * strides[d];
+          return index;
+        }
+
+      CellIndex_t next(CellIndex_t index, unsigned int d) const
+        { return index + strides[d]; }
+
+      CellIndex_t rewind(
+        CellIndex_t index, unsigned int d, CellDimIndex_t from, CellDimIndex_t to
+        ) const
+        { return index - (from - to) * strides[d]; }
+
+        private:
+      std::array<CellIndex_t, RANK> strides; ///< index steps in each dimension
+
+      template <std::size_t... D>
+      static std::array<CellIndex_t, RANK> extractStrides
+        (util::TensorIndices<RANK> const& indices, std::index_sequence<D...>)
+        { return {{ (indices.template size<D>() / indices.template dim<D>())... }}; }
+
+    }; // GridIndexSteps<TensorIndices>
+
+    /// Morton order: steps are (masked) dilated integer arithmetic
+    template <unsigned int RANK>
+    class GridIndexSteps<util::MortonTensorIndices<RANK>> {
+        public:
+      using CellIndex_t = TensorIndicesBasicTypes::LinIndex_t;
+      using CellDimIndex_t = TensorIndicesBasicTypes::Index_t;
+      using Mask_t = typename util::MortonTensorIndices<RANK>::Mask_t;
+
+      explicit GridIndexSteps(util::MortonTensorIndices<RANK> const& indices)
+        { for (unsigned int d = 0; d < RANK; ++d) masks[d] = indices.mask(d); }
+
+      template <typename CellID>
+      CellIndex_t index(CellID const& id) const
+        {
+          Mask_t index = 0;
+          for (unsigned int d = 0; d < RANK; ++d)
+            index |= details::depositBits(Mask_t(id[d]), masks[d]);
+          return index;
+        }
+
+      CellIndex_t next(CellIndex_t index, unsigned int d) const
+        {
+          // filling the bits of the other dimensions with 1 makes the carry
+          // of the increment propagate through them
+          Mask_t const mask = masks[d];
+          return (((index | ~mask) + 1) & mask) | (index & ~mask);
+        }
+
+      CellIndex_t rewind
+        (CellIndex_t index, unsigned int d, CellDimIndex_t, CellDimIndex_t to)
+        const
+        {
+          return (index & ~masks[d])
+            | details::depositBits(Mask_t(to), masks[d]);
+        }
+
+        private:
+      std::array<Mask_t, RANK> masks; ///< bits of each dimension in the index
+
+    }; // GridIndexSteps<MortonTensorIndices>
+
+    /// Fixed sizes: steps are compile-time strides, and there is no state
+    template <TensorIndicesBasicTypes::DimSize_t... DIMS>
+    class GridIndexSteps<util::FixedTensorIndices<DIMS...>> {
+      using Indices_t = util::FixedTensorIndices<DIMS...>;
+      static constexpr unsigned int RANK = Indices_t::rank();
+        public:
+      using CellIndex_t = TensorIndicesBasicTypes::LinIndex_t;
+      using CellDimIndex_t = TensorIndicesBasicTypes::Index_t;
+
+      explicit constexpr GridIndexSteps(Indices_t const&) {}
+
+      template <typename CellID>
+      constexpr CellIndex_t index(CellID const& id) const
+        {
+          CellIndex_t index = 0;
+          for (unsigned int d = 0; d < RANK; ++d)
+            index += id[d] * Indices_t::stride(d);
+          return index;
+        }
+
+      constexpr CellIndex_t next(CellIndex_t index, unsigned int d) const
+        { return index + Indices_t::stride(d); }
+
+      constexpr CellIndex_t rewind(
+        CellIndex_t index, unsigned int d, CellDimIndex_t from, CellDimIndex_t to
+        ) const
+        { return index - (from - to) * Indices_t::stride(d); }
+
+    }; // GridIndexSteps<FixedTensorIndices>
+
+  } // namespace details
+
+
+  /**
+   * @brief Range of the indices of the cells in a box around a cell
+   * @tparam DIMS number of dimensions of the grid
+   * @tparam STEPS type of index arithmetic (`details::GridIndexSteps`)
+   *
+   * The range covers the cells whose coordinates are all within the box
+   * boundaries, clipped to the grid; it is iterated with the last coordinate
+   * running fastest, and the iterators yield cell indices.
+   * The index of the next cell is updated with precomputed steps (strides in
+   * row-major order, bit masks in Morton order), so that no full index
+   * computation is needed while iterating.
+   *
+   * This object is returned by `GridContainerIndicesBase::neighbourhood()`.
+   */
+  template <unsigned int DIMS, typename STEPS>
+  class GridNeighbourhood {
+      public:
+    using Steps_t = STEPS; ///< type of index arithmetic
+    using CellIndex_t = typename Steps_t::CellIndex_t; ///< type of cell index
+    using CellDimIndex_t = typename Steps_t::CellDimIndex_t;
+                                              ///< type of coordinate of the cell
+
+    /// Type of coordinates (or span) of a cell
+    using CellID_t = std::array<CellDimIndex_t, DIMS>;
+
+    /// Iterator through the indices of the cells
+    class const_iterator {
+        public:
+      using value_type = CellIndex_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = CellIndex_t const*;
+      using reference = CellIndex_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      const_iterator() = default;
+
+      /// Returns the index of the current cell
+      CellIndex_t operator* () const { return index; }
+
+      /// Returns the coordinates of the current cell
+      CellID_t const& cellID() const { return pos; }
+
+      const_iterator& operator++ ()
+        {
+          // odometer: the last dimension runs fastest; carries reset the
+          // dimension to its lower boundary, except for the first one
+          Steps_t const& steps = range->steps;
+          for (unsigned int d = DIMS - 1; d > 0; --d) {
+            if (++pos[d] < range->upper[d]) {
+              index = steps.next(index, d);
+              return *this;
+            }
+            index = steps.rewind(index, d, pos[d] - 1, range->lower[d]);
+            pos[d] = range->lower[d];
+          } // for
+          if (++pos[0] < range->upper[0]) index = steps.next(index, 0);
+          return *this;
+        }
+      const_iterator operator++ (int)
+        { const_iterator old(*this); operator++(); return old; }
+
+      bool operator== (const_iterator const& as) const
+        { return pos == as.pos; }
+      bool operator!= (const_iterator const& as) const
+        { return pos != as.pos; }
+
+        private:
+      friend class GridNeighbourhood;
+
+      GridNeighbourhood const* range = nullptr; ///< the range being iterated
+      CellID_t pos; ///< coordinates of the current cell
+      CellIndex_t index = 0; ///< index of the current cell
+
+      const_iterator
+        (GridNeighbourhood const* range, CellID_t const& pos, CellIndex_t index)
+        : range(range), pos(pos), index(index) {}
+
+    }; // const_iterator
+
+
+    /**
+     * @brief Constructor: box from `lower` up to `upper` (excluded)
+     * @param lower the first coordinates in the box in each dimension
+     * @param upper the coordinates past the box in each dimension
+     * @param steps index arithmetic of the grid
+     *
+     * The box must be already clipped to the grid.
+     */
+    GridNeighbourhood
+      (CellID_t const& lower, CellID_t const& upper, Steps_t const& steps)
+      : lower(lower), upper(upper), steps(steps)
+      {
+        // the end has the first coordinate past the box, the others at their
+        // lower boundary; an empty box starts at the end
+        endPos = lower;
+        endPos[0] = upper[0];
+        bool empty = false;
+        for (unsigned int d = 0; d < DIMS; ++d)
+          if (upper[d] <= lower[d]) empty = true;
+        if (empty) startPos = endPos;
+        else {
+          startPos = lower;
+          firstIndex = steps.index(lower);
+        }
+      }
+
+    /// Returns an iterator to the first cell
+    const_iterator begin() const { return { this, startPos, firstIndex }; }
+
+    /// Returns an iterator past the last cell
+    const_iterator end() const { return { this, endPos, 0 }; }
+
+    /// Returns whether the range has no cells
+    bool empty() const { return startPos == endPos; }
+
+    /// Returns the number of cells in the range
+    std::size_t size() const
+      {
+        if (empty()) return 0U;
+        std::size_t n = 1;
+        for (unsigned int d = 0; d < DIMS; ++d) n *= (upper[d] - lower[d]);
+        return n;
+      }
+
+      private:
+    CellID_t lower; ///< first coordinates in the box
+    CellID_t upper; ///< coordinates past the box
+    Steps_t steps; ///< index arithmetic
+    CellID_t startPos; ///< coordinates of the first cell
+    CellID_t endPos; ///< coordinates of the end iterator
+    CellIndex_t firstIndex = 0; ///< index of the first cell
+
+  }; // class GridNeighbourhood
+
+
+  namespace details {
+
+    /**
+     * @brief Index manager for a container of data arranged on a DIMS-dimension grid
+     * @tparam DIMS number of dimensions
+     * @tparam INDICES linearization of the cell coordinates
+     *                 (`util::TensorIndices`, `util::MortonTensorIndices`
+     *                 or `util::FixedTensorIndices`)
+     */
+    template <unsigned int DIMS, typename INDICES = util::TensorIndices<DIMS>>
     class GridContainerIndicesBase {
-      using IndexManager_t = util::TensorIndices<DIMS>;
+      using Steps_t = details::GridIndexSteps<INDICES>;
         public:
 
+      /// type of linearization of the cell coordinates
+      using IndexManager_t = INDICES;
+
       /// Returns the number of dimensions in this object
       static constexpr unsigned int dims() { return DIMS; }
 
@@ -52,9 +333,24 @@ namespace util {
       /// type of cell coordinate (x, y, z)
       using CellID_t = std::array<CellDimIndex_t, dims()>;
 
+      /// type of range of cells in a neighbourhood
+      using Neighbourhood_t = GridNeighbourhood<DIMS, Steps_t>;
+
       /// Constructor: specifies the size of the container and allocates it
       GridContainerIndicesBase(std::array<size_t, dims()> const& new_dims)
         : indices(new_dims.begin())
+        , sizes(extractSizes(indices, std::make_index_sequence<DIMS>()))
+        , steps(indices)
+        {}
+
+      /// Constructor: the sizes are the ones fixed by `IndexManager_t`
+      /// (only for index managers with compile-time sizes)
+      template <
+        typename I = IndexManager_t,
+        typename = decltype(I::dimensions())
+        >
+      GridContainerIndicesBase()
+        : GridContainerIndicesBase(I::dimensions())
         {}
 
       /// @{
@@ -67,6 +363,9 @@ namespace util {
       /// Returns the number of cells in the grid
       size_t size() const { return indices.size(); }
 
+      /// Returns whether the cell with the specified coordinates is in the grid
+      bool hasCell(CellID_t const& id) const { return indices.has(id.begin()); }
+
       /// @}
 
       /// @{
@@ -80,15 +379,45 @@ namespace util {
         (CellID_t const& origin, CellID_t const& cellID) const
         { return index(cellID) - index(origin); }
 
+      /**
+       * @brief Returns the cells within `k` cells of `center` in each dimension
+       * @param center coordinates of the central cell
+       * @param k half size of the box
+       * @return a range of cell indices
+       *
+       * The box is clipped to the grid; `center` itself may be outside the
+       * grid, in which case the range includes only the cells in the grid.
+       */
+      Neighbourhood_t neighbourhood
+        (CellID_t const& center, CellDimIndex_t k) const
+        {
+          CellID_t lower, upper;
+          for (unsigned int d = 0; d < DIMS; ++d) {
+            lower[d] = std::max(center[d] - k, CellDimIndex_t(0));
+            upper[d] = std::min
+              (center[d] + k + 1, CellDimIndex_t(sizes[d]));
+          }
+          return { lower, upper, steps };
+        }
+
       /// @}
 
         protected:
       IndexManager_t indices; ///< the actual worker
 
+      std::array<size_t, DIMS> sizes; ///< number of cells in each dimension
+      Steps_t steps; ///< index arithmetic for neighbourhoods
+
       /// Returns the index of the element from its cell coordinates (no check!)
       CellIndex_t index(CellID_t id) const
         { return indices(id.begin()); }
 
+        private:
+      template <std::size_t... D>
+      static std::array<size_t, DIMS> extractSizes
+        (IndexManager_t const& indices, std::index_sequence<D...>)
+        { return {{ indices.template dim<D>()... }}; }
+
     }; // GridContainerIndicesBase
 
   } // namespace details
@@ -96,13 +425,13 @@ namespace util {
 
 
   /// Index manager for a container of data arranged on a >=1-dim grid
-  template <unsigned int DIMS = 1U>
+  template <unsigned int DIMS = 1U, typename INDICES = util::TensorIndices<DIMS>>
   class GridContainerIndicesBase1D:
-    public details::GridContainerIndicesBase<DIMS>
+    public details::GridContainerIndicesBase<DIMS, INDICES>
   {
     static_assert(DIMS >= 1U,
       "Dimensions for GridContainerIndicesBase1D must be at least 1");
-    using Base_t = details::GridContainerIndicesBase<DIMS>;
+    using Base_t = details::GridContainerIndicesBase<DIMS, INDICES>;
 
       public:
 
@@ -124,12 +453,14 @@ namespace util {
 
 
   /// Index manager for a container of data arranged on a >=2-dim grid
-  template <unsigned int DIMS = 2U>
-  class GridContainerIndicesBase2D: public GridContainerIndicesBase1D<DIMS> {
+  template <unsigned int DIMS = 2U, typename INDICES = util::TensorIndices<DIMS>>
+  class GridContainerIndicesBase2D:
+    public GridContainerIndicesBase1D<DIMS, INDICES>
+  {
     static_assert(DIMS >= 2U,
       "Dimensions for GridContainerIndicesBase2D must be at least 2");
 
-    using Base_t = GridContainerIndicesBase1D<DIMS>;
+    using Base_t = GridContainerIndicesBase1D<DIMS, INDICES>;
 
       public:
 
@@ -151,11 +482,13 @@ namespace util {
 
 
   /// Index manager for a container of data arranged on a >=3-dim grid
-  template <unsigned int DIMS = 3U>
-  class GridContainerIndicesBase3D: public GridContainerIndicesBase2D<DIMS> {
+  template <unsigned int DIMS = 3U, typename INDICES = util::TensorIndices<DIMS>>
+  class GridContainerIndicesBase3D:
+    public GridContainerIndicesBase2D<DIMS, INDICES>
+  {
     static_assert(DIMS >= 3U,
       "Dimensions for GridContainerIndicesBase3D must be at least 3");
-    using Base_t = GridContainerIndicesBase2D<DIMS>;
+    using Base_t = GridContainerIndicesBase2D<DIMS, INDICES>;
 
       public:
 
@@ -183,6 +516,25 @@ namespace util {
   /// Index manager for a container of data arranged on a 3D grid
   using GridContainer3DIndices = GridContainerIndicesBase3D<>;
 
+  /// Index manager for a container of data on a 2D grid, in Morton order
+  using GridContainer2DMortonIndices
+    = GridContainerIndicesBase2D<2U, util::MortonTensorIndices<2U>>;
+
+  /// Index manager for a container of data on a 3D grid, in Morton order
+  using GridContainer3DMortonIndices
+    = GridContainerIndicesBase3D<3U, util::MortonTensorIndices<3U>>;
+
+  /// Index manager for a container of data on a NX x NY grid (fixed sizes)
+  template <std::size_t NX, std::size_t NY>
+  using GridContainer2DFixedIndices
+    = GridContainerIndicesBase2D<2U, util::FixedTensorIndices<NX, NY>>;
+
+  /// Index manager for a container of data on a NX x NY x NZ grid
+  /// (fixed sizes)
+  template <std::size_t NX, std::size_t NY, std::size_t NZ>
+  using GridContainer3DFixedIndices
+    = GridContainerIndicesBase3D<3U, util::FixedTensorIndices<NX, NY, NZ>>;
+
 
 } // namespace util
 
@@ -8,7 +8,14 @@
  *
  * * GridContainer2D: container on data in 2D space
  * * GridContainer3D: container of data in 3D space
+ * * MortonGridContainer2D, MortonGridContainer3D: the same, with cells in
+ *   Morton order
+ * * FixedGridContainer2D, FixedGridContainer3D: the same, with the grid sizes
+ *   fixed at compile time
+ * * SparseGridContainer2D, SparseGridContainer3D (and their Morton versions):
+ *   the same, with cells allocated in blocks only where there is data
  * * GridContainerBase: base class for containers in a N-dimension space
+ * * SparseGridContainerBase: base class for sparse containers
  *
  * This is a pure header that contains only template classes.
  */
@@ -18,10 +25,20 @@
 
 // LArSoft libraries
 #include "lardata/Utilities/GridContainerIndices.h"
+#include "lardata/Utilities/CollectionView.h"
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 // C/C++ standard libraries
 #include <vector>
 #include <array>
+#include <memory> // std::unique_ptr<>, std::make_unique()
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::vector
+#include <iterator> // std::distance()
+#include <limits> // std::numeric_limits<>
+#include <utility> // std::pair<>, std::move()
 
 
 namespace util {
@@ -37,6 +54,33 @@ namespace util {
      * It provides the full functionality, to which the other classes add
      * some dimension-specific interface.
      *
+     * Frozen storage
+     * ---------------
+     *
+     * Each cell is a separate vector, filled by `insert()`. When the content
+     * is built once and then read many times (e.g. neighbourhood scans), the
+     * container can be filled in two phases instead:
+     *
+     * 1. `stage()` queues the data, with no allocation per cell;
+     * 2. `freeze()` sorts all the data (by counting) into a single contiguous
+     *    array, with each cell taking a consecutive range (cell offsets);
+     *    data in each cell keep their order of insertion.
+     *
+     * The data of a cell are then read with `cellData()`. Data added by
+     * `insert()` before freezing are moved into the frozen array too.
+     * Data staged or inserted after `freeze()` are not visible via
+     * `cellData()` until the next `freeze()`. `clear()` removes all the data,
+     * keeping the allocated memory for the next filling.
+     *
+     * The frozen content can also be built in one go from a collection of
+     * data with `fill()`, which computes the cells in parallel.
+     *
+     * Neighbourhood
+     * --------------
+     *
+     * `neighbourhood()` returns the indices of the cells in a box around a
+     * cell, clipped to the grid, and `forEachNeighbour()` runs through the
+     * frozen data in all those cells.
      */
     template <typename DATUM, typename IXMAN>
     class GridContainerBase {
@@ -71,10 +115,51 @@ namespace util {
       /// type of iterator to all cells
       using const_iterator = typename Cells_t::const_iterator;
 
+      /// type of read-only view of the data of a cell
+      using CellView_t = lar::RangeAsCollection_t<Datum_t const*>;
+
+      /// type of range of the indices of cells around a cell
+      using Neighbourhood_t = typename Indexer_t::Neighbourhood_t;
+
       /// Constructor: specifies the size of the container and allocates it
       GridContainerBase(std::array<size_t, dims()> const& dims)
+        : GridContainerBase(dims, std::pmr::get_default_resource())
+        {}
+
+      /**
+       * @brief Constructor: sizes fixed by the index manager
+       * @param resource memory for `stage()`, `freeze()` and `fill()`
+       *
+       * This constructor is available only for index managers with the sizes
+       * fixed at compile time (e.g. `GridContainer3DFixedIndices`).
+       */
+      template <
+        typename I = typename Indexer_t::IndexManager_t,
+        typename = decltype(I::dimensions())
+        >
+      explicit GridContainerBase
+        (std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : GridContainerBase(I::dimensions(), resource)
+        {}
+
+      /**
+       * @brief Constructor: the staged and frozen data use `resource`
+       * @param dims the size of the container in each dimension
+       * @param resource memory for `stage()`, `freeze()` and `fill()`
+       *
+       * The memory of the staged and frozen data comes from `resource`
+       * (e.g. a `lar::EventArena`), which must outlive this container.
+       * The cells filled by `insert()` use the standard allocator.
+       */
+      GridContainerBase
+        (std::array<size_t, dims()> const& dims,
+         std::pmr::memory_resource* resource)
         : indices(dims)
         , data(indices.size())
+        , staged(resource)
+        , frozenData(resource)
+        , cellOffsets(resource)
+        , stagedOrder(resource)
         {}
 
       /// @{
@@ -99,6 +184,30 @@ namespace util {
         (CellID_t const& origin, CellID_t const& cellID) const
         { return indices.offset(origin, cellID); }
 
+      /// Returns the indices of the cells within `k` of `center` (see
+      /// `GridContainerIndicesBase::neighbourhood()`)
+      Neighbourhood_t neighbourhood
+        (CellID_t const& center, CellDimIndex_t k) const
+        { return indices.neighbourhood(center, k); }
+
+      /**
+       * @brief Calls `op` on all the data in the cells around `center`
+       * @param center coordinates of the central cell
+       * @param k half size of the box of cells, in each dimension
+       * @param op operation to be called with each datum (`Datum_t const&`)
+       * @see `neighbourhood()`, `cellData()`
+       *
+       * The cells are visited in `neighbourhood()` order, and their data in
+       * `cellData()` order (only frozen data, if the container is frozen).
+       */
+      template <typename Op>
+      void forEachNeighbour
+        (CellID_t const& center, CellDimIndex_t k, Op op) const
+        {
+          for (CellIndex_t index: neighbourhood(center, k))
+            for (Datum_t const& datum: cellData(index)) op(datum);
+        }
+
       /// Returns a reference to the specified cell
       Cell_t& operator[] (CellID_t const& id) { return cell(id); }
 
@@ -134,6 +243,86 @@ namespace util {
 
       /// @}
 
+      /// @{
+      /// @name Frozen storage
+
+      /// Queues a copy of an element for the specified cell (see `freeze()`)
+      void stage(CellID_t const& cellID, Datum_t const& elem)
+        { staged.emplace_back(index(cellID), elem); }
+
+      /// Queues an element for the specified cell (see `freeze()`)
+      void stage(CellID_t const& cellID, Datum_t&& elem)
+        { staged.emplace_back(index(cellID), std::move(elem)); }
+
+      /// Queues a copy of an element for the cell with the specified index
+      void stage(CellIndex_t index, Datum_t const& elem)
+        { staged.emplace_back(index, elem); }
+
+      /// Queues an element for the cell with the specified index
+      void stage(CellIndex_t index, Datum_t&& elem)
+        { staged.emplace_back(index, std::move(elem)); }
+
+      /**
+       * @brief Moves all the data into contiguous storage
+       *
+       * All the staged data and the data in the cells are moved into a single
+       * array, cell by cell: first the data already frozen, then the ones in
+       * the cell containers and last the staged ones, each in their order.
+       * The cell containers and the staging queue are left empty.
+       * The complexity is linear in the number of cells and of data.
+       */
+      void freeze();
+
+      /**
+       * @brief Replaces the content with the data from a range, frozen
+       * @tparam Iter random access iterator to data convertible to `Datum_t`
+       * @tparam CellOf functor returning the `CellID_t` of a datum
+       * @param begin iterator to the first datum
+       * @param end iterator past the last datum
+       * @param cellOf functor assigning each datum its cell
+       *
+       * The container is cleared, and then the cell of each datum is computed
+       * and the data are copied into the frozen storage, both in parallel;
+       * the cell histogram and the scatter of the positions in between are a
+       * counting sort. Data in a cell keep their order in the input range.
+       * Data assigned a cell outside the grid are skipped.
+       * `Datum_t` must be default-constructible.
+       */
+      template <typename Iter, typename CellOf>
+      void fill(Iter begin, Iter end, CellOf cellOf);
+
+      /// Returns whether `freeze()` has been called since the last `clear()`
+      bool frozen() const { return !cellOffsets.empty(); }
+
+      /// Returns the frozen data of the cell with the specified index
+      /// (if the container is not frozen, the data in the cell container)
+      CellView_t cellData(CellIndex_t index) const
+        {
+          if (!frozen()) {
+            Cell_t const& cell = data[index];
+            return lar::makeCollectionView
+              (cell.data(), cell.data() + cell.size());
+          }
+          Datum_t const* first = frozenData.data();
+          return lar::makeCollectionView
+            (first + cellOffsets[index], first + cellOffsets[index + 1]);
+        }
+
+      /// Returns the frozen data of the specified cell
+      CellView_t cellData(CellID_t const& cellID) const
+        { return cellData(index(cellID)); }
+
+      /// Removes all the data (the memory is kept for the next filling)
+      void clear()
+        {
+          for (Cell_t& cell: data) cell.clear();
+          staged.clear();
+          frozenData.clear();
+          cellOffsets.clear();
+        }
+
+      /// @}
+
       /// Returns the index manager of the grid
       Indexer_t const& indexManager() const { return indices; }
 
@@ -143,6 +332,17 @@ namespace util {
 
       Cells_t data; ///< organised collection of points
 
+      /// data queued by `stage()`, with their cell index
+      std::pmr::vector<std::pair<CellIndex_t, Datum_t>> staged;
+
+      /// frozen data, sorted by cell
+      std::pmr::vector<Datum_t> frozenData;
+      /// start of each cell in `frozenData`
+      std::pmr::vector<size_t> cellOffsets;
+
+      /// staged data sorted by cell (buffer)
+      std::pmr::vector<size_t> stagedOrder;
+
       /// Returns a reference to the specified cell
       Cell_t& cell(CellID_t const& cellID)
         { return data[index(cellID)]; }
@@ -153,6 +353,238 @@ namespace util {
 
     }; // GridContainerBase<>
 
+
+    /**
+     * @brief Base class for a sparse container of data arranged on a grid
+     * @tparam DATUM type of datum to be contained
+     * @tparam IXMAN type of the grid index manager
+     * @tparam BLOCKSIZE number of cells in each block (a power of 2)
+     *
+     * This is the counterpart of `GridContainerBase` for grids with data in
+     * only a small part of their cells. The cells are grouped in blocks of
+     * `BLOCKSIZE` consecutive indices, and a block is allocated only when data
+     * is first inserted into one of its cells: the empty grid costs one
+     * pointer per block. With the Morton index managers (e.g.
+     * `GridContainer3DMortonIndices`) the blocks are tiles of the grid
+     * (with the default size, 4 x 4 x 4 cells in 3D if each side of the grid
+     * has at least 4 cells), with the row-major ones
+     * they are runs of cells along the last dimension.
+     *
+     * The cells have the same indices as in `GridContainerBase`. Reading a
+     * cell of a block which was never allocated yields an empty cell, while
+     * the non-constant access (`operator[]`, `insert()`) allocates the block.
+     * `forEachCell()` visits only the cells of the allocated blocks.
+     * There is no frozen storage, and the container can be moved but not
+     * copied.
+     */
+    template <typename DATUM, typename IXMAN, std::size_t BLOCKSIZE = 64U>
+    class SparseGridContainerBase {
+      static_assert((BLOCKSIZE > 0U) && ((BLOCKSIZE & (BLOCKSIZE - 1U)) == 0U),
+        "The block size of SparseGridContainerBase must be a power of 2.");
+
+        public:
+      using Datum_t = DATUM; ///< type of contained datum
+      using Indexer_t = IXMAN; /// type of index manager
+
+      /// this type
+      using Grid_t = SparseGridContainerBase<Datum_t, Indexer_t, BLOCKSIZE>;
+
+
+      static constexpr unsigned int dims() { return IXMAN::dims(); }
+
+      /// Returns the number of cells in each block
+      static constexpr std::size_t blockSize() { return BLOCKSIZE; }
+
+      /// type of index for direct access to the cell
+      using CellIndex_t = typename Indexer_t::CellIndex_t;
+
+      /// type of difference between indices
+      using CellIndexOffset_t = typename Indexer_t::CellIndexOffset_t;
+
+      /// type of difference between indices
+      using CellDimIndex_t = typename Indexer_t::CellDimIndex_t;
+
+      /// type of cell coordinate (x, y, z)
+      using CellID_t = typename Indexer_t::CellID_t;
+
+      /// type of a single cell container
+      using Cell_t = std::vector<Datum_t>;
+
+      /// type of a block of cells
+      using Block_t = std::array<Cell_t, BLOCKSIZE>;
+
+      /// type of range of the indices of cells around a cell
+      using Neighbourhood_t = typename Indexer_t::Neighbourhood_t;
+
+      /// Constructor: specifies the size of the container (no cell allocated)
+      SparseGridContainerBase(std::array<size_t, dims()> const& dims)
+        : indices(dims)
+        , blocks((indices.size() + BLOCKSIZE - 1U) / BLOCKSIZE)
+        {}
+
+      /// Constructor: sizes fixed by the index manager (see
+      /// `GridContainerBase`)
+      template <
+        typename I = typename Indexer_t::IndexManager_t,
+        typename = decltype(I::dimensions())
+        >
+      SparseGridContainerBase(): SparseGridContainerBase(I::dimensions()) {}
+
+      /// @{
+      /// @name Data structure
+
+      /// Returns the total size of the container
+      size_t size() const { return indices.size(); }
+
+      /// Returns whether the specified index is valid
+      bool has(CellIndexOffset_t index) const { return indices.has(index); }
+
+      /// Returns the number of blocks the cells are grouped in
+      size_t nBlocks() const { return blocks.size(); }
+
+      /// Returns the number of blocks currently allocated
+      size_t nAllocatedBlocks() const { return allocated.size(); }
+
+      /// @}
+
+      /// @{
+      /// @name Data access
+
+      /// Return the index of the element from its cell coordinates (no check!)
+      CellIndex_t index(CellID_t const& id) const { return indices[id]; }
+
+      /// Returns the difference in index from two cells
+      CellIndexOffset_t indexOffset
+        (CellID_t const& origin, CellID_t const& cellID) const
+        { return indices.offset(origin, cellID); }
+
+      /// Returns the indices of the cells within `k` of `center` (see
+      /// `GridContainerIndicesBase::neighbourhood()`)
+      Neighbourhood_t neighbourhood
+        (CellID_t const& center, CellDimIndex_t k) const
+        { return indices.neighbourhood(center, k); }
+
+      /// Calls `op` on all the data in the cells around `center` (see
+      /// `GridContainerBase::forEachNeighbour()`)
+      template <typename Op>
+      void forEachNeighbour
+        (CellID_t const& center, CellDimIndex_t k, Op op) const
+        {
+          for (CellIndex_t index: neighbourhood(center, k)) {
+            Cell_t const* cell = findCell(index);
+            if (!cell) continue;
+            for (Datum_t const& datum: *cell) op(datum);
+          }
+        }
+
+      /**
+       * @brief Calls `op` on all the non-empty cells
+       * @param op operation called as `op(CellIndex_t, Cell_t const&)`
+       *
+       * Only the allocated blocks are visited, in the order they were
+       * allocated; the cells of each block are visited by increasing index.
+       */
+      template <typename Op>
+      void forEachCell(Op op) const
+        {
+          for (std::size_t iBlock: allocated) {
+            Block_t const& block = *(blocks[iBlock]);
+            CellIndex_t const first = iBlock * BLOCKSIZE;
+            for (std::size_t i = 0; i < BLOCKSIZE; ++i)
+              if (!block[i].empty()) op(first + i, block[i]);
+          }
+        }
+
+      /// Returns a pointer to the cell with the specified index, or `nullptr`
+      /// if its block is not allocated
+      Cell_t const* findCell(CellIndex_t index) const
+        {
+          Block_t const* block = blocks[index / BLOCKSIZE].get();
+          return block? &((*block)[index % BLOCKSIZE]): nullptr;
+        }
+
+      /// Returns a reference to the specified cell (allocating its block)
+      Cell_t& operator[] (CellID_t const& id) { return cell(index(id)); }
+
+      /// Returns a constant reference to the specified cell
+      Cell_t const& operator[] (CellID_t const& id) const
+        { return cellOrEmpty(index(id)); }
+
+      /// Returns a reference to to the cell with specified index (allocating
+      /// its block)
+      Cell_t& operator[] (CellIndex_t index) { return cell(index); }
+
+      /// Returns a constant reference to the cell with specified index
+      Cell_t const& operator[] (CellIndex_t index) const
+        { return cellOrEmpty(index); }
+
+      ///@}
+
+      /// @{
+      /// @name Data insertion
+
+      /// Copies an element into the specified cell
+      void insert(CellID_t const& cellID, Datum_t const& elem)
+        { cell(index(cellID)).push_back(elem); }
+
+      /// Moves an element into the specified cell
+      void insert(CellID_t const& cellID, Datum_t&& elem)
+        { cell(index(cellID)).push_back(std::move(elem)); }
+
+      /// Copies an element into the cell with the specified index
+      void insert(CellIndex_t index, Datum_t const& elem)
+        { cell(index).push_back(elem); }
+
+      /// Moves an element into the cell with the specified index
+      void insert(CellIndex_t index, Datum_t&& elem)
+        { cell(index).push_back(std::move(elem)); }
+
+      /// Removes all the data, releasing all the blocks
+      void clear()
+        {
+          for (std::size_t iBlock: allocated) blocks[iBlock].reset();
+          allocated.clear();
+        }
+
+      /// @}
+
+      /// Returns the index manager of the grid
+      Indexer_t const& indexManager() const { return indices; }
+
+
+        protected:
+      Indexer_t indices; ///< manager of the indices of the container
+
+      /// blocks of cells, allocated on the first insertion
+      std::vector<std::unique_ptr<Block_t>> blocks;
+
+      /// indices of the allocated blocks, in order of allocation
+      std::vector<std::size_t> allocated;
+
+      /// the cell returned for the blocks not allocated
+      static inline Cell_t const EmptyCell {};
+
+      /// Returns the cell with the specified index, allocating its block
+      Cell_t& cell(CellIndex_t index)
+        {
+          std::size_t const iBlock = index / BLOCKSIZE;
+          std::unique_ptr<Block_t>& block = blocks[iBlock];
+          if (!block) {
+            block = std::make_unique<Block_t>();
+            allocated.push_back(iBlock);
+          }
+          return (*block)[index % BLOCKSIZE];
+        }
+
+      /// Returns the cell with the specified index, or an empty one
+      Cell_t const& cellOrEmpty(CellIndex_t index) const
+        {
+          Cell_t const* cell = findCell(index);
+          return cell? *cell: EmptyCell;
+        }
+
+    }; // SparseGridContainerBase<>
+
   } // namespace details
 
 
@@ -160,18 +592,22 @@ namespace util {
    * @brief Base class for a container of data arranged on a 1D-grid
    * @tparam DATUM type of datum to be contained
    * @tparam IXMAN type of the grid index manager
+   * @tparam BASE type of the container (dense or sparse)
    *
    *
    */
-  template <typename DATUM, typename IXMAN>
-  class GridContainerBase1D: public details::GridContainerBase<DATUM, IXMAN> {
-    using Base_t = details::GridContainerBase<DATUM, IXMAN>;
+  template <
+    typename DATUM, typename IXMAN,
+    typename BASE = details::GridContainerBase<DATUM, IXMAN>
+    >
+  class GridContainerBase1D: public BASE {
+    using Base_t = BASE;
     static_assert(Base_t::dims() >= 1,
       "GridContainerBase1D must have dimensions 1 or larger.");
 
       public:
 
-    using Base_t::GridContainerBase;
+    using Base_t::Base_t;
 
     /// @{
     /// @name Data structure
@@ -193,12 +629,16 @@ namespace util {
    * @brief Base class for a container of data arranged on a 2D-grid
    * @tparam DATUM type of datum to be contained
    * @tparam IXMAN type of the grid index manager
+   * @tparam BASE type of the container (dense or sparse)
    *
    *
    */
-  template <typename DATUM, typename IXMAN>
-  class GridContainerBase2D: public GridContainerBase1D<DATUM, IXMAN> {
-    using Base_t = GridContainerBase1D<DATUM, IXMAN>;
+  template <
+    typename DATUM, typename IXMAN,
+    typename BASE = details::GridContainerBase<DATUM, IXMAN>
+    >
+  class GridContainerBase2D: public GridContainerBase1D<DATUM, IXMAN, BASE> {
+    using Base_t = GridContainerBase1D<DATUM, IXMAN, BASE>;
     static_assert(Base_t::dims() >= 2,
       "GridContainerBase2D must have dimensions 2 or larger.");
 
@@ -226,12 +666,16 @@ namespace util {
    * @brief Base class for a container of data arranged on a 3D-grid
    * @tparam DATUM type of datum to be contained
    * @tparam IXMAN type of the grid index manager
+   * @tparam BASE type of the container (dense or sparse)
    *
    *
    */
-  template <typename DATUM, typename IXMAN>
-  class GridContainerBase3D: public GridContainerBase2D<DATUM, IXMAN> {
-    using Base_t = GridContainerBase2D<DATUM, IXMAN>;
+  template <
+    typename DATUM, typename IXMAN,
+    typename BASE = details::GridContainerBase<DATUM, IXMAN>
+    >
+  class GridContainerBase3D: public GridContainerBase2D<DATUM, IXMAN, BASE> {
+    using Base_t = GridContainerBase2D<DATUM, IXMAN, BASE>;
     static_assert(Base_t::dims() >= 3,
       "GridContainerBase3D must have dimensions 3 or larger.");
 
@@ -278,7 +722,231 @@ namespace util {
   template <typename DATUM>
   using GridContainer3D = GridContainerBase3D<DATUM, GridContainer3DIndices>;
 
+
+  /**
+   * @brief Container allowing 2D indexing, with cells in Morton order
+   * @tparam DATUM type of contained data
+   * @see GridContainer2DMortonIndices, util::MortonTensorIndices
+   *
+   * This is the same as GridContainer2D, with cells close in both directions
+   * stored close together; the number of cells (`size()`) includes the
+   * padding to a power of 2 in each dimension.
+   */
+  template <typename DATUM>
+  using MortonGridContainer2D
+    = GridContainerBase2D<DATUM, GridContainer2DMortonIndices>;
+
+
+  /**
+   * @brief Container allowing 3D indexing, with cells in Morton order
+   * @tparam DATUM type of contained data
+   * @see GridContainer3DMortonIndices, util::MortonTensorIndices
+   *
+   * This is the same as GridContainer3D, with cells close in all directions
+   * stored close together; the number of cells (`size()`) includes the
+   * padding to a power of 2 in each dimension.
+   */
+  template <typename DATUM>
+  using MortonGridContainer3D
+    = GridContainerBase3D<DATUM, GridContainer3DMortonIndices>;
+
+
+  /**
+   * @brief Container allowing 2D indexing, with sizes fixed at compile time
+   * @tparam DATUM type of contained data
+   * @tparam NX number of cells on the x axis
+   * @tparam NY number of cells on the y axis
+   * @see GridContainer2DFixedIndices, util::FixedTensorIndices
+   *
+   * This is the same as GridContainer2D, with index arithmetic made of
+   * constants; it is default-constructible.
+   */
+  template <typename DATUM, std::size_t NX, std::size_t NY>
+  using FixedGridContainer2D
+    = GridContainerBase2D<DATUM, GridContainer2DFixedIndices<NX, NY>>;
+
+
+  /**
+   * @brief Container allowing 3D indexing, with sizes fixed at compile time
+   * @tparam DATUM type of contained data
+   * @tparam NX number of cells on the x axis
+   * @tparam NY number of cells on the y axis
+   * @tparam NZ number of cells on the z axis
+   * @see GridContainer3DFixedIndices, util::FixedTensorIndices
+   *
+   * This is the same as GridContainer3D, with index arithmetic made of
+   * constants; it is default-constructible.
+   */
+  template <typename DATUM, std::size_t NX, std::size_t NY, std::size_t NZ>
+  using FixedGridContainer3D
+    = GridContainerBase3D<DATUM, GridContainer3DFixedIndices<NX, NY, NZ>>;
+
+
+  /**
+   * @brief Container allowing 2D indexing, with cells allocated as needed
+   * @tparam DATUM type of contained data
+   * @see details::SparseGridContainerBase
+   *
+   * This is the same as GridContainer2D, with the cells allocated in blocks
+   * only when data is inserted in them.
+   */
+  template <typename DATUM>
+  using SparseGridContainer2D = GridContainerBase2D<
+    DATUM, GridContainer2DIndices,
+    details::SparseGridContainerBase<DATUM, GridContainer2DIndices>
+    >;
+
+
+  /**
+   * @brief Container allowing 3D indexing, with cells allocated as needed
+   * @tparam DATUM type of contained data
+   * @see details::SparseGridContainerBase
+   *
+   * This is the same as GridContainer3D, with the cells allocated in blocks
+   * only when data is inserted in them.
+   */
+  template <typename DATUM>
+  using SparseGridContainer3D = GridContainerBase3D<
+    DATUM, GridContainer3DIndices,
+    details::SparseGridContainerBase<DATUM, GridContainer3DIndices>
+    >;
+
+
+  /**
+   * @brief Container allowing 2D indexing, allocated in square tiles
+   * @tparam DATUM type of contained data
+   * @see details::SparseGridContainerBase, MortonGridContainer2D
+   *
+   * This is the same as SparseGridContainer2D, with cells in Morton order:
+   * each block is a tile of 8 x 8 cells (if both sides have at least 8).
+   */
+  template <typename DATUM>
+  using SparseMortonGridContainer2D = GridContainerBase2D<
+    DATUM, GridContainer2DMortonIndices,
+    details::SparseGridContainerBase<DATUM, GridContainer2DMortonIndices>
+    >;
+
+
+  /**
+   * @brief Container allowing 3D indexing, allocated in cubic tiles
+   * @tparam DATUM type of contained data
+   * @see details::SparseGridContainerBase, MortonGridContainer3D
+   *
+   * This is the same as SparseGridContainer3D, with cells in Morton order:
+   * each block is a tile of 4 x 4 x 4 cells (if all sides have at least 4).
+   */
+  template <typename DATUM>
+  using SparseMortonGridContainer3D = GridContainerBase3D<
+    DATUM, GridContainer3DMortonIndices,
+    details::SparseGridContainerBase<DATUM, GridContainer3DMortonIndices>
+    >;
+
 } // namespace util
 
 
+//------------------------------------------------------------------------------
+//--- template implementation
+//
+template <typename DATUM, typename IXMAN>
+void util::details::GridContainerBase<DATUM, IXMAN>::freeze() {
+
+  std::size_t const nCells = size();
+
+  // data frozen before are moved into the new storage first
+  std::pmr::vector<Datum_t> oldData(frozenData.get_allocator());
+  std::pmr::vector<size_t> oldOffsets(cellOffsets.get_allocator());
+  if (frozen()) {
+    oldData = std::move(frozenData);
+    oldOffsets = std::move(cellOffsets);
+    frozenData.clear();
+    cellOffsets.clear();
+  }
+
+  // count the data of each cell, and where the staged data of each cell start
+  cellOffsets.assign(nCells + 1, 0U);
+  std::vector<size_t> stagedStart(nCells + 1, 0U);
+  for (auto const& entry: staged) ++stagedStart[entry.first + 1];
+  for (std::size_t iCell = 0; iCell < nCells; ++iCell) {
+    std::size_t const nOld = oldOffsets.empty()
+      ? 0U: (oldOffsets[iCell + 1] - oldOffsets[iCell]);
+    cellOffsets[iCell + 1] = cellOffsets[iCell]
+      + nOld + data[iCell].size() + stagedStart[iCell + 1];
+    stagedStart[iCell + 1] += stagedStart[iCell];
+  } // for
+
+  // counting sort of the staged data
+  stagedOrder.resize(staged.size());
+  {
+    std::vector<size_t> next(stagedStart.begin(), stagedStart.end() - 1);
+    for (std::size_t iEntry = 0; iEntry < staged.size(); ++iEntry)
+      stagedOrder[next[staged[iEntry].first]++] = iEntry;
+  }
+
+  // fill the storage cell by cell
+  frozenData.reserve(cellOffsets.back());
+  for (std::size_t iCell = 0; iCell < nCells; ++iCell) {
+    if (!oldOffsets.empty()) {
+      for (std::size_t i = oldOffsets[iCell]; i < oldOffsets[iCell + 1]; ++i)
+        frozenData.push_back(std::move(oldData[i]));
+    }
+    if (!data[iCell].empty()) {
+      for (Datum_t& elem: data[iCell]) frozenData.push_back(std::move(elem));
+      Cell_t().swap(data[iCell]); // release the cell memory
+    }
+    for (std::size_t i = stagedStart[iCell]; i < stagedStart[iCell + 1]; ++i)
+      frozenData.push_back(std::move(staged[stagedOrder[i]].second));
+  } // for
+
+  staged.clear();
+
+} // util::details::GridContainerBase<>::freeze()
+
+
+//------------------------------------------------------------------------------
+template <typename DATUM, typename IXMAN>
+template <typename Iter, typename CellOf>
+void util::details::GridContainerBase<DATUM, IXMAN>::fill
+  (Iter begin, Iter end, CellOf cellOf)
+{
+  constexpr CellIndex_t NoCell = std::numeric_limits<CellIndex_t>::max();
+  using Range_t = tbb::blocked_range<std::size_t>;
+
+  clear();
+  std::size_t const n = std::distance(begin, end);
+  std::size_t const nCells = size();
+
+  // the cell of each datum (parallel)
+  std::vector<CellIndex_t> cellIndices(n);
+  tbb::parallel_for(Range_t(0, n), [&](Range_t const& range){
+    for (std::size_t i = range.begin(); i != range.end(); ++i) {
+      CellID_t const cellID = cellOf(begin[i]);
+      cellIndices[i] = indices.hasCell(cellID)? index(cellID): NoCell;
+    }
+  });
+
+  // histogram of the cells, into the offsets
+  cellOffsets.assign(nCells + 1, 0U);
+  for (CellIndex_t cellIndex: cellIndices)
+    if (cellIndex != NoCell) ++cellOffsets[cellIndex + 1];
+  for (std::size_t iCell = 0; iCell < nCells; ++iCell)
+    cellOffsets[iCell + 1] += cellOffsets[iCell];
+
+  // scatter of the positions of the data, cell by cell
+  stagedOrder.resize(cellOffsets.back());
+  {
+    std::vector<size_t> next(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (std::size_t i = 0; i < n; ++i)
+      if (cellIndices[i] != NoCell) stagedOrder[next[cellIndices[i]]++] = i;
+  }
+
+  // copy of the data (parallel)
+  frozenData.resize(stagedOrder.size());
+  tbb::parallel_for(Range_t(0, stagedOrder.size()), [&](Range_t const& range){
+    for (std::size_t k = range.begin(); k != range.end(); ++k)
+      frozenData[k] = begin[stagedOrder[k]];
+  });
+
+} // util::details::GridContainerBase<>::fill()
+
+
 #endif // LARDATA_UTILITIES_GRIDCONTAINERS_H
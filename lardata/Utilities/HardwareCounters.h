@@ -0,0 +1,431 @@
+/**
+ * @file   HardwareCounters.h
+ * @brief  Hardware performance counters for the lardata benchmarks
+ * @date   October 14, 2026
+ *
+ * This is a pure header library.
+ *
+ * The counters are read via the Linux `perf_event_open()` interface; on other
+ * systems, or when the kernel does not allow it (e.g. because of
+ * `/proc/sys/kernel/perf_event_paranoid`, or in some virtual machines), only
+ * the wall time is measured.
+ */
+
+#ifndef LARDATA_UTILITIES_HARDWARECOUNTERS_H
+#define LARDATA_UTILITIES_HARDWARECOUNTERS_H 1
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <array>
+#include <chrono>
+#include <cstdlib> // std::getenv()
+#include <cstring> // std::strerror()
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility> // std::move()
+#include <vector>
+#include <cerrno>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif // __linux__
+
+
+namespace lar {
+
+  /// Utilities for the benchmarks
+  namespace bench {
+
+    /// Hardware counts of a measured section of code
+    struct HardwareCounts {
+
+      /// The supported counters
+      enum Counter_t: unsigned int {
+        Cycles,          ///< CPU cycles
+        Instructions,    ///< retired instructions
+        CacheReferences, ///< last level cache references
+        CacheMisses,     ///< last level cache misses
+        L1DReadMisses,   ///< level 1 data cache read misses
+        BranchMisses,    ///< mispredicted branches
+        NCounters        ///< number of supported counters
+      }; // Counter_t
+
+      double seconds = 0.; ///< wall time [s]
+      std::array<std::uint64_t, NCounters> values {}; ///< by counter
+      unsigned int validMask = 0U; ///< bit `c` set if counter `c` is valid
+
+      /// Returns whether the specified counter was measured
+      bool has(Counter_t c) const { return (validMask & (1U << c)) != 0; }
+
+      /// Returns the value of the specified counter (`0` if not measured)
+      std::uint64_t get(Counter_t c) const { return has(c)? values[c]: 0U; }
+
+      /// Returns the instructions per cycle (`0` if not available)
+      double ipc() const
+        {
+          return (has(Cycles) && has(Instructions) && values[Cycles])
+            ? double(values[Instructions]) / values[Cycles]: 0.;
+        }
+
+      /// Returns the name of the specified counter
+      static char const* name(Counter_t c)
+        {
+          static char const* const names[NCounters] = {
+            "cycles", "instructions", "cache references", "cache misses",
+            "L1D read misses", "branch misses"
+          };
+          return names[c];
+        }
+
+    }; // struct HardwareCounts
+
+
+    /**
+     * @brief Reads the hardware counters of the current thread.
+     *
+     * The counters are opened at construction, and they count only between
+     * `start()` and `stop()`, in the thread which constructed this object.
+     * The code being measured should then be single-threaded.
+     *
+     * Counters which can't be opened are not reported; if none can,
+     * `available()` is `false`, `reason()` describes why, and only the wall
+     * time is measured. When the processor has fewer counters than
+     * requested, the kernel multiplexes them, and the values are scaled to
+     * the whole measurement time.
+     */
+    class HardwareCounters {
+        public:
+
+      /// Opens the counters
+      HardwareCounters();
+
+      /// Closes the counters
+      ~HardwareCounters();
+
+      HardwareCounters(HardwareCounters const&) = delete;
+      HardwareCounters& operator= (HardwareCounters const&) = delete;
+
+      /// Returns whether any hardware counter is available
+      bool available() const { return fLeader >= 0; }
+
+      /// Returns the reason why the counters are not available
+      std::string const& reason() const { return fReason; }
+
+      /// Resets and starts counting
+      void start();
+
+      /// Stops counting, and returns the counts since `start()`
+      HardwareCounts stop();
+
+      /// Runs `func` and returns its counts
+      template <typename Func>
+      HardwareCounts measure(Func&& func)
+        { start(); func(); return stop(); }
+
+
+        private:
+      using Clock_t = std::chrono::steady_clock;
+
+      int fLeader = -1; ///< file descriptor of the group leader
+      std::vector<int> fDescriptors; ///< all the open counters
+      /// Counter of each open descriptor, in group order
+      std::vector<HardwareCounts::Counter_t> fCounters;
+      std::string fReason; ///< why counters are not available
+      Clock_t::time_point fStart; ///< time of the last `start()`
+
+    }; // class HardwareCounters
+
+
+    /**
+     * @brief Runs workloads and reports their hardware counts.
+     *
+     * A test registers its workloads, each one returning the number of items
+     * it processed, and then calls `runIfEnabled()`:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * lar::bench::HardwareBenchmark bench { "neighbourhood", "cells" };
+     * bench.add("row-major", [&](){ return sumNeighbours(rowMajorGrid); });
+     * bench.add("Morton", [&](){ return sumNeighbours(mortonGrid); });
+     * bench.runIfEnabled(std::cout);
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The workloads are run only if the benchmark mode is enabled, by setting
+     * the environment variable `LARDATA_HARDWARE_BENCHMARK` to a value other
+     * than `0` (the value, if a number, is the number of repetitions).
+     * Each workload is run a number of times, and the run with the
+     * fewest cycles (or the shortest, if cycles are not available) is
+     * reported, in cycles, instructions per cycle, cache and branch misses per
+     * item.
+     */
+    class HardwareBenchmark {
+        public:
+
+      /// Measurement of one workload
+      struct Result_t {
+        std::string name; ///< name of the workload
+        std::size_t items = 0U; ///< items processed by the workload
+        HardwareCounts counts; ///< counts of the best run
+      }; // Result_t
+
+      /// Name of the environment variable enabling the benchmarks
+      static constexpr char const* EnableVariable
+        = "LARDATA_HARDWARE_BENCHMARK";
+
+      /// Constructor: `itemName` is the unit of the workloads (plural)
+      explicit HardwareBenchmark
+        (std::string name, std::string itemName = "items")
+        : fName(std::move(name)), fItemName(std::move(itemName))
+        {}
+
+      /// Registers a workload, returning the number of processed items
+      void add(std::string name, std::function<std::size_t()> workload)
+        { fWorkloads.push_back({ std::move(name), std::move(workload) }); }
+
+      /// Returns the number of registered workloads
+      std::size_t size() const { return fWorkloads.size(); }
+
+      /// Runs all the workloads `repeat` times, returning the best runs
+      std::vector<Result_t> measure(unsigned int repeat = 3U) const;
+
+      /// Runs all the workloads and prints their counts into `out`
+      void run(std::ostream& out, unsigned int repeat = 3U) const;
+
+      /// Runs and prints the workloads only if the benchmarks are enabled
+      /// @return whether the workloads were run
+      bool runIfEnabled(std::ostream& out) const;
+
+      /// Returns whether the benchmark mode is enabled
+      static bool enabled() { return enabledRepetitions() > 0U; }
+
+      /// Returns the repetitions requested by the environment (`0`: disabled)
+      static unsigned int enabledRepetitions();
+
+
+        private:
+      struct Workload_t {
+        std::string name;
+        std::function<std::size_t()> func;
+      }; // Workload_t
+
+      std::string fName; ///< name of the benchmark
+      std::string fItemName; ///< name of the processed items
+      std::vector<Workload_t> fWorkloads; ///< registered workloads
+
+    }; // class HardwareBenchmark
+
+  } // namespace bench
+
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline lar::bench::HardwareCounters::HardwareCounters() {
+
+#ifdef __linux__
+  struct EventDef_t {
+    HardwareCounts::Counter_t counter;
+    std::uint32_t type;
+    std::uint64_t config;
+  };
+  EventDef_t const events[] = {
+    { HardwareCounts::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { HardwareCounts::Instructions,
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { HardwareCounts::CacheReferences,
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+    { HardwareCounts::CacheMisses,
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { HardwareCounts::L1DReadMisses, PERF_TYPE_HW_CACHE,
+      PERF_COUNT_HW_CACHE_L1D
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    },
+    { HardwareCounts::BranchMisses,
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  };
+
+  for (EventDef_t const& event: events) {
+    perf_event_attr attr {};
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = (fLeader < 0)? 1: 0; // the group follows its leader
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP
+      | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int const fd = static_cast<int>
+      (::syscall(__NR_perf_event_open, &attr, 0, -1, fLeader, 0));
+    if (fd < 0) {
+      if (fLeader < 0) fReason = std::strerror(errno);
+      continue; // this counter is not reported
+    }
+    if (fLeader < 0) fLeader = fd;
+    fDescriptors.push_back(fd);
+    fCounters.push_back(event.counter);
+  } // for
+  if (fLeader >= 0) fReason.clear();
+#else // !__linux__
+  fReason = "hardware counters are supported only on Linux";
+#endif // __linux__
+
+} // lar::bench::HardwareCounters::HardwareCounters()
+
+
+//------------------------------------------------------------------------------
+inline lar::bench::HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (int fd: fDescriptors) ::close(fd);
+#endif // __linux__
+} // lar::bench::HardwareCounters::~HardwareCounters()
+
+
+//------------------------------------------------------------------------------
+inline void lar::bench::HardwareCounters::start() {
+#ifdef __linux__
+  if (available()) {
+    ::ioctl(fLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif // __linux__
+  fStart = Clock_t::now();
+} // lar::bench::HardwareCounters::start()
+
+
+//------------------------------------------------------------------------------
+inline lar::bench::HardwareCounts lar::bench::HardwareCounters::stop() {
+
+  auto const stopTime = Clock_t::now();
+  HardwareCounts counts;
+#ifdef __linux__
+  if (available()) {
+    ::ioctl(fLeader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // format: number of counters, time enabled, time running, values
+    std::vector<std::uint64_t> buffer(3U + fCounters.size(), 0U);
+    auto const nBytes = buffer.size() * sizeof(std::uint64_t);
+    if (::read(fLeader, buffer.data(), nBytes) == (ssize_t) nBytes) {
+      std::uint64_t const enabled = buffer[1], running = buffer[2];
+      double const scale
+        = (running > 0U && running < enabled)? double(enabled) / running: 1.;
+      for (std::size_t i = 0; i < fCounters.size(); ++i) {
+        HardwareCounts::Counter_t const c = fCounters[i];
+        counts.values[c] = static_cast<std::uint64_t>(buffer[3U + i] * scale);
+        if (running > 0U) counts.validMask |= (1U << c);
+      } // for
+    }
+  }
+#endif // __linux__
+  counts.seconds = std::chrono::duration<double>(stopTime - fStart).count();
+  return counts;
+
+} // lar::bench::HardwareCounters::stop()
+
+
+//------------------------------------------------------------------------------
+inline auto lar::bench::HardwareBenchmark::measure
+  (unsigned int repeat /* = 3U */) const -> std::vector<Result_t>
+{
+  HardwareCounters counters;
+  std::vector<Result_t> results;
+  for (Workload_t const& workload: fWorkloads) {
+    Result_t best;
+    best.name = workload.name;
+    for (unsigned int iRun = 0; iRun < std::max(repeat, 1U); ++iRun) {
+      std::size_t items = 0U;
+      HardwareCounts const counts
+        = counters.measure([&](){ items = workload.func(); });
+      bool const better = (iRun == 0)
+        || (counts.has(HardwareCounts::Cycles)
+          ? counts.get(HardwareCounts::Cycles)
+            < best.counts.get(HardwareCounts::Cycles)
+          : counts.seconds < best.counts.seconds
+          );
+      if (!better) continue;
+      best.items = items;
+      best.counts = counts;
+    } // for runs
+    results.push_back(std::move(best));
+  } // for workloads
+  return results;
+} // lar::bench::HardwareBenchmark::measure()
+
+
+//------------------------------------------------------------------------------
+inline void lar::bench::HardwareBenchmark::run
+  (std::ostream& out, unsigned int repeat /* = 3U */) const
+{
+  using Counts_t = HardwareCounts;
+
+  {
+    HardwareCounters const counters;
+    out << "Benchmark '" << fName << "' (best of " << std::max(repeat, 1U)
+      << " runs)";
+    if (!counters.available())
+      out << "; hardware counters not available: " << counters.reason();
+    out << "\n";
+  }
+
+  for (Result_t const& result: measure(repeat)) {
+    Counts_t const& counts = result.counts;
+    double const items = double(std::max<std::size_t>(result.items, 1U));
+    out << "  " << result.name << ": " << result.items << " " << fItemName
+      << " in " << (counts.seconds * 1e3) << " ms";
+    if (counts.has(Counts_t::Cycles)) {
+      out << "; " << (counts.get(Counts_t::Cycles) / items) << " cycles/"
+        << fItemName;
+    }
+    if (counts.has(Counts_t::Instructions))
+      out << ", IPC " << counts.ipc();
+    for (Counts_t::Counter_t c: { Counts_t::CacheMisses,
+      Counts_t::L1DReadMisses, Counts_t::BranchMisses }
+    ) {
+      if (!counts.has(c)) continue;
+      out << ", " << (counts.get(c) / items) << " " << Counts_t::name(c)
+        << "/" << fItemName;
+      if ((c == Counts_t::CacheMisses) && counts.has(Counts_t::CacheReferences)
+        && counts.get(Counts_t::CacheReferences)
+      ) {
+        out << " (" << (100. * counts.get(c)
+          / counts.get(Counts_t::CacheReferences)) << "% of references)";
+      }
+    } // for
+    out << "\n";
+  } // for results
+  out << std::flush;
+
+} // lar::bench::HardwareBenchmark::run()
+
+
+//------------------------------------------------------------------------------
+inline bool lar::bench::HardwareBenchmark::runIfEnabled
+  (std::ostream& out) const
+{
+  unsigned int const repeat = enabledRepetitions();
+  if (repeat == 0U) return false;
+  run(out, repeat);
+  return true;
+} // lar::bench::HardwareBenchmark::runIfEnabled()
+
+
+//------------------------------------------------------------------------------
+inline unsigned int lar::bench::HardwareBenchmark::enabledRepetitions() {
+  char const* const value = std::getenv(EnableVariable);
+  if (!value || !*value) return 0U;
+  char* end = nullptr;
+  unsigned long const n = std::strtoul(value, &end, 10);
+  if (end == value) return 3U; // not a number: default repetitions
+  return static_cast<unsigned int>(n);
+} // lar::bench::HardwareBenchmark::enabledRepetitions()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_UTILITIES_HARDWARECOUNTERS_H
@@ -0,0 +1,416 @@
+/**
+ * @file   Instrumentation.h
+ * @brief  Optional scoped timers and counters for the lardata algorithms
+ * @date   October 14, 2026
+ * @see    InstrumentationReport.h
+ *
+ * This is a pure header library.
+ *
+ * The instrumentation is enabled at compile time by defining the preprocessor
+ * macro `LARDATA_INSTRUMENTATION` to a non-zero value (e.g.
+ * `-DLARDATA_INSTRUMENTATION=1`) for the whole build. When it is not
+ * enabled, `lar::ScopedTimer` is an empty object and the recording functions
+ * do nothing, so that the instrumented code has no cost.
+ */
+
+#ifndef LARDATA_UTILITIES_INSTRUMENTATION_H
+#define LARDATA_UTILITIES_INSTRUMENTATION_H 1
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory> // std::unique_ptr<>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+
+#ifndef LARDATA_INSTRUMENTATION
+#  define LARDATA_INSTRUMENTATION 0
+#endif // !LARDATA_INSTRUMENTATION
+
+
+namespace lar {
+
+  /// Statistics of one timer or counter
+  struct InstrumentationStats_t {
+    std::uint64_t entries = 0U; ///< number of recorded entries
+    std::uint64_t sum = 0U; ///< total recorded (nanoseconds for timers)
+    std::uint64_t max = 0U; ///< largest single entry
+
+    /// Returns the average of an entry (`0` if no entry)
+    double mean() const { return entries? double(sum) / entries: 0.0; }
+
+    /// Adds the specified statistics to these ones
+    InstrumentationStats_t& operator+= (InstrumentationStats_t const& other)
+      {
+        entries += other.entries;
+        sum += other.sum;
+        max = std::max(max, other.max);
+        return *this;
+      }
+
+  }; // struct InstrumentationStats_t
+
+
+  /**
+   * @brief Registry of the timers and counters of the instrumented code
+   *
+   * Each timer and counter (_probe_) is identified by a _tag_, a type with a
+   * static member `Name` with the name to be reported:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * struct DeconvoluteTimer
+   *   { static constexpr char const* Name = "SignalShaping::Deconvolute"; };
+   * struct ROICounter
+   *   { static constexpr char const* Name = "ROIs"; };
+   *
+   * void deconvolute(std::vector<double>& waveform) {
+   *   lar::ScopedTimer<DeconvoluteTimer> const timer;
+   *   // ...
+   *   lar::Instrumentation::count<ROICounter>(rois.size());
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * Each thread accumulates its entries in its own counters, which are added
+   * together only when the statistics are requested (`GetStats()`), so that
+   * threads don't contend for them. The counters of a thread are kept after
+   * the thread has ended.
+   *
+   * When tracing is enabled at run time (`setTracing()`), each timer entry is
+   * also stored as an event with its start time and duration, which can be
+   * written in the Chrome trace event format (`writeChromeTrace()`) and
+   * inspected with a trace viewer (like `chrome://tracing` or Perfetto).
+   * At most `MaxTraceEvents` events are stored per thread.
+   *
+   * At most `MaxProbes` probes are supported; further probes share the last
+   * one.
+   *
+   * The statistics and the trace should be read when no thread is recording
+   * (e.g. at the end of the job); otherwise, they may be slightly outdated.
+   */
+  class Instrumentation {
+      public:
+
+    /// Whether the instrumentation is enabled in this build
+    static constexpr bool Enabled = (LARDATA_INSTRUMENTATION != 0);
+
+    /// Maximum number of distinct probes
+    static constexpr std::size_t MaxProbes = 64U;
+
+    /// Maximum number of trace events stored by each thread
+    static constexpr std::size_t MaxTraceEvents = 1U << 20;
+
+    /// Kind of probe
+    enum Kind_t {
+      Timer,  ///< entries are durations in nanoseconds
+      Counter ///< entries are arbitrary amounts
+    }; // Kind_t
+
+    /// Statistics of a probe, with its name
+    struct Summary_t {
+      std::string name; ///< name of the probe
+      Kind_t kind; ///< kind of the probe
+      InstrumentationStats_t stats; ///< statistics of the job
+    }; // Summary_t
+
+    /// Clock used by the timers
+    using Clock_t = std::chrono::steady_clock;
+
+    /// Adds `amount` to the counter `Tag` (if enabled)
+    template <typename Tag>
+    static void count(std::uint64_t amount = 1U)
+      { if constexpr (Enabled) record(probeID<Tag, Counter>(), amount); }
+
+    /// Records an entry of the timer `Tag` (used by `lar::ScopedTimer`)
+    template <typename Tag>
+    static void recordTime(Clock_t::time_point start, Clock_t::time_point stop)
+      { if constexpr (Enabled) recordTime(probeID<Tag, Timer>(), start, stop); }
+
+    /// Returns the statistics of the job of the probe `Tag` of kind `K`
+    template <typename Tag, Kind_t K>
+    static InstrumentationStats_t GetStats() { return GetStats(probeID<Tag, K>()); }
+
+    /// Returns the statistics of the job of the probe with the specified ID
+    static InstrumentationStats_t GetStats(std::size_t id);
+
+    /// Returns the statistics of the job of all the probes seen so far
+    static std::vector<Summary_t> GetStats();
+
+    /// Returns the number of probes seen so far
+    static std::size_t nProbes() { return registry().nProbes.load(); }
+
+    /// Returns the name of the probe with the specified ID
+    static char const* probeName(std::size_t id) { return registry().names[id]; }
+
+    /// Returns the kind of the probe with the specified ID
+    static Kind_t probeKind(std::size_t id) { return registry().kinds[id]; }
+
+    /// Enables or disables the recording of trace events from now on
+    static void setTracing(bool enable)
+      { registry().tracing.store(enable, std::memory_order_relaxed); }
+
+    /// Returns whether trace events are being recorded
+    static bool isTracing()
+      { return registry().tracing.load(std::memory_order_relaxed); }
+
+    /// Prints a table with the statistics of all the probes seen so far
+    static void printSummary
+      (std::ostream& out, std::string const& indent = "");
+
+    /// Writes all the trace events recorded so far, in Chrome JSON format
+    static void writeChromeTrace(std::ostream& out);
+
+    /// Records an entry of `amount` into the probe with the specified ID
+    static void record(std::size_t id, std::uint64_t amount);
+
+    /// Records a timer entry (and its trace event, if tracing)
+    static void recordTime
+      (std::size_t id, Clock_t::time_point start, Clock_t::time_point stop);
+
+    /// Returns the ID of the probe `Tag` of kind `K`, registering it if needed
+    template <typename Tag, Kind_t K>
+    static std::size_t probeID()
+      { static std::size_t const id = registerProbe(Tag::Name, K); return id; }
+
+
+      private:
+
+    /// Counters of one probe in a thread (written only by that thread)
+    struct ThreadStats_t {
+      std::atomic<std::uint64_t> entries { 0U };
+      std::atomic<std::uint64_t> sum { 0U };
+      std::atomic<std::uint64_t> max { 0U };
+    }; // struct ThreadStats_t
+
+    /// A timer entry, with times in nanoseconds since the start of the job
+    struct TraceEvent_t {
+      std::size_t id; ///< probe ID
+      std::uint64_t start; ///< start time
+      std::uint64_t duration; ///< duration
+    }; // TraceEvent_t
+
+    /// All the data recorded by a thread
+    struct ThreadData_t {
+      std::size_t thread; ///< index of the thread
+      std::array<ThreadStats_t, MaxProbes> stats; ///< by probe ID
+      std::vector<TraceEvent_t> trace; ///< timer entries, if tracing
+    }; // ThreadData_t
+
+    struct Registry_t {
+      std::atomic<std::size_t> nProbes { 0U }; ///< number of registered probes
+      std::array<char const*, MaxProbes> names {}; ///< name of each probe
+      std::array<Kind_t, MaxProbes> kinds {}; ///< kind of each probe
+      std::atomic<bool> tracing { false }; ///< whether to record trace events
+      Clock_t::time_point const epoch = Clock_t::now(); ///< trace time origin
+      std::vector<std::unique_ptr<ThreadData_t>> threads; ///< data by thread
+      std::mutex mutex; ///< protects the registration of probes and threads
+    }; // struct Registry_t
+
+    /// Returns the registry of the job
+    static Registry_t& registry() { static Registry_t reg; return reg; }
+
+    /// Returns the data of this thread, registering it if needed
+    static ThreadData_t& threadData()
+      {
+        static thread_local ThreadData_t* const data = registerThread();
+        return *data;
+      }
+
+    /// Registers a probe with the specified name, and returns its ID
+    static std::size_t registerProbe(char const* name, Kind_t kind);
+
+    /// Registers a new thread, and returns its data
+    static ThreadData_t* registerThread();
+
+    /// Adds `amount` to the specified counters (from their thread only)
+    static void add(ThreadStats_t& stats, std::uint64_t amount);
+
+  }; // class Instrumentation
+
+
+  /**
+   * @brief Measures the time spent in a scope, under the timer `Tag`
+   * @tparam Tag the tag of the timer (see `lar::Instrumentation`)
+   *
+   * The time from the construction to the destruction of this object is
+   * recorded by `lar::Instrumentation`. If the instrumentation is not enabled
+   * at compile time, this object is empty and does nothing.
+   */
+  template <typename Tag, bool = Instrumentation::Enabled>
+  class ScopedTimer {
+      public:
+    ScopedTimer(): fStart(Instrumentation::Clock_t::now()) {}
+    ~ScopedTimer()
+      {
+        Instrumentation::recordTime<Tag>
+          (fStart, Instrumentation::Clock_t::now());
+      }
+
+    ScopedTimer(ScopedTimer const&) = delete;
+    ScopedTimer& operator= (ScopedTimer const&) = delete;
+
+      private:
+    Instrumentation::Clock_t::time_point const fStart; ///< construction time
+
+  }; // class ScopedTimer<>
+
+  // disabled timer: no measurement at all
+  template <typename Tag>
+  class ScopedTimer<Tag, false> {
+      public:
+    ScopedTimer() {}
+
+    ScopedTimer(ScopedTimer const&) = delete;
+    ScopedTimer& operator= (ScopedTimer const&) = delete;
+  }; // class ScopedTimer<Tag, false>
+
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline lar::InstrumentationStats_t lar::Instrumentation::GetStats
+  (std::size_t id)
+{
+  Registry_t& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  InstrumentationStats_t result;
+  for (auto const& data: reg.threads) {
+    ThreadStats_t const& stats = data->stats[id];
+    InstrumentationStats_t threadStats;
+    threadStats.entries = stats.entries.load(std::memory_order_relaxed);
+    threadStats.sum = stats.sum.load(std::memory_order_relaxed);
+    threadStats.max = stats.max.load(std::memory_order_relaxed);
+    result += threadStats;
+  } // for threads
+  return result;
+} // lar::Instrumentation::GetStats(std::size_t)
+
+
+//------------------------------------------------------------------------------
+inline auto lar::Instrumentation::GetStats() -> std::vector<Summary_t> {
+  std::vector<Summary_t> result;
+  std::size_t const n = nProbes();
+  result.reserve(n);
+  for (std::size_t id = 0; id < n; ++id)
+    result.push_back({ probeName(id), probeKind(id), GetStats(id) });
+  return result;
+} // lar::Instrumentation::GetStats()
+
+
+//------------------------------------------------------------------------------
+inline void lar::Instrumentation::printSummary
+  (std::ostream& out, std::string const& indent /* = "" */)
+{
+  bool first = true;
+  for (Summary_t const& probe: GetStats()) {
+    if (!first) out << "\n";
+    first = false;
+    InstrumentationStats_t const& stats = probe.stats;
+    out << indent << probe.name << ": ";
+    if (probe.kind == Timer) {
+      out << stats.entries << " calls, " << (stats.sum / 1e6) << " ms ("
+        << (stats.mean() / 1e3) << " us per call, at most "
+        << (stats.max / 1e3) << " us)";
+    }
+    else {
+      out << stats.sum << " in " << stats.entries << " entries ("
+        << stats.mean() << " per entry, at most " << stats.max << ")";
+    }
+  } // for probes
+} // lar::Instrumentation::printSummary()
+
+
+//------------------------------------------------------------------------------
+inline void lar::Instrumentation::writeChromeTrace(std::ostream& out) {
+  Registry_t& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  for (auto const& data: reg.threads) {
+    for (TraceEvent_t const& event: data->trace) {
+      if (!first) out << ",";
+      first = false;
+      // times are in microseconds
+      out << "\n{\"name\":\"" << reg.names[event.id]
+        << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << data->thread
+        << ",\"ts\":" << (event.start / 1e3)
+        << ",\"dur\":" << (event.duration / 1e3) << "}";
+    } // for events
+  } // for threads
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+} // lar::Instrumentation::writeChromeTrace()
+
+
+//------------------------------------------------------------------------------
+inline void lar::Instrumentation::record(std::size_t id, std::uint64_t amount)
+  { add(threadData().stats[id], amount); }
+
+
+//------------------------------------------------------------------------------
+inline void lar::Instrumentation::recordTime
+  (std::size_t id, Clock_t::time_point start, Clock_t::time_point stop)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  ThreadData_t& data = threadData();
+  std::uint64_t const duration
+    = duration_cast<nanoseconds>(stop - start).count();
+  add(data.stats[id], duration);
+
+  if (!isTracing() || (data.trace.size() >= MaxTraceEvents)) return;
+  std::uint64_t const time
+    = duration_cast<nanoseconds>(start - registry().epoch).count();
+  data.trace.push_back({ id, time, duration });
+
+} // lar::Instrumentation::recordTime()
+
+
+//------------------------------------------------------------------------------
+inline void lar::Instrumentation::add
+  (ThreadStats_t& stats, std::uint64_t amount)
+{
+  // only this thread writes these counters: no atomic read-modify-write needed
+  constexpr auto relaxed = std::memory_order_relaxed;
+  stats.entries.store(stats.entries.load(relaxed) + 1U, relaxed);
+  stats.sum.store(stats.sum.load(relaxed) + amount, relaxed);
+  if (amount > stats.max.load(relaxed)) stats.max.store(amount, relaxed);
+} // lar::Instrumentation::add()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t lar::Instrumentation::registerProbe
+  (char const* name, Kind_t kind)
+{
+  Registry_t& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::size_t const n = reg.nProbes.load();
+  if (n == MaxProbes) return MaxProbes - 1U; // shares the last probe
+  reg.names[n] = (n == MaxProbes - 1U)? "(other)": name;
+  reg.kinds[n] = kind;
+  reg.nProbes.store(n + 1U);
+  return n;
+} // lar::Instrumentation::registerProbe()
+
+
+//------------------------------------------------------------------------------
+inline auto lar::Instrumentation::registerThread() -> ThreadData_t* {
+  Registry_t& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.threads.push_back(std::make_unique<ThreadData_t>());
+  ThreadData_t* const data = reg.threads.back().get();
+  data->thread = reg.threads.size() - 1U;
+  return data;
+} // lar::Instrumentation::registerThread()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_UTILITIES_INSTRUMENTATION_H
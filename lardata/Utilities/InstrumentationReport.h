@@ -0,0 +1,69 @@
+/**
+ * @file   InstrumentationReport.h
+ * @brief  _art_ service reporting the timers and counters of lardata
+ * @date   October 14, 2026
+ * @see    InstrumentationReport_service.cc, Instrumentation.h
+ */
+
+#ifndef LARDATA_UTILITIES_INSTRUMENTATIONREPORT_H
+#define LARDATA_UTILITIES_INSTRUMENTATIONREPORT_H 1
+
+// LArSoft libraries
+#include "lardata/Utilities/Instrumentation.h"
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <string>
+
+
+namespace lar {
+
+  /**
+   * @brief Reports the timers and counters of the instrumented code.
+   *
+   * At the end of the job, the statistics of all the timers and counters of
+   * `lar::Instrumentation` are printed on the `mf::LogInfo` stream
+   * `InstrumentationReport`: the number of calls and the total, average and
+   * maximum time of each timer, and the total, average and maximum amount of
+   * each counter. The statistics include all the threads.
+   *
+   * Unlike the _art_ `TimeTracker` service, which measures whole modules,
+   * this service reports the time spent in the instrumented helpers, from
+   * all the modules using them.
+   *
+   * The instrumentation must be enabled at compile time (see
+   * `LARDATA_INSTRUMENTATION`); otherwise this service only prints a warning
+   * that there is nothing to report.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *ChromeTraceFile* (string, default: empty): if not empty, each timer
+   *   entry is recorded, and at the end of the job all of them are written
+   *   in this file in Chrome trace event format (JSON)
+   */
+  class InstrumentationReport {
+      public:
+
+    InstrumentationReport
+      (fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+      private:
+
+    std::string const fChromeTraceFile; ///< path of the trace (empty: none)
+
+    void postEndJob();
+
+  }; // class InstrumentationReport
+
+} // namespace lar
+
+
+DECLARE_ART_SERVICE(lar::InstrumentationReport, SHARED)
+
+
+#endif // LARDATA_UTILITIES_INSTRUMENTATIONREPORT_H
@@ -0,0 +1,59 @@
+/**
+ * @file   InstrumentationReport_service.cc
+ * @brief  _art_ service reporting the timers and counters of lardata
+ * @date   October 14, 2026
+ * @see    InstrumentationReport.h
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/InstrumentationReport.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <sstream>
+
+
+//------------------------------------------------------------------------------
+lar::InstrumentationReport::InstrumentationReport
+  (fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
+  : fChromeTraceFile(pset.get<std::string>("ChromeTraceFile", ""))
+{
+  if (!Instrumentation::Enabled) {
+    mf::LogWarning("InstrumentationReport") << "lardata was built without"
+      " LARDATA_INSTRUMENTATION: no timer nor counter will be reported.";
+    return;
+  }
+  if (!fChromeTraceFile.empty()) Instrumentation::setTracing(true);
+  reg.sPostEndJob.watch(this, &InstrumentationReport::postEndJob);
+} // lar::InstrumentationReport::InstrumentationReport()
+
+
+//------------------------------------------------------------------------------
+void lar::InstrumentationReport::postEndJob() {
+
+  std::ostringstream summary;
+  Instrumentation::printSummary(summary, "  ");
+  mf::LogInfo("InstrumentationReport")
+    << "Timers and counters of lardata:\n" << summary.str();
+
+  if (fChromeTraceFile.empty()) return;
+
+  Instrumentation::setTracing(false);
+  std::ofstream traceFile(fChromeTraceFile);
+  if (!traceFile) {
+    mf::LogError("InstrumentationReport")
+      << "Can't write the trace into '" << fChromeTraceFile << "'.";
+    return;
+  }
+  Instrumentation::writeChromeTrace(traceFile);
+  mf::LogInfo("InstrumentationReport")
+    << "Trace written into '" << fChromeTraceFile << "'.";
+
+} // lar::InstrumentationReport::postEndJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_SERVICE(lar::InstrumentationReport)
@@ -0,0 +1,160 @@
+/**
+ * @file    InterpolationTable.h
+ * @brief   Sorted table of values with linear interpolation
+ * @date    October 14, 2026
+ *
+ * This is a pure header library.
+ */
+
+#ifndef LARDATA_UTILITIES_INTERPOLATIONTABLE_H
+#define LARDATA_UTILITIES_INTERPOLATIONTABLE_H 1
+
+// C/C++ standard libraries
+#include <algorithm> // std::upper_bound(), std::sort()
+#include <cstddef> // std::size_t
+#include <map>
+#include <numeric> // std::iota()
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <string> // std::to_string()
+#include <vector>
+
+
+namespace lar {
+  namespace util {
+
+    /**
+     * @brief Table of values of a function on sorted points
+     * @tparam T type of the points and of the values
+     *
+     * The table stores the points and the values in two flat, sorted arrays,
+     * which makes the lookup a binary search on contiguous memory and avoids
+     * the allocation of nodes of a `std::map`.
+     * The value at a point between two of the table is interpolated
+     * linearly; outside the range of the table, the value at the closest
+     * end is returned:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * lar::util::InterpolationTable<double> const table
+     *   ({ { 1.0, 10.0 }, { 2.0, 20.0 } }); // from a std::map
+     * double const v = table(1.5); // 15.0
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The interpolation of an empty table is not defined.
+     */
+    template <typename T = double>
+    class InterpolationTable {
+        public:
+      using Data_t = T; ///< type of the points and values
+
+      /// Constructor: an empty table
+      InterpolationTable() = default;
+
+      /// Constructor: points and values from a map
+      explicit InterpolationTable(std::map<Data_t, Data_t> const& values)
+        {
+          fX.reserve(values.size());
+          fY.reserve(values.size());
+          for (auto const& point: values) {
+            fX.push_back(point.first);
+            fY.push_back(point.second);
+          }
+        }
+
+      /**
+       * @brief Constructor: points and values from two arrays
+       * @param x the points (need not be sorted)
+       * @param y the values at each of the points
+       * @throw std::invalid_argument if the sizes of `x` and `y` differ
+       */
+      InterpolationTable(std::vector<Data_t> const& x, std::vector<Data_t> const& y)
+        {
+          if (x.size() != y.size()) {
+            throw std::invalid_argument("InterpolationTable: "
+              + std::to_string(x.size()) + " points but "
+              + std::to_string(y.size()) + " values");
+          }
+          std::vector<std::size_t> order(x.size());
+          std::iota(order.begin(), order.end(), 0U);
+          std::sort(order.begin(), order.end(),
+            [&x](std::size_t a, std::size_t b){ return x[a] < x[b]; });
+          fX.reserve(x.size());
+          fY.reserve(y.size());
+          for (std::size_t i: order) {
+            fX.push_back(x[i]);
+            fY.push_back(y[i]);
+          }
+        }
+
+      /// Returns whether the table has no point
+      bool empty() const { return fX.empty(); }
+
+      /// Returns the number of points in the table
+      std::size_t size() const { return fX.size(); }
+
+      /// Returns the sorted points
+      std::vector<Data_t> const& points() const { return fX; }
+
+      /// Returns the values, in the order of the points
+      std::vector<Data_t> const& values() const { return fY; }
+
+      /// Returns the smallest point in the table
+      Data_t minPoint() const { return fX.front(); }
+
+      /// Returns the largest point in the table
+      Data_t maxPoint() const { return fX.back(); }
+
+      /// Returns the interpolated value at `x`
+      Data_t operator() (Data_t x) const { return interpolate(x); }
+
+      /**
+       * @brief Returns the value at `x`, interpolated linearly
+       * @param x the point to evaluate the table at
+       * @return the interpolated value
+       *
+       * Outside the range of the points, the value of the closest point is
+       * returned.
+       */
+      Data_t interpolate(Data_t x) const
+        {
+          if (x <= fX.front()) return fY.front();
+          if (x >= fX.back()) return fY.back();
+          std::size_t const i = upperIndex(x);
+          Data_t const t = (x - fX[i - 1]) / (fX[i] - fX[i - 1]);
+          return fY[i - 1] + t * (fY[i] - fY[i - 1]);
+        }
+
+      /**
+       * @brief Returns the value at `x`, which must be in the range of points
+       * @throw std::out_of_range if `x` is outside the range of points
+       */
+      Data_t at(Data_t x) const
+        {
+          if (empty() || (x < fX.front()) || (x > fX.back())) {
+            throw std::out_of_range
+              ("InterpolationTable: point " + std::to_string(x)
+              + " out of range");
+          }
+          return interpolate(x);
+        }
+
+      /// Returns the original content as a map
+      std::map<Data_t, Data_t> toMap() const
+        {
+          std::map<Data_t, Data_t> values;
+          for (std::size_t i = 0; i < size(); ++i) values.emplace(fX[i], fY[i]);
+          return values;
+        }
+
+        private:
+      std::vector<Data_t> fX; ///< sorted points
+      std::vector<Data_t> fY; ///< value at each point
+
+      /// Index of the first point larger than `x` (`x` must be in range)
+      std::size_t upperIndex(Data_t x) const
+        { return std::upper_bound(fX.begin(), fX.end(), x) - fX.begin(); }
+
+    }; // class InterpolationTable<>
+
+  } // namespace util
+} // namespace lar
+
+
+#endif // LARDATA_UTILITIES_INTERPOLATIONTABLE_H
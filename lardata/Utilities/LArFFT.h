@@ -15,14 +15,94 @@
 #include "TH1D.h"
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
 
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/LArFFTWWorkspacePool.h"
+
 ///General LArSoft Utilities
 namespace util{
+
+    /**
+     * Transforms of one size, as handed out by `LArFFT::Transforms()`.
+     *
+     * The set holds either the ROOT `TFFTRealComplex`/`TFFTComplexReal`
+     * pair or the FFTW plans with their workspace pool, depending on the
+     * backend. It stays valid as long as a handle to it is kept, also after
+     * `LArFFT` has dropped it from its registry.
+     * The ROOT transforms hold the data being transformed, so they are
+     * used by one thread at a time (concurrent calls wait for each other);
+     * the FFTW ones run concurrently, each on a workspace of the pool.
+     */
+    class LArFFTTransforms {
+    public:
+      LArFFTTransforms(int size, std::string const& option, bool useFFTW, int fitbins);
+      ~LArFFTTransforms();
+
+      LArFFTTransforms(LArFFTTransforms const&) = delete;
+      LArFFTTransforms& operator=(LArFFTTransforms const&) = delete;
+
+      template <class T> void         DoFFT(std::vector<T> & input,
+					    std::vector<TComplex> & output);
+
+      template <class T> void         DoInvFFT(std::vector<TComplex> & input,
+					       std::vector<T> & output);
+
+      // Convolution with an already transformed response function
+      template <class T> void         Convolute(std::vector<T> & input,
+					        std::vector<TComplex> const& kern);
+
+      int   Size()                const { return fSize; }
+      int   FreqSize()            const { return fFreqSize; }
+      std::string const& Option() const { return fOption; }
+      bool  UsesFFTW()            const { return fUseFFTW; }
+
+    private:
+      int                    fSize;       ///< size of transform
+      int                    fFreqSize;   ///< size of frequency space
+      std::string            fOption;     ///< FFTW setting
+      bool                   fUseFFTW;    ///< whether FFTW backend is used
+
+      std::unique_ptr<TFFTRealComplex> fFFT;        ///< object to do FFT
+      std::unique_ptr<TFFTComplexReal> fInverseFFT; ///< object to do Inverse FFT
+      std::mutex fROOTMutex;                        ///< serializes the ROOT transforms
+      std::shared_ptr<LArFFTWPlan const> fFFTWPlan; ///< FFTW plans (FFTW backend)
+      std::unique_ptr<LArFFTWWorkspacePool> fFFTWPool; ///< FFTW workspaces
+
+    }; // class LArFFTTransforms
+
+    /**
+     * The transforms are executed by the backend selected with the
+     * `FFTBackend` configuration parameter:
+     * * `"ROOT"` (default): ROOT `TFFTRealComplex`/`TFFTComplexReal`,
+     *   filled and read point by point;
+     * * `"FFTW"`: `util::LArFFTW` workspaces sharing one `LArFFTWPlan`,
+     *   transforming whole buffers; `DoFFT()` and `DoInvFFT()` can then
+     *   be called concurrently.
+     *
+     * The interface (`TComplex` frequency series) is the same for both.
+     * Peak correlation fits always use ROOT.
+     *
+     * `FindCorrelationPeak()` looks for the correlation peak only within a
+     * window of lags, against an already transformed reference, without
+     * inverse transform and without fit (see `LArFFTW::FindSpectrumPeak()`).
+     *
+     * The transforms of the last `MaxCachedSizes` sizes (default: 4) are
+     * kept in a registry, most recently used first: `ReinitializeFFT()`
+     * and the run-by-run size update switch to a cached size without
+     * planning it again. `Transforms(size)` hands out the transforms of a
+     * specific size (rounded up to a power of 2) from the same registry,
+     * for callers working at a size different from the current one.
+     */
     class LArFFT {
     public:
       LArFFT(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
@@ -66,12 +146,28 @@ namespace util{
       template <class T> T           PeakCorrelation(std::vector<T> &shape1,
 						     std::vector<T> &shape2);
 
+      template <class T> LArFFTW::CorrelationPeak
+        FindCorrelationPeak(std::vector<T> & shape,
+                            std::vector<TComplex> const& refKern,
+                            int minLag, int maxLag,
+                            LArFFTW::PeakInterpolation interp = LArFFTW::kParabolic);
+
       int   FFTSize()          const { return fSize; }
       std::string FFTOptions() const { return fOption; }
       int FFTFitBins()         const { return fFitBins; }
+      std::string FFTBackend() const { return fBackend; }
 
       void ReinitializeFFT(int, std::string, int);
 
+      // Transforms of the specified size (rounded up to a power of 2)
+      std::shared_ptr<LArFFTTransforms> Transforms(int size);
+
+      // Transforms of the current size
+      std::shared_ptr<LArFFTTransforms> CurrentTransforms() const { return fTransforms; }
+
+      unsigned int MaxCachedSizes() const { return fMaxCachedSizes; }
+      unsigned int NCachedSizes() const;
+
 	private:
 
       int                    fSize;       //size of transform
@@ -82,9 +178,21 @@ namespace util{
       TH1D                  *fConvHist;   //Fit data histogram
       std::vector<TComplex>  fCompTemp;   //temporary complex data
       std::vector<TComplex>  fKern;       //transformed response function
+      std::vector<double>    fKernResp;   //response function transformed in fKern
 
-      TFFTRealComplex       *fFFT;        ///< object to do FFT
-      TFFTComplexReal       *fInverseFFT; ///< object to do Inverse FF
+      template <class T> bool  IsKernelOf(std::vector<T> const& respFunc) const;
+
+      std::string            fBackend;    ///< FFT backend ("ROOT" or "FFTW")
+      bool                   fUseFFTW;    ///< whether FFTW backend is used
+      unsigned int           fMaxCachedSizes; ///< transforms kept in the registry
+
+      std::shared_ptr<LArFFTTransforms> fTransforms; ///< transforms of fSize
+
+      /// Registry of the transforms, most recently used first
+      std::list<std::shared_ptr<LArFFTTransforms>> fRegistry;
+      mutable std::mutex     fRegistryMutex; ///< protects fRegistry
+
+      static int RoundedSize(int size);
 
       void InitializeFFT();
       void resetSizePerRun(art::Run const&);
@@ -98,9 +206,36 @@ namespace util{
 template <class T> inline void util::LArFFT::DoFFT(std::vector<T> & input,
 						   std::vector<TComplex> & output)
 {
+  fTransforms->DoFFT(input, output);
+}
+
+//Inverse Fourier Transform
+//-------------------------------------------------
+template <class T> inline void util::LArFFT::DoInvFFT(std::vector<TComplex> & input,
+						      std::vector<T> & output)
+{
+  fTransforms->DoInvFFT(input, output);
+}
+
+// "Forward" Fourier Transform
+//--------------------------------------------------------
+template <class T> inline void util::LArFFTTransforms::DoFFT(std::vector<T> & input,
+							     std::vector<TComplex> & output)
+{
+  if (fUseFFTW) {
+    static thread_local LArFFTW::ComplexVector spectrum;
+    spectrum.resize(fFreqSize);
+    fFFTWPool->Lease()->DoFFT(input, spectrum);
+    for(int i = 0; i < fFreqSize; ++i)
+      output[i] = TComplex(spectrum[i].real(), spectrum[i].imag());
+    return;
+  }
+
   double real      = 0.;  //real value holder
   double imaginary = 0.;  //imaginary value hold
 
+  std::lock_guard<std::mutex> const lock(fROOTMutex);
+
   // set the points
   for(size_t p = 0; p < input.size(); ++p)
     fFFT->SetPoint(p, input[p]);
@@ -117,9 +252,20 @@ template <class T> inline void util::LArFFT::DoFFT(std::vector<T> & input,
 
 //Inverse Fourier Transform
 //-------------------------------------------------
-template <class T> inline void util::LArFFT::DoInvFFT(std::vector<TComplex> & input,
-						      std::vector<T> & output)
+template <class T> inline void util::LArFFTTransforms::DoInvFFT(std::vector<TComplex> & input,
+								std::vector<T> & output)
 {
+  if (fUseFFTW) {
+    static thread_local LArFFTW::ComplexVector spectrum;
+    spectrum.resize(fFreqSize);
+    for(int i = 0; i < fFreqSize; ++i)
+      spectrum[i] = std::complex<double>(input[i].Re(), input[i].Im());
+    fFFTWPool->Lease()->DoInvFFT(spectrum, output);
+    return;
+  }
+
+  std::lock_guard<std::mutex> const lock(fROOTMutex);
+
   for(int i = 0; i < fFreqSize; ++i)
     fInverseFFT->SetPointComplex(i, input[i]);
 
@@ -132,13 +278,42 @@ template <class T> inline void util::LArFFT::DoInvFFT(std::vector<TComplex> & in
   return;
 }
 
+//Convolution scheme using an already transformed
+//response function
+//--------------------------------------------------
+template <class T> inline void util::LArFFTTransforms::Convolute(std::vector<T> & input,
+								 std::vector<TComplex> const& kern)
+{
+  static thread_local std::vector<TComplex> spectrum;
+  spectrum.resize(fFreqSize);
+  DoFFT(input, spectrum);
+
+  for(int i = 0; i < fFreqSize; i++)
+    spectrum[i]*=kern[i];
+
+  DoInvFFT(spectrum, input);
+}
+
+//Whether fKern holds the transform of respFunc
+//--------------------------------------------------
+template <class T> inline bool util::LArFFT::IsKernelOf(std::vector<T> const& respFunc) const
+{
+  return !fKernResp.empty()
+    && std::equal(respFunc.begin(), respFunc.end(), fKernResp.begin(), fKernResp.end(),
+      [](T a, double b){ return static_cast<double>(a) == b; });
+}
+
 //Deconvolution scheme taking all time-domain
 //information
 //--------------------------------------------------
 template <class T> inline void util::LArFFT::Deconvolute(std::vector<T> & input,
 							 std::vector<T> & respFunction)
 {
-  DoFFT(respFunction, fKern);
+  // the transform of the response is reused while the response is unchanged
+  if (!IsKernelOf(respFunction)) {
+    DoFFT(respFunction, fKern);
+    fKernResp.assign(respFunction.begin(), respFunction.end());
+  }
   DoFFT(input, fCompTemp);
 
   for(int i = 0; i < fFreqSize; i++)
@@ -174,6 +349,7 @@ template <class T> inline void util::LArFFT::Convolute(std::vector<T> & shape1,
 						       std::vector<T> & shape2)
 {
   DoFFT(shape1, fKern);
+  fKernResp.clear();
   DoFFT(shape2, fCompTemp);
 
   for(int i = 0; i < fFreqSize; i++)
@@ -208,6 +384,7 @@ template <class T> inline void util::LArFFT::Correlate(std::vector<T> & shape1,
 						       std::vector<T> & shape2)
 {
   DoFFT(shape1, fKern);
+  fKernResp.clear();
   DoFFT(shape2, fCompTemp);
 
   for(int i = 0; i < fFreqSize; i++)
@@ -292,5 +469,25 @@ template <class T> inline T util::LArFFT::PeakCorrelation(std::vector<T> & shape
   return fPeakFit->GetParameter(1)+startT;
 }
 
+//Returns the lag of the correlation peak of shape with the
+//transformed reference refKern, within [ minLag, maxLag ]
+//--------------------------------------------------
+template <class T> inline util::LArFFTW::CorrelationPeak
+util::LArFFT::FindCorrelationPeak(std::vector<T> & shape,
+                                  std::vector<TComplex> const& refKern,
+                                  int minLag, int maxLag,
+                                  LArFFTW::PeakInterpolation interp)
+{
+  DoFFT(shape, fCompTemp);
+
+  LArFFTW::ComplexVector cross(fFreqSize);
+  for(int i = 0; i < fFreqSize; i++) {
+    TComplex const c = fCompTemp[i]*TComplex::Conjugate(refKern[i]);
+    cross[i] = { c.Re(), c.Im() };
+  }
+
+  return LArFFTW::FindSpectrumPeak(cross, fSize, minLag, maxLag, interp);
+}
+
 DECLARE_ART_SERVICE(util::LArFFT, LEGACY)
 #endif // LARFFT_H
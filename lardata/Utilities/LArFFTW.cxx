@@ -1,23 +1,65 @@
 #include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+#include <cmath>
 
 using std::string;
 
+namespace {
+
+  // ---------------------------------------------------------------------------
+  // ~~~~ Correlation at lag tau from the cross spectrum P of a real transform
+  //      of size n: (1/n) sum over all frequencies of P[k] exp(2 pi i k tau/n),
+  //      the negative frequencies being the conjugates of the positive ones;
+  //      the first and second derivative are also returned, if requested
+  // ---------------------------------------------------------------------------
+  double CorrelationAt(std::complex<double> const* P, int n, double tau,
+                       double* d1 = nullptr, double* d2 = nullptr)
+  {
+    constexpr int kBlock = 64; // phase recomputed exactly at each block start
+    int const nFreq = n/2+1;
+    double const omega = 2.0*std::acos(-1)/n;
+    std::complex<double> const step = std::polar(1., omega*tau);
+
+    double c = 0., c1 = 0., c2 = 0.;
+    std::complex<double> w;
+    for(int k = 0; k < nFreq; ++k){
+      if(k % kBlock == 0) w = std::polar(1., omega*tau*k);
+      double const weight = (k == 0 || 2*k == n)? 1.: 2.;
+      std::complex<double> const term = P[k]*w;
+      double const wk = omega*k;
+      c  += weight*term.real();
+      c1 -= weight*wk*term.imag();
+      c2 -= weight*wk*wk*term.real();
+      w *= step;
+    }
+    if(d1) *d1 = c1/n;
+    if(d2) *d2 = c2/n;
+    return c/n;
+  }
+
+} // local namespace
+
+
 util::LArFFTW::LArFFTW(int transformSize, const void* fplan, const void* rplan, int fitbins) 
+  : LArFFTW(transformSize, fplan, rplan, nullptr, nullptr, fitbins)
+{}
+
+util::LArFFTW::LArFFTW(int transformSize, const void* fplan, const void* rplan,
+                       const void* fplanf, const void* rplanf, int fitbins) 
   : fSize    (transformSize)
-  , fPlan    (fplan)
-  , rPlan    (rplan)
   , fFitBins (fitbins)
 {
 
   fFreqSize = fSize/2+1;  
 
-  // ... Real-Complex
-  fIn = fftw_malloc(sizeof(double)*fSize);
-  fOut= fftw_malloc(sizeof(fftw_complex)*fFreqSize);
-
-  // ... Complex-Real
-  rIn = fftw_malloc(sizeof(fftw_complex)*fFreqSize);
-  rOut= fftw_malloc(sizeof(double)*fSize);
+  // ... double precision buffers are always there; single precision ones
+  //     only if we have the plans to use them
+  fD.Allocate(fSize, fFreqSize, fplan, rplan);
+  if (fplanf && rplanf) {
+    fF.Allocate(fSize, fFreqSize, fplanf, rplanf);
+    fKernF.resize(fFreqSize);
+  }
 
   // ... allocate other data vectors  
   fCompTemp.resize(fFreqSize);  
@@ -25,19 +67,102 @@ util::LArFFTW::LArFFTW(int transformSize, const void* fplan, const void* rplan,
   fConvHist.resize(fFitBins);
 }
 
+util::LArFFTW::LArFFTW(LArFFTWPlan const& plan, int fitbins)
+  : LArFFTW(plan.TransformSize(), plan.fPlan, plan.rPlan, plan.fPlanF, plan.rPlanF, fitbins)
+{
+  if (plan.BatchSize() != 1) {
+    throw cet::exception("LArFFTW") << "Plan for batches of " << plan.BatchSize()
+      << " transforms can't be used for single transforms (use LArFFTWBatch)\n";
+  }
+}
+
+util::LArFFTW::LArFFTW(std::shared_ptr<LArFFTWPlan const> plan, int fitbins)
+  : LArFFTW(*plan, fitbins)
+{
+  fSharedPlan = std::move(plan);
+}
+
+util::LArFFTW::LArFFTW(int transformSize, const std::string& option, int fitbins)
+  : LArFFTW(LArFFTWPlan::Shared(transformSize, option), fitbins)
+{}
+
 util::LArFFTW::~LArFFTW()
 {
-  fPlan = 0;
-  fftw_free(fIn);
-  fIn = 0;
-  fftw_free((fftw_complex*)fOut);
-  fOut = 0;
-
-  rPlan = 0;
-  fftw_free((fftw_complex*)rIn);
-  rIn = 0;
-  fftw_free(rOut);
-  rOut = 0;
+  fD.Release();
+  fF.Release();
+}
+
+// -----------------------------------------------------------------------------
+void util::LArFFTW::SetWindow(DoubleVector const& window)
+{
+  if (!window.empty() && (int) window.size() != fSize) {
+    throw cet::exception("LArFFTW") << "Bad window size = " << window.size() << "\n";
+  }
+
+  fD.fWindow = window;
+  if (HasSinglePrecision()) fF.fWindow.assign(window.begin(), window.end());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Correlation evaluated at the integer lags of the window (and one more
+//      on each side, for the interpolation), then interpolated around the
+//      highest one
+// -----------------------------------------------------------------------------
+util::LArFFTW::CorrelationPeak util::LArFFTW::FindSpectrumPeak
+  (const ComplexVector& crossSpectrum, int transformSize, int minLag, int maxLag,
+   PeakInterpolation interp)
+{
+  if((int) crossSpectrum.size() != transformSize/2+1){
+    throw cet::exception("LArFFTW") << "Bad cross spectrum size = " << crossSpectrum.size() << "\n";
+  }
+  if(minLag > maxLag || maxLag - minLag >= transformSize){
+    throw cet::exception("LArFFTW") << "Bad lag window [ " << minLag << " ; " << maxLag
+      << " ] for transform size " << transformSize << "\n";
+  }
+
+  std::complex<double> const* P = crossSpectrum.data();
+  std::vector<double> corr(maxLag - minLag + 3);
+  for(int lag = minLag - 1; lag <= maxLag + 1; ++lag)
+    corr[lag - minLag + 1] = CorrelationAt(P, transformSize, lag);
+
+  auto const iMax = std::max_element(corr.begin() + 1, corr.end() - 1) - corr.begin();
+  CorrelationPeak peak;
+  peak.lag = minLag + iMax - 1;
+  peak.value = corr[iMax];
+  if(interp == kNoInterpolation) return peak;
+
+  // ..parabola through the highest lag and its neighbours
+  double const left = corr[iMax-1], right = corr[iMax+1];
+  double const curvature = left - 2.*peak.value + right;
+  double delta = 0.;
+  if(curvature < 0.) delta = 0.5*(left - right)/curvature;
+  delta = std::min(maxLag - peak.lag, std::max(minLag - peak.lag, delta));
+  if(interp == kParabolic){
+    peak.lag += delta;
+    peak.value -= 0.25*(left - right)*delta;
+    return peak;
+  }
+
+  // ..Newton iterations for the zero of the derivative of the band-limited
+  //   correlation, starting from the parabola and kept within one tick
+  //   (and within the window)
+  double const lower = std::max(peak.lag - 1., double(minLag));
+  double const upper = std::min(peak.lag + 1., double(maxLag));
+  double tau = peak.lag + delta;
+  for(int iter = 0; iter < 8; ++iter){
+    double d1, d2;
+    CorrelationAt(P, transformSize, tau, &d1, &d2);
+    if(!(d2 < 0.)) break;
+    double const step = d1/d2;
+    tau = std::min(upper, std::max(lower, tau - step));
+    if(std::abs(step) < 1e-6) break;
+  }
+  double const value = CorrelationAt(P, transformSize, tau);
+  if(value >= peak.value){
+    peak.lag = tau;
+    peak.value = value;
+  }
+  return peak;
 }
 
 // According to the Fourier transform identity
@@ -47,9 +172,7 @@ void util::LArFFTW::ShiftData(ComplexVector & input, double shift)
 { 
   double factor = -2.0*std::acos(-1)*shift/(double)fSize;  
 
-  for(int i = 0; i < fFreqSize; i++){
-    input[i] *= std::exp(std::complex<double>(0,factor*(double)i));  
-  }
+  fftwsimd::Rotate(reinterpret_cast<double*>(input.data()), fFreqSize, factor);
 
   return;
 }
@@ -6,15 +6,58 @@
 #include <vector>
 #include <complex>
 #include <algorithm>
+#include <memory>
+#include <type_traits>
 
 #include "fftw3.h"
 
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "cetlib_except/coded_exception.h"
 #include "lardata/Utilities/MarqFitAlg.h"
+#include "lardata/Utilities/LArFFTWTraits.h"
+#include "lardata/Utilities/LArFFTWSimd.h"
 
 namespace util {
 
+class LArFFTWPlan;
+
+// -----------------------------------------------------------------------------
+// The transforms are executed in double precision, unless single precision
+// (fftwf) plans are provided: in that case `std::vector<float>` inputs are
+// transformed in single precision, all other element types still in double.
+// Kernels can be supplied in either precision (`ComplexVector` or
+// `ComplexVectorF`) independently of the precision of the transform.
+//
+// The `*InPlace()` methods work directly on a caller buffer of `double`
+// (or `float`, with single precision plans): the forward transform reads
+// from it and the inverse transform writes into it, with kernel and
+// normalisation applied in a single pass over the spectrum. Buffers
+// allocated by FFTW (e.g. `AlignedVector`) avoid any copy; buffers with a
+// different alignment are staged through the internal arrays.
+//
+// Raw ADC counts (`ADCVector`, the same type as `raw::RawDigit::ADCvector_t`)
+// can be convoluted or deconvoluted directly: pedestal subtraction,
+// conversion, the optional window (`SetWindow()`) and the load into the
+// transform array happen in one vectorised pass, and the result is written
+// into the output vector. Waveforms shorter than the transform are padded
+// with zeroes.
+//
+// Instances of the same transform size can share one plan from the job-wide
+// registry (`LArFFTWPlan::Shared()`), owning only their buffers: the
+// constructors taking an option or a shared plan keep that plan alive.
+//
+// `FindCorrelationPeak()` finds the lag of the maximum of the correlation of
+// a shape with a reference, given as its transform (`DoFFT()` output) so
+// that it is transformed only once for many shapes. The correlation is
+// evaluated from the cross spectrum only at the lags of the requested window
+// (no inverse transform: the cost is proportional to the window width times
+// the transform size, and it is smaller than an inverse transform for
+// windows of up to a few tens of ticks), and the peak is interpolated with a
+// parabola through the three highest lags, or refined on the band-limited
+// (periodic sinc) interpolation of the correlation, which the cross spectrum
+// also gives exactly. A lag `l` means that `shape[t]` matches
+// `reference[t - l]`.
+// -----------------------------------------------------------------------------
 class LArFFTW {
 
   public:
@@ -22,140 +65,343 @@ class LArFFTW {
     using FloatVector = std::vector<float>;
     using DoubleVector = std::vector<double>;
     using ComplexVector = std::vector<std::complex<double>>;
+    using ComplexVectorF = std::vector<std::complex<float>>;
+    template <class Real> using AlignedVector = std::vector<Real, LArFFTWAllocator<Real>>;
+    using ADCVector = std::vector<short>;
+
+    enum PeakInterpolation { kNoInterpolation, kParabolic, kSinc };
+
+    struct CorrelationPeak {
+      double lag = 0.;		// lag of the maximum [ticks]
+      double value = 0.;	// correlation at that lag
+    };
 
     LArFFTW(int transformSize, const void* fplan, const void* rplan, int fitbins);
+    LArFFTW(int transformSize, const void* fplan, const void* rplan,
+            const void* fplanf, const void* rplanf, int fitbins);
+    LArFFTW(LArFFTWPlan const& plan, int fitbins);
+    LArFFTW(std::shared_ptr<LArFFTWPlan const> plan, int fitbins);
+    LArFFTW(int transformSize, const std::string& option, int fitbins);
     ~LArFFTW();
 
-    template <class T> void DoFFT(std::vector<T>& input);            
-    template <class T> void DoFFT(std::vector<T>& input, ComplexVector& output);            
-    template <class T> void DoInvFFT(std::vector<T>& output);            
-    template <class T> void DoInvFFT(ComplexVector& input, std::vector<T>& output);            
+    LArFFTW(LArFFTW const&) = delete;
+    LArFFTW& operator=(LArFFTW const&) = delete;
+
+    // ... whether std::vector<float> data is transformed in single precision
+    bool HasSinglePrecision() const { return fF.fPlan != nullptr; }
+
+    // ... window applied to raw ADC waveforms after pedestal subtraction
+    //     (transform size elements; empty to remove it)
+    void SetWindow(DoubleVector const& window);
+    bool HasWindow() const { return !fD.fWindow.empty(); }
+
+    template <class T> void DoFFT(std::vector<T>& input);
+    template <class T> void DoFFT(std::vector<T>& input, ComplexVector& output);
+    template <class T> void DoInvFFT(std::vector<T>& output);
+    template <class T> void DoInvFFT(ComplexVector& input, std::vector<T>& output);
 
     // ... Do convolution calculation (for simulation).
     template <class T> void Convolute(std::vector<T>& func, const ComplexVector& kern);
+    template <class T> void Convolute(std::vector<T>& func, const ComplexVectorF& kern);
     template <class T> void Convolute(std::vector<T>& func, std::vector<T>& resp);
+    template <class T> void Convolute(const ADCVector& adc, double pedestal,
+                                      const ComplexVector& kern, std::vector<T>& output);
+    template <class T> void Convolute(const ADCVector& adc, double pedestal,
+                                      const ComplexVectorF& kern, std::vector<T>& output);
 
     // ... Do deconvolution calculation (for reconstruction).
     template <class T> void Deconvolute(std::vector<T>& func, const ComplexVector& kern);
+    template <class T> void Deconvolute(std::vector<T>& func, const ComplexVectorF& kern);
     template <class T> void Deconvolute(std::vector<T>& func, std::vector<T>& resp);
+    template <class T> void Deconvolute(const ADCVector& adc, double pedestal,
+                                        const ComplexVector& kern, std::vector<T>& output);
+    template <class T> void Deconvolute(const ADCVector& adc, double pedestal,
+                                        const ComplexVectorF& kern, std::vector<T>& output);
 
     // ... Do correlation
     template <class T> void Correlate(std::vector<T>& func, const ComplexVector& kern);
+    template <class T> void Correlate(std::vector<T>& func, const ComplexVectorF& kern);
     template <class T> void Correlate(std::vector<T>& func, std::vector<T>& resp);
 
+    // ... In-place versions on caller buffers (Real is double or float).
+    template <class Real, class K> void ConvoluteInPlace(Real* data, std::size_t n, const K& kern);
+    template <class Real, class K> void ConvoluteInPlace(AlignedVector<Real>& func, const K& kern);
+    template <class Real, class K> void DeconvoluteInPlace(Real* data, std::size_t n, const K& kern);
+    template <class Real, class K> void DeconvoluteInPlace(AlignedVector<Real>& func, const K& kern);
+    template <class Real, class K> void CorrelateInPlace(Real* data, std::size_t n, const K& kern);
+    template <class Real, class K> void CorrelateInPlace(AlignedVector<Real>& func, const K& kern);
+
     void ShiftData(ComplexVector & input, double shift);
     template <class T> void ShiftData(std::vector<T> & input, double shift);
 
     template <class T> void AlignedSum(std::vector<T> & input, std::vector<T> &output,
                                        bool add = true);
-    template <class T> T PeakCorrelation(std::vector<T> &shape1,std::vector<T> &shape2);       
+    template <class T> T PeakCorrelation(std::vector<T> &shape1,std::vector<T> &shape2);
+
+    // ... Peak of the correlation with a transformed reference, within the
+    //     lags [ minLag, maxLag ]
+    template <class T>
+    CorrelationPeak FindCorrelationPeak(const std::vector<T>& shape, const ComplexVector& refKern,
+                                        int minLag, int maxLag,
+                                        PeakInterpolation interp = kParabolic);
+    template <class T>
+    std::vector<CorrelationPeak> FindCorrelationPeaks(const std::vector<std::vector<T>>& shapes,
+                                                      const ComplexVector& refKern,
+                                                      int minLag, int maxLag,
+                                                      PeakInterpolation interp = kParabolic);
+
+    // ... Same, from the cross spectrum S[k] conj(R[k]) of a transform of
+    //     the specified size (for transforms not made by LArFFTW)
+    static CorrelationPeak FindSpectrumPeak(const ComplexVector& crossSpectrum, int transformSize,
+                                            int minLag, int maxLag,
+                                            PeakInterpolation interp = kParabolic);
 
   private:
 
+    // ... FFTW buffers and plans of one precision
+    template <class Real> struct Workspace {
+      using Complex = typename LArFFTWTraits<Real>::complex_type;
+      Real *fIn = nullptr;
+      Complex *fOut = nullptr;
+      const void *fPlan = nullptr;
+      Complex *rIn = nullptr;
+      Real *rOut = nullptr;
+      const void *rPlan = nullptr;
+      std::vector<Real> fWindow;	// window for raw ADC input (optional)
+      lar::MemoryAccount<LArFFTWAllocationTag> fMemory;	// size of the buffers
+      void Allocate(int size, int freqSize, const void* fplan, const void* rplan);
+      void Release();
+    };
+
+    // ... kernel operations on a spectrum: out[i] = scale * op(in[i], k[i]);
+    //     the vectorised versions in LArFFTWSimd take over when the kernel
+    //     has the precision of the transform, the generic loop otherwise
+    template <class Derived> struct KernelOp {
+      template <class C, class K, class Real>
+      void operator() (const C* in, const K* k, C* out, int n, Real scale) const
+        {
+          for(int i = 0; i < n; ++i){
+            static_cast<Derived const&>(*this)(in[i], k[i], out[i]);
+            out[i][0] *= scale;
+            out[i][1] *= scale;
+          }
+        }
+    };
+    struct KernelMultiply: KernelOp<KernelMultiply> {
+      using KernelOp<KernelMultiply>::operator();
+      template <class C, class K> void operator() (const C& in, const K& k, C& out) const
+        {
+          auto const re = in[0], im = in[1];
+          out[0] = re*k.real()-im*k.imag();
+          out[1] = re*k.imag()+im*k.real();
+        }
+      template <class Real>
+      void operator() (const Real (*in)[2], const std::complex<Real>* k, Real (*out)[2], int n, Real scale) const
+        { fftwsimd::Multiply(in[0], reinterpret_cast<Real const*>(k), out[0], n, scale); }
+    };
+    struct KernelDivide: KernelOp<KernelDivide> {
+      using KernelOp<KernelDivide>::operator();
+      template <class C, class K> void operator() (const C& in, const K& k, C& out) const
+        {
+          auto const a = in[0], b = in[1], c = k.real(), d = k.imag();
+          auto const e = 1./(c*c+d*d);
+          out[0] = (a*c+b*d)*e;
+          out[1] = (b*c-a*d)*e;
+        }
+      template <class Real>
+      void operator() (const Real (*in)[2], const std::complex<Real>* k, Real (*out)[2], int n, Real scale) const
+        { fftwsimd::Divide(in[0], reinterpret_cast<Real const*>(k), out[0], n, scale); }
+    };
+    struct KernelCorrelate: KernelOp<KernelCorrelate> {
+      using KernelOp<KernelCorrelate>::operator();
+      template <class C, class K> void operator() (const C& in, const K& k, C& out) const
+        {
+          auto const re = in[0], im = in[1];
+          out[0] =  re*k.real()+im*k.imag();
+          out[1] = -re*k.imag()+im*k.real();
+        }
+      template <class Real>
+      void operator() (const Real (*in)[2], const std::complex<Real>* k, Real (*out)[2], int n, Real scale) const
+        { fftwsimd::MultiplyConj(in[0], reinterpret_cast<Real const*>(k), out[0], n, scale); }
+    };
+
     ComplexVector fKern;	// transformed response function
+    ComplexVectorF fKernF;	// transformed response function (single precision)
     ComplexVector fCompTemp;	// temporary complex data
     std::vector<float> fConvHist;	// Fit data histogram
     int fSize;			// size of transform
     int fFreqSize;		// size of frequency space
-    void *fIn;
-    void *fOut;
-    const void *fPlan;
-    void *rIn;
-    void *rOut;
-    const void *rPlan;
+    Workspace<double> fD;	// double precision buffers and plans
+    Workspace<float> fF;	// single precision buffers and plans (optional)
     int fFitBins;		// Bins used for peak fit
+    std::shared_ptr<LArFFTWPlan const> fSharedPlan;	// shared plan, if any
+
+    gshf::MarqFitAlg fMarqFitAlg;	// Gaussian fitter for peak correlation
+
+    // ... true if data of type T goes through the single precision plans
+    template <class T> bool UseSinglePrecision() const
+      { return std::is_same<T, float>::value && HasSinglePrecision(); }
+
+    // ... throws if the plans of the precision of ws were never made
+    template <class Real> void CheckPlans(Workspace<Real> const& ws) const;
+
+    template <class Real, class T> void Forward(Workspace<Real>& ws, std::vector<T> const& input);
+    template <class Real, class T> void Inverse(Workspace<Real>& ws, std::vector<T>& output);
+    template <class Real> void ForwardADC(Workspace<Real>& ws, const ADCVector& adc, double pedestal);
+
+    template <class Real, class T, class K, class Op>
+    void ApplyKernel(Workspace<Real>& ws, std::vector<T>& func, const K& kern, Op op);
+
+    template <class Real, class T, class Op>
+    void ApplyResponse(Workspace<Real>& ws, std::vector<T>& func, std::vector<T>& resp, Op op);
+
+    template <class Real, class K, class Op>
+    void ApplyKernelInPlace(Real* data, std::size_t n, const K& kern, Op op);
+
+    template <class T, class K, class Op>
+    void KernelTransform(std::vector<T>& func, const K& kern, Op op);
+
+    template <class Real, class T, class K, class Op>
+    void ApplyKernelADC(Workspace<Real>& ws, const ADCVector& adc, double pedestal,
+                        const K& kern, std::vector<T>& output, Op op);
+
+    template <class T, class K, class Op>
+    void ADCKernelTransform(const ADCVector& adc, double pedestal, const K& kern,
+                            std::vector<T>& output, Op op);
+
+    template <class T, class Op>
+    void ResponseTransform(std::vector<T>& func, std::vector<T>& resp, Op op);
+
+    Workspace<double>& WorkspaceFor(double) { return fD; }
+    Workspace<float>& WorkspaceFor(float) { return fF; }
+
+    ComplexVector& ComplexKernelStorage(double) { return fKern; }
+    ComplexVectorF& ComplexKernelStorage(float) { return fKernF; }
 
-    gshf::MarqFitAlg* fMarqFitAlg;
 };
 
 }  // end namespace util
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Forward Fourier Transform - DoFFT( REAL In )
+template <class Real>
+inline void util::LArFFTW::Workspace<Real>::Allocate
+  (int size, int freqSize, const void* fplan, const void* rplan)
+{
+  using Traits = LArFFTWTraits<Real>;
+
+  fPlan = fplan;
+  rPlan = rplan;
+
+  // ... Real-Complex
+  fIn = (Real*) Traits::Malloc(sizeof(Real)*size);
+  fOut= (Complex*) Traits::Malloc(sizeof(Complex)*freqSize);
+
+  // ... Complex-Real
+  rIn = (Complex*) Traits::Malloc(sizeof(Complex)*freqSize);
+  rOut= (Real*) Traits::Malloc(sizeof(Real)*size);
+
+  fMemory.set(2*(sizeof(Real)*size + sizeof(Complex)*freqSize));
+}
+
 // -----------------------------------------------------------------------------
-template <class T> inline void util::LArFFTW::DoFFT(std::vector<T> & input)
-{  
-  // ..set point
-  for(size_t p = 0; p < input.size(); ++p){
-    ((double *)fIn)[p] = input[p];
-  }
-  
-  // ..transform (using the New-array Execute Functions)
-  fftw_execute_dft_r2c((fftw_plan)fPlan,(double*)fIn,(fftw_complex*)fOut);
+template <class Real>
+inline void util::LArFFTW::Workspace<Real>::Release()
+{
+  using Traits = LArFFTWTraits<Real>;
+
+  fPlan = 0;
+  Traits::Free(fIn);
+  fIn = 0;
+  Traits::Free(fOut);
+  fOut = 0;
+
+  rPlan = 0;
+  Traits::Free(rIn);
+  rIn = 0;
+  Traits::Free(rOut);
+  rOut = 0;
+
+  fMemory.release();
+}
 
-  return;
+// -----------------------------------------------------------------------------
+// ~~~~ A plan made for one precision only leaves the other workspace planless
+// -----------------------------------------------------------------------------
+template <class Real>
+inline void util::LArFFTW::CheckPlans(Workspace<Real> const& ws) const
+{
+  if(!ws.fPlan || !ws.rPlan){
+    throw cet::exception("LArFFTW") << "No "
+      << (std::is_same<Real, float>::value? "single": "double")
+      << " precision plans (see LArFFTWPlan::Precision)\n";
+  }
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Forward Fourier Transform - DoFFT( REAL In, COMPLEX Out )
+// ~~~~ Forward transform of input into ws.fOut
 // -----------------------------------------------------------------------------
-template <class T> inline void util::LArFFTW::DoFFT(std::vector<T> & input, ComplexVector& output)
-{  
+template <class Real, class T>
+inline void util::LArFFTW::Forward(Workspace<Real>& ws, std::vector<T> const& input)
+{
+  CheckPlans(ws);
+
   // ..set point
   for(size_t p = 0; p < input.size(); ++p){
-    ((double *)fIn)[p] = input[p];
+    ws.fIn[p] = input[p];
   }
-  
-  // ..transform (using the New-array Execute Functions)
-  fftw_execute_dft_r2c((fftw_plan)fPlan,(double*)fIn,(fftw_complex*)fOut);
-
-  for(int i = 0; i < fFreqSize; ++i){    
-    output[i].real(((fftw_complex*)fOut)[i][0]);
-    output[i].imag(((fftw_complex*)fOut)[i][1]);
-  }  
 
-  return;
+  // ..transform (using the New-array Execute Functions)
+  LArFFTWTraits<Real>::ExecuteR2C(ws.fPlan, ws.fIn, ws.fOut);
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Inverse Fourier Transform - DoInvFFT( REAL Out )
+// ~~~~ Inverse transform of ws.rIn into output, normalised
 // -----------------------------------------------------------------------------
-template <class T> inline void util::LArFFTW::DoInvFFT(std::vector<T> & output)
-{  
+template <class Real, class T>
+inline void util::LArFFTW::Inverse(Workspace<Real>& ws, std::vector<T>& output)
+{
+  CheckPlans(ws);
+
   // ..transform (using the New-array Execute Functions)
-  fftw_execute_dft_c2r((fftw_plan)rPlan,(fftw_complex*)rIn,(double*)rOut);
+  LArFFTWTraits<Real>::ExecuteC2R(ws.rPlan, ws.rIn, ws.rOut);
 
   // ..get point real
-  double factor = 1.0/(double) fSize;  
-  const double * array =  (const double*)(rOut);
+  Real const factor = 1.0/(double) fSize;
+  const Real * array = ws.rOut;
   for(int i = 0; i < fSize; ++i){
     output[i] = factor*array[i];
   }
-
-  return;
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Inverse Fourier Transform - DoInvFFT( COMPLEX In, REAL Out )
+// ~~~~ Forward transform of pedestal subtracted (and windowed) ADC counts
 // -----------------------------------------------------------------------------
-template <class T> inline void util::LArFFTW::DoInvFFT(ComplexVector& input, std::vector<T> & output)
-{  
-  // ..set point complex
-  for(int i = 0; i < fFreqSize; ++i){
-    ((fftw_complex*)rIn)[i][0] = input[i].real();
-    ((fftw_complex*)rIn)[i][1] = input[i].imag();
+template <class Real>
+inline void util::LArFFTW::ForwardADC(Workspace<Real>& ws, const ADCVector& adc, double pedestal)
+{
+  CheckPlans(ws);
+
+  int const n = adc.size();
+  if(n > fSize){
+    throw cet::exception("LArFFTW") << "Bad ADC waveform size = " << n << "\n";
   }
 
-  // ..transform (using the New-array Execute Functions)
-  fftw_execute_dft_c2r((fftw_plan)rPlan,(fftw_complex*)rIn,(double*)rOut);
-
-  // ..get point real
-  double factor = 1.0/(double) fSize;  
-  const double * array =  (const double*)(rOut);
-  for(int i = 0; i < fSize; ++i){
-    output[i] = factor*array[i];
-  }
+  // ..set point, in a single pass
+  fftwsimd::LoadADC(adc.data(), ws.fIn, n, Real(pedestal),
+                    ws.fWindow.empty()? nullptr: ws.fWindow.data());
+  std::fill(ws.fIn + n, ws.fIn + fSize, Real(0));
 
-  return;
+  // ..transform (using the New-array Execute Functions)
+  LArFFTWTraits<Real>::ExecuteR2C(ws.fPlan, ws.fIn, ws.fOut);
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Convolution: using transformed response function
+// ~~~~ Transform func, apply the kernel op with kern, transform back
 // -----------------------------------------------------------------------------
-template <class T>
-inline void util::LArFFTW::Convolute(std::vector<T>& func,
-                                          const ComplexVector& kern){
-
+template <class Real, class T, class K, class Op>
+inline void util::LArFFTW::ApplyKernel(Workspace<Real>& ws, std::vector<T>& func,
+                                       const K& kern, Op op)
+{
   // ... Make sure that time series and kernel have the correct size.
   int n = func.size();
   if(n != fSize){
@@ -165,27 +411,42 @@ inline void util::LArFFTW::Convolute(std::vector<T>& func,
   if(n != fFreqSize){
     throw cet::exception("LArFFTW") << "Bad kernel size = " << n << "\n";
   }
-  
-  DoFFT(func);  
 
-  // ..perform the convolution
-  for(int i = 0; i < fFreqSize; ++i){    
-    double re = ((fftw_complex*)fOut)[i][0];
-    double im = ((fftw_complex*)fOut)[i][1];
-    ((fftw_complex*)rIn)[i][0] = re*kern[i].real()-im*kern[i].imag();
-    ((fftw_complex*)rIn)[i][1] = re*kern[i].imag()+im*kern[i].real();
-  }  
+  Forward(ws, func);
+
+  op(ws.fOut, kern.data(), ws.rIn, fFreqSize, Real(1));
 
-  DoInvFFT(func);  
+  Inverse(ws, func);
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Convolution: using all time-domain information
+// ~~~~ Same as ApplyKernel, from raw ADC counts into output
 // -----------------------------------------------------------------------------
-template <class T>
-inline void util::LArFFTW::Convolute(std::vector<T>& func1,
-                                          std::vector<T>& func2){
+template <class Real, class T, class K, class Op>
+inline void util::LArFFTW::ApplyKernelADC(Workspace<Real>& ws, const ADCVector& adc,
+                                          double pedestal, const K& kern,
+                                          std::vector<T>& output, Op op)
+{
+  int const n = kern.size();
+  if(n != fFreqSize){
+    throw cet::exception("LArFFTW") << "Bad kernel size = " << n << "\n";
+  }
 
+  ForwardADC(ws, adc, pedestal);
+
+  op(ws.fOut, kern.data(), ws.rIn, fFreqSize, Real(1));
+
+  output.resize(fSize);
+  Inverse(ws, output);
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Transform func and resp, apply the kernel op, transform back
+// -----------------------------------------------------------------------------
+template <class Real, class T, class Op>
+inline void util::LArFFTW::ApplyResponse(Workspace<Real>& ws, std::vector<T>& func1,
+                                         std::vector<T>& func2, Op op)
+{
   // ... Make sure that time series has the correct size.
   int n = func1.size();
   if(n != fSize){
@@ -196,33 +457,38 @@ inline void util::LArFFTW::Convolute(std::vector<T>& func1,
     throw cet::exception("LArFFTW") << "Bad 2nd time series size = " << n << "\n";
   }
 
-  DoFFT(func2);  
-  for(int i = 0; i < fFreqSize; ++i){    
-    fKern[i].real(((fftw_complex*)fOut)[i][0]);
-    fKern[i].imag(((fftw_complex*)fOut)[i][1]);
+  // ... kernel storage of the same precision as the transform
+  auto& kern = ComplexKernelStorage(Real{});
+
+  Forward(ws, func2);
+  for(int i = 0; i < fFreqSize; ++i){
+    kern[i].real(ws.fOut[i][0]);
+    kern[i].imag(ws.fOut[i][1]);
   }
-  DoFFT(func1);  
+  Forward(ws, func1);
 
-  // ..perform the convolution
-  for(int i = 0; i < fFreqSize; ++i){    
-    double re = ((fftw_complex*)fOut)[i][0];
-    double im = ((fftw_complex*)fOut)[i][1];
-    ((fftw_complex*)rIn)[i][0] = re*fKern[i].real()-im*fKern[i].imag();
-    ((fftw_complex*)rIn)[i][1] = re*fKern[i].imag()+im*fKern[i].real();
-  }  
+  op(ws.fOut, kern.data(), ws.rIn, fFreqSize, Real(1));
 
-  DoInvFFT(func1);  
+  Inverse(ws, func1);
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Deconvolution: using transformed response function
+// ~~~~ Same as ApplyKernel, but reading from and writing to the caller buffer
+//      and applying kernel and normalisation in the same pass
 // -----------------------------------------------------------------------------
-template <class T>
-inline void util::LArFFTW::Deconvolute(std::vector<T>& func,
-                                            const ComplexVector& kern){
+template <class Real, class K, class Op>
+inline void util::LArFFTW::ApplyKernelInPlace(Real* data, std::size_t size,
+                                              const K& kern, Op op)
+{
+  static_assert(std::is_same<Real, double>::value || std::is_same<Real, float>::value,
+    "in-place transforms need a double or float buffer");
+  using Traits = LArFFTWTraits<Real>;
+
+  Workspace<Real>& ws = WorkspaceFor(Real{});
+  CheckPlans(ws);
 
   // ... Make sure that time series and kernel have the correct size.
-  int n = func.size();
+  int n = size;
   if(n != fSize){
     throw cet::exception("LArFFTW") << "Bad time series size = " << n << "\n";
   }
@@ -231,92 +497,205 @@ inline void util::LArFFTW::Deconvolute(std::vector<T>& func,
     throw cet::exception("LArFFTW") << "Bad kernel size = " << n << "\n";
   }
 
-  DoFFT(func);  
+  // ..the New-array Execute Functions require the alignment of the plan arrays
+  bool const aligned = (Traits::AlignmentOf(data) == Traits::AlignmentOf(ws.fIn));
+
+  Real* in = data;
+  if(!aligned){
+    std::copy(data, data + fSize, ws.fIn);
+    in = ws.fIn;
+  }
+  Traits::ExecuteR2C(ws.fPlan, in, ws.fOut);
+
+  // ..kernel and normalisation in one pass, spectrum transformed in place
+  Real const factor = 1.0/(double) fSize;
+  op(ws.fOut, kern.data(), ws.fOut, fFreqSize, factor);
 
-  // ..perform the deconvolution
-  double a,b,c,d,e;
-  for(int i = 0; i < fFreqSize; ++i){    
-    a = ((fftw_complex*)fOut)[i][0];
-    b = ((fftw_complex*)fOut)[i][1];
-    c = kern[i].real();
-    d = kern[i].imag();
-    e = 1./(c*c+d*d);
-    ((fftw_complex*)rIn)[i][0] = (a*c+b*d)*e;
-    ((fftw_complex*)rIn)[i][1] = (b*c-a*d)*e;
-  }  
+  if(aligned){
+    Traits::ExecuteC2R(ws.rPlan, ws.fOut, data);
+  }
+  else{
+    Traits::ExecuteC2R(ws.rPlan, ws.fOut, ws.rOut);
+    std::copy(ws.rOut, ws.rOut + fSize, data);
+  }
+}
 
-  DoInvFFT(func);  
+// -----------------------------------------------------------------------------
+template <class T, class K, class Op>
+inline void util::LArFFTW::KernelTransform(std::vector<T>& func, const K& kern, Op op)
+{
+  if (UseSinglePrecision<T>()) ApplyKernel(fF, func, kern, op);
+  else                         ApplyKernel(fD, func, kern, op);
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Deconvolution: using all time domain information
+template <class T, class K, class Op>
+inline void util::LArFFTW::ADCKernelTransform(const ADCVector& adc, double pedestal,
+                                              const K& kern, std::vector<T>& output, Op op)
+{
+  if (UseSinglePrecision<T>()) ApplyKernelADC(fF, adc, pedestal, kern, output, op);
+  else                         ApplyKernelADC(fD, adc, pedestal, kern, output, op);
+}
+
 // -----------------------------------------------------------------------------
-template <class T>
-inline void util::LArFFTW::Deconvolute(std::vector<T>& func,
-                                            std::vector<T>& resp){
+template <class T, class Op>
+inline void util::LArFFTW::ResponseTransform(std::vector<T>& func, std::vector<T>& resp, Op op)
+{
+  if (UseSinglePrecision<T>()) ApplyResponse(fF, func, resp, op);
+  else                         ApplyResponse(fD, func, resp, op);
+}
 
-  // ... Make sure that time series has the correct size.
-  int n = func.size();
-  if(n != fSize){
-    throw cet::exception("LArFFTW") << "Bad 1st time series size = " << n << "\n";
-  }
-  n = resp.size();
-  if(n != fSize){
-    throw cet::exception("LArFFTW") << "Bad 2nd time series size = " << n << "\n";
-  }
+// -----------------------------------------------------------------------------
+// ~~~~ Do Forward Fourier Transform - DoFFT( REAL In )
+// -----------------------------------------------------------------------------
+template <class T> inline void util::LArFFTW::DoFFT(std::vector<T> & input)
+{
+  if (UseSinglePrecision<T>()) Forward(fF, input);
+  else                         Forward(fD, input);
 
-  DoFFT(resp);  
-  for(int i = 0; i < fFreqSize; ++i){    
-    fKern[i].real(((fftw_complex*)fOut)[i][0]);
-    fKern[i].imag(((fftw_complex*)fOut)[i][1]);
-  }
-  DoFFT(func);  
+  return;
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Forward Fourier Transform - DoFFT( REAL In, COMPLEX Out )
+// -----------------------------------------------------------------------------
+template <class T> inline void util::LArFFTW::DoFFT(std::vector<T> & input, ComplexVector& output)
+{
+  auto copyOut = [&output, this](auto const* out)
+    {
+      for(int i = 0; i < fFreqSize; ++i){
+        output[i].real(out[i][0]);
+        output[i].imag(out[i][1]);
+      }
+    };
+
+  if (UseSinglePrecision<T>()) { Forward(fF, input); copyOut(fF.fOut); }
+  else                         { Forward(fD, input); copyOut(fD.fOut); }
 
-  // ..perform the deconvolution
-  double a,b,c,d,e;
-  for(int i = 0; i < fFreqSize; ++i){    
-    a = ((fftw_complex*)fOut)[i][0];
-    b = ((fftw_complex*)fOut)[i][1];
-    c = fKern[i].real();
-    d = fKern[i].imag();
-    e = 1./(c*c+d*d);
-    ((fftw_complex*)rIn)[i][0] = (a*c+b*d)*e;
-    ((fftw_complex*)rIn)[i][1] = (b*c-a*d)*e;
-  }  
+  return;
+}
 
-  DoInvFFT(func);  
+// -----------------------------------------------------------------------------
+// ~~~~ Do Inverse Fourier Transform - DoInvFFT( REAL Out )
+// -----------------------------------------------------------------------------
+template <class T> inline void util::LArFFTW::DoInvFFT(std::vector<T> & output)
+{
+  if (UseSinglePrecision<T>()) Inverse(fF, output);
+  else                         Inverse(fD, output);
 
+  return;
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Do Deconvolution: using transformed response function
+// ~~~~ Do Inverse Fourier Transform - DoInvFFT( COMPLEX In, REAL Out )
+// -----------------------------------------------------------------------------
+template <class T> inline void util::LArFFTW::DoInvFFT(ComplexVector& input, std::vector<T> & output)
+{
+  auto copyIn = [&input, this](auto* in)
+    {
+      for(int i = 0; i < fFreqSize; ++i){
+        in[i][0] = input[i].real();
+        in[i][1] = input[i].imag();
+      }
+    };
+
+  if (UseSinglePrecision<T>()) { copyIn(fF.rIn); Inverse(fF, output); }
+  else                         { copyIn(fD.rIn); Inverse(fD, output); }
+
+  return;
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Convolution: using transformed response function
 // -----------------------------------------------------------------------------
 template <class T>
-inline void util::LArFFTW::Correlate(std::vector<T>& func,
+inline void util::LArFFTW::Convolute(std::vector<T>& func,
                                           const ComplexVector& kern){
+  KernelTransform(func, kern, KernelMultiply());
+}
 
-  // ... Make sure that time series and kernel have the correct size.
-  int n = func.size();
-  if(n != fSize){
-    throw cet::exception("LArFFTW") << "Bad time series size = " << n << "\n";
-  }
-  n = kern.size();
-  if(n != fFreqSize){
-    throw cet::exception("LArFFTW") << "Bad kernel size = " << n << "\n";
-  }
+template <class T>
+inline void util::LArFFTW::Convolute(std::vector<T>& func,
+                                          const ComplexVectorF& kern){
+  KernelTransform(func, kern, KernelMultiply());
+}
 
-  DoFFT(func);  
+// -----------------------------------------------------------------------------
+// ~~~~ Do Convolution: using all time-domain information
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTW::Convolute(std::vector<T>& func1,
+                                          std::vector<T>& func2){
+  ResponseTransform(func1, func2, KernelMultiply());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Convolution: from raw ADC counts
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTW::Convolute(const ADCVector& adc, double pedestal,
+                                     const ComplexVector& kern, std::vector<T>& output){
+  ADCKernelTransform(adc, pedestal, kern, output, KernelMultiply());
+}
 
-  // ..perform the correlation
-  for(int i = 0; i < fFreqSize; ++i){    
-    double re = ((fftw_complex*)fOut)[i][0];
-    double im = ((fftw_complex*)fOut)[i][1];
-    ((fftw_complex*)rIn)[i][0] =  re*kern[i].real()+im*kern[i].imag();
-    ((fftw_complex*)rIn)[i][1] = -re*kern[i].imag()+im*kern[i].real();
-  }  
+template <class T>
+inline void util::LArFFTW::Convolute(const ADCVector& adc, double pedestal,
+                                     const ComplexVectorF& kern, std::vector<T>& output){
+  ADCKernelTransform(adc, pedestal, kern, output, KernelMultiply());
+}
 
-  DoInvFFT(func);
+// -----------------------------------------------------------------------------
+// ~~~~ Do Deconvolution: using transformed response function
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTW::Deconvolute(std::vector<T>& func,
+                                            const ComplexVector& kern){
+  KernelTransform(func, kern, KernelDivide());
+}
 
+template <class T>
+inline void util::LArFFTW::Deconvolute(std::vector<T>& func,
+                                            const ComplexVectorF& kern){
+  KernelTransform(func, kern, KernelDivide());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Deconvolution: using all time domain information
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTW::Deconvolute(std::vector<T>& func,
+                                            std::vector<T>& resp){
+  ResponseTransform(func, resp, KernelDivide());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Deconvolution: from raw ADC counts
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTW::Deconvolute(const ADCVector& adc, double pedestal,
+                                       const ComplexVector& kern, std::vector<T>& output){
+  ADCKernelTransform(adc, pedestal, kern, output, KernelDivide());
+}
+
+template <class T>
+inline void util::LArFFTW::Deconvolute(const ADCVector& adc, double pedestal,
+                                       const ComplexVectorF& kern, std::vector<T>& output){
+  ADCKernelTransform(adc, pedestal, kern, output, KernelDivide());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Correlation: using transformed response function
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTW::Correlate(std::vector<T>& func,
+                                          const ComplexVector& kern){
+  KernelTransform(func, kern, KernelCorrelate());
+}
+
+template <class T>
+inline void util::LArFFTW::Correlate(std::vector<T>& func,
+                                          const ComplexVectorF& kern){
+  KernelTransform(func, kern, KernelCorrelate());
 }
 
 // -----------------------------------------------------------------------------
@@ -325,63 +704,63 @@ inline void util::LArFFTW::Correlate(std::vector<T>& func,
 template <class T>
 inline void util::LArFFTW::Correlate(std::vector<T>& func1,
                                           std::vector<T>& func2){
+  ResponseTransform(func1, func2, KernelCorrelate());
+}
 
-  // ... Make sure that time series has the correct size.
-  int n = func1.size();
-  if(n != fSize){
-    throw cet::exception("LArFFTW") << "Bad 1st time series size = " << n << "\n";
-  }
-  n = func2.size();
-  if(n != fSize){
-    throw cet::exception("LArFFTW") << "Bad 2nd time series size = " << n << "\n";
-  }
+// -----------------------------------------------------------------------------
+// ~~~~ In-place convolution, deconvolution and correlation on caller buffers
+// -----------------------------------------------------------------------------
+template <class Real, class K>
+inline void util::LArFFTW::ConvoluteInPlace(Real* data, std::size_t n, const K& kern)
+{ ApplyKernelInPlace(data, n, kern, KernelMultiply()); }
 
-  DoFFT(func2);  
-  for(int i = 0; i < fFreqSize; ++i){    
-    fKern[i].real(((fftw_complex*)fOut)[i][0]);
-    fKern[i].imag(((fftw_complex*)fOut)[i][1]);
-  }
-  DoFFT(func1);  
+template <class Real, class K>
+inline void util::LArFFTW::ConvoluteInPlace(AlignedVector<Real>& func, const K& kern)
+{ ApplyKernelInPlace(func.data(), func.size(), kern, KernelMultiply()); }
 
-  // ..perform the correlation
-  for(int i = 0; i < fFreqSize; ++i){    
-    double re = ((fftw_complex*)fOut)[i][0];
-    double im = ((fftw_complex*)fOut)[i][1];
-    ((fftw_complex*)rIn)[i][0] =  re*fKern[i].real()+im*fKern[i].imag();
-    ((fftw_complex*)rIn)[i][1] = -re*fKern[i].imag()+im*fKern[i].real();
-  }  
+template <class Real, class K>
+inline void util::LArFFTW::DeconvoluteInPlace(Real* data, std::size_t n, const K& kern)
+{ ApplyKernelInPlace(data, n, kern, KernelDivide()); }
 
-  DoInvFFT(func1);  
+template <class Real, class K>
+inline void util::LArFFTW::DeconvoluteInPlace(AlignedVector<Real>& func, const K& kern)
+{ ApplyKernelInPlace(func.data(), func.size(), kern, KernelDivide()); }
 
-}
+template <class Real, class K>
+inline void util::LArFFTW::CorrelateInPlace(Real* data, std::size_t n, const K& kern)
+{ ApplyKernelInPlace(data, n, kern, KernelCorrelate()); }
+
+template <class Real, class K>
+inline void util::LArFFTW::CorrelateInPlace(AlignedVector<Real>& func, const K& kern)
+{ ApplyKernelInPlace(func.data(), func.size(), kern, KernelCorrelate()); }
 
 // -----------------------------------------------------------------------------
 // ~~~~ Shifts real vectors using above ShiftData function
 // -----------------------------------------------------------------------------
 template <class T>
 inline void util::LArFFTW::ShiftData(std::vector<T> & input, double shift)
-{ 
+{
   DoFFT(input,fCompTemp);
   ShiftData(fCompTemp,shift);
-  DoInvFFT(fCompTemp,input); 
+  DoInvFFT(fCompTemp,input);
 
   return;
 }
 
 // -----------------------------------------------------------------------------
-// ~~~~ Scheme for adding two signals which have an arbitrary relative 
-//      translation.  Shape1 is translated over shape2 and is replaced with the 
+// ~~~~ Scheme for adding two signals which have an arbitrary relative
+//      translation.  Shape1 is translated over shape2 and is replaced with the
 //      sum, or the translated result if add = false
 // -----------------------------------------------------------------------------
 template <class T> inline void util::LArFFTW::AlignedSum(std::vector<T> & shape1,
-							std::vector<T> & shape2,     
+							std::vector<T> & shape2,
 							bool add)
-{  
-  double shift = PeakCorrelation(shape1,shape2);    
-  
-  ShiftData(shape1,shift);  
-   
-  if(add)for(int i = 0; i < fSize; i++) shape1[i]+=shape2[i];   
+{
+  double shift = PeakCorrelation(shape1,shape2);
+
+  ShiftData(shape1,shift);
+
+  if(add) fftwsimd::Add(shape1.data(), shape2.data(), fSize);
 
   return;
 }
@@ -390,43 +769,43 @@ template <class T> inline void util::LArFFTW::AlignedSum(std::vector<T> & shape1
 // ~~~~ Returns the length of the translation at which the correlation
 //      of 2 signals is maximal.
 // -----------------------------------------------------------------------------
-template <class T> inline T util::LArFFTW::PeakCorrelation(std::vector<T> & shape1,    
+template <class T> inline T util::LArFFTW::PeakCorrelation(std::vector<T> & shape1,
                                                                 std::vector<T> & shape2)
-{ 
+{
   float chiSqr = std::numeric_limits<float>::max();
   float dchiSqr = std::numeric_limits<float>::max();
   const float chiCut   = 1e-3;
   float lambda  = 0.001;	// Marquardt damping parameter
-  std::vector<float> p;
+  std::vector<float> p(3);
 
-  std::vector<T> holder = shape1;  
-  Correlate(holder,shape2);  
+  std::vector<T> holder = shape1;
+  Correlate(holder,shape2);
 
-  int	maxT   = max_element(holder.begin(), holder.end())-holder.begin();  
-  float startT = maxT-fFitBins/2;  
+  int	maxT   = max_element(holder.begin(), holder.end())-holder.begin();
+  float startT = maxT-fFitBins/2;
   int	offset = 0;
 
-  for(int i = 0; i < fFitBins; i++) { 
+  for(int i = 0; i < fFitBins; i++) {
     if(startT+i < 0) offset=fSize;
-    else if(startT+i > fSize) offset=-fSize;
-    else offset = 0;	 
+    else if(startT+i >= fSize) offset=-fSize;
+    else offset = 0;
     if(holder[i+startT+offset]<=0.) {
-      fConvHist[i]=0.;    
+      fConvHist[i]=0.;
     } else {
       fConvHist[i]=holder[i+startT+offset];
     }
-  }  
+  }
 
   p[0] = *max_element(fConvHist.begin(), fConvHist.end());
   p[1] = fFitBins/2;
   p[2] = fFitBins/2;
   float p1 = p[1];	// save initial p[1] guess
-  
+
   int fitResult{-1};
   int trial=0;
   lambda=-1.;		// initialize lambda on first call
   do{
-    fitResult=fMarqFitAlg->mrqdtfit(lambda, &p[0], &fConvHist[0], 3, fFitBins, chiSqr, dchiSqr);
+    fitResult=fMarqFitAlg.mrqdtfit(lambda, &p[0], &fConvHist[0], 3, fFitBins, chiSqr, dchiSqr);
     trial++;
     if(fitResult){
         mf::LogWarning("LArFFTW") << "Peak Correlation Fitting failed";
@@ -440,4 +819,46 @@ template <class T> inline T util::LArFFTW::PeakCorrelation(std::vector<T> & shap
 
   return p1 + 0.5 + startT;
 }
+
+// -----------------------------------------------------------------------------
+// ~~~~ Peak of the correlation within a lag window: one forward transform,
+//      the cross spectrum in fCompTemp, no inverse transform
+// -----------------------------------------------------------------------------
+template <class T>
+inline auto util::LArFFTW::FindCorrelationPeak(const std::vector<T>& shape,
+                                               const ComplexVector& refKern,
+                                               int minLag, int maxLag,
+                                               PeakInterpolation interp)
+  -> CorrelationPeak
+{
+  int n = shape.size();
+  if(n != fSize){
+    throw cet::exception("LArFFTW") << "Bad time series size = " << n << "\n";
+  }
+  n = refKern.size();
+  if(n != fFreqSize){
+    throw cet::exception("LArFFTW") << "Bad kernel size = " << n << "\n";
+  }
+
+  Forward(fD, shape);
+  fftwsimd::MultiplyConj(fD.fOut[0], reinterpret_cast<double const*>(refKern.data()),
+                         reinterpret_cast<double*>(fCompTemp.data()), fFreqSize);
+
+  return FindSpectrumPeak(fCompTemp, fSize, minLag, maxLag, interp);
+}
+
+// -----------------------------------------------------------------------------
+template <class T>
+inline auto util::LArFFTW::FindCorrelationPeaks(const std::vector<std::vector<T>>& shapes,
+                                                const ComplexVector& refKern,
+                                                int minLag, int maxLag,
+                                                PeakInterpolation interp)
+  -> std::vector<CorrelationPeak>
+{
+  std::vector<CorrelationPeak> peaks;
+  peaks.reserve(shapes.size());
+  for(auto const& shape: shapes)
+    peaks.push_back(FindCorrelationPeak(shape, refKern, minLag, maxLag, interp));
+  return peaks;
+}
 #endif
@@ -0,0 +1,55 @@
+#include "lardata/Utilities/LArFFTWBatch.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+util::LArFFTWBatch::LArFFTWBatch(int transformSize, int batchSize,
+                                 const void* fplan, const void* rplan)
+  : fSize    (transformSize)
+  , fBatch   (batchSize)
+  , fPlan    (fplan)
+  , rPlan    (rplan)
+{
+  if(fBatch < 1){
+    throw cet::exception("LArFFTWBatch") << "Bad batch size = " << fBatch << "\n";
+  }
+
+  fFreqSize = fSize/2+1;
+
+  // ... Real-Complex, all the waveforms of a batch back to back
+  fIn = fftw_malloc(sizeof(double)*fSize*fBatch);
+  fOut= fftw_malloc(sizeof(fftw_complex)*fFreqSize*fBatch);
+
+  // ... Complex-Real
+  rIn = fftw_malloc(sizeof(fftw_complex)*fFreqSize*fBatch);
+  rOut= fftw_malloc(sizeof(double)*fSize*fBatch);
+}
+
+util::LArFFTWBatch::LArFFTWBatch(LArFFTWPlan const& plan)
+  : LArFFTWBatch(plan.TransformSize(), plan.BatchSize(), plan.fPlan, plan.rPlan)
+{
+  if(!plan.HasDoublePrecision()){
+    throw cet::exception("LArFFTWBatch") << "No double precision plans (see LArFFTWPlan::Precision)\n";
+  }
+}
+
+util::LArFFTWBatch::~LArFFTWBatch()
+{
+  fPlan = 0;
+  fftw_free(fIn);
+  fIn = 0;
+  fftw_free((fftw_complex*)fOut);
+  fOut = 0;
+
+  rPlan = 0;
+  fftw_free((fftw_complex*)rIn);
+  rIn = 0;
+  fftw_free(rOut);
+  rOut = 0;
+}
+
+void util::LArFFTWBatch::CheckKernel(const ComplexVector& kern) const
+{
+  int const n = kern.size();
+  if(n != fFreqSize){
+    throw cet::exception("LArFFTWBatch") << "Bad kernel size = " << n << "\n";
+  }
+}
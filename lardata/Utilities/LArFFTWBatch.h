@@ -0,0 +1,283 @@
+#ifndef LARFFTWBATCH_H
+#define LARFFTWBATCH_H
+
+// C/C++ standard libraries
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "fftw3.h"
+
+#include "cetlib_except/exception.h"
+#include "lardata/Utilities/LArFFTWSimd.h"
+
+namespace util {
+
+class LArFFTWPlan;
+
+// -----------------------------------------------------------------------------
+// Batched version of LArFFTW: many waveforms of the same size are transformed
+// by a single execution of a `fftw_plan_many_dft_r2c`/`c2r` plan pair (see
+// `LArFFTWPlan` constructed with a batch size).
+//
+// Waveforms can be supplied as a contiguous block of `N*TransformSize()`
+// samples, as a collection of waveforms transformed in place, or as a
+// collection of read-only inputs (e.g. `raw::RawDigit` or `recob::Wire`,
+// through a projection returning the sample vector) with a separate output
+// collection. Collections longer than the batch size are processed in chunks;
+// the plan and the scratch buffers are reused across chunks.
+// -----------------------------------------------------------------------------
+class LArFFTWBatch {
+
+  public:
+
+    using ComplexVector = std::vector<std::complex<double>>;
+
+    LArFFTWBatch(int transformSize, int batchSize, const void* fplan, const void* rplan);
+    LArFFTWBatch(LArFFTWPlan const& plan);
+    ~LArFFTWBatch();
+
+    LArFFTWBatch(LArFFTWBatch const&) = delete;
+    LArFFTWBatch& operator=(LArFFTWBatch const&) = delete;
+
+    int TransformSize() const { return fSize; }
+    int BatchSize() const { return fBatch; }
+
+    // ... Do convolution calculation on a contiguous block of waveforms.
+    template <class T> void Convolute(T* block, std::size_t nWaveforms, const ComplexVector& kern);
+
+    // ... Do convolution calculation in place on a collection of waveforms.
+    template <class Coll> void Convolute(Coll& waveforms, const ComplexVector& kern);
+
+    // ... Do convolution calculation from read-only inputs.
+    template <class InColl, class OutColl, class Proj>
+    void Convolute(InColl const& inputs, OutColl& outputs, const ComplexVector& kern, Proj proj);
+
+    // ... Do deconvolution calculation on a contiguous block of waveforms.
+    template <class T> void Deconvolute(T* block, std::size_t nWaveforms, const ComplexVector& kern);
+
+    // ... Do deconvolution calculation in place on a collection of waveforms.
+    template <class Coll> void Deconvolute(Coll& waveforms, const ComplexVector& kern);
+
+    // ... Do deconvolution calculation from read-only inputs.
+    template <class InColl, class OutColl, class Proj>
+    void Deconvolute(InColl const& inputs, OutColl& outputs, const ComplexVector& kern, Proj proj);
+
+  private:
+
+    int fSize;			// size of transform
+    int fFreqSize;		// size of frequency space
+    int fBatch;			// number of transforms per plan execution
+    void *fIn;
+    void *fOut;
+    const void *fPlan;
+    void *rIn;
+    void *rOut;
+    const void *rPlan;
+
+    struct KernelMultiply {
+      void operator() (const fftw_complex* in, const std::complex<double>* k, fftw_complex* out, int n) const
+        { fftwsimd::Multiply(in[0], reinterpret_cast<double const*>(k), out[0], n); }
+    };
+
+    struct KernelDivide {
+      void operator() (const fftw_complex* in, const std::complex<double>* k, fftw_complex* out, int n) const
+        { fftwsimd::Divide(in[0], reinterpret_cast<double const*>(k), out[0], n); }
+    };
+
+    void CheckKernel(const ComplexVector& kern) const;
+    template <class Wave> void CheckWaveform(Wave const& wave) const;
+
+    // Runs nWaveforms transforms in chunks of fBatch:
+    // load(i, dest) fills waveform i, store(i, src, factor) writes it back.
+    template <class Load, class Store, class Op>
+    void Process(std::size_t nWaveforms, Load load, Store store,
+                 const ComplexVector& kern, Op op);
+
+    template <class InColl, class OutColl, class Proj, class Op>
+    void ProcessCollections(InColl const& inputs, OutColl& outputs,
+                            const ComplexVector& kern, Proj proj, Op op);
+};
+
+}  // end namespace util
+
+// -----------------------------------------------------------------------------
+template <class Wave>
+inline void util::LArFFTWBatch::CheckWaveform(Wave const& wave) const
+{
+  int const n = wave.size();
+  if(n != fSize){
+    throw cet::exception("LArFFTWBatch") << "Bad time series size = " << n << "\n";
+  }
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Core loop: forward transforms, kernel operation, inverse transforms
+//      of up to fBatch waveforms per plan execution
+// -----------------------------------------------------------------------------
+template <class Load, class Store, class Op>
+inline void util::LArFFTWBatch::Process(std::size_t nWaveforms, Load load, Store store,
+                                        const ComplexVector& kern, Op op)
+{
+  CheckKernel(kern);
+
+  double const factor = 1.0/(double) fSize;
+  double* const in = (double*)fIn;
+  fftw_complex* const out = (fftw_complex*)fOut;
+  fftw_complex* const rin = (fftw_complex*)rIn;
+  double const* const rout = (double const*)rOut;
+
+  for(std::size_t first = 0; first < nWaveforms; first += fBatch){
+    std::size_t const n = std::min<std::size_t>(fBatch, nWaveforms - first);
+
+    // ..set points; unused slots of the last chunk are transformed as zeros
+    for(std::size_t w = 0; w < n; ++w) load(first + w, in + w*fSize);
+    if(n < (std::size_t) fBatch)
+      std::fill(in + n*fSize, in + fBatch*fSize, 0.0);
+
+    fftw_execute_dft_r2c((fftw_plan)fPlan, in, out);
+
+    // ..apply the kernel to all spectra
+    for(std::size_t w = 0; w < (std::size_t) fBatch; ++w){
+      fftw_complex const* spec = out + w*fFreqSize;
+      fftw_complex* dest = rin + w*fFreqSize;
+      op(spec, kern.data(), dest, fFreqSize);
+    }
+
+    fftw_execute_dft_c2r((fftw_plan)rPlan, rin, (double*)rOut);
+
+    // ..get points real
+    for(std::size_t w = 0; w < n; ++w) store(first + w, rout + w*fSize, factor);
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <class InColl, class OutColl, class Proj, class Op>
+inline void util::LArFFTWBatch::ProcessCollections(InColl const& inputs, OutColl& outputs,
+                                                   const ComplexVector& kern, Proj proj, Op op)
+{
+  using std::size;
+  std::size_t const nWaveforms = size(inputs);
+  if(size(outputs) < nWaveforms){
+    throw cet::exception("LArFFTWBatch") << "Output collection too small: "
+      << size(outputs) << " for " << nWaveforms << " waveforms\n";
+  }
+
+  // ..the projection is called once per input: its result is kept by address
+  //   if it is a reference, by value otherwise (e.g. recob::Wire::Signal())
+  using Proj_t = decltype(proj(*std::begin(inputs)));
+  using Wave_t = std::remove_cv_t<std::remove_reference_t<Proj_t>>;
+  constexpr bool byAddress = std::is_lvalue_reference<Proj_t>::value;
+  std::vector<std::conditional_t<byAddress, Wave_t const*, Wave_t>> waves;
+  waves.reserve(nWaveforms);
+  for(auto const& input: inputs){
+    if constexpr (byAddress){
+      waves.push_back(&proj(input));
+      CheckWaveform(*waves.back());
+    }
+    else {
+      waves.push_back(proj(input));
+      CheckWaveform(waves.back());
+    }
+  }
+
+  auto out = std::begin(outputs);
+  auto load = [&waves, this](std::size_t iw, double* dest)
+    {
+      Wave_t const* wave = nullptr;
+      if constexpr (byAddress) wave = waves[iw];
+      else                     wave = &waves[iw];
+      for(int i = 0; i < fSize; ++i) dest[i] = (*wave)[i];
+    };
+  auto store = [&out, this](std::size_t, double const* src, double factor)
+    {
+      auto& wave = *out++;
+      wave.resize(fSize);
+      for(int i = 0; i < fSize; ++i) wave[i] = factor*src[i];
+    };
+  Process(nWaveforms, load, store, kern, op);
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Convolution: contiguous block of waveforms
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTWBatch::Convolute(T* block, std::size_t nWaveforms,
+                                          const ComplexVector& kern)
+{
+  auto load = [block, this](std::size_t iw, double* dest)
+    { std::copy(block + iw*fSize, block + (iw+1)*fSize, dest); };
+  auto store = [block, this](std::size_t iw, double const* src, double factor)
+    { T* wave = block + iw*fSize; for(int i = 0; i < fSize; ++i) wave[i] = factor*src[i]; };
+  Process(nWaveforms, load, store, kern, KernelMultiply());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Convolution: collection of waveforms, in place
+// -----------------------------------------------------------------------------
+template <class Coll>
+inline void util::LArFFTWBatch::Convolute(Coll& waveforms, const ComplexVector& kern)
+{
+  for(auto const& wave: waveforms) CheckWaveform(wave);
+  auto in = std::begin(waveforms);
+  auto out = std::begin(waveforms);
+  auto load = [&in, this](std::size_t, double* dest)
+    { auto const& wave = *in++; std::copy(std::begin(wave), std::begin(wave) + fSize, dest); };
+  auto store = [&out, this](std::size_t, double const* src, double factor)
+    { auto& wave = *out++; for(int i = 0; i < fSize; ++i) wave[i] = factor*src[i]; };
+  Process(std::distance(std::begin(waveforms), std::end(waveforms)), load, store, kern, KernelMultiply());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Convolution: read-only inputs, separate outputs
+// -----------------------------------------------------------------------------
+template <class InColl, class OutColl, class Proj>
+inline void util::LArFFTWBatch::Convolute(InColl const& inputs, OutColl& outputs,
+                                          const ComplexVector& kern, Proj proj)
+{
+  ProcessCollections(inputs, outputs, kern, proj, KernelMultiply());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Deconvolution: contiguous block of waveforms
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTWBatch::Deconvolute(T* block, std::size_t nWaveforms,
+                                            const ComplexVector& kern)
+{
+  auto load = [block, this](std::size_t iw, double* dest)
+    { std::copy(block + iw*fSize, block + (iw+1)*fSize, dest); };
+  auto store = [block, this](std::size_t iw, double const* src, double factor)
+    { T* wave = block + iw*fSize; for(int i = 0; i < fSize; ++i) wave[i] = factor*src[i]; };
+  Process(nWaveforms, load, store, kern, KernelDivide());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Deconvolution: collection of waveforms, in place
+// -----------------------------------------------------------------------------
+template <class Coll>
+inline void util::LArFFTWBatch::Deconvolute(Coll& waveforms, const ComplexVector& kern)
+{
+  for(auto const& wave: waveforms) CheckWaveform(wave);
+  auto in = std::begin(waveforms);
+  auto out = std::begin(waveforms);
+  auto load = [&in, this](std::size_t, double* dest)
+    { auto const& wave = *in++; std::copy(std::begin(wave), std::begin(wave) + fSize, dest); };
+  auto store = [&out, this](std::size_t, double const* src, double factor)
+    { auto& wave = *out++; for(int i = 0; i < fSize; ++i) wave[i] = factor*src[i]; };
+  Process(std::distance(std::begin(waveforms), std::end(waveforms)), load, store, kern, KernelDivide());
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ Do Deconvolution: read-only inputs, separate outputs
+// -----------------------------------------------------------------------------
+template <class InColl, class OutColl, class Proj>
+inline void util::LArFFTWBatch::Deconvolute(InColl const& inputs, OutColl& outputs,
+                                            const ComplexVector& kern, Proj proj)
+{
+  ProcessCollections(inputs, outputs, kern, proj, KernelDivide());
+}
+
+#endif
@@ -0,0 +1,242 @@
+#include "lardata/Utilities/LArFFTWGpu.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#ifdef LARDATA_CUFFT
+#include "lardata/Utilities/LArFFTWGpuKernels.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+#endif
+
+// -----------------------------------------------------------------------------
+// ~~~~ Device resources: a stream, the plans for the last number of waveforms,
+//      the device buffers, the pinned host buffer and the resident kernels
+// -----------------------------------------------------------------------------
+#ifdef LARDATA_CUFFT
+
+namespace {
+
+  struct DeviceError {
+    std::string what;
+  };
+
+  void check(cudaError_t status, char const* call)
+  {
+    if(status != cudaSuccess)
+      throw DeviceError{ std::string(call) + ": " + cudaGetErrorString(status) };
+  }
+
+  void check(cufftResult status, char const* call)
+  {
+    if(status != CUFFT_SUCCESS)
+      throw DeviceError{ std::string(call) + ": cuFFT error " + std::to_string(int(status)) };
+  }
+
+}
+
+struct util::LArFFTWGpu::Device {
+
+  struct Kernel {
+    void const* host;		// address of the host vector
+    std::size_t size;
+    cufftDoubleComplex* data;	// device copy
+  };
+
+  int size;
+  int freqSize;
+  cudaStream_t stream = nullptr;
+  cufftHandle fPlan = 0;
+  cufftHandle rPlan = 0;
+  std::size_t nPlanned = 0;	// waveforms of the current plans
+  double* real = nullptr;	// device, nPlanned*size
+  cufftDoubleComplex* spectra = nullptr; // device, nPlanned*freqSize
+  double* host = nullptr;	// pinned, nHost*size
+  std::size_t nHost = 0;
+  std::vector<Kernel> kernels;
+
+  explicit Device(int size)
+    : size(size), freqSize(size/2+1)
+    { check(cudaStreamCreate(&stream), "cudaStreamCreate"); }
+
+  ~Device()
+    {
+      ReleaseKernels();
+      ReleasePlans();
+      if(host) cudaFreeHost(host);
+      if(stream) cudaStreamDestroy(stream);
+    }
+
+  void ReleasePlans()
+    {
+      if(nPlanned == 0) return;
+      cufftDestroy(fPlan);
+      cufftDestroy(rPlan);
+      cudaFree(real);
+      cudaFree(spectra);
+      real = nullptr;
+      spectra = nullptr;
+      nPlanned = 0;
+    }
+
+  void ReleaseKernels()
+    {
+      for(Kernel const& kernel: kernels) cudaFree(kernel.data);
+      kernels.clear();
+    }
+
+  // ... plans and buffers for n waveforms transformed in one call
+  void Plan(std::size_t n)
+    {
+      if(n == nPlanned) return;
+      ReleasePlans();
+      int dims[] = { size };
+      check(cufftPlanMany(&fPlan, 1, dims, nullptr, 1, size, nullptr, 1, freqSize,
+                          CUFFT_D2Z, int(n)), "cufftPlanMany(D2Z)");
+      check(cufftPlanMany(&rPlan, 1, dims, nullptr, 1, freqSize, nullptr, 1, size,
+                          CUFFT_Z2D, int(n)), "cufftPlanMany(Z2D)");
+      nPlanned = n;
+      check(cufftSetStream(fPlan, stream), "cufftSetStream");
+      check(cufftSetStream(rPlan, stream), "cufftSetStream");
+      check(cudaMalloc(&real, sizeof(double)*n*size), "cudaMalloc");
+      check(cudaMalloc(&spectra, sizeof(cufftDoubleComplex)*n*freqSize), "cudaMalloc");
+    }
+
+  double* Host(std::size_t n)
+    {
+      if(n > nHost){
+        if(host) cudaFreeHost(host);
+        host = nullptr;
+        nHost = 0;
+        check(cudaMallocHost(&host, sizeof(double)*n*size), "cudaMallocHost");
+        nHost = n;
+      }
+      return host;
+    }
+
+  // ... device copy of the kernel, uploaded on first use
+  cufftDoubleComplex const* Resident(ComplexVector const& kern)
+    {
+      for(Kernel const& kernel: kernels)
+        if(kernel.host == kern.data() && kernel.size == kern.size()) return kernel.data;
+
+      Kernel kernel{ kern.data(), kern.size(), nullptr };
+      check(cudaMalloc(&kernel.data, sizeof(cufftDoubleComplex)*kern.size()), "cudaMalloc");
+      kernels.push_back(kernel);
+      check(cudaMemcpyAsync(kernel.data, kern.data(), sizeof(cufftDoubleComplex)*kern.size(),
+                            cudaMemcpyHostToDevice, stream), "cudaMemcpyAsync");
+      return kernel.data;
+    }
+
+  void Run(std::size_t n, ComplexVector const& kern, bool divide)
+    {
+      Plan(n);
+      cufftDoubleComplex const* kernel = Resident(kern);
+      std::size_t const bytes = sizeof(double)*n*size;
+      check(cudaMemcpyAsync(real, host, bytes, cudaMemcpyHostToDevice, stream), "cudaMemcpyAsync");
+      check(cufftExecD2Z(fPlan, real, spectra), "cufftExecD2Z");
+      details::LArFFTWGpuApplyKernel(spectra, kernel, freqSize, n, 1.0/size, divide, stream);
+      check(cudaGetLastError(), "kernel launch");
+      check(cufftExecZ2D(rPlan, spectra, real), "cufftExecZ2D");
+      check(cudaMemcpyAsync(host, real, bytes, cudaMemcpyDeviceToHost, stream), "cudaMemcpyAsync");
+      check(cudaStreamSynchronize(stream), "cudaStreamSynchronize");
+    }
+
+};
+
+#else // !LARDATA_CUFFT
+
+// ... never created: everything runs on the CPU
+struct util::LArFFTWGpu::Device {};
+
+#endif // LARDATA_CUFFT
+
+// -----------------------------------------------------------------------------
+util::LArFFTWGpu::LArFFTWGpu(LArFFTWPlan const& plan, bool useDevice)
+  : fSize(plan.TransformSize())
+  , fCPU (plan)
+{
+#ifdef LARDATA_CUFFT
+  if(useDevice && DeviceAvailable()){
+    try{
+      fDevice = std::make_unique<Device>(fSize);
+    }
+    catch(DeviceError const& e){
+      mf::LogWarning("LArFFTWGpu") << "GPU not usable (" << e.what
+        << "): transforms run on the CPU";
+    }
+  }
+#else
+  (void) useDevice;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+util::LArFFTWGpu::~LArFFTWGpu() = default;
+
+// -----------------------------------------------------------------------------
+bool util::LArFFTWGpu::DeviceAvailable()
+{
+#ifdef LARDATA_CUFFT
+  int nDevices = 0;
+  return (cudaGetDeviceCount(&nDevices) == cudaSuccess) && (nDevices > 0);
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void util::LArFFTWGpu::ReleaseKernels()
+{
+#ifdef LARDATA_CUFFT
+  if(fDevice) fDevice->ReleaseKernels();
+#endif
+}
+
+// -----------------------------------------------------------------------------
+double* util::LArFFTWGpu::HostBuffer(std::size_t nWaveforms)
+{
+#ifdef LARDATA_CUFFT
+  if(!fDevice) return nullptr;
+  try{
+    return fDevice->Host(nWaveforms);
+  }
+  catch(DeviceError const& e){
+    mf::LogWarning("LArFFTWGpu") << "Can't allocate the pinned buffer for "
+      << nWaveforms << " waveforms (" << e.what
+      << "): transforms will run on the CPU from now on";
+    fDevice.reset();
+    return nullptr;
+  }
+#else
+  (void) nWaveforms;
+  return nullptr;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+bool util::LArFFTWGpu::RunOnDevice(std::size_t nWaveforms, const ComplexVector& kern,
+                                   KernelOp op)
+{
+  if(kern.size() != std::size_t(fSize/2+1)){
+    throw cet::exception("LArFFTWGpu") << "Bad kernel size = " << kern.size() << "\n";
+  }
+#ifdef LARDATA_CUFFT
+  try{
+    fDevice->Run(nWaveforms, kern, op == kDivide);
+    return true;
+  }
+  catch(DeviceError const& e){
+    // ... the waveforms are still untouched: the CPU engine takes over
+    mf::LogWarning("LArFFTWGpu") << "GPU error (" << e.what
+      << "): transforms will run on the CPU from now on";
+    fDevice.reset();
+    return false;
+  }
+#else
+  (void) nWaveforms; (void) op;
+  return false;
+#endif
+}
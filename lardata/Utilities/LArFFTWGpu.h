@@ -0,0 +1,190 @@
+#ifndef LARFFTWGPU_H
+#define LARFFTWGPU_H
+
+// C/C++ standard libraries
+#include <vector>
+#include <complex>
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+
+#include "cetlib_except/exception.h"
+#include "lardata/Utilities/LArFFTWBatch.h"
+
+namespace util {
+
+class LArFFTWPlan;
+
+// -----------------------------------------------------------------------------
+// Batched convolution and deconvolution offloaded to a GPU, with fallback to
+// `LArFFTWBatch` on the CPU.
+//
+// All the waveforms passed to one call (typically all the channels of an
+// event) are copied into a pinned host buffer, transferred to the device and
+// transformed there by a single cuFFT `D2Z`/`Z2D` plan pair, with the kernel
+// operation applied on the device between the two transforms.
+//
+// The kernels are uploaded to the device the first time they are used and stay
+// resident there, identified by the address and size of the host vector: this
+// suits the kernels of a locked `SignalShaping`, which don't change for all
+// the job. A kernel vector which is modified or destroyed after use must be
+// released with `ReleaseKernels()`.
+//
+// The GPU is used only if lardata is built with cuFFT (`LARDATA_CUFFT`), a
+// device is present and `useDevice` is set; otherwise, or after any device
+// error (reported once in the message facility), all the work is done by the
+// CPU engine built from the same `LArFFTWPlan`. The results are the same up to
+// rounding.
+// -----------------------------------------------------------------------------
+class LArFFTWGpu {
+
+  public:
+
+    using ComplexVector = LArFFTWBatch::ComplexVector;
+
+    LArFFTWGpu(LArFFTWPlan const& plan, bool useDevice = true);
+    ~LArFFTWGpu();
+
+    LArFFTWGpu(LArFFTWGpu const&) = delete;
+    LArFFTWGpu& operator=(LArFFTWGpu const&) = delete;
+
+    int TransformSize() const { return fSize; }
+
+    // ... whether the transforms are currently run on the GPU
+    bool OnDevice() const { return fDevice != nullptr; }
+
+    // ... whether this build supports GPUs and one is present
+    static bool DeviceAvailable();
+
+    // ... frees the device copies of all the kernels
+    void ReleaseKernels();
+
+    // ... Do convolution calculation on a contiguous block of waveforms.
+    template <class T> void Convolute(T* block, std::size_t nWaveforms, const ComplexVector& kern);
+
+    // ... Do convolution calculation in place on a collection of waveforms.
+    template <class Coll> void Convolute(Coll& waveforms, const ComplexVector& kern);
+
+    // ... Do deconvolution calculation on a contiguous block of waveforms.
+    template <class T> void Deconvolute(T* block, std::size_t nWaveforms, const ComplexVector& kern);
+
+    // ... Do deconvolution calculation in place on a collection of waveforms.
+    template <class Coll> void Deconvolute(Coll& waveforms, const ComplexVector& kern);
+
+  private:
+
+    enum KernelOp { kMultiply, kDivide };
+
+    struct Device;		// cuFFT plans and device buffers
+
+    int fSize;			// size of transform
+    LArFFTWBatch fCPU;		// fallback engine
+    std::unique_ptr<Device> fDevice; // null when running on the CPU
+
+    // ... pinned host buffer for nWaveforms waveforms; null if the device
+    //     is not used (anymore)
+    double* HostBuffer(std::size_t nWaveforms);
+
+    // ... transforms the waveforms in the host buffer on the device;
+    //     returns false (and switches to the CPU) on failure
+    bool RunOnDevice(std::size_t nWaveforms, const ComplexVector& kern, KernelOp op);
+
+    template <class Coll> void CheckWaveforms(Coll const& waveforms) const;
+
+    template <class T>
+    void ProcessBlock(T* block, std::size_t nWaveforms, const ComplexVector& kern, KernelOp op);
+
+    template <class Coll>
+    void ProcessCollection(Coll& waveforms, const ComplexVector& kern, KernelOp op);
+};
+
+}  // end namespace util
+
+// -----------------------------------------------------------------------------
+template <class Coll>
+inline void util::LArFFTWGpu::CheckWaveforms(Coll const& waveforms) const
+{
+  for(auto const& wave: waveforms){
+    int const n = wave.size();
+    if(n != fSize){
+      throw cet::exception("LArFFTWGpu") << "Bad time series size = " << n << "\n";
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ The device works on the pinned buffer: waveforms are copied in, and the
+//      results (already normalized) copied back
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTWGpu::ProcessBlock(T* block, std::size_t nWaveforms,
+                                           const ComplexVector& kern, KernelOp op)
+{
+  double* const host = (fDevice && nWaveforms > 0)? HostBuffer(nWaveforms): nullptr;
+  if(host){
+    std::size_t const nSamples = nWaveforms*fSize;
+    std::copy(block, block + nSamples, host);
+    if(RunOnDevice(nWaveforms, kern, op)){
+      std::copy(host, host + nSamples, block);
+      return;
+    }
+  }
+  if(op == kMultiply) fCPU.Convolute(block, nWaveforms, kern);
+  else                fCPU.Deconvolute(block, nWaveforms, kern);
+}
+
+// -----------------------------------------------------------------------------
+template <class Coll>
+inline void util::LArFFTWGpu::ProcessCollection(Coll& waveforms,
+                                                const ComplexVector& kern, KernelOp op)
+{
+  CheckWaveforms(waveforms);
+  std::size_t const nWaveforms = std::distance(std::begin(waveforms), std::end(waveforms));
+  double* const host = (fDevice && nWaveforms > 0)? HostBuffer(nWaveforms): nullptr;
+  if(host){
+    double* dest = host;
+    for(auto const& wave: waveforms)
+      dest = std::copy(std::begin(wave), std::begin(wave) + fSize, dest);
+    if(RunOnDevice(nWaveforms, kern, op)){
+      double const* result = host;
+      for(auto& wave: waveforms){
+        std::copy(result, result + fSize, std::begin(wave));
+        result += fSize;
+      }
+      return;
+    }
+  }
+  if(op == kMultiply) fCPU.Convolute(waveforms, kern);
+  else                fCPU.Deconvolute(waveforms, kern);
+}
+
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTWGpu::Convolute(T* block, std::size_t nWaveforms,
+                                        const ComplexVector& kern)
+{
+  ProcessBlock(block, nWaveforms, kern, kMultiply);
+}
+
+template <class Coll>
+inline void util::LArFFTWGpu::Convolute(Coll& waveforms, const ComplexVector& kern)
+{
+  ProcessCollection(waveforms, kern, kMultiply);
+}
+
+// -----------------------------------------------------------------------------
+template <class T>
+inline void util::LArFFTWGpu::Deconvolute(T* block, std::size_t nWaveforms,
+                                          const ComplexVector& kern)
+{
+  ProcessBlock(block, nWaveforms, kern, kDivide);
+}
+
+template <class Coll>
+inline void util::LArFFTWGpu::Deconvolute(Coll& waveforms, const ComplexVector& kern)
+{
+  ProcessCollection(waveforms, kern, kDivide);
+}
+
+#endif
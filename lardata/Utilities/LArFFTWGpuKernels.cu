@@ -0,0 +1,39 @@
+#include "lardata/Utilities/LArFFTWGpuKernels.h"
+
+namespace {
+
+// ... one thread per frequency of each spectrum
+__global__ void ApplyKernel(cufftDoubleComplex* spectra, cufftDoubleComplex const* kernel,
+                            int freqSize, std::size_t nValues, double scale, bool divide)
+{
+  std::size_t const i = std::size_t(blockIdx.x)*blockDim.x + threadIdx.x;
+  if(i >= nValues) return;
+
+  cufftDoubleComplex const k = kernel[i % freqSize];
+  cufftDoubleComplex const in = spectra[i];
+  cufftDoubleComplex out;
+  if(divide){
+    double const e = scale/(k.x*k.x + k.y*k.y);
+    out.x = (in.x*k.x + in.y*k.y)*e;
+    out.y = (in.y*k.x - in.x*k.y)*e;
+  }
+  else{
+    out.x = (in.x*k.x - in.y*k.y)*scale;
+    out.y = (in.x*k.y + in.y*k.x)*scale;
+  }
+  spectra[i] = out;
+}
+
+}
+
+void util::details::LArFFTWGpuApplyKernel(cufftDoubleComplex* spectra,
+                                          cufftDoubleComplex const* kernel,
+                                          int freqSize, std::size_t nWaveforms,
+                                          double scale, bool divide, cudaStream_t stream)
+{
+  std::size_t const nValues = nWaveforms*freqSize;
+  if(nValues == 0) return;
+  unsigned int const threads = 256;
+  unsigned int const blocks = (nValues + threads - 1)/threads;
+  ApplyKernel<<<blocks, threads, 0, stream>>>(spectra, kernel, freqSize, nValues, scale, divide);
+}
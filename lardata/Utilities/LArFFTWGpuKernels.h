@@ -0,0 +1,24 @@
+#ifndef LARFFTWGPUKERNELS_H
+#define LARFFTWGPUKERNELS_H
+
+// Device code of LArFFTWGpu (LArFFTWGpuKernels.cu), built only with cuFFT.
+
+#include <cstddef>
+
+#include <cuda_runtime.h>
+#include <cufft.h>
+
+namespace util {
+namespace details {
+
+// ... spectra[w*freqSize + i] = scale * spectra[w*freqSize + i] op kernel[i]
+//     for all the nWaveforms spectra, with op a multiplication or a division
+//     (as fftwsimd::Multiply() and fftwsimd::Divide())
+void LArFFTWGpuApplyKernel(cufftDoubleComplex* spectra, cufftDoubleComplex const* kernel,
+                           int freqSize, std::size_t nWaveforms, double scale, bool divide,
+                           cudaStream_t stream);
+
+}  // end namespace details
+}  // end namespace util
+
+#endif
@@ -1,11 +1,77 @@
 #include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/LArFFTWTraits.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using std::string;
 std::mutex util::LArFFTWPlan::mutex_;
 
-util::LArFFTWPlan::LArFFTWPlan(int transformSize, const std::string &option) 
-  : fSize    (transformSize)
-  , fOption  (option){
+namespace {
+
+  // ... current FFTW wisdom, as a string
+  template <class Real>
+  string ExportedWisdom() {
+    char* wisdom = util::LArFFTWTraits<Real>::ExportWisdomToString();
+    if (!wisdom) return {};
+    string const result { wisdom };
+    std::free(wisdom);
+    return result;
+  }
+
+  // ... writes the wisdom to a temporary file in the same directory and
+  //     renames it over the target, so that jobs sharing the wisdom never
+  //     import a partially written file; the caller holds the planning lock
+  template <class Real>
+  bool ExportWisdomAtomically(const string &file) {
+    static unsigned int nExports = 0;
+    string const tmpFile = file + ".tmp." + std::to_string(::getpid())
+      + "." + std::to_string(nExports++);
+    if (util::LArFFTWTraits<Real>::ExportWisdom(tmpFile.c_str())
+      && (std::rename(tmpFile.c_str(), file.c_str()) == 0))
+      return true;
+    std::remove(tmpFile.c_str());
+    return false;
+  }
+
+  // ... FFTW keeps separate wisdom for single precision
+  template <class Real>
+  string PrecisionWisdomFile(const string &file)
+    { return std::is_same<Real, float>::value? file + ".float": file; }
+
+  // ... job-wide registry of the shared plans; the key is transform size,
+  //     planning flags, batch size, wisdom path and precision
+  struct SharedPlans {
+    using Key_t = std::tuple<int, unsigned int, int, string, int>;
+
+    std::mutex mutex;
+    std::map<Key_t, std::shared_ptr<util::LArFFTWPlan const>> plans;
+
+    static SharedPlans& Instance()
+    {
+      static SharedPlans registry;
+      return registry;
+    }
+  };
+
+} // local namespace
+
+util::LArFFTWPlan::LArFFTWPlan(int transformSize, const std::string &option,
+                               int batchSize, const std::string &wisdomPath,
+                               Precision precision) 
+  : fPlan    (nullptr), rPlan (nullptr)
+  , fIn      (nullptr), fOut  (nullptr), rIn  (nullptr), rOut  (nullptr)
+  , fPlanF   (nullptr), rPlanF(nullptr)
+  , fInF     (nullptr), fOutF (nullptr), rInF (nullptr), rOutF (nullptr)
+  , fSize    (transformSize)
+  , fBatch   (std::max(batchSize, 1))
+  , fOption  (option)
+  , fWisdomFile(ResolveWisdomFile(wisdomPath)){
 
   std::lock_guard<std::mutex> lock(mutex_);
 
@@ -13,45 +79,159 @@ util::LArFFTWPlan::LArFFTWPlan(int transformSize, const std::string &option)
   fN = new int[1];
   fN[0] = fSize;
 
-  fIn = fftw_malloc(sizeof(double)*fSize);
-  fOut= fftw_malloc(sizeof(fftw_complex)*fFreqSize);
-  fPlan = (void*)fftw_plan_dft_r2c(1, fN, (double*)fIn, (fftw_complex*)fOut, MapFFTWOption());
-
-  rIn = fftw_malloc(sizeof(fftw_complex)*fFreqSize);
-  rOut= fftw_malloc(sizeof(double)*fSize);
-  rPlan = (void*)fftw_plan_dft_c2r(1, fN, (fftw_complex*)rIn, (double*)rOut, MapFFTWOption());
+  if (precision & kDouble)
+    MakePlans<double>(fPlan, rPlan, fIn, fOut, rIn, rOut);
+  if (precision & kSingle)
+    MakePlans<float>(fPlanF, rPlanF, fInF, fOutF, rInF, rOutF);
 }
 
 util::LArFFTWPlan::~LArFFTWPlan()
 {
-  fftw_destroy_plan((fftw_plan)fPlan);
-  fPlan = 0;
-  fftw_free(fIn);
-  fIn = 0;
-  fftw_free((fftw_complex*)fOut);
-  fOut = 0;
-
-  fftw_destroy_plan((fftw_plan)rPlan);
-  rPlan = 0;
-  fftw_free((fftw_complex*)rIn);
-  rIn = 0;
-  fftw_free(rOut);
-  rOut = 0;
+  DestroyPlans<double>(fPlan, rPlan, fIn, fOut, rIn, rOut);
+  DestroyPlans<float>(fPlanF, rPlanF, fInF, fOutF, rInF, rOutF);
 
   delete [] fN;
   fN = 0;
 }
 
-unsigned int util::LArFFTWPlan::MapFFTWOption()
+std::shared_ptr<util::LArFFTWPlan const> util::LArFFTWPlan::Shared
+  (int transformSize, const std::string &option, int batchSize,
+   const std::string &wisdomPath, Precision precision)
 {
-  std::transform(fOption.begin(), fOption.end(),fOption.begin(), ::toupper);
-  if (fOption.find("ES")!=string::npos)
+  SharedPlans& registry = SharedPlans::Instance();
+  SharedPlans::Key_t const key { transformSize, FFTWFlags(option),
+    std::max(batchSize, 1), wisdomPath, precision };
+
+  // ... planning happens under the registry lock, so that concurrent
+  //     requests of the same plan make it only once
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& plan = registry.plans[key];
+  if (!plan) {
+    plan = std::make_shared<LArFFTWPlan const>
+      (transformSize, option, batchSize, wisdomPath, precision);
+  }
+  return plan;
+}
+
+std::size_t util::LArFFTWPlan::NShared()
+{
+  SharedPlans& registry = SharedPlans::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.plans.size();
+}
+
+void util::LArFFTWPlan::ClearShared()
+{
+  SharedPlans& registry = SharedPlans::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.plans.clear();
+}
+
+template <class Real>
+void util::LArFFTWPlan::MakePlans(void*& fplan, void*& rplan,
+                                  void*& fin, void*& fout, void*& rin, void*& rout)
+{
+  using Traits = LArFFTWTraits<Real>;
+  using Complex = typename Traits::complex_type;
+
+  // ... wisdom is global FFTW state: import it under the planning lock
+  //     (held by the caller); a missing file just means planning from scratch
+  string const wisdomFile = PrecisionWisdomFile<Real>(fWisdomFile);
+  string wisdomBefore;
+  if (!fWisdomFile.empty()) {
+    Traits::ImportWisdom(wisdomFile.c_str());
+    wisdomBefore = ExportedWisdom<Real>();
+  }
+
+  fin = Traits::Malloc(sizeof(Real)*fSize*fBatch);
+  fout= Traits::Malloc(sizeof(Complex)*fFreqSize*fBatch);
+  rin = Traits::Malloc(sizeof(Complex)*fFreqSize*fBatch);
+  rout= Traits::Malloc(sizeof(Real)*fSize*fBatch);
+
+  // ... waveforms are stored back to back: unit stride, one transform
+  //     (or one frequency spectrum) apart; a batch of one is a plain plan
+  fplan = (void*)Traits::PlanR2C(1, fN, fBatch, (Real*)fin, fSize,
+                                 (Complex*)fout, fFreqSize, MapFFTWOption());
+  rplan = (void*)Traits::PlanC2R(1, fN, fBatch, (Complex*)rin, fFreqSize,
+                                 (Real*)rout, fSize, MapFFTWOption());
+
+  // ... write back only if planning learnt something new; shared read-only
+  //     areas (e.g. CVMFS) simply fail to be written
+  if (!fWisdomFile.empty() && ExportedWisdom<Real>() != wisdomBefore)
+    ExportWisdomAtomically<Real>(wisdomFile);
+}
+
+template <class Real>
+void util::LArFFTWPlan::DestroyPlans(void*& fplan, void*& rplan,
+                                     void*& fin, void*& fout, void*& rin, void*& rout)
+{
+  using Traits = LArFFTWTraits<Real>;
+
+  if (fplan) Traits::DestroyPlan(fplan);
+  fplan = 0;
+  Traits::Free(fin);
+  fin = 0;
+  Traits::Free(fout);
+  fout = 0;
+
+  if (rplan) Traits::DestroyPlan(rplan);
+  rplan = 0;
+  Traits::Free(rin);
+  rin = 0;
+  Traits::Free(rout);
+  rout = 0;
+}
+
+unsigned int util::LArFFTWPlan::MapFFTWOption() const
+{
+  return FFTWFlags(fOption);
+}
+
+unsigned int util::LArFFTWPlan::FFTWFlags(std::string option)
+{
+  std::transform(option.begin(), option.end(),option.begin(), ::toupper);
+  if (option.find("ES")!=string::npos)
      return FFTW_ESTIMATE;
-  if (fOption.find("M")!=string::npos)
+  if (option.find("M")!=string::npos)
      return FFTW_MEASURE;
-  if (fOption.find("P")!=string::npos)
+  if (option.find("P")!=string::npos)
      return FFTW_PATIENT;
-  if (fOption.find("EX")!=string::npos)
+  if (option.find("EX")!=string::npos)
      return FFTW_EXHAUSTIVE;
   return FFTW_ESTIMATE;
 }
+
+string util::LArFFTWPlan::ResolveWisdomFile(const std::string &path) const
+{
+  if (path.empty()) return {};
+  struct stat info;
+  bool const isDir = (path.back() == '/')
+    || ((stat(path.c_str(), &info) == 0) && S_ISDIR(info.st_mode));
+  return isDir? WisdomFileName(path, fSize, fBatch): path;
+}
+
+string util::LArFFTWPlan::WisdomFileName(const std::string &dir, int transformSize, int batchSize)
+{
+  string name = dir;
+  if (!name.empty() && name.back() != '/') name += '/';
+  name += "larfftw_n" + std::to_string(transformSize);
+  if (batchSize > 1) name += "_b" + std::to_string(batchSize);
+  name += "_" + CPUFlagsTag() + ".wisdom";
+  return name;
+}
+
+string util::LArFFTWPlan::CPUFlagsTag()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return "avx512";
+  if (__builtin_cpu_supports("avx2")) return "avx2";
+  if (__builtin_cpu_supports("avx")) return "avx";
+  if (__builtin_cpu_supports("sse2")) return "sse2";
+  return "x86";
+#elif defined(__aarch64__)
+  return "aarch64";
+#else
+  return "generic";
+#endif
+}
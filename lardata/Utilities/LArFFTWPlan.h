@@ -4,7 +4,9 @@
 // C/C++ standard libraries
 #include <string>
 #include <algorithm>
+#include <memory>
 #include <mutex>
+#include <cstddef>
 
 #include "fftw3.h"
 
@@ -13,23 +15,95 @@ namespace util {
 class LArFFTWPlan {
 
   public:
-    LArFFTWPlan(int transformSize, const std::string &option);
+    /// Floating point precision of the plans to be made.
+    enum Precision { kDouble = 1, kSingle = 2, kDoubleAndSingle = kDouble|kSingle };
+
+    /// A batch size larger than 1 makes `fftw_plan_many_dft_*` plans
+    /// transforming `batchSize` contiguous waveforms per execution.
+    ///
+    /// If `wisdomPath` is not empty, FFTW wisdom is imported from it before
+    /// planning, and exported back to it if planning produced new wisdom
+    /// (a failure to write, e.g. on a read-only area, is not an error).
+    /// A path ending with `/` or naming an existing directory selects a file
+    /// in that directory keyed by transform size, batch size and CPU flags
+    /// (see `WisdomFileName()`); any other path is used as the file itself.
+    ///
+    /// Double precision plans (`fPlan`, `rPlan`) are made by default;
+    /// single precision ones (`fPlanF`, `rPlanF`) are made on request, and
+    /// are null otherwise.
+    LArFFTWPlan(int transformSize, const std::string &option, int batchSize = 1,
+                const std::string &wisdomPath = "", Precision precision = kDouble);
     ~LArFFTWPlan();
+
+    LArFFTWPlan(LArFFTWPlan const&) = delete;
+    LArFFTWPlan& operator=(LArFFTWPlan const&) = delete;
+
+    /// Plan from the job-wide registry: the first request for a transform
+    /// size, planning flags (from `option`), batch size, wisdom path and
+    /// precision makes the plan, further requests share it. The plans can be
+    /// executed concurrently by separate `LArFFTW` instances, each owning
+    /// only its buffers. The registry is thread-safe and keeps the plans
+    /// until `ClearShared()` (the ones already handed out stay valid).
+    static std::shared_ptr<LArFFTWPlan const> Shared
+      (int transformSize, const std::string &option, int batchSize = 1,
+       const std::string &wisdomPath = "", Precision precision = kDouble);
+
+    /// Number of plans in the registry.
+    static std::size_t NShared();
+
+    /// Removes all the plans from the registry.
+    static void ClearShared();
+
     void *fPlan;
     void *rPlan;
     void *fIn;
     void *fOut;
     void *rIn;
     void *rOut;
+
+    // ... single precision (fftwf) plans and buffers
+    void *fPlanF;
+    void *rPlanF;
+    void *fInF;
+    void *fOutF;
+    void *rInF;
+    void *rOutF;
+
+    int TransformSize() const { return fSize; }
+    int BatchSize() const { return fBatch; }
+    bool HasDoublePrecision() const { return fPlan != nullptr; }
+    bool HasSinglePrecision() const { return fPlanF != nullptr; }
+    const std::string& WisdomFile() const { return fWisdomFile; }
+
+    /// Name of the wisdom file for the specified transform in a directory.
+    static std::string WisdomFileName(const std::string &dir, int transformSize, int batchSize = 1);
+
+    /// Tag of the SIMD extensions of this CPU used in wisdom file names.
+    static std::string CPUFlagsTag();
     
   private:
     static std::mutex mutex_;
     int fSize;		// size of transform
     int fFreqSize;	// size of frequency space
+    int fBatch;		// number of transforms per plan execution
     int *fN;
     std::string fOption;	// FFTW setting
+    std::string fWisdomFile;	// FFTW wisdom file (empty if none)
+
+    unsigned int MapFFTWOption() const;
+
+    /// FFTW planning flags for the specified option.
+    static unsigned int FFTWFlags(std::string option);
+
+    template <class Real>
+    void MakePlans(void*& fplan, void*& rplan,
+                   void*& fin, void*& fout, void*& rin, void*& rout);
+
+    template <class Real>
+    static void DestroyPlans(void*& fplan, void*& rplan,
+                             void*& fin, void*& fout, void*& rin, void*& rout);
 
-    unsigned int MapFFTWOption();
+    std::string ResolveWisdomFile(const std::string &path) const;
 
 };
 
@@ -0,0 +1,312 @@
+#include "lardata/Utilities/LArFFTWSimd.h"
+
+// C/C++ standard libraries
+#include <atomic>
+#include <complex>
+
+// The vectorised versions are compiled for their instruction set with
+// target pragmas, so that the rest of the library keeps the default flags;
+// other compilers and architectures get the plain C++ version only.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define LARFFTW_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+  using util::fftwsimd::Level;
+
+  // ---------------------------------------------------------------------------
+  // ~~~~ Plain C++ versions, also used for the elements left over by the
+  //      vectorised loops
+  // ---------------------------------------------------------------------------
+  template <class Real> struct Scalar {
+
+    static void Multiply(Real const* in, Real const* k, Real* out, std::size_t n, Real s)
+      {
+        for (std::size_t i = 0; i < 2*n; i += 2) {
+          Real const a = in[i], b = in[i+1], c = k[i], d = k[i+1];
+          out[i]   = s*(a*c-b*d);
+          out[i+1] = s*(a*d+b*c);
+        }
+      }
+
+    static void MultiplyConj(Real const* in, Real const* k, Real* out, std::size_t n, Real s)
+      {
+        for (std::size_t i = 0; i < 2*n; i += 2) {
+          Real const a = in[i], b = in[i+1], c = k[i], d = k[i+1];
+          out[i]   = s*(a*c+b*d);
+          out[i+1] = s*(b*c-a*d);
+        }
+      }
+
+    static void Divide(Real const* in, Real const* k, Real* out, std::size_t n, Real s)
+      {
+        for (std::size_t i = 0; i < 2*n; i += 2) {
+          Real const a = in[i], b = in[i+1], c = k[i], d = k[i+1];
+          Real const e = s/(c*c+d*d);
+          out[i]   = (a*c+b*d)*e;
+          out[i+1] = (b*c-a*d)*e;
+        }
+      }
+
+    static void Add(Real* out, Real const* in, std::size_t n)
+      { for (std::size_t i = 0; i < n; ++i) out[i] += in[i]; }
+
+    static void LoadADC(short const* adc, Real* out, std::size_t n, Real pedestal,
+                        Real const* window)
+      {
+        if (window) {
+          for (std::size_t i = 0; i < n; ++i) out[i] = (adc[i] - pedestal)*window[i];
+        }
+        else {
+          for (std::size_t i = 0; i < n; ++i) out[i] = adc[i] - pedestal;
+        }
+      }
+
+  };
+
+} // local namespace
+
+
+#ifdef LARFFTW_SIMD_X86
+
+// -----------------------------------------------------------------------------
+// ~~~~ AVX2 (with FMA): 2 double or 4 float complex numbers per register
+// -----------------------------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+namespace {
+namespace avx2 {
+
+  struct D {
+    using Real = double;
+    using V = __m256d;
+    static constexpr std::size_t N = 2;
+    static V Set(Real x) { return _mm256_set1_pd(x); }
+    static V Load(Real const* p) { return _mm256_loadu_pd(p); }
+    static V LoadShort(short const* p)
+      { return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i const*) p))); }
+    static void Store(Real* p, V v) { _mm256_storeu_pd(p, v); }
+    static V Add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V Sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V Mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V Div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V Re(V k) { return _mm256_movedup_pd(k); }
+    static V Im(V k) { return _mm256_permute_pd(k, 0xF); }
+    static V Swap(V a) { return _mm256_permute_pd(a, 0x5); }
+    static V FMAddSub(V a, V b, V c) { return _mm256_fmaddsub_pd(a, b, c); }
+    static V FMSubAdd(V a, V b, V c) { return _mm256_fmsubadd_pd(a, b, c); }
+  };
+
+  struct F {
+    using Real = float;
+    using V = __m256;
+    static constexpr std::size_t N = 4;
+    static V Set(Real x) { return _mm256_set1_ps(x); }
+    static V Load(Real const* p) { return _mm256_loadu_ps(p); }
+    static V LoadShort(short const* p)
+      { return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i const*) p))); }
+    static void Store(Real* p, V v) { _mm256_storeu_ps(p, v); }
+    static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V Re(V k) { return _mm256_moveldup_ps(k); }
+    static V Im(V k) { return _mm256_movehdup_ps(k); }
+    static V Swap(V a) { return _mm256_permute_ps(a, 0xB1); }
+    static V FMAddSub(V a, V b, V c) { return _mm256_fmaddsub_ps(a, b, c); }
+    static V FMSubAdd(V a, V b, V c) { return _mm256_fmsubadd_ps(a, b, c); }
+  };
+
+#include "lardata/Utilities/LArFFTWSimdLoops.tcc"
+
+} // namespace avx2
+} // local namespace
+
+#pragma GCC pop_options
+
+// -----------------------------------------------------------------------------
+// ~~~~ AVX-512: 4 double or 8 float complex numbers per register
+// -----------------------------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// ... the AVX-512 intrinsics start from undefined registers, which GCC
+//     reports as uninitialised once inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+namespace {
+namespace avx512 {
+
+  struct D {
+    using Real = double;
+    using V = __m512d;
+    static constexpr std::size_t N = 4;
+    static V Set(Real x) { return _mm512_set1_pd(x); }
+    static V Load(Real const* p) { return _mm512_loadu_pd(p); }
+    static V LoadShort(short const* p)
+      { return _mm512_cvtepi32_pd(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i const*) p))); }
+    static void Store(Real* p, V v) { _mm512_storeu_pd(p, v); }
+    static V Add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V Sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V Mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V Div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V Re(V k) { return _mm512_movedup_pd(k); }
+    static V Im(V k) { return _mm512_permute_pd(k, 0xFF); }
+    static V Swap(V a) { return _mm512_permute_pd(a, 0x55); }
+    static V FMAddSub(V a, V b, V c) { return _mm512_fmaddsub_pd(a, b, c); }
+    static V FMSubAdd(V a, V b, V c) { return _mm512_fmsubadd_pd(a, b, c); }
+  };
+
+  struct F {
+    using Real = float;
+    using V = __m512;
+    static constexpr std::size_t N = 8;
+    static V Set(Real x) { return _mm512_set1_ps(x); }
+    static V Load(Real const* p) { return _mm512_loadu_ps(p); }
+    static V LoadShort(short const* p)
+      { return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i const*) p))); }
+    static void Store(Real* p, V v) { _mm512_storeu_ps(p, v); }
+    static V Add(V a, V b) { return _mm512_add_ps(a, b); }
+    static V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+    static V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+    static V Div(V a, V b) { return _mm512_div_ps(a, b); }
+    static V Re(V k) { return _mm512_moveldup_ps(k); }
+    static V Im(V k) { return _mm512_movehdup_ps(k); }
+    static V Swap(V a) { return _mm512_permute_ps(a, 0xB1); }
+    static V FMAddSub(V a, V b, V c) { return _mm512_fmaddsub_ps(a, b, c); }
+    static V FMSubAdd(V a, V b, V c) { return _mm512_fmsubadd_ps(a, b, c); }
+  };
+
+#include "lardata/Utilities/LArFFTWSimdLoops.tcc"
+
+} // namespace avx512
+} // local namespace
+
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+
+#endif // LARFFTW_SIMD_X86
+
+
+namespace {
+
+  Level Detect()
+  {
+#ifdef LARFFTW_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return util::fftwsimd::kAVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return util::fftwsimd::kAVX2;
+#endif
+    return util::fftwsimd::kScalar;
+  }
+
+  std::atomic<int>& Active()
+  {
+    static std::atomic<int> level{ util::fftwsimd::DetectedLevel() };
+    return level;
+  }
+
+  // ... calls the version of an operation for the active level
+#ifdef LARFFTW_SIMD_X86
+#define LARFFTW_SIMD_DISPATCH(OP, VEC, REAL, ...)                          \
+  switch (Active().load(std::memory_order_relaxed)) {                     \
+    case util::fftwsimd::kAVX512: avx512::OP<avx512::VEC>(__VA_ARGS__); return; \
+    case util::fftwsimd::kAVX2:   avx2::OP<avx2::VEC>(__VA_ARGS__); return; \
+    default:                      Scalar<REAL>::OP(__VA_ARGS__); return;  \
+  }
+#else
+#define LARFFTW_SIMD_DISPATCH(OP, VEC, REAL, ...)                          \
+  Scalar<REAL>::OP(__VA_ARGS__);
+#endif
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+util::fftwsimd::Level util::fftwsimd::DetectedLevel()
+{
+  static Level const level = Detect();
+  return level;
+}
+
+util::fftwsimd::Level util::fftwsimd::ActiveLevel()
+{
+  return static_cast<Level>(Active().load());
+}
+
+util::fftwsimd::Level util::fftwsimd::SetLevel(Level level)
+{
+  if (level > DetectedLevel()) level = DetectedLevel();
+  if (level < kScalar) level = kScalar;
+  Active().store(level);
+  return level;
+}
+
+const char* util::fftwsimd::LevelName(Level level)
+{
+  switch (level) {
+    case kAVX512: return "AVX-512";
+    case kAVX2:   return "AVX2";
+    default:      return "scalar";
+  }
+}
+
+// -----------------------------------------------------------------------------
+void util::fftwsimd::Multiply(double const* in, double const* k, double* out, std::size_t n, double scale)
+{ LARFFTW_SIMD_DISPATCH(Multiply, D, double, in, k, out, n, scale) }
+
+void util::fftwsimd::Multiply(float const* in, float const* k, float* out, std::size_t n, float scale)
+{ LARFFTW_SIMD_DISPATCH(Multiply, F, float, in, k, out, n, scale) }
+
+void util::fftwsimd::MultiplyConj(double const* in, double const* k, double* out, std::size_t n, double scale)
+{ LARFFTW_SIMD_DISPATCH(MultiplyConj, D, double, in, k, out, n, scale) }
+
+void util::fftwsimd::MultiplyConj(float const* in, float const* k, float* out, std::size_t n, float scale)
+{ LARFFTW_SIMD_DISPATCH(MultiplyConj, F, float, in, k, out, n, scale) }
+
+void util::fftwsimd::Divide(double const* in, double const* k, double* out, std::size_t n, double scale)
+{ LARFFTW_SIMD_DISPATCH(Divide, D, double, in, k, out, n, scale) }
+
+void util::fftwsimd::Divide(float const* in, float const* k, float* out, std::size_t n, float scale)
+{ LARFFTW_SIMD_DISPATCH(Divide, F, float, in, k, out, n, scale) }
+
+void util::fftwsimd::Add(double* out, double const* in, std::size_t n)
+{ LARFFTW_SIMD_DISPATCH(Add, D, double, out, in, n) }
+
+void util::fftwsimd::Add(float* out, float const* in, std::size_t n)
+{ LARFFTW_SIMD_DISPATCH(Add, F, float, out, in, n) }
+
+void util::fftwsimd::LoadADC(short const* adc, double* out, std::size_t n, double pedestal,
+                             double const* window)
+{ LARFFTW_SIMD_DISPATCH(LoadADC, D, double, adc, out, n, pedestal, window) }
+
+void util::fftwsimd::LoadADC(short const* adc, float* out, std::size_t n, float pedestal,
+                             float const* window)
+{ LARFFTW_SIMD_DISPATCH(LoadADC, F, float, adc, out, n, pedestal, window) }
+
+// -----------------------------------------------------------------------------
+// ~~~~ The phase factors are computed in blocks, exactly at the start of each
+//      block and by recurrence within it (much cheaper than std::exp for each
+//      element, with rounding errors bounded by the block length), then applied
+//      with the vectorised multiplication.
+// -----------------------------------------------------------------------------
+void util::fftwsimd::Rotate(double* data, std::size_t n, double phase)
+{
+  constexpr std::size_t kBlock = 64;
+  std::complex<double> factors[kBlock];
+  std::complex<double> const step = std::polar(1., phase);
+
+  for (std::size_t i0 = 0; i0 < n; i0 += kBlock) {
+    std::size_t const m = (n - i0 < kBlock)? n - i0: kBlock;
+    std::complex<double> w = std::polar(1., phase*(double)i0);
+    for (std::size_t i = 0; i < m; ++i) {
+      factors[i] = w;
+      w *= step;
+    }
+    Multiply(data + 2*i0, reinterpret_cast<double const*>(factors), data + 2*i0, m);
+  }
+}
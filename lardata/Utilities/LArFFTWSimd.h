@@ -0,0 +1,66 @@
+#ifndef LARFFTWSIMD_H
+#define LARFFTWSIMD_H
+
+// C/C++ standard libraries
+#include <cstddef>
+
+namespace util {
+
+// -----------------------------------------------------------------------------
+// Vectorised inner loops of LArFFTW, on spectra stored as interleaved
+// (real, imaginary) pairs: fftw_complex, fftwf_complex and std::complex arrays
+// all have this layout. Sizes are numbers of complex elements.
+//
+// The implementation (AVX-512, AVX2 or plain C++) is chosen at run time on
+// the first call, according to what the CPU supports; all of them give the
+// same results up to rounding. Input and output arrays may coincide.
+// -----------------------------------------------------------------------------
+namespace fftwsimd {
+
+  enum Level { kScalar = 0, kAVX2, kAVX512 };
+
+  /// Best implementation supported by this CPU (and by this build).
+  Level DetectedLevel();
+
+  /// Implementation in use.
+  Level ActiveLevel();
+
+  /// Selects the implementation (capped to DetectedLevel()); returns the
+  /// selected one. Meant for tests and benchmarks, not to be changed while
+  /// transforms are running in other threads.
+  Level SetLevel(Level level);
+
+  const char* LevelName(Level level);
+
+  /// out[i] = scale * in[i] * k[i]
+  void Multiply(double const* in, double const* k, double* out, std::size_t n, double scale = 1.);
+  void Multiply(float const* in, float const* k, float* out, std::size_t n, float scale = 1.f);
+
+  /// out[i] = scale * in[i] * conj(k[i])
+  void MultiplyConj(double const* in, double const* k, double* out, std::size_t n, double scale = 1.);
+  void MultiplyConj(float const* in, float const* k, float* out, std::size_t n, float scale = 1.f);
+
+  /// out[i] = scale * in[i] / k[i]
+  void Divide(double const* in, double const* k, double* out, std::size_t n, double scale = 1.);
+  void Divide(float const* in, float const* k, float* out, std::size_t n, float scale = 1.f);
+
+  /// data[i] *= exp(i * phase * i)
+  void Rotate(double* data, std::size_t n, double phase);
+
+  /// out[i] += in[i] (real arrays; n is the number of elements)
+  void Add(double* out, double const* in, std::size_t n);
+  void Add(float* out, float const* in, std::size_t n);
+  template <class T> void Add(T* out, T const* in, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] += in[i]; }
+
+  /// out[i] = (adc[i] - pedestal) * window[i], or without the window if it
+  /// is null (real arrays; n is the number of elements)
+  void LoadADC(short const* adc, double* out, std::size_t n, double pedestal,
+               double const* window = nullptr);
+  void LoadADC(short const* adc, float* out, std::size_t n, float pedestal,
+               float const* window = nullptr);
+
+} // end namespace fftwsimd
+} // end namespace util
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file   lardata/Utilities/LArFFTWSimdLoops.tcc
+ * @brief  Vectorised loops of `LArFFTWSimd.cxx`, for one instruction set.
+ *
+ * This file is included by `LArFFTWSimd.cxx` once for each instruction set,
+ * inside a namespace defining the register wrappers `D` (double) and `F`
+ * (float) and under the matching target options; it is not a header and has
+ * no include guard on purpose.
+ */
+
+  // ... (a + ib) (c + id): real parts of k duplicated times a, plus/minus
+  //     imaginary parts of k duplicated times a with real/imaginary swapped
+  template <class W>
+  inline typename W::V ComplexMul(typename W::V a, typename W::V k)
+    { return W::FMAddSub(a, W::Re(k), W::Mul(W::Swap(a), W::Im(k))); }
+
+  // ... (a + ib) (c - id)
+  template <class W>
+  inline typename W::V ComplexMulConj(typename W::V a, typename W::V k)
+    { return W::FMSubAdd(a, W::Re(k), W::Mul(W::Swap(a), W::Im(k))); }
+
+  // ... |k|^2 in both the real and imaginary slot
+  template <class W>
+  inline typename W::V Norm2(typename W::V k)
+    { typename W::V const k2 = W::Mul(k, k); return W::Add(k2, W::Swap(k2)); }
+
+  template <class W>
+  void Multiply(typename W::Real const* in, typename W::Real const* k,
+                typename W::Real* out, std::size_t n, typename W::Real s)
+  {
+    typename W::V const vs = W::Set(s);
+    std::size_t i = 0;
+    for (; i + W::N <= n; i += W::N) {
+      W::Store(out + 2*i, W::Mul(vs, ComplexMul<W>(W::Load(in + 2*i), W::Load(k + 2*i))));
+    }
+    Scalar<typename W::Real>::Multiply(in + 2*i, k + 2*i, out + 2*i, n - i, s);
+  }
+
+  template <class W>
+  void MultiplyConj(typename W::Real const* in, typename W::Real const* k,
+                    typename W::Real* out, std::size_t n, typename W::Real s)
+  {
+    typename W::V const vs = W::Set(s);
+    std::size_t i = 0;
+    for (; i + W::N <= n; i += W::N) {
+      W::Store(out + 2*i, W::Mul(vs, ComplexMulConj<W>(W::Load(in + 2*i), W::Load(k + 2*i))));
+    }
+    Scalar<typename W::Real>::MultiplyConj(in + 2*i, k + 2*i, out + 2*i, n - i, s);
+  }
+
+  template <class W>
+  void Divide(typename W::Real const* in, typename W::Real const* k,
+              typename W::Real* out, std::size_t n, typename W::Real s)
+  {
+    typename W::V const vs = W::Set(s);
+    std::size_t i = 0;
+    for (; i + W::N <= n; i += W::N) {
+      typename W::V const vk = W::Load(k + 2*i);
+      typename W::V const e = W::Div(vs, Norm2<W>(vk));
+      W::Store(out + 2*i, W::Mul(e, ComplexMulConj<W>(W::Load(in + 2*i), vk)));
+    }
+    Scalar<typename W::Real>::Divide(in + 2*i, k + 2*i, out + 2*i, n - i, s);
+  }
+
+  // ... real arrays: 2 N elements per register
+  template <class W>
+  void Add(typename W::Real* out, typename W::Real const* in, std::size_t n)
+  {
+    std::size_t i = 0;
+    for (; i + 2*W::N <= n; i += 2*W::N) {
+      W::Store(out + i, W::Add(W::Load(out + i), W::Load(in + i)));
+    }
+    Scalar<typename W::Real>::Add(out + i, in + i, n - i);
+  }
+
+  // ... 2 N ADC counts converted per register
+  template <class W>
+  void LoadADC(short const* adc, typename W::Real* out, std::size_t n,
+               typename W::Real pedestal, typename W::Real const* window)
+  {
+    typename W::V const vp = W::Set(pedestal);
+    std::size_t i = 0;
+    if (window) {
+      for (; i + 2*W::N <= n; i += 2*W::N) {
+        W::Store(out + i, W::Mul(W::Sub(W::LoadShort(adc + i), vp), W::Load(window + i)));
+      }
+    }
+    else {
+      for (; i + 2*W::N <= n; i += 2*W::N) {
+        W::Store(out + i, W::Sub(W::LoadShort(adc + i), vp));
+      }
+    }
+    Scalar<typename W::Real>::LoadADC(adc + i, out + i, n - i, pedestal,
+                                      window? window + i: nullptr);
+  }
@@ -0,0 +1,120 @@
+#ifndef LARFFTWTRAITS_H
+#define LARFFTWTRAITS_H
+
+// C/C++ standard libraries
+#include <cstddef>
+#include <new>
+
+#include "fftw3.h"
+
+#include "lardata/Utilities/AllocationAccounting.h"
+#include "lardata/Utilities/MemoryAccounting.h"
+
+namespace util {
+
+// -----------------------------------------------------------------------------
+// Maps the FFTW API onto the floating point type of the transform:
+// `fftw_*` for double precision, `fftwf_*` for single precision.
+// -----------------------------------------------------------------------------
+template <class Real> struct LArFFTWTraits;
+
+template <> struct LArFFTWTraits<double> {
+  using real_type = double;
+  using complex_type = fftw_complex;
+  using plan_type = fftw_plan;
+
+  static void* Malloc(std::size_t n) { return fftw_malloc(n); }
+  static void Free(void* p) { fftw_free(p); }
+
+  static plan_type PlanR2C(int n, const int* dims, int howmany,
+                           real_type* in, int idist, complex_type* out, int odist,
+                           unsigned flags)
+    { return fftw_plan_many_dft_r2c(n, dims, howmany, in, nullptr, 1, idist, out, nullptr, 1, odist, flags); }
+  static plan_type PlanC2R(int n, const int* dims, int howmany,
+                           complex_type* in, int idist, real_type* out, int odist,
+                           unsigned flags)
+    { return fftw_plan_many_dft_c2r(n, dims, howmany, in, nullptr, 1, idist, out, nullptr, 1, odist, flags); }
+
+  static void ExecuteR2C(const void* plan, real_type* in, complex_type* out)
+    { fftw_execute_dft_r2c((plan_type)plan, in, out); }
+  static void ExecuteC2R(const void* plan, complex_type* in, real_type* out)
+    { fftw_execute_dft_c2r((plan_type)plan, in, out); }
+
+  static void DestroyPlan(void* plan) { fftw_destroy_plan((plan_type)plan); }
+
+  static int AlignmentOf(real_type* p) { return fftw_alignment_of(p); }
+
+  static int ImportWisdom(const char* file) { return fftw_import_wisdom_from_filename(file); }
+  static int ExportWisdom(const char* file) { return fftw_export_wisdom_to_filename(file); }
+  static char* ExportWisdomToString() { return fftw_export_wisdom_to_string(); }
+};
+
+template <> struct LArFFTWTraits<float> {
+  using real_type = float;
+  using complex_type = fftwf_complex;
+  using plan_type = fftwf_plan;
+
+  static void* Malloc(std::size_t n) { return fftwf_malloc(n); }
+  static void Free(void* p) { fftwf_free(p); }
+
+  static plan_type PlanR2C(int n, const int* dims, int howmany,
+                           real_type* in, int idist, complex_type* out, int odist,
+                           unsigned flags)
+    { return fftwf_plan_many_dft_r2c(n, dims, howmany, in, nullptr, 1, idist, out, nullptr, 1, odist, flags); }
+  static plan_type PlanC2R(int n, const int* dims, int howmany,
+                           complex_type* in, int idist, real_type* out, int odist,
+                           unsigned flags)
+    { return fftwf_plan_many_dft_c2r(n, dims, howmany, in, nullptr, 1, idist, out, nullptr, 1, odist, flags); }
+
+  static void ExecuteR2C(const void* plan, real_type* in, complex_type* out)
+    { fftwf_execute_dft_r2c((plan_type)plan, in, out); }
+  static void ExecuteC2R(const void* plan, complex_type* in, real_type* out)
+    { fftwf_execute_dft_c2r((plan_type)plan, in, out); }
+
+  static void DestroyPlan(void* plan) { fftwf_destroy_plan((plan_type)plan); }
+
+  static int AlignmentOf(real_type* p) { return fftwf_alignment_of(p); }
+
+  static int ImportWisdom(const char* file) { return fftwf_import_wisdom_from_filename(file); }
+  static int ExportWisdom(const char* file) { return fftwf_export_wisdom_to_filename(file); }
+  static char* ExportWisdomToString() { return fftwf_export_wisdom_to_string(); }
+};
+
+// -----------------------------------------------------------------------------
+// Standard allocator returning memory aligned the way FFTW plans expect it
+// (fftw_malloc/fftwf_malloc), e.g. `std::vector<double, LArFFTWAllocator<double>>`.
+// The allocations are accounted under the tag "LArFFTW" when lardata is built
+// with LARDATA_ALLOCATION_ACCOUNTING (see lar::AllocationAccounting), and
+// the live buffers are always registered under the same tag (see
+// lar::MemoryAccounting).
+// -----------------------------------------------------------------------------
+struct LArFFTWAllocationTag { static constexpr char const* Name = "LArFFTW"; };
+
+template <class T> struct LArFFTWAllocator {
+  using value_type = T;
+
+  LArFFTWAllocator() noexcept = default;
+  template <class U> LArFFTWAllocator(LArFFTWAllocator<U> const&) noexcept {}
+
+  T* allocate(std::size_t n)
+    {
+      void* p = LArFFTWTraits<double>::Malloc(n*sizeof(T));
+      if (!p && n) throw std::bad_alloc();
+      lar::AllocationAccounting::recordAllocation<LArFFTWAllocationTag>(n*sizeof(T));
+      lar::MemoryAccounting::change<LArFFTWAllocationTag>(n*sizeof(T));
+      return static_cast<T*>(p);
+    }
+  void deallocate(T* p, std::size_t n) noexcept
+    {
+      lar::AllocationAccounting::recordDeallocation<LArFFTWAllocationTag>(n*sizeof(T));
+      lar::MemoryAccounting::change<LArFFTWAllocationTag>(-(long long)(n*sizeof(T)));
+      LArFFTWTraits<double>::Free(p);
+    }
+
+  template <class U> bool operator== (LArFFTWAllocator<U> const&) const noexcept { return true; }
+  template <class U> bool operator!= (LArFFTWAllocator<U> const&) const noexcept { return false; }
+};
+
+}  // end namespace util
+
+#endif
@@ -0,0 +1,62 @@
+#include "lardata/Utilities/LArFFTWWorkspacePool.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+util::LArFFTWWorkspacePool::LArFFTWWorkspacePool
+  (int transformSize, const void* fplan, const void* rplan, int fitbins)
+  : fSize        (transformSize)
+  , fPlan        (fplan)
+  , rPlan        (rplan)
+  , fFitBins     (fitbins)
+  , fNWorkspaces (0)
+{}
+
+util::LArFFTWWorkspacePool::LArFFTWWorkspacePool(LArFFTWPlan const& plan, int fitbins)
+  : LArFFTWWorkspacePool(plan.TransformSize(), plan.fPlan, plan.rPlan, fitbins)
+{}
+
+util::LArFFTWWorkspacePool::WorkspaceLease util::LArFFTWWorkspacePool::Lease()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fAvailable.empty()) {
+      std::unique_ptr<LArFFTW> workspace = std::move(fAvailable.back());
+      fAvailable.pop_back();
+      return { this, std::move(workspace) };
+    }
+    ++fNWorkspaces;
+  }
+  // ... buffer allocation does not need the lock
+  return { this, MakeWorkspace() };
+}
+
+void util::LArFFTWWorkspacePool::Reserve(std::size_t n)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  while (fNWorkspaces < n) {
+    fAvailable.push_back(MakeWorkspace());
+    ++fNWorkspaces;
+  }
+}
+
+std::size_t util::LArFFTWWorkspacePool::NWorkspaces() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNWorkspaces;
+}
+
+std::size_t util::LArFFTWWorkspacePool::NAvailable() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fAvailable.size();
+}
+
+std::unique_ptr<util::LArFFTW> util::LArFFTWWorkspacePool::MakeWorkspace() const
+{
+  return std::make_unique<LArFFTW>(fSize, fPlan, rPlan, fFitBins);
+}
+
+void util::LArFFTWWorkspacePool::Return(std::unique_ptr<LArFFTW> workspace)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fAvailable.push_back(std::move(workspace));
+}
@@ -0,0 +1,120 @@
+#ifndef LARFFTWWORKSPACEPOOL_H
+#define LARFFTWWORKSPACEPOOL_H
+
+// C/C++ standard libraries
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+
+#include "lardata/Utilities/LArFFTW.h"
+
+namespace util {
+
+class LArFFTWPlan;
+
+// -----------------------------------------------------------------------------
+// Pool of LArFFTW workspaces sharing one pair of FFTW plans.
+//
+// Each LArFFTW owns private scratch buffers (fIn/fOut/rIn/rOut and kernels),
+// so a single instance can't be used by two threads at once. FFTW plans,
+// instead, may be executed concurrently through the new-array execute
+// functions. The pool hands out workspaces through an RAII lease: a thread
+// leases a workspace, runs Convolute/Deconvolute on it, and the workspace
+// goes back to the pool when the lease is destroyed. New workspaces are
+// created on demand, so the pool grows to the number of concurrent users
+// (typically one per thread) and then stays stable.
+//
+// Example, inside a TBB loop over channels:
+//
+//     util::LArFFTWWorkspacePool pool(plan, fitBins);
+//     tbb::parallel_for(..., [&](auto const& range){
+//       auto fft = pool.Lease();
+//       for (auto& wave: range) fft->Deconvolute(wave, kernel);
+//     });
+//
+// The plans (and the LArFFTWPlan they come from) must outlive the pool.
+// -----------------------------------------------------------------------------
+class LArFFTWWorkspacePool {
+
+  public:
+
+    // RAII handle to a leased workspace
+    class WorkspaceLease {
+      public:
+        WorkspaceLease(WorkspaceLease&& other) noexcept
+          : fPool(other.fPool), fWorkspace(std::move(other.fWorkspace))
+          { other.fPool = nullptr; }
+        WorkspaceLease& operator=(WorkspaceLease&& other) noexcept
+          {
+            if (this != &other) {
+              Release();
+              fPool = other.fPool;
+              fWorkspace = std::move(other.fWorkspace);
+              other.fPool = nullptr;
+            }
+            return *this;
+          }
+        WorkspaceLease(WorkspaceLease const&) = delete;
+        WorkspaceLease& operator=(WorkspaceLease const&) = delete;
+        ~WorkspaceLease() { Release(); }
+
+        LArFFTW& operator* () const { return *fWorkspace; }
+        LArFFTW* operator-> () const { return fWorkspace.get(); }
+        LArFFTW* get() const { return fWorkspace.get(); }
+
+      private:
+        friend class LArFFTWWorkspacePool;
+
+        WorkspaceLease(LArFFTWWorkspacePool* pool, std::unique_ptr<LArFFTW> workspace)
+          : fPool(pool), fWorkspace(std::move(workspace)) {}
+
+        void Release()
+          {
+            if (fPool && fWorkspace) fPool->Return(std::move(fWorkspace));
+            fPool = nullptr;
+          }
+
+        LArFFTWWorkspacePool* fPool;
+        std::unique_ptr<LArFFTW> fWorkspace;
+    };
+
+    LArFFTWWorkspacePool(int transformSize, const void* fplan, const void* rplan, int fitbins);
+    LArFFTWWorkspacePool(LArFFTWPlan const& plan, int fitbins);
+
+    LArFFTWWorkspacePool(LArFFTWWorkspacePool const&) = delete;
+    LArFFTWWorkspacePool& operator=(LArFFTWWorkspacePool const&) = delete;
+
+    // Leases a workspace, creating a new one if none is available
+    WorkspaceLease Lease();
+
+    // Creates workspaces in advance up to a total of n
+    void Reserve(std::size_t n);
+
+    // Number of workspaces created so far
+    std::size_t NWorkspaces() const;
+
+    // Number of workspaces currently not leased
+    std::size_t NAvailable() const;
+
+    int TransformSize() const { return fSize; }
+    int FitBins() const { return fFitBins; }
+
+  private:
+
+    int fSize;			// size of transform
+    const void *fPlan;
+    const void *rPlan;
+    int fFitBins;		// Bins used for peak fit
+
+    mutable std::mutex fMutex;
+    std::vector<std::unique_ptr<LArFFTW>> fAvailable;
+    std::size_t fNWorkspaces;
+
+    std::unique_ptr<LArFFTW> MakeWorkspace() const;
+    void Return(std::unique_ptr<LArFFTW> workspace);
+};
+
+}  // end namespace util
+
+#endif
@@ -13,13 +13,31 @@
 
 #include "lardata/Utilities/LArFFT.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <cctype>
 
 //-----------------------------------------------
 util::LArFFT::LArFFT(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
   : fSize    (pset.get< int        > ("FFTSize", 0))
   , fOption  (pset.get< std::string >("FFTOption"))
   , fFitBins (pset.get< int         >("FitBins"))
+  , fPeakFit (nullptr)
+  , fConvHist(nullptr)
+  , fBackend (pset.get< std::string >("FFTBackend", "ROOT"))
+  , fMaxCachedSizes(pset.get< unsigned int >("MaxCachedSizes", 4))
 {
+  std::transform(fBackend.begin(), fBackend.end(), fBackend.begin(), ::toupper);
+  if (fBackend != "ROOT" && fBackend != "FFTW") {
+    throw cet::exception("LArFFT") << "Unsupported FFTBackend '" << fBackend
+      << "' (supported: \"ROOT\", \"FFTW\")\n";
+  }
+  fUseFFTW = (fBackend == "FFTW");
+  if (fMaxCachedSizes == 0) {
+    throw cet::exception("LArFFT") << "MaxCachedSizes must be at least 1\n";
+  }
+
   // Default to the readout window size if the user didn't input
   // a specific size
   if (fSize <= 0) {
@@ -41,34 +59,98 @@ void util::LArFFT::resetSizePerRun(art::Run const&)
 }
 
 //-----------------------------------------------
-void util::LArFFT::InitializeFFT()
+util::LArFFTTransforms::LArFFTTransforms(int size, std::string const& option,
+                                         bool useFFTW, int fitbins)
+  : fSize    (size)
+  , fFreqSize(size/2+1)
+  , fOption  (option)
+  , fUseFFTW (useFFTW)
+{
+  if (fUseFFTW) {
+    // FFTW plans shared by all the workspaces (and other users of this size)
+    fFFTWPlan = LArFFTWPlan::Shared(fSize, fOption);
+    fFFTWPool = std::make_unique<LArFFTWWorkspacePool>(*fFFTWPlan, fitbins);
+  }
+  else {
+    // allocate and setup Transform objects
+    fFFT        = std::make_unique<TFFTRealComplex>(fSize, false);
+    fInverseFFT = std::make_unique<TFFTComplexReal>(fSize, false);
+
+    int dummy[1] = {0};
+    // appears to be dummy argument from root page
+    fFFT->Init(fOption.c_str(),-1,dummy);
+    fInverseFFT->Init(fOption.c_str(),1,dummy);
+  }
+}
+
+//-----------------------------------------------
+util::LArFFTTransforms::~LArFFTTransforms()
+{
+  // the pool must go before the plans it uses
+  fFFTWPool.reset();
+}
+
+//-----------------------------------------------
+int util::LArFFT::RoundedSize(int size)
 {
   int i;
-  for(i = 1; i < fSize; i *= 2){ }
-  fSize=i;
-  fFreqSize = fSize/2+1;
+  for(i = 1; i < size; i *= 2){ }
+  return i;
+}
+
+//-----------------------------------------------
+std::shared_ptr<util::LArFFTTransforms> util::LArFFT::Transforms(int size)
+{
+  size = RoundedSize(size);
+
+  std::lock_guard<std::mutex> lock(fRegistryMutex);
+  auto const match = std::find_if(fRegistry.begin(), fRegistry.end(),
+    [size, this](auto const& transforms)
+      { return transforms->Size() == size && transforms->Option() == fOption; });
+  if (match != fRegistry.end()) {
+    // most recently used goes first
+    fRegistry.splice(fRegistry.begin(), fRegistry, match);
+    return fRegistry.front();
+  }
+
+  fRegistry.push_front
+    (std::make_shared<LArFFTTransforms>(size, fOption, fUseFFTW, fFitBins));
+  // handles already given out keep the dropped transforms alive
+  while (fRegistry.size() > fMaxCachedSizes) fRegistry.pop_back();
+  return fRegistry.front();
+}
+
+//-----------------------------------------------
+unsigned int util::LArFFT::NCachedSizes() const
+{
+  std::lock_guard<std::mutex> lock(fRegistryMutex);
+  return fRegistry.size();
+}
 
-  // allocate and setup Transform objects
-  fFFT        = new TFFTRealComplex(fSize, false);
-  fInverseFFT = new TFFTComplexReal(fSize, false);
+//-----------------------------------------------
+void util::LArFFT::InitializeFFT()
+{
+  fSize = RoundedSize(fSize);
+  fFreqSize = fSize/2+1;
 
-  int dummy[1] = {0};
-  // appears to be dummy argument from root page
-  fFFT->Init(fOption.c_str(),-1,dummy);
-  fInverseFFT->Init(fOption.c_str(),1,dummy);
+  fTransforms = Transforms(fSize);
 
-  fPeakFit = new TF1("fPeakFit","gaus"); //allocate function used for peak fitting
-  fConvHist = new TH1D("fConvHist","Convolution Peak Data",fFitBins,0,fFitBins);  //allocate histogram for peak fitting
+  // the peak fit depends only on the number of fit bins
+  if (!fConvHist || fConvHist->GetNbinsX() != fFitBins) {
+    delete fPeakFit;
+    delete fConvHist;
+    fPeakFit = new TF1("fPeakFit","gaus"); //allocate function used for peak fitting
+    fConvHist = new TH1D("fConvHist","Convolution Peak Data",fFitBins,0,fFitBins);  //allocate histogram for peak fitting
+  }
   //allocate other data vectors
   fCompTemp.resize(fFreqSize);
   fKern.resize(fFreqSize);
+  fKernResp.clear();
 }
 
 //------------------------------------------------
 util::LArFFT::~LArFFT()
 {
-  delete fFFT;
-  delete fInverseFFT;
   delete fPeakFit;
   delete fConvHist;
 }
@@ -76,18 +158,12 @@ util::LArFFT::~LArFFT()
 //------------------------------------------------
 void util::LArFFT::ReinitializeFFT(int size, std::string option, int fitbins)
 {
-  //delete these, which will be remade
-  delete fFFT;
-  delete fInverseFFT;
-  delete fPeakFit;
-  delete fConvHist;
-
   //set members
   fSize = size;
   fOption = option;
   fFitBins = fitbins;
 
-  //now initialize
+  //now initialize; transforms of a cached size are reused
   InitializeFFT();
 }
 
@@ -8,8 +8,41 @@
 #ifndef LARDATA_UTILITIES_MAKEINDEX_H
 #define LARDATA_UTILITIES_MAKEINDEX_H
 
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::max(), std::fill()
+#include <iterator> // std::begin()
+#include <limits> // std::numeric_limits<>
+#include <stdexcept> // std::runtime_error
+#include <string> // std::to_string()
+#include <type_traits> // std::remove_reference_t
+#include <cstddef> // std::size_t
+
+
 namespace util {
 
+  /// What the parallel index makers do with items having the same key.
+  enum class DuplicateKeyPolicy {
+    KeepFirst, ///< the first item in the collection is used
+    KeepLast,  ///< the last item in the collection is used
+    Throw      ///< a `std::runtime_error` exception is thrown
+  }; // DuplicateKeyPolicy
+
+
+  // declarations of the versions filling an existing vector
+  template <typename Coll, typename KeyOf>
+  std::vector<size_t>& MakeIndex
+    (Coll const& data, KeyOf key_of, std::vector<size_t>& Index);
+  template <typename Coll, typename KeyOf, typename Ptr>
+  std::vector<Ptr>& MakeMap
+    (Coll const& data, KeyOf key_of, std::vector<Ptr>& Index);
+
+
   /**
    * @brief Creates a map of indices from an existing collection
    * @tparam Coll type of the collection
@@ -41,11 +74,32 @@ namespace util {
    */
   template <typename Coll, typename KeyOf>
   std::vector<size_t> MakeIndex(Coll const& data, KeyOf key_of = KeyOf()) {
+    std::vector<size_t> Index;
+    MakeIndex(data, key_of, Index);
+    return Index;
+  } // MakeIndex()
+
 
+  /**
+   * @brief Fills a map of indices from an existing collection
+   * @tparam Coll type of the collection
+   * @tparam KeyOf type of the extractor of the key
+   * @param data the data collection
+   * @param key_of instance of a functor extracting a key value from a datum
+   * @param Index the vector to be filled
+   * @return `Index`, filled as by `MakeIndex(data, key_of)`
+   *
+   * The previous content of `Index` is replaced, but its memory is reused:
+   * keeping the same vector from one event to the next saves its allocation.
+   */
+  template <typename Coll, typename KeyOf>
+  std::vector<size_t>& MakeIndex
+    (Coll const& data, KeyOf key_of, std::vector<size_t>& Index)
+  {
     // we start the index with the best guess that all the items will have
     // a unique key and they are contiguous:
     // the index would have the same size as the data
-    std::vector<size_t> Index(data.size(), std::numeric_limits<size_t>::max());
+    Index.assign(data.size(), std::numeric_limits<size_t>::max());
 
     size_t min_size = 0; // minimum size needed to hold all keys
 
@@ -65,7 +119,7 @@ namespace util {
     } // for datum
     Index.resize(min_size);
     return Index;
-  } // MakeIndex()
+  } // MakeIndex(Index)
 
 
   /**
@@ -97,16 +151,35 @@ namespace util {
    */
   template <typename Coll, typename KeyOf>
   auto MakeMap(Coll const& data, KeyOf key_of = KeyOf())
-    -> std::vector<decltype(key_of(*(data.begin()))) const*>
   {
-    using Mapped_t = decltype(key_of(*(data.begin())));
-    using Ptr_t = Mapped_t const*;
-    using Map_t = std::vector<Ptr_t>;
+    std::vector<std::remove_reference_t<decltype(*(data.begin()))> const*>
+      Index;
+    MakeMap(data, key_of, Index);
+    return Index;
+  } // MakeMap()
 
+
+  /**
+   * @brief Fills a map of objects from an existing collection
+   * @tparam Coll type of the collection
+   * @tparam KeyOf type of the extractor of the key
+   * @tparam Ptr type of pointer to the data
+   * @param data the data collection
+   * @param key_of instance of a functor extracting a key value from a datum
+   * @param Index the vector to be filled
+   * @return `Index`, filled as by `MakeMap(data, key_of)`
+   *
+   * The previous content of `Index` is replaced, but its memory is reused:
+   * keeping the same vector from one event to the next saves its allocation.
+   */
+  template <typename Coll, typename KeyOf, typename Ptr>
+  std::vector<Ptr>& MakeMap
+    (Coll const& data, KeyOf key_of, std::vector<Ptr>& Index)
+  {
     // we start the index with the best guess that all the items will have
     // a unique key and they are contiguous:
     // the index would have the same size as the data
-    Map_t Index(data.size(), nullptr);
+    Index.assign(data.size(), nullptr);
 
     size_t min_size = 0; // minimum size needed to hold all keys
 
@@ -121,7 +194,195 @@ namespace util {
     } // for datum
     Index.resize(min_size);
     return Index;
-  } // MakeMap()
+  } // MakeMap(Index)
+
+
+  namespace details {
+
+    /**
+     * @brief Fills `Index[key]` with the value of each item, in parallel
+     * @param n number of items
+     * @param keyAt functor returning the key of the item with the given index
+     * @param valueAt functor returning the value of the item with given index
+     * @param noValue value for keys with no item
+     * @param policy what to do with items with the same key
+     * @param Index the vector to be filled (its memory is reused)
+     *
+     * The keys are extracted and their maximum is found in parallel.
+     * Then the items are distributed in blocks of keys small enough for their
+     * part of `Index` to stay in cache, and the blocks are filled in parallel.
+     * Each block is filled following the order of the items in the
+     * collection, so that the result does not depend on the scheduling.
+     */
+    template <typename Value, typename KeyAt, typename ValueAt>
+    void ParallelFillByKey(
+      std::size_t n, KeyAt keyAt, ValueAt valueAt, Value noValue,
+      DuplicateKeyPolicy policy, std::vector<Value>& Index
+    ) {
+      using Range_t = tbb::blocked_range<std::size_t>;
+      constexpr std::size_t KeyBlockSize = 4096; // keys in one block
+      constexpr std::size_t ChunkSize = 16384; // items in one chunk
+
+      // the keys, and their maximum (parallel)
+      std::vector<std::size_t> keys(n);
+      std::size_t const maxKey = tbb::parallel_reduce(
+        Range_t(0, n), std::size_t(0),
+        [&](Range_t const& range, std::size_t m){
+          for (std::size_t i = range.begin(); i != range.end(); ++i) {
+            keys[i] = std::size_t(keyAt(i));
+            m = std::max(m, keys[i]);
+          }
+          return m;
+        },
+        [](std::size_t a, std::size_t b){ return std::max(a, b); }
+        );
+
+      Index.resize((n == 0)? 0: maxKey + 1);
+      std::size_t const nBlocks = (Index.size() + KeyBlockSize - 1) / KeyBlockSize;
+      std::size_t const nChunks = (n + ChunkSize - 1) / ChunkSize;
+
+      // histogram of the blocks for each chunk of items, into the offsets;
+      // the offsets are sorted by block and, within the block, by chunk
+      std::vector<std::size_t> offsets(nBlocks * nChunks + 1, 0U);
+      tbb::parallel_for(Range_t(0, nChunks), [&](Range_t const& range){
+        for (std::size_t iChunk = range.begin(); iChunk != range.end(); ++iChunk) {
+          std::size_t const end = std::min(n, (iChunk + 1) * ChunkSize);
+          for (std::size_t i = iChunk * ChunkSize; i < end; ++i)
+            ++offsets[(keys[i] / KeyBlockSize) * nChunks + iChunk + 1];
+        }
+      });
+      for (std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+      // scatter of the items by block (parallel)
+      std::vector<std::size_t> order(n);
+      tbb::parallel_for(Range_t(0, nChunks), [&](Range_t const& range){
+        std::vector<std::size_t> next(nBlocks);
+        for (std::size_t iChunk = range.begin(); iChunk != range.end(); ++iChunk) {
+          for (std::size_t iBlock = 0; iBlock < nBlocks; ++iBlock)
+            next[iBlock] = offsets[iBlock * nChunks + iChunk];
+          std::size_t const end = std::min(n, (iChunk + 1) * ChunkSize);
+          for (std::size_t i = iChunk * ChunkSize; i < end; ++i)
+            order[next[keys[i] / KeyBlockSize]++] = i;
+        }
+      });
+
+      // filling of the index, block by block (parallel)
+      tbb::parallel_for(Range_t(0, nBlocks), [&](Range_t const& range){
+        for (std::size_t iBlock = range.begin(); iBlock != range.end(); ++iBlock) {
+          std::size_t const firstKey = iBlock * KeyBlockSize;
+          std::fill(
+            Index.begin() + firstKey,
+            Index.begin() + std::min(Index.size(), firstKey + KeyBlockSize),
+            noValue
+            );
+          std::size_t const end = offsets[(iBlock + 1) * nChunks];
+          for (std::size_t k = offsets[iBlock * nChunks]; k != end; ++k) {
+            std::size_t const i = order[k];
+            Value& entry = Index[keys[i]];
+            if (entry != noValue) {
+              if (policy == DuplicateKeyPolicy::KeepFirst) continue;
+              if (policy == DuplicateKeyPolicy::Throw) {
+                throw std::runtime_error
+                  ("Duplicate key " + std::to_string(keys[i]) + " in index");
+              }
+            } // if duplicate
+            entry = valueAt(i);
+          } // for items
+        } // for blocks
+      });
+
+    } // ParallelFillByKey()
+
+  } // namespace details
+
+
+  /**
+   * @brief Fills a map of indices from an existing collection, in parallel
+   * @tparam Coll type of the collection (with random access)
+   * @tparam KeyOf type of the extractor of the key
+   * @param data the data collection
+   * @param key_of instance of a functor extracting a key value from a datum
+   * @param Index the vector to be filled (its memory is reused)
+   * @param policy what to do if multiple items have the same key
+   * @return `Index`, with the same content as from `MakeIndex(data, key_of)`
+   *
+   * This is a parallel version of `MakeIndex()`, using TBB. The key of each
+   * item is extracted once. If multiple items have the same key, `policy`
+   * decides which one is kept (by default the last one, as in most cases
+   * `MakeIndex()` does), or an exception is thrown.
+   * `key_of` may be called concurrently from different threads.
+   */
+  template <typename Coll, typename KeyOf>
+  std::vector<size_t>& ParallelMakeIndex(
+    Coll const& data, KeyOf key_of, std::vector<size_t>& Index,
+    DuplicateKeyPolicy policy = DuplicateKeyPolicy::KeepLast
+  ) {
+    auto const begin = std::begin(data);
+    details::ParallelFillByKey(
+      data.size(),
+      [&begin, &key_of](std::size_t i){ return key_of(begin[i]); },
+      [](std::size_t i){ return i; },
+      std::numeric_limits<size_t>::max(), policy, Index
+      );
+    return Index;
+  } // ParallelMakeIndex(Index)
+
+
+  /// Creates a map of indices from an existing collection, in parallel.
+  /// @see `ParallelMakeIndex(Coll const&, KeyOf, std::vector<size_t>&, DuplicateKeyPolicy)`
+  template <typename Coll, typename KeyOf>
+  std::vector<size_t> ParallelMakeIndex(
+    Coll const& data, KeyOf key_of = KeyOf(),
+    DuplicateKeyPolicy policy = DuplicateKeyPolicy::KeepLast
+  ) {
+    std::vector<size_t> Index;
+    ParallelMakeIndex(data, key_of, Index, policy);
+    return Index;
+  } // ParallelMakeIndex()
+
+
+  /**
+   * @brief Fills a map of objects from an existing collection, in parallel
+   * @tparam Coll type of the collection (with random access)
+   * @tparam KeyOf type of the extractor of the key
+   * @tparam Ptr type of pointer to the data
+   * @param data the data collection
+   * @param key_of instance of a functor extracting a key value from a datum
+   * @param Index the vector to be filled (its memory is reused)
+   * @param policy what to do if multiple items have the same key
+   * @return `Index`, with the same content as from `MakeMap(data, key_of)`
+   *
+   * This is a parallel version of `MakeMap()`; see `ParallelMakeIndex()`.
+   */
+  template <typename Coll, typename KeyOf, typename Ptr>
+  std::vector<Ptr>& ParallelMakeMap(
+    Coll const& data, KeyOf key_of, std::vector<Ptr>& Index,
+    DuplicateKeyPolicy policy = DuplicateKeyPolicy::KeepLast
+  ) {
+    auto const begin = std::begin(data);
+    details::ParallelFillByKey(
+      data.size(),
+      [&begin, &key_of](std::size_t i){ return key_of(begin[i]); },
+      [&begin](std::size_t i) -> Ptr { return &(begin[i]); },
+      Ptr(nullptr), policy, Index
+      );
+    return Index;
+  } // ParallelMakeMap(Index)
+
+
+  /// Creates a map of objects from an existing collection, in parallel.
+  /// @see `ParallelMakeMap(Coll const&, KeyOf, std::vector<Ptr>&, DuplicateKeyPolicy)`
+  template <typename Coll, typename KeyOf>
+  auto ParallelMakeMap(
+    Coll const& data, KeyOf key_of = KeyOf(),
+    DuplicateKeyPolicy policy = DuplicateKeyPolicy::KeepLast
+  ) {
+    std::vector<std::remove_reference_t<decltype(*(data.begin()))> const*>
+      Index;
+    ParallelMakeMap(data, key_of, Index, policy);
+    return Index;
+  } // ParallelMakeMap()
 
 } // namespace util
 
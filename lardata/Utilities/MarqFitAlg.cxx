@@ -1,25 +1,198 @@
 #include "lardata/Utilities/MarqFitAlg.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include <cstdint>
+#include <cstring>
 #include <limits>
 
+namespace {
+
+  /*
+   Exponential of a single precision number, with a polynomial on the reduced
+   argument (as in Cephes expf) and no branch nor library call, so that loops
+   calling it can be vectorized. The relative error is within a couple of ulp.
+  */
+  inline float vexp(float x){
+    const float Log2e = 1.44269504088896341f;
+    const float Ln2Hi = 0.693359375f;
+    const float Ln2Lo = -2.12194440e-4f;
+    const float Round = 12582912.f; // 1.5 x 2^23, rounds to nearest integer
+    const float xc = (x < -87.3f)? -87.3f: ((x > 88.3f)? 88.3f: x);
+    const float n = (xc*Log2e + Round) - Round;
+    const float r = (xc - n*Ln2Hi) - n*Ln2Lo;
+    float poly = 1.9875691500e-4f;
+    poly = poly*r + 1.3981999507e-3f;
+    poly = poly*r + 8.3334519073e-3f;
+    poly = poly*r + 4.1665795894e-2f;
+    poly = poly*r + 1.6666665459e-1f;
+    poly = poly*r + 5.0000001201e-1f;
+    const float y = poly*r*r + r + 1.f;
+    const std::int32_t bits = (std::int32_t(n) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    const float e = y*scale;
+    return (x != x)? x: ((x < -87.3f)? 0.f: e);
+  }
+
+  /* parameters of NG Gaussians, one array per kind (amplitude, mean, 1/sigma) */
+  template <int NG>
+  struct GaussParams {
+    float amp[NG];
+    float mean[NG];
+    float invSigma[NG];
+    explicit GaussParams(const float p[]){
+      for(int j=0;j<NG;j++){
+        amp[j]=p[3*j];
+        mean[j]=p[3*j+1];
+        invSigma[j]=1.f/p[3*j+2];
+      }
+    }
+  };
+
+  /* fgauss() for exactly NG Gaussians */
+  template <int NG>
+  void fgaussN(const float yd[], const float p[], const int ndat, float res[]){
+    const GaussParams<NG> g(p);
+    #if defined WITH_OPENMP
+    #pragma omp simd
+    #endif
+    for(int i=0;i<ndat;i++){
+      float yf=0.;
+      for(int j=0;j<NG;j++){
+        const float xmu_sg=(float(i)-g.mean[j])*g.invSigma[j];
+        yf = yf + g.amp[j]*vexp(-0.5f*xmu_sg*xmu_sg);
+      }
+      res[i]=yd[i]-yf;
+    }
+  }
+
+  /* dgauss() for exactly NG Gaussians */
+  template <int NG>
+  void dgaussN(const float p[], const int ndat, float dydp[]){
+    const int npar = 3*NG;
+    const GaussParams<NG> g(p);
+    #if defined WITH_OPENMP
+    #pragma omp simd
+    #endif
+    for(int i=0;i<ndat;i++){
+      for(int j=0;j<NG;j++){
+        const float xmu_sg=(float(i)-g.mean[j])*g.invSigma[j];
+        const float e=vexp(-0.5f*xmu_sg*xmu_sg);
+        const float d1=g.amp[j]*e*xmu_sg*g.invSigma[j];
+        dydp[i*npar+3*j]=e;
+        dydp[i*npar+3*j+1]=d1;
+        dydp[i*npar+3*j+2]=d1*xmu_sg;
+      }
+    }
+  }
+
+  /* calls Func<NG>::call(args...) for the NG between 1 and Max matching ng */
+  template <template <int> class Func, int NG, int Max>
+  struct Dispatch {
+    template <typename... Args>
+    static bool call(const int ng, Args... args){
+      if(ng==NG){ Func<NG>::call(args...); return true; }
+      return Dispatch<Func, NG+1, Max>::call(ng, args...);
+    }
+  };
+  template <template <int> class Func, int Max>
+  struct Dispatch<Func, Max+1, Max> {
+    template <typename... Args>
+    static bool call(const int, Args...){ return false; }
+  };
+
+  template <int NG>
+  struct FGauss {
+    static void call(const float yd[], const float p[], int ndat, float res[])
+      { fgaussN<NG>(yd, p, ndat, res); }
+  };
+
+  template <int NG>
+  struct DGauss {
+    static void call(const float p[], int ndat, float dydp[])
+      { dgaussN<NG>(p, ndat, dydp); }
+  };
+
+  /*
+   Solves alpha dp = beta by Cholesky decomposition alpha = L L^T, with L
+   stored in the lower triangle of l (n x n). alpha must be symmetric and
+   positive definite, as the damped curvature matrix is; returns false if a
+   pivot is not positive (e.g. for a singular matrix), leaving dp undefined.
+  */
+  inline bool cholesky_solve(const float beta[], const float alpha[], const int n, float l[], float dp[]){
+    for(int i=0;i<n;i++){
+      for(int j=0;j<=i;j++){
+        float sum=alpha[i*n+j];
+        for(int k=0;k<j;k++) sum-=l[i*n+k]*l[j*n+k];
+        if(i==j){
+          if(!(sum>0.f)) return false;
+          l[i*n+i]=std::sqrt(sum);
+        }
+        else l[i*n+j]=sum/l[j*n+j];
+      }
+    }
+    /* ... forward substitution, L z = beta */
+    for(int i=0;i<n;i++){
+      float sum=beta[i];
+      for(int k=0;k<i;k++) sum-=l[i*n+k]*dp[k];
+      dp[i]=sum/l[i*n+i];
+    }
+    /* ... back substitution, L^T dp = z */
+    for(int i=n-1;i>=0;i--){
+      float sum=dp[i];
+      for(int k=i+1;k<n;k++) sum-=l[k*n+i]*dp[k];
+      dp[i]=sum/l[i*n+i];
+    }
+    return true;
+  }
+
+  /* cholesky_solve() with the size known at compile time, fully unrolled */
+  template <int N>
+  bool cholesky_solveN(const float beta[], const float alpha[], float l[], float dp[])
+    { return cholesky_solve(beta, alpha, N, l, dp); }
+
+} // local namespace
+
 namespace gshf{
 
+  MarqFitAlg::MarqFitAlg(){}
+
+  MarqFitAlg::Workspace& MarqFitAlg::threadWorkspace(){
+    // one per thread and shared by all the algorithms, which are stateless
+    thread_local Workspace work;
+    return work;
+  }
+
+  void MarqFitAlg::Workspace::resize(const int nParam, const int nData){
+    // std::vector keeps its memory when shrinking, so after the largest fit
+    // there are no more allocations
+    res.resize(nData);
+    dydp.resize(nData*nParam);
+    beta.resize(nParam);
+    alpha.resize(nParam*nParam);
+    dp.resize(nParam);
+    alpsav.resize(nParam);
+    psav.resize(nParam);
+    h.resize(nParam*(nParam+1));
+  }
+
   /* multi-Gaussian function, number of Gaussians is npar divided by 3 */
-  void MarqFitAlg::fgauss(const float yd[], const float p[], const int npar, const int ndat, std::vector<float> &res){
+  void MarqFitAlg::fgauss(const float yd[], const float p[], const int npar, const int ndat, float res[]){
+    if(Dispatch<FGauss, 1, MaxUnrolledGaussians>::call(npar/3, yd, p, ndat, res)) return;
     #if defined WITH_OPENMP
     #pragma omp simd
     #endif
     for(int i=0;i<ndat;i++){
       float yf=0.;
       for(int j=0;j<npar;j+=3){
-	yf = yf + p[j]*std::exp(-0.5*std::pow((float(i)-p[j+1])/p[j+2],2));
+	const float xmu_sg=(float(i)-p[j+1])/p[j+2];
+	yf = yf + p[j]*vexp(-0.5f*xmu_sg*xmu_sg);
       }
       res[i]=yd[i]-yf;
     }
   }
 
   /* analytic derivatives for multi-Gaussian function in fgauss */
-  void MarqFitAlg::dgauss(const float p[], const int npar, const int ndat, std::vector<float> &dydp){
+  void MarqFitAlg::dgauss(const float p[], const int npar, const int ndat, float dydp[]){
+    if(Dispatch<DGauss, 1, MaxUnrolledGaussians>::call(npar/3, p, ndat, dydp)) return;
     #if defined WITH_OPENMP
     //#pragma GCC ivdep
      #pragma omp simd 
@@ -29,7 +202,7 @@ namespace gshf{
 	const float xmu=float(i)-p[j+1];
 	const float xmu_sg=xmu/p[j+2];
 	const float xmu_sg2=xmu_sg*xmu_sg;
-	dydp[i*npar+j] = std::exp(-0.5*xmu_sg2);
+	dydp[i*npar+j] = vexp(-0.5f*xmu_sg2);
 	dydp[i*npar+j+1]=p[j]*dydp[i*npar+j]*xmu_sg/p[j+2];
 	dydp[i*npar+j+2]=dydp[i*npar+j+1]*xmu_sg;
       }
@@ -37,7 +210,7 @@ namespace gshf{
   }
 
   /* calculate ChiSquared */
-  float MarqFitAlg::cal_xi2(const std::vector<float> &res, const int ndat){
+  float MarqFitAlg::cal_xi2(const float res[], const int ndat){
     int i;
     float xi2;
     xi2=0.;
@@ -48,7 +221,7 @@ namespace gshf{
   }
 
   /* setup the beta and  (curvature) matrices */
-  void MarqFitAlg::setup_matrix(const std::vector<float> &res, const std::vector<float> &dydp, const int npar, const int ndat, std::vector<float> &beta, std::vector<float> &alpha)
+  void MarqFitAlg::setup_matrix(const float res[], const float dydp[], const int npar, const int ndat, float beta[], float alpha[])
   {
     int i,j,k;
   
@@ -81,53 +254,66 @@ namespace gshf{
   }
 
   /* solve system of linear equations */
-  void MarqFitAlg::solve_matrix(const std::vector<float> &beta, const std::vector<float> &alpha, const int npar, std::vector<float> &dp)
+  void MarqFitAlg::solve_matrix(const float beta[], const float alpha[], const int npar, float hbuf[], float dp[])
   {
+    /* ... the damped alpha is symmetric positive definite: use Cholesky,
+       unrolled for 1 to 5 Gaussians */
+    bool solved;
+    switch(npar){
+      case  3: solved=cholesky_solveN< 3>(beta, alpha, hbuf, dp); break;
+      case  6: solved=cholesky_solveN< 6>(beta, alpha, hbuf, dp); break;
+      case  9: solved=cholesky_solveN< 9>(beta, alpha, hbuf, dp); break;
+      case 12: solved=cholesky_solveN<12>(beta, alpha, hbuf, dp); break;
+      case 15: solved=cholesky_solveN<15>(beta, alpha, hbuf, dp); break;
+      default: solved=cholesky_solve(beta, alpha, npar, hbuf, dp); break;
+    }
+    if(solved) return;
+
+    /* ... not positive definite within rounding: Gauss-Jordan elimination */
     int i,j,k,imax;
     float hmax,hsav;
 
-    std::vector<std::vector<float>> h(npar, std::vector<float>(npar+1,0));
-
-    /* ... set up augmented N x N+1 matrix */
+    /* ... set up augmented N x N+1 matrix, in the workspace hbuf */
+    auto h = [hbuf,npar](int r) { return hbuf + r*(npar+1); };
     for(i=0;i<npar;i++){
-      h[i][npar]=beta[i];
+      h(i)[npar]=beta[i];
       for(j=0;j<npar;j++){
-	h[i][j]=alpha[i*npar+j];
+	h(i)[j]=alpha[i*npar+j];
       }
     }
 
     /* ... diagonalize N x N matrix but do only terms required for solution */
     for(i=0;i<npar;i++){
-      hmax=h[i][i];
+      hmax=h(i)[i];
       imax=i;
       for(j=i+1;j<npar;j++){
-	if(h[j][i]>hmax){
-	  hmax=h[j][i];
+	if(h(j)[i]>hmax){
+	  hmax=h(j)[i];
 	  imax=j;
 	}
       }
       if(imax!=i){
 	for(k=0;k<=npar;k++){
-	  hsav=h[i][k];
-	  h[i][k]=h[imax][k];
-	  h[imax][k]=hsav;
+	  hsav=h(i)[k];
+	  h(i)[k]=h(imax)[k];
+	  h(imax)[k]=hsav;
 	}
       }
       for(j=0;j<npar;j++){
 	if(j==i)continue;
 	for(k=i;k<npar;k++){
-	  h[j][k+1]-=h[i][k+1]*h[j][i]/h[i][i];
+	  h(j)[k+1]-=h(i)[k+1]*h(j)[i]/h(i)[i];
 	}
       }
     }
     /* ... scale (N+1)'th column with factor which normalizes the diagonal */
     for(i=0;i<npar;i++){
-      dp[i]=h[i][npar]/h[i][i];
+      dp[i]=h(i)[npar]/h(i)[i];
     }
 
   }
 
-  float MarqFitAlg::invrt_matrix(std::vector<float> &alphaf, const int npar)
+  float MarqFitAlg::invrt_matrix(float alphaf[], const int npar)
   {
     /*
      Inverts the curvature matrix alpha using Gauss-Jordan elimination and 
@@ -240,23 +426,23 @@ namespace gshf{
   /* Calculate parameter errors */
   int MarqFitAlg::cal_perr(float p[], float y[], const int nParam, const int nData, float perr[])
   {
-    int i,j;
+    return cal_perr(threadWorkspace(), p, y, nParam, nData, perr);
+  }
+
+  int MarqFitAlg::cal_perr(Workspace &work, float p[], float y[], const int nParam, const int nData, float perr[])
+  {
+    int i;
     float det;
 
-    std::vector<float> res(nData);
-    std::vector<float> dydp(nData*nParam);
-    std::vector<float> beta(nParam);
-    std::vector<float> alpha(nParam*nParam);
-    std::vector<std::vector<float>> alpsav(nParam,std::vector<float>(nParam));
+    work.resize(nParam, nData);
+    float* const res = work.res.data();
+    float* const dydp = work.dydp.data();
+    float* const beta = work.beta.data();
+    float* const alpha = work.alpha.data();
 
     fgauss(y, p, nParam, nData, res);
     dgauss(p, nParam, nData, dydp);
     setup_matrix(res, dydp, nParam, nData, beta,alpha);
-    for(i=0;i<nParam;i++){
-      for(j=0;j<nParam;j++){
-	alpsav[i][j]=alpha[i*nParam+j];
-      }
-    }
     det=invrt_matrix(alpha, nParam);
 
     if(det==0)return 1;
@@ -273,26 +459,33 @@ namespace gshf{
 
   int MarqFitAlg::mrqdtfit(float &lambda, float p[], float y[], const int nParam, const int nData, float &chiSqr, float &dchiSqr)
   {
-    std::vector<float> plimmin(nParam,std::numeric_limits<float>::lowest());
-    std::vector<float> plimmax(nParam,std::numeric_limits<float>::max());
-    return mrqdtfit(lambda, p, &plimmin[0], &plimmax[0], y, nParam, nData, chiSqr, dchiSqr);
+    // no limits
+    return mrqdtfit(threadWorkspace(), lambda, p, nullptr, nullptr, y, nParam, nData, chiSqr, dchiSqr);
   }
 
   int MarqFitAlg::mrqdtfit(float &lambda, float p[], float plimmin[], float plimmax[], float y[], const int nParam, const int nData, float &chiSqr, float &dchiSqr)
+  {
+    return mrqdtfit(threadWorkspace(), lambda, p, plimmin, plimmax, y, nParam, nData, chiSqr, dchiSqr);
+  }
+
+  int MarqFitAlg::mrqdtfit(Workspace &work, float &lambda, float p[], float plimmin[], float plimmax[], float y[], const int nParam, const int nData, float &chiSqr, float &dchiSqr)
   {
     int j;
     float nu,rho,lzmlh,amax,chiSq0;
 
-    std::vector<float> res(nData);
-    std::vector<float> beta(nParam);
-    std::vector<float> dp(nParam);
-    std::vector<float> alpsav(nParam);
-    std::vector<float> psav(nParam);
-    std::vector<float> dydp(nData*nParam);
-    std::vector<float> alpha(nParam*nParam);
-
+    work.resize(nParam, nData);
+    float* const res = work.res.data();
+    float* const beta = work.beta.data();
+    float* const dp = work.dp.data();
+    float* const alpsav = work.alpsav.data();
+    float* const psav = work.psav.data();
+    float* const dydp = work.dydp.data();
+    float* const alpha = work.alpha.data();
+    float* const h = work.h.data();
+
+    // limits are optional (both or none)
     bool haslimits = false;
-    for(j=0;j<nParam;j++){
+    for(j=0;plimmin && plimmax && j<nParam;j++){
       if (plimmin[j]>std::numeric_limits<float>::lowest() || plimmax[j]<std::numeric_limits<float>::max()) {
         haslimits = true;
         break;
@@ -314,7 +507,7 @@ namespace gshf{
       alpsav[j]=alpha[j*nParam+j];
       alpha[j*nParam+j]=alpsav[j]+lambda;
     }
-    solve_matrix(beta, alpha, nParam, dp);
+    solve_matrix(beta, alpha, nParam, h, dp);
 
     nu=2.;
     rho=-1.;
@@ -345,7 +538,7 @@ namespace gshf{
 	for(j = 0; j < nParam; j++){
 	  alpha[j*nParam+j]=alpsav[j]+lambda;
 	}
-	solve_matrix(beta, alpha, nParam, dp);
+	solve_matrix(beta, alpha, nParam, h, dp);
       }
     } while(rho<0.);
     lambda=lambda*fmax(0.333333,1.-pow(2.*rho-1.,3));  
@@ -354,4 +547,32 @@ namespace gshf{
 
   }
 
+  int MarqFitAlg::fit_batch(const int nFits, float p[], float plimmin[], float plimmax[], const int paramOffsets[], float y[], const int dataOffsets[], const float chiCut, const int maxTrials, float chiSqr[], int status[])
+  {
+    Workspace work;
+    int nFailed=0;
+    for(int i=0;i<nFits;i++){
+      const int firstParam=paramOffsets[i];
+      const int nParam=paramOffsets[i+1]-firstParam;
+      const int nData=dataOffsets[i+1]-dataOffsets[i];
+      float* const pi = p+firstParam;
+      float* const pmin = plimmin? (plimmin+firstParam): nullptr;
+      float* const pmax = plimmax? (plimmax+firstParam): nullptr;
+      float* const yi = y+dataOffsets[i];
+
+      float lambda=-1.;  // initialize lambda on first call
+      float dchiSqr=0.;
+      int fitResult=0;
+      int trial=0;
+      do{
+	fitResult=mrqdtfit(work, lambda, pi, pmin, pmax, yi, nParam, nData, chiSqr[i], dchiSqr);
+	trial++;
+      } while(!fitResult && trial<maxTrials && std::fabs(dchiSqr)>=chiCut);
+
+      if(fitResult) ++nFailed;
+      if(status) status[i]=fitResult;
+    }
+    return nFailed;
+  }
+
 }//end namespace gshf
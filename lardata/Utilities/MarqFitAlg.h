@@ -1,8 +1,8 @@
 ////////////////////////////////////////////////////////////////////////
 // Class:       MarqFitAlg
 // Purpose:     Fit gaussians
-//              
-//              
+//
+//
 // Original code by Mike Wang, converted to a larsoft algorithm by S. Berkman
 ////////////////////////////////////////////////////////////////////////
 
@@ -20,22 +20,65 @@ namespace gshf{
 
   class MarqFitAlg {
     public:
+
+      /// Working memory of a fit; it grows to the largest fit and is reused
+      struct Workspace {
+        std::vector<float> res;    ///< residuals, one per data point
+        std::vector<float> dydp;   ///< derivatives, nData x nParam
+        std::vector<float> beta;   ///< gradient of the chi square
+        std::vector<float> alpha;  ///< curvature matrix, nParam x nParam
+        std::vector<float> dp;     ///< parameter step
+        std::vector<float> alpsav; ///< diagonal of alpha before damping
+        std::vector<float> psav;   ///< parameters before the step
+        std::vector<float> h;      ///< augmented matrix for solve_matrix()
+
+        /// Makes room for a fit with nParam parameters and nData points
+        void resize(const int nParam, const int nData);
+      };
+
+      /// Largest number of Gaussians with a dedicated, unrolled function
+      static constexpr int MaxUnrolledGaussians = 6;
+
       explicit MarqFitAlg();
       virtual ~MarqFitAlg() {}
 
+      // these versions use a workspace private to the calling thread, so that
+      // different threads can share the same algorithm
       int cal_perr(float p[], float y[], const int nParam, const int nData, float perr[]);
       int mrqdtfit(float &lambda, float p[], float y[], const int nParam, const int nData, float &chiSqr, float &dchiSqr);
       int mrqdtfit(float &lambda, float p[], float plimmin[], float plimmax[], float y[], const int nParam, const int nData, float &chiSqr, float &dchiSqr);
 
+      // these versions use the specified workspace, which must not be used by
+      // other threads at the same time; they spare the lookup of the workspace
+      // of the thread
+      int cal_perr(Workspace &work, float p[], float y[], const int nParam, const int nData, float perr[]);
+      int mrqdtfit(Workspace &work, float &lambda, float p[], float plimmin[], float plimmax[], float y[], const int nParam, const int nData, float &chiSqr, float &dchiSqr);
+
+      /*
+       Fits nFits independent pulse trains, iterating mrqdtfit() on each one
+       until the change of chi square is below chiCut or maxTrials steps are
+       done. The parameters of fit i are p[paramOffsets[i]] to
+       p[paramOffsets[i+1]-1] (and the same for the optional limits plimmin and
+       plimmax), and its data is y[dataOffsets[i]] to y[dataOffsets[i+1]-1];
+       the offset arrays have nFits+1 elements. The fitted parameters replace
+       the initial ones; chiSqr and the optional status (0 for success) hold
+       one value per fit. Returns the number of fits which failed. The batch
+       uses a workspace of its own.
+      */
+      int fit_batch(const int nFits, float p[], float plimmin[], float plimmax[], const int paramOffsets[], float y[], const int dataOffsets[], const float chiCut, const int maxTrials, float chiSqr[], int status[] = nullptr);
+
 
     private:
       //these functions are  called by the public functions
-      void fgauss(const float yd[], const float p[], const int npar, const int ndat, std::vector<float> &res);
-      void dgauss(const float p[], const int npar, const int ndat, std::vector<float> &dydp);
-      float cal_xi2(const std::vector<float> &res, const int ndat);
-      void setup_matrix(const std::vector<float> &res, const std::vector<float> &dydp, const int npar, const int ndat, std::vector<float> &beta, std::vector<float> &alpha);
-      void solve_matrix(const std::vector<float> &beta, const std::vector<float> &alpha, const int npar, std::vector<float> &dp);
-      float invrt_matrix(std::vector<float> &alphaf, const int npar);
+      void fgauss(const float yd[], const float p[], const int npar, const int ndat, float res[]);
+      void dgauss(const float p[], const int npar, const int ndat, float dydp[]);
+      float cal_xi2(const float res[], const int ndat);
+      void setup_matrix(const float res[], const float dydp[], const int npar, const int ndat, float beta[], float alpha[]);
+      void solve_matrix(const float beta[], const float alpha[], const int npar, float h[], float dp[]);
+      float invrt_matrix(float alphaf[], const int npar);
+
+      /// Returns the workspace of the calling thread
+      static Workspace& threadWorkspace();
 
   };
 
@@ -0,0 +1,277 @@
+/**
+ * @file   MemoryAccounting.h
+ * @brief  Accounting of the live buffers of lardata helpers
+ * @date   October 14, 2026
+ * @see    MemoryReport.h, AllocationAccounting.h
+ *
+ * This is a pure header library.
+ *
+ * Unlike `lar::AllocationAccounting`, this accounting is always enabled: each
+ * registration costs an atomic addition and an atomic comparison for the tag
+ * and as many for the job total, plus plain arithmetic on the scope of the
+ * thread.
+ */
+
+#ifndef LARDATA_UTILITIES_MEMORYACCOUNTING_H
+#define LARDATA_UTILITIES_MEMORYACCOUNTING_H 1
+
+// C/C++ standard libraries
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace lar {
+
+  /// Bytes registered under one tag, and their high-water mark
+  struct MemoryUsage_t {
+    long long live = 0; ///< bytes registered now (may be negative in a scope)
+    long long peak = 0; ///< largest value of `live` so far
+
+    /// Records a change of `delta` bytes
+    void change(long long delta)
+      { live += delta; if (live > peak) peak = live; }
+
+  }; // struct MemoryUsage_t
+
+
+  /**
+   * @brief Registry of the live buffer sizes of lardata helpers
+   *
+   * Helpers owning large buffers (hit collections being created, FFT
+   * workspaces, hit indices of proxies...) register the size of their buffers
+   * under a _tag_, a type with a static member `Name` with the name to be
+   * reported (the same tags as `lar::AllocationAccounting` can be used).
+   * The simplest way is a `lar::MemoryAccount` member, updated with the
+   * current size of the buffer:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * struct WorkspaceMemoryTag
+   *   { static constexpr char const* Name = "Workspace"; };
+   *
+   * lar::MemoryAccount<WorkspaceMemoryTag> fMemory;
+   *
+   * buffer.resize(n);
+   * fMemory.set(buffer.capacity() * sizeof(buffer[0]));
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The changes are added to the usage of the tag for the job and to the
+   * total of the job (`GetUsage()`, `GetTotalUsage()`), each with its
+   * high-water mark. If a scope is set on the thread (`setScope()`), they are
+   * also added to it: this is how `lar::MemoryReport` assigns the peaks to
+   * each module and event. The usage of a scope is relative to its start, so
+   * it is negative when the scope releases buffers registered before.
+   *
+   * At most `MaxTags` tags are supported; further tags share the last one.
+   */
+  class MemoryAccounting {
+      public:
+
+    /// Maximum number of distinct tags
+    static constexpr std::size_t MaxTags = 32U;
+
+    /// Usage of all the tags, by tag ID, in a scope
+    struct Scope_t {
+      std::array<MemoryUsage_t, MaxTags> tags; ///< usage by tag ID
+      MemoryUsage_t total; ///< usage of all the tags together
+
+      /// Resets all the usages
+      void clear() { tags.fill(MemoryUsage_t{}); total = MemoryUsage_t{}; }
+    }; // struct Scope_t
+
+    /// Records a change of `delta` bytes of the buffers under `Tag`
+    template <typename Tag>
+    static void change(long long delta) { change(tagID<Tag>(), delta); }
+
+    /// Records a change of `delta` bytes under the tag with specified ID
+    static void change(std::size_t id, long long delta);
+
+    /// Returns the usage of the job under `Tag`
+    template <typename Tag>
+    static MemoryUsage_t GetUsage() { return GetUsage(tagID<Tag>()); }
+
+    /// Returns the usage of the job under the tag with the specified ID
+    static MemoryUsage_t GetUsage(std::size_t id)
+      { return registry().usage[id].get(); }
+
+    /// Returns the usage of the job of all the tags seen so far, with names
+    static std::vector<std::pair<std::string, MemoryUsage_t>> GetUsage();
+
+    /// Returns the usage of the job of all the tags together
+    static MemoryUsage_t GetTotalUsage() { return registry().total.get(); }
+
+    /// Returns the number of tags seen so far
+    static std::size_t nTags() { return registry().nTags.load(); }
+
+    /// Returns the name of the tag with the specified ID
+    static char const* tagName(std::size_t id) { return registry().names[id]; }
+
+    /// Sets the scope of the changes of this thread; returns the old one
+    static Scope_t* setScope(Scope_t* scope)
+      {
+        Scope_t* const old = currentScope();
+        currentScope() = scope;
+        return old;
+      }
+
+    /// Returns the ID of the specified tag, registering it if needed
+    template <typename Tag>
+    static std::size_t tagID()
+      { static std::size_t const id = registerTag(Tag::Name); return id; }
+
+
+      private:
+
+    /// Job-wide usage of one tag
+    struct AtomicUsage_t {
+      std::atomic<long long> live { 0 };
+      std::atomic<long long> peak { 0 };
+
+      /// Adds `delta` to the live bytes, and raises the peak if needed
+      void change(long long delta);
+
+      /// Returns a snapshot of the usage
+      MemoryUsage_t get() const
+        {
+          return {
+            live.load(std::memory_order_relaxed),
+            peak.load(std::memory_order_relaxed)
+            };
+        }
+    }; // struct AtomicUsage_t
+
+    struct Registry_t {
+      std::atomic<std::size_t> nTags { 0U }; ///< number of registered tags
+      std::array<char const*, MaxTags> names {}; ///< name of each tag
+      std::array<AtomicUsage_t, MaxTags> usage; ///< usage of each tag
+      AtomicUsage_t total; ///< usage of all the tags
+      std::mutex mutex; ///< protects the registration of tags
+    }; // struct Registry_t
+
+    /// Returns the registry of the job
+    static Registry_t& registry() { static Registry_t reg; return reg; }
+
+    /// Returns the scope of this thread
+    static Scope_t*& currentScope()
+      { static thread_local Scope_t* scope = nullptr; return scope; }
+
+    /// Registers a tag with the specified name, and returns its ID
+    static std::size_t registerTag(char const* name);
+
+  }; // class MemoryAccounting
+
+
+  /**
+   * @brief Registration of the size of one buffer under a tag
+   * @tparam Tag tag of the buffer (see `lar::MemoryAccounting`)
+   *
+   * The object holds the size last set, and registers only its changes.
+   * On destruction the size is released. A copy registers the same size
+   * again (like the copy of its buffer would), while a move transfers it.
+   */
+  template <typename Tag>
+  class MemoryAccount {
+      public:
+
+    /// Constructor: no bytes registered
+    MemoryAccount() = default;
+
+    /// Constructor: registers `bytes`
+    explicit MemoryAccount(std::size_t bytes) { set(bytes); }
+
+    MemoryAccount(MemoryAccount const& from): MemoryAccount(from.fBytes) {}
+    MemoryAccount(MemoryAccount&& from) noexcept: fBytes(from.fBytes)
+      { from.fBytes = 0U; }
+
+    MemoryAccount& operator= (MemoryAccount const& from)
+      { set(from.fBytes); return *this; }
+    MemoryAccount& operator= (MemoryAccount&& from) noexcept
+      {
+        if (&from == this) return *this;
+        release();
+        fBytes = from.fBytes;
+        from.fBytes = 0U;
+        return *this;
+      }
+
+    /// Destructor: releases the registered bytes
+    ~MemoryAccount() { release(); }
+
+    /// Sets the size of the buffer, registering the change
+    void set(std::size_t bytes)
+      {
+        if (bytes == fBytes) return;
+        MemoryAccounting::change<Tag>((long long) bytes - (long long) fBytes);
+        fBytes = bytes;
+      }
+
+    /// Releases all the registered bytes
+    void release() { set(0U); }
+
+    /// Returns the registered bytes
+    std::size_t bytes() const { return fBytes; }
+
+      private:
+    std::size_t fBytes = 0U; ///< registered bytes
+
+  }; // class MemoryAccount
+
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline void lar::MemoryAccounting::AtomicUsage_t::change(long long delta) {
+  long long const newLive
+    = live.fetch_add(delta, std::memory_order_relaxed) + delta;
+  long long oldPeak = peak.load(std::memory_order_relaxed);
+  while ((newLive > oldPeak)
+    && !peak.compare_exchange_weak(oldPeak, newLive, std::memory_order_relaxed)
+    );
+} // lar::MemoryAccounting::AtomicUsage_t::change()
+
+
+//------------------------------------------------------------------------------
+inline void lar::MemoryAccounting::change(std::size_t id, long long delta) {
+  Registry_t& reg = registry();
+  reg.usage[id].change(delta);
+  reg.total.change(delta);
+  if (Scope_t* const scope = currentScope()) {
+    scope->tags[id].change(delta);
+    scope->total.change(delta);
+  }
+} // lar::MemoryAccounting::change()
+
+
+//------------------------------------------------------------------------------
+inline auto lar::MemoryAccounting::GetUsage()
+  -> std::vector<std::pair<std::string, MemoryUsage_t>>
+{
+  std::vector<std::pair<std::string, MemoryUsage_t>> result;
+  std::size_t const n = nTags();
+  result.reserve(n);
+  for (std::size_t id = 0; id < n; ++id)
+    result.emplace_back(tagName(id), GetUsage(id));
+  return result;
+} // lar::MemoryAccounting::GetUsage()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t lar::MemoryAccounting::registerTag(char const* name) {
+  Registry_t& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::size_t const n = reg.nTags.load();
+  if (n == MaxTags) return MaxTags - 1U; // shares the last tag
+  reg.names[n] = (n == MaxTags - 1U)? "(other)": name;
+  reg.nTags.store(n + 1U);
+  return n;
+} // lar::MemoryAccounting::registerTag()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATA_UTILITIES_MEMORYACCOUNTING_H
@@ -0,0 +1,105 @@
+/**
+ * @file   MemoryReport.h
+ * @brief  _art_ service reporting the high-water marks of lardata buffers
+ * @date   October 14, 2026
+ * @see    MemoryReport_service.cc, MemoryAccounting.h
+ */
+
+#ifndef LARDATA_UTILITIES_MEMORYREPORT_H
+#define LARDATA_UTILITIES_MEMORYREPORT_H 1
+
+// LArSoft libraries
+#include "lardata/Utilities/MemoryAccounting.h"
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace art { class Event; }
+
+namespace lar {
+
+  /**
+   * @brief Reports the high-water marks of the buffers of lardata helpers.
+   *
+   * The buffer sizes registered with `lar::MemoryAccounting` by each module
+   * while processing an event are assigned to that module, and to the event.
+   * At the end of the job, a summary is printed on the `mf::LogInfo` stream
+   * `MemoryReport`:
+   *
+   * * for each module, the largest peak of the registered bytes in a single
+   *   call (relative to the start of the call), the event it happened in,
+   *   and the peak of each tag;
+   * * the largest events: the peak of the bytes registered by all the
+   *   modules of the event, assuming they run one after the other;
+   * * the high-water mark of each tag in the job, and the bytes still
+   *   registered at its end.
+   *
+   * Only the changes made on the thread running the module are assigned
+   * to it; the others are reported in the job totals.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *TopEvents* (integer, default: 10): number of largest events to report
+   * * *LogEvents* (boolean, default: false): reports the peak of each event
+   *   as it completes
+   */
+  class MemoryReport {
+      public:
+
+    MemoryReport(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+      private:
+
+    /// Peaks of one module
+    struct ModulePeaks_t {
+      std::size_t calls = 0U; ///< event calls of the module
+      long long peak = 0; ///< largest peak of a call
+      art::EventID peakEvent; ///< event with the largest peak
+      std::map<std::string, long long> tagPeaks; ///< largest peak by tag
+    }; // ModulePeaks_t
+
+    /// Usage of one event
+    struct EventUsage_t {
+      art::EventID id; ///< ID of the event
+      lar::MemoryUsage_t usage; ///< bytes registered by its modules
+    }; // EventUsage_t
+
+    std::size_t const fTopEvents; ///< number of largest events to report
+    bool const fLogEvents; ///< whether to report each event
+
+    std::mutex fMutex; ///< protects the following members
+    std::map<std::string, ModulePeaks_t> fModules; ///< by module label
+    std::map<art::ScheduleID, EventUsage_t> fCurrentEvent; ///< by schedule
+    std::vector<EventUsage_t> fLargestEvents; ///< sorted by decreasing peak
+    std::size_t fNEvents = 0U; ///< events processed
+    long long fSumEventPeaks = 0; ///< sum of the peaks of all events
+
+    void preProcessEvent(art::Event const& event, art::ScheduleContext sc);
+    void postProcessEvent(art::Event const& event, art::ScheduleContext sc);
+    void preModule(art::ModuleContext const& mc);
+    void postModule(art::ModuleContext const& mc);
+    void postEndJob();
+
+  }; // class MemoryReport
+
+} // namespace lar
+
+
+DECLARE_ART_SERVICE(lar::MemoryReport, SHARED)
+
+
+#endif // LARDATA_UTILITIES_MEMORYREPORT_H
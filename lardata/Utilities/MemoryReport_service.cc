@@ -0,0 +1,151 @@
+/**
+ * @file   MemoryReport_service.cc
+ * @brief  _art_ service reporting the high-water marks of lardata buffers
+ * @date   October 14, 2026
+ * @see    MemoryReport.h
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/MemoryReport.h"
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max(), std::upper_bound()
+
+
+namespace {
+
+  /// Returns the scope of the module running in this thread
+  lar::MemoryAccounting::Scope_t& moduleScope() {
+    static thread_local lar::MemoryAccounting::Scope_t scope;
+    return scope;
+  } // moduleScope()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+lar::MemoryReport::MemoryReport
+  (fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
+  : fTopEvents(pset.get<std::size_t>("TopEvents", 10U))
+  , fLogEvents(pset.get<bool>("LogEvents", false))
+{
+  fLargestEvents.reserve(fTopEvents + 1U);
+  reg.sPreProcessEvent.watch(this, &MemoryReport::preProcessEvent);
+  reg.sPostProcessEvent.watch(this, &MemoryReport::postProcessEvent);
+  reg.sPreModule.watch(this, &MemoryReport::preModule);
+  reg.sPostModule.watch(this, &MemoryReport::postModule);
+  reg.sPostEndJob.watch(this, &MemoryReport::postEndJob);
+} // lar::MemoryReport::MemoryReport()
+
+
+//------------------------------------------------------------------------------
+void lar::MemoryReport::preProcessEvent
+  (art::Event const& event, art::ScheduleContext sc)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fCurrentEvent[sc.id()] = { event.id(), {} };
+} // lar::MemoryReport::preProcessEvent()
+
+
+//------------------------------------------------------------------------------
+void lar::MemoryReport::postProcessEvent
+  (art::Event const&, art::ScheduleContext sc)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  EventUsage_t const& event = fCurrentEvent[sc.id()];
+  ++fNEvents;
+  fSumEventPeaks += event.usage.peak;
+
+  auto const byPeak = [](EventUsage_t const& a, EventUsage_t const& b)
+    { return a.usage.peak > b.usage.peak; };
+  auto const where = std::upper_bound
+    (fLargestEvents.begin(), fLargestEvents.end(), event, byPeak);
+  if (std::size_t(where - fLargestEvents.begin()) < fTopEvents) {
+    fLargestEvents.insert(where, event);
+    if (fLargestEvents.size() > fTopEvents) fLargestEvents.pop_back();
+  }
+
+  if (fLogEvents) {
+    mf::LogInfo("MemoryReport") << event.id << ": peak of " << event.usage.peak
+      << " bytes, " << event.usage.live << " bytes left registered";
+  }
+} // lar::MemoryReport::postProcessEvent()
+
+
+//------------------------------------------------------------------------------
+void lar::MemoryReport::preModule(art::ModuleContext const&) {
+  MemoryAccounting::Scope_t& scope = moduleScope();
+  scope.clear();
+  MemoryAccounting::setScope(&scope);
+} // lar::MemoryReport::preModule()
+
+
+//------------------------------------------------------------------------------
+void lar::MemoryReport::postModule(art::ModuleContext const& mc) {
+
+  MemoryAccounting::setScope(nullptr);
+  MemoryAccounting::Scope_t const& scope = moduleScope();
+
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  // the peak of the module is on top of what the previous modules left
+  EventUsage_t& event = fCurrentEvent[mc.scheduleID()];
+  event.usage.peak
+    = std::max(event.usage.peak, event.usage.live + scope.total.peak);
+  event.usage.live += scope.total.live;
+
+  ModulePeaks_t& module = fModules[mc.moduleLabel()];
+  ++module.calls;
+  if ((module.calls == 1U) || (scope.total.peak > module.peak)) {
+    module.peak = scope.total.peak;
+    module.peakEvent = event.id;
+  }
+  std::size_t const nTags = MemoryAccounting::nTags();
+  for (std::size_t id = 0; id < nTags; ++id) {
+    MemoryUsage_t const& usage = scope.tags[id];
+    if (usage.peak == 0) continue;
+    long long& tagPeak = module.tagPeaks[MemoryAccounting::tagName(id)];
+    tagPeak = std::max(tagPeak, usage.peak);
+  } // for tags
+
+} // lar::MemoryReport::postModule()
+
+
+//------------------------------------------------------------------------------
+void lar::MemoryReport::postEndJob() {
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  mf::LogInfo log("MemoryReport");
+  log << "High-water marks of lardata buffers in " << fNEvents << " events:";
+  for (auto const& [ label, module ]: fModules) {
+    if (module.tagPeaks.empty()) continue;
+    log << "\n  " << label << ": at most " << module.peak
+      << " bytes in one event (" << module.peakEvent << ")";
+    for (auto const& [ tag, peak ]: module.tagPeaks)
+      log << "\n    " << tag << ": at most " << peak << " bytes";
+  } // for modules
+
+  if (fNEvents > 0U) {
+    log << "\nLargest events (average peak: "
+      << (double(fSumEventPeaks) / fNEvents) << " bytes):";
+    for (EventUsage_t const& event: fLargestEvents)
+      log << "\n  " << event.id << ": " << event.usage.peak << " bytes";
+  }
+
+  MemoryUsage_t const total = MemoryAccounting::GetTotalUsage();
+  log << "\nJob high-water marks by tag (all tags: " << total.peak
+    << " bytes, " << total.live << " still registered):";
+  for (auto const& [ tag, usage ]: MemoryAccounting::GetUsage()) {
+    log << "\n  " << tag << ": " << usage.peak << " bytes, " << usage.live
+      << " still registered";
+  } // for tags
+
+} // lar::MemoryReport::postEndJob()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_SERVICE(lar::MemoryReport)
@@ -0,0 +1,283 @@
+/**
+ * @file   MortonTensorIndices.h
+ * @brief  Flattening of multi-dimension indices in Morton (Z-) order
+ * @date   October 14, 2026
+ * @see    TensorIndices.h
+ *
+ * This header provides:
+ *
+ * * util::MortonTensorIndices: indices in Morton order, with the interface of
+ *   util::TensorIndices
+ *
+ * This is a pure header that contains only template classes.
+ */
+
+#ifndef LARDATA_UTILITIES_MORTONTENSORINDICES_H
+#define LARDATA_UTILITIES_MORTONTENSORINDICES_H
+
+// LArSoft libraries
+#include "lardata/Utilities/TensorIndices.h" // util::TensorIndicesBasicTypes
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <array>
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <string> // std::to_string()
+#include <type_traits> // std::enable_if_t
+
+#ifdef __BMI2__
+#  include <immintrin.h> // _pdep_u64(), _pext_u64()
+#endif // __BMI2__
+
+
+namespace util {
+
+  namespace details {
+
+    /// Spreads the lowest bits of `value` on the set bits of `mask`
+    inline std::uint64_t depositBits(std::uint64_t value, std::uint64_t mask)
+      {
+#ifdef __BMI2__
+        return _pdep_u64(value, mask);
+#else // !__BMI2__
+        std::uint64_t result = 0;
+        for (std::uint64_t bit = 1; mask; bit <<= 1) {
+          std::uint64_t const lowest = mask & -mask;
+          if (value & bit) result |= lowest;
+          mask ^= lowest;
+        }
+        return result;
+#endif // ?__BMI2__
+      } // depositBits()
+
+    /// Collects the bits of `value` on the set bits of `mask` into the lowest
+    inline std::uint64_t extractBits(std::uint64_t value, std::uint64_t mask)
+      {
+#ifdef __BMI2__
+        return _pext_u64(value, mask);
+#else // !__BMI2__
+        std::uint64_t result = 0;
+        for (std::uint64_t bit = 1; mask; bit <<= 1) {
+          std::uint64_t const lowest = mask & -mask;
+          if (value & lowest) result |= bit;
+          mask ^= lowest;
+        }
+        return result;
+#endif // ?__BMI2__
+      } // extractBits()
+
+  } // namespace details
+
+
+  /**
+   * @brief Converts tensor indices into a linear index in Morton order
+   * @tparam RANK rank of the tensor
+   *
+   * This class has the same interface as `util::TensorIndices`, but the
+   * linear index is the Morton (or Z-order) code of the indices: the bits of
+   * the indices of all dimensions are interleaved, the lowest bit coming
+   * from the last dimension. Elements close to each other in any dimension
+   * are then usually close also in the linear index, while in row-major order
+   * only the elements close in the last dimension are.
+   *
+   * Each dimension is rounded up to the next power of 2: the linear index
+   * runs up to the product of the rounded dimensions (`size()`), and some of
+   * the values in that range (the padding) do not correspond to any valid
+   * element. The total number of bits must not exceed 64.
+   *
+   * The interleaving uses the BMI2 instructions `pdep` and `pext` when the
+   * compiler targets them (`__BMI2__` defined, e.g. with `-mbmi2` or
+   * `-march=haswell`), and a bit loop otherwise.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * util::MortonTensorIndices<3> indices(100, 100, 50);
+   * std::vector<double> v(indices.size(), 0.);
+   * v[indices(12, 34, 5)] = 1.0;
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <unsigned int RANK>
+  class MortonTensorIndices {
+    static_assert(RANK > 0, "MortonTensorIndices must have rank 1 or higher");
+
+      public:
+
+    /// Type of a single index in the tensor
+    using Index_t    = TensorIndicesBasicTypes::Index_t   ;
+
+    /// Type for the specification of a dimension size
+    using DimSize_t  = TensorIndicesBasicTypes::DimSize_t ;
+
+    /// Type of the linear index
+    using LinIndex_t = TensorIndicesBasicTypes::LinIndex_t;
+
+    /// Type of bit mask of the linear index
+    using Mask_t = std::uint64_t;
+
+
+    /// Rank of this tensor
+    static constexpr unsigned int rank() { return RANK; }
+
+
+    /// Constructor: initialises the dimensions of the tensor
+    template <typename... DIMS>
+    MortonTensorIndices(DimSize_t first, DIMS... others)
+      : MortonTensorIndices
+        (std::array<DimSize_t, RANK>{{ first, DimSize_t(others)... }}.begin())
+      {
+        static_assert(sizeof...(DIMS) + 1 == RANK,
+          "Wrong number of dimensions for MortonTensorIndices");
+      }
+
+    /// Constructor: initialises the dimensions from `rank()` values
+    template <
+      typename ITER,
+      typename = std::enable_if_t
+        <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, void>
+      >
+    MortonTensorIndices(ITER dimIter)
+      {
+        for (unsigned int d = 0; d < RANK; ++d, ++dimIter) dims[d] = *dimIter;
+        buildMasks();
+      }
+
+
+    /// Returns the linear index of the indices pointed by `indexIter`
+    /// (no check on the validity of the indices)
+    template <typename ITER>
+    std::enable_if_t
+      <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, LinIndex_t>
+    operator() (ITER indexIter) const
+      {
+        Mask_t linIndex = 0;
+        for (unsigned int d = 0; d < RANK; ++d, ++indexIter)
+          linIndex |= details::depositBits(Mask_t(*indexIter), masks[d]);
+        return LinIndex_t(linIndex);
+      }
+
+    /// Returns the linear index of the specified indices (no check)
+    template <typename... INDICES>
+    LinIndex_t operator() (Index_t first, INDICES... others) const
+      {
+        static_assert(sizeof...(INDICES) + 1 == RANK,
+          "Wrong number of indices for MortonTensorIndices");
+        std::array<Index_t, RANK> const indices {{ first, Index_t(others)... }};
+        return operator()(indices.begin());
+      }
+
+    /// Returns the linear index of the specified indices
+    /// @throw std::out_of_range if any index is not valid
+    template <typename ITER>
+    std::enable_if_t
+      <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, LinIndex_t>
+    at(ITER indexIter) const
+      {
+        ITER iter = indexIter;
+        for (unsigned int d = 0; d < RANK; ++d, ++iter) {
+          if (hasIndex(d, *iter)) continue;
+          throw std::out_of_range("Requested index " + std::to_string(*iter)
+            + " for dimension #" + std::to_string(d) + " of size "
+            + std::to_string(dims[d]));
+        }
+        return operator()(indexIter);
+      }
+
+    /// Returns the indices of the element with the specified linear index
+    std::array<Index_t, RANK> indices(LinIndex_t linIndex) const
+      {
+        std::array<Index_t, RANK> indices;
+        for (unsigned int d = 0; d < RANK; ++d)
+          indices[d] = Index_t(details::extractBits(linIndex, masks[d]));
+        return indices;
+      }
+
+
+    /// Returns whether all the indices pointed by `indexIter` are valid
+    template <typename ITER>
+    std::enable_if_t
+      <std::is_convertible<decltype(*(ITER())), DimSize_t>::value, bool>
+    has(ITER indexIter) const
+      {
+        for (unsigned int d = 0; d < RANK; ++d, ++indexIter)
+          if (!hasIndex(d, *indexIter)) return false;
+        return true;
+      }
+
+    /// Returns whether the specified index is valid for dimension `DIM`
+    template <unsigned int DIM>
+    bool hasIndex(Index_t index) const
+      {
+        static_assert(DIM < RANK, "Invalid dimension requested");
+        return hasIndex(DIM, index);
+      }
+
+    /// Returns whether the linear index is in the range (padding included)
+    bool hasLinIndex(LinIndex_t linIndex) const { return linIndex < size(); }
+
+
+    /// Returns the size of the linear index range (padding included)
+    DimSize_t size() const { return totSize; }
+
+    /// Returns the size of the specified dimension
+    template <unsigned int DIM>
+    DimSize_t dim() const
+      {
+        static_assert(DIM < RANK, "Invalid dimension requested");
+        return dims[DIM];
+      }
+
+    /// Returns the bits of the linear index encoding the dimension `d`
+    Mask_t mask(unsigned int d) const { return masks[d]; }
+
+
+    /// Returns whether all sizes of the tensor t are the same as this one
+    bool operator== (MortonTensorIndices<RANK> const& t) const
+      { return dims == t.dims; }
+
+    /// Returns whether any size of the tensor t is different from this one
+    bool operator!= (MortonTensorIndices<RANK> const& t) const
+      { return dims != t.dims; }
+
+
+      private:
+    std::array<DimSize_t, RANK> dims; ///< size of each dimension
+    std::array<Mask_t, RANK> masks; ///< bits of each dimension in the index
+    DimSize_t totSize = 1; ///< size of the linear index range
+
+    bool hasIndex(unsigned int d, Index_t index) const
+      { return (index >= 0) && ((DimSize_t) index < dims[d]); }
+
+    /// Assigns the bits of the linear index to the dimensions, round robin
+    void buildMasks()
+      {
+        std::array<unsigned int, RANK> nBits;
+        unsigned int totBits = 0;
+        for (unsigned int d = 0; d < RANK; ++d) {
+          nBits[d] = 0;
+          while ((DimSize_t(1) << nBits[d]) < dims[d]) ++nBits[d];
+          totBits += nBits[d];
+          masks[d] = 0;
+        } // for
+        if (totBits > 64) {
+          throw std::length_error("MortonTensorIndices: "
+            + std::to_string(totBits) + " bits required, only 64 supported");
+        }
+        unsigned int bit = 0;
+        while (bit < totBits) {
+          for (unsigned int d = RANK; d-- > 0; ) {
+            if (nBits[d] == 0) continue;
+            masks[d] |= Mask_t(1) << bit++;
+            --nBits[d];
+          } // for dimensions
+        } // while
+        totSize = (totBits == 64)? ~DimSize_t(0): (DimSize_t(1) << totBits);
+      } // buildMasks()
+
+  }; // class MortonTensorIndices<>
+
+
+} // namespace util
+
+
+#endif // LARDATA_UTILITIES_MORTONTENSORINDICES_H
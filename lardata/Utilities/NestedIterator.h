@@ -14,6 +14,11 @@
 // interface include
 #include <type_traits> // std::true_type, std::false_type, std::conditional
 #include <iterator> // std::forward_iterator_tag
+#include <vector>
+#include <algorithm> // std::upper_bound()
+#include <stdexcept> // std::out_of_range
+#include <string> // std::to_string()
+#include <cstddef> // std::size_t
 
 namespace lar {
 
@@ -76,6 +81,22 @@ namespace lar {
   using double_fwd_const_iterator
     = deep_const_fwd_iterator_nested<CITER, INNERCONTEXTRACT>;
 
+
+  /// Index of a container of containers, flattened into a single sequence
+  template <
+    typename CONT,
+    typename INNERCONTEXTRACT = Identity<typename CONT::value_type>
+    >
+  class flattened_nested;
+
+  /// Returns a flattened index of the specified container of containers
+  template <typename CONT>
+  flattened_nested<CONT> flatten_nested(const CONT& cont);
+
+  /// Returns a flattened index of the specified container of containers
+  template <typename INNERCONTEXTRACT, typename CONT>
+  flattened_nested<CONT, INNERCONTEXTRACT> flatten_nested(const CONT& cont);
+
 } // namespace lar
 
 
@@ -313,6 +334,120 @@ namespace lar {
   }; // class deep_const_fwd_iterator_nested<>
 
 
+  //---
+  //--- flattened_nested declaration
+  //---
+  /**
+   * @brief Index of a container of containers, flattened into one sequence
+   * @tparam CONT type of the outer container
+   * @tparam INNERCONTEXTRACT functor returning the inner container out of
+   *         an element of the outer one (like in `deep_const_fwd_iterator_nested`)
+   *
+   * While `deep_const_fwd_iterator_nested` walks the nested structure one
+   * element after the other, checking at each step for the end of the current
+   * inner container, this object "flattens" the structure once: it records the
+   * inner containers together with a prefix sum of their sizes (the flattened
+   * index of the first element of each of them).
+   * After that, the element with flattened index `i` is found with a binary
+   * search on the offsets of the inner containers (no scan of the elements),
+   * and any range of flattened indices can be visited independently of the
+   * others. For example, the hits of all the clusters can be split among
+   * threads:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::vector<std::vector<float>> data;
+   * // ...
+   * auto const flat = lar::flatten_nested(data);
+   * tbb::parallel_for(tbb::blocked_range<std::size_t>(0, flat.size()),
+   *   [&flat](tbb::blocked_range<std::size_t> const& r)
+   *     { flat.for_each(r.begin(), r.end(), [](float v){ ... }); }
+   *   );
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The inner containers should have random access iterators, for the element
+   * to be reached in constant time once its inner container is found.
+   *
+   * The index refers to the original containers, which must outlive it and
+   * must not change size after it is created. All the methods are constant,
+   * and the index can be used by many threads at the same time.
+   */
+  template <typename CONT, typename INNERCONTEXTRACT>
+  class flattened_nested {
+      public:
+    using OuterContainer_t = CONT;
+    using InnerContainerExtractor_t = INNERCONTEXTRACT;
+    using InnerContainer_t = std::remove_cv_t
+      <typename InnerContainerExtractor_t::result_type>;
+
+    /// Type of the elements of the inner containers
+    using value_type = typename InnerContainer_t::value_type;
+    using size_type = std::size_t;
+
+    /// Position of an element in the nested structure
+    struct Position_t {
+      size_type outer; ///< index of the inner container in the outer one
+      size_type inner; ///< index of the element in its inner container
+    }; // struct Position_t
+
+    /// Constructor: indexes all the elements of the specified container
+    explicit flattened_nested(const OuterContainer_t& cont);
+
+    /// Returns the total number of elements
+    size_type size() const { return offsets_.back(); }
+
+    /// Returns whether there is no element at all
+    bool empty() const { return size() == 0; }
+
+    /// Returns the number of inner containers
+    size_type n_inner() const { return inner_.size(); }
+
+    /// Returns the flattened index of the first element of the `outer`-th
+    /// inner container (`n_inner()` for the total number of elements)
+    size_type offset(size_type outer) const { return offsets_[outer]; }
+
+    /// Returns the flattened index of the first element of each container,
+    /// and the total number of elements at the end
+    const std::vector<size_type>& offsets() const { return offsets_; }
+
+    /// Returns the position in the nested structure of the element `i`
+    Position_t locate(size_type i) const;
+
+    /// Returns the element with flattened index `i` (no range check)
+    const value_type& operator[] (size_type i) const
+      { return element(locate(i)); }
+
+    /// Returns the element with flattened index `i`
+    /// @throw std::out_of_range if `i` is not smaller than `size()`
+    const value_type& at(size_type i) const;
+
+    /// Returns the element at the specified position
+    const value_type& element(Position_t const& pos) const
+      { return *std::next(std::begin(*(inner_[pos.outer])), pos.inner); }
+
+    /**
+     * @brief Calls `f(value)` on the elements from `first` to before `last`
+     * @param first flattened index of the first element to be visited
+     * @param last flattened index after the last element to be visited
+     * @param f functor to be called
+     *
+     * The first element is located once, then the elements are visited in
+     * sequence.
+     */
+    template <typename Func>
+    void for_each(size_type first, size_type last, Func&& f) const;
+
+    /// Calls `f(value)` on all the elements
+    template <typename Func>
+    void for_each(Func&& f) const { for_each(0, size(), f); }
+
+      private:
+    /// Inner containers, in the order of the outer one
+    std::vector<const InnerContainer_t*> inner_;
+
+    /// Offset of each inner container in the sequence, and total at the end
+    std::vector<size_type> offsets_;
+
+  }; // class flattened_nested<>
+
+
   //---
   //--- deep_const_fwd_iterator_nested implementation
   //---
@@ -373,6 +508,78 @@ namespace lar {
   } // skip_empty()
 
 
+  //---
+  //--- flattened_nested implementation
+  //---
+  template <typename CONT, typename INNERCONTEXTRACT>
+  flattened_nested<CONT, INNERCONTEXTRACT>::flattened_nested
+    (const OuterContainer_t& cont)
+  {
+    InnerContainerExtractor_t extract;
+    offsets_.push_back(0);
+    for (const auto& elem: cont) {
+      const InnerContainer_t& inner = extract(elem);
+      inner_.push_back(&inner);
+      offsets_.push_back(offsets_.back() + inner.size());
+    } // for
+  } // flattened_nested<>::flattened_nested()
+
+
+  template <typename CONT, typename INNERCONTEXTRACT>
+  auto flattened_nested<CONT, INNERCONTEXTRACT>::locate(size_type i) const
+    -> Position_t
+  {
+    // the last inner container starting at or before i is the one with i
+    // (empty containers start where the next one does, and are skipped)
+    auto const iNext
+      = std::upper_bound(offsets_.cbegin(), offsets_.cend(), i);
+    size_type const outer = (iNext - offsets_.cbegin()) - 1;
+    return { outer, i - offsets_[outer] };
+  } // flattened_nested<>::locate()
+
+
+  template <typename CONT, typename INNERCONTEXTRACT>
+  auto flattened_nested<CONT, INNERCONTEXTRACT>::at(size_type i) const
+    -> const value_type&
+  {
+    if (i >= size()) {
+      throw std::out_of_range("flattened_nested index out of range: "
+        + std::to_string(i) + " >= " + std::to_string(size()));
+    }
+    return operator[](i);
+  } // flattened_nested<>::at()
+
+
+  template <typename CONT, typename INNERCONTEXTRACT>
+  template <typename Func>
+  void flattened_nested<CONT, INNERCONTEXTRACT>::for_each
+    (size_type first, size_type last, Func&& f) const
+  {
+    if (first >= last) return;
+    Position_t pos = locate(first);
+    auto iElem = std::next(std::begin(*(inner_[pos.outer])), pos.inner);
+    auto iEnd = std::end(*(inner_[pos.outer]));
+    for (size_type n = last - first; n > 0; --n) {
+      while (iElem == iEnd) { // move to the next non-empty container
+        ++pos.outer;
+        iElem = std::begin(*(inner_[pos.outer]));
+        iEnd = std::end(*(inner_[pos.outer]));
+      } // while
+      f(*iElem);
+      ++iElem;
+    } // for
+  } // flattened_nested<>::for_each()
+
+
+  template <typename CONT>
+  flattened_nested<CONT> flatten_nested(const CONT& cont)
+    { return flattened_nested<CONT>(cont); }
+
+  template <typename INNERCONTEXTRACT, typename CONT>
+  flattened_nested<CONT, INNERCONTEXTRACT> flatten_nested(const CONT& cont)
+    { return flattened_nested<CONT, INNERCONTEXTRACT>(cont); }
+
+
 } // namespace lar
 
 
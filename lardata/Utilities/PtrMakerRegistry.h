@@ -0,0 +1,172 @@
+/**
+ * @file   lardata/Utilities/PtrMakerRegistry.h
+ * @brief  Event-scoped collection of _art_ pointer makers.
+ * @date   October 14, 2026
+ * @see    lardata/Utilities/AssociationUtil.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARDATA_UTILITIES_PTRMAKERREGISTRY_H
+#define LARDATA_UTILITIES_PTRMAKERREGISTRY_H
+
+// framework libraries
+#include "art/Framework/Principal/Event.h"
+#include "art/Persistency/Common/PtrMaker.h"
+#include "canvas/Persistency/Common/Ptr.h"
+
+// C/C++ standard libraries
+#include <memory> // std::unique_ptr<>
+#include <vector>
+#include <string>
+#include <typeindex>
+#include <typeinfo> // typeid
+#include <utility> // std::move()
+#include <cassert>
+#include <cstddef> // std::size_t
+
+
+namespace util {
+
+  /**
+   * @brief Collection of `art::PtrMaker`, one per data product.
+   *
+   * Creating an `art::PtrMaker` requires the lookup of the product ID of the
+   * data product it points into. Modules producing many collections and
+   * associations among them end up creating the same pointer makers several
+   * times (in `CreateAssn()` calls and in the data product helpers, like
+   * `recob::HitCollectionCreator`). This registry creates each pointer maker
+   * only once per event, and shares it with all the helpers given the
+   * registry.
+   *
+   * The pointer makers are identified by the type of the element of the data
+   * product (`std::vector<T>`) and by the product instance name. The first
+   * request of a maker returns a `Slot`, which can be used afterwards to
+   * reach the maker by index, without any lookup:
+   *
+   *     void MyProducer::produce(art::Event& event) {
+   *
+   *       util::PtrMakerRegistry ptrMakers { event };
+   *       recob::HitCollectionCreator hits { ptrMakers, "", true, false };
+   *
+   *       auto const clusterSlot = ptrMakers.slot<recob::Cluster>();
+   *       util::AssnsBuilder<recob::Cluster, recob::Hit> clusterHits
+   *         { ptrMakers, *clusterHitAssns };
+   *       // ...
+   *       art::Ptr<recob::Cluster> const cluster
+   *         = ptrMakers.makePtr(clusterSlot, iCluster);
+   *
+   *     }
+   *
+   * The registry must not outlive the event it is constructed with, and it is
+   * not thread-safe.
+   */
+  class PtrMakerRegistry {
+
+    /// Registry element, with pointer maker type erased.
+    struct EntryBase {
+      std::type_index type; ///< Type of the element of the data product.
+      std::string instance; ///< Instance name of the data product.
+
+      EntryBase(std::type_index type, std::string instance)
+        : type(type), instance(std::move(instance)) {}
+      virtual ~EntryBase() = default;
+    }; // EntryBase
+
+    /// Registry element with the pointer maker.
+    template <typename T>
+    struct Entry: EntryBase {
+      art::PtrMaker<T> maker; ///< The pointer maker.
+
+      Entry(art::Event& event, std::string const& instance)
+        : EntryBase(typeid(T), instance), maker(event, instance) {}
+    }; // Entry<>
+
+      public:
+
+    /// Index of a pointer maker in the registry, for creating `art::Ptr<T>`.
+    template <typename T>
+    class Slot {
+      friend class PtrMakerRegistry;
+      std::size_t fIndex; ///< Index of the maker in the registry.
+      explicit Slot(std::size_t index): fIndex(index) {}
+        public:
+      /// Returns the index of the maker in the registry.
+      std::size_t index() const { return fIndex; }
+    }; // Slot<>
+
+
+    /// Constructor: pointer makers will point into the products of `event`.
+    explicit PtrMakerRegistry(art::Event& event): fEvent(event) {}
+
+    /// Returns the event the pointer makers are bound to.
+    art::Event& event() const { return fEvent; }
+
+    /// Returns the number of pointer makers created so far.
+    std::size_t size() const { return fEntries.size(); }
+
+
+    /**
+     * @brief Returns the slot of the pointer maker for the specified product.
+     * @tparam T type of the elements of the data product (`std::vector<T>`)
+     * @param instance instance name of the data product
+     * @return the slot of the maker
+     *
+     * The maker is created if not present yet.
+     */
+    template <typename T>
+    Slot<T> slot(std::string const& instance = {});
+
+    /// Returns the pointer maker in the specified slot.
+    template <typename T>
+    art::PtrMaker<T> const& maker(Slot<T> slot) const
+      {
+        assert(slot.index() < fEntries.size());
+        return static_cast<Entry<T> const&>(*fEntries[slot.index()]).maker;
+      }
+
+    /// Returns the pointer maker for the specified product, creating it.
+    template <typename T>
+    art::PtrMaker<T> const& maker(std::string const& instance = {})
+      { return maker(slot<T>(instance)); }
+
+    /// Returns a pointer to the element `index` of the product in `slot`.
+    template <typename T>
+    art::Ptr<T> makePtr(Slot<T> slot, std::size_t index) const
+      { return maker(slot)(index); }
+
+
+      private:
+
+    art::Event& fEvent; ///< Event the pointers point into.
+
+    /// All the pointer makers (address of each one stays the same).
+    std::vector<std::unique_ptr<EntryBase>> fEntries;
+
+  }; // class PtrMakerRegistry
+
+
+} // namespace util
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename T>
+auto util::PtrMakerRegistry::slot(std::string const& instance /* = {} */)
+  -> Slot<T>
+{
+  std::type_index const type { typeid(T) };
+  for (std::size_t i = 0; i < fEntries.size(); ++i) {
+    EntryBase const& entry = *fEntries[i];
+    if ((entry.type == type) && (entry.instance == instance)) return Slot<T>(i);
+  } // for
+
+  fEntries.push_back(std::make_unique<Entry<T>>(fEvent, instance));
+  return Slot<T>(fEntries.size() - 1);
+} // util::PtrMakerRegistry::slot()
+
+
+//------------------------------------------------------------------------------
+
+#endif // LARDATA_UTILITIES_PTRMAKERREGISTRY_H
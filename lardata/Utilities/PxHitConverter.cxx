@@ -49,40 +49,58 @@ namespace util {
   PxHit PxHitConverter::HitToPxHit(recob::Hit const& hit) const
   {
 
-    util::GeometryUtilities  gser;
+    double wireToCm, timeToCm;
+    ConversionFactors(wireToCm, timeToCm);
 
     PxHit pxhit;
-    pxhit.t      = hit.PeakTime() * gser.TimeToCm();
-    pxhit.w      = hit.WireID().Wire * gser.WireToCm();
+    FillPxHit(hit, wireToCm, timeToCm, pxhit);
+
+    return pxhit;
+  } // PxHitConverter::HitToPxHit(recob::Hit)
+
+
+  void PxHitConverter::ConversionFactors
+    (double& wireToCm, double& timeToCm) const
+  {
+    // the shared object is built only after the services change
+    std::shared_ptr<const util::GeometryUtilities> gser
+      = util::GeometryUtilities::Current();
+    wireToCm = gser->WireToCm();
+    timeToCm = gser->TimeToCm();
+  } // PxHitConverter::ConversionFactors()
+
+
+  void PxHitConverter::FillPxHit(recob::Hit const& hit,
+				 double wireToCm, double timeToCm,
+				 util::PxHit& pxhit)
+  {
+    pxhit.t      = hit.PeakTime() * timeToCm;
+    pxhit.w      = hit.WireID().Wire * wireToCm;
     pxhit.charge = hit.Integral();
     pxhit.sumADC = hit.SummedADC();
     pxhit.peak   = hit.PeakAmplitude();
     pxhit.plane  = hit.WireID().Plane;
-
-    return pxhit;
-  } // PxHitConverter::HitToPxHit(recob::Hit)
+  } // PxHitConverter::FillPxHit()
 
 
 
   /// Generate: from 1 set of hits => 1 set of PxHits using indexes (association)
   void PxHitConverter::GeneratePxHit(const std::vector<unsigned int>& hit_index,
-				     const std::vector<art::Ptr<recob::Hit>> hits,
+				     const std::vector<art::Ptr<recob::Hit>>& hits,
 				     std::vector<util::PxHit> &pxhits) const
   {
 
     if(!(hit_index.size())) throw UtilException(Form("Hit list empty! (%s)",__FUNCTION__));
 
-    pxhits.clear();
-    pxhits.reserve(hit_index.size());
+    double wireToCm, timeToCm;
+    ConversionFactors(wireToCm, timeToCm);
 
-    for(auto const& index : hit_index) {
+    pxhits.resize(hit_index.size());
 
-      auto const& hit = hits[index];
+    for(size_t i = 0; i < hit_index.size(); ++i) {
 
-      PxHit h;
-      GenerateSinglePxHit(hit,h);
+      FillPxHit(*(hits[hit_index[i]]), wireToCm, timeToCm, pxhits[i]);
 
-      pxhits.push_back(h);
     }
 
   }
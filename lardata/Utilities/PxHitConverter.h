@@ -17,6 +17,7 @@
 #include "canvas/Persistency/Common/Ptr.h"
 
 #include <algorithm>
+#include <cstddef> // std::size_t
 #include <type_traits>
 #include <vector>
 
@@ -24,6 +25,48 @@
 ///General LArSoft Utilities
 namespace util{
 
+  /**
+   * @brief Hits in "structure of arrays" layout
+   *
+   * The same information as a `std::vector<util::PxHit>`, with each data
+   * member in its own array, so that algorithms can run vectorized over,
+   * e.g., all the wire coordinates.
+   * The arrays keep their memory when cleared, so the same object can be
+   * filled again at each event with no new allocation.
+   */
+  struct PxHitArrays {
+    std::vector<double> w;      ///< wire distance in cm
+    std::vector<double> t;      ///< time distance in cm (drift distance)
+    std::vector<double> charge; ///< area charge
+    std::vector<double> sumADC; ///< sum of ADCs
+    std::vector<double> peak;   ///< peak amplitude
+    std::vector<unsigned int> plane; ///< plane number
+
+    /// Returns the number of hits
+    std::size_t size() const { return w.size(); }
+
+    /// Returns whether there is no hit
+    bool empty() const { return w.empty(); }
+
+    /// Sets the number of hits (the new ones have undefined values)
+    void resize(std::size_t n)
+      {
+        w.resize(n); t.resize(n); charge.resize(n);
+        sumADC.resize(n); peak.resize(n); plane.resize(n);
+      }
+
+    /// Removes all the hits (the memory is kept)
+    void clear() { resize(0U); }
+
+    /// Returns the hit with index `i` as a `PxHit` object
+    util::PxHit hit(std::size_t i) const
+      {
+        util::PxHit pxhit(plane[i], w[i], t[i], charge[i], sumADC[i], peak[i]);
+        return pxhit;
+      }
+
+  }; // struct PxHitArrays
+
 
   //class GeometryUtilities : public larlight::larlight_base {
   class PxHitConverter {
@@ -47,7 +90,7 @@ namespace util{
 
     /// Generate: from 1 set of hits => 1 set of PxHits using indexes (association)
     void GeneratePxHit(const std::vector<unsigned int>& hit_index,
-		       const std::vector<art::Ptr<recob::Hit>> hits,
+		       const std::vector<art::Ptr<recob::Hit>>& hits,
 		       std::vector<util::PxHit> &pxhits) const;
 
       /// Generate: from 1 set of hits => 1 set of PxHits using using all hits
@@ -83,6 +126,30 @@ namespace util{
     template <typename Cont, typename Hit = typename Cont::value_type>
     std::vector<util::PxHit> ToPxHitVector(Cont const& hits) const;
 
+    /**
+     * @brief Converts hits into arrays of coordinates
+     * @tparam Cont type of container of hits or of pointers to hits
+     * @param hits the hits to be converted
+     * @param arrays (output) where to store the converted hits
+     *
+     * The content of `arrays` is replaced (its memory is reused).
+     * The conversion factors are obtained once for all the hits.
+     */
+    template <typename Cont>
+    void ToPxHitArrays(Cont const& hits, util::PxHitArrays& arrays) const;
+
+    /// Returns the wire and time conversion factors to cm
+    void ConversionFactors(double& wireToCm, double& timeToCm) const;
+
+      private:
+
+    /// Fills `pxhit` from `hit`, with the specified conversion factors
+    static void FillPxHit(recob::Hit const& hit,
+			  double wireToCm, double timeToCm,
+			  util::PxHit& pxhit);
+
+      public:
+
 
 
 
@@ -119,13 +186,55 @@ template <typename Cont, typename Hit /* = typename Cont::value_type */>
 std::vector<util::PxHit> util::PxHitConverter::ToPxHitVector
   (Cont const& hits) const
 {
-  std::vector<util::PxHit> pxhits;
-  pxhits.reserve(hits.size());
-  std::transform(hits.begin(), hits.end(), std::back_inserter(pxhits),
-    [this](Hit const& hit) { return this->ToPxHit(hit); });
+  static_assert(
+    std::is_convertible<
+      typename lar::util::dereferenced_type<Hit>::type,
+      recob::Hit
+    >::value,
+    "PxHitConverter::ToPxHitVector() requires a container of recob::Hit"
+    );
+
+  double wireToCm, timeToCm;
+  ConversionFactors(wireToCm, timeToCm);
+
+  std::vector<util::PxHit> pxhits(hits.size());
+  auto iPxHit = pxhits.begin();
+  for (Hit const& hit: hits)
+    FillPxHit(lar::util::dereference(hit), wireToCm, timeToCm, *(iPxHit++));
   return pxhits;
 } // util::PxHitConverter::ToPxHitVector()
 
 
+template <typename Cont>
+void util::PxHitConverter::ToPxHitArrays
+  (Cont const& hits, util::PxHitArrays& arrays) const
+{
+  using Hit = typename Cont::value_type;
+  static_assert(
+    std::is_convertible<
+      typename lar::util::dereferenced_type<Hit>::type,
+      recob::Hit
+    >::value,
+    "PxHitConverter::ToPxHitArrays() requires a container of recob::Hit"
+    );
+
+  double wireToCm, timeToCm;
+  ConversionFactors(wireToCm, timeToCm);
+
+  arrays.resize(hits.size());
+  std::size_t i = 0;
+  for (Hit const& hitObj: hits) {
+    recob::Hit const& hit = lar::util::dereference(hitObj);
+    arrays.w[i]      = hit.WireID().Wire * wireToCm;
+    arrays.t[i]      = hit.PeakTime() * timeToCm;
+    arrays.charge[i] = hit.Integral();
+    arrays.sumADC[i] = hit.SummedADC();
+    arrays.peak[i]   = hit.PeakAmplitude();
+    arrays.plane[i]  = hit.WireID().Plane;
+    ++i;
+  } // for
+} // util::PxHitConverter::ToPxHitArrays()
+
+
 
 #endif // UTIL_PXHITCONVERTER_H
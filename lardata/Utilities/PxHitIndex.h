@@ -0,0 +1,325 @@
+/**
+ * @file   PxHitIndex.h
+ * @brief  Spatial index of hits on a (wire, time) plane
+ * @date   October 14, 2026
+ * @see    PxUtils.h, GridContainers.h
+ *
+ * This is a pure header library.
+ */
+
+#ifndef LARDATA_UTILITIES_PXHITINDEX_H
+#define LARDATA_UTILITIES_PXHITINDEX_H 1
+
+// LArSoft libraries
+#include "lardata/Utilities/PxUtils.h"
+#include "lardata/Utilities/GridContainers.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <array>
+#include <algorithm> // std::min(), std::max()
+#include <cmath> // std::floor(), std::ceil(), std::sqrt(), std::isfinite()
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits<>
+
+
+namespace util {
+
+  /**
+   * @brief Uniform grid of hits on a (wire, time) plane, for fast look-up
+   *
+   * The index is built once from a list of hits (typically, all the hits of
+   * a plane), and then answers queries about the hits close to a point
+   * without scanning all of them:
+   * * `closest()` returns the hit nearest to a point;
+   * * `forEachInBox()` and `inBox()` visit the hits within a rectangle.
+   *
+   * The hits are identified by their position in the original list; the
+   * index keeps a copy of their coordinates, sorted by cell, so it does not
+   * need the list any more. Coordinates are in whatever units the hits are
+   * (usually cm/cm for `PxHit`).
+   *
+   * The area covered by the hits is split into cells; unless specified, the
+   * cell size is chosen so that there are about `HitsPerCell` hits per cell
+   * on average. Queries cost the number of cells covered plus the number of
+   * hits in them.
+   */
+  class PxHitIndex {
+      public:
+
+    using Index_t = unsigned int; ///< type of index of the hit in the list
+
+    /// Value returned by `closest()` when there is no hit
+    static constexpr Index_t npos = std::numeric_limits<Index_t>::max();
+
+    /// Average number of hits per cell when the size is chosen automatically
+    static constexpr double HitsPerCell = 2.0;
+
+    /// Coordinates of a hit, and its position in the original list
+    struct Entry_t {
+      double w;      ///< wire coordinate
+      double t;      ///< time coordinate
+      Index_t index; ///< position of the hit in the original list
+    }; // struct Entry_t
+
+    /**
+     * @brief Constructor: indexes the specified hits
+     * @param hits the hits to be indexed
+     * @param cellW size of the cells in wire direction (`0`: automatic)
+     * @param cellT size of the cells in time direction (`0`: automatic)
+     *
+     * Hits with non-finite coordinates are not indexed.
+     */
+    PxHitIndex
+      (std::vector<util::PxHit> const& hits, double cellW = 0., double cellT = 0.)
+      : fGrid(Setup(hits, cellW, cellT))
+      {
+        for (std::size_t i = 0; i < hits.size(); ++i) {
+          util::PxHit const& hit = hits[i];
+          if (!std::isfinite(hit.w) || !std::isfinite(hit.t)) continue;
+          fGrid.stage(cellOf(hit.w, hit.t), Entry_t{ hit.w, hit.t, Index_t(i) });
+          ++fNHits;
+        } // for
+        fGrid.freeze();
+      }
+
+    /// Returns the number of indexed hits
+    std::size_t size() const { return fNHits; }
+
+    /// Returns whether there is no indexed hit
+    bool empty() const { return size() == 0; }
+
+    /// Returns the size of the cells in wire direction
+    double cellSizeW() const { return fCellW; }
+
+    /// Returns the size of the cells in time direction
+    double cellSizeT() const { return fCellT; }
+
+    /**
+     * @brief Calls `op` on all the hits in the cells overlapping a rectangle
+     * @param wMin lower wire coordinate of the rectangle
+     * @param wMax upper wire coordinate of the rectangle
+     * @param tMin lower time coordinate of the rectangle
+     * @param tMax upper time coordinate of the rectangle
+     * @param op operation called with each `Entry_t const&`
+     *
+     * All the hits within the rectangle are visited, and some outside it
+     * too (the ones sharing a cell with the rectangle): `op` should check the
+     * coordinates of the entry. The order of the hits is unspecified.
+     */
+    template <typename Op>
+    void forEachInBox
+      (double wMin, double wMax, double tMin, double tMax, Op op) const;
+
+    /// Returns the indices of the hits within a rectangle (borders included),
+    /// in increasing order
+    std::vector<Index_t> inBox
+      (double wMin, double wMax, double tMin, double tMax) const;
+
+    /**
+     * @brief Returns the index of the hit closest to a point
+     * @param w wire coordinate of the point
+     * @param t time coordinate of the point
+     * @param wScale factor applied to wire distances
+     * @param tScale factor applied to time distances
+     * @return the index of the closest hit, `npos` if no hit is indexed
+     *
+     * The distance is `sqrt((wScale dw)^2 + (tScale dt)^2)`. If several hits
+     * are at the same distance, the one with the lowest index is returned.
+     * The search starts from the cell of the point and moves outward ring by
+     * ring, until no unvisited hit can be closer than the best one found.
+     */
+    Index_t closest
+      (double w, double t, double wScale = 1., double tScale = 1.) const;
+
+
+      private:
+    using Grid_t = util::GridContainer2D<Entry_t>;
+    using CellID_t = Grid_t::CellID_t;
+    using CellDimIndex_t = Grid_t::CellDimIndex_t;
+
+    double fOriginW = 0.; ///< lower wire coordinate of the grid
+    double fOriginT = 0.; ///< lower time coordinate of the grid
+    double fCellW = 1.; ///< cell size in wire direction
+    double fCellT = 1.; ///< cell size in time direction
+    std::size_t fNHits = 0U; ///< number of indexed hits
+
+    Grid_t fGrid; ///< the hits, sorted by cell
+
+    /// Returns the cell index in one dimension, clamped into the grid
+    static CellDimIndex_t clampedCell
+      (double x, double origin, double size, std::size_t nCells)
+      {
+        double const c = std::floor((x - origin) / size);
+        if (!(c > 0.)) return 0; // also if NaN
+        if (c >= double(nCells)) return CellDimIndex_t(nCells - 1);
+        return CellDimIndex_t(c);
+      }
+
+    /// Returns the cell containing a point (clamped into the grid)
+    CellID_t cellOf(double w, double t) const
+      {
+        return {{
+          clampedCell(w, fOriginW, fCellW, fGrid.sizeX()),
+          clampedCell(t, fOriginT, fCellT, fGrid.sizeY())
+        }};
+      }
+
+    /// Calls `op` on all the entries in the specified cell
+    template <typename Op>
+    void forEachInCell(CellDimIndex_t iW, CellDimIndex_t iT, Op& op) const
+      { for (Entry_t const& entry: fGrid.cellData({{ iW, iT }})) op(entry); }
+
+    /// Sets the grid geometry up and returns the number of cells
+    std::array<std::size_t, 2> Setup
+      (std::vector<util::PxHit> const& hits, double cellW, double cellT);
+
+  }; // class PxHitIndex
+
+} // namespace util
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+template <typename Op>
+void util::PxHitIndex::forEachInBox
+  (double wMin, double wMax, double tMin, double tMax, Op op) const
+{
+  if (empty() || (wMax < wMin) || (tMax < tMin)) return;
+  CellID_t const lower = cellOf(wMin, tMin);
+  CellID_t const upper = cellOf(wMax, tMax);
+  for (CellDimIndex_t iW = lower[0]; iW <= upper[0]; ++iW)
+    for (CellDimIndex_t iT = lower[1]; iT <= upper[1]; ++iT)
+      forEachInCell(iW, iT, op);
+} // util::PxHitIndex::forEachInBox()
+
+
+//------------------------------------------------------------------------------
+inline auto util::PxHitIndex::inBox
+  (double wMin, double wMax, double tMin, double tMax) const
+  -> std::vector<Index_t>
+{
+  std::vector<Index_t> indices;
+  forEachInBox(wMin, wMax, tMin, tMax, [&](Entry_t const& entry)
+    {
+      if ((entry.w < wMin) || (entry.w > wMax)) return;
+      if ((entry.t < tMin) || (entry.t > tMax)) return;
+      indices.push_back(entry.index);
+    });
+  std::sort(indices.begin(), indices.end());
+  return indices;
+} // util::PxHitIndex::inBox()
+
+
+//------------------------------------------------------------------------------
+inline auto util::PxHitIndex::closest
+  (double w, double t, double wScale /* = 1. */, double tScale /* = 1. */)
+  const -> Index_t
+{
+  if (empty()) return npos;
+
+  CellDimIndex_t const nW = fGrid.sizeX();
+  CellDimIndex_t const nT = fGrid.sizeY();
+  CellID_t const center = cellOf(w, t);
+
+  double bestDist2 = std::numeric_limits<double>::infinity();
+  Index_t best = npos;
+  auto test = [&](Entry_t const& entry)
+    {
+      double const dw = (entry.w - w) * wScale;
+      double const dt = (entry.t - t) * tScale;
+      double const d2 = dw * dw + dt * dt;
+      if ((d2 < bestDist2) || ((d2 == bestDist2) && (entry.index < best))) {
+        bestDist2 = d2;
+        best = entry.index;
+      }
+    };
+
+  for (CellDimIndex_t k = 0; ; ++k) {
+    CellDimIndex_t const wLow = center[0] - k, wHigh = center[0] + k;
+    CellDimIndex_t const tLow = center[1] - k, tHigh = center[1] + k;
+
+    // visit the ring of cells at distance k (clipped to the grid)
+    for (CellDimIndex_t iW = std::max(wLow, CellDimIndex_t(0));
+      iW <= std::min(wHigh, nW - 1); ++iW
+    ) {
+      if ((iW == wLow) || (iW == wHigh)) {
+        for (CellDimIndex_t iT = std::max(tLow, CellDimIndex_t(0));
+          iT <= std::min(tHigh, nT - 1); ++iT
+          )
+          forEachInCell(iW, iT, test);
+      }
+      else {
+        if (tLow >= 0) forEachInCell(iW, tLow, test);
+        if ((tHigh < nT) && (tHigh != tLow)) forEachInCell(iW, tHigh, test);
+      }
+    } // for wire cells
+
+    // the hits not visited yet are beyond at least one side of the box
+    double bound = std::numeric_limits<double>::infinity();
+    bool more = false;
+    if (wLow > 0) {
+      more = true;
+      bound = std::min(bound, (w - (fOriginW + wLow * fCellW)) * wScale);
+    }
+    if (wHigh < nW - 1) {
+      more = true;
+      bound = std::min(bound, (fOriginW + (wHigh + 1) * fCellW - w) * wScale);
+    }
+    if (tLow > 0) {
+      more = true;
+      bound = std::min(bound, (t - (fOriginT + tLow * fCellT)) * tScale);
+    }
+    if (tHigh < nT - 1) {
+      more = true;
+      bound = std::min(bound, (fOriginT + (tHigh + 1) * fCellT - t) * tScale);
+    }
+    if (!more) break;
+    if ((best != npos) && (bound > 0.) && (bound * bound > bestDist2)) break;
+  } // for rings
+
+  return best;
+} // util::PxHitIndex::closest()
+
+
+//------------------------------------------------------------------------------
+inline std::array<std::size_t, 2> util::PxHitIndex::Setup
+  (std::vector<util::PxHit> const& hits, double cellW, double cellT)
+{
+  double wMin = std::numeric_limits<double>::max(), wMax = -wMin;
+  double tMin = wMin, tMax = -wMin;
+  std::size_t n = 0U;
+  for (util::PxHit const& hit: hits) {
+    if (!std::isfinite(hit.w) || !std::isfinite(hit.t)) continue;
+    wMin = std::min(wMin, hit.w);
+    wMax = std::max(wMax, hit.w);
+    tMin = std::min(tMin, hit.t);
+    tMax = std::max(tMax, hit.t);
+    ++n;
+  } // for
+  if (n == 0) return {{ 1U, 1U }};
+
+  fOriginW = wMin;
+  fOriginT = tMin;
+  double const rangeW = wMax - wMin, rangeT = tMax - tMin;
+
+  // automatic size: square cells (in the hit units), about HitsPerCell each
+  if ((cellW <= 0.) || (cellT <= 0.)) {
+    double const nCells = std::max(1.0, n / HitsPerCell);
+    double const area = std::max(rangeW, 1e-9) * std::max(rangeT, 1e-9);
+    double const side = std::sqrt(area / nCells);
+    if (cellW <= 0.) cellW = std::max(side, std::max(rangeW, 1e-9) / nCells);
+    if (cellT <= 0.) cellT = std::max(side, std::max(rangeT, 1e-9) / nCells);
+  }
+  fCellW = cellW;
+  fCellT = cellT;
+
+  return {{
+    std::size_t(std::floor(rangeW / fCellW)) + 1U,
+    std::size_t(std::floor(rangeT / fCellT)) + 1U
+  }};
+} // util::PxHitIndex::Setup()
+
+
+#endif // LARDATA_UTILITIES_PXHITINDEX_H
@@ -0,0 +1,236 @@
+/**
+ * @file   PxPolygon.h
+ * @brief  Polygon on a (wire, time) plane, with fast point containment tests
+ * @date   October 14, 2026
+ * @see    PxUtils.h, GeometryUtilities.h
+ *
+ * This is a pure header library.
+ */
+
+#ifndef LARDATA_UTILITIES_PXPOLYGON_H
+#define LARDATA_UTILITIES_PXPOLYGON_H 1
+
+// LArSoft libraries
+#include "lardata/Utilities/PxUtils.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::min(), std::max()
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits<>
+
+
+namespace util {
+
+  /**
+   * @brief Polygon on a (wire, time) plane
+   *
+   * The polygon is described by its vertices in order (e.g. the output of
+   * `GeometryUtilities::SelectPolygonHitList()`); it is closed implicitly.
+   * The vertices are stored as separate arrays of coordinates, together with
+   * the bounding box.
+   *
+   * A point is inside the polygon if the winding number of the polygon
+   * around it is not zero. The test is done on many points at once by
+   * `contains()`, which rejects the points outside the bounding box and
+   * loops on all the points for each edge, with no branch, so that the
+   * compiler can vectorize it. Points on the border may be found either
+   * inside or outside.
+   *
+   * The working memory is a fixed-size buffer on the stack: no allocation
+   * is done on the tests.
+   */
+  class PxPolygon {
+      public:
+
+    /// Number of points tested together
+    static constexpr std::size_t BlockSize = 64;
+
+    /// Constructor: empty polygon (contains no point)
+    PxPolygon() = default;
+
+    /// Constructor: polygon with the specified vertices
+    explicit PxPolygon(std::vector<const util::PxHit*> const& vertices)
+      { for (util::PxHit const* v: vertices) addVertex(v->w, v->t); }
+
+    /// Constructor: polygon with the specified vertices
+    explicit PxPolygon(std::vector<util::PxPoint> const& vertices)
+      { for (util::PxPoint const& v: vertices) addVertex(v.w, v.t); }
+
+    /// Adds a vertex after the last one
+    void addVertex(double w, double t)
+      {
+        fW.push_back(w);
+        fT.push_back(t);
+        fMinW = std::min(fMinW, w);
+        fMaxW = std::max(fMaxW, w);
+        fMinT = std::min(fMinT, t);
+        fMaxT = std::max(fMaxT, t);
+      }
+
+    /// Returns the number of vertices
+    std::size_t size() const { return fW.size(); }
+
+    /// Returns whether the bounding box contains the specified point
+    bool boxContains(double w, double t) const
+      { return (w >= fMinW) && (w <= fMaxW) && (t >= fMinT) && (t <= fMaxT); }
+
+    /// Returns whether the polygon contains the specified point
+    bool contains(double w, double t) const
+      {
+        unsigned char inside;
+        contains(1U, &w, &t, &inside);
+        return inside;
+      }
+
+    /**
+     * @brief Tests whether the polygon contains each of the specified points
+     * @param n number of points
+     * @param w wire coordinates of the points
+     * @param t time coordinates of the points
+     * @param inside (output) `1` for each point inside the polygon, `0` else
+     */
+    void contains(std::size_t n, double const* w, double const* t,
+      unsigned char* inside) const;
+
+    /// Returns the number of `hits` inside the polygon
+    std::size_t countInside(std::vector<util::PxHit> const& hits) const;
+
+    /**
+     * @brief Tests many points against many polygons
+     * @param polygons the polygons
+     * @param n number of points
+     * @param w wire coordinates of the points
+     * @param t time coordinates of the points
+     * @param inside (output) whether point `i` is inside polygon `p`
+     *
+     * `inside` is resized to `polygons.size() * n` and `inside[p * n + i]`
+     * is `1` if the point `i` is inside the polygon `p` (`0` otherwise).
+     * Blocks of points whose bounding box does not overlap a polygon are
+     * skipped together.
+     */
+    static void containsMany(
+      std::vector<PxPolygon> const& polygons,
+      std::size_t n, double const* w, double const* t,
+      std::vector<unsigned char>& inside
+      );
+
+
+      private:
+    std::vector<double> fW; ///< wire coordinates of the vertices
+    std::vector<double> fT; ///< time coordinates of the vertices
+
+    double fMinW = std::numeric_limits<double>::max(); ///< bounding box
+    double fMaxW = std::numeric_limits<double>::lowest(); ///< bounding box
+    double fMinT = std::numeric_limits<double>::max(); ///< bounding box
+    double fMaxT = std::numeric_limits<double>::lowest(); ///< bounding box
+
+    /// Tests up to `BlockSize` points
+    void containsBlock(std::size_t n, double const* w, double const* t,
+      unsigned char* inside) const;
+
+  }; // class PxPolygon
+
+} // namespace util
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline void util::PxPolygon::containsBlock
+  (std::size_t n, double const* w, double const* t, unsigned char* inside)
+  const
+{
+  int winding[BlockSize];
+  for (std::size_t i = 0; i < n; ++i) winding[i] = 0;
+
+  std::size_t const nVertices = size();
+  for (std::size_t v = 0; v < nVertices; ++v) {
+    std::size_t const next = (v + 1 == nVertices)? 0: v + 1;
+    double const w0 = fW[v], t0 = fT[v];
+    double const dw = fW[next] - w0, dt = fT[next] - t0;
+    double const t1 = fT[next];
+    for (std::size_t i = 0; i < n; ++i) {
+      // which side of the edge the point is on (positive: left)
+      double const side = dw * (t[i] - t0) - (w[i] - w0) * dt;
+      int const upward = (t0 <= t[i]) & (t1 > t[i]) & (side > 0.);
+      int const downward = (t0 > t[i]) & (t1 <= t[i]) & (side < 0.);
+      winding[i] += upward - downward;
+    } // for points
+  } // for edges
+
+  for (std::size_t i = 0; i < n; ++i)
+    inside[i] = (winding[i] != 0) & boxContains(w[i], t[i]);
+
+} // util::PxPolygon::containsBlock()
+
+
+//------------------------------------------------------------------------------
+inline void util::PxPolygon::contains
+  (std::size_t n, double const* w, double const* t, unsigned char* inside)
+  const
+{
+  for (std::size_t first = 0; first < n; first += BlockSize) {
+    std::size_t const nBlock = std::min(BlockSize, n - first);
+    if (size() < 3) {
+      for (std::size_t i = 0; i < nBlock; ++i) inside[first + i] = 0;
+      continue;
+    }
+    containsBlock(nBlock, w + first, t + first, inside + first);
+  } // for blocks
+} // util::PxPolygon::contains()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t util::PxPolygon::countInside
+  (std::vector<util::PxHit> const& hits) const
+{
+  double w[BlockSize], t[BlockSize];
+  unsigned char inside[BlockSize];
+  std::size_t count = 0;
+  for (std::size_t first = 0; first < hits.size(); first += BlockSize) {
+    std::size_t const nBlock = std::min(BlockSize, hits.size() - first);
+    for (std::size_t i = 0; i < nBlock; ++i) {
+      w[i] = hits[first + i].w;
+      t[i] = hits[first + i].t;
+    }
+    contains(nBlock, w, t, inside);
+    for (std::size_t i = 0; i < nBlock; ++i) count += inside[i];
+  } // for blocks
+  return count;
+} // util::PxPolygon::countInside()
+
+
+//------------------------------------------------------------------------------
+inline void util::PxPolygon::containsMany(
+  std::vector<PxPolygon> const& polygons,
+  std::size_t n, double const* w, double const* t,
+  std::vector<unsigned char>& inside
+) {
+  inside.assign(polygons.size() * n, 0);
+  for (std::size_t first = 0; first < n; first += BlockSize) {
+    std::size_t const nBlock = std::min(BlockSize, n - first);
+
+    // bounding box of the block of points
+    double minW = w[first], maxW = w[first];
+    double minT = t[first], maxT = t[first];
+    for (std::size_t i = first + 1; i < first + nBlock; ++i) {
+      minW = std::min(minW, w[i]);
+      maxW = std::max(maxW, w[i]);
+      minT = std::min(minT, t[i]);
+      maxT = std::max(maxT, t[i]);
+    }
+
+    for (std::size_t p = 0; p < polygons.size(); ++p) {
+      PxPolygon const& polygon = polygons[p];
+      if (polygon.size() < 3) continue;
+      if ((maxW < polygon.fMinW) || (minW > polygon.fMaxW)) continue;
+      if ((maxT < polygon.fMinT) || (minT > polygon.fMaxT)) continue;
+      polygon.containsBlock
+        (nBlock, w + first, t + first, inside.data() + p * n + first);
+    } // for polygons
+  } // for blocks
+} // util::PxPolygon::containsMany()
+
+
+#endif // LARDATA_UTILITIES_PXPOLYGON_H
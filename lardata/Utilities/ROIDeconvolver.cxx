@@ -0,0 +1,128 @@
+#include "lardata/Utilities/ROIDeconvolver.h"
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/SignalShaping.h"
+
+// -----------------------------------------------------------------------------
+// ~~~~ Plans, engine and deconvolution kernel of one transform size
+// -----------------------------------------------------------------------------
+struct util::ROIDeconvolver::SizedTransform {
+  LArFFTW fft;
+  ComplexVector kernel;
+
+  // ... the plans are shared with all the other users of this size
+  SizedTransform(int size, std::string const& option)
+    : fft(LArFFTWPlan::Shared(size, option), 1)
+    , kernel(size/2+1)
+  {}
+};
+
+// -----------------------------------------------------------------------------
+util::ROIDeconvolver::ROIDeconvolver(ComplexVector const& deconvKernel, int fullSize,
+                                     std::size_t padding, std::vector<int> sizes,
+                                     std::string const& fftwOption)
+  : fFullSize  (fullSize)
+  , fPadding   (padding)
+  , fSizes     (sizes.empty()? DefaultSizes(fullSize): std::move(sizes))
+  , fOption    (fftwOption)
+  , fFullKernel(deconvKernel)
+{
+  if(fFullSize < 2 || deconvKernel.size() != std::size_t(fFullSize/2+1)){
+    throw cet::exception("ROIDeconvolver") << "Bad kernel size = " << deconvKernel.size()
+      << " for transform size " << fFullSize << "\n";
+  }
+
+  // ... sorted sizes, up to the full size (always included)
+  fSizes.erase(std::remove_if(fSizes.begin(), fSizes.end(),
+                              [this](int size){ return size < 2 || size > fFullSize; }),
+               fSizes.end());
+  fSizes.push_back(fFullSize);
+  std::sort(fSizes.begin(), fSizes.end());
+  fSizes.erase(std::unique(fSizes.begin(), fSizes.end()), fSizes.end());
+  fTransforms.resize(fSizes.size());
+
+  // ... time domain response, from which the shorter kernels are derived
+  SizedTransform& full = Transform(fSizes.size() - 1);
+  fResponse.resize(fFullSize);
+  ComplexVector kernel = fFullKernel;
+  full.fft.DoInvFFT(kernel, fResponse);
+}
+
+// -----------------------------------------------------------------------------
+util::ROIDeconvolver::ROIDeconvolver(SignalShaping const& shaping,
+                                     std::size_t padding, std::vector<int> sizes,
+                                     std::string const& fftwOption)
+  : ROIDeconvolver(shaping.DeconvKernelD(), 2*(int(shaping.DeconvKernelD().size())-1),
+                   padding, std::move(sizes), fftwOption)
+{}
+
+// -----------------------------------------------------------------------------
+util::ROIDeconvolver::~ROIDeconvolver() = default;
+
+// -----------------------------------------------------------------------------
+std::vector<int> util::ROIDeconvolver::DefaultSizes(int fullSize)
+{
+  std::vector<int> sizes;
+  for(int size = 64; size < fullSize; size *= 2)
+    sizes.push_back(size);
+  sizes.push_back(fullSize);
+  return sizes;
+}
+
+// -----------------------------------------------------------------------------
+std::size_t util::ROIDeconvolver::SizeIndex(std::size_t length) const
+{
+  auto const iSize = std::lower_bound(fSizes.begin(), fSizes.end(), length,
+                                      [](int size, std::size_t length){ return std::size_t(size) < length; });
+  return (iSize == fSizes.end())? fSizes.size() - 1: iSize - fSizes.begin();
+}
+
+// -----------------------------------------------------------------------------
+// ~~~~ The kernel of a size M is the transform of the time domain response
+//      truncated to M ticks: the first M/2 ticks, and the last M/2 of the
+//      (periodic) response before tick 0
+// -----------------------------------------------------------------------------
+auto util::ROIDeconvolver::Transform(std::size_t iSize) -> SizedTransform&
+{
+  std::unique_ptr<SizedTransform>& transform = fTransforms[iSize];
+  if(transform) return *transform;
+
+  int const size = fSizes[iSize];
+  transform = std::make_unique<SizedTransform>(size, fOption);
+  if(size == fFullSize){
+    transform->kernel = fFullKernel;
+  }
+  else{
+    std::vector<double> response(size, 0.);
+    int const half = size/2;
+    for(int i = 0; i < size - half; ++i)
+      response[i] = fResponse[i];
+    for(int j = 1; j <= half; ++j)
+      response[size-j] = fResponse[fFullSize-j];
+    transform->fft.DoFFT(response, transform->kernel);
+  }
+  return *transform;
+}
+
+// -----------------------------------------------------------------------------
+void util::ROIDeconvolver::DeconvoluteBuffer(std::size_t iSize)
+{
+  SizedTransform& transform = Transform(iSize);
+  transform.fft.Convolute(fBuffer, transform.kernel);
+  fTransformedTicks += fBuffer.size();
+}
+
+// -----------------------------------------------------------------------------
+void util::ROIDeconvolver::MergeROIs(ROIs_t& rois)
+{
+  if(rois.empty()) return;
+  RangeArray<std::size_t> ranges;
+  ranges.reserve(rois.size());
+  for(ROI_t const& roi: rois)
+    ranges.push_back(roi.first, std::max(roi.first, roi.second));
+  SortByStart(ranges);
+  Coalesce(ranges);
+  rois.resize(ranges.size());
+  for(std::size_t i = 0; i < ranges.size(); ++i)
+    rois[i] = { ranges.Start(i), ranges.End(i) };
+}
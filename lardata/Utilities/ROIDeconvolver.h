@@ -0,0 +1,216 @@
+#ifndef ROIDECONVOLVER_H
+#define ROIDECONVOLVER_H
+
+// C/C++ standard libraries
+#include <vector>
+#include <complex>
+#include <memory>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+#include "cetlib_except/exception.h"
+#include "lardataobj/Utilities/sparse_vector.h"
+#include "lardata/Utilities/UniqueRangeSet.h"
+#include "lardata/Utilities/RangeArrays.h"
+
+namespace util {
+
+class SignalShaping;
+
+// -----------------------------------------------------------------------------
+// Deconvolution of the regions of interest of a waveform only.
+//
+// The full waveform deconvolution (`SignalShaping::Deconvolute()`) transforms
+// all the ticks of each channel, even when only a few regions of interest
+// (ROI) carry signal. This class deconvolves instead a window around each
+// ROI, padded on both sides with the waveform samples, with the smallest
+// transform size from a list which fits the window. The deconvolution kernel
+// for each size is derived once from the full size one (its time domain
+// response, truncated to the size) the first time that size is needed, and
+// its FFTW plans are taken from the job-wide registry, shared with all the
+// other deconvolvers (e.g. one per plane); the result is equivalent to the full
+// deconvolution as long as the padding covers the time extent of the
+// deconvolution response.
+//
+// The result is a `lar::sparse_vector<float>` with the deconvolved ROIs, of
+// the type `recob::Wire` stores, so that it can be moved into
+// `recob::WireCreator` without copies:
+//
+//     util::ROIDeconvolver deconvolver(shaping, 100);
+//     for (auto const& digit: digits) {
+//       ...
+//       recob::WireCreator wire
+//         (deconvolver.Deconvolute(samples, rois), digit);
+//       wires.push_back(wire.move());
+//     }
+//
+// ROIs are half-open ranges of ticks `[ begin, end )`. An object is not
+// thread-safe (like `LArFFTW`, it owns scratch buffers): use one per thread.
+// -----------------------------------------------------------------------------
+class ROIDeconvolver {
+
+  public:
+
+    using ComplexVector = std::vector<std::complex<double>>;
+    using ROI_t = std::pair<std::size_t, std::size_t>;
+    using ROIs_t = std::vector<ROI_t>;
+    using RegionsOfInterest_t = lar::sparse_vector<float>;
+
+    // ... deconvKernel: full size frequency domain deconvolution kernel
+    //     (N/2+1 elements); sizes: transform sizes to choose from (empty:
+    //     DefaultSizes(N)); the full size N is always included
+    ROIDeconvolver(ComplexVector const& deconvKernel, int fullSize,
+                   std::size_t padding = 64, std::vector<int> sizes = {},
+                   std::string const& fftwOption = "ES");
+
+    // ... uses the deconvolution kernel of a shaper, which must have been
+    //     calculated already (e.g. a shared shaper)
+    explicit ROIDeconvolver(SignalShaping const& shaping,
+                            std::size_t padding = 64, std::vector<int> sizes = {},
+                            std::string const& fftwOption = "ES");
+
+    ~ROIDeconvolver();
+
+    ROIDeconvolver(ROIDeconvolver const&) = delete;
+    ROIDeconvolver& operator=(ROIDeconvolver const&) = delete;
+
+    int FullSize() const { return fFullSize; }
+    std::size_t Padding() const { return fPadding; }
+    std::vector<int> const& Sizes() const { return fSizes; }
+
+    // ... smallest available transform size not shorter than length
+    int TransformSize(std::size_t length) const
+      { return fSizes[SizeIndex(length)]; }
+
+    // ... total number of ticks transformed so far (for benchmarks)
+    std::size_t TransformedTicks() const { return fTransformedTicks; }
+
+    // ... deconvolution of the specified ROIs of waveform
+    //     (which must not be longer than the full transform size);
+    //     overlapping and touching ROIs are merged
+    template <class T>
+    RegionsOfInterest_t Deconvolute(std::vector<T> const& waveform, ROIs_t rois);
+
+    // ... ROIs from a range set (`End()` excluded from each range)
+    template <class T, class R>
+    RegionsOfInterest_t Deconvolute(std::vector<T> const& waveform,
+                                    UniqueRangeSet<R> const& rois);
+
+    // ... ROIs from a range array (`End(i)` excluded from each range)
+    template <class T, class R>
+    RegionsOfInterest_t Deconvolute(std::vector<T> const& waveform,
+                                    RangeArray<R> const& rois);
+
+    // ... ROIs from the non-void ranges of a sparse vector
+    template <class T, class V>
+    RegionsOfInterest_t Deconvolute(std::vector<T> const& waveform,
+                                    lar::sparse_vector<V> const& rois);
+
+    // ... powers of 2 from 64 to the full size, and the full size
+    static std::vector<int> DefaultSizes(int fullSize);
+
+  private:
+
+    struct SizedTransform;
+
+    int fFullSize;			// full transform size
+    std::size_t fPadding;		// ticks added on each side of a ROI
+    std::vector<int> fSizes;		// sorted transform sizes
+    std::string fOption;		// FFTW planning option
+    ComplexVector fFullKernel;		// full size deconvolution kernel
+    std::vector<double> fResponse;	// time domain deconvolution response
+    std::vector<std::unique_ptr<SizedTransform>> fTransforms;	// by size, on demand
+    std::vector<double> fBuffer;	// window being deconvolved
+    std::size_t fTransformedTicks = 0;
+
+    std::size_t SizeIndex(std::size_t length) const;
+
+    // ... plans, engine and kernel for fSizes[iSize], made on first use
+    SizedTransform& Transform(std::size_t iSize);
+
+    // ... deconvolution of fBuffer (of size fSizes[iSize]) in place
+    void DeconvoluteBuffer(std::size_t iSize);
+
+    // ... sorts and merges the ROIs
+    static void MergeROIs(ROIs_t& rois);
+};
+
+}
+
+// -----------------------------------------------------------------------------
+template <class T>
+inline auto util::ROIDeconvolver::Deconvolute(std::vector<T> const& waveform, ROIs_t rois)
+  -> RegionsOfInterest_t
+{
+  std::size_t const n = waveform.size();
+  if(n > std::size_t(fFullSize)){
+    throw cet::exception("ROIDeconvolver") << "Waveform of " << n
+      << " ticks is longer than the full transform size " << fFullSize << "\n";
+  }
+
+  MergeROIs(rois);
+
+  RegionsOfInterest_t result(n);
+  for(ROI_t const& roi: rois){
+    std::size_t const begin = std::min(roi.first, n);
+    std::size_t const end = std::min(roi.second, n);
+    if(begin >= end) continue;
+
+    // ... padded window, within the waveform
+    std::size_t const wbegin = (begin > fPadding)? begin - fPadding: 0;
+    std::size_t const wend = std::min(end + fPadding, n);
+
+    std::size_t const iSize = SizeIndex(wend - wbegin);
+    fBuffer.assign(fSizes[iSize], 0.);
+    std::copy(waveform.begin() + wbegin, waveform.begin() + wend, fBuffer.begin());
+
+    DeconvoluteBuffer(iSize);
+
+    result.add_range(begin,
+      fBuffer.begin() + (begin - wbegin), fBuffer.begin() + (end - wbegin));
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+template <class T, class R>
+inline auto util::ROIDeconvolver::Deconvolute(std::vector<T> const& waveform,
+                                              UniqueRangeSet<R> const& rois)
+  -> RegionsOfInterest_t
+{
+  ROIs_t ranges;
+  ranges.reserve(rois.size());
+  for(auto const& range: rois)
+    ranges.emplace_back(range.Start(), range.End());
+  return Deconvolute(waveform, std::move(ranges));
+}
+
+// -----------------------------------------------------------------------------
+template <class T, class R>
+inline auto util::ROIDeconvolver::Deconvolute(std::vector<T> const& waveform,
+                                              RangeArray<R> const& rois)
+  -> RegionsOfInterest_t
+{
+  ROIs_t ranges;
+  ranges.reserve(rois.size());
+  for(std::size_t i = 0; i < rois.size(); ++i)
+    ranges.emplace_back(rois.Start(i), rois.End(i));
+  return Deconvolute(waveform, std::move(ranges));
+}
+
+// -----------------------------------------------------------------------------
+template <class T, class V>
+inline auto util::ROIDeconvolver::Deconvolute(std::vector<T> const& waveform,
+                                              lar::sparse_vector<V> const& rois)
+  -> RegionsOfInterest_t
+{
+  ROIs_t ranges;
+  ranges.reserve(rois.n_ranges());
+  for(auto const& range: rois.get_ranges())
+    ranges.emplace_back(range.begin_index(), range.end_index());
+  return Deconvolute(waveform, std::move(ranges));
+}
+
+#endif
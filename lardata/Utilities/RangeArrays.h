@@ -0,0 +1,216 @@
+/**
+ * \file RangeArrays.h
+ *
+ * \ingroup RangeTool
+ *
+ * \brief Batch operations on arrays of ranges (util::RangeArray)
+ *
+ * @date October 14, 2026
+ */
+
+/** \addtogroup RangeTool
+    @{*/
+
+#ifndef RANGEARRAYS_H
+#define RANGEARRAYS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace util {
+
+  /**
+     \class RangeArray
+     @brief Ranges stored as two arrays, one of "start" and one of "end" values.
+     While util::Range and util::UniqueRangeSet handle one range at a time, this structure   \n
+     keeps the starts and the ends in two contiguous arrays, so that the batch operations    \n
+     below (util::SortByStart, util::Coalesce, util::Intersect, util::CoveredLength) run     \n
+     as loops on plain arrays, with no branch depending on the data in their bodies, which   \n
+     the compiler can vectorize.                                                             \n
+
+     As in util::UniqueRangeSet, ranges which overlap or touch are merged by util::Coalesce. \n
+     A range must not start after its end.
+  */
+  template <class T>
+  class RangeArray {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// default ctor
+    RangeArray(){}
+
+    /// Copies the ranges in [first, last) (elements with Start() and End())
+    template <typename Iter>
+    RangeArray(Iter first, Iter last)
+    { for(; first != last; ++first) push_back(first->Start(),first->End()); }
+
+    /// Adds a range at the end of the array
+    void push_back(const T& start,const T& end)
+    {
+      if(start>end) throw std::runtime_error("Inserted invalid range: end before start.");
+      _starts.push_back(start);
+      _ends.push_back(end);
+    }
+
+    /// "start" of the range i
+    const T& Start(size_type i) const { return _starts[i]; }
+    /// "end" of the range i
+    const T& End(size_type i) const { return _ends[i]; }
+
+    /// All the "start" values
+    const std::vector<T>& Starts() const { return _starts; }
+    /// All the "end" values
+    const std::vector<T>& Ends() const { return _ends; }
+
+    size_type size() const { return _starts.size(); }
+    bool empty() const { return _starts.empty(); }
+    void clear() { _starts.clear(); _ends.clear(); }
+    void reserve(size_type n) { _starts.reserve(n); _ends.reserve(n); }
+
+  private:
+    std::vector<T> _starts; ///< start of each range
+    std::vector<T> _ends;   ///< end of each range
+
+    template <class U> friend void SortByStart(RangeArray<U>& ranges);
+    template <class U> friend size_t Coalesce(RangeArray<U>& ranges);
+    template <class U> friend RangeArray<U> Intersect
+      (const RangeArray<U>& a, const RangeArray<U>& b);
+
+  };
+
+
+  /// Returns whether the ranges are sorted by start.
+  template <class T>
+  bool IsSortedByStart(const RangeArray<T>& ranges)
+  {
+    const T* starts = ranges.Starts().data();
+    size_t descents = 0;
+    for(size_t i = 1; i < ranges.size(); ++i)
+      descents += (starts[i] < starts[i-1]);
+    return descents == 0;
+  }
+
+
+  /**
+     Sorts the ranges by start (ranges with the same start keep their order). \n
+     If the ranges are already sorted, this costs one linear pass.
+  */
+  template <class T>
+  void SortByStart(RangeArray<T>& ranges)
+  {
+    if(IsSortedByStart(ranges)) return;
+
+    size_t const n = ranges.size();
+    std::vector<size_t> order(n);
+    std::iota(order.begin(),order.end(),size_t(0));
+    std::stable_sort(order.begin(),order.end(),
+      [&starts=ranges._starts](size_t a,size_t b){ return starts[a] < starts[b]; });
+
+    std::vector<T> starts(n), ends(n);
+    for(size_t i = 0; i < n; ++i) {
+      starts[i] = ranges._starts[order[i]];
+      ends[i] = ranges._ends[order[i]];
+    }
+    ranges._starts.swap(starts);
+    ranges._ends.swap(ends);
+  }
+
+
+  /**
+     Merges in place the ranges which overlap or touch, leaving them sorted and disjoint. \n
+     The ranges must be sorted by start (see util::SortByStart).                         \n
+     Return = # ranges which disappeared in merges.
+  */
+  template <class T>
+  size_t Coalesce(RangeArray<T>& ranges)
+  {
+    size_t const n = ranges.size();
+    if(n == 0) return 0;
+
+    T* starts = ranges._starts.data();
+    T* ends = ranges._ends.data();
+
+    // the current range is always written at the output position, which moves
+    // on only when the next range is detached; the output position is never
+    // after the input one, so no range is overwritten before being read
+    size_t out = 0;
+    T cur_start = starts[0], cur_end = ends[0];
+    for(size_t i = 1; i < n; ++i) {
+      bool const gap = cur_end < starts[i];
+      starts[out] = cur_start;
+      ends[out] = cur_end;
+      out += gap;
+      cur_start = gap? starts[i]: cur_start;
+      cur_end = gap? ends[i]: std::max(cur_end,ends[i]);
+    }
+    starts[out] = cur_start;
+    ends[out] = cur_end;
+    ++out;
+
+    ranges._starts.resize(out);
+    ranges._ends.resize(out);
+    return n - out;
+  }
+
+
+  /**
+     Returns the intersection of two sets of disjoint ranges sorted by start    \n
+     (as util::Coalesce leaves them): the ranges covered by both a and b.       \n
+     Ranges which only touch have no intersection.
+  */
+  template <class T>
+  RangeArray<T> Intersect(const RangeArray<T>& a, const RangeArray<T>& b)
+  {
+    size_t const na = a.size(), nb = b.size();
+    RangeArray<T> res;
+    if((na == 0) || (nb == 0)) return res;
+
+    // there are at most na + nb - 1 intersections
+    res._starts.resize(na + nb - 1);
+    res._ends.resize(na + nb - 1);
+    T* starts = res._starts.data();
+    T* ends = res._ends.data();
+
+    const T* a_starts = a._starts.data();
+    const T* a_ends = a._ends.data();
+    const T* b_starts = b._starts.data();
+    const T* b_ends = b._ends.data();
+
+    size_t out = 0, i = 0, j = 0;
+    while((i < na) && (j < nb)) {
+      T const lo = std::max(a_starts[i],b_starts[j]);
+      T const hi = std::min(a_ends[i],b_ends[j]);
+      starts[out] = lo;
+      ends[out] = hi;
+      out += (lo < hi);
+      // the range ending first can't intersect anything else
+      bool const next_a = !(b_ends[j] < a_ends[i]);
+      bool const next_b = !(a_ends[i] < b_ends[j]);
+      i += next_a;
+      j += next_b;
+    }
+    res._starts.resize(out);
+    res._ends.resize(out);
+    return res;
+  }
+
+
+  /// Total length of the ranges (of the covered interval, if they are disjoint)
+  template <class T>
+  T CoveredLength(const RangeArray<T>& ranges)
+  {
+    const T* starts = ranges.Starts().data();
+    const T* ends = ranges.Ends().data();
+    T total = T(0);
+    for(size_t i = 0; i < ranges.size(); ++i) total += ends[i] - starts[i];
+    return total;
+  }
+
+}
+
+#endif
+/** @} */ // end of doxygen group
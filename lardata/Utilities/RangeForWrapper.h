@@ -49,8 +49,10 @@ namespace util {
       // This wrapper fully supports up to bidirectional iterators;
       // if the wrapped iterator is a random or contiguous iterator,
       // the wrapper will still expose only a bidirectional iterator interface.
-      // Supporting random access is possible, but writing a proper unit test
-      // is tedious... open a feature request if needed.
+      // Random access ranges whose end can be turned into a begin iterator
+      // do not use this wrapper at all (see `RangeForWrapperBox`), so that
+      // random access is lost only when the distance between the begin and
+      // the end iterators can't be computed.
       //
       using iterator_category = std::conditional_t<
         std::is_base_of<std::bidirectional_iterator_tag, typename traits_t::iterator_category>::value,
@@ -202,7 +204,7 @@ namespace util {
         IndexAccessor(difference_type offset): offset(offset) {}
 
         template <typename Iter>
-        bool operator() (Iter& iter) const
+        reference operator() (Iter& iter) const
           { return IndexAccessorImpl<reference, Iter>(offset).access(iter); }
 
           private:
@@ -228,6 +230,40 @@ namespace util {
 
 
 
+    /**
+     * @brief Trait: whether an end iterator can be turned into a begin one.
+     * @tparam BeginIter type of the begin iterator
+     * @tparam EndIter type of the end iterator
+     *
+     * This is true if `BeginIter` is a random access iterator, its distance
+     * from `EndIter` can be computed (`end - begin`) and it can be advanced by
+     * that distance (`begin += distance`). In that case the end iterator can be
+     * replaced by a begin iterator in constant time.
+     */
+    template <typename BeginIter, typename EndIter, typename = void>
+    struct is_end_convertible_to_begin: public std::false_type {};
+
+    template <typename BeginIter, typename EndIter>
+    struct is_end_convertible_to_begin<BeginIter, EndIter, std::enable_if_t<
+      std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<BeginIter>::iterator_category
+        >::value
+      && std::is_convertible<
+        decltype(std::declval<EndIter const&>() - std::declval<BeginIter const&>()),
+        typename std::iterator_traits<BeginIter>::difference_type
+        >::value
+      && std::is_same<
+        decltype(std::declval<BeginIter&>() += std::declval<
+          typename std::iterator_traits<BeginIter>::difference_type>()
+          ),
+        BeginIter&
+        >::value
+      >>
+      : public std::true_type
+    {};
+
+
     /// Class defining types and traits for RangeForWrapperBox
     template <typename RangeRef>
     struct RangeForWrapperTraits {
@@ -255,18 +291,50 @@ namespace util {
       static constexpr bool sameIteratorTypes
         = std::is_same<BeginIter_t, EndIter_t>();
 
+      /// True if the end iterator can be replaced by a begin iterator.
+      static constexpr bool commonIterators
+        = is_end_convertible_to_begin<BeginIter_t, EndIter_t>();
+
       /// Type of wrapper iterators (same for begin and end iterators).
-      using Iterator_t = RangeForWrapperIterator<BeginIter_t, EndIter_t>;
+      using Iterator_t = std::conditional_t<
+        commonIterators,
+        BeginIter_t,
+        RangeForWrapperIterator<BeginIter_t, EndIter_t>
+        >;
 
-      using value_type = typename BeginIter_t::value_type;
+      using value_type = typename std::iterator_traits<BeginIter_t>::value_type;
       using size_type = std::size_t;
-      using difference_type = typename BeginIter_t::difference_type;
-      using reference = typename BeginIter_t::value_type;
-      using pointer = typename BeginIter_t::pointer;
+      using difference_type
+        = typename std::iterator_traits<BeginIter_t>::difference_type;
+      using reference = typename std::iterator_traits<BeginIter_t>::reference;
+      using pointer = typename std::iterator_traits<BeginIter_t>::pointer;
 
     }; // class RangeForWrapperTraits<>
 
 
+    /// Stores a range (if `RangeRef` is a rvalue reference) or a reference to it.
+    template <typename RangeRef>
+    struct RangeForDataBox {
+
+      using Stored_t = std::conditional_t<
+        std::is_rvalue_reference<RangeRef>::value,
+        std::remove_reference_t<RangeRef>,
+        RangeRef
+        >;
+      using Data_t = std::remove_reference_t<Stored_t>;
+
+      Stored_t data;
+
+      // only one of these is valid...
+      RangeForDataBox(Data_t& data): data(data) {}
+      RangeForDataBox(Data_t&& data): data(std::move(data)) {}
+
+      operator RangeRef() const { return RangeRef(data); }
+      operator RangeRef() { return RangeRef(data); }
+
+    }; // RangeForDataBox
+
+
     /**
      * @brief Class offering begin/end iterators of the same type out of a range
      *        of iterators of different types.
@@ -274,6 +342,18 @@ namespace util {
      *
      * The class steals (moves) the value if `RangeRef` is a rvalue reference
      * type, while it just references the original one otherwise.
+     *
+     * If the begin iterator is a random access iterator and the end iterator
+     * can be turned into one (that is, their difference can be computed),
+     * the iterators of this object are the begin iterators of the range
+     * themselves. They keep their category (random access or contiguous), so
+     * that the range can be used with parallel algorithms (e.g. with
+     * `std::execution::par`) and in vectorizable loops. Otherwise,
+     * a `RangeForWrapperIterator` wraps both types, with at most bidirectional
+     * access.
+     *
+     * The iterators only read the range, and concurrent iterations are safe
+     * as long as they are safe on the wrapped range.
      */
     template <typename RangeRef>
     class RangeForWrapperBox {
@@ -314,14 +394,31 @@ namespace util {
 
       /// Returns a end-of-range iterator.
       Iterator_t end() const
-        { return Iterator_t(wrappedEnd()); }
+        {
+          if constexpr (Traits_t::commonIterators) {
+            auto iEnd = wrappedBegin();
+            iEnd += (wrappedEnd() - iEnd);
+            return iEnd;
+          }
+          else return Iterator_t(wrappedEnd());
+        }
 
       /// @{
       /// @name Reduced container interface.
 
       auto size() const { return std::distance(begin(), end()); }
 
-      bool empty() const { return !(wrappedBegin() != wrappedEnd()); }
+      /// Returns the data of the range (only if the range provides `data()`).
+      template <typename R = Range_t>
+      auto data() const -> decltype(std::declval<R&>().data())
+        { return static_cast<RangeRef_t>(fRange).data(); }
+
+      bool empty() const
+        {
+          if constexpr (Traits_t::commonIterators)
+            return (wrappedEnd() - wrappedBegin()) == 0;
+          else return !(wrappedBegin() != wrappedEnd());
+        }
 
       auto operator[] (difference_type index) const -> decltype(auto)
         { return wrappedBegin()[index]; }
@@ -331,27 +428,7 @@ namespace util {
 
         private:
 
-      struct DataBox {
-
-        using Stored_t = std::conditional_t<
-          std::is_rvalue_reference<RangeRef_t>::value,
-          std::remove_reference_t<RangeRef_t>,
-          RangeRef_t
-          >;
-        using Data_t = std::remove_reference_t<Stored_t>;
-
-        Stored_t data;
-
-        // only one of these is valid...
-        DataBox(Data_t& data): data(data) {}
-        DataBox(Data_t&& data): data(std::move(data)) {}
-
-        operator RangeRef_t() const { return RangeRef_t(data); }
-        operator RangeRef_t() { return RangeRef_t(data); }
-
-      }; // DataBox
-
-      DataBox fRange; ///< A reference to the original range.
+      RangeForDataBox<RangeRef_t> fRange; ///< A reference to the original range.
 
       auto wrappedBegin() const -> decltype(auto)
         { return Traits_t::extractBegin(static_cast<RangeRef_t>(fRange)); }
@@ -401,6 +478,131 @@ namespace util {
         }
     }; // WrapRangeForDispatcher<BaseRange, false>
 
+
+    /// Whether the compiler supports range-for loops with sentinels (C++17).
+#if defined(__cpp_range_based_for) && (__cpp_range_based_for >= 201603L)
+    constexpr bool RangeForSupportsSentinels = true;
+#else
+    constexpr bool RangeForSupportsSentinels = false;
+#endif // __cpp_range_based_for
+
+
+    /**
+     * @brief Class exposing the begin and end iterators of a range as they are.
+     * @tparam RangeRef type of reference to be stored (constantness embedded)
+     *
+     * Unlike `RangeForWrapperBox`, the begin and end iterators of this object
+     * are of different types: the ones of the wrapped range. It is meant for
+     * range-for loops on compilers accepting different types (C++17), and
+     * for iterations with the `begin()` and `end()` free functions, comparing
+     * the iterator with the end one with `!=`. No branch is added to the
+     * iteration and to the comparison.
+     *
+     * The class steals (moves) the value if `RangeRef` is a rvalue reference
+     * type, while it just references the original one otherwise.
+     */
+    template <typename RangeRef>
+    class RangeForSentinelBox {
+
+      static_assert(std::is_reference<RangeRef>::value,
+        "RangeForSentinelBox requires a reference type.");
+
+      using Traits_t = RangeForWrapperTraits<RangeRef>;
+
+        public:
+
+      // Import traits
+      using RangeRef_t = typename Traits_t::RangeRef_t;
+      using Range_t = typename Traits_t::Range_t;
+
+      /// Type of begin iterator.
+      using Iterator_t = typename Traits_t::BeginIter_t;
+
+      /// Type of end iterator.
+      using Sentinel_t = typename Traits_t::EndIter_t;
+
+      /// Type of number of stored elements.
+      using size_type = typename Traits_t::size_type;
+
+      /// Type of difference between element positions.
+      using difference_type = typename Traits_t::difference_type;
+
+      /// Constructor: references the specified range (lvalue reference).
+      RangeForSentinelBox(Range_t& range)
+        : fRange(range)
+        {}
+
+      /// Constructor: references the specified range (rvalue reference).
+      RangeForSentinelBox(Range_t&& range)
+        : fRange(std::move(range))
+        {}
+
+      /// Returns a begin-of-range iterator.
+      Iterator_t begin() const
+        { return Traits_t::extractBegin(static_cast<RangeRef_t>(fRange)); }
+
+      /// Returns a end-of-range iterator (sentinel).
+      Sentinel_t end() const
+        { return Traits_t::extractEnd(static_cast<RangeRef_t>(fRange)); }
+
+      /// @{
+      /// @name Reduced container interface.
+
+      /// Returns the number of elements (iterating through all of them).
+      size_type size() const
+        {
+          size_type n = 0;
+          for (auto it = begin(), send = end(); it != send; ++it) ++n;
+          return n;
+        }
+
+      /// Returns the data of the range (only if the range provides `data()`).
+      template <typename R = Range_t>
+      auto data() const -> decltype(std::declval<R&>().data())
+        { return static_cast<RangeRef_t>(fRange).data(); }
+
+      bool empty() const { return !(begin() != end()); }
+
+      auto operator[] (difference_type index) const -> decltype(auto)
+        { return begin()[index]; }
+
+      /// @}
+
+
+        private:
+
+      RangeForDataBox<RangeRef_t> fRange; ///< A reference to the original range.
+
+    }; // class RangeForSentinelBox<>
+
+
+    /// Wraps an object for use in a range-for loop, with sentinels if possible.
+    template <
+      typename BaseRange,
+      bool NeedsWrapper = !RangeForSupportsSentinels
+        || RangeForWrapperTraits<std::decay_t<BaseRange>>::sameIteratorTypes
+        || RangeForWrapperTraits<std::decay_t<BaseRange>>::commonIterators
+      >
+    struct WrapRangeForSentinelDispatcher;
+
+    // Template specialization for ranges requiring `RangeForWrapperBox`
+    // (or no wrapping at all)
+    template <typename BaseRange>
+    struct WrapRangeForSentinelDispatcher<BaseRange, true>
+      : public WrapRangeForDispatcher<BaseRange>
+    {};
+
+    // Template specialization for ranges with sentinels
+    template <typename BaseRange>
+    struct WrapRangeForSentinelDispatcher<BaseRange, false> {
+      template <typename Range>
+      static auto wrap(Range&& range)
+        {
+          return RangeForSentinelBox<decltype(range)>
+            (static_cast<decltype(range)>(range));
+        }
+    }; // WrapRangeForSentinelDispatcher<BaseRange, false>
+
   } // namespace details
 
 
@@ -457,6 +659,58 @@ namespace util {
     { return wrapRangeFor(std::forward<Range>(range)); }
 
 
+  /**
+   * @brief Wraps an object for use in a range-for loop, keeping its sentinel.
+   * @tparam Range type of range object (anything with begin() and end())
+   * @param range instance of the range object to be wrapped
+   * @see wrapRangeFor()
+   *
+   * This is equivalent to `wrapRangeFor()`, except for ranges with begin and
+   * end iterators of different types, whose distance can't be computed.
+   * On compilers supporting such ranges in range-for loops (C++17), those
+   * are not wrapped in `RangeForWrapperIterator`, which checks at each
+   * increment and comparison which of the two iterators it holds. Instead,
+   * the returned object exposes the original begin iterator and
+   * end-of-range sentinel. In exchange, the iterators `begin()` and `end()`
+   * may be of different types, and they can't be used with the algorithms
+   * requiring a pair of iterators of the same type: the result is meant to
+   * be iterated in a range-for loop, or with `begin()`, `end()` and `!=`.
+   */
+  template <typename Range>
+  auto wrapRangeForSentinel(Range&& range) -> decltype(auto)
+    {
+      return details::WrapRangeForSentinelDispatcher<Range>::wrap
+        (std::forward<Range>(range));
+    }
+
+
+  /// Tag marking the use of `wrapRangeForSentinel()`
+  struct RangeForSentinelTag {};
+
+  /// Constant to be used with
+  /// `operator|(Range&&, details::RangeForSentinelTag)`.
+  constexpr RangeForSentinelTag range_for_sentinel;
+
+  /**
+   * @brief Transforms a range so that it can be used in a range-for loop
+   * @tparam Range the type of range to be transformed
+   * @param range the range to be transformed
+   * @return an equivalent range object to be used in a range-for loop
+   * @see wrapRangeForSentinel()
+   *
+   * Example of usage:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * Range data; // initialization
+   * for (auto&& value: data | util::range_for_sentinel) // ...
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * Unlike with `util::range_for`, the begin and end iterators of the result
+   * may be of different types.
+   */
+  template <typename Range>
+  auto operator| (Range&& range, RangeForSentinelTag) -> decltype(auto)
+    { return wrapRangeForSentinel(std::forward<Range>(range)); }
+
+
 } // namespace util
 
 
@@ -558,7 +812,7 @@ namespace util {
     template <typename BeginIter, typename EndIter>
     template <typename Iter>
     struct RangeForWrapperIterator<BeginIter, EndIter>::Incrementer::IncrementerImpl<
-      Iter, std::enable_if_t<is_type_v<decltype(++(std::declval<Iter>()))>>
+      Iter, std::enable_if_t<is_type_v<decltype(++(std::declval<Iter&>()))>>
       >
     {
       static void increment(Iter& iter)
@@ -580,7 +834,7 @@ namespace util {
     template <typename BeginIter, typename EndIter>
     template <typename Iter>
     struct RangeForWrapperIterator<BeginIter, EndIter>::Decrementer::DecrementerImpl<
-      Iter, std::enable_if_t<is_type_v<decltype(--(std::declval<Iter>()))>>
+      Iter, std::enable_if_t<is_type_v<decltype(--(std::declval<Iter&>()))>>
       >
     {
       static void decrement(Iter& iter)
@@ -612,7 +866,7 @@ namespace util {
 
       IndexAccessorImpl(difference_type offset): offset(offset) {}
 
-      Result dereference(Iter const& iter) const
+      Result access(Iter const& iter) const
         { return iter[offset]; }
     }; //
 
@@ -0,0 +1,122 @@
+/**
+ * @file   RunValueCache.cxx
+ * @brief  Run-dependent database values, stored in a local file
+ * @date   October 14, 2026
+ * @see    RunValueCache.h
+ */
+
+// our header
+#include "lardata/Utilities/RunValueCache.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <cstdio> // std::rename()
+#include <fstream>
+#include <sstream>
+
+
+//------------------------------------------------------------------------------
+bool util::RunValueCache::has(int run, std::string const& field) const {
+  return find(run, field) != nullptr;
+} // util::RunValueCache::has()
+
+
+//------------------------------------------------------------------------------
+auto util::RunValueCache::find(int run, std::string const& field) const
+  -> Values_t const*
+{
+  auto const iValues = fValues.find({ run, field });
+  return (iValues == fValues.end())? nullptr: &(iValues->second);
+} // util::RunValueCache::find()
+
+
+//------------------------------------------------------------------------------
+void util::RunValueCache::set
+  (int run, std::string const& field, Values_t values)
+{
+  fValues[{ run, field }] = std::move(values);
+  fModified = true;
+} // util::RunValueCache::set()
+
+
+//------------------------------------------------------------------------------
+bool util::RunValueCache::hasRun(int run) const {
+  // the entries are sorted by run first
+  auto const iValues = fValues.lower_bound({ run, std::string() });
+  return (iValues != fValues.end()) && (iValues->first.first == run);
+} // util::RunValueCache::hasRun()
+
+
+//------------------------------------------------------------------------------
+std::size_t util::RunValueCache::load(std::string const& path) {
+
+  std::ifstream in(path);
+  if (!in) {
+    throw cet::exception("RunValueCache")
+      << "Can't open the run value cache file '" << path << "'\n";
+  }
+
+  std::size_t nEntries = 0;
+  std::size_t iLine = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    ++iLine;
+    std::istringstream sstr(line);
+    std::string first;
+    if (!(sstr >> first) || (first[0] == '#')) continue;
+
+    int run = 0;
+    std::string field;
+    std::size_t nValues = 0;
+    std::istringstream runStr(first);
+    if (!(runStr >> run) || !(sstr >> field >> nValues)) {
+      throw cet::exception("RunValueCache")
+        << "Malformed line " << iLine << " in run value cache file '"
+        << path << "'\n";
+    }
+
+    Values_t values(nValues);
+    for (std::string& value: values) {
+      if (sstr >> value) continue;
+      throw cet::exception("RunValueCache")
+        << "Line " << iLine << " in run value cache file '" << path
+        << "' has fewer than the " << nValues << " declared values\n";
+    }
+    fValues[{ run, field }] = std::move(values);
+    ++nEntries;
+  } // while
+
+  fModified = false;
+  return nEntries;
+} // util::RunValueCache::load()
+
+
+//------------------------------------------------------------------------------
+void util::RunValueCache::save(std::string const& path) {
+
+  std::string const tempPath = path + ".tmp";
+  {
+    std::ofstream out(tempPath);
+    out << "# <run> <field> <number of values> <values...>\n";
+    for (auto const& entry: fValues) {
+      out << entry.first.first << " " << entry.first.second
+        << " " << entry.second.size();
+      for (std::string const& value: entry.second) out << " " << value;
+      out << "\n";
+    } // for
+    if (!out) {
+      throw cet::exception("RunValueCache")
+        << "Failed to write the run value cache file '" << tempPath << "'\n";
+    }
+  }
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    throw cet::exception("RunValueCache")
+      << "Failed to rename '" << tempPath << "' into '" << path << "'\n";
+  }
+  fModified = false;
+} // util::RunValueCache::save()
+
+
+//------------------------------------------------------------------------------
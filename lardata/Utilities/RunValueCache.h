@@ -0,0 +1,96 @@
+/**
+ * @file   RunValueCache.h
+ * @brief  Run-dependent database values, stored in a local file
+ * @date   October 14, 2026
+ * @see    RunValueCache.cxx
+ */
+
+#ifndef LARDATA_UTILITIES_RUNVALUECACHE_H
+#define LARDATA_UTILITIES_RUNVALUECACHE_H 1
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <map>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+
+
+namespace util {
+
+  /**
+   * @brief Values of database fields, by run, with a file snapshot
+   *
+   * The cache associates to a run number and a field name (e.g. `"tau"`) the
+   * list of values extracted from the database, as text, so that the values
+   * are formatted exactly as the database returns them.
+   *
+   * The content can be written into a text file, one entry per line:
+   *
+   *     <run> <field> <number of values> <value> ...
+   *
+   * and read back, so that a job can be given the values of all its runs
+   * instead of querying the database. Empty lines and lines starting with
+   * `#` are ignored. Values must be non-empty and contain no blank.
+   */
+  class RunValueCache {
+      public:
+
+    /// Type of the values of a field
+    using Values_t = std::vector<std::string>;
+
+    /// Returns whether there are values for `field` in run `run`
+    bool has(int run, std::string const& field) const;
+
+    /// Returns the values of the field in the run, `nullptr` if not cached
+    Values_t const* find(int run, std::string const& field) const;
+
+    /// Sets the values of the field in the run, replacing existing ones
+    void set(int run, std::string const& field, Values_t values);
+
+    /// Returns whether any field of the run is cached
+    bool hasRun(int run) const;
+
+    /// Returns the number of cached entries (run and field)
+    std::size_t size() const { return fValues.size(); }
+
+    /// Returns whether there are no cached entries
+    bool empty() const { return fValues.empty(); }
+
+    /// Returns whether the content changed since the last `load()`/`save()`
+    bool modified() const { return fModified; }
+
+    /**
+     * @brief Adds the content of a file to the cache
+     * @param path the file to read
+     * @return the number of entries read
+     * @throw cet::exception (category `"RunValueCache"`) if the file can't
+     *        be read or is malformed
+     *
+     * Entries in the file replace the cached ones with the same run and field.
+     */
+    std::size_t load(std::string const& path);
+
+    /**
+     * @brief Writes the whole cache into a file
+     * @param path the file to write
+     * @throw cet::exception (category `"RunValueCache"`) on write failure
+     *
+     * The file is first written with a temporary name and then renamed, so
+     * that a job reading it never sees it incomplete.
+     */
+    void save(std::string const& path);
+
+      private:
+
+    using Key_t = std::pair<int, std::string>; ///< run and field
+
+    std::map<Key_t, Values_t> fValues; ///< all the cached values
+    bool fModified = false; ///< whether changed since last load or save
+
+  }; // class RunValueCache
+
+} // namespace util
+
+
+#endif // LARDATA_UTILITIES_RUNVALUECACHE_H
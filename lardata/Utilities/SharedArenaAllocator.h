@@ -0,0 +1,132 @@
+/**
+ * @file   SharedArenaAllocator.h
+ * @brief  Allocator drawing memory from a reference-counted arena
+ * @see    `BulkAllocator.h`
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARDATA_UTILITIES_SHAREDARENAALLOCATOR_H
+#define LARDATA_UTILITIES_SHAREDARENAALLOCATOR_H 1
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <memory> // std::shared_ptr<>, std::allocate_shared()
+#include <memory_resource> // std::pmr::monotonic_buffer_resource
+#include <utility> // std::move(), std::forward()
+
+
+namespace lar {
+
+  /// Type of the arena memory resource used by `SharedArenaAllocator`.
+  using SharedArena_t = std::pmr::memory_resource;
+
+
+  /**
+   * @brief Creates a new arena for bump allocation
+   * @param initialSize size of the first memory block [bytes] (0: default)
+   * @return a shared pointer to the new arena
+   *
+   * The arena is a `std::pmr::monotonic_buffer_resource`: allocation is a
+   * pointer bump, deallocation does nothing, and all the memory is returned
+   * in one shot when the arena is destroyed.
+   * The arena is not thread-safe.
+   */
+  inline std::shared_ptr<SharedArena_t> makeSharedArena
+    (std::size_t initialSize = 0)
+    {
+      return (initialSize > 0)
+        ? std::make_shared<std::pmr::monotonic_buffer_resource>(initialSize)
+        : std::make_shared<std::pmr::monotonic_buffer_resource>();
+    }
+
+
+  /**
+   * @brief Allocator sharing the ownership of its arena
+   * @tparam T type of the allocated objects
+   *
+   * Each copy of the allocator, including the one that
+   * `std::allocate_shared()` stores in the control block of a shared pointer,
+   * keeps the arena alive.
+   * Objects created with `makeArenaShared()` can therefore outlive the code
+   * that created the arena: the arena memory is released in one shot after the
+   * last of them is destroyed.
+   *
+   * Example:
+   *
+   *     auto arena = lar::makeSharedArena();
+   *     std::shared_ptr<const Base> p = lar::makeArenaShared<Derived>(arena, 5);
+   *     arena.reset(); // the memory is released when `p` is destroyed
+   *
+   */
+  template <typename T>
+  class SharedArenaAllocator {
+      public:
+    using value_type = T;
+
+    /// Constructor: uses the specified arena (must not be null).
+    explicit SharedArenaAllocator
+      (std::shared_ptr<SharedArena_t> arena) noexcept
+      : fArena(std::move(arena))
+      {}
+
+    /// Conversion from an allocator of different type.
+    template <typename U>
+    SharedArenaAllocator(SharedArenaAllocator<U> const& other) noexcept
+      : fArena(other.arena())
+      {}
+
+    /// Allocates memory for n objects (not constructed).
+    T* allocate(std::size_t n)
+      { return static_cast<T*>(fArena->allocate(n * sizeof(T), alignof(T))); }
+
+    /// Returns the memory to the arena (no-op for a bump arena).
+    void deallocate(T* p, std::size_t n) noexcept
+      { fArena->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    /// Returns the arena in use.
+    std::shared_ptr<SharedArena_t> const& arena() const noexcept
+      { return fArena; }
+
+      private:
+    std::shared_ptr<SharedArena_t> fArena; ///< Arena the memory comes from.
+
+  }; // class SharedArenaAllocator<>
+
+
+  /// Allocators are equal if they share the same arena.
+  template <typename T, typename U>
+  bool operator==
+    (SharedArenaAllocator<T> const& a, SharedArenaAllocator<U> const& b)
+    noexcept
+    { return a.arena() == b.arena(); }
+
+  template <typename T, typename U>
+  bool operator!=
+    (SharedArenaAllocator<T> const& a, SharedArenaAllocator<U> const& b)
+    noexcept
+    { return !(a == b); }
+
+
+  /**
+   * @brief Creates a shared object, using the arena if any
+   * @tparam T type of object to be created
+   * @param arena the arena to allocate the object (and its count) in
+   * @param args arguments for the constructor of T
+   * @return a shared pointer to the new object
+   *
+   * If `arena` is null, `std::make_shared()` is used instead.
+   */
+  template <typename T, typename... Args>
+  std::shared_ptr<T> makeArenaShared
+    (std::shared_ptr<SharedArena_t> const& arena, Args&&... args)
+    {
+      if (!arena) return std::make_shared<T>(std::forward<Args>(args)...);
+      return std::allocate_shared<T>
+        (SharedArenaAllocator<T>(arena), std::forward<Args>(args)...);
+    }
+
+} // namespace lar
+
+
+#endif // LARDATA_UTILITIES_SHAREDARENAALLOCATOR_H
@@ -9,8 +9,52 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <mutex>
+#include <unordered_map>
 #include "cetlib_except/exception.h"
 #include "lardata/Utilities/SignalShaping.h"
+#include "lardata/Utilities/SignalShapingKernelCache.h"
+
+namespace {
+
+  // Copy a TComplex kernel into std::complex vectors of both precisions.
+  void CopyKernel(std::vector<TComplex> const& kernel,
+                  std::vector<std::complex<float>>& kernelF,
+                  std::vector<std::complex<double>>& kernelD)
+  {
+    kernelF.resize(kernel.size());
+    kernelD.resize(kernel.size());
+    for(unsigned int i=0; i<kernel.size(); ++i) {
+      kernelD[i] = std::complex<double>(kernel[i].Re(), kernel[i].Im());
+      kernelF[i] = std::complex<float>(kernelD[i]);
+    }
+  }
+
+  // Fourier transform of a response function, shared across the job.
+  std::shared_ptr<std::vector<TComplex> const> ResponseKernel
+    (std::vector<double> const& resp)
+  {
+    art::ServiceHandle<util::LArFFT> fft;
+    return util::SignalShapingKernelCache::Instance().ResponseKernel(
+      resp, fft->FFTSize(),
+      [&fft](std::vector<double> const& resp, std::vector<TComplex>& kern)
+        { fft->DoFFT(const_cast<std::vector<double>&>(resp), kern); }
+      );
+  }
+
+  // Job-wide registry of the shared shapers.
+  struct SharedShapers {
+    std::mutex mutex;
+    std::unordered_map<std::string, util::SignalShaping::SharedPtr_t> shapers;
+
+    static SharedShapers& Instance()
+    {
+      static SharedShapers registry;
+      return registry;
+    }
+  };
+
+} // local namespace
 
 
 //----------------------------------------------------------------------
@@ -19,7 +63,9 @@
 util::SignalShaping::SignalShaping()
   : fResponseLocked(false)
   , fFilterLocked  (false)
+  , fDeconvKernelPolarity(+1)
   , fNorm (true)
+  , fShared(false)
 {}
 
 
@@ -29,6 +75,63 @@ util::SignalShaping::SignalShaping()
 util::SignalShaping::~SignalShaping()
 {}
 
+//----------------------------------------------------------------------
+// Lock a shaper and make it shareable.
+util::SignalShaping::SharedPtr_t util::SignalShaping::Share(SignalShaping shaping)
+{
+  // Lock everything now: a shared shaper must never change, not even
+  // lazily from its const methods.
+
+  shaping.LockResponse();
+  if(!shaping.fFilterLocked && !shaping.fFilter.empty())
+    shaping.CalculateDeconvKernel();
+  shaping.fShared = true;
+
+  return std::make_shared<SignalShaping const>(std::move(shaping));
+}
+
+
+//----------------------------------------------------------------------
+// Return the shared shaper with the specified key, creating it if needed.
+util::SignalShaping::SharedPtr_t util::SignalShaping::Shared
+  (std::string const& key, std::function<void(SignalShaping&)> const& configure)
+{
+  SharedShapers& registry = SharedShapers::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto iShaper = registry.shapers.find(key);
+  if(iShaper != registry.shapers.end())
+    return iShaper->second;
+
+  // First request: configure the shaper (if this throws, nothing is
+  // registered).
+
+  SignalShaping shaping;
+  configure(shaping);
+  SharedPtr_t shared = Share(std::move(shaping));
+  registry.shapers.emplace(key, shared);
+  return shared;
+}
+
+
+//----------------------------------------------------------------------
+std::size_t util::SignalShaping::NShared()
+{
+  SharedShapers& registry = SharedShapers::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.shapers.size();
+}
+
+
+//----------------------------------------------------------------------
+void util::SignalShaping::ClearShared()
+{
+  SharedShapers& registry = SharedShapers::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.shapers.clear();
+}
+
+
 // void util::SignalShaping::ResetDecon()
 // {
 //   fResponseLocked = false;
@@ -48,10 +151,16 @@ void util::SignalShaping::Reset()
 {
   fResponseLocked = false;
   fFilterLocked = false;
+  fShared = false;
   fResponse.clear();
   fConvKernel.clear();
   fFilter.clear();
   fDeconvKernel.clear();
+  fConvKernelF.clear();
+  fDeconvKernelF.clear();
+  fConvKernelD.clear();
+  fDeconvKernelD.clear();
+  fTransforms.reset();
   //Set deconvolution polarity to + as default
   fDeconvKernelPolarity = +1;
 }
@@ -84,16 +193,15 @@ void util::SignalShaping::AddResponseFunction(const std::vector<double>& resp, b
     // This is the first response function.
     // Just calculate the fourier transform.
 
-    fConvKernel.resize(nticks/2 + 1);
-    fft->DoFFT(fResponse, fConvKernel);
+    fConvKernel = *ResponseKernel(fResponse);
   }
   else {
 
     // Not the first response function.
     // Calculate the fourier transform of new response function.
 
-    std::vector<TComplex> kern(nticks/2 + 1);
-    fft->DoFFT(fResponse, kern);
+    auto const kernPtr = ResponseKernel(fResponse);
+    std::vector<TComplex> const& kern = *kernPtr;
 
     // Update overall convolution kernel.
 
@@ -219,7 +327,7 @@ void util::SignalShaping::LockResponse() const
 
     // Get FFT service.
 
-    art::ServiceHandle<util::LArFFT const> fft;
+    art::ServiceHandle<util::LArFFT> fft;
 
     // Make sure response has been configured.
 
@@ -238,6 +346,14 @@ void util::SignalShaping::LockResponse() const
       throw cet::exception("SignalShaping") << __func__ << ": unexpected FFT size, "
         << n << " vs. expected " << (2 * (fConvKernel.size() - 1)) << "\n";
 
+    // Prepare the kernel copies for LArFFTW.
+
+    CopyKernel(fConvKernel, fConvKernelF, fConvKernelD);
+
+    // Keep the transforms of this size.
+
+    fTransforms = fft->Transforms(n);
+
     // Set the lock flag.
 
     fResponseLocked = true;
@@ -279,16 +395,53 @@ void util::SignalShaping::CalculateDeconvKernel() const
       << fFilter.size() << " vs. " << fConvKernel.size() << "\n";
   }
 
+  // Calculate the deconvolution kernel, unless the same configuration
+  // has already been seen in this job.
+
+  auto const kernel = SignalShapingKernelCache::Instance().DeconvKernel(
+    fConvKernel, fFilter, fResponse, n, fDeconvKernelPolarity, fNorm,
+    [this](std::vector<TComplex>& kernel){ ComputeDeconvKernel(kernel); });
+  fDeconvKernel = *kernel;
+
+  // Prepare the kernel copies for LArFFTW.
+
+  CopyKernel(fDeconvKernel, fDeconvKernelF, fDeconvKernelD);
+
+  // Set the lock flag.
+
+  fFilterLocked = true;
+}
+
+
+//----------------------------------------------------------------------
+// Calculate the deconvolution kernel when it is first needed.
+void util::SignalShaping::CalculateDeconvKernelOnDemand() const
+{
+  // A shared shaper is used concurrently, and it is never modified.
+
+  if(fShared)
+    throw cet::exception("SignalShaping")
+      << "Shared shaper has no deconvolution kernel (no filter configured before sharing).\n";
+
+  CalculateDeconvKernel();
+}
+
+
+//----------------------------------------------------------------------
+// Compute the normalized deconvolution kernel from the current
+// configuration (no caching).
+void util::SignalShaping::ComputeDeconvKernel(std::vector<TComplex>& kernel) const
+{
   // Calculate deconvolution kernel as the ratio of the
   // filter function and the convolution kernel.
 
-  fDeconvKernel = fFilter;
-  for(unsigned int i=0; i<fDeconvKernel.size(); ++i) {
+  kernel = fFilter;
+  for(unsigned int i=0; i<kernel.size(); ++i) {
     if(std::abs(fConvKernel[i].Re()) <= 0.0001 && std::abs(fConvKernel[i].Im()) <= 0.0001) {
-      fDeconvKernel[i] = 0.;
+      kernel[i] = 0.;
     }
     else {
-      fDeconvKernel[i] /= fConvKernel[i];
+      kernel[i] /= fConvKernel[i];
     }
   }
 
@@ -297,6 +450,8 @@ void util::SignalShaping::CalculateDeconvKernel() const
   // Calculate the unnormalized deconvoluted response
   // (inverse FFT of filter function).
 
+  art::ServiceHandle<util::LArFFT> fft;
+  unsigned int n = fft->FFTSize();
   std::vector<double> deconv(n, 0.);
   fft->DoInvFFT(const_cast<std::vector<TComplex>&>(fFilter), deconv);
 
@@ -339,10 +494,7 @@ void util::SignalShaping::CalculateDeconvKernel() const
     // (Peak of response) = (Peak of deconvoluted response).
 
     double ratio = peak_response / peak_deconv;
-    for(unsigned int i = 0; i < fDeconvKernel.size(); ++i)
-      fDeconvKernel[i] *= ratio;
+    for(unsigned int i = 0; i < kernel.size(); ++i)
+      kernel[i] *= ratio;
   }
-  // Set the lock flag.
-
-  fFilterLocked = true;
 }
@@ -25,6 +25,28 @@
 ///
 /// After the deconvolution kernel is calculated, the configuration is locked.
 ///
+/// Response transforms and deconvolution kernels are looked up in the
+/// job-wide `SignalShapingKernelCache`, so shapers configured identically
+/// (e.g. one per channel or per thread) compute them only once.
+///
+/// Shared shapers
+/// ---------------
+///
+/// Channel groups configured with identical response and filter functions
+/// can share a single shaper instead of owning one copy each:
+/// `SignalShaping::Share()` fully locks a configured shaper and turns it
+/// into an immutable `std::shared_ptr<SignalShaping const>`, and
+/// `SignalShaping::Shared()` returns the shaper registered under a key,
+/// configuring and locking it only on the first request. The kernels of
+/// a shared shaper are computed once (including the effects of
+/// `ShiftResponseTime()` and `SetPeakResponseTime()`), and since it is
+/// completely locked its `Convolute()` and `Deconvolute()` methods can be
+/// called concurrently: the overloads taking an engine with one engine per
+/// thread, and the ones using the `LArFFT` transforms with either backend
+/// (the ROOT transforms run one at a time, the FFTW ones in parallel).
+/// A shaper shared without filter has no deconvolution kernel, and its
+/// `Deconvolute()` methods throw an exception instead of computing it.
+///
 /// Notes on time and frequency series functions
 /// ---------------------------------------------
 ///
@@ -38,6 +60,30 @@
 /// Negative frequencies (not stored) are complex conjugate of
 /// corresponding positive frequency.
 ///
+/// When the response is locked, the shaper takes from `LArFFT` the
+/// transforms of its own size (`LArFFT::Transforms()`), and `Convolute()`
+/// and `Deconvolute()` use those: a shaper keeps working at the size it
+/// was configured with also after `LArFFT` has switched to another size.
+///
+/// Single precision
+/// -----------------
+///
+/// When the configuration is locked, copies of the convolution and
+/// deconvolution kernels are also stored as `std::complex<float>` and
+/// `std::complex<double>` vectors. The `Convolute()` and `Deconvolute()`
+/// overloads taking a `util::LArFFTW` transform engine use them: for
+/// `std::vector<float>` signals the single precision kernels are used (and
+/// the transform runs in single precision if the engine has fftwf plans),
+/// for any other type the double precision ones.
+///
+/// GPU offload
+/// ------------
+///
+/// The overloads taking a `util::LArFFTWGpu` engine shape a whole collection
+/// of time series (e.g. all the channels of an event) in one batched
+/// transform, on a GPU if available; the double precision kernels stay
+/// resident on the device between calls.
+///
 /// Update notes
 /// -------------
 ///
@@ -59,26 +105,72 @@
 #define SIGNALSHAPING_H
 
 #include <vector>
+#include <complex>
+#include <memory>
+#include <string>
+#include <functional>
+#include <type_traits>
+#include <cstddef>
 #include "TComplex.h"
 
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "lardata/Utilities/LArFFT.h"
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWGpu.h"
+#include "lardata/Utilities/Instrumentation.h"
 
 namespace util {
 
+// Timers of the convolutions (see lar::Instrumentation)
+struct SignalShapingConvoluteTimer
+  { static constexpr char const* Name = "SignalShaping::Convolute"; };
+struct SignalShapingDeconvoluteTimer
+  { static constexpr char const* Name = "SignalShaping::Deconvolute"; };
+
 class SignalShaping {
 public:
 
+    // Shared, fully locked shaper.
+    using SharedPtr_t = std::shared_ptr<SignalShaping const>;
+
     // Constructor, destructor.
     SignalShaping();
+    SignalShaping(SignalShaping const&) = default;
+    SignalShaping(SignalShaping&&) = default;
+    SignalShaping& operator= (SignalShaping const&) = default;
+    SignalShaping& operator= (SignalShaping&&) = default;
     virtual ~SignalShaping();
 
+    // Lock the response of shaping, and its filter if configured,
+    // and return it as an immutable shaper which can be shared.
+    static SharedPtr_t Share(SignalShaping shaping);
+
+    // Return the shared shaper registered under key.  The first request
+    // with a key configures a default-constructed shaper by calling
+    // configure(shaper), locks it as Share() does and registers it;
+    // further requests return the same shaper, without calling
+    // configure.  The registry is job-wide and thread-safe, but
+    // configure must not call Shared() itself.
+    static SharedPtr_t Shared(std::string const& key,
+                              std::function<void(SignalShaping&)> const& configure);
+
+    // Number of registered shared shapers.
+    static std::size_t NShared();
+
+    // Remove all the registered shared shapers
+    // (the ones already handed out stay valid).
+    static void ClearShared();
+
     // Accessors.
     const std::vector<double>& Response() const {return fResponse;}
     const std::vector<double>& Response_save() const {return fResponse_save;}
     const std::vector<TComplex>& ConvKernel() const {return fConvKernel;}
     const std::vector<TComplex>& Filter() const {return fFilter;}
     const std::vector<TComplex>& DeconvKernel() const {return fDeconvKernel;}
+    const std::vector<std::complex<float>>& ConvKernelF() const {return fConvKernelF;}
+    const std::vector<std::complex<float>>& DeconvKernelF() const {return fDeconvKernelF;}
+    const std::vector<std::complex<double>>& ConvKernelD() const {return fConvKernelD;}
+    const std::vector<std::complex<double>>& DeconvKernelD() const {return fDeconvKernelD;}
     /* const int GetTimeOffset() const {return fTimeOffset;} */
 
     // Signal shaping methods.
@@ -89,6 +181,17 @@ public:
     // Convolute a time series with deconvolution kernel.
     template <class T> void Deconvolute(std::vector<T>& func) const;
 
+    // Same as above, but using the specified LArFFTW engine; the kernel
+    // precision follows the element type of the time series.
+    template <class T> void Convolute(util::LArFFTW& fft, std::vector<T>& func) const;
+    template <class T> void Deconvolute(util::LArFFTW& fft, std::vector<T>& func) const;
+
+    // Same as above, on a whole collection of time series at once (e.g. all
+    // the channels of an event), on the GPU of the engine if it has one;
+    // the kernels are in double precision.
+    template <class Coll> void Convolute(util::LArFFTWGpu& fft, Coll& funcs) const;
+    template <class Coll> void Deconvolute(util::LArFFTWGpu& fft, Coll& funcs) const;
+
 
     // Configuration methods.
 
@@ -151,6 +254,28 @@ public:
     // Deconvolution kernel (= fFilter / fConvKernel).
     mutable std::vector<TComplex> fDeconvKernel;
 
+    // Copies of the kernels for LArFFTW, in single and double precision.
+    mutable std::vector<std::complex<float>> fConvKernelF;
+    mutable std::vector<std::complex<float>> fDeconvKernelF;
+    mutable std::vector<std::complex<double>> fConvKernelD;
+    mutable std::vector<std::complex<double>> fDeconvKernelD;
+
+    // Transforms of the size of the kernels (set when response is locked).
+    mutable std::shared_ptr<util::LArFFTTransforms> fTransforms;
+
+    // Compute the deconvolution kernel from the current configuration.
+    void ComputeDeconvKernel(std::vector<TComplex>& kernel) const;
+
+    // Calculate the deconvolution kernel on the first deconvolution
+    // (throws for a shared shaper, which must not change).
+    void CalculateDeconvKernelOnDemand() const;
+
+    // Kernel copies matching the precision of time series of type T.
+    template <class T> using LArFFTWKernel_t = std::conditional_t
+      <std::is_same<T, float>::value, std::vector<std::complex<float>>, std::vector<std::complex<double>>>;
+    template <class T> LArFFTWKernel_t<T> const& LArFFTWConvKernel() const;
+    template <class T> LArFFTWKernel_t<T> const& LArFFTWDeconvKernel() const;
+
     // Deconvolution Kernel Polarity Flag
     // Set to +1 if deconv signal should be deconv to + ADC count
     // Set to -1 if one wants to normalize to - ADC count
@@ -158,6 +283,9 @@ public:
 
     // Xin added */
     bool fNorm;
+
+    // Whether this shaper was made by Share().
+    bool fShared;
 };
 
 }
@@ -166,34 +294,106 @@ public:
 // Convolute a time series with current response.
 template <class T> inline void util::SignalShaping::Convolute(std::vector<T>& func) const
 {
+  lar::ScopedTimer<SignalShapingConvoluteTimer> const timer;
+
   // Make sure response configuration is locked.
   if(!fResponseLocked)
     LockResponse();
 
-  art::ServiceHandle<util::LArFFT> fft;
-
   // Make sure that time series has the correct size.
-  if(int const n = func.size(); n != fft->FFTSize())
+  if(int const n = func.size(); n != fTransforms->Size())
     throw cet::exception("SignalShaping") << "Bad time series size = " << n << "\n";
 
-  fft->Convolute(func, const_cast<std::vector<TComplex>&>(fConvKernel));
+  fTransforms->Convolute(func, fConvKernel);
 }
 
 //----------------------------------------------------------------------
 // Convolute a time series with deconvolution kernel.
 template <class T> inline void util::SignalShaping::Deconvolute(std::vector<T>& func) const
 {
+  lar::ScopedTimer<SignalShapingDeconvoluteTimer> const timer;
+
   // Make sure deconvolution kernel is configured.
   if(!fFilterLocked)
-    CalculateDeconvKernel();
-
-  art::ServiceHandle<util::LArFFT> fft;
+    CalculateDeconvKernelOnDemand();
 
   // Make sure that time series has the correct size.
-  if(int const n = func.size(); n != fft->FFTSize())
+  if(int const n = func.size(); n != fTransforms->Size())
     throw cet::exception("SignalShaping") << "Bad time series size = " << n << "\n";
 
-  fft->Convolute(func, fDeconvKernel);
+  fTransforms->Convolute(func, fDeconvKernel);
+}
+
+//----------------------------------------------------------------------
+template <class T>
+inline auto util::SignalShaping::LArFFTWConvKernel() const -> LArFFTWKernel_t<T> const&
+{
+  if constexpr (std::is_same<T, float>::value) return fConvKernelF;
+  else                                         return fConvKernelD;
+}
+
+template <class T>
+inline auto util::SignalShaping::LArFFTWDeconvKernel() const -> LArFFTWKernel_t<T> const&
+{
+  if constexpr (std::is_same<T, float>::value) return fDeconvKernelF;
+  else                                         return fDeconvKernelD;
+}
+
+//----------------------------------------------------------------------
+// Convolute a time series with current response, using LArFFTW.
+template <class T>
+inline void util::SignalShaping::Convolute(util::LArFFTW& fft, std::vector<T>& func) const
+{
+  lar::ScopedTimer<SignalShapingConvoluteTimer> const timer;
+
+  // Make sure response configuration is locked.
+  if(!fResponseLocked)
+    LockResponse();
+
+  fft.Convolute(func, LArFFTWConvKernel<T>());
+}
+
+//----------------------------------------------------------------------
+// Convolute a time series with deconvolution kernel, using LArFFTW.
+template <class T>
+inline void util::SignalShaping::Deconvolute(util::LArFFTW& fft, std::vector<T>& func) const
+{
+  lar::ScopedTimer<SignalShapingDeconvoluteTimer> const timer;
+
+  // Make sure deconvolution kernel is configured.
+  if(!fFilterLocked)
+    CalculateDeconvKernelOnDemand();
+
+  fft.Convolute(func, LArFFTWDeconvKernel<T>());
+}
+
+//----------------------------------------------------------------------
+// Convolute time series with current response, using LArFFTWGpu.
+template <class Coll>
+inline void util::SignalShaping::Convolute(util::LArFFTWGpu& fft, Coll& funcs) const
+{
+  lar::ScopedTimer<SignalShapingConvoluteTimer> const timer;
+
+  // Make sure response configuration is locked.
+  if(!fResponseLocked)
+    LockResponse();
+
+  fft.Convolute(funcs, fConvKernelD);
+}
+
+//----------------------------------------------------------------------
+// Convolute time series with deconvolution kernel, using LArFFTWGpu.
+template <class Coll>
+inline void util::SignalShaping::Deconvolute(util::LArFFTWGpu& fft, Coll& funcs) const
+{
+  lar::ScopedTimer<SignalShapingDeconvoluteTimer> const timer;
+
+  // Make sure deconvolution kernel is configured.
+  if(!fFilterLocked)
+    CalculateDeconvKernelOnDemand();
+
+  // the deconvolution kernel already includes the division by the response
+  fft.Convolute(funcs, fDeconvKernelD);
 }
 
 #endif
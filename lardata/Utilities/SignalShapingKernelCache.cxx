@@ -0,0 +1,176 @@
+//////////////////////////////////////////////////////////////////////
+///
+/// \file   SignalShapingKernelCache.cxx
+///
+/// \brief  Job-wide cache of frequency domain signal shaping kernels.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <cstdint>
+#include "lardata/Utilities/SignalShapingKernelCache.h"
+
+namespace {
+
+  // FNV-1a hash of a sequence of doubles (bit patterns).
+  class Hasher {
+  public:
+    void add(double value)
+    {
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      for(unsigned int i=0; i<sizeof(bits); ++i) {
+        fHash ^= (bits >> (8*i)) & 0xFF;
+        fHash *= 1099511628211ULL;
+      }
+    }
+    void add(std::size_t value)
+    {
+      fHash ^= value;
+      fHash *= 1099511628211ULL;
+    }
+    std::size_t value() const { return fHash; }
+  private:
+    std::uint64_t fHash = 14695981039346656037ULL;
+  };
+
+  bool SameKernel(util::SignalShapingKernelCache::Kernel_t const& a,
+                  util::SignalShapingKernelCache::Kernel_t const& b)
+  {
+    if(a.size() != b.size()) return false;
+    for(unsigned int i=0; i<a.size(); ++i) {
+      if(a[i].Re() != b[i].Re() || a[i].Im() != b[i].Im()) return false;
+    }
+    return true;
+  }
+
+} // local namespace
+
+
+//----------------------------------------------------------------------
+util::SignalShapingKernelCache& util::SignalShapingKernelCache::Instance()
+{
+  static SignalShapingKernelCache cache;
+  return cache;
+}
+
+
+//----------------------------------------------------------------------
+std::size_t util::SignalShapingKernelCache::Hash(std::vector<double> const& v)
+{
+  Hasher h;
+  h.add(v.size());
+  for(double x: v) h.add(x);
+  return h.value();
+}
+
+std::size_t util::SignalShapingKernelCache::Hash(Kernel_t const& v)
+{
+  Hasher h;
+  h.add(v.size());
+  for(TComplex const& x: v) { h.add(x.Re()); h.add(x.Im()); }
+  return h.value();
+}
+
+
+//----------------------------------------------------------------------
+util::SignalShapingKernelCache::KernelPtr_t
+util::SignalShapingKernelCache::ResponseKernel(
+  std::vector<double> const& resp, int fftSize,
+  std::function<void(std::vector<double> const&, Kernel_t&)> const& compute)
+{
+  Hasher h;
+  h.add(Hash(resp));
+  h.add(static_cast<std::size_t>(fftSize));
+  std::size_t const key = h.value();
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto const range = fResponseKernels.equal_range(key);
+    for(auto it = range.first; it != range.second; ++it) {
+      ResponseEntry const& entry = it->second;
+      if(entry.fftSize == fftSize && entry.response == resp) return entry.kernel;
+    }
+  }
+
+  // Compute out of the lock; if another thread raced us to the same
+  // configuration, the first inserted kernel wins.
+
+  auto kernel = std::make_shared<Kernel_t>(fftSize/2 + 1);
+  compute(resp, *kernel);
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto const range = fResponseKernels.equal_range(key);
+  for(auto it = range.first; it != range.second; ++it) {
+    ResponseEntry const& entry = it->second;
+    if(entry.fftSize == fftSize && entry.response == resp) return entry.kernel;
+  }
+  fResponseKernels.emplace(key, ResponseEntry{ resp, fftSize, kernel });
+  return kernel;
+}
+
+
+//----------------------------------------------------------------------
+util::SignalShapingKernelCache::KernelPtr_t
+util::SignalShapingKernelCache::DeconvKernel(
+  Kernel_t const& convKernel, Kernel_t const& filter,
+  std::vector<double> const& response,
+  int fftSize, int polarity, bool norm,
+  std::function<void(Kernel_t&)> const& compute)
+{
+  Hasher h;
+  h.add(Hash(convKernel));
+  h.add(Hash(filter));
+  h.add(Hash(response));
+  h.add(static_cast<std::size_t>(fftSize));
+  h.add(static_cast<std::size_t>(polarity + 2));
+  h.add(static_cast<std::size_t>(norm));
+  std::size_t const key = h.value();
+
+  auto matches = [&](DeconvEntry const& entry)
+    {
+      return entry.fftSize == fftSize && entry.polarity == polarity
+        && entry.norm == norm && entry.response == response
+        && SameKernel(entry.convKernel, convKernel)
+        && SameKernel(entry.filter, filter);
+    };
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto const range = fDeconvKernels.equal_range(key);
+    for(auto it = range.first; it != range.second; ++it)
+      if(matches(it->second)) return it->second.kernel;
+  }
+
+  auto kernel = std::make_shared<Kernel_t>();
+  compute(*kernel);
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto const range = fDeconvKernels.equal_range(key);
+  for(auto it = range.first; it != range.second; ++it)
+    if(matches(it->second)) return it->second.kernel;
+  fDeconvKernels.emplace(key,
+    DeconvEntry{ convKernel, filter, response, fftSize, polarity, norm, kernel });
+  return kernel;
+}
+
+
+//----------------------------------------------------------------------
+std::size_t util::SignalShapingKernelCache::NResponseKernels() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fResponseKernels.size();
+}
+
+std::size_t util::SignalShapingKernelCache::NDeconvKernels() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fDeconvKernels.size();
+}
+
+void util::SignalShapingKernelCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fResponseKernels.clear();
+  fDeconvKernels.clear();
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   SignalShapingKernelCache.h
+///
+/// \brief  Job-wide cache of frequency domain signal shaping kernels.
+///
+/// Many `SignalShaping` objects (one per plane, per channel group, per
+/// module or per thread) are configured with the very same response and
+/// filter functions. This cache stores the kernels computed from a given
+/// configuration, so that each distinct configuration is transformed
+/// only once per job:
+///
+/// * response kernels: fourier transform of a time domain response
+///   function of a given FFT size;
+/// * deconvolution kernels: normalized ratio of a filter function and a
+///   convolution kernel, for a given FFT size, polarity and normalization
+///   flag.
+///
+/// Entries are immutable once inserted and are shared through
+/// `std::shared_ptr<... const>`; the cache can be used concurrently from
+/// many threads. Lookups are keyed by a hash of the configuration, and
+/// the full configuration is compared on a hash match, so a hash
+/// collision can never return a wrong kernel.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef SIGNALSHAPINGKERNELCACHE_H
+#define SIGNALSHAPINGKERNELCACHE_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+#include <cstddef>
+#include "TComplex.h"
+
+namespace util {
+
+class SignalShapingKernelCache {
+public:
+
+    using Kernel_t = std::vector<TComplex>;
+    using KernelPtr_t = std::shared_ptr<Kernel_t const>;
+
+    /// The cache shared by the whole job.
+    static SignalShapingKernelCache& Instance();
+
+    /// Returns the transform of resp (of size fftSize), computing it
+    /// with compute(resp, kernel) if not cached yet.
+    KernelPtr_t ResponseKernel(
+      std::vector<double> const& resp, int fftSize,
+      std::function<void(std::vector<double> const&, Kernel_t&)> const& compute);
+
+    /// Returns the deconvolution kernel for the configuration,
+    /// computing it with compute(kernel) if not cached yet.
+    KernelPtr_t DeconvKernel(
+      Kernel_t const& convKernel, Kernel_t const& filter,
+      std::vector<double> const& response,
+      int fftSize, int polarity, bool norm,
+      std::function<void(Kernel_t&)> const& compute);
+
+    /// Number of cached response kernels.
+    std::size_t NResponseKernels() const;
+
+    /// Number of cached deconvolution kernels.
+    std::size_t NDeconvKernels() const;
+
+    /// Removes all the entries (kernels already handed out stay valid).
+    void Clear();
+
+    // Hash of the content of a function.
+    static std::size_t Hash(std::vector<double> const& v);
+    static std::size_t Hash(Kernel_t const& v);
+
+private:
+
+    SignalShapingKernelCache() = default;
+
+    struct ResponseEntry {
+      std::vector<double> response;
+      int fftSize;
+      KernelPtr_t kernel;
+    };
+
+    struct DeconvEntry {
+      Kernel_t convKernel;
+      Kernel_t filter;
+      std::vector<double> response;
+      int fftSize;
+      int polarity;
+      bool norm;
+      KernelPtr_t kernel;
+    };
+
+    mutable std::mutex fMutex;
+    std::unordered_multimap<std::size_t, ResponseEntry> fResponseKernels;
+    std::unordered_multimap<std::size_t, DeconvEntry> fDeconvKernels;
+};
+
+}
+
+#endif
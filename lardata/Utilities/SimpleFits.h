@@ -6,7 +6,9 @@
  *
  * Currently includes:
  *  - LinearFit
- *  -
+ *  - QuadraticFit
+ *  - GaussianFit
+ *  - makeFits(), filling many fitters from data in a single set of arrays
  *
  */
 
@@ -19,9 +21,12 @@
 #include <array>
 #include <iterator> // std::begin(), std::end()
 #include <algorithm> // std::for_each()
-#include <type_traits> // std::enable_if<>, std::is_const<>
-#include <stdexcept> // std::range_error
+#include <type_traits> // std::enable_if<>, std::is_const<>, std::is_pointer<>
+#include <stdexcept> // std::range_error, std::length_error
 #include <ostream> // std::endl
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits<>
+#include <vector>
 
 
 #include "lardataalg/Utilities/StatCollector.h" // lar::util::identity
@@ -36,38 +41,6 @@ namespace lar {
       template <typename T, unsigned int D>
       class FitDataCollector {
 
-        /**
-         * @details
-         * The "extractor" is just a C++ trick to replace a statement like:
-         *
-         *     (N == 0)? weight.Weights(): sums.template SumN<N>()
-         *
-         * where N is a constexpr number. The problem is that SumN<0> is not
-         * valid (in our case, it raises a static assertion). The analysis of
-         * the full statement shows that it would not be a problem, since the
-         * compiler could remove the ternary operator since it always knows
-         * whether N is 0 or not. Matter of fact, the compiler can also choose
-         * to be dumb and compile the whole thing, including a SumN<0>.
-         *
-         * The trick is in the form of a class that gets specialized for N = 0.
-         * A long list of limitations in C++ (up to 2014 at least) forces the
-         * implementation in a struct.
-         */
-        template <unsigned int Power, unsigned int N>
-        struct SumExtractor {
-          static T Sum
-            (WeightTracker<T> const&, DataTracker<Power, T> const& sums)
-            { return sums.template SumN<N>(); }
-        }; // SumExtractor
-
-        // specialization
-        template <unsigned int Power>
-        struct SumExtractor<Power, 0U> {
-          static T Sum
-            (WeightTracker<T> const& weight, DataTracker<Power, T> const&)
-            { return weight.Weights(); }
-        }; // SumExtractor<>
-
           public:
         /// Degree of the fit
         static constexpr unsigned int Degree = D;
@@ -254,6 +227,91 @@ namespace lar {
         unsigned int add_with_uncertainty(Cont cont)
           { return add_with_uncertainty(std::begin(cont), std::end(cont)); }
 
+
+        /**
+         * @brief Adds measurements from separate arrays of x, y and uncertainty
+         * @param x pointer to the first of the `n` x values
+         * @param y pointer to the first of the `n` y values
+         * @param sy pointer to the first of the `n` uncertainties on y
+         *           (if `nullptr`, all uncertainties are 1)
+         * @param n number of measurements
+         * @return number of points added
+         *
+         * All the sums are updated in a single pass on the arrays, with the
+         * points processed a few at a time in independent partial sums, which
+         * the compiler can vectorize.
+         * The result is the same as adding the points one by one, apart from
+         * the rounding.
+         *
+         * Points with zero or infinite uncertainty are ignored and not added.
+         */
+        unsigned int add_arrays
+          (Data_t const* x, Data_t const* y, Data_t const* sy, std::size_t n);
+
+        /**
+         * @brief Adds measurements from separate containers of x, y and sigma
+         * @tparam XCont type of contiguous container of x values
+         * @tparam YCont type of contiguous container of y values
+         * @tparam SCont type of contiguous container of uncertainties on y
+         * @param x container of the x values
+         * @param y container of the y values
+         * @param sy container of the uncertainties on y
+         * @return number of points added
+         * @throws std::length_error if the containers have different sizes
+         * @see add_arrays(Data_t const*, Data_t const*, Data_t const*, std::size_t)
+         *
+         * The containers must store `Data_t` values contiguously and support
+         * `std::data()` and `std::size()`, like `std::vector` does.
+         */
+        template <typename XCont, typename YCont, typename SCont>
+        unsigned int add_arrays
+          (XCont const& x, YCont const& y, SCont const& sy)
+          {
+            CheckSizes(std::size(x), std::size(y));
+            CheckSizes(std::size(x), std::size(sy));
+            return
+              add_arrays(std::data(x), std::data(y), std::data(sy), std::size(x));
+          }
+
+        /**
+         * @brief Adds measurements from separate containers of x and y
+         * @tparam XCont type of contiguous container of x values
+         * @tparam YCont type of contiguous container of y values
+         * @param x container of the x values
+         * @param y container of the y values
+         * @return number of points added
+         * @throws std::length_error if the containers have different sizes
+         * @see add_arrays(XCont const&, YCont const&, SCont const&)
+         *
+         * All the measurements have uncertainty 1.
+         */
+        template <typename XCont, typename YCont>
+        unsigned int add_arrays(XCont const& x, YCont const& y)
+          {
+            CheckSizes(std::size(x), std::size(y));
+            return add_arrays(std::data(x), std::data(y), nullptr, std::size(x));
+          }
+
+
+        /**
+         * @brief Adds all the entries of another collector to this one
+         * @param other the collector with the entries to be added
+         * @return this collector
+         *
+         * The result is the same as if all the entries added to `other` had
+         * been added to this collector, up to the rounding of the sums.
+         * Data can then be collected in parts (e.g. by different threads or
+         * jobs) and the parts combined before fitting; for a result
+         * independent of the number of threads, see
+         * `lar::util::deterministicReduce()`.
+         */
+        FitDataCollector& merge(FitDataCollector const& other);
+
+        /// Adds all the entries of another collector to this one
+        /// @see merge()
+        FitDataCollector& operator+= (FitDataCollector const& other)
+          { return merge(other); }
+
         ///@}
 
         /// Clears all the statistics
@@ -263,7 +321,7 @@ namespace lar {
         /// @name Statistic retrieval
 
         /// Returns the number of entries added
-        int N() const { return s2.N(); }
+        int N() const { return n; }
 
         /**
          * @brief Returns an average of the uncertainties
@@ -274,8 +332,7 @@ namespace lar {
          * (that is, the errors squared):
          * @f$ \bar{s}^{-2} = \frac{1}{N} \sum_{i=1}^{N} s_{y}^{-2} @f$
          */
-        Data_t AverageUncertainty() const
-          { return WeightToUncertainty(s2.AverageWeight()); }
+        Data_t AverageUncertainty() const;
 
 
         /// Returns the square of the specified value
@@ -285,26 +342,34 @@ namespace lar {
 
         /// Returns the weighted sum of x^n
         Data_t XN(unsigned int n) const
-          { return (n == 0)? s2.Weights(): x.Sum(n); }
+          { return (n == 0)? s2: (n <= x.size())? x[n - 1]: Data_t(0); }
 
         /// Returns the weighted sum of x^n y
         Data_t XNY(unsigned int n) const
-          { return (n == 0)? y.Weights(): xy.Sum(n); }
+          { return (n == 0)? y: (n <= xy.size())? xy[n - 1]: Data_t(0); }
 
 
         /// Returns the weighted sum of x^N
         template <unsigned int N>
         Data_t XN() const
-          { return SumExtractor<decltype(x)::Power, N>::Sum(s2, x); }
+          {
+            static_assert(N <= 2 * Degree, "XN<N>(): N too large");
+            if constexpr (N == 0) return s2;
+            else return std::get<N - 1>(x);
+          }
 
         /// Returns the weighted sum of x^N y
         template <unsigned int N>
         Data_t XNY() const
-          { return SumExtractor<decltype(xy)::Power, N>::Sum(y, xy); }
+          {
+            static_assert(N <= Degree, "XNY<N>(): N too large");
+            if constexpr (N == 0) return y;
+            else return std::get<N - 1>(xy);
+          }
 
 
         /// Returns the weighted sum of y^2
-        Data_t Y2() const { return y2.template SumN<1>(); }
+        Data_t Y2() const { return y2; }
 
 
         /// @}
@@ -324,11 +389,26 @@ namespace lar {
 
           protected:
 
-        WeightTracker<Data_t> s2;        ///< accumulator for uncertainty
-        DataTracker<Degree*2, Data_t> x; ///< accumulator for variable x^k
-        WeightTracker<Data_t> y;         ///< accumulator for y
-        DataTracker<1, Data_t> y2;       ///< accumulator for y2
-        DataTracker<Degree, Data_t> xy;  ///< accumulator for variable xy
+        // the sums are kept here rather than in `lar::util::DataTracker`
+        // objects, so that they can be updated by bulk
+
+        int n = 0;                               ///< number of entries
+        Data_t s2 = Data_t(0);                   ///< sum of 1/s^2
+        std::array<Data_t, Degree*2> x {};       ///< sums of x^k/s^2
+        Data_t y = Data_t(0);                    ///< sum of y/s^2
+        Data_t y2 = Data_t(0);                   ///< sum of y^2/s^2
+        std::array<Data_t, Degree> xy {};        ///< sums of x^k y/s^2
+
+        /// Number of points processed together by `add_arrays()`
+        static constexpr std::size_t NLanes = 4;
+
+        /// Throws `std::length_error` if the two sizes differ
+        static void CheckSizes(std::size_t a, std::size_t b)
+          {
+            if (a == b) return;
+            throw std::length_error
+              ("FitDataCollector::add_arrays(): containers of different sizes");
+          }
 
       }; // class FitDataCollector<>
 
@@ -415,6 +495,24 @@ namespace lar {
         unsigned int add_with_uncertainty(Cont cont)
           { return stats.add_with_uncertainty(cont); }
 
+
+        unsigned int add_arrays
+          (Data_t const* x, Data_t const* y, Data_t const* sy, std::size_t n)
+          { return stats.add_arrays(x, y, sy, n); }
+
+        template <typename XCont, typename YCont, typename SCont>
+        unsigned int add_arrays
+          (XCont const& x, YCont const& y, SCont const& sy)
+          { return stats.add_arrays(x, y, sy); }
+
+        template <typename XCont, typename YCont>
+        unsigned int add_arrays(XCont const& x, YCont const& y)
+          { return stats.add_arrays(x, y); }
+
+        /// Adds all the data of another fitter to this one
+        void merge(SimplePolyFitterDataBase const& other)
+          { stats.merge(other.stats); }
+
         ///@}
 
         /// Clears all the statistics
@@ -869,6 +967,18 @@ namespace lar {
 
       // default constructor, destructor and all the rest
 
+      /**
+       * @brief Adds all the data of another fitter to this one
+       * @param other the fitter with the data to be added
+       * @return this fitter
+       * @see details::FitDataCollector::merge()
+       */
+      LinearFit& merge(LinearFit const& other)
+        { Base_t::merge(other); return *this; }
+
+      /// Adds all the data of another fitter to this one
+      LinearFit& operator+= (LinearFit const& other) { return merge(other); }
+
       /**
        * @brief Returns the intercept of the fit
        * @return the intercept of the fit, in y units
@@ -973,6 +1083,19 @@ namespace lar {
 
       // default constructor, destructor and all the rest
 
+      /**
+       * @brief Adds all the data of another fitter to this one
+       * @param other the fitter with the data to be added
+       * @return this fitter
+       * @see details::FitDataCollector::merge()
+       */
+      QuadraticFit& merge(QuadraticFit const& other)
+        { Base_t::merge(other); return *this; }
+
+      /// Adds all the data of another fitter to this one
+      QuadraticFit& operator+= (QuadraticFit const& other)
+        { return merge(other); }
+
       /**
        * @brief Returns the @f$ \chi^{2} @f$ of the fit
        * @return the @f$ \chi^{2} @f$ of the fit (not divided by NDF())
@@ -1093,6 +1216,64 @@ namespace lar {
         { return add_with_uncertainty(std::begin(cont), std::end(cont)); }
 
 
+      /**
+       * @brief Adds measurements from separate arrays of x, y and uncertainty
+       * @param x pointer to the first of the `n` x values
+       * @param y pointer to the first of the `n` y values
+       * @param sy pointer to the first of the `n` uncertainties on y
+       *           (if `nullptr`, all uncertainties are 1)
+       * @param n number of measurements
+       * @return number of points added
+       * @see FitDataCollector::add_arrays()
+       *
+       * The values are converted for the quadratic fit a block at a time,
+       * and each block is added to the fitter in a single pass.
+       * Non-positive values are ignored.
+       */
+      unsigned int add_arrays
+        (Data_t const* x, Data_t const* y, Data_t const* sy, std::size_t n);
+
+      template <typename XCont, typename YCont, typename SCont>
+      unsigned int add_arrays
+        (XCont const& x, YCont const& y, SCont const& sy)
+        {
+          if ((std::size(x) != std::size(y)) || (std::size(x) != std::size(sy)))
+          {
+            throw std::length_error
+              ("GaussianFit::add_arrays(): containers of different sizes");
+          }
+          return
+            add_arrays(std::data(x), std::data(y), std::data(sy), std::size(x));
+        }
+
+      template <typename XCont, typename YCont>
+      unsigned int add_arrays(XCont const& x, YCont const& y)
+        {
+          if (std::size(x) != std::size(y)) {
+            throw std::length_error
+              ("GaussianFit::add_arrays(): containers of different sizes");
+          }
+          return add_arrays(std::data(x), std::data(y), nullptr, std::size(x));
+        }
+
+
+      /**
+       * @brief Adds all the data of another fitter to this one
+       * @param other the fitter with the data to be added
+       * @return this fitter
+       *
+       * The data is merged after the conversion for the quadratic fit, which
+       * does not depend on the other data.
+       * @see details::FitDataCollector::merge()
+       */
+      GaussianFit& merge(GaussianFit const& other)
+        { fitter.merge(other.fitter); return *this; }
+
+      /// Adds all the data of another fitter to this one
+      GaussianFit& operator+= (GaussianFit const& other)
+        { return merge(other); }
+
+
       /// Clears all the input statistics
       void clear() { fitter.clear(); }
 
@@ -1425,9 +1606,79 @@ namespace lar {
       static void ThrowNotImplemented [[noreturn]] (std::string method)
         { throw std::logic_error("Method " + method + "() not implemented"); }
 
+      /// Number of points converted at a time by `add_arrays()`
+      static constexpr std::size_t BlockSize = 64;
+
     }; // class GaussianFit<>
 
 
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Fills one fitter for each of many small datasets
+     * @tparam Fitter type of fitter (e.g. `LinearFit<double>`)
+     * @tparam OffsetCont type of container of dataset offsets
+     * @param offsets where each dataset starts in the data; `N + 1` entries
+     * @param x pointer to the x values of all the datasets
+     * @param y pointer to the y values of all the datasets
+     * @param sy pointer to the uncertainties of all the datasets
+     *           (if `nullptr`, all uncertainties are 1)
+     * @return a collection of fitters, one per dataset, with their data
+     *
+     * The data of all the datasets is stored in separate arrays of x, y and
+     * uncertainty ("structure of arrays" layout), one dataset after the
+     * other: dataset `i` spans from `offsets[i]` to `offsets[i + 1]`
+     * (excluded), and `offsets` must have one more entry than the number of
+     * datasets.
+     * Each dataset is added to its fitter with `add_arrays()`; the results
+     * are then available from each fitter.
+     *
+     * Example fitting the peaks of many hits at once:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * auto const fits = lar::util::makeFits<lar::util::GaussianFit<double>>
+     *   (peakOffsets, ticks.data(), ADCs.data(), nullptr);
+     * for (auto const& fit: fits) {
+     *   lar::util::GaussianFit<double>::FitParameters_t params, errors;
+     *   if (!fit.FillResults(params, errors)) continue;
+     *   // ...
+     * }
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    template <typename Fitter, typename OffsetCont>
+    std::vector<Fitter> makeFits(
+      OffsetCont const& offsets,
+      typename Fitter::Data_t const* x,
+      typename Fitter::Data_t const* y,
+      typename Fitter::Data_t const* sy
+      );
+
+
+    /**
+     * @brief Fills one fitter for each of many small datasets
+     * @tparam Fitter type of fitter (e.g. `LinearFit<double>`)
+     * @tparam OffsetCont type of container of dataset offsets
+     * @tparam XCont type of contiguous container of x values
+     * @tparam YCont type of contiguous container of y values
+     * @tparam SCont type of contiguous container of uncertainties on y
+     * @param offsets where each dataset starts in the data; `N + 1` entries
+     * @param x the x values of all the datasets
+     * @param y the y values of all the datasets
+     * @param sy the uncertainties of all the datasets
+     * @return a collection of fitters, one per dataset, with their data
+     * @throws std::length_error if the containers have different sizes
+     *                           or the last offset is beyond their end
+     * @see makeFits(OffsetCont const&, Data_t const*, Data_t const*, Data_t const*)
+     */
+    template <
+      typename Fitter,
+      typename OffsetCont, typename XCont, typename YCont, typename SCont,
+      typename = std::enable_if_t<!std::is_pointer<XCont>::value>
+      >
+    std::vector<Fitter> makeFits(
+      OffsetCont const& offsets,
+      XCont const& x, YCont const& y, SCont const& sy
+      );
+
+
   } // namespace util
 } // namespace lar
 
@@ -1447,20 +1698,76 @@ bool lar::util::details::FitDataCollector<T, D>::add
 {
   Data_t w = UncertaintyToWeight(sy);
   if (!std::isnormal(w)) return false;
+  ++n;
   // the x section has a 1/s^2 weight; we track that weight separately
-  s2.add(w);
-  x.add(x_value, w);
+  s2 += w;
+  Data_t xw = w;
+  for (Data_t& sum: x) sum += (xw *= x_value);
   // we treat the y section as if it were a x section with a y/s^2 weight;
   // we track that weight separately
   Data_t yw = y_value * w;
-  y.add(yw);
-  y2.add(sqr(y_value), w); // used only for chi^2
-  xy.add(x_value, yw);
+  y += yw;
+  y2 += y_value * yw; // used only for chi^2
+  for (Data_t& sum: xy) sum += (yw *= x_value);
 
   return true; // we did add the value
 } // FitDataCollector<>::add()
 
 
+template <typename T, unsigned int D>
+unsigned int lar::util::details::FitDataCollector<T, D>::add_arrays
+  (Data_t const* x_values, Data_t const* y_values, Data_t const* sy_values,
+  std::size_t n_values)
+{
+  constexpr unsigned int NX = Degree * 2;
+  constexpr Data_t MinWeight = std::numeric_limits<Data_t>::min();
+  constexpr Data_t MaxWeight = std::numeric_limits<Data_t>::max();
+
+  // partial sums, one per lane; points with invalid weight contribute 0
+  int nLane[NLanes] = {};
+  Data_t s2Lane[NLanes] = {}, yLane[NLanes] = {}, y2Lane[NLanes] = {};
+  Data_t xLane[NX][NLanes] = {}, xyLane[Degree][NLanes] = {};
+
+  auto addPoint
+    = [&, x_values, y_values, sy_values](std::size_t i, std::size_t lane)
+    {
+      Data_t const wRaw = sy_values
+        ? UncertaintyToWeight(sy_values[i]): Data_t(1.0);
+      // same as std::isnormal() for non-negative weights, but vectorizable
+      bool const good = (wRaw >= MinWeight) && (wRaw <= MaxWeight);
+      Data_t const w = good? wRaw: Data_t(0);
+      Data_t const x_value = good? x_values[i]: Data_t(0);
+      Data_t const y_value = good? y_values[i]: Data_t(0);
+      nLane[lane] += good;
+      s2Lane[lane] += w;
+      Data_t xw = w;
+      for (unsigned int k = 0; k < NX; ++k) xLane[k][lane] += (xw *= x_value);
+      Data_t yw = y_value * w;
+      yLane[lane] += yw;
+      y2Lane[lane] += y_value * yw;
+      for (unsigned int k = 0; k < Degree; ++k)
+        xyLane[k][lane] += (yw *= x_value);
+    };
+
+  std::size_t i = 0;
+  for (; i + NLanes <= n_values; i += NLanes)
+    for (std::size_t lane = 0; lane < NLanes; ++lane) addPoint(i + lane, lane);
+  for (std::size_t lane = 0; i < n_values; ++i, ++lane) addPoint(i, lane);
+
+  unsigned int added = 0;
+  for (std::size_t lane = 0; lane < NLanes; ++lane) {
+    added += nLane[lane];
+    s2 += s2Lane[lane];
+    for (unsigned int k = 0; k < NX; ++k) x[k] += xLane[k][lane];
+    y += yLane[lane];
+    y2 += y2Lane[lane];
+    for (unsigned int k = 0; k < Degree; ++k) xy[k] += xyLane[k][lane];
+  } // for lanes
+  n += added;
+  return added;
+} // FitDataCollector<>::add_arrays()
+
+
 template <typename T, unsigned int D>
 template <typename Iter, typename Pred>
 void lar::util::details::FitDataCollector<T, D>::add_without_uncertainty
@@ -1505,30 +1812,57 @@ unsigned int lar::util::details::FitDataCollector<T, D>::add_with_uncertainty
 
 
 
+template <typename T, unsigned int D>
+auto lar::util::details::FitDataCollector<T, D>::merge
+  (FitDataCollector const& other) -> FitDataCollector&
+{
+  n += other.n;
+  s2 += other.s2;
+  for (unsigned int k = 0; k < x.size(); ++k) x[k] += other.x[k];
+  y += other.y;
+  y2 += other.y2;
+  for (unsigned int k = 0; k < xy.size(); ++k) xy[k] += other.xy[k];
+  return *this;
+} // FitDataCollector<>::merge()
+
+
 template <typename T, unsigned int D>
 inline void lar::util::details::FitDataCollector<T, D>::clear() {
-  s2.clear();
-  x.clear();
-  y.clear();
-  y2.clear();
-  xy.clear();
+  n = 0;
+  s2 = Data_t(0);
+  x.fill(Data_t(0));
+  y = Data_t(0);
+  y2 = Data_t(0);
+  xy.fill(Data_t(0));
 } // FitDataCollector<>::clear()
 
 
+template <typename T, unsigned int D>
+auto lar::util::details::FitDataCollector<T, D>::AverageUncertainty() const
+  -> Data_t
+{
+  if (n == 0) {
+    throw std::range_error
+      ("FitDataCollector<>::AverageUncertainty(): no data");
+  }
+  return WeightToUncertainty(s2 / n);
+} // FitDataCollector<>::AverageUncertainty()
+
+
 template <typename T, unsigned int D> template <typename Stream>
 void lar::util::details::FitDataCollector<T, D>::Print(Stream& out) const {
 
-  out << "Sums  1/s^2=" << s2.Weights()
-    << "\n      x/s^2=" << x.template SumN<1>();
-  for (unsigned int degree = 2; degree <= x.Power; ++degree)
-    out << "\n    x^" << degree << "/s^2=" << x.Sum(degree);
+  out << "Sums  1/s^2=" << s2
+    << "\n      x/s^2=" << x[0];
+  for (unsigned int degree = 2; degree <= x.size(); ++degree)
+    out << "\n    x^" << degree << "/s^2=" << XN(degree);
   out
-    << "\n      y/s^2=" << y.Weights()
-    << "\n    y^2/s^2=" << y2.Sum();
-  if (xy.Power >= 1)
-    out << "\n     xy/s^2=" << xy.template SumN<1>();
-  for (unsigned int degree = 2; degree <= xy.Power; ++degree)
-    out << "\n   x^" << degree << "y/s^2=" << xy.Sum(degree);
+    << "\n      y/s^2=" << y
+    << "\n    y^2/s^2=" << y2;
+  if (xy.size() >= 1)
+    out << "\n     xy/s^2=" << xy[0];
+  for (unsigned int degree = 2; degree <= xy.size(); ++degree)
+    out << "\n   x^" << degree << "y/s^2=" << XNY(degree);
   out << std::endl;
 } // FitDataCollector<>::Print()
 
@@ -1834,6 +2168,30 @@ unsigned int lar::util::GaussianFit<T>::add_with_uncertainty
 } // GaussianFit<T>::add_with_uncertainty()
 
 
+template <typename T>
+unsigned int lar::util::GaussianFit<T>::add_arrays
+  (Data_t const* x, Data_t const* y, Data_t const* sy, std::size_t n)
+{
+  constexpr Data_t Infinity = std::numeric_limits<Data_t>::infinity();
+
+  Data_t values[BlockSize], errors[BlockSize];
+  unsigned int added = 0;
+  for (std::size_t start = 0; start < n; start += BlockSize) {
+    std::size_t const nBlock = std::min(BlockSize, n - start);
+    for (std::size_t i = 0; i < nBlock; ++i) {
+      Data_t const value = y[start + i];
+      Data_t const error = sy? sy[start + i]: Data_t(1.0);
+      // non-positive values get infinite uncertainty: the fitter skips them
+      bool const good = value > Data_t(0);
+      values[i] = good? std::log(value): Data_t(0);
+      errors[i] = good? (error / value): Infinity;
+    } // for
+    added += fitter.add_arrays(x + start, values, errors, nBlock);
+  } // for blocks
+  return added;
+} // GaussianFit<T>::add_arrays()
+
+
 //
 // fitting interface
 //
@@ -2046,4 +2404,54 @@ bool lar::util::GaussianFit<T>::isValid
 //******************************************************************************
 
 
+//******************************************************************************
+//***  makeFits()
+//***
+template <typename Fitter, typename OffsetCont>
+std::vector<Fitter> lar::util::makeFits(
+  OffsetCont const& offsets,
+  typename Fitter::Data_t const* x,
+  typename Fitter::Data_t const* y,
+  typename Fitter::Data_t const* sy
+) {
+  std::size_t const nOffsets = std::size(offsets);
+  std::vector<Fitter> fits((nOffsets > 0)? (nOffsets - 1): 0);
+  auto iOffset = std::begin(offsets);
+  for (Fitter& fit: fits) {
+    std::size_t const first = *iOffset;
+    std::size_t const last = *(++iOffset);
+    fit.add_arrays
+      (x + first, y + first, (sy? (sy + first): nullptr), last - first);
+  } // for
+  return fits;
+} // lar::util::makeFits(Data_t const*)
+
+
+template <
+  typename Fitter,
+  typename OffsetCont, typename XCont, typename YCont, typename SCont,
+  typename
+  >
+std::vector<Fitter> lar::util::makeFits(
+  OffsetCont const& offsets,
+  XCont const& x, YCont const& y, SCont const& sy
+) {
+  std::size_t const n = std::size(x);
+  if ((std::size(y) != n) || (std::size(sy) != n)) {
+    throw std::length_error
+      ("lar::util::makeFits(): data containers of different sizes");
+  }
+  if ((std::size(offsets) > 0)
+    && (std::size_t(*std::prev(std::end(offsets))) > n))
+  {
+    throw std::length_error
+      ("lar::util::makeFits(): datasets extend beyond the data");
+  }
+  return makeFits<Fitter>(offsets, std::data(x), std::data(y), std::data(sy));
+} // lar::util::makeFits(XCont, YCont, SCont)
+
+
+//******************************************************************************
+
+
 #endif // SIMPLEFITS_H
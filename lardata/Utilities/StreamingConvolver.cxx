@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////
+///
+/// \file   StreamingConvolver.cxx
+///
+/// \brief  Block convolution of arbitrarily long signals.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include "cetlib_except/exception.h"
+#include "lardata/Utilities/StreamingConvolver.h"
+
+namespace {
+
+  util::LArFFTW::ComplexVector ToComplexVector(std::vector<TComplex> const& kernel)
+  {
+    util::LArFFTW::ComplexVector result(kernel.size());
+    for(unsigned int i=0; i<kernel.size(); ++i)
+      result[i] = std::complex<double>(kernel[i].Re(), kernel[i].Im());
+    return result;
+  }
+
+} // local namespace
+
+
+//----------------------------------------------------------------------
+util::StreamingConvolver::StreamingConvolver(LArFFTW& fft, int fftSize,
+                                             LArFFTW::ComplexVector const& kernel,
+                                             int pre, int post, Method method)
+  : fFFT(&fft)
+  , fSize(fftSize)
+  , fPre(pre)
+  , fPost(post)
+  , fStep(fftSize - pre - post)
+  , fMethod(method)
+  , fKernel(kernel)
+  , fBlock(fftSize, 0.)
+{
+  if(fPre < 0 || fPost < 0)
+    throw cet::exception("StreamingConvolver")
+      << "Kernel response extent must not be negative (pre " << fPre
+      << ", post " << fPost << ")\n";
+  if(fStep <= 0)
+    throw cet::exception("StreamingConvolver")
+      << "Kernel response (" << fPre << " + " << fPost
+      << " ticks) does not fit FFT size " << fSize << "\n";
+  if(2 * (fKernel.size() - 1) != (unsigned int) fSize)
+    throw cet::exception("StreamingConvolver")
+      << "Kernel size " << fKernel.size() << " does not match FFT size "
+      << fSize << "\n";
+
+  Reset();
+}
+
+
+//----------------------------------------------------------------------
+util::StreamingConvolver::StreamingConvolver(LArFFTW& fft, int fftSize,
+                                             std::vector<TComplex> const& kernel,
+                                             int pre, int post, Method method)
+  : StreamingConvolver(fft, fftSize, ToComplexVector(kernel), pre, post, method)
+{}
+
+
+//----------------------------------------------------------------------
+void util::StreamingConvolver::Reset()
+{
+  fInput.clear();
+  fReady.clear();
+  fNInput = 0;
+  fNOutput = 0;
+  fNProcessed = 0;
+
+  if(fMethod == kOverlapSave) {
+    // The first block starts fPost ticks before the stream,
+    // so that its first valid output is tick 0.
+    fInput.assign(fPost, 0.);
+    fAccum.clear();
+  }
+  else {
+    // The accumulator starts at tick -fPre.
+    fAccum.assign(fSize, 0.);
+  }
+}
+
+
+//----------------------------------------------------------------------
+void util::StreamingConvolver::Process(bool flush)
+{
+  if(fMethod == kOverlapSave) ProcessOverlapSave(flush);
+  else                        ProcessOverlapAdd(flush);
+}
+
+
+//----------------------------------------------------------------------
+// Each block of fSize input ticks starting at tick s yields the ticks
+// [ s + fPost, s + fSize - fPre ) of the linear convolution; the next
+// block starts fStep ticks later.
+void util::StreamingConvolver::ProcessOverlapSave(bool flush)
+{
+  while(true) {
+    std::size_t const produced = fNOutput + fReady.size();
+    if(produced >= fNInput && (flush || fNInput == 0)) break;
+    if(!flush && fInput.size() < (std::size_t) fSize) break;
+
+    std::size_t const n = std::min<std::size_t>(fInput.size(), fSize);
+    std::copy(fInput.begin(), fInput.begin() + n, fBlock.begin());
+    std::fill(fBlock.begin() + n, fBlock.end(), 0.);
+
+    fFFT->ConvoluteInPlace(fBlock, fKernel);
+
+    // in the last blocks, output only as many ticks as the input had
+    std::size_t nOut = fStep;
+    if(flush) nOut = std::min<std::size_t>(nOut, fNInput - produced);
+    fReady.insert(fReady.end(), fBlock.begin() + fPost, fBlock.begin() + fPost + nOut);
+
+    fInput.erase(fInput.begin(), fInput.begin() + std::min<std::size_t>(fStep, fInput.size()));
+  }
+}
+
+
+//----------------------------------------------------------------------
+// Each chunk of fStep input ticks starting at tick c is zero-padded to
+// fSize and contributes to the ticks [ c - fPre, c + fStep + fPost ) of
+// the linear convolution; ticks before c + fStep - fPre have received
+// all their contributions after that chunk.
+void util::StreamingConvolver::ProcessOverlapAdd(bool flush)
+{
+  while(true) {
+    std::size_t const produced = fNOutput + fReady.size();
+    if(produced >= fNInput && (flush || fNInput == 0)) break;
+    if(!flush && fInput.size() < (std::size_t) fStep) break;
+
+    std::size_t const n = std::min<std::size_t>(fInput.size(), fStep);
+    std::copy(fInput.begin(), fInput.begin() + n, fBlock.begin());
+    std::fill(fBlock.begin() + n, fBlock.end(), 0.);
+    fInput.erase(fInput.begin(), fInput.begin() + n);
+
+    fFFT->ConvoluteInPlace(fBlock, fKernel);
+
+    // the accumulator starts fPre ticks before the chunk;
+    // negative offsets wrap around the end of the block
+    for(int m = -fPre; m < fStep + fPost; ++m)
+      fAccum[m + fPre] += fBlock[(m + fSize) % fSize];
+
+    // ticks before the start of the stream are dropped, and no more
+    // output ticks than input ticks are produced
+    long long const tick0 = (long long) fNProcessed - fPre;
+    for(int i = 0; i < fStep; ++i) {
+      long long const tick = tick0 + i;
+      if(tick < 0) continue;
+      if((std::size_t) tick >= fNInput) break;
+      fReady.push_back(fAccum[i]);
+    }
+    fNProcessed += fStep;
+
+    std::copy(fAccum.begin() + fStep, fAccum.end(), fAccum.begin());
+    std::fill(fAccum.end() - fStep, fAccum.end(), 0.);
+  }
+}
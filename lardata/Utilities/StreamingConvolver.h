@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file   StreamingConvolver.h
+///
+/// \brief  Block convolution of arbitrarily long signals.
+///
+/// `SignalShaping` and `LArFFTW` work on time series of exactly the FFT
+/// size. This class applies one of their frequency domain kernels to a
+/// stream of any length (continuous readout, supernova buffers...),
+/// processing it in blocks of the FFT size with the overlap-save or the
+/// overlap-add method, and keeping only one block worth of memory.
+///
+/// The kernel is described by the extent of its impulse response:
+/// `post` ticks after the impulse (causal part) and `pre` ticks before it
+/// (non-causal part, e.g. wrapped around the end of a deconvolution
+/// kernel); response outside this range is neglected. Each block yields
+/// `FFTSize() - pre - post` output ticks, which must be positive.
+///
+/// Samples are fed incrementally with `Feed()`, e.g. as DAQ fragments
+/// arrive; the output ticks that are final are appended to the output
+/// vector, lagging the input by `pre` ticks plus the block latency.
+/// `Finish()` flushes the remaining output, so that in total as many
+/// output ticks as input ticks are produced, aligned with the input
+/// (as a "same" size linear convolution), and the convolver is ready
+/// for a new stream.
+///
+/// Example; a deconvolution with a kernel whose response extends 200
+/// ticks on both sides:
+///
+///     util::StreamingConvolver conv(fft, fftSize, shaper.DeconvKernel(), 200, 200);
+///     std::vector<float> output;
+///     for (auto const& fragment: fragments)
+///       conv.Feed(fragment.data(), fragment.size(), output);
+///     conv.Finish(output);
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef STREAMINGCONVOLVER_H
+#define STREAMINGCONVOLVER_H
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include "TComplex.h"
+
+#include "lardata/Utilities/LArFFTW.h"
+
+namespace util {
+
+class StreamingConvolver {
+public:
+
+    enum Method { kOverlapSave, kOverlapAdd };
+
+    /// Uses fft (which must stay valid) with the specified kernel.
+    StreamingConvolver(LArFFTW& fft, int fftSize,
+                       LArFFTW::ComplexVector const& kernel,
+                       int pre, int post, Method method = kOverlapSave);
+
+    /// Same, with a kernel from SignalShaping (ConvKernel(), DeconvKernel()).
+    StreamingConvolver(LArFFTW& fft, int fftSize,
+                       std::vector<TComplex> const& kernel,
+                       int pre, int post, Method method = kOverlapSave);
+
+    int FFTSize() const { return fSize; }
+
+    /// Output ticks produced by each block.
+    int BlockStep() const { return fStep; }
+
+    /// Number of input ticks fed since the start of the stream.
+    std::size_t NInput() const { return fNInput; }
+
+    /// Number of output ticks produced since the start of the stream.
+    std::size_t NOutput() const { return fNOutput; }
+
+    /// Adds n samples to the stream, appending final output to output.
+    template <class In, class Out>
+    void Feed(In const* data, std::size_t n, std::vector<Out>& output);
+
+    /// Flushes all the pending output and starts a new stream.
+    template <class Out>
+    void Finish(std::vector<Out>& output);
+
+    /// Discards pending data and starts a new stream.
+    void Reset();
+
+private:
+
+    LArFFTW* fFFT;
+    int fSize;    ///< FFT (block) size
+    int fPre;     ///< non-causal extent of the kernel response
+    int fPost;    ///< causal extent of the kernel response
+    int fStep;    ///< output ticks per block
+    Method fMethod;
+    LArFFTW::ComplexVector fKernel;
+
+    LArFFTW::AlignedVector<double> fBlock; ///< FFT block
+    std::vector<double> fInput;   ///< pending input samples
+    std::vector<double> fAccum;   ///< overlap-add accumulator
+    std::vector<double> fReady;   ///< final output not yet handed out
+    std::size_t fNInput;
+    std::size_t fNOutput;
+    std::size_t fNProcessed;      ///< overlap-add: input ticks (and padding) transformed
+
+    void Process(bool flush);
+    void ProcessOverlapSave(bool flush);
+    void ProcessOverlapAdd(bool flush);
+
+    template <class Out> void HandOut(std::vector<Out>& output);
+};
+
+}
+
+//----------------------------------------------------------------------
+template <class In, class Out>
+inline void util::StreamingConvolver::Feed(In const* data, std::size_t n,
+                                           std::vector<Out>& output)
+{
+  fInput.insert(fInput.end(), data, data + n);
+  fNInput += n;
+  Process(false);
+  HandOut(output);
+}
+
+//----------------------------------------------------------------------
+template <class Out>
+inline void util::StreamingConvolver::Finish(std::vector<Out>& output)
+{
+  Process(true);
+  HandOut(output);
+  Reset();
+}
+
+//----------------------------------------------------------------------
+template <class Out>
+inline void util::StreamingConvolver::HandOut(std::vector<Out>& output)
+{
+  output.insert(output.end(), fReady.begin(), fReady.end());
+  fNOutput += fReady.size();
+  fReady.clear();
+}
+
+#endif
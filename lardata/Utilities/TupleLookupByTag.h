@@ -42,6 +42,7 @@
 
 // C/C++ standard libraries
 #include <tuple>
+#include <utility> // std::index_sequence<>, std::make_index_sequence()
 #include <type_traits>
 #include <cstddef> // std::size_t
 
@@ -962,20 +963,19 @@ namespace util {
     //--------------------------------------------------------------------------
     //--- General utilities
     //--------------------------------------------------------------------------
+    //
+    // The lookups are implemented with pack expansions and constexpr tables
+    // rather than with recursive templates: the number of template
+    // instantiations grows linearly with the number of elements, and so does
+    // not blow up the compilation of proxies with many auxiliary data.
+    // Type lookups in a tuple compare constexpr addresses in a table of type
+    // identities (`type_id_table`), which is instantiated once per tuple and
+    // shared by the lookups of all the types.
+    //
     template <typename Target, typename... T>
-    struct count_type_in_list_impl: public std::integral_constant<unsigned int, 0U>
-    {};
-
-    template <typename Target, typename First, typename... Others>
-    struct count_type_in_list_impl<Target, First, Others...>
+    struct count_type_in_list_impl
       : public std::integral_constant
-          <unsigned int, count_type_in_list_impl<Target, Others...>::value>
-    {};
-
-    template <typename Target, typename... Others>
-    struct count_type_in_list_impl<Target, Target, Others...>
-      : public std::integral_constant
-          <unsigned int, count_type_in_list_impl<Target, Others...>::value + 1>
+          <unsigned int, (0U + ... + (std::is_same_v<Target, T>? 1U: 0U))>
     {};
 
 
@@ -993,124 +993,193 @@ namespace util {
 
     //--------------------------------------------------------------------------
     template <typename Target, typename... T>
-    struct type_is_in_impl: public std::false_type {};
-
-    template <typename Target, typename First, typename... Others>
-    struct type_is_in_impl<Target, First, Others...>
-      : public std::integral_constant<bool, type_is_in_impl<Target, Others...>::value>
+    struct type_is_in_impl
+      : public std::integral_constant
+          <bool, (false || ... || std::is_same_v<Target, T>)>
     {};
 
-    template <typename Target, typename... Others>
-    struct type_is_in_impl<Target, Target, Others...>: public std::true_type {};
+
+    //--------------------------------------------------------------------------
+    // Part of implementation of `extract_to_tuple_type`.
+    template <
+      typename SrcTuple,
+      template <typename T, typename...> class Extractor,
+      template <typename...> class TargetClass,
+      typename Indices
+        = std::make_index_sequence<std::tuple_size<SrcTuple>::value>
+      >
+    struct extract_to_tuple_type_impl;
+
+    template <
+      typename SrcTuple,
+      template <typename T, typename...> class Extractor,
+      template <typename...> class TargetClass,
+      std::size_t... I
+      >
+    struct extract_to_tuple_type_impl
+      <SrcTuple, Extractor, TargetClass, std::index_sequence<I...>>
+    {
+      using type = TargetClass<
+        typename Extractor<std::tuple_element_t<I, SrcTuple>>::type...
+        >;
+    }; // extract_to_tuple_type_impl
+
+    // `std::tuple` elements are expanded directly, since `std::tuple_element`
+    // may cost an instantiation per preceding element
+    template <
+      typename... T,
+      template <typename, typename...> class Extractor,
+      template <typename...> class TargetClass,
+      std::size_t... I
+      >
+    struct extract_to_tuple_type_impl
+      <std::tuple<T...>, Extractor, TargetClass, std::index_sequence<I...>>
+    {
+      using type = TargetClass<typename Extractor<T>::type...>;
+    }; // extract_to_tuple_type_impl<std::tuple>
 
 
     //--------------------------------------------------------------------------
+    /// A distinct address for each type `T` (compared as type identity).
+    template <typename T>
+    constexpr char type_marker = 0;
+
     /**
-     * @brief Implementation for `extract_to_tuple_type`.
-     * @tparam TargetClass as in `extract_to_tuple_type`
-     * @tparam Extractor as in `extract_to_tuple_type`
-     * @tparam Tuple as in `extract_to_tuple_type`
-     * @tparam I index of the type being extracted at this iteration
-     * @tparam N total number of types to be extracted
-     * @tparam T types already extracted
+     * @brief Table of the identities of the types in a `std::tuple`.
+     * @tparam Types `std::tuple` of the types
      *
-     * The recursive implementation adds the type extracted from the `I`-th
-     * `Tuple` element to the list of T.
-     *
-     * The total number of iterations needs to be passed as argument since the
-     * end-of-iteration specialization needs to define `I` as
-     * `std::tuple_size_v<Tuple>`, but C++ (at least up to C++14) does not allow
-     * for a typed template argument to be so complicate ().
-     * This may change in the future,
+     * The table is an array of addresses of `type_marker<T>`, one per type:
+     * two types are the same if their addresses are the same. The table is
+     * instantiated once per set of types, and the lookups of any type in it
+     * are evaluated by constexpr functions, without further template
+     * instantiations.
      */
-    template <template <typename...> class TargetClass, template <typename T, typename...> class Extractor, typename Tuple, std::size_t I, std::size_t N, typename... T>
-    struct extract_to_tuple_type_impl {
-      using type = typename extract_to_tuple_type_impl<TargetClass, Extractor, Tuple, (I + 1), N, T..., typename Extractor<std::tuple_element_t<I, Tuple>>::type>::type;
-    }; // extract_to_tuple_type_impl
+    template <typename Types>
+    struct type_id_table;
 
-    /// End-of-recursion specialization: packs all types already extracted into the target type.
-    template <template <typename...> class TargetClass, template <typename T, typename...> class Extractor, typename Tuple, std::size_t N, typename... T>
-    struct extract_to_tuple_type_impl<TargetClass, Extractor, Tuple, N, N, T...> {
-      using type = TargetClass<T...>;
-    }; // extract_to_tuple_type_impl<N>
+    template <typename... T>
+    struct type_id_table<std::tuple<T...>> {
 
+      /// Number of types in the table.
+      static constexpr std::size_t N = sizeof...(T);
 
-    //--------------------------------------------------------------------------
+      /// The identity of each of the types (one extra `nullptr` entry).
+      static constexpr char const* ids[N + 1] = { &type_marker<T>..., nullptr };
 
-    // TODO try alternative simple implementation:
-    template <typename SrcTuple, template <typename T, typename...> class Extractor, template <typename...> class TargetClass, std::size_t... I>
-    struct extract_to_tuple_type_impl_simple {
-      using type = TargetClass<
-        typename Extractor<std::tuple_element_t<I, SrcTuple>>::type...
-        >;
-    }; // extract_to_tuple_type_impl<N>
+      /// Returns the index of the first `id` at or after `from` (`N` if none).
+      static constexpr std::size_t find(char const* id, std::size_t from = 0U)
+        {
+          for (std::size_t i = from; i < N; ++i) if (ids[i] == id) return i;
+          return N;
+        }
+
+      /// Returns how many times `id` is in the table.
+      static constexpr unsigned int count(char const* id)
+        {
+          unsigned int n = 0U;
+          for (std::size_t i = 0; i < N; ++i) if (ids[i] == id) ++n;
+          return n;
+        }
+
+      /// Returns whether any of the types is present more than once.
+      static constexpr bool hasDuplicates()
+        {
+          for (std::size_t i = 1; i < N; ++i)
+            if (find(ids[i]) < i) return true;
+          return false;
+        }
+
+    }; // struct type_id_table<>
 
 
     //--------------------------------------------------------------------------
+    /**
+     * @brief Table of which elements of `Tuple` contain the type `Target`.
+     * @tparam Extractor trait exposing the target type in an element
+     * @tparam Target the type to be matched
+     * @tparam Tuple tuple-like type with the elements
+     *
+     * The lookups needed by the exposed traits are offered as constexpr
+     * functions, on the `type_id_table` of the types extracted from `Tuple`,
+     * which is shared by the lookups of all the target types.
+     */
+    template <
+      template <typename T, typename...> class Extractor,
+      typename Target,
+      typename Tuple
+      >
+    struct extracted_type_table {
 
-    // Part of implementation for `index_of_extracted_type`.
-    template <template <typename T, typename...> class Extractor, typename Target, std::size_t I, typename Elem, typename Tuple>
-    struct index_of_extracted_type_impl;
+      /// Table of the identities of the extracted types.
+      using ids_t = type_id_table
+        <typename extract_to_tuple_type_impl<Tuple, Extractor, std::tuple>::type>;
 
-    // Part of implementation for `index_of_extracted_type`.
+      /// Number of elements in the tuple.
+      static constexpr std::size_t N = ids_t::N;
+
+      /// Returns the index of the first match at or after `from` (`N` if none).
+      static constexpr std::size_t find(std::size_t from = 0U)
+        { return ids_t::find(&type_marker<Target>, from); }
+
+      /// Returns the number of matches.
+      static constexpr unsigned int count()
+        { return ids_t::count(&type_marker<Target>); }
+
+    }; // struct extracted_type_table<>
+
+
+    //--------------------------------------------------------------------------
+    // Part of implementation for `index_of_extracted_type`:
+    // index of the first element from `I` on matching `Target` (`N` if none).
     template <template <typename T, typename...> class Extractor, typename Target, std::size_t N, std::size_t I, typename Tuple>
     struct index_of_extracted_type_checked
-      : public index_of_extracted_type_impl<Extractor, Target, I, typename Extractor<std::tuple_element_t<I, Tuple>>::type, Tuple>
+      : public std::integral_constant<
+          std::size_t,
+          extracted_type_table<Extractor, Target, Tuple>::find(I)
+          >
     {};
 
-    // Part of implementation for `index_of_extracted_type`.
-    template<template <typename T, typename...> class Extractor, typename Target, std::size_t N, typename Tuple>
-    struct index_of_extracted_type_checked<Extractor, Target, N, N, Tuple>
-      : public std::integral_constant<std::size_t, N>
-    {};
+    // Part of implementation for `index_of_extracted_type`:
+    // `I` if the `I`-th element `Elem` matches, or the index of the next match.
     template <template <typename T, typename...> class Extractor, typename Target, std::size_t I, typename Elem, typename Tuple>
     struct index_of_extracted_type_impl
-      : public index_of_extracted_type_checked
-        <Extractor, Target, std::tuple_size<Tuple>::value, (I + 1), Tuple>
-      {};
-
-    // Part of implementation for `index_of_extracted_type`.
-    template <template <typename T, typename...> class Extractor, typename Target, std::size_t I, typename Tuple>
-    struct index_of_extracted_type_impl<Extractor, Target, I, Target, Tuple>
-      : public std::integral_constant<std::size_t, I>
-    {
-      static constexpr std::size_t N = std::tuple_size<Tuple>();
-      static_assert(I < N, "Internal logic error.");
-    };
+      : public std::integral_constant<
+          std::size_t,
+          std::is_same_v<Elem, Target>
+            ? I: extracted_type_table<Extractor, Target, Tuple>::find(I + 1)
+          >
+    {};
 
-    // Part of implementation for `index_of_extracted_type`.
+    // Part of implementation for `index_of_extracted_type`:
+    // index of the first element after `After` matching `Target`.
     template <template <typename T, typename...> class Extractor, typename Target, std::size_t N, std::size_t After, typename Tuple>
     struct index_of_extracted_type_checked_after
-      : public index_of_extracted_type_checked<Extractor, Target, N, (After + 1), Tuple>
-    {};
-
-    // Part of implementation for `index_of_extracted_type`.
-    template <template <typename T, typename...> class Extractor, typename Target, std::size_t N, typename Tuple>
-    struct index_of_extracted_type_checked_after<Extractor, Target, N, N, Tuple>
-      : public std::integral_constant<std::size_t, N>
+      : public std::integral_constant<
+          std::size_t,
+          (After >= N)
+            ? N: extracted_type_table<Extractor, Target, Tuple>::find(After + 1)
+          >
     {};
 
-
     // Part of implementation for `index_of_extracted_type`.
-    // This implementation relies on std::tuple_size and std::tuple_element;
-    // an implementation assuming Tuple to be std::tuple would be more efficient...
     template <template <typename T, typename...> class Extractor, typename Target, typename Tuple>
     struct index_of_type_base
       : public std::integral_constant<
           std::size_t,
-          index_of_extracted_type_checked<Extractor, Target, std::tuple_size<Tuple>::value, 0U, Tuple>::value
+          extracted_type_table<Extractor, Target, Tuple>::find()
           >
     {};
 
     // Part of implementation for `index_of_extracted_type`.
     template <template <typename T, typename...> class Extractor, typename Target, typename Tuple>
     struct index_of_type_helper {
-      static constexpr std::size_t N = std::tuple_size<Tuple>::value;
-      static constexpr std::size_t value = index_of_type_base<Extractor, Target, Tuple>();
+      using table_t = extracted_type_table<Extractor, Target, Tuple>;
+      static constexpr std::size_t N = table_t::N;
+      static constexpr std::size_t value = table_t::find();
 
       static_assert(value < N,
         "The specified tuple does not have the sought type.");
-      static_assert(index_of_extracted_type_checked_after<Extractor, Target, N, value, Tuple>() >= N,
+      static_assert(table_t::find(value + 1) >= N,
         "The specified tuple has more than one element with the sought type.");
     }; // struct index_of_type_helper
 
@@ -1118,13 +1187,9 @@ namespace util {
     //--------------------------------------------------------------------------
     // Part of implementation of `has_duplicate_types`.
     template <typename Tuple, typename... T>
-    struct has_duplicate_types_impl: public std::false_type {};
-
-    template <typename Tuple, typename First, typename... Others>
-    struct has_duplicate_types_impl<Tuple, First, Others...>
+    struct has_duplicate_types_impl
       : public std::integral_constant<bool,
-          (count_type_in_tuple<First, Tuple>::value > 1U)
-          || has_duplicate_types_impl<Tuple, Others...>::value
+          (false || ... || (count_type_in_tuple<T, Tuple>::value > 1U))
           >
     {};
 
@@ -1132,7 +1197,8 @@ namespace util {
     // Part of implementation of `has_duplicate_types`.
     template <typename... T>
     struct has_duplicate_types_unwrapper<std::tuple<T...>>
-      : public has_duplicate_types_impl<std::tuple<T...>, T...>
+      : public std::integral_constant
+          <bool, type_id_table<std::tuple<T...>>::hasDuplicates()>
       {};
 
 
@@ -1204,11 +1270,8 @@ namespace util {
     template <typename...> class TargetClass /* = std::tuple */
     >
   struct extract_to_tuple_type {
-      private:
-    static constexpr std::size_t N = std::tuple_size<SrcTuple>();
-      public:
     using type = typename details::extract_to_tuple_type_impl
-      <TargetClass, Extractor, SrcTuple, 0U, N>::type;
+      <SrcTuple, Extractor, TargetClass>::type;
   }; // extract_to_tuple_type
 
 
@@ -1247,8 +1310,10 @@ namespace util {
     typename Tuple
     >
   struct count_extracted_types
-    : public count_type_in_tuple
-        <Target, extract_to_tuple_type_t<Tuple, Extractor>>
+    : public std::integral_constant<
+        unsigned int,
+        details::extracted_type_table<Extractor, Target, Tuple>::count()
+        >
   {};
 
 
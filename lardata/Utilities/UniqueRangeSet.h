@@ -30,7 +30,10 @@ namespace util {
      One important function worth noting is util::UniqueRangeSet::Exclusive which takes two   \n
      input arguments, "start" and "end", and returns util::UniqueRangeSet of all exclusive    \n
      regions between "start" and "end". By definition, merging this return with the original  \n
-     instance will result in 1 huge util::Range.
+     instance will result in 1 huge util::Range.                                              \n
+
+     util::UniqueRangeVector offers the same interface on a sorted vector, with batch         \n
+     insertion; it is faster when many ranges are added at once.
   */
   template <class T>
   class UniqueRangeSet : public std::set<util::Range<T> > {
@@ -67,8 +70,9 @@ namespace util {
     {
       UniqueRangeSet<T> res;
 
-      auto start_iter = std::lower_bound(this->begin(),this->end(),start);
-      auto end_iter   = std::lower_bound(this->begin(),this->end(),end);
+      // set lookups (std::lower_bound would walk the set linearly)
+      auto start_iter = this->lower_bound(Range<T>(start,start));
+      auto end_iter   = this->lower_bound(Range<T>(end,end));
 
       // Anything to add to the head?
       if(start < (*start_iter)._window.first) res.emplace(start,(*start_iter)._window.first);
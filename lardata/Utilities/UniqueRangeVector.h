@@ -0,0 +1,187 @@
+/**
+ * \file UniqueRangeVector.h
+ *
+ * \ingroup RangeTool
+ *
+ * \brief Class def header for a class UniqueRangeVector
+ *
+ * @date October 14, 2026
+ */
+
+/** \addtogroup RangeTool
+    @{*/
+
+#ifndef UNIQUERANGEVECTOR_H
+#define UNIQUERANGEVECTOR_H
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Range.h"
+
+namespace util {
+
+  /**
+     \class UniqueRangeVector
+     @brief Sorted vector of util::Range, which does not allow any overlap in contained element.
+     This has the interface of util::UniqueRangeSet, with the ranges stored contiguously in a  \n
+     vector sorted by start. Lookups are binary searches; a single emplace moves the ranges   \n
+     after the insertion point, so many ranges should rather be added together with           \n
+     util::UniqueRangeVector::Insert(begin, end), which sorts them and merges them with the   \n
+     existing ones in a single sweep.                                                         \n
+
+     As in util::UniqueRangeSet, ranges which overlap or touch are merged into one.          \n
+     util::UniqueRangeVector::Overlapping returns the contained ranges overlapping a given    \n
+     interval in O(log n) plus their number.
+  */
+  template <class T>
+  class UniqueRangeVector {
+
+    using Ranges_t = std::vector<util::Range<T> >;
+
+  public:
+    using value_type = util::Range<T>;
+    using size_type = typename Ranges_t::size_type;
+    using const_iterator = typename Ranges_t::const_iterator;
+    using iterator = const_iterator; ///< ranges can't be modified in place
+    using const_reverse_iterator = typename Ranges_t::const_reverse_iterator;
+
+    /// default ctor
+    UniqueRangeVector(){}
+
+    /// Merge two UniqueRangeVector<T>
+    void Merge(const UniqueRangeVector<T>& in)
+    { Insert(in.begin(),in.end()); }
+
+    /// Very first "start" of all contained range
+    const T& Start() const
+    {
+      if(empty()) throw std::runtime_error("Nothing in the set!");
+      return _ranges.front().Start();
+    }
+
+    /// Very last "end" of all contained range
+    const T& End() const
+    {
+      if(empty()) throw std::runtime_error("Nothing in the set!");
+      return _ranges.back().End();
+    }
+
+    /**
+       It takes two input arguments, "start" and "end", and returns util::UniqueRangeVector \n
+       of all exclusive regions between "start" and "end", that is the gaps between the     \n
+       contained ranges clipped to [start, end]. Merging this return with the original      \n
+       instance results in 1 range covering at least [start, end].
+    */
+    UniqueRangeVector<T> Exclusive(const T start, const T end) const
+    {
+      UniqueRangeVector<T> res;
+      auto const overlap = Overlapping(start,end);
+      T tmp_start = start;
+      for(auto iter = overlap.first; iter != overlap.second; ++iter) {
+        if(tmp_start < iter->Start())
+          res._ranges.emplace_back(tmp_start,iter->Start());
+        tmp_start = iter->End();
+      }
+      if(tmp_start < end) res._ranges.emplace_back(tmp_start,end);
+      return res;
+    }
+
+    /**
+       Returns the range of contained ranges overlapping (or touching) [start, end], \n
+       as a pair of iterators (begin and end of the sequence).                       \n
+       The complexity is logarithmic in the number of contained ranges.
+    */
+    std::pair<const_iterator,const_iterator> Overlapping(const T& start,const T& end) const
+    {
+      // first range not ending before start
+      auto first = std::lower_bound(_ranges.begin(),_ranges.end(),start,
+        [](const Range<T>& r,const T& value){ return r.End() < value; });
+      // first range starting after end
+      auto last = std::upper_bound(first,_ranges.end(),end,
+        [](const T& value,const Range<T>& r){ return value < r.Start(); });
+      return { first, last };
+    }
+
+    /// Modified emplace that merges overlapping range. Return = # merged range.
+    size_t emplace(const T& start,const T& end) {
+
+      Range<T> tmp_a(start,end); // checks the validity
+      auto overlap = Overlapping(start,end);
+      size_t const ctr = std::distance(overlap.first,overlap.second);
+      if(ctr == 0) {
+        _ranges.insert(overlap.first,tmp_a);
+        return 0;
+      }
+      tmp_a.Merge(*overlap.first);
+      tmp_a.Merge(*std::prev(overlap.second));
+      auto const iter = _ranges.begin() + (overlap.first - _ranges.cbegin());
+      *iter = tmp_a;
+      _ranges.erase(std::next(iter),_ranges.begin() + (overlap.second - _ranges.cbegin()));
+      return ctr;
+    }
+
+    /// Modified insert that merges overlapping range. Return = # merged range.
+    size_t insert(const Range<T>& a)
+    {return emplace(a.Start(),a.End());}
+
+    /**
+       Inserts all the ranges in [first, last), merging the ones overlapping.    \n
+       The new ranges are sorted and then merged with the contained ones in one  \n
+       linear sweep. Return = # ranges which disappeared in merges.
+    */
+    template <typename Iter>
+    size_t Insert(Iter first, Iter last)
+    {
+      std::vector<Range<T> > added(first,last);
+      if(added.empty()) return 0;
+      std::sort(added.begin(),added.end(),
+        [](const Range<T>& a,const Range<T>& b){ return a.Start() < b.Start(); });
+
+      size_t const n_before = _ranges.size() + added.size();
+      Ranges_t merged;
+      merged.reserve(n_before);
+      auto iOld = _ranges.cbegin(), iNew = added.cbegin();
+      while((iOld != _ranges.cend()) || (iNew != added.cend())) {
+        // pick the next range by start
+        Range<T> const& next
+          = ((iNew == added.cend())
+             || ((iOld != _ranges.cend()) && (iOld->Start() < iNew->Start())))
+          ? *(iOld++): *(iNew++);
+        if(merged.empty() || (merged.back().End() < next.Start()))
+          merged.push_back(next);
+        else
+          merged.back().Merge(next);
+      }
+      _ranges.swap(merged);
+      return n_before - _ranges.size();
+    }
+
+    //
+    // container interface
+    //
+    const_iterator begin() const { return _ranges.begin(); }
+    const_iterator end() const { return _ranges.end(); }
+    const_iterator cbegin() const { return _ranges.cbegin(); }
+    const_iterator cend() const { return _ranges.cend(); }
+    const_reverse_iterator rbegin() const { return _ranges.rbegin(); }
+    const_reverse_iterator rend() const { return _ranges.rend(); }
+
+    size_type size() const { return _ranges.size(); }
+    bool empty() const { return _ranges.empty(); }
+    void clear() { _ranges.clear(); }
+    void reserve(size_type n) { _ranges.reserve(n); }
+
+    /// Removes the specified range
+    const_iterator erase(const_iterator iter) { return _ranges.erase(iter); }
+
+  private:
+    Ranges_t _ranges; ///< the ranges, disjoint and sorted
+
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
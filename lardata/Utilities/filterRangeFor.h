@@ -11,6 +11,9 @@
 #define LARDATA_UTILITIES_FILTERRANGEFOR_H
 
 
+// LArSoft libraries
+#include "lardata/Utilities/RangeForWrapper.h"
+
 // Boost libraries
 #include <boost/iterator/filter_iterator.hpp>
 
@@ -50,7 +53,8 @@ namespace util {
    *
    *     for (auto&& v: range);
    *
-   *   is valid
+   *   is valid; if its begin and end iterators have different types, it is
+   *   wrapped by `util::wrapRangeFor()`
    * * `Pred` is a copiable unary function type, whose single argument can be
    *     converted from the value type of `Range`, and whose return value can be
    *     converted into a `bool` vaule
@@ -73,13 +77,16 @@ namespace util {
     template <typename Range, typename Pred>
     class FilterRangeForStruct {
 
+      // Boost filter iterator requires begin and end iterators of the same
+      // type: ranges with a different end type are wrapped (if needed at all)
+
       /// Extract the begin iterator from a range.
       static auto getBegin(Range&& range) -> decltype(auto)
-        { using std::begin; return begin(range); }
+        { using std::begin; return begin(util::wrapRangeFor(range)); }
 
       /// Extract the end iterator from a range.
       static auto getEnd(Range&& range) -> decltype(auto)
-        { using std::end; return end(range); }
+        { using std::end; return end(util::wrapRangeFor(range)); }
 
       /// Create a Boost filter iterator pointing to the beginning of data.
       static auto makeBeginIterator(Range&& range, Pred&& pred)
@@ -0,0 +1,104 @@
+/**
+ * @file    BenchmarkSummary_test.cc
+ * @brief   Tests the summary of the benchmark modules
+ * @date    October 14, 2026
+ * @see     `lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h`
+ *
+ * This test is linked with the allocation hook library, so that the
+ * allocations are counted.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard libraries
+#include <memory> // std::make_unique()
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( BenchmarkSummary_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+
+
+//------------------------------------------------------------------------------
+void RunAllocationCountTest() {
+
+  BOOST_CHECK(lar::bench::allocationCountsAvailable());
+
+  lar::bench::AllocationCounts const before
+    = lar::bench::currentAllocationCounts();
+  auto data = std::make_unique<std::vector<double>>(1000U);
+  lar::bench::AllocationCounts const after
+    = lar::bench::currentAllocationCounts();
+
+  BOOST_CHECK_EQUAL(data->size(), 1000U);
+  BOOST_CHECK_GE(after.count - before.count, 2U);
+  BOOST_CHECK_GE(after.bytes - before.bytes, 1000U * sizeof(double));
+
+} // RunAllocationCountTest()
+
+
+//------------------------------------------------------------------------------
+void RunSummaryTest() {
+
+  lar::bench::BenchmarkSummary summary("test", "elements");
+  BOOST_CHECK_EQUAL(summary.name(), "test");
+  BOOST_CHECK_EQUAL(summary.nSections(), 0U);
+  BOOST_CHECK(!summary.section("fill"));
+
+  for (unsigned int iEvent = 1; iEvent <= 3; ++iEvent) {
+    lar::bench::Measurement const& fill = summary.measure("fill", [iEvent](){
+      std::vector<int> v;
+      for (unsigned int i = 0; i < 100 * iEvent; ++i) v.push_back(i);
+      return v.size();
+    });
+    BOOST_CHECK_EQUAL(fill.items, 100U * iEvent);
+    BOOST_CHECK_GE(fill.seconds, 0.);
+    BOOST_CHECK_GE(fill.allocations.count, 1U);
+
+    lar::bench::Measurement const& none
+      = summary.measure("nothing", [](){ return 0U; });
+    BOOST_CHECK_EQUAL(none.items, 0U);
+    BOOST_CHECK_EQUAL(none.allocations.count, 0U);
+  } // for events
+
+  BOOST_CHECK_EQUAL(summary.nSections(), 2U);
+
+  auto const* fillStats = summary.section("fill");
+  BOOST_REQUIRE(fillStats);
+  BOOST_CHECK_EQUAL(fillStats->name, "fill");
+  BOOST_CHECK_EQUAL(fillStats->seconds.N(), 3);
+  BOOST_CHECK_EQUAL(fillStats->items, 600U);
+  BOOST_CHECK_GE(fillStats->allocations.Average(), 1.);
+
+  lar::bench::Measurement extra;
+  extra.seconds = 1.0;
+  extra.items = 50U;
+  summary.record("external", extra);
+  BOOST_CHECK_EQUAL(summary.nSections(), 3U);
+  BOOST_REQUIRE(summary.section("external"));
+  BOOST_CHECK_EQUAL(summary.section("external")->items, 50U);
+
+  std::ostringstream out;
+  out << summary;
+  std::string const text = out.str();
+  BOOST_CHECK_NE(text.find("'fill' on 3 events"), std::string::npos);
+  BOOST_CHECK_NE(text.find("elements/s"), std::string::npos);
+  BOOST_CHECK_NE(text.find("allocations/event"), std::string::npos);
+
+} // RunSummaryTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(AllocationCountTestCase) {
+  RunAllocationCountTest();
+} // AllocationCountTestCase
+
+BOOST_AUTO_TEST_CASE(SummaryTestCase) {
+  RunSummaryTest();
+} // SummaryTestCase
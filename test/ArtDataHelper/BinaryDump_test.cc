@@ -0,0 +1,202 @@
+/**
+ * @file   BinaryDump_test.cc
+ * @brief  Unit test for the binary dump files of the dumper modules
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/Dumpers/BinaryDump.h
+ *
+ * Records are written and read back, and truncated files and records
+ * declaring more data than they have are refused before any allocation.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( BinaryDump_test )
+#include "cetlib/quiet_unit_test.hpp" // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Dumpers/BinaryDump.h"
+#include "lardataobj/RawData/RawDigit.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator<>
+#include <sstream>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstdio> // std::remove()
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+
+namespace {
+
+  using recob::dumper::BinaryRecord;
+
+  /// Name of the scratch file of the test
+  std::string const DumpFile = "BinaryDump_test.bin";
+
+  /// ADC counts of the test raw digit
+  raw::RawDigit::ADCvector_t const ADCs = { 400, 401, 420, 480, 430, 405 };
+
+  /// Writes an event with a raw digit and an association
+  void writeTestDump(std::string const& fileName) {
+    recob::dumper::BinaryDumpWriter out(fileName);
+    out.writeEvent(1U, 2U, 3U, "daq", 1U);
+    recob::dumper::writeRawDigit(out, raw::RawDigit(12U, ADCs.size(), ADCs));
+    recob::dumper::writeAssociation(out, 0U, { { 4U, 6U }, { 9U, 9U } });
+  } // writeTestDump()
+
+  /// Returns the content of the file
+  std::string readFile(std::string const& fileName) {
+    std::ifstream in(fileName, std::ios::binary);
+    return
+      { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+  }
+
+  /// Writes `content` as the whole file
+  void writeFile(std::string const& fileName, std::string const& content) {
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size());
+  }
+
+  /// Returns the text of a record
+  std::string recordText(recob::dumper::BinaryDumpReader const& dump) {
+    std::ostringstream sstr;
+    recob::dumper::printRecordAsText(sstr, dump.type(), dump.payload());
+    return sstr.str();
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void RoundTripTest() {
+
+  writeTestDump(DumpFile);
+
+  recob::dumper::BinaryDumpReader dump(DumpFile);
+
+  BOOST_CHECK(dump.next());
+  BOOST_CHECK(dump.type() == BinaryRecord::Event);
+  auto event = dump.payload();
+  BOOST_CHECK_EQUAL(event.get<std::uint32_t>(), 1U);
+  BOOST_CHECK_EQUAL(event.get<std::uint32_t>(), 2U);
+  BOOST_CHECK_EQUAL(event.get<std::uint32_t>(), 3U);
+  BOOST_CHECK_EQUAL(event.getString(), "daq");
+  BOOST_CHECK_EQUAL(event.get<std::uint64_t>(), 1U);
+  BOOST_CHECK_EQUAL(event.remaining(), 0U);
+
+  BOOST_CHECK(dump.next());
+  BOOST_CHECK(dump.type() == BinaryRecord::RawDigit);
+  auto digit = dump.payload();
+  BOOST_CHECK_EQUAL(digit.get<std::uint32_t>(), 12U);
+  BOOST_CHECK_EQUAL(digit.get<std::uint64_t>(), ADCs.size());
+  digit.get<std::int32_t>(); // compression
+  BOOST_CHECK_EQUAL(digit.get<std::uint64_t>(), ADCs.size());
+  std::vector<short> readADCs(digit.getCount<short>());
+  digit.getArray(readADCs.data(), readADCs.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (readADCs.begin(), readADCs.end(), ADCs.begin(), ADCs.end());
+  BOOST_CHECK_EQUAL(digit.remaining(), 0U);
+  BOOST_CHECK(recordText(dump).find(" 480 430") != std::string::npos);
+
+  BOOST_CHECK(dump.next());
+  BOOST_CHECK(dump.type() == BinaryRecord::Association);
+  BOOST_CHECK_EQUAL(recordText(dump), "  #0 associated with: [4-6] 9");
+
+  BOOST_CHECK(!dump.next());
+
+  std::remove(DumpFile.c_str());
+
+} // RoundTripTest()
+
+
+//------------------------------------------------------------------------------
+void TruncatedFileTest() {
+
+  writeTestDump(DumpFile);
+  std::string const content = readFile(DumpFile);
+
+  // the last record misses its last byte
+  writeFile(DumpFile, content.substr(0U, content.size() - 1U));
+  {
+    recob::dumper::BinaryDumpReader dump(DumpFile);
+    BOOST_CHECK(dump.next());
+    BOOST_CHECK(dump.next());
+    BOOST_CHECK_THROW(dump.next(), cet::exception);
+  }
+
+  // the last record misses part of its size
+  std::size_t const assnSize = 8U + 4U * 8U; // left key, ranges and count
+  writeFile(DumpFile, content.substr(0U, content.size() - assnSize - 4U));
+  {
+    recob::dumper::BinaryDumpReader dump(DumpFile);
+    BOOST_CHECK(dump.next());
+    BOOST_CHECK(dump.next());
+    BOOST_CHECK_THROW(dump.next(), cet::exception);
+  }
+
+  // a record declaring a huge size is refused before allocating it
+  std::string header = content.substr(0U, 12U); // signature and marker
+  std::uint32_t const type = static_cast<std::uint32_t>(BinaryRecord::Hit);
+  std::uint64_t const hugeSize = std::uint64_t(1) << 62;
+  header.append(reinterpret_cast<char const*>(&type), sizeof(type));
+  header.append(reinterpret_cast<char const*>(&hugeSize), sizeof(hugeSize));
+  header.append(16U, '\0');
+  writeFile(DumpFile, header);
+  {
+    recob::dumper::BinaryDumpReader dump(DumpFile);
+    BOOST_CHECK_THROW(dump.next(), cet::exception);
+  }
+
+  std::remove(DumpFile.c_str());
+
+} // TruncatedFileTest()
+
+
+//------------------------------------------------------------------------------
+void BadCountTest() {
+
+  // records whose element counts exceed their own size
+  {
+    recob::dumper::BinaryDumpWriter out(DumpFile);
+    out.writeRecord(BinaryRecord::RawDigit, out.buffer()
+      .put<std::uint32_t>(1U).put<std::uint64_t>(4U).put<std::int32_t>(0)
+      .put<std::uint64_t>(4U).put<std::uint64_t>(std::uint64_t(1) << 61)
+      .put<short>(400).put<short>(401)
+      );
+    out.writeRecord(BinaryRecord::Wire, out.buffer()
+      .put<std::uint32_t>(1U).put<std::int32_t>(0).put<std::uint64_t>(10U)
+      .put<std::uint64_t>(1U) // one region of interest...
+      .put<std::uint64_t>(2U).put<std::uint64_t>(3U) // ... with 3 samples
+      .put<float>(1.0f).put<float>(2.0f)
+      );
+  }
+
+  recob::dumper::BinaryDumpReader dump(DumpFile);
+  BOOST_CHECK(dump.next());
+  BOOST_CHECK_THROW(recordText(dump), cet::exception);
+  BOOST_CHECK(dump.next());
+  BOOST_CHECK_THROW(recordText(dump), cet::exception);
+  BOOST_CHECK(!dump.next());
+
+  std::remove(DumpFile.c_str());
+
+} // BadCountTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RoundTripTestCase) {
+  RoundTripTest();
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedFileTestCase) {
+  TruncatedFileTest();
+}
+
+BOOST_AUTO_TEST_CASE(BadCountTestCase) {
+  BadCountTest();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file   CompactWire_test.cc
+ * @brief  Unit test for `recob::CompactWire`
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/CompactWire.h
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( CompactWire_test )
+#include "cetlib/quiet_unit_test.hpp" // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/CompactWire.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cmath> // std::abs(), std::sin()
+#include <limits> // std::numeric_limits<>
+#include <cstddef> // std::size_t
+
+
+namespace {
+
+  /// Returns the largest difference between the samples of two signals
+  float maxDifference(
+    recob::Wire::RegionsOfInterest_t const& a,
+    recob::Wire::RegionsOfInterest_t const& b
+    )
+  {
+    float maxDiff = 0.0f;
+    for (std::size_t i = 0; i < a.size(); ++i)
+      maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]));
+    return maxDiff;
+  } // maxDifference()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(QuantizedSignal_test) {
+
+  constexpr std::size_t NTicks = 1000U;
+  constexpr float Precision = 0.01f;
+
+  // a unipolar and a bipolar pulse, and a flat region
+  recob::Wire::RegionsOfInterest_t signal(NTicks);
+  std::vector<float> pulse(50U), bipolar(80U), flat(10U, 0.0f);
+  for (std::size_t i = 0; i < pulse.size(); ++i)
+    pulse[i] = 120.0f * std::sin(3.1416f * i / pulse.size());
+  for (std::size_t i = 0; i < bipolar.size(); ++i)
+    bipolar[i] = -35.0f * std::sin(6.2832f * i / bipolar.size());
+  signal.add_range(100U, pulse.begin(), pulse.end());
+  signal.add_range(400U, bipolar.begin(), bipolar.end());
+  signal.add_range(900U, flat.begin(), flat.end());
+
+  recob::CompactWireCreator creator(signal, 12U, geo::kU, Precision);
+  recob::CompactWire const wire = creator.move();
+
+  BOOST_CHECK_EQUAL(wire.Channel(), 12U);
+  BOOST_CHECK_EQUAL(wire.View(), geo::kU);
+  BOOST_CHECK_EQUAL(wire.NSignal(), NTicks);
+  BOOST_CHECK_EQUAL(wire.Precision(), Precision);
+  BOOST_CHECK_EQUAL(wire.NROIs(), 3U);
+  BOOST_CHECK_EQUAL(wire.NExactROIs(), 0U);
+
+  // the samples take half of the memory of the floats
+  std::size_t const nSamples = pulse.size() + bipolar.size() + flat.size();
+  BOOST_CHECK_EQUAL(wire.SampleMemory(),
+    nSamples * 2U + 3U * sizeof(recob::CompactWire::ROIInfo_t));
+
+  // decoding view
+  recob::CompactWire::ROIView const roi = wire.ROI(1U);
+  BOOST_CHECK_EQUAL(roi.startTick(), 400U);
+  BOOST_CHECK_EQUAL(roi.size(), bipolar.size());
+  BOOST_CHECK(!roi.isExact());
+  for (std::size_t i = 0; i < bipolar.size(); ++i)
+    BOOST_CHECK_SMALL(roi[i] - bipolar[i], Precision);
+
+  // full decoding
+  recob::Wire const decoded = wire.toWire();
+  BOOST_CHECK_EQUAL(decoded.Channel(), 12U);
+  BOOST_CHECK_EQUAL(decoded.NSignal(), NTicks);
+  BOOST_CHECK_EQUAL(decoded.SignalROI().n_ranges(), 3U);
+  BOOST_CHECK_LE(maxDifference(decoded.SignalROI(), signal), Precision);
+
+} // QuantizedSignal_test
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ExactFallback_test) {
+
+  // with 16 bits, a range of 1000 can't be represented within 0.001:
+  // that region is stored as it is; the same for non-finite samples
+  std::vector<float> const samples
+    { 1000.0f, 0.1234f, -2.0f, 0.5f, 0.25f, std::numeric_limits<float>::infinity() };
+  std::vector<recob::CompactWireCreator::FlatROI_t> const rois {
+    { 10U, 0U, 2U }, // large range
+    { 20U, 2U, 3U }, // small range
+    { 30U, 5U, 1U }, // infinity
+  };
+
+  recob::CompactWireCreator const creator
+    (samples.data(), rois, 50U, 7U, geo::kZ, 0.001f);
+  recob::CompactWire const& wire = creator.copy();
+
+  BOOST_CHECK_EQUAL(wire.NROIs(), 3U);
+  BOOST_CHECK_EQUAL(wire.NExactROIs(), 2U);
+  BOOST_CHECK(wire.ROI(0U).isExact());
+  BOOST_CHECK(!wire.ROI(1U).isExact());
+  BOOST_CHECK(wire.ROI(2U).isExact());
+  BOOST_CHECK_EQUAL(wire.ROI(0U)[1], 0.1234f);
+  BOOST_CHECK_EQUAL(wire.ROI(2U)[0], samples[5]);
+  BOOST_CHECK_SMALL(wire.ROI(1U)[0] - samples[2], 0.001f);
+
+  std::vector<float> decoded(3U);
+  wire.ROI(1U).copyTo(decoded.data());
+  for (std::size_t i = 0; i < decoded.size(); ++i)
+    BOOST_CHECK_SMALL(decoded[i] - samples[2U + i], 0.001f);
+
+  BOOST_CHECK_THROW(
+    recob::CompactWire(samples.data(), rois, 50U, 7U, geo::kZ, 0.0f),
+    cet::exception
+    );
+
+} // ExactFallback_test
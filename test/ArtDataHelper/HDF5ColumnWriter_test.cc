@@ -0,0 +1,155 @@
+/**
+ * @file   HDF5ColumnWriter_test.cc
+ * @brief  Unit test for the HDF5 columnar writer
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/Exporters/HDF5ColumnWriter.h
+ *
+ * The test writes a few events into a HDF5 file, and reads them back with
+ * the HDF5 library.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( HDF5ColumnWriter_test )
+#include "cetlib/quiet_unit_test.hpp" // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Exporters/HDF5ColumnWriter.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// HDF5
+#include "hdf5.h"
+
+// C/C++ standard libraries
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace {
+
+  /// Reads a whole one-dimensional dataset
+  template <typename T>
+  std::vector<T> readDataset(hid_t file, std::string const& path, hid_t type) {
+    hid_t const dataset = H5Dopen2(file, path.c_str(), H5P_DEFAULT);
+    BOOST_TEST_REQUIRE(dataset >= 0, "dataset '" << path << "' not found");
+    hid_t const space = H5Dget_space(dataset);
+    hsize_t size = 0U;
+    H5Sget_simple_extent_dims(space, &size, nullptr);
+    std::vector<T> values(size);
+    if (size > 0U)
+      H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Sclose(space);
+    H5Dclose(dataset);
+    return values;
+  } // readDataset()
+
+  /// Event with `nHits` hits, and `nPoints` points if any
+  recob::exporter::EventColumns makeEvent
+    (std::uint32_t event, unsigned int nHits, unsigned int nPoints)
+  {
+    recob::exporter::EventColumns data(1U, 2U, event);
+    auto& hits = data.table("hits");
+    auto& channel = hits.column<std::uint32_t>("channel");
+    auto& peakTime = hits.column<float>("peak_time");
+    for (unsigned int i = 0; i < nHits; ++i) {
+      channel.push_back(event*100U + i);
+      peakTime.push_back(0.5f*i);
+    }
+    if (nPoints > 0U) {
+      auto& points = data.table("points");
+      auto& x = points.column<double>("x");
+      for (unsigned int i = 0; i < nPoints; ++i) x.push_back(-1.0*i);
+    }
+    return data;
+  } // makeEvent()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WriteAndRead_test) {
+
+  std::string const fileName = "HDF5ColumnWriter_test.h5";
+  {
+    recob::exporter::HDF5ColumnWriter::Options options;
+    options.chunkRows = 4U; // several chunks per dataset
+    options.maxQueuedEvents = 2U;
+    recob::exporter::HDF5ColumnWriter writer(fileName, options);
+    writer.write(makeEvent(1U, 3U, 0U));
+    writer.write(makeEvent(2U, 0U, 5U));
+    writer.write(makeEvent(3U, 7U, 2U));
+    writer.flush();
+    writer.write(makeEvent(4U, 1U, 0U));
+  } // the writer closes the file here
+
+  hid_t const file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  BOOST_TEST_REQUIRE(file >= 0);
+
+  std::vector<std::uint32_t> const expectedEvents { 1U, 2U, 3U, 4U };
+  auto const events = readDataset<std::uint32_t>(file, "/events/event", H5T_NATIVE_UINT32);
+  BOOST_CHECK_EQUAL_COLLECTIONS(events.begin(), events.end(),
+    expectedEvents.begin(), expectedEvents.end());
+  auto const runs = readDataset<std::uint32_t>(file, "/events/run", H5T_NATIVE_UINT32);
+  BOOST_CHECK_EQUAL(runs.size(), 4U);
+  BOOST_CHECK_EQUAL(runs.front(), 1U);
+
+  // hits: 3 + 0 + 7 + 1 rows
+  auto const channels = readDataset<std::uint32_t>(file, "/hits/channel", H5T_NATIVE_UINT32);
+  auto const peakTimes = readDataset<float>(file, "/hits/peak_time", H5T_NATIVE_FLOAT);
+  BOOST_CHECK_EQUAL(channels.size(), 11U);
+  BOOST_CHECK_EQUAL(peakTimes.size(), 11U);
+  BOOST_CHECK_EQUAL(channels[3], 300U);
+  BOOST_CHECK_EQUAL(channels[10], 400U);
+  BOOST_CHECK_EQUAL(peakTimes[9], 3.0f);
+
+  std::vector<std::uint64_t> const expectedHitOffsets { 0U, 3U, 3U, 10U };
+  std::vector<std::uint64_t> const expectedHitCounts { 3U, 0U, 7U, 1U };
+  auto const hitOffsets = readDataset<std::uint64_t>(file, "/hits/event_offset", H5T_NATIVE_UINT64);
+  auto const hitCounts = readDataset<std::uint64_t>(file, "/hits/event_count", H5T_NATIVE_UINT64);
+  BOOST_CHECK_EQUAL_COLLECTIONS(hitOffsets.begin(), hitOffsets.end(),
+    expectedHitOffsets.begin(), expectedHitOffsets.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(hitCounts.begin(), hitCounts.end(),
+    expectedHitCounts.begin(), expectedHitCounts.end());
+
+  // points first appear in the second event
+  std::vector<std::uint64_t> const expectedPointOffsets { 0U, 0U, 5U, 7U };
+  std::vector<std::uint64_t> const expectedPointCounts { 0U, 5U, 2U, 0U };
+  auto const pointOffsets = readDataset<std::uint64_t>(file, "/points/event_offset", H5T_NATIVE_UINT64);
+  auto const pointCounts = readDataset<std::uint64_t>(file, "/points/event_count", H5T_NATIVE_UINT64);
+  BOOST_CHECK_EQUAL_COLLECTIONS(pointOffsets.begin(), pointOffsets.end(),
+    expectedPointOffsets.begin(), expectedPointOffsets.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(pointCounts.begin(), pointCounts.end(),
+    expectedPointCounts.begin(), expectedPointCounts.end());
+  auto const x = readDataset<double>(file, "/points/x", H5T_NATIVE_DOUBLE);
+  BOOST_CHECK_EQUAL(x.size(), 7U);
+  BOOST_CHECK_EQUAL(x[6], -1.0);
+
+  H5Fclose(file);
+
+} // BOOST_AUTO_TEST_CASE(WriteAndRead_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Errors_test) {
+
+  // columns of different type or length
+  recob::exporter::EventColumns data(1U, 1U, 1U);
+  auto& table = data.table("hits");
+  table.column<float>("peak_time").push_back(1.0f);
+  BOOST_CHECK_THROW(table.column<double>("peak_time"), cet::exception);
+  table.column<std::uint32_t>("channel");
+  BOOST_CHECK_THROW(table.nRows(), cet::exception);
+
+  // a table changing its columns is reported by the next call
+  recob::exporter::HDF5ColumnWriter writer("HDF5ColumnWriter_errors_test.h5");
+  writer.write(makeEvent(1U, 2U, 0U));
+  recob::exporter::EventColumns changed(1U, 1U, 2U);
+  changed.table("hits").column<std::uint32_t>("channel").push_back(5U);
+  writer.write(std::move(changed));
+  BOOST_CHECK_THROW(writer.flush(), cet::exception);
+  BOOST_CHECK_THROW(writer.write(makeEvent(3U, 2U, 0U)), cet::exception);
+
+} // BOOST_AUTO_TEST_CASE(Errors_test)
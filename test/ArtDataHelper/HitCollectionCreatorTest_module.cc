@@ -16,6 +16,7 @@
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Core/EDProducer.h"
 #include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/Exception.h"
 
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
@@ -46,6 +47,9 @@ namespace recob {
      *
      * * *instanceName* (string, default: empty): name of the data product
      *     instance to produce
+     * * *nShards* (unsigned integer, default: 0): if not zero, the hits are
+     *     created with a `recob::ShardedHitCollectionCreator` with this number
+     *     of shards, instead of with a `recob::HitCollectionCreator`
      *
      */
     class HitCollectionCreatorTest: public art::EDProducer {
@@ -63,6 +67,12 @@ namespace recob {
           "" /* default: empty */
           };
 
+        fhicl::Atom<unsigned int> nShards {
+          Name("nShards"),
+          Comment("number of shards to fill (0: do not use sharded creator)"),
+          0U
+          };
+
       }; // Config
 
       using Parameters = art::EDProducer::Table<Config>;
@@ -77,13 +87,22 @@ namespace recob {
 
       recob::HitCollectionCreatorManager hitCollManager;
 
+      /// Manager of the sharded hit collection creator.
+      recob::HitAndAssociationsWriterManager
+        <recob::ShardedHitCollectionCreator>
+        shardedHitCollManager;
+
       std::string fInstanceName; ///< Instance name to be used for products.
 
+      unsigned int fNShards; ///< Number of shards (0: no sharded creator).
+
 
 
       /// Produces a collection of hits and stores it into the event.
       void produceHits(art::Event& event, std::string instanceName);
 
+      void produceShardedHits(art::Event& event);
+
     }; // HitCollectionCreatorTest
 
     DEFINE_ART_MODULE(HitCollectionCreatorTest)
@@ -99,16 +118,28 @@ namespace recob {
 recob::test::HitCollectionCreatorTest::HitCollectionCreatorTest
   (Parameters const& config)
   : art::EDProducer(config)
-  , hitCollManager(
+  , fNShards(config().nShards())
+{
+  // produces<>() hit collections
+  if (fNShards > 0U) {
+    shardedHitCollManager.declareProducts(
+      producesCollector(), config().instanceName(),
+      false /* doWireAssns */, false /* doRawDigitAssns */
+      );
+  }
+  else {
+    hitCollManager.declareProducts(
       producesCollector(), config().instanceName(),
       false /* doWireAssns */, false /* doRawDigitAssns */
-    ) // produces<>() hit collections
-  {}
+      );
+  }
+} // HitCollectionCreatorTest::HitCollectionCreatorTest()
 
 
 //----------------------------------------------------------------------------
 void recob::test::HitCollectionCreatorTest::produce(art::Event& event) {
-  produceHits(event, fInstanceName);
+  if (fNShards > 0U) produceShardedHits(event);
+  else               produceHits(event, fInstanceName);
 } // HitCollectionCreatorTest::produce()
 
 
@@ -153,4 +184,50 @@ void recob::test::HitCollectionCreatorTest::produceHits
 } // recob::test::HitCollectionCreatorTest::produceHits()
 
 
+//----------------------------------------------------------------------------
+void recob::test::HitCollectionCreatorTest::produceShardedHits
+  (art::Event& event)
+{
+
+  auto Hits = shardedHitCollManager.collectionWriter(event);
+  Hits.setNShards(fNShards);
+
+  // hits are added in decreasing channel order, spread over all the shards;
+  // the creator is expected to sort them back by channel
+  for (raw::ChannelID_t channel: { 2U, 1U, 0U }) {
+    Hits.shard(channel % fNShards).emplace_back(
+      recob::Hit(
+        channel,                     /* channel */
+        raw::TDCtick_t(1000),        /* start_tick */
+        raw::TDCtick_t(1010),        /* end_tick */
+        0.0,                         /* peak_time */
+        1.0,                         /* sigma_peak_time */
+        5.0,                         /* rms */
+        100.0,                       /* peak_amplitude */
+        1.0,                         /* sigma_peak_amplitude */
+        500.0,                       /* summedADC */
+        500.0,                       /* hit_integral */
+        1.0,                         /* hit_sigma_integral */
+        1,                           /* multiplicity */
+        0,                           /* local_index */
+        1.0,                         /* goodness_of_fit */
+        7,                           /* dof */
+        geo::kUnknown,               /* view */
+        geo::kMysteryType,           /* signal_type */
+        geo::WireID{}                /* wireID */
+        )
+      );
+  } // for hits
+
+  if (Hits.size() != 3U) {
+    throw art::Exception(art::errors::LogicError)
+      << "ShardedHitCollectionCreator has " << Hits.size()
+      << " hits, 3 expected!\n";
+  }
+
+  Hits.put_into();
+
+} // recob::test::HitCollectionCreatorTest::produceShardedHits()
+
+
 //----------------------------------------------------------------------------
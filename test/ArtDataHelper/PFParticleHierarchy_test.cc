@@ -0,0 +1,160 @@
+/**
+ * @file   PFParticleHierarchy_test.cc
+ * @brief  Unit test for `recob::PFParticleHierarchy`
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/PFParticleHierarchy.h
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( PFParticleHierarchy_test )
+#include "cetlib/quiet_unit_test.hpp" // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/PFParticleHierarchy.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace {
+
+  constexpr std::size_t Primary = recob::PFParticle::kPFParticlePrimary;
+  constexpr std::size_t Invalid = recob::PFParticleHierarchy::InvalidIndex;
+
+  template <typename Range>
+  std::vector<std::size_t> toVector(Range const& range)
+    { return { range.begin(), range.end() }; }
+
+  void checkSame
+    (std::vector<std::size_t> const& actual, std::vector<std::size_t> const& expected)
+  {
+    BOOST_CHECK_EQUAL_COLLECTIONS
+      (actual.begin(), actual.end(), expected.begin(), expected.end());
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ConsistentHierarchy_test) {
+
+  // two primaries, in shuffled order and with non-contiguous IDs:
+  //   ID 10 -> { 12, 14 }, 12 -> { 16 }; ID 20 -> { 18 }
+  std::vector<recob::PFParticle> const particles {
+    { 13, 12, 10, { 16 } },
+    { 13, 10, Primary, { 12, 14 } },
+    { 11, 16, 12, {} },
+    { 11, 20, Primary, { 18 } },
+    { 22, 14, 10, {} },
+    { 22, 18, 20, {} },
+  };
+
+  recob::PFParticleHierarchy const hierarchy(particles);
+
+  BOOST_CHECK_EQUAL(hierarchy.size(), particles.size());
+  BOOST_CHECK(hierarchy.isConsistent());
+  BOOST_CHECK_EQUAL(hierarchy.nDisconnected(), 0U);
+  for (std::size_t i = 0; i < particles.size(); ++i)
+    BOOST_CHECK_EQUAL(hierarchy.index(particles[i].Self()), i);
+  BOOST_CHECK_EQUAL(hierarchy.index(11), Invalid);
+  BOOST_CHECK_EQUAL(hierarchy.index(1000), Invalid);
+
+  checkSame(hierarchy.primaries(), { 1U, 3U });
+  BOOST_CHECK_EQUAL(hierarchy.parent(1), Invalid);
+  BOOST_CHECK_EQUAL(hierarchy.parent(0), 1U);
+  BOOST_CHECK_EQUAL(hierarchy.parent(2), 0U);
+  BOOST_CHECK_EQUAL(hierarchy.parent(5), 3U);
+
+  BOOST_CHECK_EQUAL(hierarchy.nDaughters(1), 2U);
+  checkSame(toVector(hierarchy.daughters(1)), { 0U, 4U });
+  checkSame(toVector(hierarchy.daughters(0)), { 2U });
+  BOOST_CHECK_EQUAL(hierarchy.nDaughters(2), 0U);
+  BOOST_CHECK(hierarchy.daughters(2).empty());
+
+  BOOST_CHECK_EQUAL(hierarchy.depth(1), 0U);
+  BOOST_CHECK_EQUAL(hierarchy.depth(0), 1U);
+  BOOST_CHECK_EQUAL(hierarchy.depth(2), 2U);
+  BOOST_CHECK_EQUAL(hierarchy.depth(5), 1U);
+
+  checkSame(toVector(hierarchy.subtree(1)), { 1U, 0U, 2U, 4U });
+  checkSame(toVector(hierarchy.subtree(0)), { 0U, 2U });
+  checkSame(toVector(hierarchy.subtree(3)), { 3U, 5U });
+  checkSame(toVector(hierarchy.subtree(4)), { 4U });
+  BOOST_CHECK_EQUAL(hierarchy.subtreeSize(1), 4U);
+
+} // BOOST_AUTO_TEST_CASE(ConsistentHierarchy_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SparseIDs_test) {
+
+  std::vector<recob::PFParticle> const particles {
+    { 13, 1000000, Primary, { 5 } },
+    { 11, 5, 1000000, {} },
+  };
+
+  recob::PFParticleHierarchy const hierarchy(particles);
+  BOOST_CHECK(hierarchy.isConsistent());
+  BOOST_CHECK_EQUAL(hierarchy.index(1000000), 0U);
+  BOOST_CHECK_EQUAL(hierarchy.index(5), 1U);
+  BOOST_CHECK_EQUAL(hierarchy.index(6), Invalid);
+  checkSame(toVector(hierarchy.subtree(0)), { 0U, 1U });
+
+} // BOOST_AUTO_TEST_CASE(SparseIDs_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BrokenHierarchy_test) {
+
+  std::vector<recob::PFParticle> const particles {
+    { 13, 0, Primary, { 1, 0, 7 } }, // own daughter, ghost daughter 7
+    { 13, 1, 0, { 2 } },
+    { 13, 2, 1, {} },
+    { 13, 3, 0, {} },                // parent does not list it
+    { 13, 4, 5, { 5 } },             // cycle with 5
+    { 13, 5, 4, { 4 } },
+    { 13, 6, 9, {} },                // ghost parent
+    { 13, 8, Primary, { 2 } },       // 2 has two parents
+  };
+
+  recob::PFParticleHierarchy const hierarchy(particles);
+  BOOST_CHECK(!hierarchy.isConsistent());
+
+  checkSame(toVector(hierarchy.daughters(0)), { 1U });
+  BOOST_CHECK_EQUAL(hierarchy.parent(3), 0U);
+  BOOST_CHECK_EQUAL(hierarchy.parent(6), Invalid);
+  checkSame(hierarchy.primaries(), { 0U, 7U });
+
+  // 2 is placed under the first primary reaching it
+  checkSame(toVector(hierarchy.subtree(0)), { 0U, 1U, 2U });
+  checkSame(toVector(hierarchy.subtree(7)), { 7U });
+  BOOST_CHECK_EQUAL(hierarchy.depth(2), 2U);
+
+  // 3, 4, 5 and 6 don't descend from a primary
+  BOOST_CHECK_EQUAL(hierarchy.nDisconnected(), 4U);
+  BOOST_CHECK(!hierarchy.isFromPrimary(3));
+  BOOST_CHECK(!hierarchy.isFromPrimary(6));
+  BOOST_CHECK_EQUAL(hierarchy.depth(4), recob::PFParticleHierarchy::InvalidDepth);
+  checkSame(toVector(hierarchy.subtree(3)), { 3U });
+  checkSame(toVector(hierarchy.subtree(6)), { 6U });
+  checkSame(toVector(hierarchy.subtree(4)), { 4U, 5U });
+
+  // all the particles are placed in some subtree
+  BOOST_CHECK_EQUAL(hierarchy.subtreeSize(0) + hierarchy.subtreeSize(7)
+    + hierarchy.nDisconnected(), particles.size());
+
+} // BOOST_AUTO_TEST_CASE(BrokenHierarchy_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Empty_test) {
+
+  recob::PFParticleHierarchy const hierarchy{ std::vector<recob::PFParticle>{} };
+  BOOST_CHECK(hierarchy.empty());
+  BOOST_CHECK(hierarchy.primaries().empty());
+  BOOST_CHECK_EQUAL(hierarchy.index(0), Invalid);
+
+} // BOOST_AUTO_TEST_CASE(Empty_test)
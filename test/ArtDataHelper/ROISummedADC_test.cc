@@ -0,0 +1,144 @@
+/**
+ * @file   ROISummedADC_test.cc
+ * @brief  Unit test for `recob::ROISummedADC`
+ * @date   October 14, 2026
+ * @see    lardata/ArtDataHelper/HitCreator.h
+ *
+ * The sums of tick ranges are compared with the direct sums of the signal,
+ * for empty regions of interest and for each of the regions of a wire.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ROISummedADC_test )
+#include "cetlib/quiet_unit_test.hpp" // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/HitCreator.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cmath> // std::sin()
+#include <cstddef> // std::size_t
+#include <utility> // std::pair<>
+
+
+namespace {
+
+  using RegionOfInterest_t = recob::ROISummedADC::RegionOfInterest_t;
+
+  constexpr raw::TDCtick_t NTicks = 120;
+
+  /// Sum of the ticks of `signal` from `start` to `end` (excluded)
+  double directSum(
+    recob::Wire::RegionsOfInterest_t const& signal,
+    raw::TDCtick_t start, raw::TDCtick_t end
+    )
+  {
+    double sum = 0.0;
+    for (raw::TDCtick_t tick = start; tick < end; ++tick) {
+      if ((tick >= 0) && (tick < raw::TDCtick_t(signal.size())))
+        sum += signal[tick];
+    }
+    return sum;
+  } // directSum()
+
+  /// Sum of the ticks of `roi` from `start` to `end` (excluded)
+  double directSum
+    (RegionOfInterest_t const& roi, raw::TDCtick_t start, raw::TDCtick_t end)
+  {
+    double sum = 0.0;
+    raw::TDCtick_t tick = roi.begin_index();
+    for (auto const adc: roi) {
+      if ((tick >= start) && (tick < end)) sum += adc;
+      ++tick;
+    }
+    return sum;
+  } // directSum()
+
+  /// Checks the sums of all the tick ranges within the wire
+  void checkAllRanges(
+    recob::ROISummedADC const& sums, RegionOfInterest_t const& roi
+    )
+  {
+    for (raw::TDCtick_t start = -2; start <= NTicks; ++start) {
+      for (raw::TDCtick_t end = start; end <= NTicks + 2; ++end) {
+        BOOST_CHECK_SMALL
+          (sums.sum(start, end) - directSum(roi, start, end), 1e-9);
+      }
+      // reversed ranges are empty
+      BOOST_CHECK_EQUAL(sums.sum(start, start - 5), 0.0);
+    }
+  } // checkAllRanges()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EmptyROITestCase) {
+
+  // default-constructed: no region
+  recob::ROISummedADC const none;
+  BOOST_CHECK_EQUAL(none.begin_tick(), none.end_tick());
+  BOOST_CHECK_EQUAL(none.sum(), 0.0);
+  BOOST_CHECK_EQUAL(none.sum(0, NTicks), 0.0);
+  BOOST_CHECK_EQUAL(none.sum(-10, 10), 0.0);
+
+  // a region with no tick
+  std::vector<float> const noSamples;
+  RegionOfInterest_t const emptyROI(20U, noSamples.begin(), noSamples.end());
+  recob::ROISummedADC const empty(emptyROI);
+  BOOST_CHECK_EQUAL(empty.begin_tick(), 20);
+  BOOST_CHECK_EQUAL(empty.end_tick(), 20);
+  BOOST_CHECK_EQUAL(empty.sum(), 0.0);
+  BOOST_CHECK_EQUAL(empty.sum(20, 20), 0.0);
+  BOOST_CHECK_EQUAL(empty.sum(19, 21), 0.0);
+  checkAllRanges(empty, emptyROI);
+
+} // EmptyROITestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MultipleROIsTestCase) {
+
+  // regions of different length, one of a single tick, and one touching
+  // each end of the wire
+  std::vector<std::pair<std::size_t, std::size_t>> const regions = {
+    { 0U, 4U }, { 10U, 5U }, { 16U, 3U }, { 60U, 1U }, { 100U, 20U }
+  };
+
+  recob::Wire::RegionsOfInterest_t signal(NTicks);
+  for (auto const& [ start, length ]: regions) {
+    std::vector<float> samples(length);
+    for (std::size_t i = 0; i < length; ++i)
+      samples[i] = 20.0f * std::sin(0.3f * (start + i)) + 0.25f * i;
+    signal.add_range(start, samples.begin(), samples.end());
+  }
+  BOOST_CHECK_EQUAL(signal.n_ranges(), regions.size());
+
+  std::vector<recob::ROISummedADC> allSums;
+  for (auto const& roi: signal.get_ranges()) {
+    BOOST_TEST_CHECKPOINT("region at tick " << roi.begin_index());
+    recob::ROISummedADC const sums(roi);
+    BOOST_CHECK_EQUAL(sums.begin_tick(), raw::TDCtick_t(roi.begin_index()));
+    BOOST_CHECK_EQUAL(sums.end_tick(), raw::TDCtick_t(roi.end_index()));
+    BOOST_CHECK_SMALL(sums.sum() - directSum(roi, 0, NTicks), 1e-9);
+
+    // the ticks of the other regions are not included
+    checkAllRanges(sums, roi);
+    allSums.push_back(sums);
+  } // for regions
+
+  // all the regions together make the sum of the whole signal, which is
+  // what `HitCreator` would compute from the wire
+  for (raw::TDCtick_t start = 0; start <= NTicks; ++start) {
+    for (raw::TDCtick_t end = start; end <= NTicks; ++end) {
+      double total = 0.0;
+      for (recob::ROISummedADC const& sums: allSums)
+        total += sums.sum(start, end);
+      BOOST_CHECK_SMALL(total - directSum(signal, start, end), 1e-9);
+    }
+  }
+
+} // MultipleROIsTestCase
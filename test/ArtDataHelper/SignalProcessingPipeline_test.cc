@@ -0,0 +1,275 @@
+/**
+ * @file    SignalProcessingPipeline_test.cc
+ * @brief   Tests the stages of `recob::SignalProcessingPipeline`
+ * @date    October 14, 2026
+ * @see     `lardata/ArtDataHelper/SignalProcessingPipeline.h`
+ *
+ * The deconvolution kernels are constant (a scaling of the waveform), so
+ * that the wires can be compared with the pedestal subtracted ADC counts.
+ * The same digits are processed with one and with several threads.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/SignalProcessingPipeline.h"
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SignalProcessingPipeline_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+#include <boost/test/floating_point_comparison.hpp> // BOOST_CHECK_CLOSE()
+
+// TBB libraries
+#include "tbb/task_arena.h"
+
+// C/C++ standard libraries
+#include <cmath> // std::abs()
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+  using Pipeline_t = recob::SignalProcessingPipeline;
+
+  constexpr std::size_t TransformSize = 256U;
+  constexpr std::size_t NTicks = 200U;
+  constexpr std::size_t NChannels = 300U;
+  constexpr short Pedestal = 400;
+
+  /// Kernel scaling the waveform by `factor`
+  Pipeline_t::ComplexVector constantKernel(double factor)
+    { return Pipeline_t::ComplexVector(TransformSize / 2U + 1U, factor); }
+
+  /// Digits with one pulse each, at a tick depending on the channel
+  std::vector<raw::RawDigit> makeDigits() {
+    std::vector<raw::RawDigit> digits;
+    for (unsigned int channel = 0; channel < NChannels; ++channel) {
+      raw::RawDigit::ADCvector_t adcs(NTicks, Pedestal);
+      std::size_t const peak = 20U + (channel * 7U) % 150U;
+      for (int i = -2; i <= 2; ++i) adcs[peak + i] += 10 * (3 - std::abs(i));
+      digits.emplace_back(channel, NTicks, std::move(adcs));
+      digits.back().SetPedestal(Pedestal);
+    } // for
+    return digits;
+  } // makeDigits()
+
+  /// Channel setup: even channels use kernel 0, odd ones kernel 1
+  Pipeline_t::ChannelSetup_t setup(raw::ChannelID_t channel)
+    { return { (channel % 2)? geo::kV: geo::kU, std::size_t(channel % 2) }; }
+
+  /// Runs `f` in a task arena with the specified number of threads
+  template <typename F>
+  auto inArena(unsigned int nThreads, F f)
+    { tbb::task_arena arena(nThreads); return arena.execute(f); }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void FindROIsTest() {
+
+  std::vector<float> signal(50U, 0.0f);
+  signal[10] = signal[11] = 5.0f; // region [ 8, 13 [
+  signal[15] = 5.0f;              // region [ 13, 17 [, merged with the first
+  signal[30] = 5.0f;              // region [ 28, 32 [
+  signal[49] = 5.0f;              // region [ 47, 50 [, clamped
+  signal[40] = 1.0f;              // below threshold
+
+  std::vector<Pipeline_t::FlatROI_t> rois;
+  Pipeline_t::findROIs(signal.data(), signal.size(), 3.0f, 2U, 1U, rois);
+
+  BOOST_CHECK_EQUAL(rois.size(), 3U);
+  if (rois.size() != 3U) return;
+  BOOST_CHECK_EQUAL(rois[0].startTick, 8U);
+  BOOST_CHECK_EQUAL(rois[0].nSamples, 9U);
+  BOOST_CHECK_EQUAL(rois[1].startTick, 28U);
+  BOOST_CHECK_EQUAL(rois[1].nSamples, 4U);
+  BOOST_CHECK_EQUAL(rois[2].startTick, 47U);
+  BOOST_CHECK_EQUAL(rois[2].nSamples, 3U);
+  for (auto const& roi: rois) BOOST_CHECK_EQUAL(roi.offset, roi.startTick);
+
+  // no signal, no region (and the previous ones are removed)
+  std::vector<float> const empty(50U, 0.0f);
+  Pipeline_t::findROIs(empty.data(), empty.size(), 3.0f, 2U, 1U, rois);
+  BOOST_CHECK(rois.empty());
+
+} // FindROIsTest()
+
+
+//------------------------------------------------------------------------------
+void MedianPedestalTest() {
+
+  std::vector<short> scratch;
+  BOOST_CHECK_EQUAL(Pipeline_t::medianPedestal({}, scratch), 0.0f);
+  BOOST_CHECK_EQUAL
+    (Pipeline_t::medianPedestal({ 400, 402, 900, 399, 401 }, scratch), 401.0f);
+
+} // MedianPedestalTest()
+
+
+//------------------------------------------------------------------------------
+void PipelineTest() {
+
+  Pipeline_t::Config_t config;
+  config.batchSize = 16U;
+  config.threshold = 15.0f;
+  config.preSamples = 3U;
+  config.postSamples = 4U;
+
+  Pipeline_t pipeline({ constantKernel(1.0), constantKernel(2.0) }, config);
+  BOOST_CHECK_EQUAL(pipeline.transformSize(), TransformSize);
+  BOOST_CHECK_EQUAL(pipeline.nKernels(), 2U);
+
+  std::vector<raw::RawDigit> const digits = makeDigits();
+
+  auto const serial
+    = inArena(1U, [&](){ return pipeline.process(digits, setup); });
+  BOOST_CHECK_EQUAL(pipeline.nWorkspaces(), 1U);
+  auto const parallel
+    = inArena(8U, [&](){ return pipeline.process(digits, setup); });
+  BOOST_CHECK_LE(pipeline.nWorkspaces(), 8U);
+
+  BOOST_CHECK_EQUAL(serial->size(), NChannels);
+  BOOST_CHECK_EQUAL(parallel->size(), NChannels);
+  if ((serial->size() != NChannels) || (parallel->size() != NChannels)) return;
+
+  for (std::size_t i = 0; i < NChannels; ++i) {
+    recob::Wire const& wire = (*parallel)[i];
+    BOOST_CHECK_EQUAL(wire.Channel(), digits[i].Channel());
+    BOOST_CHECK_EQUAL(wire.View(), setup(digits[i].Channel()).view);
+    BOOST_CHECK_EQUAL(wire.NSignal(), NTicks);
+
+    // one region: the pulse (ticks with signal above 15), padded
+    auto const& ranges = wire.SignalROI().get_ranges();
+    BOOST_CHECK_EQUAL(ranges.size(), 1U);
+    if (ranges.size() != 1U) continue;
+    std::size_t const peak = 20U + (i * 7U) % 150U;
+    double const scale = (i % 2)? 2.0: 1.0;
+    std::size_t const first = (scale > 1.0)? peak - 2U: peak - 1U;
+    std::size_t const last = (scale > 1.0)? peak + 2U: peak + 1U;
+    BOOST_CHECK_EQUAL(ranges[0].begin_index(), first - 3U);
+    BOOST_CHECK_EQUAL(ranges[0].end_index(), last + 5U);
+    for (std::size_t tick = ranges[0].begin_index();
+      tick < ranges[0].end_index(); ++tick
+    ) {
+      double const expected
+        = scale * (digits[i].ADCs()[tick] - digits[i].GetPedestal());
+      BOOST_CHECK_SMALL(wire.SignalROI()[tick] - expected, 1e-3);
+    } // for ticks
+
+    // the result does not depend on the number of threads
+    auto const& serialRanges = (*serial)[i].SignalROI().get_ranges();
+    BOOST_CHECK_EQUAL(serialRanges.size(), ranges.size());
+    if (serialRanges.size() != ranges.size()) continue;
+    BOOST_CHECK_EQUAL(serialRanges[0].begin_index(), ranges[0].begin_index());
+    BOOST_CHECK_EQUAL(serialRanges[0].end_index(), ranges[0].end_index());
+  } // for channels
+
+  // one timing entry per channel and stage
+  Pipeline_t::Timing_t const timing = pipeline.timing();
+  BOOST_CHECK_EQUAL(timing.nCalls, 2U);
+  for (std::size_t iStage = 0; iStage < Pipeline_t::NStages; ++iStage) {
+    auto const stage = static_cast<Pipeline_t::Stage_t>(iStage);
+    BOOST_CHECK_EQUAL(timing[stage].entries, 2U * NChannels);
+  }
+  BOOST_CHECK_LE(timing.totalTime(), timing.wallTime * 8U);
+
+  std::ostringstream sstr;
+  sstr << timing;
+  BOOST_CHECK(sstr.str().find("deconvolution") != std::string::npos);
+
+  pipeline.resetTiming();
+  BOOST_CHECK_EQUAL(pipeline.timing().nCalls, 0U);
+  BOOST_CHECK_EQUAL(pipeline.timing()[Pipeline_t::Pedestal].entries, 0U);
+
+} // PipelineTest()
+
+
+//------------------------------------------------------------------------------
+void SinglePrecisionTest() {
+
+  Pipeline_t::Config_t config;
+  config.threshold = 5.0f;
+  config.estimatePedestal = true;
+  config.singlePrecision = true;
+
+  Pipeline_t pipeline({ constantKernel(1.0), constantKernel(2.0) }, config);
+
+  std::vector<raw::RawDigit> digits = makeDigits();
+  for (raw::RawDigit& digit: digits) digit.SetPedestal(0.0f); // not used
+
+  auto const wires = pipeline.process(digits, setup);
+  BOOST_CHECK_EQUAL(wires->size(), NChannels);
+  for (std::size_t i = 0; i < wires->size(); ++i) {
+    std::size_t const peak = 20U + (i * 7U) % 150U;
+    double const scale = (i % 2)? 2.0: 1.0;
+    BOOST_CHECK_CLOSE((*wires)[i].SignalROI()[peak], scale * 30.0, 1e-3);
+  } // for
+
+} // SinglePrecisionTest()
+
+
+//------------------------------------------------------------------------------
+void ErrorTest() {
+
+  using Kernels_t = std::vector<Pipeline_t::ComplexVector>;
+
+  BOOST_CHECK_THROW(Pipeline_t(Kernels_t{}), cet::exception);
+  BOOST_CHECK_THROW(
+    Pipeline_t(Kernels_t{ constantKernel(1.0), Pipeline_t::ComplexVector(65U) }),
+    cet::exception
+    );
+
+  Pipeline_t::Config_t config;
+  config.batchSize = 0U;
+  BOOST_CHECK_THROW(
+    Pipeline_t(Kernels_t{ constantKernel(1.0) }, config), cet::exception
+    );
+
+  Pipeline_t pipeline(Kernels_t{ constantKernel(1.0) });
+
+  // kernel #1 is not available
+  std::vector<raw::RawDigit> const digits = makeDigits();
+  BOOST_CHECK_THROW(pipeline.process(digits, setup), cet::exception);
+
+  // too many samples
+  std::vector<raw::RawDigit> longDigits;
+  longDigits.emplace_back(0U, TransformSize + 1U,
+    raw::RawDigit::ADCvector_t(TransformSize + 1U, Pedestal));
+  BOOST_CHECK_THROW(
+    pipeline.process(longDigits,
+      [](raw::ChannelID_t){ return Pipeline_t::ChannelSetup_t{ geo::kU, 0U }; }
+      ),
+    cet::exception
+    );
+
+} // ErrorTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FindROIsTestCase) {
+  FindROIsTest();
+}
+
+BOOST_AUTO_TEST_CASE(MedianPedestalTestCase) {
+  MedianPedestalTest();
+}
+
+BOOST_AUTO_TEST_CASE(PipelineTestCase) {
+  PipelineTest();
+}
+
+BOOST_AUTO_TEST_CASE(SinglePrecisionTestCase) {
+  SinglePrecisionTest();
+}
+
+BOOST_AUTO_TEST_CASE(ErrorTestCase) {
+  ErrorTest();
+}
@@ -16,7 +16,11 @@
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardataalg/DetectorInfo/LArProperties.h"
 #include "lardataalg/DetectorInfo/DetectorProperties.h"
+#include "lardata/DetectorInfoServices/XTicksConverter.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom<>()
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::PlaneID
+
+#include <vector>
 
 namespace util
 {
@@ -77,6 +81,19 @@ namespace util
     assert(detprop->DriftVelocity() == detprop->DriftVelocity(detprop->Efield(),
 							      detprop->Temperature()));
 
+    // Batch ticks <-> x conversions match the provider ones.
+
+    geo::PlaneID const planeID(0, 0, 0);
+    detinfo::XTicksConverter const converter(*detprop, planeID);
+    std::vector<float> const ticks { 0.0, 100.0, 1234.5, 3200.0 };
+    std::vector<double> const xs = converter.ticksToX(ticks);
+    std::vector<double> const backTicks = converter.xToTicks(xs);
+    assert(xs.size() == ticks.size());
+    for(std::size_t i = 0; i < ticks.size(); ++i) {
+      assert(xs[i] == detprop->ConvertTicksToX(ticks[i], planeID));
+      assert(backTicks[i] == detprop->ConvertXToTicks(xs[i], planeID));
+    }
+
     // Drift velocity vs. electric field.
 
     std::cout << "\nDrift Velocity vs. Electric Field.\n"
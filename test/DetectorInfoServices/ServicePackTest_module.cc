@@ -54,6 +54,7 @@ namespace lar {
    *
    * Currently exercises:
    * - `lar::extractProviders()`
+   * - `lar::makeProviderSnapshot()`
    *
    * Throws an exception on failure.
    *
@@ -104,6 +105,9 @@ namespace lar {
     /// All tests on lar::extractProviders()
     void extractProviders_tests();
 
+    /// Tests lar::makeProviderSnapshot() and the staleness check
+    void providerSnapshot_test();
+
     /// @}
 
       private:
@@ -129,6 +133,7 @@ namespace lar {
   //----------------------------------------------------------------------------
   void ServicePackTest::beginJob() {
     extractProviders_tests();
+    providerSnapshot_test();
   } // ServicePackTest::beginJob()
 
 
@@ -356,6 +361,66 @@ namespace lar {
   } // ServicePackTest::extractProviders_test_reduced()
 
 
+  //----------------------------------------------------------------------------
+  void ServicePackTest::providerSnapshot_test() {
+
+    /*
+     * The test creates a snapshot and checks that its providers are as
+     * expected, that copies share its stamp, and that it becomes stale
+     * after a provider change is declared.
+     */
+
+    // these are the "solutions":
+    geo::GeometryCore const* geom
+      = lar::providerFrom<geo::Geometry>();
+    detinfo::DetectorProperties const* detprop
+      = lar::providerFrom<detinfo::DetectorPropertiesService>();
+
+    auto const snapshot = lar::makeProviderSnapshot<
+      geo::Geometry,
+      detinfo::LArPropertiesService,
+      detinfo::DetectorClocksService,
+      detinfo::DetectorPropertiesService
+      >();
+
+    if (snapshot.get<geo::GeometryCore>() != geom) {
+      errors.push_back("wrong geometry provider (got "
+        + ::to_string(snapshot.get<geo::GeometryCore>())
+        + ", expected " + ::to_string(geom)
+        + ") [snapshot]");
+    }
+    if (snapshot.get<detinfo::DetectorProperties>() != detprop) {
+      errors.push_back("wrong detector properties provider (got "
+        + ::to_string(snapshot.get<detinfo::DetectorProperties>())
+        + ", expected " + ::to_string(detprop)
+        + ") [snapshot]");
+    }
+
+    // a reduced pack can be assigned from the snapshot
+    lar::ProviderPack<geo::GeometryCore> const reduced = snapshot.providers();
+    if (reduced.get<geo::GeometryCore>() != geom) {
+      errors.push_back("wrong geometry provider from snapshot [reduced]");
+    }
+
+    auto const copy = snapshot;
+    if (copy.stamp() != snapshot.stamp()) {
+      errors.push_back("snapshot copy has a different stamp");
+    }
+    if (snapshot.isStale()) {
+      errors.push_back("new snapshot is already stale");
+    }
+
+    lar::noteProviderChange();
+    if (!copy.isStale()) {
+      errors.push_back("snapshot not stale after a provider change");
+    }
+    if (lar::makeProviderSnapshot<geo::Geometry>().isStale()) {
+      errors.push_back("snapshot extracted after the change is stale");
+    }
+
+  } // ServicePackTest::providerSnapshot_test()
+
+
   //----------------------------------------------------------------------------
 
 } // namespace lar
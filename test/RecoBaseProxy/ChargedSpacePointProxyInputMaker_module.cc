@@ -17,6 +17,7 @@
 #include "art/Framework/Principal/Event.h"
 
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "cetlib_except/exception.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Comment.h"
@@ -26,6 +27,7 @@
 
 // C/C++ standard libraries
 #include <memory> // std::make_unique()
+#include <vector>
 
 
 namespace lar {
@@ -100,16 +102,27 @@ void lar::test::ChargedSpacePointProxyInputMaker::produce(art::Event& event) {
 
   const double err[6U] = { 1.0, 0.0, 1.0, 0.0, 0.0, 1.0 };
 
-  for (unsigned int iPoint = 0; iPoint < nPoints; ++iPoint) {
+  // the first half of the points is added one by one (alternating add() and
+  // emplace()), then a quarter in columns and the rest moved in with addAll()
+  unsigned int const nSinglePoints = nPoints / 2U;
+  unsigned int const nColumnPoints = nSinglePoints + (nPoints - nSinglePoints) / 2U;
+  for (unsigned int iPoint = 0; iPoint < nSinglePoints; ++iPoint) {
     BOOST_CHECK_EQUAL(spacePoints.size(), (std::size_t) iPoint);
 
     double const pos[3U]
       = { double(iPoint), double(2.0 * iPoint), double(4.0 * iPoint) };
 
-    spacePoints.add(
-      { pos, err, 1.0 /* chisq */, int(iPoint) /* id */ }, // space point
-      { recob::PointCharge::Charge_t(iPoint) }                  // charge
-      );
+    if (iPoint % 2U) {
+      spacePoints.emplace(recob::PointCharge::Charge_t(iPoint),
+        pos, err, 1.0 /* chisq */, int(iPoint) /* id */
+        );
+    }
+    else {
+      spacePoints.add(
+        { pos, err, 1.0 /* chisq */, int(iPoint) /* id */ }, // space point
+        { recob::PointCharge::Charge_t(iPoint) }                  // charge
+        );
+    }
 
     mf::LogVerbatim("ChargedSpacePointProxyInputMaker")
       << "[#" << iPoint << "] point: " << spacePoints.lastSpacePoint()
@@ -118,7 +131,53 @@ void lar::test::ChargedSpacePointProxyInputMaker::produce(art::Event& event) {
       << " (ptr: " << spacePoints.lastChargePtr() << ")";
 
   } // for (iPoint)
+  BOOST_CHECK_EQUAL(spacePoints.size(), (std::size_t) nSinglePoints);
+
+  std::vector<double> positions, errors, chi2;
+  std::vector<recob::PointCharge::Charge_t> charges;
+  for (unsigned int iPoint = nSinglePoints; iPoint < nColumnPoints; ++iPoint) {
+    positions.push_back(double(iPoint));
+    positions.push_back(double(2.0 * iPoint));
+    positions.push_back(double(4.0 * iPoint));
+    errors.insert(errors.end(), err, err + 6U);
+    chi2.push_back(1.0);
+    charges.push_back(recob::PointCharge::Charge_t(iPoint));
+  } // for (iPoint)
+  spacePoints.addColumns(positions, errors, chi2, charges, int(nSinglePoints));
+  BOOST_CHECK_EQUAL(spacePoints.size(), (std::size_t) nColumnPoints);
+
+  // the moved vectors have room for all the points, and are adopted
+  std::vector<recob::SpacePoint> movedPoints;
+  std::vector<recob::PointCharge> movedCharges;
+  movedPoints.reserve(nPoints);
+  movedCharges.reserve(nPoints);
+  for (unsigned int iPoint = nColumnPoints; iPoint < nPoints; ++iPoint) {
+    double const pos[3U]
+      = { double(iPoint), double(2.0 * iPoint), double(4.0 * iPoint) };
+    movedPoints.emplace_back(pos, err, 1.0, int(iPoint));
+    movedCharges.emplace_back(recob::PointCharge::Charge_t(iPoint));
+  } // for (iPoint)
+  recob::SpacePoint const* movedData = movedPoints.data();
+  spacePoints.addAll(std::move(movedPoints), std::move(movedCharges));
   BOOST_CHECK_EQUAL(spacePoints.size(), (std::size_t) nPoints);
+  BOOST_CHECK(movedPoints.empty());
+  BOOST_CHECK(movedCharges.empty());
+  if (nPoints > 0U)
+    BOOST_CHECK_EQUAL(&(spacePoints.spacePoint(0)), movedData);
+
+  for (unsigned int iPoint = nSinglePoints; iPoint < nPoints; ++iPoint) {
+    BOOST_CHECK_EQUAL(spacePoints.spacePoint(iPoint).ID(), int(iPoint));
+    BOOST_CHECK_EQUAL
+      (spacePoints.spacePoint(iPoint).XYZ()[1], double(2.0 * iPoint));
+    BOOST_CHECK_EQUAL(spacePoints.charge(iPoint).charge(), float(iPoint));
+    BOOST_CHECK_EQUAL(spacePoints.spacePointPtr(iPoint).key(), iPoint);
+  } // for (iPoint)
+
+  // inconsistent columns are rejected
+  BOOST_CHECK_THROW(
+    spacePoints.addColumns(positions, {}, {}, { 1.0F }, 0),
+    cet::exception
+    );
 
   mf::LogInfo("ChargedSpacePointProxyInputMaker")
     << "Produced " << spacePoints.size() << " points and charges.";
@@ -30,6 +30,9 @@
 #include <boost/test/test_tools.hpp> // BOOST_CHECK()
 
 // C/C++ libraries
+#include <algorithm> // std::sort(), std::min()
+#include <utility> // std::pair<>
+#include <vector>
 #include <memory> // std::addressof()
 #include <type_traits>
 #include <cassert>
@@ -148,6 +151,14 @@ void ChargedSpacePointProxyTest::testChargedSpacePoints
   BOOST_CHECK_EQUAL(std::addressof(charges), std::addressof(expectedCharges));
   BOOST_CHECK_EQUAL(charges.size(), expectedCharges.size());
 
+  auto const& columns = points.columns();
+  BOOST_CHECK_EQUAL(std::addressof(points.columns()), std::addressof(columns));
+  BOOST_CHECK_EQUAL(columns.size(), expectedSpacePoints.size());
+  BOOST_CHECK_EQUAL(columns.positionsX().size(), expectedSpacePoints.size());
+  BOOST_CHECK_EQUAL(columns.positionsY().size(), expectedSpacePoints.size());
+  BOOST_CHECK_EQUAL(columns.positionsZ().size(), expectedSpacePoints.size());
+  BOOST_CHECK_EQUAL(columns.charges().size(), expectedCharges.size());
+
   std::size_t iExpectedPoint = 0;
   for (auto pointProxy: points) {
     auto const& expectedSpacePoint = expectedSpacePoints[iExpectedPoint];
@@ -164,6 +175,15 @@ void ChargedSpacePointProxyTest::testChargedSpacePoints
     BOOST_CHECK_EQUAL(pointProxy.hasCharge(), expectedChargeInfo.hasCharge());
     BOOST_CHECK_EQUAL(pointProxy.charge(), expectedChargeInfo.charge());
 
+    BOOST_CHECK_EQUAL(columns.positionsX()[iExpectedPoint],
+      static_cast<float>(expectedSpacePoint.XYZ()[0]));
+    BOOST_CHECK_EQUAL(columns.positionsY()[iExpectedPoint],
+      static_cast<float>(expectedSpacePoint.XYZ()[1]));
+    BOOST_CHECK_EQUAL(columns.positionsZ()[iExpectedPoint],
+      static_cast<float>(expectedSpacePoint.XYZ()[2]));
+    BOOST_CHECK_EQUAL
+      (columns.charges()[iExpectedPoint], expectedChargeInfo.charge());
+
     decltype(auto) chargeInfo = pointProxy.get<recob::PointCharge>();
     static_assert(
       std::is_lvalue_reference<decltype(chargeInfo)>(),
@@ -176,6 +196,41 @@ void ChargedSpacePointProxyTest::testChargedSpacePoints
   } // for
   BOOST_CHECK_EQUAL(iExpectedPoint, expectedSpacePoints.size());
 
+  //
+  // spatial index, compared with a direct search
+  //
+  auto const& grid = points.spatialIndex(0.5);
+  BOOST_CHECK_EQUAL(std::addressof(points.spatialIndex(0.5)), std::addressof(grid));
+  BOOST_CHECK_EQUAL(grid.size(), expectedSpacePoints.size());
+
+  double const radius = 1.5;
+  for (auto pointProxy: points) {
+    geo::Point_t const center = pointProxy.position();
+
+    std::vector<std::pair<double, std::size_t>> distances;
+    std::vector<std::size_t> expectedWithin;
+    for (std::size_t i = 0; i < expectedSpacePoints.size(); ++i) {
+      double const d2 = (geo::vect::makePointFromCoords
+        (expectedSpacePoints[i].XYZ()) - center).Mag2();
+      distances.emplace_back(d2, i);
+      if (d2 <= radius * radius) expectedWithin.push_back(i);
+    } // for
+    std::sort(distances.begin(), distances.end());
+
+    auto const within = grid.pointsWithin(center, radius);
+    BOOST_CHECK_EQUAL_COLLECTIONS(within.begin(), within.end(),
+      expectedWithin.begin(), expectedWithin.end());
+
+    std::size_t const k = std::min<std::size_t>(3U, distances.size());
+    std::vector<std::size_t> expectedNearest;
+    for (std::size_t i = 0; i < k; ++i)
+      expectedNearest.push_back(distances[i].second);
+    auto const nearest = points.nearestPoints(center, 3U);
+    BOOST_CHECK_EQUAL_COLLECTIONS(nearest.begin(), nearest.end(),
+      expectedNearest.begin(), expectedNearest.end());
+    BOOST_CHECK_EQUAL(nearest.front(), pointProxy.index());
+  } // for
+
 } // ChargedSpacePointProxyTest::testChargedSpacePoints()
 
 
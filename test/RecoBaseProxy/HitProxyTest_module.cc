@@ -0,0 +1,160 @@
+/**
+ * @file   HitProxyTest_module.cc
+ * @brief  Tests `proxy::Hits` proxy.
+ * @date   October 14, 2026
+ *
+ */
+
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/Hits.h" // proxy namespace
+#include "lardataobj/RecoBase/Hit.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::PlaneID, ...
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// framework libraries
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Utilities/InputTag.h"
+
+// utility libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// Boost libraries
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// C/C++ libraries
+#include <map>
+#include <vector>
+#include <memory> // std::addressof()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Runs a test of `proxy::Hits` interface.
+ *
+ * The groups of the proxy are compared with maps filled directly from the hit
+ * collection.
+ *
+ * This module uses Boost unit test library, and as such it must be run with
+ * `lar_ut` instead of `lar`.
+ */
+class HitProxyTest: public art::EDAnalyzer {
+    public:
+
+  struct Config {
+    using Name = fhicl::Name;
+    using Comment = fhicl::Comment;
+
+    fhicl::Atom<art::InputTag> hitsTag{
+      Name("hits"),
+      Comment("tag of the recob::Hit data product.")
+      };
+
+  }; // struct Config
+
+  using Parameters = art::EDAnalyzer::Table<Config>;
+
+  explicit HitProxyTest(Parameters const& config)
+    : art::EDAnalyzer(config)
+    , hitsTag(config().hitsTag())
+    {}
+
+  // Plugins should not be copied or assigned.
+  HitProxyTest(HitProxyTest const &) = delete;
+  HitProxyTest(HitProxyTest&&) = delete;
+  HitProxyTest& operator= (HitProxyTest const &) = delete;
+  HitProxyTest& operator= (HitProxyTest&&) = delete;
+
+  virtual void analyze(art::Event const& event) override;
+
+    private:
+  art::InputTag hitsTag; ///< Tag for the input.
+
+  /// Checks that `group` has the proxies of the hits at `expected` positions.
+  template <typename Group>
+  void checkGroup
+    (Group const& group, std::vector<std::size_t> const& expected) const;
+
+}; // class HitProxyTest
+
+
+//------------------------------------------------------------------------------
+template <typename Group>
+void HitProxyTest::checkGroup
+  (Group const& group, std::vector<std::size_t> const& expected) const
+{
+  auto const& positions = group.positions();
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (positions.begin(), positions.end(), expected.begin(), expected.end());
+
+  BOOST_CHECK_EQUAL(group.size(), expected.size());
+  std::size_t i = 0;
+  for (auto hitProxy: group) {
+    if (i >= expected.size()) break;
+    BOOST_CHECK_EQUAL(hitProxy.index(), expected[i]);
+    ++i;
+  } // for
+  BOOST_CHECK_EQUAL(i, expected.size());
+
+} // HitProxyTest::checkGroup()
+
+
+//------------------------------------------------------------------------------
+void HitProxyTest::analyze(art::Event const& event) {
+
+  auto const& expectedHits
+    = *(event.getValidHandle<std::vector<recob::Hit>>(hitsTag));
+
+  mf::LogInfo("ProxyTest")
+    << "Starting test on " << expectedHits.size() << " hits from '"
+    << hitsTag.encode() << "'";
+
+  std::map<raw::ChannelID_t, std::vector<std::size_t>> byChannel;
+  std::map<geo::PlaneID, std::vector<std::size_t>> byPlane;
+  std::map<geo::WireID, std::vector<std::size_t>> byWire;
+  for (std::size_t iHit = 0; iHit < expectedHits.size(); ++iHit) {
+    recob::Hit const& hit = expectedHits[iHit];
+    byChannel[hit.Channel()].push_back(iHit);
+    byPlane[hit.WireID().asPlaneID()].push_back(iHit);
+    byWire[hit.WireID()].push_back(iHit);
+  } // for
+
+  auto hits = proxy::getHits(event, hitsTag);
+
+  BOOST_CHECK_EQUAL
+    (std::addressof(hits.hits()), std::addressof(expectedHits));
+  BOOST_CHECK_EQUAL(hits.size(), expectedHits.size());
+
+  auto const& index = hits.groupIndex();
+  BOOST_CHECK_EQUAL(std::addressof(hits.groupIndex()), std::addressof(index));
+  BOOST_CHECK_EQUAL(index.nHits(), expectedHits.size());
+
+  BOOST_CHECK_EQUAL(index.channels().size(), byChannel.size());
+  for (auto const& [ channel, expected ]: byChannel)
+    checkGroup(hits.onChannel(channel), expected);
+
+  BOOST_CHECK_EQUAL(index.planes().size(), byPlane.size());
+  for (auto const& [ planeID, expected ]: byPlane)
+    checkGroup(hits.onPlane(planeID), expected);
+
+  for (auto const& [ wireID, expected ]: byWire)
+    checkGroup(hits.onWire(wireID), expected);
+
+  // a channel and a plane with no hits
+  raw::ChannelID_t const lastChannel
+    = byChannel.empty()? 0: byChannel.rbegin()->first;
+  BOOST_CHECK(hits.onChannel(lastChannel + 1).empty());
+  BOOST_CHECK(hits.onPlane(geo::PlaneID{ 99, 99, 99 }).empty());
+
+} // HitProxyTest::analyze()
+
+
+//------------------------------------------------------------------------------
+
+DEFINE_ART_MODULE(HitProxyTest)
@@ -0,0 +1,170 @@
+/**
+ * @file   AssociatedData_test.cc
+ * @brief  Unit tests on grouping of associations in `proxy::AssociatedData`.
+ * @date   October 14, 2026
+ *
+ * The _art_ pointers in the associations are never dereferenced: only their
+ * keys are checked.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( AssociatedData_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/AssociatedData.h"
+#include "lardata/RecoBaseProxy/ProxyBase/IndexBufferPool.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <iterator> // std::distance()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+// types used for the test
+struct Track {};
+struct Hit {};
+
+/// Associations (track key, hit key), neither sorted nor contiguous.
+std::vector<std::pair<std::size_t, std::size_t>> const AssnsKeys = {
+  { 3U, 0U }, { 0U, 1U }, { 1U, 2U }, { 0U, 3U },
+  { 3U, 4U }, { 1U, 5U }, { 0U, 6U }, { 3U, 7U }
+};
+
+/// Expected hit keys associated with each track key.
+std::vector<std::vector<std::size_t>> const ExpectedHits = {
+  { 1U, 3U, 6U }, { 2U, 5U }, {}, { 0U, 4U, 7U }, {}
+};
+
+
+template <typename Assns>
+void addAssns(Assns& assns) {
+  for (auto const& keys: AssnsKeys) {
+    assns.addSingle(
+      art::Ptr<Track>(art::ProductID(), keys.first, nullptr),
+      art::Ptr<Hit>(art::ProductID(), keys.second, nullptr)
+      );
+  } // for
+} // addAssns()
+
+
+// -----------------------------------------------------------------------------
+void unsortedAssociatedDataTest() {
+
+  art::Assns<Track, Hit> assns;
+  addAssns(assns);
+
+  std::size_t const nTracks = ExpectedHits.size();
+  auto const assData = proxy::makeAssociatedData(assns, nTracks);
+
+  BOOST_CHECK_EQUAL
+    (std::distance(assData.begin(), assData.end()), (int) nTracks);
+
+  for (std::size_t iTrack = 0; iTrack < nTracks; ++iTrack) {
+    auto const& expected = ExpectedHits[iTrack];
+    auto const hits = assData[iTrack];
+    BOOST_CHECK_EQUAL(hits.size(), expected.size());
+
+    std::size_t iHit = 0;
+    for (auto it = hits.begin(); it != hits.end(); ++it, ++iHit) {
+      BOOST_CHECK_EQUAL(it.mainPtr().key(), iTrack);
+      BOOST_CHECK_EQUAL(it->key(), expected.at(iHit));
+    } // for hits
+    BOOST_CHECK_EQUAL(iHit, expected.size());
+  } // for tracks
+
+  // access by range iteration must be the same
+  std::size_t iTrack = 0;
+  for (auto const& hits: assData) {
+    BOOST_CHECK_EQUAL(hits.size(), ExpectedHits[iTrack].size());
+    ++iTrack;
+  } // for
+
+} // unsortedAssociatedDataTest()
+
+
+// -----------------------------------------------------------------------------
+void unsortedAssociatedDataWithMetadataTest() {
+
+  art::Assns<Track, Hit, float> assns;
+  for (auto const& keys: AssnsKeys) {
+    assns.addSingle(
+      art::Ptr<Track>(art::ProductID(), keys.first, nullptr),
+      art::Ptr<Hit>(art::ProductID(), keys.second, nullptr),
+      keys.second * 0.5F
+      );
+  } // for
+
+  // no explicit size: as many ranges as the largest track key plus one
+  auto const assData = proxy::makeAssociatedData(assns);
+  BOOST_CHECK_EQUAL(std::distance(assData.begin(), assData.end()), 4);
+
+  std::size_t const iTrack = 3U;
+  auto const& expected = ExpectedHits[iTrack];
+  auto const hits = assData[iTrack];
+  BOOST_CHECK_EQUAL(hits.size(), expected.size());
+  std::size_t iHit = 0;
+  for (auto it = hits.begin(); it != hits.end(); ++it, ++iHit) {
+    BOOST_CHECK_EQUAL(it->key(), expected.at(iHit));
+    BOOST_CHECK_EQUAL(it.data(), expected.at(iHit) * 0.5F);
+  } // for
+
+} // unsortedAssociatedDataWithMetadataTest()
+
+
+// -----------------------------------------------------------------------------
+void pooledAssociatedDataTest() {
+
+  art::Assns<Track, Hit> assns;
+  addAssns(assns);
+  std::size_t const nTracks = ExpectedHits.size();
+
+  proxy::IndexBufferPool pool;
+
+  // each index takes three buffers (nodes, offsets and a temporary one);
+  // the first "event" allocates all of them, the following ones recycle
+  constexpr std::size_t NEvents = 3U;
+  for (std::size_t iEvent = 0; iEvent < NEvents; ++iEvent) {
+
+    proxy::IndexBufferPool::Use const usePool(pool);
+    BOOST_CHECK_EQUAL(proxy::IndexBufferPool::inUse(), &pool);
+
+    auto const assData = proxy::makeAssociatedData(assns, nTracks);
+    BOOST_CHECK_EQUAL(pool.nAvailable(), 1U); // the temporary buffer
+
+    for (std::size_t iTrack = 0; iTrack < nTracks; ++iTrack) {
+      auto const& expected = ExpectedHits[iTrack];
+      auto const hits = assData[iTrack];
+      BOOST_CHECK_EQUAL(hits.size(), expected.size());
+      std::size_t iHit = 0;
+      for (auto it = hits.begin(); it != hits.end(); ++it, ++iHit)
+        BOOST_CHECK_EQUAL(it->key(), expected.at(iHit));
+    } // for tracks
+
+  } // for events
+  BOOST_CHECK(proxy::IndexBufferPool::inUse() == nullptr);
+  BOOST_CHECK_EQUAL(pool.nAvailable(), 3U);
+  BOOST_CHECK_EQUAL(pool.nAllocated(), 3U);
+  BOOST_CHECK_EQUAL(pool.nRecycled(), 3U * (NEvents - 1U));
+
+  // data created with no pool in use does not affect the pool
+  auto const assData = proxy::makeAssociatedData(assns, nTracks);
+  BOOST_CHECK_EQUAL(assData[0U].size(), ExpectedHits[0U].size());
+  BOOST_CHECK_EQUAL(pool.nAvailable(), 3U);
+
+} // pooledAssociatedDataTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(AssociatedDataTestCase) {
+  unsortedAssociatedDataTest();
+  unsortedAssociatedDataWithMetadataTest();
+  pooledAssociatedDataTest();
+} // BOOST_AUTO_TEST_CASE(AssociatedDataTestCase)
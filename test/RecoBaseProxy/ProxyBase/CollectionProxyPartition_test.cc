@@ -0,0 +1,94 @@
+/**
+ * @file   CollectionProxyPartition_test.cc
+ * @brief  Unit tests on `proxy::CollectionProxyPartition`.
+ * @date   October 14, 2026
+ *
+ * The collection proxies are built on a plain vector, without auxiliary data.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( CollectionProxyPartition_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/CollectionProxyPartition.h"
+#include "lardata/RecoBaseProxy/ProxyBase/CollectionProxy.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <iterator> // std::distance()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+void partitionTest() {
+
+  std::vector<int> const data { 12, 5, 31, 17, 3, 35, 10, 14 };
+  auto const partition = proxy::partitionCollection(
+    proxy::details::makeCollectionProxy(data),
+    [](auto const& elem){ return *elem / 10; }
+    );
+
+  // keys: 0 (5, 3), 1 (12, 17, 10, 14), 3 (31, 35)
+  std::vector<int> const expectedKeys { 0, 1, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(partition.keys().begin(), partition.keys().end(),
+    expectedKeys.begin(), expectedKeys.end());
+  BOOST_CHECK_EQUAL(partition.size(), 3U);
+
+  std::vector<std::vector<std::size_t>> const expectedPositions
+    { { 1U, 4U }, { 0U, 3U, 6U, 7U }, { 2U, 5U } };
+  std::size_t iSubset = 0U;
+  std::size_t nElements = 0U;
+  for (auto const& subset: partition) {
+    auto const& expected = expectedPositions[iSubset];
+    auto const& positions = subset.positions();
+    BOOST_CHECK_EQUAL_COLLECTIONS(positions.begin(), positions.end(),
+      expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(std::distance(subset.begin(), subset.end()),
+      (std::ptrdiff_t) expected.size());
+
+    std::size_t i = 0U;
+    for (auto const& elem: subset) {
+      BOOST_CHECK_EQUAL(elem.index(), expected[i]);
+      BOOST_CHECK_EQUAL(&*elem, &data[expected[i]]);
+      BOOST_CHECK_EQUAL(*elem / 10, partition.key(iSubset));
+      ++i;
+    } // for elements
+    nElements += subset.size();
+    ++iSubset;
+  } // for subsets
+  BOOST_CHECK_EQUAL(iSubset, partition.size());
+  BOOST_CHECK_EQUAL(nElements, data.size());
+
+  BOOST_CHECK_EQUAL(partition.subset(1).size(), 4U);
+  BOOST_CHECK_EQUAL(*(partition.subset(3)[1]), 35);
+  BOOST_CHECK(partition.subset(2).empty());
+  BOOST_CHECK(partition.subset(7).empty());
+
+} // partitionTest()
+
+
+// -----------------------------------------------------------------------------
+void emptyPartitionTest() {
+
+  std::vector<int> const data;
+  auto const partition = proxy::partitionCollection(
+    proxy::details::makeCollectionProxy(data),
+    [](auto const& elem){ return *elem; }
+    );
+
+  BOOST_CHECK(partition.empty());
+  BOOST_CHECK(partition.begin() == partition.end());
+  BOOST_CHECK(partition.subset(0).empty());
+
+} // emptyPartitionTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(CollectionProxyPartitionTestCase) {
+
+  partitionTest();
+  emptyPartitionTest();
+
+} // BOOST_AUTO_TEST_CASE(CollectionProxyPartitionTestCase)
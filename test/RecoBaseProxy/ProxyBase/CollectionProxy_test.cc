@@ -0,0 +1,137 @@
+/**
+ * @file   CollectionProxy_test.cc
+ * @brief  Unit tests on iteration of `proxy::CollectionProxyBase`.
+ * @date   October 14, 2026
+ *
+ * The collection proxies are built on a plain vector, without auxiliary data.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( CollectionProxy_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/CollectionProxy.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::for_each()
+#include <iterator> // std::distance(), std::iterator_traits<>
+#include <type_traits> // std::is_same<>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+std::vector<int> makeData(std::size_t n) {
+  std::vector<int> data;
+  data.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) data.push_back(10 * i);
+  return data;
+} // makeData()
+
+
+// -----------------------------------------------------------------------------
+void randomAccessIteratorTest() {
+
+  auto const data = makeData(10U);
+  auto const coll = proxy::details::makeCollectionProxy(data);
+
+  using iterator_t = decltype(coll.begin());
+  static_assert(std::is_same<
+    typename std::iterator_traits<iterator_t>::iterator_category,
+    std::random_access_iterator_tag
+    >::value,
+    "Collection proxy iterator is not random access"
+    );
+
+  auto const b = coll.begin();
+  auto const e = coll.end();
+  BOOST_CHECK_EQUAL(e - b, (int) data.size());
+  BOOST_CHECK_EQUAL(std::distance(b, e), (int) data.size());
+
+  auto it = b + 4;
+  BOOST_CHECK_EQUAL((*it).index(), 4U);
+  BOOST_CHECK_EQUAL(*(*it), data[4]);
+  BOOST_CHECK_EQUAL(*(b[7]), data[7]);
+  BOOST_CHECK_EQUAL((2 + it).index(), 6U);
+  BOOST_CHECK_EQUAL((it - 3).index(), 1U);
+
+  it += 3;
+  BOOST_CHECK_EQUAL(it.index(), 7U);
+  it -= 5;
+  BOOST_CHECK_EQUAL(it.index(), 2U);
+  BOOST_CHECK_EQUAL((it++).index(), 2U);
+  BOOST_CHECK_EQUAL((it--).index(), 3U);
+  BOOST_CHECK_EQUAL((--it).index(), 1U);
+
+  BOOST_CHECK(b < it);
+  BOOST_CHECK(b <= it);
+  BOOST_CHECK(e > it);
+  BOOST_CHECK(e >= e);
+  BOOST_CHECK(b + 1 == it);
+  BOOST_CHECK(b != it);
+
+  std::size_t n = 0;
+  std::for_each(b, e, [&n](auto const& elem){
+    BOOST_CHECK_EQUAL(*elem, (int) (10 * elem.index()));
+    ++n;
+  });
+  BOOST_CHECK_EQUAL(n, data.size());
+
+} // randomAccessIteratorTest()
+
+
+// -----------------------------------------------------------------------------
+/// Splits the range recursively, checking that each element is met once.
+template <typename Range>
+void visitRange(Range& range, std::vector<unsigned int>& visits) {
+  if (!range.is_divisible()) {
+    BOOST_CHECK_LE(range.size(), range.grainsize());
+    for (auto const& elem: range) ++visits.at(elem.index());
+    return;
+  }
+  std::size_t const size = range.size();
+  Range other(range, 0); // any splitting tag will do
+  BOOST_CHECK_EQUAL(range.size() + other.size(), size);
+  BOOST_CHECK(range.end() == other.begin());
+  BOOST_CHECK(!range.empty());
+  BOOST_CHECK(!other.empty());
+  visitRange(range, visits);
+  visitRange(other, visits);
+} // visitRange()
+
+
+void splittableRangeTest() {
+
+  auto const data = makeData(37U);
+  auto const coll = proxy::details::makeCollectionProxy(data);
+
+  for (std::size_t grainSize: { 0U, 1U, 3U, 10U, 50U }) {
+    auto range = coll.range(grainSize);
+    BOOST_CHECK_EQUAL(range.size(), data.size());
+    BOOST_CHECK(range.begin() == coll.begin());
+    BOOST_CHECK(range.end() == coll.end());
+
+    std::vector<unsigned int> visits(data.size(), 0U);
+    visitRange(range, visits);
+    for (auto count: visits) BOOST_CHECK_EQUAL(count, 1U);
+  } // for
+
+  std::vector<int> const empty;
+  auto const emptyColl = proxy::details::makeCollectionProxy(empty);
+  auto const emptyRange = emptyColl.range();
+  BOOST_CHECK(emptyRange.empty());
+  BOOST_CHECK(!emptyRange.is_divisible());
+
+} // splittableRangeTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(CollectionProxyIteratorTestCase) {
+  randomAccessIteratorTest();
+} // BOOST_AUTO_TEST_CASE(CollectionProxyIteratorTestCase)
+
+BOOST_AUTO_TEST_CASE(CollectionProxyRangeTestCase) {
+  splittableRangeTest();
+} // BOOST_AUTO_TEST_CASE(CollectionProxyRangeTestCase)
@@ -0,0 +1,120 @@
+/**
+ * @file   OneTo01Data_test.cc
+ * @brief  Unit tests on dense and sparse `proxy::details::OneTo01Data`.
+ * @date   October 14, 2026
+ *
+ * The _art_ pointers in the associations are never dereferenced: only their
+ * keys are checked.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( OneTo01Data_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/OneTo01Data.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair<>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+// types used for the test
+struct Track {};
+struct Flash {};
+
+using Assns_t = art::Assns<Track, Flash>;
+
+
+Assns_t makeAssns(std::vector<std::pair<std::size_t, std::size_t>> const& keys)
+{
+  Assns_t assns;
+  for (auto const& [ trackKey, flashKey ]: keys) {
+    assns.addSingle(
+      art::Ptr<Track>(art::ProductID(), trackKey, nullptr),
+      art::Ptr<Flash>(art::ProductID(), flashKey, nullptr)
+      );
+  } // for
+  return assns;
+} // makeAssns()
+
+
+// -----------------------------------------------------------------------------
+void denseOneTo01DataTest() {
+
+  // 3 out of 4 tracks are associated
+  constexpr std::size_t NTracks = 4U;
+  auto const assns = makeAssns({ { 0U, 5U }, { 1U, 6U }, { 3U, 7U } });
+  auto const data = proxy::makeOneTo01data(assns, NTracks);
+
+  BOOST_CHECK(!data.isSparse());
+  BOOST_CHECK_EQUAL(data.size(), NTracks);
+  BOOST_CHECK(data.has(0U));
+  BOOST_CHECK(data.has(1U));
+  BOOST_CHECK(!data.has(2U));
+  BOOST_CHECK(data.has(3U));
+  BOOST_CHECK_EQUAL(data[0U].key(), 5U);
+  BOOST_CHECK_EQUAL(data[1U].key(), 6U);
+  BOOST_CHECK_EQUAL(data[3U].key(), 7U);
+
+} // denseOneTo01DataTest()
+
+
+// -----------------------------------------------------------------------------
+void sparseOneTo01DataTest() {
+
+  // 3 out of 100 tracks are associated
+  constexpr std::size_t NTracks = 100U;
+  auto const assns = makeAssns({ { 10U, 1U }, { 42U, 2U }, { 77U, 3U } });
+  auto const data = proxy::makeOneTo01data(assns, NTracks);
+
+  BOOST_CHECK(data.isSparse());
+  BOOST_CHECK_EQUAL(data.size(), NTracks);
+
+  unsigned int nAssociated = 0U;
+  for (std::size_t i = 0; i < NTracks; ++i) {
+    if (data.has(i)) ++nAssociated;
+    else BOOST_CHECK(data[i] == art::Ptr<Flash>());
+  } // for
+  BOOST_CHECK_EQUAL(nAssociated, 3U);
+  BOOST_CHECK_EQUAL(data[10U].key(), 1U);
+  BOOST_CHECK_EQUAL(data[42U].key(), 2U);
+  BOOST_CHECK_EQUAL(data[77U].key(), 3U);
+
+} // sparseOneTo01DataTest()
+
+
+// -----------------------------------------------------------------------------
+void unsortedSparseOneTo01DataTest() {
+
+  // not sorted, and track 42 is associated twice: the last association wins
+  constexpr std::size_t NTracks = 100U;
+  auto const assns
+    = makeAssns({ { 77U, 3U }, { 42U, 2U }, { 10U, 1U }, { 42U, 4U } });
+  auto const data = proxy::makeOneTo01data(assns, NTracks);
+
+  BOOST_CHECK(data.isSparse());
+  BOOST_CHECK_EQUAL(data.size(), NTracks);
+  BOOST_CHECK(!data.has(0U));
+  BOOST_CHECK(!data.has(99U));
+  BOOST_CHECK_EQUAL(data[10U].key(), 1U);
+  BOOST_CHECK_EQUAL(data[42U].key(), 4U);
+  BOOST_CHECK_EQUAL(data[77U].key(), 3U);
+
+} // unsortedSparseOneTo01DataTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(OneTo01DataTestCase) {
+  denseOneTo01DataTest();
+  sparseOneTo01DataTest();
+  unsortedSparseOneTo01DataTest();
+} // BOOST_AUTO_TEST_CASE(OneTo01DataTestCase)
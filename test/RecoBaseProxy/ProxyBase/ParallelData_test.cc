@@ -0,0 +1,98 @@
+/**
+ * @file   ParallelData_test.cc
+ * @brief  Unit tests on `proxy::details::ParallelData` and its zip view.
+ * @date   October 14, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ParallelData_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/ParallelData.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <deque>
+#include <iterator> // std::distance()
+#include <type_traits> // std::is_same<>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+// types used for the test
+struct Momentum { double p; };
+struct Charge { float q; };
+struct Label { int id; };
+
+
+// -----------------------------------------------------------------------------
+void parallelDataTest() {
+
+  std::vector<Momentum> const momenta { { 1.0 }, { 2.0 }, { 3.0 } };
+  auto const data = proxy::makeParallelData(momenta);
+
+  BOOST_CHECK_EQUAL(data.size(), momenta.size());
+  BOOST_CHECK_EQUAL(data.elements(), momenta.data());
+  for (std::size_t i = 0; i < momenta.size(); ++i) {
+    data.prefetch(i);
+    BOOST_CHECK_EQUAL(&data.element(i), &momenta[i]);
+    BOOST_CHECK_EQUAL(data[i].p, momenta[i].p);
+  } // for
+
+  // a collection without contiguous storage takes the generic path
+  std::deque<Label> const labels { { 5 }, { 6 } };
+  auto const labelData = proxy::makeParallelData(labels);
+  BOOST_CHECK_EQUAL(&labelData.element(1U), &labels[1]);
+  labelData.prefetch(0U); // does nothing
+
+} // parallelDataTest()
+
+
+// -----------------------------------------------------------------------------
+void parallelDataZipTest() {
+
+  std::vector<Momentum> const momenta { { 1.0 }, { 2.0 }, { 3.0 } };
+  std::vector<Charge> const charges { { 0.5f }, { 1.5f }, { 2.5f } };
+  std::deque<Label> const labels { { 10 }, { 11 }, { 12 } };
+
+  auto const zip = proxy::zipParallelData(
+    proxy::makeParallelData(momenta),
+    proxy::makeParallelData(charges),
+    proxy::makeParallelData(labels)
+    );
+
+  static_assert(std::is_same<
+    decltype(zip)::value_type,
+    std::tuple<Momentum const&, Charge const&, Label const&>
+    >());
+
+  BOOST_CHECK_EQUAL(zip.size(), 3U);
+  BOOST_CHECK(!zip.empty());
+  BOOST_CHECK_EQUAL(std::distance(zip.begin(), zip.end()), 3);
+
+  std::size_t i = 0;
+  for (auto const& [ momentum, charge, label ]: zip) {
+    BOOST_CHECK_EQUAL(&momentum, &momenta[i]);
+    BOOST_CHECK_EQUAL(&charge, &charges[i]);
+    BOOST_CHECK_EQUAL(&label, &labels[i]);
+    ++i;
+  } // for
+  BOOST_CHECK_EQUAL(i, 3U);
+
+  BOOST_CHECK_EQUAL(zip.get<Charge>(1U).q, 1.5f);
+  BOOST_CHECK_EQUAL(zip.get<Label>(2U).id, 12);
+  BOOST_CHECK_EQUAL(zip.data<Momentum>().elements(), momenta.data());
+  BOOST_CHECK_EQUAL(std::get<0U>(zip.begin()[2]).p, 3.0);
+
+} // parallelDataZipTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ParallelDataTestCase) {
+
+  parallelDataTest();
+  parallelDataZipTest();
+
+} // BOOST_AUTO_TEST_CASE(ParallelDataTestCase)
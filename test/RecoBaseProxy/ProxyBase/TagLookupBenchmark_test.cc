@@ -0,0 +1,99 @@
+/**
+ * @file   TagLookupBenchmark_test.cc
+ * @brief  Compilation benchmark for proxies with many auxiliary data.
+ * @date   October 14, 2026
+ *
+ * This test builds a collection proxy with `NAuxData` auxiliary data
+ * collections and accesses each of them by tag, both from the collection and
+ * from its elements. The lookup of the tags happens at compile time, so the
+ * interesting figure of this test is the time it takes to compile,
+ * which should grow about linearly with `NAuxData`.
+ * The test also checks that each tag leads to the right data.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TagLookupBenchmark_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/RecoBaseProxy/ProxyBase/CollectionProxy.h"
+#include "lardata/Utilities/TupleLookupByTag.h" // util::TagN<>, ...
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::index_sequence<>, std::make_index_sequence()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+/// Number of auxiliary data collections in the proxy.
+constexpr std::size_t NAuxData = 32U;
+
+/// Tag of the auxiliary data number `I`.
+template <std::size_t I>
+using AuxTag = util::TagN<I>;
+
+/// Datum of the auxiliary data number `I`.
+template <std::size_t I>
+struct AuxValue {
+  int value;
+  AuxValue(int value): value(value) {}
+}; // struct AuxValue<>
+
+/// Auxiliary data number `I`: the value of each element is `I` times its key.
+template <std::size_t I>
+struct AuxColl {
+  using tag = AuxTag<I>;
+  using auxiliary_data_t = util::add_tag_t<AuxValue<I>, tag>;
+
+  auxiliary_data_t operator[] (std::size_t index) const
+    { return auxiliary_data_t(static_cast<int>(I * index)); }
+
+}; // struct AuxColl<>
+
+
+template <std::size_t... I>
+auto makeProxy(std::vector<int> const& data, std::index_sequence<I...>)
+  {
+    return proxy::CollectionProxy<std::vector<int>, AuxColl<I>...>
+      (data, AuxColl<I>()...);
+  }
+
+
+// -----------------------------------------------------------------------------
+template <typename Proxy, std::size_t... I>
+void checkAllTags(Proxy const& proxy, std::index_sequence<I...>) {
+
+  static_assert((Proxy::template has<AuxTag<I>>() && ...));
+  static_assert(!Proxy::template has<AuxTag<NAuxData>>());
+
+  std::size_t index = 0U;
+  for (auto const& element: proxy) {
+    std::size_t const nMatches = (
+      0U + ... +
+      ((element.template get<AuxTag<I>>().value == static_cast<int>(I * index))
+        ? 1U: 0U)
+      );
+    BOOST_CHECK_EQUAL(nMatches, NAuxData);
+    ++index;
+  } // for
+  BOOST_CHECK_EQUAL(index, proxy.size());
+
+} // checkAllTags()
+
+
+void tagLookupBenchmarkTest() {
+
+  std::vector<int> const data { 0, 1, 2, 3, 4 };
+
+  auto const proxy = makeProxy(data, std::make_index_sequence<NAuxData>());
+  checkAllTags(proxy, std::make_index_sequence<NAuxData>());
+
+} // tagLookupBenchmarkTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TagLookupBenchmarkTestCase) {
+  tagLookupBenchmarkTest();
+} // BOOST_AUTO_TEST_CASE(TagLookupBenchmarkTestCase)
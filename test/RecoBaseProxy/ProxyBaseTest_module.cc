@@ -93,6 +93,12 @@ class ProxyBaseTest : public art::EDAnalyzer {
   /// Tests proxy composition.
   void testProxyComposition(art::Event const& event) const;
 
+  /// Tests auxiliary data created on first access.
+  void testLazyData(art::Event const& event) const;
+
+  /// Tests the sharing of proxies via `proxy::ProxyCache`.
+  void testProxyCache(art::Event const& event) const;
+
   /// Performs the actual test.
   void testTracks(art::Event const& event) const;
 
@@ -310,6 +316,123 @@ void ProxyBaseTest::testProxyComposition(art::Event const& event) const {
 
 } // ProxyBaseTest::testProxyComposition()
 
+//------------------------------------------------------------------------------
+void ProxyBaseTest::testLazyData(art::Event const& event) const {
+
+  auto expectedTracksHandle
+    = event.getValidHandle<std::vector<recob::Track>>(tracksTag);
+  auto const& expectedTracks = *expectedTracksHandle;
+
+  art::FindManyP<recob::Hit> hitsPerTrack
+    (expectedTracksHandle, event, tracksTag);
+
+  auto const& expectedTrackFitHitInfo
+    = *(event.getValidHandle<std::vector<std::vector<recob::TrackFitHitInfo>>>
+    (tracksTag));
+
+  auto tracks = proxy::getCollection<std::vector<recob::Track>>(
+    event, tracksTag
+    , proxy::withLazy(proxy::withAssociated<recob::Hit>())
+    , proxy::withLazy
+      (proxy::withParallelData<std::vector<recob::TrackFitHitInfo>>())
+    );
+
+  // nothing is created until it's needed
+  BOOST_CHECK(!proxy::isAuxDataLoaded<recob::Hit>(tracks));
+  BOOST_CHECK(
+    !proxy::isAuxDataLoaded<std::vector<recob::TrackFitHitInfo>>(tracks)
+    );
+  BOOST_CHECK(proxy::loadedAuxDataTags(tracks).empty());
+
+  BOOST_CHECK_EQUAL(tracks.size(), expectedTracks.size());
+  if (tracks.empty()) return;
+
+  // elements do not create the data either
+  std::vector<decltype(tracks)::element_proxy_t> trackProxies
+    (tracks.begin(), tracks.end());
+  BOOST_CHECK(!proxy::isAuxDataLoaded<recob::Hit>(tracks));
+
+  std::size_t iExpectedTrack = 0;
+  for (auto const& trackProxy: trackProxies) {
+    auto const& expectedHits = hitsPerTrack.at(iExpectedTrack);
+
+    auto const& hits = trackProxy.get<recob::Hit>();
+    BOOST_CHECK_EQUAL(hits.size(), expectedHits.size());
+    std::size_t iExpectedHit = 0;
+    for (auto const& hitPtr: hits) {
+      BOOST_CHECK_EQUAL(hitPtr, expectedHits.at(iExpectedHit));
+      ++iExpectedHit;
+    } // for hits
+    BOOST_CHECK_EQUAL(iExpectedHit, expectedHits.size());
+
+    ++iExpectedTrack;
+  } // for
+  BOOST_CHECK_EQUAL(iExpectedTrack, expectedTracks.size());
+
+  BOOST_CHECK(proxy::isAuxDataLoaded<recob::Hit>(tracks));
+  BOOST_CHECK(
+    !proxy::isAuxDataLoaded<std::vector<recob::TrackFitHitInfo>>(tracks)
+    );
+  BOOST_CHECK_EQUAL(proxy::loadedAuxDataTags(tracks).size(), 1U);
+
+  // the first use of the other data creates it
+  BOOST_CHECK_EQUAL(
+    std::addressof(
+      trackProxies.back().get<std::vector<recob::TrackFitHitInfo>>()
+      ),
+    std::addressof(expectedTrackFitHitInfo.back())
+    );
+  BOOST_CHECK(
+    proxy::isAuxDataLoaded<std::vector<recob::TrackFitHitInfo>>(tracks)
+    );
+  BOOST_CHECK_EQUAL(proxy::loadedAuxDataTags(tracks).size(), 2U);
+
+} // ProxyBaseTest::testLazyData()
+
+
+//------------------------------------------------------------------------------
+void ProxyBaseTest::testProxyCache(art::Event const& event) const {
+
+  auto const& expectedTracks
+    = *(event.getValidHandle<std::vector<recob::Track>>(tracksTag));
+
+  proxy::ProxyCache cache;
+
+  auto tracks = cache.getCollection<std::vector<recob::Track>>(
+    event, tracksTag
+    , proxy::withAssociated<recob::Hit>(tracksTag)
+    );
+  BOOST_CHECK_EQUAL(tracks->size(), expectedTracks.size());
+  BOOST_CHECK_EQUAL(cache.nMisses(), 1U);
+  BOOST_CHECK_EQUAL(cache.nHits(), 0U);
+
+  // same request: same proxy
+  auto sameTracks = cache.getCollection<std::vector<recob::Track>>(
+    event, tracksTag
+    , proxy::withAssociated<recob::Hit>(tracksTag)
+    );
+  BOOST_CHECK_EQUAL(sameTracks.get(), tracks.get());
+  BOOST_CHECK_EQUAL(cache.nMisses(), 1U);
+  BOOST_CHECK_EQUAL(cache.nHits(), 1U);
+
+  // different auxiliary data: different proxy
+  auto otherTracks = cache.getCollection<std::vector<recob::Track>>(
+    event, tracksTag
+    , proxy::withParallelData<std::vector<recob::TrackFitHitInfo>>()
+    );
+  BOOST_CHECK_EQUAL(otherTracks->size(), expectedTracks.size());
+  BOOST_CHECK_EQUAL(cache.nMisses(), 2U);
+  BOOST_CHECK_EQUAL(cache.size(), 2U);
+
+  cache.clearEvent(event.id());
+  BOOST_CHECK_EQUAL(cache.size(), 0U);
+
+  // the proxies handed out are still alive
+  BOOST_CHECK_EQUAL(tracks->size(), expectedTracks.size());
+
+} // ProxyBaseTest::testProxyCache()
+
+
 //------------------------------------------------------------------------------
 void ProxyBaseTest::testTracks(art::Event const& event) const {
 
@@ -640,6 +763,12 @@ void ProxyBaseTest::analyze(art::Event const& event) {
   // test proxy composition
   testProxyComposition(event);
 
+  // test auxiliary data created on demand
+  testLazyData(event);
+
+  // test proxy sharing
+  testProxyCache(event);
+
   // "test" that track proxies survive their collection (part II)
   mf::LogVerbatim("ProxyBaseTest")
     << longTracks.size() << " tracks are longer than " << minLength << " cm:";
@@ -0,0 +1,311 @@
+/**
+ * @file   TrackProxyBenchmark_module.cc
+ * @brief  Compares the cost of track proxies and of `art::FindManyP` loops
+ * @date   October 14, 2026
+ * @see    lardata/RecoBaseProxy/Track.h, benchmark_trackproxy.fcl
+ */
+
+// LArSoft libraries
+#include "lardata/ArtDataHelper/Benchmarks/BenchmarkSummary.h"
+#include "lardata/RecoBaseProxy/Track.h" // proxy namespace
+#include "lardata/Utilities/FindManyInChainP.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/TrackTrajectory.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/TrackHitMeta.h"
+
+// framework libraries
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+#include "canvas/Utilities/InputTag.h"
+
+// utility libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+
+// C/C++ standard libraries
+#include <iomanip> // std::setprecision()
+#include <optional>
+#include <string>
+#include <utility> // std::declval()
+#include <vector>
+
+
+namespace lar {
+  namespace test {
+
+    // -------------------------------------------------------------------------
+    /**
+     * @brief Measures the access to the hits of tracks, in different ways.
+     *
+     * On each event, the hits of all the input tracks are read with:
+     * * `proxy::Tracks`: `proxy::getCollection<proxy::Tracks>()`, whose hits
+     *   are always associated;
+     * * `withAssociated`: `proxy::getCollection<std::vector<recob::Track>>()`
+     *   with `proxy::withAssociated<recob::Hit>()`;
+     * * `FindManyP`: a plain `art::FindManyP<recob::Hit>` on the tracks;
+     * * `FindManyInChainP`: `lar::FindManyInChainP`, following the chain
+     *   from the tracks to their `recob::TrackTrajectory` and to its hits.
+     *
+     * For each of them, two sections are measured: `construction`, when the
+     * proxy or the query object is created, and `traversal`, when all the hits
+     * of all the tracks are read. All the items are hits.
+     * At the end of the job, besides the usual benchmark summary, the cost of
+     * each section per track and per hit is printed.
+     *
+     * The test data of `TrackProxyHitMaker` and `TrackProxyTrackMaker`
+     * (with `repeatHitsPerTrack`) allows events of any size; see
+     * `benchmark_trackproxy.fcl`.
+     *
+     * Configuration parameters
+     * =========================
+     *
+     * * *tracks* (input tag, mandatory): the `recob::Track` collection, with
+     *   its associations to hits and to trajectories, and the associations of
+     *   the trajectories to hits
+     * * *logEvents* (boolean, default: false): also log each event
+     *
+     * The events are processed one at a time, so that the measurements of
+     * different events do not overlap.
+     */
+    class TrackProxyBenchmark: public art::SharedAnalyzer {
+        public:
+
+      struct Config {
+        using Name = fhicl::Name;
+        using Comment = fhicl::Comment;
+
+        fhicl::Atom<art::InputTag> tracks{
+          Name("tracks"),
+          Comment("tag of the recob::Track data product to read")
+          };
+
+        fhicl::Atom<bool> logEvents{
+          Name("logEvents"),
+          Comment("whether to log the measurements of each event"),
+          false
+          };
+
+      }; // struct Config
+
+      using Parameters = art::SharedAnalyzer::Table<Config>;
+
+      TrackProxyBenchmark
+        (Parameters const& config, art::ProcessingFrame const&);
+
+      virtual void analyze
+        (art::Event const& event, art::ProcessingFrame const&) override;
+
+      virtual void endJob(art::ProcessingFrame const&) override;
+
+        private:
+      art::InputTag fTracksTag; ///< input tracks
+      bool fLogEvents; ///< whether to log each event
+
+      unsigned long long fNTracks = 0U; ///< tracks processed in all events
+      double fChecksum = 0.; ///< sum of the read values, keeps them alive
+
+      lar::bench::BenchmarkSummary fSummary; ///< collected measurements
+
+      /// Returns the sum of the integrals of the hits, counting them
+      template <typename Hits>
+      double sumHits(Hits const& hits, std::size_t& nHits) const;
+
+    }; // class TrackProxyBenchmark
+
+    // -------------------------------------------------------------------------
+
+  } // namespace test
+} // namespace lar
+
+
+//------------------------------------------------------------------------------
+lar::test::TrackProxyBenchmark::TrackProxyBenchmark
+  (Parameters const& config, art::ProcessingFrame const&)
+  : art::SharedAnalyzer(config)
+  , fTracksTag(config().tracks())
+  , fLogEvents(config().logEvents())
+  , fSummary("TrackProxyBenchmark", "hits")
+  {
+    serialize<art::InEvent>();
+  }
+
+
+//------------------------------------------------------------------------------
+void lar::test::TrackProxyBenchmark::analyze
+  (art::Event const& event, art::ProcessingFrame const&)
+{
+
+  using lar::bench::Measurement;
+
+  auto const tracksHandle
+    = event.getValidHandle<std::vector<recob::Track>>(fTracksTag);
+  fNTracks += tracksHandle->size();
+
+  // the other products are read once before the measurements,
+  // so that the first approach does not pay for reading them
+  event.getValidHandle<art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta>>
+    (fTracksTag);
+  event.getValidHandle<art::Assns<recob::Track, recob::TrackTrajectory>>
+    (fTracksTag);
+  event.getValidHandle<art::Assns<recob::TrackTrajectory, recob::Hit>>
+    (fTracksTag);
+
+  std::vector<std::pair<std::string, Measurement>> measurements;
+  auto measure = [this, &measurements](std::string name, auto&& func)
+    {
+      measurements.emplace_back
+        (name, fSummary.measure(name, std::forward<decltype(func)>(func)));
+    };
+
+  //
+  // proxy::Tracks
+  //
+  {
+    using TracksProxy_t = decltype(proxy::getCollection<proxy::Tracks>
+      (std::declval<art::Event const&>(), std::declval<art::InputTag>()));
+    std::optional<TracksProxy_t> tracks;
+
+    measure("proxy::Tracks construction", [&](){
+      tracks.emplace(proxy::getCollection<proxy::Tracks>(event, fTracksTag));
+      std::size_t nHits = 0U;
+      for (auto const& track: *tracks) nHits += track.nHits();
+      return nHits;
+    });
+
+    measure("proxy::Tracks traversal", [&](){
+      std::size_t nHits = 0U;
+      for (auto const& track: *tracks) fChecksum += sumHits(track.hits(), nHits);
+      return nHits;
+    });
+  }
+
+  //
+  // withAssociated<recob::Hit>()
+  //
+  {
+    using TracksProxy_t
+      = decltype(proxy::getCollection<std::vector<recob::Track>>(
+        std::declval<art::Event const&>(), std::declval<art::InputTag>(),
+        proxy::withAssociated<recob::Hit>()
+      ));
+    std::optional<TracksProxy_t> tracks;
+
+    measure("withAssociated construction", [&](){
+      tracks.emplace(proxy::getCollection<std::vector<recob::Track>>
+        (event, fTracksTag, proxy::withAssociated<recob::Hit>()));
+      std::size_t nHits = 0U;
+      for (auto const& track: *tracks) nHits += track.get<recob::Hit>().size();
+      return nHits;
+    });
+
+    measure("withAssociated traversal", [&](){
+      std::size_t nHits = 0U;
+      for (auto const& track: *tracks)
+        fChecksum += sumHits(track.get<recob::Hit>(), nHits);
+      return nHits;
+    });
+  }
+
+  //
+  // art::FindManyP
+  //
+  {
+    std::optional<art::FindManyP<recob::Hit>> trackHits;
+
+    measure("FindManyP construction", [&](){
+      trackHits.emplace(tracksHandle, event, fTracksTag);
+      std::size_t nHits = 0U;
+      for (std::size_t i = 0; i < trackHits->size(); ++i)
+        nHits += trackHits->at(i).size();
+      return nHits;
+    });
+
+    measure("FindManyP traversal", [&](){
+      std::size_t nHits = 0U;
+      for (std::size_t i = 0; i < trackHits->size(); ++i)
+        fChecksum += sumHits(trackHits->at(i), nHits);
+      return nHits;
+    });
+  }
+
+  //
+  // lar::FindManyInChainP
+  //
+  {
+    using Finder_t = lar::FindManyInChainP<recob::Hit, recob::TrackTrajectory>;
+    std::vector<Finder_t::TargetPtrCollection_t> trackHits;
+
+    measure("FindManyInChainP construction", [&](){
+      trackHits = Finder_t::find(tracksHandle, event, fTracksTag, fTracksTag);
+      std::size_t nHits = 0U;
+      for (auto const& hits: trackHits) nHits += hits.size();
+      return nHits;
+    });
+
+    measure("FindManyInChainP traversal", [&](){
+      std::size_t nHits = 0U;
+      for (auto const& hits: trackHits) fChecksum += sumHits(hits, nHits);
+      return nHits;
+    });
+  }
+
+  if (fLogEvents) {
+    mf::LogInfo log("TrackProxyBenchmark");
+    log << event.id() << " (" << tracksHandle->size() << " tracks)";
+    for (auto const& [ name, measurement ]: measurements)
+      log << "\n  [" << name << "] " << measurement;
+  } // if log
+
+} // lar::test::TrackProxyBenchmark::analyze()
+
+
+//------------------------------------------------------------------------------
+void lar::test::TrackProxyBenchmark::endJob(art::ProcessingFrame const&) {
+
+  mf::LogInfo log("TrackProxyBenchmark");
+  log << fSummary;
+
+  // all sections process all the hits of the same tracks in each event
+  log << "\nCost per element (" << fNTracks << " tracks):";
+  for (std::string const section: {
+    "proxy::Tracks construction", "proxy::Tracks traversal",
+    "withAssociated construction", "withAssociated traversal",
+    "FindManyP construction", "FindManyP traversal",
+    "FindManyInChainP construction", "FindManyInChainP traversal"
+  }) {
+    auto const* stats = fSummary.section(section);
+    if (!stats) continue;
+    double const ns = stats->seconds.Sum() * 1e9;
+    log << "\n  " << section << ": " << std::fixed << std::setprecision(1);
+    if (fNTracks > 0U) log << (ns / fNTracks) << " ns/track";
+    if (stats->items > 0U) log << ", " << (ns / stats->items) << " ns/hit";
+  } // for sections
+
+  log << "\n(checksum: " << fChecksum << ")";
+
+} // lar::test::TrackProxyBenchmark::endJob()
+
+
+//------------------------------------------------------------------------------
+template <typename Hits>
+double lar::test::TrackProxyBenchmark::sumHits
+  (Hits const& hits, std::size_t& nHits) const
+{
+  double sum = 0.;
+  for (art::Ptr<recob::Hit> const& hit: hits) {
+    ++nHits;
+    if (hit.isNull()) continue;
+    sum += hit->Integral();
+  }
+  return sum;
+} // lar::test::TrackProxyBenchmark::sumHits()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(lar::test::TrackProxyBenchmark)
@@ -38,6 +38,7 @@
 #include <initializer_list>
 #include <memory> // std::unique_ptr<>
 #include <cstring> // std::strlen(), std::strcpy()
+#include <type_traits> // std::decay_t<>
 
 
 //------------------------------------------------------------------------------
@@ -208,6 +209,7 @@ void TrackProxyTest::testTracks(art::Event const& event) {
     , proxy::withAssociatedAs<recob::Hit, tag::SpecialHits>()
     , proxy::withFitHitInfo()
     , proxy::withOriginalTrajectory()
+    , proxy::withHitMetadata()
     );
 
   //
@@ -270,6 +272,20 @@ void TrackProxyTest::testTracks(art::Event const& event) {
     BOOST_CHECK_EQUAL
       (trackProxy.get<tag::SpecialHits>().size(), expectedHits.size());
 
+    // hits with metadata
+    static_assert(trackProxy.hasHitMetadata(), "Hit metadata not found!!!");
+    auto const& hitsWithMeta = trackProxy.hitsWithMetadata();
+    BOOST_CHECK_EQUAL(hitsWithMeta.size(), expectedHits.size());
+    auto const& metaHitPtrs = hitsWithMeta.hitPtrs();
+    auto const& metaHits = hitsWithMeta.hits();
+    auto const& hitMetadata = hitsWithMeta.metadata();
+    for (std::size_t iHit = 0; iHit < hitsWithMeta.size(); ++iHit) {
+      BOOST_CHECK_EQUAL(metaHitPtrs[iHit], expectedHits[iHit]);
+      BOOST_CHECK_EQUAL(metaHits[iHit], expectedHits[iHit].get());
+      BOOST_CHECK_EQUAL(hitMetadata[iHit]->Index(), iHit);
+      BOOST_CHECK_EQUAL(hitMetadata[iHit]->Dx(), 2.0 * iHit);
+    } // for
+
     // trajectory?
     BOOST_CHECK_EQUAL
       (trackProxy.hasOriginalTrajectory(), !expectedTrajPtr.isNull());
@@ -295,6 +311,17 @@ void TrackProxyTest::testTracks(art::Event const& event) {
     std::array<unsigned int, recob::TrajectoryPointFlagTraits::maxFlags()>
       flagCounts;
     flagCounts.fill(0U);
+
+    // bulk point interface
+    auto const& positions = trackProxy.positions();
+    auto const& momenta = trackProxy.momenta();
+    auto const& pointFlags = trackProxy.flags();
+    auto const hitKeys = trackProxy.hitKeys();
+    BOOST_CHECK_EQUAL(positions.size(), expectedTrack.NPoints());
+    BOOST_CHECK_EQUAL(momenta.size(), expectedTrack.NPoints());
+    BOOST_CHECK_EQUAL(pointFlags.size(), expectedTrack.NPoints());
+    BOOST_CHECK_EQUAL(hitKeys.size(), trackProxy.nHits());
+
     std::size_t iPoint = 0;
     for (auto const& pointInfo: trackProxy.points()) {
       BOOST_TEST_CHECKPOINT("  point #" << pointInfo.index());
@@ -316,6 +343,13 @@ void TrackProxyTest::testTracks(art::Event const& event) {
       else {
         BOOST_CHECK(!pointInfo.hitPtr());
       }
+      BOOST_CHECK_EQUAL(&positions[iPoint], &pointInfo.position());
+      BOOST_CHECK_EQUAL(&momenta[iPoint], &pointInfo.momentum());
+      BOOST_CHECK_EQUAL(pointFlags[iPoint], expectedPointFlags);
+      BOOST_CHECK_EQUAL(hitKeys[iPoint], pointInfo.hitPtr().isNull()
+        ? std::decay_t<decltype(trackProxy)>::InvalidHitKey
+        : pointInfo.hitPtr().key()
+        );
 
       // collect the count of each flag type
       for (auto flag: {
@@ -342,6 +376,27 @@ void TrackProxyTest::testTracks(art::Event const& event) {
     } // for
     BOOST_CHECK_EQUAL(iPoint, expectedTrack.NPoints());
 
+    // field-selective point interface
+    iPoint = 0;
+    for (auto const& pointInfo: trackProxy.points<proxy::TrackPointPosition>())
+    {
+      BOOST_CHECK_EQUAL(pointInfo.index(), iPoint);
+      BOOST_CHECK_EQUAL(&pointInfo.position(), &positions[iPoint]);
+      ++iPoint;
+    } // for
+    BOOST_CHECK_EQUAL(iPoint, expectedTrack.NPoints());
+
+    auto const hitPoints = trackProxy.points
+      <proxy::TrackPointFlags, proxy::TrackPointHit>();
+    BOOST_CHECK_EQUAL(hitPoints.size(), expectedTrack.NPoints());
+    for (auto const& pointInfo: hitPoints) {
+      BOOST_TEST_CHECKPOINT("  point #" << pointInfo.index());
+      auto const& fullInfo = trackProxy.point(pointInfo.index());
+      BOOST_CHECK_EQUAL(pointInfo.flags(), fullInfo.flags());
+      BOOST_CHECK_EQUAL(pointInfo.hit(), fullInfo.hit());
+      BOOST_CHECK_EQUAL(pointInfo.hitPtr(), fullInfo.hitPtr());
+    } // for
+
     // testing pointsWithFlags() with some single flags
     for (auto flag: {
       recob::TrajectoryPointFlags::flag::NoPoint,
@@ -53,6 +53,10 @@ namespace lar {
     *     for each produced track. If there are hits left after all the tracks
     *     specified here have been created, an additional track with all those
     *     hits is created. If there are not enough hits, an exception is thrown.
+    * * *repeatHitsPerTrack* (boolean, default: false): if set, the tracks are
+    *     created cycling through `hitsPerTrack` until all the hits are used
+    *     (the last track may have fewer hits); this allows large events, e.g.
+    *     100000 tracks of 10 hits with `hitsPerTrack: [ 10 ]`
     *
     */
     class TrackProxyTrackMaker: public art::EDProducer {
@@ -72,6 +76,12 @@ namespace lar {
           Comment("number of hits per track; last takes all remaining ones.")
           };
 
+        fhicl::Atom<bool> repeatHitsPerTrack{
+          Name("repeatHitsPerTrack"),
+          Comment("cycle through hitsPerTrack until all the hits are used"),
+          false
+          };
+
       }; // struct Config
 
       using Parameters = art::EDProducer::Table<Config>;
@@ -80,6 +90,8 @@ namespace lar {
         : EDProducer{config}
         , hitsTag(config().hitsTag())
         , hitsPerTrack(config().hitsPerTrack())
+        , repeatHitsPerTrack
+          (config().repeatHitsPerTrack() && !hitsPerTrack.empty())
         {
           produces<std::vector<recob::TrackTrajectory>>();
           produces<art::Assns<recob::TrackTrajectory, recob::Hit>>();
@@ -94,6 +106,7 @@ namespace lar {
         private:
       art::InputTag hitsTag; ///< Input hit collection label.
       std::vector<unsigned int> hitsPerTrack; ///< Hits per produced track.
+      bool repeatHitsPerTrack; ///< Whether to cycle through `hitsPerTrack`.
 
     };  // TrackProxyTrackMaker
 
@@ -128,7 +141,12 @@ void lar::test::TrackProxyTrackMaker::produce(art::Event& event) {
   while (usedHits < hits.size()) {
 
     // how many hits for this track:
-    unsigned int const nTrackHits = (iTrack < hitsPerTrack.size())
+    unsigned int const nTrackHits = repeatHitsPerTrack
+      ? std::min(
+        hitsPerTrack[iTrack % hitsPerTrack.size()],
+        (unsigned int)(hits.size() - usedHits)
+        )
+      : (iTrack < hitsPerTrack.size())
       ? std::min(hitsPerTrack[iTrack], (unsigned int)(hits.size() - usedHits))
       : (hits.size() - usedHits)
       ;
@@ -177,7 +195,7 @@ void lar::test::TrackProxyTrackMaker::produce(art::Event& event) {
         double(iPoint) * 1.5,              // aHitMeasErr2
         {},                                // aTrackStatePar
         { ROOT::Math::SMatrixIdentity{} }, // aTrackStateCov
-        hits[usedHits + iPoint].WireID()   // aWireId
+        hits[usedHits - 1].WireID()        // aWireId
         });
     } // for
 
@@ -224,9 +242,12 @@ void lar::test::TrackProxyTrackMaker::produce(art::Event& event) {
     //
     trackTrajectoryAssn->addSingle(trackPtr, trajPtr);
 
-    mf::LogVerbatim("TrackProxyTrackMaker")
-      << "New track #" << tracks->back().ID()
-      << " with " << nTrackHits << " hits";
+    // (not for each of the many tracks of a repeated pattern)
+    if (!repeatHitsPerTrack) {
+      mf::LogVerbatim("TrackProxyTrackMaker")
+        << "New track #" << tracks->back().ID()
+        << " with " << nTrackHits << " hits";
+    }
 
     //
     // prepare for the next track
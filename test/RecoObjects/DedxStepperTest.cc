@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE ( DedxStepperTest )
+#include "cetlib/quiet_unit_test.hpp"
+
+//
+// File: DedxStepperTest.cc
+//
+// Purpose: Unit test for the error-controlled energy loss integration
+//          (DedxStepper.h), with a simple model of the stopping power.
+//
+
+#include <cmath>
+#include "lardata/RecoObjects/DedxStepper.h"
+
+namespace {
+
+  // Stopping power (GeV/cm), 1/beta^2 dependence with a minimum
+  // ionizing value of 2.1 MeV/cm.
+  struct Stopping
+  {
+    double mass;
+    double operator()(double p) const {return 0.0021 * (1. + mass*mass/(p*p));}
+  };
+
+  // Reference integration, many midpoint steps.
+  double reference(const Stopping& dedx, double e1, double s)
+  {
+    const int n = 100000;
+    const double h = s / n;
+    double e = e1;
+    for(int i = 0; i < n; ++i) {
+      double emid = e - 0.5 * h * dedx(std::sqrt(e*e - dedx.mass*dedx.mass));
+      e -= h * dedx(std::sqrt(emid*emid - dedx.mass*dedx.mass));
+    }
+    return e;
+  }
+}
+
+// Minimum ionizing muon: one step is enough.
+
+BOOST_AUTO_TEST_CASE(Mip) {
+  Stopping dedx{0.1057};
+  const double e1 = std::hypot(2., dedx.mass);
+  double e2 = 0.;
+  unsigned long nsteps = 0;
+  BOOST_CHECK(trkf::integrateDedx(dedx, e1, dedx.mass, 50., 1.e-3, e2, nsteps));
+  BOOST_CHECK_EQUAL(nsteps, 1U);
+  BOOST_CHECK_CLOSE(e2, reference(dedx, e1, 50.), 1.e-3);
+  BOOST_CHECK_GT(trkf::dedxStepLength(dedx, e1, dedx.mass, 1.e-3, 50.), 50.);
+}
+
+// Slow proton: several steps, more for tighter tolerances, and an error
+// of the order of the tolerance (which applies to each step);
+// backward propagation recovers the initial energy.
+
+BOOST_AUTO_TEST_CASE(Proton) {
+  Stopping dedx{0.938};
+  const double e1 = std::hypot(0.4, dedx.mass);
+  const double s = 3.;
+  const double ref = reference(dedx, e1, s);
+  unsigned long previous = 0;
+  for(double tolerance : {1.e-2, 1.e-3, 1.e-4}) {
+    double e2 = 0.;
+    unsigned long nsteps = 0;
+    BOOST_CHECK(trkf::integrateDedx(dedx, e1, dedx.mass, s, tolerance, e2, nsteps));
+    BOOST_CHECK_GT(nsteps, previous);
+    BOOST_CHECK_LT(std::abs(e2 - ref), 2. * tolerance * (e1 - dedx.mass));
+    previous = nsteps;
+
+    double e3 = 0.;
+    BOOST_CHECK(trkf::integrateDedx(dedx, e2, dedx.mass, -s, tolerance, e3, nsteps));
+    BOOST_CHECK_LT(std::abs(e3 - e1), 4. * tolerance * (e1 - dedx.mass));
+  }
+
+  // The proton stops before 100 cm.
+
+  double e2 = 0.;
+  unsigned long nsteps = 0;
+  BOOST_CHECK(!trkf::integrateDedx(dedx, e1, dedx.mass, 100., 1.e-3, e2, nsteps));
+}
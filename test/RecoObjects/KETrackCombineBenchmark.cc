@@ -0,0 +1,157 @@
+//
+// File: KETrackCombineBenchmark.cc
+//
+// Purpose: Timing of KETrack::combineTrack (the two-track combination of
+//          the Kalman smoother), compared with the same combination done
+//          with ublas products, as it used to be implemented.  Also checks
+//          that the two give the same result.
+//
+// Usage: KETrackCombineBenchmark [combinations]
+//
+// The default number of combinations is short enough to serve as a test.
+//
+
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "lardata/RecoObjects/KETrack.h"
+#include "lardata/RecoObjects/SurfYZPlane.h"
+
+namespace {
+
+  // Reference combination with ublas products (former implementation
+  // of KETrack::combineTrack, without the swap of the better measured track).
+
+  bool referenceCombine(trkf::TrackVector& vec1, trkf::TrackError& err1,
+			const trkf::TrackVector& vec2, const trkf::TrackError& err2,
+			double& chisq)
+  {
+    trkf::TrackVector dvec = vec1 - vec2;
+    trkf::TrackError derr = err1 + err2;
+    if(!trkf::syminvert(derr))
+      return false;
+    trkf::TrackVector tvec1 = prod(derr, dvec);
+    trkf::TrackVector tvec2 = prod(err1, tvec1);
+    trkf::TrackVector tvec3 = vec1 - tvec2;
+    trkf::TrackMatrix terr1 = prod(derr, err1);
+    trkf::TrackMatrix terr2 = prod(err1, terr1);
+    trkf::TrackError terr2s = trkf::ublas::symmetric_adaptor<trkf::TrackMatrix>(terr2);
+    trkf::TrackError terr3 = err1 - terr2s;
+    trkf::TrackVector dvec1 = prod(derr, dvec);
+    chisq = inner_prod(dvec, dvec1);
+    vec1 = tvec3;
+    err1 = terr3;
+    return true;
+  }
+
+  // Pseudo-random track state with positive definite error matrix.
+
+  struct State
+  {
+    trkf::TrackVector vec;
+    trkf::TrackError err;
+  };
+
+  State makeState(unsigned int& seed, double scale)
+  {
+    auto rnd = [&seed](){ seed = seed*1103515245U + 12345U; return ((seed >> 16) % 1000)/500. - 1.; };
+    State state { trkf::TrackVector(5), trkf::TrackError(5) };
+    trkf::TrackMatrix a(5, 5);
+    for(unsigned int i = 0; i < 5; ++i) {
+      state.vec(i) = 0.1 * rnd();
+      for(unsigned int j = 0; j < 5; ++j)
+	a(i, j) = rnd();
+    }
+    trkf::TrackMatrix aat = prod(a, trans(a));
+    for(unsigned int i = 0; i < 5; ++i) {
+      for(unsigned int j = 0; j <= i; ++j)
+	state.err(i, j) = scale * (aat(i, j) + (i == j ? 1. : 0.));
+    }
+    return state;
+  }
+
+}
+
+int main(int argc, char** argv)
+{
+  // Make sure assert is enabled.
+
+  bool assert_flag = false;
+  assert((assert_flag = true, assert_flag));
+  if ( ! assert_flag ) {
+    std::cerr << "Assert is disabled" << std::endl;
+    return 1;
+  }
+
+  unsigned int const nComb = (argc > 1)? std::atoi(argv[1]): 20000;
+
+  // Pairs of states to combine; the first one is the better measured one.
+
+  unsigned int seed = 12345;
+  std::vector<State> states1, states2;
+  for(unsigned int i = 0; i < 100; ++i) {
+    states1.push_back(makeState(seed, 0.01));
+    states2.push_back(makeState(seed, 1.));
+  }
+  std::shared_ptr<const trkf::Surface> psurf(new trkf::SurfYZPlane(0., 0., 0., 0.));
+
+  // Check that the two implementations agree.
+
+  for(unsigned int i = 0; i < states1.size(); ++i) {
+    trkf::KETrack tre1(psurf, states1[i].vec, states1[i].err, trkf::Surface::FORWARD);
+    trkf::KETrack tre2(psurf, states2[i].vec, states2[i].err, trkf::Surface::FORWARD);
+    boost::optional<double> chisq = tre1.combineTrack(tre2);
+    assert(!!chisq);
+
+    State ref = states1[i];
+    double refChisq = 0.;
+    bool ok = referenceCombine(ref.vec, ref.err, states2[i].vec, states2[i].err, refChisq);
+    assert(ok);
+    assert(std::abs(*chisq - refChisq) <= 1.e-9 * std::max(1., refChisq));
+    for(unsigned int j = 0; j < 5; ++j) {
+      assert(std::abs(tre1.getVector()(j) - ref.vec(j)) <= 1.e-9);
+      for(unsigned int k = 0; k <= j; ++k)
+	assert(std::abs(tre1.getError()(j, k) - ref.err(j, k)) <= 1.e-9 * std::abs(ref.err(j, j)));
+    }
+  }
+
+  // Timing.
+
+  double sum = 0.;
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i < nComb; ++i) {
+    State s = states1[i % states1.size()];
+    double chisq = 0.;
+    referenceCombine(s.vec, s.err, states2[i % states2.size()].vec,
+		     states2[i % states2.size()].err, chisq);
+    sum += chisq;
+  }
+  std::chrono::duration<double> refTime = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i < nComb; ++i) {
+    State const& s1 = states1[i % states1.size()];
+    State const& s2 = states2[i % states2.size()];
+    trkf::KETrack tre1(psurf, s1.vec, s1.err, trkf::Surface::FORWARD);
+    trkf::KETrack tre2(psurf, s2.vec, s2.err, trkf::Surface::FORWARD);
+    boost::optional<double> chisq = tre1.combineTrack(tre2);
+    sum -= *chisq;
+  }
+  std::chrono::duration<double> newTime = std::chrono::steady_clock::now() - start;
+
+  std::cout << "KETrackCombineBenchmark: " << nComb << " combinations"
+	    << "\n  ublas products:        " << (refTime.count() / nComb * 1.e9) << " ns/combination"
+	    << "\n  KETrack::combineTrack: " << (newTime.count() / nComb * 1.e9) << " ns/combination"
+	    << " (including track construction)"
+	    << "\n  (chisquare difference: " << sum << ")" << std::endl;
+
+  // Done (success).
+
+  std::cout << "KETrackCombineBenchmark: All tests passed." << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,330 @@
+//
+// File: KFitReplay.cc
+//
+// Purpose: Replay of recorded Kalman fit inputs (KFitRecord) outside
+//          art, for profiling and regression tests.  Each record is
+//          fitted with a simple forward filter: the measurement groups
+//          are visited in order of path distance from the track (with
+//          KHitContainer::sort, or KHitContainer::sortWindow), and the
+//          best measurement of each group within the chisquare cut is
+//          added.  Reports the throughput, and the largest differences
+//          between repeated replays and with respect to reference
+//          results.
+//
+// Usage: KFitReplay [-n repetitions] [-w window] [-d]
+//                   [-o results] [-r reference] [records]
+//
+//   -n  Number of replays of each record (default 10).
+//   -w  Resort only the next window groups after each step (default 0,
+//       full resort).
+//   -d  Propagate with dE/dx if recorded (needs the detector
+//       properties service, not available in this executable).
+//   -o  Write the fit results to file.
+//   -r  Compare the fit results with the results in file.
+//
+// Without records file, synthetic records are made, and the test also
+// checks that they are unchanged by writing and reading them back.
+//
+
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "lardata/RecoObjects/KFitRecord.h"
+#include "lardata/RecoObjects/PropYZPlane.h"
+#include "lardata/RecoObjects/SurfYZPlane.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // Container of replayed measurements (filled by KFitRecord).
+
+  class ReplayContainer : public trkf::KHitContainer
+  {
+  public:
+    void fill(const art::PtrVector<recob::Hit>&, int) override
+    {
+      throw cet::exception("KFitReplay") << "Fill from hits not supported.\n";
+    }
+  };
+
+  // Result of one fit.
+
+  struct Result
+  {
+    trkf::KETrack track;
+    double chisq = 0.;
+    int nhits = 0;
+  };
+
+  // Forward filter.
+
+  Result replayFit(const trkf::KFitRecord& rec, const trkf::Propagator& prop,
+		   unsigned int window)
+  {
+    const double maxChisq = 12.;
+
+    ReplayContainer cont;
+    rec.fillContainer(cont);
+    Result result;
+    result.track = rec.getSeed();
+    cont.sort(result.track, true, &prop, trkf::Propagator::FORWARD);
+    while(!cont.getSorted().empty()) {
+      trkf::KHitGroup& gr = cont.getSorted().front();
+      trkf::KETrack tre = result.track;
+      if(prop.noise_prop(tre, gr.getSurface(), trkf::Propagator::FORWARD, true)) {
+	std::shared_ptr<const trkf::KHitBase> best;
+	double bestChisq = maxChisq;
+	for(const std::shared_ptr<const trkf::KHitBase>& phit : gr.getHits()) {
+	  if(phit->predict(tre, &prop) && phit->getChisq() < bestChisq) {
+	    best = phit;
+	    bestChisq = phit->getChisq();
+	  }
+	}
+	if(best) {
+	  best->update(tre);
+	  result.track = tre;
+	  result.chisq += bestChisq;
+	  ++result.nhits;
+	}
+      }
+      cont.getUnused().splice(cont.getUnused().end(), cont.getSorted(), cont.getSorted().begin());
+      if(window > 0)
+	cont.sortWindow(result.track, window, &prop, trkf::Propagator::FORWARD);
+      else
+	cont.sort(result.track, false, &prop, trkf::Propagator::FORWARD);
+    }
+    return result;
+  }
+
+  // Largest difference between two sets of results.
+
+  double maxDifference(const std::vector<Result>& res1, const std::vector<Result>& res2)
+  {
+    if(res1.size() != res2.size())
+      return HUGE_VAL;
+    double diff = 0.;
+    for(unsigned int i = 0; i < res1.size(); ++i) {
+      if(res1[i].nhits != res2[i].nhits)
+	return HUGE_VAL;
+      diff = std::max(diff, std::abs(res1[i].chisq - res2[i].chisq));
+      for(unsigned int j = 0; j < 5; ++j)
+	diff = std::max(diff, std::abs(res1[i].track.getVector()(j) - res2[i].track.getVector()(j)));
+    }
+    return diff;
+  }
+
+  void writeResults(const std::string& name, const std::vector<Result>& results)
+  {
+    std::ofstream out(name, std::ios::binary);
+    for(const Result& result : results) {
+      trkf::KFitRecord::writeTrack(out, result.track);
+      out.write(reinterpret_cast<const char*>(&result.chisq), sizeof(result.chisq));
+      std::int32_t nhits = result.nhits;
+      out.write(reinterpret_cast<const char*>(&nhits), sizeof(nhits));
+    }
+  }
+
+  std::vector<Result> readResults(const std::string& name)
+  {
+    std::ifstream in(name, std::ios::binary);
+    if(!in)
+      throw cet::exception("KFitReplay") << "Can not open " << name << ".\n";
+    std::vector<Result> results;
+    while(in.peek() != std::ifstream::traits_type::eof()) {
+      Result result;
+      result.track = trkf::KFitRecord::readTrack(in);
+      std::int32_t nhits = 0;
+      in.read(reinterpret_cast<char*>(&result.chisq), sizeof(result.chisq));
+      in.read(reinterpret_cast<char*>(&nhits), sizeof(nhits));
+      result.nhits = nhits;
+      results.push_back(result);
+    }
+    return results;
+  }
+
+  // Synthetic records: straight tracks through planes at three wire
+  // angles, one measurement per plane (plus a far away one every few
+  // planes).
+
+  std::vector<trkf::KFitRecord> makeRecords(unsigned int nrec, unsigned int nplanes)
+  {
+    unsigned int seed = 12345;
+    auto rnd = [&seed](){ seed = seed*1103515245U + 12345U; return ((seed >> 16) % 1000)/500. - 1.; };
+    trkf::PropYZPlane prop(0., false);
+    const double phis[3] = {0., 0.6, -0.6};
+
+    std::vector<trkf::KFitRecord> records;
+    for(unsigned int irec = 0; irec < nrec; ++irec) {
+      std::shared_ptr<const trkf::Surface> psurf0(new trkf::SurfYZPlane(0., 0., 0., 0.));
+      trkf::TrackVector vec(5);
+      vec(0) = 10. * rnd();
+      vec(1) = 10. * rnd();
+      vec(2) = 0.2 * rnd();
+      vec(3) = 0.2 * rnd();
+      vec(4) = 1.;
+      trkf::KTrack truth(psurf0, vec, trkf::Surface::FORWARD, 13);
+
+      trkf::KFitRecord rec;
+      rec.setPropagator(trkf::KFitRecord::PROPYZPLANE, 0., false);
+      for(unsigned int ipl = 0; ipl < nplanes; ++ipl) {
+	std::shared_ptr<const trkf::Surface> psurf(new trkf::SurfYZPlane(0., 0., 0.3*(ipl+1), phis[ipl%3]));
+	trkf::KTrack trk = truth;
+	if(!prop.vec_prop(trk, psurf, trkf::Propagator::FORWARD, false))
+	  continue;
+	trkf::KFitRecord::Group group{psurf, int(ipl%3), {}};
+	group.hits.push_back(std::make_shared<const trkf::KHitRecorded>
+			     (psurf, group.plane, trkf::KHitRecorded::WIREX, 0.3,
+			      trk.getVector()(0) + 0.05*rnd(), 0.05*0.05/3.));
+	if(ipl%5 == 0)
+	  group.hits.push_back(std::make_shared<const trkf::KHitRecorded>
+			       (psurf, group.plane, trkf::KHitRecorded::WIREX, 0.3,
+				trk.getVector()(0) + 5., 0.05*0.05/3.));
+	rec.addGroup(group);
+      }
+
+      trkf::TrackError err(5);
+      err.clear();
+      err(0, 0) = 1.;
+      err(1, 1) = 1.;
+      err(2, 2) = 0.01;
+      err(3, 3) = 0.01;
+      err(4, 4) = 0.1;
+      trkf::TrackVector seedvec = vec;
+      seedvec(0) += 0.1 * rnd();
+      seedvec(1) += 0.1 * rnd();
+      rec.setSeed(trkf::KETrack(psurf0, seedvec, err, trkf::Surface::FORWARD, 13));
+      records.push_back(rec);
+    }
+    return records;
+  }
+
+  // Replays all the records, returns the results of the last replay.
+
+  std::vector<Result> replayAll(const std::vector<trkf::KFitRecord>& records, bool useDedx,
+				unsigned int window, unsigned int nrep, double& seconds)
+  {
+    std::vector<std::unique_ptr<trkf::Propagator>> props;
+    for(const trkf::KFitRecord& rec : records)
+      props.push_back(rec.makePropagator(useDedx));
+    std::vector<Result> results(records.size());
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned int irep = 0; irep < nrep; ++irep) {
+      for(unsigned int i = 0; i < records.size(); ++i)
+	results[i] = replayFit(records[i], *props[i], window);
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    seconds = time.count();
+    return results;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  // Make sure assert is enabled.
+
+  bool assert_flag = false;
+  assert((assert_flag = true, assert_flag));
+  if ( ! assert_flag ) {
+    std::cerr << "Assert is disabled" << std::endl;
+    return 1;
+  }
+
+  unsigned int nrep = 10;
+  unsigned int window = 0;
+  bool useDedx = false;
+  std::string outname, refname, recname;
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if(arg == "-n" && i+1 < argc)
+      nrep = std::atoi(argv[++i]);
+    else if(arg == "-w" && i+1 < argc)
+      window = std::atoi(argv[++i]);
+    else if(arg == "-d")
+      useDedx = true;
+    else if(arg == "-o" && i+1 < argc)
+      outname = argv[++i];
+    else if(arg == "-r" && i+1 < argc)
+      refname = argv[++i];
+    else if(!arg.empty() && arg[0] != '-')
+      recname = arg;
+    else {
+      std::cerr << "Usage: KFitReplay [-n repetitions] [-w window] [-d]"
+		<< " [-o results] [-r reference] [records]" << std::endl;
+      return 1;
+    }
+  }
+
+  // Get the records.
+
+  std::vector<trkf::KFitRecord> records;
+  if(recname.empty()) {
+    records = makeRecords(100, 60);
+
+    // Check that the records survive serialization.
+
+    std::stringstream buf;
+    for(const trkf::KFitRecord& rec : records)
+      rec.write(buf);
+    std::vector<trkf::KFitRecord> copies;
+    trkf::KFitRecord rec;
+    while(rec.read(buf))
+      copies.push_back(rec);
+    assert(copies.size() == records.size());
+    double seconds = 0.;
+    std::vector<Result> res1 = replayAll(records, false, window, 1, seconds);
+    std::vector<Result> res2 = replayAll(copies, false, window, 1, seconds);
+    assert(maxDifference(res1, res2) == 0.);
+    for(const Result& result : res1)
+      assert(result.nhits >= 40);
+    records.swap(copies);
+  }
+  else {
+    std::ifstream in(recname, std::ios::binary);
+    if(!in) {
+      std::cerr << "KFitReplay: can not open " << recname << std::endl;
+      return 1;
+    }
+    trkf::KFitRecord rec;
+    while(rec.read(in))
+      records.push_back(rec);
+  }
+  unsigned int ndedx = 0;
+  for(const trkf::KFitRecord& rec : records)
+    ndedx += rec.getDoDedx();
+  if(ndedx > 0 && !useDedx)
+    std::cout << "KFitReplay: " << ndedx << " records with dE/dx replayed without dE/dx." << std::endl;
+
+  // Replay.
+
+  double firstSeconds = 0.;
+  std::vector<Result> first = replayAll(records, useDedx, window, 1, firstSeconds);
+  double seconds = 0.;
+  std::vector<Result> results = replayAll(records, useDedx, window, nrep, seconds);
+  double repdiff = maxDifference(first, results);
+
+  std::cout << "KFitReplay: " << records.size() << " records, " << nrep << " replays"
+	    << "\n  " << (records.size() * nrep / seconds) << " fits/s"
+	    << "\n  maximum difference between replays: " << repdiff << std::endl;
+  assert(repdiff == 0.);
+
+  if(!outname.empty())
+    writeResults(outname, results);
+  if(!refname.empty()) {
+    double refdiff = maxDifference(results, readResults(refname));
+    std::cout << "  maximum difference with reference: " << refdiff << std::endl;
+  }
+
+  // Done (success).
+
+  std::cout << "KFitReplay: All tests passed." << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+#define BOOST_TEST_MODULE ( KGTrackTest )
+#include "cetlib/quiet_unit_test.hpp"
+
+//
+// File: KGTrackTest.cc
+//
+// Purpose: Unit test for KGTrack.  Checks that the track collection
+//          is kept sorted by path distance, in the same order as a
+//          multimap, whichever way the tracks are added.
+//
+
+#include <memory>
+#include <vector>
+#include "lardata/RecoObjects/KGTrack.h"
+#include "lardata/RecoObjects/SurfXYZPlane.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // Measurement with a fixed prediction distance, identified by its id.
+
+  class TestHit : public trkf::KHitBase
+  {
+  public:
+    TestHit(const std::shared_ptr<const trkf::Surface>& psurf, double dist, int id) :
+      KHitBase(psurf)
+    {
+      fPredDist = dist;
+      fID = id;
+    }
+    bool predict(const trkf::KETrack&, const trkf::Propagator*,
+		 const trkf::KTrack*) const override {return true;}
+    double getChisq() const override {return 0.;}
+    void update(trkf::KETrack&) const override {}
+  };
+
+  // Make a valid KHitTrack at path distance s, with prediction distance dist.
+
+  trkf::KHitTrack makeTrack(double s, double dist, int id)
+  {
+    auto const psurf = std::make_shared<trkf::SurfXYZPlane>(0., 0., s, 0., 0.);
+    trkf::TrackVector vec(5);
+    vec.clear();
+    vec(4) = 1.;
+    trkf::TrackError err(5);
+    err.clear();
+    for(int i=0; i<5; ++i)
+      err(i, i) = 1.;
+    trkf::KETrack tre(psurf, vec, err, trkf::Surface::FORWARD, 13);
+    trkf::KFitTrack trf(tre, s, 0., trkf::KFitTrack::FORWARD);
+    return trkf::KHitTrack(trf, std::make_shared<TestHit>(psurf, dist, id));
+  }
+
+  std::vector<int> ids(const trkf::KGTrack& trg)
+  {
+    std::vector<int> result;
+    for(const auto& entry : trg.tracks())
+      result.push_back(entry.second.getHit()->getID());
+    return result;
+  }
+
+  // Tracks in the order they are found by the fit: distances 0, 3, 1, 3, 2.
+
+  std::vector<trkf::KHitTrack> fitOrder()
+  {
+    return { makeTrack(0., 0., 0), makeTrack(2., 1., 1), makeTrack(1., 0., 2),
+	     makeTrack(3., 0., 3), makeTrack(2., 0., 4) };
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Sorting) {
+
+  // Tracks with the same distance (1 and 3) stay in insertion order.
+
+  std::vector<int> const expected { 0, 2, 4, 1, 3 };
+
+  trkf::KGTrack trg(0);
+  BOOST_CHECK(!trg.isValid());
+  BOOST_CHECK_THROW(trg.startTrack(), cet::exception);
+  for(const auto& trh : fitOrder())
+    trg.addTrack(trh);
+  std::vector<int> const oneByOne = ids(trg);
+  BOOST_CHECK_EQUAL_COLLECTIONS(oneByOne.begin(), oneByOne.end(),
+				expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(trg.numHits(), 5U);
+  BOOST_CHECK_EQUAL(trg.startTrack().getHit()->getID(), 0);
+  BOOST_CHECK_EQUAL(trg.endTrack().getHit()->getID(), 3);
+  BOOST_CHECK_EQUAL(trg.getTrackMap().front().first, 0.);
+  BOOST_CHECK_EQUAL(trg.getTrackMap().back().first, 3.);
+
+  // Same result adding all the tracks at once, or in two steps.
+
+  trkf::KGTrack trgAll(0);
+  trgAll.addTracks(fitOrder());
+  std::vector<int> const all = ids(trgAll);
+  BOOST_CHECK_EQUAL_COLLECTIONS(all.begin(), all.end(),
+				expected.begin(), expected.end());
+
+  std::vector<trkf::KHitTrack> const tracks = fitOrder();
+  trkf::KGTrack trgSteps(0);
+  trgSteps.reserve(tracks.size());
+  trgSteps.addTracks({ tracks[0], tracks[1] });
+  trgSteps.addTracks({ tracks[2], tracks[3], tracks[4] });
+  std::vector<int> const steps = ids(trgSteps);
+  BOOST_CHECK_EQUAL_COLLECTIONS(steps.begin(), steps.end(),
+				expected.begin(), expected.end());
+
+  // Invalid tracks are rejected.
+
+  BOOST_CHECK_THROW(trg.addTrack(trkf::KHitTrack()), cet::exception);
+  BOOST_CHECK_THROW(trg.addTracks({ trkf::KHitTrack() }), cet::exception);
+  BOOST_CHECK_EQUAL(trg.numHits(), 5U);
+}
+
+BOOST_AUTO_TEST_CASE(Recalibrate) {
+
+  // After recalibration, tracks are sorted by their own path distance,
+  // starting from zero.
+
+  trkf::KGTrack trg(0);
+  trg.addTrack(makeTrack(5., 0., 0));
+  trg.addTrack(makeTrack(6., 2., 1));
+  trg.addTrack(makeTrack(7., 0., 2));
+  trg.recalibrate();
+
+  std::vector<int> const expected { 0, 1, 2 };
+  std::vector<int> const result = ids(trg);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(),
+				expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(trg.getTrackMap()[1].first, 1.);
+  BOOST_CHECK_EQUAL(trg.getTrackMap()[1].second.getPath(), 1.);
+  BOOST_CHECK_EQUAL(trg.endTrack().getPath(), 2.);
+}
@@ -0,0 +1,118 @@
+#define BOOST_TEST_MODULE ( KHitContainerRefillTest )
+#include "cetlib/quiet_unit_test.hpp"
+
+//
+// File: KHitContainerRefillTest.cc
+//
+// Purpose: Unit test for KHitContainer::refill.  Checks that refilling
+//          with the same hits reuses the KHitGroup objects, moved back
+//          to the unsorted list, and that any change of the hits, of
+//          the plane or of the content makes new objects.
+//
+
+#include <set>
+#include "lardata/RecoObjects/KHitContainer.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+
+namespace {
+
+  // Container making one empty KHitGroup per hit, counting the fills.
+
+  class CountingContainer : public trkf::KHitContainer
+  {
+  public:
+    void fill(const art::PtrVector<recob::Hit>& hits, int /* only_plane */) override
+    {
+      ++nFill;
+      for(std::size_t i=0; i<hits.size(); ++i)
+	getUnsorted().push_back(trkf::KHitGroup());
+    }
+
+    int nFill = 0;
+  };
+
+  // Addresses of all the KHitGroup objects in the container.
+
+  std::set<const trkf::KHitGroup*> groups(const trkf::KHitContainer& cont)
+  {
+    std::set<const trkf::KHitGroup*> result;
+    for(const auto* list : {&cont.getSorted(), &cont.getUnsorted(), &cont.getUnused()}) {
+      for(const trkf::KHitGroup& gr : *list)
+	result.insert(&gr);
+    }
+    return result;
+  }
+
+  art::PtrVector<recob::Hit> makeHits(std::size_t n)
+  {
+    art::PtrVector<recob::Hit> hits;
+    for(std::size_t i=0; i<n; ++i)
+      hits.push_back(art::Ptr<recob::Hit>());
+    return hits;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(KHitContainerRefillTest)
+
+BOOST_AUTO_TEST_CASE(Reuse) {
+  CountingContainer cont;
+  art::PtrVector<recob::Hit> hits = makeHits(3);
+
+  cont.refill(hits, -1);
+  BOOST_CHECK_EQUAL(cont.nFill, 1);
+  BOOST_CHECK_EQUAL(cont.getUnsorted().size(), 3U);
+  std::set<const trkf::KHitGroup*> made = groups(cont);
+
+  // Simulate a filter pass: move objects around and set a path.
+
+  auto& unsorted = cont.getUnsorted();
+  unsorted.front().setPath(true, 5.);
+  cont.getSorted().splice(cont.getSorted().end(), unsorted, unsorted.begin());
+  cont.getUnused().splice(cont.getUnused().end(), unsorted, unsorted.begin());
+
+  // Same hits: the objects are reused.
+
+  cont.refill(hits, -1);
+  BOOST_CHECK_EQUAL(cont.nFill, 1);
+  BOOST_CHECK_EQUAL(cont.getUnsorted().size(), 3U);
+  BOOST_CHECK(cont.getSorted().empty());
+  BOOST_CHECK(cont.getUnused().empty());
+  BOOST_CHECK(groups(cont) == made);
+  for(const trkf::KHitGroup& gr : cont.getUnsorted())
+    BOOST_CHECK(!gr.getHasPath());
+}
+
+BOOST_AUTO_TEST_CASE(Rebuild) {
+  CountingContainer cont;
+  art::PtrVector<recob::Hit> hits = makeHits(3);
+  cont.refill(hits, -1);
+
+  // Different plane.
+
+  cont.refill(hits, 1);
+  BOOST_CHECK_EQUAL(cont.nFill, 2);
+  BOOST_CHECK_EQUAL(cont.getUnsorted().size(), 3U);
+
+  // An object was removed.
+
+  cont.getUnsorted().pop_back();
+  cont.refill(hits, 1);
+  BOOST_CHECK_EQUAL(cont.nFill, 3);
+  BOOST_CHECK_EQUAL(cont.getUnsorted().size(), 3U);
+
+  // Different hits.
+
+  cont.refill(makeHits(4), 1);
+  BOOST_CHECK_EQUAL(cont.nFill, 4);
+  BOOST_CHECK_EQUAL(cont.getUnsorted().size(), 4U);
+
+  // After clear.
+
+  cont.clear();
+  cont.refill(makeHits(4), 1);
+  BOOST_CHECK_EQUAL(cont.nFill, 5);
+  BOOST_CHECK_EQUAL(cont.getUnsorted().size(), 4U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,207 @@
+#define BOOST_TEST_MODULE ( KHitContainerSortWindowTest )
+#include "cetlib/quiet_unit_test.hpp"
+#include "boost/test/floating_point_comparison.hpp"
+
+//
+// File: KHitContainerSortWindowTest.cc
+//
+// Purpose: Unit test for KHitContainer::sortWindow.  Checks which
+//          objects are propagated at the boundaries of the window,
+//          that the window is merged with the objects after it, that
+//          the unreachable objects are moved to the unsorted list, and
+//          the order of objects with the same path distance.
+//
+
+#include <memory>
+#include <vector>
+#include "lardata/RecoObjects/KHitContainer.h"
+#include "lardata/RecoObjects/KHitRecorded.h"
+#include "lardata/RecoObjects/PropYZPlane.h"
+#include "lardata/RecoObjects/SurfYZPlane.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // The objects are placed in the lists by the tests.
+
+  class TestContainer : public trkf::KHitContainer
+  {
+  public:
+    void fill(const art::PtrVector<recob::Hit>&, int) override {}
+  };
+
+  struct KHitContainerSortWindowTestFixture
+  {
+    KHitContainerSortWindowTestFixture() :
+      prop(0., false),
+      trk(makeSurface(0.), trkf::TrackVector(5), trkf::Surface::FORWARD, 13)
+    {
+      // Track along z: the path distance to a plane is its z.
+      trkf::TrackVector vec(5);
+      vec.clear();
+      vec(4) = 1.;
+      trk.setVector(vec);
+    }
+
+    static std::shared_ptr<const trkf::Surface> makeSurface(double z)
+    {
+      return std::make_shared<trkf::SurfYZPlane>(0., 0., z, 0.);
+    }
+
+    // Append to the sorted list an object on the plane at z, with
+    // the cached path distance path.
+
+    const trkf::KHitGroup* addGroup(double z, double path)
+    {
+      trkf::KHitGroup gr(true, path);
+      gr.addHit(std::make_shared<trkf::KHitRecorded>(makeSurface(z), 0, trkf::KHitRecorded::WIREX, 0.3, 0., 0.1));
+      cont.getSorted().push_back(std::move(gr));
+      return &cont.getSorted().back();
+    }
+
+    // Objects of the list in order, and their path distances.
+
+    static std::vector<const trkf::KHitGroup*> order(const std::list<trkf::KHitGroup>& groups)
+    {
+      std::vector<const trkf::KHitGroup*> result;
+      for(const trkf::KHitGroup& gr : groups)
+	result.push_back(&gr);
+      return result;
+    }
+
+    static std::vector<double> paths(const std::list<trkf::KHitGroup>& groups)
+    {
+      std::vector<double> result;
+      for(const trkf::KHitGroup& gr : groups)
+	result.push_back(gr.getPath());
+      return result;
+    }
+
+    void checkPaths(const std::vector<double>& expected) const
+    {
+      const std::vector<double> actual = paths(cont.getSorted());
+      BOOST_CHECK_EQUAL(actual.size(), expected.size());
+      if(actual.size() != expected.size())
+	return;
+      for(std::size_t i=0; i<expected.size(); ++i)
+	BOOST_CHECK_SMALL(actual[i] - expected[i], 1.e-9);
+      for(const trkf::KHitGroup& gr : cont.getSorted())
+	BOOST_CHECK(gr.getHasPath());
+    }
+
+    trkf::PropYZPlane prop;
+    trkf::KTrack trk;
+    TestContainer cont;
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(KHitContainerSortWindowTest, KHitContainerSortWindowTestFixture)
+
+BOOST_AUTO_TEST_CASE(WindowBoundaries) {
+
+  // Stale path distances, 10 more than the actual ones.
+
+  for(unsigned int window : {0U, 1U, 3U, 5U, 8U}) {
+    cont.clear();
+    for(int z=1; z<=5; ++z)
+      addGroup(z, z + 10.);
+    const std::vector<const trkf::KHitGroup*> before = order(cont.getSorted());
+
+    cont.sortWindow(trk, window, &prop, trkf::Propagator::FORWARD);
+
+    // The order is kept; with an empty window nothing changes, otherwise
+    // the first object of the window gives all the others the same shift.
+
+    BOOST_CHECK(order(cont.getSorted()) == before);
+    BOOST_CHECK(cont.getUnsorted().empty());
+    if(window == 0)
+      checkPaths({11., 12., 13., 14., 15.});
+    else
+      checkPaths({1., 2., 3., 4., 5.});
+  }
+
+  // Objects after the window are not propagated: those ones are not
+  // moved to their actual place, but shifted with the first object.
+
+  cont.clear();
+  const trkf::KHitGroup* gr1 = addGroup(1., 1.);
+  const trkf::KHitGroup* gr5 = addGroup(5., 2.);
+  const trkf::KHitGroup* gr6 = addGroup(6., 3.);
+  const trkf::KHitGroup* gr2 = addGroup(2., 4.);
+  cont.sortWindow(trk, 2, &prop, trkf::Propagator::FORWARD);
+  BOOST_CHECK(order(cont.getSorted()) == (std::vector<const trkf::KHitGroup*>{gr1, gr6, gr2, gr5}));
+  checkPaths({1., 3., 4., 5.});
+
+  // No propagator.
+
+  BOOST_CHECK_THROW(cont.sortWindow(trk, 2, nullptr), cet::exception);
+}
+
+BOOST_AUTO_TEST_CASE(WindowReorder) {
+
+  // The window is sorted, and the objects after it get the shift of
+  // the first one (3 - 1).
+
+  const trkf::KHitGroup* gr3 = addGroup(3., 1.);
+  const trkf::KHitGroup* gr1 = addGroup(1., 2.);
+  const trkf::KHitGroup* gr2 = addGroup(2., 3.);
+  const trkf::KHitGroup* gr5 = addGroup(5., 4.);
+  const trkf::KHitGroup* gr6 = addGroup(6., 5.);
+  cont.sortWindow(trk, 3, &prop, trkf::Propagator::FORWARD);
+  BOOST_CHECK(order(cont.getSorted()) == (std::vector<const trkf::KHitGroup*>{gr1, gr2, gr3, gr5, gr6}));
+  checkPaths({1., 2., 3., 6., 7.});
+
+  // The objects with no path are moved to the unsorted list, and the
+  // shift comes from the first reachable object (5 - 2).
+
+  cont.clear();
+  const trkf::KHitGroup* behind = addGroup(-1., 1.);
+  gr5 = addGroup(5., 2.);
+  gr1 = addGroup(1., 3.);
+  gr6 = addGroup(6., 4.);
+  cont.sortWindow(trk, 3, &prop, trkf::Propagator::FORWARD);
+  BOOST_CHECK(order(cont.getSorted()) == (std::vector<const trkf::KHitGroup*>{gr1, gr5, gr6}));
+  checkPaths({1., 5., 7.});
+  BOOST_CHECK(order(cont.getUnsorted()) == std::vector<const trkf::KHitGroup*>{behind});
+  BOOST_CHECK(!behind->getHasPath());
+}
+
+BOOST_AUTO_TEST_CASE(EqualPaths) {
+
+  // Two objects of the window on planes at the same distance, and two
+  // objects after the window with that same (stale) path distance.
+
+  const trkf::KHitGroup* grA = addGroup(2., 2.);
+  const trkf::KHitGroup* gr1 = addGroup(1., 2.);
+  const trkf::KHitGroup* grB = addGroup(2., 2.);
+  const trkf::KHitGroup* grC = addGroup(3., 2.);
+  const trkf::KHitGroup* grD = addGroup(4., 2.);
+  cont.sortWindow(trk, 3, &prop, trkf::Propagator::FORWARD);
+
+  // The shift is 0; the window objects go before the objects after the
+  // window with the same path distance, which keep their order.
+
+  const std::vector<const trkf::KHitGroup*> sorted = order(cont.getSorted());
+  BOOST_CHECK_EQUAL(sorted.size(), 5U);
+  checkPaths({1., 2., 2., 2., 2.});
+  if(sorted.size() == 5U) {
+    BOOST_CHECK(sorted[0] == gr1);
+    BOOST_CHECK((sorted[1] == grA && sorted[2] == grB) || (sorted[1] == grB && sorted[2] == grA));
+    BOOST_CHECK(sorted[3] == grC);
+    BOOST_CHECK(sorted[4] == grD);
+  }
+
+  // Sorting again changes nothing.
+
+  cont.sortWindow(trk, 3, &prop, trkf::Propagator::FORWARD);
+  const std::vector<const trkf::KHitGroup*> resorted = order(cont.getSorted());
+  BOOST_CHECK_EQUAL(resorted.size(), 5U);
+  checkPaths({1., 2., 2., 2., 2.});
+  if(resorted.size() == 5U) {
+    BOOST_CHECK(resorted[0] == gr1);
+    BOOST_CHECK(resorted[3] == grC);
+    BOOST_CHECK(resorted[4] == grD);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
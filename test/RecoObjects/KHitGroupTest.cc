@@ -0,0 +1,253 @@
+#define BOOST_TEST_MODULE ( KHitGroupTest )
+#include "cetlib/quiet_unit_test.hpp"
+#include "boost/test/floating_point_comparison.hpp"
+
+//
+// File: KHitGroupTest.cc
+//
+// Purpose: Unit test for KHitGroup::predictHits.  Checks that sharing
+//          the prediction between measurements on the same surface
+//          gives the same result as predicting each of them, and that
+//          the shared prediction is calculated only once.  Also checks
+//          that the pre-filter (KHitGroup::preselectHits) includes the
+//          slope error of the prediction, and counts concurrent calls.
+//
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "lardata/RecoObjects/KHitGroup.h"
+#include "lardata/RecoObjects/KHit.h"
+#include "lardata/RecoObjects/KHitRecorded.h"
+#include "lardata/RecoObjects/SurfYZPlane.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // One-dimensional measurement of track parameter 0 (as KHitWireX),
+  // counting the calls of subpredict.
+
+  class TestHit : public trkf::KHit<1>
+  {
+  public:
+    TestHit(const std::shared_ptr<const trkf::Surface>& psurf,
+	    double x, double xerr, bool shared) :
+      KHit(psurf, makeVector(x), makeError(xerr)),
+      fShared(shared)
+    {
+      setMeasPlane(0);
+    }
+
+    bool subpredict(const trkf::KETrack& tre,
+		    trkf::KVector<1>::type& pvec,
+		    trkf::KSymMatrix<1>::type& perr,
+		    trkf::KHMatrix<1>::type& hmatrix) const override
+    {
+      ++nSubpredict;
+      pvec.resize(1, false);
+      pvec(0) = tre.getVector()(0);
+      perr.resize(1, false);
+      perr(0,0) = tre.getError()(0,0) + 0.01 * tre.getVector()(2) * tre.getVector()(2);
+      hmatrix.resize(1, tre.getVector().size(), false);
+      hmatrix.clear();
+      hmatrix(0,0) = 1.;
+      return true;
+    }
+
+    bool isPredictionShared() const override {return fShared;}
+
+    static int nSubpredict;
+
+  private:
+    static trkf::KVector<1>::type makeVector(double x)
+      {return trkf::KVector<1>::type(1, x);}
+    static trkf::KSymMatrix<1>::type makeError(double xerr)
+      {trkf::KSymMatrix<1>::type err(1); err(0,0) = xerr*xerr; return err;}
+
+    bool fShared;
+  };
+
+  int TestHit::nSubpredict = 0;
+
+  struct KHitGroupTestFixture
+  {
+    KHitGroupTestFixture() :
+      psurf(std::make_shared<trkf::SurfYZPlane>(0., 0., 5., 0.3))
+    {
+      trkf::TrackVector vec(5);
+      vec(0) = 1.;
+      vec(1) = 2.;
+      vec(2) = 0.5;
+      vec(3) = -0.2;
+      vec(4) = 1.;
+      trkf::TrackError err(5);
+      err.clear();
+      for(int i=0; i<5; ++i)
+	err(i, i) = 0.1 * (i+1);
+      tre = trkf::KETrack(psurf, vec, err, trkf::Surface::FORWARD, 13);
+    }
+
+    std::shared_ptr<const trkf::Surface> psurf;
+    trkf::KETrack tre;
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(KHitGroupTest, KHitGroupTestFixture)
+
+// Shared predictions give the same chisquare and residual as one by one.
+
+BOOST_AUTO_TEST_CASE(SharedPrediction) {
+  trkf::KHitGroup group;
+  std::vector<std::shared_ptr<const TestHit> > hits;
+  for(int i=0; i<6; ++i) {
+    hits.push_back(std::make_shared<TestHit>(psurf, 0.5 + 0.2*i, 0.1 + 0.05*i, i != 3));
+    group.addHit(hits.back());
+  }
+
+  TestHit::nSubpredict = 0;
+  std::vector<double> chisq;
+  BOOST_CHECK_EQUAL(group.predictHits(tre, 0, 0, chisq), hits.size());
+  BOOST_CHECK_EQUAL(chisq.size(), hits.size());
+
+  // One prediction for the shared measurements, one for the other.
+
+  BOOST_CHECK_EQUAL(TestHit::nSubpredict, 2);
+
+  for(std::size_t i=0; i<hits.size(); ++i) {
+    BOOST_CHECK(hits[i]->getPredSurface().get() == psurf.get());
+    double res = hits[i]->getResVector()(0);
+    double reserr = hits[i]->getResError()(0,0);
+    BOOST_CHECK_CLOSE(chisq[i], hits[i]->getChisq(), 1.e-10);
+
+    // Compare with a prediction of the measurement alone.
+
+    TestHit alone(*hits[i]);
+    BOOST_CHECK(alone.predict(tre));
+    BOOST_CHECK_CLOSE(alone.getChisq(), chisq[i], 1.e-10);
+    BOOST_CHECK_CLOSE(alone.getResVector()(0), res, 1.e-10);
+    BOOST_CHECK_CLOSE(alone.getResError()(0,0), reserr, 1.e-10);
+    BOOST_CHECK_EQUAL(alone.getH()(0,0), hits[i]->getH()(0,0));
+  }
+
+  // The updated track is the same as with a prediction alone.
+
+  trkf::KETrack tre1(tre);
+  hits[4]->update(tre1);
+  TestHit alone(*hits[4]);
+  alone.predict(tre);
+  trkf::KETrack tre2(tre);
+  alone.update(tre2);
+  for(int i=0; i<5; ++i)
+    BOOST_CHECK_CLOSE(tre1.getVector()(i), tre2.getVector()(i), 1.e-10);
+}
+
+// A failed shared prediction fails all the measurements sharing it.
+
+BOOST_AUTO_TEST_CASE(FailedPrediction) {
+  std::vector<std::shared_ptr<const trkf::KHitBase> > hits;
+  for(int i=0; i<3; ++i)
+    hits.push_back(std::make_shared<TestHit>(psurf, 1., 0.1, true));
+
+  // Track on another surface, and no propagator: the prediction throws.
+
+  trkf::KETrack other(tre);
+  other.setSurface(std::make_shared<trkf::SurfYZPlane>(0., 0., 7., 0.3));
+  std::vector<double> chisq;
+  BOOST_CHECK_THROW(trkf::KHitGroup::predictHits(hits, other, 0, 0, chisq), cet::exception);
+
+  // Measurement which can't be predicted from the first.
+
+  TestHit const& first = static_cast<TestHit const&>(*hits[0]);
+  TestHit const& second = static_cast<TestHit const&>(*hits[1]);
+  TestHit fresh(psurf, 1., 0.1, true);
+  BOOST_CHECK(!second.predictAs(fresh));
+  BOOST_CHECK(second.getPredSurface().get() == 0);
+  BOOST_CHECK(first.predict(tre));
+  BOOST_CHECK(second.predictAs(first));
+  BOOST_CHECK_CLOSE(second.getChisq(), first.getChisq(), 1.e-10);
+}
+
+// At a large slope the pre-filter accepts the measurements whose
+// chisquare, including the slope error, is within the cut.
+
+BOOST_AUTO_TEST_CASE(PreselectLargeSlope) {
+  const double pitch = 1.;
+  const double nsigma = 3.;
+  for(auto kind : {trkf::KHitRecorded::WIREX, trkf::KHitRecorded::WIRELINE}) {
+    trkf::KETrack steep(tre);
+    trkf::TrackVector vec = steep.getVector();
+    vec(2) = (kind == trkf::KHitRecorded::WIREX)? 10.: 0.1;
+    steep.setVector(vec);
+
+    trkf::KHitGroup group;
+    std::vector<std::shared_ptr<const trkf::KHitRecorded> > hits;
+    for(int i=0; i<20; ++i) {
+      hits.push_back(std::make_shared<trkf::KHitRecorded>
+		     (psurf, 0, kind, pitch, vec(0) + 0.4*(i-10), 0.01));
+      group.addHit(hits.back());
+    }
+
+    std::vector<std::shared_ptr<const trkf::KHitBase> > selected;
+    std::size_t nsel = group.preselectHits(steep, nsigma, selected);
+    BOOST_CHECK_EQUAL(nsel, selected.size());
+    BOOST_CHECK_EQUAL(group.getNumAccepted(), nsel);
+    BOOST_CHECK_EQUAL(group.getNumPruned(), hits.size() - nsel);
+
+    // The slope error is what makes most of the measurements compatible.
+
+    double diagvar = 0.01 + steep.getError()(0,0);
+    std::size_t nwithin = 0;
+    std::size_t ndiag = 0;
+    for(const auto& phit : hits) {
+      BOOST_CHECK(phit->predict(steep));
+      bool within = phit->getChisq() <= nsigma*nsigma;
+      BOOST_CHECK_EQUAL(phit->checkResidual(steep, nsigma), within);
+      if(within)
+	++nwithin;
+      double res = phit->getMeasVector()(0) - vec(0);
+      if(res*res <= nsigma*nsigma * diagvar)
+	++ndiag;
+    }
+    BOOST_CHECK_EQUAL(nsel, nwithin);
+    BOOST_CHECK_GT(nsel, ndiag);
+  }
+}
+
+// Concurrent pre-filtering of the same group counts every measurement.
+
+BOOST_AUTO_TEST_CASE(PreselectConcurrentCounters) {
+  trkf::KHitGroup group;
+  for(int i=0; i<10; ++i)
+    group.addHit(std::make_shared<trkf::KHitRecorded>
+		 (psurf, 0, trkf::KHitRecorded::WIREX, 0.3, 1. + 0.5*i, 0.01));
+
+  const int nthreads = 4;
+  const int ncalls = 1000;
+  std::vector<std::thread> threads;
+  for(int i=0; i<nthreads; ++i) {
+    threads.emplace_back([this, &group]() {
+	std::vector<std::shared_ptr<const trkf::KHitBase> > selected;
+	for(int j=0; j<ncalls; ++j)
+	  group.preselectHits(tre, 3., selected);
+      });
+  }
+  for(auto& thread : threads)
+    thread.join();
+
+  BOOST_CHECK_EQUAL(group.getNumAccepted() + group.getNumPruned(),
+		    std::size_t(nthreads * ncalls * 10));
+  BOOST_CHECK_GT(group.getNumAccepted(), 0U);
+  BOOST_CHECK_GT(group.getNumPruned(), 0U);
+
+  // Copies keep the counts.
+
+  trkf::KHitGroup copy(group);
+  BOOST_CHECK_EQUAL(copy.getNumAccepted(), group.getNumAccepted());
+  group.resetCounters();
+  BOOST_CHECK_EQUAL(group.getNumAccepted(), 0U);
+  BOOST_CHECK_EQUAL(group.getNumPruned(), 0U);
+  BOOST_CHECK_GT(copy.getNumPruned(), 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
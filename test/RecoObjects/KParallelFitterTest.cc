@@ -0,0 +1,89 @@
+#define BOOST_TEST_MODULE ( KParallelFitterTest )
+#include "cetlib/quiet_unit_test.hpp"
+
+//
+// File: KParallelFitterTest.cc
+//
+// Purpose: Unit test for KParallelFitter.  Checks that each fit gets
+//          its own propagator, and that the output order does not
+//          depend on the number of threads.
+//
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "lardata/RecoObjects/KParallelFitter.h"
+#include "lardata/RecoObjects/PropYZPlane.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // Fit function: candidate i makes (i%3) tracks, with preferred
+  // plane encoding the candidate and track number.
+
+  void dummyFit(std::size_t i, const trkf::Propagator&, std::vector<trkf::KGTrack>& out)
+  {
+    for(std::size_t j = 0; j < i%3; ++j)
+      out.emplace_back(int(10*i + j));
+  }
+
+  std::vector<int> prefPlanes(const std::vector<trkf::KGTrack>& tracks)
+  {
+    std::vector<int> result;
+    for(const auto& trg : tracks)
+      result.push_back(trg.getPrefPlane());
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Order) {
+  trkf::PropYZPlane prop(-1., false);
+  std::size_t const ncand = 1000;
+
+  std::vector<int> expected;
+  for(std::size_t i = 0; i < ncand; ++i) {
+    for(std::size_t j = 0; j < i%3; ++j)
+      expected.push_back(int(10*i + j));
+  }
+
+  for(int nthreads : {1, 2, 8, 0}) {
+    trkf::KParallelFitter fitter(prop, nthreads);
+    BOOST_CHECK_EQUAL(fitter.getNumThreads(), nthreads);
+    std::vector<trkf::KGTrack> tracks = fitter.fit(ncand, dummyFit);
+    std::vector<int> planes = prefPlanes(tracks);
+    BOOST_CHECK_EQUAL_COLLECTIONS(planes.begin(), planes.end(),
+				  expected.begin(), expected.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PrivatePropagator) {
+  trkf::PropYZPlane prop(-1., false);
+  trkf::KParallelFitter fitter(prop, 4);
+  BOOST_CHECK(&fitter.getPropagator() != &prop);
+
+  std::mutex mutex;
+  std::set<const trkf::Propagator*> seen;
+  std::atomic<int> ncalls(0);
+  std::atomic<int> nbad(0);
+  fitter.fit(100, [&](std::size_t, const trkf::Propagator& p, std::vector<trkf::KGTrack>&) {
+      ++ncalls;
+      if(&p == &prop || &p == &fitter.getPropagator() ||
+	 dynamic_cast<const trkf::PropYZPlane*>(&p) == 0)
+	++nbad;
+      std::lock_guard<std::mutex> lock(mutex);
+      seen.insert(&p);
+    });
+  BOOST_CHECK_EQUAL(ncalls.load(), 100);
+  BOOST_CHECK_EQUAL(nbad.load(), 0);
+  BOOST_CHECK(!seen.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Exception) {
+  trkf::PropYZPlane prop(-1., false);
+  trkf::KParallelFitter fitter(prop, 2);
+  BOOST_CHECK_THROW(fitter.fit(1, trkf::KParallelFitter::FitFunction()), cet::exception);
+  BOOST_CHECK_THROW(fitter.fit(10, [](std::size_t i, const trkf::Propagator&, std::vector<trkf::KGTrack>&) {
+	if(i == 7) throw cet::exception("KParallelFitterTest") << "fit failed\n";
+      }), cet::exception);
+}
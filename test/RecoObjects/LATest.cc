@@ -115,7 +115,7 @@ int main()
 
   // 5x5 TrackError.
 
-  trkf::TrackError m5;
+  trkf::TrackError m5(5);
   for(unsigned int i = 0; i < m5.size1(); ++i) {
     for(unsigned int j = 0; j <= i; ++j) {
       m5(i,j) = i+j+1.;
@@ -245,6 +245,45 @@ int main()
     }
   }
 
+  // 3x3 KMatrix needing pivoting (zero first element).
+
+  trkf::KMatrix<3,3>::type m11(3,3);
+  for(unsigned int i = 0; i < m11.size1(); ++i) {
+    for(unsigned int j = 0; j < m11.size2(); ++j)
+      m11(i,j) = (i+j == 0 ? 0. : i + 2*j + (i==j ? 1. : 0.));
+
+  }
+  trkf::KMatrix<3,3>::type minv11(m11);
+  ok = trkf::invert(minv11);
+  assert(ok);
+  trkf::ublas::matrix<double> unit11 = prod(m11, minv11);
+  std::cout << m11 << std::endl;
+  std::cout << minv11 << std::endl;
+  std::cout << unit11 << std::endl;
+  for(unsigned int i = 0; i < m11.size1(); ++i) {
+    for(unsigned int j = 0; j < m11.size2(); ++j) {
+      double val = (i==j ? 1. : 0.);
+      assert(std::abs(unit11(i,j) - val) < 1.e-10);
+    }
+  }
+
+  // Singular matrices.
+
+  trkf::KSymMatrix<2>::type m12(2);
+  m12(0,0) = 1.;
+  m12(1,0) = 2.;
+  m12(1,1) = 4.;
+  ok = trkf::syminvert(m12);
+  assert(!ok);
+
+  trkf::KMatrix<2,2>::type m13(2,2);
+  m13(0,0) = 1.;
+  m13(0,1) = 2.;
+  m13(1,0) = 2.;
+  m13(1,1) = 4.;
+  ok = trkf::invert(m13);
+  assert(!ok);
+
   // Done (success).
 
   std::cout << "LATest: All tests passed." << std::endl;
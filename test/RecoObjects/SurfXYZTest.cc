@@ -62,6 +62,45 @@ BOOST_AUTO_TEST_CASE(Transformation) {
     BOOST_CHECK_CLOSE(xyz1[i], xyz2[i], 1.e-6);
 }
 
+// Test coordinate transformations of many points.
+
+BOOST_AUTO_TEST_CASE(BatchTransformation) {
+  double xyz1[4][3] = {{1., 2., 3.}, {0., 0., 0.}, {-5., 7., 11.}, {2., 2., 2.}};
+  double uvw1[4][3];
+  double xyz2[4][3];
+  surf4.toLocalBatch(4, xyz1, uvw1);
+  surf4.toGlobalBatch(4, uvw1, xyz2);
+  for(int j=0; j<4; ++j) {
+    double uvw[3];
+    surf4.toLocal(xyz1[j], uvw);
+    for(int i=0; i<3; ++i) {
+      BOOST_CHECK_SMALL(uvw1[j][i] - uvw[i], 1.e-12);
+      BOOST_CHECK_SMALL(xyz2[j][i] - xyz1[j][i], 1.e-12);
+    }
+  }
+
+  // Transformation in place.
+
+  surf4.toLocalBatch(4, xyz2, xyz2);
+  for(int j=0; j<4; ++j) {
+    for(int i=0; i<3; ++i)
+      BOOST_CHECK_SMALL(xyz2[j][i] - uvw1[j][i], 1.e-12);
+  }
+}
+
+// Test the transformation of a surface constructed from its normal vector.
+
+BOOST_AUTO_TEST_CASE(NormalTransformation) {
+  trkf::SurfXYZPlane surf(1., 2., 3., 0.3, -0.4, 0.5);
+  double norm = std::sqrt(0.3*0.3 + 0.4*0.4 + 0.5*0.5);
+  double xyz[3] = {1. + 0.3/norm, 2. - 0.4/norm, 3. + 0.5/norm};
+  double uvw[3];
+  surf.toLocal(xyz, uvw);
+  BOOST_CHECK_SMALL(uvw[0], 1.e-12);
+  BOOST_CHECK_SMALL(uvw[1], 1.e-12);
+  BOOST_CHECK_CLOSE(uvw[2], 1., 1.e-6);
+}
+
 // Test separation.
 
 BOOST_AUTO_TEST_CASE(Separation) {
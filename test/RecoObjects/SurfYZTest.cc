@@ -62,6 +62,32 @@ BOOST_AUTO_TEST_CASE(Transformation) {
     BOOST_CHECK_CLOSE(xyz1[i], xyz2[i], 1.e-6);
 }
 
+// Test coordinate transformations of many points.
+
+BOOST_AUTO_TEST_CASE(BatchTransformation) {
+  double xyz1[4][3] = {{1., 2., 3.}, {0., 0., 0.}, {-5., 7., 11.}, {2., 2., 2.}};
+  double uvw1[4][3];
+  double xyz2[4][3];
+  surf4.toLocalBatch(4, xyz1, uvw1);
+  surf4.toGlobalBatch(4, uvw1, xyz2);
+  for(int j=0; j<4; ++j) {
+    double uvw[3];
+    surf4.toLocal(xyz1[j], uvw);
+    for(int i=0; i<3; ++i) {
+      BOOST_CHECK_SMALL(uvw1[j][i] - uvw[i], 1.e-12);
+      BOOST_CHECK_SMALL(xyz2[j][i] - xyz1[j][i], 1.e-12);
+    }
+  }
+
+  // Transformation in place.
+
+  surf4.toLocalBatch(4, xyz2, xyz2);
+  for(int j=0; j<4; ++j) {
+    for(int i=0; i<3; ++i)
+      BOOST_CHECK_SMALL(xyz2[j][i] - uvw1[j][i], 1.e-12);
+  }
+}
+
 // Test separation.
 
 BOOST_AUTO_TEST_CASE(Separation) {
@@ -0,0 +1,139 @@
+#define BOOST_TEST_MODULE ( SurfaceVariantTest )
+#include "cetlib/quiet_unit_test.hpp"
+#include "boost/test/floating_point_comparison.hpp"
+
+//
+// File: SurfaceVariantTest.cc
+//
+// Purpose: Unit test for SurfaceVariant and visitSurface.
+//
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include "lardata/RecoObjects/SurfaceVariant.h"
+#include "lardata/RecoObjects/KalmanLinearAlgebra.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  // A surface type derived from a known one.
+  class MySurfYZPlane : public trkf::SurfYZPlane
+  {
+  public:
+    using trkf::SurfYZPlane::SurfYZPlane;
+  };
+
+  // Returns the name of the surface type seen by visitSurface.
+  struct TypeName
+  {
+    std::string operator()(const trkf::SurfYZPlane&) const {return "SurfYZPlane";}
+    std::string operator()(const trkf::SurfXYZPlane&) const {return "SurfXYZPlane";}
+    std::string operator()(const trkf::SurfYZLine&) const {return "SurfYZLine";}
+    std::string operator()(const trkf::SurfWireX&) const {return "SurfWireX";}
+    std::string operator()(const trkf::SurfWireLine&) const {return "SurfWireLine";}
+    std::string operator()(const trkf::Surface&) const {return "Surface";}
+  };
+
+}
+
+struct SurfaceVariantTestFixture
+{
+  SurfaceVariantTestFixture() :
+    plane1(trkf::SurfYZPlane(0., 0., 0., 0.)),
+    plane2(trkf::SurfYZPlane(1., 1., 1., 0.)),
+    plane3(trkf::SurfYZPlane(2., 3., 4., 1.)),
+    xyzplane(trkf::SurfXYZPlane(2., 3., 4., 1., 0.2)),
+    line1(trkf::SurfYZLine(2., 3., 4., 1.)),
+    line2(trkf::SurfYZLine(2., 3., 4., 1.)) {}
+  trkf::SurfaceVariant plane1;   // Default SurfYZPlane.
+  trkf::SurfaceVariant plane2;   // Parallel to plane1.
+  trkf::SurfaceVariant plane3;   // Not parallel.
+  trkf::SurfaceVariant xyzplane;
+  trkf::SurfaceVariant line1;
+  trkf::SurfaceVariant line2;    // Same as line1.
+};
+
+BOOST_FIXTURE_TEST_SUITE(SurfaceVariantTest, SurfaceVariantTestFixture)
+
+// Test comparisons, which must match the polymorphic ones.
+
+BOOST_AUTO_TEST_CASE(Comparisons) {
+  const trkf::SurfaceVariant* surfs[] = {&plane1, &plane2, &plane3, &xyzplane, &line1, &line2};
+  for(const trkf::SurfaceVariant* s1: surfs) {
+    for(const trkf::SurfaceVariant* s2: surfs) {
+      const trkf::Surface& ps1 = trkf::asSurface(*s1);
+      const trkf::Surface& ps2 = trkf::asSurface(*s2);
+      BOOST_CHECK_EQUAL(trkf::isParallel(*s1, *s2), ps1.isParallel(ps2));
+      BOOST_CHECK_EQUAL(trkf::isEqual(*s1, *s2), ps1.isEqual(ps2));
+    }
+  }
+  BOOST_CHECK(trkf::isEqual(line1, line2));
+  BOOST_CHECK(!trkf::isParallel(plane3, line1));
+  BOOST_CHECK(!trkf::isParallel(plane3, xyzplane));
+  BOOST_CHECK(trkf::distanceTo(plane1, plane2) == 1.);
+  BOOST_CHECK_EXCEPTION( trkf::distanceTo(plane1, line1), cet::exception, \
+                         [](cet::exception const & e)	          \
+			 {				          \
+			   return e.category() == "SurfYZPlane";  \
+			 } );
+}
+
+// Test coordinate transformations and track parameters.
+
+BOOST_AUTO_TEST_CASE(Transformation) {
+  trkf::TrackVector v(5);
+  v(0) = 0.1;
+  v(1) = 0.2;
+  v(2) = 0.3;
+  v(3) = 0.4;
+  v(4) = 0.5;
+
+  for(const trkf::SurfaceVariant* s: {&plane3, &xyzplane, &line1}) {
+    const trkf::Surface& ps = trkf::asSurface(*s);
+    double xyz1[3] = {1., 2., 3.};
+    double uvw1[3], uvw2[3], xyz2[3];
+    trkf::toLocal(*s, xyz1, uvw1);
+    ps.toLocal(xyz1, uvw2);
+    trkf::toGlobal(*s, uvw1, xyz2);
+    for(int i=0; i<3; ++i) {
+      BOOST_CHECK_EQUAL(uvw1[i], uvw2[i]);
+      BOOST_CHECK_CLOSE(xyz1[i], xyz2[i], 1.e-6);
+    }
+
+    double mom1[3], mom2[3];
+    trkf::getPosition(*s, v, xyz1);
+    ps.getPosition(v, xyz2);
+    trkf::getMomentum(*s, v, mom1, trkf::Surface::FORWARD);
+    ps.getMomentum(v, mom2, trkf::Surface::FORWARD);
+    for(int i=0; i<3; ++i) {
+      BOOST_CHECK_EQUAL(xyz1[i], xyz2[i]);
+      BOOST_CHECK_EQUAL(mom1[i], mom2[i]);
+    }
+    BOOST_CHECK_EQUAL(trkf::isTrackValid(*s, v), ps.isTrackValid(v));
+  }
+}
+
+// Test conversions from and to the polymorphic surfaces.
+
+BOOST_AUTO_TEST_CASE(Conversions) {
+  std::shared_ptr<const trkf::Surface> psurf = trkf::makeSurface(xyzplane);
+  BOOST_CHECK(dynamic_cast<const trkf::SurfXYZPlane*>(&*psurf));
+  trkf::SurfaceVariant copy = trkf::makeSurfaceVariant(*psurf);
+  BOOST_CHECK(std::holds_alternative<trkf::SurfXYZPlane>(copy));
+  BOOST_CHECK(trkf::isEqual(copy, xyzplane));
+
+  // A derived type is copied as its known base.
+
+  MySurfYZPlane mine(1., 2., 3., 0.5);
+  BOOST_CHECK_EQUAL(trkf::visitSurface(mine, TypeName()), "SurfYZPlane");
+  trkf::SurfaceVariant mycopy = trkf::makeSurfaceVariant(mine);
+  BOOST_CHECK(std::holds_alternative<trkf::SurfYZPlane>(mycopy));
+  BOOST_CHECK(mine.isEqual(trkf::asSurface(mycopy)));
+
+  BOOST_CHECK_EQUAL(trkf::visitSurface(trkf::asSurface(line1), TypeName()), "SurfYZLine");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,252 @@
+#define BOOST_TEST_MODULE ( TrackStateBatchTest )
+#include "cetlib/quiet_unit_test.hpp"
+
+//
+// File: TrackStateBatchTest.cc
+//
+// Purpose: Unit test for the batch propagation and update of track
+//          states (TrackStateBatch.h).  Checks that they take the same
+//          decisions as TrackStatePropagator::propagateToPlane and
+//          KFTrackState::updateWithHitState, and that the results agree
+//          within rounding, step by step along a chain of planes.
+//
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lardata/RecoObjects/TrackStateBatch.h"
+#include "lardata/RecoObjects/TrackStatePropagator.h"
+#include "lardata/RecoObjects/KFTrackState.h"
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  using trkf::Plane;
+  using trkf::Point_t;
+  using trkf::Vector_t;
+  using trkf::TrackState;
+
+  constexpr double tolerance = 1.e-9;
+
+  bool close(double a, double b) { return std::abs(a-b) <= tolerance*(1. + std::abs(a) + std::abs(b)); }
+
+  // Covariance elements are compared on the scale of the errors, since the steep tracks have large correlations.
+  bool closeCov(const trkf::SMatrixSym55& a, const trkf::SMatrixSym55& b, unsigned int i, unsigned int j)
+  {
+    return std::abs(a(i,j)-b(i,j)) <= tolerance*(1. + std::sqrt(std::abs(a(i,i)*a(j,j))));
+  }
+
+  // Plane through (0,0,z), with direction tilted by alpha around y and by phi around x.
+  Plane makePlane(double z, double alpha, double phi)
+  {
+    return Plane(Point_t(0., 0., z), Vector_t(std::sin(alpha), -std::cos(alpha)*std::sin(phi), std::cos(alpha)*std::cos(phi)));
+  }
+
+  TrackState randomState(std::mt19937& engine, const Plane& plane)
+  {
+    std::uniform_real_distribution<double> flat(-1., 1.);
+    trkf::SVector5 par(50.*flat(engine), 50.*flat(engine), 0.8*flat(engine), 0.8*flat(engine), 1.65 + 1.35*flat(engine));
+    // positive definite covariance: A*A^T plus a diagonal term
+    double a[5][5];
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j < 5; ++j) a[i][j] = 0.1*flat(engine);
+    trkf::SMatrixSym55 cov;
+    for (unsigned int i = 0; i < 5; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+	double sum = (i==j ? 0.05 : 0.);
+	for (unsigned int k = 0; k < 5; ++k) sum += a[i][k]*a[j][k];
+	cov(i,j) = sum;
+      }
+    }
+    return TrackState(par, cov, plane, true, 13);
+  }
+
+  trkf::HitState makeHit(double meas, const Plane& plane)
+  {
+    return trkf::HitState(meas, 0.09, geo::WireID(), plane);
+  }
+
+  void checkSame(const TrackState& expected, const TrackState& actual)
+  {
+    for (unsigned int i = 0; i < 5; ++i)
+      BOOST_CHECK(close(expected.parameters()(i), actual.parameters()(i)));
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j <= i; ++j)
+	BOOST_CHECK(closeCov(expected.covariance(), actual.covariance(), i, j));
+    BOOST_CHECK(close(expected.position().X(), actual.position().X()));
+    BOOST_CHECK(close(expected.position().Y(), actual.position().Y()));
+    BOOST_CHECK(close(expected.position().Z(), actual.position().Z()));
+    BOOST_CHECK(close(expected.momentum().X(), actual.momentum().X()));
+    BOOST_CHECK(close(expected.momentum().Y(), actual.momentum().Y()));
+    BOOST_CHECK(close(expected.momentum().Z(), actual.momentum().Z()));
+    BOOST_CHECK((expected.plane().position()-actual.plane().position()).Mag2() == 0.);
+    BOOST_CHECK((expected.plane().direction()-actual.plane().direction()).Mag2() == 0.);
+    BOOST_CHECK_EQUAL(expected.isTrackAlongPlaneDir(), actual.isTrackAlongPlaneDir());
+  }
+
+  // The providers are not needed without material effects.
+  trkf::TrackStatePropagator makePropagator(double fastPathMinP = -1.)
+  {
+    return trkf::TrackStatePropagator(nullptr, nullptr, 1., 0.1, 10, 10., 0.01, false, fastPathMinP);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(BatchStorage) {
+  std::mt19937 engine(1);
+  const TrackState state = randomState(engine, makePlane(10., 0.2, 1.));
+  trkf::TrackStateBatch states;
+  states.push_back(state);
+  BOOST_CHECK_EQUAL(states.size(), 1U);
+  checkSame(state, states.state(0));
+  BOOST_CHECK_EQUAL(states.state(0).pID(), 13);
+
+  // the local to global conversion of the kernels is the one of the planes
+  trkf::batch::StateArrays s = states.arrays();
+  double pos[3], mom[3];
+  double par[5];
+  for (unsigned int i = 0; i < 5; ++i) par[i] = state.parameters()(i);
+  const trkf::PlaneBatch& planes = states.planes();
+  const trkf::batch::PlaneArrays<const double> p = planes.arrays();
+  trkf::batch::localToGlobal(par, p.sinA[0], p.cosA[0], p.sinB[0], p.cosB[0], p.x[0], p.y[0], p.z[0], true, pos, mom);
+  for (unsigned int i = 0; i < 3; ++i) {
+    BOOST_CHECK(close(pos[i], s.pos[i][0]));
+    BOOST_CHECK(close(mom[i], s.mom[i][0]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PropagationDecisions) {
+  std::mt19937 engine(2);
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.);
+  std::vector<Plane> targets;
+  for (unsigned int i = 0; i < 12; ++i) {
+    // some planes behind the origin, in the wrong direction for a FORWARD propagation
+    const double z = (i%4 == 3 ? -20. : 5. + 10.*i);
+    targets.push_back(makePlane(z, 0.1*(i%3), -1.0 + 0.2*i));
+  }
+
+  std::vector<TrackState> origins;
+  trkf::TrackStateBatch states;
+  trkf::PlaneBatch targetBatch;
+  for (unsigned int i = 0; i < 200; ++i) {
+    origins.push_back(randomState(engine, origin));
+    states.push_back(origins.back());
+    targetBatch.push_back(targets[i % targets.size()]);
+  }
+
+  for (auto dir : { trkf::TrackStatePropagator::FORWARD, trkf::TrackStatePropagator::BACKWARD }) {
+    trkf::TrackStateBatch batch = states;
+    std::vector<char> success;
+    prop.resetPathCounters();
+    prop.propagateToPlane(success, batch, targetBatch, false, false, dir);
+    BOOST_REQUIRE_EQUAL(success.size(), origins.size());
+    unsigned int nOk = 0;
+    for (size_t i = 0; i < origins.size(); ++i) {
+      bool ok = false;
+      const TrackState expected = prop.propagateToPlane(ok, origins[i], targets[i % targets.size()], false, false, dir);
+      BOOST_CHECK_EQUAL(bool(success[i]), ok);
+      if (ok) {
+	checkSame(expected, batch.state(i));
+	++nOk;
+      }
+      else checkSame(origins[i], batch.state(i));
+    }
+    BOOST_CHECK(nOk > 0);
+    BOOST_CHECK(nOk < origins.size());
+  }
+
+  // fast path above the momentum threshold, with material effects requested
+  const trkf::TrackStatePropagator fastProp = makePropagator(0.);
+  trkf::TrackStateBatch batch = states;
+  std::vector<char> success;
+  fastProp.propagateToPlane(success, batch, targetBatch, true, true);
+  unsigned int nOk = 0;
+  for (size_t i = 0; i < origins.size(); ++i) nOk += bool(success[i]);
+  BOOST_CHECK_EQUAL(fastProp.pathCounters().fast, nOk);
+  BOOST_CHECK_EQUAL(fastProp.pathCounters().iterative, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(SharedTargetAndSelection) {
+  std::mt19937 engine(3);
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.5);
+  const Plane target = makePlane(30., 0.15, -0.5);
+  std::vector<TrackState> origins;
+  trkf::TrackStateBatch states;
+  std::vector<char> select;
+  for (unsigned int i = 0; i < 50; ++i) {
+    origins.push_back(randomState(engine, origin));
+    states.push_back(origins.back());
+    select.push_back(i%2);
+  }
+  trkf::PlaneBatch targets;
+  targets.push_back(target);
+
+  std::vector<char> success(origins.size(), 7);
+  trkf::propagateStraightToPlanes(success, states, targets, 0.01, trkf::TrackStatePropagator::FORWARD, select);
+  for (size_t i = 0; i < origins.size(); ++i) {
+    if (!select[i]) {
+      BOOST_CHECK_EQUAL(int(success[i]), 7);
+      checkSame(origins[i], states.state(i));
+      continue;
+    }
+    bool ok = false;
+    const TrackState expected = prop.propagateToPlane(ok, origins[i], target, false, false);
+    BOOST_CHECK_EQUAL(bool(success[i]), ok);
+    checkSame(ok ? expected : origins[i], states.state(i));
+  }
+
+  // wrong sizes
+  trkf::PlaneBatch twoTargets = targets;
+  twoTargets.push_back(target);
+  BOOST_CHECK_THROW(trkf::propagateStraightToPlanes(success, states, twoTargets, 0.01, trkf::TrackStatePropagator::FORWARD),
+		    cet::exception);
+  BOOST_CHECK_THROW(trkf::propagateStraightToPlanes(success, states, targets, 0.01, trkf::TrackStatePropagator::FORWARD,
+						    std::vector<char>(3, 1)), cet::exception);
+}
+
+BOOST_AUTO_TEST_CASE(FilterChain) {
+  std::mt19937 engine(4);
+  std::normal_distribution<double> noise(0., 0.3);
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.);
+  std::vector<Plane> planes;
+  for (unsigned int k = 0; k < 9; ++k) planes.push_back(makePlane(3. + 0.3*k, 0., (k%3 - 1.)*0.5));
+  const Plane elsewhere = makePlane(100., 0., 0.);
+
+  std::vector<trkf::KFTrackState> expected;
+  trkf::TrackStateBatch states;
+  for (unsigned int i = 0; i < 100; ++i) {
+    TrackState state = randomState(engine, origin);
+    states.push_back(state);
+    expected.emplace_back(std::move(state));
+  }
+
+  for (unsigned int k = 0; k < planes.size(); ++k) {
+    trkf::PlaneBatch targets;
+    targets.push_back(planes[k]);
+    std::vector<char> propagated;
+    prop.propagateToPlane(propagated, states, targets, false, false);
+
+    // hits on the target plane, except a few on another one
+    trkf::HitStateBatch hits;
+    std::vector<trkf::HitState> hitStates;
+    for (size_t i = 0; i < expected.size(); ++i) {
+      const Plane& hitPlane = ((i + k)%7 == 0 ? elsewhere : planes[k]);
+      hitStates.push_back(makeHit(states.parameter(i, 0) + noise(engine), hitPlane));
+      hits.push_back(hitStates.back());
+    }
+    std::vector<char> updated;
+    trkf::updateWithHitStates(updated, states, hits, propagated);
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+      bool ok = false;
+      TrackState next = prop.propagateToPlane(ok, expected[i].trackState(), planes[k], false, false);
+      BOOST_CHECK_EQUAL(bool(propagated[i]), ok);
+      if (!ok) continue;
+      expected[i].setTrackState(std::move(next));
+      BOOST_CHECK_EQUAL(bool(updated[i]), expected[i].updateWithHitState(hitStates[i]));
+      checkSame(expected[i].trackState(), states.state(i));
+    }
+  }
+}
@@ -0,0 +1,199 @@
+#define BOOST_TEST_MODULE ( TrackStatePropagatorTest )
+#include "cetlib/quiet_unit_test.hpp"
+
+//
+// File: TrackStatePropagatorTest.cc
+//
+// Purpose: Unit test for the propagation of several mass hypotheses
+//          of the same track by TrackStatePropagator::propagateToPlane.
+//          Checks that the shared geometry gives the same states as the
+//          one by one propagation, exactly for the reference and to
+//          first order for nearby hypotheses, and that failures and
+//          states on other planes are handled as documented.
+//
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lardata/RecoObjects/TrackStatePropagator.h"
+
+namespace {
+
+  using trkf::Plane;
+  using trkf::Point_t;
+  using trkf::Vector_t;
+  using trkf::TrackState;
+
+  bool close(double a, double b, double tolerance) { return std::abs(a-b) <= tolerance*(1. + std::abs(a) + std::abs(b)); }
+
+  // Covariance elements are compared on the scale of the errors, since the steep tracks have large correlations.
+  bool closeCov(const trkf::SMatrixSym55& a, const trkf::SMatrixSym55& b, unsigned int i, unsigned int j, double tolerance)
+  {
+    return std::abs(a(i,j)-b(i,j)) <= tolerance*(1. + std::sqrt(std::abs(a(i,i)*a(j,j))));
+  }
+
+  // Plane through (0,0,z), with direction tilted by alpha around y and by phi around x.
+  Plane makePlane(double z, double alpha, double phi)
+  {
+    return Plane(Point_t(0., 0., z), Vector_t(std::sin(alpha), -std::cos(alpha)*std::sin(phi), std::cos(alpha)*std::cos(phi)));
+  }
+
+  TrackState randomState(std::mt19937& engine, const Plane& plane, int pid)
+  {
+    std::uniform_real_distribution<double> flat(-1., 1.);
+    trkf::SVector5 par(50.*flat(engine), 50.*flat(engine), 0.8*flat(engine), 0.8*flat(engine), 1.65 + 1.35*flat(engine));
+    // positive definite covariance: A*A^T plus a diagonal term
+    double a[5][5];
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j < 5; ++j) a[i][j] = 0.1*flat(engine);
+    trkf::SMatrixSym55 cov;
+    for (unsigned int i = 0; i < 5; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+	double sum = (i==j ? 0.05 : 0.);
+	for (unsigned int k = 0; k < 5; ++k) sum += a[i][k]*a[j][k];
+	cov(i,j) = sum;
+      }
+    }
+    return TrackState(par, cov, plane, true, pid);
+  }
+
+  // The same state with a different particle and parameters shifted by delta.
+  TrackState hypothesis(const TrackState& ref, int pid, double delta)
+  {
+    trkf::SVector5 par = ref.parameters();
+    for (unsigned int i = 0; i < 5; ++i) par[i] += delta*(i + 1.);
+    return TrackState(par, ref.covariance(), ref.plane(), ref.isTrackAlongPlaneDir(), pid);
+  }
+
+  void checkSame(const TrackState& expected, const TrackState& actual, double tolerance, double covTolerance)
+  {
+    for (unsigned int i = 0; i < 5; ++i)
+      BOOST_CHECK(close(expected.parameters()(i), actual.parameters()(i), tolerance));
+    for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j <= i; ++j)
+	BOOST_CHECK(closeCov(expected.covariance(), actual.covariance(), i, j, covTolerance));
+    BOOST_CHECK((expected.plane().position()-actual.plane().position()).Mag2() == 0.);
+    BOOST_CHECK((expected.plane().direction()-actual.plane().direction()).Mag2() == 0.);
+    BOOST_CHECK_EQUAL(expected.isTrackAlongPlaneDir(), actual.isTrackAlongPlaneDir());
+    BOOST_CHECK_EQUAL(expected.pID(), actual.pID());
+  }
+
+  // The providers are not needed without material effects.
+  trkf::TrackStatePropagator makePropagator()
+  {
+    return trkf::TrackStatePropagator(nullptr, nullptr, 1., 0.1, 10, 10., 0.01, false);
+  }
+
+  const std::vector<int> pids = { 13, 211, 321, 2212 };
+}
+
+BOOST_AUTO_TEST_CASE(SameParameters) {
+  std::mt19937 engine(1);
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.3);
+  for (unsigned int k = 0; k < 20; ++k) {
+    const Plane target = makePlane(10. + 2.*k, 0.05*(k%4), -0.6 + 0.1*k);
+    const TrackState ref = randomState(engine, origin, pids.front());
+    std::vector<TrackState> origins;
+    for (int pid : pids) origins.push_back(hypothesis(ref, pid, 0.));
+
+    std::vector<bool> success;
+    prop.resetPathCounters();
+    const std::vector<TrackState> result = prop.propagateToPlane(success, origins, target, false, false);
+    BOOST_REQUIRE_EQUAL(result.size(), origins.size());
+    BOOST_REQUIRE_EQUAL(success.size(), origins.size());
+    BOOST_CHECK_EQUAL(prop.pathCounters().fast, origins.size());
+    for (size_t i = 0; i < origins.size(); ++i) {
+      bool ok = false;
+      const TrackState expected = prop.propagateToPlane(ok, origins[i], target, false, false);
+      BOOST_CHECK_EQUAL(success[i], ok);
+      if (ok) checkSame(expected, result[i], 1.e-9, 1.e-9);
+      else checkSame(origins[i], result[i], 0., 0.);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NearbyHypotheses) {
+  // the hypotheses differ from the reference by delta: the first order propagation of the parameters
+  // is off by delta^2, and the Jacobian of the reference is off by delta
+  std::mt19937 engine(2);
+  const double delta = 1.e-6;
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.);
+  for (unsigned int k = 0; k < 20; ++k) {
+    const Plane target = makePlane(5. + 3.*k, 0.1*(k%3), -1.0 + 0.1*k);
+    const TrackState ref = randomState(engine, origin, pids.front());
+    std::vector<TrackState> origins;
+    for (size_t i = 0; i < pids.size(); ++i) origins.push_back(hypothesis(ref, pids[i], delta*i));
+
+    std::vector<bool> success;
+    const std::vector<TrackState> result = prop.propagateToPlane(success, origins, target, false, false);
+    BOOST_REQUIRE_EQUAL(result.size(), origins.size());
+    for (size_t i = 0; i < origins.size(); ++i) {
+      bool ok = false;
+      const TrackState expected = prop.propagateToPlane(ok, origins[i], target, false, false);
+      BOOST_CHECK_EQUAL(success[i], ok);
+      if (ok) checkSame(expected, result[i], 1.e-8, 1.e-3);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(OtherPlane) {
+  // a hypothesis on another plane is propagated on its own
+  std::mt19937 engine(3);
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.);
+  const Plane other = makePlane(2., 0.1, 0.5);
+  const Plane target = makePlane(20., 0.1, -0.3);
+  std::vector<TrackState> origins;
+  origins.push_back(randomState(engine, origin, 13));
+  origins.push_back(randomState(engine, other, 211));
+  origins.push_back(hypothesis(origins.front(), 2212, 0.));
+
+  std::vector<bool> success;
+  prop.resetPathCounters();
+  const std::vector<TrackState> result = prop.propagateToPlane(success, origins, target, false, false);
+  BOOST_REQUIRE_EQUAL(result.size(), origins.size());
+  BOOST_CHECK_EQUAL(prop.pathCounters().fast, origins.size());
+  for (size_t i = 0; i < origins.size(); ++i) {
+    bool ok = false;
+    const TrackState expected = prop.propagateToPlane(ok, origins[i], target, false, false);
+    BOOST_CHECK(ok);
+    BOOST_CHECK_EQUAL(success[i], ok);
+    checkSame(expected, result[i], 1.e-9, 1.e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Failures) {
+  std::mt19937 engine(4);
+  const trkf::TrackStatePropagator prop = makePropagator();
+  const Plane origin = makePlane(0., 0., 0.);
+  const Plane behind = makePlane(-20., 0., 0.);
+  std::vector<TrackState> origins;
+  const TrackState ref = randomState(engine, origin, 13);
+  for (int pid : pids) origins.push_back(hypothesis(ref, pid, 0.));
+
+  // wrong direction: no state is propagated, and the origins are returned
+  std::vector<bool> success;
+  std::vector<TrackState> result = prop.propagateToPlane(success, origins, behind, false, false, trkf::TrackStatePropagator::FORWARD);
+  BOOST_REQUIRE_EQUAL(result.size(), origins.size());
+  for (size_t i = 0; i < origins.size(); ++i) {
+    BOOST_CHECK(!success[i]);
+    checkSame(origins[i], result[i], 0., 0.);
+  }
+
+  // the same target, backward
+  result = prop.propagateToPlane(success, origins, behind, false, false, trkf::TrackStatePropagator::BACKWARD);
+  for (size_t i = 0; i < origins.size(); ++i) {
+    bool ok = false;
+    const TrackState expected = prop.propagateToPlane(ok, origins[i], behind, false, false, trkf::TrackStatePropagator::BACKWARD);
+    BOOST_CHECK(ok);
+    BOOST_CHECK_EQUAL(success[i], ok);
+    checkSame(expected, result[i], 1.e-9, 1.e-9);
+  }
+
+  // no hypothesis
+  result = prop.propagateToPlane(success, std::vector<TrackState>(), behind, false, false);
+  BOOST_CHECK(result.empty());
+  BOOST_CHECK(success.empty());
+}
@@ -0,0 +1,119 @@
+/**
+ * @file    AllocationAccounting_test.cc
+ * @brief   Tests the accounting of the allocations of tagged containers
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/AllocationAccounting.h`
+ *
+ * The accounting is enabled for this test only.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+#define LARDATA_ALLOCATION_ACCOUNTING 1
+
+// LArSoft libraries
+#include "lardata/Utilities/AllocationAccounting.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( AllocationAccounting_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <list>
+#include <string>
+#include <thread>
+#include <type_traits> // std::is_same<>
+#include <vector>
+
+
+struct VectorTag { static constexpr char const* Name = "vector"; };
+struct ListTag { static constexpr char const* Name = "list"; };
+
+
+//------------------------------------------------------------------------------
+void RunCountingTest() {
+
+  using Accounting_t = lar::AllocationAccounting;
+  static_assert(Accounting_t::Enabled);
+  static_assert(std::is_same<
+    lar::TaggedAllocator<int, VectorTag>, lar::CountingAllocator<int, VectorTag>
+    >());
+
+  lar::AllocationCounts_t const start = Accounting_t::GetCounts<VectorTag>();
+  {
+    lar::TaggedVector<double, VectorTag> v;
+    v.reserve(100U);
+    lar::AllocationCounts_t const counts = Accounting_t::GetCounts<VectorTag>();
+    BOOST_CHECK_EQUAL(counts.allocations - start.allocations, 1U);
+    BOOST_CHECK_EQUAL
+      (counts.allocatedBytes - start.allocatedBytes, 100U * sizeof(double));
+    BOOST_CHECK_EQUAL(counts.bytesInUse() - start.bytesInUse(),
+      (long long)(100U * sizeof(double)));
+  }
+  lar::AllocationCounts_t const end = Accounting_t::GetCounts<VectorTag>();
+  BOOST_CHECK_EQUAL(end.deallocations - start.deallocations, 1U);
+  BOOST_CHECK_EQUAL(end.bytesInUse(), start.bytesInUse());
+
+  // list nodes go to their own tag, with the allocator rebound
+  std::list<int, lar::TaggedAllocator<int, ListTag>> l { 1, 2, 3 };
+  BOOST_CHECK_EQUAL(Accounting_t::GetCounts<ListTag>().allocations, 3U);
+  BOOST_CHECK_EQUAL(Accounting_t::GetCounts<VectorTag>().allocations,
+    end.allocations);
+
+  // the tags are listed by name
+  bool foundVector = false, foundList = false;
+  for (auto const& [ name, counts ]: Accounting_t::GetCounts()) {
+    if (name == "vector") foundVector = true;
+    if (name == "list") {
+      foundList = true;
+      BOOST_CHECK_EQUAL(counts.allocations, 3U);
+    }
+  } // for
+  BOOST_CHECK(foundVector);
+  BOOST_CHECK(foundList);
+
+} // RunCountingTest()
+
+
+//------------------------------------------------------------------------------
+void RunScopeTest() {
+
+  using Accounting_t = lar::AllocationAccounting;
+
+  std::size_t const id = Accounting_t::tagID<VectorTag>();
+
+  Accounting_t::Scope_t scope;
+  scope.clear();
+  BOOST_CHECK(!Accounting_t::setScope(&scope));
+
+  lar::TaggedVector<int, VectorTag> v(10U);
+
+  // allocations from other threads are not in this scope
+  std::thread([](){ lar::TaggedVector<int, VectorTag> w(5U); }).join();
+
+  BOOST_CHECK_EQUAL(Accounting_t::setScope(nullptr), &scope);
+  BOOST_CHECK_EQUAL(scope.counts[id].allocations, 1U);
+  BOOST_CHECK_EQUAL(scope.counts[id].allocatedBytes, 10U * sizeof(int));
+  BOOST_CHECK_EQUAL(scope.counts[id].deallocations, 0U);
+
+  // explicit accounting
+  Accounting_t::setScope(&scope);
+  Accounting_t::recordAllocation<VectorTag>(64U);
+  Accounting_t::recordDeallocation<VectorTag>(64U);
+  Accounting_t::setScope(nullptr);
+  BOOST_CHECK_EQUAL(scope.counts[id].allocations, 2U);
+  BOOST_CHECK_EQUAL(scope.counts[id].deallocations, 1U);
+  BOOST_CHECK_EQUAL(scope.counts[id].freedBytes, 64U);
+
+} // RunScopeTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(CountingTestCase) {
+  RunCountingTest();
+} // CountingTestCase
+
+BOOST_AUTO_TEST_CASE(ScopeTestCase) {
+  RunScopeTest();
+} // ScopeTestCase
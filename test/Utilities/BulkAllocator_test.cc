@@ -13,7 +13,10 @@
 
 // C/C++ standard libraries
 #include <map>
+#include <list>
 #include <random>
+#include <thread>
+#include <vector>
 
 // Boost libraries
 /*
@@ -37,6 +40,19 @@
 constexpr unsigned int RandomSeed = 12345;
 
 
+/// A node of a singly linked list, allocated one at a time
+struct ListNode_t {
+  ListNode_t* next;
+  long int value;
+}; // ListNode_t
+
+/// Another node type, so that each test has its own global allocator
+struct TreeNode_t {
+  TreeNode_t* next;
+  double value[3];
+}; // TreeNode_t
+
+
 //------------------------------------------------------------------------------
 //--- Test code
 //
@@ -128,6 +144,240 @@ void RunHoughTransformTreeTest() {
 } // RunHoughTransformTreeTest()
 
 
+/**
+ * @brief Tests the allocator from several threads at the same time
+ *
+ * Each thread fills its own list, and the content of all the lists is checked
+ * after all the threads are done.
+ * The allocated memory is also checked to be released with the last user.
+ */
+void RunConcurrentFillTest() {
+
+  constexpr unsigned int NThreads = 8;
+  constexpr unsigned int NElements = 200000;
+
+  using Allocator_t = lar::BulkAllocator<unsigned int>;
+  using List_t = std::list<unsigned int, Allocator_t>;
+
+  {
+    std::vector<List_t> lists(NThreads);
+
+    std::vector<std::thread> threads;
+    for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+      threads.emplace_back([&lists, iThread](){
+        for (unsigned int i = 0; i < NElements; ++i)
+          lists[iThread].push_back(iThread * NElements + i);
+      });
+    } // for
+    for (auto& thread: threads) thread.join();
+
+    for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+      List_t const& list = lists[iThread];
+      BOOST_CHECK_EQUAL(list.size(), NElements);
+      unsigned int expected = iThread * NElements;
+      bool bSame = true;
+      for (unsigned int value: list) bSame = bSame && (value == expected++);
+      BOOST_CHECK(bSame);
+    } // for
+  }
+
+} // RunConcurrentFillTest()
+
+
+/**
+ * @brief Tests the counting of the users by copies of the allocator
+ *
+ * A copy of an allocator (even a temporary one) must not be able to free the
+ * memory that other allocators still use.
+ */
+void RunUserCountTest() {
+
+  using Allocator_t = lar::BulkAllocator<double>;
+
+  Allocator_t allocator(100);
+  double* values = allocator.allocate(10);
+  for (int i = 0; i < 10; ++i) values[i] = i;
+
+  {
+    Allocator_t copy(allocator);
+    lar::BulkAllocator<float> converted(allocator);
+    Allocator_t moved(std::move(copy));
+  } // copies go out of scope here
+
+  // still the same memory
+  double* more = allocator.allocate(10);
+  BOOST_CHECK_EQUAL(more, values + 10);
+  bool bSame = true;
+  for (int i = 0; i < 10; ++i) bSame = bSame && (values[i] == double(i));
+  BOOST_CHECK(bSame);
+
+} // RunUserCountTest()
+
+
+/**
+ * @brief Tests the reuse of deallocated memory
+ *
+ * Containers are filled and destroyed many times (as it happens event by
+ * event): the memory must not grow, and empty chunks must be returned.
+ */
+void RunReleaseTest() {
+
+  using Allocator_t = lar::BulkAllocator<long int>;
+
+  Allocator_t allocator(1000);
+
+  // single elements are reused
+  long int* first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  BOOST_CHECK_EQUAL(allocator.allocate(1), first);
+  allocator.deallocate(first, 1);
+
+  // the list nodes are allocated with an allocator of a different type,
+  // which shares the chunk size of ours; it also keeps the node memory from
+  // being all freed at each event
+  using NodeAllocator_t = std::allocator_traits<Allocator_t>::rebind_alloc
+    <ListNode_t>;
+  NodeAllocator_t nodeAllocator(allocator);
+
+  unsigned int nReports = 0;
+  NodeAllocator_t::SetReporter
+    ([&nReports](std::array<std::size_t, 2> const&){ ++nReports; }, 5);
+
+  std::size_t maxChunks = 0;
+  for (int iEvent = 0; iEvent < 50; ++iEvent) {
+    ListNode_t* head = nullptr;
+    for (long int i = 0; i < 10000; ++i) {
+      ListNode_t* node = nodeAllocator.allocate(1);
+      *node = ListNode_t{ head, i };
+      head = node;
+    } // for
+    maxChunks = std::max(maxChunks, NodeAllocator_t::NChunks());
+    while (head) {
+      ListNode_t* next = head->next;
+      nodeAllocator.deallocate(head, 1);
+      head = next;
+    } // while
+  } // for
+
+  // one event takes 10 chunks of 1000 nodes
+  BOOST_CHECK_LE(maxChunks, 11U);
+
+  // all but the chunk currently allocated from have been returned,
+  // and nothing is in use
+  std::array<std::size_t, 2> const counts = NodeAllocator_t::GetCounts();
+  BOOST_CHECK_EQUAL(NodeAllocator_t::NChunks(), 1U);
+  BOOST_CHECK_EQUAL(counts[0], 0U);
+  BOOST_CHECK_EQUAL(counts[1], 1000U);
+
+  BOOST_CHECK_GT(nReports, 0U);
+  NodeAllocator_t::SetReporter({}); // no more reports
+
+} // RunReleaseTest()
+
+
+/**
+ * @brief Tests that the headers of returned chunks are deleted
+ *
+ * Many events return their chunks: the number of chunk headers must stay
+ * bounded, also when the events are processed by concurrent threads.
+ */
+void RunHeaderReclamationTest() {
+
+  using Allocator_t = lar::BulkAllocator<TreeNode_t>;
+
+  Allocator_t allocator(100);
+
+  // an event fills 10 chunks, and has 2 requests larger than a chunk
+  auto processEvent = [&allocator](){
+    TreeNode_t* head = nullptr;
+    for (int i = 0; i < 1000; ++i) {
+      TreeNode_t* node = allocator.allocate(1);
+      node->next = head;
+      head = node;
+    } // for
+    TreeNode_t* large1 = allocator.allocate(250);
+    TreeNode_t* large2 = allocator.allocate(400);
+    allocator.deallocate(large1, 250);
+    while (head) {
+      TreeNode_t* next = head->next;
+      allocator.deallocate(head, 1);
+      head = next;
+    } // while
+    allocator.deallocate(large2, 400);
+  };
+
+  std::size_t maxHeaders = 0;
+  for (int iEvent = 0; iEvent < 3000; ++iEvent) {
+    processEvent();
+    maxHeaders = std::max(maxHeaders, Allocator_t::NChunkHeaders());
+  } // for
+  // the headers of an event, plus the first of the list (never unlinked)
+  BOOST_CHECK_LE(maxHeaders, 14U);
+  BOOST_CHECK_LE(Allocator_t::NChunkHeaders(), Allocator_t::NChunks() + 1U);
+
+  std::vector<std::thread> threads;
+  for (int iThread = 0; iThread < 4; ++iThread) {
+    threads.emplace_back([&processEvent](){
+      for (int iEvent = 0; iEvent < 500; ++iEvent) processEvent();
+    });
+  }
+  for (auto& thread: threads) thread.join();
+
+  // headers left by a sweep during walks of other threads go with this one
+  processEvent();
+  BOOST_CHECK_LE(Allocator_t::NChunkHeaders(), Allocator_t::NChunks() + 1U);
+  BOOST_CHECK_EQUAL(Allocator_t::GetCounts()[0], 0U);
+
+} // RunHeaderReclamationTest()
+
+
+/**
+ * @brief Tests the NUMA node policy
+ *
+ * Chunks allocated by different threads are counted on the node of their
+ * thread, and the per-node counts add up to the total ones.
+ */
+void RunNodeLocalTest() {
+
+  using Allocator_t = lar::BulkAllocator<double>;
+
+  Allocator_t::SetNodeLocal(true);
+  BOOST_CHECK(Allocator_t::IsNodeLocal());
+
+  Allocator_t allocator(5000, true); // preallocated (and touched) here
+
+  std::vector<std::thread> threads;
+  for (int iThread = 0; iThread < 4; ++iThread) {
+    threads.emplace_back([&allocator](){
+      allocator.deallocate(allocator.allocate(100), 100);
+      // fill a chunk and free it: it is reused only from its node
+      std::vector<double*> values;
+      for (int i = 0; i < 6000; ++i) values.push_back(allocator.allocate(1));
+      for (double* value: values) allocator.deallocate(value, 1);
+    });
+  }
+  for (auto& thread: threads) thread.join();
+
+  auto const nodeCounts = Allocator_t::GetNodeCounts();
+  std::array<std::size_t, 2> const counts = Allocator_t::GetCounts();
+  std::array<std::size_t, 2> total = {{ 0U, 0U }};
+  for (auto const& nodeCount: nodeCounts) {
+    total[0] += nodeCount[0];
+    total[1] += nodeCount[1];
+  }
+  BOOST_CHECK_EQUAL(total[0], counts[0]);
+  BOOST_CHECK_EQUAL(total[1], counts[1]);
+  BOOST_CHECK_EQUAL(counts[0], 0U);
+
+  // the chunk preallocated by this thread is still here
+  BOOST_CHECK(!nodeCounts.empty());
+  BOOST_CHECK_GE(counts[1], 5000U);
+
+  Allocator_t::SetNodeLocal(false);
+
+} // RunNodeLocalTest()
+
+
 //------------------------------------------------------------------------------
 //--- registration of tests
 //
@@ -141,3 +391,23 @@ BOOST_AUTO_TEST_CASE(RunHoughTransformTree) {
   RunHoughTransformTreeTest();
   std::cout << "Done." << std::endl;
 }
+
+BOOST_AUTO_TEST_CASE(RunConcurrentFill) {
+  RunConcurrentFillTest();
+}
+
+BOOST_AUTO_TEST_CASE(RunUserCount) {
+  RunUserCountTest();
+}
+
+BOOST_AUTO_TEST_CASE(RunRelease) {
+  RunReleaseTest();
+}
+
+BOOST_AUTO_TEST_CASE(RunHeaderReclamation) {
+  RunHeaderReclamationTest();
+}
+
+BOOST_AUTO_TEST_CASE(RunNodeLocal) {
+  RunNodeLocalTest();
+}
@@ -23,7 +23,10 @@
 #include "lardata/Utilities/ChiSquareAccumulator.h"
 
 // C/C++ standard libraries
+#include <array>
+#include <stdexcept> // std::length_error
 #include <type_traits> // std::is_same<>
+#include <vector>
 
 
 //------------------------------------------------------------------------------
@@ -63,6 +66,72 @@ void testChiSquareAccumulator() {
 } // testChiSquareAccumulator()
 
 
+//------------------------------------------------------------------------------
+void testChiSquareAccumulatorSequences() {
+
+  auto line = [](double x){ return 2.0 - x; };
+
+  // enough points to fill a few blocks, plus a partial one
+  constexpr std::size_t N = 1000U;
+  std::vector<double> xs, ys, sigmas;
+  for (std::size_t i = 0; i < N; ++i) {
+    xs.push_back(0.01 * i);
+    ys.push_back(line(xs.back()) + ((i % 3) - 1.0) * 0.1);
+    sigmas.push_back(0.5 + 0.001 * i);
+  } // for
+
+  auto single = lar::util::makeChiSquareAccumulator(line);
+  auto singleUnit = lar::util::makeChiSquareAccumulator(line);
+  for (std::size_t i = 0; i < N; ++i) {
+    single.add(xs[i], ys[i], sigmas[i]);
+    singleUnit.add(xs[i], ys[i]);
+  }
+
+  auto batch = lar::util::makeChiSquareAccumulator(line);
+  batch.add(xs, ys, sigmas);
+  BOOST_CHECK_EQUAL(batch.N(), N);
+  BOOST_CHECK_CLOSE(batch(), single(), 1e-8);
+
+  auto batchUnit = lar::util::makeChiSquareAccumulator(line);
+  batchUnit.add(xs, ys);
+  BOOST_CHECK_EQUAL(batchUnit.N(), N);
+  BOOST_CHECK_CLOSE(batchUnit(), singleUnit(), 1e-8);
+
+  // C arrays and sequences of a different type
+  std::array<float, 3U> const fx { 0.0F, 1.0F, 2.0F };
+  double const y[3] = { 1.0, 1.0, 1.0 };
+  double const s[3] = { 0.5, 0.5, 0.5 };
+  auto small = lar::util::makeChiSquareAccumulator(line);
+  small.add(fx, y, s);
+  BOOST_CHECK_EQUAL(small.N(), 3U);
+  BOOST_CHECK_CLOSE(small(), 8.0, 1e-6);
+
+  // empty and mismatched sequences
+  small.add(std::vector<double>{}, std::vector<double>{});
+  BOOST_CHECK_EQUAL(small.N(), 3U);
+  BOOST_CHECK_THROW(small.add(xs, ys, fx), std::length_error);
+
+  // merge of partial accumulators
+  std::size_t const half = N / 3;
+  auto first = lar::util::makeChiSquareAccumulator(line);
+  auto second = lar::util::makeChiSquareAccumulator(line);
+  for (std::size_t i = 0; i < half; ++i) first.add(xs[i], ys[i], sigmas[i]);
+  second.add(
+    std::vector<double>(xs.begin() + half, xs.end()),
+    std::vector<double>(ys.begin() + half, ys.end()),
+    std::vector<double>(sigmas.begin() + half, sigmas.end())
+    );
+  first.merge(second);
+  BOOST_CHECK_EQUAL(first.N(), N);
+  BOOST_CHECK_CLOSE(first(), single(), 1e-8);
+
+  first.clear();
+  BOOST_CHECK_EQUAL(first.N(), 0U);
+  BOOST_CHECK_EQUAL(first(), 0.0);
+
+} // testChiSquareAccumulatorSequences()
+
+
 //------------------------------------------------------------------------------
 void testChiSquareAccumulator_documentation() {
   /*
@@ -151,6 +220,7 @@ void testMakeChiSquareAccumulator_documentation2() {
 BOOST_AUTO_TEST_CASE(ChiSquareAccumulatorTestCase) {
 
   testChiSquareAccumulator();
+  testChiSquareAccumulatorSequences();
   testChiSquareAccumulator_documentation();
   testMakeChiSquareAccumulator_documentation1();
   testMakeChiSquareAccumulator_documentation2();
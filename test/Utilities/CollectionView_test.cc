@@ -16,12 +16,16 @@
 #include <boost/test/test_tools.hpp> // BOOST_CHECK()
 
 // C/C++ standard libraries
+#include <algorithm> // std::sort()
 #include <deque>
 #include <list>
 #include <forward_list>
 #include <numeric> // std::iota()
 #include <sstream>
 #include <iostream>
+#include <iterator> // std::iterator_traits
+#include <type_traits> // std::is_same<>
+#include <cstddef> // std::ptrdiff_t
 
 
 //------------------------------------------------------------------------------
@@ -212,6 +216,52 @@ BOOST_AUTO_TEST_CASE(ForwardListTestCase) {
 } // BOOST_AUTO_TEST_CASE(ForwardListTestCase)
 
 
+//------------------------------------------------------------------------------
+/// End of a range of integers, with a type different from its begin.
+struct IntSentinel { int const* ptr; };
+
+std::ptrdiff_t operator- (IntSentinel const& end, int const* begin)
+  { return end.ptr - begin; }
+
+bool operator!= (int const* begin, IntSentinel const& end)
+  { return begin != end.ptr; }
+
+
+BOOST_AUTO_TEST_CASE(SentinelTestCase) {
+  //
+  // test on random access collection with a different type of end iterator
+  //
+  std::vector<int> c{ 5, 3, 4 };
+  int const* const cbegin = c.data();
+  IntSentinel const cend{ c.data() + c.size() };
+
+  auto cv = lar::makeCollectionView(cbegin, cend);
+
+  // the end iterator is turned into a begin one, random access is kept
+  static_assert(std::is_same<decltype(cv.cend()), decltype(cv.cbegin())>());
+  static_assert(std::is_same<
+    decltype(cv)::iterator_category, std::random_access_iterator_tag
+    >());
+
+  BOOST_CHECK_EQUAL(cv.empty(), c.empty());
+  BOOST_CHECK_EQUAL(cv.size(), c.size());
+  BOOST_CHECK_EQUAL(cv.cend(), c.data() + c.size());
+  BOOST_CHECK_EQUAL(cv.data(), c.data());
+  BOOST_CHECK_EQUAL(&(cv.back()), &(c.back()));
+
+  // can be used with algorithms requiring random access iterators
+  std::vector<int> sorted(cv.begin(), cv.end());
+  std::sort(sorted.begin(), sorted.end());
+  BOOST_CHECK_EQUAL(sorted.front(), 3);
+  BOOST_CHECK_EQUAL(sorted.back(), 5);
+
+  auto const emptyView = lar::makeCollectionView(cbegin, IntSentinel{ cbegin });
+  BOOST_CHECK(emptyView.empty());
+  BOOST_CHECK_EQUAL(emptyView.size(), 0U);
+
+} // BOOST_AUTO_TEST_CASE(SentinelTestCase)
+
+
 //------------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE(DocumentationTestCase) {
 
@@ -0,0 +1,133 @@
+/**
+ * @file    ConcurrentCountersMap_test.cc
+ * @brief   Tests the concurrent counter map
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/ConcurrentCountersMap.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard libraries
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ConcurrentCountersMap_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/ConcurrentCountersMap.h"
+
+
+//------------------------------------------------------------------------------
+void RunSingleThreadTest() {
+
+  lar::ConcurrentCountersMap<int, int, 8> cm;
+  BOOST_CHECK(cm.empty());
+  BOOST_CHECK(cm.begin() == cm.end());
+
+  BOOST_CHECK_EQUAL(cm.increment(5), 1);
+  BOOST_CHECK_EQUAL(cm.increment(5), 2);
+  BOOST_CHECK_EQUAL(cm.decrement(-3), -1);
+  BOOST_CHECK_EQUAL(cm.add(20, 4), 4);
+  BOOST_CHECK_EQUAL(cm.set(21, 7), 7);
+
+  BOOST_CHECK(!cm.empty());
+  BOOST_CHECK_EQUAL(cm.n_counters(), 3U * 8U); // blocks -8, 0 and 16
+  BOOST_CHECK_EQUAL(cm[5], 2);
+  BOOST_CHECK_EQUAL(cm[-3], -1);
+  BOOST_CHECK_EQUAL(cm[6], 0);
+  BOOST_CHECK_EQUAL(cm[1000], 0);
+
+  std::map<int, int> expected { { -3, -1 }, { 5, 2 }, { 20, 4 }, { 21, 7 } };
+  BOOST_CHECK(cm.is_equal(expected));
+
+  // iteration in key order, all the counters of the blocks
+  int nextKey = -8;
+  for (auto const p: cm) {
+    BOOST_CHECK_EQUAL(p.first, nextKey);
+    auto const iExpected = expected.find(p.first);
+    BOOST_CHECK_EQUAL
+      (p.second, (iExpected == expected.end())? 0: iExpected->second);
+    if (++nextKey == 8) nextKey = 16;
+  }
+  BOOST_CHECK_EQUAL(nextKey, 24);
+
+  expected[6] = 1;
+  BOOST_CHECK(!cm.is_equal(expected));
+
+  cm.clear();
+  BOOST_CHECK(cm.empty());
+  BOOST_CHECK_EQUAL(cm[5], 0);
+
+} // RunSingleThreadTest()
+
+
+/**
+ * @brief Fills the map from many threads, while another thread iterates it
+ *
+ * The content must match the one of a STL map filled with the same keys.
+ */
+void RunConcurrentFillTest() {
+
+  constexpr unsigned int NThreads = 8;
+  constexpr unsigned int NEntries = 100000;
+  constexpr int KeyRange = 20000;
+
+  // each thread fills the same keys, with the same seed
+  std::map<int, unsigned int> expected;
+  std::vector<int> keys;
+  std::default_random_engine random_engine(12345);
+  std::uniform_int_distribution<int> uniform(-KeyRange, KeyRange);
+  for (unsigned int i = 0; i < NEntries; ++i) {
+    keys.push_back(uniform(random_engine));
+    expected[keys.back()] += NThreads;
+  }
+
+  lar::ConcurrentCountersMap<int, unsigned int, 16, 8> cm;
+
+  std::atomic<bool> done { false };
+  unsigned int nScans = 0;
+  bool scansOk = true;
+  std::thread reader([&](){
+    do {
+      // counts only grow: a scan must never see more than the final count
+      for (auto const p: cm) {
+        auto const iExpected = expected.find(p.first);
+        unsigned int const max
+          = (iExpected == expected.end())? 0U: iExpected->second;
+        if (p.second > max) scansOk = false;
+      }
+      ++nScans;
+    } while (!done);
+  });
+
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&cm, &keys](){
+      for (int key: keys) cm.increment(key);
+    });
+  }
+  for (auto& thread: threads) thread.join();
+  done = true;
+  reader.join();
+
+  BOOST_CHECK(scansOk);
+  BOOST_CHECK_GT(nScans, 0U);
+  BOOST_CHECK(cm.is_equal(expected));
+
+} // RunConcurrentFillTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RunSingleThread) {
+  RunSingleThreadTest();
+}
+
+BOOST_AUTO_TEST_CASE(RunConcurrentFill) {
+  RunConcurrentFillTest();
+}
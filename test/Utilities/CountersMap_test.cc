@@ -12,7 +12,9 @@
  */
 
 // C/C++ standard libraries
+#include <cstdlib> // std::abs()
 #include <map>
+#include <memory> // std::allocator<>
 #include <random>
 #include <iostream>
 
@@ -176,6 +178,112 @@ void RunHoughTransformTreeTest() {
 } // RunHoughTransformTreeTest()
 
 
+/**
+ * @brief Tests the dense storage against a STL map
+ *
+ * Keys are added in no particular order, including negative keys and keys
+ * below the lowest one added so far, so that the storage grows in both
+ * directions.
+ */
+void RunDenseStorageTest() {
+
+  constexpr unsigned int NEntries = 100000;
+  constexpr int KeyRange = 5000;
+
+  std::map<int, int> stl_map;
+  lar::DenseCountersMap<int, int, 8> dense_map;
+  lar::CountersMap<int, int, 8> tree_map;
+  BOOST_CHECK(dense_map.empty());
+
+  static std::default_random_engine random_engine(RandomSeed);
+  std::uniform_int_distribution<int> uniform(-KeyRange, KeyRange);
+
+  // first a descending sequence, then random keys
+  for (int key = 100; key > -100; key -= 7) {
+    ++(stl_map[key]);
+    dense_map.increment(key);
+    tree_map.increment(key);
+  }
+  for (unsigned int iEntry = 0; iEntry < NEntries; ++iEntry) {
+    int const key = uniform(random_engine);
+    ++(stl_map[key]);
+    dense_map.increment(key);
+    tree_map.increment(key);
+    if (iEntry % 10 == 0) {
+      --(stl_map[key]);
+      dense_map.decrement(key);
+      tree_map.decrement(key);
+    }
+  } // for
+  stl_map[-2*KeyRange] = 5;
+  dense_map.set(-2*KeyRange, 5);
+  tree_map.set(-2*KeyRange, 5);
+
+  BOOST_CHECK(!dense_map.empty());
+  BOOST_CHECK(dense_map.is_equal(stl_map));
+  BOOST_CHECK_EQUAL(dense_map.n_counters(), tree_map.n_counters());
+  BOOST_CHECK_EQUAL(dense_map[-2*KeyRange], 5);
+  BOOST_CHECK_EQUAL(dense_map[-2*KeyRange + 1], 0);
+  BOOST_CHECK_EQUAL(dense_map[-2*KeyRange - 1], 0);
+  BOOST_CHECK_EQUAL(dense_map[3*KeyRange], 0);
+
+  // the two storages must yield the same counters in the same order
+  auto iTree = tree_map.begin();
+  for (auto p: dense_map) {
+    BOOST_REQUIRE(iTree != tree_map.end());
+    BOOST_CHECK_EQUAL(p.first, (*iTree).first);
+    BOOST_CHECK_EQUAL(p.second, (*iTree).second);
+    ++iTree;
+  } // for
+  BOOST_CHECK(iTree == tree_map.end());
+
+  stl_map[KeyRange / 2]++;
+  BOOST_CHECK(!dense_map.is_equal(stl_map));
+
+} // RunDenseStorageTest()
+
+
+/**
+ * @brief Tests counters split into subcounters
+ *
+ * Each `unsigned char` counter holds four 2-bit subcounters, which are
+ * independent and wrap at 4.
+ */
+template <typename STORAGE>
+void RunSubcountersTest() {
+
+  using CountersMap_t = lar::CountersMap<
+    int, unsigned char, 4, std::allocator<std::pair<const int, unsigned char>>,
+    4, STORAGE
+    >;
+  CountersMap_t cm;
+
+  // 16 subcounters per block
+  BOOST_CHECK_EQUAL(CountersMap_t::NSubcounters, 16U);
+
+  std::map<int, unsigned char> expected;
+  for (int key = -20; key < 40; ++key) {
+    unsigned char const n = (unsigned char)(std::abs(key) % 7);
+    for (unsigned char i = 0; i < n; ++i) cm.increment(key);
+    expected[key] = n % 4;
+  } // for
+  for (auto const& p: expected)
+    BOOST_CHECK_EQUAL(int(cm[p.first]), int(p.second));
+  BOOST_CHECK(cm.is_equal(expected));
+  BOOST_CHECK_EQUAL(cm.n_counters(), 80U); // keys from -32 to 47
+
+  // wrap downward and setting values out of range
+  cm.set(5, 0);
+  BOOST_CHECK_EQUAL(int(cm.decrement(5)), 3);
+  BOOST_CHECK_EQUAL(int(cm.set(6, 6)), 2);
+  BOOST_CHECK_EQUAL(int(cm[6]), 2);
+  // neighbours are unaffected
+  BOOST_CHECK_EQUAL(int(cm[4]), int(expected[4]));
+  BOOST_CHECK_EQUAL(int(cm[7]), int(expected[7]));
+
+} // RunSubcountersTest()
+
+
 //------------------------------------------------------------------------------
 //--- registration of tests
 //
@@ -189,3 +297,12 @@ BOOST_AUTO_TEST_CASE(RunHoughTransformTree) {
   RunHoughTransformTreeTest();
   std::cout << "Done." << std::endl;
 }
+
+BOOST_AUTO_TEST_CASE(RunDenseStorage) {
+  RunDenseStorageTest();
+}
+
+BOOST_AUTO_TEST_CASE(RunSubcounters) {
+  RunSubcountersTest<lar::counters_map::MapStorage>();
+  RunSubcountersTest<lar::counters_map::DenseStorage>();
+}
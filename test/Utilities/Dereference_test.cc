@@ -11,6 +11,8 @@
 // static tests
 #include <type_traits>
 #include <memory>
+#include <vector>
+#include <cstddef> // std::size_t
 
 // Boost libraries
 /*
@@ -171,6 +173,25 @@ static_assert(std::is_same<
   );
 
 
+//------------------------------------------------------------------------------
+// custom pointer to an element of a "data product" (like `art::Ptr`);
+// each dereference is counted
+struct MyProductPtr {
+	std::vector<int> const* product = nullptr;
+	int productID = -1;
+	std::size_t index = 0;
+
+	static unsigned int nDereferences;
+
+	int id() const { return productID; }
+	std::size_t key() const { return index; }
+	bool isNull() const { return product == nullptr; }
+	int const& operator* () const { ++nDereferences; return (*product)[index]; }
+}; // struct MyProductPtr
+
+unsigned int MyProductPtr::nDereferences = 0U;
+
+
 //******************************************************************************
 //***  testing starts here;
 //***  still mostly a compilation test
@@ -200,6 +221,45 @@ void test() {
 } // test<>()
 
 
+//------------------------------------------------------------------------------
+void pointer_table_test() {
+
+  std::vector<int> const productA { 0, 1, 2, 3, 4 };
+  std::vector<int> const productB { 10, 11, 12 };
+
+  std::vector<MyProductPtr> const ptrs {
+    { &productA, 1, 3 }, { &productB, 2, 2 }, { &productA, 1, 0 },
+    { nullptr, -1, 0 }, { &productB, 2, 0 }, { &productA, 1, 4 }
+  };
+  std::vector<int const*> const expected {
+    &productA[3], &productB[2], &productA[0],
+    nullptr, &productB[0], &productA[4]
+  };
+
+  MyProductPtr::nDereferences = 0U;
+  auto const table = lar::util::make_product_pointer_table(ptrs);
+  static_assert
+    (std::is_same<decltype(table), std::vector<int const*> const>::value);
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (table.begin(), table.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(MyProductPtr::nDereferences, 2U); // one per product
+
+  std::vector<MyProductPtr> const simplePtrs
+    { { &productA, 1, 2 }, { &productB, 2, 1 } };
+  MyProductPtr::nDereferences = 0U;
+  auto const simpleTable = lar::util::make_pointer_table(simplePtrs);
+  BOOST_CHECK_EQUAL(simpleTable.size(), 2U);
+  BOOST_CHECK_EQUAL(simpleTable[0], &productA[2]);
+  BOOST_CHECK_EQUAL(simpleTable[1], &productB[1]);
+  BOOST_CHECK_EQUAL(MyProductPtr::nDereferences, 2U); // one per pointer
+
+  // values are their own pointers
+  auto const valueTable = lar::util::make_pointer_table(productB);
+  BOOST_CHECK_EQUAL(valueTable[1], &productB[1]);
+
+} // pointer_table_test()
+
+
 //******************************************************************************
 BOOST_AUTO_TEST_CASE(TestInt) {
   test<int>();
@@ -208,3 +268,7 @@ BOOST_AUTO_TEST_CASE(TestInt) {
 BOOST_AUTO_TEST_CASE(TestConstInt) {
   test<const int>();
 }
+
+BOOST_AUTO_TEST_CASE(TestPointerTables) {
+  pointer_table_test();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file    DeterministicReduce_test.cc
+ * @brief   Tests the reproducibility of `lar::util::deterministicReduce()`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/DeterministicReduce.h`
+ *
+ * The same reductions are run with one and with several threads, and their
+ * results are required to be identical, bit by bit.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/DeterministicReduce.h"
+#include "lardata/Utilities/SimpleFits.h"
+#include "lardata/Utilities/ChiSquareAccumulator.h"
+#include "lardata/Utilities/CountersMap.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( DeterministicReduce_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+#include <boost/test/floating_point_comparison.hpp> // BOOST_CHECK_CLOSE()
+
+// TBB libraries
+#include "tbb/task_arena.h"
+
+// C/C++ standard libraries
+#include <cmath> // std::pow()
+#include <cstring> // std::memcmp()
+#include <map>
+#include <random>
+#include <stdexcept> // std::logic_error
+#include <vector>
+
+
+namespace {
+
+  constexpr std::size_t NPoints = 100003U; // not a multiple of the chunk size
+  constexpr std::size_t ChunkSize = 1000U;
+  constexpr unsigned int NThreads = 8U;
+
+  /// Points with a wide range of magnitudes, to make rounding matter
+  struct Points_t {
+    std::vector<double> x, y, s;
+
+    Points_t()
+      {
+        std::mt19937 gen(1234);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (std::size_t i = 0; i < NPoints; ++i) {
+          x.push_back(1e3 * uniform(gen));
+          y.push_back(2.0 - 0.5 * x.back() + std::pow(10.0, 4.0 * uniform(gen)));
+          s.push_back(0.1 + uniform(gen));
+        }
+      }
+  }; // Points_t
+
+  /// Runs `f` in a task arena with the specified number of threads
+  template <typename F>
+  auto inArena(unsigned int nThreads, F f)
+    { tbb::task_arena arena(nThreads); return arena.execute(f); }
+
+  /// Returns whether the two values have the same bits
+  bool sameBits(double a, double b)
+    { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void LinearFitReproducibilityTest() {
+
+  using Fit_t = lar::util::LinearFit<double>;
+  Points_t const points;
+
+  auto const reduce = [&points](){
+    return lar::util::deterministicReduce(NPoints, ChunkSize, Fit_t(),
+      [&points](Fit_t& fit, std::size_t b, std::size_t e)
+        {
+          for (std::size_t i = b; i < e; ++i)
+            fit.add(points.x[i], points.y[i], points.s[i]);
+        }
+      );
+  };
+
+  Fit_t const serial = inArena(1U, reduce);
+  Fit_t const parallel = inArena(NThreads, reduce);
+
+  BOOST_CHECK_EQUAL(serial.N(), NPoints);
+  BOOST_CHECK_EQUAL(parallel.N(), NPoints);
+  BOOST_CHECK(sameBits(serial.Slope(), parallel.Slope()));
+  BOOST_CHECK(sameBits(serial.Intercept(), parallel.Intercept()));
+  BOOST_CHECK(sameBits(serial.ChiSquare(), parallel.ChiSquare()));
+
+  // the result is the one of filling a single fit, up to rounding
+  Fit_t single;
+  for (std::size_t i = 0; i < NPoints; ++i)
+    single.add(points.x[i], points.y[i], points.s[i]);
+  BOOST_CHECK_CLOSE(parallel.Slope(), single.Slope(), 1e-6);
+  BOOST_CHECK_CLOSE(parallel.Intercept(), single.Intercept(), 1e-6);
+
+} // LinearFitReproducibilityTest()
+
+
+//------------------------------------------------------------------------------
+void ChiSquareReproducibilityTest() {
+
+  Points_t const points;
+  auto line = [](double x){ return 2.0 - 0.5 * x; };
+  auto const empty = lar::util::makeChiSquareAccumulator(line);
+  using Acc_t = decltype(empty);
+
+  auto const reduce = [&](){
+    return lar::util::deterministicReduce(NPoints, ChunkSize, empty,
+      [&points](auto& chiSquare, std::size_t b, std::size_t e)
+        {
+          for (std::size_t i = b; i < e; ++i)
+            chiSquare.add(points.x[i], points.y[i], points.s[i]);
+        }
+      );
+  };
+
+  Acc_t const serial = inArena(1U, reduce);
+  Acc_t const parallel = inArena(NThreads, reduce);
+
+  BOOST_CHECK_EQUAL(serial.N(), NPoints);
+  BOOST_CHECK_EQUAL(parallel.N(), NPoints);
+  BOOST_CHECK(sameBits(serial(), parallel()));
+
+  auto single = lar::util::makeChiSquareAccumulator(line);
+  single.add(points.x, points.y, points.s);
+  BOOST_CHECK_CLOSE(parallel(), single(), 1e-10);
+
+  // the same, with the merge explicitly specified and a single chunk
+  auto const oneChunk = lar::util::deterministicReduce(NPoints, NPoints, empty,
+    [&points](auto& chiSquare, std::size_t b, std::size_t e)
+      {
+        for (std::size_t i = b; i < e; ++i)
+          chiSquare.add(points.x[i], points.y[i], points.s[i]);
+      },
+    [](auto& into, auto const& from){ into.merge(from); }
+    );
+  BOOST_CHECK_EQUAL(oneChunk.N(), NPoints);
+  BOOST_CHECK_CLOSE(oneChunk(), single(), 1e-10);
+
+} // ChiSquareReproducibilityTest()
+
+
+//------------------------------------------------------------------------------
+void CountersMapReductionTest() {
+
+  using Counters_t = lar::CountersMap<int, unsigned int, 16>;
+  std::vector<int> keys;
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> uniform(-500, 2000);
+  std::map<int, unsigned int> expected;
+  for (std::size_t i = 0; i < NPoints; ++i) {
+    keys.push_back(uniform(gen));
+    ++expected[keys.back()];
+  }
+
+  auto const reduce = [&keys](){
+    return lar::util::deterministicReduce(keys.size(), ChunkSize, Counters_t(),
+      [&keys](Counters_t& counters, std::size_t b, std::size_t e)
+        { for (std::size_t i = b; i < e; ++i) counters.increment(keys[i]); }
+      );
+  };
+
+  Counters_t const serial = inArena(1U, reduce);
+  Counters_t const parallel = inArena(NThreads, reduce);
+
+  int firstDifference = 0;
+  BOOST_CHECK(serial.is_equal(expected, firstDifference));
+  BOOST_CHECK(parallel.is_equal(expected, firstDifference));
+
+} // CountersMapReductionTest()
+
+
+//------------------------------------------------------------------------------
+void EdgeCasesTest() {
+
+  lar::util::LinearFit<double> const empty = lar::util::deterministicReduce(
+    0U, ChunkSize, lar::util::LinearFit<double>(),
+    [](lar::util::LinearFit<double>&, std::size_t, std::size_t){}
+    );
+  BOOST_CHECK_EQUAL(empty.N(), 0);
+
+  BOOST_CHECK_THROW(
+    lar::util::deterministicReduce(10U, 0U, lar::util::LinearFit<double>(),
+      [](lar::util::LinearFit<double>&, std::size_t, std::size_t){}
+      ),
+    std::logic_error
+    );
+
+} // EdgeCasesTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(LinearFitReproducibilityTestCase) {
+  LinearFitReproducibilityTest();
+}
+
+BOOST_AUTO_TEST_CASE(ChiSquareReproducibilityTestCase) {
+  ChiSquareReproducibilityTest();
+}
+
+BOOST_AUTO_TEST_CASE(CountersMapReductionTestCase) {
+  CountersMapReductionTest();
+}
+
+BOOST_AUTO_TEST_CASE(EdgeCasesTestCase) {
+  EdgeCasesTest();
+}
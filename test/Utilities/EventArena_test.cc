@@ -0,0 +1,154 @@
+/**
+ * @file    EventArena_test.cc
+ * @brief   Tests the event arena
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/EventArena.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard libraries
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( EventArena_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/EventArena.h"
+#include "lardata/Utilities/GridContainers.h"
+#include "lardata/Utilities/SharedArenaAllocator.h"
+
+
+//------------------------------------------------------------------------------
+void RunSingleThreadTest() {
+
+  lar::EventArena arena;
+  BOOST_CHECK_EQUAL(arena.nSubArenas(), 0U);
+
+  for (int event = 0; event < 3; ++event) {
+    std::pmr::vector<int> v(arena.allocator<int>());
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    BOOST_CHECK_EQUAL(v.size(), 1000U);
+    BOOST_CHECK_EQUAL(v[999], 999);
+    BOOST_CHECK(v.get_allocator().resource() == &arena);
+    BOOST_CHECK_EQUAL(arena.nSubArenas(), 1U);
+
+    // alignment is respected
+    void* p = arena.allocate(24, 64);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % 64, 0U);
+
+    v = std::pmr::vector<int>(arena.allocator<int>());
+    arena.release();
+  } // for events
+
+  // two arenas alternating in the same thread
+  lar::EventArena other;
+  std::pmr::vector<double> a(arena.allocator<double>());
+  std::pmr::vector<double> b(other.allocator<double>());
+  for (int i = 0; i < 100; ++i) {
+    a.push_back(i);
+    b.push_back(-i);
+  }
+  BOOST_CHECK_EQUAL(a[50], 50.0);
+  BOOST_CHECK_EQUAL(b[50], -50.0);
+  BOOST_CHECK_EQUAL(arena.nSubArenas(), 1U);
+  BOOST_CHECK_EQUAL(other.nSubArenas(), 1U);
+  BOOST_CHECK(!arena.is_equal(other));
+  BOOST_CHECK(arena.is_equal(arena));
+
+} // RunSingleThreadTest()
+
+
+//------------------------------------------------------------------------------
+void RunMultiThreadTest() {
+
+  constexpr unsigned int NThreads = 4;
+  constexpr std::size_t NAllocs = 10000;
+
+  lar::EventArena arena(4096);
+
+  for (int event = 0; event < 2; ++event) {
+    std::array<std::vector<int*>, NThreads> pointers;
+    std::vector<std::thread> threads;
+    for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+      threads.emplace_back([&arena, &pointers, iThread](){
+        std::vector<int*>& mine = pointers[iThread];
+        for (std::size_t i = 0; i < NAllocs; ++i) {
+          void* const mem = arena.allocate(sizeof(int), alignof(int));
+          int* p = static_cast<int*>(mem);
+          *p = int(iThread * NAllocs + i);
+          mine.push_back(p);
+        }
+      });
+    } // for threads
+    for (auto& thread: threads) thread.join();
+
+    // each thread has its own sub-arena
+    BOOST_CHECK_EQUAL(arena.nSubArenas(), NThreads);
+
+    // all the memory is distinct and still holds what was written
+    std::set<int*> all;
+    for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+      for (std::size_t i = 0; i < NAllocs; ++i) {
+        int* p = pointers[iThread][i];
+        BOOST_CHECK_EQUAL(*p, int(iThread * NAllocs + i));
+        all.insert(p);
+      }
+    }
+    BOOST_CHECK_EQUAL(all.size(), NThreads * NAllocs);
+
+    arena.release();
+  } // for events
+
+} // RunMultiThreadTest()
+
+
+//------------------------------------------------------------------------------
+void RunHelpersTest() {
+
+  // shared ownership, as used by `trkf::KHitContainer::setArena()`
+  std::shared_ptr<lar::SharedArena_t> shared = lar::makeEventArena();
+  auto p = lar::makeArenaShared<std::array<int, 4>>(shared);
+  (*p)[2] = 3;
+  shared.reset(); // `p` keeps the arena alive
+  BOOST_CHECK_EQUAL((*p)[2], 3);
+  p.reset();
+
+  // grid container with staged data in the arena
+  lar::EventArena arena;
+  util::GridContainer2D<int> grid({{ 3, 2 }}, &arena);
+  grid.stage({{ 1, 1 }}, 5);
+  grid.stage({{ 0, 0 }}, 7);
+  grid.stage({{ 1, 1 }}, 6);
+  grid.freeze();
+  BOOST_CHECK_EQUAL(arena.nSubArenas(), 1U);
+  auto const cell = grid.cellData({{ 1, 1 }});
+  BOOST_CHECK_EQUAL(cell.size(), 2U);
+  BOOST_CHECK_EQUAL(cell[0], 5);
+  BOOST_CHECK_EQUAL(cell[1], 6);
+  BOOST_CHECK_EQUAL(grid.cellData({{ 0, 0 }}).size(), 1U);
+  grid.clear();
+
+} // RunHelpersTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SingleThreadTestCase) {
+  RunSingleThreadTest();
+} // SingleThreadTestCase
+
+BOOST_AUTO_TEST_CASE(MultiThreadTestCase) {
+  RunMultiThreadTest();
+} // MultiThreadTestCase
+
+BOOST_AUTO_TEST_CASE(HelpersTestCase) {
+  RunHelpersTest();
+} // HelpersTestCase
@@ -9,7 +9,8 @@
  * See http://www.boost.org/libs/test for the Boost test library home page.
  *
  * Timing:
- * not given yet
+ * not given yet; `MatrixTimingTest` prints the time of the 5x5 and 6x6
+ * inversions compared with a plain Gauss-Jordan elimination
  */
 
 // define the following symbol to print the matrices
@@ -23,6 +24,8 @@
 #include <random>
 #include <string>
 #include <iostream>
+#include <vector>
+#include <chrono>
 
 
 // Boost libraries
@@ -42,6 +45,7 @@
 
 // LArSoft libraries
 #include "lardata/Utilities/FastMatrixMathHelper.h"
+#include "lardata/Utilities/HardwareCounters.h"
 
 
 //==============================================================================
@@ -55,7 +59,9 @@ constexpr unsigned int static_sqrt(unsigned int n) {
     ((n ==  4)? 2:
     ((n ==  9)? 3:
     ((n == 16)? 4:
-    std::numeric_limits<unsigned int>::max()))));
+    ((n == 25)? 5:
+    ((n == 36)? 6:
+    std::numeric_limits<unsigned int>::max()))))));
 } // static_sqrt()
 
 
@@ -117,7 +123,7 @@ void MatrixTest(Array const& mat) {
   using Data_t = typename Array::value_type;
 
   constexpr unsigned int Dim = static_sqrt(std::tuple_size<Array>::value);
-  static_assert((Dim >= 1) && (Dim <= 4), "Dimension not supported");
+  static_assert((Dim >= 1) && (Dim <= 6), "Dimension not supported");
 
   using FastMatrixOperations
     = lar::util::details::FastMatrixOperations<Data_t, Dim>;
@@ -135,7 +141,7 @@ void MatrixTest(Array const& mat, typename Array::value_type det) {
   using Data_t = typename Array::value_type;
 
   constexpr unsigned int Dim = static_sqrt(std::tuple_size<Array>::value);
-  static_assert((Dim >= 1) && (Dim <= 4), "Dimension not supported");
+  static_assert((Dim >= 1) && (Dim <= 6), "Dimension not supported");
 
   using FastMatrixOperations
     = lar::util::details::FastMatrixOperations<Data_t, Dim>;
@@ -157,7 +163,7 @@ void SymmetricMatrixTest(Array const& mat) {
   using Data_t = typename Array::value_type;
 
   constexpr unsigned int Dim = static_sqrt(std::tuple_size<Array>::value);
-  static_assert((Dim >= 1) && (Dim <= 4), "Dimension not supported");
+  static_assert((Dim >= 1) && (Dim <= 6), "Dimension not supported");
 
   using FastMatrixOperations
     = lar::util::details::FastMatrixOperations<Data_t, Dim>;
@@ -177,7 +183,7 @@ void SymmetricMatrixTest(Array const& mat, typename Array::value_type det) {
   using Data_t = typename Array::value_type;
 
   constexpr unsigned int Dim = static_sqrt(std::tuple_size<Array>::value);
-  static_assert((Dim >= 1) && (Dim <= 4), "Dimension not supported");
+  static_assert((Dim >= 1) && (Dim <= 6), "Dimension not supported");
 
   using FastMatrixOperations
     = lar::util::details::FastMatrixOperations<Data_t, Dim>;
@@ -401,6 +407,291 @@ void TestSymmetricMatrix4x4() {
 } // TestSymmetricMatrix4x4()
 
 
+template <typename T, unsigned int Dim>
+std::array<T, Dim*Dim> RandomPositiveDefiniteMatrix
+  (std::default_random_engine& engine)
+{
+  using Data_t = T;
+  std::uniform_real_distribution<Data_t> uniform(Data_t(-10.), Data_t(10.));
+
+  // B B^T + Dim, which is symmetric and positive definite
+  std::array<Data_t, Dim*Dim> B;
+  std::generate(B.begin(), B.end(),
+    [&engine, &uniform] { return uniform(engine); }
+    );
+  std::array<Data_t, Dim*Dim> matrix;
+  for (unsigned int r = 0; r < Dim; ++r) {
+    for (unsigned int c = 0; c < Dim; ++c) {
+      Data_t v = (r == c)? Data_t(Dim): Data_t(0);
+      for (unsigned int k = 0; k < Dim; ++k) v += B[r * Dim + k] * B[c * Dim + k];
+      matrix[r * Dim + c] = v;
+    } // for column
+  } // for row
+  return matrix;
+} // RandomPositiveDefiniteMatrix()
+
+
+template <typename T, unsigned int Dim>
+void TestSymmetricMatrix_N(unsigned int N = 100) {
+
+  std::default_random_engine engine;
+  for (unsigned int i = 0; i < N; ++i) {
+    auto const matrix = RandomPositiveDefiniteMatrix<T, Dim>(engine);
+    PrintMatrix(std::cout, matrix, "Symmetric matrix");
+    SymmetricMatrixTest(matrix);
+  } // for
+
+} // TestSymmetricMatrix_N()
+
+
+template <typename T, unsigned int Dim>
+void TestSymmetricMatrixBatch(unsigned int N = 51) {
+
+  using Data_t = T;
+  using FastMatrixOperations
+    = lar::util::details::FastMatrixOperations<Data_t, Dim>;
+  constexpr unsigned int Size = Dim * Dim;
+
+  // N matrices in "structure of arrays" layout
+  std::default_random_engine engine;
+  std::vector<std::array<Data_t, Size>> matrices;
+  std::vector<Data_t> batch(Size * N);
+  for (unsigned int i = 0; i < N; ++i) {
+    matrices.push_back(RandomPositiveDefiniteMatrix<T, Dim>(engine));
+    for (unsigned int e = 0; e < Size; ++e)
+      batch[e * N + i] = matrices.back()[e];
+  } // for
+
+  std::vector<Data_t> inverses(Size * N);
+  FastMatrixOperations::InvertSymmetricMatrices
+    (N, batch.data(), inverses.data());
+
+  // the result must match the one from the single matrix inversion
+  for (unsigned int i = 0; i < N; ++i) {
+    auto const expected
+      = FastMatrixOperations::InvertSymmetricMatrix(matrices[i]);
+    std::array<Data_t, Size> mat_inv;
+    for (unsigned int e = 0; e < Size; ++e) {
+      mat_inv[e] = inverses[e * N + i];
+      BOOST_CHECK_CLOSE(mat_inv[e], expected[e], 1e-6);
+    }
+    CheckInverse(matrices[i], mat_inv);
+  } // for
+
+  // in place
+  FastMatrixOperations::InvertSymmetricMatrices
+    (N, batch.data(), batch.data());
+  for (unsigned int e = 0; e < Size * N; ++e)
+    BOOST_CHECK_EQUAL(batch[e], inverses[e]);
+
+} // TestSymmetricMatrixBatch()
+
+
+template <typename T>
+void TestIndefiniteSymmetricMatrix5x5() {
+
+  using Data_t = T;
+  using FastMatrixOperations
+    = lar::util::details::FastMatrixOperations<Data_t, 5>;
+  constexpr unsigned int Size = 25;
+
+  // {{ 0, 1 }, { 1, 0 }} (+) diag(2, 3, 4): nonsingular, but with a null
+  // first pivot; its inverse is {{ 0, 1 }, { 1, 0 }} (+) diag(1/2, 1/3, 1/4)
+  std::array<Data_t, Size> const matrix = {
+    Data_t(0), Data_t(1), Data_t(0), Data_t(0), Data_t(0),
+    Data_t(1), Data_t(0), Data_t(0), Data_t(0), Data_t(0),
+    Data_t(0), Data_t(0), Data_t(2), Data_t(0), Data_t(0),
+    Data_t(0), Data_t(0), Data_t(0), Data_t(3), Data_t(0),
+    Data_t(0), Data_t(0), Data_t(0), Data_t(0), Data_t(4)
+  };
+  std::array<Data_t, Size> const true_inverse = {
+    Data_t(0), Data_t(1), Data_t(0), Data_t(0), Data_t(0),
+    Data_t(1), Data_t(0), Data_t(0), Data_t(0), Data_t(0),
+    Data_t(0), Data_t(0), Data_t(1)/Data_t(2), Data_t(0), Data_t(0),
+    Data_t(0), Data_t(0), Data_t(0), Data_t(1)/Data_t(3), Data_t(0),
+    Data_t(0), Data_t(0), Data_t(0), Data_t(0), Data_t(1)/Data_t(4)
+  };
+
+  auto const mat_inv = FastMatrixOperations::InvertSymmetricMatrix(matrix);
+  PrintMatrix(std::cout, mat_inv, "Alleged inverse matrix");
+  for (unsigned int e = 0; e < Size; ++e)
+    BOOST_CHECK_SMALL(mat_inv[e] - true_inverse[e], Data_t(1e-12));
+  CheckInverse(matrix, mat_inv);
+  SymmetricMatrixTest(matrix, Data_t(-24));
+
+  // in a batch, among positive definite matrices
+  constexpr unsigned int N = 11;
+  constexpr unsigned int Indefinite = 3;
+  std::default_random_engine engine;
+  std::vector<std::array<Data_t, Size>> matrices;
+  std::vector<Data_t> batch(Size * N);
+  for (unsigned int i = 0; i < N; ++i) {
+    matrices.push_back((i == Indefinite)
+      ? matrix: RandomPositiveDefiniteMatrix<T, 5>(engine));
+    for (unsigned int e = 0; e < Size; ++e)
+      batch[e * N + i] = matrices.back()[e];
+  } // for
+
+  std::vector<Data_t> inverses(Size * N);
+  FastMatrixOperations::InvertSymmetricMatrices
+    (N, batch.data(), inverses.data());
+  for (unsigned int i = 0; i < N; ++i) {
+    std::array<Data_t, Size> batch_inv;
+    for (unsigned int e = 0; e < Size; ++e)
+      batch_inv[e] = inverses[e * N + i];
+    CheckInverse(matrices[i], batch_inv);
+  } // for
+  for (unsigned int e = 0; e < Size; ++e)
+    BOOST_CHECK_SMALL(inverses[e * N + Indefinite] - true_inverse[e], Data_t(1e-12));
+
+  // in place
+  FastMatrixOperations::InvertSymmetricMatrices
+    (N, batch.data(), batch.data());
+  for (unsigned int e = 0; e < Size * N; ++e)
+    BOOST_CHECK_EQUAL(batch[e], inverses[e]);
+
+} // TestIndefiniteSymmetricMatrix5x5()
+
+
+/// Reference inversion: Gauss-Jordan elimination with sizes known at run time
+template <typename T>
+std::vector<T> ReferenceInverse(std::vector<T> m, unsigned int Dim) {
+  std::vector<T> inv(Dim * Dim, T(0));
+  for (unsigned int i = 0; i < Dim; ++i) inv[i * Dim + i] = T(1);
+  for (unsigned int k = 0; k < Dim; ++k) {
+    unsigned int pivot = k;
+    for (unsigned int r = k + 1; r < Dim; ++r)
+      if (std::abs(m[r * Dim + k]) > std::abs(m[pivot * Dim + k])) pivot = r;
+    for (unsigned int c = 0; c < Dim; ++c) {
+      std::swap(m[k * Dim + c], m[pivot * Dim + c]);
+      std::swap(inv[k * Dim + c], inv[pivot * Dim + c]);
+    }
+    T const factor = T(1) / m[k * Dim + k];
+    for (unsigned int c = 0; c < Dim; ++c) {
+      m[k * Dim + c] *= factor;
+      inv[k * Dim + c] *= factor;
+    }
+    for (unsigned int r = 0; r < Dim; ++r) {
+      if (r == k) continue;
+      T const f = m[r * Dim + k];
+      for (unsigned int c = 0; c < Dim; ++c) {
+        m[r * Dim + c] -= f * m[k * Dim + c];
+        inv[r * Dim + c] -= f * inv[k * Dim + c];
+      }
+    } // for rows
+  } // for k
+  return inv;
+} // ReferenceInverse()
+
+
+template <typename T, unsigned int Dim>
+void TimeSymmetricMatrixInversion(unsigned int N = 20000) {
+
+  using Data_t = T;
+  using FastMatrixOperations
+    = lar::util::details::FastMatrixOperations<Data_t, Dim>;
+  constexpr unsigned int Size = Dim * Dim;
+  using Clock_t = std::chrono::steady_clock;
+  auto elapsed = [](Clock_t::time_point start)
+    {
+      return std::chrono::duration<double, std::micro>
+        (Clock_t::now() - start).count();
+    };
+
+  std::default_random_engine engine;
+  std::vector<std::array<Data_t, Size>> matrices;
+  std::vector<Data_t> batch(Size * N);
+  for (unsigned int i = 0; i < N; ++i) {
+    matrices.push_back(RandomPositiveDefiniteMatrix<T, Dim>(engine));
+    for (unsigned int e = 0; e < Size; ++e)
+      batch[e * N + i] = matrices.back()[e];
+  } // for
+
+  Data_t sum = Data_t(0); // prevents the optimizer from skipping the work
+
+  auto start = Clock_t::now();
+  for (auto const& matrix: matrices) {
+    std::vector<Data_t> const m(matrix.begin(), matrix.end());
+    sum += ReferenceInverse(m, Dim)[Size - 1];
+  }
+  double const refTime = elapsed(start);
+
+  start = Clock_t::now();
+  for (auto const& matrix: matrices)
+    sum += FastMatrixOperations::InvertMatrix(matrix)[Size - 1];
+  double const genericTime = elapsed(start);
+
+  start = Clock_t::now();
+  for (auto const& matrix: matrices)
+    sum += FastMatrixOperations::InvertSymmetricMatrix(matrix)[Size - 1];
+  double const symTime = elapsed(start);
+
+  start = Clock_t::now();
+  FastMatrixOperations::InvertSymmetricMatrices
+    (N, batch.data(), batch.data());
+  sum += batch.back();
+  double const batchTime = elapsed(start);
+
+  std::cout << N << " " << Dim << "x" << Dim << " matrices (in microseconds):"
+    << "\n  reference Gauss-Jordan:   " << refTime
+    << "\n  InvertMatrix():           " << genericTime
+    << "\n  InvertSymmetricMatrix():  " << symTime
+    << "\n  InvertSymmetricMatrices(): " << batchTime
+    << "\n  (check sum: " << sum << ")"
+    << std::endl;
+
+} // TimeSymmetricMatrixInversion()
+
+
+/**
+ * @brief Hardware counters of the inversion of symmetric matrices
+ *
+ * Runs only with `LARDATA_HARDWARE_BENCHMARK` set in the environment (see
+ * `lar::bench::HardwareBenchmark`), comparing the inversion one matrix at a
+ * time with the batch inversion (structure of arrays).
+ */
+template <typename T, unsigned int Dim>
+void SymmetricMatrixInversionBenchmark(unsigned int N = 20000) {
+
+  if (!lar::bench::HardwareBenchmark::enabled()) return;
+
+  using Data_t = T;
+  using FastMatrixOperations
+    = lar::util::details::FastMatrixOperations<Data_t, Dim>;
+  constexpr unsigned int Size = Dim * Dim;
+
+  std::default_random_engine engine;
+  std::vector<std::array<Data_t, Size>> matrices;
+  std::vector<Data_t> batch(Size * N), inverted(Size * N);
+  for (unsigned int i = 0; i < N; ++i) {
+    matrices.push_back(RandomPositiveDefiniteMatrix<T, Dim>(engine));
+    for (unsigned int e = 0; e < Size; ++e)
+      batch[e * N + i] = matrices.back()[e];
+  } // for
+
+  Data_t sum = Data_t(0); // prevents the optimizer from skipping the work
+  lar::bench::HardwareBenchmark bench {
+    "inversion of " + std::to_string(Dim) + "x" + std::to_string(Dim)
+      + " symmetric matrices",
+    "matrices"
+    };
+  bench.add("InvertSymmetricMatrix()", [&](){
+      for (auto const& matrix: matrices)
+        sum += FastMatrixOperations::InvertSymmetricMatrix(matrix)[Size - 1];
+      return matrices.size();
+    });
+  bench.add("InvertSymmetricMatrices()", [&](){
+      FastMatrixOperations::InvertSymmetricMatrices
+        (N, batch.data(), inverted.data());
+      sum += inverted.back();
+      return std::size_t(N);
+    });
+  bench.runIfEnabled(std::cout);
+  BOOST_CHECK(std::isfinite(sum));
+
+} // SymmetricMatrixInversionBenchmark()
+
+
 //------------------------------------------------------------------------------
 //--- registration of tests
 //
@@ -438,3 +729,28 @@ BOOST_AUTO_TEST_CASE(Matrix4x4RealTest) {
   TestMatrix_N<double, 4>();
   TestNullMatrix<double, 4>();
 }
+
+BOOST_AUTO_TEST_CASE(Matrix5x5RealTest) {
+  TestMatrix_N<double, 5>();
+  TestSymmetricMatrix_N<double, 5>();
+  TestSymmetricMatrixBatch<double, 5>();
+  TestIndefiniteSymmetricMatrix5x5<double>();
+  TestNullMatrix<double, 5>();
+}
+
+BOOST_AUTO_TEST_CASE(Matrix6x6RealTest) {
+  TestMatrix_N<double, 6>();
+  TestSymmetricMatrix_N<double, 6>();
+  TestSymmetricMatrixBatch<double, 6>();
+  TestNullMatrix<double, 6>();
+}
+
+BOOST_AUTO_TEST_CASE(MatrixTimingTest) {
+  TimeSymmetricMatrixInversion<double, 5>();
+  TimeSymmetricMatrixInversion<double, 6>();
+}
+
+BOOST_AUTO_TEST_CASE(MatrixHardwareBenchmarkTest) {
+  SymmetricMatrixInversionBenchmark<double, 5>();
+  SymmetricMatrixInversionBenchmark<double, 6>();
+}
@@ -13,13 +13,27 @@
  *
  * * `GridContainer2DTest`: two-dimension container test
  * * `GridContainer3DTest`: three-dimension container test
+ * * `GridContainerFrozenTest`: contiguous (frozen) storage test
+ * * `GridContainerNeighbourhoodTest`: neighbourhood ranges and parallel fill,
+ *   for row-major and Morton order, and with sizes fixed at compile time
+ * * `SparseGridContainerTest`: sparse container, compared with a dense one,
+ *   in row-major and Morton order
  *
- * See the documentation of the three functions for more information.
+ * See the documentation of the test functions for more information.
  *
  */
 
 // LArSoft libraries
 #include "lardata/Utilities/GridContainers.h"
+#include "lardata/Utilities/HardwareCounters.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort()
+#include <array>
+#include <cstdlib> // std::abs()
+#include <iostream>
+#include <set>
+#include <vector>
 
 // Boost libraries
 #define BOOST_TEST_MODULE ( PointIsolationAlg_test )
@@ -213,6 +227,305 @@ void GridContainer3DTest() {
 } // GridContainer3DTest()
 
 
+//------------------------------------------------------------------------------
+/**
+ * @brief Test for the frozen storage of a GridContainer3D of integers
+ *
+ * The container is filled with a mix of `stage()` and `insert()` calls, in
+ * no particular cell order, then frozen, refilled after `clear()` and frozen
+ * twice.
+ *
+ */
+void GridContainerFrozenTest() {
+
+  using Container_t = util::GridContainer3D<int>;
+  Container_t grid({{{ 2U, 3U, 4U }}});
+
+  BOOST_CHECK(!grid.frozen());
+
+  // fill cells in reverse order, all staged except one value per odd cell
+  auto fill = [&grid](int base){
+    for (std::size_t iCell = grid.size(); iCell-- > 0; ) {
+      int const count = iCell % 5;
+      for (int k = 0; k < count; ++k) {
+        if ((iCell & 1) && (k == 0)) grid.insert(iCell, base + k);
+        else                         grid.stage(iCell, base + k);
+      }
+    } // for
+  };
+  fill(0);
+
+  // before freezing, cellData() shows only the inserted data
+  BOOST_CHECK_EQUAL(grid.cellData(Container_t::CellIndex_t(1)).size(), 1U);
+
+  grid.freeze();
+  BOOST_CHECK(grid.frozen());
+  for (std::size_t iCell = 0; iCell < grid.size(); ++iCell) {
+    BOOST_TEST_CHECKPOINT("cell #" << iCell);
+    BOOST_CHECK(grid[iCell].empty());
+    auto const cell = grid.cellData(iCell);
+    BOOST_CHECK_EQUAL(cell.size(), iCell % 5);
+    int k = 0;
+    for (int val: cell) BOOST_CHECK_EQUAL(val, k++);
+  } // for
+
+  // cells are contiguous in memory
+  auto const first = grid.cellData(Container_t::CellIndex_t(0));
+  auto const last = grid.cellData(grid.size() - 1);
+  BOOST_CHECK_EQUAL(last.end() - first.begin(), 4 * (0+1+2+3+4) + (0+1+2+3));
+  BOOST_CHECK_EQUAL(grid.cellData({{ 1, 2, 3 }}).size(), 23U % 5);
+
+  // freezing again appends the new data to the frozen ones
+  grid.stage({{ 0, 0, 1 }}, 10);
+  BOOST_CHECK_EQUAL(grid.cellData(Container_t::CellIndex_t(1)).size(), 1U);
+  grid.freeze();
+  auto const cell1 = grid.cellData(Container_t::CellIndex_t(1));
+  BOOST_CHECK_EQUAL(cell1.size(), 2U);
+  BOOST_CHECK_EQUAL(cell1[0], 0);
+  BOOST_CHECK_EQUAL(cell1[1], 10);
+
+  // clear and refill
+  grid.clear();
+  BOOST_CHECK(!grid.frozen());
+  BOOST_CHECK(grid.cellData(Container_t::CellIndex_t(4)).empty());
+  fill(100);
+  grid.freeze();
+  for (std::size_t iCell = 0; iCell < grid.size(); ++iCell) {
+    auto const cell = grid.cellData(iCell);
+    BOOST_CHECK_EQUAL(cell.size(), iCell % 5);
+    int k = 100;
+    for (int val: cell) BOOST_CHECK_EQUAL(val, k++);
+  } // for
+
+} // GridContainerFrozenTest()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Test for neighbourhoods and parallel fill of a 3D grid container
+ * @tparam Container_t type of container (row-major or Morton order, or with
+ *                     fixed 4 x 5 x 6 sizes)
+ *
+ * The cells in the neighbourhoods are compared with the ones selected by
+ * brute force, for boxes in the middle of the grid, on its border and
+ * partially or totally outside it.
+ * The container is then filled in parallel from a list of points, and the
+ * data around a cell are compared with the expectation.
+ *
+ */
+template <typename Container_t>
+void GridContainerNeighbourhoodTest() {
+
+  using CellID_t = typename Container_t::CellID_t;
+  Container_t grid({{{ 4U, 5U, 6U }}});
+
+  auto bruteForce = [&grid](CellID_t const& center, std::ptrdiff_t k){
+    std::set<std::size_t> cells;
+    CellID_t id;
+    for (id[0] = 0; id[0] < (std::ptrdiff_t) grid.sizeX(); ++id[0])
+      for (id[1] = 0; id[1] < (std::ptrdiff_t) grid.sizeY(); ++id[1])
+        for (id[2] = 0; id[2] < (std::ptrdiff_t) grid.sizeZ(); ++id[2]) {
+          if (std::abs(id[0] - center[0]) > k) continue;
+          if (std::abs(id[1] - center[1]) > k) continue;
+          if (std::abs(id[2] - center[2]) > k) continue;
+          cells.insert(grid.index(id));
+        }
+    return cells;
+  };
+
+  std::vector<std::pair<CellID_t, std::ptrdiff_t>> const boxes {
+    { {{ 2, 2, 3 }}, 1 }, { {{ 0, 0, 0 }}, 1 }, { {{ 3, 4, 5 }}, 2 },
+    { {{ 1, 2, 3 }}, 0 }, { {{ 2, 2, 2 }}, 10 }, { {{ -1, 2, 7 }}, 1 },
+    { {{ 10, 2, 3 }}, 2 }
+  };
+  for (auto const& box: boxes) {
+    BOOST_TEST_CHECKPOINT("box [" << box.first[0] << "][" << box.first[1]
+      << "][" << box.first[2] << "] +/- " << box.second);
+    std::set<std::size_t> const expected = bruteForce(box.first, box.second);
+    auto const neighbourhood = grid.neighbourhood(box.first, box.second);
+    BOOST_CHECK_EQUAL(neighbourhood.size(), expected.size());
+    BOOST_CHECK_EQUAL(neighbourhood.empty(), expected.empty());
+    std::vector<std::size_t> cells;
+    for (auto it = neighbourhood.begin(); it != neighbourhood.end(); ++it) {
+      BOOST_CHECK_EQUAL(grid.index(it.cellID()), *it);
+      cells.push_back(*it);
+    }
+    std::sort(cells.begin(), cells.end()); // Morton order is not monotonic
+    BOOST_CHECK_EQUAL_COLLECTIONS
+      (cells.begin(), cells.end(), expected.begin(), expected.end());
+  } // for
+
+  // parallel fill: the datum is the point number, one point in each cell
+  // plus points out of the grid
+  std::vector<CellID_t> points;
+  CellID_t id;
+  for (id[0] = -1; id[0] <= (std::ptrdiff_t) grid.sizeX(); ++id[0])
+    for (id[1] = 0; id[1] < (std::ptrdiff_t) grid.sizeY(); ++id[1])
+      for (id[2] = 0; id[2] < (std::ptrdiff_t) grid.sizeZ(); ++id[2])
+        points.push_back(id);
+  std::vector<int> pointIndices(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) pointIndices[i] = i;
+
+  grid.fill(pointIndices.begin(), pointIndices.end(),
+    [&points](int i){ return points[i]; });
+  BOOST_CHECK(grid.frozen());
+
+  // (in Morton order, some cells are padding and stay empty)
+  std::size_t nData = 0;
+  for (std::size_t iCell = 0; iCell < grid.size(); ++iCell) {
+    auto const cell = grid.cellData(iCell);
+    nData += cell.size();
+    if (cell.empty()) continue;
+    BOOST_CHECK_EQUAL(cell.size(), 1U);
+    BOOST_CHECK_EQUAL(grid.index(points[cell.front()]), iCell);
+  }
+  BOOST_CHECK_EQUAL(nData, grid.sizeX() * grid.sizeY() * grid.sizeZ());
+
+  std::set<std::size_t> found;
+  grid.forEachNeighbour({{ 0, 4, 2 }}, 1,
+    [&](int i){ found.insert(grid.index(points[i])); });
+  std::set<std::size_t> const expected = bruteForce({{ 0, 4, 2 }}, 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (found.begin(), found.end(), expected.begin(), expected.end());
+
+} // GridContainerNeighbourhoodTest()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Test for a sparse 3D grid container
+ * @tparam Container_t type of sparse container (row-major or Morton order)
+ * @tparam Dense_t type of the equivalent dense container
+ *
+ * Both containers are filled with the same data in a few cells far apart,
+ * and their content and their neighbourhoods are compared. Only the blocks
+ * of the filled cells are expected to be allocated.
+ *
+ */
+template <typename Container_t, typename Dense_t>
+void SparseGridContainerTest() {
+
+  using CellID_t = typename Container_t::CellID_t;
+  std::array<std::size_t, 3U> const sizes {{ 40U, 50U, 60U }};
+  Container_t grid(sizes);
+  Container_t const& cgrid = grid; // constant access does not allocate
+  Dense_t dense(sizes);
+
+  BOOST_CHECK_EQUAL(grid.size(), dense.size());
+  BOOST_CHECK_EQUAL(grid.sizeY(), 50U);
+  BOOST_CHECK_EQUAL(grid.nAllocatedBlocks(), 0U);
+  CellID_t const emptyCell {{ 1, 2, 3 }};
+  BOOST_CHECK(cgrid[emptyCell].empty());
+  BOOST_CHECK_EQUAL(grid.nAllocatedBlocks(), 0U);
+
+  std::vector<CellID_t> const cells {
+    {{ 0, 0, 0 }}, {{ 0, 0, 1 }}, {{ 20, 25, 30 }}, {{ 39, 49, 59 }},
+    {{ 21, 25, 30 }}
+  };
+  int value = 0;
+  for (CellID_t const& cellID: cells) {
+    for (int k = 0; k <= value; ++k) {
+      grid.insert(cellID, value + k);
+      dense.insert(cellID, value + k);
+    }
+    ++value;
+  } // for
+
+  std::set<std::size_t> blocks;
+  for (CellID_t const& cellID: cells)
+    blocks.insert(grid.index(cellID) / Container_t::blockSize());
+  BOOST_CHECK_EQUAL(grid.nAllocatedBlocks(), blocks.size());
+  BOOST_CHECK_LT(grid.nAllocatedBlocks(), grid.nBlocks());
+
+  // all the cells have the same content as in the dense container
+  for (std::size_t iCell = 0; iCell < grid.size(); ++iCell) {
+    BOOST_TEST_CHECKPOINT("cell #" << iCell);
+    auto const& cell = cgrid[iCell];
+    BOOST_CHECK_EQUAL_COLLECTIONS
+      (cell.begin(), cell.end(), dense[iCell].begin(), dense[iCell].end());
+  } // for
+  BOOST_CHECK_EQUAL(grid.nAllocatedBlocks(), blocks.size());
+
+  // only the non-empty cells are visited
+  std::set<std::size_t> visited;
+  std::size_t nData = 0;
+  grid.forEachCell([&](auto index, auto const& cell){
+    visited.insert(index);
+    nData += cell.size();
+    BOOST_CHECK_EQUAL(cell.size(), dense[index].size());
+  });
+  BOOST_CHECK_EQUAL(visited.size(), cells.size());
+  BOOST_CHECK_EQUAL(nData, (cells.size() * (cells.size() + 1)) / 2);
+
+  for (CellID_t const& center: cells) {
+    std::multiset<int> found, expected;
+    grid.forEachNeighbour(center, 1, [&found](int i){ found.insert(i); });
+    for (auto index: dense.neighbourhood(center, 1))
+      expected.insert(dense[index].begin(), dense[index].end());
+    BOOST_CHECK_EQUAL_COLLECTIONS
+      (found.begin(), found.end(), expected.begin(), expected.end());
+  } // for
+
+  grid.clear();
+  BOOST_CHECK_EQUAL(grid.nAllocatedBlocks(), 0U);
+  BOOST_CHECK(grid.findCell(grid.index(cells[2])) == nullptr);
+
+} // SparseGridContainerTest()
+
+
+//------------------------------------------------------------------------------
+/// Returns the sum of the data around each cell of a filled grid
+template <typename Container_t>
+long long sumNeighbours(Container_t const& grid) {
+  long long sum = 0;
+  typename Container_t::CellID_t id;
+  for (id[0] = 0; id[0] < (std::ptrdiff_t) grid.sizeX(); ++id[0])
+    for (id[1] = 0; id[1] < (std::ptrdiff_t) grid.sizeY(); ++id[1])
+      for (id[2] = 0; id[2] < (std::ptrdiff_t) grid.sizeZ(); ++id[2])
+        grid.forEachNeighbour(id, 1, [&sum](int i){ sum += i; });
+  return sum;
+} // sumNeighbours()
+
+
+/**
+ * @brief Hardware counters of neighbourhood queries, row-major versus Morton
+ *
+ * Runs only with `LARDATA_HARDWARE_BENCHMARK` set in the environment (see
+ * `lar::bench::HardwareBenchmark`). The two containers are filled with the
+ * same points (four per cell), and all the neighbourhoods are visited.
+ */
+void GridContainerNeighbourhoodBenchmark() {
+
+  if (!lar::bench::HardwareBenchmark::enabled()) return;
+
+  constexpr std::size_t Side = 64U;
+  using CellID_t = util::GridContainer3D<int>::CellID_t;
+  std::vector<CellID_t> points;
+  CellID_t id;
+  for (id[0] = 0; id[0] < (std::ptrdiff_t) Side; ++id[0])
+    for (id[1] = 0; id[1] < (std::ptrdiff_t) Side; ++id[1])
+      for (id[2] = 0; id[2] < (std::ptrdiff_t) Side; ++id[2])
+        points.insert(points.end(), 4U, id);
+  std::vector<int> pointIndices(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) pointIndices[i] = i;
+  auto const cellOf = [&points](int i){ return points[i]; };
+
+  util::GridContainer3D<int> rowMajor({{{ Side, Side, Side }}});
+  rowMajor.fill(pointIndices.begin(), pointIndices.end(), cellOf);
+  util::MortonGridContainer3D<int> morton({{{ Side, Side, Side }}});
+  morton.fill(pointIndices.begin(), pointIndices.end(), cellOf);
+  BOOST_CHECK_EQUAL(sumNeighbours(rowMajor), sumNeighbours(morton));
+
+  std::size_t const nCells = Side * Side * Side;
+  long long sum = 0;
+  lar::bench::HardwareBenchmark bench { "grid neighbourhoods", "cells" };
+  bench.add("row-major", [&](){ sum += sumNeighbours(rowMajor); return nCells; });
+  bench.add("Morton", [&](){ sum += sumNeighbours(morton); return nCells; });
+  bench.runIfEnabled(std::cout);
+
+} // GridContainerNeighbourhoodBenchmark()
+
+
 //------------------------------------------------------------------------------
 //--- test cases
 //
@@ -224,3 +537,36 @@ BOOST_AUTO_TEST_CASE(GridContainer3DTestCase) {
   GridContainer3DTest();
 } // GridContainer3DTestCase
 
+BOOST_AUTO_TEST_CASE(GridContainerFrozenTestCase) {
+  GridContainerFrozenTest();
+} // GridContainerFrozenTestCase
+
+BOOST_AUTO_TEST_CASE(GridContainerNeighbourhoodTestCase) {
+  GridContainerNeighbourhoodTest<util::GridContainer3D<int>>();
+} // GridContainerNeighbourhoodTestCase
+
+BOOST_AUTO_TEST_CASE(MortonGridContainerNeighbourhoodTestCase) {
+  GridContainerNeighbourhoodTest<util::MortonGridContainer3D<int>>();
+} // MortonGridContainerNeighbourhoodTestCase
+
+BOOST_AUTO_TEST_CASE(FixedGridContainerNeighbourhoodTestCase) {
+  util::FixedGridContainer3D<int, 4U, 5U, 6U> const grid; // sizes are implied
+  BOOST_CHECK_EQUAL(grid.size(), 4U * 5U * 6U);
+  BOOST_CHECK_EQUAL(grid.sizeY(), 5U);
+  GridContainerNeighbourhoodTest<util::FixedGridContainer3D<int, 4U, 5U, 6U>>();
+} // FixedGridContainerNeighbourhoodTestCase
+
+BOOST_AUTO_TEST_CASE(SparseGridContainerTestCase) {
+  SparseGridContainerTest
+    <util::SparseGridContainer3D<int>, util::GridContainer3D<int>>();
+} // SparseGridContainerTestCase
+
+BOOST_AUTO_TEST_CASE(SparseMortonGridContainerTestCase) {
+  SparseGridContainerTest
+    <util::SparseMortonGridContainer3D<int>, util::MortonGridContainer3D<int>>();
+} // SparseMortonGridContainerTestCase
+
+BOOST_AUTO_TEST_CASE(GridContainerNeighbourhoodBenchmarkCase) {
+  GridContainerNeighbourhoodBenchmark();
+} // GridContainerNeighbourhoodBenchmarkCase
+
@@ -0,0 +1,100 @@
+/**
+ * @file    HardwareCounters_test.cc
+ * @brief   Tests the benchmark harness of `HardwareCounters.h`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/HardwareCounters.h`
+ *
+ * The hardware counters are checked only if the system allows their use;
+ * otherwise only the wall time is.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/HardwareCounters.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( HardwareCounters_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <numeric> // std::iota()
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+std::size_t sumWorkload(std::vector<double> const& data, double& sum) {
+  for (double v: data) sum += v;
+  return data.size();
+} // sumWorkload()
+
+
+//------------------------------------------------------------------------------
+void HardwareCountersTest() {
+
+  using Counts_t = lar::bench::HardwareCounts;
+
+  std::vector<double> data(100000);
+  std::iota(data.begin(), data.end(), 0.0);
+  double sum = 0.0;
+
+  lar::bench::HardwareCounters counters;
+  BOOST_TEST_MESSAGE("Hardware counters available: " << counters.available()
+    << (counters.available()? "": (" (" + counters.reason() + ")")));
+  Counts_t const counts
+    = counters.measure([&](){ sumWorkload(data, sum); });
+  BOOST_CHECK_EQUAL(sum, 99999.0 * 100000.0 / 2.0);
+  BOOST_CHECK_GT(counts.seconds, 0.0);
+
+  if (counters.available()) {
+    BOOST_CHECK(counts.has(Counts_t::Cycles) || counts.has(Counts_t::Instructions));
+    if (counts.has(Counts_t::Instructions))
+      BOOST_CHECK_GE(counts.get(Counts_t::Instructions), data.size());
+  }
+  else {
+    BOOST_CHECK_EQUAL(counts.validMask, 0U);
+    BOOST_CHECK_EQUAL(counts.ipc(), 0.0);
+    BOOST_CHECK(!counters.reason().empty());
+  }
+
+} // HardwareCountersTest()
+
+
+//------------------------------------------------------------------------------
+void HardwareBenchmarkTest() {
+
+  std::vector<double> data(1000, 1.0);
+  double sum = 0.0;
+
+  lar::bench::HardwareBenchmark bench { "sums", "values" };
+  bench.add("sum", [&](){ return sumWorkload(data, sum); });
+  bench.add("twice", [&](){ return 2U * sumWorkload(data, sum); });
+  BOOST_CHECK_EQUAL(bench.size(), 2U);
+
+  auto const results = bench.measure(2U);
+  BOOST_CHECK_EQUAL(sum, 4000.0); // each workload run twice
+  BOOST_REQUIRE_EQUAL(results.size(), 2U);
+  BOOST_CHECK_EQUAL(results[0].name, "sum");
+  BOOST_CHECK_EQUAL(results[0].items, 1000U);
+  BOOST_CHECK_EQUAL(results[1].items, 2000U);
+
+  std::ostringstream out;
+  bench.run(out, 1U);
+  BOOST_TEST_MESSAGE(out.str());
+  BOOST_CHECK(out.str().find("Benchmark 'sums'") == 0U);
+  BOOST_CHECK(out.str().find("  twice: 2000 values in ") != std::string::npos);
+
+} // HardwareBenchmarkTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(HardwareCountersTestCase) {
+  HardwareCountersTest();
+} // BOOST_AUTO_TEST_CASE(HardwareCountersTestCase)
+
+BOOST_AUTO_TEST_CASE(HardwareBenchmarkTestCase) {
+  HardwareBenchmarkTest();
+} // BOOST_AUTO_TEST_CASE(HardwareBenchmarkTestCase)
@@ -0,0 +1,117 @@
+/**
+ * @file    Instrumentation_test.cc
+ * @brief   Tests the timers and counters of `Instrumentation.h`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/Instrumentation.h`
+ *
+ * The instrumentation is enabled for this test only.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+#define LARDATA_INSTRUMENTATION 1
+
+// LArSoft libraries
+#include "lardata/Utilities/Instrumentation.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( Instrumentation_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits> // std::is_empty<>
+#include <vector>
+
+
+struct SleepTimer { static constexpr char const* Name = "sleep"; };
+struct ItemCounter { static constexpr char const* Name = "items"; };
+struct DisabledTimer { static constexpr char const* Name = "disabled"; };
+
+
+//------------------------------------------------------------------------------
+void RunCountingTest() {
+
+  using Instr_t = lar::Instrumentation;
+  static_assert(Instr_t::Enabled);
+
+  constexpr unsigned int NThreads = 4U;
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < NThreads; ++i) {
+    threads.emplace_back([i](){
+      for (unsigned int j = 0; j <= i; ++j)
+        Instr_t::count<ItemCounter>(j + 1U);
+      lar::ScopedTimer<SleepTimer> const timer;
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+  } // for
+  for (auto& thread: threads) thread.join();
+
+  // counts from threads which have ended are kept
+  auto const counts = Instr_t::GetStats<ItemCounter, Instr_t::Counter>();
+  BOOST_CHECK_EQUAL(counts.entries, 10U); // 1 + 2 + 3 + 4
+  BOOST_CHECK_EQUAL(counts.sum, 20U); // 1 + (1+2) + (1+2+3) + (1+2+3+4)
+  BOOST_CHECK_EQUAL(counts.max, 4U);
+
+  auto const times = Instr_t::GetStats<SleepTimer, Instr_t::Timer>();
+  BOOST_CHECK_EQUAL(times.entries, NThreads);
+  BOOST_CHECK_GE(times.max, 2000000U); // nanoseconds
+  BOOST_CHECK_GE(times.sum, NThreads * 2000000U);
+
+  std::ostringstream summary;
+  Instr_t::printSummary(summary);
+  BOOST_TEST_MESSAGE(summary.str());
+  BOOST_CHECK(summary.str().find("sleep: 4 calls") != std::string::npos);
+  BOOST_CHECK(summary.str().find("items: 20 in 10 entries") != std::string::npos);
+
+} // RunCountingTest()
+
+
+//------------------------------------------------------------------------------
+void RunTraceTest() {
+
+  using Instr_t = lar::Instrumentation;
+
+  Instr_t::setTracing(true);
+  { lar::ScopedTimer<SleepTimer> const timer; }
+  Instr_t::setTracing(false);
+  { lar::ScopedTimer<SleepTimer> const timer; } // not traced
+
+  std::ostringstream trace;
+  Instr_t::writeChromeTrace(trace);
+  std::string const json = trace.str();
+  BOOST_TEST_MESSAGE(json);
+  BOOST_CHECK_EQUAL(json.find("{\"traceEvents\":["), 0U);
+  std::size_t nEvents = 0U;
+  for (auto pos = json.find("\"ph\":\"X\""); pos != std::string::npos;
+    pos = json.find("\"ph\":\"X\"", pos + 1U)
+    )
+    ++nEvents;
+  BOOST_CHECK_EQUAL(nEvents, 1U);
+  BOOST_CHECK(json.find("\"name\":\"sleep\"") != std::string::npos);
+
+} // RunTraceTest()
+
+
+//------------------------------------------------------------------------------
+void RunDisabledTest() {
+
+  // a disabled timer records nothing and takes no space
+  using Timer_t = lar::ScopedTimer<DisabledTimer, false>;
+  static_assert(std::is_empty<Timer_t>::value);
+  { Timer_t const timer; }
+  BOOST_CHECK_EQUAL(lar::Instrumentation::nProbes(), 2U);
+
+} // RunDisabledTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(InstrumentationTestCase) {
+  RunCountingTest();
+  RunTraceTest();
+  RunDisabledTest();
+} // BOOST_AUTO_TEST_CASE(InstrumentationTestCase)
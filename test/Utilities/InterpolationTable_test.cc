@@ -0,0 +1,101 @@
+/**
+ * @file    InterpolationTable_test.cc
+ * @brief   Tests the class in `InterpolationTable.h`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/InterpolationTable.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( InterpolationTable_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+#include <boost/test/floating_point_comparison.hpp> // BOOST_CHECK_CLOSE()
+
+// LArSoft libraries
+#include "lardata/Utilities/InterpolationTable.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <vector>
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+
+
+//------------------------------------------------------------------------------
+void testInterpolationFromMap() {
+
+  std::map<double, double> const values
+    { { 1.0, 10.0 }, { 2.0, 20.0 }, { 4.0, 0.0 } };
+
+  lar::util::InterpolationTable<double> const table(values);
+
+  BOOST_CHECK(!table.empty());
+  BOOST_CHECK_EQUAL(table.size(), 3U);
+  BOOST_CHECK_EQUAL(table.minPoint(), 1.0);
+  BOOST_CHECK_EQUAL(table.maxPoint(), 4.0);
+
+  // at the points
+  BOOST_CHECK_CLOSE(table(1.0), 10.0, 1e-6);
+  BOOST_CHECK_CLOSE(table(2.0), 20.0, 1e-6);
+  BOOST_CHECK_SMALL(table(4.0), 1e-9);
+
+  // between the points
+  BOOST_CHECK_CLOSE(table(1.5), 15.0, 1e-6);
+  BOOST_CHECK_CLOSE(table(3.0), 10.0, 1e-6);
+  BOOST_CHECK_CLOSE(table.interpolate(3.5), 5.0, 1e-6);
+
+  // outside the range
+  BOOST_CHECK_CLOSE(table(0.0), 10.0, 1e-6);
+  BOOST_CHECK_SMALL(table(5.0), 1e-9);
+  BOOST_CHECK_THROW(table.at(0.5), std::out_of_range);
+  BOOST_CHECK_THROW(table.at(4.5), std::out_of_range);
+  BOOST_CHECK_CLOSE(table.at(1.5), 15.0, 1e-6);
+
+  BOOST_CHECK(table.toMap() == values);
+
+} // testInterpolationFromMap()
+
+
+//------------------------------------------------------------------------------
+void testInterpolationFromVectors() {
+
+  // the points are not sorted
+  std::vector<double> const x { 4.0, 1.0, 2.0 };
+  std::vector<double> const y { 0.0, 10.0, 20.0 };
+
+  lar::util::InterpolationTable<double> const table(x, y);
+
+  std::vector<double> const expectedPoints { 1.0, 2.0, 4.0 };
+  std::vector<double> const expectedValues { 10.0, 20.0, 0.0 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    table.points().begin(), table.points().end(),
+    expectedPoints.begin(), expectedPoints.end()
+    );
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    table.values().begin(), table.values().end(),
+    expectedValues.begin(), expectedValues.end()
+    );
+  BOOST_CHECK_CLOSE(table(3.0), 10.0, 1e-6);
+
+  BOOST_CHECK_THROW(
+    (lar::util::InterpolationTable<double>({ 1.0, 2.0 }, { 1.0 })),
+    std::invalid_argument
+    );
+
+  lar::util::InterpolationTable<double> const empty;
+  BOOST_CHECK(empty.empty());
+  BOOST_CHECK_THROW(empty.at(1.0), std::out_of_range);
+
+} // testInterpolationFromVectors()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(InterpolationFromMapTestCase) {
+  testInterpolationFromMap();
+}
+
+BOOST_AUTO_TEST_CASE(InterpolationFromVectorsTestCase) {
+  testInterpolationFromVectors();
+}
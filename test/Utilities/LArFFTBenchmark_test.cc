@@ -0,0 +1,353 @@
+/**
+ * @file   LArFFTBenchmark_test.cc
+ * @brief  Timing of the Fourier transform utilities on waveform-like data
+ * @see    LArFFTW.h, LArFFTWBatch.h, LArFFT.h
+ *
+ * Times forward transforms, convolution, deconvolution and peak correlation
+ * with:
+ * * `util::LArFFTW` in double and single precision, with different FFTW
+ *   planning options; the kernel operations are the ones used by
+ *   `util::SignalShaping::Convolute(util::LArFFTW&, ...)` and
+ *   `Deconvolute(util::LArFFTW&, ...)`;
+ * * `util::LArFFTWBatch` (double precision, batches of 16 waveforms);
+ * * the `util::LArFFT` service, with each of its backends (power of two
+ *   sizes only, since the service rounds sizes up).
+ *
+ * Results are reported as time per channel and channels per second; each
+ * number is the best of a few repetitions over a set of channels, and
+ * includes copying the input waveform (as a producer would do).
+ *
+ * Usage:
+ * ~~~~
+ * LArFFTBenchmark_test [options]
+ * ~~~~
+ * Options:
+ * * `--sizes N,N,...`: transform sizes (default: `2048,6000`)
+ * * `--options OPT,OPT,...`: FFTW planning options, see `LArFFTWPlan`
+ *   (default: `ES`)
+ * * `--channels N`: channels per timing sample (default: 100)
+ * * `--repeat N`: timing samples per measurement (default: 3)
+ * * `--simd LEVEL`: `scalar`, `avx2` or `avx512` kernel loops (default: best)
+ * * `--no-larfft`: skip the `LArFFT` service
+ * * `--full`: sizes `2048,4096,6000,8192,9595,12000,16384`, options
+ *   `ES,M,P`, 1000 channels (for choosing sizes for a detector; slow)
+ *
+ * Without options, the run is short enough to serve as a smoke test.
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/LArFFTWBatch.h"
+#include "lardata/Utilities/LArFFTWSimd.h"
+#include "lardata/Utilities/LArFFT.h"
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+//--- Test configuration and data
+//---
+namespace {
+
+  struct Config {
+    std::vector<int> sizes { 2048, 6000 };
+    std::vector<std::string> options { "ES" };
+    unsigned int nChannels = 100;
+    unsigned int nRepeat = 3;
+    bool doLArFFT = true;
+  };
+
+  template <class T>
+  std::vector<T> parseList(std::string const& s) {
+    std::vector<T> values;
+    std::istringstream sstr(s);
+    std::string item;
+    while (std::getline(sstr, item, ',')) {
+      std::istringstream isstr(item);
+      T value;
+      isstr >> value;
+      if (!isstr) throw std::runtime_error("invalid list item: '" + item + "'");
+      values.push_back(value);
+    }
+    return values;
+  }
+
+  bool isPowerOfTwo(int n) { return (n > 0) && ((n & (n - 1)) == 0); }
+
+  // ... a few channels of noise with a pulse each
+  std::vector<std::vector<double>> makeWaveforms(int size, unsigned int n) {
+    std::vector<std::vector<double>> waveforms(n, std::vector<double>(size));
+    unsigned int seed = 12345;
+    auto noise = [&seed](){ seed = seed*1103515245U + 12345U; return ((seed >> 16) % 1000)/500.0 - 1.0; };
+    for (unsigned int c = 0; c < n; ++c) {
+      double const t0 = (c * 37) % (size - 100) + 50;
+      for (int i = 0; i < size; ++i) {
+        double const dt = (i - t0)/5.;
+        waveforms[c][i] = noise() + 50.*std::exp(-0.5*dt*dt);
+      }
+    }
+    return waveforms;
+  }
+
+  // ... exponential response, as the transform of a kernel for deconvolution
+  std::vector<double> makeResponse(int size) {
+    std::vector<double> response(size, 0.);
+    for (int i = 0; i < std::min(size, 200); ++i) response[i] = std::exp(-i/20.) + 0.01;
+    return response;
+  }
+
+  // ... best time per channel of op(channel index) over the repetitions
+  template <class Op>
+  double timePerChannel(Config const& config, Op op) {
+    double best = std::numeric_limits<double>::max();
+    for (unsigned int r = 0; r < config.nRepeat; ++r) {
+      auto const start = std::chrono::steady_clock::now();
+      for (unsigned int c = 0; c < config.nChannels; ++c) op(c);
+      std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count()/config.nChannels);
+    }
+    return best;
+  }
+
+  void report(std::string const& engine, std::string const& precision,
+              std::string const& option, int size, std::string const& operation,
+              double seconds)
+  {
+    std::printf("%-12s %-7s %-4s %6d  %-16s %10.2f us %12.0f ch/s\n",
+                engine.c_str(), precision.c_str(), option.c_str(), size,
+                operation.c_str(), seconds*1e6, 1./seconds);
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//--- LArFFTW
+//---
+namespace {
+
+  template <class T>
+  void benchmarkLArFFTW(Config const& config, util::LArFFTW& fft, int size,
+                        std::string const& option)
+  {
+    std::string const precision = std::is_same<T, float>::value? "float": "double";
+    auto const templates = makeWaveforms(size, std::min(config.nChannels, 16U));
+    auto const nTemplates = templates.size();
+    std::vector<std::vector<T>> inputs;
+    for (auto const& wave: templates) inputs.emplace_back(wave.begin(), wave.end());
+
+    // ... the kernel precision that SignalShaping picks for the data type
+    std::vector<T> response;
+    for (double v: makeResponse(size)) response.push_back(v);
+    util::LArFFTW::ComplexVector kern(size/2+1);
+    fft.DoFFT(response, kern);
+    util::LArFFTW::ComplexVectorF kernF(kern.begin(), kern.end());
+
+    std::vector<T> work;
+
+    report("LArFFTW", precision, option, size, "DoFFT",
+      timePerChannel(config, [&](unsigned int c)
+        { work = inputs[c % nTemplates]; fft.DoFFT(work); }));
+
+    auto convolute = [&](unsigned int c)
+      {
+        work = inputs[c % nTemplates];
+        if (std::is_same<T, float>::value && fft.HasSinglePrecision()) fft.Convolute(work, kernF);
+        else fft.Convolute(work, kern);
+      };
+    report("LArFFTW", precision, option, size, "Convolute", timePerChannel(config, convolute));
+
+    auto deconvolute = [&](unsigned int c)
+      {
+        work = inputs[c % nTemplates];
+        if (std::is_same<T, float>::value && fft.HasSinglePrecision()) fft.Deconvolute(work, kernF);
+        else fft.Deconvolute(work, kern);
+      };
+    report("LArFFTW", precision, option, size, "Deconvolute", timePerChannel(config, deconvolute));
+
+    util::LArFFTW::AlignedVector<T> aligned(size);
+    auto deconvoluteInPlace = [&](unsigned int c)
+      {
+        std::copy(inputs[c % nTemplates].begin(), inputs[c % nTemplates].end(), aligned.begin());
+        if (std::is_same<T, float>::value && fft.HasSinglePrecision()) fft.DeconvoluteInPlace(aligned, kernF);
+        else fft.DeconvoluteInPlace(aligned, kern);
+      };
+    report("LArFFTW", precision, option, size, "DeconvoluteInPl", timePerChannel(config, deconvoluteInPlace));
+
+    std::vector<T> reference = inputs[0];
+    report("LArFFTW", precision, option, size, "PeakCorrelation",
+      timePerChannel(config, [&](unsigned int c)
+        { work = inputs[c % nTemplates]; fft.PeakCorrelation(work, reference); }));
+  }
+
+  void benchmarkLArFFTWBatch(Config const& config, int size, std::string const& option) {
+    int const batch = 16;
+    util::LArFFTWPlan plan(size, option, batch);
+    util::LArFFTWBatch fft(plan);
+
+    auto const templates = makeWaveforms(size, batch);
+    std::vector<double> block;
+    for (auto const& wave: templates) block.insert(block.end(), wave.begin(), wave.end());
+
+    util::LArFFTWPlan singlePlan(size, "ES");
+    util::LArFFTW single(singlePlan, 20);
+    std::vector<double> response = makeResponse(size);
+    util::LArFFTW::ComplexVector kern(size/2+1);
+    single.DoFFT(response, kern);
+
+    // ... each call processes a whole batch: the time is divided accordingly
+    std::vector<double> work;
+    Config batchConfig = config;
+    batchConfig.nChannels = std::max(1U, config.nChannels/batch);
+    report("LArFFTWBatch", "double", option, size, "Convolute",
+      timePerChannel(batchConfig, [&](unsigned int)
+        { work = block; fft.Convolute(work.data(), batch, kern); })/batch);
+    report("LArFFTWBatch", "double", option, size, "Deconvolute",
+      timePerChannel(batchConfig, [&](unsigned int)
+        { work = block; fft.Deconvolute(work.data(), batch, kern); })/batch);
+  }
+
+  void benchmarkFFTW(Config const& config) {
+    for (std::string const& option: config.options) {
+      for (int size: config.sizes) {
+        util::LArFFTWPlan plan(size, option, 1, "", util::LArFFTWPlan::kDoubleAndSingle);
+        util::LArFFTW fft(plan, 20);
+        benchmarkLArFFTW<double>(config, fft, size, option);
+        benchmarkLArFFTW<float>(config, fft, size, option);
+        benchmarkLArFFTWBatch(config, size, option);
+      }
+    }
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//--- LArFFT service
+//---
+namespace {
+
+  void benchmarkLArFFT(Config const& config, std::string const& backend) {
+    art::ActivityRegistry registry;
+    for (int size: config.sizes) {
+      if (!isPowerOfTwo(size)) continue;
+
+      fhicl::ParameterSet pset;
+      pset.put("FFTSize", size);
+      std::string const option = (backend == "FFTW")? "ES": "";
+      pset.put("FFTOption", option);
+      pset.put("FitBins", 20);
+      pset.put("FFTBackend", backend);
+      util::LArFFT fft(pset, registry);
+
+      auto const templates = makeWaveforms(size, std::min(config.nChannels, 16U));
+      auto const nTemplates = templates.size();
+      std::vector<double> response = makeResponse(size);
+      std::vector<TComplex> kern(size/2+1);
+      fft.DoFFT(response, kern);
+
+      std::string const engine = "LArFFT/" + backend;
+      std::vector<double> work;
+      std::vector<TComplex> spectrum(size/2+1);
+
+      report(engine, "double", "", size, "DoFFT",
+        timePerChannel(config, [&](unsigned int c)
+          { work = templates[c % nTemplates]; fft.DoFFT(work, spectrum); }));
+      report(engine, "double", "", size, "Convolute",
+        timePerChannel(config, [&](unsigned int c)
+          { work = templates[c % nTemplates]; fft.Convolute(work, kern); }));
+      report(engine, "double", "", size, "Deconvolute",
+        timePerChannel(config, [&](unsigned int c)
+          { work = templates[c % nTemplates]; fft.Deconvolute(work, kern); }));
+
+      std::vector<double> reference = templates[0];
+      report(engine, "double", "", size, "PeakCorrelation",
+        timePerChannel(config, [&](unsigned int c)
+          { work = templates[c % nTemplates]; fft.PeakCorrelation(work, reference); }));
+
+      // alternating between two sizes reuses the transforms in the registry
+      report(engine, "double", "", size, "ReinitializeFFT",
+        timePerChannel(config, [&](unsigned int c)
+          { fft.ReinitializeFFT((c % 2)? 2*size: size, option, 20); }));
+    }
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//---
+
+int main(int argc, char** argv) {
+
+  Config config;
+
+  //
+  // command line argument parsing
+  //
+  try {
+    for (int iArg = 1; iArg < argc; ++iArg) {
+      std::string const arg = argv[iArg];
+      auto value = [&]() -> std::string {
+        if (++iArg >= argc) throw std::runtime_error("option " + arg + " needs a value");
+        return argv[iArg];
+      };
+      if (arg == "--sizes")         config.sizes = parseList<int>(value());
+      else if (arg == "--options")  config.options = parseList<std::string>(value());
+      else if (arg == "--channels") config.nChannels = std::stoul(value());
+      else if (arg == "--repeat")   config.nRepeat = std::stoul(value());
+      else if (arg == "--no-larfft") config.doLArFFT = false;
+      else if (arg == "--simd") {
+        std::string const level = value();
+        if (level == "scalar")      util::fftwsimd::SetLevel(util::fftwsimd::kScalar);
+        else if (level == "avx2")   util::fftwsimd::SetLevel(util::fftwsimd::kAVX2);
+        else if (level == "avx512") util::fftwsimd::SetLevel(util::fftwsimd::kAVX512);
+        else throw std::runtime_error("unknown SIMD level: '" + level + "'");
+      }
+      else if (arg == "--full") {
+        config.sizes = { 2048, 4096, 6000, 8192, 9595, 12000, 16384 };
+        config.options = { "ES", "M", "P" };
+        config.nChannels = 1000;
+      }
+      else throw std::runtime_error("unknown option: '" + arg + "'");
+    }
+    for (int size: config.sizes)
+      if (size < 200) throw std::runtime_error("transform sizes must be at least 200");
+    if (config.nChannels == 0 || config.nRepeat == 0)
+      throw std::runtime_error("channels and repetitions must be positive");
+  }
+  catch (std::exception const& e) {
+    std::cerr << "Invalid arguments: " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::cout << "Kernel loops: "
+    << util::fftwsimd::LevelName(util::fftwsimd::ActiveLevel())
+    << ", " << config.nChannels << " channels, best of " << config.nRepeat
+    << std::endl;
+
+  benchmarkFFTW(config);
+  if (config.doLArFFT) {
+    benchmarkLArFFT(config, "ROOT");
+    benchmarkLArFFT(config, "FFTW");
+  }
+
+  return 0;
+} // main()
@@ -0,0 +1,125 @@
+/**
+ * @file    LArFFTWBatch_test.cc
+ * @brief   Tests the batched transforms of read-only inputs of `LArFFTWBatch`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/LArFFTWBatch.h`
+ *
+ * The inputs are convoluted with a unit kernel, in more chunks than the batch
+ * size, and the projection extracting their samples is counted.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( LArFFTWBatch_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTWBatch.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <vector>
+
+
+namespace {
+
+  constexpr int Size = 64;
+  constexpr int BatchSize = 2;
+  constexpr std::size_t NInputs = 5U; // two full chunks and a partial one
+
+  /// Input with its samples in a data member (like `raw::RawDigit`)
+  struct Input_t {
+    std::vector<double> samples;
+  };
+
+  std::vector<Input_t> makeInputs() {
+    std::vector<Input_t> inputs(NInputs);
+    for (std::size_t iw = 0; iw < NInputs; ++iw) {
+      for (int i = 0; i < Size; ++i)
+        inputs[iw].samples.push_back(std::sin(0.1*(iw + 1)*i));
+    }
+    return inputs;
+  }
+
+  util::LArFFTWBatch::ComplexVector unitKernel()
+    { return util::LArFFTWBatch::ComplexVector(Size/2 + 1, 1.0); }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ProjectionByReferenceTest) {
+
+  util::LArFFTWPlan const plan(Size, "ES", BatchSize);
+  util::LArFFTWBatch batch(plan);
+
+  std::vector<Input_t> const inputs = makeInputs();
+  std::vector<std::vector<double>> outputs(NInputs);
+
+  unsigned int nCalls = 0U;
+  batch.Convolute(inputs, outputs, unitKernel(),
+    [&nCalls](Input_t const& input) -> std::vector<double> const&
+      { ++nCalls; return input.samples; }
+    );
+
+  BOOST_CHECK_EQUAL(nCalls, NInputs);
+  for (std::size_t iw = 0; iw < NInputs; ++iw) {
+    BOOST_CHECK_EQUAL(outputs[iw].size(), std::size_t(Size));
+    for (int i = 0; i < Size; ++i)
+      BOOST_CHECK_SMALL(outputs[iw][i] - inputs[iw].samples[i], 1e-9);
+  }
+
+} // ProjectionByReferenceTest
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ProjectionByValueTest) {
+
+  util::LArFFTWPlan const plan(Size, "ES", BatchSize);
+  util::LArFFTWBatch batch(plan);
+
+  std::vector<Input_t> const inputs = makeInputs();
+  std::vector<std::vector<float>> outputs(NInputs);
+
+  // like `recob::Wire::Signal()`, the projection returns a new vector
+  unsigned int nCalls = 0U;
+  batch.Deconvolute(inputs, outputs, unitKernel(),
+    [&nCalls](Input_t const& input)
+      {
+        ++nCalls;
+        return std::vector<float>(input.samples.begin(), input.samples.end());
+      }
+    );
+
+  BOOST_CHECK_EQUAL(nCalls, NInputs);
+  for (std::size_t iw = 0; iw < NInputs; ++iw) {
+    BOOST_CHECK_EQUAL(outputs[iw].size(), std::size_t(Size));
+    for (int i = 0; i < Size; ++i)
+      BOOST_CHECK_SMALL(outputs[iw][i] - inputs[iw].samples[i], 1e-5);
+  }
+
+} // ProjectionByValueTest
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BadInputTest) {
+
+  util::LArFFTWPlan const plan(Size, "ES", BatchSize);
+  util::LArFFTWBatch batch(plan);
+
+  std::vector<Input_t> inputs = makeInputs();
+  inputs.back().samples.pop_back();
+  std::vector<std::vector<double>> outputs(NInputs);
+
+  unsigned int nCalls = 0U;
+  BOOST_CHECK_THROW(
+    batch.Convolute(inputs, outputs, unitKernel(),
+      [&nCalls](Input_t const& input) -> std::vector<double> const&
+        { ++nCalls; return input.samples; }
+      ),
+    cet::exception
+    );
+  BOOST_CHECK_EQUAL(nCalls, NInputs);
+
+} // BadInputTest
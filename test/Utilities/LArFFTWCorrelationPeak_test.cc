@@ -0,0 +1,81 @@
+/**
+ * @file    LArFFTWCorrelationPeak_test.cc
+ * @brief   Tests the windowed correlation peak search of `LArFFTW`
+ * @see     `lardata/Utilities/LArFFTW.h`
+ *
+ * A Gaussian pulse shifted by a fraction of tick is correlated with the
+ * original one; the lag is compared with the shift, and the integer lag and
+ * peak value with the full correlation.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( LArFFTWCorrelationPeak_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace {
+
+  constexpr int Size = 512;
+
+  std::vector<double> makePulse(double peak) {
+    std::vector<double> pulse(Size);
+    for (int i = 0; i < Size; ++i)
+      pulse[i] = std::exp(-0.5*(i - peak)*(i - peak)/16.);
+    return pulse;
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(CorrelationPeakTestCase) {
+
+  util::LArFFTWPlan plan(Size, "ES");
+  util::LArFFTW fft(plan, 20);
+
+  std::vector<double> reference = makePulse(200.);
+  util::LArFFTW::ComplexVector refKern(Size/2+1);
+  fft.DoFFT(reference, refKern);
+
+  std::vector<std::vector<double>> const shapes
+    { makePulse(207.3), makePulse(195.6) };
+
+  auto const plain
+    = fft.FindCorrelationPeaks(shapes, refKern, -20, 20, util::LArFFTW::kNoInterpolation);
+  auto const parabolic
+    = fft.FindCorrelationPeaks(shapes, refKern, -20, 20, util::LArFFTW::kParabolic);
+  auto const sinc
+    = fft.FindCorrelationPeaks(shapes, refKern, -20, 20, util::LArFFTW::kSinc);
+  BOOST_CHECK_EQUAL(sinc.size(), shapes.size());
+
+  double const shifts[] = { 7.3, -4.4 };
+  for (std::size_t i = 0; i < shapes.size(); ++i) {
+    // ... integer lag and value as from the full correlation
+    std::vector<double> corr = shapes[i];
+    fft.Correlate(corr, refKern);
+    int const maxT = std::max_element(corr.begin(), corr.end()) - corr.begin();
+    int const lag = (maxT > Size/2)? maxT - Size: maxT;
+    BOOST_CHECK_EQUAL(plain[i].lag, lag);
+    BOOST_CHECK_CLOSE(plain[i].value, corr[maxT], 1e-8);
+
+    BOOST_CHECK_SMALL(parabolic[i].lag - shifts[i], 0.05);
+    BOOST_CHECK_SMALL(sinc[i].lag - shifts[i], 1e-4);
+    BOOST_CHECK_GE(sinc[i].value, plain[i].value);
+  } // for
+
+  // ... peak outside the window: the result stays at its edge
+  auto const edge
+    = fft.FindCorrelationPeak(shapes[0], refKern, -20, 5, util::LArFFTW::kSinc);
+  BOOST_CHECK_EQUAL(edge.lag, 5.);
+
+} // BOOST_AUTO_TEST_CASE(CorrelationPeakTestCase)
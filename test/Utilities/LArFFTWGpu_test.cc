@@ -0,0 +1,98 @@
+/**
+ * @file    LArFFTWGpu_test.cc
+ * @brief   Tests the batched transforms of `LArFFTWGpu`
+ * @see     `lardata/Utilities/LArFFTWGpu.h`
+ *
+ * The convolutions and deconvolutions of a collection of waveforms are
+ * compared with the ones of `LArFFTW`, one waveform at a time. Without a GPU
+ * (or without cuFFT support in the build) this tests the CPU fallback.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( LArFFTWGpu_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTWGpu.h"
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <complex>
+#include <vector>
+
+
+namespace {
+
+  constexpr int Size = 256;
+  constexpr int NWaveforms = 40; // more than a CPU batch
+
+  util::LArFFTWGpu::ComplexVector makeKernel() {
+    util::LArFFTWGpu::ComplexVector kernel(Size/2+1);
+    for (int i = 0; i <= Size/2; ++i)
+      kernel[i] = std::polar(1.0/(1.0 + 0.01*i), -0.05*i);
+    kernel[Size/2] = std::abs(kernel[Size/2]); // real at Nyquist frequency
+    return kernel;
+  }
+
+  std::vector<std::vector<double>> makeWaveforms() {
+    std::vector<std::vector<double>> waveforms(NWaveforms, std::vector<double>(Size));
+    for (int w = 0; w < NWaveforms; ++w)
+      for (int i = 0; i < Size; ++i)
+        waveforms[w][i] = std::sin(0.01*(w+1)*i) + 0.1*((i*w) % 7);
+    return waveforms;
+  }
+
+  void checkSame(std::vector<std::vector<double>> const& a,
+                 std::vector<std::vector<double>> const& b)
+  {
+    BOOST_REQUIRE_EQUAL(a.size(), b.size());
+    for (std::size_t w = 0; w < a.size(); ++w)
+      for (int i = 0; i < Size; ++i) BOOST_CHECK_SMALL(a[w][i] - b[w][i], 1e-9);
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BatchedTransformTestCase) {
+
+  util::LArFFTWPlan plan(Size, "ES");
+  util::LArFFTWPlan batchPlan(Size, "ES", 16);
+  util::LArFFTW fft(plan, 1);
+  util::LArFFTWGpu gpu(batchPlan);
+  BOOST_CHECK_EQUAL(gpu.TransformSize(), Size);
+  if (!util::LArFFTWGpu::DeviceAvailable()) BOOST_CHECK(!gpu.OnDevice());
+
+  auto const kernel = makeKernel();
+  auto const waveforms = makeWaveforms();
+
+  // ... convolution
+  auto expected = waveforms;
+  for (auto& wave: expected) fft.Convolute(wave, kernel);
+  auto convoluted = waveforms;
+  gpu.Convolute(convoluted, kernel);
+  checkSame(convoluted, expected);
+
+  // ... deconvolution (on a contiguous block) undoes the convolution
+  std::vector<double> block;
+  for (auto const& wave: convoluted) block.insert(block.end(), wave.begin(), wave.end());
+  gpu.Deconvolute(block.data(), NWaveforms, kernel);
+  for (int w = 0; w < NWaveforms; ++w)
+    for (int i = 0; i < Size; ++i)
+      BOOST_CHECK_SMALL(block[w*Size + i] - waveforms[w][i], 1e-9);
+
+  // ... the CPU engine gives the same result when requested explicitly
+  util::LArFFTWGpu cpu(batchPlan, false);
+  BOOST_CHECK(!cpu.OnDevice());
+  auto onCPU = waveforms;
+  cpu.Convolute(onCPU, kernel);
+  checkSame(onCPU, convoluted);
+
+  // ... a kernel of the wrong size is rejected
+  util::LArFFTWGpu::ComplexVector const badKernel(Size);
+  BOOST_CHECK_THROW(gpu.Convolute(onCPU, badKernel), cet::exception);
+
+} // BOOST_AUTO_TEST_CASE(BatchedTransformTestCase)
@@ -0,0 +1,193 @@
+/**
+ * @file    LArFFTWPlan_test.cc
+ * @brief   Tests the job-wide registry of shared `LArFFTWPlan`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/LArFFTWPlan.h`
+ *
+ * Plans requested with the same parameters are shared, and engines from
+ * concurrent threads use a shared plan with their own buffers. Transforms in
+ * a precision the plan was not made for are refused. The wisdom
+ * learnt by planning is written to its file without leftovers.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( LArFFTWPlan_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWBatch.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <cstdio> // std::remove()
+#include <cstdlib> // mkdtemp()
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h> // rmdir()
+
+
+namespace {
+
+  constexpr int Size = 256;
+
+  std::vector<double> makePulse(double peak) {
+    std::vector<double> pulse(Size);
+    for (int i = 0; i < Size; ++i)
+      pulse[i] = std::exp(-0.5*(i - peak)*(i - peak)/9.);
+    return pulse;
+  }
+
+  std::vector<std::string> listDirectory(std::string const& dir) {
+    std::vector<std::string> names;
+    DIR* dp = opendir(dir.c_str());
+    if (!dp) return names;
+    while (dirent* entry = readdir(dp)) {
+      std::string const name = entry->d_name;
+      if ((name != ".") && (name != "..")) names.push_back(name);
+    }
+    closedir(dp);
+    return names;
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SharedPlanTestCase) {
+
+  util::LArFFTWPlan::ClearShared();
+
+  auto const plan = util::LArFFTWPlan::Shared(Size, "ES");
+  BOOST_CHECK_EQUAL(plan->TransformSize(), Size);
+  BOOST_CHECK_EQUAL(util::LArFFTWPlan::NShared(), 1U);
+
+  // the key is the planning flags, not the option string
+  BOOST_CHECK(util::LArFFTWPlan::Shared(Size, "es") == plan);
+  BOOST_CHECK(util::LArFFTWPlan::Shared(Size, "") == plan);
+  BOOST_CHECK_EQUAL(util::LArFFTWPlan::NShared(), 1U);
+
+  BOOST_CHECK(util::LArFFTWPlan::Shared(2*Size, "ES") != plan);
+  BOOST_CHECK(util::LArFFTWPlan::Shared(Size, "ES", 4) != plan);
+  BOOST_CHECK(util::LArFFTWPlan::Shared
+    (Size, "ES", 1, "", util::LArFFTWPlan::kDoubleAndSingle) != plan);
+  BOOST_CHECK_EQUAL(util::LArFFTWPlan::NShared(), 4U);
+
+  // handles given out stay valid after the registry is cleared
+  util::LArFFTWPlan::ClearShared();
+  BOOST_CHECK_EQUAL(util::LArFFTWPlan::NShared(), 0U);
+  BOOST_CHECK_EQUAL(plan->TransformSize(), Size);
+  BOOST_CHECK(util::LArFFTWPlan::Shared(Size, "ES") != plan);
+
+} // SharedPlanTestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SharedPlanEnginesTestCase) {
+
+  util::LArFFTWPlan::ClearShared();
+
+  // reference result from an engine with private plans
+  util::LArFFTWPlan privatePlan(Size, "ES");
+  util::LArFFTW reference(privatePlan, 20);
+  std::vector<double> const response = makePulse(3.);
+  std::vector<double> expected = makePulse(100.);
+  util::LArFFTW::ComplexVector kern(Size/2+1);
+  {
+    std::vector<double> resp = response;
+    reference.DoFFT(resp, kern);
+  }
+  reference.Convolute(expected, kern);
+
+  // engines of different threads sharing the same plan
+  constexpr unsigned int NThreads = 4;
+  std::vector<std::vector<double>> results(NThreads, makePulse(100.));
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&results, &kern, iThread](){
+      util::LArFFTW fft(Size, "ES", 20);
+      for (int i = 0; i < 10; ++i) {
+        std::vector<double> work = makePulse(100.);
+        fft.Convolute(work, kern);
+        results[iThread] = work;
+      }
+    });
+  }
+  for (auto& thread: threads) thread.join();
+  BOOST_CHECK_EQUAL(util::LArFFTWPlan::NShared(), 1U);
+
+  for (auto const& result: results) {
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+    for (int i = 0; i < Size; ++i)
+      BOOST_CHECK_SMALL(result[i] - expected[i], 1e-12);
+  }
+
+} // SharedPlanEnginesTestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MissingPrecisionTestCase) {
+
+  util::LArFFTW::ComplexVector const kern(Size/2+1, 1.);
+  util::LArFFTW::ComplexVectorF const kernF(Size/2+1, 1.f);
+
+  // single precision only: float data is transformed, double data is refused
+  util::LArFFTWPlan const singlePlan
+    (Size, "ES", 1, "", util::LArFFTWPlan::kSingle);
+  BOOST_CHECK(!singlePlan.HasDoublePrecision());
+  util::LArFFTW single(singlePlan, 20);
+  BOOST_CHECK(single.HasSinglePrecision());
+
+  std::vector<float> dataF(Size, 1.f);
+  single.Convolute(dataF, kernF);
+  BOOST_CHECK_SMALL(dataF[0] - 1.f, 1e-5f);
+
+  std::vector<double> data(Size, 1.);
+  BOOST_CHECK_THROW(single.Convolute(data, kern), cet::exception);
+  BOOST_CHECK_THROW(single.DoFFT(data), cet::exception);
+  BOOST_CHECK_THROW(single.DoInvFFT(data), cet::exception);
+  BOOST_CHECK_THROW(single.ConvoluteInPlace(data.data(), data.size(), kern),
+                    cet::exception);
+  BOOST_CHECK_THROW(util::LArFFTWBatch{ singlePlan }, cet::exception);
+
+  // double precision only: float data falls back to double precision
+  util::LArFFTWPlan const doublePlan(Size, "ES");
+  util::LArFFTW dbl(doublePlan, 20);
+  BOOST_CHECK(!dbl.HasSinglePrecision());
+  dataF.assign(Size, 1.f);
+  dbl.Convolute(dataF, kern);
+  BOOST_CHECK_SMALL(dataF[0] - 1.f, 1e-5f);
+  BOOST_CHECK_THROW(dbl.ConvoluteInPlace(dataF.data(), dataF.size(), kernF),
+                    cet::exception);
+
+} // MissingPrecisionTestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WisdomExportTestCase) {
+
+  char dirTemplate[] = "/tmp/LArFFTWPlan_test_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(dirTemplate));
+  std::string const dir = dirTemplate;
+
+  // measured planning learns wisdom, which is written under its final name
+  {
+    util::LArFFTWPlan const plan(64, "M", 1, dir);
+    util::LArFFTWPlan const planF
+      (64, "M", 1, dir, util::LArFFTWPlan::kSingle);
+  }
+  std::string const wisdomFile = util::LArFFTWPlan::WisdomFileName(dir, 64);
+  std::vector<std::string> const names = listDirectory(dir);
+  BOOST_CHECK_EQUAL(names.size(), 2U);
+  for (std::string const& name: names) {
+    std::string const path = dir + "/" + name;
+    BOOST_CHECK((path == wisdomFile) || (path == wisdomFile + ".float"));
+    std::remove(path.c_str());
+  }
+  rmdir(dir.c_str());
+
+} // WisdomExportTestCase
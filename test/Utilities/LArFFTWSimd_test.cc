@@ -0,0 +1,126 @@
+/**
+ * @file    LArFFTWSimd_test.cc
+ * @brief   Tests the vectorised spectrum loops in `LArFFTWSimd.h`
+ * @see     `lardata/Utilities/LArFFTWSimd.h`
+ *
+ * All the implementations supported by the machine running the test are
+ * compared with the plain C++ one and with `std::complex` arithmetic, and
+ * the raw ADC loader with the direct computation.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( LArFFTWSimd_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTWSimd.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <complex>
+#include <vector>
+
+
+namespace {
+
+  using namespace util::fftwsimd;
+
+  template <class Real>
+  std::vector<std::complex<Real>> makeSpectrum(std::size_t n, double seed) {
+    std::vector<std::complex<Real>> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+      v[i] = { Real(std::sin(seed*(i+1)) + 1.5), Real(std::cos(0.7*seed*(i+1))) };
+    return v;
+  }
+
+  template <class Real> Real const* raw(std::vector<std::complex<Real>> const& v)
+    { return reinterpret_cast<Real const*>(v.data()); }
+  template <class Real> Real* raw(std::vector<std::complex<Real>>& v)
+    { return reinterpret_cast<Real*>(v.data()); }
+
+  template <class Real>
+  void checkLevel(Level level, double tol) {
+    BOOST_TEST_MESSAGE("Testing " << LevelName(level) << " implementation");
+    BOOST_CHECK_EQUAL(SetLevel(level), level);
+
+    // sizes not multiple of the register width exercise the remainder loops
+    for (std::size_t n: { 1U, 2U, 3U, 7U, 8U, 17U, 1025U }) {
+      auto const in = makeSpectrum<Real>(n, 0.3);
+      auto const k = makeSpectrum<Real>(n, 1.1);
+      Real const scale = 0.25;
+
+      std::vector<std::complex<Real>> mul(n), conj(n), div(n);
+      Multiply(raw(in), raw(k), raw(mul), n, scale);
+      MultiplyConj(raw(in), raw(k), raw(conj), n, scale);
+      Divide(raw(in), raw(k), raw(div), n, scale);
+
+      // in place
+      auto inPlace = in;
+      Divide(raw(inPlace), raw(k), raw(inPlace), n, scale);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        BOOST_CHECK_SMALL(std::abs(mul[i] - scale*in[i]*k[i]), Real(tol));
+        BOOST_CHECK_SMALL(std::abs(conj[i] - scale*in[i]*std::conj(k[i])), Real(tol));
+        BOOST_CHECK_SMALL(std::abs(div[i] - scale*in[i]/k[i]), Real(tol));
+        BOOST_CHECK_EQUAL(inPlace[i], div[i]);
+      }
+
+      std::vector<Real> sum(2*n), addend(2*n);
+      for (std::size_t i = 0; i < 2*n; ++i) { sum[i] = i; addend[i] = 0.5*i; }
+      Add(sum.data(), addend.data(), 2*n);
+      for (std::size_t i = 0; i < 2*n; ++i) BOOST_CHECK_EQUAL(sum[i], Real(1.5*i));
+
+      std::vector<short> adc(2*n);
+      std::vector<Real> window(2*n), loaded(2*n), windowed(2*n);
+      for (std::size_t i = 0; i < 2*n; ++i) {
+        adc[i] = short(400 + 37*i % 211) * ((i % 3)? 1: -1);
+        window[i] = 0.5 + 0.25*(i % 4);
+      }
+      Real const pedestal = 401.5;
+      LoadADC(adc.data(), loaded.data(), 2*n, pedestal);
+      LoadADC(adc.data(), windowed.data(), 2*n, pedestal, window.data());
+      for (std::size_t i = 0; i < 2*n; ++i) {
+        BOOST_CHECK_EQUAL(loaded[i], adc[i] - pedestal);
+        BOOST_CHECK_EQUAL(windowed[i], (adc[i] - pedestal)*window[i]);
+      }
+    }
+  }
+
+  template <class Real>
+  void checkAllLevels(double tol) {
+    Level const detected = DetectedLevel();
+    for (Level level: { kScalar, kAVX2, kAVX512 })
+      if (level <= detected) checkLevel<Real>(level, tol);
+    SetLevel(detected);
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MultiplyDoubleTestCase) {
+  checkAllLevels<double>(1e-14);
+}
+
+BOOST_AUTO_TEST_CASE(MultiplyFloatTestCase) {
+  checkAllLevels<float>(1e-5);
+}
+
+BOOST_AUTO_TEST_CASE(RotateTestCase) {
+  std::size_t const n = 1000;
+  double const phase = -0.0123;
+  auto data = makeSpectrum<double>(n, 0.3);
+  auto const expected = data;
+  Rotate(raw(data), n, phase);
+  for (std::size_t i = 0; i < n; ++i) {
+    BOOST_CHECK_SMALL
+      (std::abs(data[i] - expected[i]*std::polar(1.0, phase*i)), 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LevelCapTestCase) {
+  Level const detected = DetectedLevel();
+  BOOST_CHECK_EQUAL(SetLevel(kAVX512), detected);
+  BOOST_CHECK_EQUAL(ActiveLevel(), detected);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file    MakeIndex_test.cc
+ * @brief   Tests the serial and parallel index makers
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/MakeIndex.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/MakeIndex.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( MakeIndex_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <algorithm> // std::shuffle()
+#include <numeric> // std::iota()
+#include <random>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+/// A datum with a key, like a wire with its channel
+struct Datum {
+  std::size_t key;
+  int value;
+};
+
+struct KeyOf {
+  std::size_t operator() (Datum const& datum) const { return datum.key; }
+};
+
+
+/// Returns data with shuffled keys, some missing and some duplicate
+std::vector<Datum> makeData(std::size_t n) {
+  std::vector<std::size_t> keys(n);
+  std::iota(keys.begin(), keys.end(), 0U);
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine(12345));
+  std::vector<Datum> data;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i % 7 == 3) continue; // a hole
+    data.push_back({ 2 * keys[i], int(i) });
+  }
+  data.push_back({ data.front().key, -1 }); // a duplicate of the first one
+  return data;
+} // makeData()
+
+
+//------------------------------------------------------------------------------
+void RunMakeIndexTest() {
+
+  std::vector<Datum> const data = makeData(100000);
+
+  std::vector<std::size_t> const expected = util::MakeIndex(data, KeyOf());
+  BOOST_CHECK_EQUAL(expected[data.front().key], data.size() - 1);
+
+  // the parallel version matches the serial one, keeping the last duplicate
+  std::vector<std::size_t> Index = util::ParallelMakeIndex(data, KeyOf());
+  BOOST_CHECK(Index == expected);
+
+  // reusing the buffer
+  Index.assign(1000000U, 5U);
+  util::ParallelMakeIndex(data, KeyOf(), Index);
+  BOOST_CHECK(Index == expected);
+  std::vector<std::size_t> serial(1000000U, 5U);
+  util::MakeIndex(data, KeyOf(), serial);
+  BOOST_CHECK(serial == expected);
+
+  // conflict policies
+  util::ParallelMakeIndex
+    (data, KeyOf(), Index, util::DuplicateKeyPolicy::KeepFirst);
+  BOOST_CHECK_EQUAL(Index[data.front().key], 0U);
+  BOOST_CHECK_THROW(
+    util::ParallelMakeIndex
+      (data, KeyOf(), Index, util::DuplicateKeyPolicy::Throw),
+    std::runtime_error
+    );
+  std::vector<Datum> const unique(data.begin(), data.end() - 1);
+  util::ParallelMakeIndex
+    (unique, KeyOf(), Index, util::DuplicateKeyPolicy::Throw);
+  BOOST_CHECK(Index == util::MakeIndex(unique, KeyOf()));
+
+  // empty collection
+  util::ParallelMakeIndex(std::vector<Datum>(), KeyOf(), Index);
+  BOOST_CHECK(Index.empty());
+
+} // RunMakeIndexTest()
+
+
+//------------------------------------------------------------------------------
+void RunMakeMapTest() {
+
+  std::vector<Datum> const data = makeData(50000);
+
+  auto const expected = util::MakeMap(data, KeyOf());
+  BOOST_CHECK_EQUAL(expected[data.front().key], &data.back());
+
+  auto Map = util::ParallelMakeMap(data, KeyOf());
+  BOOST_CHECK(Map == expected);
+
+  util::ParallelMakeMap
+    (data, KeyOf(), Map, util::DuplicateKeyPolicy::KeepFirst);
+  BOOST_CHECK_EQUAL(Map[data.front().key], &data.front());
+  BOOST_CHECK(!Map[1]); // odd keys are holes
+
+} // RunMakeMapTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MakeIndexTestCase) {
+  RunMakeIndexTest();
+} // MakeIndexTestCase
+
+BOOST_AUTO_TEST_CASE(MakeMapTestCase) {
+  RunMakeMapTest();
+} // MakeMapTestCase
@@ -0,0 +1,182 @@
+/**
+ * @file    MarqFitAlg_test.cc
+ * @brief   Tests the Gaussian fits of `gshf::MarqFitAlg`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/MarqFitAlg.h`
+ *
+ * Pulses of known Gaussians are fitted with the workspace of the thread and
+ * with explicit workspaces, and by several threads sharing one algorithm.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( MarqFitAlg_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+#include <boost/test/floating_point_comparison.hpp> // BOOST_CHECK_CLOSE()
+
+// LArSoft libraries
+#include "lardata/Utilities/MarqFitAlg.h"
+
+// C/C++ standard libraries
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+  constexpr float ChiCut = 1e-4f;
+  constexpr int MaxTrials = 100;
+
+  using Params_t = std::vector<float>;
+
+  /// Pulse of nData samples with the Gaussians of params (amplitude, mean, RMS)
+  std::vector<float> makePulse(Params_t const& params, int nData) {
+    std::vector<float> y(nData, 0.0f);
+    for (int i = 0; i < nData; ++i) {
+      for (std::size_t j = 0; j < params.size(); j += 3) {
+        float const x = (i - params[j+1]) / params[j+2];
+        y[i] += params[j] * std::exp(-0.5f * x * x);
+      }
+    }
+    return y;
+  }
+
+  /// Starting point of the fit: parameters off by 10%
+  Params_t seed(Params_t params) {
+    for (float& p: params) p *= 1.1f;
+    return params;
+  }
+
+  /// Fitted parameters, and number of failed steps (no Boost checks here,
+  /// since fits also run in other threads)
+  struct Fit_t { Params_t params; int nFailed = 0; };
+
+  /// Fits with the workspace of the thread
+  Fit_t fit(gshf::MarqFitAlg& alg, Params_t const& params, int nData) {
+    std::vector<float> y = makePulse(params, nData);
+    Fit_t result { seed(params) };
+    Params_t& p = result.params;
+    float lambda = -1.0f, chiSqr = 0.0f, dchiSqr = 0.0f;
+    int trial = 0;
+    do {
+      if (alg.mrqdtfit(lambda, p.data(), y.data(), p.size(), nData, chiSqr, dchiSqr))
+        ++result.nFailed;
+    } while ((++trial < MaxTrials) && (std::abs(dchiSqr) >= ChiCut));
+    return result;
+  }
+
+  /// Fits with the specified workspace
+  Fit_t fit(gshf::MarqFitAlg& alg, gshf::MarqFitAlg::Workspace& work,
+            Params_t const& params, int nData)
+  {
+    std::vector<float> y = makePulse(params, nData);
+    Fit_t result { seed(params) };
+    Params_t& p = result.params;
+    float lambda = -1.0f, chiSqr = 0.0f, dchiSqr = 0.0f;
+    int trial = 0;
+    do {
+      if (alg.mrqdtfit(work, lambda, p.data(), nullptr, nullptr,
+        y.data(), p.size(), nData, chiSqr, dchiSqr))
+        ++result.nFailed;
+    } while ((++trial < MaxTrials) && (std::abs(dchiSqr) >= ChiCut));
+    return result;
+  }
+
+  void checkFit(Fit_t const& fitted, Params_t const& expected) {
+    BOOST_CHECK_EQUAL(fitted.nFailed, 0);
+    BOOST_CHECK_EQUAL(fitted.params.size(), expected.size());
+    if (fitted.params.size() != expected.size()) return;
+    for (std::size_t j = 0; j < expected.size(); ++j)
+      BOOST_CHECK_CLOSE(fitted.params[j], expected[j], 0.1);
+  }
+
+  /// The test pulses, with different numbers of parameters and samples
+  struct Pulse_t { Params_t params; int nData; };
+  std::array<Pulse_t, 4> const Pulses = {{
+    { { 50.0f, 20.0f, 3.0f }, 40 },
+    { { 30.0f, 12.0f, 2.0f, 20.0f, 30.0f, 4.0f }, 50 },
+    { { 80.0f, 5.0f, 1.5f }, 12 },
+    { { 10.0f, 30.0f, 5.0f, 40.0f, 50.0f, 2.5f, 25.0f, 70.0f, 3.5f }, 100 },
+  }};
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ThreadWorkspaceTestCase) {
+
+  gshf::MarqFitAlg alg;
+  for (Pulse_t const& pulse: Pulses)
+    checkFit(fit(alg, pulse.params, pulse.nData), pulse.params);
+
+  // parameter errors of a perfect fit are finite and positive
+  Pulse_t const& pulse = Pulses[1];
+  std::vector<float> y = makePulse(pulse.params, pulse.nData);
+  Params_t p = pulse.params;
+  Params_t perr(p.size());
+  BOOST_CHECK_EQUAL
+    (alg.cal_perr(p.data(), y.data(), p.size(), pulse.nData, perr.data()), 0);
+  for (float err: perr) BOOST_CHECK(std::isfinite(err) && (err > 0.0f));
+
+} // ThreadWorkspaceTestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ExplicitWorkspaceTestCase) {
+
+  gshf::MarqFitAlg alg;
+  gshf::MarqFitAlg::Workspace work;
+  for (Pulse_t const& pulse: Pulses) {
+    Fit_t const fitted = fit(alg, work, pulse.params, pulse.nData);
+    checkFit(fitted, pulse.params);
+    // the same steps as with the workspace of the thread
+    Params_t const reference = fit(alg, pulse.params, pulse.nData).params;
+    BOOST_CHECK_EQUAL_COLLECTIONS(fitted.params.begin(), fitted.params.end(),
+      reference.begin(), reference.end());
+  }
+
+  Pulse_t const& pulse = Pulses[1];
+  std::vector<float> y = makePulse(pulse.params, pulse.nData);
+  Params_t p = pulse.params;
+  Params_t perr(p.size()), reference(p.size());
+  BOOST_CHECK_EQUAL(alg.cal_perr
+    (work, p.data(), y.data(), p.size(), pulse.nData, perr.data()), 0);
+  BOOST_CHECK_EQUAL(alg.cal_perr
+    (p.data(), y.data(), p.size(), pulse.nData, reference.data()), 0);
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (perr.begin(), perr.end(), reference.begin(), reference.end());
+
+} // ExplicitWorkspaceTestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SharedAlgorithmTestCase) {
+
+  // threads fitting pulses of different sizes with the same algorithm
+  gshf::MarqFitAlg alg;
+  constexpr unsigned int NIterations = 200U;
+
+  std::vector<Fit_t> results
+    (Pulses.size() * 2U * NIterations); // written by one thread each
+  std::vector<std::thread> threads;
+  for (std::size_t iPulse = 0; iPulse < Pulses.size(); ++iPulse) {
+    threads.emplace_back([&alg, &results, iPulse](){
+      Pulse_t const& pulse = Pulses[iPulse];
+      gshf::MarqFitAlg::Workspace work;
+      for (unsigned int i = 0; i < NIterations; ++i) {
+        std::size_t const index = (iPulse * NIterations + i) * 2U;
+        results[index] = fit(alg, pulse.params, pulse.nData);
+        results[index + 1U] = fit(alg, work, pulse.params, pulse.nData);
+      }
+    });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  for (std::size_t iPulse = 0; iPulse < Pulses.size(); ++iPulse) {
+    for (unsigned int i = 0; i < 2U * NIterations; ++i)
+      checkFit(results[iPulse * 2U * NIterations + i], Pulses[iPulse].params);
+  }
+
+} // SharedAlgorithmTestCase
@@ -0,0 +1,144 @@
+/**
+ * @file    MemoryAccounting_test.cc
+ * @brief   Tests the accounting of the live buffers of lardata helpers
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/MemoryAccounting.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// LArSoft libraries
+#include "lardata/Utilities/MemoryAccounting.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( MemoryAccounting_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <thread>
+#include <utility> // std::move()
+#include <vector>
+
+
+struct BufferTag { static constexpr char const* Name = "buffer"; };
+struct OtherTag { static constexpr char const* Name = "other"; };
+struct ThreadTag { static constexpr char const* Name = "thread"; };
+
+
+//------------------------------------------------------------------------------
+void RunAccountTest() {
+
+  using Accounting_t = lar::MemoryAccounting;
+
+  lar::MemoryUsage_t const start = Accounting_t::GetUsage<BufferTag>();
+  {
+    lar::MemoryAccount<BufferTag> account(1000U);
+    BOOST_CHECK_EQUAL(account.bytes(), 1000U);
+    BOOST_CHECK_EQUAL(Accounting_t::GetUsage<BufferTag>().live, start.live + 1000);
+
+    account.set(3000U);
+    account.set(2000U);
+    lar::MemoryUsage_t const usage = Accounting_t::GetUsage<BufferTag>();
+    BOOST_CHECK_EQUAL(usage.live, start.live + 2000);
+    BOOST_CHECK_EQUAL(usage.peak, start.live + 3000);
+
+    // a copy registers its bytes again, a move transfers them
+    lar::MemoryAccount<BufferTag> copy(account);
+    BOOST_CHECK_EQUAL(Accounting_t::GetUsage<BufferTag>().live, start.live + 4000);
+    lar::MemoryAccount<BufferTag> moved(std::move(copy));
+    BOOST_CHECK_EQUAL(copy.bytes(), 0U);
+    BOOST_CHECK_EQUAL(moved.bytes(), 2000U);
+    BOOST_CHECK_EQUAL(Accounting_t::GetUsage<BufferTag>().live, start.live + 4000);
+
+    account = std::move(moved);
+    BOOST_CHECK_EQUAL(account.bytes(), 2000U);
+    BOOST_CHECK_EQUAL(Accounting_t::GetUsage<BufferTag>().live, start.live + 2000);
+  }
+  BOOST_CHECK_EQUAL(Accounting_t::GetUsage<BufferTag>().live, start.live);
+  BOOST_CHECK_EQUAL(Accounting_t::GetUsage<BufferTag>().peak, start.live + 4000);
+
+} // RunAccountTest()
+
+
+//------------------------------------------------------------------------------
+void RunScopeTest() {
+
+  using Accounting_t = lar::MemoryAccounting;
+
+  lar::MemoryAccount<BufferTag> before(500U); // registered out of the scope
+
+  Accounting_t::Scope_t scope;
+  scope.clear();
+  BOOST_CHECK(Accounting_t::setScope(&scope) == nullptr);
+  {
+    lar::MemoryAccount<BufferTag> buffer(1000U);
+    lar::MemoryAccount<OtherTag> other(300U);
+    buffer.release();
+    before.release();
+  }
+  BOOST_CHECK(Accounting_t::setScope(nullptr) == &scope);
+  lar::MemoryAccount<BufferTag> after(5000U); // not in the scope
+
+  lar::MemoryUsage_t const& buffer
+    = scope.tags[Accounting_t::tagID<BufferTag>()];
+  BOOST_CHECK_EQUAL(buffer.peak, 1000);
+  BOOST_CHECK_EQUAL(buffer.live, -500);
+  lar::MemoryUsage_t const& other = scope.tags[Accounting_t::tagID<OtherTag>()];
+  BOOST_CHECK_EQUAL(other.peak, 300);
+  BOOST_CHECK_EQUAL(other.live, 0);
+  BOOST_CHECK_EQUAL(scope.total.peak, 1300);
+  BOOST_CHECK_EQUAL(scope.total.live, -500);
+
+} // RunScopeTest()
+
+
+//------------------------------------------------------------------------------
+void RunThreadTest() {
+
+  using Accounting_t = lar::MemoryAccounting;
+
+  constexpr unsigned int NThreads = 4U;
+  constexpr std::size_t N = 10000U;
+  lar::MemoryAccount<ThreadTag> barrier(1U);
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < NThreads; ++i) {
+    threads.emplace_back([](){
+      lar::MemoryAccount<ThreadTag> account;
+      for (std::size_t n = 1U; n <= N; ++n) account.set(n);
+      });
+  }
+  for (std::thread& t: threads) t.join();
+
+  lar::MemoryUsage_t const usage = Accounting_t::GetUsage<ThreadTag>();
+  BOOST_CHECK_EQUAL(usage.live, 1);
+  BOOST_CHECK_GE(usage.peak, (long long)(N + 1U));
+  BOOST_CHECK_LE(usage.peak, (long long)(NThreads * N + 1U));
+
+  // the job total includes all the tags
+  BOOST_CHECK_GE(Accounting_t::GetTotalUsage().peak, usage.peak);
+
+  bool found = false;
+  for (auto const& [ name, tagUsage ]: Accounting_t::GetUsage()) {
+    if (name != "thread") continue;
+    found = true;
+    BOOST_CHECK_EQUAL(tagUsage.peak, usage.peak);
+  }
+  BOOST_CHECK(found);
+
+} // RunThreadTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MemoryAccountTestCase) {
+  RunAccountTest();
+}
+
+BOOST_AUTO_TEST_CASE(MemoryScopeTestCase) {
+  RunScopeTest();
+}
+
+BOOST_AUTO_TEST_CASE(MemoryThreadTestCase) {
+  RunThreadTest();
+}
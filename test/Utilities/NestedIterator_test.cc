@@ -15,6 +15,8 @@
 #include <map>
 #include <random>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 // Boost libraries
 /*
@@ -145,6 +147,81 @@ void RunVectorMapTest() {
 } // RunVectorMapTest()
 
 
+/**
+ * @brief Tests the flattened index of a vector of vectors and of a map
+ *
+ * The test fills a sequence of integers in a two-level structure (with some
+ * empty containers), flattens it and checks the random access to it, and
+ * the visit of the sequence split in a few threads.
+ */
+void RunFlattenedTest() {
+
+  using DoubleVectorI_t = std::vector<std::vector<int>>;
+  DoubleVectorI_t data(1);
+  constexpr size_t NElements = 10000;
+  constexpr float SwitchProbability = 0.1;
+
+  static std::default_random_engine random_engine(RandomSeed);
+  std::uniform_real_distribution<float> uniform(0., 1.);
+
+  data.emplace_back(); // an empty container, for sure
+  for (size_t i = 0; i < NElements; ++i) {
+    if (uniform(random_engine) < SwitchProbability) data.emplace_back();
+    data.back().push_back(i);
+  } // for
+  data.emplace_back(); // an empty container at the end, too
+
+  auto const flat = lar::flatten_nested(data);
+  BOOST_CHECK_EQUAL(flat.size(), NElements);
+  BOOST_CHECK_EQUAL(flat.n_inner(), data.size());
+  BOOST_CHECK_EQUAL(flat.offsets().size(), data.size() + 1);
+
+  unsigned int nMismatches = 0;
+  for (size_t i = 0; i < NElements; ++i) {
+    if (flat[i] != (int) i) ++nMismatches;
+    auto const pos = flat.locate(i);
+    if (&flat.element(pos) != &data[pos.outer][pos.inner]) ++nMismatches;
+  } // for
+  BOOST_CHECK_EQUAL(nMismatches, 0U);
+  BOOST_CHECK_THROW(flat.at(NElements), std::out_of_range);
+
+  // visit in chunks, from different threads
+  constexpr size_t NChunks = 4;
+  std::vector<size_t> visited(NChunks, 0), mismatches(NChunks, 0);
+  std::vector<std::thread> threads;
+  for (size_t iChunk = 0; iChunk < NChunks; ++iChunk) {
+    threads.emplace_back([&flat, &visited, &mismatches, iChunk](){
+      size_t const first = NElements * iChunk / NChunks;
+      size_t const last = NElements * (iChunk + 1) / NChunks;
+      int expected = first;
+      flat.for_each(first, last, [&](int v){
+        if (v != expected++) ++mismatches[iChunk];
+        ++visited[iChunk];
+      });
+    });
+  } // for
+  for (auto& thread: threads) thread.join();
+  size_t nVisited = 0;
+  for (size_t iChunk = 0; iChunk < NChunks; ++iChunk) {
+    BOOST_CHECK_EQUAL(mismatches[iChunk], 0U);
+    nVisited += visited[iChunk];
+  }
+  BOOST_CHECK_EQUAL(nVisited, NElements);
+
+  // a map of vectors
+  using VectorMapI_t = std::map<int, std::vector<int>>;
+  VectorMapI_t mapData { { 0, { 0, 1 } }, { 1, {} }, { 2, { 2, 3, 4 } } };
+  auto const flatMap
+    = lar::flatten_nested<lar::PairSecond<VectorMapI_t::value_type>>(mapData);
+  BOOST_CHECK_EQUAL(flatMap.size(), 5U);
+  for (size_t i = 0; i < flatMap.size(); ++i)
+    BOOST_CHECK_EQUAL(flatMap[i], (int) i);
+  BOOST_CHECK_EQUAL(flatMap.locate(2).outer, 2U);
+  BOOST_CHECK_EQUAL(flatMap.locate(2).inner, 0U);
+
+} // RunFlattenedTest()
+
+
 //------------------------------------------------------------------------------
 //--- registration of tests
 //
@@ -161,3 +238,7 @@ BOOST_AUTO_TEST_CASE(RunVectorVector) {
 BOOST_AUTO_TEST_CASE(RunVectorMap) {
   RunVectorMapTest();
 }
+
+BOOST_AUTO_TEST_CASE(RunFlattened) {
+  RunFlattenedTest();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file    PxHitIndex_test.cc
+ * @brief   Tests the spatial index of hits
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/PxHitIndex.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <limits>
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( PxHitIndex_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/PxHitIndex.h"
+
+
+//------------------------------------------------------------------------------
+/// Returns the closest hit by linear scan (lowest index on ties)
+unsigned int BruteForceClosest(
+  std::vector<util::PxHit> const& hits, double w, double t,
+  double wScale, double tScale
+) {
+  unsigned int best = util::PxHitIndex::npos;
+  double bestDist2 = std::numeric_limits<double>::infinity();
+  for (unsigned int i = 0; i < hits.size(); ++i) {
+    double const dw = (hits[i].w - w) * wScale;
+    double const dt = (hits[i].t - t) * tScale;
+    double const d2 = dw * dw + dt * dt;
+    if (d2 < bestDist2) {
+      bestDist2 = d2;
+      best = i;
+    }
+  } // for
+  return best;
+} // BruteForceClosest()
+
+
+//------------------------------------------------------------------------------
+void RunRandomHitsTest(double cellW, double cellT) {
+
+  std::default_random_engine engine;
+  std::uniform_real_distribution<double> wireDist(0., 300.);
+  std::uniform_real_distribution<double> timeDist(-50., 150.);
+  std::uniform_real_distribution<double> queryDist(-100., 400.);
+
+  std::vector<util::PxHit> hits;
+  for (unsigned int i = 0; i < 1000; ++i)
+    hits.emplace_back(2, wireDist(engine), timeDist(engine), 1., 1., 1.);
+
+  util::PxHitIndex const index(hits, cellW, cellT);
+  BOOST_CHECK_EQUAL(index.size(), hits.size());
+  BOOST_CHECK(!index.empty());
+
+  for (unsigned int q = 0; q < 500; ++q) {
+    double const w = queryDist(engine), t = queryDist(engine);
+
+    // closest hit, also with anisotropic metric
+    BOOST_CHECK_EQUAL
+      (index.closest(w, t), BruteForceClosest(hits, w, t, 1., 1.));
+    BOOST_CHECK_EQUAL
+      (index.closest(w, t, 0.3, 0.08), BruteForceClosest(hits, w, t, 0.3, 0.08));
+
+    // hits in a box
+    double const wMin = w - 20., wMax = w + 15., tMin = t - 10., tMax = t + 5.;
+    std::vector<unsigned int> expected;
+    for (unsigned int i = 0; i < hits.size(); ++i) {
+      if ((hits[i].w < wMin) || (hits[i].w > wMax)) continue;
+      if ((hits[i].t < tMin) || (hits[i].t > tMax)) continue;
+      expected.push_back(i);
+    }
+    std::vector<unsigned int> const selected
+      = index.inBox(wMin, wMax, tMin, tMax);
+    BOOST_CHECK_EQUAL_COLLECTIONS
+      (selected.begin(), selected.end(), expected.begin(), expected.end());
+  } // for queries
+
+} // RunRandomHitsTest()
+
+
+//------------------------------------------------------------------------------
+void RunDegenerateHitsTest() {
+
+  // no hits
+  std::vector<util::PxHit> hits;
+  util::PxHitIndex const emptyIndex(hits);
+  BOOST_CHECK(emptyIndex.empty());
+  BOOST_CHECK_EQUAL(emptyIndex.closest(1., 2.), util::PxHitIndex::npos);
+  BOOST_CHECK(emptyIndex.inBox(0., 10., 0., 10.).empty());
+
+  // all hits on the same wire, one duplicate, one invalid
+  for (unsigned int i = 0; i < 20; ++i)
+    hits.emplace_back(0, 5., double(i), 1., 1., 1.);
+  hits.emplace_back(0, 5., 7., 1., 1., 1.); // same as hit #7
+  hits.emplace_back
+    (0, std::numeric_limits<double>::quiet_NaN(), 3., 1., 1., 1.);
+
+  util::PxHitIndex const index(hits);
+  BOOST_CHECK_EQUAL(index.size(), 21U);
+  BOOST_CHECK_EQUAL(index.closest(5., 7.2), 7U); // lowest index on ties
+  BOOST_CHECK_EQUAL(index.closest(-50., 100.), 19U);
+  BOOST_CHECK_EQUAL(index.closest(8., -3.), 0U);
+
+  std::vector<unsigned int> const selected = index.inBox(4., 6., 6.5, 8.);
+  std::vector<unsigned int> const expected { 7U, 8U, 20U };
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (selected.begin(), selected.end(), expected.begin(), expected.end());
+
+} // RunDegenerateHitsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(AutomaticCellsTestCase) {
+  RunRandomHitsTest(0., 0.);
+} // AutomaticCellsTestCase
+
+BOOST_AUTO_TEST_CASE(FixedCellsTestCase) {
+  RunRandomHitsTest(7., 3.);
+  RunRandomHitsTest(1000., 1000.); // one cell
+} // FixedCellsTestCase
+
+BOOST_AUTO_TEST_CASE(DegenerateHitsTestCase) {
+  RunDegenerateHitsTest();
+} // DegenerateHitsTestCase
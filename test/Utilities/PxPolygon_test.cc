@@ -0,0 +1,138 @@
+/**
+ * @file    PxPolygon_test.cc
+ * @brief   Tests the polygon on the wire/time plane
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/PxPolygon.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard libraries
+#include <cmath> // std::cos(), std::sin()
+#include <random>
+#include <vector>
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( PxPolygon_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/PxPolygon.h"
+
+
+//------------------------------------------------------------------------------
+/// Returns whether the point is inside, by crossing count (slow reference)
+bool ReferenceContains
+  (std::vector<util::PxPoint> const& vertices, double w, double t)
+{
+  bool inside = false;
+  std::size_t const n = vertices.size();
+  for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+    util::PxPoint const& a = vertices[i];
+    util::PxPoint const& b = vertices[j];
+    if (((a.t > t) != (b.t > t))
+      && (w < (b.w - a.w) * (t - a.t) / (b.t - a.t) + a.w))
+      inside = !inside;
+  } // for
+  return inside;
+} // ReferenceContains()
+
+
+//------------------------------------------------------------------------------
+void RunSimplePolygonTest() {
+
+  // a "U", concave, counterclockwise
+  std::vector<util::PxPoint> const vertices {
+    { 0, 0., 0. }, { 0, 3., 0. }, { 0, 3., 3. }, { 0, 2., 3. },
+    { 0, 2., 1. }, { 0, 1., 1. }, { 0, 1., 3. }, { 0, 0., 3. }
+  };
+  util::PxPolygon const polygon(vertices);
+  BOOST_CHECK_EQUAL(polygon.size(), vertices.size());
+
+  BOOST_CHECK( polygon.contains(0.5, 0.5));
+  BOOST_CHECK( polygon.contains(0.5, 2.5));
+  BOOST_CHECK( polygon.contains(2.5, 2.5));
+  BOOST_CHECK(!polygon.contains(1.5, 2.0)); // in the notch
+  BOOST_CHECK(!polygon.contains(4.0, 1.0));
+  BOOST_CHECK(!polygon.contains(-1., 1.0));
+
+  // same polygon, clockwise
+  std::vector<util::PxPoint> const reversed(vertices.rbegin(), vertices.rend());
+  util::PxPolygon const polygonCW(reversed);
+  BOOST_CHECK( polygonCW.contains(0.5, 0.5));
+  BOOST_CHECK(!polygonCW.contains(1.5, 2.0));
+
+  // hits
+  std::vector<util::PxHit> hits;
+  hits.emplace_back(0, 0.5, 0.5, 1., 1., 1.);
+  hits.emplace_back(0, 1.5, 2.0, 1., 1., 1.);
+  hits.emplace_back(0, 2.5, 0.2, 1., 1., 1.);
+  BOOST_CHECK_EQUAL(polygon.countInside(hits), 2U);
+
+  // degenerate polygons contain nothing
+  BOOST_CHECK(!util::PxPolygon().contains(0., 0.));
+  util::PxPolygon segment;
+  segment.addVertex(0., 0.);
+  segment.addVertex(1., 1.);
+  BOOST_CHECK(!segment.contains(0.5, 0.5));
+
+} // RunSimplePolygonTest()
+
+
+//------------------------------------------------------------------------------
+void RunManyPolygonsTest() {
+
+  std::default_random_engine engine;
+  std::uniform_real_distribution<double> uniform(0., 100.);
+  std::uniform_real_distribution<double> radius(2., 20.);
+
+  // random star-shaped polygons
+  std::vector<std::vector<util::PxPoint>> vertices;
+  std::vector<util::PxPolygon> polygons;
+  for (unsigned int p = 0; p < 20; ++p) {
+    double const cw = uniform(engine), ct = uniform(engine);
+    unsigned int const nVertices = 3 + p % 6;
+    std::vector<util::PxPoint> polygon;
+    for (unsigned int v = 0; v < nVertices; ++v) {
+      double const phi = 2. * M_PI * (v + 0.5 * uniform(engine) / 100.)
+        / nVertices;
+      double const r = radius(engine);
+      polygon.emplace_back(0, cw + r * std::cos(phi), ct + r * std::sin(phi));
+    }
+    polygons.emplace_back(polygon);
+    vertices.push_back(std::move(polygon));
+  } // for polygons
+
+  std::size_t const n = 1000;
+  std::vector<double> w(n), t(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    w[i] = uniform(engine);
+    t[i] = uniform(engine);
+  }
+
+  std::vector<unsigned char> inside;
+  util::PxPolygon::containsMany(polygons, n, w.data(), t.data(), inside);
+  BOOST_CHECK_EQUAL(inside.size(), polygons.size() * n);
+
+  std::vector<unsigned char> single(n);
+  for (std::size_t p = 0; p < polygons.size(); ++p) {
+    polygons[p].contains(n, w.data(), t.data(), single.data());
+    for (std::size_t i = 0; i < n; ++i) {
+      bool const expected = ReferenceContains(vertices[p], w[i], t[i]);
+      BOOST_CHECK_EQUAL(bool(inside[p * n + i]), expected);
+      BOOST_CHECK_EQUAL(bool(single[i]), expected);
+    } // for points
+  } // for polygons
+
+} // RunManyPolygonsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SimplePolygonTestCase) {
+  RunSimplePolygonTest();
+} // SimplePolygonTestCase
+
+BOOST_AUTO_TEST_CASE(ManyPolygonsTestCase) {
+  RunManyPolygonsTest();
+} // ManyPolygonsTestCase
@@ -0,0 +1,98 @@
+/**
+ * @file    ROIDeconvolver_test.cc
+ * @brief   Tests the ROI-only deconvolution of `ROIDeconvolver.h`
+ * @see     `lardata/Utilities/ROIDeconvolver.h`
+ *
+ * The deconvolution of padded ROIs with smaller transforms is compared with
+ * the deconvolution of the whole waveform, with a kernel whose response is
+ * shorter than the padding.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ROIDeconvolver_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/ROIDeconvolver.h"
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <complex>
+#include <vector>
+
+
+namespace {
+
+  constexpr int FullSize = 1024;
+
+  // ... kernel of a response spanning ticks [ -3, 5 ]
+  util::ROIDeconvolver::ComplexVector makeKernel() {
+    std::vector<double> response(FullSize, 0.);
+    double const taps[] = { 0.05, -0.1, 0.2, 1.0, -0.4, 0.3, -0.2, 0.1, -0.05 };
+    for (int i = -3; i <= 5; ++i)
+      response[(i + FullSize) % FullSize] = taps[i + 3];
+
+    util::LArFFTWPlan plan(FullSize, "ES");
+    util::LArFFTW fft(plan, 1);
+    util::ROIDeconvolver::ComplexVector kernel(FullSize/2+1);
+    fft.DoFFT(response, kernel);
+    return kernel;
+  }
+
+  std::vector<float> makeWaveform() {
+    std::vector<float> waveform(FullSize);
+    for (int i = 0; i < FullSize; ++i)
+      waveform[i] = float(std::sin(0.05*i) + 0.3*std::cos(0.31*i));
+    return waveform;
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SizesTest) {
+
+  util::ROIDeconvolver const defaults(makeKernel(), FullSize);
+  BOOST_CHECK((defaults.Sizes() == std::vector<int>{ 64, 128, 256, 512, 1024 }));
+  BOOST_CHECK_EQUAL(defaults.TransformSize(1U), 64);
+  BOOST_CHECK_EQUAL(defaults.TransformSize(65U), 128);
+  BOOST_CHECK_EQUAL(defaults.TransformSize(5000U), FullSize);
+
+  util::ROIDeconvolver const custom
+    (makeKernel(), FullSize, 16, { 300, 100, 2048, 100 });
+  BOOST_CHECK((custom.Sizes() == std::vector<int>{ 100, 300, 1024 }));
+
+} // BOOST_AUTO_TEST_CASE(SizesTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DeconvolutionTest) {
+
+  auto const kernel = makeKernel();
+  std::vector<float> const waveform = makeWaveform();
+
+  // ... reference: full waveform deconvolution
+  std::vector<double> full(waveform.begin(), waveform.end());
+  util::LArFFTWPlan plan(FullSize, "ES");
+  util::LArFFTW fft(plan, 1);
+  fft.Convolute(full, kernel);
+
+  util::ROIDeconvolver deconvolver(kernel, FullSize, 16);
+  util::ROIDeconvolver::ROIs_t const rois
+    { { 100, 120 }, { 115, 140 }, { 500, 700 }, { 1000, 1015 } };
+  auto const result = deconvolver.Deconvolute(waveform, rois);
+
+  BOOST_CHECK_EQUAL(result.size(), waveform.size());
+  BOOST_CHECK_EQUAL(result.n_ranges(), 3U); // the first two are merged
+  BOOST_CHECK_LT(deconvolver.TransformedTicks(), std::size_t(FullSize));
+
+  for (auto const& range: result.get_ranges()) {
+    for (std::size_t i = range.begin_index(); i < range.end_index(); ++i)
+      BOOST_CHECK_SMALL(double(result[i]) - full[i], 1e-4);
+  } // for
+  BOOST_CHECK_EQUAL(result[300], 0.0f);
+
+} // BOOST_AUTO_TEST_CASE(DeconvolutionTest)
@@ -0,0 +1,159 @@
+/**
+ * @file    RangeArrays_test.cc
+ * @brief   Tests the batch range operations in `RangeArrays.h`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/RangeArrays.h`
+ *
+ * The merged ranges are compared with the ones of `util::UniqueRangeVector`,
+ * the intersections and lengths with a tick-by-tick bookkeeping.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( RangeArrays_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/RangeArrays.h"
+#include "lardata/Utilities/UniqueRangeVector.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+util::RangeArray<int> randomRanges
+  (std::default_random_engine& engine, unsigned int n, int maxStart)
+{
+  std::uniform_int_distribution<int> start(0, maxStart), length(0, 20);
+  util::RangeArray<int> ranges;
+  for (unsigned int i = 0; i < n; ++i) {
+    int const s = start(engine);
+    ranges.push_back(s, s + length(engine));
+  }
+  return ranges;
+} // randomRanges()
+
+
+/// Marks the ticks covered by the ranges.
+std::vector<bool> coverage(util::RangeArray<int> const& ranges, int size) {
+  std::vector<bool> covered(size, false);
+  for (std::size_t i = 0; i < ranges.size(); ++i)
+    for (int t = ranges.Start(i); t < ranges.End(i); ++t) covered[t] = true;
+  return covered;
+} // coverage()
+
+
+//------------------------------------------------------------------------------
+void testSortAndCoalesce() {
+
+  util::RangeArray<int> ranges;
+  BOOST_CHECK(ranges.empty());
+  BOOST_CHECK_THROW(ranges.push_back(5, 4), std::runtime_error);
+  BOOST_CHECK_EQUAL(util::Coalesce(ranges), 0U);
+
+  ranges.push_back(30, 40);
+  ranges.push_back(10, 20);
+  ranges.push_back(20, 25); // touches the previous one
+  ranges.push_back(0, 5);
+  ranges.push_back(12, 15); // contained in [ 10, 20 ]
+  BOOST_CHECK(!util::IsSortedByStart(ranges));
+
+  util::SortByStart(ranges);
+  BOOST_CHECK(util::IsSortedByStart(ranges));
+  BOOST_CHECK_EQUAL(ranges.Start(0), 0);
+  BOOST_CHECK_EQUAL(ranges.Start(4), 30);
+
+  BOOST_CHECK_EQUAL(util::Coalesce(ranges), 2U);
+  BOOST_REQUIRE_EQUAL(ranges.size(), 3U);
+  BOOST_CHECK_EQUAL(ranges.Start(0), 0);
+  BOOST_CHECK_EQUAL(ranges.End(0), 5);
+  BOOST_CHECK_EQUAL(ranges.Start(1), 10);
+  BOOST_CHECK_EQUAL(ranges.End(1), 25);
+  BOOST_CHECK_EQUAL(ranges.Start(2), 30);
+  BOOST_CHECK_EQUAL(ranges.End(2), 40);
+  BOOST_CHECK_EQUAL(util::CoveredLength(ranges), 30);
+
+} // testSortAndCoalesce()
+
+
+//------------------------------------------------------------------------------
+void testRandomCoalesce() {
+
+  std::default_random_engine engine;
+  util::RangeArray<int> ranges = randomRanges(engine, 500, 5000);
+
+  std::vector<util::Range<int>> input;
+  for (std::size_t i = 0; i < ranges.size(); ++i)
+    input.emplace_back(ranges.Start(i), ranges.End(i));
+  util::UniqueRangeVector<int> expected;
+  expected.Insert(input.begin(), input.end());
+
+  auto const covered = coverage(ranges, 5100);
+
+  util::SortByStart(ranges);
+  util::Coalesce(ranges);
+  BOOST_REQUIRE_EQUAL(ranges.size(), expected.size());
+  std::size_t i = 0;
+  for (auto const& r: expected) {
+    BOOST_CHECK_EQUAL(ranges.Start(i), r.Start());
+    BOOST_CHECK_EQUAL(ranges.End(i), r.End());
+    ++i;
+  }
+
+  int nCovered = 0;
+  for (bool const c: covered) nCovered += c;
+  BOOST_CHECK_EQUAL(util::CoveredLength(ranges), nCovered);
+
+} // testRandomCoalesce()
+
+
+//------------------------------------------------------------------------------
+void testIntersect() {
+
+  std::default_random_engine engine;
+  constexpr int Size = 3100;
+  util::RangeArray<int> a = randomRanges(engine, 200, 3000);
+  util::RangeArray<int> b = randomRanges(engine, 150, 3000);
+  auto const coveredA = coverage(a, Size), coveredB = coverage(b, Size);
+
+  util::SortByStart(a);
+  util::Coalesce(a);
+  util::SortByStart(b);
+  util::Coalesce(b);
+
+  util::RangeArray<int> const both = util::Intersect(a, b);
+  BOOST_CHECK(util::IsSortedByStart(both));
+  for (std::size_t i = 0; i < both.size(); ++i) {
+    BOOST_CHECK_LT(both.Start(i), both.End(i));
+    if (i > 0) BOOST_CHECK_LE(both.End(i - 1), both.Start(i));
+  }
+
+  auto const coveredBoth = coverage(both, Size);
+  for (int t = 0; t < Size; ++t)
+    BOOST_CHECK_EQUAL(coveredBoth[t], coveredA[t] && coveredB[t]);
+
+  // touching ranges have no intersection
+  util::RangeArray<int> c, d;
+  c.push_back(0, 10);
+  d.push_back(10, 20);
+  BOOST_CHECK(util::Intersect(c, d).empty());
+  BOOST_CHECK(util::Intersect(c, util::RangeArray<int>{}).empty());
+
+} // testIntersect()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SortAndCoalesceTestCase) {
+  testSortAndCoalesce();
+  testRandomCoalesce();
+}
+
+BOOST_AUTO_TEST_CASE(IntersectTestCase) {
+  testIntersect();
+}
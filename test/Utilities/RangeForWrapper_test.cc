@@ -18,6 +18,7 @@
 #include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
 
 // C/C++ standard libraries
+#include <algorithm> // std::sort()
 #include <iterator>
 #include <numeric> // std::accumulate()
 #include <limits> // std::numeric_limits<>
@@ -644,6 +645,7 @@ void RangeForWrapperIteratorStandardsTest() {
   for (std::size_t i = 0; i < data.size(); ++i) {
     decltype(auto) value = range[i];
     BOOST_CHECK_EQUAL(value, data[i]);
+    BOOST_CHECK_EQUAL(rbegin[i], data[i]);
   }
 
 } // RangeForWrapperIteratorStandardsTest()
@@ -717,3 +719,95 @@ BOOST_AUTO_TEST_CASE(RangeForWrapperIteratorStandardsTestCase) {
 
 } // BOOST_AUTO_TEST_CASE(RangeForWrapperIteratorStandardsTestCase)
 
+
+//-----------------------------------------------------------------------------
+//--- a range with a random access begin iterator and a different end type
+//---
+struct Sentinel { int const* ptr; };
+
+std::ptrdiff_t operator- (Sentinel const& end, int const* begin)
+  { return end.ptr - begin; }
+
+struct SentinelData {
+  std::vector<int> values;
+
+  int* begin() { return values.data(); }
+  int const* begin() const { return values.data(); }
+  Sentinel end() const { return { values.data() + values.size() }; }
+  int const* data() const { return values.data(); }
+
+}; // SentinelData
+
+
+BOOST_AUTO_TEST_CASE(RangeForWrapperRandomAccessTestCase) {
+
+  SentinelData data { { 4, 2, 3 } };
+
+  auto range = data | util::range_for;
+
+  // the begin iterator is used as is, with its (contiguous) access
+  static_assert(std::is_same<decltype(range.begin()), int*>(),
+    "util::range_for should expose the random access begin iterator");
+  static_assert(std::is_same<decltype(range.end()), int*>(),
+    "util::range_for should turn the end into a begin iterator");
+
+  BOOST_CHECK_EQUAL(range.begin(), data.values.data());
+  BOOST_CHECK_EQUAL(range.end(), data.values.data() + data.values.size());
+  BOOST_CHECK_EQUAL(range.size(), data.values.size());
+  BOOST_CHECK(!range.empty());
+  BOOST_CHECK_EQUAL(range.data(), data.values.data());
+  BOOST_CHECK_EQUAL(range[1], 2);
+
+  // algorithms requiring random access iterators work in place
+  std::sort(range.begin(), range.end());
+  BOOST_CHECK_EQUAL(data.values[0], 2);
+  BOOST_CHECK_EQUAL(data.values[1], 3);
+  BOOST_CHECK_EQUAL(data.values[2], 4);
+
+  int total = 0;
+  for (int d: std::move(data) | util::range_for) total += d;
+  BOOST_CHECK_EQUAL(total, 9);
+
+} // BOOST_AUTO_TEST_CASE(RangeForWrapperRandomAccessTestCase)
+
+
+//-----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RangeForSentinelTestCase) {
+
+  // same iterator types: pass-through
+  std::vector<int> vdata = { 2, 3, 4 };
+  BOOST_CHECK_EQUAL(&vdata, &(vdata | util::range_for_sentinel));
+
+  // random access begin iterator: same as `util::range_for`
+  SentinelData sdata { { 4, 2, 3 } };
+  static_assert(std::is_same<
+      decltype(sdata | util::range_for_sentinel),
+      decltype(sdata | util::range_for)
+    >(),
+    "util::range_for_sentinel should use the begin iterator as end"
+    );
+
+  // different iterator types
+  Data<int> data = { 2, 3, 4 };
+  auto range = data | util::range_for_sentinel;
+#if defined(__cpp_range_based_for) && (__cpp_range_based_for >= 201603L)
+  static_assert(std::is_same<decltype(range.begin()), Data<int>::begin_iterator>(),
+    "util::range_for_sentinel should expose the begin iterator");
+  static_assert(std::is_same<decltype(range.end()), Data<int>::end_iterator>(),
+    "util::range_for_sentinel should expose the end iterator");
+#endif // __cpp_range_based_for
+
+  BOOST_CHECK_EQUAL(range.size(), data.size());
+  BOOST_CHECK_EQUAL(range.empty(), data.empty());
+  BOOST_CHECK_EQUAL(range[1], 3);
+
+  int total = 0;
+  for (int& d: range) total += d++;
+  BOOST_CHECK_EQUAL(total, 9);
+  BOOST_CHECK_EQUAL(data[0], 3);
+
+  total = 0;
+  for (int d: Data<int>{ 1, 2, 3, 4 } | util::range_for_sentinel) total += d;
+  BOOST_CHECK_EQUAL(total, 10);
+
+} // BOOST_AUTO_TEST_CASE(RangeForSentinelTestCase)
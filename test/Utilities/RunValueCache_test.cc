@@ -0,0 +1,108 @@
+/**
+ * @file    RunValueCache_test.cc
+ * @brief   Tests the class in `RunValueCache.h`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/RunValueCache.h`
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( RunValueCache_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/RunValueCache.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <cstdio> // std::remove()
+#include <fstream>
+#include <string>
+
+
+//------------------------------------------------------------------------------
+void testCacheContent() {
+
+  util::RunValueCache cache;
+  BOOST_CHECK(cache.empty());
+  BOOST_CHECK(!cache.modified());
+  BOOST_CHECK(cache.find(10, "tau") == nullptr);
+
+  cache.set(10, "tau", { "1.5" });
+  cache.set(10, "efield", { "0.5", "0.7" });
+  cache.set(12, "tau", { "2.5" });
+
+  BOOST_CHECK_EQUAL(cache.size(), 3U);
+  BOOST_CHECK(cache.modified());
+  BOOST_CHECK(cache.has(10, "tau"));
+  BOOST_CHECK(!cache.has(10, "temp"));
+  BOOST_CHECK(cache.hasRun(10));
+  BOOST_CHECK(!cache.hasRun(11));
+  BOOST_CHECK(cache.hasRun(12));
+
+  auto const* efield = cache.find(10, "efield");
+  BOOST_REQUIRE(efield);
+  BOOST_CHECK_EQUAL(efield->size(), 2U);
+  BOOST_CHECK_EQUAL((*efield)[1], "0.7");
+
+  // replacement
+  cache.set(12, "tau", { "3.5" });
+  BOOST_CHECK_EQUAL(cache.size(), 3U);
+  BOOST_CHECK_EQUAL(cache.find(12, "tau")->front(), "3.5");
+
+} // testCacheContent()
+
+
+//------------------------------------------------------------------------------
+void testCacheFile() {
+
+  std::string const path = "RunValueCache_test.txt";
+
+  util::RunValueCache cache;
+  cache.set(10, "tau", { "1.5" });
+  cache.set(10, "efield", { "0.5", "0.7" });
+  cache.set(12, "T0", { "-3" });
+  cache.save(path);
+  BOOST_CHECK(!cache.modified());
+
+  util::RunValueCache readBack;
+  BOOST_CHECK_EQUAL(readBack.load(path), 3U);
+  BOOST_CHECK(!readBack.modified());
+  BOOST_CHECK_EQUAL(readBack.size(), 3U);
+  BOOST_CHECK_EQUAL(readBack.find(10, "tau")->front(), "1.5");
+  BOOST_CHECK_EQUAL(readBack.find(10, "efield")->back(), "0.7");
+  BOOST_CHECK_EQUAL(readBack.find(12, "T0")->front(), "-3");
+
+  // comments and empty lines are skipped; too few values are an error
+  {
+    std::ofstream out(path);
+    out << "# comment\n\n14 temp 1 87.3\n15 efield 3 0.5 0.7\n";
+  }
+  util::RunValueCache broken;
+  BOOST_CHECK_THROW(broken.load(path), cet::exception);
+
+  {
+    std::ofstream out(path);
+    out << "run16 tau 1 2.0\n";
+  }
+  BOOST_CHECK_THROW(broken.load(path), cet::exception);
+
+  std::remove(path.c_str());
+  BOOST_CHECK_THROW(broken.load(path), cet::exception);
+
+} // testCacheFile()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(CacheContentTestCase) {
+  testCacheContent();
+}
+
+BOOST_AUTO_TEST_CASE(CacheFileTestCase) {
+  testCacheFile();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file    SharedArenaAllocator_test.cc
+ * @brief   Tests the allocator in `SharedArenaAllocator.h`
+ * @see     `lardata/Utilities/SharedArenaAllocator.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SharedArenaAllocator_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/SharedArenaAllocator.h"
+
+// C/C++ standard libraries
+#include <memory>
+#include <vector>
+
+
+namespace {
+
+  /// Counts the live instances.
+  struct Counted {
+    static int alive;
+    int value;
+    Counted(int v): value(v) { ++alive; }
+    virtual ~Counted() { --alive; }
+  };
+  int Counted::alive = 0;
+
+  struct CountedDerived: public Counted {
+    double extra;
+    CountedDerived(int v, double x): Counted(v), extra(x) {}
+  };
+
+  /// Arena recording whether it has been destroyed.
+  struct WatchedArena: public std::pmr::monotonic_buffer_resource {
+    bool* destroyed;
+    std::size_t allocated = 0;
+    WatchedArena(bool* flag): destroyed(flag) {}
+    ~WatchedArena() { *destroyed = true; }
+      protected:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+      {
+        allocated += bytes;
+        return std::pmr::monotonic_buffer_resource::do_allocate(bytes, align);
+      }
+  };
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ArenaLifetimeTestCase) {
+
+  bool destroyed = false;
+  auto watched = std::make_shared<WatchedArena>(&destroyed);
+  std::shared_ptr<lar::SharedArena_t> arena = watched;
+
+  std::vector<std::shared_ptr<const Counted>> objects;
+  for (int i = 0; i < 1000; ++i)
+    objects.push_back(lar::makeArenaShared<CountedDerived>(arena, i, 0.5*i));
+  BOOST_CHECK_EQUAL(Counted::alive, 1000);
+  BOOST_CHECK_GE(watched->allocated, 1000 * sizeof(CountedDerived));
+  for (int i = 0; i < 1000; ++i) BOOST_CHECK_EQUAL(objects[i]->value, i);
+
+  // the objects keep the arena alive
+  watched.reset();
+  arena.reset();
+  BOOST_CHECK(!destroyed);
+
+  objects.resize(10);
+  BOOST_CHECK_EQUAL(Counted::alive, 10);
+  BOOST_CHECK(!destroyed);
+
+  objects.clear();
+  BOOST_CHECK_EQUAL(Counted::alive, 0);
+  BOOST_CHECK(destroyed);
+
+} // BOOST_AUTO_TEST_CASE(ArenaLifetimeTestCase)
+
+
+BOOST_AUTO_TEST_CASE(NoArenaTestCase) {
+
+  auto p = lar::makeArenaShared<Counted>(nullptr, 3);
+  BOOST_CHECK_EQUAL(p->value, 3);
+  BOOST_CHECK_EQUAL(Counted::alive, 1);
+  p.reset();
+  BOOST_CHECK_EQUAL(Counted::alive, 0);
+
+} // BOOST_AUTO_TEST_CASE(NoArenaTestCase)
+
+
+BOOST_AUTO_TEST_CASE(AllocatorEqualityTestCase) {
+
+  auto arena1 = lar::makeSharedArena();
+  auto arena2 = lar::makeSharedArena(4096);
+  lar::SharedArenaAllocator<int> a1(arena1);
+  lar::SharedArenaAllocator<double> b1(a1);
+  lar::SharedArenaAllocator<int> a2(arena2);
+  BOOST_CHECK(a1 == b1);
+  BOOST_CHECK(a1 != a2);
+
+  // usable as a container allocator
+  std::vector<int, lar::SharedArenaAllocator<int>> v(a2);
+  for (int i = 0; i < 100; ++i) v.push_back(i);
+  BOOST_CHECK_EQUAL(v.size(), 100U);
+  BOOST_CHECK_EQUAL(v.back(), 99);
+
+} // BOOST_AUTO_TEST_CASE(AllocatorEqualityTestCase)
@@ -0,0 +1,321 @@
+/**
+ * @file   SignalShapingTest_module.cc
+ * @brief  Tests the shared shapers of `util::SignalShaping`.
+ * @date   October 14, 2026
+ * @see    `lardata/Utilities/SignalShaping.h`
+ *
+ * A shaper shared without filter must refuse to deconvolute, and a shared
+ * shaper used by several threads at once must give the same results as
+ * when used by one thread. The test is run with both `LArFFT` backends.
+ */
+
+
+// LArSoft libraries
+#include "lardata/Utilities/SignalShaping.h"
+#include "lardata/Utilities/LArFFT.h"
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// framework libraries
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Comment.h"
+#include "cetlib_except/exception.h"
+
+// ROOT libraries
+#include "TComplex.h"
+
+// Boost libraries
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// C/C++ libraries
+#include <cmath>
+#include <string>
+#include <thread>
+#include <utility> // std::move()
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Runs a test of the shared shapers of `util::SignalShaping`.
+ *
+ * Each event, the shapers are configured with the current `LArFFT` size,
+ * and:
+ * * a shaper shared without filter is checked to throw on `Deconvolute()`
+ *   (both with the `LArFFT` transforms and with a `LArFFTW` engine), while
+ *   still convoluting;
+ * * a shaper shared with a filter is used by `nThreads` threads at the same
+ *   time, each convoluting and deconvoluting its own waveforms with the
+ *   `LArFFT` transforms and with an engine of its own, and the results are
+ *   compared with the ones of the same operations done in this thread.
+ *
+ * The checks all happen in the main thread, after the workers are done.
+ *
+ * This module uses Boost unit test library, and as such it must be run with
+ * `lar_ut` instead of `lar`.
+ */
+class SignalShapingTest: public art::SharedAnalyzer {
+    public:
+
+  struct Config {
+    using Name = fhicl::Name;
+    using Comment = fhicl::Comment;
+
+    fhicl::Atom<unsigned int> nThreads{
+      Name("nThreads"),
+      Comment("number of threads using the shared shaper at the same time"),
+      4U
+      };
+
+    fhicl::Atom<unsigned int> nIterations{
+      Name("nIterations"),
+      Comment("number of waveforms shaped by each thread"),
+      50U
+      };
+
+  }; // struct Config
+
+  using Parameters = art::SharedAnalyzer::Table<Config>;
+
+  SignalShapingTest(Parameters const& config, art::ProcessingFrame const&)
+    : art::SharedAnalyzer(config)
+    , nThreads(config().nThreads())
+    , nIterations(config().nIterations())
+    {
+      // Boost checks are not thread-safe: one event at a time
+      serialize<art::InEvent>();
+    }
+
+  // Plugins should not be copied or assigned.
+  SignalShapingTest(SignalShapingTest const &) = delete;
+  SignalShapingTest(SignalShapingTest&&) = delete;
+  SignalShapingTest& operator= (SignalShapingTest const &) = delete;
+  SignalShapingTest& operator= (SignalShapingTest&&) = delete;
+
+  virtual void analyze
+    (art::Event const& event, art::ProcessingFrame const&) override;
+
+    private:
+  unsigned int nThreads; ///< Number of concurrent users of the shaper.
+  unsigned int nIterations; ///< Number of waveforms per thread.
+
+  /// Convoluted and deconvoluted waveforms, by both methods.
+  struct Shaped_t {
+    std::vector<double> convoluted;
+    std::vector<double> deconvoluted;
+    std::vector<double> convolutedFFTW;
+    std::vector<double> deconvolutedFFTW;
+  }; // struct Shaped_t
+
+  /// Response function with `n` ticks.
+  static std::vector<double> makeResponse(int n);
+
+  /// Low-pass filter for transforms of `n` ticks.
+  static std::vector<TComplex> makeFilter(int n);
+
+  /// Waveform number `i` with `n` ticks.
+  static std::vector<double> makeWaveform(int n, unsigned int i);
+
+  /// Shapes waveform `i` with `shaper`, using `fft` for the `LArFFTW` methods.
+  static Shaped_t shape(util::SignalShaping const& shaper,
+                        util::LArFFTW& fft, int n, unsigned int i);
+
+  /// Returns whether `e` is the refusal of a shared shaper to deconvolute.
+  static bool isSharedShaperError(cet::exception const& e);
+
+  /// Checks that `actual` matches `expected`.
+  static void checkSame(std::vector<double> const& actual,
+                        std::vector<double> const& expected);
+
+  /// Checks a shaper shared without filter.
+  void testUnfiltered(int n) const;
+
+  /// Checks the concurrent use of a shared shaper.
+  void testConcurrent(int n) const;
+
+}; // class SignalShapingTest
+
+
+//------------------------------------------------------------------------------
+std::vector<double> SignalShapingTest::makeResponse(int n) {
+  std::vector<double> response(n, 0.0);
+  for (int i = 0; i < n / 4; ++i)
+    response[i] = i * std::exp(-0.5 * i);
+  return response;
+} // SignalShapingTest::makeResponse()
+
+
+//------------------------------------------------------------------------------
+std::vector<TComplex> SignalShapingTest::makeFilter(int n) {
+  std::vector<TComplex> filter(n / 2 + 1);
+  for (std::size_t i = 0; i < filter.size(); ++i)
+    filter[i] = TComplex(std::exp(-0.5 * std::pow(4.0 * i / n, 2)), 0.0);
+  return filter;
+} // SignalShapingTest::makeFilter()
+
+
+//------------------------------------------------------------------------------
+std::vector<double> SignalShapingTest::makeWaveform(int n, unsigned int i) {
+  std::vector<double> waveform(n);
+  for (int t = 0; t < n; ++t)
+    waveform[t] = std::sin(0.1 * (i % 7 + 1) * t) + ((t == int(i) % n)? 5.0: 0.0);
+  return waveform;
+} // SignalShapingTest::makeWaveform()
+
+
+//------------------------------------------------------------------------------
+auto SignalShapingTest::shape(util::SignalShaping const& shaper,
+                              util::LArFFTW& fft, int n, unsigned int i)
+  -> Shaped_t
+{
+  Shaped_t shaped;
+  shaped.convoluted = shaped.deconvoluted = shaped.convolutedFFTW
+    = shaped.deconvolutedFFTW = makeWaveform(n, i);
+  shaper.Convolute(shaped.convoluted);
+  shaper.Deconvolute(shaped.deconvoluted);
+  shaper.Convolute(fft, shaped.convolutedFFTW);
+  shaper.Deconvolute(fft, shaped.deconvolutedFFTW);
+  return shaped;
+} // SignalShapingTest::shape()
+
+
+//------------------------------------------------------------------------------
+bool SignalShapingTest::isSharedShaperError(cet::exception const& e) {
+  return std::string(e.what()).find("Shared shaper") != std::string::npos;
+} // SignalShapingTest::isSharedShaperError()
+
+
+//------------------------------------------------------------------------------
+void SignalShapingTest::checkSame(
+  std::vector<double> const& actual, std::vector<double> const& expected
+) {
+  BOOST_CHECK_EQUAL(actual.size(), expected.size());
+  if (actual.size() != expected.size()) return;
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    BOOST_CHECK_SMALL(actual[i] - expected[i], 1e-9);
+} // SignalShapingTest::checkSame()
+
+
+//------------------------------------------------------------------------------
+void SignalShapingTest::testUnfiltered(int n) const {
+
+  util::LArFFTWPlan const plan(n, "ES");
+  util::LArFFTW fft(plan, 20);
+
+  util::SignalShaping shaping;
+  shaping.AddResponseFunction(makeResponse(n));
+  util::SignalShaping::SharedPtr_t const shared
+    = util::SignalShaping::Share(std::move(shaping));
+
+  BOOST_CHECK(shared->DeconvKernel().empty());
+
+  // the shaper refuses to compute its kernel
+  std::vector<double> waveform = makeWaveform(n, 0U);
+  BOOST_CHECK_EXCEPTION(shared->Deconvolute(waveform), cet::exception,
+    isSharedShaperError);
+  BOOST_CHECK_EXCEPTION(shared->Deconvolute(fft, waveform), cet::exception,
+    isSharedShaperError);
+
+  // the shaper is not changed by the failures
+  BOOST_CHECK(shared->DeconvKernel().empty());
+  BOOST_CHECK_EXCEPTION(shared->Deconvolute(waveform), cet::exception,
+    isSharedShaperError);
+
+  // convolution is still available
+  shared->Convolute(waveform);
+  shared->Convolute(fft, waveform);
+
+  // the same for the shapers in the registry
+  util::SignalShaping::SharedPtr_t const registered
+    = util::SignalShaping::Shared("SignalShapingTest/unfiltered",
+      [n](util::SignalShaping& shaper)
+        { shaper.AddResponseFunction(makeResponse(n)); }
+      );
+  BOOST_CHECK_EXCEPTION(registered->Deconvolute(waveform), cet::exception,
+    isSharedShaperError);
+  BOOST_CHECK_EXCEPTION(registered->Deconvolute(fft, waveform), cet::exception,
+    isSharedShaperError);
+
+  // an unshared shaper still calculates its kernel when first needed
+  util::SignalShaping unshared;
+  unshared.AddResponseFunction(makeResponse(n));
+  unshared.AddFilterFunction(makeFilter(n));
+  unshared.Deconvolute(waveform);
+  BOOST_CHECK(!unshared.DeconvKernel().empty());
+
+} // SignalShapingTest::testUnfiltered()
+
+
+//------------------------------------------------------------------------------
+void SignalShapingTest::testConcurrent(int n) const {
+
+  util::LArFFTWPlan const plan(n, "ES");
+
+  util::SignalShaping shaping;
+  shaping.AddResponseFunction(makeResponse(n));
+  shaping.AddFilterFunction(makeFilter(n));
+  util::SignalShaping::SharedPtr_t const shared
+    = util::SignalShaping::Share(std::move(shaping));
+  BOOST_CHECK(!shared->DeconvKernel().empty());
+
+  // the expected results, from this thread alone
+  std::vector<Shaped_t> expected;
+  {
+    util::LArFFTW fft(plan, 20);
+    for (unsigned int i = 0; i < nIterations; ++i)
+      expected.push_back(shape(*shared, fft, n, i));
+  }
+
+  // all the threads at once, each with its own engine
+  std::vector<std::vector<Shaped_t>> results(nThreads);
+  std::vector<int> failed(nThreads, 0); // not `bool`: written concurrently
+  std::vector<std::thread> workers;
+  for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+    workers.emplace_back([&, iThread](){
+      try {
+        util::LArFFTW fft(plan, 20);
+        for (unsigned int i = 0; i < nIterations; ++i)
+          results[iThread].push_back(shape(*shared, fft, n, i));
+      }
+      catch (...) { failed[iThread] = 1; }
+    });
+  } // for threads
+  for (std::thread& worker: workers) worker.join();
+
+  for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+    BOOST_TEST_CHECKPOINT("thread #" << iThread);
+    BOOST_CHECK_EQUAL(failed[iThread], 0);
+    BOOST_CHECK_EQUAL(results[iThread].size(), expected.size());
+    if (results[iThread].size() != expected.size()) continue;
+    for (unsigned int i = 0; i < nIterations; ++i) {
+      Shaped_t const& result = results[iThread][i];
+      checkSame(result.convoluted, expected[i].convoluted);
+      checkSame(result.deconvoluted, expected[i].deconvoluted);
+      checkSame(result.convolutedFFTW, expected[i].convolutedFFTW);
+      checkSame(result.deconvolutedFFTW, expected[i].deconvolutedFFTW);
+    } // for waveforms
+  } // for threads
+
+} // SignalShapingTest::testConcurrent()
+
+
+//------------------------------------------------------------------------------
+void SignalShapingTest::analyze
+  (art::Event const&, art::ProcessingFrame const&)
+{
+
+  int const n = art::ServiceHandle<util::LArFFT const>{}->FFTSize();
+
+  testUnfiltered(n);
+  testConcurrent(n);
+
+} // SignalShapingTest::analyze()
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_MODULE(SignalShapingTest)
@@ -19,7 +19,8 @@
 #include <cmath>
 #include <tuple>
 #include <array>
-#include <stdexcept> // std::range_error
+#include <stdexcept> // std::range_error, std::length_error
+#include <vector>
 #include <iterator> // std::ostream_iterator
 #include <iostream>
 
@@ -40,6 +41,7 @@
 
 // LArSoft libraries
 #include "lardata/Utilities/SimpleFits.h"
+#include "lardata/Utilities/HardwareCounters.h"
 
 
 //==============================================================================
@@ -388,6 +390,73 @@ void LinearFitTest() {
     unc_chisq, unc_DoF
     );
 
+  //
+  // part V: add elements from separate arrays
+  //
+  std::vector<Data_t> xs, ys, sys;
+  for (auto const& data: uncertain_data) {
+    xs.push_back(std::get<0>(data));
+    ys.push_back(std::get<1>(data));
+    sys.push_back(std::get<2>(data));
+  } // for
+
+  // - V.1: fill with uncertainties
+  fitter.clear();
+  BOOST_CHECK_EQUAL(fitter.add_arrays(xs, ys, sys), (unsigned int) n);
+  CheckLinearFit<Data_t>(fitter, n,
+    intercept, slope,
+    unc_intercept_error, unc_slope_error, unc_intercept_slope_cov,
+    unc_chisq, unc_DoF
+    );
+
+  // - V.2: fill without uncertainties
+  fitter.clear();
+  BOOST_CHECK_EQUAL(fitter.add_arrays(xs, ys), (unsigned int) n);
+  CheckLinearFit<Data_t>(fitter, n,
+    intercept, slope,
+    perf_intercept_error, perf_slope_error, perf_intercept_slope_cov,
+    perf_chisq, perf_DoF
+    );
+
+  // - V.3: fill from pointers, with a point with no uncertainty (ignored)
+  xs.push_back(Data_t(2));
+  ys.push_back(Data_t(50));
+  sys.push_back(Data_t(0));
+  fitter.clear();
+  BOOST_CHECK_EQUAL(
+    fitter.add_arrays(xs.data(), ys.data(), sys.data(), xs.size()),
+    (unsigned int) n
+    );
+  CheckLinearFit<Data_t>(fitter, n,
+    intercept, slope,
+    unc_intercept_error, unc_slope_error, unc_intercept_slope_cov,
+    unc_chisq, unc_DoF
+    );
+
+  BOOST_CHECK_THROW
+    (fitter.add_arrays(xs, std::vector<Data_t>(2U)), std::length_error);
+
+  //
+  // part VI: merge fits of parts of the data
+  //
+  fitter.clear();
+  {
+    decltype(fitter) other, empty;
+    bool toOther = false;
+    for (auto const& data: uncertain_data) {
+      (toOther? other: fitter).add(data);
+      toOther = !toOther;
+    } // for
+    BOOST_CHECK_EQUAL(other.N(), n / 2);
+    fitter += other;
+    fitter.merge(empty);
+  }
+  CheckLinearFit<Data_t>(fitter, n,
+    intercept, slope,
+    unc_intercept_error, unc_slope_error, unc_intercept_slope_cov,
+    unc_chisq, unc_DoF
+    );
+
 } // LinearFitTest()
 
 
@@ -519,6 +588,61 @@ void QuadraticFitTest() {
   CheckQuadraticFit<Data_t>
     (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
 
+  //
+  // part V: add elements from separate arrays
+  //
+  std::vector<Data_t> xs, ys, sys;
+  for (auto const& data: uncertain_data) {
+    xs.push_back(std::get<0>(data));
+    ys.push_back(std::get<1>(data));
+    sys.push_back(std::get<2>(data));
+  } // for
+
+  // - V.1: fill with uncertainties
+  fitter.clear();
+  BOOST_CHECK_EQUAL(fitter.add_arrays(xs, ys, sys), (unsigned int) n);
+  CheckQuadraticFit<Data_t>
+    (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
+
+  // - V.2: fill without uncertainties
+  fitter.clear();
+  BOOST_CHECK_EQUAL(fitter.add_arrays(xs, ys), (unsigned int) n);
+  CheckQuadraticFit<Data_t>
+    (fitter, n, solution, perf_errors2, perf_chisq, perf_DoF);
+
+  // - V.3: fill from pointers, with a point with no uncertainty (ignored)
+  xs.push_back(Data_t(2));
+  ys.push_back(Data_t(50));
+  sys.push_back(Data_t(0));
+  fitter.clear();
+  BOOST_CHECK_EQUAL(
+    fitter.add_arrays(xs.data(), ys.data(), sys.data(), xs.size()),
+    (unsigned int) n
+    );
+  CheckQuadraticFit<Data_t>
+    (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
+
+  BOOST_CHECK_THROW
+    (fitter.add_arrays(xs, std::vector<Data_t>(2U)), std::length_error);
+
+  //
+  // part VI: merge fits of parts of the data
+  //
+  fitter.clear();
+  {
+    decltype(fitter) other, empty;
+    bool toOther = false;
+    for (auto const& data: uncertain_data) {
+      (toOther? other: fitter).add(data);
+      toOther = !toOther;
+    } // for
+    BOOST_CHECK_EQUAL(other.N(), n / 2);
+    fitter += other;
+    fitter.merge(empty);
+  }
+  CheckQuadraticFit<Data_t>
+    (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
+
 } // QuadraticFitTest()
 
 
@@ -661,9 +785,161 @@ void GaussianFitTest() {
   CheckGaussianFit<Data_t>
     (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
 
+  //
+  // part V: add elements from separate arrays
+  //
+  std::vector<Data_t> xs, ys, sys;
+  for (auto const& data: uncertain_data) {
+    xs.push_back(std::get<0>(data));
+    ys.push_back(std::get<1>(data));
+    sys.push_back(std::get<2>(data));
+  } // for
+
+  // - V.1: fill with uncertainties
+  fitter.clear();
+  BOOST_CHECK_EQUAL(fitter.add_arrays(xs, ys, sys), (unsigned int) n);
+  CheckGaussianFit<Data_t>
+    (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
+
+  // - V.2: fill without uncertainties
+  fitter.clear();
+  BOOST_CHECK_EQUAL(fitter.add_arrays(xs, ys), (unsigned int) n);
+  CheckGaussianFit<Data_t>
+    (fitter, n, solution, perf_errors2, perf_chisq, perf_DoF);
+
+  // - V.3: fill from pointers, with a point with no uncertainty (ignored)
+  xs.push_back(Data_t(2));
+  ys.push_back(Data_t(50));
+  sys.push_back(Data_t(0));
+  fitter.clear();
+  BOOST_CHECK_EQUAL(
+    fitter.add_arrays(xs.data(), ys.data(), sys.data(), xs.size()),
+    (unsigned int) n
+    );
+  CheckGaussianFit<Data_t>
+    (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
+
+  BOOST_CHECK_THROW
+    (fitter.add_arrays(xs, std::vector<Data_t>(2U)), std::length_error);
+
+  //
+  // part VI: merge fits of parts of the data
+  //
+  fitter.clear();
+  {
+    decltype(fitter) other, empty;
+    bool toOther = false;
+    for (auto const& data: uncertain_data) {
+      (toOther? other: fitter).add(data);
+      toOther = !toOther;
+    } // for
+    BOOST_CHECK_EQUAL(other.N(), n / 2);
+    fitter += other;
+    fitter.merge(empty);
+  }
+  CheckGaussianFit<Data_t>
+    (fitter, n, solution, unc_errors2, unc_chisq, unc_DoF);
+
 } // QuadraticFitTest()
 
 
+/** ****************************************************************************
+ * @brief Tests makeFits() with a few datasets in a single set of arrays
+ */
+template <typename T>
+void MultipleFitsTest() {
+
+  using Data_t = T;
+
+  // three datasets: y = -2x, empty, y = 1 + x
+  std::vector<std::size_t> const offsets { 0, 3, 3, 6 };
+  std::vector<Data_t> const xs { -4, 0, 4,   0, 1, 2 };
+  std::vector<Data_t> const ys {  8, 0, -8,  1, 2, 3 };
+  std::vector<Data_t> const sys { 1, 2, 2,   1, 1, 1 };
+
+  auto const fits = lar::util::makeFits<lar::util::LinearFit<Data_t>>
+    (offsets, xs, ys, sys);
+  BOOST_CHECK_EQUAL(fits.size(), 3U);
+
+  CheckLinearFit<Data_t>(fits[0], 3,
+    Data_t(0), Data_t(-2),
+    std::sqrt(Data_t(20)/Data_t(21)), std::sqrt(Data_t(1.5)/Data_t(21)),
+    Data_t(3)/Data_t(21),
+    Data_t(0), 1
+    );
+  CheckLinearFit<Data_t>(fits[1], 0, 0., 0., 0., 0., 0., 0., 0);
+  BOOST_CHECK_EQUAL(fits[2].N(), 3);
+  BOOST_CHECK_CLOSE(double(fits[2].Intercept()), 1.0, 0.1);
+  BOOST_CHECK_CLOSE(double(fits[2].Slope()), 1.0, 0.1);
+
+  // the same with no uncertainty, from pointers
+  auto const unitFits = lar::util::makeFits<lar::util::LinearFit<Data_t>>
+    (offsets, xs.data(), ys.data(), nullptr);
+  BOOST_CHECK_EQUAL(unitFits.size(), 3U);
+  BOOST_CHECK_EQUAL(unitFits[0].N(), 3);
+  BOOST_CHECK_CLOSE(double(unitFits[0].Slope()), -2.0, 0.1);
+  BOOST_CHECK_CLOSE(double(unitFits[2].Intercept()), 1.0, 0.1);
+
+  // datasets beyond the data
+  std::vector<std::size_t> const badOffsets { 0, 3, 7 };
+  BOOST_CHECK_THROW(
+    lar::util::makeFits<lar::util::LinearFit<Data_t>>
+      (badOffsets, xs, ys, sys),
+    std::length_error
+    );
+
+} // MultipleFitsTest()
+
+
+/** ****************************************************************************
+ * @brief Hardware counters of linear fits, one by one and with makeFits()
+ *
+ * Runs only with `LARDATA_HARDWARE_BENCHMARK` set in the environment (see
+ * `lar::bench::HardwareBenchmark`).
+ */
+template <typename T>
+void LinearFitBenchmark() {
+
+  if (!lar::bench::HardwareBenchmark::enabled()) return;
+
+  using Data_t = T;
+
+  constexpr std::size_t NFits = 2000U, NPoints = 50U;
+  std::vector<std::size_t> offsets;
+  std::vector<Data_t> xs, ys, sys;
+  for (std::size_t iFit = 0; iFit < NFits; ++iFit) {
+    offsets.push_back(xs.size());
+    for (std::size_t i = 0; i < NPoints; ++i) {
+      xs.push_back(Data_t(i));
+      ys.push_back(Data_t(iFit % 7) + Data_t(0.5) * i + Data_t((i * 13) % 5) / 10);
+      sys.push_back(Data_t(1) + Data_t(i % 3) / 4);
+    } // for points
+  } // for fits
+  offsets.push_back(xs.size());
+
+  Data_t sum = Data_t(0); // prevents the optimizer from skipping the work
+  lar::bench::HardwareBenchmark bench { "linear fits", "points" };
+  bench.add("LinearFit::add()", [&](){
+      for (std::size_t iFit = 0; iFit < NFits; ++iFit) {
+        lar::util::LinearFit<Data_t> fitter;
+        for (std::size_t i = offsets[iFit]; i < offsets[iFit + 1]; ++i)
+          fitter.add(xs[i], ys[i], sys[i]);
+        sum += fitter.Slope();
+      } // for
+      return xs.size();
+    });
+  bench.add("makeFits()", [&](){
+      auto const fits = lar::util::makeFits<lar::util::LinearFit<Data_t>>
+        (offsets, xs, ys, sys);
+      for (auto const& fit: fits) sum += fit.Slope();
+      return xs.size();
+    });
+  bench.runIfEnabled(std::cout);
+  BOOST_CHECK(std::isfinite(sum));
+
+} // LinearFitBenchmark()
+
+
 //------------------------------------------------------------------------------
 //--- registration of tests
 //
@@ -694,3 +970,17 @@ BOOST_AUTO_TEST_CASE(GaussianFitRealTest) {
   GaussianFitTest<double>();
 }
 
+//
+// makeFits() tests
+//
+BOOST_AUTO_TEST_CASE(MultipleFitsRealTest) {
+  MultipleFitsTest<double>();
+}
+
+//
+// hardware counters (only if enabled)
+//
+BOOST_AUTO_TEST_CASE(LinearFitBenchmarkRealTest) {
+  LinearFitBenchmark<double>();
+}
+
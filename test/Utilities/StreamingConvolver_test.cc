@@ -0,0 +1,186 @@
+/**
+ * @file    StreamingConvolver_test.cc
+ * @brief   Tests the block convolution of `util::StreamingConvolver`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/StreamingConvolver.h`
+ *
+ * Streams of different lengths (shorter than a block, a multiple of the
+ * block output and not) are fed in fragments of assorted sizes, and the
+ * output of both methods is compared tick by tick with a one-shot
+ * convolution of the whole stream with a transform large enough to avoid
+ * any wrapping.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( StreamingConvolver_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/StreamingConvolver.h"
+#include "lardata/Utilities/LArFFTW.h"
+#include "lardata/Utilities/LArFFTWPlan.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <cmath>
+#include <vector>
+
+
+namespace {
+
+  constexpr int BlockSize = 64;
+  constexpr int Pre = 3; // non-causal extent of the test response
+  constexpr int Post = 5; // causal extent of the test response
+  constexpr int Step = BlockSize - Pre - Post; // output ticks per block
+  constexpr int OneShotSize = 1024; // longer than any tested stream
+
+  /// Response at tick `m` (from `-Pre` to `Post`)
+  double response(int m) { return 1.0 / (2.0 + m + 0.1 * m * m); }
+
+  /// Frequency domain kernel of the response for the specified size
+  util::LArFFTW::ComplexVector makeKernel(util::LArFFTW& fft, int size) {
+    std::vector<double> impulse(size, 0.0);
+    for (int m = -Pre; m <= Post; ++m) impulse[(m + size) % size] = response(m);
+    util::LArFFTW::ComplexVector kernel(size / 2 + 1);
+    fft.DoFFT(impulse, kernel);
+    return kernel;
+  }
+
+  std::vector<double> makeStream(std::size_t n) {
+    std::vector<double> stream(n);
+    for (std::size_t i = 0; i < n; ++i)
+      stream[i] = std::sin(0.37 * i) + ((i % 17 == 0)? 5.0: 0.0);
+    return stream;
+  }
+
+  /// Linear convolution of the stream, with the same size as the stream
+  std::vector<double> oneShot(std::vector<double> const& stream) {
+    util::LArFFTWPlan const plan(OneShotSize, "ES");
+    util::LArFFTW fft(plan, 20);
+    util::LArFFTW::ComplexVector const kernel = makeKernel(fft, OneShotSize);
+
+    std::vector<double> padded(OneShotSize, 0.0);
+    std::copy(stream.begin(), stream.end(), padded.begin());
+    fft.Convolute(padded, kernel);
+    return { padded.begin(), padded.begin() + stream.size() };
+  }
+
+  /// Streams `stream` in fragments of the sizes in `fragments` (cycled)
+  std::vector<double> streamed(
+    std::vector<double> const& stream, std::vector<std::size_t> const& fragments,
+    util::StreamingConvolver::Method method
+  ) {
+    util::LArFFTWPlan const plan(BlockSize, "ES");
+    util::LArFFTW fft(plan, 20);
+    util::StreamingConvolver conv
+      (fft, BlockSize, makeKernel(fft, BlockSize), Pre, Post, method);
+    BOOST_CHECK_EQUAL(conv.BlockStep(), Step);
+
+    std::vector<double> output;
+    std::size_t start = 0U, iFragment = 0U;
+    while (start < stream.size()) {
+      std::size_t const n
+        = std::min(fragments[iFragment++ % fragments.size()], stream.size() - start);
+      conv.Feed(stream.data() + start, n, output);
+      start += n;
+      BOOST_CHECK_EQUAL(conv.NInput(), start);
+      BOOST_CHECK_LE(conv.NOutput(), conv.NInput());
+      BOOST_CHECK_EQUAL(conv.NOutput(), output.size());
+    }
+    conv.Finish(output);
+    return output;
+  }
+
+  void checkSame(std::vector<double> const& output,
+                 std::vector<double> const& expected)
+  {
+    BOOST_CHECK_EQUAL(output.size(), expected.size());
+    if (output.size() != expected.size()) return;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      BOOST_CHECK_SMALL(output[i] - expected[i], 1e-9);
+    if (expected.empty()) return;
+    // the edges, which depend on the padding of the first and last blocks
+    BOOST_CHECK_SMALL(output.front() - expected.front(), 1e-9);
+    BOOST_CHECK_SMALL(output.back() - expected.back(), 1e-9);
+  }
+
+  void testMethod(util::StreamingConvolver::Method method) {
+    std::vector<std::size_t> const lengths = {
+      1U, Step - 1U, std::size_t(Step), std::size_t(BlockSize),
+      3U * Step, 3U * Step + 1U, 500U
+    };
+    std::vector<std::vector<std::size_t>> const fragmentings = {
+      { 1000U }, // all at once
+      { 1U }, // tick by tick
+      { 7U, std::size_t(BlockSize), 1U, 30U }
+    };
+    for (std::size_t length: lengths) {
+      BOOST_TEST_CHECKPOINT("stream length " << length);
+      std::vector<double> const stream = makeStream(length);
+      std::vector<double> const expected = oneShot(stream);
+      for (auto const& fragments: fragmentings)
+        checkSame(streamed(stream, fragments, method), expected);
+    }
+  }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(OverlapSaveTestCase) {
+  testMethod(util::StreamingConvolver::kOverlapSave);
+}
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(OverlapAddTestCase) {
+  testMethod(util::StreamingConvolver::kOverlapAdd);
+}
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(NewStreamTestCase) {
+
+  // after Finish(), a second stream is not affected by the first one
+  util::LArFFTWPlan const plan(BlockSize, "ES");
+  util::LArFFTW fft(plan, 20);
+  util::StreamingConvolver conv(fft, BlockSize, makeKernel(fft, BlockSize), Pre, Post);
+
+  std::vector<double> const first = makeStream(100U);
+  std::vector<double> output;
+  conv.Feed(first.data(), first.size(), output);
+  conv.Finish(output);
+  BOOST_CHECK_EQUAL(output.size(), first.size());
+  BOOST_CHECK_EQUAL(conv.NInput(), 0U);
+
+  std::vector<double> const second(70U, 1.0);
+  output.clear();
+  conv.Feed(second.data(), second.size(), output);
+  conv.Finish(output);
+  checkSame(output, oneShot(second));
+
+  // an empty stream has no output
+  output.clear();
+  conv.Finish(output);
+  BOOST_CHECK(output.empty());
+
+} // NewStreamTestCase
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BadConfigurationTestCase) {
+
+  util::LArFFTWPlan const plan(BlockSize, "ES");
+  util::LArFFTW fft(plan, 20);
+  util::LArFFTW::ComplexVector const kernel = makeKernel(fft, BlockSize);
+
+  BOOST_CHECK_THROW(util::StreamingConvolver(fft, BlockSize, kernel, -1, Post),
+                    cet::exception);
+  BOOST_CHECK_THROW(util::StreamingConvolver(fft, BlockSize, kernel, 32, 32),
+                    cet::exception);
+  BOOST_CHECK_THROW(
+    util::StreamingConvolver(fft, 2 * BlockSize, kernel, Pre, Post),
+    cet::exception);
+
+} // BadConfigurationTestCase
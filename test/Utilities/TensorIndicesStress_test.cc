@@ -16,16 +16,89 @@
  * content is small and can likely kept in the processor cache, which is not
  * often the case in real scenarios.
  *
+ * A second test compares row-major (`util::TensorIndices`) and Morton order
+ * (`util::MortonTensorIndices`) on a 3D grid of `2 DimSize` cells per side,
+ * summing for each cell the values in the 3 x 3 x 3 cells around it.
+ * The same sum is then timed on a grid of `FixedSide` cells per side, with
+ * run-time sizes and with sizes fixed at compile time
+ * (`util::FixedTensorIndices`).
+ * With the environment variable `LARDATA_HARDWARE_BENCHMARK` set, the
+ * hardware counters of the sums are also reported
+ * (see `lar::bench::HardwareBenchmark`).
+ *
  */
 
 // LArSoft libraries
 #include "lardata/Utilities/TensorIndices.h"
+#include "lardata/Utilities/GridContainerIndices.h"
+#include "lardata/Utilities/HardwareCounters.h"
 
 // C/C++ standard libraries
 #include <array>
 #include <chrono>
 #include <sstream>
 #include <iostream>
+#include <vector>
+
+
+/// Side of the grid for the comparison with compile-time sizes
+constexpr unsigned int FixedSide = 64U;
+
+/// Index manager of the grid with compile-time sizes
+using FixedIndices_t
+  = util::GridContainer3DFixedIndices<FixedSide, FixedSide, FixedSide>;
+
+
+//------------------------------------------------------------------------------
+/// A 3D grid with a value in each cell
+template <typename Indices>
+struct NeighbourhoodGrid {
+
+  unsigned int side;
+  Indices indices;
+  std::vector<float> values;
+
+  NeighbourhoodGrid(unsigned int side)
+    : side(side)
+    , indices(std::array<std::size_t, 3U>{{ side, side, side }})
+    , values(indices.size(), 0.0f)
+    {
+      // each cell holds a value from its coordinates
+      typename Indices::CellID_t id;
+      for (id[0] = 0; id[0] < (std::ptrdiff_t) side; ++id[0])
+        for (id[1] = 0; id[1] < (std::ptrdiff_t) side; ++id[1])
+          for (id[2] = 0; id[2] < (std::ptrdiff_t) side; ++id[2])
+            values[indices[id]] = float((id[0] * 7 + id[1] * 3 + id[2]) % 11);
+    }
+
+  /// Returns the sum of the neighbourhoods of all the cells
+  double sum() const
+    {
+      double sum = 0.0;
+      typename Indices::CellID_t id;
+      for (id[0] = 0; id[0] < (std::ptrdiff_t) side; ++id[0])
+        for (id[1] = 0; id[1] < (std::ptrdiff_t) side; ++id[1])
+          for (id[2] = 0; id[2] < (std::ptrdiff_t) side; ++id[2])
+            for (auto index: indices.neighbourhood(id, 1)) sum += values[index];
+      return sum;
+    }
+
+}; // NeighbourhoodGrid
+
+
+/// Sums the neighbourhood of each cell of a grid; returns the time [ms]
+template <typename Indices>
+double neighbourhoodSum(unsigned int side, double& sum) {
+
+  NeighbourhoodGrid<Indices> const grid(side);
+
+  auto startTime = std::chrono::high_resolution_clock::now();
+  sum = grid.sum();
+  auto stopTime = std::chrono::high_resolution_clock::now();
+
+  std::chrono::duration<double> elapsed = stopTime - startTime;
+  return elapsed.count() * 1000.;
+} // neighbourhoodSum()
 
 
 //------------------------------------------------------------------------------
@@ -102,5 +175,68 @@ int main(int argc, char** argv) {
   std::cout << "Iterating through all " << count << " indices took "
     << (elapsed.count() * 1000.) << " milliseconds." << std::endl;
 
+  //
+  // neighbourhood access, row-major versus Morton order
+  //
+  unsigned int const side = 2 * dimSize;
+  double rowMajorSum, mortonSum;
+  double const rowMajorTime
+    = neighbourhoodSum<util::GridContainer3DIndices>(side, rowMajorSum);
+  double const mortonTime
+    = neighbourhoodSum<util::GridContainer3DMortonIndices>(side, mortonSum);
+  std::cout << "Summing the neighbourhoods of " << side << "^3 cells took "
+    << rowMajorTime << " milliseconds in row-major order, "
+    << mortonTime << " milliseconds in Morton order." << std::endl;
+  if (rowMajorSum != mortonSum) {
+    std::cerr << "Error: neighbourhood sum " << mortonSum
+      << " in Morton order, " << rowMajorSum << " in row-major order"
+      << std::endl;
+    return 1;
+  }
+
+  //
+  // neighbourhood access, run-time versus compile-time sizes
+  //
+  double runtimeSum, fixedSum;
+  double const runtimeTime
+    = neighbourhoodSum<util::GridContainer3DIndices>(FixedSide, runtimeSum);
+  double const fixedTime
+    = neighbourhoodSum<FixedIndices_t>(FixedSide, fixedSum);
+  std::cout << "Summing the neighbourhoods of " << FixedSide << "^3 cells took "
+    << runtimeTime << " milliseconds with run-time sizes, "
+    << fixedTime << " milliseconds with compile-time sizes." << std::endl;
+  if (runtimeSum != fixedSum) {
+    std::cerr << "Error: neighbourhood sum " << fixedSum
+      << " with compile-time sizes, " << runtimeSum << " with run-time sizes"
+      << std::endl;
+    return 1;
+  }
+
+  //
+  // hardware counters of the neighbourhood sums (if enabled)
+  //
+  if (lar::bench::HardwareBenchmark::enabled()) {
+    NeighbourhoodGrid<util::GridContainer3DIndices> const rowMajor(side);
+    NeighbourhoodGrid<util::GridContainer3DMortonIndices> const morton(side);
+    std::size_t const nCells = std::size_t(side) * side * side;
+    double sum = 0.0;
+    lar::bench::HardwareBenchmark bench { "neighbourhood sums", "cells" };
+    bench.add("row-major", [&](){ sum += rowMajor.sum(); return nCells; });
+    bench.add("Morton", [&](){ sum += morton.sum(); return nCells; });
+    bench.run(std::cout, lar::bench::HardwareBenchmark::enabledRepetitions());
+
+    NeighbourhoodGrid<util::GridContainer3DIndices> const runtime(FixedSide);
+    NeighbourhoodGrid<FixedIndices_t> const fixed(FixedSide);
+    std::size_t const nFixedCells = std::size_t(FixedSide) * FixedSide * FixedSide;
+    lar::bench::HardwareBenchmark fixedBench
+      { "neighbourhood sums, fixed side", "cells" };
+    fixedBench.add
+      ("run-time sizes", [&](){ sum += runtime.sum(); return nFixedCells; });
+    fixedBench.add
+      ("compile-time sizes", [&](){ sum += fixed.sum(); return nFixedCells; });
+    fixedBench.run
+      (std::cout, lar::bench::HardwareBenchmark::enabledRepetitions());
+  }
+
   return 0;
 } // main()
@@ -15,13 +15,17 @@
  * * `VectorTest`: one-dimension tensor test
  * * `MatrixTest`: two-dimension tensor test
  * * `TensorRank3Test`: test rank 3 tensor
+ * * `MortonRank3Test`: test rank 3 tensor in Morton order
+ * * `FixedRank3Test`: test rank 3 tensor with sizes fixed at compile time
  *
- * See the documentation of the three functions for more information.
+ * See the documentation of the test functions for more information.
  *
  */
 
 // LArSoft libraries
 #include "lardata/Utilities/TensorIndices.h"
+#include "lardata/Utilities/MortonTensorIndices.h"
+#include "lardata/Utilities/FixedTensorIndices.h"
 
 // Boost libraries
 #define BOOST_TEST_MODULE ( PointIsolationAlg_test )
@@ -29,7 +33,9 @@
 #include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
 
 // C/C++ standard libraries
-#include <stdexcept> // std::out_of_range
+#include <array>
+#include <set>
+#include <stdexcept> // std::out_of_range, std::length_error, ...
 
 
 //------------------------------------------------------------------------------
@@ -305,6 +311,132 @@ void TensorRank3Test() {
 } // TensorRank3Test()
 
 
+/**
+ * @brief Test for a rank 3 tensor in Morton order
+ *
+ * The bits of the indices of a 5 x 3 x 4 tensor are interleaved (the last
+ * index getting the lowest bit), with each dimension padded to a power of 2.
+ */
+void MortonRank3Test() {
+
+  util::MortonTensorIndices<3U> indices(5U, 3U, 4U);
+
+  BOOST_CHECK_EQUAL(indices.rank(), 3U);
+  BOOST_CHECK_EQUAL(indices.dim<0>(), 5U);
+  BOOST_CHECK_EQUAL(indices.dim<1>(), 3U);
+  BOOST_CHECK_EQUAL(indices.dim<2>(), 4U);
+  BOOST_CHECK_EQUAL(indices.size(), 8U * 4U * 4U); // padded
+
+  // bit order, from the lowest: z0 y0 x0 z1 y1 x1 x2
+  BOOST_CHECK_EQUAL(indices.mask(2), 0b0001001U);
+  BOOST_CHECK_EQUAL(indices.mask(1), 0b0010010U);
+  BOOST_CHECK_EQUAL(indices.mask(0), 0b1100100U);
+
+  BOOST_CHECK_EQUAL(indices(0, 0, 0), 0U);
+  BOOST_CHECK_EQUAL(indices(0, 0, 1), 1U);
+  BOOST_CHECK_EQUAL(indices(0, 1, 0), 2U);
+  BOOST_CHECK_EQUAL(indices(1, 0, 0), 4U);
+  BOOST_CHECK_EQUAL(indices(0, 0, 2), 8U);
+  BOOST_CHECK_EQUAL(indices(4, 0, 0), 64U);
+  BOOST_CHECK_EQUAL(indices(4, 2, 3), 64U + 16U + 8U + 1U);
+
+  // all the valid indices are different, in range, and decoded back
+  std::set<util::MortonTensorIndices<3U>::LinIndex_t> seen;
+  std::array<std::ptrdiff_t, 3U> i;
+  for (i[0] = 0; i[0] < 5; ++i[0]) {
+    for (i[1] = 0; i[1] < 3; ++i[1]) {
+      for (i[2] = 0; i[2] < 4; ++i[2]) {
+        auto const linIndex = indices(i.begin());
+        BOOST_CHECK_EQUAL(linIndex, indices(i[0], i[1], i[2]));
+        BOOST_CHECK(indices.hasLinIndex(linIndex));
+        BOOST_CHECK(indices.has(i.begin()));
+        auto const back = indices.indices(linIndex);
+        BOOST_CHECK_EQUAL_COLLECTIONS
+          (back.begin(), back.end(), i.begin(), i.end());
+        seen.insert(linIndex);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(seen.size(), 5U * 3U * 4U);
+
+  BOOST_CHECK( indices.hasIndex<0>(4));
+  BOOST_CHECK(!indices.hasIndex<0>(5));
+  BOOST_CHECK(!indices.hasIndex<1>(-1));
+  i = {{ 1, 3, 0 }};
+  BOOST_CHECK(!indices.has(i.begin()));
+  BOOST_CHECK_THROW(indices.at(i.begin()), std::out_of_range);
+  BOOST_CHECK(!indices.hasLinIndex(indices.size()));
+
+  BOOST_CHECK(indices == util::MortonTensorIndices<3U>(5U, 3U, 4U));
+  BOOST_CHECK(indices != util::MortonTensorIndices<3U>(5U, 4U, 4U));
+
+  // 3 x 22 bits is too much
+  BOOST_CHECK_THROW(
+    util::MortonTensorIndices<3U>(1U << 22, 1U << 22, 1U << 22),
+    std::length_error
+    );
+
+} // MortonRank3Test()
+
+
+/**
+ * @brief Test for a rank 3 tensor with sizes fixed at compile time
+ *
+ * The linear indices of a 5 x 3 x 4 tensor are compared with the ones of
+ * `util::TensorIndices` with the same sizes; some of them are also checked at
+ * compile time.
+ */
+void FixedRank3Test() {
+
+  using Indices_t = util::FixedTensorIndices<5U, 3U, 4U>;
+  constexpr Indices_t indices;
+  util::TensorIndices<3U> const runtime(5U, 3U, 4U);
+
+  static_assert(Indices_t::rank() == 3U);
+  static_assert(Indices_t::size() == 5U * 3U * 4U);
+  static_assert(Indices_t::size<1>() == 3U * 4U);
+  static_assert(Indices_t::dim<2>() == 4U);
+  static_assert(indices(4, 2, 3) == 4U * 12U + 2U * 4U + 3U);
+  static_assert(indices.hasIndex<0>(4) && !indices.hasIndex<0>(5));
+
+  BOOST_CHECK_EQUAL(indices.rank(), runtime.rank());
+  BOOST_CHECK_EQUAL(indices.size(), runtime.size());
+  BOOST_CHECK_EQUAL(indices.dim<0>(), runtime.dim<0>());
+  BOOST_CHECK_EQUAL(indices.dim<1>(), runtime.dim<1>());
+  BOOST_CHECK_EQUAL(indices.dim<2>(), runtime.dim<2>());
+  BOOST_CHECK_EQUAL(indices.size<2>(), runtime.size<2>());
+
+  std::array<std::ptrdiff_t, 3U> i;
+  for (i[0] = 0; i[0] < 5; ++i[0]) {
+    for (i[1] = 0; i[1] < 3; ++i[1]) {
+      for (i[2] = 0; i[2] < 4; ++i[2]) {
+        auto const linIndex = indices(i.begin());
+        BOOST_CHECK_EQUAL(linIndex, runtime(i.begin()));
+        BOOST_CHECK_EQUAL(linIndex, indices(i[0], i[1], i[2]));
+        BOOST_CHECK_EQUAL(indices.at(i.begin()), linIndex);
+        BOOST_CHECK(indices.has(i.begin()));
+        auto const back = indices.indices(linIndex);
+        BOOST_CHECK_EQUAL_COLLECTIONS
+          (back.begin(), back.end(), i.begin(), i.end());
+      }
+    }
+  }
+
+  BOOST_CHECK(!indices.hasIndex<1>(-1));
+  i = {{ 1, 3, 0 }};
+  BOOST_CHECK(!indices.has(i.begin()));
+  BOOST_CHECK_THROW(indices.at(i.begin()), std::out_of_range);
+  BOOST_CHECK(!indices.hasLinIndex(indices.size()));
+
+  // construction from sizes only accepts the fixed ones
+  std::array<std::size_t, 3U> const sizes {{ 5U, 3U, 4U }};
+  BOOST_CHECK(Indices_t(sizes.begin()) == indices);
+  std::array<std::size_t, 3U> const otherSizes {{ 5U, 4U, 4U }};
+  BOOST_CHECK_THROW(Indices_t(otherSizes.begin()), std::invalid_argument);
+
+} // FixedRank3Test()
+
+
 //------------------------------------------------------------------------------
 //--- tests
 //
@@ -320,3 +452,11 @@ BOOST_AUTO_TEST_CASE(TensorRank3TestCase) {
   TensorRank3Test();
 } // TensorRank3TestCase
 
+BOOST_AUTO_TEST_CASE(MortonRank3TestCase) {
+  MortonRank3Test();
+} // MortonRank3TestCase
+
+BOOST_AUTO_TEST_CASE(FixedRank3TestCase) {
+  FixedRank3Test();
+} // FixedRank3TestCase
+
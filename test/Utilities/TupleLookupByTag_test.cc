@@ -388,6 +388,48 @@ void testMakeTagged() {
 } // testMakeTagged()
 
 
+//------------------------------------------------------------------------------
+//---  Compilation benchmark
+//------------------------------------------------------------------------------
+//
+// All the lookups on a tuple of `NBenchmarkTags` tagged types: the figure of
+// merit is the compilation time of this test, which is dominated by this
+// section; with `NBenchmarkTags` = 256 it should be well below one second.
+//
+constexpr std::size_t NBenchmarkTags = 128U;
+
+struct BenchmarkPayload { int value = 0; };
+
+template <std::size_t I>
+using BenchmarkTagged = util::add_tag_t<BenchmarkPayload, util::TagN<I>>;
+
+template <std::size_t... I>
+auto makeBenchmarkTuple(std::index_sequence<I...>)
+  -> std::tuple<BenchmarkTagged<I>...>;
+
+using BenchmarkTuple_t
+  = decltype(makeBenchmarkTuple(std::make_index_sequence<NBenchmarkTags>()));
+
+template <std::size_t... I>
+constexpr bool checkBenchmarkLookups(std::index_sequence<I...>) {
+  using Tuple_t = BenchmarkTuple_t;
+  return ((util::index_of_tag_v<util::TagN<I>, Tuple_t> == I) && ...)
+    && (util::has_tag_v<util::TagN<I>, Tuple_t> && ...)
+    && !util::has_tag_v<util::TagN<NBenchmarkTags>, Tuple_t>
+    && ((util::count_tags_v<util::TagN<I>, Tuple_t> == 1U) && ...)
+    && (std::is_same_v
+         <util::type_with_tag_t<util::TagN<I>, Tuple_t>, BenchmarkTagged<I>>
+       && ...)
+    && !util::has_duplicate_tags_v<Tuple_t>
+    && util::has_duplicate_types_v
+         <std::tuple<BenchmarkTagged<0>, Tuple_t, BenchmarkTagged<0>>>
+    ;
+} // checkBenchmarkLookups()
+
+static_assert(checkBenchmarkLookups(std::make_index_sequence<NBenchmarkTags>()),
+  "Lookup benchmark failed");
+
+
 int main() {
 
   //
@@ -0,0 +1,132 @@
+/**
+ * @file    UniqueRangeVector_test.cc
+ * @brief   Tests the class in `UniqueRangeVector.h`
+ * @date    October 14, 2026
+ * @see     `lardata/Utilities/UniqueRangeVector.h`
+ *
+ * The results are compared with the ones of `util::UniqueRangeSet`.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( UniqueRangeVector_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// LArSoft libraries
+#include "lardata/Utilities/UniqueRangeVector.h"
+#include "lardata/Utilities/UniqueRangeSet.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+template <typename A, typename B>
+void checkSameRanges(A const& a, B const& b) {
+  BOOST_REQUIRE_EQUAL(a.size(), b.size());
+  auto iB = b.begin();
+  for (auto const& r: a) {
+    BOOST_CHECK_EQUAL(r.Start(), iB->Start());
+    BOOST_CHECK_EQUAL(r.End(), iB->End());
+    ++iB;
+  }
+} // checkSameRanges()
+
+
+//------------------------------------------------------------------------------
+void testEmplace() {
+
+  util::UniqueRangeVector<int> ranges;
+  BOOST_CHECK(ranges.empty());
+  BOOST_CHECK_THROW(ranges.Start(), std::runtime_error);
+
+  BOOST_CHECK_EQUAL(ranges.emplace(10, 20), 0U);
+  BOOST_CHECK_EQUAL(ranges.emplace(30, 40), 0U);
+  BOOST_CHECK_EQUAL(ranges.emplace(0, 5), 0U);
+  BOOST_CHECK_EQUAL(ranges.size(), 3U);
+  BOOST_CHECK_EQUAL(ranges.Start(), 0);
+  BOOST_CHECK_EQUAL(ranges.End(), 40);
+
+  // touching and overlapping ranges are merged
+  BOOST_CHECK_EQUAL(ranges.emplace(5, 7), 1U);
+  BOOST_CHECK_EQUAL(ranges.emplace(15, 35), 2U);
+  BOOST_CHECK_EQUAL(ranges.size(), 2U);
+  BOOST_CHECK_EQUAL(ranges.begin()->Start(), 0);
+  BOOST_CHECK_EQUAL(ranges.begin()->End(), 7);
+  BOOST_CHECK_EQUAL(ranges.rbegin()->Start(), 10);
+  BOOST_CHECK_EQUAL(ranges.rbegin()->End(), 40);
+
+  BOOST_CHECK_THROW(ranges.emplace(3, 2), std::runtime_error);
+
+  auto const overlap = ranges.Overlapping(6, 9);
+  BOOST_CHECK_EQUAL(std::distance(overlap.first, overlap.second), 1);
+  auto const none = ranges.Overlapping(8, 9);
+  BOOST_CHECK(none.first == none.second);
+
+  // exclusive regions, clipped
+  auto const gaps = ranges.Exclusive(-5, 50);
+  BOOST_REQUIRE_EQUAL(gaps.size(), 3U);
+  auto iGap = gaps.begin();
+  BOOST_CHECK_EQUAL(iGap->Start(), -5); BOOST_CHECK_EQUAL(iGap->End(), 0);
+  ++iGap;
+  BOOST_CHECK_EQUAL(iGap->Start(), 7); BOOST_CHECK_EQUAL(iGap->End(), 10);
+  ++iGap;
+  BOOST_CHECK_EQUAL(iGap->Start(), 40); BOOST_CHECK_EQUAL(iGap->End(), 50);
+
+  auto const inner = ranges.Exclusive(2, 8);
+  BOOST_REQUIRE_EQUAL(inner.size(), 1U);
+  BOOST_CHECK_EQUAL(inner.begin()->Start(), 7);
+  BOOST_CHECK_EQUAL(inner.begin()->End(), 8);
+
+  auto all = ranges;
+  all.Merge(gaps);
+  BOOST_CHECK_EQUAL(all.size(), 1U);
+
+} // testEmplace()
+
+
+//------------------------------------------------------------------------------
+void testCompareWithSet() {
+
+  std::default_random_engine engine(12345);
+  std::uniform_int_distribution<int> startDist(0, 100000);
+  std::uniform_int_distribution<int> lengthDist(0, 30);
+
+  std::vector<util::Range<int>> input;
+  for (int i = 0; i < 5000; ++i) {
+    int const start = startDist(engine);
+    input.emplace_back(start, start + lengthDist(engine));
+  }
+
+  util::UniqueRangeSet<int> set;
+  util::UniqueRangeVector<int> oneByOne;
+  for (auto const& r: input) {
+    BOOST_CHECK_EQUAL
+      (oneByOne.emplace(r.Start(), r.End()), set.emplace(r.Start(), r.End()));
+  }
+  checkSameRanges(oneByOne, set);
+
+  // in two batches
+  util::UniqueRangeVector<int> batch;
+  auto const middle = input.begin() + input.size() / 2;
+  std::size_t nMerged = batch.Insert(input.begin(), middle);
+  nMerged += batch.Insert(middle, input.end());
+  BOOST_CHECK_EQUAL(nMerged, input.size() - set.size());
+  checkSameRanges(batch, set);
+
+} // testCompareWithSet()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EmplaceTestCase) {
+  testEmplace();
+}
+
+BOOST_AUTO_TEST_CASE(CompareWithSetTestCase) {
+  testCompareWithSet();
+}
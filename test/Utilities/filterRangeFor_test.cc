@@ -39,6 +39,21 @@ void testPredicate(Cont& data, Pred pred) {
 } // testPredicate()
 
 
+//-----------------------------------------------------------------------------
+// a range whose end is marked by a negative value, with a sentinel end iterator
+struct NegativeSentinel {};
+
+bool operator!= (int const* it, NegativeSentinel) { return *it >= 0; }
+bool operator!= (NegativeSentinel, int const* it) { return *it >= 0; }
+bool operator!= (NegativeSentinel, NegativeSentinel) { return false; }
+
+struct NonNegativeRange {
+  std::vector<int> const* data;
+  int const* begin() const { return data->data(); }
+  NegativeSentinel end() const { return {}; }
+};
+
+
 //-----------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE(filterRangeFor_testCase) {
 
@@ -60,3 +75,20 @@ BOOST_AUTO_TEST_CASE(filterRangeFor_testCase) {
 
 } // BOOST_AUTO_TEST_CASE(filterRangeFor_testCase)
 
+
+//-----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(filterRangeForSentinel_testCase) {
+
+  std::vector<int> data(20);
+  std::iota(data.begin(), data.end(), 0);
+  data[12] = -1;
+
+  NonNegativeRange const range { &data };
+  unsigned int n = 0;
+  for (int v: util::filterRangeFor(range, [](int v){ return (v % 3) == 0; }))
+  {
+    BOOST_CHECK_EQUAL(v, int(3 * n++));
+  } // for
+  BOOST_CHECK_EQUAL(n, 4U); // 0, 3, 6, 9
+
+} // BOOST_AUTO_TEST_CASE(filterRangeForSentinel_testCase)
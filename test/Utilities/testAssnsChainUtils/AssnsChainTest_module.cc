@@ -33,6 +33,7 @@
 #include "fhiclcpp/types/Comment.h"
 
 // C/C++ standard libraries
+#include <algorithm> // std::equal()
 #include <set>
 #include <cassert>
 
@@ -190,6 +191,31 @@ void lar::test::AssnsChainTest::printAssociatedHits
     showerHits(showers, event, showerTag);
   assert(showerHits.size() == showers->size());
 
+  //
+  // the indexed finders must return the same hits, in the same order
+  //
+  using HitFinder_t
+    = lar::FindManyInChainP<recob::Hit, recob::Cluster, recob::PFParticle>;
+  auto const indexedHits = HitFinder_t::findIndexed(showers, event, showerTag);
+  auto const parallelHits = HitFinder_t::findIndexed
+    (lar::ParallelTraversal, showers, event, showerTag);
+  for (auto const* hitLists: { &indexedHits, &parallelHits }) {
+    if (hitLists->size() != showers->size()) {
+      throw cet::exception("AssnsChainTest")
+        << "Indexed finder returned " << hitLists->size()
+        << " hit lists for " << showers->size() << " showers.\n";
+    }
+    for (std::size_t iShower = 0; iShower < showers->size(); ++iShower) {
+      auto const& hits = showerHits.at(iShower);
+      auto const indexed = hitLists->at(iShower);
+      if (std::equal(hits.begin(), hits.end(), indexed.begin(), indexed.end()))
+        continue;
+      throw cet::exception("AssnsChainTest")
+        << "Indexed finder returned different hits for shower #" << iShower
+        << " (" << indexed.size() << " vs. " << hits.size() << ").\n";
+    } // for showers
+  } // for indexed results
+
   //
   // print the associated hits (just the art pointer so far)
   //
@@ -21,7 +21,10 @@
 
 // C/C++ standard libraries
 #include <array>
+#include <cstddef> // std::ptrdiff_t
 #include <iostream>
+#include <stdexcept> // std::out_of_range
+#include <vector>
 
 
 //------------------------------------------------------------------------------
@@ -117,9 +120,87 @@ void AssociatedGroupsTest() {
 } // associated_groups_test()
 
 
+//------------------------------------------------------------------------------
+void AssociatedGroupIndexTest() {
+
+  struct TypeA {};
+  struct TypeB {};
+
+  using MyAssns_t = art::Assns<TypeA, TypeB>;
+  QuickGenerateTClass<MyAssns_t>();
+
+  using Index_t = art::Ptr<TypeA>::key_type;
+
+  // association description: B's for each A; the A's are not sorted
+  std::array<std::pair<Index_t, std::vector<Index_t>>, 4U> expected;
+  expected[0] = { 3, { 8, 10, 12, 13 } };
+  expected[1] = { 0, { 0, 3, 6 } };
+  expected[2] = { 1, { 2, 4, 6 } };
+  expected[3] = { 7, { 1 } };
+  art::ProductID aPID{ 5 }, bPID{ 12 };
+
+  MyAssns_t assns;
+  for (auto const& pair: expected) {
+    for (auto const& bIndex: pair.second) {
+      assns.addSingle
+        ({ aPID, pair.first, nullptr }, { bPID, bIndex, nullptr });
+    } // for bIndex
+  } // for pair
+
+  auto const groups = util::associated_groups_index(assns);
+  BOOST_CHECK(!groups.sorted());
+  BOOST_CHECK_EQUAL(groups.size(), expected.size());
+
+  // random access, in reverse order
+  for (std::size_t i = groups.size(); i-- > 0; ) {
+    auto const group = groups[i];
+    auto const& expectedBs = expected[i].second;
+    BOOST_TEST_MESSAGE("  group #" << i << ", A=" << expected[i].first);
+    BOOST_CHECK_EQUAL(group.left().key(), expected[i].first);
+    BOOST_CHECK_EQUAL(group.size(), expectedBs.size());
+    std::size_t j = 0;
+    for (art::Ptr<TypeB> const& B: group) {
+      BOOST_CHECK_EQUAL(B.key(), expectedBs[j]);
+      BOOST_CHECK_EQUAL(group[j].key(), expectedBs[j]);
+      ++j;
+    } // for B
+    BOOST_CHECK_EQUAL(j, expectedBs.size());
+  } // for groups
+
+  // look-up by left object
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    art::Ptr<TypeA> const A{ aPID, expected[i].first, nullptr };
+    BOOST_CHECK_EQUAL(groups.index(A), i);
+    BOOST_CHECK_EQUAL(groups.find(A) - groups.begin(), std::ptrdiff_t(i));
+  } // for
+  art::Ptr<TypeA> const missing{ aPID, 2, nullptr };
+  BOOST_CHECK_EQUAL(groups.index(missing), groups.npos);
+  BOOST_CHECK(groups.find(missing) == groups.end());
+  BOOST_CHECK_THROW(groups.at(groups.size()), std::out_of_range);
+
+  // iteration, matching `util::associated_groups()`
+  auto iGroup = groups.begin();
+  for (auto Bs: util::associated_groups(assns)) {
+    auto const group = *(iGroup++);
+    auto iB = group.begin();
+    for (art::Ptr<TypeB> const& B: Bs) BOOST_CHECK_EQUAL(B, *(iB++));
+    BOOST_CHECK(iB == group.end());
+  } // for
+  BOOST_CHECK(iGroup == groups.end());
+  BOOST_CHECK_EQUAL
+    (groups.end() - groups.begin(), std::ptrdiff_t(groups.size()));
+
+} // AssociatedGroupIndexTest()
+
+
 //------------------------------------------------------------------------------
 //--- tests
 //
 BOOST_AUTO_TEST_CASE(AssociatedGroupsTestCase) {
   AssociatedGroupsTest();
 } // AssociatedGroupsTestCase
+
+
+BOOST_AUTO_TEST_CASE(AssociatedGroupIndexTestCase) {
+  AssociatedGroupIndexTest();
+} // AssociatedGroupIndexTestCase